@@ -0,0 +1,1114 @@
+// allocbench.m.cpp                                                   -*-C++-*-
+
+//@PURPOSE: Measure the cost of BDE allocation strategies on 'bsl' containers.
+//
+//@DESCRIPTION: This program reproduces the benchmarks described in the ISO
+// C++ papers "On Quantifying Memory-Allocation Strategies" (N4468, P0089R0,
+// and P0089R1) using the allocators of this repository.  Each benchmark runs
+// one *workload* on one 'bsl' *container* under each of a set of allocation
+// *strategies*, and reports the elapsed time of each in a machine-readable
+// format (CSV or JSON Lines), so that the results of different releases can
+// be compared mechanically.
+//
+///Strategies
+///----------
+// Each strategy names the allocator supplied to the containers, and whether
+// the containers are destroyed normally, or are "winked out" -- i.e., not
+// destroyed at all, their memory being reclaimed when the allocator is
+// destroyed:
+//..
+//  Name                      Allocator
+//  ------------------------  ---------------------------------------------
+//  newdelete                 'bslma::NewDeleteAllocator'
+//  monotonic                 'bdlma::SequentialAllocator'
+//  monotonic-wink            'bdlma::SequentialAllocator', winked out
+//  local-monotonic           'bdlma::LocalSequentialAllocator' (16K buffer)
+//  local-monotonic-wink      'bdlma::LocalSequentialAllocator', winked out
+//  multipool                 'bdlma::MultipoolAllocator'
+//  multipool-wink            'bdlma::MultipoolAllocator', winked out
+//  multipool-monotonic       'bdlma::MultipoolAllocator' drawing on a
+//                            'bdlma::SequentialAllocator'
+//  multipool-monotonic-wink  as above, winked out
+//  concurrent-multipool      'bdlma::ConcurrentMultipoolAllocator'
+//  thread-caching-multipool  'bdlma::ThreadCachingMultipoolAllocator'
+//..
+// Except for 'newdelete', each allocator is a *local* allocator: a new
+// allocator object is created for each unit of work, and is destroyed (with
+// all of its memory) when that unit of work completes.  All allocators obtain
+// their memory from the 'bslma::NewDeleteAllocator' singleton.
+//
+///Workloads
+///---------
+//: 'churn':
+//:   (N4468 "benchmark I") Repeatedly create a container, insert 'size'
+//:   elements, and destroy it (or wink it out), for container sizes from 16
+//:   to 65536, performing the same total number of insertions for each size.
+//:   Each repetition uses a new local allocator.
+//:
+//: 'fragment':
+//:   (P0089 "benchmark II") Create 32 "subsystems", each owning a node-based
+//:   container and (except for 'newdelete') its own allocator.  Insert
+//:   elements into the subsystems in round-robin order ('build' phase), then
+//:   repeatedly remove the first element of a randomly chosen subsystem and
+//:   insert a new one ('shuffle' phase), and finally traverse every
+//:   subsystem several times ('access' phase).  The 'access' phase measures
+//:   the locality of the memory handed out by each strategy after it has
+//:   been fragmented.
+//:
+//: 'threads':
+//:   Run the 'churn' workload (with containers of 256 elements) concurrently
+//:   in 1, 2, 4, ... threads, both with a 'local' allocator per thread and
+//:   unit of work (for every strategy), and with a single allocator 'shared'
+//:   by all threads (for the thread-safe strategies that do not wink out).
+//:   Each thread performs the same amount of work, so that ideal scaling
+//:   shows as a throughput proportional to the number of threads.
+//
+///Output
+///------
+// One record is written for each measurement.  In CSV format (the default),
+// the first line names the fields; in JSON format, each line is an object.
+// The fields are:
+//..
+//  Field          Meaning
+//  -------------  ----------------------------------------------------------
+//  version        BDE version of the library under test
+//  workload       'churn', 'fragment', or 'threads'
+//  container      e.g., 'vector<int>', 'list<int>', 'vector<string>'
+//  strategy       one of the strategy names above
+//  sharing        'local' or 'shared' (allocator per unit of work or global)
+//  threads        number of threads running the workload
+//  size           elements per container
+//  phase          'all' ('churn', 'threads') or 'build', 'shuffle', 'access'
+//  operations     number of element operations per sample
+//  samples        number of times the measurement was repeated
+//  min_seconds    least elapsed time of any sample
+//  median_seconds median elapsed time of the samples
+//  ops_per_second 'operations / median_seconds'
+//..
+//
+///Usage
+///-----
+//..
+//  allocbench [--format csv|json] [--workload churn|fragment|threads|all]
+//             [--strategy NAME]... [--container NAME]... [--scale N]
+//             [--repeat N] [--max-threads N] [--list] [--help]
+//..
+// '--scale N' sets the number of element operations per sample to '2^N'
+// (default 20); '--repeat N' sets the number of samples of each measurement
+// (default 3); '--max-threads N' bounds the thread counts of the 'threads'
+// workload (default: the hardware concurrency, but at least 4).  '--strategy'
+// and '--container' may be repeated to select a subset of the strategies and
+// containers.  '--list' prints the names of the strategies and containers.
+
+#include <bdlma_concurrentmultipoolallocator.h>
+#include <bdlma_localsequentialallocator.h>
+#include <bdlma_multipoolallocator.h>
+#include <bdlma_sequentialallocator.h>
+#include <bdlma_threadcachingmultipoolallocator.h>
+
+#include <bdlscm_version.h>
+
+#include <bslma_allocator.h>
+#include <bslma_newdeleteallocator.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_threadutil.h>
+
+#include <bslstl_stringref.h>
+
+#include <bsls_timeutil.h>
+#include <bsls_types.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_list.h>
+#include <bsl_set.h>
+#include <bsl_string.h>
+#include <bsl_unordered_set.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+
+namespace {
+
+// ============================================================================
+//                             CONSTANTS
+// ----------------------------------------------------------------------------
+
+enum {
+    k_LOCAL_BUFFER_SIZE  = 16 * 1024,  // buffer of 'local-monotonic'
+    k_STRING_LENGTH      = 40,         // exceeds the short-string buffer
+    k_TEXT_LENGTH        = 256,        // characters of text to draw from
+    k_NUM_SUBSYSTEMS     = 32,         // subsystems of 'fragment'
+    k_ACCESS_PASSES      = 8,          // traversals of 'fragment'
+    k_THREADS_SIZE       = 256,        // container size of 'threads'
+    k_MAX_SAMPLES        = 100         // upper bound of '--repeat'
+};
+
+volatile bsls::Types::Uint64 g_sink;
+    // Accumulates a value derived from each container, so that the work on
+    // the container cannot be optimized away.
+
+// ============================================================================
+//                             STRATEGIES
+// ----------------------------------------------------------------------------
+
+enum AllocatorKind {
+    e_NEW_DELETE,
+    e_MONOTONIC,
+    e_LOCAL_MONOTONIC,
+    e_MULTIPOOL,
+    e_MULTIPOOL_MONOTONIC,
+    e_CONCURRENT_MULTIPOOL,
+    e_THREAD_CACHING_MULTIPOOL
+};
+
+struct Strategy {
+    // This 'struct' describes an allocation strategy.
+
+    const char    *d_name;        // name of the strategy
+    AllocatorKind  d_kind;        // allocator supplied to the containers
+    bool           d_winkOut;     // 'true' if containers are not destroyed
+    bool           d_threadSafe;  // 'true' if the allocator is thread-safe
+};
+
+const Strategy STRATEGIES[] = {
+    // name                        kind                         wink   safe
+    { "newdelete",                 e_NEW_DELETE,                false, true  },
+    { "monotonic",                 e_MONOTONIC,                 false, false },
+    { "monotonic-wink",            e_MONOTONIC,                 true,  false },
+    { "local-monotonic",           e_LOCAL_MONOTONIC,           false, false },
+    { "local-monotonic-wink",      e_LOCAL_MONOTONIC,           true,  false },
+    { "multipool",                 e_MULTIPOOL,                 false, false },
+    { "multipool-wink",            e_MULTIPOOL,                 true,  false },
+    { "multipool-monotonic",       e_MULTIPOOL_MONOTONIC,       false, false },
+    { "multipool-monotonic-wink",  e_MULTIPOOL_MONOTONIC,       true,  false },
+    { "concurrent-multipool",      e_CONCURRENT_MULTIPOOL,      false, true  },
+    { "thread-caching-multipool",  e_THREAD_CACHING_MULTIPOOL,  false, true  }
+};
+
+const int NUM_STRATEGIES = sizeof STRATEGIES / sizeof *STRATEGIES;
+
+                    // ====================================
+                    // class MultipoolOnMonotonicAllocator
+                    // ====================================
+
+class MultipoolOnMonotonicAllocator : public bslma::Allocator {
+    // This class provides an allocator that dispenses memory from a
+    // 'bdlma::MultipoolAllocator' that obtains its memory from a
+    // 'bdlma::SequentialAllocator'.
+
+    // DATA
+    bdlma::SequentialAllocator d_monotonic;  // supplies 'd_multipool'
+    bdlma::MultipoolAllocator  d_multipool;  // supplies memory
+
+  public:
+    // CREATORS
+    explicit MultipoolOnMonotonicAllocator(bslma::Allocator *basicAllocator)
+        // Create an allocator that obtains its memory from the specified
+        // 'basicAllocator'.
+    : d_monotonic(basicAllocator)
+    , d_multipool(&d_monotonic)
+    {
+    }
+
+    // MANIPULATORS
+    void *allocate(size_type size)
+        // Return a block of at least the specified 'size' bytes.
+    {
+        return d_multipool.allocate(size);
+    }
+
+    void deallocate(void *address)
+        // Return the block at the specified 'address' to the multipool.
+    {
+        d_multipool.deallocate(address);
+    }
+};
+
+template <class FUNCTOR>
+void withLocalAllocator(AllocatorKind kind, const FUNCTOR& functor)
+    // Invoke the specified 'functor' with the address of a newly-created
+    // allocator of the specified 'kind', created on the stack, and destroy
+    // the allocator.  If 'kind' is 'e_NEW_DELETE', supply the new-delete
+    // allocator singleton.
+{
+    bslma::Allocator *nd = &bslma::NewDeleteAllocator::singleton();
+
+    switch (kind) {
+      case e_NEW_DELETE: {
+        functor(nd);
+      } break;
+      case e_MONOTONIC: {
+        bdlma::SequentialAllocator allocator(nd);
+        functor(&allocator);
+      } break;
+      case e_LOCAL_MONOTONIC: {
+        bdlma::LocalSequentialAllocator<k_LOCAL_BUFFER_SIZE> allocator(nd);
+        functor(&allocator);
+      } break;
+      case e_MULTIPOOL: {
+        bdlma::MultipoolAllocator allocator(nd);
+        functor(&allocator);
+      } break;
+      case e_MULTIPOOL_MONOTONIC: {
+        MultipoolOnMonotonicAllocator allocator(nd);
+        functor(&allocator);
+      } break;
+      case e_CONCURRENT_MULTIPOOL: {
+        bdlma::ConcurrentMultipoolAllocator allocator(nd);
+        functor(&allocator);
+      } break;
+      case e_THREAD_CACHING_MULTIPOOL: {
+        bdlma::ThreadCachingMultipoolAllocator allocator(nd);
+        functor(&allocator);
+      } break;
+    }
+}
+
+bslma::Allocator *createAllocator(AllocatorKind kind)
+    // Return the address of a newly-created allocator of the specified
+    // 'kind', allocated from the new-delete allocator singleton, or, if 'kind'
+    // is 'e_NEW_DELETE', the address of that singleton.  Use
+    // 'destroyAllocator' to destroy the returned allocator.
+{
+    bslma::NewDeleteAllocator *nd = &bslma::NewDeleteAllocator::singleton();
+
+    switch (kind) {
+      case e_NEW_DELETE: {
+        return nd;                                                    // RETURN
+      }
+      case e_MONOTONIC: {
+        return new (*nd) bdlma::SequentialAllocator(nd);              // RETURN
+      }
+      case e_LOCAL_MONOTONIC: {
+        return new (*nd) bdlma::LocalSequentialAllocator<
+                                                   k_LOCAL_BUFFER_SIZE>(nd);
+                                                                      // RETURN
+      }
+      case e_MULTIPOOL: {
+        return new (*nd) bdlma::MultipoolAllocator(nd);               // RETURN
+      }
+      case e_MULTIPOOL_MONOTONIC: {
+        return new (*nd) MultipoolOnMonotonicAllocator(nd);           // RETURN
+      }
+      case e_CONCURRENT_MULTIPOOL: {
+        return new (*nd) bdlma::ConcurrentMultipoolAllocator(nd);     // RETURN
+      }
+      case e_THREAD_CACHING_MULTIPOOL: {
+        return new (*nd) bdlma::ThreadCachingMultipoolAllocator(nd);  // RETURN
+      }
+    }
+    return nd;
+}
+
+void destroyAllocator(bslma::Allocator *allocator)
+    // Destroy the specified 'allocator', obtained from 'createAllocator'.
+{
+    bslma::NewDeleteAllocator *nd = &bslma::NewDeleteAllocator::singleton();
+
+    if (allocator != nd) {
+        nd->deleteObject(allocator);
+    }
+}
+
+// ============================================================================
+//                             TEST DATA
+// ----------------------------------------------------------------------------
+
+class Data {
+    // This class provides the values inserted into the containers: a
+    // pseudo-random permutation of integers, and text from which strings are
+    // drawn.
+
+    // DATA
+    bsl::vector<int> d_keys;                    // permutation of '[0 .. N)'
+    char             d_text[k_TEXT_LENGTH + k_STRING_LENGTH];
+
+  public:
+    // CREATORS
+    explicit Data(int numKeys)
+        // Create test data having the specified 'numKeys' keys.
+    : d_keys(numKeys)
+    {
+        for (int i = 0; i < numKeys; ++i) {
+            d_keys[i] = i;
+        }
+
+        unsigned int seed = 12345;
+        for (int i = numKeys - 1; 0 < i; --i) {
+            seed = seed * 1103515245u + 12345u;
+            bsl::swap(d_keys[i], d_keys[(seed >> 8) % (i + 1)]);
+        }
+
+        for (int i = 0; i < k_TEXT_LENGTH + k_STRING_LENGTH; ++i) {
+            d_text[i] = static_cast<char>('a' + i % 26);
+        }
+    }
+
+    // ACCESSORS
+    int key(int index) const
+        // Return the key at the specified 'index', modulo the number of keys.
+    {
+        return d_keys[index % d_keys.size()];
+    }
+
+    const char *text(int index) const
+        // Return the address of 'k_STRING_LENGTH' characters of text selected
+        // by the specified 'index'.
+    {
+        return d_text + index % k_TEXT_LENGTH;
+    }
+};
+
+// ============================================================================
+//                             CONTAINERS
+// ----------------------------------------------------------------------------
+
+typedef bsl::vector<int>           VectorOfInt;
+typedef bsl::vector<bsl::string>   VectorOfString;
+typedef bsl::list<int>             ListOfInt;
+typedef bsl::set<int>              SetOfInt;
+typedef bsl::unordered_set<int>    UnorderedSetOfInt;
+
+void insertValue(VectorOfInt *container, int index, const Data& data)
+    // Insert the value selected by the specified 'index' from the specified
+    // 'data' into the specified 'container'.
+{
+    container->push_back(data.key(index));
+}
+
+void insertValue(VectorOfString *container, int index, const Data& data)
+{
+    container->emplace_back(bslstl::StringRef(data.text(index),
+                                              k_STRING_LENGTH));
+}
+
+void insertValue(ListOfInt *container, int index, const Data& data)
+{
+    container->push_back(data.key(index));
+}
+
+void insertValue(SetOfInt *container, int index, const Data& data)
+{
+    container->insert(data.key(index));
+}
+
+void insertValue(UnorderedSetOfInt *container, int index, const Data& data)
+{
+    container->insert(data.key(index));
+}
+
+void removeFirst(ListOfInt *container)
+    // Remove the first element of the specified 'container'.  Note that the
+    // first element of a 'list' is the oldest, that of a 'set' the smallest,
+    // and that of an 'unordered_set' is unspecified.
+{
+    container->pop_front();
+}
+
+void removeFirst(SetOfInt *container)
+{
+    container->erase(container->begin());
+}
+
+void removeFirst(UnorderedSetOfInt *container)
+{
+    container->erase(container->begin());
+}
+
+template <class CONTAINER>
+bsls::Types::Uint64 traverse(const CONTAINER& container)
+    // Return the sum of the elements of the specified 'container'.
+{
+    bsls::Types::Uint64 sum = 0;
+    for (typename CONTAINER::const_iterator it  = container.begin();
+                                            it != container.end();
+                                            ++it) {
+        sum += *it;
+    }
+    return sum;
+}
+
+template <class CONTAINER>
+void fillAndDrop(bslma::Allocator *allocator,
+                 bool              winkOut,
+                 int               size,
+                 int               offset,
+                 const Data&       data)
+    // Create a container using the specified 'allocator', insert the
+    // specified 'size' values of the specified 'data' starting at the
+    // specified 'offset', and then destroy the container, or, if the
+    // specified 'winkOut' is 'true', abandon it to be reclaimed with
+    // 'allocator'.
+{
+    if (winkOut) {
+        CONTAINER *container = new (*allocator) CONTAINER(allocator);
+        for (int i = 0; i < size; ++i) {
+            insertValue(container, offset + i, data);
+        }
+        g_sink = g_sink + container->size();
+    }
+    else {
+        CONTAINER container(allocator);
+        for (int i = 0; i < size; ++i) {
+            insertValue(&container, offset + i, data);
+        }
+        g_sink = g_sink + container.size();
+    }
+}
+
+typedef void (*FillAndDropFunction)(bslma::Allocator *,
+                                    bool,
+                                    int,
+                                    int,
+                                    const Data&);
+
+struct Container {
+    // This 'struct' describes a container type used by the workloads.
+
+    const char          *d_name;           // name of the container
+    FillAndDropFunction  d_fillAndDrop;    // 'fillAndDrop<CONTAINER>'
+    bool                 d_isNodeBased;    // 'true' for 'fragment'
+};
+
+const Container CONTAINERS[] = {
+    { "vector<int>",        &fillAndDrop<VectorOfInt>,        false },
+    { "vector<string>",     &fillAndDrop<VectorOfString>,     false },
+    { "list<int>",          &fillAndDrop<ListOfInt>,          true  },
+    { "set<int>",           &fillAndDrop<SetOfInt>,           true  },
+    { "unordered_set<int>", &fillAndDrop<UnorderedSetOfInt>,  true  }
+};
+
+const int NUM_CONTAINERS = sizeof CONTAINERS / sizeof *CONTAINERS;
+
+struct FillAndDrop {
+    // This functor invokes a 'FillAndDropFunction' with fixed arguments.
+
+    FillAndDropFunction  d_function;
+    bool                 d_winkOut;
+    int                  d_size;
+    int                  d_offset;
+    const Data          *d_data_p;
+
+    void operator()(bslma::Allocator *allocator) const
+        // Invoke the function with the specified 'allocator'.
+    {
+        d_function(allocator, d_winkOut, d_size, d_offset, *d_data_p);
+    }
+};
+
+// ============================================================================
+//                             REPORTING
+// ----------------------------------------------------------------------------
+
+enum Format { e_CSV, e_JSON };
+
+struct Record {
+    // This 'struct' holds the description of a measurement.
+
+    const char          *d_workload;
+    const char          *d_container;
+    const char          *d_strategy;
+    const char          *d_sharing;
+    int                  d_threads;
+    int                  d_size;
+    const char          *d_phase;
+    bsls::Types::Int64   d_operations;
+};
+
+class Reporter {
+    // This class writes measurements to the standard output.
+
+    // DATA
+    Format d_format;
+
+  public:
+    // CREATORS
+    explicit Reporter(Format format)
+        // Create a reporter writing in the specified 'format', and write the
+        // header line, if any.
+    : d_format(format)
+    {
+        if (e_CSV == d_format) {
+            bsl::printf("version,workload,container,strategy,sharing,threads,"
+                        "size,phase,operations,samples,min_seconds,"
+                        "median_seconds,ops_per_second\n");
+        }
+    }
+
+    // MANIPULATORS
+    void report(const Record& record, bsls::Types::Int64 *samples, int n)
+        // Write the specified 'record' with the statistics of the specified
+        // 'n' elapsed times (in nanoseconds) at the specified 'samples'.  Note
+        // that 'samples' is sorted.
+    {
+        bsl::sort(samples, samples + n);
+
+        const double minSeconds    = samples[0] / 1.0e9;
+        const bsls::Types::Int64 median =
+                 n % 2 ? samples[n / 2]
+                       : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+
+        const double medianSeconds = median / 1.0e9;
+        const double opsPerSecond  = medianSeconds > 0
+                                   ? record.d_operations / medianSeconds
+                                   : 0;
+
+        const char *fmt = e_CSV == d_format
+            ? "%s,%s,%s,%s,%s,%d,%d,%s,%lld,%d,%.9f,%.9f,%.1f\n"
+            : "{\"version\":\"%s\",\"workload\":\"%s\",\"container\":\"%s\","
+              "\"strategy\":\"%s\",\"sharing\":\"%s\",\"threads\":%d,"
+              "\"size\":%d,\"phase\":\"%s\",\"operations\":%lld,"
+              "\"samples\":%d,\"min_seconds\":%.9f,\"median_seconds\":%.9f,"
+              "\"ops_per_second\":%.1f}\n";
+
+        bsl::printf(fmt,
+                    bdlscm::Version::version(),
+                    record.d_workload,
+                    record.d_container,
+                    record.d_strategy,
+                    record.d_sharing,
+                    record.d_threads,
+                    record.d_size,
+                    record.d_phase,
+                    static_cast<long long>(record.d_operations),
+                    n,
+                    minSeconds,
+                    medianSeconds,
+                    opsPerSecond);
+        bsl::fflush(stdout);
+    }
+};
+
+// ============================================================================
+//                             WORKLOADS
+// ----------------------------------------------------------------------------
+
+struct Config {
+    // This 'struct' holds the options of a run.
+
+    int               d_scale;       // 'log2' of operations per sample
+    int               d_repeat;      // samples per measurement
+    int               d_maxThreads;  // largest thread count of 'threads'
+    bsl::vector<int>  d_strategies;  // indices of selected strategies
+    bsl::vector<int>  d_containers;  // indices of selected containers
+};
+
+void runChurn(Reporter *reporter, const Config& config, const Data& data)
+    // Run the 'churn' workload, as configured by the specified 'config' and
+    // using the specified 'data', and report the results to the specified
+    // 'reporter'.
+{
+    const int numOperations = 1 << config.d_scale;
+
+    bsls::Types::Int64 samples[k_MAX_SAMPLES];
+
+    for (bsl::size_t ci = 0; ci < config.d_containers.size(); ++ci) {
+        const Container& container = CONTAINERS[config.d_containers[ci]];
+
+        for (int size = 16; size <= 65536 && size <= numOperations; size *= 16)
+        {
+            const int numRepetitions = numOperations / size;
+
+            for (bsl::size_t si = 0; si < config.d_strategies.size(); ++si) {
+                const Strategy& strategy =
+                                        STRATEGIES[config.d_strategies[si]];
+
+                for (int sample = 0; sample < config.d_repeat; ++sample) {
+                    const bsls::Types::Int64 start =
+                                                   bsls::TimeUtil::getTimer();
+
+                    for (int r = 0; r < numRepetitions; ++r) {
+                        FillAndDrop f = { container.d_fillAndDrop,
+                                          strategy.d_winkOut,
+                                          size,
+                                          r,
+                                          &data };
+                        withLocalAllocator(strategy.d_kind, f);
+                    }
+
+                    samples[sample] = bsls::TimeUtil::getTimer() - start;
+                }
+
+                Record record = { "churn",
+                                  container.d_name,
+                                  strategy.d_name,
+                                  "local",
+                                  1,
+                                  size,
+                                  "all",
+                                  numRepetitions * size };
+                reporter->report(record, samples, config.d_repeat);
+            }
+        }
+    }
+}
+
+template <class CONTAINER>
+void runFragmentPhases(bsls::Types::Int64  *elapsed,
+                       AllocatorKind        kind,
+                       bool                 winkOut,
+                       int                  numOperations,
+                       const Data&          data)
+    // Run the phases of the 'fragment' workload for the specified 'CONTAINER'
+    // using allocators of the specified 'kind', performing the specified
+    // 'numOperations' element operations in each phase, with the specified
+    // 'data', and load the elapsed times of the 'build', 'shuffle', and
+    // 'access' phases into the specified 'elapsed' array.  If the specified
+    // 'winkOut' is 'true', do not destroy the containers.
+{
+    const int numElements = bsl::max(1, numOperations / k_NUM_SUBSYSTEMS);
+
+    bslma::Allocator *allocators[k_NUM_SUBSYSTEMS];
+    CONTAINER        *containers[k_NUM_SUBSYSTEMS];
+
+    for (int i = 0; i < k_NUM_SUBSYSTEMS; ++i) {
+        allocators[i] = createAllocator(kind);
+        containers[i] = new (*allocators[i]) CONTAINER(allocators[i]);
+    }
+
+    // Build, interleaving the allocations of the subsystems.
+
+    bsls::Types::Int64 start = bsls::TimeUtil::getTimer();
+
+    int next = 0;
+    for (int e = 0; e < numElements; ++e) {
+        for (int i = 0; i < k_NUM_SUBSYSTEMS; ++i) {
+            insertValue(containers[i], next++, data);
+        }
+    }
+
+    elapsed[0] = bsls::TimeUtil::getTimer() - start;
+
+    // Shuffle: replace the first element of randomly chosen subsystems.
+
+    start = bsls::TimeUtil::getTimer();
+
+    unsigned int seed = 54321;
+    for (int op = 0; op < numOperations; ++op) {
+        seed = seed * 1103515245u + 12345u;
+        CONTAINER *container = containers[(seed >> 8) % k_NUM_SUBSYSTEMS];
+
+        removeFirst(container);
+        insertValue(container, next++, data);
+    }
+
+    elapsed[1] = bsls::TimeUtil::getTimer() - start;
+
+    // Access: traverse every subsystem.
+
+    start = bsls::TimeUtil::getTimer();
+
+    bsls::Types::Uint64 sum = 0;
+    for (int pass = 0; pass < k_ACCESS_PASSES; ++pass) {
+        for (int i = 0; i < k_NUM_SUBSYSTEMS; ++i) {
+            sum += traverse(*containers[i]);
+        }
+    }
+    g_sink = g_sink + sum;
+
+    elapsed[2] = bsls::TimeUtil::getTimer() - start;
+
+    for (int i = 0; i < k_NUM_SUBSYSTEMS; ++i) {
+        if (!winkOut) {
+            allocators[i]->deleteObject(containers[i]);
+        }
+        destroyAllocator(allocators[i]);
+    }
+}
+
+void runFragment(Reporter *reporter, const Config& config, const Data& data)
+    // Run the 'fragment' workload, as configured by the specified 'config'
+    // and using the specified 'data', and report the results to the
+    // specified 'reporter'.
+{
+    static const char *const PHASES[] = { "build", "shuffle", "access" };
+
+    const int numOperations = 1 << config.d_scale;
+    const int numElements   = bsl::max(1, numOperations / k_NUM_SUBSYSTEMS);
+
+    bsls::Types::Int64 samples[3][k_MAX_SAMPLES];
+
+    for (bsl::size_t ci = 0; ci < config.d_containers.size(); ++ci) {
+        const Container& container = CONTAINERS[config.d_containers[ci]];
+
+        if (!container.d_isNodeBased) {
+            continue;
+        }
+
+        for (bsl::size_t si = 0; si < config.d_strategies.size(); ++si) {
+            const Strategy& strategy = STRATEGIES[config.d_strategies[si]];
+
+            for (int sample = 0; sample < config.d_repeat; ++sample) {
+                bsls::Types::Int64 elapsed[3];
+
+                if (0 == bsl::strcmp(container.d_name, "list<int>")) {
+                    runFragmentPhases<ListOfInt>(elapsed,
+                                                 strategy.d_kind,
+                                                 strategy.d_winkOut,
+                                                 numOperations,
+                                                 data);
+                }
+                else if (0 == bsl::strcmp(container.d_name, "set<int>")) {
+                    runFragmentPhases<SetOfInt>(elapsed,
+                                                strategy.d_kind,
+                                                strategy.d_winkOut,
+                                                numOperations,
+                                                data);
+                }
+                else {
+                    runFragmentPhases<UnorderedSetOfInt>(elapsed,
+                                                         strategy.d_kind,
+                                                         strategy.d_winkOut,
+                                                         numOperations,
+                                                         data);
+                }
+
+                for (int phase = 0; phase < 3; ++phase) {
+                    samples[phase][sample] = elapsed[phase];
+                }
+            }
+
+            const bsls::Types::Int64 operations[] = {
+                static_cast<bsls::Types::Int64>(numElements)
+                                                           * k_NUM_SUBSYSTEMS,
+                numOperations,
+                static_cast<bsls::Types::Int64>(numElements)
+                                         * k_NUM_SUBSYSTEMS * k_ACCESS_PASSES
+            };
+
+            for (int phase = 0; phase < 3; ++phase) {
+                Record record = { "fragment",
+                                  container.d_name,
+                                  strategy.d_name,
+                                  "local",
+                                  1,
+                                  numElements,
+                                  PHASES[phase],
+                                  operations[phase] };
+                reporter->report(record, samples[phase], config.d_repeat);
+            }
+        }
+    }
+}
+
+struct ThreadArgs {
+    // This 'struct' holds the arguments of a thread of the 'threads'
+    // workload.
+
+    bslmt::Barrier      *d_barrier_p;      // start barrier
+    const Strategy      *d_strategy_p;     // strategy of the workload
+    bslma::Allocator    *d_shared_p;       // shared allocator, or 0
+    FillAndDropFunction  d_fillAndDrop;    // work on the container
+    int                  d_numRepetitions; // containers to fill and drop
+    const Data          *d_data_p;         // values to insert
+    bsls::Types::Int64   d_start;          // time the work started (output)
+    bsls::Types::Int64   d_end;            // time the work ended (output)
+};
+
+extern "C" void *churnThread(void *arg)
+    // Run the 'churn' loop of the 'threads' workload as described by the
+    // specified 'arg', which must be the address of a 'ThreadArgs' object.
+{
+    ThreadArgs& args = *static_cast<ThreadArgs *>(arg);
+
+    args.d_barrier_p->wait();
+
+    args.d_start = bsls::TimeUtil::getTimer();
+
+    for (int r = 0; r < args.d_numRepetitions; ++r) {
+        FillAndDrop f = { args.d_fillAndDrop,
+                          args.d_strategy_p->d_winkOut,
+                          k_THREADS_SIZE,
+                          r,
+                          args.d_data_p };
+        if (args.d_shared_p) {
+            f(args.d_shared_p);
+        }
+        else {
+            withLocalAllocator(args.d_strategy_p->d_kind, f);
+        }
+    }
+
+    args.d_end = bsls::TimeUtil::getTimer();
+
+    return 0;
+}
+
+void runThreads(Reporter *reporter, const Config& config, const Data& data)
+    // Run the 'threads' workload, as configured by the specified 'config'
+    // and using the specified 'data', and report the results to the
+    // specified 'reporter'.
+{
+    const int numOperations  = 1 << config.d_scale;
+    const int numRepetitions = bsl::max(1, numOperations / k_THREADS_SIZE);
+
+    bsls::Types::Int64 samples[k_MAX_SAMPLES];
+
+    for (bsl::size_t ci = 0; ci < config.d_containers.size(); ++ci) {
+        const Container& container = CONTAINERS[config.d_containers[ci]];
+
+        for (int shared = 0; shared < 2; ++shared) {
+            for (bsl::size_t si = 0; si < config.d_strategies.size(); ++si) {
+                const Strategy& strategy =
+                                        STRATEGIES[config.d_strategies[si]];
+
+                if (shared && (!strategy.d_threadSafe || strategy.d_winkOut)) {
+                    continue;
+                }
+
+                for (int numThreads = 1;
+                     numThreads <= config.d_maxThreads;
+                     numThreads *= 2) {
+                    for (int sample = 0; sample < config.d_repeat; ++sample) {
+                        bslma::Allocator *allocator = shared
+                                           ? createAllocator(strategy.d_kind)
+                                           : 0;
+
+                        bslmt::Barrier barrier(numThreads);
+
+                        ThreadArgs args = { &barrier,
+                                            &strategy,
+                                            allocator,
+                                            container.d_fillAndDrop,
+                                            numRepetitions,
+                                            &data,
+                                            0,
+                                            0 };
+
+                        bsl::vector<ThreadArgs> threadArgs(numThreads, args);
+                        bsl::vector<bslmt::ThreadUtil::Handle> handles(
+                                                                  numThreads);
+                        for (int t = 0; t < numThreads; ++t) {
+                            if (0 != bslmt::ThreadUtil::create(
+                                                          &handles[t],
+                                                          churnThread,
+                                                          &threadArgs[t])) {
+                                bsl::fprintf(stderr,
+                                             "allocbench: cannot create "
+                                             "thread\n");
+                                bsl::exit(1);
+                            }
+                        }
+
+                        // The elapsed time is measured from the first thread
+                        // starting its work to the last thread finishing it.
+
+                        bsls::Types::Int64 start = 0;
+                        bsls::Types::Int64 end   = 0;
+                        for (int t = 0; t < numThreads; ++t) {
+                            bslmt::ThreadUtil::join(handles[t]);
+
+                            if (0 == t || threadArgs[t].d_start < start) {
+                                start = threadArgs[t].d_start;
+                            }
+                            if (0 == t || end < threadArgs[t].d_end) {
+                                end = threadArgs[t].d_end;
+                            }
+                        }
+                        samples[sample] = end - start;
+
+                        if (allocator) {
+                            destroyAllocator(allocator);
+                        }
+                    }
+
+                    Record record = { "threads",
+                                      container.d_name,
+                                      strategy.d_name,
+                                      shared ? "shared" : "local",
+                                      numThreads,
+                                      k_THREADS_SIZE,
+                                      "all",
+                                      static_cast<bsls::Types::Int64>(
+                                                                 numThreads)
+                                          * numRepetitions * k_THREADS_SIZE };
+                    reporter->report(record, samples, config.d_repeat);
+                }
+            }
+        }
+    }
+}
+
+// ============================================================================
+//                             COMMAND LINE
+// ----------------------------------------------------------------------------
+
+void printUsage()
+    // Write the usage of this program to the standard error.
+{
+    bsl::fprintf(stderr,
+                 "usage: allocbench [--format csv|json]"
+                 " [--workload churn|fragment|threads|all]\n"
+                 "                  [--strategy NAME]... [--container NAME]..."
+                 " [--scale N]\n"
+                 "                  [--repeat N] [--max-threads N] [--list]"
+                 " [--help]\n");
+}
+
+int findName(const char *name, bool isStrategy)
+    // Return the index of the strategy (if the specified 'isStrategy' is
+    // 'true') or container having the specified 'name', or -1 if there is no
+    // such strategy or container.
+{
+    const int n = isStrategy ? NUM_STRATEGIES : NUM_CONTAINERS;
+    for (int i = 0; i < n; ++i) {
+        if (0 == bsl::strcmp(name, isStrategy ? STRATEGIES[i].d_name
+                                              : CONTAINERS[i].d_name)) {
+            return i;                                                 // RETURN
+        }
+    }
+    return -1;
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    Format      format   = e_CSV;
+    const char *workload = "all";
+
+    Config config;
+    config.d_scale      = 20;
+    config.d_repeat     = 3;
+    config.d_maxThreads = bsl::max(
+                  4,
+                  static_cast<int>(bslmt::ThreadUtil::hardwareConcurrency()));
+
+    for (int i = 1; i < argc; ++i) {
+        const char *option = argv[i];
+        const char *value  = i + 1 < argc ? argv[i + 1] : 0;
+
+        if (0 == bsl::strcmp(option, "--help")) {
+            printUsage();
+            return 0;                                                 // RETURN
+        }
+        if (0 == bsl::strcmp(option, "--list")) {
+            for (int s = 0; s < NUM_STRATEGIES; ++s) {
+                bsl::printf("strategy  %s\n", STRATEGIES[s].d_name);
+            }
+            for (int c = 0; c < NUM_CONTAINERS; ++c) {
+                bsl::printf("container %s\n", CONTAINERS[c].d_name);
+            }
+            return 0;                                                 // RETURN
+        }
+        if (!value) {
+            printUsage();
+            return 1;                                                 // RETURN
+        }
+        ++i;
+
+        if (0 == bsl::strcmp(option, "--format")) {
+            if (0 == bsl::strcmp(value, "csv")) {
+                format = e_CSV;
+            }
+            else if (0 == bsl::strcmp(value, "json")) {
+                format = e_JSON;
+            }
+            else {
+                printUsage();
+                return 1;                                             // RETURN
+            }
+        }
+        else if (0 == bsl::strcmp(option, "--workload")) {
+            workload = value;
+        }
+        else if (0 == bsl::strcmp(option, "--strategy")
+              || 0 == bsl::strcmp(option, "--container")) {
+            const bool isStrategy = 0 == bsl::strcmp(option, "--strategy");
+            const int  index      = findName(value, isStrategy);
+            if (index < 0) {
+                bsl::fprintf(stderr,
+                             "allocbench: unknown %s '%s'\n",
+                             isStrategy ? "strategy" : "container",
+                             value);
+                return 1;                                             // RETURN
+            }
+            (isStrategy ? config.d_strategies
+                        : config.d_containers).push_back(index);
+        }
+        else if (0 == bsl::strcmp(option, "--scale")) {
+            config.d_scale = bsl::atoi(value);
+        }
+        else if (0 == bsl::strcmp(option, "--repeat")) {
+            config.d_repeat = bsl::atoi(value);
+        }
+        else if (0 == bsl::strcmp(option, "--max-threads")) {
+            config.d_maxThreads = bsl::atoi(value);
+        }
+        else {
+            printUsage();
+            return 1;                                                 // RETURN
+        }
+    }
+
+    if (config.d_scale < 4 || 28 < config.d_scale
+     || config.d_repeat < 1 || k_MAX_SAMPLES < config.d_repeat
+     || config.d_maxThreads < 1) {
+        bsl::fprintf(stderr, "allocbench: option value out of range\n");
+        return 1;                                                     // RETURN
+    }
+
+    if (config.d_strategies.empty()) {
+        for (int s = 0; s < NUM_STRATEGIES; ++s) {
+            config.d_strategies.push_back(s);
+        }
+    }
+    if (config.d_containers.empty()) {
+        for (int c = 0; c < NUM_CONTAINERS; ++c) {
+            config.d_containers.push_back(c);
+        }
+    }
+
+    const bool all = 0 == bsl::strcmp(workload, "all");
+    if (!all
+     && 0 != bsl::strcmp(workload, "churn")
+     && 0 != bsl::strcmp(workload, "fragment")
+     && 0 != bsl::strcmp(workload, "threads")) {
+        printUsage();
+        return 1;                                                     // RETURN
+    }
+
+    bsls::TimeUtil::initialize();
+
+    // The 'fragment' workload inserts up to twice as many distinct keys as
+    // there are operations per sample.
+
+    const Data data(2 << config.d_scale);
+    Reporter   reporter(format);
+
+    if (all || 0 == bsl::strcmp(workload, "churn")) {
+        runChurn(&reporter, config, data);
+    }
+    if (all || 0 == bsl::strcmp(workload, "fragment")) {
+        runFragment(&reporter, config, data);
+    }
+    if (all || 0 == bsl::strcmp(workload, "threads")) {
+        runThreads(&reporter, config, data);
+    }
+
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
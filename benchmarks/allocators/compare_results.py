@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""Compare two result files of 'allocbench' and report regressions.
+
+usage: compare_results.py [--threshold PERCENT] BASELINE CURRENT
+
+Each file is the CSV or JSON Lines output of 'allocbench'.  Measurements are
+matched on their 'workload', 'container', 'strategy', 'sharing', 'threads',
+'size', and 'phase' fields, and the median times are compared.  Every
+measurement whose median time increased by more than the threshold (default
+10 percent) is reported, and the exit status is 1 if there is any such
+regression, and 0 otherwise.
+"""
+
+import argparse
+import csv
+import json
+import sys
+
+KEY_FIELDS = ('workload', 'container', 'strategy', 'sharing', 'threads',
+              'size', 'phase')
+
+
+def load(path):
+    """Return a dictionary mapping the key of each record in the file at the
+    specified 'path' to its median time in seconds."""
+    with open(path) as f:
+        text = f.read()
+    if text.lstrip().startswith('{'):
+        records = [json.loads(line) for line in text.splitlines() if line]
+    else:
+        records = list(csv.DictReader(text.splitlines()))
+    return {tuple(str(r[k]) for k in KEY_FIELDS): float(r['median_seconds'])
+            for r in records}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--threshold', type=float, default=10.0)
+    parser.add_argument('baseline')
+    parser.add_argument('current')
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    regressions = 0
+    for key in sorted(set(baseline) & set(current)):
+        before, after = baseline[key], current[key]
+        if before <= 0:
+            continue
+        change = (after - before) / before * 100
+        if change > args.threshold:
+            regressions += 1
+            print('REGRESSION %+7.1f%%  %s' % (change, ' '.join(key)))
+
+    missing = sorted(set(baseline) - set(current))
+    for key in missing:
+        print('MISSING             %s' % ' '.join(key))
+
+    print('%d measurements compared, %d regressions, %d missing'
+          % (len(set(baseline) & set(current)), regressions, len(missing)))
+    return 1 if regressions else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
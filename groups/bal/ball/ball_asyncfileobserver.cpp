@@ -19,21 +19,42 @@ BSLS_IDENT_RCSID(ball_asyncfileobserver_cpp,"$Id$ $CSID$")
 #include <bslmt_threadattributes.h>
 
 #include <bsls_assert.h>
+#include <bsls_performancehint.h>
+#include <bsls_types.h>
 
 #include <bsl_functional.h>
 #include <bsl_memory.h>
 #include <bsl_ostream.h>
+#include <bsl_vector.h>
 
 ///IMPLEMENTATION NOTES
 ///--------------------
 // To guarantee that the publication thread sees the 'd_shuttingDownFlag', a
-// ('ball::Transmission::e_END') record is appended to the queue; otherwise,
-// the thread may be blocked indefinitely on 'popFront'.  Unfortunately, that
-// potentially leaves a bogus record in the queue after the publication thread
-// is shut down.  To avoid having to deal with that 'e_END' record when the
-// thread is restarted, 'shutdownThread' clears the queue in order to simplify
-// the implementation.  Alternative designs are possible, but are not perceived
-// to be worth the added complexity.
+// ('ball::Transmission::e_END') record is appended to each shard of the
+// queue; otherwise, the thread may be blocked indefinitely waiting for
+// records.  Unfortunately, that potentially leaves bogus records in the queue
+// after the publication thread is shut down.  To avoid having to deal with
+// those 'e_END' records when the thread is restarted, 'shutdownThread' clears
+// the queue in order to simplify the implementation.  Alternative designs are
+// possible, but are not perceived to be worth the added complexity.
+//
+// The publication thread stops removing records from a shard once it has
+// removed the 'e_END' record of that shard, and exits once it has removed the
+// 'e_END' record of every shard.  Since each shard is FIFO, all records that
+// were in a shard when 'stopThread' appended the 'e_END' record to that shard
+// are published before the thread exits.  Note that records removed in the
+// same batch as an 'e_END' record are published as well.
+//
+// The publication thread removes records from the shards without blocking,
+// and waits on 'd_recordsAvailableSemaphore' when all shards are empty.  The
+// wait is coordinated with 'publish' using 'd_publisherWaitingFlag': the
+// publication thread sets the flag before checking (for a final time) that
+// the shards are empty, and 'publish' checks the flag after appending a
+// record to a shard, posting the semaphore if it resets the flag.  As both
+// the flag and the indices of the shards are accessed with sequential
+// consistency, either the publication thread sees the appended record, or
+// 'publish' sees the flag (or both).  The latter may leave an extra post on
+// the semaphore, which results in a (harmless) spurious wakeup.
 
 namespace BloombergLP {
 namespace ball {
@@ -42,7 +63,9 @@ namespace {
 
 enum {
     k_DEFAULT_FIXED_QUEUE_SIZE = 8192,
-    k_FORCE_WARN_THRESHOLD     = 5000
+    k_FORCE_WARN_THRESHOLD     = 5000,
+    k_PUBLISH_BATCH_SIZE       = 64    // maximum number of records removed
+                                       // from a shard at once
 };
 
 static const char *const k_LOG_CATEGORY = "BALL.ASYNCFILEOBSERVER";
@@ -61,6 +84,21 @@ static void populateWarnRecord(ball::Record *record,
     os << "Dropped " << numDropped << " log records." << bsl::ends;
 }
 
+static bsl::size_t shardIndex(bsls::Types::Uint64 threadId,
+                              bsl::size_t         numShards)
+    // Return the index, in the range '[0 .. numShards)', of the record queue
+    // shard for records having the specified 'threadId', given the specified
+    // 'numShards'.  The behavior is undefined unless '0 < numShards'.
+{
+    // Thread ids are frequently aligned addresses, so spread the bits (using
+    // Fibonacci hashing) before reducing modulo 'numShards'.
+
+    const bsls::Types::Uint64 k_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+
+    return static_cast<bsl::size_t>((threadId * k_MULTIPLIER) >> 32)
+                                                                 % numShards;
+}
+
 }  // close unnamed namespace
 
                        // -----------------------
@@ -81,41 +119,85 @@ void AsyncFileObserver::logDroppedMessageWarning(int numDropped)
 
 void AsyncFileObserver::publishThreadEntryPoint()
 {
-    bool done = false;
     d_droppedRecordWarning.fixedFields().setThreadID(
                                           bslmt::ThreadUtil::selfIdAsUint64());
 
+    const bsl::size_t numShards = d_recordQueues.size();
+
+    int totalCapacity = 0;
+    for (bsl::size_t i = 0; i < numShards; ++i) {
+        totalCapacity += d_recordQueues[i]->size();
+    }
+
+    bsl::vector<AsyncFileObserver_Record> records(d_allocator_p);
+    records.reserve(k_PUBLISH_BATCH_SIZE);
+
+    bsl::vector<char> isShardStopped(numShards, 0, d_allocator_p);
+    bsl::size_t       numStoppedShards = 0;
+
+    bool done = false;
+
     while (!done) {
-        AsyncFileObserver_Record asyncRecord = d_recordQueue.popFront();
+        bool isAnyPopped = false;
 
-        // Publish the next log record on the queue only if the observer is not
-        // shutting down.
+        for (bsl::size_t i = 0; i < numShards && !done; ++i) {
+            if (isShardStopped[i]
+             || 0 != d_recordQueues[i]->tryPopFront(k_PUBLISH_BATCH_SIZE,
+                                                     &records)) {
+                continue;                                           // CONTINUE
+            }
+            isAnyPopped = true;
+
+            for (bsl::size_t j = 0; j < records.size(); ++j) {
+                // Publish the next log record only if the observer is not
+                // shutting down.
+
+                if (d_shuttingDownFlag) {
+                    done = true;
+                    break;                                             // BREAK
+                }
+
+                const AsyncFileObserver_Record& asyncRecord = records[j];
+
+                if (Transmission::e_END ==
+                                 asyncRecord.d_context.transmissionCause()) {
+                    isShardStopped[i] = 1;
+                    if (++numStoppedShards == numShards) {
+                        done = true;
+                    }
+                }
+                else {
+                    d_fileObserver.publish(*asyncRecord.d_record,
+                                           asyncRecord.d_context);
+                }
+            }
 
-        if (Transmission::e_END == asyncRecord.d_context.transmissionCause()
-            || d_shuttingDownFlag) {
-            done = true;
-        }
-        else {
-            d_fileObserver.publish(*asyncRecord.d_record,
-                                   asyncRecord.d_context);
+            // Release the published records (and the references to them)
+            // before waiting for more.
+
+            records.clear();
+
+            // Publish the count of dropped records.  To avoid repeatedly
+            // publishing this information when the record queue is full, we
+            // publish the number of dropped records only when the queue
+            // becomes half empty or when a sufficient number of records have
+            // been dropped.  Finally, we publish the dropped record count if
+            // the observer is shutting down, so the information is not lost.
+
+            if (0 < d_dropCount.loadRelaxed()) {
+                if (recordQueueLength() <= totalCapacity / 2
+                ||  d_dropCount.loadRelaxed() >= k_FORCE_WARN_THRESHOLD
+                ||  d_shuttingDownFlag) {
+                    int numDropped = d_dropCount.swap(0);
+                    BSLS_ASSERT(0 < numDropped); // No other thread should
+                                                 // have cleared the count.
+                    logDroppedMessageWarning(numDropped);
+                }
+            }
         }
 
-        // Publish the count of dropped records.  To avoid repeatedly
-        // publishing this information when the record queue is full, we
-        // publish the number of dropped records only when the queue becomes
-        // half empty or when a sufficient number of records have been dropped.
-        // Finally, we publish the dropped record count if the observer is
-        // shutting down, so the information is not lost.
-
-        if (0 < d_dropCount.loadRelaxed()) {
-            if (d_recordQueue.length() <= d_recordQueue.size() / 2
-            ||  d_dropCount.loadRelaxed() >= k_FORCE_WARN_THRESHOLD
-            ||  d_shuttingDownFlag) {
-                int numDropped = d_dropCount.swap(0);
-                BSLS_ASSERT(0 < numDropped); // No other thread should have
-                                             // cleared the count.
-                logDroppedMessageWarning(numDropped);
-            }
+        if (!done && !isAnyPopped) {
+            waitForRecords(isShardStopped);
         }
     }
 }
@@ -144,7 +226,19 @@ int AsyncFileObserver::stopThread()
         Context context(Transmission::e_END, 0, 1);
         asyncRecord.d_record  = record;
         asyncRecord.d_context = context;
-        d_recordQueue.pushBack(asyncRecord);
+        for (bsl::size_t i = 0; i < d_recordQueues.size(); ++i) {
+            if (d_shuttingDownFlag) {
+                // The publication thread exits upon removing any record, so
+                // it is sufficient (and necessary, as the thread may have
+                // exited) not to block on a full shard.
+
+                d_recordQueues[i]->tryPushBack(asyncRecord);
+            }
+            else {
+                d_recordQueues[i]->pushBack(asyncRecord);
+            }
+            wakePublicationThread();
+        }
 
         int ret = bslmt::ThreadUtil::join(d_threadHandle);
         d_threadHandle = bslmt::ThreadUtil::invalidHandle();
@@ -163,19 +257,73 @@ int AsyncFileObserver::shutdownThread()
 
     int ret = stopThread();
 
-    // We clear the queue to remove the bogus log record appended by
+    // We clear the queue to remove the bogus log records appended by
     // 'stopThread'.
 
-    d_recordQueue.removeAll();
+    for (bsl::size_t i = 0; i < d_recordQueues.size(); ++i) {
+        d_recordQueues[i]->removeAll();
+    }
+
+    // Discard any post left on the semaphore by 'publish' (see implementation
+    // note).
+
+    while (0 == d_recordsAvailableSemaphore.tryWait()) {
+    }
+
     d_shuttingDownFlag = 0;
     return ret;
 }
 
-void AsyncFileObserver::construct()
+void AsyncFileObserver::waitForRecords(const bsl::vector<char>& isShardStopped)
 {
-    d_threadHandle     = bslmt::ThreadUtil::invalidHandle();
-    d_shuttingDownFlag = 0;
-    d_dropCount        = 0;
+    d_publisherWaitingFlag = 1;
+
+    bool isEmpty = true;
+    for (bsl::size_t i = 0; i < d_recordQueues.size() && isEmpty; ++i) {
+        isEmpty = isShardStopped[i] || d_recordQueues[i]->isEmpty();
+    }
+
+    if (isEmpty) {
+        d_recordsAvailableSemaphore.wait();
+    }
+    else {
+        // A record was appended since the shards were last checked, or is
+        // still being appended (in which case it cannot be removed yet).
+
+        bslmt::ThreadUtil::yield();
+    }
+
+    d_publisherWaitingFlag = 0;
+}
+
+void AsyncFileObserver::wakePublicationThread()
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(d_publisherWaitingFlag)
+     && 1 == d_publisherWaitingFlag.testAndSwap(1, 0)) {
+        d_recordsAvailableSemaphore.post();
+    }
+}
+
+void AsyncFileObserver::construct(int maxRecordQueueSize,
+                                  int numRecordQueueShards)
+{
+    BSLS_ASSERT(0 < numRecordQueueShards);
+    BSLS_ASSERT(numRecordQueueShards <= maxRecordQueueSize);
+
+    d_threadHandle         = bslmt::ThreadUtil::invalidHandle();
+    d_shuttingDownFlag     = 0;
+    d_publisherWaitingFlag = 0;
+    d_dropCount            = 0;
+
+    const int shardSize = (maxRecordQueueSize + numRecordQueueShards - 1)
+                                                       / numRecordQueueShards;
+
+    d_recordQueues.reserve(numRecordQueueShards);
+    for (int i = 0; i < numRecordQueueShards; ++i) {
+        bsl::shared_ptr<RecordQueue> queue;
+        queue.createInplace(d_allocator_p, shardSize, d_allocator_p);
+        d_recordQueues.push_back(queue);
+    }
 
     d_publishThreadEntryPoint = bsl::function<void()>(
             bsl::allocator_arg_t(),
@@ -192,38 +340,38 @@ void AsyncFileObserver::construct()
 // CREATORS
 AsyncFileObserver::AsyncFileObserver(bslma::Allocator *basicAllocator)
 : d_fileObserver(Severity::e_WARN, basicAllocator)
-, d_recordQueue(k_DEFAULT_FIXED_QUEUE_SIZE, basicAllocator)
+, d_recordQueues(basicAllocator)
 , d_shuttingDownFlag(0)
 , d_dropRecordsOnFullQueueThreshold(Severity::e_OFF)
 , d_droppedRecordWarning(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
-    construct();
+    construct(k_DEFAULT_FIXED_QUEUE_SIZE, 1);
 }
 
 AsyncFileObserver::AsyncFileObserver(Severity::Level   stdoutThreshold,
                                      bslma::Allocator *basicAllocator)
 : d_fileObserver(stdoutThreshold, basicAllocator)
-, d_recordQueue(k_DEFAULT_FIXED_QUEUE_SIZE, basicAllocator)
+, d_recordQueues(basicAllocator)
 , d_shuttingDownFlag(0)
 , d_dropRecordsOnFullQueueThreshold(Severity::e_OFF)
 , d_droppedRecordWarning(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
-    construct();
+    construct(k_DEFAULT_FIXED_QUEUE_SIZE, 1);
 }
 
 AsyncFileObserver::AsyncFileObserver(Severity::Level   stdoutThreshold,
                                      bool              publishInLocalTime,
                                      bslma::Allocator *basicAllocator)
 : d_fileObserver(stdoutThreshold, publishInLocalTime, basicAllocator)
-, d_recordQueue(k_DEFAULT_FIXED_QUEUE_SIZE, basicAllocator)
+, d_recordQueues(basicAllocator)
 , d_shuttingDownFlag(0)
 , d_dropRecordsOnFullQueueThreshold(Severity::e_OFF)
 , d_droppedRecordWarning(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
-    construct();
+    construct(k_DEFAULT_FIXED_QUEUE_SIZE, 1);
 }
 
 AsyncFileObserver::AsyncFileObserver(Severity::Level   stdoutThreshold,
@@ -231,29 +379,46 @@ AsyncFileObserver::AsyncFileObserver(Severity::Level   stdoutThreshold,
                                      int               maxRecordQueueSize,
                                      bslma::Allocator *basicAllocator)
 : d_fileObserver(stdoutThreshold, publishInLocalTime, basicAllocator)
-, d_recordQueue(maxRecordQueueSize, basicAllocator)
+, d_recordQueues(basicAllocator)
 , d_shuttingDownFlag(0)
 , d_dropRecordsOnFullQueueThreshold(Severity::e_OFF)
 , d_droppedRecordWarning(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
-    construct();
+    construct(maxRecordQueueSize, 1);
+}
+
+AsyncFileObserver::AsyncFileObserver(
+                             Severity::Level   stdoutThreshold,
+                             bool              publishInLocalTime,
+                             int               maxRecordQueueSize,
+                             Severity::Level   dropRecordsOnFullQueueThreshold,
+                             bslma::Allocator *basicAllocator)
+: d_fileObserver(stdoutThreshold, publishInLocalTime, basicAllocator)
+, d_recordQueues(basicAllocator)
+, d_shuttingDownFlag(0)
+, d_dropRecordsOnFullQueueThreshold(dropRecordsOnFullQueueThreshold)
+, d_droppedRecordWarning(basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    construct(maxRecordQueueSize, 1);
 }
 
 AsyncFileObserver::AsyncFileObserver(
                              Severity::Level   stdoutThreshold,
                              bool              publishInLocalTime,
                              int               maxRecordQueueSize,
+                             int               numRecordQueueShards,
                              Severity::Level   dropRecordsOnFullQueueThreshold,
                              bslma::Allocator *basicAllocator)
 : d_fileObserver(stdoutThreshold, publishInLocalTime, basicAllocator)
-, d_recordQueue(maxRecordQueueSize, basicAllocator)
+, d_recordQueues(basicAllocator)
 , d_shuttingDownFlag(0)
 , d_dropRecordsOnFullQueueThreshold(dropRecordsOnFullQueueThreshold)
 , d_droppedRecordWarning(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
-    construct();
+    construct(maxRecordQueueSize, numRecordQueueShards);
 }
 
 AsyncFileObserver::~AsyncFileObserver()
@@ -272,14 +437,25 @@ void AsyncFileObserver::publish(const bsl::shared_ptr<const Record>& record,
     asyncRecord.d_record  = record;
     asyncRecord.d_context = context;
 
+    const bsl::size_t numShards = d_recordQueues.size();
+
+    RecordQueue& queue = 1 == numShards
+                       ? *d_recordQueues.front()
+                       : *d_recordQueues[shardIndex(
+                                              record->fixedFields().threadID(),
+                                              numShards)];
+
     if (record->fixedFields().severity() > d_dropRecordsOnFullQueueThreshold) {
-        if (0 != d_recordQueue.tryPushBack(asyncRecord)) {
+        if (0 != queue.tryPushBack(asyncRecord)) {
             d_dropCount.addRelaxed(1);
+            return;                                                   // RETURN
         }
     }
     else {
-        d_recordQueue.pushBack(asyncRecord);
+        queue.pushBack(asyncRecord);
     }
+
+    wakePublicationThread();
 }
 
 void AsyncFileObserver::releaseRecords()
@@ -290,7 +466,9 @@ void AsyncFileObserver::releaseRecords()
         startThread();
     }
     else {
-        d_recordQueue.removeAll();
+        for (bsl::size_t i = 0; i < d_recordQueues.size(); ++i) {
+            d_recordQueues[i]->removeAll();
+        }
     }
 }
 
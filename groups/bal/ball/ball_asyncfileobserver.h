@@ -58,6 +58,7 @@ BSLS_IDENT("$Id: $")
 //                         |              isPublicationThreadRunning
 //                         |              isPublishInLocalTimeEnabled
 //                         |              isStdoutLoggingPrefixEnabled
+//                         |              numRecordQueueShards
 //                         |              recordQueueLength
 //                         |              rotationLifetime
 //                         |              rotationSize
@@ -95,6 +96,7 @@ BSLS_IDENT("$Id: $")
 // | 'stdout' Logging      | stdoutThreshold                 |
 // +-----------------------+---------------------------------+
 // | Log Record Queue      | maxRecordQueueSize              |
+// |                       | numRecordQueueShards            |
 // |                       | dropRecordsOnFullQueueThreshold |
 // +-----------------------+---------------------------------+
 //
@@ -164,6 +166,24 @@ BSLS_IDENT("$Id: $")
 // record count is reset to 0 after each such warning is published, so each
 // dropped record is counted only once.
 //
+///Record Queue Shards
+/// - - - - - - - - -
+// By default, the record queue is a single queue shared by every thread that
+// publishes to the async file observer.  When many threads publish
+// concurrently, they contend on that queue.  The 'numRecordQueueShards'
+// constructor argument may be used to split the record queue into that many
+// independent queues ("shards"), each having a maximum size of
+// 'maxRecordQueueSize / numRecordQueueShards' (rounded up).  A record is
+// appended to the shard selected by the thread id of the record (see
+// 'ball::RecordAttributes::threadID'), so the records of each thread are
+// published in the order they were received, but records of different
+// threads are not necessarily published in the order they were received.
+// The publication thread removes records from the shards in batches.  Note
+// that the queue-full behavior described above applies to each shard
+// individually: a record may be dropped (or 'publish' may block) when the
+// shard selected for the record is full, even if other shards have spare
+// capacity.
+//
 ///Log Record Formatting
 ///---------------------
 // By default, the output format of published log records (whether to 'stdout'
@@ -480,6 +500,7 @@ BSLS_IDENT("$Id: $")
 
 #include <bslmf_nestedtraitdeclaration.h>
 
+#include <bslmt_semaphore.h>
 #include <bslmt_threadutil.h>
 
 #include <bsls_atomic.h>
@@ -487,6 +508,7 @@ BSLS_IDENT("$Id: $")
 #include <bsl_functional.h>
 #include <bsl_memory.h>
 #include <bsl_string.h>
+#include <bsl_vector.h>
 
 namespace BloombergLP {
 namespace ball {
@@ -515,6 +537,9 @@ class AsyncFileObserver : public Observer {
     // can operate on an object concurrently.  This class is exception-neutral
     // with no guarantee of rollback.  In no event is memory leaked.
 
+    // PRIVATE TYPES
+    typedef bdlcc::FixedQueue<AsyncFileObserver_Record> RecordQueue;
+
     // DATA
     FileObserver                   d_fileObserver;   // forward most public
                                                      // method calls to this
@@ -524,10 +549,23 @@ class AsyncFileObserver : public Observer {
     bslmt::ThreadUtil::Handle      d_threadHandle;   // handle of asynchronous
                                                      // publication thread
 
-    bdlcc::FixedQueue<AsyncFileObserver_Record>
-                                   d_recordQueue;    // fixed-size queue of
-                                                     // records processed by
-                                                     // the publication thread
+    bsl::vector<bsl::shared_ptr<RecordQueue> >
+                                   d_recordQueues;   // shards of the record
+                                                     // queue; fixed-size
+                                                     // queues of records
+                                                     // processed by the
+                                                     // publication thread
+
+    bslmt::Semaphore               d_recordsAvailableSemaphore;
+                                                     // semaphore on which the
+                                                     // publication thread
+                                                     // waits for records
+
+    bsls::AtomicInt                d_publisherWaitingFlag;
+                                                     // flag that indicates the
+                                                     // publication thread is
+                                                     // waiting, or about to
+                                                     // wait, for records
 
     bsls::AtomicInt                d_shuttingDownFlag;
                                                      // flag that indicates the
@@ -566,10 +604,15 @@ class AsyncFileObserver : public Observer {
     AsyncFileObserver& operator=(const AsyncFileObserver&);
 
     // PRIVATE MANIPULATORS
-    void construct();
+    void construct(int maxRecordQueueSize, int numRecordQueueShards);
         // Initialize members of this object that do not vary between
-        // constructor overloads.  Note that this method should be removed when
-        // C++11 constructor chaining is available on all supported platforms.
+        // constructor overloads, creating the specified 'numRecordQueueShards'
+        // record queue shards having a total capacity of (at least) the
+        // specified 'maxRecordQueueSize'.  The behavior is undefined unless
+        // '0 < numRecordQueueShards' and
+        // 'numRecordQueueShards <= maxRecordQueueSize'.  Note that this method
+        // should be removed when C++11 constructor chaining is available on
+        // all supported platforms.
 
     void logDroppedMessageWarning(int numDropped);
         // Synchronously log a record to the underlying file observer
@@ -606,6 +649,17 @@ class AsyncFileObserver : public Observer {
         // publication thread.  The behavior is undefined unless the calling
         // thread holds a lock on 'd_mutex'.
 
+    void waitForRecords(const bsl::vector<char>& isShardStopped);
+        // Block until a record may be available in a record queue shard for
+        // which the corresponding element of the specified 'isShardStopped'
+        // is 0.  Spurious wakeups are possible.  The behavior is undefined
+        // unless this method is invoked from the publication thread.
+
+    void wakePublicationThread();
+        // Wake the publication thread if it is waiting for records.  Note
+        // that this method must be called after a record is appended to a
+        // record queue shard.
+
   public:
     // TYPES
     typedef FileObserver::OnFileRotationCallback OnFileRotationCallback;
@@ -695,6 +749,36 @@ class AsyncFileObserver : public Observer {
         // used.  Note that independent default record formats are in effect
         // for 'stdout' and file logging (see 'setLogFormat').
 
+    AsyncFileObserver(Severity::Level   stdoutThreshold,
+                      bool              publishInLocalTime,
+                      int               maxRecordQueueSize,
+                      int               numRecordQueueShards,
+                      Severity::Level   dropRecordsOnFullQueueThreshold,
+                      bslma::Allocator *basicAllocator = 0);
+        // Create an async file observer that asynchronously publishes log
+        // records to 'stdout' if their severity is at least as severe as the
+        // specified 'stdoutThreshold' level, and has file logging initially
+        // disabled.  The timestamp attribute of published records is written
+        // in local time if the specified 'publishInLocalTime' flag is 'true',
+        // and in UTC time otherwise.  Records received by the 'publish' method
+        // are appended to one of the specified 'numRecordQueueShards' queue
+        // shards, each having a (fixed) size of the specified
+        // 'maxRecordQueueSize' divided by 'numRecordQueueShards' (rounded up),
+        // and published later by an independent publication thread.  Records
+        // received when the selected shard is full are discarded if their
+        // severity is below the specified 'dropRecordsOnFullQueueThreshold',
+        // and block the calling thread until space is available otherwise.
+        // (See {Log Record Queue} and {Record Queue Shards} for further
+        // information.)  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  The behavior is undefined unless
+        // '0 < numRecordQueueShards' and
+        // 'numRecordQueueShards <= maxRecordQueueSize'.  Note that supplying
+        // 'Severity::e_OFF' for 'dropRecordsOnFullQueueThreshold' discards all
+        // records received while the selected shard is full.  Also note that
+        // independent default record formats are in effect for 'stdout' and
+        // file logging (see 'setLogFormat').
+
     ~AsyncFileObserver();
         // Publish all records that were on the record queue upon entry if a
         // publication thread is running, stop the publication thread (if any),
@@ -955,9 +1039,13 @@ class AsyncFileObserver : public Observer {
         // !DEPRECATED!: Use 'bdlt::LocalTimeOffset' instead.
 #endif // BDE_OMIT_INTERNAL_DEPRECATED
 
+    int numRecordQueueShards() const;
+        // Return the number of shards of the record queue of this async file
+        // observer.  (See {Record Queue Shards}.)
+
     int recordQueueLength() const;
         // Return the number of log records currently on the record queue of
-        // this async file observer.
+        // this async file observer (summed over all of its shards).
 
     bdlt::DatetimeInterval rotationLifetime() const;
         // Return the log file lifetime that will trigger a file rotation by
@@ -1132,10 +1220,20 @@ bdlt::DatetimeInterval AsyncFileObserver::localTimeOffset() const
 }
 #endif // BDE_OMIT_INTERNAL_DEPRECATED
 
+inline
+int AsyncFileObserver::numRecordQueueShards() const
+{
+    return static_cast<int>(d_recordQueues.size());
+}
+
 inline
 int AsyncFileObserver::recordQueueLength() const
 {
-    return d_recordQueue.length();
+    int length = 0;
+    for (bsl::size_t i = 0; i < d_recordQueues.size(); ++i) {
+        length += d_recordQueues[i]->length();
+    }
+    return length;
 }
 
 inline
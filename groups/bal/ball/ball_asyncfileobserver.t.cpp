@@ -26,9 +26,12 @@
 #include <bslmf_nestedtraitdeclaration.h>
 
 #include <bsls_assert.h>
+#include <bsls_asserttest.h>
 #include <bsls_platform.h>
 #include <bsls_stopwatch.h>
+#include <bsls_timeutil.h>
 
+#include <bsl_algorithm.h>
 #include <bsl_climits.h>
 #include <bsl_cmath.h>
 #include <bsl_cstddef.h>
@@ -39,6 +42,7 @@
 #include <bsl_iomanip.h>     // 'setfill'
 #include <bsl_iostream.h>
 #include <bsl_sstream.h>
+#include <bsl_vector.h>
 
 #include <bsl_c_stdlib.h>    // 'unsetenv'
 
@@ -84,6 +88,7 @@ using bsl::flush;
 // [ X] AsyncFileObserver(ball::Severity::Level, bool, bslma::Allocator *);
 // [ 5] AsyncFileObserver(Severity::Level, bool, int, bslma::Allocator *);
 // [ 5] AsyncFileObserver(Severity, bool, int, Severity, Allocator *);
+// [12] AsyncFileObserver(Severity, bool, int, int, Severity, Allocator*);
 // [ 2] ~AsyncFileObserver();
 //
 // MANIPULATORS
@@ -118,6 +123,7 @@ using bsl::flush;
 // [ 1] bool isPublishInLocalTimeEnabled() const;
 // [ 1] bool isStdoutLoggingPrefixEnabled() const;
 // [ 1] bool isUserFieldsLoggingEnabled() const;
+// [12] int numRecordQueueShards() const;
 // [11] int recordQueueLength() const;
 // [ 6] bdlt::DatetimeInterval rotationLifetime() const;
 // [ 6] int rotationSize() const;
@@ -128,7 +134,9 @@ using bsl::flush;
 // [ 7] CONCERN: LOGGING TO A FAILING STREAM
 // [ 5] CONCERN: LOG MESSAGE DROP
 // [ 9] CONCERN: ROTATION
-// [12] USAGE EXAMPLE
+// [12] CONCERN: RECORD QUEUE SHARDS
+// [13] USAGE EXAMPLE
+// [-1] PERFORMANCE: CONCURRENT PUBLICATION
 
 // Note assert and debug macros all output to 'cerr' instead of cout, unlike
 // most other test drivers.  This is necessary because test case 2 plays tricks
@@ -605,6 +613,46 @@ extern "C" void *workerThread2(void *arg)
 
 }  // close namespace BALL_ASYNCFILEOBSERVER_TEST_CONCURRENCY
 
+namespace BALL_ASYNCFILEOBSERVER_TEST_PERFORMANCE {
+
+struct ThreadArgs {
+    // This 'struct' holds the arguments of, and the latencies measured by,
+    // 'publishThread'.
+
+    ball::AsyncFileObserver           *d_observer_p;    // observer
+    int                                d_numRecords;    // records to publish
+    bsl::vector<bsls::Types::Int64>    d_latencies;     // latency of each
+                                                        // 'publish' (in
+                                                        // nanoseconds)
+};
+
+extern "C" void *publishThread(void *arg)
+    // Publish the number of records indicated by the 'ThreadArgs' object
+    // addressed by the specified 'arg' to the observer it indicates, loading
+    // the latency of each 'publish' into the 'ThreadArgs' object.
+{
+    ThreadArgs& args = *static_cast<ThreadArgs *>(arg);
+
+    bsl::shared_ptr<ball::Record> record;
+    record.createInplace();
+    record->fixedFields().setSeverity(ball::Severity::e_INFO);
+    record->fixedFields().setThreadID(bslmt::ThreadUtil::selfIdAsUint64());
+    record->fixedFields().setMessage("performance test");
+
+    ball::Context context;
+
+    args.d_latencies.resize(args.d_numRecords);
+
+    for (int i = 0; i < args.d_numRecords; ++i) {
+        bsls::Types::Int64 start = bsls::TimeUtil::getTimer();
+        args.d_observer_p->publish(record, context);
+        args.d_latencies[i] = bsls::TimeUtil::getTimer() - start;
+    }
+    return 0;
+}
+
+}  // close namespace BALL_ASYNCFILEOBSERVER_TEST_PERFORMANCE
+
 //=============================================================================
 //                                 MAIN PROGRAM
 //-----------------------------------------------------------------------------
@@ -623,7 +671,7 @@ int main(int argc, char *argv[])
     bslma::TestAllocator *Z = &allocator;
 
     switch (test) { case 0:
-      case 12: {
+      case 13: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -775,6 +823,269 @@ int main(int argc, char *argv[])
 //..
 
       } break;
+      case 12: {
+        // --------------------------------------------------------------------
+        // TESTING RECORD QUEUE SHARDS
+        //
+        // Concerns:
+        //:  1 'numRecordQueueShards' returns 1 for an observer created without
+        //:    a number of record queue shards, and the supplied number
+        //:    otherwise.
+        //:
+        //:  2 Each shard has a capacity of the maximum record queue size
+        //:    divided (rounding up) by the number of shards, and records of
+        //:    the same thread are appended to the same shard.
+        //:
+        //:  3 Records of each thread are published in the order they were
+        //:    received.
+        //:
+        //:  4 'stopPublicationThread' publishes the records in every shard
+        //:    before stopping, and 'shutdownPublicationThread' discards them;
+        //:    the publication thread can be restarted in either case.
+        //:
+        //:  5 Records published concurrently by many threads are all
+        //:    written to the log file.
+        //:
+        //:  6 QoI: Asserted precondition violations are detected when
+        //:    enabled.
+        //
+        // Plan:
+        //:  1 Create observers with and without a number of shards and
+        //:    verify 'numRecordQueueShards'.  (C-1)
+        //:
+        //:  2 Publish, with no publication thread running, more records than
+        //:    a shard can hold, from one thread id, and then from many, and
+        //:    verify 'recordQueueLength'.  (C-2)
+        //:
+        //:  3 Publish sequenced records from several thread ids, stop the
+        //:    publication thread, and verify the log file contains every
+        //:    record, in order for each thread id.  Shut down the publication
+        //:    thread with records queued and verify the queue is emptied,
+        //:    then restart it.  (C-3..4)
+        //:
+        //:  4 Log from several threads through the logger manager to a
+        //:    sharded observer and count the records in the log file.  (C-5)
+        //:
+        //:  5 Verify that, in appropriate build modes, defensive checks are
+        //:    triggered for invalid numbers of shards (using the
+        //:    'BSLS_ASSERTTEST_*' macros).  (C-6)
+        //
+        // Testing:
+        //   AsyncFileObserver(Severity, bool, int, int, Severity, Allocator*);
+        //   int numRecordQueueShards() const;
+        //   CONCERN: RECORD QUEUE SHARDS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING RECORD QUEUE SHARDS."
+                          << "\n============================" << endl;
+
+        const ball::Severity::Level OFF   = ball::Severity::e_OFF;
+        const ball::Severity::Level ERROR = ball::Severity::e_ERROR;
+
+        if (veryVerbose) cout << "\tTesting 'numRecordQueueShards'" << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+            Obj mX(&ta);  const Obj& X = mX;
+            ASSERT(1 == X.numRecordQueueShards());
+
+            Obj mY(OFF, false, 100, ERROR, &ta);  const Obj& Y = mY;
+            ASSERT(1 == Y.numRecordQueueShards());
+
+            Obj mZ(OFF, false, 100, 7, ERROR, &ta);  const Obj& Z = mZ;
+            ASSERT(7 == Z.numRecordQueueShards());
+        }
+
+        if (veryVerbose) cout << "\tTesting shard capacity" << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+            enum { k_QUEUE_SIZE = 100, k_NUM_SHARDS = 8, k_SHARD_SIZE = 13 };
+
+            Obj mX(OFF, false, k_QUEUE_SIZE, k_NUM_SHARDS, OFF, &ta);
+            const Obj& X = mX;
+
+            bsl::shared_ptr<ball::Record> record;
+            record.createInplace(&ta);
+            record->fixedFields().setSeverity(ERROR);
+            record->fixedFields().setThreadID(1);
+            ball::Context context;
+
+            for (int i = 0; i < 2 * k_SHARD_SIZE; ++i) {
+                mX.publish(record, context);
+            }
+            ASSERTV(X.recordQueueLength(),
+                    k_SHARD_SIZE == X.recordQueueLength());
+
+            // Records of other threads are appended to other shards.
+
+            for (int i = 2; i < 1000; ++i) {
+                bsl::shared_ptr<ball::Record> other;
+                other.createInplace(&ta, *record, &ta);
+                other->fixedFields().setThreadID(i * 4096);
+                mX.publish(other, context);
+            }
+            ASSERTV(X.recordQueueLength(),
+                    k_SHARD_SIZE <  X.recordQueueLength());
+            ASSERTV(X.recordQueueLength(),
+                    k_NUM_SHARDS * k_SHARD_SIZE >= X.recordQueueLength());
+
+            mX.releaseRecords();
+            ASSERT(0 == X.recordQueueLength());
+        }
+
+        if (veryVerbose) cout << "\tTesting per-thread ordering" << endl;
+        {
+            TempDirectoryGuard tempDirGuard;
+
+            bsl::string fileName(tempDirGuard.getTempDirName());
+            bdls::PathUtil::appendRaw(&fileName, "testLog");
+
+            bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+            enum { k_NUM_THREAD_IDS = 5, k_NUM_RECORDS = 200 };
+
+            // Set up a blocking async observer.
+
+            Obj mX(OFF, false, 4096, 4, ball::Severity::e_TRACE, &ta);
+            const Obj& X = mX;
+
+            mX.setLogFormat("%t %m\n", "%t %m\n");
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+            // Queue records before starting the publication thread, so that
+            // 'stopPublicationThread' must drain every shard.
+
+            ball::Context context;
+
+            for (int i = 0; i < k_NUM_RECORDS; ++i) {
+                if (k_NUM_RECORDS / 4 == i) {
+                    ASSERT(0 == mX.startPublicationThread());
+                }
+                for (int t = 1; t <= k_NUM_THREAD_IDS; ++t) {
+                    bsl::ostringstream message;
+                    message << i;
+
+                    bsl::shared_ptr<ball::Record> record;
+                    record.createInplace(&ta, &ta);
+                    record->fixedFields().setSeverity(ERROR);
+                    record->fixedFields().setThreadID(t);
+                    record->fixedFields().setMessage(message.str().c_str());
+                    mX.publish(record, context);
+                }
+            }
+
+            ASSERT(0 == mX.stopPublicationThread());
+            ASSERT(0 == X.recordQueueLength());
+
+            mX.disableFileLogging();
+
+            bsl::vector<int> lastSequence(k_NUM_THREAD_IDS + 1, -1);
+            int              numLines = 0;
+
+            bsl::ifstream fs(fileName.c_str());
+            ASSERT(fs.is_open());
+
+            int threadId;
+            int sequence;
+            while (fs >> threadId >> sequence) {
+                ++numLines;
+                ASSERTV(threadId, 1 <= threadId);
+                ASSERTV(threadId, k_NUM_THREAD_IDS >= threadId);
+                if (1 <= threadId && k_NUM_THREAD_IDS >= threadId) {
+                    ASSERTV(threadId,
+                            lastSequence[threadId],
+                            sequence,
+                            lastSequence[threadId] + 1 == sequence);
+                    lastSequence[threadId] = sequence;
+                }
+            }
+            ASSERTV(numLines, k_NUM_THREAD_IDS * k_NUM_RECORDS == numLines);
+
+            // Shut down with records queued, then restart.
+
+            bsl::shared_ptr<ball::Record> record;
+            record.createInplace(&ta, &ta);
+            record->fixedFields().setSeverity(ERROR);
+            for (int t = 1; t <= 40; ++t) {
+                record->fixedFields().setThreadID(t);
+                mX.publish(record, context);
+            }
+            ASSERT(0 <  X.recordQueueLength());
+            ASSERT(0 == mX.startPublicationThread());
+            ASSERT(0 == mX.shutdownPublicationThread());
+            ASSERT(0 == X.recordQueueLength());
+            ASSERT(!X.isPublicationThreadRunning());
+
+            ASSERT(0 == mX.startPublicationThread());
+            for (int t = 1; t <= 40; ++t) {
+                record->fixedFields().setThreadID(t);
+                mX.publish(record, context);
+            }
+            ASSERT(0 == mX.stopPublicationThread());
+            ASSERT(0 == X.recordQueueLength());
+        }
+
+        if (veryVerbose) cout << "\tTesting concurrent publication" << endl;
+        {
+            using namespace BALL_ASYNCFILEOBSERVER_TEST_CONCURRENCY;
+
+            TempDirectoryGuard tempDirGuard;
+
+            bsl::string fileName(tempDirGuard.getTempDirName());
+            bdls::PathUtil::appendRaw(&fileName, "testLog");
+
+            bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+            // Set up a blocking async observer.
+
+            bsl::shared_ptr<Obj> mX(new(ta) Obj(ball::Severity::e_WARN,
+                                                false,
+                                                1024,
+                                                8,
+                                                ball::Severity::e_TRACE,
+                                                &ta),
+                                    &ta);
+
+            mX->startPublicationThread();
+
+            ball::LoggerManagerConfiguration configuration;
+            ASSERT(0 == configuration.setDefaultThresholdLevelsIfValid(
+                                                     ball::Severity::e_TRACE));
+
+            ball::LoggerManagerScopedGuard guard(configuration);
+
+            ball::LoggerManager& manager = ball::LoggerManager::singleton();
+
+            mX->enableFileLogging(fileName.c_str());
+
+            ASSERT(0 == manager.registerObserver(mX, "asyncObserver"));
+
+            const int numThreads = 8;
+
+            executeInParallel(numThreads, workerThread);
+
+            mX->stopPublicationThread();
+            mX->disableFileLogging();
+
+            int numRecords = countLoggedRecords(fileName);
+            ASSERTV(numRecords, numRecords == 10000 * numThreads);
+
+            ASSERT(0 == manager.deregisterObserver("asyncObserver"));
+        }
+
+        if (veryVerbose) cout << "\tNegative Testing" << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            bslma::TestAllocator ta(veryVeryVeryVerbose);
+
+            ASSERT_PASS(Obj(OFF, false, 10,  1, OFF, &ta));
+            ASSERT_PASS(Obj(OFF, false, 10, 10, OFF, &ta));
+            ASSERT_FAIL(Obj(OFF, false, 10,  0, OFF, &ta));
+            ASSERT_FAIL(Obj(OFF, false, 10, 11, OFF, &ta));
+        }
+      } break;
       case 11: {
         // --------------------------------------------------------------------
         // TESTING 'recordQueueLength'
@@ -3513,6 +3824,101 @@ int main(int argc, char *argv[])
         }
         fclose(stdout);
       } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: CONCURRENT PUBLICATION
+        //
+        // Concerns:
+        //:  1 Sharding the record queue improves the throughput and the tail
+        //:    latency of 'publish' when many threads publish concurrently.
+        //
+        // Plan:
+        //:  1 For a number of record queue shards, have many threads publish
+        //:    records to an observer whose publication thread is running,
+        //:    that drops records when the queue is full, and that logs
+        //:    neither to a file nor to 'stdout' (so the queue, rather than
+        //:    the output, is measured).  Report the number of records
+        //:    published per second, and the median and 99th percentile
+        //:    latency of 'publish'.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: CONCURRENT PUBLICATION
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nPERFORMANCE: CONCURRENT PUBLICATION."
+                          << "\n====================================" << endl;
+
+        using namespace BALL_ASYNCFILEOBSERVER_TEST_PERFORMANCE;
+
+        enum { k_NUM_THREADS       = 40,
+               k_NUM_RECORDS       = 50000,
+               k_QUEUE_SIZE        = 8192 };
+
+        const int NUM_SHARDS[] = { 1, 4, 16, k_NUM_THREADS };
+        const int NUM_CONFIGS = static_cast<int>(sizeof NUM_SHARDS /
+                                                 sizeof *NUM_SHARDS);
+
+        cout << "threads: "   << k_NUM_THREADS
+             << ", records per thread: " << k_NUM_RECORDS
+             << ", queue size: "          << k_QUEUE_SIZE << endl;
+
+        for (int ti = 0; ti < NUM_CONFIGS; ++ti) {
+            const int SHARDS = NUM_SHARDS[ti];
+
+            Obj mX(ball::Severity::e_OFF,
+                   false,
+                   k_QUEUE_SIZE,
+                   SHARDS,
+                   ball::Severity::e_OFF);
+
+            ASSERT(0 == mX.startPublicationThread());
+
+            bsl::vector<ThreadArgs>                args(k_NUM_THREADS);
+            bsl::vector<bslmt::ThreadUtil::Handle> handles(k_NUM_THREADS);
+
+            bsls::Stopwatch timer;
+            timer.start();
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                args[i].d_observer_p = &mX;
+                args[i].d_numRecords = k_NUM_RECORDS;
+                ASSERT(0 == bslmt::ThreadUtil::create(&handles[i],
+                                                      publishThread,
+                                                      &args[i]));
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                bslmt::ThreadUtil::join(handles[i]);
+            }
+
+            timer.stop();
+
+            ASSERT(0 == mX.stopPublicationThread());
+
+            bsl::vector<bsls::Types::Int64> latencies;
+            latencies.reserve(k_NUM_THREADS * k_NUM_RECORDS);
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                latencies.insert(latencies.end(),
+                                 args[i].d_latencies.begin(),
+                                 args[i].d_latencies.end());
+            }
+
+            const bsl::size_t numLatencies = latencies.size();
+
+            bsl::vector<bsls::Types::Int64>::iterator median =
+                                   latencies.begin() + numLatencies / 2;
+            bsl::vector<bsls::Types::Int64>::iterator p99 =
+                                   latencies.begin() + numLatencies * 99 / 100;
+            bsl::nth_element(latencies.begin(), median, latencies.end());
+            bsl::nth_element(median, p99, latencies.end());
+
+            cout << "shards: "            << SHARDS
+                 << "\trecords/sec: "     << static_cast<bsls::Types::Int64>(
+                                                 latencies.size()
+                                                 / timer.elapsedTime())
+                 << "\tmedian (ns): "     << *median
+                 << "\tp99 (ns): "        << *p99 << endl;
+        }
+      } break;
       default: {
         cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
         testStatus = -1;
@@ -0,0 +1,584 @@
+// ball_batchedfilewriter.cpp                                         -*-C++-*-
+
+///Implementation Notes
+///--------------------
+// Appending threads and the writer thread share three lists of batches, all
+// guarded by 'd_mutex': 'd_pendingBatches' (filled batches waiting for the
+// writer thread), 'd_writingBatches' (batches being written), and
+// 'd_spareBatches' (written batches, whose capacity is reused for the current
+// batch).  Batches are moved between the lists by swapping, so that, once the
+// writer has reached a steady state, neither appending nor writing data
+// allocates memory.
+//
+// The writer thread releases 'd_mutex' only while it makes the system calls
+// that write (and synchronize) the batches in 'd_writingBatches', during which
+// 'd_isWriting' is 'true'.  Since 'setFileDescriptor' waits until no batches
+// are pending or being written before changing 'd_fd' (without releasing
+// 'd_mutex' in between), no data is written to a file descriptor after it has
+// been replaced.
+//
+// If the writer thread is not running, the thread that submits a batch (or
+// calls 'flush') writes it, following the same protocol.
+
+#include <ball_batchedfilewriter.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ball_batchedfilewriter_cpp,"$Id$ $CSID$")
+
+#include <bdlf_memfn.h>
+
+#include <bslma_default.h>
+
+#include <bslmt_lockguard.h>
+#include <bslmt_threadattributes.h>
+
+#include <bsls_assert.h>
+#include <bsls_log.h>
+#include <bsls_platform.h>
+#include <bsls_systemclocktype.h>
+#include <bsls_systemtime.h>
+
+#include <bsl_cstring.h>
+
+#include <bsl_c_errno.h>
+#include <bsl_c_stdio.h>   // for 'snprintf'
+
+#ifdef BSLS_PLATFORM_OS_UNIX
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#endif
+
+#if defined(BSLS_PLATFORM_CMP_MSVC)
+#define snprintf _snprintf
+#endif
+
+namespace BloombergLP {
+namespace ball {
+
+namespace {
+
+enum {
+    k_MAX_IOVECS = 64  // maximum number of buffers submitted by one call to
+                       // 'writev'
+};
+
+static int getErrorCode(void)
+    // Return the system-specific error code.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    int rc = GetLastError();
+    return rc ? rc : errno;
+#else
+    return errno;
+#endif
+}
+
+static void reportError(const char *operation, int numBytes)
+    // Report, via 'bsls::Log', the failure of the specified 'operation' on a
+    // batch of the specified 'numBytes', using the system-specific error code.
+{
+    char errorBuffer[256];
+
+    snprintf(errorBuffer,
+             sizeof errorBuffer,
+             "Cannot %s log file (%d bytes): %s. "
+             "Further data for the file will be discarded!",
+             operation,
+             numBytes,
+             bsl::strerror(getErrorCode()));
+    bsls::Log::platformDefaultMessageHandler(bsls::LogSeverity::e_ERROR,
+                                             __FILE__,
+                                             __LINE__,
+                                             errorBuffer);
+}
+
+static int syncFile(bdls::FilesystemUtil::FileDescriptor fd)
+    // Synchronize the file having the specified 'fd' with its storage device.
+    // Return 0 on success, and a non-zero value otherwise.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    return FlushFileBuffers(fd) ? 0 : -1;
+#else
+    int rc;
+    do {
+        rc = ::fsync(fd);
+    } while (0 != rc && EINTR == errno);
+    return rc;
+#endif
+}
+
+static int writeBatchList(
+                    bsls::Types::Int64                      *numBytesWritten,
+                    bsls::Types::Int64                      *numWriteCalls,
+                    bdls::FilesystemUtil::FileDescriptor     fd,
+                    const bsl::vector<bsl::vector<char> >&   batches)
+    // Write the specified 'batches' to the file having the specified 'fd',
+    // and load the number of bytes written into the specified
+    // 'numBytesWritten', and the number of system calls made into the
+    // specified 'numWriteCalls'.  Return 0 on success, and a non-zero value
+    // otherwise.
+{
+    *numBytesWritten = 0;
+    *numWriteCalls   = 0;
+
+#ifdef BSLS_PLATFORM_OS_UNIX
+    struct iovec iov[k_MAX_IOVECS];
+
+    bsl::size_t next = 0;
+    while (next < batches.size()) {
+        int numIov = 0;
+        while (next < batches.size() && numIov < k_MAX_IOVECS) {
+            if (!batches[next].empty()) {
+                iov[numIov].iov_base =
+                                   const_cast<char *>(batches[next].data());
+                iov[numIov].iov_len  = batches[next].size();
+                ++numIov;
+            }
+            ++next;
+        }
+
+        struct iovec *first = iov;
+        while (0 < numIov) {
+            ssize_t rc = ::writev(fd, first, numIov);
+            ++*numWriteCalls;
+            if (rc <= 0) {
+                // Retry only an interrupted call: a call writing nothing (or
+                // failing with 'EAGAIN') makes no progress and would
+                // otherwise be retried indefinitely.
+
+                if (rc < 0 && EINTR == errno) {
+                    continue;
+                }
+                return -1;                                            // RETURN
+            }
+            *numBytesWritten += rc;
+
+            // Skip the buffers that were completely written, and adjust the
+            // first partially written one.
+
+            bsl::size_t remaining = static_cast<bsl::size_t>(rc);
+            while (0 < numIov && first->iov_len <= remaining) {
+                remaining -= first->iov_len;
+                ++first;
+                --numIov;
+            }
+            if (0 < numIov) {
+                first->iov_base = static_cast<char *>(first->iov_base)
+                                                                   + remaining;
+                first->iov_len -= remaining;
+            }
+        }
+    }
+#else
+    for (bsl::size_t i = 0; i < batches.size(); ++i) {
+        const char *data     = batches[i].data();
+        int         numBytes = static_cast<int>(batches[i].size());
+        while (0 < numBytes) {
+            int rc = bdls::FilesystemUtil::write(fd, data, numBytes);
+            ++*numWriteCalls;
+            if (rc <= 0) {
+                return -1;                                            // RETURN
+            }
+            *numBytesWritten += rc;
+            data             += rc;
+            numBytes         -= rc;
+        }
+    }
+#endif
+
+    return 0;
+}
+
+}  // close unnamed namespace
+
+                          // -----------------------
+                          // class BatchedFileWriter
+                          // -----------------------
+
+// PRIVATE MANIPULATORS
+void BatchedFileWriter::flushImp()
+{
+    if (!d_currentBatch.empty()) {
+        submitCurrentBatch();
+    }
+
+    if (0 < d_syncSize
+     && (0 < d_numUnsyncedBytes || !d_pendingBatches.empty() || d_isWriting)) {
+        d_isSyncRequested = true;
+    }
+
+    // The writer thread may be stopped while this thread waits, so whether
+    // to wait for it or to write the batches inline is decided anew on each
+    // iteration.
+
+    while (!d_pendingBatches.empty() || d_isWriting || d_isSyncRequested) {
+        if (isWriterAvailable()) {
+            d_writerCondition.signal();
+            d_writtenCondition.wait(&d_mutex);
+        }
+        else if (d_isWriting) {
+            d_writtenCondition.wait(&d_mutex);
+        }
+        else {
+            writeBatches();
+        }
+    }
+}
+
+void BatchedFileWriter::submitCurrentBatch()
+{
+    d_pendingBatches.resize(d_pendingBatches.size() + 1);
+    d_pendingBatches.back().swap(d_currentBatch);
+
+    if (!d_spareBatches.empty()) {
+        d_currentBatch.swap(d_spareBatches.back());
+        d_spareBatches.pop_back();
+    }
+    else {
+        d_currentBatch.reserve(d_flushSize);
+    }
+}
+
+void BatchedFileWriter::writeBatches()
+{
+    BSLS_ASSERT(!d_isWriting);
+
+    d_writingBatches.swap(d_pendingBatches);
+
+    const FileDescriptor fd            = d_fd;
+    const bool           isWritable    = FileDescriptor(
+                                  bdls::FilesystemUtil::k_INVALID_FD) != fd
+                                      && !d_hasFailed;
+    const bool           syncRequested = d_isSyncRequested;
+    bsls::Types::Int64   numUnsynced   = d_numUnsyncedBytes;
+    bsls::Types::Int64   numBytes      = 0;
+    bsls::Types::Int64   numCalls      = 0;
+    bool                 isSynced      = false;
+    bool                 hasFailed     = false;
+
+    d_isSyncRequested = false;
+    d_isWriting       = true;
+
+    // Appending threads blocked on a full list of pending batches may now
+    // proceed.
+
+    d_writtenCondition.broadcast();
+
+    if (isWritable) {
+        bslmt::LockGuardUnlock<bslmt::Mutex> unlockGuard(&d_mutex);
+
+        if (0 != writeBatchList(&numBytes, &numCalls, fd, d_writingBatches)) {
+            reportError("write", static_cast<int>(numBytes));
+            hasFailed = true;
+        }
+        numUnsynced += numBytes;
+
+        if (!hasFailed
+         && 0 < d_syncSize
+         && 0 < numUnsynced
+         && (d_syncSize <= numUnsynced || syncRequested)) {
+            if (0 != syncFile(fd)) {
+                reportError("synchronize", static_cast<int>(numUnsynced));
+                hasFailed = true;
+            }
+            else {
+                isSynced    = true;
+                numUnsynced = 0;
+            }
+        }
+    }
+
+    d_isWriting         = false;
+    d_numUnsyncedBytes  = numUnsynced;
+    d_numBytesWritten  += numBytes;
+    d_numWriteCalls    += numCalls;
+    d_numSyncs         += isSynced ? 1 : 0;
+    d_hasFailed         = d_hasFailed || hasFailed;
+
+    for (bsl::size_t i = 0; i < d_writingBatches.size(); ++i) {
+        if (d_spareBatches.size() < k_MAX_PENDING_BATCHES) {
+            d_writingBatches[i].clear();
+            d_spareBatches.resize(d_spareBatches.size() + 1);
+            d_spareBatches.back().swap(d_writingBatches[i]);
+        }
+    }
+    d_writingBatches.clear();
+
+    d_writtenCondition.broadcast();
+}
+
+void BatchedFileWriter::writerThread()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    while (true) {
+        if (!d_currentBatch.empty()
+         && (d_isStopping
+          || d_currentBatchDeadline <=
+                                    bsls::SystemTime::nowMonotonicClock())) {
+            submitCurrentBatch();
+        }
+
+        if (!d_pendingBatches.empty() || d_isSyncRequested) {
+            writeBatches();
+            continue;
+        }
+
+        if (d_isStopping) {
+            break;
+        }
+
+        if (d_currentBatch.empty()) {
+            d_writerCondition.wait(&d_mutex);
+        }
+        else {
+            d_writerCondition.timedWait(&d_mutex, d_currentBatchDeadline);
+        }
+    }
+}
+
+// PRIVATE ACCESSORS
+bool BatchedFileWriter::isWriterAvailable() const
+{
+    return d_isRunning && !d_isStopping;
+}
+
+// CREATORS
+BatchedFileWriter::BatchedFileWriter(int                        flushSize,
+                                     const bsls::TimeInterval&  flushInterval,
+                                     bsls::Types::Int64         syncSize,
+                                     bslma::Allocator          *basicAllocator)
+: d_flushSize(flushSize)
+, d_flushInterval(flushInterval)
+, d_syncSize(syncSize)
+, d_fd(bdls::FilesystemUtil::k_INVALID_FD)
+, d_currentBatch(basicAllocator)
+, d_currentBatchDeadline()
+, d_pendingBatches(basicAllocator)
+, d_writingBatches(basicAllocator)
+, d_spareBatches(basicAllocator)
+, d_isWriting(false)
+, d_isSyncRequested(false)
+, d_isRunning(false)
+, d_isStopping(false)
+, d_hasFailed(false)
+, d_numUnsyncedBytes(0)
+, d_numBytesWritten(0)
+, d_numWriteCalls(0)
+, d_numSyncs(0)
+, d_writerThread()
+, d_mutex()
+, d_writerCondition(bsls::SystemClockType::e_MONOTONIC)
+, d_writtenCondition(bsls::SystemClockType::e_MONOTONIC)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 < flushSize);
+    BSLS_ASSERT(bsls::TimeInterval() < flushInterval);
+    BSLS_ASSERT(0 <= syncSize);
+
+    d_currentBatch.reserve(d_flushSize);
+    d_pendingBatches.reserve(k_MAX_PENDING_BATCHES + 1);
+    d_writingBatches.reserve(k_MAX_PENDING_BATCHES + 1);
+    d_spareBatches.reserve(k_MAX_PENDING_BATCHES);
+}
+
+BatchedFileWriter::~BatchedFileWriter()
+{
+    stop();
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+    flushImp();
+}
+
+// MANIPULATORS
+int BatchedFileWriter::append(const char *data, int numBytes)
+{
+    BSLS_ASSERT(data || 0 == numBytes);
+    BSLS_ASSERT(0 <= numBytes);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (FileDescriptor(bdls::FilesystemUtil::k_INVALID_FD) == d_fd
+     || d_hasFailed) {
+        return -1;                                                    // RETURN
+    }
+
+    if (0 == numBytes) {
+        return 0;                                                     // RETURN
+    }
+
+    if (d_currentBatch.empty()) {
+        d_currentBatchDeadline = bsls::SystemTime::nowMonotonicClock()
+                                                             + d_flushInterval;
+        if (d_isRunning) {
+            d_writerCondition.signal();
+        }
+    }
+
+    d_currentBatch.insert(d_currentBatch.end(), data, data + numBytes);
+
+    if (d_flushSize <= static_cast<int>(d_currentBatch.size())) {
+        while (isWriterAvailable()
+            && k_MAX_PENDING_BATCHES <= d_pendingBatches.size()) {
+            d_writtenCondition.wait(&d_mutex);
+        }
+
+        // Another thread may have submitted the current batch, and the
+        // writer thread may have been stopped, while this thread was waiting.
+
+        if (d_flushSize <= static_cast<int>(d_currentBatch.size())) {
+            submitCurrentBatch();
+        }
+
+        if (isWriterAvailable()) {
+            d_writerCondition.signal();
+        }
+        else {
+            while (d_isWriting) {
+                d_writtenCondition.wait(&d_mutex);
+            }
+            if (!d_pendingBatches.empty()) {
+                writeBatches();
+            }
+        }
+    }
+
+    return 0;
+}
+
+int BatchedFileWriter::flush()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (FileDescriptor(bdls::FilesystemUtil::k_INVALID_FD) == d_fd) {
+        return -1;                                                    // RETURN
+    }
+
+    flushImp();
+
+    return d_hasFailed ? -1 : 0;
+}
+
+int BatchedFileWriter::setFileDescriptor(FileDescriptor fd)
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    int rc = 0;
+    if (FileDescriptor(bdls::FilesystemUtil::k_INVALID_FD) != d_fd) {
+        flushImp();
+        rc = d_hasFailed ? -1 : 0;
+    }
+
+    d_fd               = fd;
+    d_hasFailed        = false;
+    d_numUnsyncedBytes = 0;
+
+    return rc;
+}
+
+int BatchedFileWriter::start()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (d_isRunning) {
+        return 1;                                                     // RETURN
+    }
+
+    bslmt::ThreadAttributes attr;
+    int rc = bslmt::ThreadUtil::createWithAllocator(
+                       &d_writerThread,
+                       attr,
+                       bdlf::MemFnUtil::memFn(&BatchedFileWriter::writerThread,
+                                              this),
+                       d_allocator_p);
+    if (0 != rc) {
+        return -1;                                                    // RETURN
+    }
+
+    d_isRunning = true;
+    return 0;
+}
+
+void BatchedFileWriter::stop()
+{
+    bslmt::ThreadUtil::Handle writerThread;
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        if (!d_isRunning || d_isStopping) {
+            return;                                                   // RETURN
+        }
+
+        flushImp();
+
+        d_isStopping = true;
+        d_writerCondition.signal();
+        writerThread = d_writerThread;
+    }
+
+    bslmt::ThreadUtil::join(writerThread);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    d_isRunning  = false;
+    d_isStopping = false;
+
+    // Appending threads blocked on a full list of pending batches must now
+    // write the batches themselves.
+
+    d_writtenCondition.broadcast();
+}
+
+// ACCESSORS
+BatchedFileWriter::FileDescriptor BatchedFileWriter::fileDescriptor() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+    return d_fd;
+}
+
+bool BatchedFileWriter::isRunning() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+    return d_isRunning;
+}
+
+bsls::Types::Int64 BatchedFileWriter::numBytesWritten() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+    return d_numBytesWritten;
+}
+
+bsls::Types::Int64 BatchedFileWriter::numSyncs() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+    return d_numSyncs;
+}
+
+bsls::Types::Int64 BatchedFileWriter::numWriteCalls() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+    return d_numWriteCalls;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
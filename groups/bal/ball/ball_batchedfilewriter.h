@@ -0,0 +1,408 @@
+// ball_batchedfilewriter.h                                           -*-C++-*-
+#ifndef INCLUDED_BALL_BATCHEDFILEWRITER
+#define INCLUDED_BALL_BATCHEDFILEWRITER
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a writer that batches data and writes it from a thread.
+//
+//@CLASSES:
+//  ball::BatchedFileWriter: batches appended data and writes it to a file
+//
+//@SEE_ALSO: ball_fileobserver2
+//
+//@DESCRIPTION: This component provides a thread-safe mechanism,
+// 'ball::BatchedFileWriter', that accumulates the data appended to it in
+// memory and writes that data, in large batches, to a file (identified by a
+// file descriptor) from a dedicated writer thread.  Threads that append data
+// to a batched file writer therefore do not, in general, wait for the system
+// call that writes the data to the file to complete.
+//
+// Data appended to a batched file writer is copied into the *current* batch,
+// which is a contiguous buffer that is reused from one batch to the next.  The
+// current batch is handed to the writer thread when it holds at least
+// 'flushSize' bytes, or once 'flushInterval' has elapsed since the first data
+// was appended to it, whichever occurs first.  The writer thread submits all
+// of the batches that are waiting for it to the operating system with a
+// single gather-write ('writev') call where the platform supports it.
+//
+// If more than 'k_MAX_PENDING_BATCHES' batches are waiting for the writer
+// thread (i.e., if data is being appended faster than it can be written), a
+// thread appending data blocks until the writer thread catches up.
+//
+///Synchronizing the File
+///----------------------
+// Data written to a file is not, in general, immediately transferred to the
+// underlying storage device.  If a non-zero 'syncSize' is supplied on
+// construction, the writer thread synchronizes the file with the storage
+// device (using 'fsync' or its equivalent) each time at least 'syncSize' bytes
+// have been written since the file was last synchronized, so that the cost of
+// synchronization is shared by many batches.  The file is also synchronized
+// by 'flush', 'setFileDescriptor', and 'stop' if any data has been written to
+// it since it was last synchronized.  If 'syncSize' is 0, the file is never
+// explicitly synchronized.
+//
+///Write Errors
+///------------
+// If writing a batch to the file fails, the error is reported via
+// 'bsls::Log', and the remaining data destined for the file is discarded.
+// Subsequent calls to 'append' and 'flush' then fail (and have no effect)
+// until a (possibly different) file descriptor is supplied to
+// 'setFileDescriptor'.
+//
+///Thread Safety
+///-------------
+// 'ball::BatchedFileWriter' is fully *thread-safe*, meaning that all non-
+// creator methods can be safely called concurrently from different threads.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Writing Data to a File in Batches
+/// - - - - - - - - - - - - - - - - - - - - - -
+// First, we open a file to which we will write:
+//..
+//  typedef bdls::FilesystemUtil FileUtil;
+//
+//  FileUtil::FileDescriptor fd = FileUtil::open(fileName,
+//                                               FileUtil::e_OPEN_OR_CREATE,
+//                                               FileUtil::e_READ_APPEND);
+//  assert(FileUtil::k_INVALID_FD != fd);
+//..
+// Then, we create a batched file writer that hands its current batch to the
+// writer thread when it holds 64 kilobytes, or 100 milliseconds after data is
+// first appended to it, and that does not synchronize the file, and start its
+// writer thread:
+//..
+//  ball::BatchedFileWriter writer(64 * 1024,
+//                                 bsls::TimeInterval(0.1),
+//                                 0);
+//  writer.setFileDescriptor(fd);
+//
+//  int rc = writer.start();
+//  assert(0 == rc);
+//..
+// Next, we append several lines of text to the writer.  Each call to 'append'
+// merely copies the data into the current batch:
+//..
+//  for (int i = 0; i < 100; ++i) {
+//      rc = writer.append("Hello, world!\n", 14);
+//      assert(0 == rc);
+//  }
+//..
+// Now, we flush the writer, which blocks until the data appended so far has
+// been written to the file:
+//..
+//  rc = writer.flush();
+//  assert(0 == rc);
+//  assert(1400 == FileUtil::getFileSize(fileName));
+//..
+// Finally, we stop the writer thread and close the file:
+//..
+//  writer.stop();
+//  FileUtil::close(fd);
+//..
+
+#include <balscm_version.h>
+
+#include <bdls_filesystemutil.h>
+
+#include <bslma_allocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bslmt_condition.h>
+#include <bslmt_mutex.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_timeinterval.h>
+#include <bsls_types.h>
+
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace ball {
+
+                          // =======================
+                          // class BatchedFileWriter
+                          // =======================
+
+class BatchedFileWriter {
+    // This class accumulates the data appended to it in memory, and writes it
+    // in batches to a file from a dedicated writer thread.  This class is
+    // fully thread-safe.
+
+  public:
+    // PUBLIC TYPES
+    typedef bdls::FilesystemUtil::FileDescriptor FileDescriptor;
+
+    // PUBLIC CONSTANTS
+    enum {
+        k_MAX_PENDING_BATCHES = 16  // maximum number of batches waiting for
+                                    // the writer thread before 'append'
+                                    // blocks
+    };
+
+  private:
+    // PRIVATE TYPES
+    typedef bsl::vector<char> Batch;
+
+    // DATA
+    const int                 d_flushSize;        // size (in bytes) at which
+                                                  // the current batch is
+                                                  // submitted
+
+    const bsls::TimeInterval  d_flushInterval;    // maximum age of the
+                                                  // current batch
+
+    const bsls::Types::Int64  d_syncSize;         // number of bytes written
+                                                  // between synchronizations
+                                                  // (0 if never)
+
+    FileDescriptor            d_fd;               // file being written
+
+    Batch                     d_currentBatch;     // batch being filled
+
+    bsls::TimeInterval        d_currentBatchDeadline;
+                                                  // time (monotonic) by which
+                                                  // the current batch is
+                                                  // submitted
+
+    bsl::vector<Batch>        d_pendingBatches;   // batches waiting for the
+                                                  // writer thread
+
+    bsl::vector<Batch>        d_writingBatches;   // batches being written
+
+    bsl::vector<Batch>        d_spareBatches;     // written batches, kept for
+                                                  // reuse
+
+    bool                      d_isWriting;        // 'true' while batches are
+                                                  // being written (without
+                                                  // 'd_mutex' held)
+
+    bool                      d_isSyncRequested;  // 'true' if the file must be
+                                                  // synchronized once pending
+                                                  // batches are written
+
+    bool                      d_isRunning;        // 'true' if the writer
+                                                  // thread is running
+
+    bool                      d_isStopping;       // 'true' if the writer
+                                                  // thread is to exit
+
+    bool                      d_hasFailed;        // 'true' if writing to
+                                                  // 'd_fd' failed
+
+    bsls::Types::Int64        d_numUnsyncedBytes; // bytes written to 'd_fd'
+                                                  // since it was last
+                                                  // synchronized
+
+    bsls::Types::Int64        d_numBytesWritten;  // total bytes written
+
+    bsls::Types::Int64        d_numWriteCalls;    // total write system calls
+
+    bsls::Types::Int64        d_numSyncs;         // total synchronizations
+
+    bslmt::ThreadUtil::Handle d_writerThread;     // writer thread handle
+
+    mutable bslmt::Mutex      d_mutex;            // serializes access to the
+                                                  // data members above
+
+    bslmt::Condition          d_writerCondition;  // wakes the writer thread
+
+    bslmt::Condition          d_writtenCondition; // signaled when batches
+                                                  // have been written
+
+    bslma::Allocator         *d_allocator_p;      // memory allocator (held,
+                                                  // not owned)
+
+  private:
+    // NOT IMPLEMENTED
+    BatchedFileWriter(const BatchedFileWriter&);
+    BatchedFileWriter& operator=(const BatchedFileWriter&);
+
+    // PRIVATE MANIPULATORS
+    void flushImp();
+        // Write all data appended to this object to the file, and synchronize
+        // the file if a non-zero 'syncSize' was supplied on construction and
+        // any data was written to it since its last synchronization, waiting
+        // for the writer thread to do so if it is running.  The behavior is
+        // undefined unless 'd_mutex' is locked by the calling thread.
+
+    void submitCurrentBatch();
+        // Append the current batch to the batches waiting for the writer
+        // thread, and replace it with an empty batch.  The behavior is
+        // undefined unless 'd_mutex' is locked by the calling thread.
+
+    void writeBatches();
+        // Write the batches waiting for the writer thread to the file, and
+        // synchronize the file if required, unlocking 'd_mutex' for the
+        // duration of the system calls.  The behavior is undefined unless
+        // 'd_mutex' is locked by the calling thread, and 'd_isWriting' is
+        // 'false'.
+
+    void writerThread();
+        // Write batches of data to the file as they become available, until
+        // 'stop' is called.
+
+    // PRIVATE ACCESSORS
+    bool isWriterAvailable() const;
+        // Return 'true' if the writer thread is running and will write the
+        // batches subsequently submitted to it, and 'false' otherwise.  Note
+        // that once 'stop' has been called the writer thread may exit at any
+        // time 'd_mutex' is unlocked, so batches submitted after a wait must
+        // be written by the calling thread unless this method, called after
+        // the wait, returns 'true'.  The behavior is undefined unless
+        // 'd_mutex' is locked by the calling thread.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(BatchedFileWriter,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    BatchedFileWriter(int                        flushSize,
+                      const bsls::TimeInterval&  flushInterval,
+                      bsls::Types::Int64         syncSize,
+                      bslma::Allocator          *basicAllocator = 0);
+        // Create a batched file writer, having no file, that submits its
+        // current batch for writing when it holds at least the specified
+        // 'flushSize' bytes, or once the specified 'flushInterval' has elapsed
+        // since data was first appended to it, and that synchronizes its file
+        // each time at least the specified 'syncSize' bytes have been written
+        // to it since it was last synchronized, or never if 'syncSize' is 0.
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless '0 < flushSize',
+        // 'bsls::TimeInterval() < flushInterval', and '0 <= syncSize'.  Note
+        // that the writer thread is not started until 'start' is called.
+
+    ~BatchedFileWriter();
+        // Write all data appended to this object to its file, stop the writer
+        // thread if it is running, and destroy this object.  Note that the
+        // file is *not* closed.
+
+    // MANIPULATORS
+    int append(const char *data, int numBytes);
+        // Append the specified 'numBytes' of the specified 'data' to the
+        // current batch, submitting the batch for writing if it then holds at
+        // least 'flushSize' bytes.  Return 0 on success, and a non-zero value
+        // (with no effect) if this object has no file, or if writing to its
+        // file has failed.  This method blocks while 'k_MAX_PENDING_BATCHES'
+        // batches are waiting to be written.  The behavior is undefined
+        // unless '0 <= numBytes'.
+
+    int flush();
+        // Block until all data appended to this object has been written to
+        // its file, and synchronize the file if a non-zero 'syncSize' was
+        // supplied on construction and any data has been written to it since
+        // it was last synchronized.  Return 0 on success, and a non-zero
+        // value if this object has no file, or if writing to its file has
+        // failed.  Note that if the writer thread is not running, the data is
+        // written by the calling thread.
+
+    int setFileDescriptor(FileDescriptor fd);
+        // Flush all data appended to this object to its current file (if
+        // any), then direct subsequently appended data to the file having the
+        // specified 'fd', or discard it if 'fd' is
+        // 'bdls::FilesystemUtil::k_INVALID_FD'.  Return the status of the
+        // flush: 0 if it succeeded or there was no current file, and a
+        // non-zero value otherwise.  Note that no data is written to the
+        // previous file after this method returns, so it may then be closed.
+
+    int start();
+        // Start the writer thread.  Return 0 on success, a positive value if
+        // the writer thread is already running (with no effect), and a
+        // negative value otherwise.
+
+    void stop();
+        // Write all data appended to this object to its file, and stop the
+        // writer thread.  This method has no effect if the writer thread is
+        // not running.  Note that data appended after this method returns is
+        // written by the thread that calls 'flush' (or the destructor) or, if
+        // 'start' is called again, by the writer thread.
+
+    // ACCESSORS
+    FileDescriptor fileDescriptor() const;
+        // Return the descriptor of the file to which this object writes, or
+        // 'bdls::FilesystemUtil::k_INVALID_FD' if it has no file.
+
+    int flushSize() const;
+        // Return the size (in bytes) at which the current batch is submitted
+        // for writing.
+
+    const bsls::TimeInterval& flushInterval() const;
+        // Return the maximum time for which data appended to this object
+        // waits in the current batch before the batch is submitted for
+        // writing.
+
+    bool isRunning() const;
+        // Return 'true' if the writer thread is running, and 'false'
+        // otherwise.
+
+    bsls::Types::Int64 numBytesWritten() const;
+        // Return the total number of bytes written by this object.
+
+    bsls::Types::Int64 numSyncs() const;
+        // Return the total number of times this object has synchronized its
+        // file.
+
+    bsls::Types::Int64 numWriteCalls() const;
+        // Return the total number of system calls made by this object to
+        // write data.
+
+    bsls::Types::Int64 syncSize() const;
+        // Return the number of bytes written between synchronizations of the
+        // file of this object, or 0 if the file is never synchronized.
+};
+
+// ============================================================================
+//                              INLINE DEFINITIONS
+// ============================================================================
+
+                          // -----------------------
+                          // class BatchedFileWriter
+                          // -----------------------
+
+// ACCESSORS
+inline
+int BatchedFileWriter::flushSize() const
+{
+    return d_flushSize;
+}
+
+inline
+const bsls::TimeInterval& BatchedFileWriter::flushInterval() const
+{
+    return d_flushInterval;
+}
+
+inline
+bsls::Types::Int64 BatchedFileWriter::syncSize() const
+{
+    return d_syncSize;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1190 @@
+// ball_batchedfilewriter.t.cpp                                       -*-C++-*-
+#include <ball_batchedfilewriter.h>
+
+#include <bdls_filesystemutil.h>
+#include <bdls_pathutil.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_testallocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bslmt_threadgroup.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_platform.h>
+#include <bsls_timeinterval.h>
+#include <bsls_timeutil.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_fstream.h>
+#include <bsl_iostream.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                             TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test provides a mechanism, 'ball::BatchedFileWriter',
+// that writes the data appended to it to a file, in batches, from a writer
+// thread.  Each test case creates files in a temporary directory, appends data
+// to a writer, and compares the contents of the files with the appended data
+// once 'flush' (or 'stop') guarantees that the data has been written.  The
+// statistics reported by the writer ('numWriteCalls', 'numSyncs', etc.) are
+// used to verify that data is actually written in batches.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] BatchedFileWriter(int, const TimeInterval&, Int64, Allocator *);
+// [ 2] ~BatchedFileWriter();
+//
+// MANIPULATORS
+// [ 3] int append(const char *data, int numBytes);
+// [ 3] int flush();
+// [ 6] int setFileDescriptor(FileDescriptor fd);
+// [ 2] int start();
+// [ 2] void stop();
+//
+// ACCESSORS
+// [ 6] FileDescriptor fileDescriptor() const;
+// [ 2] int flushSize() const;
+// [ 2] const bsls::TimeInterval& flushInterval() const;
+// [ 2] bool isRunning() const;
+// [ 3] bsls::Types::Int64 numBytesWritten() const;
+// [ 5] bsls::Types::Int64 numSyncs() const;
+// [ 3] bsls::Types::Int64 numWriteCalls() const;
+// [ 2] bsls::Types::Int64 syncSize() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] FLUSH ON INTERVAL
+// [ 6] WRITE ERRORS
+// [ 7] CONCURRENT APPENDS
+// [ 8] USAGE EXAMPLE
+// [-1] PERFORMANCE: BATCHED WRITES VS. ONE WRITE PER RECORD
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef ball::BatchedFileWriter Obj;
+typedef bdls::FilesystemUtil    FsUtil;
+typedef bsls::Types::Int64      Int64;
+
+static bool verbose;
+static bool veryVerbose;
+
+//=============================================================================
+//                  GLOBAL CLASSES FOR TESTING
+//-----------------------------------------------------------------------------
+
+                          // ========================
+                          // class TempDirectoryGuard
+                          // ========================
+
+class TempDirectoryGuard {
+    // This class implements a scoped temporary directory guard.  The guard
+    // tries to create a temporary directory in the system-wide temp directory
+    // and falls back to the current directory.
+
+    // DATA
+    bsl::string       d_dirName;      // path to the created directory
+    bslma::Allocator *d_allocator_p;  // memory allocator (held, not owned)
+
+  private:
+    // NOT IMPLEMENTED
+    TempDirectoryGuard(const TempDirectoryGuard&);
+    TempDirectoryGuard& operator=(const TempDirectoryGuard&);
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(TempDirectoryGuard,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit TempDirectoryGuard(bslma::Allocator *basicAllocator = 0)
+        // Create temporary directory in the system-wide temp or current
+        // directory.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.
+    : d_dirName(bslma::Default::allocator(basicAllocator))
+    , d_allocator_p(bslma::Default::allocator(basicAllocator))
+    {
+        bsl::string tmpPath(d_allocator_p);
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+        char tmpPathBuf[MAX_PATH];
+        GetTempPath(MAX_PATH, tmpPathBuf);
+        tmpPath.assign(tmpPathBuf);
+#else
+        const char *envTmpPath = bsl::getenv("TMPDIR");
+        if (envTmpPath) {
+            tmpPath.assign(envTmpPath);
+        }
+#endif
+
+        int res = bdls::PathUtil::appendIfValid(&tmpPath, "ball_");
+        ASSERTV(tmpPath, 0 == res);
+
+        res = bdls::FilesystemUtil::createTemporaryDirectory(&d_dirName,
+                                                             tmpPath);
+        ASSERTV(tmpPath, 0 == res);
+    }
+
+    ~TempDirectoryGuard()
+        // Destroy this object and remove the temporary directory (recursively)
+        // created at construction.
+    {
+        bdls::FilesystemUtil::remove(d_dirName, true);
+    }
+
+    // ACCESSORS
+    const bsl::string& getTempDirName() const
+        // Return a 'const' reference to the name of the created temporary
+        // directory.
+    {
+        return d_dirName;
+    }
+};
+
+//=============================================================================
+//                  GLOBAL HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static bsl::string makeFileName(const TempDirectoryGuard& tempDir,
+                                const char               *leafName)
+    // Return the path of the file having the specified 'leafName' in the
+    // specified 'tempDir'.
+{
+    bsl::string fileName(tempDir.getTempDirName());
+    bdls::PathUtil::appendRaw(&fileName, leafName);
+    return fileName;
+}
+
+static FsUtil::FileDescriptor openForAppend(const bsl::string& fileName)
+    // Open (creating it if necessary) the file having the specified
+    // 'fileName' for appending, and return its descriptor.
+{
+    FsUtil::FileDescriptor fd = FsUtil::open(fileName,
+                                             FsUtil::e_OPEN_OR_CREATE,
+                                             FsUtil::e_READ_APPEND);
+    ASSERTV(fileName, FsUtil::k_INVALID_FD != fd);
+    return fd;
+}
+
+static bsl::string readFile(const bsl::string& fileName)
+    // Return the contents of the file having the specified 'fileName'.
+{
+    bsl::ifstream      fs(fileName.c_str(), bsl::ios::in | bsl::ios::binary);
+    bsl::ostringstream os;
+    os << fs.rdbuf();
+    return os.str();
+}
+
+static bsl::string makeLine(int id, int index)
+    // Return a newline-terminated line of text identifying the specified
+    // 'index'th line appended by the thread having the specified 'id'.
+{
+    char buffer[64];
+    snprintf(buffer, sizeof buffer, "thread %d line %d\n", id, index);
+    return buffer;
+}
+
+                          // ====================
+                          // struct AppendThread
+                          // ====================
+
+struct AppendThread {
+    // This functor appends a number of lines, identifying the thread and the
+    // line, to a batched file writer.
+
+    // DATA
+    Obj *d_writer_p;    // writer (held, not owned)
+    int  d_id;          // identifies the thread in the appended lines
+    int  d_numLines;    // number of lines to append
+
+    // MANIPULATORS
+    void operator()()
+        // Append 'd_numLines' lines to '*d_writer_p'.
+    {
+        for (int i = 0; i < d_numLines; ++i) {
+            const bsl::string line = makeLine(d_id, i);
+            int rc = d_writer_p->append(line.data(),
+                                        static_cast<int>(line.length()));
+            ASSERTV(d_id, i, rc, 0 == rc);
+        }
+    }
+};
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    verbose     = argc > 2;
+    veryVerbose = argc > 3;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator defaultAllocator("default", veryVerbose);
+    bslma::Default::setDefaultAllocatorRaw(&defaultAllocator);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "USAGE EXAMPLE" << endl
+                                  << "=============" << endl;
+
+        TempDirectoryGuard tempDir;
+        const bsl::string  fileName = makeFileName(tempDir, "usage.log");
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Writing Data to a File in Batches
+/// - - - - - - - - - - - - - - - - - - - - - -
+// First, we open a file to which we will write:
+//..
+    typedef bdls::FilesystemUtil FileUtil;
+
+    FileUtil::FileDescriptor fd = FileUtil::open(fileName,
+                                                 FileUtil::e_OPEN_OR_CREATE,
+                                                 FileUtil::e_READ_APPEND);
+    ASSERT(FileUtil::k_INVALID_FD != fd);
+//..
+// Then, we create a batched file writer that hands its current batch to the
+// writer thread when it holds 64 kilobytes, or 100 milliseconds after data is
+// first appended to it, and that does not synchronize the file, and start its
+// writer thread:
+//..
+    ball::BatchedFileWriter writer(64 * 1024,
+                                   bsls::TimeInterval(0.1),
+                                   0);
+    writer.setFileDescriptor(fd);
+
+    int rc = writer.start();
+    ASSERT(0 == rc);
+//..
+// Next, we append several lines of text to the writer.  Each call to 'append'
+// merely copies the data into the current batch:
+//..
+    for (int i = 0; i < 100; ++i) {
+        rc = writer.append("Hello, world!\n", 14);
+        ASSERT(0 == rc);
+    }
+//..
+// Now, we flush the writer, which blocks until the data appended so far has
+// been written to the file:
+//..
+    rc = writer.flush();
+    ASSERT(0 == rc);
+    ASSERT(1400 == FileUtil::getFileSize(fileName));
+//..
+// Finally, we stop the writer thread and close the file:
+//..
+    writer.stop();
+    FileUtil::close(fd);
+//..
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // CONCURRENT APPENDS
+        //
+        // Concerns:
+        //: 1 Data appended concurrently by several threads is written to the
+        //:   file exactly once, and the data appended by each thread appears
+        //:   in the order in which it was appended.
+        //:
+        //: 2 Appending threads are throttled, without deadlock, when data is
+        //:   appended faster than it is written.
+        //:
+        //: 3 Batches submitted while the writer thread is being stopped are
+        //:   written by the appending threads, rather than left to a writer
+        //:   thread that has exited.
+        //
+        // Plan:
+        //: 1 Using a small flush size (so that the list of pending batches
+        //:   fills), append lines identifying the thread and the line from
+        //:   several threads, with and without the writer thread running,
+        //:   and with the writer thread stopped while the threads append.
+        //:   Verify that the file contains every line once, and that the
+        //:   lines of each thread are in order.  (C-1,2)
+        //:
+        //: 2 When the writer thread is stopped during the appends, verify
+        //:   that once the appending threads have finished, only data not
+        //:   yet filling a batch remains unwritten.  (C-3)
+        //
+        // Testing:
+        //   CONCURRENT APPENDS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "CONCURRENT APPENDS" << endl
+                                  << "==================" << endl;
+
+        enum { k_NUM_THREADS = 8, k_NUM_LINES = 5000, k_FLUSH_SIZE = 256 };
+
+        Int64 totalBytes = 0;
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            for (int j = 0; j < k_NUM_LINES; ++j) {
+                totalBytes += makeLine(i, j).length();
+            }
+        }
+
+        // 'running' is 0 if the writer thread is not started, 1 if it runs
+        // throughout, and 2 if it is stopped while the threads append.
+
+        for (int running = 0; running < 3; ++running) {
+            if (veryVerbose) { T_ P(running) }
+
+            TempDirectoryGuard tempDir;
+            const bsl::string  fileName = makeFileName(tempDir, "mt.log");
+
+            bslma::TestAllocator   oa("object", veryVerbose);
+            FsUtil::FileDescriptor fd = openForAppend(fileName);
+            {
+                Obj mX(k_FLUSH_SIZE, bsls::TimeInterval(0.01), 4096, &oa);
+                ASSERT(0 == mX.setFileDescriptor(fd));
+                if (running) {
+                    ASSERT(0 == mX.start());
+                }
+
+                bslmt::ThreadGroup threads;
+                for (int i = 0; i < k_NUM_THREADS; ++i) {
+                    AppendThread functor = { &mX, i, k_NUM_LINES };
+                    ASSERT(0 == threads.addThread(functor));
+                }
+                if (2 == running) {
+                    bslmt::ThreadUtil::microSleep(1000);
+                    mX.stop();
+                    ASSERT(!mX.isRunning());
+                }
+                threads.joinAll();
+
+                if (2 == running) {
+                    ASSERTV(totalBytes,
+                            mX.numBytesWritten(),
+                            totalBytes - mX.numBytesWritten() <
+                                                                k_FLUSH_SIZE);
+                }
+
+                ASSERT(0 == mX.flush());
+                ASSERT(mX.numBytesWritten() ==
+                                            FsUtil::getFileSize(fileName));
+                ASSERTV(mX.numSyncs(), 0 < mX.numSyncs());
+            }
+            FsUtil::close(fd);
+
+            bsl::istringstream is(readFile(fileName));
+            bsl::vector<int>   nextIndex(k_NUM_THREADS, 0);
+            bsl::string        line;
+            int                numLines = 0;
+            while (bsl::getline(is, line)) {
+                int id, index;
+                ASSERTV(line,
+                        2 == bsl::sscanf(line.c_str(),
+                                         "thread %d line %d",
+                                         &id,
+                                         &index));
+                ASSERTV(line, 0 <= id && id < k_NUM_THREADS);
+                if (0 <= id && id < k_NUM_THREADS) {
+                    ASSERTV(id, index, nextIndex[id] == index);
+                    nextIndex[id] = index + 1;
+                }
+                ++numLines;
+            }
+            ASSERTV(numLines, k_NUM_THREADS * k_NUM_LINES == numLines);
+        }
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // TESTING 'setFileDescriptor' AND WRITE ERRORS
+        //
+        // Concerns:
+        //: 1 'setFileDescriptor' writes the data appended so far to the
+        //:   previous file, and directs subsequent data to the new file.
+        //:
+        //: 2 'fileDescriptor' returns the current file descriptor.
+        //:
+        //: 3 If writing to the file fails, 'append' and 'flush' fail until a
+        //:   new file descriptor is supplied, which resets the failure.
+        //:
+        //: 4 Supplying an invalid file descriptor detaches the writer from its
+        //:   file.
+        //
+        // Plan:
+        //: 1 Append data, switch to a second file, append more data, and
+        //:   verify the contents of both files.  (C-1,2)
+        //:
+        //: 2 Supply the descriptor of a file opened for reading only, and
+        //:   verify that the failure to write to it is reported by 'flush'
+        //:   and 'append', and is reset by 'setFileDescriptor'.  (C-3)
+        //:
+        //: 3 Supply 'k_INVALID_FD', and verify that 'append' and 'flush'
+        //:   fail.  (C-4)
+        //
+        // Testing:
+        //   int setFileDescriptor(FileDescriptor fd);
+        //   FileDescriptor fileDescriptor() const;
+        //   WRITE ERRORS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'setFileDescriptor' AND WRITE ERRORS"
+                          << endl
+                          << "============================================"
+                          << endl;
+
+        TempDirectoryGuard tempDir;
+        const bsl::string  fileName1 = makeFileName(tempDir, "first.log");
+        const bsl::string  fileName2 = makeFileName(tempDir, "second.log");
+        const bsl::string  fileName3 = makeFileName(tempDir, "readonly.log");
+
+        FsUtil::FileDescriptor fd1 = openForAppend(fileName1);
+        FsUtil::FileDescriptor fd2 = openForAppend(fileName2);
+        FsUtil::close(openForAppend(fileName3));
+        FsUtil::FileDescriptor fd3 = FsUtil::open(fileName3,
+                                                  FsUtil::e_OPEN,
+                                                  FsUtil::e_READ_ONLY);
+        ASSERT(FsUtil::k_INVALID_FD != fd3);
+
+        bslma::TestAllocator oa("object", veryVerbose);
+
+        for (int running = 0; running < 2; ++running) {
+            if (veryVerbose) { T_ P(running) }
+
+            Obj mX(1024 * 1024, bsls::TimeInterval(60), 0, &oa);
+            const Obj& X = mX;
+
+            if (running) {
+                ASSERT(0 == mX.start());
+            }
+
+            ASSERT(FsUtil::k_INVALID_FD == X.fileDescriptor());
+
+            if (verbose) cout << "\tSwitching files." << endl;
+
+            ASSERT(0 == mX.setFileDescriptor(fd1));
+            ASSERT(fd1 == X.fileDescriptor());
+            ASSERT(0 == mX.append("one\n", 4));
+
+            ASSERT(0 == mX.setFileDescriptor(fd2));
+            ASSERT(fd2 == X.fileDescriptor());
+            ASSERT(0 == mX.append("two\n", 4));
+
+            // The data for the first file was written by 'setFileDescriptor'.
+
+            ASSERTV(readFile(fileName1),
+                    (running ? "one\none\none\n" : "one\n") ==
+                                                          readFile(fileName1));
+            ASSERT(0 == mX.flush());
+            ASSERTV(readFile(fileName2),
+                    (running ? "two\ntwo\n" : "two\n") == readFile(fileName2));
+
+            if (verbose) cout << "\tWrite errors." << endl;
+
+            ASSERT(0 == mX.setFileDescriptor(fd3));
+            ASSERT(0 == mX.append("three\n", 6));
+            ASSERT(0 != mX.flush());
+            ASSERT(0 != mX.append("three\n", 6));
+            ASSERT(0 != mX.flush());
+
+            ASSERT(0 != mX.setFileDescriptor(fd1));
+            ASSERT(0 == mX.append("one\n", 4));
+            ASSERT(0 == mX.flush());
+            ASSERTV(readFile(fileName1),
+                    (running ? "one\none\none\none\n" : "one\none\n") ==
+                                                          readFile(fileName1));
+
+            if (verbose) cout << "\tDetaching." << endl;
+
+            ASSERT(0 == mX.setFileDescriptor(FsUtil::k_INVALID_FD));
+            ASSERT(FsUtil::k_INVALID_FD == X.fileDescriptor());
+            ASSERT(0 != mX.append("four\n", 5));
+            ASSERT(0 != mX.flush());
+        }
+
+        FsUtil::close(fd1);
+        FsUtil::close(fd2);
+        FsUtil::close(fd3);
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING FILE SYNCHRONIZATION
+        //
+        // Concerns:
+        //: 1 If 'syncSize' is 0, the file is never synchronized.
+        //:
+        //: 2 Otherwise, the file is synchronized once at least 'syncSize'
+        //:   bytes have been written since it was last synchronized, so that
+        //:   many batches share a single synchronization.
+        //:
+        //: 3 'flush' synchronizes the file if, and only if, data has been
+        //:   written to it since it was last synchronized.
+        //
+        // Plan:
+        //: 1 Append and flush data with a 'syncSize' of 0, and verify that
+        //:   'numSyncs' remains 0.  (C-1)
+        //:
+        //: 2 Append many batches of data, and verify that the number of
+        //:   synchronizations is about the number of bytes divided by
+        //:   'syncSize'.  (C-2)
+        //:
+        //: 3 Call 'flush' repeatedly, with and without appending data in
+        //:   between, and verify 'numSyncs'.  (C-3)
+        //
+        // Testing:
+        //   bsls::Types::Int64 numSyncs() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING FILE SYNCHRONIZATION" << endl
+                                  << "============================" << endl;
+
+        TempDirectoryGuard tempDir;
+        const bsl::string  fileName = makeFileName(tempDir, "sync.log");
+
+        FsUtil::FileDescriptor fd = openForAppend(fileName);
+
+        bslma::TestAllocator oa("object", veryVerbose);
+
+        const char DATA[] = "0123456789abcdef0123456789abcdef"
+                            "0123456789abcdef0123456789abcdef";
+        const int  SIZE   = sizeof DATA - 1;
+
+        for (int running = 0; running < 2; ++running) {
+            if (veryVerbose) { T_ P(running) }
+
+            if (verbose) cout << "\tNo synchronization." << endl;
+            {
+                Obj mX(SIZE, bsls::TimeInterval(60), 0, &oa);
+                ASSERT(0 == mX.setFileDescriptor(fd));
+                if (running) {
+                    ASSERT(0 == mX.start());
+                }
+                for (int i = 0; i < 100; ++i) {
+                    ASSERT(0 == mX.append(DATA, SIZE));
+                }
+                ASSERT(0 == mX.flush());
+                ASSERT(100 * SIZE == mX.numBytesWritten());
+                ASSERT(0 == mX.numSyncs());
+            }
+
+            if (verbose) cout << "\tSynchronization by size." << endl;
+            {
+                Obj mX(SIZE, bsls::TimeInterval(60), 10 * SIZE, &oa);
+                ASSERT(0 == mX.setFileDescriptor(fd));
+                if (running) {
+                    ASSERT(0 == mX.start());
+                }
+                for (int i = 0; i < 100; ++i) {
+                    ASSERT(0 == mX.append(DATA, SIZE));
+                }
+                ASSERT(0 == mX.flush());
+                ASSERT(100 * SIZE == mX.numBytesWritten());
+
+                // Batches written together are synchronized together, so
+                // there are at most 10 synchronizations.
+
+                ASSERTV(mX.numSyncs(),
+                        1 <= mX.numSyncs() && mX.numSyncs() <= 10);
+                if (!running) {
+                    ASSERTV(mX.numSyncs(), 10 == mX.numSyncs());
+                }
+            }
+
+            if (verbose) cout << "\tSynchronization by 'flush'." << endl;
+            {
+                Obj mX(1024 * 1024, bsls::TimeInterval(60), 1024 * 1024, &oa);
+                ASSERT(0 == mX.setFileDescriptor(fd));
+                if (running) {
+                    ASSERT(0 == mX.start());
+                }
+                ASSERT(0 == mX.flush());
+                ASSERT(0 == mX.numSyncs());
+
+                for (int i = 0; i < 5; ++i) {
+                    ASSERT(0 == mX.append(DATA, SIZE));
+                    ASSERT(0 == mX.flush());
+                    ASSERTV(i, mX.numSyncs(), i + 1 == mX.numSyncs());
+                    ASSERT(0 == mX.flush());
+                    ASSERTV(i, mX.numSyncs(), i + 1 == mX.numSyncs());
+                }
+
+                mX.stop();
+                ASSERT(5 == mX.numSyncs());
+            }
+        }
+
+        FsUtil::close(fd);
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING FLUSH ON INTERVAL
+        //
+        // Concerns:
+        //: 1 Once 'flushInterval' has elapsed since data was first appended
+        //:   to the current batch, the writer thread writes the batch even
+        //:   though it is smaller than 'flushSize'.
+        //:
+        //: 2 The batch is not written before 'flushInterval' has elapsed.
+        //
+        // Plan:
+        //: 1 Append a small amount of data to a writer having a large flush
+        //:   size and a short flush interval, and poll the file until the data
+        //:   appears, without calling 'flush'.  (C-1)
+        //:
+        //: 2 Append a small amount of data to a writer having a long flush
+        //:   interval, and verify that the data has not been written after a
+        //:   short sleep.  (C-2)
+        //
+        // Testing:
+        //   FLUSH ON INTERVAL
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING FLUSH ON INTERVAL" << endl
+                                  << "=========================" << endl;
+
+        TempDirectoryGuard tempDir;
+
+        bslma::TestAllocator oa("object", veryVerbose);
+
+        if (verbose) cout << "\tShort interval." << endl;
+        {
+            const bsl::string      fileName = makeFileName(tempDir, "a.log");
+            FsUtil::FileDescriptor fd       = openForAppend(fileName);
+
+            Obj mX(1024 * 1024, bsls::TimeInterval(0.05), 0, &oa);
+            ASSERT(0 == mX.setFileDescriptor(fd));
+            ASSERT(0 == mX.start());
+
+            for (int round = 0; round < 3; ++round) {
+                ASSERT(0 == mX.append("tick\n", 5));
+
+                const Int64 expected = 5 * (round + 1);
+                for (int i = 0; i < 500; ++i) {
+                    if (expected == FsUtil::getFileSize(fileName)) {
+                        break;
+                    }
+                    bslmt::ThreadUtil::microSleep(10 * 1000);
+                }
+                ASSERTV(round,
+                        FsUtil::getFileSize(fileName),
+                        expected == FsUtil::getFileSize(fileName));
+            }
+
+            mX.stop();
+            FsUtil::close(fd);
+        }
+
+        if (verbose) cout << "\tLong interval." << endl;
+        {
+            const bsl::string      fileName = makeFileName(tempDir, "b.log");
+            FsUtil::FileDescriptor fd       = openForAppend(fileName);
+
+            Obj mX(1024 * 1024, bsls::TimeInterval(60), 0, &oa);
+            ASSERT(0 == mX.setFileDescriptor(fd));
+            ASSERT(0 == mX.start());
+
+            ASSERT(0 == mX.append("tick\n", 5));
+            bslmt::ThreadUtil::microSleep(200 * 1000);
+            ASSERT(0 == FsUtil::getFileSize(fileName));
+
+            mX.stop();
+            ASSERT(5 == FsUtil::getFileSize(fileName));
+            FsUtil::close(fd);
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'append' AND 'flush'
+        //
+        // Concerns:
+        //: 1 Data appended is written to the file, in order, once 'flush'
+        //:   returns.
+        //:
+        //: 2 Data is written in batches: the number of system calls made to
+        //:   write the data is much smaller than the number of appends.
+        //:
+        //: 3 A batch is written, even if the writer thread is not running,
+        //:   once it holds at least 'flushSize' bytes.
+        //:
+        //: 4 'append' of 0 bytes succeeds and has no effect.
+        //:
+        //: 5 'numBytesWritten' and 'numWriteCalls' report the amount of data
+        //:   written and the number of system calls made.
+        //:
+        //: 6 All memory allocated by the object is released on destruction.
+        //
+        // Plan:
+        //: 1 For writers having a variety of flush sizes, with and without the
+        //:   writer thread running, append many records of varying length,
+        //:   flush, and compare the file with the appended data.  (C-1,4,5)
+        //:
+        //: 2 Verify that 'numWriteCalls' is at most the number of bytes
+        //:   divided by the flush size (plus one).  (C-2)
+        //:
+        //: 3 Without the writer thread running, append a batch of exactly
+        //:   'flushSize' bytes and verify that it has been written.  (C-3)
+        //:
+        //: 4 Verify that no memory remains in use by the object allocator once
+        //:   the object is destroyed.  (C-6)
+        //
+        // Testing:
+        //   int append(const char *data, int numBytes);
+        //   int flush();
+        //   bsls::Types::Int64 numBytesWritten() const;
+        //   bsls::Types::Int64 numWriteCalls() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING 'append' AND 'flush'" << endl
+                                  << "============================" << endl;
+
+        TempDirectoryGuard tempDir;
+
+        static const int FLUSH_SIZES[] = { 1, 7, 100, 4096, 1024 * 1024 };
+        const int        NUM_FLUSH_SIZES = sizeof FLUSH_SIZES
+                                                      / sizeof *FLUSH_SIZES;
+
+        enum { k_NUM_RECORDS = 2000 };
+
+        for (int ti = 0; ti < NUM_FLUSH_SIZES; ++ti) {
+            const int FLUSH_SIZE = FLUSH_SIZES[ti];
+
+            for (int running = 0; running < 2; ++running) {
+                if (veryVerbose) { T_ P_(FLUSH_SIZE) P(running) }
+
+                bsl::ostringstream leafName;
+                leafName << "append" << ti << running << ".log";
+                const bsl::string fileName = makeFileName(
+                                                    tempDir,
+                                                    leafName.str().c_str());
+
+                FsUtil::FileDescriptor fd = openForAppend(fileName);
+
+                bslma::TestAllocator oa("object", veryVerbose);
+                bsl::string          expected;
+                {
+                    Obj        mX(FLUSH_SIZE, bsls::TimeInterval(60), 0, &oa);
+                    const Obj& X = mX;
+
+                    ASSERT(0 == mX.setFileDescriptor(fd));
+                    if (running) {
+                        ASSERT(0 == mX.start());
+                    }
+
+                    ASSERT(0 == mX.append("", 0));
+
+                    for (int i = 0; i < k_NUM_RECORDS; ++i) {
+                        bsl::string record(i % 97, char('a' + i % 26));
+                        record += '\n';
+                        expected += record;
+
+                        ASSERT(0 == mX.append(
+                                        record.data(),
+                                        static_cast<int>(record.length())));
+                    }
+
+                    ASSERT(0 == mX.flush());
+
+                    const Int64 SIZE = static_cast<Int64>(expected.length());
+
+                    ASSERTV(X.numBytesWritten(), SIZE == X.numBytesWritten());
+                    ASSERTV(FLUSH_SIZE,
+                            X.numWriteCalls(),
+                            X.numWriteCalls() <= SIZE / FLUSH_SIZE + 1);
+                    if (4096 <= FLUSH_SIZE) {
+                        ASSERTV(FLUSH_SIZE,
+                                X.numWriteCalls(),
+                                X.numWriteCalls() < k_NUM_RECORDS / 10);
+                    }
+                }
+                FsUtil::close(fd);
+
+                ASSERTV(FLUSH_SIZE, running, expected == readFile(fileName));
+                ASSERTV(FLUSH_SIZE, running, 0 == oa.numBlocksInUse());
+            }
+        }
+
+        if (verbose) cout << "\tWriting a full batch without a thread."
+                          << endl;
+        {
+            const bsl::string      fileName = makeFileName(tempDir,
+                                                           "full.log");
+            FsUtil::FileDescriptor fd       = openForAppend(fileName);
+
+            bslma::TestAllocator oa("object", veryVerbose);
+
+            Obj mX(8, bsls::TimeInterval(60), 0, &oa);
+            ASSERT(0 == mX.setFileDescriptor(fd));
+
+            ASSERT(0 == mX.append("1234567", 7));
+            ASSERT(0 == FsUtil::getFileSize(fileName));
+            ASSERT(0 == mX.append("8", 1));
+            ASSERT(8 == FsUtil::getFileSize(fileName));
+            ASSERT(1 == mX.numWriteCalls());
+
+            FsUtil::close(fd);
+            ASSERT(0 == mX.setFileDescriptor(FsUtil::k_INVALID_FD));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS, 'start', 'stop', AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 The constructor stores the configuration, which is reported by
+        //:   the corresponding accessors.
+        //:
+        //: 2 'start' starts the writer thread, and returns a positive value
+        //:   if it is already running; 'stop' stops it, and has no effect if
+        //:   it is not running.  The writer thread may be restarted.
+        //:
+        //: 3 A writer having no file rejects appended data.
+        //:
+        //: 4 The destructor stops a running writer thread.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create writers with a variety of configurations, and verify the
+        //:   accessors.  (C-1)
+        //:
+        //: 2 Start, stop, and restart the writer thread, verifying the return
+        //:   values and 'isRunning'.  (C-2)
+        //:
+        //: 3 Append data to, and flush, a writer having no file.  (C-3)
+        //:
+        //: 4 Destroy a writer whose thread is running.  (C-4)
+        //:
+        //: 5 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-5)
+        //
+        // Testing:
+        //   BatchedFileWriter(int, const TimeInterval&, Int64, Allocator *);
+        //   ~BatchedFileWriter();
+        //   int start();
+        //   void stop();
+        //   int flushSize() const;
+        //   const bsls::TimeInterval& flushInterval() const;
+        //   bool isRunning() const;
+        //   bsls::Types::Int64 syncSize() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS, 'start', 'stop', AND BASIC ACCESSORS"
+                          << endl
+                          << "=============================================="
+                          << endl;
+
+        static const struct {
+            int    d_line;
+            int    d_flushSize;
+            double d_flushInterval;
+            Int64  d_syncSize;
+        } DATA[] = {
+            { L_,           1,  0.001,                0 },
+            { L_,        4096,  0.1,                  1 },
+            { L_,   64 * 1024,  1.0,         1024 * 1024 },
+            { L_, 1024 * 1024, 60.0, 1024LL * 1024 * 1024 * 16 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int                LINE  = DATA[ti].d_line;
+            const int                FSIZE = DATA[ti].d_flushSize;
+            const bsls::TimeInterval INTERVAL(DATA[ti].d_flushInterval);
+            const Int64              SSIZE = DATA[ti].d_syncSize;
+
+            bslma::TestAllocator oa("object", veryVerbose);
+            {
+                Obj        mX(FSIZE, INTERVAL, SSIZE, &oa);
+                const Obj& X = mX;
+
+                ASSERTV(LINE, FSIZE    == X.flushSize());
+                ASSERTV(LINE, INTERVAL == X.flushInterval());
+                ASSERTV(LINE, SSIZE    == X.syncSize());
+                ASSERTV(LINE, false    == X.isRunning());
+                ASSERTV(LINE, FsUtil::k_INVALID_FD == X.fileDescriptor());
+                ASSERTV(LINE, 0        == X.numBytesWritten());
+                ASSERTV(LINE, 0        == X.numWriteCalls());
+                ASSERTV(LINE, 0        == X.numSyncs());
+
+                ASSERTV(LINE, 0 != mX.append("abc", 3));
+                ASSERTV(LINE, 0 != mX.flush());
+
+                mX.stop();
+                ASSERTV(LINE, false == X.isRunning());
+
+                ASSERTV(LINE, 0 == mX.start());
+                ASSERTV(LINE, true == X.isRunning());
+                ASSERTV(LINE, 0 <  mX.start());
+                ASSERTV(LINE, true == X.isRunning());
+
+                ASSERTV(LINE, 0 != mX.append("abc", 3));
+
+                mX.stop();
+                ASSERTV(LINE, false == X.isRunning());
+                mX.stop();
+                ASSERTV(LINE, false == X.isRunning());
+
+                ASSERTV(LINE, 0 == mX.start());
+                ASSERTV(LINE, true == X.isRunning());
+            }
+            ASSERTV(LINE, 0 == oa.numBlocksInUse());
+        }
+        ASSERTV(defaultAllocator.numBlocksTotal(),
+                0 == defaultAllocator.numBlocksTotal());
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            const bsls::TimeInterval ONE(1);
+            const bsls::TimeInterval ZERO;
+
+            ASSERT_SAFE_PASS(Obj(1,  ONE,   0));
+            ASSERT_SAFE_FAIL(Obj(0,  ONE,   0));
+            ASSERT_SAFE_FAIL(Obj(-1, ONE,   0));
+            ASSERT_SAFE_FAIL(Obj(1,  ZERO,  0));
+            ASSERT_SAFE_FAIL(Obj(1,  ONE,  -1));
+
+            Obj mX(1, ONE, 0);
+            ASSERT_SAFE_PASS(mX.append("a", 0));
+            ASSERT_SAFE_FAIL(mX.append("a", -1));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create a writer, attach a file, start the writer thread, append
+        //:   some data, stop the thread, and verify the contents of the file.
+        //:   (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "BREATHING TEST" << endl
+                                  << "==============" << endl;
+
+        TempDirectoryGuard tempDir;
+        const bsl::string  fileName = makeFileName(tempDir, "breathing.log");
+
+        FsUtil::FileDescriptor fd = openForAppend(fileName);
+
+        bslma::TestAllocator oa("object", veryVerbose);
+        {
+            Obj mX(16, bsls::TimeInterval(0.1), 32, &oa);
+
+            ASSERT(0 == mX.setFileDescriptor(fd));
+            ASSERT(0 == mX.start());
+
+            ASSERT(0 == mX.append("Hello, ", 7));
+            ASSERT(0 == mX.append("world!\n", 7));
+            ASSERT(0 == mX.append("Goodbye, world!\n", 16));
+
+            mX.stop();
+
+            ASSERT(30 == mX.numBytesWritten());
+            ASSERT(1  <= mX.numSyncs());
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+
+        FsUtil::close(fd);
+
+        ASSERTV(readFile(fileName),
+                "Hello, world!\nGoodbye, world!\n" == readFile(fileName));
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: BATCHED WRITES VS. ONE WRITE PER RECORD
+        //
+        // Concerns:
+        //: 1 Appending records to a batched file writer is substantially
+        //:   cheaper, for the appending thread, than writing each record to
+        //:   the file.
+        //
+        // Plan:
+        //: 1 Measure the time taken to write a large number of log-sized
+        //:   records to a file with one 'write' per record, and to append
+        //:   them to a batched file writer (including the final 'flush').
+        //
+        // Testing:
+        //   PERFORMANCE: BATCHED WRITES VS. ONE WRITE PER RECORD
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: BATCHED WRITES VS. ONE WRITE PER "
+                             "RECORD"
+                          << endl
+                          << "=============================================="
+                             "======"
+                          << endl;
+
+        enum { k_NUM_RECORDS = 200 * 1000 };
+
+        TempDirectoryGuard tempDir;
+        const bsl::string  record(
+               "17OCT2026_12:00:00.000 4242:139 INFO ball_fileobserver2.cpp:"
+               "100 ORDERS order 1001 executed at 99.5000 (IBM)\n");
+        const int          SIZE = static_cast<int>(record.length());
+
+        const bsl::string      fileName1 = makeFileName(tempDir, "direct");
+        FsUtil::FileDescriptor fd1       = openForAppend(fileName1);
+
+        Int64 start = bsls::TimeUtil::getTimer();
+        for (int i = 0; i < k_NUM_RECORDS; ++i) {
+            ASSERT(SIZE == FsUtil::write(fd1, record.data(), SIZE));
+        }
+        const Int64 direct = bsls::TimeUtil::getTimer() - start;
+        FsUtil::close(fd1);
+
+        const bsl::string      fileName2 = makeFileName(tempDir, "batched");
+        FsUtil::FileDescriptor fd2       = openForAppend(fileName2);
+
+        Obj mX(64 * 1024, bsls::TimeInterval(0.1), 0);
+        ASSERT(0 == mX.setFileDescriptor(fd2));
+        ASSERT(0 == mX.start());
+
+        start = bsls::TimeUtil::getTimer();
+        for (int i = 0; i < k_NUM_RECORDS; ++i) {
+            ASSERT(0 == mX.append(record.data(), SIZE));
+        }
+        const Int64 appended = bsls::TimeUtil::getTimer() - start;
+        ASSERT(0 == mX.flush());
+        const Int64 flushed = bsls::TimeUtil::getTimer() - start;
+
+        mX.stop();
+        FsUtil::close(fd2);
+
+        ASSERT(FsUtil::getFileSize(fileName1) ==
+                                              FsUtil::getFileSize(fileName2));
+
+        cout << "one write per record: " << direct / k_NUM_RECORDS
+             << " ns/record" << endl
+             << "batched (append):     " << appended / k_NUM_RECORDS
+             << " ns/record" << endl
+             << "batched (flushed):    " << flushed / k_NUM_RECORDS
+             << " ns/record (" << mX.numWriteCalls() << " write calls)"
+             << endl;
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
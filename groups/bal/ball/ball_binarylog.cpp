@@ -0,0 +1,467 @@
+// ball_binarylog.cpp                                                 -*-C++-*-
+
+///Implementation Notes
+///--------------------
+// Each logging thread appends its deferred messages to its own
+// 'bdlcc::SingleProducerSingleConsumerBoundedQueue', found through a
+// thread-specific key, so that logging threads never contend with one another;
+// the background thread is the single consumer of every queue.  The set of
+// queues is guarded by a mutex, which is acquired by a logging thread only
+// when its queue is created, and by the background thread once per pass over
+// the queues.
+//
+// The background thread publishes the records of each batch to the observers
+// registered with the logger manager singleton (using 'visitObservers'), so
+// that the registry of observers is locked once per batch rather than once
+// per record.
+//
+// When a thread exits, the destructor associated with the thread-specific key
+// marks the queue of the thread as abandoned; the background thread removes an
+// abandoned queue once it is empty.  Since the thread-specific key is deleted
+// when the 'BinaryLog' is destroyed, the key destructor is never invoked on a
+// queue that no longer exists.
+
+#include <ball_binarylog.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ball_binarylog_cpp,"$Id$ $CSID$")
+
+#include <ball_binarymessage.h>
+#include <ball_context.h>
+#include <ball_loggermanager.h>
+#include <ball_observer.h>
+#include <ball_record.h>
+#include <ball_recordattributes.h>
+#include <ball_transmission.h>
+
+#include <bdlcc_singleproducersingleconsumerboundedqueue.h>
+
+#include <bdlf_bind.h>
+
+#include <bdls_processutil.h>
+
+#include <bdlt_currenttime.h>
+#include <bdlt_datetime.h>
+
+#include <bslma_default.h>
+
+#include <bslmt_lockguard.h>
+#include <bslmt_threadattributes.h>
+
+#include <bslstl_stringref.h>
+
+#include <bsls_assert.h>
+
+#include <bsl_ostream.h>
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace ball {
+
+namespace {
+
+enum {
+    k_PUBLISH_BATCH_SIZE     = 256,  // maximum number of messages published
+                                     // from one buffer before moving on to the
+                                     // next
+
+    k_IDLE_SLEEP_MICROSECONDS = 1000  // time the background thread sleeps when
+                                      // all buffers are empty
+};
+
+                        // =====================
+                        // struct BinaryLogEntry
+                        // =====================
+
+struct BinaryLogEntry {
+    // This 'struct' holds a deferred log message and the attributes captured
+    // when it was logged.
+
+    const Category      *d_category_p;  // category (held, not owned)
+    int                  d_severity;    // severity
+    const char          *d_fileName_p;  // file name (held, not owned)
+    int                  d_lineNumber;  // line number
+    bdlt::Datetime       d_timestamp;   // time at which message was logged
+    bsls::Types::Uint64  d_threadId;    // id of the logging thread
+    BinaryMessage        d_message;     // encoded message
+};
+
+void renderMessage(Record *record, const BinaryMessage& message)
+    // Render the specified 'message' into the message attribute of the
+    // specified 'record'.
+{
+    bsl::ostream stream(&record->fixedFields().messageStreamBuf());
+    message.render(stream);
+}
+
+typedef bsl::vector<bsl::shared_ptr<const Record> > Records;
+
+                        // ===========================
+                        // class PublishRecordsVisitor
+                        // ===========================
+
+class PublishRecordsVisitor {
+    // This functor publishes a sequence of records to each observer it is
+    // invoked on.
+
+    // DATA
+    const Records& d_records;  // records to publish
+
+  public:
+    // CREATORS
+    explicit PublishRecordsVisitor(const Records& records)
+        // Create a visitor that publishes the specified 'records'.
+    : d_records(records)
+    {
+    }
+
+    // ACCESSORS
+    void operator()(const bsl::shared_ptr<Observer>& observer,
+                    const bslstl::StringRef&) const
+        // Publish the records of this visitor to the specified 'observer'.
+    {
+        const Context context(Transmission::e_PASSTHROUGH,
+                              0,                           // recordIndex
+                              1);                          // sequenceLength
+
+        for (Records::const_iterator it = d_records.begin();
+                                     it != d_records.end(); ++it) {
+            observer->publish(*it, context);
+        }
+    }
+};
+
+extern "C" void abandonThreadBuffer(void *buffer);
+    // Mark the specified 'buffer' (of type 'BinaryLog_ThreadBuffer') as
+    // abandoned.  This function is invoked when a thread having a buffer
+    // exits.
+
+}  // close unnamed namespace
+
+                        // ============================
+                        // class BinaryLog_ThreadBuffer
+                        // ============================
+
+class BinaryLog_ThreadBuffer {
+    // This class holds the queue of deferred messages of one logging thread,
+    // and whether that thread has exited.
+
+    // PRIVATE TYPES
+    typedef bdlcc::SingleProducerSingleConsumerBoundedQueue<BinaryLogEntry>
+                                                                        Queue;
+
+    // DATA
+    Queue            d_queue;        // deferred messages
+    bsls::AtomicBool d_isAbandoned;  // 'true' once the thread has exited
+
+  private:
+    // NOT IMPLEMENTED
+    BinaryLog_ThreadBuffer(const BinaryLog_ThreadBuffer&);
+    BinaryLog_ThreadBuffer& operator=(const BinaryLog_ThreadBuffer&);
+
+  public:
+    // CREATORS
+    BinaryLog_ThreadBuffer(int capacity, bslma::Allocator *basicAllocator)
+        // Create a buffer holding up to the specified 'capacity' messages,
+        // using the specified 'basicAllocator' to supply memory.
+    : d_queue(capacity, basicAllocator)
+    , d_isAbandoned(false)
+    {
+    }
+
+    // MANIPULATORS
+    void abandon()
+        // Mark this buffer as abandoned by its thread.
+    {
+        d_isAbandoned.storeRelease(true);
+    }
+
+    int tryPopFront(BinaryLogEntry *entry)
+        // Remove the oldest message from this buffer and load it into the
+        // specified 'entry'.  Return 0 on success, and a non-zero value if
+        // this buffer is empty.
+    {
+        return d_queue.tryPopFront(entry);
+    }
+
+    int tryPushBack(const BinaryLogEntry& entry)
+        // Append the specified 'entry' to this buffer.  Return 0 on success,
+        // and a non-zero value if this buffer is full.
+    {
+        return d_queue.tryPushBack(entry);
+    }
+
+    // ACCESSORS
+    bool isReclaimable() const
+        // Return 'true' if the thread of this buffer has exited and all of its
+        // messages have been removed, and 'false' otherwise.
+    {
+        return d_isAbandoned.loadAcquire() && d_queue.isEmpty();
+    }
+};
+
+namespace {
+
+extern "C" void abandonThreadBuffer(void *buffer)
+{
+    static_cast<BinaryLog_ThreadBuffer *>(buffer)->abandon();
+}
+
+}  // close unnamed namespace
+
+                        // ---------------
+                        // class BinaryLog
+                        // ---------------
+
+// CLASS DATA
+bsls::AtomicPointer<BinaryLog> BinaryLog::s_running_p(0);
+
+// PRIVATE MANIPULATORS
+void BinaryLog::enqueue(const Category *category,
+                        int             severity,
+                        const char     *fileName,
+                        int             lineNumber,
+                        const char     *format,
+                        bsl::va_list    arguments)
+{
+    BinaryLogEntry entry;
+
+    entry.d_category_p = category;
+    entry.d_severity   = severity;
+    entry.d_fileName_p = fileName;
+    entry.d_lineNumber = lineNumber;
+    entry.d_timestamp  = bdlt::CurrentTime::utc();
+    entry.d_threadId   = bslmt::ThreadUtil::selfIdAsUint64();
+    entry.d_message.encodeList(format, arguments);
+
+    if (0 != threadBuffer()->tryPushBack(entry)) {
+        d_numDropped.addRelaxed(1);
+    }
+}
+
+void BinaryLog::publishMessages()
+{
+    static const int pid = bdls::ProcessUtil::getProcessId();
+
+    Buffers        buffers(d_allocator_p);
+    Records        records(d_allocator_p);
+    BinaryLogEntry entry;
+
+    records.reserve(k_PUBLISH_BATCH_SIZE);
+
+    while (true) {
+        // 'd_isStopping' is read before the buffers are drained, so that the
+        // pass in which it is first observed to be 'true' publishes every
+        // message logged before 'stop' was called.
+
+        const bool isStopping = d_isStopping.loadAcquire();
+
+        {
+            bslmt::LockGuard<bslmt::Mutex> guard(&d_buffersLock);
+
+            for (Buffers::iterator it = d_buffers.begin();
+                                   it != d_buffers.end(); ) {
+                if ((*it)->isReclaimable()) {
+                    it = d_buffers.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+            buffers = d_buffers;
+        }
+
+        bsls::Types::Uint64 numPublished = 0;
+
+        for (Buffers::iterator it = buffers.begin(); it != buffers.end();
+                                                                        ++it) {
+            records.clear();
+            while (records.size() <
+                                static_cast<bsl::size_t>(k_PUBLISH_BATCH_SIZE)
+                && 0 == (*it)->tryPopFront(&entry)) {
+                bsl::shared_ptr<Record> record;
+                record.createInplace(d_allocator_p, d_allocator_p);
+
+                RecordAttributes& attributes = record->fixedFields();
+
+                attributes.setTimestamp(entry.d_timestamp);
+                attributes.setCategory(entry.d_category_p->categoryName());
+                attributes.setSeverity(entry.d_severity);
+                attributes.setProcessID(pid);
+                attributes.setThreadID(entry.d_threadId);
+                attributes.setFileName(entry.d_fileName_p);
+                attributes.setLineNumber(entry.d_lineNumber);
+                renderMessage(record.get(), entry.d_message);
+
+                records.push_back(record);
+            }
+
+            if (!records.empty()) {
+                PublishRecordsVisitor visitor(records);
+                LoggerManager::singleton().visitObservers(visitor);
+                numPublished += records.size();
+            }
+        }
+
+        if (numPublished) {
+            d_numPublished.addAcqRel(numPublished);
+        }
+        else if (isStopping) {
+            break;
+        }
+        else {
+            bslmt::ThreadUtil::microSleep(k_IDLE_SLEEP_MICROSECONDS);
+        }
+    }
+}
+
+BinaryLog_ThreadBuffer *BinaryLog::threadBuffer()
+{
+    void *value = bslmt::ThreadUtil::getSpecific(d_bufferKey);
+    if (value) {
+        return static_cast<BinaryLog_ThreadBuffer *>(value);          // RETURN
+    }
+
+    bsl::shared_ptr<BinaryLog_ThreadBuffer> handle;
+    handle.createInplace(d_allocator_p, d_bufferCapacity, d_allocator_p);
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_buffersLock);
+        d_buffers.push_back(handle);
+    }
+
+    bslmt::ThreadUtil::setSpecific(d_bufferKey, handle.get());
+
+    return handle.get();
+}
+
+// CLASS METHODS
+void BinaryLog::log(const Category *category,
+                    int             severity,
+                    const char     *fileName,
+                    int             lineNumber,
+                    const char     *format,
+                    ...)
+{
+    BSLS_ASSERT(1 <= severity);  BSLS_ASSERT(severity <= 255);
+    BSLS_ASSERT(fileName);
+    BSLS_ASSERT(format);
+
+    bsl::va_list arguments;
+    va_start(arguments, format);
+
+    BinaryLog *binaryLog = s_running_p.loadAcquire();
+
+    if (binaryLog && category && severity <= category->passLevel()) {
+        binaryLog->enqueue(category,
+                           severity,
+                           fileName,
+                           lineNumber,
+                           format,
+                           arguments);
+    }
+    else {
+        BinaryMessage message;
+        message.encodeList(format, arguments);
+
+        Record *record = Log::getRecord(category, fileName, lineNumber);
+        renderMessage(record, message);
+        Log::logMessage(category, severity, record);
+    }
+
+    va_end(arguments);
+}
+
+// CREATORS
+BinaryLog::BinaryLog(bslma::Allocator *basicAllocator)
+: d_bufferCapacity(k_DEFAULT_BUFFER_CAPACITY)
+, d_buffers(basicAllocator)
+, d_publicationThread(bslmt::ThreadUtil::invalidHandle())
+, d_isStopping(false)
+, d_numPublished(0)
+, d_numDropped(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    int rc = bslmt::ThreadUtil::createKey(&d_bufferKey, &abandonThreadBuffer);
+    BSLS_ASSERT_OPT(0 == rc);  (void)rc;
+}
+
+BinaryLog::BinaryLog(int bufferCapacity, bslma::Allocator *basicAllocator)
+: d_bufferCapacity(bufferCapacity)
+, d_buffers(basicAllocator)
+, d_publicationThread(bslmt::ThreadUtil::invalidHandle())
+, d_isStopping(false)
+, d_numPublished(0)
+, d_numDropped(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 < bufferCapacity);
+
+    int rc = bslmt::ThreadUtil::createKey(&d_bufferKey, &abandonThreadBuffer);
+    BSLS_ASSERT_OPT(0 == rc);  (void)rc;
+}
+
+BinaryLog::~BinaryLog()
+{
+    stop();
+    bslmt::ThreadUtil::deleteKey(d_bufferKey);
+}
+
+// MANIPULATORS
+int BinaryLog::start()
+{
+    if (!LoggerManager::isInitialized()) {
+        return 1;                                                     // RETURN
+    }
+
+    if (0 != s_running_p.testAndSwap(0, this)) {
+        return 2;                                                     // RETURN
+    }
+
+    d_isStopping.storeRelease(false);
+
+    bslmt::ThreadAttributes attributes;
+    int                     rc = bslmt::ThreadUtil::create(
+                            &d_publicationThread,
+                            attributes,
+                            bdlf::BindUtil::bind(&BinaryLog::publishMessages,
+                                                 this));
+    if (0 != rc) {
+        s_running_p.storeRelease(0);
+        d_publicationThread = bslmt::ThreadUtil::invalidHandle();
+        return 3;                                                     // RETURN
+    }
+
+    return 0;
+}
+
+void BinaryLog::stop()
+{
+    if (this != s_running_p.testAndSwap(this, 0)) {
+        return;                                                       // RETURN
+    }
+
+    d_isStopping.storeRelease(true);
+
+    bslmt::ThreadUtil::join(d_publicationThread);
+    d_publicationThread = bslmt::ThreadUtil::invalidHandle();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
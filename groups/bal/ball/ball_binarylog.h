@@ -0,0 +1,445 @@
+// ball_binarylog.h                                                   -*-C++-*-
+#ifndef INCLUDED_BALL_BINARYLOG
+#define INCLUDED_BALL_BINARYLOG
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide 'printf'-style logging macros with deferred formatting.
+//
+//@CLASSES:
+//  ball::BinaryLog: mechanism that publishes deferred log messages
+//
+//@MACROS: BALL_LOGBIN_TRACE,             BALL_LOGBIN_DEBUG,
+//         BALL_LOGBIN_INFO,              BALL_LOGBIN_WARN,
+//         BALL_LOGBIN_ERROR,             BALL_LOGBIN_FATAL,
+//         BALL_LOGBIN
+//
+//@SEE_ALSO: ball_log, ball_binarymessage, ball_loggermanager
+//
+//@DESCRIPTION: This component provides a set of 'printf'-style logging macros,
+// analogous to the 'BALL_LOGVA_*' macros of 'ball_log', whose cost to the
+// logging thread does not include formatting the message.  For example, the
+// deferred version of 'BALL_LOGVA_INFO' is 'BALL_LOGBIN_INFO', and the
+// deferred version of 'BALL_LOGVA' is 'BALL_LOGBIN'.
+//
+// When a 'ball::BinaryLog' object is running (see {'ball::BinaryLog'}), a
+// 'BALL_LOGBIN_*' macro whose category and severity enable logging captures
+// the address of its format string and the raw values of its arguments (see
+// 'ball_binarymessage'), together with the file name, line number, timestamp,
+// and thread id of the call site, and appends them to a bounded buffer owned
+// by the calling thread.  A background thread of the running 'BinaryLog'
+// drains the buffers of all threads, renders each message, and publishes a
+// 'ball::Record' having the captured attributes to the observers registered
+// with the logger manager singleton, which format the record (e.g., using
+// 'ball::RecordStringFormatter') as usual.  The logging thread therefore pays
+// only for copying the arguments and a single-producer queue insertion, and
+// never contends with other logging threads.
+//
+// When no 'ball::BinaryLog' is running, the macros log synchronously, exactly
+// as the 'BALL_LOGVA_*' macros do.
+//
+///Differences from Synchronous Logging
+///------------------------------------
+// A message logged by a 'BALL_LOGBIN_*' macro differs from one logged by the
+// corresponding 'BALL_LOGVA_*' macro in the following ways:
+//
+//: o The format string must be a string literal (which is enforced at
+//:   compile time), and the arguments are subject to the restrictions
+//:   described in 'ball_binarymessage'.  In particular, string arguments are
+//:   copied, but the message (in both modes) is truncated if its arguments
+//:   exceed 'ball::BinaryMessage::k_CAPACITY' bytes.
+//:
+//: o Messages logged while a 'BinaryLog' is running are published directly to
+//:   the observers, bypassing the logger's record buffer.  Only messages whose
+//:   severity is within the *pass* threshold of their category are deferred;
+//:   other enabled messages (i.e., those enabled only by the record or trigger
+//:   threshold, or by a logging rule) are logged synchronously, so that the
+//:   record buffer and triggers behave as they do for 'BALL_LOGVA'.
+//:
+//: o The user fields populator of the logger manager is not invoked for
+//:   deferred messages.
+//:
+//: o Messages logged by different threads are published in an order that
+//:   is consistent with the order in which each thread logged them, but not
+//:   necessarily with their timestamps.
+//:
+//: o If the buffer of the logging thread is full, the message is discarded
+//:   (see 'numDroppedMessages').  Logging threads never block.
+//
+///'ball::BinaryLog'
+///-----------------
+// At most one 'ball::BinaryLog' object can be running at a time.  A
+// 'BinaryLog' is started by calling 'start', which fails unless the logger
+// manager singleton has been initialized and no other 'BinaryLog' is running,
+// and is stopped by calling 'stop' (or by destroying it).  'stop' blocks
+// until all messages logged before it was called have been published.
+//
+// Each thread that logs a deferred message is given its own buffer, holding
+// up to 'bufferCapacity()' messages, the first time it does so.  The buffer of
+// a thread is reclaimed once the thread has exited and its messages have been
+// published.
+//
+// The background thread publishes the contents of the buffers in batches, and
+// sleeps for a short interval when all of the buffers are empty.
+//
+// Note that 'start' and 'stop' must not be called while another thread is
+// logging through the 'BinaryLog' being started or stopped (e.g., from a
+// thread that logs deferred messages while the application is shutting down),
+// much as the logger manager singleton must not be destroyed while threads
+// are logging.
+//
+///Thread Safety
+///-------------
+// The 'BALL_LOGBIN_*' macros and 'ball::BinaryLog::log' are *thread-safe*.
+// The manipulators of 'ball::BinaryLog' must not be called concurrently with
+// one another; its accessors are *thread-safe*.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Logging from a Latency-Sensitive Thread
+/// - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we have a function, invoked on the critical path of an order
+// handling thread, that records the execution of an order.  The cost of
+// formatting a log message there is undesirable, so we use the deferred
+// logging macros.
+//
+// First, we initialize the logger manager singleton, registering an observer
+// that will receive the published records:
+//..
+//  ball::LoggerManagerConfiguration configuration;
+//  configuration.setDefaultThresholdLevelsIfValid(ball::Severity::e_INFO);
+//
+//  ball::LoggerManagerScopedGuard guard(configuration);
+//
+//  bsl::shared_ptr<ball::TestObserver> observer =
+//                                     bsl::make_shared<ball::TestObserver>(
+//                                                                 &bsl::cout);
+//  ball::LoggerManager::singleton().registerObserver(observer, "default");
+//..
+// Then, we create and start a 'ball::BinaryLog' object:
+//..
+//  ball::BinaryLog binaryLog;
+//  int             rc = binaryLog.start();
+//  assert(0 == rc);
+//..
+// Next, we define the function that logs each execution:
+//..
+//  void recordExecution(int orderId, double price, const char *symbol)
+//  {
+//      BALL_LOG_SET_CATEGORY("ORDERS");
+//
+//      BALL_LOGBIN_INFO("order %d executed at %.4f (%s)",
+//                       orderId,
+//                       price,
+//                       symbol);
+//  }
+//..
+// Then, we call the function; the arguments are captured and the message is
+// published by the background thread of 'binaryLog':
+//..
+//  recordExecution(1001, 99.5, "IBM");
+//..
+// Finally, we stop 'binaryLog', which publishes any messages that are still
+// buffered:
+//..
+//  binaryLog.stop();
+//
+//  assert(1 == observer->numPublishedRecords());
+//  assert(bsl::string("order 1001 executed at 99.5000 (IBM)") ==
+//                 observer->lastPublishedRecord().fixedFields().message());
+//..
+
+#include <balscm_version.h>
+
+#include <ball_category.h>
+#include <ball_log.h>
+#include <ball_severity.h>
+
+#include <bslma_allocator.h>
+
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bslmt_mutex.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_annotation.h>
+#include <bsls_atomic.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdarg.h>
+#include <bsl_memory.h>
+#include <bsl_vector.h>
+
+                       // ======================
+                       // Implementation Details
+                       // ======================
+
+// BALL_LOGBIN_CONST_IMP requires its first argument to be a compile-time
+// constant, while all the others may be variables, except for the format,
+// which must be a string literal.  The format is captured by address and
+// formatted only when the message is published, so the macros prefix it with
+// an empty string literal, rejecting at compile time any format that is not a
+// string literal (and so might not outlive the message).
+
+#define BALL_LOGBIN_CONST_IMP(SEVERITY, ...)                                  \
+do {                                                                          \
+    if (const BloombergLP::ball::CategoryHolder *ball_log_cAtEgOrYhOlDeR =    \
+               BloombergLP::ball::Log::categoryHolderIfEnabled<(SEVERITY)>(   \
+                      ball_log_getCategoryHolder(BALL_LOG_CATEGORYHOLDER))) { \
+        BloombergLP::ball::BinaryLog::log(                                    \
+                                       ball_log_cAtEgOrYhOlDeR->category(),   \
+                                       (SEVERITY),                            \
+                                       __FILE__,                              \
+                                       __LINE__,                              \
+                                       "" __VA_ARGS__);                       \
+    }                                                                         \
+} while(0)
+
+                       // ======================
+                       // Deferred-format macros
+                       // ======================
+
+// BALL_LOGBIN allows all its arguments, except for the format string
+// literal, to be calculated at run-time, at a cost in performance.
+
+#define BALL_LOGBIN(SEVERITY, ...)                                            \
+do {                                                                          \
+    const BloombergLP::ball::CategoryHolder *ball_log_cAtEgOrYhOlDeR =        \
+                         ball_log_getCategoryHolder(BALL_LOG_CATEGORYHOLDER); \
+    if (ball_log_cAtEgOrYhOlDeR->threshold() >= (SEVERITY) &&                 \
+           BloombergLP::ball::Log::isCategoryEnabled(ball_log_cAtEgOrYhOlDeR, \
+                                                     (SEVERITY))) {           \
+        BloombergLP::ball::BinaryLog::log(                                    \
+                                       ball_log_cAtEgOrYhOlDeR->category(),   \
+                                       (SEVERITY),                            \
+                                       __FILE__,                              \
+                                       __LINE__,                              \
+                                       "" __VA_ARGS__);                       \
+    }                                                                         \
+} while(0)
+
+#define BALL_LOGBIN_TRACE(...)                                                \
+    BALL_LOGBIN_CONST_IMP(BloombergLP::ball::Severity::e_TRACE, __VA_ARGS__)
+
+#define BALL_LOGBIN_DEBUG(...)                                                \
+    BALL_LOGBIN_CONST_IMP(BloombergLP::ball::Severity::e_DEBUG, __VA_ARGS__)
+
+#define BALL_LOGBIN_INFO( ...)                                                \
+    BALL_LOGBIN_CONST_IMP(BloombergLP::ball::Severity::e_INFO,  __VA_ARGS__)
+
+#define BALL_LOGBIN_WARN( ...)                                                \
+    BALL_LOGBIN_CONST_IMP(BloombergLP::ball::Severity::e_WARN,  __VA_ARGS__)
+
+#define BALL_LOGBIN_ERROR(...)                                                \
+    BALL_LOGBIN_CONST_IMP(BloombergLP::ball::Severity::e_ERROR, __VA_ARGS__)
+
+#define BALL_LOGBIN_FATAL(...)                                                \
+    BALL_LOGBIN_CONST_IMP(BloombergLP::ball::Severity::e_FATAL, __VA_ARGS__)
+
+namespace BloombergLP {
+namespace ball {
+
+class BinaryLog_ThreadBuffer;
+
+                        // ===============
+                        // class BinaryLog
+                        // ===============
+
+class BinaryLog {
+    // This mechanism, while running, receives the deferred log messages of
+    // every thread into per-thread buffers, and publishes them from a
+    // background thread to the observers of the logger manager singleton.  At
+    // most one 'BinaryLog' can be running at a time.
+
+    // PRIVATE TYPES
+    typedef bsl::vector<bsl::shared_ptr<BinaryLog_ThreadBuffer> > Buffers;
+
+    // CLASS DATA
+    static bsls::AtomicPointer<BinaryLog> s_running_p;
+                                             // running binary log, if any
+
+    // DATA
+    int                         d_bufferCapacity;
+                                             // capacity of each per-thread
+                                             // buffer
+
+    bslmt::ThreadUtil::Key      d_bufferKey; // key to each thread's buffer
+
+    Buffers                     d_buffers;   // buffers of all threads
+
+    bslmt::Mutex                d_buffersLock;
+                                             // lock for 'd_buffers'
+
+    bslmt::ThreadUtil::Handle   d_publicationThread;
+                                             // handle of the background thread
+
+    bsls::AtomicBool            d_isStopping;
+                                             // 'true' once 'stop' is called
+
+    bsls::AtomicUint64          d_numPublished;
+                                             // number of deferred messages
+                                             // published
+
+    bsls::AtomicUint64          d_numDropped;
+                                             // number of deferred messages
+                                             // dropped due to a full buffer
+
+    bslma::Allocator           *d_allocator_p;
+                                             // memory allocator (held, not
+                                             // owned)
+
+    // NOT IMPLEMENTED
+    BinaryLog(const BinaryLog&);
+    BinaryLog& operator=(const BinaryLog&);
+
+    // PRIVATE MANIPULATORS
+    void enqueue(const Category *category,
+                 int             severity,
+                 const char     *fileName,
+                 int             lineNumber,
+                 const char     *format,
+                 bsl::va_list    arguments);
+        // Append to the buffer of the calling thread a deferred message having
+        // the specified 'category', 'severity', 'fileName', 'lineNumber',
+        // 'format', and 'arguments', together with the current time and the
+        // id of the calling thread.  If the buffer is full, discard the
+        // message.
+
+    void publishMessages();
+        // Publish the deferred messages appended to the buffers of all
+        // threads until 'stop' is called and all buffers are empty.  This
+        // method is the entry point of the background thread.
+
+    BinaryLog_ThreadBuffer *threadBuffer();
+        // Return the address of the buffer of the calling thread, creating it
+        // if necessary.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(BinaryLog, bslma::UsesBslmaAllocator);
+
+    // PUBLIC CONSTANTS
+    enum {
+        k_DEFAULT_BUFFER_CAPACITY = 1024  // default per-thread capacity, in
+                                          // messages
+    };
+
+    // CLASS METHODS
+    static void log(const Category *category,
+                    int             severity,
+                    const char     *fileName,
+                    int             lineNumber,
+                    const char     *format,
+                    ...) BSLS_ANNOTATION_PRINTF(5, 6);
+        // Log a message having the specified 'category', 'severity',
+        // 'fileName', and 'lineNumber', whose text is rendered from the
+        // specified 'format' and the arguments that follow it.  If a
+        // 'BinaryLog' is running, 'category' is not null, and 'severity' is
+        // within the pass threshold of 'category', the message is deferred;
+        // otherwise, it is logged synchronously.  The behavior is undefined
+        // unless 'format' and the arguments satisfy the requirements of
+        // 'BinaryMessage::encode' and '1 <= severity <= 255'.  Note that this
+        // method is intended to be used by the 'BALL_LOGBIN_*' macros, which
+        // check whether logging is enabled before calling it.
+
+    // CREATORS
+    explicit BinaryLog(bslma::Allocator *basicAllocator = 0);
+    explicit BinaryLog(int               bufferCapacity,
+                       bslma::Allocator *basicAllocator = 0);
+        // Create a binary log that is not running.  Optionally specify
+        // 'bufferCapacity', the maximum number of messages held by the buffer
+        // of each logging thread; if 'bufferCapacity' is not specified,
+        // 'k_DEFAULT_BUFFER_CAPACITY' is used.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless '0 < bufferCapacity'.
+
+    ~BinaryLog();
+        // Stop this binary log, if it is running, and destroy it.
+
+    // MANIPULATORS
+    int start();
+        // Start the background thread of this binary log and make it the
+        // running binary log.  Return 0 on success, and a non-zero value if
+        // this or another binary log is running, if the logger manager
+        // singleton has not been initialized, or if the thread could not be
+        // created.
+
+    void stop();
+        // Stop this binary log, if it is running: subsequent deferred log
+        // messages are logged synchronously, and this method blocks until all
+        // messages buffered by this binary log have been published.
+
+    // ACCESSORS
+    int bufferCapacity() const;
+        // Return the maximum number of messages held by the buffer of each
+        // logging thread.
+
+    bool isRunning() const;
+        // Return 'true' if this binary log is running, and 'false' otherwise.
+
+    bsls::Types::Uint64 numDroppedMessages() const;
+        // Return the number of deferred messages discarded by this binary log
+        // because the buffer of the logging thread was full.
+
+    bsls::Types::Uint64 numPublishedMessages() const;
+        // Return the number of deferred messages published by this binary
+        // log.
+};
+
+// ============================================================================
+//                              INLINE DEFINITIONS
+// ============================================================================
+
+                        // ---------------
+                        // class BinaryLog
+                        // ---------------
+
+// ACCESSORS
+inline
+int BinaryLog::bufferCapacity() const
+{
+    return d_bufferCapacity;
+}
+
+inline
+bool BinaryLog::isRunning() const
+{
+    return this == s_running_p.loadAcquire();
+}
+
+inline
+bsls::Types::Uint64 BinaryLog::numDroppedMessages() const
+{
+    return d_numDropped.loadRelaxed();
+}
+
+inline
+bsls::Types::Uint64 BinaryLog::numPublishedMessages() const
+{
+    return d_numPublished.loadAcquire();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
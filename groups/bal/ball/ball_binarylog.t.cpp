@@ -0,0 +1,995 @@
+// ball_binarylog.t.cpp                                               -*-C++-*-
+#include <ball_binarylog.h>
+
+#include <ball_binarymessage.h>
+#include <ball_context.h>
+#include <ball_log.h>
+#include <ball_loggermanager.h>
+#include <ball_loggermanagerconfiguration.h>
+#include <ball_observer.h>
+#include <ball_record.h>
+#include <ball_recordattributes.h>
+#include <ball_severity.h>
+#include <ball_testobserver.h>
+
+#include <bdlf_bind.h>
+
+#include <bdlt_currenttime.h>
+#include <bdlt_datetime.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_testallocator.h>
+
+#include <bslmt_lockguard.h>
+#include <bslmt_mutex.h>
+#include <bslmt_threadgroup.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_timeutil.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_memory.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                             TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test provides a mechanism, 'ball::BinaryLog', and a set
+// of macros that log through it.  The logger manager singleton is created in
+// each test case with an observer that records the published records, and the
+// records published for messages logged through the macros (and through
+// 'ball::BinaryLog::log') are compared with the values that were logged,
+// both while a 'BinaryLog' is running (deferred logging) and while none is
+// (synchronous logging).
+//
+// Since publication is asynchronous, the records published for deferred
+// messages are examined only after 'stop' has been called, which guarantees
+// that every message logged before the call has been published.
+//-----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 3] static void log(category, severity, fileName, lineNumber, format, ...);
+//
+// CREATORS
+// [ 2] explicit BinaryLog(bslma::Allocator *basicAllocator = 0);
+// [ 2] explicit BinaryLog(int bufferCapacity, bslma::Allocator *ba = 0);
+// [ 2] ~BinaryLog();
+//
+// MANIPULATORS
+// [ 2] int start();
+// [ 2] void stop();
+//
+// ACCESSORS
+// [ 2] int bufferCapacity() const;
+// [ 2] bool isRunning() const;
+// [ 4] bsls::Types::Uint64 numDroppedMessages() const;
+// [ 3] bsls::Types::Uint64 numPublishedMessages() const;
+//
+// MACROS
+// [ 5] BALL_LOGBIN_TRACE(FORMAT, ...);
+// [ 5] BALL_LOGBIN_DEBUG(FORMAT, ...);
+// [ 5] BALL_LOGBIN_INFO(FORMAT, ...);
+// [ 5] BALL_LOGBIN_WARN(FORMAT, ...);
+// [ 5] BALL_LOGBIN_ERROR(FORMAT, ...);
+// [ 5] BALL_LOGBIN_FATAL(FORMAT, ...);
+// [ 5] BALL_LOGBIN(SEVERITY, FORMAT, ...);
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] CONCURRENT LOGGING
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE: LATENCY OF THE LOGGING THREAD
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef ball::BinaryLog Obj;
+
+static bool verbose;
+static bool veryVerbose;
+
+//=============================================================================
+//                  GLOBAL CLASSES FOR TESTING
+//-----------------------------------------------------------------------------
+
+                          // =======================
+                          // class RecordingObserver
+                          // =======================
+
+class RecordingObserver : public ball::Observer {
+    // This observer keeps every record published to it.
+
+    // DATA
+    bsl::vector<bsl::shared_ptr<const ball::Record> > d_records;
+    mutable bslmt::Mutex                              d_mutex;
+
+  public:
+    // CREATORS
+    explicit RecordingObserver(bslma::Allocator *basicAllocator = 0)
+    : d_records(basicAllocator)
+    {
+    }
+
+    // MANIPULATORS
+    using ball::Observer::publish;
+
+    void publish(const bsl::shared_ptr<const ball::Record>& record,
+                 const ball::Context&)
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        d_records.push_back(record);
+    }
+
+    void releaseRecords()
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        d_records.clear();
+    }
+
+    // ACCESSORS
+    bsl::size_t numRecords() const
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        return d_records.size();
+    }
+
+    const ball::Record& record(bsl::size_t index) const
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        return *d_records[index];
+    }
+};
+
+//=============================================================================
+//                  GLOBAL HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static int logMessages(int threadIndex, int numMessages)
+    // Log the specified 'numMessages' deferred messages identifying the
+    // specified 'threadIndex' and the sequence number of each message.
+    // Return 0.
+{
+    BALL_LOG_SET_CATEGORY("CONCURRENT");
+
+    for (int i = 0; i < numMessages; ++i) {
+        BALL_LOGBIN_INFO("%d %d", threadIndex, i);
+    }
+    return 0;
+}
+
+static void logSampleMessage(const ball::Category *category,
+                             const char           *fileName,
+                             int                   lineNumber)
+    // Log, at 'e_WARN' severity, a message having the specified 'category',
+    // 'fileName', and 'lineNumber', whose text is "abc    12|2.500   |z".
+{
+    Obj::log(category,
+             ball::Severity::e_WARN,
+             fileName,
+             lineNumber,
+             "%s %5d|%-8.3f|%c",
+             "abc",
+             12,
+             2.5,
+             'z');
+}
+
+namespace BALL_BINARYLOG_TEST_PERFORMANCE {
+
+class NullObserver : public ball::Observer {
+    // This observer counts, and otherwise ignores, the records published to
+    // it.
+
+    // DATA
+    bsls::AtomicInt64 d_numRecords;
+
+  public:
+    // CREATORS
+    NullObserver()
+    : d_numRecords(0)
+    {
+    }
+
+    // MANIPULATORS
+    using ball::Observer::publish;
+
+    void publish(const bsl::shared_ptr<const ball::Record>&,
+                 const ball::Context&)
+    {
+        ++d_numRecords;
+    }
+
+    // ACCESSORS
+    bsls::Types::Int64 numRecords() const
+    {
+        return d_numRecords;
+    }
+};
+
+}  // close namespace BALL_BINARYLOG_TEST_PERFORMANCE
+
+//=============================================================================
+//                                USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Logging from a Latency-Sensitive Thread
+/// - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we have a function, invoked on the critical path of an order
+// handling thread, that records the execution of an order.  The cost of
+// formatting a log message there is undesirable, so we use the deferred
+// logging macros.
+//
+// Next, we define the function that logs each execution:
+//..
+    void recordExecution(int orderId, double price, const char *symbol)
+    {
+        BALL_LOG_SET_CATEGORY("ORDERS");
+
+        BALL_LOGBIN_INFO("order %d executed at %.4f (%s)",
+                         orderId,
+                         price,
+                         symbol);
+    }
+//..
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    verbose     = argc > 2;
+    veryVerbose = argc > 3;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "USAGE EXAMPLE" << endl
+                                  << "=============" << endl;
+
+// First, we initialize the logger manager singleton, registering an observer
+// that will receive the published records:
+//..
+    ball::LoggerManagerConfiguration configuration;
+    configuration.setDefaultThresholdLevelsIfValid(ball::Severity::e_INFO);
+
+    ball::LoggerManagerScopedGuard guard(configuration);
+
+    bsl::shared_ptr<ball::TestObserver> observer =
+                                       bsl::make_shared<ball::TestObserver>(
+                                                                   &bsl::cout);
+    ball::LoggerManager::singleton().registerObserver(observer, "default");
+//..
+// Then, we create and start a 'ball::BinaryLog' object:
+//..
+    ball::BinaryLog binaryLog;
+    int             rc = binaryLog.start();
+    ASSERT(0 == rc);
+//..
+// Then, we call the function; the arguments are captured and the message is
+// published by the background thread of 'binaryLog':
+//..
+    recordExecution(1001, 99.5, "IBM");
+//..
+// Finally, we stop 'binaryLog', which publishes any messages that are still
+// buffered:
+//..
+    binaryLog.stop();
+
+    ASSERT(1 == observer->numPublishedRecords());
+    ASSERT(bsl::string("order 1001 executed at 99.5000 (IBM)") ==
+                   observer->lastPublishedRecord().fixedFields().message());
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING MACROS
+        //
+        // Concerns:
+        //: 1 Each severity-specific macro logs a message having its severity.
+        //:
+        //: 2 'BALL_LOGBIN' logs a message having the (run-time) severity
+        //:   supplied to it.
+        //:
+        //: 3 Messages whose severity does not enable logging are neither
+        //:   published nor buffered.
+        //:
+        //: 4 The file name and line number of the call site are captured.
+        //:
+        //: 5 A format that is not a string literal is rejected at compile
+        //:   time.
+        //
+        // Plan:
+        //: 1 With a running 'BinaryLog', invoke each macro at enabled and
+        //:   disabled severities, stop the 'BinaryLog', and verify the
+        //:   published records.  (C-1..4)
+        //:
+        //: 2 Provide an 'ifdef'ed invocation of the macros with a format that
+        //:   is not a string literal, which should fail to compile when
+        //:   manually tested.  (C-5)
+        //
+        // Testing:
+        //   BALL_LOGBIN_TRACE(FORMAT, ...);
+        //   BALL_LOGBIN_DEBUG(FORMAT, ...);
+        //   BALL_LOGBIN_INFO(FORMAT, ...);
+        //   BALL_LOGBIN_WARN(FORMAT, ...);
+        //   BALL_LOGBIN_ERROR(FORMAT, ...);
+        //   BALL_LOGBIN_FATAL(FORMAT, ...);
+        //   BALL_LOGBIN(SEVERITY, FORMAT, ...);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING MACROS" << endl
+                                  << "==============" << endl;
+
+        bslma::TestAllocator ga("global", veryVerbose);
+
+        ball::LoggerManagerConfiguration configuration;
+        configuration.setDefaultThresholdLevelsIfValid(
+                                                      ball::Severity::e_TRACE);
+
+        ball::LoggerManagerScopedGuard guard(configuration, &ga);
+
+        bsl::shared_ptr<RecordingObserver> observer =
+                                      bsl::make_shared<RecordingObserver>();
+        ball::LoggerManager::singleton().registerObserver(observer, "test");
+
+        BALL_LOG_SET_CATEGORY("MACROS");
+
+        Obj mX;
+        ASSERT(0 == mX.start());
+
+        const int LINE = L_ + 1;
+        BALL_LOGBIN_TRACE("%s", "trace");
+        BALL_LOGBIN_DEBUG("%s", "debug");
+        BALL_LOGBIN_INFO( "%s", "info");
+        BALL_LOGBIN_WARN( "%s", "warn");
+        BALL_LOGBIN_ERROR("%s", "error");
+        BALL_LOGBIN_FATAL("%s", "fatal");
+
+        int severity = ball::Severity::e_WARN;
+        BALL_LOGBIN(severity, "%s", "variable");
+
+        // Disable logging below 'e_ERROR' in the "MACROS" category.
+
+        ball::LoggerManager::singleton().setCategory(
+                                                   "MACROS",
+                                                   ball::Severity::e_OFF,
+                                                   ball::Severity::e_ERROR,
+                                                   ball::Severity::e_OFF,
+                                                   ball::Severity::e_OFF);
+
+        BALL_LOGBIN_INFO("%s", "disabled");
+        BALL_LOGBIN(severity, "%s", "disabled");
+        BALL_LOGBIN(ball::Severity::e_ERROR, "%s", "enabled");
+
+#ifdef TEST_COMPILE_FAILS
+        {
+            const char *format = "%s";
+            BALL_LOGBIN_ERROR(format, "not a literal");
+            BALL_LOGBIN(ball::Severity::e_ERROR, format, "not a literal");
+        }
+#endif
+
+        mX.stop();
+
+        const struct {
+            int         d_severity;
+            const char *d_message;
+        } EXPECTED[] = {
+            { ball::Severity::e_TRACE, "trace"    },
+            { ball::Severity::e_DEBUG, "debug"    },
+            { ball::Severity::e_INFO,  "info"     },
+            { ball::Severity::e_WARN,  "warn"     },
+            { ball::Severity::e_ERROR, "error"    },
+            { ball::Severity::e_FATAL, "fatal"    },
+            { ball::Severity::e_WARN,  "variable" },
+            { ball::Severity::e_ERROR, "enabled"  },
+        };
+        const bsl::size_t NUM_EXPECTED = sizeof EXPECTED / sizeof *EXPECTED;
+
+        ASSERTV(observer->numRecords(),
+                NUM_EXPECTED == observer->numRecords());
+        ASSERT(NUM_EXPECTED == mX.numPublishedMessages());
+
+        for (bsl::size_t i = 0; i < NUM_EXPECTED &&
+                                i < observer->numRecords(); ++i) {
+            const ball::RecordAttributes& attributes =
+                                          observer->record(i).fixedFields();
+
+            ASSERTV(i, EXPECTED[i].d_severity == attributes.severity());
+            ASSERTV(i, attributes.message(),
+                    bsl::string(EXPECTED[i].d_message) ==
+                                                        attributes.message());
+            ASSERTV(i, bsl::string("MACROS") == attributes.category());
+            ASSERTV(i, bsl::string(__FILE__) == attributes.fileName());
+            if (i < 6) {
+                ASSERTV(i,
+                        attributes.lineNumber(),
+                        LINE + static_cast<int>(i) ==
+                                                    attributes.lineNumber());
+            }
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // CONCURRENT LOGGING
+        //
+        // Concerns:
+        //: 1 Messages logged concurrently by several threads are each either
+        //:   published or counted as dropped.
+        //:
+        //: 2 The messages of each thread are published in the order in which
+        //:   they were logged, with the id of the thread that logged them.
+        //:
+        //: 3 Messages are dropped, rather than blocking the logging thread,
+        //:   when the buffer of a thread is full.
+        //:
+        //: 4 Threads that exit after logging do not prevent later messages
+        //:   from being published.
+        //
+        // Plan:
+        //: 1 Using a 'BinaryLog' having a small buffer capacity, log messages
+        //:   identifying the thread and sequence number from several threads,
+        //:   join the threads, log from the main thread, and stop the
+        //:   'BinaryLog'.  Verify that the number of published and dropped
+        //:   messages sum to the number logged, and that the sequence numbers
+        //:   published for each thread are increasing.  (C-1..4)
+        //
+        // Testing:
+        //   CONCURRENT LOGGING
+        //   bsls::Types::Uint64 numDroppedMessages() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "CONCURRENT LOGGING" << endl
+                                  << "==================" << endl;
+
+        enum { k_NUM_THREADS = 4, k_NUM_MESSAGES = 5000, k_CAPACITY = 16 };
+
+        bslma::TestAllocator ga("global", veryVerbose);
+        bslma::TestAllocator oa("object", veryVerbose);
+
+        ball::LoggerManagerConfiguration configuration;
+        configuration.setDefaultThresholdLevelsIfValid(ball::Severity::e_INFO);
+
+        ball::LoggerManagerScopedGuard guard(configuration, &ga);
+
+        bsl::shared_ptr<RecordingObserver> observer =
+                                      bsl::make_shared<RecordingObserver>();
+        ball::LoggerManager::singleton().registerObserver(observer, "test");
+
+        {
+            Obj mX(k_CAPACITY, &oa);  const Obj& X = mX;
+            ASSERT(0 == mX.start());
+
+            bslmt::ThreadGroup threadGroup;
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                const int NUM_MESSAGES = k_NUM_MESSAGES;
+                ASSERT(0 == threadGroup.addThread(bdlf::BindUtil::bind(
+                                                            &logMessages,
+                                                            i,
+                                                            NUM_MESSAGES)));
+            }
+            threadGroup.joinAll();
+
+            // Log from the main thread after the other threads have exited.
+
+            logMessages(k_NUM_THREADS, 1);
+
+            mX.stop();
+
+            const bsls::Types::Uint64 NUM_LOGGED =
+                                          k_NUM_THREADS * k_NUM_MESSAGES + 1;
+
+            if (verbose) {
+                P_(X.numPublishedMessages()) P(X.numDroppedMessages())
+            }
+
+            ASSERTV(X.numPublishedMessages(), X.numDroppedMessages(),
+                    NUM_LOGGED == X.numPublishedMessages()
+                                + X.numDroppedMessages());
+            ASSERT(observer->numRecords() == X.numPublishedMessages());
+
+            bsl::vector<int>                 lastIndex(k_NUM_THREADS + 1, -1);
+            bsl::vector<bsls::Types::Uint64> threadId(k_NUM_THREADS + 1, 0);
+            for (bsl::size_t i = 0; i < observer->numRecords(); ++i) {
+                const ball::RecordAttributes& attributes =
+                                             observer->record(i).fixedFields();
+
+                int threadIndex = -1;
+                int index       = -1;
+                ASSERTV(i, 2 == bsl::sscanf(attributes.message(),
+                                            "%d %d",
+                                            &threadIndex,
+                                            &index));
+                if (threadIndex < 0 || k_NUM_THREADS < threadIndex) {
+                    ASSERTV(i, threadIndex, false);
+                    continue;
+                }
+                ASSERTV(i, threadIndex, index, lastIndex[threadIndex] < index);
+                lastIndex[threadIndex] = index;
+
+                if (0 == threadId[threadIndex]) {
+                    threadId[threadIndex] = attributes.threadID();
+                }
+                ASSERTV(i, threadId[threadIndex] == attributes.threadID());
+            }
+
+            // The message logged by the main thread, after the buffers of the
+            // other threads were abandoned, is published.
+
+            ASSERT(0 == lastIndex[k_NUM_THREADS]);
+            ASSERT(bslmt::ThreadUtil::selfIdAsUint64() ==
+                                                     threadId[k_NUM_THREADS]);
+        }
+
+        // The published records, which are held by the observer, are
+        // allocated by the 'BinaryLog'.
+
+        observer->releaseRecords();
+        ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'log'
+        //
+        // Concerns:
+        //: 1 While no 'BinaryLog' is running, 'log' publishes the message
+        //:   synchronously, from the calling thread.
+        //:
+        //: 2 While a 'BinaryLog' is running, 'log' defers the message, which
+        //:   is published by 'stop' at the latest, with the attributes
+        //:   captured when the message was logged: the category, severity,
+        //:   file name, line number, timestamp, and id of the logging thread.
+        //:
+        //: 3 A message whose severity is enabled by the record threshold, but
+        //:   not by the pass threshold, of its category is logged
+        //:   synchronously (i.e., it is stored in the record buffer and not
+        //:   published).
+        //:
+        //: 4 Messages logged with the same arguments render identically in
+        //:   both modes.
+        //:
+        //: 5 'numPublishedMessages' counts the deferred messages published.
+        //
+        // Plan:
+        //: 1 Log a message without a running 'BinaryLog', and verify that it
+        //:   is published immediately.  (C-1)
+        //:
+        //: 2 Start a 'BinaryLog', log the same message from another thread,
+        //:   stop the 'BinaryLog', and verify the published record.  (C-2, 4,
+        //:   5)
+        //:
+        //: 3 Log a message enabled only by the record threshold and verify
+        //:   that it is not published.  (C-3)
+        //
+        // Testing:
+        //   static void log(category, severity, fileName, lineNumber, ...);
+        //   bsls::Types::Uint64 numPublishedMessages() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING 'log'" << endl
+                                  << "=============" << endl;
+
+        bslma::TestAllocator ga("global", veryVerbose);
+
+        ball::LoggerManagerConfiguration configuration;
+        configuration.setDefaultThresholdLevelsIfValid(ball::Severity::e_TRACE,
+                                                       ball::Severity::e_INFO,
+                                                       ball::Severity::e_OFF,
+                                                       ball::Severity::e_OFF);
+
+        ball::LoggerManagerScopedGuard guard(configuration, &ga);
+
+        bsl::shared_ptr<RecordingObserver> observer =
+                                      bsl::make_shared<RecordingObserver>();
+        ball::LoggerManager::singleton().registerObserver(observer, "test");
+
+        const ball::Category *CATEGORY =
+                          ball::LoggerManager::singleton().setCategory("LOG");
+        ASSERT(CATEGORY);
+
+        const char *FILE = "file.cpp";
+
+        if (verbose) cout << "\tSynchronous logging." << endl;
+
+        logSampleMessage(CATEGORY, FILE, 10);
+
+        ASSERTV(observer->numRecords(), 1 == observer->numRecords());
+        ASSERT(bsl::string("abc    12|2.500   |z") ==
+                                 observer->record(0).fixedFields().message());
+        ASSERT(bslmt::ThreadUtil::selfIdAsUint64() ==
+                                 observer->record(0).fixedFields().threadID());
+
+        if (verbose) cout << "\tDeferred logging." << endl;
+
+        Obj mX;  const Obj& X = mX;
+        ASSERT(0 == mX.start());
+
+        const bdlt::Datetime BEFORE = bdlt::CurrentTime::utc();
+
+        bsls::Types::Uint64 loggingThreadId = 0;
+        {
+            bslmt::ThreadGroup threadGroup;
+            threadGroup.addThread(bdlf::BindUtil::bind(&logSampleMessage,
+                                                       CATEGORY,
+                                                       FILE,
+                                                       20));
+            threadGroup.joinAll();
+        }
+
+        const bdlt::Datetime AFTER = bdlt::CurrentTime::utc();
+
+        if (verbose) cout << "\tRecord-only severity." << endl;
+
+        Obj::log(CATEGORY, ball::Severity::e_DEBUG, FILE, 30, "%s", "record");
+
+        mX.stop();
+
+        ASSERTV(observer->numRecords(), 2 == observer->numRecords());
+        ASSERTV(X.numPublishedMessages(), 1 == X.numPublishedMessages());
+        ASSERT(0 == X.numDroppedMessages());
+
+        if (2 <= observer->numRecords()) {
+            const ball::RecordAttributes& attributes =
+                                             observer->record(1).fixedFields();
+
+            loggingThreadId = attributes.threadID();
+
+            ASSERT(bsl::string("abc    12|2.500   |z") ==
+                                                        attributes.message());
+            ASSERT(bsl::string("LOG") == attributes.category());
+            ASSERT(ball::Severity::e_WARN == attributes.severity());
+            ASSERT(bsl::string(FILE) == attributes.fileName());
+            ASSERT(20 == attributes.lineNumber());
+            ASSERT(BEFORE <= attributes.timestamp());
+            ASSERT(AFTER  >= attributes.timestamp());
+            ASSERT(bslmt::ThreadUtil::selfIdAsUint64() != loggingThreadId);
+            ASSERT(0 != loggingThreadId);
+        }
+
+        if (verbose) cout << "\tNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_FAIL(Obj::log(CATEGORY, 0, FILE, 1, "x"));
+            ASSERT_FAIL(Obj::log(CATEGORY, 256, FILE, 1, "x"));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS, 'start', AND 'stop'
+        //
+        // Concerns:
+        //: 1 A newly created 'BinaryLog' is not running and has the specified
+        //:   (or default) buffer capacity.
+        //:
+        //: 2 'start' fails if the logger manager singleton has not been
+        //:   initialized, or if a 'BinaryLog' is already running.
+        //:
+        //: 3 'stop' has no effect on a 'BinaryLog' that is not running, and a
+        //:   stopped 'BinaryLog' can be restarted.
+        //:
+        //: 4 The destructor stops a running 'BinaryLog', after which another
+        //:   one can be started.
+        //:
+        //: 5 No memory is leaked, and memory is obtained from the specified
+        //:   allocator.
+        //:
+        //: 6 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create 'BinaryLog' objects, and start and stop them in various
+        //:   sequences, checking the return values and 'isRunning'.  (C-1..4)
+        //:
+        //: 2 Use a test allocator to verify memory use.  (C-5)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid buffer capacities.  (C-6)
+        //
+        // Testing:
+        //   explicit BinaryLog(bslma::Allocator *basicAllocator = 0);
+        //   explicit BinaryLog(int bufferCapacity, bslma::Allocator *ba = 0);
+        //   ~BinaryLog();
+        //   int start();
+        //   void stop();
+        //   int bufferCapacity() const;
+        //   bool isRunning() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "CREATORS, 'start', AND 'stop'" << endl
+                                  << "=============================" << endl;
+
+        bslma::TestAllocator ga("global", veryVerbose);
+        bslma::TestAllocator oa("object", veryVerbose);
+
+        {
+            Obj mX(&oa);  const Obj& X = mX;
+
+            ASSERT(Obj::k_DEFAULT_BUFFER_CAPACITY == X.bufferCapacity());
+            ASSERT(!X.isRunning());
+
+            // The logger manager singleton has not been initialized.
+
+            ASSERT(0 != mX.start());
+            ASSERT(!X.isRunning());
+
+            mX.stop();
+            ASSERT(!X.isRunning());
+        }
+
+        ball::LoggerManagerConfiguration configuration;
+        ball::LoggerManagerScopedGuard   guard(configuration, &ga);
+
+        {
+            Obj mX(32, &oa);  const Obj& X = mX;
+            Obj mY(&oa);      const Obj& Y = mY;
+
+            ASSERT(32 == X.bufferCapacity());
+
+            ASSERT(0 == mX.start());
+            ASSERT( X.isRunning());
+            ASSERT(0 != mX.start());
+            ASSERT( X.isRunning());
+
+            ASSERT(0 != mY.start());
+            ASSERT(!Y.isRunning());
+
+            mY.stop();
+            ASSERT( X.isRunning());
+
+            mX.stop();
+            ASSERT(!X.isRunning());
+
+            ASSERT(0 == mY.start());
+            ASSERT( Y.isRunning());
+            mY.stop();
+
+            ASSERT(0 == mX.start());
+            ASSERT( X.isRunning());
+        }
+
+        {
+            Obj mX(&oa);  const Obj& X = mX;
+            ASSERT(0 == mX.start());
+            ASSERT(X.isRunning());
+        }
+        ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+
+        if (verbose) cout << "\tNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_PASS(Obj(1, &oa));
+            ASSERT_FAIL(Obj(0, &oa));
+            ASSERT_FAIL(Obj(-1, &oa));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //
+        // Concerns:
+        //: 1 The class and macros are sufficiently functional to enable
+        //:   comprehensive testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Log messages with and without a running 'BinaryLog', and verify
+        //:   that they are published.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "BREATHING TEST" << endl
+                                  << "==============" << endl;
+
+        bslma::TestAllocator ga("global", veryVerbose);
+
+        ball::LoggerManagerConfiguration configuration;
+        ball::LoggerManagerScopedGuard   guard(configuration, &ga);
+
+        bsl::shared_ptr<ball::TestObserver> observer =
+                                     bsl::make_shared<ball::TestObserver>(
+                                                                   &bsl::cout);
+        ball::LoggerManager::singleton().registerObserver(observer, "test");
+
+        BALL_LOG_SET_CATEGORY("BREATHING");
+
+        BALL_LOGBIN_ERROR("synchronous %d", 1);
+        ASSERT(1 == observer->numPublishedRecords());
+        ASSERT(bsl::string("synchronous 1") ==
+                      observer->lastPublishedRecord().fixedFields().message());
+
+        Obj mX;
+        ASSERT(0 == mX.start());
+
+        BALL_LOGBIN_ERROR("deferred %d", 2);
+
+        mX.stop();
+
+        ASSERT(2 == observer->numPublishedRecords());
+        ASSERT(bsl::string("deferred 2") ==
+                      observer->lastPublishedRecord().fixedFields().message());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: LATENCY OF THE LOGGING THREAD
+        //
+        // Concerns:
+        //: 1 Logging a deferred message costs the logging thread less than
+        //:   logging the same message with 'BALL_LOGVA_INFO'.
+        //
+        // Plan:
+        //: 1 Log the same message repeatedly with 'BALL_LOGVA_INFO' and with
+        //:   'BALL_LOGBIN_INFO', to an observer that discards the records, and
+        //:   report the average time per call in the logging thread.
+        //
+        // Testing:
+        //   PERFORMANCE: LATENCY OF THE LOGGING THREAD
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: LATENCY OF THE LOGGING THREAD"
+                          << endl
+                          << "=========================================="
+                          << endl;
+
+        using namespace BALL_BINARYLOG_TEST_PERFORMANCE;
+
+        enum { k_NUM_MESSAGES = 50000 };
+
+        ball::LoggerManagerConfiguration configuration;
+        configuration.setDefaultThresholdLevelsIfValid(ball::Severity::e_INFO);
+
+        ball::LoggerManagerScopedGuard guard(configuration);
+
+        bsl::shared_ptr<NullObserver> observer =
+                                           bsl::make_shared<NullObserver>();
+        ball::LoggerManager::singleton().registerObserver(observer, "null");
+
+        BALL_LOG_SET_CATEGORY("PERFORMANCE");
+
+        bsls::Types::Int64 start = bsls::TimeUtil::getTimer();
+        for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+            BALL_LOGVA_INFO("order %d executed at %.4f (%s)", i, 99.5, "IBM");
+        }
+        const bsls::Types::Int64 synchronous =
+                                         bsls::TimeUtil::getTimer() - start;
+
+        Obj mX(k_NUM_MESSAGES);
+        ASSERT(0 == mX.start());
+
+        start = bsls::TimeUtil::getTimer();
+        for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+            BALL_LOGBIN_INFO("order %d executed at %.4f (%s)", i, 99.5, "IBM");
+        }
+        const bsls::Types::Int64 deferred = bsls::TimeUtil::getTimer() - start;
+
+        mX.stop();
+
+        ASSERT(2 * k_NUM_MESSAGES == observer->numRecords() +
+                     static_cast<bsls::Types::Int64>(mX.numDroppedMessages()));
+
+        cout << "BALL_LOGVA_INFO:  " << synchronous / k_NUM_MESSAGES
+             << " ns/message" << endl
+             << "BALL_LOGBIN_INFO: " << deferred / k_NUM_MESSAGES
+             << " ns/message (" << mX.numDroppedMessages() << " dropped)"
+             << endl;
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,701 @@
+// ball_binarymessage.cpp                                             -*-C++-*-
+
+///Implementation Notes
+///--------------------
+// The arguments of a message are stored back-to-back, without type tags and
+// without alignment padding (values are copied with 'memcpy'), in the order
+// in which the format string consumes them.  Since the same format string is
+// scanned (by 'parseSpecification') when the message is encoded and when it
+// is rendered, the type and size of each stored value are implied by the
+// conversion specification that consumes it.  A string argument is stored as
+// an 'int' length followed by that many characters (without a null
+// terminator); the length is negated if the string was truncated.
+//
+// Each conversion specification is rendered by rebuilding it with a length
+// modifier matching the stored (widened) type, replacing any '*' width or
+// precision with the stored value, and passing the result to 'snprintf'.
+
+#include <ball_binarymessage.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ball_binarymessage_cpp,"$Id$ $CSID$")
+
+#include <bsls_assert.h>
+#include <bsls_platform.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_cstring.h>
+#include <bsl_ostream.h>
+#include <bsl_string.h>
+
+#include <stdio.h>  // *NOT* <bsl_cstdio.h>, which does not declare 'snprintf'
+
+#if defined(BSLS_PLATFORM_CMP_MSVC)
+#define snprintf _snprintf
+#endif
+
+namespace BloombergLP {
+namespace ball {
+
+namespace {
+
+enum {
+    k_MAX_SPECIFICATION_LENGTH = 32  // longest conversion specification, not
+                                     // including '%', that is supported
+};
+
+enum LengthModifier {
+    // Enumerate the length modifiers of a conversion specification.
+
+    e_NONE,
+    e_HH,
+    e_H,
+    e_L,
+    e_LL,
+    e_J,
+    e_Z,
+    e_T,
+    e_BIG_L
+};
+
+enum ArgumentType {
+    // Enumerate the ways in which the argument consumed by a conversion
+    // specification is stored.
+
+    e_SIGNED,         // stored as 'bsls::Types::Int64'
+    e_UNSIGNED,       // stored as 'bsls::Types::Uint64'
+    e_CHARACTER,      // stored as 'bsls::Types::Int64'
+    e_DOUBLE,         // stored as 'double'
+    e_LONG_DOUBLE,    // stored as 'long double'
+    e_STRING,         // stored as 'int' length followed by characters
+    e_POINTER,        // stored as 'bsls::Types::Uint64'
+    e_WIDE,           // not stored
+    e_COUNT           // not stored
+};
+
+struct Specification {
+    // This 'struct' describes a parsed conversion specification.
+
+    const char     *d_flags_p;          // first flag character
+    int             d_numFlags;         // number of flag characters
+    bool            d_widthIsStar;      // 'true' if width is '*'
+    const char     *d_width_p;          // first width digit
+    int             d_numWidthDigits;   // number of width digits
+    bool            d_hasPrecision;     // 'true' if '.' is present
+    bool            d_precisionIsStar;  // 'true' if precision is '*'
+    const char     *d_precision_p;      // first precision digit
+    int             d_numPrecisionDigits;
+                                        // number of precision digits
+    LengthModifier  d_modifier;         // length modifier
+    ArgumentType    d_type;             // how the argument is stored
+    char            d_conversion;       // conversion character
+    const char     *d_end_p;            // one past the conversion character
+};
+
+const char *parseDigits(const char *input)
+    // Return the address of the first character of the specified 'input'
+    // that is not a decimal digit.
+{
+    while ('0' <= *input && *input <= '9') {
+        ++input;
+    }
+    return input;
+}
+
+bool parseSpecification(Specification *result, const char *input)
+    // Load into the specified 'result' the description of the conversion
+    // specification that starts at the specified 'input' (the character
+    // following a '%').  Return 'true' on success, and 'false' if the
+    // specification is not supported.
+{
+    const char *p = input;
+
+    result->d_flags_p = p;
+    while (*p && bsl::strchr("-+ #0'", *p)) {
+        ++p;
+    }
+    result->d_numFlags = static_cast<int>(p - result->d_flags_p);
+
+    result->d_widthIsStar = '*' == *p;
+    result->d_width_p     = p;
+    p = result->d_widthIsStar ? p + 1 : parseDigits(p);
+    result->d_numWidthDigits = result->d_widthIsStar
+                             ? 0
+                             : static_cast<int>(p - result->d_width_p);
+
+    result->d_hasPrecision       = '.' == *p;
+    result->d_precisionIsStar    = false;
+    result->d_numPrecisionDigits = 0;
+    if (result->d_hasPrecision) {
+        ++p;
+        result->d_precisionIsStar = '*' == *p;
+        result->d_precision_p     = p;
+        p = result->d_precisionIsStar ? p + 1 : parseDigits(p);
+        const int numDigits = static_cast<int>(p - result->d_precision_p);
+        result->d_numPrecisionDigits = result->d_precisionIsStar ? 0
+                                                                 : numDigits;
+    }
+
+    switch (*p) {
+      case 'h': {
+        result->d_modifier = 'h' == p[1] ? e_HH : e_H;
+        p += e_HH == result->d_modifier ? 2 : 1;
+      } break;
+      case 'l': {
+        result->d_modifier = 'l' == p[1] ? e_LL : e_L;
+        p += e_LL == result->d_modifier ? 2 : 1;
+      } break;
+      case 'q': {
+        result->d_modifier = e_LL;
+        ++p;
+      } break;
+      case 'j': {
+        result->d_modifier = e_J;
+        ++p;
+      } break;
+      case 'z': {
+        result->d_modifier = e_Z;
+        ++p;
+      } break;
+      case 't': {
+        result->d_modifier = e_T;
+        ++p;
+      } break;
+      case 'L': {
+        result->d_modifier = e_BIG_L;
+        ++p;
+      } break;
+      default: {
+        result->d_modifier = e_NONE;
+      } break;
+    }
+
+    result->d_conversion = *p;
+    switch (*p) {
+      case 'd':
+      case 'i': {
+        result->d_type = e_SIGNED;
+      } break;
+      case 'o':
+      case 'u':
+      case 'x':
+      case 'X': {
+        result->d_type = e_UNSIGNED;
+      } break;
+      case 'c': {
+        result->d_type = e_L == result->d_modifier ? e_WIDE : e_CHARACTER;
+      } break;
+      case 'e':
+      case 'E':
+      case 'f':
+      case 'F':
+      case 'g':
+      case 'G':
+      case 'a':
+      case 'A': {
+        result->d_type = e_BIG_L == result->d_modifier ? e_LONG_DOUBLE
+                                                       : e_DOUBLE;
+      } break;
+      case 's': {
+        result->d_type = e_L == result->d_modifier ? e_WIDE : e_STRING;
+      } break;
+      case 'p': {
+        result->d_type = e_POINTER;
+      } break;
+      case 'n': {
+        result->d_type = e_COUNT;
+      } break;
+      default: {
+        return false;                                                 // RETURN
+      }
+    }
+    result->d_end_p = p + 1;
+
+    return result->d_end_p - input <= k_MAX_SPECIFICATION_LENGTH;
+}
+
+void appendInt(char **cursor, int value)
+    // Write the decimal representation of the specified 'value' at the
+    // specified '*cursor' and advance '*cursor' past it.
+{
+    *cursor += snprintf(*cursor, 16, "%d", value);
+}
+
+void appendText(char **cursor, const char *text, int length)
+    // Copy the specified 'length' characters of the specified 'text' to the
+    // specified '*cursor' and advance '*cursor' past them.
+{
+    bsl::memcpy(*cursor, text, length);
+    *cursor += length;
+}
+
+void buildFormat(char                 *result,
+                 const Specification&  spec,
+                 int                   width,
+                 int                   precision,
+                 const char           *modifier)
+    // Load into the specified 'result' a null-terminated conversion
+    // specification equivalent to the specified 'spec', having the specified
+    // 'modifier' as its length modifier, and using the specified 'width' and
+    // 'precision' in place of a '*' width and precision, respectively.  If
+    // 'precision' is -2, '.*' is used as the precision.  The behavior is
+    // undefined unless 'result' has room for 'k_MAX_SPECIFICATION_LENGTH + 32'
+    // characters.
+{
+    char *cursor = result;
+
+    *cursor++ = '%';
+    appendText(&cursor, spec.d_flags_p, spec.d_numFlags);
+    if (spec.d_widthIsStar) {
+        appendInt(&cursor, width);
+    }
+    else {
+        appendText(&cursor, spec.d_width_p, spec.d_numWidthDigits);
+    }
+    if (-2 == precision) {
+        appendText(&cursor, ".*", 2);
+    }
+    else if (spec.d_precisionIsStar) {
+        if (0 <= precision) {
+            *cursor++ = '.';
+            appendInt(&cursor, precision);
+        }
+    }
+    else if (spec.d_hasPrecision) {
+        *cursor++ = '.';
+        appendText(&cursor, spec.d_precision_p, spec.d_numPrecisionDigits);
+    }
+    appendText(&cursor, modifier, static_cast<int>(bsl::strlen(modifier)));
+    *cursor++ = spec.d_conversion;
+    *cursor   = '\0';
+}
+
+template <class VALUE>
+int formatToBuffer(char         *buffer,
+                   bsl::size_t   size,
+                   const char   *format,
+                   int           numChars,
+                   const char   *chars,
+                   const VALUE&  value,
+                   bool          isChars)
+    // Write to the specified 'buffer' of the specified 'size' the result of
+    // formatting, according to the specified 'format', either the specified
+    // 'numChars' characters at 'chars' (if the specified 'isChars' is 'true')
+    // or the specified 'value'.  Return the value returned by 'snprintf'.
+{
+    return isChars ? snprintf(buffer, size, format, numChars, chars)
+                   : snprintf(buffer, size, format, value);
+}
+
+template <class VALUE>
+void renderValue(bsl::ostream&  stream,
+                 const char    *format,
+                 int            numChars,
+                 const char    *chars,
+                 const VALUE&   value,
+                 bool           isChars)
+    // Write to the specified 'stream' the result of formatting, according to
+    // the specified 'format', either the specified 'numChars' characters at
+    // 'chars' (if the specified 'isChars' is 'true') or the specified
+    // 'value'.
+{
+    char buffer[128];
+
+    int rc = formatToBuffer(buffer,
+                            sizeof buffer,
+                            format,
+                            numChars,
+                            chars,
+                            value,
+                            isChars);
+
+    if (0 <= rc && rc < static_cast<int>(sizeof buffer)) {
+        stream.write(buffer, rc);
+        return;                                                       // RETURN
+    }
+
+    // The text does not fit in 'buffer'.  Note that, on some platforms, the
+    // required size is not reported on overflow.
+
+    bsl::string overflow;
+    bsl::size_t size = 0 <= rc ? rc + 1 : 2 * sizeof buffer;
+    while (true) {
+        overflow.resize(size);
+        rc = formatToBuffer(&overflow[0],
+                            size,
+                            format,
+                            numChars,
+                            chars,
+                            value,
+                            isChars);
+        if (0 <= rc && rc < static_cast<int>(size)) {
+            stream.write(overflow.data(), rc);
+            return;                                                   // RETURN
+        }
+        size = 0 <= rc ? rc + 1 : 2 * size;
+    }
+}
+
+}  // close unnamed namespace
+
+                        // -------------------
+                        // class BinaryMessage
+                        // -------------------
+
+// PUBLIC CONSTANTS
+const char BinaryMessage::k_TRUNCATION_MARKER[] = "...[TRUNCATED]";
+
+// CREATORS
+BinaryMessage::BinaryMessage(const BinaryMessage& original)
+: d_format_p(original.d_format_p)
+, d_length(original.d_length)
+, d_isTruncated(original.d_isTruncated)
+{
+    bsl::memcpy(d_buffer, original.d_buffer, d_length);
+}
+
+// MANIPULATORS
+BinaryMessage& BinaryMessage::operator=(const BinaryMessage& rhs)
+{
+    if (this != &rhs) {
+        d_format_p    = rhs.d_format_p;
+        d_length      = rhs.d_length;
+        d_isTruncated = rhs.d_isTruncated;
+        bsl::memcpy(d_buffer, rhs.d_buffer, d_length);
+    }
+    return *this;
+}
+
+void BinaryMessage::encode(const char *format, ...)
+{
+    BSLS_ASSERT(format);
+
+    bsl::va_list arguments;
+    va_start(arguments, format);
+    encodeList(format, arguments);
+    va_end(arguments);
+}
+
+void BinaryMessage::encodeList(const char *format, bsl::va_list arguments)
+{
+    BSLS_ASSERT(format);
+
+    d_format_p    = format;
+    d_length      = 0;
+    d_isTruncated = false;
+
+#define BALL_BINARYMESSAGE_STORE(VALUE) {                                     \
+        if (k_CAPACITY - d_length < static_cast<int>(sizeof(VALUE))) {        \
+            d_isTruncated = true;                                             \
+            return;                                                           \
+        }                                                                     \
+        bsl::memcpy(d_buffer + d_length, &(VALUE), sizeof(VALUE));            \
+        d_length += static_cast<int>(sizeof(VALUE));                          \
+    }
+
+    const char    *p = format;
+    Specification  spec;
+
+    while (0 != (p = bsl::strchr(p, '%'))) {
+        ++p;
+        if ('%' == *p) {
+            ++p;
+            continue;
+        }
+        if (!parseSpecification(&spec, p)) {
+            return;                                                   // RETURN
+        }
+        p = spec.d_end_p;
+
+        int precision = -1;
+        if (spec.d_widthIsStar) {
+            const int width = va_arg(arguments, int);
+            BALL_BINARYMESSAGE_STORE(width);
+        }
+        if (spec.d_precisionIsStar) {
+            precision = va_arg(arguments, int);
+            BALL_BINARYMESSAGE_STORE(precision);
+        }
+        else if (spec.d_hasPrecision) {
+            precision = 0;
+            for (int i = 0; i < spec.d_numPrecisionDigits; ++i) {
+                precision = precision * 10 + (spec.d_precision_p[i] - '0');
+            }
+        }
+
+        switch (spec.d_type) {
+          case e_SIGNED:
+          case e_CHARACTER: {
+            bsls::Types::Int64 value;
+            switch (spec.d_modifier) {
+              case e_HH: {
+                value = static_cast<signed char>(va_arg(arguments, int));
+              } break;
+              case e_H: {
+                value = static_cast<short>(va_arg(arguments, int));
+              } break;
+              case e_L: {
+                value = va_arg(arguments, long);
+              } break;
+              case e_LL:
+              case e_BIG_L: {
+                value = va_arg(arguments, long long);
+              } break;
+              case e_J: {
+                value = va_arg(arguments, bsls::Types::Int64);
+              } break;
+              case e_Z: {
+                value = static_cast<bsls::Types::IntPtr>(
+                                              va_arg(arguments, bsl::size_t));
+              } break;
+              case e_T: {
+                value = va_arg(arguments, bsl::ptrdiff_t);
+              } break;
+              default: {
+                value = va_arg(arguments, int);
+              } break;
+            }
+            BALL_BINARYMESSAGE_STORE(value);
+          } break;
+          case e_UNSIGNED: {
+            bsls::Types::Uint64 value;
+            switch (spec.d_modifier) {
+              case e_HH: {
+                value = static_cast<unsigned char>(
+                                              va_arg(arguments, unsigned int));
+              } break;
+              case e_H: {
+                value = static_cast<unsigned short>(
+                                              va_arg(arguments, unsigned int));
+              } break;
+              case e_L: {
+                value = va_arg(arguments, unsigned long);
+              } break;
+              case e_LL:
+              case e_BIG_L: {
+                value = va_arg(arguments, unsigned long long);
+              } break;
+              case e_J: {
+                value = va_arg(arguments, bsls::Types::Uint64);
+              } break;
+              case e_Z: {
+                value = va_arg(arguments, bsl::size_t);
+              } break;
+              case e_T: {
+                value = static_cast<bsls::Types::UintPtr>(
+                                            va_arg(arguments, bsl::ptrdiff_t));
+              } break;
+              default: {
+                value = va_arg(arguments, unsigned int);
+              } break;
+            }
+            BALL_BINARYMESSAGE_STORE(value);
+          } break;
+          case e_DOUBLE: {
+            const double value = va_arg(arguments, double);
+            BALL_BINARYMESSAGE_STORE(value);
+          } break;
+          case e_LONG_DOUBLE: {
+            const long double value = va_arg(arguments, long double);
+            BALL_BINARYMESSAGE_STORE(value);
+          } break;
+          case e_STRING: {
+            const char *value = va_arg(arguments, const char *);
+            if (!value) {
+                value = "(null)";
+            }
+
+            // Do not read beyond 'precision' characters, as the argument
+            // need not be null-terminated in that case.
+
+            int length = 0;
+            while ((precision < 0 || length < precision) && value[length]) {
+                ++length;
+            }
+
+            const int available = k_CAPACITY - d_length
+                                              - static_cast<int>(sizeof(int));
+            if (available < length) {
+                if (available < 0) {
+                    d_isTruncated = true;
+                    return;                                           // RETURN
+                }
+                length        = available;
+                d_isTruncated = true;
+            }
+            // A string that was cut short is stored with a negative length.
+
+            const int storedLength = d_isTruncated ? -length : length;
+            BALL_BINARYMESSAGE_STORE(storedLength);
+            bsl::memcpy(d_buffer + d_length, value, length);
+            d_length += length;
+            if (d_isTruncated) {
+                return;                                               // RETURN
+            }
+          } break;
+          case e_POINTER: {
+            const void                *pointer = va_arg(arguments,
+                                                         const void *);
+            const bsls::Types::Uint64  value   =
+                               reinterpret_cast<bsls::Types::UintPtr>(pointer);
+            BALL_BINARYMESSAGE_STORE(value);
+          } break;
+          case e_WIDE: {
+            if ('c' == spec.d_conversion) {
+                (void)va_arg(arguments, int);
+            }
+            else {
+                (void)va_arg(arguments, const void *);
+            }
+          } break;
+          case e_COUNT: {
+            (void)va_arg(arguments, int *);
+          } break;
+        }
+    }
+
+#undef BALL_BINARYMESSAGE_STORE
+}
+
+// ACCESSORS
+bsl::ostream& BinaryMessage::render(bsl::ostream& stream) const
+{
+    int offset = 0;
+
+#define BALL_BINARYMESSAGE_LOAD(VALUE) {                                      \
+        if (d_length - offset < static_cast<int>(sizeof(VALUE))) {            \
+            stream << k_TRUNCATION_MARKER;                                    \
+            return stream;                                                    \
+        }                                                                     \
+        bsl::memcpy(&(VALUE), d_buffer + offset, sizeof(VALUE));              \
+        offset += static_cast<int>(sizeof(VALUE));                            \
+    }
+
+    const char    *p = d_format_p;
+    const char    *percent;
+    Specification  spec;
+    char           format[k_MAX_SPECIFICATION_LENGTH + 32];
+
+    while (0 != (percent = bsl::strchr(p, '%'))) {
+        stream.write(p, percent - p);
+        p = percent + 1;
+
+        if ('%' == *p) {
+            stream.put('%');
+            ++p;
+            continue;
+        }
+        if (!parseSpecification(&spec, p)) {
+            p = percent;
+            break;
+        }
+        p = spec.d_end_p;
+
+        int width     = 0;
+        int precision = -1;
+        if (spec.d_widthIsStar) {
+            BALL_BINARYMESSAGE_LOAD(width);
+        }
+        if (spec.d_precisionIsStar) {
+            BALL_BINARYMESSAGE_LOAD(precision);
+        }
+
+        switch (spec.d_type) {
+          case e_SIGNED: {
+            long long value;
+            BALL_BINARYMESSAGE_LOAD(value);
+            buildFormat(format, spec, width, precision, "ll");
+            renderValue(stream, format, 0, 0, value, false);
+          } break;
+          case e_UNSIGNED: {
+            unsigned long long value;
+            BALL_BINARYMESSAGE_LOAD(value);
+            buildFormat(format, spec, width, precision, "ll");
+            renderValue(stream, format, 0, 0, value, false);
+          } break;
+          case e_CHARACTER: {
+            bsls::Types::Int64 value;
+            BALL_BINARYMESSAGE_LOAD(value);
+            buildFormat(format, spec, width, precision, "");
+            renderValue(stream,
+                        format,
+                        0,
+                        0,
+                        static_cast<int>(value),
+                        false);
+          } break;
+          case e_DOUBLE: {
+            double value;
+            BALL_BINARYMESSAGE_LOAD(value);
+            buildFormat(format, spec, width, precision, "");
+            renderValue(stream, format, 0, 0, value, false);
+          } break;
+          case e_LONG_DOUBLE: {
+            long double value;
+            BALL_BINARYMESSAGE_LOAD(value);
+            buildFormat(format, spec, width, precision, "L");
+            renderValue(stream, format, 0, 0, value, false);
+          } break;
+          case e_STRING: {
+            int length;
+            BALL_BINARYMESSAGE_LOAD(length);
+            const bool isCut = length < 0;
+            if (isCut) {
+                length = -length;
+            }
+            buildFormat(format, spec, width, -2, "");
+            renderValue(stream, format, length, d_buffer + offset, 0, true);
+            offset += length;
+            if (isCut) {
+                stream << k_TRUNCATION_MARKER;
+                return stream;                                        // RETURN
+            }
+          } break;
+          case e_POINTER: {
+            bsls::Types::Uint64 value;
+            BALL_BINARYMESSAGE_LOAD(value);
+            buildFormat(format, spec, width, precision, "");
+            renderValue(stream,
+                        format,
+                        0,
+                        0,
+                        reinterpret_cast<const void *>(
+                                  static_cast<bsls::Types::UintPtr>(value)),
+                        false);
+          } break;
+          case e_WIDE: {
+            stream.put('?');
+          } break;
+          case e_COUNT: {
+          } break;
+        }
+    }
+
+#undef BALL_BINARYMESSAGE_LOAD
+
+    stream << p;
+    return stream;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#if defined(BSLS_PLATFORM_CMP_MSVC)
+#undef snprintf
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
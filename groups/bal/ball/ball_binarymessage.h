@@ -0,0 +1,257 @@
+// ball_binarymessage.h                                               -*-C++-*-
+#ifndef INCLUDED_BALL_BINARYMESSAGE
+#define INCLUDED_BALL_BINARYMESSAGE
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a compact, deferred-formatting encoding of a log message.
+//
+//@CLASSES:
+//  ball::BinaryMessage: 'printf'-style format with its unrendered arguments
+//
+//@SEE_ALSO: ball_binarylog, ball_log
+//
+//@DESCRIPTION: This component provides a value-semantic-like class,
+// 'ball::BinaryMessage', that captures a 'printf'-style format string and the
+// raw values of the arguments that accompany it, *without* rendering them as
+// text.  The format string is stored by address, and the arguments are copied
+// into a fixed-size buffer held within the object itself, so encoding a
+// message neither allocates memory nor performs any numeric-to-text
+// conversion.  The textual form of the message is produced later, possibly in
+// another thread, by the 'render' method, which yields the same text that
+// 'snprintf' would have produced from the original arguments.
+//
+// 'ball::BinaryMessage' is the unit of data exchanged between the threads that
+// log through 'ball_binarylog' and the thread that publishes their records.
+//
+///Format Strings
+///--------------
+// The format string supplied to 'encode' must remain valid (and unmodified)
+// until the last call to 'render' on the encoded message; in practice it must
+// be a string literal, as is the case for the 'BALL_LOGBIN_*' macros provided
+// by 'ball_binarylog'.
+//
+// The format string is scanned when the message is encoded, and each
+// conversion specification determines the type of the argument that is
+// retrieved from the variable argument list and how it is stored:
+//..
+//  Conversion               Argument Type            Stored As
+//  ----------------------   ----------------------   ---------------------
+//  d i                      signed integer (1)       64-bit signed integer
+//  o u x X                  unsigned integer (1)     64-bit unsigned integer
+//  c                        'int'                    64-bit signed integer
+//  e E f F g G a A          'double'                 'double'
+//  Le LE Lf LF Lg LG La LA  'long double'            'long double'
+//  s                        'const char *'           copy of the characters
+//  p                        'const void *'           64-bit unsigned integer
+//  n                        'int *' (ignored)        nothing
+//  * (width or precision)   'int'                    'int'
+//
+//  (1) Any of the length modifiers 'hh', 'h', 'l', 'll', 'j', 'z', and 't' may
+//      be used; the argument is converted, as 'printf' would, to the type
+//      implied by the modifier before being widened.
+//..
+// Wide-character conversions ('%lc' and '%ls') are not supported; the
+// argument is consumed and '?' is rendered in its place.  A conversion
+// specification that is not recognized ends the scan, and the remainder of
+// the format string is rendered verbatim.
+//
+///Truncation
+///----------
+// The arguments of a message are stored in a buffer of 'k_CAPACITY' bytes.  A
+// string argument that does not fit in the space remaining in the buffer is
+// truncated, and no further arguments are stored once the buffer is full.
+// When such a message is rendered, the text up to the first argument that
+// could not be (completely) stored is produced, followed by the
+// 'k_TRUNCATION_MARKER' string; 'isTruncated' reports whether this occurred.
+//
+///Thread Safety
+///-------------
+// 'ball::BinaryMessage' is *const* *thread-safe*, meaning that accessors may
+// be invoked concurrently from different threads, but it is not safe to
+// access or modify a 'ball::BinaryMessage' in one thread while another thread
+// modifies the same object.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Encoding and Rendering a Message
+///- - - - - - - - - - - - - - - - - - - - - -
+// First, we encode a message together with its arguments.  Neither the
+// integer nor the floating-point value is converted to text at this point:
+//..
+//  ball::BinaryMessage message;
+//  message.encode("order %d filled at %.2f for '%s'", 42, 101.25, "ACME");
+//  assert(!message.isTruncated());
+//..
+// Then, at some later time (and possibly in another thread), we render the
+// message:
+//..
+//  bsl::ostringstream oss;
+//  message.render(oss);
+//  assert("order 42 filled at 101.25 for 'ACME'" == oss.str());
+//..
+
+#include <balscm_version.h>
+
+#include <bsls_annotation.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdarg.h>
+#include <bsl_iosfwd.h>
+
+namespace BloombergLP {
+namespace ball {
+
+                        // ===================
+                        // class BinaryMessage
+                        // ===================
+
+class BinaryMessage {
+    // This class holds the address of a 'printf'-style format string and a
+    // compact binary encoding of the arguments that accompany it, from which
+    // the formatted text can be rendered on demand.  Copying a
+    // 'BinaryMessage' copies only the portion of the argument buffer in use.
+
+  public:
+    // PUBLIC CONSTANTS
+    enum {
+        k_CAPACITY = 256  // size (in bytes) of the argument buffer
+    };
+
+    static const char k_TRUNCATION_MARKER[];
+        // String rendered in place of the arguments that could not be stored.
+
+  private:
+    // DATA
+    const char *d_format_p;           // format string (held, not owned)
+
+    int         d_length;             // number of bytes of 'd_buffer' in use
+
+    bool        d_isTruncated;        // 'true' if arguments were discarded
+
+    char        d_buffer[k_CAPACITY]; // encoded arguments
+
+  public:
+    // CREATORS
+    BinaryMessage();
+        // Create a binary message having an empty format string and no
+        // arguments.
+
+    BinaryMessage(const BinaryMessage& original);
+        // Create a binary message having the same format string and encoded
+        // arguments as the specified 'original' message.
+
+    //! ~BinaryMessage() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    BinaryMessage& operator=(const BinaryMessage& rhs);
+        // Assign to this object the format string and encoded arguments of
+        // the specified 'rhs' message, and return a reference providing
+        // modifiable access to this object.
+
+    void encode(const char *format, ...) BSLS_ANNOTATION_PRINTF(2, 3);
+        // Set the format string of this message to the specified 'format' and
+        // encode the arguments that follow it, as described in {Format
+        // Strings}.  The behavior is undefined unless 'format' remains valid
+        // until this message is rendered, and the arguments are of the types
+        // required by 'format'.
+
+    void encodeList(const char *format, bsl::va_list arguments);
+        // Set the format string of this message to the specified 'format' and
+        // encode the specified 'arguments', as described in {Format Strings}.
+        // The behavior is undefined unless 'format' remains valid until this
+        // message is rendered, and 'arguments' are of the types required by
+        // 'format'.
+
+    void reset();
+        // Reset this object to the default-constructed state.
+
+    // ACCESSORS
+    const char *format() const;
+        // Return the address of the format string of this message.
+
+    bool isTruncated() const;
+        // Return 'true' if one or more arguments of this message could not be
+        // stored (completely) when it was encoded, and 'false' otherwise.
+
+    int length() const;
+        // Return the number of bytes of the argument buffer used by the
+        // encoded arguments of this message.
+
+    bsl::ostream& render(bsl::ostream& stream) const;
+        // Write to the specified 'stream' the text formed by rendering the
+        // encoded arguments of this message according to its format string,
+        // and return a reference to 'stream'.  If 'isTruncated()' is 'true',
+        // the text is rendered up to the first argument that could not be
+        // stored and is followed by 'k_TRUNCATION_MARKER'.
+};
+
+// ============================================================================
+//                              INLINE DEFINITIONS
+// ============================================================================
+
+                        // -------------------
+                        // class BinaryMessage
+                        // -------------------
+
+// CREATORS
+inline
+BinaryMessage::BinaryMessage()
+: d_format_p("")
+, d_length(0)
+, d_isTruncated(false)
+{
+}
+
+// MANIPULATORS
+inline
+void BinaryMessage::reset()
+{
+    d_format_p    = "";
+    d_length      = 0;
+    d_isTruncated = false;
+}
+
+// ACCESSORS
+inline
+const char *BinaryMessage::format() const
+{
+    return d_format_p;
+}
+
+inline
+bool BinaryMessage::isTruncated() const
+{
+    return d_isTruncated;
+}
+
+inline
+int BinaryMessage::length() const
+{
+    return d_length;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
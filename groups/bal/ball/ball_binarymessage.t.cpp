@@ -0,0 +1,608 @@
+// ball_binarymessage.t.cpp                                           -*-C++-*-
+#include <ball_binarymessage.h>
+
+#include <bslim_testutil.h>
+
+#include <bslmf_assert.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_types.h>
+
+#include <bsl_climits.h>
+#include <bsl_cstdarg.h>
+#include <bsl_cstddef.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+
+#include <stdio.h>  // *NOT* <bsl_cstdio.h>, which does not declare 'vsnprintf'
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                             TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is a simple class holding a format string and an
+// encoding of the arguments that accompany it.  The central concern is that
+// rendering an encoded message produces exactly the text that 'vsnprintf'
+// produces from the same format string and arguments; this is verified for
+// each supported conversion, flag, width, precision, and length modifier by
+// encoding and rendering the same arguments that are passed to 'vsnprintf'.
+// The behavior of messages whose arguments do not fit in the buffer is
+// verified separately.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] BinaryMessage();
+// [ 2] BinaryMessage(const BinaryMessage& original);
+//
+// MANIPULATORS
+// [ 2] BinaryMessage& operator=(const BinaryMessage& rhs);
+// [ 3] void encode(const char *format, ...);
+// [ 3] void encodeList(const char *format, bsl::va_list arguments);
+// [ 2] void reset();
+//
+// ACCESSORS
+// [ 2] const char *format() const;
+// [ 4] bool isTruncated() const;
+// [ 2] int length() const;
+// [ 3] bsl::ostream& render(bsl::ostream& stream) const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] USAGE EXAMPLE
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef ball::BinaryMessage Obj;
+
+static bool verbose;
+static bool veryVerbose;
+
+//=============================================================================
+//                  GLOBAL HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static bsl::string renderMessage(const Obj& message)
+    // Return the text obtained by rendering the specified 'message'.
+{
+    bsl::ostringstream oss;
+    message.render(oss);
+    return oss.str();
+}
+
+static void verify(int line, const char *format, ...)
+    // Verify that encoding and rendering the arguments that follow the
+    // specified 'format' produces the same text as 'vsnprintf', and report
+    // failures using the specified 'line'.
+{
+    char expected[1024];
+
+    bsl::va_list arguments;
+
+    va_start(arguments, format);
+    vsnprintf(expected, sizeof expected, format, arguments);
+    va_end(arguments);
+
+    Obj mX;  const Obj& X = mX;
+
+    va_start(arguments, format);
+    mX.encodeList(format, arguments);
+    va_end(arguments);
+
+    const bsl::string actual = renderMessage(X);
+
+    if (veryVerbose) {
+        T_ P_(line) P_(format) P_(expected) P(actual)
+    }
+
+    ASSERTV(line, format, expected, actual, expected == actual);
+    ASSERTV(line, format, X.format() == format);
+    ASSERTV(line, format, !X.isTruncated());
+}
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    verbose     = argc > 2;
+    veryVerbose = argc > 3;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "USAGE EXAMPLE" << endl
+                                  << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Encoding and Rendering a Message
+///- - - - - - - - - - - - - - - - - - - - - -
+// First, we encode a message together with its arguments.  Neither the
+// integer nor the floating-point value is converted to text at this point:
+//..
+    ball::BinaryMessage message;
+    message.encode("order %d filled at %.2f for '%s'", 42, 101.25, "ACME");
+    ASSERT(!message.isTruncated());
+//..
+// Then, at some later time (and possibly in another thread), we render the
+// message:
+//..
+    bsl::ostringstream oss;
+    message.render(oss);
+    ASSERT("order 42 filled at 101.25 for 'ACME'" == oss.str());
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING TRUNCATION
+        //
+        // Concerns:
+        //: 1 Arguments that fit in the buffer are encoded, and those that do
+        //:   not are discarded.
+        //:
+        //: 2 A string argument that does not fit is truncated to the space
+        //:   remaining in the buffer.
+        //:
+        //: 3 'isTruncated' reports whether arguments were discarded, and the
+        //:   truncation marker follows the text rendered from the arguments
+        //:   that were kept.
+        //:
+        //: 4 Copying a truncated message preserves its truncation.
+        //
+        // Plan:
+        //: 1 Encode messages whose arguments exceed the capacity of the buffer
+        //:   and verify the rendered text and 'isTruncated'.  (C-1..4)
+        //
+        // Testing:
+        //   bool isTruncated() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING TRUNCATION" << endl
+                                  << "==================" << endl;
+
+        const bsl::string MARKER(Obj::k_TRUNCATION_MARKER);
+
+        if (verbose) cout << "\tLong string argument." << endl;
+        {
+            const bsl::string LONG(2 * Obj::k_CAPACITY, 'x');
+
+            Obj mX;  const Obj& X = mX;
+            mX.encode("<%d:%s> tail %d", 7, LONG.c_str(), 8);
+
+            ASSERT(X.isTruncated());
+            ASSERT(Obj::k_CAPACITY == X.length());
+
+            const bsl::string result = renderMessage(X);
+            const int         NUM_X  = Obj::k_CAPACITY
+                                     - static_cast<int>(sizeof(int))
+                                     - static_cast<int>(
+                                                  sizeof(bsls::Types::Int64));
+
+            ASSERTV(result,
+                    "<7:" + bsl::string(NUM_X, 'x') + MARKER == result);
+
+            Obj mY(X);  const Obj& Y = mY;
+            ASSERT(Y.isTruncated());
+            ASSERT(result == renderMessage(Y));
+        }
+
+        if (verbose) cout << "\tToo many numeric arguments." << endl;
+        {
+            // Each 'double' occupies 8 bytes; the buffer holds 'k_CAPACITY /
+            // 8' of them.
+
+            bsl::string format;
+            bsl::string expected;
+            const int   NUM_STORED = Obj::k_CAPACITY / 8;
+            for (int i = 0; i < NUM_STORED; ++i) {
+                format   += "%.0f,";
+                expected += "1,";
+            }
+            format += "%.0f,%.0f";
+            expected += MARKER;
+
+            Obj mX;  const Obj& X = mX;
+
+#define ARGS8  1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0
+            BSLMF_ASSERT(256 == Obj::k_CAPACITY);
+            mX.encode(format.c_str(), ARGS8, ARGS8, ARGS8, ARGS8,
+                                      1.0, 1.0);
+#undef ARGS8
+
+            ASSERT(X.isTruncated());
+            ASSERT(Obj::k_CAPACITY == X.length());
+            ASSERTV(renderMessage(X), expected == renderMessage(X));
+        }
+
+        if (verbose) cout << "\tArguments exactly fill the buffer." << endl;
+        {
+            bsl::string format;
+            bsl::string expected;
+            for (int i = 0; i < Obj::k_CAPACITY / 8; ++i) {
+                format   += "%.0f ";
+                expected += "2 ";
+            }
+
+            Obj mX;  const Obj& X = mX;
+
+#define ARGS8  2.0, 2.0, 2.0, 2.0, 2.0, 2.0, 2.0, 2.0
+            mX.encode(format.c_str(), ARGS8, ARGS8, ARGS8, ARGS8);
+#undef ARGS8
+
+            ASSERT(!X.isTruncated());
+            ASSERT(Obj::k_CAPACITY == X.length());
+            ASSERTV(renderMessage(X), expected == renderMessage(X));
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'encode' AND 'render'
+        //
+        // Concerns:
+        //: 1 Each supported conversion, with any combination of flags, width,
+        //:   precision, and length modifier, renders the same text as
+        //:   'vsnprintf'.
+        //:
+        //: 2 '*' widths and precisions, including negative values, are
+        //:   consumed from the argument list and honored.
+        //:
+        //: 3 Arguments narrower than their widened storage (e.g., '%hhd') are
+        //:   converted as 'printf' would convert them.
+        //:
+        //: 4 '%%' and '%n' consume no stored data.
+        //:
+        //: 5 An unsupported conversion ends the scan, and the remainder of the
+        //:   format string is rendered verbatim.
+        //:
+        //: 6 'encode' and 'encodeList' produce equivalent messages.
+        //
+        // Plan:
+        //: 1 For a variety of format strings and arguments, encode and render
+        //:   the arguments, and compare the result with that of 'vsnprintf'
+        //:   applied to the same arguments.  (C-1..4, 6)
+        //:
+        //: 2 Verify that a format with an unsupported conversion is rendered
+        //:   verbatim from the unsupported conversion.  (C-5)
+        //
+        // Testing:
+        //   void encode(const char *format, ...);
+        //   void encodeList(const char *format, bsl::va_list arguments);
+        //   bsl::ostream& render(bsl::ostream& stream) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING 'encode' AND 'render'" << endl
+                                  << "=============================" << endl;
+
+        if (verbose) cout << "\tLiteral text." << endl;
+        {
+            verify(L_, "");
+            verify(L_, "plain text");
+            verify(L_, "100%% sure, %%d");
+        }
+
+        if (verbose) cout << "\tSigned integers." << endl;
+        {
+            verify(L_, "%d %i", 0, -1);
+            verify(L_, "%d|%d", INT_MIN, INT_MAX);
+            verify(L_, "[%5d][%-5d][%05d][%+d][% d]", 42, 42, 42, 42, 42);
+            verify(L_, "[%.3d][%8.3d][%-+8.3d]", 7, -7, 7);
+            verify(L_, "%hhd %hd", 300, 70000);
+            verify(L_, "%ld %lld", -1234567890L, -1234567890123456789LL);
+            verify(L_, "%jd", static_cast<bsls::Types::Int64>(-99));
+            verify(L_, "%zd %td", static_cast<bsl::size_t>(12),
+                                  static_cast<bsl::ptrdiff_t>(-13));
+        }
+
+        if (verbose) cout << "\tUnsigned integers." << endl;
+        {
+            verify(L_, "%u %o %x %X", 4000000000U, 8U, 255U, 255U);
+            verify(L_, "[%#o][%#x][%#10X][%-#10x]", 8U, 255U, 255U, 255U);
+            verify(L_, "%hhu %hx", 300U, 70000U);
+            verify(L_, "%lu %llx", 4000000000UL, 0xFEDCBA9876543210ULL);
+            verify(L_, "%zu", static_cast<bsl::size_t>(123456));
+        }
+
+        if (verbose) cout << "\tCharacters." << endl;
+        {
+            verify(L_, "[%c][%3c][%-3c]", 'a', 'b', 'c');
+        }
+
+        if (verbose) cout << "\tFloating point." << endl;
+        {
+            verify(L_, "%f %e %g %E %G", 3.25, 3.25, 3.25, 1e-10, 1e20);
+            verify(L_, "[%10.3f][%-10.2e][%+.0f][%#.0f]", 3.14159,
+                                                         2.5,
+                                                         2.5,
+                                                         2.0);
+            verify(L_, "%a %A", 1.0, 0.5);
+            verify(L_, "%Lf %Lg", 1.5L, 2.25L);
+        }
+
+        if (verbose) cout << "\tStrings." << endl;
+        {
+            verify(L_, "%s", "");
+            verify(L_, "[%s][%10s][%-10s]", "abc", "def", "ghi");
+            verify(L_, "[%.2s][%8.2s]", "abcdef", "abcdef");
+
+            // Precision limits the characters read from the argument.
+
+            const char UNTERMINATED[] = { 'x', 'y', 'z' };
+            verify(L_, "%.3s", UNTERMINATED);
+        }
+
+        if (verbose) cout << "\tPointers." << endl;
+        {
+            int value;
+            verify(L_, "%p", static_cast<void *>(&value));
+            verify(L_, "[%20p]", static_cast<void *>(&value));
+        }
+
+        if (verbose) cout << "\t'*' widths and precisions." << endl;
+        {
+            verify(L_, "[%*d][%*d][%.*d]", 6, 1, -6, 2, 3, 4);
+            verify(L_, "[%*.*f][%.*f]", 10, 2, 1.5, -1, 1.5);
+            verify(L_, "[%*.*s]", 8, 3, "abcdef");
+        }
+
+        if (verbose) cout << "\tMixed." << endl;
+        {
+            verify(L_, "%s=%d (%5.1f%%) at %p, %c%llu",
+                       "key",
+                       -3,
+                       99.5,
+                       static_cast<void *>(0),
+                       'z',
+                       18446744073709551615ULL);
+        }
+
+        if (verbose) cout << "\t'%n'." << endl;
+        {
+            int count = 0;
+
+            Obj mX;  const Obj& X = mX;
+            mX.encode("abc%n%d", &count, 5);
+            ASSERTV(renderMessage(X), "abc5" == renderMessage(X));
+        }
+
+        if (verbose) cout << "\tUnsupported conversions." << endl;
+        {
+            const char *UNSUPPORTED = "%d %y %d";
+
+            Obj mX;  const Obj& X = mX;
+            mX.encode(UNSUPPORTED, 1);
+            ASSERTV(renderMessage(X), "1 %y %d" == renderMessage(X));
+            ASSERT(!X.isTruncated());
+        }
+
+        if (verbose) cout << "\t'encode' matches 'encodeList'." << endl;
+        {
+            Obj mX;  const Obj& X = mX;
+            mX.encode("%d-%s", 12, "ab");
+            ASSERT("12-ab" == renderMessage(X));
+            ASSERT(sizeof(bsls::Types::Int64) + sizeof(int) + 2 ==
+                                         static_cast<bsl::size_t>(X.length()));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS, 'reset', AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 A default-constructed message has an empty format string, no
+        //:   arguments, and renders as an empty string.
+        //:
+        //: 2 Copy construction and assignment produce a message that renders
+        //:   identically to the original and has the same format string and
+        //:   length.
+        //:
+        //: 3 'reset' returns a message to the default-constructed state.
+        //:
+        //: 4 Assigning to self has no effect.
+        //:
+        //: 5 A null format string is rejected by 'encode' in appropriate build
+        //:   modes.
+        //
+        // Plan:
+        //: 1 Exercise each creator and manipulator and verify the state using
+        //:   the basic accessors and 'render'.  (C-1..4)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for a null format string (using the 'BSLS_ASSERTTEST_*'
+        //:   macros).  (C-5)
+        //
+        // Testing:
+        //   BinaryMessage();
+        //   BinaryMessage(const BinaryMessage& original);
+        //   BinaryMessage& operator=(const BinaryMessage& rhs);
+        //   void reset();
+        //   const char *format() const;
+        //   int length() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS, 'reset', AND BASIC ACCESSORS" << endl
+                          << "======================================" << endl;
+
+        const char *FORMAT = "%s:%d";
+
+        Obj mX;  const Obj& X = mX;
+        ASSERT(0 == bsl::strcmp("", X.format()));
+        ASSERT(0 == X.length());
+        ASSERT(!X.isTruncated());
+        ASSERT("" == renderMessage(X));
+
+        mX.encode(FORMAT, "abc", 5);
+        ASSERT(FORMAT == X.format());
+        ASSERT(0 < X.length());
+        ASSERT("abc:5" == renderMessage(X));
+
+        Obj mY(X);  const Obj& Y = mY;
+        ASSERT(FORMAT     == Y.format());
+        ASSERT(X.length() == Y.length());
+        ASSERT("abc:5"    == renderMessage(Y));
+
+        Obj mZ;  const Obj& Z = mZ;
+        ASSERT(&mZ == &(mZ = X));
+        ASSERT(FORMAT     == Z.format());
+        ASSERT(X.length() == Z.length());
+        ASSERT("abc:5"    == renderMessage(Z));
+
+        ASSERT(&mZ == &(mZ = Z));
+        ASSERT("abc:5" == renderMessage(Z));
+
+        mX.reset();
+        ASSERT(0 == bsl::strcmp("", X.format()));
+        ASSERT(0 == X.length());
+        ASSERT("" == renderMessage(X));
+        ASSERT("abc:5" == renderMessage(Y));
+
+        if (verbose) cout << "\tNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            const char *NULL_FORMAT = 0;
+
+            ASSERT_PASS(mX.encode("x"));
+            ASSERT_FAIL(mX.encode(NULL_FORMAT));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Encode and render a few messages.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "BREATHING TEST" << endl
+                                  << "==============" << endl;
+
+        Obj mX;  const Obj& X = mX;
+
+        mX.encode("hello");
+        ASSERT("hello" == renderMessage(X));
+
+        mX.encode("%d + %d = %s", 1, 2, "three");
+        ASSERT("1 + 2 = three" == renderMessage(X));
+
+        mX.encode("%5.2f", 3.14159);
+        ASSERT(" 3.14" == renderMessage(X));
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -5,6 +5,7 @@
 BSLS_IDENT_RCSID(ball_fileobserver2_cpp,"$Id$ $CSID$")
 
 #include <ball_context.h>
+#include <ball_logfileutil.h>
 #include <ball_record.h>
 #include <ball_recordattributes.h>
 #include <ball_userfields.h>
@@ -19,7 +20,6 @@ BSLS_IDENT_RCSID(ball_fileobserver2_cpp,"$Id$ $CSID$")
 #include <bdlf_memfn.h>
 
 #include <bdls_filesystemutil.h>
-#include <bdls_processutil.h>
 
 #include <bdlt_currenttime.h>
 #include <bdlt_date.h>
@@ -27,6 +27,8 @@ BSLS_IDENT_RCSID(ball_fileobserver2_cpp,"$Id$ $CSID$")
 #include <bdlt_localtimeoffset.h>
 #include <bdlt_time.h>
 
+#include <bslma_default.h>
+
 #include <bslmt_lockguard.h>
 
 #include <bsls_assert.h>
@@ -36,13 +38,12 @@ BSLS_IDENT_RCSID(ball_fileobserver2_cpp,"$Id$ $CSID$")
 
 #include <bslstl_stringref.h>
 
+#include <bsl_climits.h>
 #include <bsl_cstdio.h>
 #include <bsl_cstring.h>
-#include <bsl_iomanip.h>
 #include <bsl_ios.h>
 #include <bsl_memory.h>
 #include <bsl_ostream.h>
-#include <bsl_sstream.h>
 
 #include <bsl_c_errno.h>
 #include <bsl_c_time.h>
@@ -86,24 +87,6 @@ static int getErrorCode(void)
 #endif
 }
 
-static bsl::string getTimestampSuffix(const bdlt::Datetime& timestamp)
-    // Return the specified 'timestamp' in the 'YYYYMMDD_hhmmss' format.
-{
-    char buffer[16];
-
-    snprintf(buffer,
-             sizeof buffer,
-             "%04d%02d%02d_%02d%02d%02d",
-             timestamp.year(),
-             timestamp.month(),
-             timestamp.day(),
-             timestamp.hour(),
-             timestamp.minute(),
-             timestamp.second());
-
-    return bsl::string(buffer);
-}
-
 static bdlt::DatetimeInterval localTimeOffsetInterval(bdlt::Datetime timeUtc)
     // Return the offset of local time from UTC time at the specified
     // 'timeUtc'.
@@ -112,112 +95,6 @@ static bdlt::DatetimeInterval localTimeOffsetInterval(bdlt::Datetime timeUtc)
                               bdlt::LocalTimeOffset::localTimeOffset(timeUtc));
 }
 
-static void getLogFileName(bsl::string    *logFileName,
-                           bdlt::Datetime *timestampUtc,
-                           const char     *logFilePattern,
-                           bool            publishInLocalTime)
-    // Load, into the specified 'logFileName', the filename that is obtained by
-    // replacing every '%'-escape sequence in the specified 'logFilePattern'.
-    // If the specified 'publishInLocalTime' is 'true', replace the time
-    // patterns with local time values, and replace them with UTC time values
-    // otherwise.  Load the current time in UTC into the specified
-    // 'timestampUtc'.
-{
-    BSLS_ASSERT(logFileName);
-    BSLS_ASSERT(timestampUtc);
-    BSLS_ASSERT(logFilePattern);
-
-    *timestampUtc = bdlt::CurrentTime::utc();
-
-    bdlt::Datetime logFileTimestamp = *timestampUtc;
-
-    if (publishInLocalTime) {
-        logFileTimestamp += localTimeOffsetInterval(*timestampUtc);
-    }
-
-    bsl::ostringstream os;
-
-    for (; *logFilePattern; ++logFilePattern) {
-        if ('%' == *logFilePattern) {
-            if (*++logFilePattern) {
-                switch (*logFilePattern) {
-                  case 'T': {
-                    os << getTimestampSuffix(logFileTimestamp);
-                  } break;
-                  case 'Y': {
-                    os << bsl::setw(4) << bsl::setfill('0')
-                       << logFileTimestamp.year();
-                  } break;
-                  case 'M': {
-                    os << bsl::setw(2) << bsl::setfill('0')
-                       << logFileTimestamp.month();
-                  } break;
-                  case 'D': {
-                    os << bsl::setw(2) << bsl::setfill('0')
-                       << logFileTimestamp.day();
-                  } break;
-                  case 'h': {
-                    os << bsl::setw(2) << bsl::setfill('0')
-                       << logFileTimestamp.hour();
-                  } break;
-                  case 'm': {
-                    os << bsl::setw(2) << bsl::setfill('0')
-                       << logFileTimestamp.minute();
-                  } break;
-                  case 's': {
-                    os << bsl::setw(2) << bsl::setfill('0')
-                       << logFileTimestamp.second();
-                  } break;
-                  case 'p': {
-                    os << bdls::ProcessUtil::getProcessId();
-                  } break;
-                  case '%': {
-                  } break;
-                  default: {
-                    os << '%' << *logFilePattern;
-                  } break;
-                }
-            }
-            else {
-                os << '%';  // trailing '%' in pattern
-                break;
-            }
-        } else {
-            os << *logFilePattern;
-        }
-    }
-    *logFileName = os.str();
-}
-
-static bool hasEscapePattern(const char *logFilePattern)
-    // Return 'true' if the specified 'logFilePattern' contains a recognized
-    // '%'-escape sequence, and false otherwise.  The recognized escape
-    // sequence are "%Y", "%M", "%D", "%h", "%m", "%s", and "%%".
-
-{
-    for (; *logFilePattern; ++logFilePattern) {
-        if ('%' == *logFilePattern) {
-            ++logFilePattern;
-            if ('\0' == *logFilePattern) {
-                return false;                                         // RETURN
-            }
-
-            switch (*logFilePattern) {
-              case 'Y':
-              case 'M':
-              case 'D':
-              case 'h':
-              case 'm':
-              case 's':
-              case '%': {
-                return true;                                          // RETURN
-              } break;
-            }
-        }
-    }
-    return false;
-}
-
 static int openLogFile(bsl::ostream *stream, const char *filename)
     // Open a file stream referred to by the specified 'stream' for the file
     // with the specified 'filename' in append mode.  Return 0 on success, and
@@ -282,89 +159,37 @@ static int openLogFile(bsl::ostream *stream, const char *filename)
     return 0;
 }
 
-bool fuzzyEqual(const bdlt::Datetime&         a,
-                const bdlt::Datetime&         b,
-                const bdlt::DatetimeInterval& interval)
-    // Return 'true' if the specified 'a' and 'b' times are within 10% of the
-    // specified 'interval' from each other, and 'false' otherwise.  The
-    // behavior is undefined unless '0 <= interval.totalMilliseconds()'.
-{
-    BSLS_ASSERT(0 <= interval.totalMilliseconds());
-
-    // Note that 'abs(long long)' not available across platforms (C++11).
-
-    bsls::Types::Int64 distance = (a - b).totalMilliseconds();
-
-    if (distance < 0) {
-        distance = -distance;
-    }
+}  // close unnamed namespace
 
-    return distance < (interval.totalMilliseconds() / 10);
-}
+                          // -------------------
+                          // class FileObserver2
+                          // -------------------
 
-static bdlt::Datetime computeNextRotationTime(
-                         const bdlt::Datetime&         referenceStartTimeLocal,
-                         const bdlt::DatetimeInterval& interval,
-                         const bdlt::Datetime&         fileCreationTimeUtc)
-    // Return the UTC time for the next scheduled file rotation after the
-    // specified 'fileCreationTimeUtc', for a schedule that has a start
-    // reference time indicated by the specified 'referenceStartTimeLocal' and
-    // rotated every specified 'interval'.  'referenceStartTimeLocal' must be a
-    // local time value, and 'fileCreationTimeUtc' must be a UTC time value.
-    // The behavior is undefined unless '0 <= interval.totalMilliseconds()'.
-    // Note that 'referenceStartTimeLocal' is a local time value because
-    // 'rotateOnTimeInterval' accepts a local time value and converting that
-    // value to UTC might cause an underflow.
+// PRIVATE MANIPULATORS
+void FileObserver2::attachBatchedWriter()
 {
-    BSLS_ASSERT(0 < interval.totalMilliseconds());
-
-    // Note that all the computations must be done in local time because the
-    // 'referenceStartTimeLocal' when converted to UTC might be out of the
-    // representable range of 'bdlt::Datetime' ('bdlt::Datetime(1, 1, 1)' is a
-    // common reference time).
-
-    bdlt::Datetime fileCreationTimeLocal =
-        fileCreationTimeUtc + localTimeOffsetInterval(fileCreationTimeUtc);
-
-    // If the reference start time is (effectively) equal to the file creation
-    // time, don't rotate until at least one interval has occurred.  A fuzzy
-    // comparison is required because the time stamps come from different
-    // sources, which may occur in close proximity during the configuration of
-    // logging at task startup (the 'fileCreationTime' is determined when
-    // logging is enabled, while the 'referenceStartTimeLocal' may be
-    // determined on a call to 'rotateOnTimeInterval').
-
-    if (fuzzyEqual(referenceStartTimeLocal, fileCreationTimeLocal, interval)) {
-        return fileCreationTimeUtc + interval;                        // RETURN
+    if (!d_batchedWriter_mp || !d_logStreamBuf.isOpened()) {
+        return;                                                       // RETURN
     }
 
-    bsls::Types::Int64 timeLeft =
-       (fileCreationTimeLocal - referenceStartTimeLocal).totalMilliseconds() %
-       interval.totalMilliseconds();
+    d_logOutStream.flush();
 
-    // The modulo operator may return a negative number depending on
-    // implementation.
+    const bsl::streampos position = d_logOutStream.tellp();
+    d_batchedLogFileSize = 0 <= position
+                           ? static_cast<bsls::Types::Int64>(position)
+                           : 0;
 
-    if (timeLeft >= 0) {
-        timeLeft = interval.totalMilliseconds() - timeLeft;
-    }
-    else {
-        timeLeft = -timeLeft;
-    }
-
-    bdlt::Datetime resultUtc = fileCreationTimeUtc;
-    resultUtc.addMilliseconds(timeLeft);
-
-    return resultUtc;
+    d_batchedWriter_mp->setFileDescriptor(d_logStreamBuf.fileDescriptor());
 }
 
-}  // close unnamed namespace
-
-                          // -------------------
-                          // class FileObserver2
-                          // -------------------
+void FileObserver2::detachBatchedWriter()
+{
+    if (d_batchedWriter_mp) {
+        d_batchedWriter_mp->setFileDescriptor(
+                                          bdls::FilesystemUtil::k_INVALID_FD);
+    }
+}
 
-// PRIVATE MANIPULATORS
 void FileObserver2::logRecordDefault(bsl::ostream& stream,
                                      const Record& record)
 
@@ -432,6 +257,8 @@ int FileObserver2::rotateFile(bsl::string *rotatedLogFileName)
 
     int returnStatus = k_ROTATE_SUCCESS;
 
+    detachBatchedWriter();
+
     if (0 != d_logStreamBuf.clear()) {
         char errorBuffer[256];
 
@@ -450,21 +277,17 @@ int FileObserver2::rotateFile(bsl::string *rotatedLogFileName)
 
     const bdlt::Datetime oldLogFileTimestamp = d_logFileTimestampUtc;
 
-    getLogFileName(&d_logFileName,
-                   &d_logFileTimestampUtc,
-                   d_logFilePattern.c_str(),
-                   d_publishInLocalTime);
+    LogFileUtil::loadLogFileName(&d_logFileName,
+                                 &d_logFileTimestampUtc,
+                                 d_logFilePattern.c_str(),
+                                 d_publishInLocalTime);
 
     if (bdls::FilesystemUtil::exists(d_logFileName.c_str())) {
-        bdlt::Datetime timeStampSuffix(oldLogFileTimestamp);
-
-        if (d_publishInLocalTime) {
-            timeStampSuffix += localTimeOffsetInterval(oldLogFileTimestamp);
-        }
-
-        bsl::string newFileName(d_logFileName);
-        newFileName += '.';
-        newFileName += getTimestampSuffix(timeStampSuffix);
+        bsl::string newFileName;
+        LogFileUtil::loadRotatedLogFileName(&newFileName,
+                                            d_logFileName,
+                                            oldLogFileTimestamp,
+                                            d_publishInLocalTime);
 
         if (0 == bsl::rename(d_logFileName.c_str(), newFileName.c_str())) {
             *rotatedLogFileName = newFileName;
@@ -487,7 +310,7 @@ int FileObserver2::rotateFile(bsl::string *rotatedLogFileName)
     }
 
     if (0 < d_rotationInterval.totalSeconds()) {
-        d_nextRotationTimeUtc = computeNextRotationTime(
+        d_nextRotationTimeUtc = LogFileUtil::computeNextRotationTime(
                                                   d_rotationReferenceLocalTime,
                                                   d_rotationInterval,
                                                   d_logFileTimestampUtc);
@@ -510,6 +333,8 @@ int FileObserver2::rotateFile(bsl::string *rotatedLogFileName)
                : k_ROTATE_NEW_LOG_ERROR;                              // RETURN
     }
 
+    attachBatchedWriter();
+
     return returnStatus;
 }
 
@@ -526,9 +351,16 @@ int FileObserver2::rotateIfNecessary(bsl::string           *rotatedLogFileName,
 
     if (d_rotationSize) {
         // 'tellp' returns -1 on failure.  Rotate the log file if either
-        // 'tellp' fails, or the rotation size is exceeded.
+        // 'tellp' fails, or the rotation size is exceeded.  If write batching
+        // is enabled, records are not written through 'd_logOutStream', whose
+        // position is therefore not that of the end of the log file.
+
+        const bsls::Types::Int64 logFileSize = d_batchedWriter_mp
+                                   ? d_batchedLogFileSize
+                                   : static_cast<bsls::Types::Int64>(
+                                                      d_logOutStream.tellp());
 
-        if (static_cast<bsls::Types::Uint64>(d_logOutStream.tellp()) >
+        if (static_cast<bsls::Types::Uint64>(logFileSize) >
             static_cast<bsls::Types::Uint64>(d_rotationSize) * 1024) {
 
             return rotateFile(rotatedLogFileName);                    // RETURN
@@ -564,11 +396,18 @@ FileObserver2::FileObserver2(bslma::Allocator *basicAllocator)
                  bsl::allocator<FileObserver2::OnFileRotationCallback>(
                                                                basicAllocator))
 , d_rotationCbMutex()
+, d_batchRecordStreamBuf(basicAllocator)
+, d_batchRecordStream(&d_batchRecordStreamBuf)
+, d_batchedWriter_mp()
+, d_batchedLogFileSize(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
 }
 
 FileObserver2::~FileObserver2()
 {
+    detachBatchedWriter();
+
     if (d_logStreamBuf.isOpened()) {
         d_logStreamBuf.clear();
     }
@@ -579,6 +418,8 @@ void FileObserver2::disableFileLogging()
 {
     bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
 
+    detachBatchedWriter();
+
     if (d_logStreamBuf.isOpened()) {
         d_logStreamBuf.clear();
     }
@@ -610,6 +451,19 @@ void FileObserver2::disableTimeIntervalRotation()
     d_rotationInterval.setTotalSeconds(0);
 }
 
+void FileObserver2::disableWriteBatching()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (!d_batchedWriter_mp) {
+        return;                                                       // RETURN
+    }
+
+    detachBatchedWriter();
+    d_batchedWriter_mp->stop();
+    d_batchedWriter_mp.reset();
+}
+
 int FileObserver2::enableFileLogging(const char *logFilenamePattern)
 {
     BSLS_ASSERT(logFilenamePattern);
@@ -622,10 +476,10 @@ int FileObserver2::enableFileLogging(const char *logFilenamePattern)
 
     d_logFilePattern = logFilenamePattern;
 
-    getLogFileName(&d_logFileName,
-                   &d_logFileTimestampUtc,
-                   d_logFilePattern.c_str(),
-                   d_publishInLocalTime);
+    LogFileUtil::loadLogFileName(&d_logFileName,
+                                 &d_logFileTimestampUtc,
+                                 d_logFilePattern.c_str(),
+                                 d_publishInLocalTime);
 
     // Use the last modification time of the log file to calculate the next
     // rotation time if the log file already exists.  The
@@ -636,13 +490,19 @@ int FileObserver2::enableFileLogging(const char *logFilenamePattern)
                                                   d_logFileName);
 
     if (0 < d_rotationInterval.totalSeconds()) {
-        d_nextRotationTimeUtc = computeNextRotationTime(
+        d_nextRotationTimeUtc = LogFileUtil::computeNextRotationTime(
                                                   d_rotationReferenceLocalTime,
                                                   d_rotationInterval,
                                                   d_logFileTimestampUtc);
     }
 
-    return openLogFile(&d_logOutStream, d_logFileName.c_str());
+    if (0 != openLogFile(&d_logOutStream, d_logFileName.c_str())) {
+        return -1;                                                    // RETURN
+    }
+
+    attachBatchedWriter();
+
+    return 0;
 }
 
 int FileObserver2::enableFileLogging(const char *logFilenamePattern,
@@ -650,7 +510,8 @@ int FileObserver2::enableFileLogging(const char *logFilenamePattern,
 {
     BSLS_ASSERT(logFilenamePattern);
 
-    if (appendTimestampFlag && !hasEscapePattern(logFilenamePattern)) {
+    if (appendTimestampFlag
+     && !LogFileUtil::hasEscapePattern(logFilenamePattern)) {
         bsl::string pattern(logFilenamePattern);
         pattern += ".%T";
         return enableFileLogging(pattern.c_str());                    // RETURN
@@ -685,6 +546,42 @@ void FileObserver2::enablePublishInLocalTime()
     d_publishInLocalTime = true;
 }
 
+int FileObserver2::enableWriteBatching(
+                                   int                           flushSize,
+                                   const bdlt::DatetimeInterval& flushInterval,
+                                   int                           syncSize)
+{
+    BSLS_ASSERT(0 < flushSize);
+    BSLS_ASSERT(flushSize <= INT_MAX / 1024);
+    BSLS_ASSERT(0 < flushInterval.totalMicroseconds());
+    BSLS_ASSERT(0 <= syncSize);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (d_batchedWriter_mp) {
+        return 1;                                                     // RETURN
+    }
+
+    bslma::ManagedPtr<BatchedFileWriter> writer(
+              new (*d_allocator_p) BatchedFileWriter(
+                 flushSize * 1024,
+                 bdlt::IntervalConversionUtil::convertToTimeInterval(
+                                                               flushInterval),
+                 static_cast<bsls::Types::Int64>(syncSize) * 1024,
+                 d_allocator_p),
+              d_allocator_p);
+
+    if (0 != writer->start()) {
+        return -1;                                                    // RETURN
+    }
+
+    d_batchedWriter_mp = writer;
+
+    attachBatchedWriter();
+
+    return 0;
+}
+
 void FileObserver2::publish(const Record& record, const Context&)
 {
     bsl::string rotatedFileName;
@@ -695,7 +592,41 @@ void FileObserver2::publish(const Record& record, const Context&)
         rotationStatus = rotateIfNecessary(&rotatedFileName,
                                            record.fixedFields().timestamp());
 
-        if (d_logStreamBuf.isOpened()) {
+        if (d_logStreamBuf.isOpened() && d_batchedWriter_mp) {
+            // Format the record into memory, and append it to the current
+            // batch of the writer.
+
+            d_batchRecordStreamBuf.pubseekpos(0);
+            d_batchRecordStream.clear();
+
+            d_logFileFunctor(d_batchRecordStream, record);
+
+            const int length = static_cast<int>(
+                                             d_batchRecordStreamBuf.length());
+
+            if (!d_batchRecordStream
+             || 0 != d_batchedWriter_mp->append(d_batchRecordStreamBuf.data(),
+                                                length)) {
+                char errorBuffer[256];
+
+                snprintf(errorBuffer,
+                         sizeof errorBuffer,
+                         "Error on batched writes to %s.",
+                         d_logFileName.c_str());
+                bsls::Log::platformDefaultMessageHandler(
+                                                    bsls::LogSeverity::e_ERROR,
+                                                    __FILE__,
+                                                    __LINE__,
+                                                    errorBuffer);
+
+                detachBatchedWriter();
+                d_logStreamBuf.clear();
+            }
+            else {
+                d_batchedLogFileSize += length;
+            }
+        }
+        else if (d_logStreamBuf.isOpened()) {
             d_logFileFunctor(d_logOutStream, record);
 
             if (!d_logOutStream) {
@@ -756,7 +687,7 @@ void FileObserver2::rotateOnTimeInterval(
     // Need to determine the next rotation time if the file is already opened.
 
     if (d_logStreamBuf.isOpened()) {
-        d_nextRotationTimeUtc = computeNextRotationTime(
+        d_nextRotationTimeUtc = LogFileUtil::computeNextRotationTime(
                                                   d_rotationReferenceLocalTime,
                                                   d_rotationInterval,
                                                   d_logFileTimestampUtc);
@@ -813,6 +744,13 @@ bool FileObserver2::isPublishInLocalTimeEnabled() const
     return d_publishInLocalTime;
 }
 
+bool FileObserver2::isWriteBatchingEnabled() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return 0 != d_batchedWriter_mp.get();
+}
+
 bdlt::DatetimeInterval FileObserver2::localTimeOffset() const
 {
     bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
@@ -12,7 +12,7 @@ BSLS_IDENT("$Id: $")
 //  ball::FileObserver2: observer that outputs log records to a file
 //
 //@SEE_ALSO: ball_record, ball_context, ball_observer,
-//           ball_recordstringformatter
+//           ball_recordstringformatter, ball_batchedfilewriter
 //
 //@DESCRIPTION: This component provides a concrete implementation of the
 // 'ball::Observer' protocol, 'ball::FileObserver2', for publishing log records
@@ -27,8 +27,10 @@ BSLS_IDENT("$Id: $")
 //                         |              disableTimeIntervalRotation
 //                         |              disableSizeRotation
 //                         |              disablePublishInLocalTime
+//                         |              disableWriteBatching
 //                         |              enableFileLogging
 //                         |              enablePublishInLocalTime
+//                         |              enableWriteBatching
 //                         |              forceRotation
 //                         |              rotateOnSize
 //                         |              rotateOnTimeInterval
@@ -36,6 +38,7 @@ BSLS_IDENT("$Id: $")
 //                         |              setOnFileRotationCallback
 //                         |              isFileLoggingEnabled
 //                         |              isPublishInLocalTimeEnabled
+//                         |              isWriteBatchingEnabled
 //                         |              rotationLifetime
 //                         |              rotationSize
 //                         V
@@ -52,7 +55,9 @@ BSLS_IDENT("$Id: $")
 // logging to a file is initially disabled following construction.  The format
 // of published log records is user-configurable (see {Log Record Formatting}
 // below).  In addition, a file observer may be configured to perform automatic
-// log file rotation (see {Log File Rotation} below).
+// log file rotation (see {Log File Rotation} below), and to write log records
+// to its file in batches from a dedicated thread (see {Write Batching}
+// below).
 //
 ///File Observer Configuration Synopsis
 ///------------------------------------
@@ -80,6 +85,9 @@ BSLS_IDENT("$Id: $")
 // |             | disableTimeIntervalRotation |                              |
 // |             | setOnFileRotationCallback   |                              |
 // +-------------+-----------------------------+------------------------------+
+// | Write       | enableWriteBatching         | isWriteBatchingEnabled       |
+// | Batching    | disableWriteBatching        |                              |
+// +-------------+-----------------------------+------------------------------+
 //..
 // In general, a 'ball::FileObserver2' object can be dynamically configured
 // throughout its lifetime (in particular, before or after being registered
@@ -238,6 +246,37 @@ BSLS_IDENT("$Id: $")
 // in the filename.  In any case, logging resumes to a new, initially empty,
 // file.
 //
+///Write Batching
+///--------------
+// By default, 'publish' writes each record to the log file through a stream
+// buffer that is flushed after each record (when the default format is in
+// effect), so that each published record costs at least one 'write' system
+// call, made while the lock of the file observer is held.  If records are
+// published at a high rate, the threads publishing them (or, if the logger
+// manager publishes records asynchronously, the thread doing so) spend most of
+// their time waiting for those system calls.
+//
+// The 'enableWriteBatching' method configures a file observer to format each
+// published record into memory and append it to a 'ball::BatchedFileWriter',
+// which writes the accumulated records to the log file in large batches (using
+// a single 'writev' system call per group of batches where available) from a
+// dedicated writer thread.  The writer hands its current batch to the writer
+// thread when it holds at least 'flushSize' kilobytes, or once 'flushInterval'
+// has elapsed since a record was first appended to it, whichever occurs first.
+// The writer can also synchronize the log file with its storage device (using
+// 'fsync' or its equivalent) each time at least 'syncSize' kilobytes have been
+// written to it, so that many batches share the cost of one synchronization.
+// See {'ball_batchedfilewriter'} for details.
+//
+// While write batching is enabled, a record published to the file observer may
+// reach the log file up to 'flushInterval' after 'publish' returns.  All
+// records published before a log file is closed (by 'disableFileLogging', by
+// a rotation, or by the destruction of the file observer), or before
+// 'disableWriteBatching' is called, are written to the log file before that
+// operation completes.  If a record is published faster than it can be
+// written, 'publish' blocks until the writer thread catches up.  Rotation of
+// the log file, based on its size or on a time interval, is unaffected.
+//
 ///Thread Safety
 ///-------------
 // All methods of 'ball::FileObserver2' are thread-safe, and can be called
@@ -302,21 +341,27 @@ BSLS_IDENT("$Id: $")
 
 #include <balscm_version.h>
 
+#include <ball_batchedfilewriter.h>
 #include <ball_observer.h>
 #include <ball_severity.h>
 
 #include <bdls_fdstreambuf.h>
 
+#include <bdlsb_memoutstreambuf.h>
+
 #include <bdlt_datetime.h>
 #include <bdlt_datetimeinterval.h>
 
 #include <bslma_allocator.h>
+#include <bslma_managedptr.h>
 #include <bslma_usesbslmaallocator.h>
 
 #include <bslmf_nestedtraitdeclaration.h>
 
 #include <bslmt_mutex.h>
 
+#include <bsls_types.h>
+
 #include <bsl_fstream.h>
 #include <bsl_functional.h>
 #include <bsl_iosfwd.h>
@@ -419,6 +464,30 @@ class FileObserver2 : public Observer {
                                                        // called with 'd_mutex'
                                                        // unlocked
 
+    bdlsb::MemOutStreamBuf d_batchRecordStreamBuf;     // stream buffer into
+                                                       // which records are
+                                                       // formatted when write
+                                                       // batching is enabled
+
+    bsl::ostream           d_batchRecordStream;        // output stream for
+                                                       // formatting records
+                                                       // (refers to the
+                                                       // stream buffer above)
+
+    bslma::ManagedPtr<BatchedFileWriter>
+                           d_batchedWriter_mp;         // writer of batched
+                                                       // records (empty if
+                                                       // write batching is not
+                                                       // enabled)
+
+    bsls::Types::Int64     d_batchedLogFileSize;       // size of the log file,
+                                                       // including records
+                                                       // appended to
+                                                       // 'd_batchedWriter_mp'
+
+    bslma::Allocator      *d_allocator_p;              // memory allocator
+                                                       // (held, not owned)
+
   private:
     // NOT IMPLEMENTED
     FileObserver2(const FileObserver2&);
@@ -426,6 +495,21 @@ class FileObserver2 : public Observer {
 
   private:
     // PRIVATE MANIPULATORS
+    void attachBatchedWriter();
+        // Direct the records subsequently appended to the batched writer of
+        // this file observer to the current log file, after writing any data
+        // buffered by 'd_logOutStream' to the file.  This method has no effect
+        // unless both write batching and file logging are enabled.  The
+        // behavior is undefined unless the caller acquired the lock for this
+        // object.
+
+    void detachBatchedWriter();
+        // Write all records appended to the batched writer of this file
+        // observer to the current log file, and detach the writer from the
+        // file.  This method has no effect unless write batching is enabled.
+        // The behavior is undefined unless the caller acquired the lock for
+        // this object.
+
     void logRecordDefault(bsl::ostream& stream, const Record& record);
         // Write the specified log 'record' to the specified output 'stream'
         // using the default record format of this file observer.
@@ -503,6 +587,12 @@ class FileObserver2 : public Observer {
         // enabled.  Note that this method also affects log filenames (see {Log
         // Filename Patterns}).
 
+    void disableWriteBatching();
+        // Disable write batching for this file observer: write all records
+        // published so far to the log file, and stop the writer thread;
+        // henceforth, records are written to the log file by 'publish'.  This
+        // method has no effect if write batching is not enabled.
+
     int enableFileLogging(const char *logFilenamePattern);
         // Enable logging of all records published to this file observer to a
         // file whose name is derived from the specified 'logFilenamePattern'.
@@ -550,6 +640,25 @@ class FileObserver2 : public Observer {
         // in local time is already enabled.  Note that this method also
         // affects log filenames (see {Log Filename Patterns}).
 
+    int enableWriteBatching(int                           flushSize,
+                            const bdlt::DatetimeInterval& flushInterval,
+                            int                           syncSize = 0);
+        // Enable write batching for this file observer: henceforth, published
+        // records are accumulated in memory and written to the log file by a
+        // dedicated writer thread, in batches of at least the specified
+        // 'flushSize' (in kilobytes), or once the specified 'flushInterval'
+        // has elapsed since a record was first added to a batch.  Optionally
+        // specify a 'syncSize' (in kilobytes): if 'syncSize' is positive, the
+        // log file is synchronized with its storage device each time at least
+        // 'syncSize' kilobytes have been written to it since it was last
+        // synchronized; otherwise, the log file is never explicitly
+        // synchronized.  Return 0 on success, a positive value if write
+        // batching is already enabled (with no effect), and a negative value
+        // if the writer thread could not be started.  The behavior is
+        // undefined unless '0 < flushSize', 'flushSize <= INT_MAX / 1024',
+        // '0 < flushInterval.totalMicroseconds()', and '0 <= syncSize'.  See
+        // {Write Batching}.
+
     void publish(const Record& record, const Context& context);
         // Process the specified log 'record' having the specified publishing
         // 'context' by writing 'record' and 'context' to the current log file
@@ -643,6 +752,10 @@ class FileObserver2 : public Observer {
         // value returned by this method also affects log filenames (see {Log
         // Filename Patterns}).
 
+    bool isWriteBatchingEnabled() const;
+        // Return 'true' if write batching is enabled for this file observer,
+        // and 'false' otherwise.
+
     bdlt::DatetimeInterval rotationLifetime() const;
         // Return the lifetime of the log file that will trigger a file
         // rotation by this file observer if rotation-on-lifetime is in effect,
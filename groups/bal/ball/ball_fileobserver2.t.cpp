@@ -39,6 +39,7 @@
 #include <bslstl_stringref.h>
 
 #include <bsls_assert.h>
+#include <bsls_asserttest.h>
 #include <bsls_platform.h>
 #include <bsls_timeinterval.h>
 #include <bsls_types.h>
@@ -96,9 +97,11 @@ using bsl::flush;
 // [ 1] void disablePublishInLocalTime();
 // [ 2] void disableSizeRotation();
 // [ 8] void disableTimeIntervalRotation();
+// [14] void disableWriteBatching();
 // [ 1] int  enableFileLogging(const char *fileName);
 // [ 1] int  enableFileLogging(const char *fileName, bool timestampFlag);
 // [ 1] void enablePublishInLocalTime();
+// [14] int  enableWriteBatching(int, const DatetimeInterval&, int = 0);
 // [ 1] void publish(const Record& record, const Context& context);
 // [ 1] void publish(const shared_ptr<Record>&, const Context&);
 // [ 2] void forceRotation();
@@ -113,10 +116,12 @@ using bsl::flush;
 // [ 1] bool isFileLoggingEnabled() const;
 // [ 1] bool isFileLoggingEnabled(bsl::string *result) const;
 // [ 1] bool isPublishInLocalTimeEnabled() const;
+// [14] bool isWriteBatchingEnabled() const;
 // [ 2] DatetimeInterval rotationLifetime() const;
 // [ 2] int rotationSize() const;
 // ----------------------------------------------------------------------------
-// [13] USAGE EXAMPLE
+// [15] USAGE EXAMPLE
+// [14] CONCERN: WRITE BATCHING
 // [12] CONCERN: CURRENT LOCAL-TIME OFFSET IN TIMESTAMP
 // [11] CONCERN: TIME CALLBACKS ARE CALLED
 // [10] CONCERN: ROTATION CAN BE ENABLED AFTER FILE LOGGING
@@ -187,6 +192,17 @@ void aSsErT2(bool condition, const char *message, int line)
 #define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
 #define L_           BSLIM_TESTUTIL_L_  // current Line number
 
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
 // ============================================================================
 //                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
 // ----------------------------------------------------------------------------
@@ -712,7 +728,7 @@ int main(int argc, char *argv[])
     ASSERT(0 == bslma::Default::setDefaultAllocator(&defaultAllocator));
 
     switch (test) { case 0:
-      case 14: {
+      case 15: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -788,6 +804,244 @@ int main(int argc, char *argv[])
 //..
 
       } break;
+      case 14: {
+        // --------------------------------------------------------------------
+        // TESTING WRITE BATCHING
+        //
+        // Concerns:
+        //: 1 'enableWriteBatching' enables write batching, whether or not file
+        //:   logging is enabled, and returns a positive value if write
+        //:   batching is already enabled; 'disableWriteBatching' disables it;
+        //:   'isWriteBatchingEnabled' reports whether it is enabled.
+        //:
+        //: 2 While write batching is enabled, published records are not
+        //:   written to the log file by 'publish', but are written (in order)
+        //:   once the flush interval elapses, or when write batching or file
+        //:   logging is disabled.
+        //:
+        //: 3 Records published before a rotation are written to the rotated
+        //:   file, and records published after it to the new file.
+        //:
+        //: 4 Rotation on size accounts for the records that are not yet
+        //:   written to the log file.
+        //:
+        //: 5 Records are written to the log file by 'publish' once write
+        //:   batching is disabled.
+        //:
+        //: 6 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Enable write batching with a long flush interval, publish
+        //:   records, and verify that the log file is empty until write
+        //:   batching, or file logging, is disabled.  (C-1,2,5)
+        //:
+        //: 2 Enable write batching with a short flush interval, publish a
+        //:   record, and poll the log file until the record is written.  (C-2)
+        //:
+        //: 3 With write batching enabled, publish records, force a rotation,
+        //:   publish more records, and verify the contents of both files.
+        //:   (C-3)
+        //:
+        //: 4 With write batching enabled and a rotation size of 1 KB, publish
+        //:   records until the rotation callback is invoked, and verify that
+        //:   the rotated file holds the expected records.  (C-4)
+        //:
+        //: 5 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-6)
+        //
+        // Testing:
+        //   int  enableWriteBatching(int, const DatetimeInterval&, int = 0);
+        //   void disableWriteBatching();
+        //   bool isWriteBatchingEnabled() const;
+        //   CONCERN: WRITE BATCHING
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING WRITE BATCHING"
+                          << "\n======================" << endl;
+
+        // Each record published by 'publishRecord' occupies two lines of the
+        // log file when the default format is in effect.
+
+        const bdlt::DatetimeInterval LONG(0, 0, 1);
+        const bdlt::DatetimeInterval SHORT(0, 0, 0, 0, 20);
+
+        bslma::TestAllocator ta("ta", veryVeryVeryVerbose);
+
+        if (verbose) cout << "\tEnabling and disabling." << endl;
+        {
+            TempDirectoryGuard tempDirGuard;
+            bsl::string        fileName(tempDirGuard.getTempDirName());
+            bdls::PathUtil::appendRaw(&fileName, "batched.log");
+
+            Obj        mX(&ta);
+            const Obj& X = mX;
+
+            ASSERT(false == X.isWriteBatchingEnabled());
+            ASSERT(0     == mX.enableWriteBatching(1024, LONG));
+            ASSERT(true  == X.isWriteBatchingEnabled());
+            ASSERT(1     == mX.enableWriteBatching(1024, LONG));
+            ASSERT(true  == X.isWriteBatchingEnabled());
+
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+            for (int i = 0; i < 100; ++i) {
+                publishRecord(&mX, "batched");
+            }
+            ASSERT(0 == FsUtil::getFileSize(fileName.c_str()));
+
+            mX.disableWriteBatching();
+            ASSERT(false == X.isWriteBatchingEnabled());
+            ASSERTV(getNumLines(fileName.c_str()),
+                    200 == getNumLines(fileName.c_str()));
+
+            mX.disableWriteBatching();
+            ASSERT(false == X.isWriteBatchingEnabled());
+
+            publishRecord(&mX, "unbatched");
+            ASSERTV(getNumLines(fileName.c_str()),
+                    202 == getNumLines(fileName.c_str()));
+
+            // Enabling write batching while file logging is enabled.
+
+            ASSERT(0 == mX.enableWriteBatching(1, LONG, 1));
+            for (int i = 0; i < 10; ++i) {
+                publishRecord(&mX, "batched");
+            }
+            mX.disableFileLogging();
+            ASSERTV(getNumLines(fileName.c_str()),
+                    222 == getNumLines(fileName.c_str()));
+
+            // Records published while file logging is disabled are dropped.
+
+            publishRecord(&mX, "dropped");
+
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+            publishRecord(&mX, "batched");
+            mX.disableWriteBatching();
+            ASSERTV(getNumLines(fileName.c_str()),
+                    224 == getNumLines(fileName.c_str()));
+            mX.disableFileLogging();
+
+            bsl::string content;
+            readFileIntoString(__LINE__, fileName, content);
+            ASSERT(bsl::string::npos == content.find("dropped"));
+            ASSERT(content.find("unbatched") < content.rfind("batched"));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tFlushing on interval." << endl;
+        {
+            TempDirectoryGuard tempDirGuard;
+            bsl::string        fileName(tempDirGuard.getTempDirName());
+            bdls::PathUtil::appendRaw(&fileName, "interval.log");
+
+            Obj mX(&ta);
+
+            ASSERT(0 == mX.enableWriteBatching(1024, SHORT));
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+            publishRecord(&mX, "interval");
+
+            for (int i = 0; i < 500; ++i) {
+                if (0 < FsUtil::getFileSize(fileName.c_str())) {
+                    break;
+                }
+                bslmt::ThreadUtil::microSleep(10 * 1000);
+            }
+            ASSERTV(getNumLines(fileName.c_str()),
+                    2 == getNumLines(fileName.c_str()));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tForced rotation." << endl;
+        {
+            TempDirectoryGuard tempDirGuard;
+            bsl::string        fileName(tempDirGuard.getTempDirName());
+            bdls::PathUtil::appendRaw(&fileName, "rotated.log");
+
+            Obj   mX(&ta);
+            RotCb cb(&ta);
+            mX.setOnFileRotationCallback(cb);
+
+            ASSERT(0 == mX.enableWriteBatching(1024, LONG));
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+            for (int i = 0; i < 10; ++i) {
+                publishRecord(&mX, "before");
+            }
+
+            mX.forceRotation();
+
+            ASSERTV(cb.numInvocations(), 1 == cb.numInvocations());
+            ASSERTV(cb.status(),         0 == cb.status());
+            ASSERTV(getNumLines(cb.rotatedFileName().c_str()),
+                    20 == getNumLines(cb.rotatedFileName().c_str()));
+            ASSERT(0 == FsUtil::getFileSize(fileName.c_str()));
+
+            for (int i = 0; i < 5; ++i) {
+                publishRecord(&mX, "after");
+            }
+            mX.disableFileLogging();
+
+            ASSERTV(getNumLines(fileName.c_str()),
+                    10 == getNumLines(fileName.c_str()));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tRotation on size." << endl;
+        {
+            TempDirectoryGuard tempDirGuard;
+            bsl::string        fileName(tempDirGuard.getTempDirName());
+            bdls::PathUtil::appendRaw(&fileName, "size.log");
+
+            Obj   mX(&ta);
+            RotCb cb(&ta);
+            mX.setOnFileRotationCallback(cb);
+
+            ASSERT(0 == mX.enableWriteBatching(1024, LONG));
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+            mX.rotateOnSize(1);
+
+            const bsl::string message(400, 'x');
+
+            // The first three records exceed 1 KB, so the fourth is published
+            // to a new file.
+
+            for (int i = 0; i < 3; ++i) {
+                publishRecord(&mX, message.c_str());
+            }
+            ASSERTV(cb.numInvocations(), 0 == cb.numInvocations());
+            ASSERT(0 == FsUtil::getFileSize(fileName.c_str()));
+
+            publishRecord(&mX, message.c_str());
+
+            ASSERTV(cb.numInvocations(), 1 == cb.numInvocations());
+            ASSERTV(cb.status(),         0 == cb.status());
+            ASSERTV(getNumLines(cb.rotatedFileName().c_str()),
+                    6 == getNumLines(cb.rotatedFileName().c_str()));
+
+            mX.disableFileLogging();
+            ASSERTV(getNumLines(fileName.c_str()),
+                    2 == getNumLines(fileName.c_str()));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            const bdlt::DatetimeInterval ZERO;
+
+            Obj mX(&ta);
+
+            ASSERT_SAFE_FAIL(mX.enableWriteBatching(0,    LONG));
+            ASSERT_SAFE_FAIL(mX.enableWriteBatching(-1,   LONG));
+            ASSERT_SAFE_FAIL(mX.enableWriteBatching(1024, ZERO));
+            ASSERT_SAFE_FAIL(mX.enableWriteBatching(1024, LONG, -1));
+            ASSERT_SAFE_PASS(mX.enableWriteBatching(1024, LONG, 0));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
       case 13: {
         // --------------------------------------------------------------------
         // REPRODUCE BUG FROM DRQS 123123158
@@ -0,0 +1,269 @@
+// ball_logfileutil.cpp                                               -*-C++-*-
+#include <ball_logfileutil.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ball_logfileutil_cpp,"$Id$ $CSID$")
+
+#include <bdls_processutil.h>
+
+#include <bdlt_currenttime.h>
+#include <bdlt_intervalconversionutil.h>
+#include <bdlt_localtimeoffset.h>
+
+#include <bsls_assert.h>
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
+#include <bsl_iomanip.h>
+#include <bsl_sstream.h>
+
+#include <bsl_c_stdio.h>   // for 'snprintf'
+
+#if defined(BSLS_PLATFORM_CMP_MSVC)
+#define snprintf _snprintf
+#endif
+
+namespace BloombergLP {
+namespace ball {
+
+namespace {
+
+bsl::string getTimestampSuffix(const bdlt::Datetime& timestamp)
+    // Return the specified 'timestamp' in the 'YYYYMMDD_hhmmss' format.
+{
+    char buffer[16];
+
+    snprintf(buffer,
+             sizeof buffer,
+             "%04d%02d%02d_%02d%02d%02d",
+             timestamp.year(),
+             timestamp.month(),
+             timestamp.day(),
+             timestamp.hour(),
+             timestamp.minute(),
+             timestamp.second());
+
+    return bsl::string(buffer);
+}
+
+bdlt::DatetimeInterval localTimeOffsetInterval(bdlt::Datetime timeUtc)
+    // Return the offset of local time from UTC time at the specified
+    // 'timeUtc'.
+{
+    return bdlt::IntervalConversionUtil::convertToDatetimeInterval(
+                              bdlt::LocalTimeOffset::localTimeOffset(timeUtc));
+}
+
+bool fuzzyEqual(const bdlt::Datetime&         a,
+                const bdlt::Datetime&         b,
+                const bdlt::DatetimeInterval& interval)
+    // Return 'true' if the specified 'a' and 'b' times are within 10% of the
+    // specified 'interval' from each other, and 'false' otherwise.  The
+    // behavior is undefined unless '0 <= interval.totalMilliseconds()'.
+{
+    BSLS_ASSERT(0 <= interval.totalMilliseconds());
+
+    // Note that 'abs(long long)' not available across platforms (C++11).
+
+    bsls::Types::Int64 distance = (a - b).totalMilliseconds();
+
+    if (distance < 0) {
+        distance = -distance;
+    }
+
+    return distance < (interval.totalMilliseconds() / 10);
+}
+
+}  // close unnamed namespace
+
+                            // ------------------
+                            // struct LogFileUtil
+                            // ------------------
+
+// CLASS METHODS
+bdlt::Datetime LogFileUtil::computeNextRotationTime(
+                         const bdlt::Datetime&         referenceStartTimeLocal,
+                         const bdlt::DatetimeInterval& interval,
+                         const bdlt::Datetime&         fileCreationTimeUtc)
+{
+    BSLS_ASSERT(0 < interval.totalMilliseconds());
+
+    // Note that all the computations must be done in local time because the
+    // 'referenceStartTimeLocal' when converted to UTC might be out of the
+    // representable range of 'bdlt::Datetime' ('bdlt::Datetime(1, 1, 1)' is a
+    // common reference time).
+
+    bdlt::Datetime fileCreationTimeLocal =
+        fileCreationTimeUtc + localTimeOffsetInterval(fileCreationTimeUtc);
+
+    // If the reference start time is (effectively) equal to the file creation
+    // time, don't rotate until at least one interval has occurred.  A fuzzy
+    // comparison is required because the time stamps come from different
+    // sources, which may occur in close proximity during the configuration of
+    // logging at task startup (the 'fileCreationTime' is determined when
+    // logging is enabled, while the 'referenceStartTimeLocal' may be
+    // determined on a call to 'rotateOnTimeInterval').
+
+    if (fuzzyEqual(referenceStartTimeLocal, fileCreationTimeLocal, interval)) {
+        return fileCreationTimeUtc + interval;                        // RETURN
+    }
+
+    bsls::Types::Int64 timeLeft =
+       (fileCreationTimeLocal - referenceStartTimeLocal).totalMilliseconds() %
+       interval.totalMilliseconds();
+
+    // The modulo operator may return a negative number depending on
+    // implementation.
+
+    if (timeLeft >= 0) {
+        timeLeft = interval.totalMilliseconds() - timeLeft;
+    }
+    else {
+        timeLeft = -timeLeft;
+    }
+
+    bdlt::Datetime resultUtc = fileCreationTimeUtc;
+    resultUtc.addMilliseconds(timeLeft);
+
+    return resultUtc;
+}
+
+bool LogFileUtil::hasEscapePattern(const char *logFilePattern)
+{
+    BSLS_ASSERT(logFilePattern);
+
+    for (; *logFilePattern; ++logFilePattern) {
+        if ('%' == *logFilePattern) {
+            ++logFilePattern;
+            if ('\0' == *logFilePattern) {
+                return false;                                         // RETURN
+            }
+
+            switch (*logFilePattern) {
+              case 'Y':
+              case 'M':
+              case 'D':
+              case 'h':
+              case 'm':
+              case 's':
+              case '%': {
+                return true;                                          // RETURN
+              } break;
+            }
+        }
+    }
+    return false;
+}
+
+void LogFileUtil::loadLogFileName(bsl::string    *logFileName,
+                                  bdlt::Datetime *timestampUtc,
+                                  const char     *logFilePattern,
+                                  bool            publishInLocalTime)
+{
+    BSLS_ASSERT(logFileName);
+    BSLS_ASSERT(timestampUtc);
+    BSLS_ASSERT(logFilePattern);
+
+    *timestampUtc = bdlt::CurrentTime::utc();
+
+    bdlt::Datetime logFileTimestamp = *timestampUtc;
+
+    if (publishInLocalTime) {
+        logFileTimestamp += localTimeOffsetInterval(*timestampUtc);
+    }
+
+    bsl::ostringstream os;
+
+    for (; *logFilePattern; ++logFilePattern) {
+        if ('%' == *logFilePattern) {
+            if (*++logFilePattern) {
+                switch (*logFilePattern) {
+                  case 'T': {
+                    os << getTimestampSuffix(logFileTimestamp);
+                  } break;
+                  case 'Y': {
+                    os << bsl::setw(4) << bsl::setfill('0')
+                       << logFileTimestamp.year();
+                  } break;
+                  case 'M': {
+                    os << bsl::setw(2) << bsl::setfill('0')
+                       << logFileTimestamp.month();
+                  } break;
+                  case 'D': {
+                    os << bsl::setw(2) << bsl::setfill('0')
+                       << logFileTimestamp.day();
+                  } break;
+                  case 'h': {
+                    os << bsl::setw(2) << bsl::setfill('0')
+                       << logFileTimestamp.hour();
+                  } break;
+                  case 'm': {
+                    os << bsl::setw(2) << bsl::setfill('0')
+                       << logFileTimestamp.minute();
+                  } break;
+                  case 's': {
+                    os << bsl::setw(2) << bsl::setfill('0')
+                       << logFileTimestamp.second();
+                  } break;
+                  case 'p': {
+                    os << bdls::ProcessUtil::getProcessId();
+                  } break;
+                  case '%': {
+                  } break;
+                  default: {
+                    os << '%' << *logFilePattern;
+                  } break;
+                }
+            }
+            else {
+                os << '%';  // trailing '%' in pattern
+                break;
+            }
+        } else {
+            os << *logFilePattern;
+        }
+    }
+    *logFileName = os.str();
+}
+
+void LogFileUtil::loadRotatedLogFileName(
+                                   bsl::string           *rotatedLogFileName,
+                                   const bsl::string&     logFileName,
+                                   const bdlt::Datetime&  logFileTimestampUtc,
+                                   bool                   publishInLocalTime)
+{
+    BSLS_ASSERT(rotatedLogFileName);
+
+    bdlt::Datetime timestamp(logFileTimestampUtc);
+
+    if (publishInLocalTime) {
+        timestamp += localTimeOffsetInterval(logFileTimestampUtc);
+    }
+
+    rotatedLogFileName->assign(logFileName);
+    *rotatedLogFileName += '.';
+    *rotatedLogFileName += getTimestampSuffix(timestamp);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#if defined(BSLS_PLATFORM_CMP_MSVC)
+#undef snprintf
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,171 @@
+// ball_logfileutil.h                                                 -*-C++-*-
+#ifndef INCLUDED_BALL_LOGFILEUTIL
+#define INCLUDED_BALL_LOGFILEUTIL
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide utilities for naming and scheduling rotation of log files.
+//
+//@CLASSES:
+//  ball::LogFileUtil: namespace for log filename and rotation utilities
+//
+//@SEE_ALSO: ball_fileobserver2, ball_mappedfileobserver,
+//           ball_logfilecleanerutil
+//
+//@DESCRIPTION: This component provides a 'struct', 'ball::LogFileUtil', that
+// provides a namespace for utility functions shared by the 'ball' observers
+// that write log records to files and rotate them: deriving the name of a log
+// file from a log filename pattern, deriving the name to which a log file is
+// renamed upon rotation, and computing the time of the next scheduled
+// rotation of a log file.
+//
+///Log Filename Patterns
+///---------------------
+// Log filename patterns may contain the following '%'-escape sequences:
+//..
+//  %Y - current year   (4 digits with leading zeros)
+//  %M - current month  (2 digits with leading zeros)
+//  %D - current day    (2 digits with leading zeros)
+//  %h - current hour   (2 digits with leading zeros)
+//  %m - current minute (2 digits with leading zeros)
+//  %s - current second (2 digits with leading zeros)
+//  %T - current datetime, equivalent to "%Y%M%D_%h%m%s"
+//  %p - process ID
+//..
+// "%%" is replaced by nothing, and any other '%'-escape sequence is left
+// unchanged.  See {'ball_fileobserver2'} for details on how log filename
+// patterns are interpreted by file observers.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Naming and Rotating a Log File
+///- - - - - - - - - - - - - - - - - - - - -
+// Suppose that we are implementing an observer that writes log records to a
+// file whose name is derived from a pattern, and that rotates the file each
+// day at midnight (local time).
+//
+// First, we derive the name of the log file from the pattern, obtaining the
+// current time in the process:
+//..
+//  bsl::string    logFileName;
+//  bdlt::Datetime logFileTimestampUtc;
+//
+//  ball::LogFileUtil::loadLogFileName(&logFileName,
+//                                     &logFileTimestampUtc,
+//                                     "task.log.%Y%M%D",
+//                                     false);
+//
+//  assert(logFileName.length() == bsl::strlen("task.log.YYYYMMDD"));
+//..
+// Then, we compute the time at which the file is to be rotated:
+//..
+//  const bdlt::DatetimeInterval oneDay(1);
+//
+//  bdlt::Datetime nextRotationTimeUtc =
+//      ball::LogFileUtil::computeNextRotationTime(bdlt::Datetime(1, 1, 1),
+//                                                 oneDay,
+//                                                 logFileTimestampUtc);
+//
+//  assert(logFileTimestampUtc <  nextRotationTimeUtc);
+//  assert(nextRotationTimeUtc <= logFileTimestampUtc + oneDay);
+//..
+// Finally, when the file is rotated, if the name derived from the pattern is
+// unchanged, we compute the name to which the current file is to be renamed:
+//..
+//  bsl::string rotatedLogFileName;
+//  ball::LogFileUtil::loadRotatedLogFileName(&rotatedLogFileName,
+//                                            logFileName,
+//                                            logFileTimestampUtc,
+//                                            false);
+//
+//  assert(rotatedLogFileName.length() ==
+//                           bsl::strlen("task.log.YYYYMMDD.YYYYMMDD_hhmmss"));
+//..
+
+#include <balscm_version.h>
+
+#include <bdlt_datetime.h>
+#include <bdlt_datetimeinterval.h>
+
+#include <bsl_string.h>
+
+namespace BloombergLP {
+namespace ball {
+
+                            // ==================
+                            // struct LogFileUtil
+                            // ==================
+
+struct LogFileUtil {
+    // This 'struct' provides a namespace for utility functions that name log
+    // files and schedule their rotation.
+
+    // CLASS METHODS
+    static bdlt::Datetime computeNextRotationTime(
+                        const bdlt::Datetime&         referenceStartTimeLocal,
+                        const bdlt::DatetimeInterval& interval,
+                        const bdlt::Datetime&         fileCreationTimeUtc);
+        // Return the UTC time for the next scheduled file rotation after the
+        // specified 'fileCreationTimeUtc', for a schedule that has a start
+        // reference time indicated by the specified 'referenceStartTimeLocal'
+        // and rotated every specified 'interval'.  'referenceStartTimeLocal'
+        // must be a local time value, and 'fileCreationTimeUtc' must be a UTC
+        // time value.  The behavior is undefined unless
+        // '0 < interval.totalMilliseconds()'.  Note that
+        // 'referenceStartTimeLocal' is a local time value because the
+        // rotation schedules of file observers are configured in local time,
+        // and converting that value to UTC might cause an underflow.
+
+    static bool hasEscapePattern(const char *logFilePattern);
+        // Return 'true' if the specified 'logFilePattern' contains a
+        // recognized '%'-escape sequence, and 'false' otherwise.  The
+        // recognized escape sequences are "%Y", "%M", "%D", "%h", "%m", "%s",
+        // and "%%".
+
+    static void loadLogFileName(bsl::string    *logFileName,
+                                bdlt::Datetime *timestampUtc,
+                                const char     *logFilePattern,
+                                bool            publishInLocalTime);
+        // Load, into the specified 'logFileName', the filename that is
+        // obtained by replacing every '%'-escape sequence in the specified
+        // 'logFilePattern'.  If the specified 'publishInLocalTime' is 'true',
+        // replace the time patterns with local time values, and replace them
+        // with UTC time values otherwise.  Load the current time in UTC into
+        // the specified 'timestampUtc'.
+
+    static void loadRotatedLogFileName(
+                            bsl::string           *rotatedLogFileName,
+                            const bsl::string&     logFileName,
+                            const bdlt::Datetime&  logFileTimestampUtc,
+                            bool                   publishInLocalTime);
+        // Load, into the specified 'rotatedLogFileName', the name to which
+        // the log file having the specified 'logFileName', opened at the
+        // specified 'logFileTimestampUtc', is renamed upon rotation:
+        // 'logFileName' followed by '.' and the timestamp in the
+        // 'YYYYMMDD_hhmmss' format, in local time if the specified
+        // 'publishInLocalTime' is 'true', and in UTC time otherwise.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,711 @@
+// ball_logfileutil.t.cpp                                             -*-C++-*-
+#include <ball_logfileutil.h>
+
+#include <bdls_processutil.h>
+
+#include <bdlt_currenttime.h>
+#include <bdlt_datetime.h>
+#include <bdlt_datetimeinterval.h>
+#include <bdlt_intervalconversionutil.h>
+#include <bdlt_localtimeoffset.h>
+
+#include <bslim_testutil.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>     // 'atoi'
+#include <bsl_cstring.h>     // 'strlen'
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                             TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is a utility whose functions were factored out of
+// 'ball::FileObserver2', so that they can be shared by the 'ball' observers
+// that write to, and rotate, log files.  The functions are tested with
+// tables of patterns and times, computing the expected values independently
+// of the component.
+//-----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 5] Datetime computeNextRotationTime(const Datetime&, interval, ...);
+// [ 2] bool hasEscapePattern(const char *logFilePattern);
+// [ 3] void loadLogFileName(string *, Datetime *, const char *, bool);
+// [ 4] void loadRotatedLogFileName(string *, const string&, ...);
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] USAGE EXAMPLE
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef ball::LogFileUtil Obj;
+
+// ============================================================================
+//                  GLOBAL HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+
+bdlt::DatetimeInterval localOffset(const bdlt::Datetime& timeUtc)
+    // Return the offset of local time from UTC time at the specified
+    // 'timeUtc'.
+{
+    return bdlt::IntervalConversionUtil::convertToDatetimeInterval(
+                              bdlt::LocalTimeOffset::localTimeOffset(timeUtc));
+}
+
+bsl::string expandPattern(const char            *pattern,
+                          const bdlt::Datetime&  timestamp)
+    // Return the specified 'pattern' with the time and process id escape
+    // sequences replaced using the specified 'timestamp'.  Note that this is
+    // an independent (and deliberately simplistic) oracle for
+    // 'loadLogFileName'.
+{
+    bsl::string result;
+    char        buffer[32];
+
+    for (; *pattern; ++pattern) {
+        if ('%' != *pattern) {
+            result += *pattern;
+            continue;
+        }
+
+        ++pattern;
+        buffer[0] = '\0';
+
+        switch (*pattern) {
+          case '\0': {
+            result += '%';
+            return result;                                            // RETURN
+          }
+          case 'Y': {
+            sprintf(buffer, "%04d", timestamp.year());
+          } break;
+          case 'M': {
+            sprintf(buffer, "%02d", timestamp.month());
+          } break;
+          case 'D': {
+            sprintf(buffer, "%02d", timestamp.day());
+          } break;
+          case 'h': {
+            sprintf(buffer, "%02d", timestamp.hour());
+          } break;
+          case 'm': {
+            sprintf(buffer, "%02d", timestamp.minute());
+          } break;
+          case 's': {
+            sprintf(buffer, "%02d", timestamp.second());
+          } break;
+          case 'T': {
+            sprintf(buffer,
+                    "%04d%02d%02d_%02d%02d%02d",
+                    timestamp.year(),
+                    timestamp.month(),
+                    timestamp.day(),
+                    timestamp.hour(),
+                    timestamp.minute(),
+                    timestamp.second());
+          } break;
+          case 'p': {
+            sprintf(buffer, "%d", bdls::ProcessUtil::getProcessId());
+          } break;
+          case '%': {
+          } break;
+          default: {
+            buffer[0] = '%';
+            buffer[1] = *pattern;
+            buffer[2] = '\0';
+          } break;
+        }
+        result += buffer;
+    }
+    return result;
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const int  test        = argc > 1 ? atoi(argv[1]) : 0;
+    const bool verbose     = argc > 2;
+    const bool veryVerbose = argc > 3;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nUSAGE EXAMPLE"
+                          << "\n=============" << endl;
+
+///Example 1: Naming and Rotating a Log File
+///- - - - - - - - - - - - - - - - - - - - -
+// Suppose that we are implementing an observer that writes log records to a
+// file whose name is derived from a pattern, and that rotates the file each
+// day at midnight (local time).
+//
+// First, we derive the name of the log file from the pattern, obtaining the
+// current time in the process:
+//..
+    bsl::string    logFileName;
+    bdlt::Datetime logFileTimestampUtc;
+
+    ball::LogFileUtil::loadLogFileName(&logFileName,
+                                       &logFileTimestampUtc,
+                                       "task.log.%Y%M%D",
+                                       false);
+
+    ASSERT(logFileName.length() == bsl::strlen("task.log.YYYYMMDD"));
+//..
+// Then, we compute the time at which the file is to be rotated:
+//..
+    const bdlt::DatetimeInterval oneDay(1);
+
+    bdlt::Datetime nextRotationTimeUtc =
+        ball::LogFileUtil::computeNextRotationTime(bdlt::Datetime(1, 1, 1),
+                                                   oneDay,
+                                                   logFileTimestampUtc);
+
+    ASSERT(logFileTimestampUtc <  nextRotationTimeUtc);
+    ASSERT(nextRotationTimeUtc <= logFileTimestampUtc + oneDay);
+//..
+// Finally, when the file is rotated, if the name derived from the pattern is
+// unchanged, we compute the name to which the current file is to be renamed:
+//..
+    bsl::string rotatedLogFileName;
+    ball::LogFileUtil::loadRotatedLogFileName(&rotatedLogFileName,
+                                              logFileName,
+                                              logFileTimestampUtc,
+                                              false);
+
+    ASSERT(rotatedLogFileName.length() ==
+                             bsl::strlen("task.log.YYYYMMDD.YYYYMMDD_hhmmss"));
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING 'computeNextRotationTime'
+        //
+        // Concerns:
+        //: 1 The next rotation time is the first time after the file creation
+        //:   time that is a whole number of intervals away from the reference
+        //:   start time, which is interpreted as a local time.
+        //:
+        //: 2 A reference start time that is (within 10% of the interval) equal
+        //:   to the file creation time schedules the rotation one full
+        //:   interval after the file creation time.
+        //:
+        //: 3 Reference start times both before and after the file creation
+        //:   time are supported.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Using a table of intervals and offsets of the reference start
+        //:   time from the (local) file creation time, verify the computed
+        //:   next rotation time.  (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for a non-positive interval.  (C-4)
+        //
+        // Testing:
+        //   Datetime computeNextRotationTime(const Datetime&, interval, ...);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING 'computeNextRotationTime'"
+                          << "\n=================================" << endl;
+
+        const bdlt::Datetime CREATION_UTC(2020, 6, 15, 12, 30, 0);
+        const bdlt::Datetime CREATION_LOCAL = CREATION_UTC +
+                                              localOffset(CREATION_UTC);
+
+        static const struct {
+            int                d_line;
+            bsls::Types::Int64 d_intervalSec;   // rotation interval
+            bsls::Types::Int64 d_referenceSec;  // reference - creation
+            bsls::Types::Int64 d_expectedSec;   // next rotation - creation
+        } DATA[] = {
+            //LINE  INTERVAL    REFERENCE   EXPECTED
+            //----  --------    ---------   --------
+            { L_,       3600,           0,      3600 },
+            { L_,       3600,         100,      3600 },  // fuzzy equal
+            { L_,       3600,        -100,      3600 },  // fuzzy equal
+            { L_,       3600,        1800,      1800 },
+            { L_,       3600,       -1800,      1800 },
+            { L_,       3600,       -3000,       600 },
+            { L_,       3600,  -10 * 3600 - 600,  3000 },
+            { L_,       3600,   10 * 3600 + 600,   600 },
+            { L_,      86400,      -43200,     43200 },
+            { L_,      86400,   -86400 * 365 - 3600,  82800 },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int                LINE = DATA[ti].d_line;
+            const bsls::Types::Int64 INTV = DATA[ti].d_intervalSec;
+            const bsls::Types::Int64 REF  = DATA[ti].d_referenceSec;
+            const bsls::Types::Int64 EXP  = DATA[ti].d_expectedSec;
+
+            bdlt::Datetime reference = CREATION_LOCAL;
+            reference.addSeconds(REF);
+
+            bdlt::Datetime expected = CREATION_UTC;
+            expected.addSeconds(EXP);
+
+            const bdlt::DatetimeInterval interval(0, 0, 0, INTV);
+
+            const bdlt::Datetime result =
+                    Obj::computeNextRotationTime(reference,
+                                                 interval,
+                                                 CREATION_UTC);
+
+            if (veryVerbose) {
+                T_ P_(LINE) P_(reference) P_(expected) P(result)
+            }
+
+            ASSERTV(LINE, expected, result, expected == result);
+        }
+
+        if (verbose) cout << "\tA distant reference time." << endl;
+        {
+            const bdlt::Datetime result = Obj::computeNextRotationTime(
+                                               bdlt::Datetime(1, 1, 1),
+                                               bdlt::DatetimeInterval(1),
+                                               CREATION_UTC);
+
+            ASSERTV(result, CREATION_UTC < result);
+            ASSERTV(result,
+                    result <= CREATION_UTC + bdlt::DatetimeInterval(1));
+
+            const bdlt::Datetime resultLocal = result + localOffset(result);
+
+            ASSERTV(resultLocal, 0 == resultLocal.hour());
+            ASSERTV(resultLocal, 0 == resultLocal.minute());
+        }
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_SAFE_PASS(Obj::computeNextRotationTime(
+                                         CREATION_LOCAL,
+                                         bdlt::DatetimeInterval(0, 0, 0, 0, 1),
+                                         CREATION_UTC));
+            ASSERT_SAFE_FAIL(Obj::computeNextRotationTime(
+                                         CREATION_LOCAL,
+                                         bdlt::DatetimeInterval(),
+                                         CREATION_UTC));
+            ASSERT_SAFE_FAIL(Obj::computeNextRotationTime(
+                                         CREATION_LOCAL,
+                                         bdlt::DatetimeInterval(-1),
+                                         CREATION_UTC));
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING 'loadRotatedLogFileName'
+        //
+        // Concerns:
+        //: 1 The rotated name is the log filename followed by '.' and the
+        //:   'YYYYMMDD_hhmmss' timestamp of the log file.
+        //:
+        //: 2 The timestamp is expressed in local time if, and only if,
+        //:   'publishInLocalTime' is 'true'.
+        //:
+        //: 3 The previous value of the output string is replaced.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Compute the rotated name of files for several timestamps, with
+        //:   and without local time, and compare against expected values.
+        //:   (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for a null output argument.  (C-4)
+        //
+        // Testing:
+        //   void loadRotatedLogFileName(string *, const string&, ...);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING 'loadRotatedLogFileName'"
+                          << "\n================================" << endl;
+
+        static const struct {
+            int         d_line;
+            const char *d_name_p;
+            int         d_year;
+            int         d_month;
+            int         d_day;
+            int         d_hour;
+            int         d_minute;
+            int         d_second;
+            const char *d_expected_p;
+        } DATA[] = {
+            //LINE NAME     YR   MO  DY  HR  MI  SE  EXPECTED
+            //---- -------  ---- --  --  --  --  --  -----------------------
+            { L_,  "a.log", 2020, 1,  2,  3,  4,  5, "a.log.20200102_030405" },
+            { L_,  "",      1999,12, 31, 23, 59, 59, ".19991231_235959"      },
+            { L_,  "x/y",      1, 1,  1,  0,  0,  0, "x/y.00010101_000000"   },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int            LINE = DATA[ti].d_line;
+            const bsl::string    NAME(DATA[ti].d_name_p);
+            const bdlt::Datetime TIMESTAMP(DATA[ti].d_year,
+                                           DATA[ti].d_month,
+                                           DATA[ti].d_day,
+                                           DATA[ti].d_hour,
+                                           DATA[ti].d_minute,
+                                           DATA[ti].d_second);
+            const char          *EXPECTED = DATA[ti].d_expected_p;
+
+            bsl::string result("garbage");
+            Obj::loadRotatedLogFileName(&result, NAME, TIMESTAMP, false);
+
+            if (veryVerbose) { T_ P_(LINE) P(result) }
+
+            ASSERTV(LINE, result, EXPECTED == result);
+        }
+
+        if (verbose) cout << "\tPublishing in local time." << endl;
+        {
+            const bdlt::Datetime TIMESTAMP(2020, 6, 15, 12, 30, 45);
+            const bdlt::Datetime LOCAL = TIMESTAMP + localOffset(TIMESTAMP);
+
+            bsl::string result;
+            Obj::loadRotatedLogFileName(&result, "a.log", TIMESTAMP, true);
+
+            ASSERTV(result, expandPattern("a.log.%T", LOCAL) == result);
+        }
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            const bdlt::Datetime TIMESTAMP(2020, 6, 15);
+            bsl::string          result;
+
+            ASSERT_SAFE_PASS(Obj::loadRotatedLogFileName(&result,
+                                                         "a",
+                                                         TIMESTAMP,
+                                                         false));
+            ASSERT_SAFE_FAIL(Obj::loadRotatedLogFileName(0,
+                                                         "a",
+                                                         TIMESTAMP,
+                                                         false));
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'loadLogFileName'
+        //
+        // Concerns:
+        //: 1 Every recognized '%'-escape sequence is replaced by the
+        //:   corresponding field of the returned timestamp (or by the process
+        //:   id for "%p"), "%%" is replaced by nothing, and unrecognized
+        //:   escape sequences are left unchanged.
+        //:
+        //: 2 The loaded timestamp is the current UTC time.
+        //:
+        //: 3 The time fields are expressed in local time if, and only if,
+        //:   'publishInLocalTime' is 'true'.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Using a table of patterns, load the filename and compare it with
+        //:   the pattern expanded independently using the loaded timestamp.
+        //:   Repeat when publishing in local time.  (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for null arguments.  (C-4)
+        //
+        // Testing:
+        //   void loadLogFileName(string *, Datetime *, const char *, bool);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING 'loadLogFileName'"
+                          << "\n=========================" << endl;
+
+        static const struct {
+            int         d_line;
+            const char *d_pattern_p;
+        } DATA[] = {
+            //LINE  PATTERN
+            //----  ------------------------
+            { L_,   ""                       },
+            { L_,   "a.log"                  },
+            { L_,   "a.log.%Y%M%D"           },
+            { L_,   "%h:%m:%s"               },
+            { L_,   "a.%T.log"               },
+            { L_,   "a.%p"                   },
+            { L_,   "100%%"                  },
+            { L_,   "a.%x.%Q"                },
+            { L_,   "trailing%"              },
+            { L_,   "%Y-%M-%D_%h-%m-%s.%p.%%" },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int   LINE    = DATA[ti].d_line;
+            const char *PATTERN = DATA[ti].d_pattern_p;
+
+            for (int local = 0; local < 2; ++local) {
+                const bdlt::Datetime before = bdlt::CurrentTime::utc();
+
+                bsl::string    result("garbage");
+                bdlt::Datetime timestampUtc;
+                Obj::loadLogFileName(&result,
+                                     &timestampUtc,
+                                     PATTERN,
+                                     0 != local);
+
+                const bdlt::Datetime after = bdlt::CurrentTime::utc();
+
+                if (veryVerbose) { T_ P_(LINE) P_(local) P(result) }
+
+                ASSERTV(LINE, before <= timestampUtc);
+                ASSERTV(LINE, timestampUtc <= after);
+
+                const bdlt::Datetime timestamp = local
+                                   ? timestampUtc + localOffset(timestampUtc)
+                                   : timestampUtc;
+
+                ASSERTV(LINE,
+                        local,
+                        result,
+                        expandPattern(PATTERN, timestamp) == result);
+            }
+        }
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            bsl::string    result;
+            bdlt::Datetime timestamp;
+
+            bsl::string    *S = &result;
+            bdlt::Datetime *D = &timestamp;
+
+            ASSERT_SAFE_PASS(Obj::loadLogFileName(S, D, "a", false));
+            ASSERT_SAFE_FAIL(Obj::loadLogFileName(0, D, "a", false));
+            ASSERT_SAFE_FAIL(Obj::loadLogFileName(S, 0, "a", false));
+            ASSERT_SAFE_FAIL(Obj::loadLogFileName(S, D, 0,   false));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING 'hasEscapePattern'
+        //
+        // Concerns:
+        //: 1 The method returns 'true' if, and only if, the pattern contains
+        //:   one of "%Y", "%M", "%D", "%h", "%m", "%s", or "%%".
+        //:
+        //: 2 A trailing '%' is not an escape sequence.
+        //:
+        //: 3 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Using a table of patterns, verify the returned value.  (C-1..2)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for a null pattern.  (C-3)
+        //
+        // Testing:
+        //   bool hasEscapePattern(const char *logFilePattern);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING 'hasEscapePattern'"
+                          << "\n==========================" << endl;
+
+        static const struct {
+            int         d_line;
+            const char *d_pattern_p;
+            bool        d_expected;
+        } DATA[] = {
+            //LINE  PATTERN         EXPECTED
+            //----  -------------   --------
+            { L_,   "",             false    },
+            { L_,   "a.log",        false    },
+            { L_,   "%",            false    },
+            { L_,   "a.log%",       false    },
+            { L_,   "%x",           false    },
+            { L_,   "%T",           false    },
+            { L_,   "%p",           false    },
+            { L_,   "%Y",           true     },
+            { L_,   "%M",           true     },
+            { L_,   "%D",           true     },
+            { L_,   "%h",           true     },
+            { L_,   "%m",           true     },
+            { L_,   "%s",           true     },
+            { L_,   "%%",           true     },
+            { L_,   "a.%p.%Y",      true     },
+            { L_,   "a.log.%D%",    true     },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int   LINE     = DATA[ti].d_line;
+            const char *PATTERN  = DATA[ti].d_pattern_p;
+            const bool  EXPECTED = DATA[ti].d_expected;
+
+            if (veryVerbose) { T_ P_(LINE) P_(PATTERN) P(EXPECTED) }
+
+            ASSERTV(LINE, PATTERN, EXPECTED == Obj::hasEscapePattern(PATTERN));
+        }
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_SAFE_PASS(Obj::hasEscapePattern("a"));
+            ASSERT_SAFE_FAIL(Obj::hasEscapePattern(0));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Invoke each method with arbitrary inputs and verify the behavior
+        //:   is as expected.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nBREATHING TEST"
+                          << "\n==============" << endl;
+
+        ASSERT( Obj::hasEscapePattern("a.%Y"));
+        ASSERT(!Obj::hasEscapePattern("a.log"));
+
+        bsl::string    name;
+        bdlt::Datetime timestamp;
+
+        Obj::loadLogFileName(&name, &timestamp, "a.log", false);
+        ASSERTV(name, "a.log" == name);
+
+        Obj::loadRotatedLogFileName(&name,
+                                    "a.log",
+                                    bdlt::Datetime(2020, 2, 29, 1, 2, 3),
+                                    false);
+        ASSERTV(name, "a.log.20200229_010203" == name);
+
+        const bdlt::Datetime next = Obj::computeNextRotationTime(
+                                                  timestamp + localOffset(
+                                                                   timestamp),
+                                                  bdlt::DatetimeInterval(0, 1),
+                                                  timestamp);
+        ASSERTV(next, timestamp + bdlt::DatetimeInterval(0, 1) == next);
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1057 @@
+// ball_mappedfileobserver.cpp                                        -*-C++-*-
+#include <ball_mappedfileobserver.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ball_mappedfileobserver_cpp,"$Id$ $CSID$")
+
+///Implementation Notes
+///--------------------
+// A thread publishing a record registers itself as a writer of the current
+// segment by incrementing 'd_numWriters' of the segment and then verifying
+// that the segment is still current.  A thread retiring a segment (while
+// holding 'd_mutex') first stores a different segment (or 0) into
+// 'd_current', and then waits for 'd_numWriters' of the retired segment to
+// drop to 0.  Because both sides use sequentially consistent operations,
+// either the publishing thread observes the change of 'd_current' (and
+// unregisters without touching the mapping), or the retiring thread observes
+// the registration (and waits for the publishing thread to finish).
+//
+// The two elements of 'd_segments' are used in turn, and are never freed, so
+// that a thread that loaded the address of a segment that has since been
+// retired (and possibly reused) can safely register itself and check it.
+//
+// Reservations in a segment are contiguous, so exactly one reservation,
+// '[offset, offset + length)', satisfies 'offset <= d_size' and
+// 'd_size < offset + length'.  The thread that made that reservation records
+// 'offset' in 'd_end', and maps the next segment at that offset in the file;
+// the bytes of the segment beyond 'd_end' are thus never part of the log.
+// Because a slot may be retired and mapped again between the reservation and
+// the acquisition of 'd_mutex' by that thread, 'advanceSegment' proceeds only
+// if 'd_end' of the current segment still designates the reserved position,
+// and 'waitForSegmentChange' waits only while the current segment is full.
+
+#include <ball_logfileutil.h>
+#include <ball_record.h>
+#include <ball_recordattributes.h>
+
+#include <bdls_memoryutil.h>
+
+#include <bdlsb_memoutstreambuf.h>
+
+#include <bdlt_currenttime.h>
+
+#include <bslma_default.h>
+
+#include <bslmt_lockguard.h>
+#include <bslmt_once.h>
+#include <bslmt_threadlocalvariable.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_assert.h>
+#include <bsls_log.h>
+#include <bsls_platform.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstdio.h>
+#include <bsl_cstring.h>
+#include <bsl_limits.h>
+#include <bsl_ostream.h>
+
+#include <bsl_c_errno.h>
+#include <bsl_c_stdio.h>   // for 'snprintf'
+
+#ifdef BSLS_PLATFORM_OS_UNIX
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#endif
+
+#if defined(BSLS_PLATFORM_CMP_MSVC)
+#define snprintf _snprintf
+#endif
+
+namespace BloombergLP {
+namespace ball {
+
+namespace {
+
+typedef bdls::FilesystemUtil FileUtil;
+
+enum {
+    // status code for the call back function.
+
+    k_ROTATE_SUCCESS                  =  0,
+    k_ROTATE_RENAME_ERROR             = -1,
+    k_ROTATE_NEW_LOG_ERROR            = -2,
+    k_ROTATE_RENAME_AND_NEW_LOG_ERROR = -3
+};
+
+enum {
+    k_MAX_RETAINED_CAPACITY = 64 * 1024  // capacity (in bytes) beyond which
+                                         // the buffer of a 'FormatBuffer' is
+                                         // released when it is reused
+};
+
+static const char k_DEFAULT_FORMAT[] = "\n%d %p:%t %s %f:%l %c %m %u\n";
+
+static int getErrorCode(void)
+    // Return the system-specific error code.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    int rc = GetLastError();
+    return rc ? rc : errno;
+#else
+    return errno;
+#endif
+}
+
+static void logError(bsls::LogSeverity::Enum  severity,
+                     int                      line,
+                     const char              *format,
+                     const char              *fileName)
+    // Report the message obtained by formatting the specified 'fileName' and
+    // the description of the current system error according to the specified
+    // 'format', having the specified 'severity', from the specified 'line' of
+    // this file.
+{
+    char errorBuffer[256];
+
+    snprintf(errorBuffer,
+             sizeof errorBuffer,
+             format,
+             fileName,
+             bsl::strerror(getErrorCode()));
+    bsls::Log::platformDefaultMessageHandler(severity,
+                                             __FILE__,
+                                             line,
+                                             errorBuffer);
+}
+
+static bsls::Types::Int64 mappingAlignment()
+    // Return the alignment, in bytes, of the offsets in a file at which the
+    // file can be mapped into memory.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+#else
+    return bdls::MemoryUtil::pageSize();
+#endif
+}
+
+static bsls::Types::Int64 toMicroseconds(const bdlt::Datetime& datetime)
+    // Return the number of microseconds from 0001/01/01_00:00:00 to the
+    // specified 'datetime'.
+{
+    return (datetime - bdlt::Datetime(1, 1, 1)).totalMicroseconds();
+}
+
+static int truncateFile(FileUtil::FileDescriptor descriptor,
+                        bsls::Types::Int64       size)
+    // Set the size of the file with the specified 'descriptor' to the
+    // specified 'size'.  Return 0 on success, and a non-zero value otherwise.
+{
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+    if (size != FileUtil::seek(descriptor,
+                               size,
+                               FileUtil::e_SEEK_FROM_BEGINNING)) {
+        return -1;                                                    // RETURN
+    }
+    return SetEndOfFile(descriptor) ? 0 : -1;
+#else
+    return ::ftruncate(descriptor, static_cast<off_t>(size));
+#endif
+}
+
+static void waitForWriters(const MappedFileObserver_Segment *segment)
+    // Wait until no thread is registered as a writer of the specified
+    // 'segment'.
+{
+    while (0 != segment->d_numWriters.load()) {
+        bslmt::ThreadUtil::yield();
+    }
+}
+
+                            // ==================
+                            // class FormatBuffer
+                            // ==================
+
+class FormatBuffer {
+    // This class provides a stream, and the buffer it writes to, into which
+    // records are formatted before being copied to a mapped segment.  One
+    // object of this class is kept in thread-specific storage for each thread
+    // that publishes records, and is reused for all the records formatted by
+    // that thread, as the construction of a stream is costly.
+
+    // DATA
+    bdlsb::MemOutStreamBuf d_streamBuf;  // buffer holding a formatted record
+    bsl::ostream           d_stream;     // stream writing to 'd_streamBuf'
+    bool                   d_isInUse;    // 'true' while a record is formatted
+
+  private:
+    // NOT IMPLEMENTED
+    FormatBuffer(const FormatBuffer&);
+    FormatBuffer& operator=(const FormatBuffer&);
+
+  public:
+    // CREATORS
+    explicit FormatBuffer(bslma::Allocator *basicAllocator)
+        // Create an empty format buffer using the specified 'basicAllocator'
+        // to supply memory.
+    : d_streamBuf(basicAllocator)
+    , d_stream(&d_streamBuf)
+    , d_isInUse(false)
+    {
+    }
+
+    // MANIPULATORS
+    bool& isInUse()
+        // Return a reference providing modifiable access to the flag
+        // indicating whether this buffer is in use.
+    {
+        return d_isInUse;
+    }
+
+    bsl::ostream& stream()
+        // Empty this buffer and return a reference providing modifiable
+        // access to the stream writing to it.
+    {
+        if (k_MAX_RETAINED_CAPACITY < d_streamBuf.capacity()) {
+            d_streamBuf.reset();
+        }
+        d_streamBuf.pubseekpos(0);
+        d_stream.clear();
+        return d_stream;
+    }
+
+    // ACCESSORS
+    const char *data() const
+        // Return the address of the formatted record.
+    {
+        return d_streamBuf.data();
+    }
+
+    bsl::size_t length() const
+        // Return the length of the formatted record.
+    {
+        return d_streamBuf.length();
+    }
+};
+
+// On supported platforms, define a thread-local variable to serve as the cache
+// for 'bslmt::ThreadUtil::getSpecific'.  Note that the memory is managed by
+// 'bslmt::ThreadUtil' thread-specific storage.
+
+#ifdef BSLMT_THREAD_LOCAL_VARIABLE
+BSLMT_THREAD_LOCAL_VARIABLE(FormatBuffer *, g_threadLocalFormatBuffer, 0);
+#endif
+
+extern "C" void deleteFormatBuffer(void *arg)
+    // Destroy the 'FormatBuffer' object at the specified 'arg', which was
+    // allocated from the global allocator.
+{
+#ifdef BSLMT_THREAD_LOCAL_VARIABLE
+    g_threadLocalFormatBuffer = 0;
+#endif
+
+    bslma::Default::globalAllocator()->deleteObject(
+                                           static_cast<FormatBuffer *>(arg));
+}
+
+static const bslmt::ThreadUtil::Key& formatBufferKey()
+    // Return a reference providing non-modifiable access to the key of the
+    // thread-specific storage holding the format buffer of each thread.
+{
+    static bslmt::ThreadUtil::Key s_formatBufferKey;
+    BSLMT_ONCE_DO {
+        bslmt::ThreadUtil::createKey(&s_formatBufferKey,
+                                     &deleteFormatBuffer);
+    }
+    return s_formatBufferKey;
+}
+
+static FormatBuffer *lookupFormatBuffer()
+    // Return the address of the format buffer of the calling thread, creating
+    // it if necessary, or 0 if it cannot be stored in thread-specific storage.
+{
+#ifdef BSLMT_THREAD_LOCAL_VARIABLE
+    if (g_threadLocalFormatBuffer) {
+        return g_threadLocalFormatBuffer;                             // RETURN
+    }
+#endif
+
+    const bslmt::ThreadUtil::Key& key = formatBufferKey();
+
+    FormatBuffer *buffer = static_cast<FormatBuffer *>(
+                                         bslmt::ThreadUtil::getSpecific(key));
+
+    if (!buffer) {
+        bslma::Allocator *allocator = bslma::Default::globalAllocator();
+
+        buffer = new (*allocator) FormatBuffer(allocator);
+
+        if (0 != bslmt::ThreadUtil::setSpecific(key, buffer)) {
+            allocator->deleteObject(buffer);
+            return 0;                                                 // RETURN
+        }
+    }
+
+#ifdef BSLMT_THREAD_LOCAL_VARIABLE
+    g_threadLocalFormatBuffer = buffer;
+#endif
+
+    return buffer;
+}
+
+                         // ========================
+                         // class FormatBufferHolder
+                         // ========================
+
+class FormatBufferHolder {
+    // This class implements a proctor that provides a format buffer for the
+    // formatting of one record: the format buffer of the calling thread, or,
+    // if that buffer is already in use (i.e., a record is published while
+    // another one is formatted by the same thread) or is unavailable, a
+    // format buffer owned by the proctor.
+
+    // DATA
+    FormatBuffer     *d_buffer_p;     // format buffer (held)
+    bslma::Allocator *d_allocator_p;  // allocator of 'd_buffer_p' if owned,
+                                      // and 0 otherwise
+
+  private:
+    // NOT IMPLEMENTED
+    FormatBufferHolder(const FormatBufferHolder&);
+    FormatBufferHolder& operator=(const FormatBufferHolder&);
+
+  public:
+    // CREATORS
+    explicit FormatBufferHolder(bslma::Allocator *basicAllocator)
+        // Create a proctor providing a format buffer, using the specified
+        // 'basicAllocator' to supply memory if a buffer owned by the proctor
+        // is needed.
+    : d_buffer_p(lookupFormatBuffer())
+    , d_allocator_p(0)
+    {
+        if (d_buffer_p && !d_buffer_p->isInUse()) {
+            d_buffer_p->isInUse() = true;
+        }
+        else {
+            d_buffer_p    = new (*basicAllocator) FormatBuffer(basicAllocator);
+            d_allocator_p = basicAllocator;
+        }
+    }
+
+    ~FormatBufferHolder()
+        // Release the format buffer provided by this proctor.
+    {
+        if (d_allocator_p) {
+            d_allocator_p->deleteObject(d_buffer_p);
+        }
+        else {
+            d_buffer_p->isInUse() = false;
+        }
+    }
+
+    // MANIPULATORS
+    FormatBuffer *operator->()
+        // Return the address of the format buffer provided by this proctor.
+    {
+        return d_buffer_p;
+    }
+};
+
+}  // close unnamed namespace
+
+                          // ------------------------
+                          // class MappedFileObserver
+                          // ------------------------
+
+// PRIVATE MANIPULATORS
+MappedFileObserver::Segment *MappedFileObserver::acquireSegment()
+{
+    for (;;) {
+        Segment *segment = d_current.load();
+
+        if (0 == segment) {
+            return 0;                                                 // RETURN
+        }
+
+        segment->d_numWriters.add(1);
+
+        if (segment == d_current.load()) {
+            return segment;                                           // RETURN
+        }
+
+        segment->d_numWriters.add(-1);
+    }
+}
+
+void MappedFileObserver::advanceSegment(bsl::string        *rotatedLogFileName,
+                                        int                *rotationStatus,
+                                        Segment            *segment,
+                                        bsls::Types::Int64  position,
+                                        bsls::Types::Int64  length)
+{
+    BSLS_ASSERT(rotatedLogFileName);
+    BSLS_ASSERT(rotationStatus);
+    BSLS_ASSERT(segment);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (segment != d_current.load()
+     || 0 > segment->d_end.load()
+     || position != segment->d_fileOffset + segment->d_end.load()) {
+        return;                                                       // RETURN
+    }
+    const bsls::Types::Int64 rotationSize =
+                 static_cast<bsls::Types::Int64>(d_rotationSize.load()) * 1024;
+
+    if (0 < rotationSize && rotationSize < position) {
+        *rotationStatus = rotateFile(rotatedLogFileName);
+        return;                                                       // RETURN
+    }
+
+    Segment *next = segment == d_segments ? d_segments + 1 : d_segments;
+
+    if (0 != mapSegment(next, position, length)) {
+        logError(bsls::LogSeverity::e_ERROR,
+                 __LINE__,
+                 "Cannot map log file %s: %s. "
+                 "File logging will be disabled!",
+                 d_logFileName.c_str());
+        closeFile();
+        return;                                                       // RETURN
+    }
+
+    d_current.store(next);
+    d_segmentChangedCondition.broadcast();
+
+    unmapSegment(segment);
+}
+
+void MappedFileObserver::closeFile()
+{
+    if (FileUtil::k_INVALID_FD == d_fd) {
+        return;                                                       // RETURN
+    }
+
+    Segment *segment = d_current.load();
+    BSLS_ASSERT(segment);
+
+    d_current.store(0);
+    d_segmentChangedCondition.broadcast();
+
+    const bsls::Types::Int64 size = unmapSegment(segment);
+
+    if (0 != truncateFile(d_fd, size)) {
+        logError(bsls::LogSeverity::e_WARN,
+                 __LINE__,
+                 "Cannot truncate log file %s: %s.",
+                 d_logFileName.c_str());
+    }
+
+    if (0 != FileUtil::close(d_fd)) {
+        logError(bsls::LogSeverity::e_WARN,
+                 __LINE__,
+                 "Unable to close old log file %s: %s.",
+                 d_logFileName.c_str());
+    }
+
+    d_fd = FileUtil::k_INVALID_FD;
+
+    updateNextRotationTime();
+}
+
+int MappedFileObserver::mapSegment(Segment            *segment,
+                                   bsls::Types::Int64  position,
+                                   bsls::Types::Int64  length)
+{
+    BSLS_ASSERT(segment);
+    BSLS_ASSERT(0 == segment->d_address_p);
+    BSLS_ASSERT(0 <= position);
+    BSLS_ASSERT(0 <= length);
+
+    const bsls::Types::Int64 alignment = mappingAlignment();
+    const bsls::Types::Int64 offset    = position / alignment * alignment;
+    const bsls::Types::Int64 start     = position - offset;
+
+    bsls::Types::Int64 size = bsl::max(d_segmentSize, start + length);
+    size = (size + alignment - 1) / alignment * alignment;
+
+    // Extend (and, where supported, preallocate) the file first: accessing a
+    // page of a mapping beyond the end of the file is an error.
+
+    if (0 != FileUtil::growFile(d_fd, offset + size, true)) {
+        return -1;                                                    // RETURN
+    }
+
+    void *address;
+    if (0 != FileUtil::map(d_fd,
+                           &address,
+                           offset,
+                           static_cast<bsl::size_t>(size),
+                           bdls::MemoryUtil::k_ACCESS_READ_WRITE)) {
+        return -2;                                                    // RETURN
+    }
+
+    segment->d_address_p  = static_cast<char *>(address);
+    segment->d_fileOffset = offset;
+    segment->d_size       = size;
+    segment->d_tail.store(start);
+    segment->d_end.store(-1);
+
+    return 0;
+}
+
+int MappedFileObserver::openFile()
+{
+    BSLS_ASSERT(FileUtil::k_INVALID_FD == d_fd);
+    BSLS_ASSERT(0 == d_current.load());
+
+    d_fd = FileUtil::open(d_logFileName,
+                          FileUtil::e_OPEN_OR_CREATE,
+                          FileUtil::e_READ_WRITE,
+                          FileUtil::e_KEEP);
+
+    if (FileUtil::k_INVALID_FD == d_fd) {
+        logError(bsls::LogSeverity::e_ERROR,
+                 __LINE__,
+                 "Cannot open log file %s: %s. "
+                 "File logging will be disabled!",
+                 d_logFileName.c_str());
+        return -1;                                                    // RETURN
+    }
+
+    const FileUtil::Offset size = FileUtil::seek(d_fd,
+                                                 0,
+                                                 FileUtil::e_SEEK_FROM_END);
+
+    if (0 > size || 0 != mapSegment(d_segments, size, 0)) {
+        logError(bsls::LogSeverity::e_ERROR,
+                 __LINE__,
+                 "Cannot map log file %s: %s. "
+                 "File logging will be disabled!",
+                 d_logFileName.c_str());
+
+        if (0 <= size) {
+            truncateFile(d_fd, size);
+        }
+        FileUtil::close(d_fd);
+        d_fd = FileUtil::k_INVALID_FD;
+        return -1;                                                    // RETURN
+    }
+
+    d_current.store(d_segments);
+    d_segmentChangedCondition.broadcast();
+
+    return 0;
+}
+
+int MappedFileObserver::rotateFile(bsl::string *rotatedLogFileName)
+{
+    BSLS_ASSERT(rotatedLogFileName);
+
+    if (FileUtil::k_INVALID_FD == d_fd) {
+        return 1;                                                     // RETURN
+    }
+
+    BSLS_ASSERT(d_logFilePattern.size() > 0);
+
+    int returnStatus = k_ROTATE_SUCCESS;
+
+    closeFile();
+
+    *rotatedLogFileName = d_logFileName;
+
+    const bdlt::Datetime oldLogFileTimestamp = d_logFileTimestampUtc;
+
+    LogFileUtil::loadLogFileName(&d_logFileName,
+                                 &d_logFileTimestampUtc,
+                                 d_logFilePattern.c_str(),
+                                 d_publishInLocalTime.load());
+
+    if (FileUtil::exists(d_logFileName.c_str())) {
+        bsl::string newFileName(d_allocator_p);
+        LogFileUtil::loadRotatedLogFileName(&newFileName,
+                                            d_logFileName,
+                                            oldLogFileTimestamp,
+                                            d_publishInLocalTime.load());
+
+        if (0 == bsl::rename(d_logFileName.c_str(), newFileName.c_str())) {
+            *rotatedLogFileName = newFileName;
+        }
+        else {
+            char errorBuffer[256];
+
+            snprintf(errorBuffer,
+                     sizeof errorBuffer,
+                     "Cannot rename %s to %s: %s.",
+                     d_logFileName.c_str(),
+                     newFileName.c_str(),
+                     bsl::strerror(getErrorCode()));
+            bsls::Log::platformDefaultMessageHandler(bsls::LogSeverity::e_WARN,
+                                                     __FILE__,
+                                                     __LINE__,
+                                                     errorBuffer);
+            returnStatus = k_ROTATE_RENAME_ERROR;
+        }
+    }
+
+    if (0 != openFile()) {
+        return k_ROTATE_SUCCESS != returnStatus
+               ? k_ROTATE_RENAME_AND_NEW_LOG_ERROR
+               : k_ROTATE_NEW_LOG_ERROR;                              // RETURN
+    }
+
+    updateNextRotationTime();
+
+    return returnStatus;
+}
+
+int MappedFileObserver::rotateIfNecessary(
+                                        bsl::string        *rotatedLogFileName,
+                                        bsls::Types::Int64  timestamp)
+{
+    BSLS_ASSERT(rotatedLogFileName);
+
+    const Segment *segment = d_current.load();
+
+    if (0 == segment) {
+        return 1;                                                     // RETURN
+    }
+
+    const bsls::Types::Int64 rotationSize =
+                 static_cast<bsls::Types::Int64>(d_rotationSize.load()) * 1024;
+
+    if (0 < rotationSize
+     && rotationSize < segment->d_fileOffset + segment->d_tail.load()) {
+        return rotateFile(rotatedLogFileName);                        // RETURN
+    }
+
+    if (d_nextRotationTimeUtc.load() <= timestamp) {
+        return rotateFile(rotatedLogFileName);                        // RETURN
+    }
+
+    return 1;
+}
+
+bsls::Types::Int64 MappedFileObserver::unmapSegment(Segment *segment)
+{
+    BSLS_ASSERT(segment);
+    BSLS_ASSERT(segment->d_address_p);
+    BSLS_ASSERT(segment != d_current.load());
+
+    waitForWriters(segment);
+
+    // If no reservation crossed the end of the segment, 'd_tail' is the end
+    // of its records.
+
+    const bsls::Types::Int64 end = 0 <= segment->d_end.load()
+                                   ? segment->d_end.load()
+                                   : segment->d_tail.load();
+
+    FileUtil::unmap(segment->d_address_p,
+                    static_cast<bsl::size_t>(segment->d_size));
+    segment->d_address_p = 0;
+
+    return segment->d_fileOffset + end;
+}
+
+void MappedFileObserver::updateNextRotationTime()
+{
+    if (FileUtil::k_INVALID_FD != d_fd
+     && 0 < d_rotationInterval.totalMilliseconds()) {
+        d_nextRotationTimeUtc.store(toMicroseconds(
+                         LogFileUtil::computeNextRotationTime(
+                                                  d_rotationReferenceLocalTime,
+                                                  d_rotationInterval,
+                                                  d_logFileTimestampUtc)));
+    }
+    else {
+        d_nextRotationTimeUtc.store(
+                              bsl::numeric_limits<bsls::Types::Int64>::max());
+    }
+}
+
+void MappedFileObserver::waitForSegmentChange(const Segment *segment)
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    while (segment == d_current.load()
+        && segment->d_size < segment->d_tail.load()) {
+        d_segmentChangedCondition.wait(&d_mutex);
+    }
+}
+
+// CREATORS
+MappedFileObserver::MappedFileObserver(bslma::Allocator *basicAllocator)
+: d_current(0)
+, d_segmentSize(static_cast<bsls::Types::Int64>(k_DEFAULT_SEGMENT_SIZE) * 1024)
+, d_fd(FileUtil::k_INVALID_FD)
+, d_logFilePattern(basicAllocator)
+, d_logFileName(basicAllocator)
+, d_utcFormatter(k_DEFAULT_FORMAT, false, basicAllocator)
+, d_localFormatter(k_DEFAULT_FORMAT, true, basicAllocator)
+, d_logFileFunctor(bsl::allocator_arg_t(),
+                   bsl::allocator<LogRecordFunctor>(basicAllocator))
+, d_publishInLocalTime(false)
+, d_rotationSize(0)
+, d_rotationInterval(0)
+, d_nextRotationTimeUtc(bsl::numeric_limits<bsls::Types::Int64>::max())
+, d_onRotationCb(bsl::allocator_arg_t(),
+                 bsl::allocator<OnFileRotationCallback>(basicAllocator))
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    d_segments[0].d_address_p = 0;
+    d_segments[1].d_address_p = 0;
+}
+
+MappedFileObserver::MappedFileObserver(int               segmentSize,
+                                       bslma::Allocator *basicAllocator)
+: d_current(0)
+, d_segmentSize(static_cast<bsls::Types::Int64>(segmentSize) * 1024)
+, d_fd(FileUtil::k_INVALID_FD)
+, d_logFilePattern(basicAllocator)
+, d_logFileName(basicAllocator)
+, d_utcFormatter(k_DEFAULT_FORMAT, false, basicAllocator)
+, d_localFormatter(k_DEFAULT_FORMAT, true, basicAllocator)
+, d_logFileFunctor(bsl::allocator_arg_t(),
+                   bsl::allocator<LogRecordFunctor>(basicAllocator))
+, d_publishInLocalTime(false)
+, d_rotationSize(0)
+, d_rotationInterval(0)
+, d_nextRotationTimeUtc(bsl::numeric_limits<bsls::Types::Int64>::max())
+, d_onRotationCb(bsl::allocator_arg_t(),
+                 bsl::allocator<OnFileRotationCallback>(basicAllocator))
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 < segmentSize);
+
+    d_segments[0].d_address_p = 0;
+    d_segments[1].d_address_p = 0;
+}
+
+MappedFileObserver::~MappedFileObserver()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    closeFile();
+}
+
+// MANIPULATORS
+void MappedFileObserver::disableFileLogging()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    closeFile();
+}
+
+void MappedFileObserver::disablePublishInLocalTime()
+{
+    d_publishInLocalTime.store(false);
+}
+
+void MappedFileObserver::disableSizeRotation()
+{
+    d_rotationSize.store(0);
+}
+
+void MappedFileObserver::disableTimeIntervalRotation()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    d_rotationInterval.setTotalSeconds(0);
+    updateNextRotationTime();
+}
+
+int MappedFileObserver::enableFileLogging(const char *logFilenamePattern)
+{
+    BSLS_ASSERT(logFilenamePattern);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (FileUtil::k_INVALID_FD != d_fd) {
+        return 1;                                                     // RETURN
+    }
+
+    d_logFilePattern = logFilenamePattern;
+
+    LogFileUtil::loadLogFileName(&d_logFileName,
+                                 &d_logFileTimestampUtc,
+                                 d_logFilePattern.c_str(),
+                                 d_publishInLocalTime.load());
+
+    // Use the last modification time of the log file to calculate the next
+    // rotation time if the log file already exists.
+
+    FileUtil::getLastModificationTime(&d_logFileTimestampUtc, d_logFileName);
+
+    if (0 != openFile()) {
+        return -1;                                                    // RETURN
+    }
+
+    updateNextRotationTime();
+
+    return 0;
+}
+
+void MappedFileObserver::enablePublishInLocalTime()
+{
+    d_publishInLocalTime.store(true);
+}
+
+void MappedFileObserver::forceRotation()
+{
+    bsl::string rotatedLogFileName(d_allocator_p);
+    int         rotationStatus;
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        rotationStatus = rotateFile(&rotatedLogFileName);
+    }
+
+    // The file-rotation callback must be invoked without a lock on 'd_mutex'
+    // to allow the callback to invoke other manipulators on this object.
+
+    if (0 >= rotationStatus) {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_rotationCbMutex);
+        if (d_onRotationCb) {
+            d_onRotationCb(rotationStatus, rotatedLogFileName);
+        }
+    }
+}
+
+void MappedFileObserver::publish(const Record& record, const Context&)
+{
+    FormatBufferHolder buffer(d_allocator_p);
+
+    bsl::string rotatedLogFileName(d_allocator_p);
+    int         rotationStatus    = 1;
+    bool        isFormatted       = false;
+    bool        isRotationChecked = false;
+
+    for (;;) {
+        Segment *segment = acquireSegment();
+
+        if (0 == segment) {
+            // Either file logging is disabled, or the log file is being
+            // changed by a thread holding 'd_mutex'.
+
+            bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+            if (FileUtil::k_INVALID_FD == d_fd) {
+                break;
+            }
+            continue;
+        }
+
+        if (!isFormatted) {
+            // The record is formatted while this thread is a writer of the
+            // segment, so that 'setLogFileFunctor' can wait for the functor
+            // to be no longer in use.
+
+            bsl::ostream& stream = buffer->stream();
+
+            if (d_logFileFunctor) {
+                d_logFileFunctor(stream, record);
+            }
+            else if (d_publishInLocalTime.loadRelaxed()) {
+                d_localFormatter(stream, record);
+            }
+            else {
+                d_utcFormatter(stream, record);
+            }
+            isFormatted = true;
+        }
+
+        if (!isRotationChecked) {
+            isRotationChecked = true;
+
+            const bsls::Types::Int64 rotationSize =
+                                static_cast<bsls::Types::Int64>(
+                                       d_rotationSize.loadRelaxed()) * 1024;
+
+            // The timestamp of the record is converted only if rotation on
+            // time interval is in effect.
+
+            const bsls::Types::Int64 nextRotationTimeUtc =
+                                           d_nextRotationTimeUtc.loadRelaxed();
+            const bsls::Types::Int64 timestamp =
+                 bsl::numeric_limits<bsls::Types::Int64>::max() ==
+                                                           nextRotationTimeUtc
+                 ? 0
+                 : toMicroseconds(record.fixedFields().timestamp());
+
+            if ((0 < rotationSize
+              && rotationSize < segment->d_fileOffset
+                              + segment->d_tail.loadRelaxed())
+             || nextRotationTimeUtc <= timestamp) {
+                segment->d_numWriters.add(-1);
+
+                bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+                rotationStatus = rotateIfNecessary(&rotatedLogFileName,
+                                                   timestamp);
+                continue;
+            }
+        }
+
+        const bsls::Types::Int64 length = buffer->length();
+        const bsls::Types::Int64 end    = segment->d_tail.add(length);
+        const bsls::Types::Int64 offset = end - length;
+
+        if (end <= segment->d_size) {
+            bsl::memcpy(segment->d_address_p + offset,
+                        buffer->data(),
+                        static_cast<bsl::size_t>(length));
+
+            segment->d_numWriters.add(-1);
+            break;
+        }
+
+        if (offset <= segment->d_size) {
+            // This reservation is the one that crosses the end of the segment:
+            // the next segment starts at 'offset'.
+
+            const bsls::Types::Int64 position = segment->d_fileOffset
+                                              + offset;
+
+            segment->d_end.store(offset);
+            segment->d_numWriters.add(-1);
+
+            advanceSegment(&rotatedLogFileName,
+                           &rotationStatus,
+                           segment,
+                           position,
+                           length);
+        }
+        else {
+            segment->d_numWriters.add(-1);
+
+            waitForSegmentChange(segment);
+        }
+    }
+
+    if (0 >= rotationStatus) {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_rotationCbMutex);
+
+        if (d_onRotationCb) {
+            d_onRotationCb(rotationStatus, rotatedLogFileName);
+        }
+    }
+}
+
+void MappedFileObserver::rotateOnSize(int size)
+{
+    BSLS_ASSERT(size > 0);
+
+    d_rotationSize.store(size);
+}
+
+void MappedFileObserver::rotateOnTimeInterval(
+                                        const bdlt::DatetimeInterval& interval)
+{
+    rotateOnTimeInterval(interval, bdlt::CurrentTime::local());
+}
+
+void MappedFileObserver::rotateOnTimeInterval(
+                                       const bdlt::DatetimeInterval& interval,
+                                       const bdlt::Datetime&         startTime)
+{
+    BSLS_ASSERT(0 < interval.totalMilliseconds());
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    d_rotationInterval = interval;
+
+    // Reference time is stored as local time as conversion to UTC time may
+    // cause an underflow (or overflow).
+
+    d_rotationReferenceLocalTime = startTime;
+
+    updateNextRotationTime();
+}
+
+void MappedFileObserver::setLogFileFunctor(
+                                        const LogRecordFunctor& logFileFunctor)
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    // Withdraw the current segment, so that no thread formats records while
+    // the functor is replaced.
+
+    Segment *segment = d_current.load();
+
+    if (segment) {
+        d_current.store(0);
+        waitForWriters(segment);
+    }
+
+    d_logFileFunctor = logFileFunctor;
+
+    if (segment) {
+        d_current.store(segment);
+    }
+}
+
+void MappedFileObserver::setOnFileRotationCallback(
+                              const OnFileRotationCallback& onRotationCallback)
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_rotationCbMutex);
+    d_onRotationCb = onRotationCallback;
+}
+
+// ACCESSORS
+bool MappedFileObserver::isFileLoggingEnabled() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return FileUtil::k_INVALID_FD != d_fd;
+}
+
+bool MappedFileObserver::isFileLoggingEnabled(bsl::string *result) const
+{
+    BSLS_ASSERT(result);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    bool rc = FileUtil::k_INVALID_FD != d_fd;
+    if (rc) {
+        result->assign(d_logFileName);
+    }
+
+    return rc;
+}
+
+bdlt::DatetimeInterval MappedFileObserver::rotationLifetime() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return d_rotationInterval;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#if defined(BSLS_PLATFORM_CMP_MSVC)
+#undef snprintf
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
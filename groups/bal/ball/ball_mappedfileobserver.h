@@ -0,0 +1,696 @@
+// ball_mappedfileobserver.h                                          -*-C++-*-
+#ifndef INCLUDED_BALL_MAPPEDFILEOBSERVER
+#define INCLUDED_BALL_MAPPEDFILEOBSERVER
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an observer writing log records to a memory-mapped file.
+//
+//@CLASSES:
+//  ball::MappedFileObserver: observer writing records to a memory-mapped file
+//
+//@SEE_ALSO: ball_fileobserver2, ball_logfileutil, ball_recordstringformatter,
+//           bdls_filesystemutil
+//
+//@DESCRIPTION: This component provides a concrete implementation of the
+// 'ball::Observer' protocol, 'ball::MappedFileObserver', for publishing log
+// records to a user-specified file through a memory mapping of that file.  The
+// following inheritance hierarchy diagram shows the classes involved and their
+// methods:
+//..
+//             ,------------------------.
+//            ( ball::MappedFileObserver )
+//             `------------------------'
+//                         |              ctor
+//                         |              disableFileLogging
+//                         |              disableTimeIntervalRotation
+//                         |              disableSizeRotation
+//                         |              disablePublishInLocalTime
+//                         |              enableFileLogging
+//                         |              enablePublishInLocalTime
+//                         |              forceRotation
+//                         |              rotateOnSize
+//                         |              rotateOnTimeInterval
+//                         |              setLogFileFunctor
+//                         |              setOnFileRotationCallback
+//                         |              isFileLoggingEnabled
+//                         |              isPublishInLocalTimeEnabled
+//                         |              rotationLifetime
+//                         |              rotationSize
+//                         |              segmentSize
+//                         V
+//                  ,--------------.
+//                 ( ball::Observer )
+//                  `--------------'
+//                                        dtor
+//                                        publish
+//                                        releaseRecords
+//..
+// A 'ball::MappedFileObserver' is configured like a 'ball::FileObserver2': the
+// 'enableFileLogging' method must be called to enable logging, log filenames
+// are derived from a pattern, and the log file may be rotated based on its
+// size and on a periodic time interval.  The {Log Record Formatting}, {Log
+// Record Timestamps}, {Log Filename Patterns}, and {Log File Rotation}
+// sections of {'ball_fileobserver2'} apply to this component unchanged,
+// except that the default record format is that of a
+// 'ball::RecordStringFormatter' having the "\n%d %p:%t %s %f:%l %c %m %u\n"
+// format specification.  The two observers differ in how records reach the
+// log file, as described below.
+//
+///File Observer Configuration Synopsis
+///------------------------------------
+//..
+// +-------------+-----------------------------+------------------------------+
+// | Aspect      | Manipulators                | Accessors                    |
+// +=============+=============================+==============================+
+// | Log Record  | setLogFileFunctor           |                              |
+// | Formatting  |                             |                              |
+// +-------------+-----------------------------+------------------------------+
+// | Log Record  | enablePublishInLocalTime    | isPublishInLocalTimeEnabled  |
+// | Timestamps  | disablePublishInLocalTime   |                              |
+// +-------------+-----------------------------+------------------------------+
+// | File        | enableFileLogging           | isFileLoggingEnabled         |
+// | Logging     | disableFileLogging          | segmentSize                  |
+// +-------------+-----------------------------+------------------------------+
+// | Log File    | rotateOnSize                | rotationSize                 |
+// | Rotation    | rotateOnTimeInterval        | rotationLifetime             |
+// |             | disableSizeRotation         |                              |
+// |             | disableTimeIntervalRotation |                              |
+// |             | forceRotation               |                              |
+// |             | setOnFileRotationCallback   |                              |
+// +-------------+-----------------------------+------------------------------+
+//..
+//
+///Memory-Mapped Output
+///--------------------
+// A 'ball::FileObserver2' serializes the threads that publish records with a
+// mutex, and writes each record to its log file with (at least) one system
+// call while that mutex is held.  A 'ball::MappedFileObserver' instead maps a
+// *segment* of its log file, 'segmentSize' kilobytes starting at the end of
+// the data in the file, into memory, having first extended the file to cover
+// the segment (using 'bdls::FilesystemUtil::growFile', which preallocates the
+// space on disk where the platform supports it).  Each call to 'publish'
+// formats the record into a buffer owned by the calling thread (and reused for
+// the records it subsequently publishes), reserves the space for the record at
+// the tail of the segment with a single atomic addition, and copies the record
+// into the mapped memory.  Threads publishing records concurrently therefore
+// neither share a lock nor make system calls; the operating system writes the
+// modified pages of the mapping back to the file.
+//
+// The thread whose reservation first extends past the end of the mapped
+// segment maps the next segment of the file, starting exactly where the data
+// in the previous segment ends, and its record is written at the start of the
+// next segment.  The threads whose reservations begin past the end of the
+// segment wait until the next segment is mapped and then reserve space anew.
+// A record larger than 'segmentSize' kilobytes is written to a segment that is
+// extended to accommodate it.  Once the threads copying records into the
+// previous segment have finished, that segment is unmapped.  Mapping a
+// segment, rotating the log file, and the other configuration changes that
+// affect the log file are serialized by a mutex, which the threads publishing
+// records acquire only to wait for one of those operations to complete.
+//
+// The records in the log file appear in the order in which space was reserved
+// for them; in particular, the records published by any one thread appear in
+// the order in which they were published.
+//
+///Log File Size
+///- - - - - - -
+// While a log file is open, its size is that of its mapped segment (rounded up
+// to a multiple of the memory page size), and the part of the file beyond the
+// published records is filled with unspecified (typically zero) bytes.  The
+// file is truncated to the size of its records when it is closed: by
+// 'disableFileLogging', by a rotation, or by the destruction of the observer.
+// Tools that follow a log file while it is written (e.g., 'tail -f') must be
+// prepared for the trailing bytes, and a log file left behind by a process
+// that terminated abnormally retains them.  The size of the records is used
+// for the rotation-on-size rule.
+//
+// The behavior is undefined if a log file is truncated by another process
+// while it is mapped (accessing a mapped page beyond the end of a file raises
+// 'SIGBUS' on most platforms).
+//
+///Thread Safety
+///-------------
+// All methods of 'ball::MappedFileObserver' are thread-safe, and can be called
+// concurrently by multiple threads.  The formatting functor supplied to
+// 'setLogFileFunctor' may be invoked by several threads concurrently, and must
+// therefore be safe to use concurrently (as is 'ball::RecordStringFormatter').
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Basic Usage
+/// - - - - - - - - - - -
+// First, we create a 'ball::LoggerManagerConfiguration' object, 'lmConfig',
+// and set the logging "pass-through" level -- the level at which log records
+// are published to registered observers -- to 'DEBUG':
+//..
+//  int main()
+//  {
+//      ball::LoggerManagerConfiguration lmConfig;
+//      lmConfig.setDefaultThresholdLevelsIfValid(ball::Severity::e_DEBUG);
+//..
+// Next, create a 'ball::LoggerManagerScopedGuard' object whose constructor
+// takes the configuration object just created.  The guard will initialize the
+// logger manager singleton on creation and destroy the singleton upon
+// destruction:
+//..
+//      ball::LoggerManagerScopedGuard guard(lmConfig);
+//      ball::LoggerManager& manager = ball::LoggerManager::singleton();
+//..
+// Next, we create a 'ball::MappedFileObserver' object that maps its log file
+// in segments of 16 megabytes:
+//..
+//      bsl::shared_ptr<ball::MappedFileObserver> observer =
+//                       bsl::make_shared<ball::MappedFileObserver>(16 * 1024);
+//..
+// Next, we configure the log file rotation rules, exactly as we would for a
+// 'ball::FileObserver2':
+//..
+//      // Rotate the file when its size becomes greater than or equal to 128
+//      // megabytes.
+//      observer->rotateOnSize(1024 * 128);
+//
+//      // Rotate the file every 24 hours.
+//      observer->rotateOnTimeInterval(bdlt::DatetimeInterval(1));
+//..
+// Then, we enable logging to a file:
+//..
+//      // Create and log records to a file named "/var/log/task/task.log".
+//      observer->enableFileLogging("/var/log/task/task.log");
+//..
+// Finally, we register the file observer with the logger manager.  Upon
+// successful registration, the observer will start to receive log records via
+// the 'publish' method:
+//..
+//      int rc = manager.registerObserver(observer, "default");
+//      assert(0 == rc);
+//      return 0;
+//  }
+//..
+
+#include <balscm_version.h>
+
+#include <ball_observer.h>
+#include <ball_recordstringformatter.h>
+
+#include <bdls_filesystemutil.h>
+
+#include <bdlt_datetime.h>
+#include <bdlt_datetimeinterval.h>
+
+#include <bslma_allocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bslmt_condition.h>
+#include <bslmt_mutex.h>
+
+#include <bsls_atomic.h>
+#include <bsls_types.h>
+
+#include <bsl_functional.h>
+#include <bsl_iosfwd.h>
+#include <bsl_memory.h>
+#include <bsl_string.h>
+
+namespace BloombergLP {
+namespace ball {
+
+class Context;
+class Record;
+
+                      // ================================
+                      // struct MappedFileObserver_Segment
+                      // ================================
+
+struct MappedFileObserver_Segment {
+    // [!PRIVATE!] This 'struct' describes a region of a log file that is
+    // mapped into memory by a 'MappedFileObserver', and into which space for
+    // records is reserved by atomically advancing 'd_tail'.  The members other
+    // than 'd_tail', 'd_end', and 'd_numWriters' are modified only while the
+    // segment is not the current segment of its observer.
+
+    // DATA
+    char               *d_address_p;   // address of the mapping
+
+    bsls::Types::Int64  d_fileOffset;  // offset of the mapping in the file
+
+    bsls::Types::Int64  d_size;        // size of the mapping (in bytes)
+
+    bsls::AtomicInt64   d_tail;        // offset, in the mapping, of the next
+                                       // reservation
+
+    bsls::AtomicInt64   d_end;         // offset, in the mapping, of the end of
+                                       // the records written to it, set when
+                                       // a reservation crosses 'd_size' (-1
+                                       // until then)
+
+    bsls::AtomicInt     d_numWriters;  // number of threads that may access
+                                       // the mapping
+};
+
+                          // ========================
+                          // class MappedFileObserver
+                          // ========================
+
+class MappedFileObserver : public Observer {
+    // This class implements the 'Observer' protocol.  The 'publish' method of
+    // this class writes the log records that it receives to a user-specified
+    // file through a memory mapping of that file.  This class is thread-safe;
+    // different threads can operate on an object concurrently, and threads
+    // publishing records do not contend for a lock.  This class is
+    // exception-neutral with no guarantee of rollback.  In no event is memory
+    // leaked.
+
+  public:
+    // PUBLIC TYPES
+    typedef bsl::function<void(bsl::ostream&, const Record&)> LogRecordFunctor;
+        // 'LogRecordFunctor' is an alias for the type of the functor used for
+        // formatting log records to a stream.
+
+    typedef bsl::function<void(int, const bsl::string&)>
+                                                        OnFileRotationCallback;
+        // 'OnFileRotationCallback' is an alias for a user-supplied callback
+        // function that is invoked after the file observer attempts to rotate
+        // its log file.  The callback takes two arguments: (1) an integer
+        // status value where 0 indicates a new log file was successfully
+        // created and a non-zero value indicates an error occurred during
+        // rotation, and (2) a string that provides the name of the rotated log
+        // file if the rotation was successful.
+
+    enum {
+        k_DEFAULT_SEGMENT_SIZE = 4096  // default size (in kilobytes) of the
+                                       // mapped segments of a log file
+    };
+
+  private:
+    // PRIVATE TYPES
+    typedef MappedFileObserver_Segment           Segment;
+    typedef bdls::FilesystemUtil::FileDescriptor FileDescriptor;
+
+    // DATA
+    Segment                      d_segments[2];   // mapped segments, used in
+                                                  // turn
+
+    bsls::AtomicPointer<Segment> d_current;       // segment into which
+                                                  // records are written (0 if
+                                                  // the segment is being
+                                                  // changed, or if file
+                                                  // logging is disabled)
+
+    bsls::Types::Int64           d_segmentSize;   // minimum size (in bytes)
+                                                  // of a mapped segment
+
+    FileDescriptor               d_fd;            // log file descriptor
+
+    bsl::string                  d_logFilePattern;
+                                                  // log filename pattern
+
+    bsl::string                  d_logFileName;   // current log filename
+
+    bdlt::Datetime               d_logFileTimestampUtc;
+                                                  // modification time of the
+                                                  // log file when it was
+                                                  // opened (or the creation
+                                                  // time if the log file did
+                                                  // not already exist)
+
+    RecordStringFormatter        d_utcFormatter;  // default formatter
+                                                  // (UTC timestamps)
+
+    RecordStringFormatter        d_localFormatter;
+                                                  // default formatter (local
+                                                  // timestamps)
+
+    LogRecordFunctor             d_logFileFunctor;
+                                                  // user-supplied formatting
+                                                  // functor (empty if the
+                                                  // default formatter is in
+                                                  // effect)
+
+    bsls::AtomicBool             d_publishInLocalTime;
+                                                  // 'true' if timestamps of
+                                                  // records are output in
+                                                  // local time, otherwise UTC
+                                                  // time
+
+    bsls::AtomicInt              d_rotationSize;  // maximum log file size
+                                                  // before rotation (in
+                                                  // kilobytes)
+
+    bdlt::Datetime               d_rotationReferenceLocalTime;
+                                                  // reference *local* start
+                                                  // time for time-based
+                                                  // rotation
+
+    bdlt::DatetimeInterval       d_rotationInterval;
+                                                  // time interval between two
+                                                  // time-based rotations
+
+    bsls::AtomicInt64            d_nextRotationTimeUtc;
+                                                  // next scheduled time for
+                                                  // time-based rotation, in
+                                                  // microseconds since
+                                                  // 0001/01/01 (the maximum
+                                                  // 'Int64' value if none)
+
+    mutable bslmt::Mutex         d_mutex;         // serialize operations that
+                                                  // change the log file or
+                                                  // the current segment
+
+    bslmt::Condition             d_segmentChangedCondition;
+                                                  // signaled when the current
+                                                  // segment changes
+
+    OnFileRotationCallback       d_onRotationCb;  // user callback invoked
+                                                  // following file rotation
+
+    mutable bslmt::Mutex         d_rotationCbMutex;
+                                                  // serialize access to
+                                                  // 'd_onRotationCb';
+                                                  // required because callback
+                                                  // must be called with
+                                                  // 'd_mutex' unlocked
+
+    bslma::Allocator            *d_allocator_p;   // memory allocator (held,
+                                                  // not owned)
+
+  private:
+    // NOT IMPLEMENTED
+    MappedFileObserver(const MappedFileObserver&);
+    MappedFileObserver& operator=(const MappedFileObserver&);
+
+  private:
+    // PRIVATE MANIPULATORS
+    Segment *acquireSegment();
+        // Return the address of the current segment of this file observer,
+        // having registered the calling thread as a writer of that segment,
+        // or 0 if there is no current segment.  The behavior is undefined if
+        // the calling thread holds the lock for this object.
+
+    void advanceSegment(bsl::string        *rotatedLogFileName,
+                        int                *rotationStatus,
+                        Segment            *segment,
+                        bsls::Types::Int64  position,
+                        bsls::Types::Int64  length);
+        // Replace the specified 'segment', whose space was exhausted by the
+        // reservation of a record of the specified 'length' at the specified
+        // 'position' in the log file, with the next segment of the log file,
+        // which is mapped at 'position' to accommodate the record; or, if the
+        // log file is due for rotation based on its size, rotate the log
+        // file, loading into the specified 'rotatedLogFileName' and
+        // 'rotationStatus' the name of the rotated file and the status of the
+        // rotation (as returned by 'rotateFile').  This method has no effect
+        // unless 'segment' is the current segment of this file observer and
+        // the end of its records is at 'position' (i.e., unless 'segment' has
+        // not been replaced since the reservation was made).  The behavior is
+        // undefined if the calling thread holds the lock for this object, or
+        // is registered as a writer of a segment.
+
+    void closeFile();
+        // Close the log file of this file observer, after unmapping its
+        // current segment and truncating the file to the size of its records.
+        // This method has no effect if file logging is not enabled.  The
+        // behavior is undefined unless the caller acquired the lock for this
+        // object.
+
+    int mapSegment(Segment            *segment,
+                   bsls::Types::Int64  position,
+                   bsls::Types::Int64  length);
+        // Map, into the specified 'segment', a region of the log file that
+        // starts at the specified 'position' and can hold a record of the
+        // specified 'length', having extended the file to cover the region.
+        // Return 0 on success, and a non-zero value otherwise.  The behavior
+        // is undefined unless the caller acquired the lock for this object,
+        // and 'segment' is not mapped.
+
+    int openFile();
+        // Open the log file named 'd_logFileName', map its first segment after
+        // the data already in the file, and make that segment current.
+        // Return 0 on success, and a non-zero value otherwise.  The behavior
+        // is undefined unless the caller acquired the lock for this object,
+        // and file logging is not enabled.
+
+    int rotateFile(bsl::string *rotatedLogFileName);
+        // Perform a log file rotation by closing the current log file of this
+        // file observer, renaming the closed log file if necessary, and
+        // opening a new log file.  Load, into the specified
+        // 'rotatedLogFileName', the name of the rotated log file.  Return 0 on
+        // success, a positive value if logging is not enabled, and a negative
+        // value otherwise.  The behavior is undefined unless the caller
+        // acquired the lock for this object.
+
+    int rotateIfNecessary(bsl::string        *rotatedLogFileName,
+                          bsls::Types::Int64  timestamp);
+        // Perform log file rotation if either the specified 'timestamp' (in
+        // microseconds since 0001/01/01 UTC) is later than the scheduled
+        // rotation time of the current log file, or the log file is larger
+        // than the allowable size, and if a rotation is performed, load into
+        // the specified 'rotatedLogFileName' the name of the rotated file.
+        // Return 0 if the log file is rotated successfully, a positive value
+        // if a rotation was not performed, and a negative value otherwise.
+        // The behavior is undefined unless the caller acquired the lock for
+        // this object.
+
+    bsls::Types::Int64 unmapSegment(Segment *segment);
+        // Wait until no thread is registered as a writer of the specified
+        // 'segment', unmap it, and return the offset in the log file of the
+        // end of the records written to it.  The behavior is undefined unless
+        // the caller acquired the lock for this object, and 'segment' is
+        // mapped and is not the current segment.
+
+    void updateNextRotationTime();
+        // Compute the next scheduled time for time-based rotation of the
+        // current log file, if rotation-on-time-interval is in effect and
+        // file logging is enabled.  The behavior is undefined unless the
+        // caller acquired the lock for this object.
+
+    void waitForSegmentChange(const Segment *segment);
+        // Block until the specified 'segment' is not the current segment of
+        // this file observer, or has space available for reservations.  The
+        // behavior is undefined if the calling thread holds the lock for this
+        // object, or is registered as a writer of a segment.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(MappedFileObserver,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit MappedFileObserver(bslma::Allocator *basicAllocator = 0);
+    explicit MappedFileObserver(int               segmentSize,
+                                bslma::Allocator *basicAllocator = 0);
+        // Create a file observer with file logging initially disabled.
+        // Optionally specify a 'segmentSize' (in kilobytes) of the regions of
+        // the log file mapped into memory; if 'segmentSize' is not specified,
+        // 'k_DEFAULT_SEGMENT_SIZE' is used.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless '0 < segmentSize'.  Note that
+        // 'isPublishInLocalTimeEnabled' returns 'false' following
+        // construction, and that a default record format is in effect for
+        // file logging (see 'setLogFileFunctor').
+
+    ~MappedFileObserver();
+        // Close the log file of this file observer if file logging is enabled,
+        // and destroy this file observer.  The behavior is undefined if
+        // 'publish' is invoked concurrently with this destructor.
+
+    // MANIPULATORS
+    void disableFileLogging();
+        // Disable file logging for this file observer: close the log file,
+        // having waited for records being written to it to be written and
+        // truncated it to the size of its records.  This method has no effect
+        // if file logging is not enabled.  Note that records subsequently
+        // received through the 'publish' method will be dropped until file
+        // logging is reenabled.
+
+    void disablePublishInLocalTime();
+        // Disable publishing of the timestamp attribute of records in local
+        // time by this file observer; henceforth, timestamps will be in UTC
+        // time.  This method has no effect if publishing in local time is not
+        // enabled.  Note that this method also affects log filenames (see
+        // {'ball_fileobserver2'|Log Filename Patterns}).
+
+    void disableSizeRotation();
+        // Disable log file rotation based on log file size for this file
+        // observer.  This method has no effect if rotation-on-size is not
+        // enabled.
+
+    void disableTimeIntervalRotation();
+        // Disable log file rotation based on a periodic time interval for this
+        // file observer.  This method has no effect if
+        // rotation-on-time-interval is not enabled.
+
+    int enableFileLogging(const char *logFilenamePattern);
+        // Enable logging of all records published to this file observer to a
+        // file whose name is derived from the specified 'logFilenamePattern',
+        // appending to the file if it already exists.  Return 0 on success, a
+        // positive value if file logging is already enabled (with no effect),
+        // and a negative value otherwise.  'logFilenamePattern' is
+        // interpreted as for 'ball::FileObserver2::enableFileLogging' (see
+        // {'ball_logfileutil'|Log Filename Patterns}).
+
+    void enablePublishInLocalTime();
+        // Enable publishing of the timestamp attribute of records in local
+        // time by this file observer.  This method has no effect if publishing
+        // in local time is already enabled.  Note that this method also
+        // affects log filenames (see {'ball_fileobserver2'|Log Filename
+        // Patterns}).
+
+    void forceRotation();
+        // Forcefully perform a log file rotation by this file observer.  Close
+        // the current log file, rename the log file if necessary, and open a
+        // new log file.  This method has no effect if file logging is not
+        // enabled.  See {'ball_fileobserver2'|Rotated File Naming} for details
+        // on filenames of rotated log files.
+
+    void publish(const Record& record, const Context& context);
+        // Process the specified log 'record' having the specified publishing
+        // 'context' by writing 'record' to the current log file if file
+        // logging is enabled for this file observer.  The method has no effect
+        // if file logging is not enabled, in which case 'record' is dropped.
+
+    void publish(const bsl::shared_ptr<const Record>& record,
+                 const Context&                       context);
+        // Process the record referenced by the specified 'record' shared
+        // pointer having the specified publishing 'context' by writing the
+        // record to the current log file if file logging is enabled for this
+        // file observer.  The method has no effect if file logging is not
+        // enabled, in which case 'record' is dropped.
+
+    void releaseRecords();
+        // Discard any shared references to 'Record' objects that were supplied
+        // to the 'publish' method, and are held by this observer.  Note that
+        // this operation should be called if resources underlying the
+        // previously provided shared pointers must be released.
+
+    void rotateOnSize(int size);
+        // Set this file observer to perform log file rotation when the size of
+        // the records in the file exceeds the specified 'size' (in kilobytes).
+        // This rule replaces any rotation-on-size rule currently in effect.
+        // The behavior is undefined unless 'size > 0'.
+
+    void rotateOnTimeInterval(const bdlt::DatetimeInterval& interval);
+    void rotateOnTimeInterval(const bdlt::DatetimeInterval& interval,
+                              const bdlt::Datetime&         startTime);
+        // Set this file observer to perform a periodic log file rotation at
+        // multiples of the specified 'interval'.  Optionally specify a
+        // 'startTime' indicating the *local* datetime to use as the starting
+        // point for computing the periodic rotation schedule.  If 'startTime'
+        // is not specified, the current time is used.  This rule replaces any
+        // rotation-on-time-interval rule currently in effect.  The behavior is
+        // undefined unless '0 < interval.totalMilliseconds()'.
+
+    void setLogFileFunctor(const LogRecordFunctor& logFileFunctor);
+        // Set the formatting functor used when writing records to the log file
+        // of this file observer to the specified 'logFileFunctor'.  This
+        // method waits for the threads formatting records with the previous
+        // functor to finish doing so.  Note that a default format
+        // ("\n%d %p:%t %s %f:%l %c %m %u\n") is in effect until this method
+        // is called (see 'ball_recordstringformatter').  Also note that
+        // 'logFileFunctor' may be invoked concurrently by several threads
+        // (see {Thread Safety}).
+
+    void setOnFileRotationCallback(
+                             const OnFileRotationCallback& onRotationCallback);
+        // Set the specified 'onRotationCallback' to be invoked after each time
+        // this file observer attempts to perform a log file rotation.  The
+        // behavior is undefined if the supplied function calls either
+        // 'setOnFileRotationCallback', 'forceRotation', or 'publish' on this
+        // file observer (i.e., the supplied callback should *not* attempt to
+        // write to the 'ball' log).
+
+    // ACCESSORS
+    bool isFileLoggingEnabled() const;
+    bool isFileLoggingEnabled(bsl::string *result) const;
+        // Return 'true' if file logging is enabled for this file observer, and
+        // 'false' otherwise.  Load the optionally specified 'result' with the
+        // name of the current log file if file logging is enabled, and leave
+        // 'result' unmodified otherwise.
+
+    bool isPublishInLocalTimeEnabled() const;
+        // Return 'true' if this file observer writes the timestamp attribute
+        // of records that it publishes in local time, and 'false' otherwise
+        // (in which case timestamps are written in UTC time).
+
+    bdlt::DatetimeInterval rotationLifetime() const;
+        // Return the interval between periodic rotations of the log file by
+        // this file observer if rotation-on-time-interval is in effect, and a
+        // 0 time interval otherwise.
+
+    int rotationSize() const;
+        // Return the size (in kilobytes) of the log file that will trigger a
+        // file rotation by this file observer if rotation-on-size is in
+        // effect, and 0 otherwise.
+
+    int segmentSize() const;
+        // Return the minimum size (in kilobytes) of the regions of the log
+        // file that are mapped into memory by this file observer.
+};
+
+// ============================================================================
+//                              INLINE DEFINITIONS
+// ============================================================================
+
+                          // ------------------------
+                          // class MappedFileObserver
+                          // ------------------------
+
+// MANIPULATORS
+inline
+void MappedFileObserver::publish(
+                                 const bsl::shared_ptr<const Record>& record,
+                                 const Context&                       context)
+{
+    publish(*record, context);
+}
+
+inline
+void MappedFileObserver::releaseRecords()
+{
+}
+
+// ACCESSORS
+inline
+bool MappedFileObserver::isPublishInLocalTimeEnabled() const
+{
+    return d_publishInLocalTime.loadRelaxed();
+}
+
+inline
+int MappedFileObserver::rotationSize() const
+{
+    return d_rotationSize.loadRelaxed();
+}
+
+inline
+int MappedFileObserver::segmentSize() const
+{
+    return static_cast<int>(d_segmentSize / 1024);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1355 @@
+// ball_mappedfileobserver.t.cpp                                      -*-C++-*-
+#include <ball_mappedfileobserver.h>
+
+#include <ball_context.h>
+#include <ball_fileobserver2.h>
+#include <ball_loggermanager.h>
+#include <ball_loggermanagerconfiguration.h>
+#include <ball_record.h>
+#include <ball_recordattributes.h>
+#include <ball_recordstringformatter.h>
+#include <ball_severity.h>
+
+#include <bdls_filesystemutil.h>
+#include <bdls_memoryutil.h>
+#include <bdls_pathutil.h>
+
+#include <bdlt_currenttime.h>
+#include <bdlt_datetime.h>
+#include <bdlt_datetimeinterval.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_testallocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bslmt_threadgroup.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_platform.h>
+#include <bsls_timeinterval.h>
+#include <bsls_timeutil.h>
+#include <bsls_types.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_fstream.h>
+#include <bsl_iostream.h>
+#include <bsl_memory.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                             TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test provides an observer, 'ball::MappedFileObserver',
+// that writes log records to a file through memory mappings of segments of
+// that file.  Each test case creates log files in a temporary directory,
+// publishes records to an observer, and compares the contents of the log files
+// with the formatted records once the log files are closed (when file logging
+// is disabled, or when a log file is rotated).  Small segment sizes are used
+// so that records are written across many segments, and records larger than a
+// segment are published.  The rotation-on-size and rotation-on-time-interval
+// rules, which are shared with 'ball::FileObserver2', are verified through the
+// file-rotation callback.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] MappedFileObserver(bslma::Allocator *basicAllocator = 0);
+// [ 2] MappedFileObserver(int segmentSize, bslma::Allocator * = 0);
+// [ 2] ~MappedFileObserver();
+//
+// MANIPULATORS
+// [ 1] void disableFileLogging();
+// [ 6] void disablePublishInLocalTime();
+// [ 4] void disableSizeRotation();
+// [ 5] void disableTimeIntervalRotation();
+// [ 1] int enableFileLogging(const char *logFilenamePattern);
+// [ 6] void enablePublishInLocalTime();
+// [ 4] void forceRotation();
+// [ 1] void publish(const Record& record, const Context& context);
+// [ 1] void publish(const shared_ptr<const Record>&, const Context&);
+// [ 2] void releaseRecords();
+// [ 4] void rotateOnSize(int size);
+// [ 5] void rotateOnTimeInterval(const DatetimeInterval& interval);
+// [ 5] void rotateOnTimeInterval(const DtInterval&, const Datetime&);
+// [ 6] void setLogFileFunctor(const LogRecordFunctor& logFileFunctor);
+// [ 4] void setOnFileRotationCallback(const OnFileRotationCallback&);
+//
+// ACCESSORS
+// [ 1] bool isFileLoggingEnabled() const;
+// [ 1] bool isFileLoggingEnabled(bsl::string *result) const;
+// [ 2] bool isPublishInLocalTimeEnabled() const;
+// [ 2] bdlt::DatetimeInterval rotationLifetime() const;
+// [ 2] int rotationSize() const;
+// [ 2] int segmentSize() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] WRITING RECORDS ACROSS SEGMENTS
+// [ 7] CONCURRENT PUBLISHING
+// [ 8] USAGE EXAMPLE
+// [-1] PERFORMANCE: MAPPED FILE OBSERVER VS. FILE OBSERVER
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef ball::MappedFileObserver Obj;
+typedef bdls::FilesystemUtil     FsUtil;
+typedef bsls::Types::Int64       Int64;
+
+static const char k_DEFAULT_FORMAT[] = "\n%d %p:%t %s %f:%l %c %m %u\n";
+
+static bool verbose;
+static bool veryVerbose;
+
+//=============================================================================
+//                  GLOBAL CLASSES FOR TESTING
+//-----------------------------------------------------------------------------
+
+                          // ========================
+                          // class TempDirectoryGuard
+                          // ========================
+
+class TempDirectoryGuard {
+    // This class implements a scoped temporary directory guard.  The guard
+    // tries to create a temporary directory in the system-wide temp directory
+    // and falls back to the current directory.
+
+    // DATA
+    bsl::string       d_dirName;      // path to the created directory
+    bslma::Allocator *d_allocator_p;  // memory allocator (held, not owned)
+
+  private:
+    // NOT IMPLEMENTED
+    TempDirectoryGuard(const TempDirectoryGuard&);
+    TempDirectoryGuard& operator=(const TempDirectoryGuard&);
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(TempDirectoryGuard,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit TempDirectoryGuard(bslma::Allocator *basicAllocator = 0)
+        // Create temporary directory in the system-wide temp or current
+        // directory.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.
+    : d_dirName(bslma::Default::allocator(basicAllocator))
+    , d_allocator_p(bslma::Default::allocator(basicAllocator))
+    {
+        bsl::string tmpPath(d_allocator_p);
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+        char tmpPathBuf[MAX_PATH];
+        GetTempPath(MAX_PATH, tmpPathBuf);
+        tmpPath.assign(tmpPathBuf);
+#else
+        const char *envTmpPath = bsl::getenv("TMPDIR");
+        if (envTmpPath) {
+            tmpPath.assign(envTmpPath);
+        }
+#endif
+
+        int res = bdls::PathUtil::appendIfValid(&tmpPath, "ball_");
+        ASSERTV(tmpPath, 0 == res);
+
+        res = bdls::FilesystemUtil::createTemporaryDirectory(&d_dirName,
+                                                             tmpPath);
+        ASSERTV(tmpPath, 0 == res);
+    }
+
+    ~TempDirectoryGuard()
+        // Destroy this object and remove the temporary directory (recursively)
+        // created at construction.
+    {
+        bdls::FilesystemUtil::remove(d_dirName, true);
+    }
+
+    // ACCESSORS
+    const bsl::string& getTempDirName() const
+        // Return a 'const' reference to the name of the created temporary
+        // directory.
+    {
+        return d_dirName;
+    }
+};
+
+                          // =======================
+                          // struct RotationRecorder
+                          // =======================
+
+struct RotationRecorder {
+    // This 'struct' holds the record of the invocations of the file-rotation
+    // callback of a file observer, and the contents of the rotated log files.
+
+    // DATA
+    bsl::vector<int>         d_statuses;  // status of each rotation
+    bsl::vector<bsl::string> d_names;     // name of each rotated file
+    bsl::string              d_contents;  // contents of the rotated files
+};
+
+                          // ======================
+                          // class RotationCallback
+                          // ======================
+
+class RotationCallback {
+    // This class provides a file-rotation callback that records its
+    // invocations in a 'RotationRecorder', and collects the contents of the
+    // rotated log files, which it removes so that the names of rotated log
+    // files can be reused.
+
+    // DATA
+    RotationRecorder *d_recorder_p;  // recorder (held, not owned)
+
+  public:
+    // CREATORS
+    explicit RotationCallback(RotationRecorder *recorder)
+        // Create a callback that records its invocations in the specified
+        // 'recorder'.
+    : d_recorder_p(recorder)
+    {
+    }
+
+    // ACCESSORS
+    void operator()(int status, const bsl::string& rotatedFileName) const;
+        // Record the specified 'status' and 'rotatedFileName', and, if
+        // 'status' is 0, append the contents of the file having
+        // 'rotatedFileName' to the contents held by the recorder and remove
+        // that file.
+};
+
+void RotationCallback::operator()(int                status,
+                                  const bsl::string& rotatedFileName) const
+{
+    d_recorder_p->d_statuses.push_back(status);
+    d_recorder_p->d_names.push_back(rotatedFileName);
+
+    if (0 == status) {
+        bsl::ifstream      fs(rotatedFileName.c_str(),
+                              bsl::ios::in | bsl::ios::binary);
+        bsl::ostringstream os;
+        os << fs.rdbuf();
+        fs.close();
+        d_recorder_p->d_contents += os.str();
+        ASSERTV(rotatedFileName, 0 == FsUtil::remove(rotatedFileName));
+    }
+}
+
+//=============================================================================
+//                  GLOBAL HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+static bsl::string makeFileName(const TempDirectoryGuard& tempDir,
+                                const char               *leafName)
+    // Return the path of the file having the specified 'leafName' in the
+    // specified 'tempDir'.
+{
+    bsl::string fileName(tempDir.getTempDirName());
+    bdls::PathUtil::appendRaw(&fileName, leafName);
+    return fileName;
+}
+
+static bsl::string readFile(const bsl::string& fileName)
+    // Return the contents of the file having the specified 'fileName'.
+{
+    bsl::ifstream      fs(fileName.c_str(), bsl::ios::in | bsl::ios::binary);
+    bsl::ostringstream os;
+    os << fs.rdbuf();
+    return os.str();
+}
+
+static void formatMessage(bsl::ostream& stream, const ball::Record& record)
+    // Write the message of the specified 'record' to the specified 'stream'.
+{
+    stream << record.fixedFields().message();
+}
+
+static bsl::string makeLine(int id, int index, int length)
+    // Return a newline-terminated line of text of (at least) the specified
+    // 'length', identifying the specified 'index'th line published by the
+    // thread having the specified 'id'.
+{
+    char buffer[64];
+    snprintf(buffer, sizeof buffer, "thread %d line %d ", id, index);
+
+    bsl::string line(buffer);
+    if (static_cast<int>(line.length()) + 1 < length) {
+        line.append(length - line.length() - 1, 'a' + index % 26);
+    }
+    line += '\n';
+    return line;
+}
+
+static void publishMessage(Obj *observer, const bsl::string& message)
+    // Publish, to the specified 'observer', a record having the specified
+    // 'message' and the current time as its timestamp.
+{
+    ball::Record record;
+    record.fixedFields().setTimestamp(bdlt::CurrentTime::utc());
+    record.fixedFields().setMessage(message.c_str());
+
+    observer->publish(record, ball::Context());
+}
+
+static bool verifyLines(bsl::vector<int>   *numLines,
+                        const bsl::string&  contents)
+    // Verify that the specified 'contents' consists of lines produced by
+    // 'makeLine' and that the lines of each thread appear in order, starting
+    // from the indices in the specified 'numLines'; update 'numLines' with
+    // the number of lines of each thread seen.  Return 'true' if the
+    // verification succeeds, and 'false' otherwise.
+{
+    bsl::size_t pos = 0;
+    while (pos < contents.length()) {
+        const bsl::size_t eol = contents.find('\n', pos);
+        if (bsl::string::npos == eol) {
+            return false;                                             // RETURN
+        }
+
+        int id;
+        int index;
+        if (2 != bsl::sscanf(contents.c_str() + pos,
+                             "thread %d line %d ",
+                             &id,
+                             &index)
+         || 0 > id
+         || static_cast<int>(numLines->size()) <= id
+         || (*numLines)[id] != index) {
+            return false;                                             // RETURN
+        }
+        const bsl::size_t length = eol - pos + 1;
+        if (makeLine(id, index, static_cast<int>(length)) !=
+                                               contents.substr(pos, length)) {
+            return false;                                             // RETURN
+        }
+        ++(*numLines)[id];
+        pos = eol + 1;
+    }
+    return true;
+}
+
+                          // ====================
+                          // struct PublishThread
+                          // ====================
+
+struct PublishThread {
+    // This functor publishes a number of lines, identifying the thread and the
+    // line, to a mapped file observer.
+
+    // DATA
+    Obj *d_observer_p;  // observer (held, not owned)
+    int  d_id;          // identifies the thread in the published lines
+    int  d_numLines;    // number of lines to publish
+
+    // MANIPULATORS
+    void operator()()
+        // Publish 'd_numLines' lines to '*d_observer_p'.
+    {
+        for (int i = 0; i < d_numLines; ++i) {
+            publishMessage(d_observer_p, makeLine(d_id, i, 20 + i % 300));
+        }
+    }
+};
+
+                          // ===================
+                          // struct RotateThread
+                          // ===================
+
+struct RotateThread {
+    // This functor forces the rotation of the log file of a mapped file
+    // observer until signaled to stop.
+
+    // DATA
+    Obj               *d_observer_p;  // observer (held, not owned)
+    bsls::AtomicBool  *d_done_p;      // stop flag (held, not owned)
+
+    // MANIPULATORS
+    void operator()()
+        // Force the rotation of the log file of '*d_observer_p' every
+        // millisecond until '*d_done_p' is 'true'.
+    {
+        while (!d_done_p->load()) {
+            d_observer_p->forceRotation();
+            bslmt::ThreadUtil::microSleep(1000);
+        }
+    }
+};
+
+                           // =================
+                           // struct PerfThread
+                           // =================
+
+template <class OBSERVER>
+struct PerfThread {
+    // This functor publishes a record a number of times to an observer of the
+    // (template parameter) type 'OBSERVER'.
+
+    // DATA
+    OBSERVER            *d_observer_p;  // observer (held, not owned)
+    const ball::Record  *d_record_p;    // published record (held, not owned)
+    int                  d_numRecords;  // number of records to publish
+
+    // MANIPULATORS
+    void operator()()
+        // Publish '*d_record_p' 'd_numRecords' times to '*d_observer_p'.
+    {
+        const ball::Context context;
+        for (int i = 0; i < d_numRecords; ++i) {
+            d_observer_p->publish(*d_record_p, context);
+        }
+    }
+};
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    verbose     = argc > 2;
+    veryVerbose = argc > 3;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator defaultAllocator("default", veryVerbose);
+    bslma::Default::setDefaultAllocatorRaw(&defaultAllocator);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   Log to a file in a temporary directory instead of
+        //:   "/var/log/task".  (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nUSAGE EXAMPLE"
+                          << "\n=============" << endl;
+
+        TempDirectoryGuard tempDir;
+        const bsl::string  fileName = makeFileName(tempDir, "task.log");
+
+        {
+            ball::LoggerManagerConfiguration lmConfig;
+            lmConfig.setDefaultThresholdLevelsIfValid(ball::Severity::e_DEBUG);
+
+            ball::LoggerManagerScopedGuard guard(lmConfig);
+            ball::LoggerManager& manager = ball::LoggerManager::singleton();
+
+            bsl::shared_ptr<ball::MappedFileObserver> observer =
+                        bsl::make_shared<ball::MappedFileObserver>(16 * 1024);
+
+            // Rotate the file when its size becomes greater than or equal to
+            // 128 megabytes.
+            observer->rotateOnSize(1024 * 128);
+
+            // Rotate the file every 24 hours.
+            observer->rotateOnTimeInterval(bdlt::DatetimeInterval(1));
+
+            observer->enableFileLogging(fileName.c_str());
+
+            int rc = manager.registerObserver(observer, "default");
+            ASSERT(0 == rc);
+
+            ASSERT(observer->isFileLoggingEnabled());
+        }
+
+        ASSERT(FsUtil::exists(fileName));
+        ASSERT(0 == FsUtil::getFileSize(fileName));
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // CONCURRENT PUBLISHING
+        //
+        // Concerns:
+        //: 1 Records published concurrently by several threads are all
+        //:   written, each one contiguously, and the records published by any
+        //:   one thread appear in the order in which they were published.
+        //:
+        //: 2 No bytes other than those of the records are written, in
+        //:   particular at the boundaries of the segments.
+        //:
+        //: 3 The log file may be rotated while records are published.
+        //
+        // Plan:
+        //: 1 For a number of segment sizes, publish lines of varying lengths
+        //:   from several threads, while another thread forces the rotation
+        //:   of the log file, collecting the contents of the rotated files in
+        //:   the rotation callback.  Verify that the concatenation of the
+        //:   rotated files and the final log file consists of exactly the
+        //:   published lines, in order for each thread.  (C-1..3)
+        //
+        // Testing:
+        //   CONCURRENT PUBLISHING
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nCONCURRENT PUBLISHING"
+                          << "\n=====================" << endl;
+
+        enum { k_NUM_THREADS = 8, k_NUM_LINES = 3000 };
+
+        const int SEGMENT_SIZES[] = { 4, 16, 1024 };
+        const int NUM_SEGMENT_SIZES =
+                                  sizeof SEGMENT_SIZES / sizeof *SEGMENT_SIZES;
+
+        for (int ti = 0; ti < NUM_SEGMENT_SIZES; ++ti) {
+            for (int rotate = 0; rotate < 2; ++rotate) {
+                const int SEGMENT_SIZE = SEGMENT_SIZES[ti];
+
+                if (veryVerbose) { T_ P_(SEGMENT_SIZE) P(rotate) }
+
+                TempDirectoryGuard tempDir;
+                const bsl::string  fileName = makeFileName(tempDir, "log");
+
+                bslma::TestAllocator ta("object", veryVerbose);
+                RotationRecorder     recorder;
+                {
+                    Obj mX(SEGMENT_SIZE, &ta);
+
+                    mX.setLogFileFunctor(&formatMessage);
+                    mX.setOnFileRotationCallback(RotationCallback(&recorder));
+                    ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+                    bsls::AtomicBool   done(false);
+                    bslmt::ThreadGroup threads;
+
+                    for (int i = 0; i < k_NUM_THREADS; ++i) {
+                        PublishThread publisher = { &mX, i, k_NUM_LINES };
+                        ASSERT(0 == threads.addThread(publisher));
+                    }
+
+                    bslmt::ThreadUtil::Handle rotator;
+                    if (rotate) {
+                        RotateThread rotatorFunctor = { &mX, &done };
+                        ASSERT(0 == bslmt::ThreadUtil::create(&rotator,
+                                                              rotatorFunctor));
+                    }
+
+                    threads.joinAll();
+
+                    if (rotate) {
+                        done.store(true);
+                        bslmt::ThreadUtil::join(rotator);
+                    }
+                }
+
+                const bsl::string contents = recorder.d_contents
+                                           + readFile(fileName);
+
+                ASSERTV(SEGMENT_SIZE, rotate,
+                        bsl::string::npos == contents.find('\0'));
+
+                bsl::vector<int> numLines(k_NUM_THREADS, 0);
+                ASSERTV(SEGMENT_SIZE, rotate, verifyLines(&numLines,
+                                                          contents));
+
+                for (int i = 0; i < k_NUM_THREADS; ++i) {
+                    ASSERTV(SEGMENT_SIZE, rotate, i, numLines[i],
+                            k_NUM_LINES == numLines[i]);
+                }
+
+                for (bsl::size_t i = 0; i < recorder.d_statuses.size(); ++i) {
+                    ASSERTV(i, recorder.d_statuses[i],
+                            0 == recorder.d_statuses[i]);
+                }
+
+                if (veryVerbose) {
+                    T_ T_ P(recorder.d_statuses.size())
+                }
+            }
+        }
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // TESTING RECORD FORMATTING
+        //
+        // Concerns:
+        //: 1 By default, records are formatted by a
+        //:   'ball::RecordStringFormatter' having the default format
+        //:   specification of the component, in UTC time.
+        //:
+        //: 2 'enablePublishInLocalTime' and 'disablePublishInLocalTime'
+        //:   select between local time and UTC time for the default format.
+        //:
+        //: 3 'setLogFileFunctor' replaces the formatting of the records, while
+        //:   file logging is enabled.
+        //
+        // Plan:
+        //: 1 Publish records in each configuration, and compare the contents
+        //:   of the log file with the output of the corresponding formatter.
+        //:   (C-1..3)
+        //
+        // Testing:
+        //   void disablePublishInLocalTime();
+        //   void enablePublishInLocalTime();
+        //   void setLogFileFunctor(const LogRecordFunctor& logFileFunctor);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING RECORD FORMATTING"
+                          << "\n=========================" << endl;
+
+        TempDirectoryGuard tempDir;
+        const bsl::string  fileName = makeFileName(tempDir, "log");
+
+        ball::Record record;
+        record.fixedFields().setTimestamp(bdlt::CurrentTime::utc());
+        record.fixedFields().setMessage("formatted message");
+        record.fixedFields().setSeverity(ball::Severity::e_WARN);
+        record.fixedFields().setFileName("ball_mappedfileobserver.t.cpp");
+        record.fixedFields().setLineNumber(__LINE__);
+        record.fixedFields().setCategory("TEST.CATEGORY");
+
+        const ball::RecordStringFormatter utcFormatter(k_DEFAULT_FORMAT,
+                                                       false);
+        const ball::RecordStringFormatter localFormatter(k_DEFAULT_FORMAT,
+                                                         true);
+
+        bsl::ostringstream expected;
+
+        bslma::TestAllocator ta("object", veryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+            mX.publish(record, ball::Context());
+            utcFormatter(expected, record);
+
+            mX.enablePublishInLocalTime();
+            ASSERT(true == X.isPublishInLocalTimeEnabled());
+
+            mX.publish(record, ball::Context());
+            localFormatter(expected, record);
+
+            mX.disablePublishInLocalTime();
+            ASSERT(false == X.isPublishInLocalTimeEnabled());
+
+            mX.publish(record, ball::Context());
+            utcFormatter(expected, record);
+
+            mX.setLogFileFunctor(&formatMessage);
+
+            mX.publish(record, ball::Context());
+            formatMessage(expected, record);
+
+            mX.setLogFileFunctor(
+                           ball::RecordStringFormatter("%m|%s\n", false, &ta));
+
+            mX.publish(record, ball::Context());
+            expected << "formatted message|WARN\n";
+
+            mX.disableFileLogging();
+        }
+
+        ASSERTV(expected.str(), readFile(fileName),
+                expected.str() == readFile(fileName));
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING ROTATION ON TIME INTERVAL
+        //
+        // Concerns:
+        //: 1 'rotateOnTimeInterval' rotates the log file once the interval
+        //:   has elapsed, upon the publication of a record.
+        //:
+        //: 2 The reference start time of the schedule is honored.
+        //:
+        //: 3 'disableTimeIntervalRotation' disables the rotation.
+        //
+        // Plan:
+        //: 1 Configure a rotation interval of one second, publish records
+        //:   before and after the interval elapses, and verify the
+        //:   invocations of the rotation callback and the contents of the
+        //:   rotated log file.  (C-1)
+        //:
+        //: 2 Configure a schedule of one hour whose reference time is a few
+        //:   seconds in the past modulo one hour, and verify that the log
+        //:   file is rotated when the reference time recurs.  (C-2)
+        //:
+        //: 3 Disable the rotation and verify that the log file is not
+        //:   rotated.  (C-3)
+        //
+        // Testing:
+        //   void rotateOnTimeInterval(const DatetimeInterval& interval);
+        //   void rotateOnTimeInterval(const DtInterval&, const Datetime&);
+        //   void disableTimeIntervalRotation();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING ROTATION ON TIME INTERVAL"
+                          << "\n=================================" << endl;
+
+        TempDirectoryGuard tempDir;
+        const bsl::string  fileName = makeFileName(tempDir, "log");
+
+        RotationRecorder recorder;
+        Obj              mX;  const Obj& X = mX;
+
+        mX.setLogFileFunctor(&formatMessage);
+        mX.setOnFileRotationCallback(RotationCallback(&recorder));
+
+        if (verbose) cout << "\tRotation interval." << endl;
+        {
+            mX.rotateOnTimeInterval(bdlt::DatetimeInterval(0, 0, 0, 1));
+            ASSERT(bdlt::DatetimeInterval(0, 0, 0, 1) == X.rotationLifetime());
+
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+            publishMessage(&mX, "first\n");
+            ASSERT(0 == recorder.d_statuses.size());
+
+            bslmt::ThreadUtil::microSleep(0, 2);
+
+            publishMessage(&mX, "second\n");
+            ASSERTV(recorder.d_statuses.size(),
+                    1 == recorder.d_statuses.size());
+            ASSERTV(recorder.d_contents, "first\n" == recorder.d_contents);
+
+            mX.disableFileLogging();
+            ASSERT("second\n" == readFile(fileName));
+            ASSERT(0 == FsUtil::remove(fileName));
+        }
+
+        if (verbose) cout << "\tReference start time." << endl;
+        {
+            recorder.d_statuses.clear();
+            recorder.d_contents.clear();
+
+            // The schedule recurs every hour, 3 seconds after the time, modulo
+            // one hour, at which logging is enabled.
+
+            const bdlt::Datetime now = bdlt::CurrentTime::local();
+            mX.rotateOnTimeInterval(bdlt::DatetimeInterval(0, 1),
+                                    now
+                                  - bdlt::DatetimeInterval(0, 1)
+                                  + bdlt::DatetimeInterval(0, 0, 0, 3));
+
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+            publishMessage(&mX, "first\n");
+            ASSERT(0 == recorder.d_statuses.size());
+
+            bslmt::ThreadUtil::microSleep(0, 4);
+
+            publishMessage(&mX, "second\n");
+            ASSERTV(recorder.d_statuses.size(),
+                    1 == recorder.d_statuses.size());
+            ASSERTV(recorder.d_contents, "first\n" == recorder.d_contents);
+
+            mX.disableFileLogging();
+            ASSERT(0 == FsUtil::remove(fileName));
+        }
+
+        if (verbose) cout << "\tDisabling the rotation." << endl;
+        {
+            recorder.d_statuses.clear();
+            recorder.d_contents.clear();
+
+            mX.rotateOnTimeInterval(bdlt::DatetimeInterval(0, 0, 0, 1));
+            mX.disableTimeIntervalRotation();
+            ASSERT(bdlt::DatetimeInterval() == X.rotationLifetime());
+
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+            publishMessage(&mX, "first\n");
+            bslmt::ThreadUtil::microSleep(0, 2);
+            publishMessage(&mX, "second\n");
+
+            ASSERT(0 == recorder.d_statuses.size());
+
+            mX.disableFileLogging();
+            ASSERT("first\nsecond\n" == readFile(fileName));
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING ROTATION ON SIZE AND FORCED ROTATION
+        //
+        // Concerns:
+        //: 1 'rotateOnSize' rotates the log file once its size exceeds the
+        //:   configured size, upon the publication of a record, including
+        //:   when the rotation is due at the end of a segment.
+        //:
+        //: 2 Rotated log files contain exactly the records written to them.
+        //:
+        //: 3 'disableSizeRotation' disables the rotation.
+        //:
+        //: 4 'forceRotation' rotates the log file, and invokes the rotation
+        //:   callback with the name of the rotated file; it has no effect if
+        //:   file logging is disabled.
+        //:
+        //: 5 The rotated log file is renamed with a timestamp suffix if the
+        //:   new log file has the same name.
+        //
+        // Plan:
+        //: 1 Configure a rotation size of one kilobyte, and publish records
+        //:   of a few hundred bytes, collecting the contents of the rotated
+        //:   files in the rotation callback.  Verify the sizes of the rotated
+        //:   files and that the records are all written.  Repeat with a
+        //:   segment size that is smaller than the rotation size.
+        //:   (C-1..2)
+        //:
+        //: 2 Disable the rotation and verify that the log file is no longer
+        //:   rotated.  (C-3)
+        //:
+        //: 3 Force the rotation of the log file with file logging enabled
+        //:   and disabled, and verify the invocations of the callback.
+        //:   (C-4..5)
+        //
+        // Testing:
+        //   void disableSizeRotation();
+        //   void forceRotation();
+        //   void rotateOnSize(int size);
+        //   void setOnFileRotationCallback(const OnFileRotationCallback&);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING ROTATION ON SIZE AND FORCED ROTATION"
+                          << "\n============================================"
+                          << endl;
+
+        enum { k_NUM_LINES = 200, k_LINE_LENGTH = 150, k_ROTATION_SIZE = 4 };
+
+        const int SEGMENT_SIZES[] = { 1, 4, 64 };
+        const int NUM_SEGMENT_SIZES =
+                                  sizeof SEGMENT_SIZES / sizeof *SEGMENT_SIZES;
+
+        for (int ti = 0; ti < NUM_SEGMENT_SIZES; ++ti) {
+            const int SEGMENT_SIZE = SEGMENT_SIZES[ti];
+
+            if (veryVerbose) { T_ P(SEGMENT_SIZE) }
+
+            TempDirectoryGuard tempDir;
+            const bsl::string  fileName = makeFileName(tempDir, "log");
+
+            RotationRecorder recorder;
+            Obj              mX(SEGMENT_SIZE);  const Obj& X = mX;
+
+            mX.setLogFileFunctor(&formatMessage);
+            mX.setOnFileRotationCallback(RotationCallback(&recorder));
+            mX.rotateOnSize(k_ROTATION_SIZE);
+            ASSERT(k_ROTATION_SIZE == X.rotationSize());
+
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+            bsl::string expected;
+            for (int i = 0; i < k_NUM_LINES; ++i) {
+                const bsl::string line = makeLine(0, i, k_LINE_LENGTH);
+                publishMessage(&mX, line);
+                expected += line;
+
+                // Verify the size of the last rotated file.
+
+                if (recorder.d_statuses.size() && i % 30 == 0) {
+                    const Int64 size = recorder.d_contents.length();
+                    ASSERTV(SEGMENT_SIZE, i, size,
+                            k_ROTATION_SIZE * 1024 < size);
+                }
+            }
+
+            const bsl::size_t numRotations = recorder.d_statuses.size();
+
+            // Each rotated file holds more than 'k_ROTATION_SIZE' kilobytes,
+            // and at most one line more than that.
+
+            const bsl::size_t LINES_PER_FILE =
+                                 k_ROTATION_SIZE * 1024 / k_LINE_LENGTH + 1;
+            ASSERTV(SEGMENT_SIZE, numRotations,
+                    numRotations >= k_NUM_LINES / (LINES_PER_FILE + 1) - 1);
+            ASSERTV(SEGMENT_SIZE, numRotations,
+                    numRotations <= k_NUM_LINES / LINES_PER_FILE);
+
+            for (bsl::size_t i = 0; i < numRotations; ++i) {
+                ASSERTV(i, 0 == recorder.d_statuses[i]);
+                const bsl::string& NAME = recorder.d_names[i];
+                ASSERTV(i, NAME,
+                        fileName + "." == NAME.substr(0,
+                                                      fileName.length() + 1));
+            }
+
+            mX.disableSizeRotation();
+            ASSERT(0 == X.rotationSize());
+
+            for (int i = k_NUM_LINES; i < 2 * k_NUM_LINES; ++i) {
+                const bsl::string line = makeLine(0, i, k_LINE_LENGTH);
+                publishMessage(&mX, line);
+                expected += line;
+            }
+            ASSERT(numRotations == recorder.d_statuses.size());
+
+            mX.forceRotation();
+            ASSERT(numRotations + 1 == recorder.d_statuses.size());
+            ASSERT(0 == recorder.d_statuses.back());
+            ASSERT(expected == recorder.d_contents);
+
+            mX.disableFileLogging();
+            ASSERT(false == X.isFileLoggingEnabled());
+
+            ASSERT(FsUtil::exists(fileName));
+            ASSERT(0 == FsUtil::getFileSize(fileName));
+
+            mX.forceRotation();
+            ASSERT(numRotations + 1 == recorder.d_statuses.size());
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // WRITING RECORDS ACROSS SEGMENTS
+        //
+        // Concerns:
+        //: 1 Records are written contiguously across segments, without
+        //:   intervening bytes, whatever their lengths relative to the
+        //:   segment size, including records that are larger than a segment
+        //:   and records larger than the formatting buffer on the stack.
+        //:
+        //: 2 While file logging is enabled, the log file is extended to cover
+        //:   its mapped segment; the file is truncated to the size of its
+        //:   records when file logging is disabled.
+        //:
+        //: 3 Records are appended to an existing log file.
+        //
+        // Plan:
+        //: 1 For a number of segment sizes, publish records of lengths that
+        //:   vary from 1 byte to several segments, check the size of the
+        //:   log file while it is open, disable file logging, and compare the
+        //:   contents of the log file with the published records.  Enable
+        //:   file logging again, publish more records, and verify that they
+        //:   are appended to the file.  (C-1..3)
+        //
+        // Testing:
+        //   WRITING RECORDS ACROSS SEGMENTS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nWRITING RECORDS ACROSS SEGMENTS"
+                          << "\n===============================" << endl;
+
+        const int SEGMENT_SIZES[] = { 1, 4, 8, 64 };
+        const int NUM_SEGMENT_SIZES =
+                                  sizeof SEGMENT_SIZES / sizeof *SEGMENT_SIZES;
+
+        const int LENGTHS[] = { 1, 2, 100, 511, 512, 513, 1000, 4095, 4096,
+                                4097, 10000, 70000, 300 * 1024 };
+        const int NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+
+        const Int64 PAGE_SIZE = bdls::MemoryUtil::pageSize();
+
+        for (int ti = 0; ti < NUM_SEGMENT_SIZES; ++ti) {
+            const int SEGMENT_SIZE = SEGMENT_SIZES[ti];
+
+            if (veryVerbose) { T_ P(SEGMENT_SIZE) }
+
+            TempDirectoryGuard tempDir;
+            const bsl::string  fileName = makeFileName(tempDir, "log");
+
+            bslma::TestAllocator ta("object", veryVerbose);
+            bsl::string          expected;
+            {
+                Obj mX(SEGMENT_SIZE, &ta);
+
+                mX.setLogFileFunctor(&formatMessage);
+
+                for (int pass = 0; pass < 2; ++pass) {
+                    ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+                    for (int i = 0; i < 3; ++i) {
+                        for (int tj = 0; tj < NUM_LENGTHS; ++tj) {
+                            const bsl::string line =
+                                                 makeLine(pass,
+                                                          i * NUM_LENGTHS + tj,
+                                                          LENGTHS[tj]);
+                            publishMessage(&mX, line);
+                            expected += line;
+                        }
+                    }
+
+                    const Int64 size = FsUtil::getFileSize(fileName);
+                    ASSERTV(SEGMENT_SIZE, size, expected.length(),
+                            static_cast<Int64>(expected.length()) < size);
+                    ASSERTV(SEGMENT_SIZE, size, 0 == size % PAGE_SIZE);
+
+                    mX.disableFileLogging();
+
+                    const bsl::string contents = readFile(fileName);
+                    ASSERTV(SEGMENT_SIZE, pass, contents.length(),
+                            expected.length(),
+                            expected == contents);
+                }
+            }
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING CREATORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 An observer is created with the specified (or default) segment
+        //:   size, with file logging disabled, rotation disabled, and UTC
+        //:   timestamps.
+        //:
+        //: 2 The object allocator is used to supply memory, and the default
+        //:   allocator is not used.
+        //:
+        //: 3 'releaseRecords' has no effect.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create observers with each constructor, and verify their
+        //:   configuration through the accessors.  (C-1)
+        //:
+        //: 2 Enable file logging, publish a record, and verify that no memory
+        //:   is supplied by the default allocator.  (C-2..3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid argument values.  (C-4)
+        //
+        // Testing:
+        //   MappedFileObserver(bslma::Allocator *basicAllocator = 0);
+        //   MappedFileObserver(int segmentSize, bslma::Allocator * = 0);
+        //   ~MappedFileObserver();
+        //   void releaseRecords();
+        //   bool isPublishInLocalTimeEnabled() const;
+        //   bdlt::DatetimeInterval rotationLifetime() const;
+        //   int rotationSize() const;
+        //   int segmentSize() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING CREATORS AND ACCESSORS"
+                          << "\n==============================" << endl;
+
+        TempDirectoryGuard tempDir;
+        const bsl::string  fileName = makeFileName(tempDir, "log");
+
+        bslma::TestAllocator ta("object", veryVerbose);
+        {
+            const Int64 numDefaultBlocks = defaultAllocator.numBlocksTotal();
+
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERT(Obj::k_DEFAULT_SEGMENT_SIZE == X.segmentSize());
+            ASSERT(false                       == X.isFileLoggingEnabled());
+            ASSERT(false                  == X.isPublishInLocalTimeEnabled());
+            ASSERT(0                           == X.rotationSize());
+            ASSERT(bdlt::DatetimeInterval()    == X.rotationLifetime());
+
+            Obj mY(64, &ta);  const Obj& Y = mY;
+
+            ASSERT(64    == Y.segmentSize());
+            ASSERT(false == Y.isFileLoggingEnabled());
+
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+            ASSERT(1 == mX.enableFileLogging(fileName.c_str()));
+
+            ball::Record record(&ta);
+            record.fixedFields().setTimestamp(bdlt::CurrentTime::utc());
+            record.fixedFields().setMessage("message");
+
+            mX.publish(record, ball::Context(&ta));
+            mX.releaseRecords();
+
+            mX.disableFileLogging();
+
+            ASSERTV(defaultAllocator.numBlocksTotal() - numDefaultBlocks,
+                    numDefaultBlocks == defaultAllocator.numBlocksTotal());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_FAIL(Obj(0));
+            ASSERT_PASS(Obj(1));
+
+            Obj mX;
+
+            ASSERT_FAIL(mX.enableFileLogging(0));
+
+            ASSERT_FAIL(mX.rotateOnSize(0));
+            ASSERT_PASS(mX.rotateOnSize(1));
+
+            ASSERT_FAIL(mX.rotateOnTimeInterval(bdlt::DatetimeInterval()));
+            ASSERT_PASS(mX.rotateOnTimeInterval(
+                                         bdlt::DatetimeInterval(0, 0, 0, 1)));
+
+            bsl::string *nullString = 0;
+            ASSERT_FAIL(mX.isFileLoggingEnabled(nullString));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Enable file logging, publish a few records (through both
+        //:   'publish' overloads), disable file logging, and compare the
+        //:   contents of the log file with the records formatted with the
+        //:   default format.  Verify that records published while file
+        //:   logging is disabled are discarded.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        //   void disableFileLogging();
+        //   int enableFileLogging(const char *logFilenamePattern);
+        //   void publish(const Record& record, const Context& context);
+        //   void publish(const shared_ptr<const Record>&, const Context&);
+        //   bool isFileLoggingEnabled() const;
+        //   bool isFileLoggingEnabled(bsl::string *result) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nBREATHING TEST"
+                          << "\n==============" << endl;
+
+        TempDirectoryGuard tempDir;
+        const bsl::string  fileName = makeFileName(tempDir, "log");
+
+        const ball::RecordStringFormatter formatter(k_DEFAULT_FORMAT, false);
+        bsl::ostringstream                expected;
+
+        Obj mX;  const Obj& X = mX;
+
+        bsl::string name;
+        ASSERT(false == X.isFileLoggingEnabled());
+        ASSERT(false == X.isFileLoggingEnabled(&name));
+
+        publishMessage(&mX, "discarded");
+
+        ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+        ASSERT(true == X.isFileLoggingEnabled());
+        ASSERT(true == X.isFileLoggingEnabled(&name));
+        ASSERTV(name, fileName == name);
+
+        for (int i = 0; i < 3; ++i) {
+            bsl::shared_ptr<ball::Record> record =
+                                            bsl::make_shared<ball::Record>();
+            record->fixedFields().setTimestamp(bdlt::CurrentTime::utc());
+            record->fixedFields().setMessage("Hello, world!");
+            record->fixedFields().setSeverity(ball::Severity::e_INFO);
+            record->fixedFields().setLineNumber(i);
+
+            if (i % 2) {
+                mX.publish(*record, ball::Context());
+            }
+            else {
+                mX.publish(record, ball::Context());
+            }
+            formatter(expected, *record);
+        }
+
+        mX.disableFileLogging();
+        ASSERT(false == X.isFileLoggingEnabled());
+
+        publishMessage(&mX, "discarded");
+
+        ASSERTV(expected.str(), readFile(fileName),
+                expected.str() == readFile(fileName));
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: MAPPED FILE OBSERVER VS. FILE OBSERVER
+        //
+        // Concerns:
+        //: 1 Publishing records concurrently to a mapped file observer is
+        //:   substantially cheaper than publishing them to a
+        //:   'ball::FileObserver2'.
+        //
+        // Plan:
+        //: 1 Measure the time taken by a number of threads to publish a large
+        //:   number of records to each observer, formatted by the same
+        //:   functor.
+        //
+        // Testing:
+        //   PERFORMANCE: MAPPED FILE OBSERVER VS. FILE OBSERVER
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: MAPPED FILE OBSERVER VS. FILE "
+                             "OBSERVER"
+                          << endl
+                          << "==========================================="
+                             "========"
+                          << endl;
+
+        enum { k_NUM_RECORDS = 400 * 1000 };
+
+        const int NUM_THREADS[] = { 1, 4, 8 };
+        const int NUM_CONFIGS   = sizeof NUM_THREADS / sizeof *NUM_THREADS;
+
+        TempDirectoryGuard tempDir;
+        const bsl::string  message(
+                              "order 1001 executed at 99.5000 (IBM) for 100 "
+                              "shares on behalf of client 4242\n");
+
+        ball::Record record;
+        record.fixedFields().setTimestamp(bdlt::CurrentTime::utc());
+        record.fixedFields().setMessage(message.c_str());
+
+        for (int ti = 0; ti < NUM_CONFIGS; ++ti) {
+            const int THREADS    = NUM_THREADS[ti];
+            const int PER_THREAD = k_NUM_RECORDS / THREADS;
+
+            const bsl::string fileName1 = makeFileName(tempDir, "file");
+            const bsl::string fileName2 = makeFileName(tempDir, "mapped");
+
+            Int64 fileTime;
+            {
+                ball::FileObserver2 observer;
+                observer.setLogFileFunctor(&formatMessage);
+                ASSERT(0 == observer.enableFileLogging(fileName1.c_str()));
+
+                bslmt::ThreadGroup threads;
+                const Int64        start = bsls::TimeUtil::getTimer();
+                for (int i = 0; i < THREADS; ++i) {
+                    PerfThread<ball::FileObserver2> publisher =
+                                            { &observer, &record, PER_THREAD };
+                    ASSERT(0 == threads.addThread(publisher));
+                }
+                threads.joinAll();
+                fileTime = bsls::TimeUtil::getTimer() - start;
+            }
+
+            Int64 mappedTime;
+            {
+                Obj observer;
+                observer.setLogFileFunctor(&formatMessage);
+                ASSERT(0 == observer.enableFileLogging(fileName2.c_str()));
+
+                bslmt::ThreadGroup threads;
+                const Int64        start = bsls::TimeUtil::getTimer();
+                for (int i = 0; i < THREADS; ++i) {
+                    PerfThread<Obj> publisher =
+                                            { &observer, &record, PER_THREAD };
+                    ASSERT(0 == threads.addThread(publisher));
+                }
+                threads.joinAll();
+                mappedTime = bsls::TimeUtil::getTimer() - start;
+            }
+
+            ASSERT(FsUtil::getFileSize(fileName1) ==
+                                              FsUtil::getFileSize(fileName2));
+
+            cout << THREADS << " thread(s):" << endl
+                 << "    ball::FileObserver2:      "
+                 << fileTime / k_NUM_RECORDS << " ns/record" << endl
+                 << "    ball::MappedFileObserver: "
+                 << mappedTime / k_NUM_RECORDS << " ns/record" << endl;
+
+            FsUtil::remove(fileName1);
+            FsUtil::remove(fileName2);
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -13,6 +13,23 @@
 // significant performance overhead.  For this reason, the 'operator()' method
 // is implemented by writing the formatted string to a buffer before inserting
 // to a stream.
+//
+// The format specification is compiled, whenever it is set, into a sequence of
+// 'RecordStringFormatter_Field' objects: conversion specifications become
+// fields naming the record attribute to render, and each run of literal text
+// (with its escape sequences already interpolated) becomes a single field
+// referring to a range of 'd_literals', so that 'operator()' need not
+// re-interpret the specification for every record.
+//
+// Rendering a timestamp through 'bdlt' is the single most expensive step of
+// formatting a typical record.  Records are usually formatted in timestamp
+// order, and many records share the same second, so the rendering of the date
+// and time up to the second (and of the time zone) is cached in a
+// 'RecordStringFormatter_TimestampCache', and only the fractional-second
+// digits are rendered for each record.  'operator()' is 'const' and may be
+// called from several threads at once, so the cache is guarded by a mutex
+// that is only ever *tried*: a thread that fails to acquire it renders the
+// timestamp into a cache of its own rather than waiting.
 
 #include <ball_recordstringformatter.h>
 
@@ -29,22 +46,23 @@ BSLS_IDENT_RCSID(ball_recordstringformatter_cpp,"$Id$ $CSID$")
 
 #include <bdlma_bufferedsequentialallocator.h>
 
-#include <bdlt_datetime.h>
 #include <bdlt_currenttime.h>
+#include <bdlt_datetimetz.h>
 #include <bdlt_localtimeoffset.h>
 #include <bdlt_iso8601util.h>
 #include <bdlt_iso8601utilconfiguration.h>
+#include <bdlt_time.h>
+
+#include <bslmt_lockguard.h>
 
 #include <bsls_annotation.h>
+#include <bsls_assert.h>
 #include <bsls_platform.h>
 #include <bsls_types.h>
 
-#include <bslstl_stringref.h>
-
 #include <bsl_climits.h>   // for 'INT_MAX'
 #include <bsl_cstring.h>   // for 'bsl::strcmp'
 #include <bsl_c_stdlib.h>
-#include <bsl_c_stdio.h>   // for 'snprintf'
 
 #include <bsl_iomanip.h>
 #include <bsl_ostream.h>
@@ -59,65 +77,180 @@ const char *const DEFAULT_FORMAT_SPEC = "\n%d %p:%t %s %f:%l %c %m %u\n";
 namespace BloombergLP {
 
 // STATIC HELPER FUNCTIONS
-static void appendToString(bsl::string *result, int value)
+static void appendToString(bsl::string *result, bsls::Types::Uint64 value)
     // Convert the specified 'value' into ASCII characters and append it to the
     // specified 'result.
 {
-    char buffer[16];
+    char  buffer[24];
+    char *end = buffer + sizeof buffer;
+    char *p   = end;
 
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#define snprintf _snprintf
-#endif
+    do {
+        *--p   = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (0 != value);
 
-    snprintf(buffer, sizeof buffer, "%d", value);
-
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#undef snprintf
-#endif
-
-    *result += buffer;
+    result->append(p, end);
 }
 
-static void appendToString(bsl::string *result, bsls::Types::Uint64 value)
+static void appendToString(bsl::string *result, int value)
     // Convert the specified 'value' into ASCII characters and append it to the
     // specified 'result.
 {
-    char buffer[32];
+    if (value < 0) {
+        *result += '-';
+        appendToString(result,
+                       static_cast<bsls::Types::Uint64>(
+                                    -static_cast<bsls::Types::Int64>(value)));
+    }
+    else {
+        appendToString(result, static_cast<bsls::Types::Uint64>(value));
+    }
+}
 
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#define snprintf _snprintf
-#endif
+static void appendToStringAsHex(bsl::string *result, bsls::Types::Uint64 value)
+    // Convert the specified 'value' into hexadecimal and append it to the
+    // specified 'result'.
+{
+    static const char k_DIGITS[] = "0123456789ABCDEF";
 
-    snprintf(buffer, sizeof buffer, "%llu", value);
+    char  buffer[24];
+    char *end = buffer + sizeof buffer;
+    char *p   = end;
 
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#undef snprintf
-#endif
+    do {
+        *--p    = k_DIGITS[value & 0xF];
+        value >>= 4;
+    } while (0 != value);
 
-    *result += buffer;
+    result->append(p, end);
 }
 
-static void appendToStringAsHex(bsl::string *result, bsls::Types::Uint64 value)
-    // Convert the specified 'value' into hexadecimal and append it to the
-    // specified 'result'.
+static void appendFractionalSeconds(bsl::string           *result,
+                                    const bdlt::Datetime&  datetime,
+                                    int                    precision)
+    // Append to the specified 'result' a '.' followed by the specified
+    // 'precision' most significant fractional-second digits of the specified
+    // 'datetime'.  The behavior is undefined unless 'precision' is 3 or 6.
 {
-    char buffer[32];
+    BSLS_ASSERT(3 == precision || 6 == precision);
 
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#define snprintf _snprintf
-#endif
+    const int millisecond = datetime.millisecond();
 
-    snprintf(buffer, sizeof(buffer), "%llX", value);
+    char buffer[8];
+    buffer[0] = '.';
+    buffer[1] = static_cast<char>('0' + millisecond / 100);
+    buffer[2] = static_cast<char>('0' + millisecond / 10 % 10);
+    buffer[3] = static_cast<char>('0' + millisecond % 10);
 
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#undef snprintf
-#endif
+    if (6 == precision) {
+        const int microsecond = datetime.microsecond();
+
+        buffer[4] = static_cast<char>('0' + microsecond / 100);
+        buffer[5] = static_cast<char>('0' + microsecond / 10 % 10);
+        buffer[6] = static_cast<char>('0' + microsecond % 10);
+    }
+
+    result->append(buffer, 1 + precision);
+}
+
+static void appendLiteralField(
+                   bsl::vector<ball::RecordStringFormatter_Field> *fields,
+                   int                                            *runStart,
+                   const bsl::string&                              literals)
+    // Append to the specified 'fields' a literal field for the characters of
+    // the specified 'literals' from the specified 'runStart' offset to its
+    // end, if there are any, and set 'runStart' to the length of 'literals'.
+{
+    typedef ball::RecordStringFormatter_Field Field;
+
+    const int length = static_cast<int>(literals.length());
+
+    if (*runStart < length) {
+        Field field = { Field::e_LITERAL, *runStart, length - *runStart };
+        fields->push_back(field);
+    }
+    *runStart = length;
+}
 
-    *result += buffer;
+static int conversionType(ball::RecordStringFormatter_Field::Type *result,
+                          char                                     conversion)
+    // Load into the specified 'result' the type of the field described by the
+    // specified 'conversion' character of a '%'-prefixed conversion
+    // specification.  Return 0 on success, and a non-zero value (with no
+    // effect on 'result') if 'conversion' is not recognized.
+{
+    typedef ball::RecordStringFormatter_Field Field;
+
+    switch (conversion) {
+      case 'd': *result = Field::e_DATETIME;                          break;
+      case 'D': *result = Field::e_DATETIME_MICROSECONDS;             break;
+      case 'i': *result = Field::e_ISO8601;                           break;
+      case 'I': *result = Field::e_ISO8601_MILLISECONDS;              break;
+      case 'O': *result = Field::e_ISO8601_MICROSECONDS;              break;
+      case 'p': *result = Field::e_PROCESS_ID;                        break;
+      case 't': *result = Field::e_THREAD_ID;                         break;
+      case 'T': *result = Field::e_THREAD_ID_HEX;                     break;
+      case 's': *result = Field::e_SEVERITY;                          break;
+      case 'f': *result = Field::e_FILE;                              break;
+      case 'F': *result = Field::e_FILE_BASENAME;                     break;
+      case 'l': *result = Field::e_LINE;                              break;
+      case 'c': *result = Field::e_CATEGORY;                          break;
+      case 'm': *result = Field::e_MESSAGE;                           break;
+      case 'x': *result = Field::e_MESSAGE_PRINTABLE;                 break;
+      case 'X': *result = Field::e_MESSAGE_HEX;                       break;
+      case 'u': *result = Field::e_USER_FIELDS;                       break;
+      default: {
+        return -1;                                                    // RETURN
+      }
+    }
+    return 0;
 }
 
 namespace ball {
 
+                 // ------------------------------------------
+                 // class RecordStringFormatter_TimestampCache
+                 // ------------------------------------------
+
+// MANIPULATORS
+void RecordStringFormatter_TimestampCache::update(
+                                         const bdlt::Datetime& localDatetime,
+                                         int                   offset)
+{
+    const bdlt::Datetime second(localDatetime.date(),
+                                bdlt::Time(localDatetime.hour(),
+                                           localDatetime.minute(),
+                                           localDatetime.second()));
+
+    if (d_isValid && second == d_second && offset == d_offset) {
+        return;                                                       // RETURN
+    }
+
+    char buffer[bdlt::Iso8601Util::k_DATETIMETZ_STRLEN + 1];
+
+    int length = second.printToBuffer(buffer, sizeof buffer, 0);
+    BSLS_ASSERT(k_DATETIME_LENGTH == length);
+    bsl::memcpy(d_datetime, buffer, k_DATETIME_LENGTH);
+
+    bdlt::Iso8601UtilConfiguration config;
+    config.setFractionalSecondPrecision(0);
+    config.setUseZAbbreviationForUtc(true);
+
+    length = bdlt::Iso8601Util::generateRaw(buffer,
+                                            bdlt::DatetimeTz(second, offset),
+                                            config);
+    BSLS_ASSERT(k_ISO8601_LENGTH < length);
+    BSLS_ASSERT(length - k_ISO8601_LENGTH <= k_ISO8601_TZ_CAPACITY);
+    bsl::memcpy(d_iso8601, buffer, k_ISO8601_LENGTH);
+    d_iso8601TzLength = length - k_ISO8601_LENGTH;
+    bsl::memcpy(d_iso8601Tz, buffer + k_ISO8601_LENGTH, d_iso8601TzLength);
+
+    d_second  = second;
+    d_offset  = offset;
+    d_isValid = true;
+}
+
                         // ---------------------------
                         // class RecordStringFormatter
                         // ---------------------------
@@ -134,14 +267,20 @@ const int RecordStringFormatter::k_DISABLE_PUBLISH_IN_LOCALTIME = INT_MIN;
 RecordStringFormatter::RecordStringFormatter(bslma::Allocator *basicAllocator)
 : d_formatSpec(DEFAULT_FORMAT_SPEC, basicAllocator)
 , d_timestampOffset(0)
+, d_fields(basicAllocator)
+, d_literals(basicAllocator)
 {
+    compileFormat();
 }
 
 RecordStringFormatter::RecordStringFormatter(const char       *format,
                                              bslma::Allocator *basicAllocator)
 : d_formatSpec(format, basicAllocator)
 , d_timestampOffset(0)
+, d_fields(basicAllocator)
+, d_literals(basicAllocator)
 {
+    compileFormat();
 }
 
 RecordStringFormatter::RecordStringFormatter(
@@ -149,7 +288,10 @@ RecordStringFormatter::RecordStringFormatter(
                                  bslma::Allocator              *basicAllocator)
 : d_formatSpec(DEFAULT_FORMAT_SPEC, basicAllocator)
 , d_timestampOffset(offset)
+, d_fields(basicAllocator)
+, d_literals(basicAllocator)
 {
+    compileFormat();
 }
 
 RecordStringFormatter::RecordStringFormatter(
@@ -163,7 +305,10 @@ RecordStringFormatter::RecordStringFormatter(
                     publishInLocalTime
                     ?  k_ENABLE_PUBLISH_IN_LOCALTIME
                     : k_DISABLE_PUBLISH_IN_LOCALTIME)
+, d_fields(basicAllocator)
+, d_literals(basicAllocator)
 {
+    compileFormat();
 }
 
 RecordStringFormatter::RecordStringFormatter(
@@ -172,7 +317,10 @@ RecordStringFormatter::RecordStringFormatter(
                                  bslma::Allocator              *basicAllocator)
 : d_formatSpec(format, basicAllocator)
 , d_timestampOffset(offset)
+, d_fields(basicAllocator)
+, d_literals(basicAllocator)
 {
+    compileFormat();
 }
 
 RecordStringFormatter::RecordStringFormatter(
@@ -187,7 +335,10 @@ RecordStringFormatter::RecordStringFormatter(
                     publishInLocalTime
                     ?  k_ENABLE_PUBLISH_IN_LOCALTIME
                     : k_DISABLE_PUBLISH_IN_LOCALTIME)
+, d_fields(basicAllocator)
+, d_literals(basicAllocator)
 {
+    compileFormat();
 }
 
 RecordStringFormatter::RecordStringFormatter(
@@ -195,9 +346,82 @@ RecordStringFormatter::RecordStringFormatter(
                                   bslma::Allocator             *basicAllocator)
 : d_formatSpec(original.d_formatSpec, basicAllocator)
 , d_timestampOffset(original.d_timestampOffset)
+, d_fields(original.d_fields, basicAllocator)
+, d_literals(original.d_literals, basicAllocator)
 {
 }
 
+// PRIVATE MANIPULATORS
+void RecordStringFormatter::compileFormat()
+{
+    bsl::vector<Field> fields(d_fields.get_allocator());
+    bsl::string        literals(d_literals.get_allocator());
+    int                runStart = 0;  // start of current run of literal text
+
+    const char *iter = d_formatSpec.data();
+    const char *end  = iter + d_formatSpec.length();
+
+    while (iter != end) {
+        switch (*iter) {
+          case '%': {
+            if (++iter == end) {
+                break;
+            }
+
+            Field::Type type;
+
+            if ('%' == *iter) {
+                literals += '%';
+            }
+            else if (0 == conversionType(&type, *iter)) {
+                appendLiteralField(&fields, &runStart, literals);
+
+                Field field = { type, 0, 0 };
+                fields.push_back(field);
+            }
+            else {
+                // Undefined: we just output the verbatim characters.
+
+                literals += '%';
+                literals += *iter;
+            }
+            ++iter;
+          } break;
+          case '\\': {
+            if (++iter == end) {
+                break;
+            }
+            switch (*iter) {
+              case 'n': {
+                literals += '\n';
+              } break;
+              case 't': {
+                literals += '\t';
+              } break;
+              case '\\': {
+                literals += '\\';
+              } break;
+              default: {
+                // Undefined: we just output the verbatim characters.
+
+                literals += '\\';
+                literals += *iter;
+              }
+            }
+            ++iter;
+          } break;
+          default: {
+            literals += *iter;
+            ++iter;
+          }
+        }
+    }
+    appendLiteralField(&fields, &runStart, literals);
+
+    d_fields.swap(fields);
+    d_literals.swap(literals);
+}
+
 // MANIPULATORS
 RecordStringFormatter& RecordStringFormatter::operator=(
                                               const RecordStringFormatter& rhs)
@@ -205,37 +429,42 @@ RecordStringFormatter& RecordStringFormatter::operator=(
     if (this != &rhs) {
         d_formatSpec      = rhs.d_formatSpec;
         d_timestampOffset = rhs.d_timestampOffset;
+        d_fields          = rhs.d_fields;
+        d_literals        = rhs.d_literals;
     }
 
     return *this;
 }
 
-// ACCESSORS
-void RecordStringFormatter::operator()(bsl::ostream& stream,
-                                       const Record& record) const
+void RecordStringFormatter::setFormat(const char *format)
+{
+    d_formatSpec = format;
+    compileFormat();
+}
 
+// PRIVATE ACCESSORS
+void RecordStringFormatter::loadTimestampCache(
+                                   TimestampCache        *result,
+                                   const bdlt::Datetime&  localDatetime,
+                                   int                    offset) const
 {
-    const RecordAttributes& fixedFields = record.fixedFields();
-    bdlt::DatetimeInterval  offset;
+    bslmt::LockGuardTryLock<bslmt::Mutex> guard(&d_timestampCacheLock);
 
-    if (k_ENABLE_PUBLISH_IN_LOCALTIME ==
-                                       d_timestampOffset.totalMilliseconds()) {
-        bsls::Types::Int64 localTimeOffsetInSeconds =
-            bdlt::LocalTimeOffset::localTimeOffset(
-                                       fixedFields.timestamp()).totalSeconds();
-        offset.setTotalSeconds(localTimeOffsetInSeconds);
-    } else if (k_DISABLE_PUBLISH_IN_LOCALTIME !=
-                                       d_timestampOffset.totalMilliseconds()) {
-        offset = d_timestampOffset;
+    if (guard.ptr()) {
+        d_timestampCache.update(localDatetime, offset);
+        *result = d_timestampCache;
     }
+    else {
+        result->update(localDatetime, offset);
+    }
+}
 
-    bdlt::DatetimeTz timestamp(fixedFields.timestamp() + offset,
-                               static_cast<int>(offset.totalMinutes()));
-
-    // Step through the format string, outputting the required elements.
+// ACCESSORS
+void RecordStringFormatter::operator()(bsl::ostream& stream,
+                                       const Record& record) const
 
-    const char* iter = d_formatSpec.data();
-    const char* end  = iter + d_formatSpec.length();
+{
+    const RecordAttributes& fixedFields = record.fixedFields();
 
     // Create a buffer on the stack for formatting the record.  Note that the
     // size of the buffer should be slightly larger than the amount we reserve
@@ -251,173 +480,153 @@ void RecordStringFormatter::operator()(bsl::ostream& stream,
     bsl::string output(&stringAllocator);
     output.reserve(STRING_RESERVATION);
 
-    while (iter != end) {
-        switch (*iter) {
-          case '%': {
-            if (++iter == end) {
-                break;
-            }
-            switch (*iter) {
-              case '%': {
-                output += '%';
-              } break;
-              case 'd': BSLS_ANNOTATION_FALLTHROUGH;
-              case 'D': {
-                const int fractionalSecondPrecision = 'd' == *iter ? 3 : 6;
-
-                char buffer[32];
-                timestamp.localDatetime().printToBuffer(
-                                                    buffer,
-                                                    sizeof buffer,
-                                                    fractionalSecondPrecision);
+    // The timestamp is adjusted and rendered only if the format specification
+    // calls for it, and then only once.
 
-                output += buffer;
-              } break;
-              case 'I': BSLS_ANNOTATION_FALLTHROUGH;
-              case 'O': BSLS_ANNOTATION_FALLTHROUGH;
-              case 'i': {
-                // Use ISO8601 "extended" format.
+    bool           isTimestampLoaded = false;
+    bdlt::Datetime localDatetime;
+    TimestampCache timestampCache;
 
-                const int fractionalSecondPrecision = 'O' == *iter ? 6 : 3;
+    typedef bsl::vector<Field>::const_iterator FieldIter;
 
-                bdlt::Iso8601UtilConfiguration config;
-                config.setFractionalSecondPrecision(fractionalSecondPrecision);
-                config.setUseZAbbreviationForUtc(true);
-
-                char buffer[bdlt::Iso8601Util::k_DATETIMETZ_STRLEN + 1];
-
-                int outputLength = bdlt::Iso8601Util::generateRaw(buffer,
-                                                                  timestamp,
-                                                                  config);
+    for (FieldIter field = d_fields.begin(); field != d_fields.end();
+                                                                     ++field) {
+        switch (field->d_type) {
+          case Field::e_LITERAL: {
+            output.append(d_literals.data() + field->d_offset,
+                          field->d_length);
+          } break;
+          case Field::e_DATETIME:               BSLS_ANNOTATION_FALLTHROUGH;
+          case Field::e_DATETIME_MICROSECONDS:  BSLS_ANNOTATION_FALLTHROUGH;
+          case Field::e_ISO8601:                BSLS_ANNOTATION_FALLTHROUGH;
+          case Field::e_ISO8601_MILLISECONDS:   BSLS_ANNOTATION_FALLTHROUGH;
+          case Field::e_ISO8601_MICROSECONDS: {
+            if (!isTimestampLoaded) {
+                bdlt::DatetimeInterval offset;
+
+                if (k_ENABLE_PUBLISH_IN_LOCALTIME ==
+                                       d_timestampOffset.totalMilliseconds()) {
+                    bsls::Types::Int64 localTimeOffsetInSeconds =
+                        bdlt::LocalTimeOffset::localTimeOffset(
+                                       fixedFields.timestamp()).totalSeconds();
+                    offset.setTotalSeconds(localTimeOffsetInSeconds);
+                } else if (k_DISABLE_PUBLISH_IN_LOCALTIME !=
+                                       d_timestampOffset.totalMilliseconds()) {
+                    offset = d_timestampOffset;
+                }
 
-                if ('i' == *iter) {
-                    // Remove milliseconds part.
+                localDatetime = fixedFields.timestamp() + offset;
+                loadTimestampCache(&timestampCache,
+                                   localDatetime,
+                                   static_cast<int>(offset.totalMinutes()));
+                isTimestampLoaded = true;
+            }
 
-                    enum { k_DECIMAL_SIGN_OFFSET = 19,
-                           k_TZINFO_OFFSET       = k_DECIMAL_SIGN_OFFSET + 4 };
-                    bslstl::StringRef head(buffer, k_DECIMAL_SIGN_OFFSET);
+            if (Field::e_DATETIME == field->d_type
+             || Field::e_DATETIME_MICROSECONDS == field->d_type) {
+                const bslstl::StringRef datetime = timestampCache.datetime();
 
-                    bslstl::StringRef tail(buffer + k_TZINFO_OFFSET,
-                                           outputLength - k_TZINFO_OFFSET);
+                output.append(datetime.data(), datetime.length());
+                appendFractionalSeconds(
+                             &output,
+                             localDatetime,
+                             Field::e_DATETIME == field->d_type ? 3 : 6);
+            }
+            else {
+                // Use ISO8601 "extended" format.
 
-                    output += head + tail;
-                }
-                else {
-                    output.append(buffer, outputLength);
+                const bslstl::StringRef iso8601 = timestampCache.iso8601();
+                const bslstl::StringRef tz      = timestampCache.iso8601Tz();
+
+                output.append(iso8601.data(), iso8601.length());
+                if (Field::e_ISO8601 != field->d_type) {
+                    appendFractionalSeconds(
+                          &output,
+                          localDatetime,
+                          Field::e_ISO8601_MILLISECONDS == field->d_type
+                          ? 3
+                          : 6);
                 }
-              } break;
-              case 'p': {
-                appendToString(&output, fixedFields.processID());
-              } break;
-              case 't': {
-                appendToString(&output, fixedFields.threadID());
-              } break;
-              case 'T': {
-                appendToStringAsHex(&output, fixedFields.threadID());
-              } break;
-              case 's': {
-                output += Severity::toAscii(
+                output.append(tz.data(), tz.length());
+            }
+          } break;
+          case Field::e_PROCESS_ID: {
+            appendToString(&output, fixedFields.processID());
+          } break;
+          case Field::e_THREAD_ID: {
+            appendToString(&output, fixedFields.threadID());
+          } break;
+          case Field::e_THREAD_ID_HEX: {
+            appendToStringAsHex(&output, fixedFields.threadID());
+          } break;
+          case Field::e_SEVERITY: {
+            output += Severity::toAscii(
                                  (Severity::Level)fixedFields.severity());
-              } break;
-              case 'f': {
-                output += fixedFields.fileName();
-              } break;
-              case 'F': {
-                const bsl::string& filename = fixedFields.fileName();
-                bsl::string::size_type rightmostSlashIndex =
+          } break;
+          case Field::e_FILE: {
+            output += fixedFields.fileName();
+          } break;
+          case Field::e_FILE_BASENAME: {
+            const bsl::string& filename = fixedFields.fileName();
+            bsl::string::size_type rightmostSlashIndex =
 #ifdef BSLS_PLATFORM_OS_WINDOWS
-                    filename.rfind('\\');
+                filename.rfind('\\');
 #else
-                    filename.rfind('/');
+                filename.rfind('/');
 #endif
-                if (bsl::string::npos == rightmostSlashIndex) {
-                    output += filename;
-                }
-                else {
-                    output += filename.substr(rightmostSlashIndex + 1);
-                }
-              } break;
-              case 'l': {
-                appendToString(&output, fixedFields.lineNumber());
-              } break;
-              case 'c': {
-                output += fixedFields.category();
-              } break;
-              case 'm': {
-                bslstl::StringRef message = fixedFields.messageRef();
-                output.append(message.data(), message.length());
-              } break;
-              case 'x': {
-                bsl::stringstream ss;
-                int length = static_cast<int>(
+            if (bsl::string::npos == rightmostSlashIndex) {
+                output += filename;
+            }
+            else {
+                output.append(filename, rightmostSlashIndex + 1,
+                              bsl::string::npos);
+            }
+          } break;
+          case Field::e_LINE: {
+            appendToString(&output, fixedFields.lineNumber());
+          } break;
+          case Field::e_CATEGORY: {
+            output += fixedFields.category();
+          } break;
+          case Field::e_MESSAGE: {
+            bslstl::StringRef message = fixedFields.messageRef();
+            output.append(message.data(), message.length());
+          } break;
+          case Field::e_MESSAGE_PRINTABLE: {
+            bsl::stringstream ss;
+            int length = static_cast<int>(
                                       fixedFields.messageStreamBuf().length());
-                bdlb::Print::printString(ss,
-                                        fixedFields.message(),
-                                        length,
-                                        false);
-                output += ss.str();
-              } break;
-              case 'X': {
-                bsl::stringstream ss;
-                int length = static_cast<int>(
+            bdlb::Print::printString(ss,
+                                    fixedFields.message(),
+                                    length,
+                                    false);
+            output += ss.str();
+          } break;
+          case Field::e_MESSAGE_HEX: {
+            bsl::stringstream ss;
+            int length = static_cast<int>(
                                       fixedFields.messageStreamBuf().length());
-                bdlb::Print::singleLineHexDump(ss,
-                                              fixedFields.message(),
-                                              length);
-                output += ss.str();
-              } break;
-              case 'u': {
-                typedef ball::UserFields Values;
-                const Values& customFields = record.customFields();
-                const int numCustomFields  = customFields.length();
-
-                if (numCustomFields > 0) {
-                    bsl::stringstream ss;
-                    Values::ConstIterator it = customFields.begin();
-                    ss << *it;
-                    ++it;
-                    for (; it != customFields.end(); ++it) {
-                        ss << " " << *it;
-                    }
-                    output += ss.str();
-                }
-              } break;
-              default: {
-                // Undefined: we just output the verbatim characters.
-
-                output += '%';
-                output += *iter;
-              }
-            }
-            ++iter;
+            bdlb::Print::singleLineHexDump(ss,
+                                          fixedFields.message(),
+                                          length);
+            output += ss.str();
           } break;
-          case '\\': {
-            if (++iter == end) {
-                break;
-            }
-            switch (*iter) {
-              case 'n': {
-                output += '\n';
-              } break;
-              case 't': {
-                output += '\t';
-              } break;
-              case '\\': {
-                output += '\\';
-              } break;
-              default: {
-                // Undefined: we just output the verbatim characters.
+          case Field::e_USER_FIELDS: {
+            typedef ball::UserFields Values;
+            const Values& customFields = record.customFields();
+            const int numCustomFields  = customFields.length();
 
-                output += '\\';
-                output += *iter;
-              }
+            if (numCustomFields > 0) {
+                bsl::stringstream ss;
+                Values::ConstIterator it = customFields.begin();
+                ss << *it;
+                ++it;
+                for (; it != customFields.end(); ++it) {
+                    ss << " " << *it;
+                }
+                output += ss.str();
             }
-            ++iter;
           } break;
-          default: {
-            output += *iter;
-            ++iter;
-          }
         }
     }
 
@@ -82,6 +82,17 @@ BSLS_IDENT("$Id: $")
 // Any other text included in the format specification of the record formatter
 // is output verbatim.
 //
+// The format specification is parsed only once, when it is supplied to the
+// record formatter (on construction, by 'setFormat', or by assignment), into
+// a sequence of literal-text and record-attribute fields that 'operator()'
+// then renders in turn.  In addition, a record formatter retains the text
+// rendered for the date and time, to the second, of the most recent timestamp
+// that it formatted, so that only the fractional-second digits are rendered
+// for a record whose timestamp falls within the same second (and time zone)
+// as that of the previous one.  'operator()' may be invoked concurrently on
+// the same record formatter from different threads; a thread that finds the
+// retained text in use by another thread renders its timestamp in full.
+//
 // When not supplied at construction, the default format specification of a
 // record formatter is:
 //..
@@ -129,6 +140,7 @@ BSLS_IDENT("$Id: $")
 
 #include <balscm_version.h>
 
+#include <bdlt_datetime.h>
 #include <bdlt_datetimeinterval.h>
 
 #include <bslma_allocator.h>
@@ -136,8 +148,13 @@ BSLS_IDENT("$Id: $")
 
 #include <bslmf_nestedtraitdeclaration.h>
 
+#include <bslmt_mutex.h>
+
+#include <bslstl_stringref.h>
+
 #include <bsl_iosfwd.h>
 #include <bsl_string.h>
+#include <bsl_vector.h>
 
 #ifndef BDE_DONT_ALLOW_TRANSITIVE_INCLUDES
 #include <bslalg_typetraits.h>
@@ -148,6 +165,109 @@ namespace ball {
 
 class Record;
 
+                     // ==================================
+                     // struct RecordStringFormatter_Field
+                     // ==================================
+
+struct RecordStringFormatter_Field {
+    // [!PRIVATE!] This component-private 'struct' describes one field of a
+    // compiled format specification: either a run of literal text, or a
+    // conversion specification naming the record attribute to be rendered.
+
+    // TYPES
+    enum Type {
+        e_LITERAL,                  // literal text (including escapes)
+        e_DATETIME,                 // '%d'
+        e_DATETIME_MICROSECONDS,    // '%D'
+        e_ISO8601,                  // '%i'
+        e_ISO8601_MILLISECONDS,     // '%I'
+        e_ISO8601_MICROSECONDS,     // '%O'
+        e_PROCESS_ID,               // '%p'
+        e_THREAD_ID,                // '%t'
+        e_THREAD_ID_HEX,            // '%T'
+        e_SEVERITY,                 // '%s'
+        e_FILE,                     // '%f'
+        e_FILE_BASENAME,            // '%F'
+        e_LINE,                     // '%l'
+        e_CATEGORY,                 // '%c'
+        e_MESSAGE,                  // '%m'
+        e_MESSAGE_PRINTABLE,        // '%x'
+        e_MESSAGE_HEX,              // '%X'
+        e_USER_FIELDS               // '%u'
+    };
+
+    // DATA
+    Type d_type;    // type of this field
+
+    int  d_offset;  // offset of the literal text of an 'e_LITERAL' field
+                    // within the literal text of the formatter
+
+    int  d_length;  // length of the literal text of an 'e_LITERAL' field
+};
+
+                 // ==========================================
+                 // class RecordStringFormatter_TimestampCache
+                 // ==========================================
+
+class RecordStringFormatter_TimestampCache {
+    // [!PRIVATE!] This component-private class holds the text rendered, in
+    // each of the timestamp formats supported by 'RecordStringFormatter', for
+    // the date and time (to the second) and the time zone of a timestamp, so
+    // that only the fractional-second digits need be rendered for subsequent
+    // timestamps falling within the same second and time zone.
+
+  public:
+    // PUBLIC CONSTANTS
+    enum {
+        k_DATETIME_LENGTH     = 18,  // length of "DDMonYYYY_HH:MM:SS"
+        k_ISO8601_LENGTH      = 19,  // length of "YYYY-MM-DDTHH:MM:SS"
+        k_ISO8601_TZ_CAPACITY = 8    // capacity for "Z" or "+HH:MM"
+    };
+
+  private:
+    // DATA
+    bdlt::Datetime d_second;         // cached timestamp, truncated to the
+                                     // second
+
+    int            d_offset;         // cached time zone offset (in minutes)
+
+    bool           d_isValid;        // 'true' once a timestamp is cached
+
+    char           d_datetime[k_DATETIME_LENGTH];
+                                     // "DDMonYYYY_HH:MM:SS"
+
+    char           d_iso8601[k_ISO8601_LENGTH];
+                                     // "YYYY-MM-DDTHH:MM:SS"
+
+    char           d_iso8601Tz[k_ISO8601_TZ_CAPACITY];
+                                     // ISO 8601 time zone designator
+
+    int            d_iso8601TzLength;
+                                     // length of 'd_iso8601Tz'
+
+  public:
+    // CREATORS
+    RecordStringFormatter_TimestampCache();
+        // Create a timestamp cache holding no timestamp.
+
+    // MANIPULATORS
+    void update(const bdlt::Datetime& localDatetime, int offset);
+        // Render the date and time, to the second, of the specified
+        // 'localDatetime' and the time zone designator for the specified
+        // 'offset' (in minutes), unless this cache already holds them.
+
+    // ACCESSORS
+    bslstl::StringRef datetime() const;
+        // Return the cached date and time in 'DDMonYYYY_HH:MM:SS' format.
+
+    bslstl::StringRef iso8601() const;
+        // Return the cached date and time in ISO 8601 'YYYY-MM-DDTHH:MM:SS'
+        // format.
+
+    bslstl::StringRef iso8601Tz() const;
+        // Return the cached ISO 8601 time zone designator.
+};
+
                         // ===========================
                         // class RecordStringFormatter
                         // ===========================
@@ -177,10 +297,37 @@ class RecordStringFormatter {
                                               // adjusted to the current local
                                               // time.
 
+    // PRIVATE TYPES
+    typedef RecordStringFormatter_Field          Field;
+    typedef RecordStringFormatter_TimestampCache TimestampCache;
+
     // DATA
     bsl::string            d_formatSpec;       // 'printf'-style format spec.
     bdlt::DatetimeInterval d_timestampOffset;  // offset added to timestamps
 
+    bsl::vector<Field>     d_fields;           // compiled 'd_formatSpec'
+
+    bsl::string            d_literals;         // literal text of 'd_fields'
+
+    mutable TimestampCache d_timestampCache;   // most recently rendered
+                                               // timestamp
+
+    mutable bslmt::Mutex   d_timestampCacheLock;
+                                               // guards 'd_timestampCache'
+
+    // PRIVATE MANIPULATORS
+    void compileFormat();
+        // Parse 'd_formatSpec' into 'd_fields' and 'd_literals'.
+
+    // PRIVATE ACCESSORS
+    void loadTimestampCache(TimestampCache        *result,
+                            const bdlt::Datetime&  localDatetime,
+                            int                    offset) const;
+        // Load into the specified 'result' the rendering of the specified
+        // 'localDatetime' and time zone 'offset' (in minutes), reusing (and
+        // refreshing) the timestamp cache of this object unless it is in use
+        // by another thread.
+
   public:
     // TRAITS
     BSLMF_NESTED_TRAIT_DECLARATION(RecordStringFormatter,
@@ -338,6 +485,38 @@ bsl::ostream& operator<<(bsl::ostream&                output,
 //                              INLINE DEFINITIONS
 // ============================================================================
 
+                 // ------------------------------------------
+                 // class RecordStringFormatter_TimestampCache
+                 // ------------------------------------------
+
+// CREATORS
+inline
+RecordStringFormatter_TimestampCache::RecordStringFormatter_TimestampCache()
+: d_offset(0)
+, d_isValid(false)
+, d_iso8601TzLength(0)
+{
+}
+
+// ACCESSORS
+inline
+bslstl::StringRef RecordStringFormatter_TimestampCache::datetime() const
+{
+    return bslstl::StringRef(d_datetime, k_DATETIME_LENGTH);
+}
+
+inline
+bslstl::StringRef RecordStringFormatter_TimestampCache::iso8601() const
+{
+    return bslstl::StringRef(d_iso8601, k_ISO8601_LENGTH);
+}
+
+inline
+bslstl::StringRef RecordStringFormatter_TimestampCache::iso8601Tz() const
+{
+    return bslstl::StringRef(d_iso8601Tz, d_iso8601TzLength);
+}
+
                         // ---------------------------
                         // class RecordStringFormatter
                         // ---------------------------
@@ -355,12 +534,6 @@ void RecordStringFormatter::enablePublishInLocalTime()
     d_timestampOffset.setTotalMilliseconds(k_ENABLE_PUBLISH_IN_LOCALTIME);
 }
 
-inline
-void RecordStringFormatter::setFormat(const char *format)
-{
-    d_formatSpec = format;
-}
-
 inline
 void RecordStringFormatter::setTimestampOffset(
                                           const bdlt::DatetimeInterval& offset)
@@ -8,7 +8,10 @@
 
 #include <bdlt_currenttime.h>
 #include <bdlt_datetime.h>
+#include <bdlt_datetimeinterval.h>
+#include <bdlt_datetimetz.h>
 #include <bdlt_iso8601util.h>
+#include <bdlt_iso8601utilconfiguration.h>
 #include <bdlt_localtimeoffset.h>
 
 #include <bslim_testutil.h>
@@ -21,6 +24,7 @@
 #include <bslmt_threadutil.h>
 
 #include <bsls_platform.h>
+#include <bsls_stopwatch.h>
 #include <bsls_types.h>
 
 #include <bsl_iostream.h>
@@ -28,6 +32,7 @@
 #include <bsl_ostream.h>
 #include <bsl_string.h>
 #include <bsl_sstream.h>
+#include <bsl_streambuf.h>
 
 #include <bsl_cstdlib.h>
 #include <bsl_cstring.h>                  // for 'strcmp'
@@ -60,7 +65,10 @@ using bsl::uppercase;
 // component therefore largely depends on that of those two contained class.
 // We simply follow the standard 10-case test suite.  In addition, since the
 // implemented class is a function object, the 'operator()' method that
-// provides string-based formatting support is extensively tested.
+// provides string-based formatting support is extensively tested.  The format
+// specification is compiled when it is set, and the rendering of the most
+// recent timestamp is cached, so case 14 verifies that neither is observable
+// in the formatted output.
 //
 // CREATORS
 // [ 2] ball::RecordStringFormatter(*ba = 0);
@@ -89,6 +97,9 @@ using bsl::uppercase;
 // ----------------------------------------------------------------------------
 // [ 1] breathing test
 // [12] USAGE example
+// [14] CONCERN: COMPILED FORMAT SPECIFICATION
+// [14] CONCERN: TIMESTAMP CACHE
+// [-1] PERFORMANCE: FORMATTING THROUGHPUT
 
 // ============================================================================
 //                     STANDARD BDE ASSERT TEST FUNCTION
@@ -246,6 +257,97 @@ bool compareText(bslstl::StringRef lhs, bslstl::StringRef rhs)
 
 namespace {
 
+bsl::string expectedTimestamps(const bdlt::Datetime&         utc,
+                               const bdlt::DatetimeInterval& offset)
+    // Return the text expected from formatting a record having the specified
+    // 'utc' timestamp with the format specification "%d|%D|%i|%I|%O" and the
+    // specified timestamp 'offset', rendered without the use of
+    // 'ball::RecordStringFormatter'.
+{
+    const bdlt::Datetime   local(utc + offset);
+    const bdlt::DatetimeTz localTz(local,
+                                   static_cast<int>(offset.totalMinutes()));
+
+    char buffer[64];
+
+    bsl::string result;
+
+    local.printToBuffer(buffer, sizeof buffer, 3);
+    result += buffer;
+    result += '|';
+    local.printToBuffer(buffer, sizeof buffer, 6);
+    result += buffer;
+
+    const int PRECISIONS[] = { 0, 3, 6 };
+    for (int i = 0; i < 3; ++i) {
+        bdlt::Iso8601UtilConfiguration config;
+        config.setFractionalSecondPrecision(PRECISIONS[i]);
+        config.setUseZAbbreviationForUtc(true);
+
+        const int length = bdlt::Iso8601Util::generateRaw(buffer,
+                                                          localTz,
+                                                          config);
+        result += '|';
+        result.append(buffer, length);
+    }
+    return result;
+}
+
+struct FormatThreadArgs {
+    // This 'struct' holds the arguments of 'formatThread'.
+
+    const Obj *d_formatter_p;  // formatter shared by all threads
+    int        d_threadIndex;  // distinguishes the timestamps of each thread
+};
+
+extern "C" void *formatThread(void *arguments)
+    // Format, using the formatter supplied in the specified 'arguments' (a
+    // 'FormatThreadArgs' object), records having a sequence of timestamps
+    // specific to the thread, and verify the formatted timestamps.
+{
+    const FormatThreadArgs& args = *static_cast<FormatThreadArgs *>(arguments);
+
+    const Obj&             X = *args.d_formatter_p;
+    const bdlt::DatetimeInterval offset(X.timestampOffset());
+
+    ball::Record mRecord;
+
+    bdlt::Datetime utc(2020, 1, 1 + args.d_threadIndex, 23, 59, 59);
+
+    for (int i = 0; i < 2000; ++i) {
+        utc.addMicroseconds(997);
+        mRecord.fixedFields().setTimestamp(utc);
+
+        ostringstream oss;
+        X(oss, mRecord);
+
+        const bsl::string EXP = expectedTimestamps(utc, offset);
+        ASSERTV(args.d_threadIndex, i, EXP, oss.str(), EXP == oss.str());
+    }
+    return 0;
+}
+
+class NullStreamBuf : public bsl::streambuf {
+    // This class implements a stream buffer that discards all of the
+    // characters written to it, and is used to measure the cost of formatting
+    // a record without the cost of storing the result.
+
+  protected:
+    // MANIPULATORS
+    int_type overflow(int_type c)
+        // Discard the specified 'c' and return a value other than 'eof()'.
+    {
+        return traits_type::not_eof(c);
+    }
+
+    bsl::streamsize xsputn(const char_type *, bsl::streamsize numCharacters)
+        // Discard the specified 'numCharacters' characters and return
+        // 'numCharacters'.
+    {
+        return numCharacters;
+    }
+};
+
 }  // close unnamed namespace
 
 //=============================================================================
@@ -263,6 +365,257 @@ int main(int argc, char *argv[])
     cout << "TEST " << __FILE__ << " CASE " << test << endl;
 
     switch (test) { case 0:
+      case 14: {
+        // --------------------------------------------------------------------
+        // TESTING COMPILED FORMAT AND TIMESTAMP CACHE
+        //   The format specification is compiled into a sequence of fields
+        //   when it is set, and the rendering of the date and time (to the
+        //   second) of the most recent timestamp is cached.
+        //
+        // Concerns:
+        //: 1 Literal text, escape sequences, and unrecognized or incomplete
+        //:   conversion and escape sequences are rendered as before.
+        //:
+        //: 2 'setFormat', the copy constructor, and the assignment operator
+        //:   each yield a formatter that renders its new format
+        //:   specification.
+        //:
+        //: 3 Timestamps are rendered correctly whether or not they fall
+        //:   within the same second as the previous timestamp, including
+        //:   when timestamps go backwards, or cross a day boundary.
+        //:
+        //: 4 A change in the timestamp offset (and hence the time zone) of
+        //:   a formatter is reflected in the rendered timestamps even if the
+        //:   timestamp itself falls within the cached second.
+        //:
+        //: 5 A formatter may be used concurrently from several threads.
+        //
+        // Plan:
+        //: 1 Using a table of format specifications and expected results,
+        //:   format a record having known attributes and verify the
+        //:   result.  (C-1)
+        //:
+        //: 2 Change the format of a formatter, copy it, and assign it, and
+        //:   verify the output of each.  (C-2)
+        //:
+        //: 3 Format records having a sequence of timestamps, using several
+        //:   timestamp offsets, and compare the result with the timestamps
+        //:   rendered directly by 'bdlt'.  (C-3..4)
+        //:
+        //: 4 Share one formatter among several threads, each of which
+        //:   formats records having its own sequence of timestamps, and
+        //:   verify the results.  (C-5)
+        //
+        // Testing:
+        //   CONCERN: COMPILED FORMAT SPECIFICATION
+        //   CONCERN: TIMESTAMP CACHE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING COMPILED FORMAT AND TIMESTAMP CACHE"
+                          << endl
+                          << "==========================================="
+                          << endl;
+
+        ball::RecordAttributes fixedFields(bdlt::Datetime(2020, 6, 1),
+                                           1234,
+                                           0xABC,
+                                           "subdir/process.cpp",
+                                           542,
+                                           "FOO.BAR",
+                                           ball::Severity::e_WARN,
+                                           "Hello");
+        ball::Record        mRecord(fixedFields, ball::UserFields());
+        const ball::Record& record = mRecord;
+
+        if (verbose) cout << "\nTesting format specifications." << endl;
+        {
+            static const struct {
+                int         d_line;    // source line number
+                const char *d_format;  // format specification
+                const char *d_exp;     // expected result
+            } DATA[] = {
+                //LINE  FORMAT                   EXPECTED
+                //----  -----------------------  -------------------------
+                { L_,   "",                      ""                        },
+                { L_,   "abc",                   "abc"                     },
+                { L_,   "%",                     ""                        },
+                { L_,   "abc%",                  "abc"                     },
+                { L_,   "\\",                    ""                        },
+                { L_,   "abc\\",                 "abc"                     },
+                { L_,   "%%",                    "%"                       },
+                { L_,   "%%%%",                  "%%"                      },
+                { L_,   "%%m",                   "%m"                      },
+                { L_,   "%q",                    "%q"                      },
+                { L_,   "%q%m%",                 "%qHello"                 },
+                { L_,   "\\q",                   "\\q"                     },
+                { L_,   "a\\nb\\tc\\\\d",          "a\nb\tc\\d"              },
+                { L_,   "%m",                    "Hello"                   },
+                { L_,   "<%m>",                  "<Hello>"                 },
+                { L_,   "%m%m",                  "HelloHello"              },
+                { L_,   "%p:%t",                 "1234:2748"               },
+                { L_,   "%T",                    "ABC"                     },
+                { L_,   "%s %c",                 "WARN FOO.BAR"            },
+                { L_,   "%f:%l",                 "subdir/process.cpp:542"  },
+                { L_,   "%F:%l",                 "process.cpp:542"         },
+                { L_,   "%u",                    ""                        },
+                { L_,   "[%u]\\n",               "[]\n"                    },
+            };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int   LINE   = DATA[ti].d_line;
+                const char *FORMAT = DATA[ti].d_format;
+                const char *EXP    = DATA[ti].d_exp;
+
+                const Obj X(FORMAT);
+
+                ostringstream oss;
+                X(oss, record);
+
+                if (veryVerbose) { P_(LINE) P_(FORMAT) P(oss.str()) }
+                ASSERTV(LINE, EXP, oss.str(), EXP == oss.str());
+            }
+        }
+
+        if (verbose) cout << "\nTesting 'setFormat', copy, and assignment."
+                          << endl;
+        {
+            Obj mX("%m");  const Obj& X = mX;
+
+            ostringstream oss;
+            X(oss, record);
+            ASSERTV(oss.str(), "Hello" == oss.str());
+
+            mX.setFormat("%l|%m");
+
+            oss.str("");
+            X(oss, record);
+            ASSERTV(oss.str(), "542|Hello" == oss.str());
+
+            const Obj Y(X);
+
+            oss.str("");
+            Y(oss, record);
+            ASSERTV(oss.str(), "542|Hello" == oss.str());
+
+            Obj mZ("%c");  const Obj& Z = mZ;
+
+            mZ = X;
+            mX.setFormat("%s");
+
+            oss.str("");
+            Z(oss, record);
+            ASSERTV(oss.str(), "542|Hello" == oss.str());
+
+            oss.str("");
+            X(oss, record);
+            ASSERTV(oss.str(), "WARN" == oss.str());
+        }
+
+        if (verbose) cout << "\nTesting timestamps." << endl;
+        {
+            const bdlt::DatetimeInterval OFFSETS[] = {
+                bdlt::DatetimeInterval(0),
+                bdlt::DatetimeInterval(0, 3, 47),
+                bdlt::DatetimeInterval(0, -5, -30),
+                bdlt::DatetimeInterval(0),
+            };
+            const int NUM_OFFSETS = static_cast<int>(sizeof OFFSETS
+                                                     / sizeof *OFFSETS);
+
+            static const struct {
+                int                d_line;          // source line number
+                bsls::Types::Int64 d_microseconds;  // microseconds since the
+                                                    // start time
+            } DATA[] = {
+                //LINE  MICROSECONDS
+                //----  ------------
+                { L_,              0 },
+                { L_,              0 },
+                { L_,              1 },
+                { L_,         999999 },
+                { L_,        1000000 },
+                { L_,        1000001 },
+                { L_,         999998 },
+                { L_,        1500000 },
+                { L_,       60000000 },
+                { L_,     3600123456LL },
+                { L_,    86400000000LL },
+                { L_,    86399999999LL },
+                { L_,    86400000000LL },
+            };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            const bdlt::Datetime START(2019, 12, 31, 23, 59, 59);
+
+            Obj mX("%d|%D|%i|%I|%O");  const Obj& X = mX;
+
+            for (int oi = 0; oi < NUM_OFFSETS; ++oi) {
+                const bdlt::DatetimeInterval& OFFSET = OFFSETS[oi];
+
+                mX.setTimestampOffset(OFFSET);
+
+                for (int ti = 0; ti < NUM_DATA; ++ti) {
+                    const int LINE = DATA[ti].d_line;
+
+                    bdlt::Datetime utc(START);
+                    utc.addMicroseconds(DATA[ti].d_microseconds);
+                    mRecord.fixedFields().setTimestamp(utc);
+
+                    ostringstream oss;
+                    X(oss, record);
+
+                    const bsl::string EXP = expectedTimestamps(utc, OFFSET);
+
+                    if (veryVerbose) { P_(LINE) P_(OFFSET) P(oss.str()) }
+                    ASSERTV(LINE, OFFSET, EXP, oss.str(), EXP == oss.str());
+                }
+            }
+
+            if (veryVerbose) cout << "\tSame local time, different offset."
+                                  << endl;
+
+            for (int oi = 0; oi < NUM_OFFSETS; ++oi) {
+                const bdlt::DatetimeInterval& OFFSET = OFFSETS[oi];
+
+                mX.setTimestampOffset(OFFSET);
+
+                const bdlt::Datetime utc(START - OFFSET);
+                mRecord.fixedFields().setTimestamp(utc);
+
+                ostringstream oss;
+                X(oss, record);
+
+                const bsl::string EXP = expectedTimestamps(utc, OFFSET);
+
+                if (veryVerbose) { P_(OFFSET) P(oss.str()) }
+                ASSERTV(OFFSET, EXP, oss.str(), EXP == oss.str());
+            }
+        }
+
+        if (verbose) cout << "\nTesting concurrent formatting." << endl;
+        {
+            enum { k_NUM_THREADS = 4 };
+
+            Obj mX("%d|%D|%i|%I|%O");  const Obj& X = mX;
+            mX.setTimestampOffset(bdlt::DatetimeInterval(0, 1, 30));
+
+            bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+            FormatThreadArgs          args[k_NUM_THREADS];
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                args[i].d_formatter_p = &X;
+                args[i].d_threadIndex = i;
+                ASSERT(0 == bslmt::ThreadUtil::create(&handles[i],
+                                                      formatThread,
+                                                      &args[i]));
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::join(handles[i]));
+            }
+        }
+      } break;
       case 13: {
         // --------------------------------------------------------------------
         // TESTING: Records Show Calculated Local-Time Offset
@@ -1771,6 +2124,73 @@ int main(int argc, char *argv[])
         ASSERT( 1 == (X1 == X4));        ASSERT(0 == (X1 != X4));
       } break;
 
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: FORMATTING THROUGHPUT
+        //
+        // Concerns:
+        //: 1 Formatting records with typical format specifications is fast
+        //:   when consecutive records have timestamps within the same second.
+        //
+        // Plan:
+        //: 1 Format a large number of records, whose timestamps advance by a
+        //:   few microseconds from one record to the next, to a stream that
+        //:   discards its output using several typical format specifications,
+        //:   and report the average time taken to format each record.
+        //
+        // Testing:
+        //   PERFORMANCE: FORMATTING THROUGHPUT
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: FORMATTING THROUGHPUT" << endl
+                          << "==================================" << endl;
+
+        enum { k_NUM_RECORDS = 500000 };
+
+        const char *FORMATS[] = {
+            "%d %p:%t %s %f:%l %c %m",
+            "%d %p:%t %s %f:%l %c %m %u",
+            "%I %p:%T %s %F:%l %c %m",
+            "%m",
+        };
+        const int NUM_FORMATS = static_cast<int>(sizeof FORMATS
+                                                 / sizeof *FORMATS);
+
+        ball::RecordAttributes fixedFields(bdlt::Datetime(2020, 6, 1),
+                                           1234,
+                                           5678,
+                                           "subdir/process.cpp",
+                                           542,
+                                           "FOO.BAR.BAZ",
+                                           ball::Severity::e_WARN,
+                                           "Hello world!");
+        ball::Record mRecord(fixedFields, ball::UserFields());
+
+        NullStreamBuf nullBuffer;
+        bsl::ostream  nullStream(&nullBuffer);
+
+        for (int i = 0; i < NUM_FORMATS; ++i) {
+            const Obj X(FORMATS[i]);
+
+            bdlt::Datetime timestamp(2020, 6, 1, 9, 30);
+
+            bsls::Stopwatch timer;
+            timer.start(true);
+            for (int j = 0; j < k_NUM_RECORDS; ++j) {
+                timestamp.addMicroseconds(7);
+                mRecord.fixedFields().setTimestamp(timestamp);
+                X(nullStream, mRecord);
+            }
+            timer.stop();
+
+            const double nsPerRecord = timer.elapsedTime() * 1.0e9
+                                                              / k_NUM_RECORDS;
+
+            cout << "\"" << FORMATS[i] << "\": " << nsPerRecord
+                 << " ns/record" << endl;
+        }
+      } break;
       default:
         {
             cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
@@ -0,0 +1,705 @@
+// balst_profilingallocator.cpp                                       -*-C++-*-
+#include <balst_profilingallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(balst_profilingallocator_cpp,"$Id$ $CSID$")
+
+#include <balst_stacktrace.h>
+#include <balst_stacktraceutil.h>
+
+#include <bslmt_lockguard.h>
+#include <bslmt_platform.h>
+
+#include <bslma_deallocatorproctor.h>
+#include <bslma_mallocfreeallocator.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_bslexceptionutil.h>
+#include <bsls_exceptionutil.h>
+#include <bsls_performancehint.h>
+#include <bsls_stackaddressutil.h>
+#include <bsls_timeutil.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstring.h>
+#include <bsl_ostream.h>
+
+namespace BloombergLP {
+namespace {
+
+typedef bsls::StackAddressUtil AddressUtil;
+typedef bsls::Types::Int64     Int64;
+typedef bsls::Types::Uint64    Uint64;
+
+enum {
+    k_IGNORE_FRAMES = AddressUtil::k_IGNORE_FRAMES + 1,
+        // Number of frames at the top of a captured stack that are ignored:
+        // the frame of 'getStackAddresses' on some platforms (see
+        // 'bsls_stackaddressutil'), and that of 'ProfilingAllocator::allocate'
+        // itself.
+
+    k_MAX_ALIGNMENT = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT,
+
+    k_DEFAULT_SAMPLING_INTERVAL  = 512 * 1024,
+
+    k_DEFAULT_NUM_RECORDED_FRAMES = 16
+};
+
+const Int64 k_NANOSECONDS_PER_SECOND = 1000 * 1000 * 1000;
+
+class CallSiteLess {
+    // This class provides a functor ordering call sites in one of the orders
+    // of 'balst::ProfilingAllocator::ReportOrder'.
+
+    typedef balst::ProfilingAllocator::CallSite CallSite;
+
+    // DATA
+    balst::ProfilingAllocator::ReportOrder d_order;  // order of call sites
+
+    // PRIVATE ACCESSORS
+    Int64 primaryKey(const CallSite& callSite) const
+        // Return the statistic of the specified 'callSite' that determines
+        // its position in the order of this functor.
+    {
+        switch (d_order) {
+          case balst::ProfilingAllocator::e_BY_BYTES_ALLOCATED: {
+            return callSite.d_estimatedBytesAllocated;                // RETURN
+          }
+          case balst::ProfilingAllocator::e_BY_ALLOCATIONS: {
+            return callSite.d_estimatedAllocations;                   // RETURN
+          }
+          default: {
+            return callSite.d_estimatedBytesInUse;                    // RETURN
+          }
+        }
+    }
+
+  public:
+    // CREATORS
+    explicit CallSiteLess(balst::ProfilingAllocator::ReportOrder order)
+        // Create a functor ordering call sites in the specified 'order'.
+    : d_order(order)
+    {
+    }
+
+    // ACCESSORS
+    bool operator()(const CallSite& lhs, const CallSite& rhs) const
+        // Return 'true' if the specified 'lhs' precedes the specified 'rhs',
+        // and 'false' otherwise.  Call sites having the same primary key are
+        // ordered by decreasing estimated bytes allocated, and then by
+        // decreasing number of samples.
+    {
+        const Int64 lhsKey = primaryKey(lhs);
+        const Int64 rhsKey = primaryKey(rhs);
+
+        if (lhsKey != rhsKey) {
+            return lhsKey > rhsKey;                                   // RETURN
+        }
+        if (lhs.d_estimatedBytesAllocated != rhs.d_estimatedBytesAllocated) {
+            return lhs.d_estimatedBytesAllocated
+                                          > rhs.d_estimatedBytesAllocated;
+                                                                      // RETURN
+        }
+        return lhs.d_numSamples > rhs.d_numSamples;
+    }
+};
+
+struct Sample {
+    // This 'struct' describes a sampled allocation whose block has not been
+    // deallocated.
+
+    balst::ProfilingAllocator::CallSite *d_callSite_p;
+                                      // call site of the allocation
+
+    Int64                                d_time;
+                                      // 'bsls::TimeUtil' timer value at
+                                      // allocation
+
+    Int64                                d_weightBlocks;
+                                      // number of allocations represented
+
+    Int64                                d_weightBytes;
+                                      // number of bytes represented
+};
+
+struct BlockHeader {
+    // This 'struct' is located at the beginning of each block obtained from
+    // the underlying allocator, 'k_HEADER_SIZE' bytes before the address
+    // returned to the client.
+
+    Sample                 *d_sample_p;  // sample describing the allocation,
+                                         // or 0 if it was not sampled
+
+    bsls::Types::size_type  d_size;      // size requested by the client
+};
+
+const bsls::Types::size_type k_HEADER_SIZE =
+                                  (sizeof(BlockHeader) + k_MAX_ALIGNMENT - 1)
+                                / k_MAX_ALIGNMENT * k_MAX_ALIGNMENT;
+    // Size of the header prepended to each block, rounded up to preserve the
+    // maximal alignment of the blocks returned by the underlying allocator.
+
+// HELPER FUNCTIONS
+
+Uint64 hashAddresses(const void * const *addresses, int numAddresses)
+    // Return a hash of the specified 'numAddresses' 'addresses'.
+{
+    Uint64 hash = 14695981039346656037ULL;   // FNV-1a offset basis
+
+    for (int i = 0; i < numAddresses; ++i) {
+        hash ^= reinterpret_cast<bsls::Types::UintPtr>(addresses[i]);
+        hash *= 1099511628211ULL;             // FNV-1a prime
+    }
+    return hash;
+}
+
+int lifetimeBucket(Int64 nanoseconds)
+    // Return the index of the bucket of the lifetime histogram of a call site
+    // for a lifetime of the specified 'nanoseconds'.
+{
+    enum { k_LAST_BUCKET = balst::ProfilingAllocator::k_NUM_LIFETIME_BUCKETS
+                                                                         - 1 };
+
+    Int64 limit = 10 * 1000;  // 10 microseconds
+
+    for (int i = 0; i < k_LAST_BUCKET; ++i, limit *= 10) {
+        if (nanoseconds < limit) {
+            return i;                                                 // RETURN
+        }
+    }
+    return k_LAST_BUCKET;
+}
+
+}  // close unnamed namespace
+
+namespace balst {
+
+                   // -------------------------------------
+                   // struct ProfilingAllocator::ThreadStats
+                   // -------------------------------------
+
+struct ProfilingAllocator::ThreadStats {
+    // This 'struct' holds the statistics of a single thread of an allocator.
+    // The statistics are written only by the thread that owns them, and their
+    // counters may be read concurrently by any thread.
+
+    ProfilingAllocator  *d_allocator_p;       // owning allocator (held)
+
+    ThreadStats         *d_next_p;            // next statistics of the
+                                              // allocator, or 0
+
+    bool                 d_isOwned;           // 'true' if owned by a running
+                                              // thread; protected by the
+                                              // mutex of the allocator
+
+    Int64                d_bytesUntilSample;  // bytes to allocate before the
+                                              // next sample
+
+    Uint64               d_randomState;       // state of the generator of
+                                              // sampling intervals
+
+    bsls::AtomicInt64    d_numAllocations;    // number of allocations
+
+    bsls::AtomicInt64    d_numBytesInUse;     // number of bytes allocated
+                                              // less the number of bytes
+                                              // deallocated
+
+    char                 d_padding[bslmt::Platform::e_CACHE_LINE_SIZE];
+                                              // keeps the statistics of
+                                              // another thread off the cache
+                                              // lines of these counters
+};
+
+                          // ------------------------
+                          // class ProfilingAllocator
+                          // ------------------------
+
+// PRIVATE MANIPULATORS
+ProfilingAllocator::CallSite *ProfilingAllocator::findOrCreateCallSite(
+                                           const void * const *addresses,
+                                           int                 numAddresses)
+{
+    const Uint64 hash = hashAddresses(addresses, numAddresses);
+
+    typedef bsl::pair<CallSiteMap::iterator, CallSiteMap::iterator> Range;
+
+    Range range = d_callSites.equal_range(hash);
+    for (CallSiteMap::iterator it = range.first; it != range.second; ++it) {
+        CallSite *callSite = it->second;
+
+        if (numAddresses == callSite->d_numAddresses
+         && 0 == bsl::memcmp(addresses,
+                             callSite->d_addresses,
+                             numAddresses * sizeof *addresses)) {
+            return callSite;                                          // RETURN
+        }
+    }
+
+    CallSite *callSite = new (*d_allocator_p) CallSite();
+
+    bslma::DeallocatorProctor<bslma::Allocator> proctor(callSite,
+                                                         d_allocator_p);
+
+    bsl::copy(addresses, addresses + numAddresses, callSite->d_addresses);
+    callSite->d_numAddresses = numAddresses;
+
+    d_callSites.insert(CallSiteMap::value_type(hash, callSite));
+
+    proctor.release();
+
+    return callSite;
+}
+
+ProfilingAllocator::ThreadStats *ProfilingAllocator::createThreadStats()
+{
+    ThreadStats *stats;
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        // Reuse, if any, the statistics of a thread that has exited, so that
+        // its counts are preserved.
+
+        for (stats = d_threadStats_p; stats; stats = stats->d_next_p) {
+            if (!stats->d_isOwned) {
+                break;
+            }
+        }
+
+        if (!stats) {
+            stats = new (*d_allocator_p) ThreadStats();
+
+            stats->d_allocator_p      = this;
+            stats->d_randomState      = static_cast<Uint64>(d_creationTime)
+                                      ^ reinterpret_cast<bsls::Types::UintPtr>(
+                                                                        stats);
+            stats->d_bytesUntilSample =
+                                  nextSamplingInterval(&stats->d_randomState);
+            stats->d_next_p           = d_threadStats_p;
+
+            d_threadStats_p = stats;
+        }
+
+        stats->d_isOwned = true;
+    }
+
+    if (0 != bslmt::ThreadUtil::setSpecific(d_key, stats)) {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        stats->d_isOwned = false;
+        bsls::BslExceptionUtil::throwBadAlloc();
+    }
+
+    return stats;
+}
+
+void ProfilingAllocator::initialize()
+{
+    if (0 != bslmt::ThreadUtil::createKey(
+                                  &d_key,
+                                  &::balst_ProfilingAllocator_threadExit)) {
+        bsls::BslExceptionUtil::throwBadAlloc();
+    }
+}
+
+// PRIVATE ACCESSORS
+int ProfilingAllocator::nextSamplingInterval(Uint64 *randomState) const
+{
+    // Knuth's MMIX linear congruential generator; the high-order bits, which
+    // have the longest periods, are used.
+
+    *randomState = *randomState * 6364136223846793005ULL
+                                                      + 1442695040888963407ULL;
+
+    const Uint64 random = *randomState >> 32;
+
+    return static_cast<int>(d_samplingInterval / 2
+                 + random % (static_cast<Uint64>(d_samplingInterval) + 1));
+}
+
+// CREATORS
+ProfilingAllocator::ProfilingAllocator(bslma::Allocator *basicAllocator)
+: d_threadStats_p(0)
+, d_fallbackBytesInUse(0)
+, d_samplingInterval(k_DEFAULT_SAMPLING_INTERVAL)
+, d_maxRecordedFrames(k_DEFAULT_NUM_RECORDED_FRAMES)
+, d_creationTime(bsls::TimeUtil::getTimer())
+, d_numSamples(0)
+, d_callSites(basicAllocator ? basicAllocator
+                             : &bslma::MallocFreeAllocator::singleton())
+, d_mutex()
+, d_allocator_p(basicAllocator ? basicAllocator
+                               : &bslma::MallocFreeAllocator::singleton())
+{
+    initialize();
+}
+
+ProfilingAllocator::ProfilingAllocator(int               samplingInterval,
+                                       bslma::Allocator *basicAllocator)
+: d_threadStats_p(0)
+, d_fallbackBytesInUse(0)
+, d_samplingInterval(samplingInterval)
+, d_maxRecordedFrames(k_DEFAULT_NUM_RECORDED_FRAMES)
+, d_creationTime(bsls::TimeUtil::getTimer())
+, d_numSamples(0)
+, d_callSites(basicAllocator ? basicAllocator
+                             : &bslma::MallocFreeAllocator::singleton())
+, d_mutex()
+, d_allocator_p(basicAllocator ? basicAllocator
+                               : &bslma::MallocFreeAllocator::singleton())
+{
+    BSLS_ASSERT(1 <= samplingInterval);
+
+    initialize();
+}
+
+ProfilingAllocator::ProfilingAllocator(int               samplingInterval,
+                                       int               numRecordedFrames,
+                                       bslma::Allocator *basicAllocator)
+: d_threadStats_p(0)
+, d_fallbackBytesInUse(0)
+, d_samplingInterval(samplingInterval)
+, d_maxRecordedFrames(numRecordedFrames)
+, d_creationTime(bsls::TimeUtil::getTimer())
+, d_numSamples(0)
+, d_callSites(basicAllocator ? basicAllocator
+                             : &bslma::MallocFreeAllocator::singleton())
+, d_mutex()
+, d_allocator_p(basicAllocator ? basicAllocator
+                               : &bslma::MallocFreeAllocator::singleton())
+{
+    BSLS_ASSERT(1 <= samplingInterval);
+    BSLS_ASSERT(1 <= numRecordedFrames);
+    BSLS_ASSERT(numRecordedFrames <= k_MAX_RECORDED_FRAMES);
+
+    initialize();
+}
+
+ProfilingAllocator::~ProfilingAllocator()
+{
+    BSLS_ASSERT(0 == numBytesInUse());
+
+    // Deleting the key first guarantees that the exit handler is not invoked
+    // for threads exiting after this point.
+
+    bslmt::ThreadUtil::deleteKey(d_key);
+
+    while (d_threadStats_p) {
+        ThreadStats *next = d_threadStats_p->d_next_p;
+        d_allocator_p->deallocate(d_threadStats_p);
+        d_threadStats_p = next;
+    }
+
+    for (CallSiteMap::iterator it = d_callSites.begin();
+                                             it != d_callSites.end(); ++it) {
+        d_allocator_p->deallocate(it->second);
+    }
+}
+
+// MANIPULATORS
+void *ProfilingAllocator::allocate(size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return 0;                                                     // RETURN
+    }
+
+    ThreadStats *stats = static_cast<ThreadStats *>(
+                                        bslmt::ThreadUtil::getSpecific(d_key));
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == stats)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        stats = createThreadStats();
+    }
+
+    BlockHeader *header = static_cast<BlockHeader *>(
+                               d_allocator_p->allocate(k_HEADER_SIZE + size));
+    header->d_sample_p = 0;
+    header->d_size     = size;
+
+    const Int64 bytes     = static_cast<Int64>(size);
+    const Int64 remaining = stats->d_bytesUntilSample - bytes;
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(remaining <= 0)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        stats->d_bytesUntilSample =
+                                  nextSamplingInterval(&stats->d_randomState);
+
+        // Capture the stack before acquiring the lock, which is not needed to
+        // do so.  Note that the frame of this function is ignored.
+
+        void *addresses[k_MAX_RECORDED_FRAMES + k_IGNORE_FRAMES];
+        int   numAddresses = AddressUtil::getStackAddresses(
+                                        addresses,
+                                        d_maxRecordedFrames + k_IGNORE_FRAMES);
+        numAddresses = bsl::max(numAddresses - k_IGNORE_FRAMES, 0);
+
+        bslma::DeallocatorProctor<bslma::Allocator> proctor(header,
+                                                             d_allocator_p);
+
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        Sample *sample = static_cast<Sample *>(
+                                      d_allocator_p->allocate(sizeof(Sample)));
+
+        bslma::DeallocatorProctor<bslma::Allocator> sampleProctor(
+                                                                sample,
+                                                                d_allocator_p);
+
+        CallSite *callSite = findOrCreateCallSite(addresses + k_IGNORE_FRAMES,
+                                                  numAddresses);
+
+        sampleProctor.release();
+
+        const Int64 interval = d_samplingInterval;
+
+        sample->d_callSite_p   = callSite;
+        sample->d_time         = bsls::TimeUtil::getTimer();
+        sample->d_weightBlocks = bytes < interval ? interval / bytes : 1;
+        sample->d_weightBytes  = bytes < interval ? interval : bytes;
+
+        ++callSite->d_numSamples;
+        ++callSite->d_numSamplesInUse;
+        callSite->d_estimatedAllocations    += sample->d_weightBlocks;
+        callSite->d_estimatedBytesAllocated += sample->d_weightBytes;
+        callSite->d_estimatedBlocksInUse    += sample->d_weightBlocks;
+        callSite->d_estimatedBytesInUse     += sample->d_weightBytes;
+
+        ++d_numSamples;
+
+        header->d_sample_p = sample;
+
+        proctor.release();
+    }
+    else {
+        stats->d_bytesUntilSample = remaining;
+    }
+
+    // Only this thread writes to its counters, so that no read-modify-write
+    // operation is needed.
+
+    stats->d_numAllocations.storeRelaxed(
+                                   stats->d_numAllocations.loadRelaxed() + 1);
+    stats->d_numBytesInUse.storeRelaxed(
+                               stats->d_numBytesInUse.loadRelaxed() + bytes);
+
+    return reinterpret_cast<char *>(header) + k_HEADER_SIZE;
+}
+
+void ProfilingAllocator::deallocate(void *address)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == address)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return;                                                       // RETURN
+    }
+
+    BlockHeader *header = reinterpret_cast<BlockHeader *>(
+                                 static_cast<char *>(address) - k_HEADER_SIZE);
+
+    const Int64 bytes = static_cast<Int64>(header->d_size);
+
+    ThreadStats *stats = static_cast<ThreadStats *>(
+                                        bslmt::ThreadUtil::getSpecific(d_key));
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == stats)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        // 'deallocate' must not throw; if the statistics of this thread
+        // cannot be created, account for the block in the shared fallback
+        // counter.
+
+        BSLS_TRY {
+            stats = createThreadStats();
+        }
+        BSLS_CATCH(...) {
+        }
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(0 != stats)) {
+        stats->d_numBytesInUse.storeRelaxed(
+                               stats->d_numBytesInUse.loadRelaxed() - bytes);
+    }
+    else {
+        d_fallbackBytesInUse.addRelaxed(-bytes);
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(header->d_sample_p)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        Sample *sample = header->d_sample_p;
+
+        const Int64 lifetime = bsls::TimeUtil::getTimer() - sample->d_time;
+
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        CallSite *callSite = sample->d_callSite_p;
+
+        --callSite->d_numSamplesInUse;
+        callSite->d_estimatedBlocksInUse -= sample->d_weightBlocks;
+        callSite->d_estimatedBytesInUse  -= sample->d_weightBytes;
+        ++callSite->d_lifetimes[lifetimeBucket(lifetime)];
+
+        d_allocator_p->deallocate(sample);
+    }
+
+    d_allocator_p->deallocate(header);
+}
+
+// ACCESSORS
+void ProfilingAllocator::loadCallSites(bsl::vector<CallSite> *result,
+                                       ReportOrder            order) const
+{
+    BSLS_ASSERT(result);
+
+    result->clear();
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        result->reserve(d_callSites.size());
+        for (CallSiteMap::const_iterator it = d_callSites.begin();
+                                             it != d_callSites.end(); ++it) {
+            result->push_back(*it->second);
+        }
+    }
+
+    bsl::sort(result->begin(), result->end(), CallSiteLess(order));
+}
+
+bsls::Types::Int64 ProfilingAllocator::numAllocations() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    Int64 result = 0;
+    for (const ThreadStats *stats = d_threadStats_p;
+                                             stats; stats = stats->d_next_p) {
+        result += stats->d_numAllocations.loadRelaxed();
+    }
+    return result;
+}
+
+bsls::Types::Int64 ProfilingAllocator::numBytesInUse() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    Int64 result = d_fallbackBytesInUse.loadRelaxed();
+    for (const ThreadStats *stats = d_threadStats_p;
+                                             stats; stats = stats->d_next_p) {
+        result += stats->d_numBytesInUse.loadRelaxed();
+    }
+    return result;
+}
+
+bsls::Types::Int64 ProfilingAllocator::numSamples() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return d_numSamples;
+}
+
+bsl::ostream& ProfilingAllocator::printReport(
+                                           bsl::ostream& stream,
+                                           int           maxNumCallSites,
+                                           ReportOrder   order) const
+{
+    BSLS_ASSERT(0 <= maxNumCallSites);
+
+    // Avoid the default allocator, which may be this allocator.
+
+    bsl::vector<CallSite> callSites(d_allocator_p);
+    loadCallSites(&callSites, order);
+
+    const double seconds = static_cast<double>(
+                                bsls::TimeUtil::getTimer() - d_creationTime)
+                                                    / k_NANOSECONDS_PER_SECOND;
+
+    stream << "Allocation profile: " << numAllocations()
+           << " allocation(s), " << numBytesInUse() << " byte(s) in use,\n"
+           << "sampling interval " << d_samplingInterval << " byte(s), "
+           << numSamples() << " sample(s), " << seconds << " second(s).\n";
+
+    const int numReported = bsl::min(maxNumCallSites,
+                                     static_cast<int>(callSites.size()));
+
+    StackTrace stackTrace(d_allocator_p);
+
+    for (int i = 0; i < numReported; ++i) {
+        const CallSite& callSite = callSites[i];
+
+        stream << "------------------------------------------"
+               << "-------------------------------------\n"
+               << "Call site " << i + 1 << " of " << callSites.size()
+               << ": ~" << callSite.d_estimatedBytesInUse
+               << " byte(s) in use in ~" << callSite.d_estimatedBlocksInUse
+               << " block(s),\n~" << callSite.d_estimatedBytesAllocated
+               << " byte(s) in ~" << callSite.d_estimatedAllocations
+               << " allocation(s)";
+        if (seconds > 0) {
+            stream << " (~"
+                   << static_cast<double>(callSite.d_estimatedBytesAllocated)
+                                                                     / seconds
+                   << " byte(s)/second)";
+        }
+        stream << ",\n" << callSite.d_numSamples << " sample(s).\n"
+               << "Lifetimes (seconds):";
+
+        double limit = 1e-5;
+        for (int b = 0; b < k_NUM_LIFETIME_BUCKETS; ++b, limit *= 10) {
+            if (b < k_NUM_LIFETIME_BUCKETS - 1) {
+                stream << " <" << limit;
+            }
+            else {
+                stream << " >=" << limit / 10;
+            }
+            stream << ':' << callSite.d_lifetimes[b];
+        }
+        stream << '\n';
+
+        const int rc = StackTraceUtil::loadStackTraceFromAddressArray(
+                                                      &stackTrace,
+                                                      callSite.d_addresses,
+                                                      callSite.d_numAddresses);
+        if (rc || 0 == stackTrace.length()) {
+            stream << "... stack trace failed ...\n";
+        }
+        else {
+            StackTraceUtil::printFormatted(stream, stackTrace);
+        }
+        stackTrace.removeAll();
+    }
+
+    return stream;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// FREE FUNCTIONS
+extern "C"
+void balst_ProfilingAllocator_threadExit(void *stats)
+{
+    using namespace BloombergLP;
+
+    typedef balst::ProfilingAllocator::ThreadStats ThreadStats;
+
+    ThreadStats *threadStats = static_cast<ThreadStats *>(stats);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(
+                                       &threadStats->d_allocator_p->d_mutex);
+
+    threadStats->d_isOwned = false;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,485 @@
+// balst_profilingallocator.h                                         -*-C++-*-
+#ifndef INCLUDED_BALST_PROFILINGALLOCATOR
+#define INCLUDED_BALST_PROFILINGALLOCATOR
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an allocator that profiles allocations by call site.
+//
+//@CLASSES:
+//  balst::ProfilingAllocator: sampling allocator with per-call-site statistics
+//
+//@SEE_ALSO: balst_stacktracetestallocator, balst_stacktraceutil,
+//           bdlma_countingallocator
+//
+//@DESCRIPTION: This component provides an instrumented allocator,
+// 'balst::ProfilingAllocator', that implements the 'bslma::Allocator'
+// protocol, forwards each request to an underlying allocator, and profiles
+// the allocations it forwards: a *sample* of the allocations is selected, the
+// call stack of each sampled allocation is captured, and statistics are
+// aggregated for each distinct call stack, or *call* *site*:
+//: o the estimated number of allocations, and of bytes allocated, from which
+//:   the allocation rate of the call site is derived
+//:
+//: o the estimated number of bytes allocated from the call site that are
+//:   still in use
+//:
+//: o a histogram of the lifetimes of the sampled blocks that were
+//:   deallocated
+//
+// A report of the call sites, ordered by the number of bytes in use, of bytes
+// allocated, or of allocations, can be written at any time by 'printReport',
+// and the statistics can be obtained programmatically with 'loadCallSites'.
+// In addition, the exact number of allocations and of bytes in use is
+// maintained.
+//..
+//                    ,-------------------------.
+//                   ( balst::ProfilingAllocator )
+//                    `-------------------------'
+//                                 |       ctor/dtor
+//                                 |       loadCallSites
+//                                 |       printReport
+//                                 |       numAllocations
+//                                 |       numBytesInUse
+//                                 |       numSamples
+//                                 |       samplingInterval
+//                                 V
+//                         ,----------------.
+//                        ( bslma::Allocator )
+//                         `----------------'
+//                                         allocate
+//                                         deallocate
+//..
+// Like 'balst::StackTraceTestAllocator', and unlike most other allocators, a
+// 'balst::ProfilingAllocator' does not rely on the currently installed
+// default allocator, but instead -- by default -- uses the
+// 'bslma::MallocFreeAllocator' singleton, both for the blocks it returns and
+// for its own bookkeeping, so that it can itself be installed as the default
+// allocator.
+//
+///Sampling
+///--------
+// Capturing a call stack costs on the order of a microsecond, which is far
+// more than the cost of a typical allocation.  To keep its overhead low
+// enough to be left enabled in production, a 'balst::ProfilingAllocator'
+// samples, on average, one allocation per 'samplingInterval()' bytes
+// allocated (512 KiB by default): the interval between two samples is chosen
+// at random, uniformly between half and one and a half times the sampling
+// interval.  An allocation of 'size' bytes is therefore sampled with a
+// probability of about 'size / samplingInterval()' (or 1, for blocks larger
+// than the sampling interval), so that large allocations are always sampled,
+// and each sample is weighted accordingly: a sampled allocation of 'size'
+// bytes is counted as 'max(1, samplingInterval() / size)' allocations, of
+// 'max(size, samplingInterval())' bytes.  The statistics of a call site are
+// therefore estimates, whose precision improves with the traffic of the call
+// site.  A sampling interval of 1 samples every allocation, so that the
+// statistics are exact.
+//
+// Each thread counts down its own sampling interval, and keeps its own counts
+// of allocations and of bytes in use, in a block of statistics found using a
+// thread-specific storage key (see 'bslmt::ThreadUtil::createKey') owned by
+// the allocator.  These counts are written only by their thread, and are
+// added up when they are read (e.g., by 'numAllocations' or 'printReport'),
+// so that threads allocating concurrently do not contend on shared memory.
+// The statistics of a thread that exits are kept, and reused by the next
+// thread that uses the allocator.  As the number of thread-specific keys is
+// limited by the platform (to 1024 on Linux), this allocator is intended for
+// a small number of long-lived instances.
+//
+// An unsampled allocation thus costs, in addition to the allocation from the
+// underlying allocator, a lookup of the thread-specific key, the update of a
+// few counters that are not shared with other threads, and a header of
+// 'bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT' bytes (typically 16) prepended to
+// each block.  A sampled allocation additionally acquires a mutex, captures
+// the call stack (as return addresses only), and looks up the call site in a
+// hash table.  Resolving the return addresses to symbols, which is expensive,
+// is deferred until a report is printed.
+//
+///Thread Safety
+///-------------
+// 'balst::ProfilingAllocator' is *fully* *thread-safe*, meaning that any
+// operation on the same instance can be safely invoked from any thread.  Note
+// that the exact statistics read while other threads allocate or deallocate
+// may not reflect the most recent of these operations.  In addition, the
+// behavior is undefined if a thread that has used the allocator exits
+// concurrently with the destruction of the allocator.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Finding the Dominant Allocation Sites
+/// - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a service spends much of its time in its allocator, and that
+// we want to find which of its containers are responsible for the allocator
+// traffic.
+//
+// First, we define two functions that allocate memory, one of which builds
+// many more strings than the other:
+//..
+//  void loadNames(bsl::vector<bsl::string> *names, int numNames)
+//      // Load into the specified 'names' the specified 'numNames' strings.
+//  {
+//      for (int i = 0; i < numNames; ++i) {
+//          names->push_back(bsl::string(
+//                          "a string long enough to allocate memory",
+//                          names->get_allocator()));
+//      }
+//  }
+//
+//  void loadCodes(bsl::vector<int> *codes, int numCodes)
+//      // Load into the specified 'codes' the specified 'numCodes' integers.
+//  {
+//      for (int i = 0; i < numCodes; ++i) {
+//          codes->push_back(i);
+//      }
+//  }
+//..
+// Then, we create a profiling allocator.  For the purpose of this example, we
+// sample every allocation, whereas a production application would use the
+// default sampling interval:
+//..
+//  balst::ProfilingAllocator profiler(1);
+//..
+// Next, we exercise the functions using the profiler (in a production
+// application, the profiler would likely be installed as the default
+// allocator):
+//..
+//  bsl::vector<bsl::string> names(&profiler);
+//  bsl::vector<int>         codes(&profiler);
+//
+//  loadNames(&names, 1000);
+//  loadCodes(&codes, 1000);
+//..
+// Now, we obtain the call sites ordered by the number of allocations, and
+// observe that the most frequently allocating call site is the construction of
+// the strings, which was sampled 1000 times, whereas the growth of the vectors
+// accounts for a few allocations only:
+//..
+//  bsl::vector<balst::ProfilingAllocator::CallSite> callSites;
+//  profiler.loadCallSites(&callSites,
+//                         balst::ProfilingAllocator::e_BY_ALLOCATIONS);
+//
+//  assert(3    <= callSites.size());
+//  assert(1000 == callSites[0].d_numSamples);
+//  assert(1000 == callSites[0].d_estimatedAllocations);
+//  assert(  20 >= callSites.back().d_estimatedAllocations);
+//..
+// Finally, we print a report of the three call sites having the most bytes in
+// use, including their resolved stack traces:
+//..
+//  bsl::ostringstream report;
+//  profiler.printReport(report, 3);
+//..
+// The report looks like this (the stack traces are abbreviated):
+//..
+//  Allocation profile: 2011 allocation(s), 43496 byte(s) in use,
+//  sampling interval 1 byte(s), 2011 sample(s), 0.0021 second(s).
+//  ---------------------------------------------------------------------------
+//  Call site 1 of 25: ~40000 byte(s) in use in ~1000 block(s),
+//  ~40000 byte(s) in ~1000 allocation(s) (~1.9e+07 byte(s)/second),
+//  1000 sample(s).
+//  Lifetimes (seconds): <1e-05:0 <0.0001:0 <0.001:0 <0.01:0 <0.1:0 <1:0 <10:0
+//  >=10:0
+//  (0): bsl::basic_string<...>::privateInitDispatch(...)+0x3f at ...
+//  ...
+//  (3): loadNames(bsl::vector<bsl::string>*, int)+0x53 at 0x4a2f33 in ...
+//  ...
+//..
+
+#include <balscm_version.h>
+
+#include <bslmt_mutex.h>
+#include <bslmt_threadutil.h>
+
+#include <bslma_allocator.h>
+
+#include <bsls_atomic.h>
+#include <bsls_keyword.h>
+#include <bsls_types.h>
+
+#include <bsl_iosfwd.h>
+#include <bsl_unordered_map.h>
+#include <bsl_vector.h>
+
+extern "C" void balst_ProfilingAllocator_threadExit(void *stats);
+    // Make the specified per-thread 'stats' of a 'balst::ProfilingAllocator'
+    // available to the next thread that uses the allocator.  This function is
+    // registered as the destructor of the thread-specific key of each
+    // allocator, and is invoked when a thread that has used the allocator
+    // exits.  Note that this function is for *private* use only.
+
+namespace BloombergLP {
+namespace balst {
+
+                          // ========================
+                          // class ProfilingAllocator
+                          // ========================
+
+class ProfilingAllocator : public bslma::Allocator {
+    // This class implements the 'bslma::Allocator' protocol to provide an
+    // allocator that forwards requests to an underlying allocator, samples
+    // the allocations, captures the call stack of each sampled allocation,
+    // and aggregates statistics for each distinct call stack.  The statistics
+    // can be obtained, or printed together with the resolved call stacks, at
+    // any time.
+
+  public:
+    // PUBLIC TYPES
+    enum {
+        k_MAX_RECORDED_FRAMES  = 32,  // maximum number of frames recorded for
+                                      // a call site
+
+        k_NUM_LIFETIME_BUCKETS = 8    // number of buckets of the lifetime
+                                      // histogram of a call site
+    };
+
+    enum ReportOrder {
+        // Enumerate the orders in which call sites are reported.
+
+        e_BY_BYTES_IN_USE,      // decreasing estimated bytes in use
+
+        e_BY_BYTES_ALLOCATED,   // decreasing estimated bytes allocated
+
+        e_BY_ALLOCATIONS        // decreasing estimated number of allocations
+    };
+
+    struct CallSite {
+        // This 'struct' holds the statistics of a call site, i.e., of the
+        // sampled allocations having the same call stack.  Estimated values
+        // are derived from the weights of the samples (see {Sampling}).
+        // Bucket 'i' of the lifetime histogram counts the sampled blocks that
+        // were deallocated less than '10^(i - 5)' seconds after their
+        // allocation; the last bucket counts those that lived longer.
+
+        // PUBLIC DATA
+        const void         *d_addresses[k_MAX_RECORDED_FRAMES];
+                                                 // return addresses of the
+                                                 // call stack, innermost
+                                                 // first
+
+        int                 d_numAddresses;      // number of valid elements
+                                                 // of 'd_addresses'
+
+        bsls::Types::Int64  d_numSamples;        // number of sampled
+                                                 // allocations
+
+        bsls::Types::Int64  d_numSamplesInUse;   // number of sampled blocks
+                                                 // not yet deallocated
+
+        bsls::Types::Int64  d_estimatedAllocations;
+                                                 // estimated number of
+                                                 // allocations
+
+        bsls::Types::Int64  d_estimatedBytesAllocated;
+                                                 // estimated number of bytes
+                                                 // allocated
+
+        bsls::Types::Int64  d_estimatedBlocksInUse;
+                                                 // estimated number of blocks
+                                                 // in use
+
+        bsls::Types::Int64  d_estimatedBytesInUse;
+                                                 // estimated number of bytes
+                                                 // in use
+
+        bsls::Types::Int64  d_lifetimes[k_NUM_LIFETIME_BUCKETS];
+                                                 // lifetime histogram of the
+                                                 // deallocated samples
+    };
+
+  private:
+    // PRIVATE TYPES
+    typedef bsl::unordered_multimap<bsls::Types::Uint64, CallSite *>
+                                                                   CallSiteMap;
+
+    struct ThreadStats;
+        // This type is defined in the implementation file.
+
+    // DATA
+    bslmt::ThreadUtil::Key  d_key;                // thread-specific key of the
+                                                  // per-thread statistics
+
+    ThreadStats            *d_threadStats_p;      // list of the per-thread
+                                                  // statistics of this
+                                                  // allocator
+
+    bsls::AtomicInt64       d_fallbackBytesInUse; // change of the bytes in use
+                                                  // by the deallocations of
+                                                  // threads whose statistics
+                                                  // could not be created
+
+    const int               d_samplingInterval;   // mean number of bytes
+                                                  // between two samples
+
+    const int               d_maxRecordedFrames;  // maximum number of frames
+                                                  // recorded per call site
+
+    const bsls::Types::Int64
+                            d_creationTime;       // 'bsls::TimeUtil' timer
+                                                  // value at construction
+
+    bsls::Types::Int64      d_numSamples;         // number of samples taken
+
+    CallSiteMap             d_callSites;          // call sites, keyed by the
+                                                  // hash of their stacks
+
+    mutable bslmt::Mutex    d_mutex;              // serializes sampling, and
+                                                  // access to 'd_callSites'
+                                                  // and 'd_threadStats_p'
+
+    bslma::Allocator       *d_allocator_p;        // underlying allocator
+                                                  // (held, not owned)
+
+  private:
+    // NOT IMPLEMENTED
+    ProfilingAllocator(const ProfilingAllocator&);
+    ProfilingAllocator& operator=(const ProfilingAllocator&);
+
+    // FRIENDS
+    friend void ::balst_ProfilingAllocator_threadExit(void *);
+
+    // PRIVATE MANIPULATORS
+    CallSite *findOrCreateCallSite(const void * const *addresses,
+                                   int                 numAddresses);
+        // Return the call site having the specified 'numAddresses' return
+        // 'addresses', creating it if it does not exist.  The behavior is
+        // undefined unless 'd_mutex' is locked by the calling thread.
+
+    ThreadStats *createThreadStats();
+        // Make the statistics of a thread that has exited, or else newly
+        // created statistics, the value of the thread-specific key of this
+        // allocator for the calling thread, and return their address.  The
+        // behavior is undefined unless the calling thread has no statistics.
+
+    void initialize();
+        // Create the thread-specific key of this allocator.
+
+    // PRIVATE ACCESSORS
+    int nextSamplingInterval(bsls::Types::Uint64 *randomState) const;
+        // Return a random number of bytes to allocate before the next sample,
+        // uniformly distributed between half and one and a half times the
+        // sampling interval, and advance the specified 'randomState' of the
+        // generator.
+
+  public:
+    // CREATORS
+    explicit ProfilingAllocator(bslma::Allocator *basicAllocator = 0);
+    explicit ProfilingAllocator(int               samplingInterval,
+                                bslma::Allocator *basicAllocator = 0);
+    ProfilingAllocator(int               samplingInterval,
+                       int               numRecordedFrames,
+                       bslma::Allocator *basicAllocator = 0);
+        // Create a profiling allocator that samples one allocation, on
+        // average, per the optionally specified 'samplingInterval' bytes
+        // allocated, and that records, for each sampled allocation, at most
+        // the optionally specified 'numRecordedFrames' frames of the call
+        // stack.  If 'samplingInterval' is not specified, 512 KiB is used; if
+        // 'numRecordedFrames' is not specified, 16 is used.  Optionally
+        // specify a 'basicAllocator' used to supply memory, both for the
+        // blocks returned by this allocator and for its bookkeeping.  If
+        // 'basicAllocator' is 0, the 'bslma::MallocFreeAllocator' singleton
+        // is used.  The behavior is undefined unless '1 <= samplingInterval'
+        // and '1 <= numRecordedFrames <= k_MAX_RECORDED_FRAMES'.
+
+    ~ProfilingAllocator() BSLS_KEYWORD_OVERRIDE;
+        // Destroy this allocator and its statistics.  The behavior is
+        // undefined unless all memory allocated from this allocator has been
+        // deallocated.
+
+    // MANIPULATORS
+    void *allocate(size_type size) BSLS_KEYWORD_OVERRIDE;
+        // Return a newly-allocated block of memory of (at least) the
+        // specified positive 'size' (in bytes), obtained from the underlying
+        // allocator, and, if the allocation is sampled, record it in the
+        // statistics of the call site of this function.  If 'size' is 0, a
+        // null pointer is returned with no other effect.  The alignment of
+        // the returned block is the maximum alignment of the underlying
+        // allocator.
+
+    void deallocate(void *address) BSLS_KEYWORD_OVERRIDE;
+        // Return the memory block at the specified 'address' back to the
+        // underlying allocator, and, if the allocation of the block was
+        // sampled, update the statistics of its call site.  If 'address' is
+        // 0, this function has no effect.  The behavior is undefined unless
+        // 'address' was allocated using this allocator object and has not
+        // already been deallocated.
+
+    // ACCESSORS
+    void loadCallSites(bsl::vector<CallSite> *result,
+                       ReportOrder            order = e_BY_BYTES_IN_USE) const;
+        // Load into the specified 'result' the statistics of all call sites,
+        // in the optionally specified 'order'.  If 'order' is not specified,
+        // the call sites are ordered by decreasing estimated number of bytes
+        // in use.
+
+    bsls::Types::Int64 numAllocations() const;
+        // Return the exact number of allocations performed by this allocator.
+        // Note that the counts of the threads are added up by this method,
+        // whose cost is thus proportional to the number of threads that have
+        // used this allocator.
+
+    bsls::Types::Int64 numBytesInUse() const;
+        // Return the exact number of bytes currently allocated from this
+        // allocator, excluding the headers of the blocks.  Note that the
+        // counts of the threads are added up by this method, whose cost is
+        // thus proportional to the number of threads that have used this
+        // allocator.
+
+    bsls::Types::Int64 numSamples() const;
+        // Return the number of allocations sampled by this allocator.
+
+    bsl::ostream& printReport(
+                           bsl::ostream& stream,
+                           int           maxNumCallSites = 10,
+                           ReportOrder   order = e_BY_BYTES_IN_USE) const;
+        // Write to the specified 'stream' a report of the allocations
+        // performed by this allocator, followed by the statistics and the
+        // resolved call stack of at most the optionally specified
+        // 'maxNumCallSites' call sites, in the optionally specified 'order',
+        // and return 'stream'.  If 'maxNumCallSites' is not specified, 10 is
+        // used; if 'order' is not specified, the call sites are ordered by
+        // decreasing estimated number of bytes in use.  Note that resolving
+        // the call stacks may be expensive, and that the format of the report
+        // is not fully specified, and can change without notice.
+
+    int samplingInterval() const;
+        // Return the mean number of bytes allocated between two samples.
+};
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                          // ------------------------
+                          // class ProfilingAllocator
+                          // ------------------------
+
+// ACCESSORS
+inline
+int ProfilingAllocator::samplingInterval() const
+{
+    return d_samplingInterval;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1090 @@
+// balst_profilingallocator.t.cpp                                     -*-C++-*-
+#include <balst_profilingallocator.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_mallocfreeallocator.h>
+#include <bslma_testallocator.h>
+
+#include <bslmt_threadutil.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_asserttest.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                              TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is an allocator that forwards its requests to an
+// underlying allocator, and samples them to maintain statistics per call
+// site.  The forwarding is verified using a 'bslma::TestAllocator' as the
+// underlying allocator.  The statistics are verified exactly with a sampling
+// interval of 1 byte, with which every allocation is sampled, and
+// statistically with larger sampling intervals.  Call sites are distinguished
+// by their call stacks, so that two calls to 'allocate' at different places
+// of a function yield different call sites.  The resolution of the call
+// stacks is the responsibility of 'balst::StackTraceUtil', and is only
+// exercised by the tests of 'printReport'.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] ProfilingAllocator(bslma::Allocator *basicAllocator = 0);
+// [ 2] ProfilingAllocator(int samplingInterval, *ba = 0);
+// [ 2] ProfilingAllocator(int samplingInterval, int numFrames, *ba = 0);
+// [ 2] ~ProfilingAllocator();
+//
+// MANIPULATORS
+// [ 3] void *allocate(size_type size);
+// [ 3] void deallocate(void *address);
+//
+// ACCESSORS
+// [ 4] void loadCallSites(bsl::vector<CallSite> *, ReportOrder) const;
+// [ 3] bsls::Types::Int64 numAllocations() const;
+// [ 3] bsls::Types::Int64 numBytesInUse() const;
+// [ 4] bsls::Types::Int64 numSamples() const;
+// [ 6] bsl::ostream& printReport(bsl::ostream&, int, ReportOrder) const;
+// [ 2] int samplingInterval() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] SAMPLING ESTIMATES
+// [ 7] CONCURRENCY TEST
+// [ 8] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST: overhead vs. the underlying allocator
+// ----------------------------------------------------------------------------
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef balst::ProfilingAllocator Obj;
+typedef Obj::CallSite             CallSite;
+typedef bsls::Types::Int64        Int64;
+
+enum { k_MAX_ALIGNMENT = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT };
+
+// ============================================================================
+//                          HELPER FUNCTIONS
+// ----------------------------------------------------------------------------
+
+static
+bool isMaximallyAligned(const void *address)
+    // Return 'true' if the specified 'address' is maximally aligned, and
+    // 'false' otherwise.
+{
+    return 0 == reinterpret_cast<bsls::Types::UintPtr>(address)
+                                                         % k_MAX_ALIGNMENT;
+}
+
+static
+const CallSite *findCallSite(const bsl::vector<CallSite>& callSites,
+                             Int64                        numSamples)
+    // Return the address of the first element of the specified 'callSites'
+    // having the specified 'numSamples', or 0 if there is no such element.
+{
+    for (bsl::size_t i = 0; i < callSites.size(); ++i) {
+        if (numSamples == callSites[i].d_numSamples) {
+            return &callSites[i];                                     // RETURN
+        }
+    }
+    return 0;
+}
+
+static
+Int64 sumLifetimes(const CallSite& callSite)
+    // Return the number of samples counted in the lifetime histogram of the
+    // specified 'callSite'.
+{
+    Int64 sum = 0;
+    for (int i = 0; i < Obj::k_NUM_LIFETIME_BUCKETS; ++i) {
+        sum += callSite.d_lifetimes[i];
+    }
+    return sum;
+}
+
+                             // ================
+                             // struct ChurnArgs
+                             // ================
+
+struct ChurnArgs {
+    // This 'struct' holds the arguments of 'churn'.
+
+    Obj *d_allocator_p;    // allocator under test
+    int  d_numRounds;      // number of rounds of allocation
+    int  d_numBlocks;      // number of blocks per round
+};
+
+extern "C"
+void *churn(void *arg)
+    // Repeatedly allocate and deallocate blocks from the allocator specified
+    // by 'arg', which must be the address of a 'ChurnArgs' object.
+{
+    ChurnArgs *args = static_cast<ChurnArgs *>(arg);
+
+    bsl::vector<void *> blocks(&bslma::MallocFreeAllocator::singleton());
+    blocks.resize(args->d_numBlocks);
+
+    for (int round = 0; round < args->d_numRounds; ++round) {
+        for (int i = 0; i < args->d_numBlocks; ++i) {
+            blocks[i] = args->d_allocator_p->allocate(1 + i % 200);
+            bsl::memset(blocks[i], 'c', 1 + i % 200);
+        }
+        for (int i = 0; i < args->d_numBlocks; ++i) {
+            args->d_allocator_p->deallocate(blocks[i]);
+        }
+    }
+    return 0;
+}
+
+extern "C"
+void *allocateBlock(void *arg)
+    // Allocate a block of 100 bytes from the allocator specified by 'arg',
+    // which must be the address of an 'Obj', and return its address.
+{
+    return static_cast<Obj *>(arg)->allocate(100);
+}
+
+//=============================================================================
+//                              USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Finding the Dominant Allocation Sites
+/// - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a service spends much of its time in its allocator, and that
+// we want to find which of its containers are responsible for the allocator
+// traffic.
+//
+// First, we define two functions that allocate memory, one of which builds
+// many more strings than the other:
+//..
+    void loadNames(bsl::vector<bsl::string> *names, int numNames)
+        // Load into the specified 'names' the specified 'numNames' strings.
+    {
+        for (int i = 0; i < numNames; ++i) {
+            names->push_back(bsl::string(
+                            "a string long enough to allocate memory",
+                            names->get_allocator()));
+        }
+    }
+
+    void loadCodes(bsl::vector<int> *codes, int numCodes)
+        // Load into the specified 'codes' the specified 'numCodes' integers.
+    {
+        for (int i = 0; i < numCodes; ++i) {
+            codes->push_back(i);
+        }
+    }
+//..
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int  test                = argc > 1 ? atoi(argv[1]) : 0;
+    bool verbose             = argc > 2;
+    bool veryVerbose         = argc > 3;
+    bool veryVeryVerbose     = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+// Then, we create a profiling allocator.  For the purpose of this example, we
+// sample every allocation, whereas a production application would use the
+// default sampling interval:
+//..
+    balst::ProfilingAllocator profiler(1);
+//..
+// Next, we exercise the functions using the profiler (in a production
+// application, the profiler would likely be installed as the default
+// allocator):
+//..
+    bsl::vector<bsl::string> names(&profiler);
+    bsl::vector<int>         codes(&profiler);
+
+    loadNames(&names, 1000);
+    loadCodes(&codes, 1000);
+//..
+// Now, we obtain the call sites ordered by the number of allocations, and
+// observe that the most frequently allocating call site is the construction of
+// the strings, which was sampled 1000 times, whereas the growth of the vectors
+// accounts for a few allocations only:
+//..
+    bsl::vector<balst::ProfilingAllocator::CallSite> callSites;
+    profiler.loadCallSites(&callSites,
+                           balst::ProfilingAllocator::e_BY_ALLOCATIONS);
+
+    ASSERT(3    <= callSites.size());
+    ASSERT(1000 == callSites[0].d_numSamples);
+    ASSERT(1000 == callSites[0].d_estimatedAllocations);
+    ASSERT(  20 >= callSites.back().d_estimatedAllocations);
+//..
+// Finally, we print a report of the three call sites having the most bytes in
+// use, including their resolved stack traces:
+//..
+    bsl::ostringstream report;
+    profiler.printReport(report, 3);
+//..
+        if (veryVerbose) {
+            cout << report.str();
+        }
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY TEST
+        //
+        // Concerns:
+        //: 1 The allocator can be used concurrently by several threads, and
+        //:   its exact and sampled statistics remain consistent.
+        //:
+        //: 2 The counts of a thread that has exited are preserved, and its
+        //:   statistics are reused by the next thread using the allocator.
+        //
+        // Plan:
+        //: 1 Have several threads repeatedly allocate and deallocate blocks
+        //:   from an allocator having a small sampling interval.  Verify that
+        //:   the number of allocations is exact, that no bytes remain in use,
+        //:   that samples were taken, and that the statistics of the call
+        //:   sites show no samples in use.  (C-1)
+        //:
+        //: 2 Create and join, one after the other, several threads that each
+        //:   allocate a block without deallocating it.  Verify the exact
+        //:   statistics, and that the underlying allocator supplies a single
+        //:   block of statistics for all these threads.  Deallocate the
+        //:   blocks from the main thread, and verify the exact statistics.
+        //:   (C-2)
+        //
+        // Testing:
+        //   CONCURRENCY TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENCY TEST" << endl
+                          << "================" << endl;
+
+        enum { k_NUM_THREADS = 8, k_NUM_ROUNDS = 50, k_NUM_BLOCKS = 500 };
+
+        bslma::TestAllocator ta("underlying", veryVeryVerbose);
+        {
+            Obj mX(256, &ta);  const Obj& X = mX;
+
+            ChurnArgs args = { &mX, k_NUM_ROUNDS, k_NUM_BLOCKS };
+
+            bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                ASSERTV(i, 0 == bslmt::ThreadUtil::create(&handles[i],
+                                                          churn,
+                                                          &args));
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                bslmt::ThreadUtil::join(handles[i]);
+            }
+
+            ASSERT(k_NUM_THREADS * k_NUM_ROUNDS * k_NUM_BLOCKS ==
+                                                         X.numAllocations());
+            ASSERT(0 == X.numBytesInUse());
+            ASSERT(0 <  X.numSamples());
+
+            bsl::vector<CallSite> callSites(&ta);
+            X.loadCallSites(&callSites);
+
+            Int64 numSamples = 0;
+            for (bsl::size_t i = 0; i < callSites.size(); ++i) {
+                const CallSite& CS = callSites[i];
+
+                ASSERTV(i, 0 == CS.d_numSamplesInUse);
+                ASSERTV(i, 0 == CS.d_estimatedBytesInUse);
+                ASSERTV(i, 0 == CS.d_estimatedBlocksInUse);
+                ASSERTV(i, CS.d_numSamples == sumLifetimes(CS));
+
+                numSamples += CS.d_numSamples;
+            }
+            ASSERT(X.numSamples() == numSamples);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\nTesting exited threads." << endl;
+        {
+            enum { k_NUM_BLOCKS = 5 };
+
+            // Sample no allocation, so that the underlying allocator supplies
+            // only the blocks and the statistics of the threads.
+
+            Obj mX(1 << 30, &ta);  const Obj& X = mX;
+
+            void *blocks[k_NUM_BLOCKS];
+
+            for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+                bslmt::ThreadUtil::Handle handle;
+                ASSERTV(i, 0 == bslmt::ThreadUtil::create(&handle,
+                                                          allocateBlock,
+                                                          &mX));
+                bslmt::ThreadUtil::join(handle, &blocks[i]);
+
+                ASSERTV(i, X.numAllocations(), i + 1 == X.numAllocations());
+                ASSERTV(i, X.numBytesInUse(),
+                        100 * (i + 1) == X.numBytesInUse());
+                ASSERTV(i, ta.numBlocksInUse(),
+                        i + 2 == ta.numBlocksInUse());
+            }
+            ASSERT(0 == X.numSamples());
+
+            for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+            ASSERTV(X.numAllocations(), k_NUM_BLOCKS == X.numAllocations());
+            ASSERTV(X.numBytesInUse(),  0            == X.numBytesInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // 'printReport'
+        //
+        // Concerns:
+        //: 1 The report states the exact statistics of the allocator and the
+        //:   statistics of at most the specified number of call sites.
+        //:
+        //: 2 The report includes the resolved call stack of each reported
+        //:   call site.
+        //:
+        //: 3 'printReport' returns the specified stream.
+        //
+        // Plan:
+        //: 1 Allocate from three call sites, and print reports of 0, 1, and
+        //:   all call sites; verify the number of call site sections and the
+        //:   presence of the statistics.  (C-1, 3)
+        //:
+        //: 2 Verify that the report of a call site names a function of this
+        //:   test driver.  (C-2)
+        //
+        // Testing:
+        //   bsl::ostream& printReport(bsl::ostream&, int, ReportOrder) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'printReport'" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator ta("underlying", veryVeryVerbose);
+        bslma::TestAllocator sa("stream", veryVeryVerbose);
+
+        Obj mX(1, &ta);  const Obj& X = mX;
+
+        bsl::vector<bsl::string> names(&mX);
+        loadNames(&names, 10);
+
+        void *p = mX.allocate(1000);
+        void *q = mX.allocate(2000);
+
+        for (int n = 0; n < 4; ++n) {
+            bsl::ostringstream report(&sa);
+
+            ASSERTV(n, &report == &X.printReport(report, n));
+
+            const bsl::string text(report.str(), &sa);
+
+            if (veryVerbose) {
+                cout << text;
+            }
+
+            ASSERTV(n, bsl::string::npos != text.find("Allocation profile"));
+            ASSERTV(n, bsl::string::npos != text.find("allocation(s)"));
+
+            int numSections = 0;
+            for (bsl::size_t pos = text.find("Call site ");
+                 bsl::string::npos != pos;
+                 pos = text.find("Call site ", pos + 1)) {
+                ++numSections;
+            }
+            ASSERTV(n, numSections, n == numSections);
+            if (0 < n) {
+                ASSERTV(n, bsl::string::npos != text.find("Lifetimes"));
+                ASSERTV(n, bsl::string::npos != text.find("main"));
+            }
+        }
+
+        mX.deallocate(q);
+        mX.deallocate(p);
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // SAMPLING ESTIMATES
+        //
+        // Concerns:
+        //: 1 With a sampling interval larger than the allocations, the number
+        //:   of samples is about the number of bytes allocated divided by the
+        //:   sampling interval.
+        //:
+        //: 2 The estimated numbers of allocations and of bytes allocated are
+        //:   close to the exact numbers.
+        //:
+        //: 3 Allocations larger than one and a half times the sampling
+        //:   interval are always sampled.
+        //
+        // Plan:
+        //: 1 Allocate many blocks of a small size from one call site, and
+        //:   verify that the number of samples and the estimates are within
+        //:   10% of the expected values.  (C-1..2)
+        //:
+        //: 2 Allocate blocks of twice the sampling interval, and verify that
+        //:   each is sampled with a weight of its size.  (C-3)
+        //
+        // Testing:
+        //   SAMPLING ESTIMATES
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "SAMPLING ESTIMATES" << endl
+                          << "==================" << endl;
+
+        enum { k_INTERVAL = 1024, k_SIZE = 64, k_NUM_BLOCKS = 200000 };
+
+        bslma::TestAllocator ta("underlying", veryVeryVerbose);
+        {
+            Obj mX(k_INTERVAL, &ta);  const Obj& X = mX;
+
+            for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+                mX.deallocate(mX.allocate(k_SIZE));
+            }
+
+            const Int64 EXPECTED = static_cast<Int64>(k_NUM_BLOCKS) * k_SIZE
+                                                                / k_INTERVAL;
+
+            if (veryVerbose) { P_(EXPECTED) P(X.numSamples()) }
+
+            ASSERTV(X.numSamples(), X.numSamples() > EXPECTED * 9 / 10);
+            ASSERTV(X.numSamples(), X.numSamples() < EXPECTED * 11 / 10);
+
+            bsl::vector<CallSite> callSites(&ta);
+            X.loadCallSites(&callSites, Obj::e_BY_ALLOCATIONS);
+
+            ASSERT(1 == callSites.size());
+
+            const CallSite& CS = callSites[0];
+
+            ASSERTV(CS.d_estimatedAllocations,
+                    CS.d_estimatedAllocations > k_NUM_BLOCKS * 9 / 10);
+            ASSERTV(CS.d_estimatedAllocations,
+                    CS.d_estimatedAllocations < k_NUM_BLOCKS * 11 / 10);
+            ASSERT(CS.d_estimatedBytesAllocated ==
+                                         CS.d_estimatedAllocations * k_SIZE);
+            ASSERT(0 == CS.d_estimatedBytesInUse);
+        }
+        {
+            Obj mX(k_INTERVAL, &ta);  const Obj& X = mX;
+
+            bsl::vector<void *> blocks(&ta);
+            for (int i = 0; i < 10; ++i) {
+                blocks.push_back(mX.allocate(2 * k_INTERVAL));
+            }
+            ASSERT(10 == X.numSamples());
+
+            bsl::vector<CallSite> callSites(&ta);
+            X.loadCallSites(&callSites);
+
+            ASSERT(1 == callSites.size());
+            ASSERT(10                  == callSites[0].d_estimatedAllocations);
+            ASSERT(20 * k_INTERVAL     == callSites[0].d_estimatedBytesInUse);
+
+            for (int i = 0; i < 10; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // CALL SITES
+        //
+        // Concerns:
+        //: 1 With a sampling interval of 1, every allocation is sampled, and
+        //:   the statistics of each call site are exact.
+        //:
+        //: 2 Allocations from different places are attributed to different
+        //:   call sites, and repeated allocations from the same place to the
+        //:   same call site.
+        //:
+        //: 3 Deallocation updates the statistics of the call site of the
+        //:   block, including its lifetime histogram.
+        //:
+        //: 4 'loadCallSites' orders the call sites as specified.
+        //:
+        //: 5 The number of recorded frames is limited as specified.
+        //
+        // Plan:
+        //: 1 Allocate 5 blocks of 100 bytes in a loop, and 3 blocks of 1000
+        //:   bytes in another loop.  Verify the statistics of the two call
+        //:   sites, and their order for each 'ReportOrder'.  (C-1..2, 4)
+        //:
+        //: 2 Deallocate some of the blocks and verify the statistics.  (C-3)
+        //:
+        //: 3 Create allocators recording 1 and 'k_MAX_RECORDED_FRAMES' frames,
+        //:   and verify the number of addresses of their call sites.  (C-5)
+        //
+        // Testing:
+        //   void loadCallSites(bsl::vector<CallSite> *, ReportOrder) const;
+        //   bsls::Types::Int64 numSamples() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CALL SITES" << endl
+                          << "==========" << endl;
+
+        bslma::TestAllocator ta("underlying", veryVeryVerbose);
+        {
+            Obj mX(1, &ta);  const Obj& X = mX;
+
+            void *small[5];
+            void *large[3];
+
+            for (int i = 0; i < 5; ++i) {
+                small[i] = mX.allocate(100);
+            }
+            for (int i = 0; i < 3; ++i) {
+                large[i] = mX.allocate(1000);
+            }
+
+            ASSERT(8 == X.numSamples());
+
+            bsl::vector<CallSite> callSites(&ta);
+
+            X.loadCallSites(&callSites);
+            ASSERT(2 == callSites.size());
+
+            // 'large' has more bytes in use and allocated.
+
+            ASSERT(3    == callSites[0].d_numSamples);
+            ASSERT(3    == callSites[0].d_numSamplesInUse);
+            ASSERT(3    == callSites[0].d_estimatedAllocations);
+            ASSERT(3    == callSites[0].d_estimatedBlocksInUse);
+            ASSERT(3000 == callSites[0].d_estimatedBytesAllocated);
+            ASSERT(3000 == callSites[0].d_estimatedBytesInUse);
+            ASSERT(0    == sumLifetimes(callSites[0]));
+            ASSERT(0    <  callSites[0].d_numAddresses);
+
+            ASSERT(5    == callSites[1].d_numSamples);
+            ASSERT(500  == callSites[1].d_estimatedBytesAllocated);
+
+            X.loadCallSites(&callSites, Obj::e_BY_BYTES_ALLOCATED);
+            ASSERT(3 == callSites[0].d_numSamples);
+
+            X.loadCallSites(&callSites, Obj::e_BY_ALLOCATIONS);
+            ASSERT(5 == callSites[0].d_numSamples);
+
+            // The call stacks differ.
+
+            ASSERT(callSites[0].d_numAddresses != callSites[1].d_numAddresses
+                || 0 != bsl::memcmp(callSites[0].d_addresses,
+                                    callSites[1].d_addresses,
+                                    callSites[0].d_numAddresses *
+                                              sizeof(const void *)));
+
+            for (int i = 0; i < 3; ++i) {
+                mX.deallocate(large[i]);
+            }
+            for (int i = 0; i < 2; ++i) {
+                mX.deallocate(small[i]);
+            }
+
+            X.loadCallSites(&callSites);
+            ASSERT(2 == callSites.size());
+
+            const CallSite *LARGE = findCallSite(callSites, 3);
+            const CallSite *SMALL = findCallSite(callSites, 5);
+
+            ASSERT(LARGE);  ASSERT(SMALL);
+
+            ASSERT(0    == LARGE->d_numSamplesInUse);
+            ASSERT(0    == LARGE->d_estimatedBytesInUse);
+            ASSERT(3000 == LARGE->d_estimatedBytesAllocated);
+            ASSERT(3    == sumLifetimes(*LARGE));
+            ASSERT(3    == SMALL->d_numSamplesInUse);
+            ASSERT(300  == SMALL->d_estimatedBytesInUse);
+            ASSERT(2    == sumLifetimes(*SMALL));
+
+            // Reported first now that 'large' blocks are deallocated.
+
+            ASSERT(5 == callSites[0].d_numSamples);
+
+            for (int i = 2; i < 5; ++i) {
+                mX.deallocate(small[i]);
+            }
+        }
+        {
+            Obj mX(1, 1, &ta);  const Obj& X = mX;
+
+            mX.deallocate(mX.allocate(10));
+
+            bsl::vector<CallSite> callSites(&ta);
+            X.loadCallSites(&callSites);
+            ASSERT(1 == callSites.size());
+            ASSERT(1 == callSites[0].d_numAddresses);
+        }
+        {
+            Obj mX(1, Obj::k_MAX_RECORDED_FRAMES, &ta);  const Obj& X = mX;
+
+            mX.deallocate(mX.allocate(10));
+
+            bsl::vector<CallSite> callSites(&ta);
+            X.loadCallSites(&callSites);
+            ASSERT(1 == callSites.size());
+            ASSERT(1 <= callSites[0].d_numAddresses);
+            ASSERT(Obj::k_MAX_RECORDED_FRAMES >= callSites[0].d_numAddresses);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'allocate' AND 'deallocate'
+        //
+        // Concerns:
+        //: 1 Each allocation and deallocation is forwarded to the underlying
+        //:   allocator.
+        //:
+        //: 2 The returned blocks are maximally aligned and writable.
+        //:
+        //: 3 'allocate(0)' returns 0, and 'deallocate(0)' has no effect.
+        //:
+        //: 4 'numAllocations' and 'numBytesInUse' are exact, whether or not
+        //:   allocations are sampled.
+        //:
+        //: 5 The default allocator is not used.
+        //
+        // Plan:
+        //: 1 Using allocators having sampling intervals of 1 and of the
+        //:   default, allocate blocks of sizes 1 to 300, fill them, verify the
+        //:   statistics of the allocator and of the underlying test allocator,
+        //:   deallocate the blocks, and verify the statistics again.
+        //:   (C-1..2, 4)
+        //:
+        //: 2 Invoke 'allocate(0)' and 'deallocate(0)'.  (C-3)
+        //:
+        //: 3 Install a test allocator as the default allocator, and verify
+        //:   that it is not used.  (C-5)
+        //
+        // Testing:
+        //   void *allocate(size_type size);
+        //   void deallocate(void *address);
+        //   bsls::Types::Int64 numAllocations() const;
+        //   bsls::Types::Int64 numBytesInUse() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'allocate' AND 'deallocate'" << endl
+                          << "===========================" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::TestAllocator         ta("underlying", veryVeryVerbose);
+        bslma::TestAllocator         sa("scratch", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+
+        enum { k_NUM_BLOCKS = 300 };
+
+        for (int ti = 0; ti < 2; ++ti) {
+            Obj  mA(1, &ta);
+            Obj  mB(&ta);
+            Obj& mX = 0 == ti ? mA : mB;  const Obj& X = mX;
+
+            bsl::vector<char *> blocks(&sa);
+            Int64               numBytes = 0;
+
+            for (int size = 1; size <= k_NUM_BLOCKS; ++size) {
+                char *p = static_cast<char *>(mX.allocate(size));
+                ASSERTV(ti, size, isMaximallyAligned(p));
+                bsl::memset(p, static_cast<char>(size), size);
+                blocks.push_back(p);
+                numBytes += size;
+
+                ASSERTV(ti, size, size     == X.numAllocations());
+                ASSERTV(ti, size, numBytes == X.numBytesInUse());
+                ASSERTV(ti, size, size     <= ta.numBlocksInUse());
+            }
+            for (int size = 1; size <= k_NUM_BLOCKS; ++size) {
+                const char *p = blocks[size - 1];
+                for (int i = 0; i < size; ++i) {
+                    ASSERTV(ti, size, i, static_cast<char>(size) == p[i]);
+                }
+            }
+            for (int size = 1; size <= k_NUM_BLOCKS; ++size) {
+                mX.deallocate(blocks[size - 1]);
+                numBytes -= size;
+
+                ASSERTV(ti, size, numBytes == X.numBytesInUse());
+            }
+            ASSERTV(ti, k_NUM_BLOCKS == X.numAllocations());
+            ASSERTV(ti, 0 == X.numBytesInUse());
+
+            if (0 == ti) {
+                ASSERT(k_NUM_BLOCKS == X.numSamples());
+            }
+
+            ASSERTV(ti, 0 == mX.allocate(0));
+            mX.deallocate(0);
+            ASSERTV(ti, k_NUM_BLOCKS == X.numAllocations());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS AND 'samplingInterval'
+        //
+        // Concerns:
+        //: 1 The default sampling interval is 512 KiB.
+        //:
+        //: 2 The specified sampling interval is reported.
+        //:
+        //: 3 If no allocator is specified, the 'bslma::MallocFreeAllocator'
+        //:   singleton, rather than the default allocator, is used.
+        //:
+        //: 4 A newly created allocator has no allocations and no samples.
+        //:
+        //: 5 The destructor returns the memory used for the statistics.
+        //:
+        //: 6 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create allocators using each constructor, with and without an
+        //:   underlying allocator, and verify the accessors.  (C-1..2, 4)
+        //:
+        //: 2 Install a test allocator as the default allocator, and verify
+        //:   that it is not used.  (C-3)
+        //:
+        //: 3 Take samples using a test allocator as the underlying allocator,
+        //:   and verify that all of its memory is returned after the
+        //:   destruction of the allocator.  (C-5)
+        //:
+        //: 4 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments (using the 'BSLS_ASSERTTEST_*'
+        //:   macros).  (C-6)
+        //
+        // Testing:
+        //   ProfilingAllocator(bslma::Allocator *basicAllocator = 0);
+        //   ProfilingAllocator(int samplingInterval, *ba = 0);
+        //   ProfilingAllocator(int samplingInterval, int numFrames, *ba = 0);
+        //   ~ProfilingAllocator();
+        //   int samplingInterval() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS AND 'samplingInterval'" << endl
+                          << "===============================" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::TestAllocator         ta("underlying", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+
+        {
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT(512 * 1024 == X.samplingInterval());
+            ASSERT(0          == X.numAllocations());
+            ASSERT(0          == X.numBytesInUse());
+            ASSERT(0          == X.numSamples());
+
+            mX.deallocate(mX.allocate(1024 * 1024));
+            ASSERT(1 == X.numSamples());
+        }
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERT(512 * 1024 == X.samplingInterval());
+
+            mX.deallocate(mX.allocate(1024 * 1024));
+            ASSERT(1 == X.numSamples());
+            ASSERT(0 <  ta.numBlocksInUse());  // call site
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        {
+            Obj mX(100);  const Obj& X = mX;
+
+            ASSERT(100 == X.samplingInterval());
+            ASSERT(0   == X.numSamples());
+        }
+        {
+            Obj mX(1, &ta);  const Obj& X = mX;
+
+            ASSERT(1 == X.samplingInterval());
+
+            for (int i = 0; i < 10; ++i) {
+                mX.deallocate(mX.allocate(10));
+                mX.deallocate(mX.allocate(20));
+            }
+            ASSERT(20 == X.numSamples());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        {
+            Obj mX(4096, 4);  const Obj& X = mX;
+
+            ASSERT(4096 == X.samplingInterval());
+        }
+        {
+            Obj mX(4096, 4, &ta);  const Obj& X = mX;
+
+            ASSERT(4096 == X.samplingInterval());
+        }
+        ASSERT(0 == da.numBlocksTotal());
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_FAIL(Obj(0));
+            ASSERT_PASS(Obj(1));
+            ASSERT_FAIL(Obj(1, 0));
+            ASSERT_PASS(Obj(1, 1));
+            ASSERT_PASS(Obj(1, Obj::k_MAX_RECORDED_FRAMES));
+            ASSERT_FAIL(Obj(1, Obj::k_MAX_RECORDED_FRAMES + 1));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic
+        //   functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Allocate blocks from a profiling allocator sampling every
+        //:   allocation, and verify the statistics and the report.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("underlying", veryVeryVerbose);
+        {
+            Obj mX(1, &ta);  const Obj& X = mX;
+
+            char *p = static_cast<char *>(mX.allocate(5));
+            char *q = static_cast<char *>(mX.allocate(100));
+
+            bsl::strcpy(p, "abcd");
+            bsl::memset(q, 'q', 100);
+            ASSERT(0 == bsl::strcmp(p, "abcd"));
+
+            ASSERT(2   == X.numAllocations());
+            ASSERT(105 == X.numBytesInUse());
+            ASSERT(2   == X.numSamples());
+            ASSERT(2   <= ta.numBlocksInUse());
+
+            mX.deallocate(q);
+            ASSERT(5   == X.numBytesInUse());
+
+            bsl::vector<CallSite> callSites(&ta);
+            X.loadCallSites(&callSites);
+
+            ASSERT(2 == callSites.size());
+            ASSERT(5 == callSites[0].d_estimatedBytesInUse);
+            ASSERT(0 == callSites[1].d_estimatedBytesInUse);
+
+            bsl::ostringstream report(&ta);
+            X.printReport(report);
+            if (veryVerbose) {
+                cout << report.str();
+            }
+            ASSERT(bsl::string::npos != report.str().find("Call site 2 of 2"));
+
+            mX.deallocate(p);
+            ASSERT(0   == X.numBytesInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST: overhead vs. the underlying allocator
+        //
+        // Concerns:
+        //: 1 With the default sampling interval, the overhead of profiling
+        //:   is small compared to the cost of the underlying allocation.
+        //
+        // Plan:
+        //: 1 Time bursts of small allocations and deallocations made directly
+        //:   from the 'bslma::MallocFreeAllocator' singleton, and through
+        //:   profiling allocators having the default sampling interval and a
+        //:   sampling interval of 1 byte.  The number of iterations may be
+        //:   specified as the second argument.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE TEST: overhead vs. the underlying allocator
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE TEST: overhead vs. the underlying allocator"
+             << endl
+             << "======================================================="
+             << endl;
+
+        const int numIterations = argc > 2 ? atoi(argv[2]) : 100000;
+
+        enum { k_BURST = 64 };
+
+        bslma::Allocator *underlying =
+                                   &bslma::MallocFreeAllocator::singleton();
+
+        Obj sampling(underlying);
+        Obj exhaustive(1, underlying);
+
+        bslma::Allocator *ALLOCATORS[] = { underlying,
+                                           &sampling,
+                                           &exhaustive };
+        const char       *NAMES[]      = { "malloc/free",
+                                           "profiling (default interval)",
+                                           "profiling (every allocation)" };
+
+        for (int ti = 0; ti < 3; ++ti) {
+            bslma::Allocator *allocator = ALLOCATORS[ti];
+            void             *blocks[k_BURST];
+
+            const int numRounds = 2 == ti ? numIterations / 100 + 1
+                                          : numIterations;
+
+            bsls::Stopwatch timer;
+            timer.start(true);
+            for (int round = 0; round < numRounds; ++round) {
+                for (int i = 0; i < k_BURST; ++i) {
+                    blocks[i] = allocator->allocate(16 + i * 8);
+                }
+                for (int i = 0; i < k_BURST; ++i) {
+                    allocator->deallocate(blocks[i]);
+                }
+            }
+            timer.stop();
+
+            cout << NAMES[ti] << ": "
+                 << timer.accumulatedWallTime() * 1e9
+                                           / (double(numRounds) * k_BURST)
+                 << " ns per allocation" << endl;
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
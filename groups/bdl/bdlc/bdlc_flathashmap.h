@@ -0,0 +1,1333 @@
+// bdlc_flathashmap.h                                                 -*-C++-*-
+
+#ifndef INCLUDED_BDLC_FLATHASHMAP
+#define INCLUDED_BDLC_FLATHASHMAP
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an open-addressed unordered map container.
+//
+//@CLASSES:
+//  bdlc::FlatHashMap: open-addressed unordered map container
+//
+//@SEE_ALSO: bdlc_flathashtable, bdlc_flathashset, bslstl_unorderedmap
+//
+//@DESCRIPTION: This component defines a single class template,
+// 'bdlc::FlatHashMap', that implements an open-addressed unordered map of
+// items with unique keys.
+//
+// Unordered maps are useful in situations when there is no meaningful way to
+// order key values, when the order of the values is irrelevant to the problem
+// domain, or (even if there is a meaningful ordering) the value of ordering
+// the results is outweighed by the higher performance provided by unordered
+// maps (compared to ordered maps).
+//
+// The unordered map provided by this component, 'bdlc::FlatHashMap', differs
+// from 'bsl::unordered_map' in that its elements are stored directly in a
+// single contiguous array (see 'bdlc_flathashtable') rather than in
+// individually allocated nodes linked into a list.  Consequently, inserting
+// an element does not allocate memory unless the map must grow, and a lookup
+// typically incurs a single cache miss on the control values followed by a
+// single cache miss on the element.  On platforms providing SSE2 instructions,
+// sixteen candidate elements are examined with a single comparison.
+//
+// The performance characteristics of 'bdlc::FlatHashMap' are, however,
+// different from those of 'bsl::unordered_map':
+//: o Any operation that changes the capacity of the map (including an
+//:   insertion that causes the map to grow) invalidates all iterators,
+//:   pointers, and references to elements; in particular, the address of an
+//:   element is not stable.
+//:
+//: o Elements are relocated (moved, or copied bitwise for types having the
+//:   'bslmf::IsBitwiseMoveable' trait) when the map grows, so very large
+//:   'value_type' objects are better held in a node-based container.
+//:
+//: o The map does not support a configurable maximum load factor, and the
+//:   bucket interface of 'bsl::unordered_map' is not provided.
+//
+// The 'HASH' template parameter defaults to 'bsl::hash<KEY>', which, for
+// types other than the fundamental types, uses 'bslh::Hash<>' and therefore
+// the 'hashAppend' free function of 'KEY'.  Any 'bslh'-conforming functor,
+// e.g., 'bslh::Hash<bslh::SipHashAlgorithm>', may be supplied instead.  Note
+// that the map multiplies each hash value by a golden-ratio constant before
+// use, so the identity hash used by 'bsl::hash' for integral types performs
+// well.
+//
+// Note that 'value_type' is 'bsl::pair<KEY, VALUE>', rather than
+// 'bsl::pair<const KEY, VALUE>', so that elements can be relocated
+// efficiently; modifying the key of an element in a map results in undefined
+// behavior.
+//
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: Gathering Document Statistics
+/// - - - - - - - - - - - - - - - - - - - -
+// Suppose one wished to gather statistics on the words appearing in a large
+// set of documents on disk or in a database.  Gathering those statistics is
+// intrusive (as one is competing for access to the documents with the regular
+// users) and must be done as quickly as possible.  Moreover, the set of unique
+// words appearing in those documents may be high.  The English language has
+// in excess of a million words (albeit many appear infrequently), and, if the
+// documents contain serial numbers, or Social Security numbers, or chemical
+// formulas, etc., then the 'O[log(n)]' insertion time of ordered maps may well
+// be inadequate.  An unordered map, having an 'O[1]' typical insertion cost,
+// is a viable alternative.
+//
+// This example illustrates the use of 'bdlc::FlatHashMap' to gather one simple
+// statistic (counts of unique words) on a portion of a single document.  To
+// avoid irrelevant details of acquiring the data, the data is stored in static
+// arrays:
+//..
+//  static char document[] =
+//  " IN CONGRESS, July 4, 1776.\n"
+//  "\n"
+//  " The unanimous Declaration of the thirteen united States of America,\n"
+//  "\n"
+//  " When in the Course of human events, it becomes necessary for one\n"
+//  " people to dissolve the political bands which have connected them with\n"
+//  " another, and to assume among the powers of the earth, the separate\n"
+//  " and equal station to which the Laws of Nature and of Nature's God\n"
+//  " entitle them, a decent respect to the opinions of mankind requires\n"
+//  " that they should declare the causes which impel them to the\n"
+//  " separation.  We hold these truths to be self-evident, that all men\n"
+//  " are created equal, that they are endowed by their Creator with\n"
+//  " certain unalienable Rights, that among these are Life, Liberty and\n"
+//  " the pursuit of Happiness.\n";
+//..
+// First, we define an alias to make our code more comprehensible:
+//..
+//  typedef bdlc::FlatHashMap<bsl::string, int> WordTally;
+//..
+// Next, we create an (empty) flat hash map to hold our word tallies:
+//..
+//  WordTally wordTally;
+//..
+// Then, we define the set of characters that define word boundaries:
+//..
+//  const char *delimiters = " \n\t,:;.()[]?!/";
+//..
+// Next, we extract the words from our document.  Note that 'strtok' modifies
+// the document array (which was not made 'const').
+//
+// As each word is located, we must determine if it has been seen before.  If
+// so, we must increment the count.  If not, we must add it to the flat hash
+// map with a count of 1.  Of course, this determination must be made for each
+// word.  The 'operator[]' method provides a simple solution.  If the key is
+// found, a reference to its value is returned; if not, a new element is
+// inserted having the key and a default-constructed value (0 for 'int'):
+//..
+//  for (char *cur = strtok(document, delimiters);
+//             cur;
+//             cur = strtok(NULL,     delimiters)) {
+//      ++wordTally[bsl::string(cur)];
+//  }
+//..
+// Now that the data has been (quickly) gathered, we can verify a few of the
+// tallies:
+//..
+//  assert(11 == wordTally["the"]);
+//  assert( 8 == wordTally["of"]);
+//  assert( 1 == wordTally["Declaration"]);
+//  assert( 0 == wordTally.count("Kraken"));
+//..
+
+#include <bdlscm_version.h>
+
+#include <bdlc_flathashtable.h>
+
+#include <bslma_allocator.h>
+#include <bslma_constructionutil.h>
+#include <bslma_destructorguard.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_enableif.h>
+#include <bslmf_isconvertible.h>
+#include <bslmf_movableref.h>
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bsls_assert.h>
+#include <bsls_compilerfeatures.h>
+#include <bsls_objectbuffer.h>
+
+#include <bslstl_stdexceptutil.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_functional.h>
+#include <bsl_utility.h>
+
+namespace BloombergLP {
+namespace bdlc {
+
+                         // ============================
+                         // struct FlatHashMap_EntryUtil
+                         // ============================
+
+template <class KEY, class VALUE, class ENTRY>
+struct FlatHashMap_EntryUtil {
+    // This templated utility provides methods to construct an 'ENTRY' and a
+    // method to extract the key from an 'ENTRY', as required by
+    // 'FlatHashTable'.
+
+    // CLASS METHODS
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES
+    template <class KEY_TYPE, class... ARGS>
+    static void construct(ENTRY            *entry,
+                          bslma::Allocator *allocator,
+                          KEY_TYPE&&        key,
+                          ARGS&&...         args);
+        // Load into the specified 'entry' the 'ENTRY' value comprised of the
+        // specified 'key' and a 'VALUE' constructed from the specified 'args',
+        // using the specified 'allocator' to supply memory.  Note that the
+        // 'VALUE' is constructed before the 'ENTRY', and is then moved into
+        // the 'ENTRY'.
+#else
+    template <class KEY_TYPE>
+    static void construct(
+                    ENTRY                                       *entry,
+                    bslma::Allocator                            *allocator,
+                    BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE)  key);
+    template <class KEY_TYPE, class ARG1>
+    static void construct(
+                    ENTRY                                       *entry,
+                    bslma::Allocator                            *allocator,
+                    BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE)  key,
+                    BSLS_COMPILERFEATURES_FORWARD_REF(ARG1)      arg1);
+        // Load into the specified 'entry' the 'ENTRY' value comprised of the
+        // specified 'key' and a 'VALUE' constructed from the optionally
+        // specified 'arg1', using the specified 'allocator' to supply memory.
+#endif
+
+    static const KEY& key(const ENTRY& entry);
+        // Return the key of the specified 'entry'.
+};
+
+                            // =================
+                            // class FlatHashMap
+                            // =================
+
+template <class KEY,
+          class VALUE,
+          class HASH  = bsl::hash<KEY>,
+          class EQUAL = bsl::equal_to<KEY> >
+class FlatHashMap {
+    // This class template implements a value-semantic container type holding
+    // an unordered set of uniquely-keyed values, stored in an open-addressed
+    // hash table.  See the component-level documentation for details.
+
+    // PRIVATE TYPES
+    typedef FlatHashTable<KEY,
+                          bsl::pair<KEY, VALUE>,
+                          FlatHashMap_EntryUtil<KEY,
+                                                VALUE,
+                                                bsl::pair<KEY, VALUE> >,
+                          HASH,
+                          EQUAL> ImplType;
+        // This is the underlying implementation class.
+
+    // FRIENDS
+    template <class K, class V, class H, class E>
+    friend bool operator==(const FlatHashMap<K, V, H, E>&,
+                           const FlatHashMap<K, V, H, E>&);
+
+  public:
+    // TYPES
+    typedef KEY                                      key_type;
+    typedef VALUE                                    mapped_type;
+    typedef bsl::pair<KEY, VALUE>                    value_type;
+    typedef bsl::size_t                              size_type;
+    typedef bsl::ptrdiff_t                           difference_type;
+    typedef EQUAL                                    key_equal;
+    typedef HASH                                     hasher;
+    typedef value_type&                              reference;
+    typedef const value_type&                        const_reference;
+    typedef value_type                              *pointer;
+    typedef const value_type                        *const_pointer;
+    typedef typename ImplType::iterator              iterator;
+    typedef typename ImplType::const_iterator        const_iterator;
+
+  private:
+    // DATA
+    ImplType d_impl;  // underlying flat hash table used by this flat hash map
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(FlatHashMap, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    FlatHashMap();
+    explicit FlatHashMap(bslma::Allocator *basicAllocator);
+    explicit FlatHashMap(bsl::size_t capacity);
+    FlatHashMap(bsl::size_t capacity, bslma::Allocator *basicAllocator);
+    FlatHashMap(bsl::size_t       capacity,
+                const HASH&       hash,
+                bslma::Allocator *basicAllocator = 0);
+    FlatHashMap(bsl::size_t       capacity,
+                const HASH&       hash,
+                const EQUAL&      equal,
+                bslma::Allocator *basicAllocator = 0);
+        // Create an empty 'FlatHashMap' object.  Optionally specify a
+        // 'capacity' indicating the minimum initial size of the underlying
+        // array of entries of this container.  If 'capacity' is not supplied
+        // or is 0, no memory is allocated.  Optionally specify a 'hash'
+        // functor used to generate the hash values associated with the keys
+        // of elements in this container.  If 'hash' is not supplied, a
+        // default-constructed object of the (template parameter) type 'HASH'
+        // is used.  Optionally specify an equality functor 'equal' used to
+        // determine whether the keys of two elements are equivalent.  If
+        // 'equal' is not supplied, a default-constructed object of the
+        // (template parameter) type 'EQUAL' is used.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is not
+        // supplied or is 0, the currently installed default allocator is
+        // used.
+
+    template <class INPUT_ITERATOR>
+    FlatHashMap(INPUT_ITERATOR    first,
+                INPUT_ITERATOR    last,
+                bslma::Allocator *basicAllocator = 0);
+    template <class INPUT_ITERATOR>
+    FlatHashMap(INPUT_ITERATOR    first,
+                INPUT_ITERATOR    last,
+                bsl::size_t       capacity,
+                bslma::Allocator *basicAllocator = 0);
+    template <class INPUT_ITERATOR>
+    FlatHashMap(INPUT_ITERATOR    first,
+                INPUT_ITERATOR    last,
+                bsl::size_t       capacity,
+                const HASH&       hash,
+                bslma::Allocator *basicAllocator = 0);
+    template <class INPUT_ITERATOR>
+    FlatHashMap(INPUT_ITERATOR    first,
+                INPUT_ITERATOR    last,
+                bsl::size_t       capacity,
+                const HASH&       hash,
+                const EQUAL&      equal,
+                bslma::Allocator *basicAllocator = 0);
+        // Create a 'FlatHashMap' object initialized by insertion of the values
+        // from the input iterator range specified by 'first' through 'last'
+        // (including 'first', excluding 'last').  Optionally specify a
+        // 'capacity' indicating the minimum initial size of the underlying
+        // array of entries of this container.  Optionally specify a 'hash'
+        // functor and an 'equal' functor (see above).  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is not
+        // supplied or is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless 'first' and 'last' refer to
+        // a sequence of valid values where 'first' is at a position at or
+        // before 'last'.  Note that if a member of the input sequence has an
+        // equivalent key to an earlier member, the later member will not be
+        // inserted.
+
+    FlatHashMap(const FlatHashMap&  original,
+                bslma::Allocator   *basicAllocator = 0);
+        // Create a 'FlatHashMap' object having the same value, hasher, and
+        // equality comparator as the specified 'original' object.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is not specified or is 0, the currently installed
+        // default allocator is used.
+
+    FlatHashMap(bslmf::MovableRef<FlatHashMap> original);
+        // Create a 'FlatHashMap' object having the same value, hasher,
+        // equality comparator, and allocator as the specified 'original'
+        // object.  The contents of 'original' are moved (in constant time) to
+        // this object, 'original' is left in a (valid) unspecified state, and
+        // no exceptions will be thrown.
+
+    FlatHashMap(bslmf::MovableRef<FlatHashMap>  original,
+                bslma::Allocator               *basicAllocator);
+        // Create a 'FlatHashMap' object having the same value, hasher, and
+        // equality comparator as the specified 'original' object, using the
+        // specified 'basicAllocator' to supply memory.  If 'basicAllocator' is
+        // 0, the currently installed default allocator is used.  The
+        // allocator of 'original' remains unchanged.  If 'original' and the
+        // newly created object have the same allocator then the contents of
+        // 'original' are moved (in constant time) to this object, 'original'
+        // is left in a (valid) unspecified state, and no exceptions will be
+        // thrown; otherwise, 'original' is unchanged (and an exception may be
+        // thrown).
+
+    //! ~FlatHashMap() = default;
+        // Destroy this object and each of its elements.
+
+    // MANIPULATORS
+    FlatHashMap& operator=(const FlatHashMap& rhs);
+        // Assign to this object the value, hasher, and equality functor of
+        // the specified 'rhs' object, and return a reference providing
+        // modifiable access to this object.
+
+    FlatHashMap& operator=(bslmf::MovableRef<FlatHashMap> rhs);
+        // Assign to this object the value, hasher, and equality comparator of
+        // the specified 'rhs' object, and return a reference providing
+        // modifiable access to this object.  If this object and 'rhs' use the
+        // same allocator the contents of 'rhs' are moved (in constant time) to
+        // this object.  'rhs' is left in a (valid) unspecified state.
+
+    VALUE& operator[](const KEY& key);
+    VALUE& operator[](bslmf::MovableRef<KEY> key);
+        // Return a reference providing modifiable access to the mapped value
+        // associated with the specified 'key' in this map.  If this map does
+        // not already contain an element having 'key', insert an element
+        // having 'key' (in the second form, moved into the element) and a
+        // default-constructed 'VALUE', and return a reference to the newly
+        // mapped value.
+
+    VALUE& at(const KEY& key);
+        // Return a reference providing modifiable access to the mapped value
+        // associated with the specified 'key' in this map, if such an entry
+        // exists; otherwise throw a 'std::out_of_range' exception.  Note that
+        // this method is not exception-neutral.
+
+    void clear();
+        // Remove all elements from this map.  Note that this map will be empty
+        // after calling this method, but allocated memory may be retained for
+        // future use.  See the 'capacity' method.
+
+    bsl::pair<iterator, iterator> equal_range(const KEY& key);
+        // Return a pair of iterators defining the sequence of modifiable
+        // elements in this map having the specified 'key', where the first
+        // iterator is positioned at the start of the sequence and the second
+        // iterator is positioned one past the end of the sequence.  If this
+        // map contains no elements having a key equivalent to 'key', then the
+        // two returned iterators will have the same value.  Note that since a
+        // map maintains unique keys, the range will contain at most one
+        // element.
+
+    bsl::size_t erase(const KEY& key);
+        // Remove from this map the element whose key is equal to the specified
+        // 'key', if it exists, and return 1; otherwise (there is no element
+        // having 'key' in this map), return 0 with no other effect.  This
+        // method invalidates only iterators and references to the removed
+        // element and previously saved values of the 'end()' iterator.
+
+    iterator erase(const_iterator position);
+    iterator erase(iterator position);
+        // Remove from this map the element at the specified 'position', and
+        // return an iterator referring to the modifiable element immediately
+        // following the removed element, or to the past-the-end position if
+        // the removed element was the last element in the sequence of elements
+        // maintained by this map.  This method invalidates only iterators and
+        // references to the removed element and previously saved values of
+        // the 'end()' iterator.  The behavior is undefined unless 'position'
+        // refers to an element in this map.
+
+    iterator erase(const_iterator first, const_iterator last);
+        // Remove from this map the elements starting at the specified 'first'
+        // position up to, but not including, the specified 'last' position,
+        // and return 'last'.  This method invalidates only iterators and
+        // references to the removed element and previously saved values of
+        // the 'end()' iterator.  The behavior is undefined unless 'first' and
+        // 'last' either refer to elements in this map or are the 'end'
+        // iterator, and the 'first' position is at or before the 'last'
+        // position in the iteration sequence provided by this container.
+
+    iterator find(const KEY& key);
+        // Return an iterator referring to the modifiable element in this map
+        // having the specified 'key', or 'end()' if no such entry exists in
+        // this map.
+
+    bsl::pair<iterator, bool> insert(const value_type& value);
+    bsl::pair<iterator, bool> insert(bslmf::MovableRef<value_type> value);
+        // Insert the specified 'value' into this map if the key (the 'first'
+        // element) of 'value' does not already exist in this map; otherwise,
+        // this method has no effect.  Return a 'pair' whose 'first' member is
+        // an iterator referring to the (possibly newly inserted) modifiable
+        // element in this map whose key is equivalent to that of the element
+        // to be inserted, and whose 'second' member is 'true' if a new element
+        // was inserted, and 'false' if an element with an equivalent key was
+        // already present.  In the second form, 'value' is left in a valid but
+        // unspecified state if it is inserted.
+
+    template <class INSERT_VALUE_TYPE>
+    typename bsl::enable_if<
+                 bsl::is_convertible<INSERT_VALUE_TYPE, value_type>::value,
+                 bsl::pair<iterator, bool> >::type
+    insert(BSLS_COMPILERFEATURES_FORWARD_REF(INSERT_VALUE_TYPE) value);
+        // Create a 'value_type' object from the specified 'value', and insert
+        // it into this map if the key of the created object does not already
+        // exist in this map; otherwise, this method has no effect.  Return a
+        // 'pair' whose 'first' member is an iterator referring to the
+        // (possibly newly inserted) modifiable element in this map whose key
+        // is equivalent to that of the created object, and whose 'second'
+        // member is 'true' if a new element was inserted, and 'false'
+        // otherwise.
+
+    template <class INPUT_ITERATOR>
+    void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        // Create a 'value_type' object for each iterator in the range starting
+        // at the specified 'first' iterator and ending immediately before the
+        // specified 'last' iterator, and insert it into this map if its key
+        // does not already exist in this map.  The behavior is undefined
+        // unless 'first' and 'last' refer to a sequence of valid values where
+        // 'first' is at a position at or before 'last'.
+
+    void rehash(bsl::size_t minimumCapacity);
+        // Change the capacity of this map to at least the specified
+        // 'minimumCapacity', and redistribute all the contained elements into
+        // a new sequence of entries, according to their hash values.  If
+        // '0 == minimumCapacity' and '0 == size()', the map is returned to the
+        // default constructed state.  After this call, 'load_factor()' will be
+        // less than or equal to 'max_load_factor()'.  This method invalidates
+        // all iterators, pointers, and references to elements.
+
+    void reserve(bsl::size_t numEntries);
+        // Change the capacity of this map to at least a capacity that can
+        // accommodate the specified 'numEntries' (accounting for the load
+        // factor invariant), and redistribute all the contained elements into
+        // a new sequence of entries, according to their hash values.  If
+        // '0 == numEntries' and '0 == size()', the map is returned to the
+        // default constructed state.  Note that this method effectively
+        // equivalent to:
+        //..
+        //      rehash(bsl::ceil(numEntries / max_load_factor()))
+        //..
+
+    void reset();
+        // Remove all elements from this map and release all memory from this
+        // map, returning the map to the default constructed state.
+
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES
+    template <class... ARGS>
+    bsl::pair<iterator, bool> try_emplace(const KEY& key, ARGS&&... args);
+    template <class... ARGS>
+    bsl::pair<iterator, bool> try_emplace(bslmf::MovableRef<KEY> key,
+                                          ARGS&&...              args);
+        // If a key equivalent to the specified 'key' already exists in this
+        // map, return a pair containing an iterator referring to the existing
+        // item and 'false'.  Otherwise, insert into this map a newly-created
+        // 'value_type' object, constructed from 'key' (in the second form,
+        // moved) and a 'VALUE' constructed from the specified 'args', and
+        // return a pair containing an iterator referring to the newly-created
+        // entry and 'true'.  Note that no 'VALUE' is constructed if 'key' is
+        // already present.
+#else
+    bsl::pair<iterator, bool> try_emplace(const KEY& key);
+    template <class ARG1>
+    bsl::pair<iterator, bool> try_emplace(
+                                const KEY&                              key,
+                                BSLS_COMPILERFEATURES_FORWARD_REF(ARG1) arg1);
+        // If a key equivalent to the specified 'key' already exists in this
+        // map, return a pair containing an iterator referring to the existing
+        // item and 'false'.  Otherwise, insert into this map a newly-created
+        // 'value_type' object, constructed from 'key' and a 'VALUE'
+        // constructed from the optionally specified 'arg1', and return a pair
+        // containing an iterator referring to the newly-created entry and
+        // 'true'.
+#endif
+
+    iterator begin();
+        // Return an iterator to the first element in the sequence of
+        // modifiable elements maintained by this map, or the 'end' iterator if
+        // this map is empty.
+
+    iterator end();
+        // Return an iterator to the past-the-end element in the sequence of
+        // modifiable elements maintained by this map.
+
+                                  // Aspects
+
+    void swap(FlatHashMap& other);
+        // Exchange the value of this object as well as its hasher and equality
+        // functors with those of the specified 'other' object.  This method
+        // provides the no-throw exception-safety guarantee if 'HASH' and
+        // 'EQUAL' have no-throw swap operations.  The behavior is undefined
+        // unless this object was created with the same allocator as 'other'.
+
+    // ACCESSORS
+    const VALUE& at(const KEY& key) const;
+        // Return a reference providing non-modifiable access to the mapped
+        // value associated with the specified 'key' in this map, if such an
+        // entry exists; otherwise throw a 'std::out_of_range' exception.  Note
+        // that this method is not exception-neutral.
+
+    bsl::size_t capacity() const;
+        // Return the number of elements this map could hold if the load factor
+        // were 1.
+
+    bool contains(const KEY& key) const;
+        // Return 'true' if this map contains an element having the specified
+        // 'key', and 'false' otherwise.
+
+    bsl::size_t count(const KEY& key) const;
+        // Return the number of elements in this map having the specified
+        // 'key'.  Note that since a flat hash map maintains unique keys, the
+        // returned value will be either 0 or 1.
+
+    bool empty() const;
+        // Return 'true' if this map contains no elements, and 'false'
+        // otherwise.
+
+    bsl::pair<const_iterator, const_iterator> equal_range(
+                                                         const KEY& key) const;
+        // Return a pair of 'const_iterator's defining the sequence of elements
+        // in this map having the specified 'key', where the first iterator is
+        // positioned at the start of the sequence and the second iterator is
+        // positioned one past the end of the sequence.  If this map contains
+        // no elements having a key equivalent to 'key', then the two returned
+        // iterators will have the same value.
+
+    const_iterator find(const KEY& key) const;
+        // Return a 'const_iterator' referring to the element in this map
+        // having the specified 'key', or 'end()' if no such entry exists in
+        // this map.
+
+    HASH hash_function() const;
+        // Return (a copy of) the unary hash functor used by this map to
+        // generate a hash value (of type 'bsl::size_t') for a 'KEY' object.
+
+    EQUAL key_eq() const;
+        // Return (a copy of) the binary key-equality functor that returns
+        // 'true' if the value of two 'KEY' objects are equivalent, and 'false'
+        // otherwise.
+
+    float load_factor() const;
+        // Return the current ratio between the number of elements in this
+        // container and its capacity.
+
+    float max_load_factor() const;
+        // Return the maximum load factor allowed for this map.  Note that if
+        // an insert operation would cause the load factor to exceed the
+        // 'max_load_factor()', that same insert operation will increase the
+        // capacity and rehash the entries of the container (see {'insert'}
+        // and {'rehash'}).  Note that the value returned by 'max_load_factor'
+        // is implementation dependent and cannot be changed by the user.
+
+    bsl::size_t size() const;
+        // Return the number of elements in this map.
+
+    const_iterator begin() const;
+        // Return a 'const_iterator' to the first element in the sequence of
+        // elements maintained by this map, or the 'end' iterator if this map
+        // is empty.
+
+    const_iterator cbegin() const;
+        // Return a 'const_iterator' to the first element in the sequence of
+        // elements maintained by this map, or the 'end' iterator if this map
+        // is empty.
+
+    const_iterator cend() const;
+        // Return a 'const_iterator' to the past-the-end element in the
+        // sequence of elements maintained by this map.
+
+    const_iterator end() const;
+        // Return a 'const_iterator' to the past-the-end element in the
+        // sequence of elements maintained by this map.
+
+                                  // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this flat hash map to supply memory.
+};
+
+// FREE OPERATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+bool operator==(const FlatHashMap<KEY, VALUE, HASH, EQUAL>& lhs,
+                const FlatHashMap<KEY, VALUE, HASH, EQUAL>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects have the same
+    // value, and 'false' otherwise.  Two 'FlatHashMap' objects have the same
+    // value if their sizes are the same and each element contained in one is
+    // equal to an element of the other.  The hash and equality functors are
+    // not involved in the comparison.
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+bool operator!=(const FlatHashMap<KEY, VALUE, HASH, EQUAL>& lhs,
+                const FlatHashMap<KEY, VALUE, HASH, EQUAL>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects do not have the
+    // same value, and 'false' otherwise.  Two 'FlatHashMap' objects do not
+    // have the same value if their sizes are different or one contains an
+    // element equal to no element of the other.  The hash and equality
+    // functors are not involved in the comparison.
+
+// FREE FUNCTIONS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void swap(FlatHashMap<KEY, VALUE, HASH, EQUAL>& a,
+          FlatHashMap<KEY, VALUE, HASH, EQUAL>& b);
+    // Exchange the value, the hasher, and the key-equality functor of the
+    // specified 'a' and 'b' objects.  This function provides the no-throw
+    // exception-safety guarantee if the two objects were created with the
+    // same allocator and the basic guarantee otherwise.
+
+// ============================================================================
+//                           INLINE DEFINITIONS
+// ============================================================================
+
+                         // ----------------------------
+                         // struct FlatHashMap_EntryUtil
+                         // ----------------------------
+
+// CLASS METHODS
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES
+template <class KEY, class VALUE, class ENTRY>
+template <class KEY_TYPE, class... ARGS>
+inline
+void FlatHashMap_EntryUtil<KEY, VALUE, ENTRY>::construct(
+                                                 ENTRY            *entry,
+                                                 bslma::Allocator *allocator,
+                                                 KEY_TYPE&&        key,
+                                                 ARGS&&...         args)
+{
+    BSLS_ASSERT_SAFE(entry);
+
+    bsls::ObjectBuffer<VALUE> value;
+    bslma::ConstructionUtil::construct(
+                                 value.address(),
+                                 allocator,
+                                 BSLS_COMPILERFEATURES_FORWARD(ARGS, args)...);
+    bslma::DestructorGuard<VALUE> guard(value.address());
+
+    bslma::ConstructionUtil::construct(
+                                 entry,
+                                 allocator,
+                                 BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, key),
+                                 bslmf::MovableRefUtil::move(value.object()));
+}
+#else
+template <class KEY, class VALUE, class ENTRY>
+template <class KEY_TYPE>
+inline
+void FlatHashMap_EntryUtil<KEY, VALUE, ENTRY>::construct(
+                        ENTRY                                       *entry,
+                        bslma::Allocator                            *allocator,
+                        BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE)  key)
+{
+    BSLS_ASSERT_SAFE(entry);
+
+    bsls::ObjectBuffer<VALUE> value;
+    bslma::ConstructionUtil::construct(value.address(), allocator);
+    bslma::DestructorGuard<VALUE> guard(value.address());
+
+    bslma::ConstructionUtil::construct(
+                                 entry,
+                                 allocator,
+                                 BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, key),
+                                 bslmf::MovableRefUtil::move(value.object()));
+}
+
+template <class KEY, class VALUE, class ENTRY>
+template <class KEY_TYPE, class ARG1>
+inline
+void FlatHashMap_EntryUtil<KEY, VALUE, ENTRY>::construct(
+                        ENTRY                                       *entry,
+                        bslma::Allocator                            *allocator,
+                        BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE)  key,
+                        BSLS_COMPILERFEATURES_FORWARD_REF(ARG1)      arg1)
+{
+    BSLS_ASSERT_SAFE(entry);
+
+    bsls::ObjectBuffer<VALUE> value;
+    bslma::ConstructionUtil::construct(
+                                    value.address(),
+                                    allocator,
+                                    BSLS_COMPILERFEATURES_FORWARD(ARG1, arg1));
+    bslma::DestructorGuard<VALUE> guard(value.address());
+
+    bslma::ConstructionUtil::construct(
+                                 entry,
+                                 allocator,
+                                 BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, key),
+                                 bslmf::MovableRefUtil::move(value.object()));
+}
+#endif
+
+template <class KEY, class VALUE, class ENTRY>
+inline
+const KEY& FlatHashMap_EntryUtil<KEY, VALUE, ENTRY>::key(const ENTRY& entry)
+{
+    return entry.first;
+}
+
+                            // -----------------
+                            // class FlatHashMap
+                            // -----------------
+
+// CREATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap()
+: d_impl(0, HASH(), EQUAL())
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                              bslma::Allocator *basicAllocator)
+: d_impl(0, HASH(), EQUAL(), basicAllocator)
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(bsl::size_t capacity)
+: d_impl(capacity, HASH(), EQUAL())
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                              bsl::size_t       capacity,
+                                              bslma::Allocator *basicAllocator)
+: d_impl(capacity, HASH(), EQUAL(), basicAllocator)
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                              bsl::size_t       capacity,
+                                              const HASH&       hash,
+                                              bslma::Allocator *basicAllocator)
+: d_impl(capacity, hash, EQUAL(), basicAllocator)
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                              bsl::size_t       capacity,
+                                              const HASH&       hash,
+                                              const EQUAL&      equal,
+                                              bslma::Allocator *basicAllocator)
+: d_impl(capacity, hash, equal, basicAllocator)
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class INPUT_ITERATOR>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                              INPUT_ITERATOR    first,
+                                              INPUT_ITERATOR    last,
+                                              bslma::Allocator *basicAllocator)
+: d_impl(0, HASH(), EQUAL(), basicAllocator)
+{
+    insert(first, last);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class INPUT_ITERATOR>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                              INPUT_ITERATOR    first,
+                                              INPUT_ITERATOR    last,
+                                              bsl::size_t       capacity,
+                                              bslma::Allocator *basicAllocator)
+: d_impl(capacity, HASH(), EQUAL(), basicAllocator)
+{
+    insert(first, last);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class INPUT_ITERATOR>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                              INPUT_ITERATOR    first,
+                                              INPUT_ITERATOR    last,
+                                              bsl::size_t       capacity,
+                                              const HASH&       hash,
+                                              bslma::Allocator *basicAllocator)
+: d_impl(capacity, hash, EQUAL(), basicAllocator)
+{
+    insert(first, last);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class INPUT_ITERATOR>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                              INPUT_ITERATOR    first,
+                                              INPUT_ITERATOR    last,
+                                              bsl::size_t       capacity,
+                                              const HASH&       hash,
+                                              const EQUAL&      equal,
+                                              bslma::Allocator *basicAllocator)
+: d_impl(capacity, hash, equal, basicAllocator)
+{
+    insert(first, last);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                          const FlatHashMap&  original,
+                                          bslma::Allocator   *basicAllocator)
+: d_impl(original.d_impl, basicAllocator)
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                       bslmf::MovableRef<FlatHashMap> original)
+: d_impl(bslmf::MovableRefUtil::move(
+                          bslmf::MovableRefUtil::access(original).d_impl))
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                              bslmf::MovableRef<FlatHashMap>  original,
+                              bslma::Allocator               *basicAllocator)
+: d_impl(bslmf::MovableRefUtil::move(
+                          bslmf::MovableRefUtil::access(original).d_impl),
+         basicAllocator)
+{
+}
+
+// MANIPULATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>&
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::operator=(const FlatHashMap& rhs)
+{
+    d_impl = rhs.d_impl;
+
+    return *this;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>&
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::operator=(
+                                            bslmf::MovableRef<FlatHashMap> rhs)
+{
+    FlatHashMap& lvalue = rhs;
+
+    d_impl = bslmf::MovableRefUtil::move(lvalue.d_impl);
+
+    return *this;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+VALUE& FlatHashMap<KEY, VALUE, HASH, EQUAL>::operator[](const KEY& key)
+{
+    return d_impl.tryEmplace(key).first->second;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+VALUE& FlatHashMap<KEY, VALUE, HASH, EQUAL>::operator[](
+                                                    bslmf::MovableRef<KEY> key)
+{
+    KEY& lvalue = key;
+
+    return d_impl.tryEmplace(bslmf::MovableRefUtil::move(lvalue))
+                                                                .first->second;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+VALUE& FlatHashMap<KEY, VALUE, HASH, EQUAL>::at(const KEY& key)
+{
+    iterator node = d_impl.find(key);
+
+    if (node == d_impl.end()) {
+        BloombergLP::bslstl::StdExceptUtil::throwOutOfRange(
+                          "FlatHashMap<...>::at(key_type): invalid key value");
+    }
+
+    return node->second;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void FlatHashMap<KEY, VALUE, HASH, EQUAL>::clear()
+{
+    d_impl.clear();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::pair<typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator,
+          typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator>
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::equal_range(const KEY& key)
+{
+    iterator first = d_impl.find(key);
+    iterator last  = first;
+
+    if (last != d_impl.end()) {
+        ++last;
+    }
+    return bsl::pair<iterator, iterator>(first, last);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashMap<KEY, VALUE, HASH, EQUAL>::erase(const KEY& key)
+{
+    return d_impl.erase(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::erase(const_iterator position)
+{
+    BSLS_ASSERT_SAFE(position != end());
+
+    return d_impl.erase(position);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::erase(iterator position)
+{
+    BSLS_ASSERT_SAFE(position != end());
+
+    return d_impl.erase(position);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::erase(const_iterator first,
+                                            const_iterator last)
+{
+    return d_impl.erase(first, last);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::find(const KEY& key)
+{
+    return d_impl.find(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::pair<typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator, bool>
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::insert(const value_type& value)
+{
+    return d_impl.insert(value);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::pair<typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator, bool>
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::insert(
+                                           bslmf::MovableRef<value_type> value)
+{
+    return d_impl.insert(bslmf::MovableRefUtil::move(value));
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class INSERT_VALUE_TYPE>
+inline
+typename bsl::enable_if<
+    bsl::is_convertible<
+        INSERT_VALUE_TYPE,
+        typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::value_type>::value,
+    bsl::pair<typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator, bool> >
+                                                                        ::type
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::insert(
+                 BSLS_COMPILERFEATURES_FORWARD_REF(INSERT_VALUE_TYPE) value)
+{
+    value_type entry(BSLS_COMPILERFEATURES_FORWARD(INSERT_VALUE_TYPE, value),
+                     d_impl.allocator());
+
+    return d_impl.insert(bslmf::MovableRefUtil::move(entry));
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class INPUT_ITERATOR>
+inline
+void FlatHashMap<KEY, VALUE, HASH, EQUAL>::insert(INPUT_ITERATOR first,
+                                                  INPUT_ITERATOR last)
+{
+    for (; first != last; ++first) {
+        insert(*first);
+    }
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void FlatHashMap<KEY, VALUE, HASH, EQUAL>::rehash(bsl::size_t minimumCapacity)
+{
+    d_impl.rehash(minimumCapacity);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void FlatHashMap<KEY, VALUE, HASH, EQUAL>::reserve(bsl::size_t numEntries)
+{
+    d_impl.reserve(numEntries);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void FlatHashMap<KEY, VALUE, HASH, EQUAL>::reset()
+{
+    d_impl.reset();
+}
+
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class... ARGS>
+inline
+bsl::pair<typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator, bool>
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::try_emplace(const KEY& key,
+                                                  ARGS&&...  args)
+{
+    return d_impl.tryEmplace(key,
+                             BSLS_COMPILERFEATURES_FORWARD(ARGS, args)...);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class... ARGS>
+inline
+bsl::pair<typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator, bool>
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::try_emplace(
+                                           bslmf::MovableRef<KEY> key,
+                                           ARGS&&...              args)
+{
+    KEY& lvalue = key;
+
+    return d_impl.tryEmplace(bslmf::MovableRefUtil::move(lvalue),
+                             BSLS_COMPILERFEATURES_FORWARD(ARGS, args)...);
+}
+#else
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::pair<typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator, bool>
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::try_emplace(const KEY& key)
+{
+    return d_impl.tryEmplace(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class ARG1>
+inline
+bsl::pair<typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator, bool>
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::try_emplace(
+                                const KEY&                              key,
+                                BSLS_COMPILERFEATURES_FORWARD_REF(ARG1) arg1)
+{
+    return d_impl.tryEmplace(key, BSLS_COMPILERFEATURES_FORWARD(ARG1, arg1));
+}
+#endif
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::begin()
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::end()
+{
+    return d_impl.end();
+}
+
+                                  // Aspects
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void FlatHashMap<KEY, VALUE, HASH, EQUAL>::swap(FlatHashMap& other)
+{
+    BSLS_ASSERT_SAFE(allocator() == other.allocator());
+
+    d_impl.swap(other.d_impl);
+}
+
+// ACCESSORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+const VALUE& FlatHashMap<KEY, VALUE, HASH, EQUAL>::at(const KEY& key) const
+{
+    const_iterator node = d_impl.find(key);
+
+    if (node == d_impl.end()) {
+        BloombergLP::bslstl::StdExceptUtil::throwOutOfRange(
+                          "FlatHashMap<...>::at(key_type): invalid key value");
+    }
+
+    return node->second;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashMap<KEY, VALUE, HASH, EQUAL>::capacity() const
+{
+    return d_impl.capacity();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bool FlatHashMap<KEY, VALUE, HASH, EQUAL>::contains(const KEY& key) const
+{
+    return d_impl.contains(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashMap<KEY, VALUE, HASH, EQUAL>::count(const KEY& key) const
+{
+    return d_impl.count(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bool FlatHashMap<KEY, VALUE, HASH, EQUAL>::empty() const
+{
+    return d_impl.empty();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::pair<typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator,
+          typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator>
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::equal_range(const KEY& key) const
+{
+    return d_impl.equal_range(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::find(const KEY& key) const
+{
+    return d_impl.find(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+HASH FlatHashMap<KEY, VALUE, HASH, EQUAL>::hash_function() const
+{
+    return d_impl.hash_function();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+EQUAL FlatHashMap<KEY, VALUE, HASH, EQUAL>::key_eq() const
+{
+    return d_impl.key_eq();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+float FlatHashMap<KEY, VALUE, HASH, EQUAL>::load_factor() const
+{
+    return d_impl.load_factor();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+float FlatHashMap<KEY, VALUE, HASH, EQUAL>::max_load_factor() const
+{
+    return d_impl.max_load_factor();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashMap<KEY, VALUE, HASH, EQUAL>::size() const
+{
+    return d_impl.size();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::begin() const
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::cbegin() const
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::cend() const
+{
+    return d_impl.end();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::end() const
+{
+    return d_impl.end();
+}
+
+                                  // Aspects
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bslma::Allocator *FlatHashMap<KEY, VALUE, HASH, EQUAL>::allocator() const
+{
+    return d_impl.allocator();
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bool bdlc::operator==(const FlatHashMap<KEY, VALUE, HASH, EQUAL>& lhs,
+                      const FlatHashMap<KEY, VALUE, HASH, EQUAL>& rhs)
+{
+    return lhs.d_impl == rhs.d_impl;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bool bdlc::operator!=(const FlatHashMap<KEY, VALUE, HASH, EQUAL>& lhs,
+                      const FlatHashMap<KEY, VALUE, HASH, EQUAL>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+// FREE FUNCTIONS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void bdlc::swap(FlatHashMap<KEY, VALUE, HASH, EQUAL>& a,
+                FlatHashMap<KEY, VALUE, HASH, EQUAL>& b)
+{
+    if (a.allocator() == b.allocator()) {
+        a.swap(b);
+
+        return;                                                       // RETURN
+    }
+
+    typedef FlatHashMap<KEY, VALUE, HASH, EQUAL> Map;
+
+    Map futureA(b, a.allocator());
+    Map futureB(a, b.allocator());
+
+    a.swap(futureA);
+    b.swap(futureB);
+}
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1081 @@
+// bdlc_flathashmap.t.cpp                                             -*-C++-*-
+#include <bdlc_flathashmap.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatormonitor.h>
+
+#include <bslmf_movableref.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_stopwatch.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iomanip.h>
+#include <bsl_iostream.h>
+#include <bsl_map.h>
+#include <bsl_stdexcept.h>
+#include <bsl_string.h>
+#include <bsl_unordered_map.h>
+#include <bsl_utility.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                              TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is a value-semantic container whose
+// implementation is provided by 'bdlc::FlatHashTable', which is tested
+// thoroughly in its own test driver.  This test driver verifies that each
+// method forwards correctly to the implementation, that the 'value_type'
+// objects are constructed using the allocator of the map, and that the
+// map-specific methods ('operator[]', 'at', 'try_emplace') behave as their
+// 'bsl::unordered_map' counterparts.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] FlatHashMap();
+// [ 2] FlatHashMap(bslma::Allocator *basicAllocator);
+// [ 2] FlatHashMap(size_t capacity);
+// [ 2] FlatHashMap(size_t capacity, bslma::Allocator *basicAllocator);
+// [ 2] FlatHashMap(size_t capacity, const HASH& hash, *ba = 0);
+// [ 2] FlatHashMap(size_t capacity, hash, equal, *ba = 0);
+// [ 3] FlatHashMap(INPUT_ITERATOR first, INPUT_ITERATOR last, *ba = 0);
+// [ 3] FlatHashMap(first, last, capacity, *ba = 0);
+// [ 3] FlatHashMap(first, last, capacity, hash, *ba = 0);
+// [ 3] FlatHashMap(first, last, capacity, hash, equal, *ba = 0);
+// [ 5] FlatHashMap(const FlatHashMap& original, *ba = 0);
+// [ 5] FlatHashMap(MovableRef<FlatHashMap> original);
+// [ 5] FlatHashMap(MovableRef<FlatHashMap> original, *ba);
+// [ 2] ~FlatHashMap();
+//
+// MANIPULATORS
+// [ 5] FlatHashMap& operator=(const FlatHashMap& rhs);
+// [ 5] FlatHashMap& operator=(MovableRef<FlatHashMap> rhs);
+// [ 2] VALUE& operator[](const KEY& key);
+// [ 2] VALUE& operator[](MovableRef<KEY> key);
+// [ 2] VALUE& at(const KEY& key);
+// [ 4] void clear();
+// [ 4] pair<iterator, iterator> equal_range(const KEY& key);
+// [ 4] size_t erase(const KEY& key);
+// [ 4] iterator erase(const_iterator position);
+// [ 4] iterator erase(iterator position);
+// [ 4] iterator erase(const_iterator first, const_iterator last);
+// [ 4] iterator find(const KEY& key);
+// [ 3] pair<iterator, bool> insert(const value_type& value);
+// [ 3] pair<iterator, bool> insert(MovableRef<value_type> value);
+// [ 3] pair<iterator, bool> insert(INSERT_VALUE_TYPE&& value);
+// [ 3] void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+// [ 4] void rehash(size_t minimumCapacity);
+// [ 4] void reserve(size_t numEntries);
+// [ 4] void reset();
+// [ 2] pair<iterator, bool> try_emplace(const KEY& key, ARGS&&... args);
+// [ 2] pair<iterator, bool> try_emplace(MovableRef<KEY> key, ARGS&&...);
+// [ 4] iterator begin();
+// [ 4] iterator end();
+// [ 5] void swap(FlatHashMap& other);
+//
+// ACCESSORS
+// [ 2] const VALUE& at(const KEY& key) const;
+// [ 2] size_t capacity() const;
+// [ 2] bool contains(const KEY& key) const;
+// [ 2] size_t count(const KEY& key) const;
+// [ 2] bool empty() const;
+// [ 4] pair<const_iterator, const_iterator> equal_range(const KEY&) const;
+// [ 2] const_iterator find(const KEY& key) const;
+// [ 2] HASH hash_function() const;
+// [ 2] EQUAL key_eq() const;
+// [ 2] float load_factor() const;
+// [ 2] float max_load_factor() const;
+// [ 2] size_t size() const;
+// [ 4] const_iterator begin() const;
+// [ 4] const_iterator cbegin() const;
+// [ 4] const_iterator cend() const;
+// [ 4] const_iterator end() const;
+// [ 2] bslma::Allocator *allocator() const;
+//
+// FREE OPERATORS
+// [ 5] bool operator==(const FlatHashMap& lhs, const FlatHashMap& rhs);
+// [ 5] bool operator!=(const FlatHashMap& lhs, const FlatHashMap& rhs);
+//
+// FREE FUNCTIONS
+// [ 5] void swap(FlatHashMap& a, FlatHashMap& b);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST: 'bdlc::FlatHashMap' vs. 'bsl::unordered_map'
+// ----------------------------------------------------------------------------
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlc::FlatHashMap<int, int>                 IntObj;
+typedef bdlc::FlatHashMap<bsl::string, bsl::string> Obj;
+
+const char *const LONG_STRING = "a string long enough to require allocation ";
+
+// ============================================================================
+//                          PERFORMANCE TEST SUPPORT
+// ----------------------------------------------------------------------------
+
+namespace {
+namespace u {
+
+template <class MAP>
+struct PerformanceResult {
+    // This 'struct' holds the results, in nanoseconds per operation, of
+    // running the standard performance operations on a 'MAP'.
+
+    // DATA
+    double d_insert;       // average time of inserting a new key
+    double d_findHit;      // average time of finding an existing key
+    double d_findMiss;     // average time of failing to find a key
+    double d_erase;        // average time of erasing an existing key
+    long   d_checksum;     // value accumulated to defeat optimization
+};
+
+template <class MAP>
+PerformanceResult<MAP> runPerformance(const bsl::vector<int>& keys,
+                                      const bsl::vector<int>& hits,
+                                      const bsl::vector<int>& misses)
+    // Return the times taken by the standard operations on a 'MAP' holding
+    // the specified 'keys' while looking up each of the specified 'hits', and
+    // each of the specified 'misses', and then erasing each of 'hits'.  The
+    // behavior is undefined unless 'keys' are unique, 'hits' is a permutation
+    // of 'keys', 'misses' has the same length as 'keys', and none of
+    // 'misses' is in 'keys'.  Note that looking up the keys in an order
+    // different from the order of insertion prevents a node-based 'MAP' from
+    // benefiting from the nodes having been allocated sequentially.
+{
+    PerformanceResult<MAP> result;
+    bsls::Stopwatch        timer;
+
+    const double scale = 1.0e9 / static_cast<double>(keys.size());
+
+    long checksum = 0;
+
+    MAP map;
+
+    timer.start(true);
+    for (bsl::size_t i = 0; i < keys.size(); ++i) {
+        map[keys[i]] = static_cast<int>(i);
+    }
+    timer.stop();
+    result.d_insert = timer.accumulatedWallTime() * scale;
+
+    timer.reset();
+    timer.start(true);
+    for (bsl::size_t i = 0; i < hits.size(); ++i) {
+        checksum += map.find(hits[i])->second;
+    }
+    timer.stop();
+    result.d_findHit = timer.accumulatedWallTime() * scale;
+
+    timer.reset();
+    timer.start(true);
+    for (bsl::size_t i = 0; i < misses.size(); ++i) {
+        checksum += map.end() == map.find(misses[i]);
+    }
+    timer.stop();
+    result.d_findMiss = timer.accumulatedWallTime() * scale;
+
+    timer.reset();
+    timer.start(true);
+    for (bsl::size_t i = 0; i < hits.size(); ++i) {
+        checksum += static_cast<long>(map.erase(hits[i]));
+    }
+    timer.stop();
+    result.d_erase = timer.accumulatedWallTime() * scale;
+
+    result.d_checksum = checksum;
+
+    return result;
+}
+
+}  // close namespace u
+}  // close unnamed namespace
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int  test    = argc > 1 ? atoi(argv[1]) : 0;
+    bool verbose = argc > 2;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Example 1: Gathering Document Statistics
+/// - - - - - - - - - - - - - - - - - - - -
+// Suppose one wished to gather statistics on the words appearing in a large
+// set of documents on disk or in a database.  Gathering those statistics is
+// intrusive (as one is competing for access to the documents with the regular
+// users) and must be done as quickly as possible.  Moreover, the set of unique
+// words appearing in those documents may be high.  The English language has
+// in excess of a million words (albeit many appear infrequently), and, if the
+// documents contain serial numbers, or Social Security numbers, or chemical
+// formulas, etc., then the 'O[log(n)]' insertion time of ordered maps may well
+// be inadequate.  An unordered map, having an 'O[1]' typical insertion cost,
+// is a viable alternative.
+//
+// This example illustrates the use of 'bdlc::FlatHashMap' to gather one simple
+// statistic (counts of unique words) on a portion of a single document.  To
+// avoid irrelevant details of acquiring the data, the data is stored in static
+// arrays:
+//..
+    static char document[] =
+    " IN CONGRESS, July 4, 1776.\n"
+    "\n"
+    " The unanimous Declaration of the thirteen united States of America,\n"
+    "\n"
+    " When in the Course of human events, it becomes necessary for one\n"
+    " people to dissolve the political bands which have connected them with\n"
+    " another, and to assume among the powers of the earth, the separate\n"
+    " and equal station to which the Laws of Nature and of Nature's God\n"
+    " entitle them, a decent respect to the opinions of mankind requires\n"
+    " that they should declare the causes which impel them to the\n"
+    " separation.  We hold these truths to be self-evident, that all men\n"
+    " are created equal, that they are endowed by their Creator with\n"
+    " certain unalienable Rights, that among these are Life, Liberty and\n"
+    " the pursuit of Happiness.\n";
+//..
+// First, we define an alias to make our code more comprehensible:
+//..
+    typedef bdlc::FlatHashMap<bsl::string, int> WordTally;
+//..
+// Next, we create an (empty) flat hash map to hold our word tallies:
+//..
+    WordTally wordTally;
+//..
+// Then, we define the set of characters that define word boundaries:
+//..
+    const char *delimiters = " \n\t,:;.()[]?!/";
+//..
+// Next, we extract the words from our document.  Note that 'strtok' modifies
+// the document array (which was not made 'const').
+//
+// As each word is located, we must determine if it has been seen before.  If
+// so, we must increment the count.  If not, we must add it to the flat hash
+// map with a count of 1.  Of course, this determination must be made for each
+// word.  The 'operator[]' method provides a simple solution.  If the key is
+// found, a reference to its value is returned; if not, a new element is
+// inserted having the key and a default-constructed value (0 for 'int'):
+//..
+    for (char *cur = strtok(document, delimiters);
+               cur;
+               cur = strtok(NULL,     delimiters)) {
+        ++wordTally[bsl::string(cur)];
+    }
+//..
+// Now that the data has been (quickly) gathered, we can verify a few of the
+// tallies:
+//..
+    ASSERT(11 == wordTally["the"]);
+    ASSERT( 8 == wordTally["of"]);
+    ASSERT( 1 == wordTally["Declaration"]);
+    ASSERT( 0 == wordTally.count("Kraken"));
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING VALUE SEMANTICS
+        //   Copy, move, assignment, swap, and equality behave as expected.
+        //
+        // Concerns:
+        //: 1 Copies have the same value as the original and use the supplied
+        //:   (or default) allocator.
+        //:
+        //: 2 A move using the same allocator does not allocate; a move using
+        //:   a different allocator yields elements using the new allocator.
+        //:
+        //: 3 Equality compares both keys and mapped values.
+        //:
+        //: 4 'swap' exchanges values; the free 'swap' supports objects using
+        //:   different allocators.
+        //
+        // Plan:
+        //: 1 Perform each operation using maps of allocating elements and
+        //:   verify the values and memory use.  (C-1..4)
+        //
+        // Testing:
+        //   FlatHashMap(const FlatHashMap& original, *ba = 0);
+        //   FlatHashMap(MovableRef<FlatHashMap> original);
+        //   FlatHashMap(MovableRef<FlatHashMap> original, *ba);
+        //   FlatHashMap& operator=(const FlatHashMap& rhs);
+        //   FlatHashMap& operator=(MovableRef<FlatHashMap> rhs);
+        //   void swap(FlatHashMap& other);
+        //   bool operator==(const FlatHashMap& lhs, const FlatHashMap& rhs);
+        //   bool operator!=(const FlatHashMap& lhs, const FlatHashMap& rhs);
+        //   void swap(FlatHashMap& a, FlatHashMap& b);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING VALUE SEMANTICS" << endl
+                          << "=======================" << endl;
+
+        bslma::TestAllocator da("default",   false);
+        bslma::TestAllocator sa1("supplied1", false);
+        bslma::TestAllocator sa2("supplied2", false);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        Obj mX(&sa1);  const Obj& X = mX;
+
+        for (int i = 0; i < 50; ++i) {
+            mX[bsl::string(LONG_STRING) + char('A' + i % 26)
+                                        + char('a' + i / 26)] =
+                                          bsl::string(LONG_STRING) + char(i);
+        }
+
+        {
+            Obj mY(X, &sa2);  const Obj& Y = mY;
+
+            ASSERT(X == Y);
+            ASSERT(&sa2 == Y.allocator());
+            ASSERT(0 == da.numBlocksInUse());
+
+            mY.begin()->second += "changed";
+            ASSERT(X != Y);
+
+            Obj mZ(X);  const Obj& Z = mZ;
+
+            ASSERT(X == Z);
+            ASSERT(&da == Z.allocator());
+        }
+        ASSERT(0 == sa2.numBlocksInUse());
+        ASSERT(0 == da.numBlocksInUse());
+
+        {
+            Obj mY(X, &sa1);
+
+            bslma::TestAllocatorMonitor sam1(&sa1);
+
+            Obj mZ(bslmf::MovableRefUtil::move(mY));  const Obj& Z = mZ;
+
+            ASSERT(X == Z);
+            ASSERT(sam1.isTotalSame());
+
+            Obj mW(bslmf::MovableRefUtil::move(mZ), &sa2);  const Obj& W = mW;
+
+            ASSERT(X == W);
+            ASSERT(&sa2 == W.allocator());
+            ASSERT(0 == da.numBlocksInUse());
+            ASSERT(0 < sa2.numBlocksInUse());
+
+            // Every element of 'W' uses the allocator of 'W'.
+
+            for (Obj::const_iterator it = W.begin(); it != W.end(); ++it) {
+                ASSERT(&sa2 == it->first.get_allocator().mechanism());
+                ASSERT(&sa2 == it->second.get_allocator().mechanism());
+            }
+        }
+        ASSERT(0 == sa2.numBlocksInUse());
+
+        {
+            Obj mY(&sa2);  const Obj& Y = mY;
+
+            mY["discarded"] = "value";
+
+            mY = X;
+            ASSERT(X == Y);
+
+            Obj mZ(&sa1);  const Obj& Z = mZ;
+
+            mZ = bslmf::MovableRefUtil::move(mY);
+            ASSERT(X == Z);
+
+            mY = Z;
+            ASSERT(X == Y);
+        }
+        ASSERT(0 == sa2.numBlocksInUse());
+
+        {
+            Obj mY(&sa1);     const Obj& Y = mY;
+            Obj mZ(X, &sa1);  const Obj& Z = mZ;
+
+            mY["one"] = "1";
+
+            const Obj YY(Y, &sa2);
+
+            mY.swap(mZ);
+            ASSERT(X  == Y);
+            ASSERT(YY == Z);
+
+            Obj mW(&sa2);  const Obj& W = mW;
+
+            bdlc::swap(mY, mW);
+            ASSERT(X == W);
+            ASSERT(Y.empty());
+            ASSERT(&sa1 == Y.allocator());
+            ASSERT(&sa2 == W.allocator());
+        }
+        ASSERT(0 == sa2.numBlocksInUse());
+        ASSERT(0 == da.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING LOOKUP, ITERATION, AND REMOVAL
+        //   The remaining manipulators and accessors forward correctly.
+        //
+        // Concerns:
+        //: 1 Iteration visits each element exactly once, and mapped values
+        //:   are modifiable through an 'iterator'.
+        //:
+        //: 2 'find' and 'equal_range' locate the element having a key.
+        //:
+        //: 3 Each 'erase' overload removes the expected elements.
+        //:
+        //: 4 'clear', 'rehash', 'reserve', and 'reset' affect the size and
+        //:   capacity as documented.
+        //
+        // Plan:
+        //: 1 Use a 'bsl::map' oracle to verify the contents of a map after
+        //:   each operation.  (C-1..4)
+        //
+        // Testing:
+        //   void clear();
+        //   pair<iterator, iterator> equal_range(const KEY& key);
+        //   size_t erase(const KEY& key);
+        //   iterator erase(const_iterator position);
+        //   iterator erase(iterator position);
+        //   iterator erase(const_iterator first, const_iterator last);
+        //   iterator find(const KEY& key);
+        //   void rehash(size_t minimumCapacity);
+        //   void reserve(size_t numEntries);
+        //   void reset();
+        //   iterator begin();
+        //   iterator end();
+        //   pair<const_iterator, const_iterator> equal_range(const KEY&);
+        //   const_iterator begin() const;
+        //   const_iterator cbegin() const;
+        //   const_iterator cend() const;
+        //   const_iterator end() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING LOOKUP, ITERATION, AND REMOVAL" << endl
+                          << "======================================" << endl;
+
+        bslma::TestAllocator sa("supplied", false);
+
+        IntObj mX(&sa);  const IntObj& X = mX;
+
+        bsl::map<int, int> oracle;
+
+        for (int i = 0; i < 1000; ++i) {
+            mX[i * 3] = i;
+            oracle[i * 3] = i;
+        }
+
+        for (IntObj::iterator it = mX.begin(); it != mX.end(); ++it) {
+            it->second *= 2;
+            oracle[it->first] *= 2;
+        }
+
+        bsl::map<int, int> visited;
+        for (IntObj::const_iterator it = X.cbegin(); it != X.cend(); ++it) {
+            ASSERT(visited.insert(*it).second);
+        }
+        ASSERT(oracle == visited);
+
+        for (int i = 0; i < 3000; ++i) {
+            IntObj::iterator       it  = mX.find(i);
+            IntObj::const_iterator cit = X.find(i);
+
+            const bool EXP = 0 != oracle.count(i);
+
+            LOOP_ASSERT(i, EXP == (it != mX.end()));
+            LOOP_ASSERT(i, EXP == (cit != X.end()));
+            LOOP_ASSERT(i, !EXP || oracle[i] == it->second);
+
+            bsl::pair<IntObj::iterator, IntObj::iterator> range =
+                                                          mX.equal_range(i);
+            LOOP_ASSERT(i, it == range.first);
+            LOOP_ASSERT(i, EXP == (range.first != range.second));
+
+            bsl::pair<IntObj::const_iterator, IntObj::const_iterator> crange
+                                                          = X.equal_range(i);
+            LOOP_ASSERT(i, cit == crange.first);
+            LOOP_ASSERT(i, EXP == (crange.first != crange.second));
+        }
+
+        for (int i = 0; i < 3000; i += 2) {
+            LOOP_ASSERT(i, oracle.erase(i) == mX.erase(i));
+        }
+        ASSERT(oracle.size() == X.size());
+
+        IntObj::iterator it = mX.find(3);
+        ASSERT(it != mX.end());
+        mX.erase(it);
+        oracle.erase(3);
+
+        IntObj::const_iterator cit = X.find(9);
+        ASSERT(cit != X.end());
+        mX.erase(cit);
+        oracle.erase(9);
+
+        ASSERT(oracle.size() == X.size());
+        for (bsl::map<int, int>::const_iterator oit = oracle.begin();
+             oit != oracle.end();
+             ++oit) {
+            ASSERT(X.contains(oit->first));
+        }
+
+        mX.reserve(10000);
+        ASSERT(16384 == X.capacity());
+        ASSERT(oracle.size() == X.size());
+
+        mX.rehash(0);
+        ASSERT(1024 == X.capacity());
+        ASSERT(oracle.size() == X.size());
+
+        const bsl::size_t CAPACITY = X.capacity();
+
+        mX.erase(X.begin(), X.end());
+        ASSERT(X.empty());
+
+        mX[1] = 1;
+        mX.clear();
+        ASSERT(X.empty());
+        ASSERT(CAPACITY == X.capacity());
+
+        mX.reset();
+        ASSERT(0 == X.capacity());
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'insert' AND RANGE CONSTRUCTORS
+        //   Elements are inserted only if their key is not present.
+        //
+        // Concerns:
+        //: 1 Each 'insert' overload inserts a copy of the value only if no
+        //:   element having the key of the value exists, and returns the
+        //:   expected iterator and status.
+        //:
+        //: 2 The range constructors and range 'insert' insert each value in
+        //:   the range, ignoring duplicate keys.
+        //:
+        //: 3 The hash and equality functors and allocator are installed.
+        //
+        // Plan:
+        //: 1 Insert values using each overload and verify the result.  (C-1)
+        //:
+        //: 2 Construct maps from a range containing duplicate keys and verify
+        //:   the contents.  (C-2..3)
+        //
+        // Testing:
+        //   FlatHashMap(INPUT_ITERATOR first, INPUT_ITERATOR last, *ba = 0);
+        //   FlatHashMap(first, last, capacity, *ba = 0);
+        //   FlatHashMap(first, last, capacity, hash, *ba = 0);
+        //   FlatHashMap(first, last, capacity, hash, equal, *ba = 0);
+        //   pair<iterator, bool> insert(const value_type& value);
+        //   pair<iterator, bool> insert(MovableRef<value_type> value);
+        //   pair<iterator, bool> insert(INSERT_VALUE_TYPE&& value);
+        //   void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'insert' AND RANGE CONSTRUCTORS" << endl
+                          << "=======================================" << endl;
+
+        bslma::TestAllocator da("default",  false);
+        bslma::TestAllocator sa("supplied", false);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        {
+            Obj mX(&sa);  const Obj& X = mX;
+
+            const Obj::value_type V1("key1", LONG_STRING);
+
+            bsl::pair<Obj::iterator, bool> rv = mX.insert(V1);
+            ASSERT(rv.second);
+            ASSERT(V1 == *rv.first);
+            ASSERT(&sa == rv.first->second.get_allocator().mechanism());
+
+            Obj::value_type v2("key1", "other");
+            rv = mX.insert(bslmf::MovableRefUtil::move(v2));
+            ASSERT(!rv.second);
+            ASSERT(V1 == *rv.first);
+
+            rv = mX.insert(bsl::make_pair(bsl::string("key2"),
+                                          bsl::string("two")));
+            ASSERT(rv.second);
+            ASSERT("two" == rv.first->second);
+
+            rv = mX.insert(bsl::pair<const char *, const char *>("key3",
+                                                                 "three"));
+            ASSERT(rv.second);
+            ASSERT("three" == X.at("key3"));
+
+            ASSERT(3 == X.size());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+
+        typedef bsl::pair<int, int> Pair;
+
+        const Pair DATA[] = { Pair(1, 10), Pair(2, 20), Pair(1, 11),
+                              Pair(3, 30), Pair(2, 21), Pair(4, 40) };
+        const int  NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        {
+            IntObj mX(DATA, DATA + NUM_DATA, &sa);  const IntObj& X = mX;
+
+            ASSERT(4 == X.size());
+            ASSERT(10 == X.at(1));
+            ASSERT(20 == X.at(2));
+            ASSERT(30 == X.at(3));
+            ASSERT(40 == X.at(4));
+            ASSERT(&sa == X.allocator());
+
+            IntObj mY(DATA, DATA + NUM_DATA, 100, &sa);
+            const IntObj& Y = mY;
+
+            ASSERT(X == Y);
+            ASSERT(128 == Y.capacity());
+
+            IntObj mZ(DATA, DATA + NUM_DATA, 0, bsl::hash<int>(), &sa);
+            const IntObj& Z = mZ;
+
+            ASSERT(X == Z);
+
+            IntObj mW(DATA,
+                      DATA + NUM_DATA,
+                      0,
+                      bsl::hash<int>(),
+                      bsl::equal_to<int>(),
+                      &sa);
+            const IntObj& W = mW;
+
+            ASSERT(X == W);
+
+            IntObj mV(&sa);  const IntObj& V = mV;
+
+            mV[4] = 44;
+            mV.insert(DATA, DATA + NUM_DATA);
+
+            ASSERT(4  == V.size());
+            ASSERT(44 == V.at(4));
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == da.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING 'operator[]', 'at', AND 'try_emplace'
+        //   The map-specific element access methods operate as expected.
+        //
+        // Concerns:
+        //: 1 'operator[]' inserts a default-constructed mapped value if the
+        //:   key is not present, and returns a reference to the mapped value.
+        //:
+        //: 2 'at' returns a reference to the mapped value, and throws
+        //:   'bsl::out_of_range' if the key is not present.
+        //:
+        //: 3 'try_emplace' constructs the mapped value from the supplied
+        //:   arguments only if the key is not present.
+        //:
+        //: 4 All keys and mapped values use the allocator of the map.
+        //:
+        //: 5 The constructors install the supplied capacity, functors, and
+        //:   allocator.
+        //
+        // Plan:
+        //: 1 Exercise each method with allocating keys and mapped values and
+        //:   verify the results and memory use.  (C-1..5)
+        //
+        // Testing:
+        //   FlatHashMap();
+        //   FlatHashMap(bslma::Allocator *basicAllocator);
+        //   FlatHashMap(size_t capacity);
+        //   FlatHashMap(size_t capacity, bslma::Allocator *basicAllocator);
+        //   FlatHashMap(size_t capacity, const HASH& hash, *ba = 0);
+        //   FlatHashMap(size_t capacity, hash, equal, *ba = 0);
+        //   ~FlatHashMap();
+        //   VALUE& operator[](const KEY& key);
+        //   VALUE& operator[](MovableRef<KEY> key);
+        //   VALUE& at(const KEY& key);
+        //   pair<iterator, bool> try_emplace(const KEY& key, ARGS&&... args);
+        //   pair<iterator, bool> try_emplace(MovableRef<KEY> key, ARGS&&...);
+        //   const VALUE& at(const KEY& key) const;
+        //   size_t capacity() const;
+        //   bool contains(const KEY& key) const;
+        //   size_t count(const KEY& key) const;
+        //   bool empty() const;
+        //   const_iterator find(const KEY& key) const;
+        //   HASH hash_function() const;
+        //   EQUAL key_eq() const;
+        //   float load_factor() const;
+        //   float max_load_factor() const;
+        //   size_t size() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'operator[]', 'at', AND 'try_emplace'"
+                          << endl
+                          << "============================================="
+                          << endl;
+
+        bslma::TestAllocator da("default",  false);
+        bslma::TestAllocator sa("supplied", false);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        if (verbose) cout << "\nConstructors." << endl;
+        {
+            Obj mA;                      ASSERT(&da == mA.allocator());
+            Obj mB(&sa);                 ASSERT(&sa == mB.allocator());
+            Obj mC(100);                 ASSERT(128 == mC.capacity());
+            Obj mD(20, &sa);             ASSERT(32  == mD.capacity());
+            Obj mE(0, bsl::hash<bsl::string>(), &sa);
+            Obj mF(0,
+                   bsl::hash<bsl::string>(),
+                   bsl::equal_to<bsl::string>(),
+                   &sa);
+
+            ASSERT(0 == mA.capacity());
+            ASSERT(0 == mB.capacity());
+            ASSERT(&sa == mD.allocator());
+            ASSERT(&sa == mE.allocator());
+            ASSERT(&sa == mF.allocator());
+            ASSERT(mF.empty());
+            ASSERT(0.875f == mF.max_load_factor());
+            ASSERT(0.0f   == mF.load_factor());
+            ASSERT(mF.key_eq()("a", "a"));
+            ASSERT(mF.hash_function()("a") == bsl::hash<bsl::string>()("a"));
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == da.numBlocksInUse());
+
+        if (verbose) cout << "\n'operator[]' and 'at'." << endl;
+        {
+            Obj mX(&sa);  const Obj& X = mX;
+
+            const bsl::string KEY(LONG_STRING, &sa);
+
+            bsl::string& value = mX[KEY];
+            ASSERT(value.empty());
+            ASSERT(1 == X.size());
+            ASSERT(&sa == value.get_allocator().mechanism());
+
+            value = LONG_STRING;
+            ASSERT(LONG_STRING == mX[KEY]);
+            ASSERT(1 == X.size());
+            ASSERT(&mX.at(KEY) == &value);
+            ASSERT(&X.at(KEY)  == &value);
+
+            bsl::string key2(KEY, &sa);
+            key2 += "2";
+            mX[bslmf::MovableRefUtil::move(key2)] = "two";
+            ASSERT(2 == X.size());
+            ASSERT("two" == X.at(bsl::string(KEY) + "2"));
+            ASSERT(X.contains(bsl::string(KEY) + "2"));
+            ASSERT(1 == X.count(KEY));
+            ASSERT(0 == X.count("absent"));
+            ASSERT(X.end() == X.find("absent"));
+
+#ifdef BDE_BUILD_TARGET_EXC
+            bool caught = false;
+            try {
+                mX.at("absent");
+            }
+            catch (const bsl::out_of_range&) {
+                caught = true;
+            }
+            ASSERT(caught);
+
+            caught = false;
+            try {
+                X.at("absent");
+            }
+            catch (const bsl::out_of_range&) {
+                caught = true;
+            }
+            ASSERT(caught);
+#endif
+            ASSERT(2 == X.size());
+            ASSERT(0 == da.numBlocksInUse());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+
+        if (verbose) cout << "\n'try_emplace'." << endl;
+        {
+            Obj mX(&sa);  const Obj& X = mX;
+
+            bsl::pair<Obj::iterator, bool> rv =
+                                          mX.try_emplace("key", LONG_STRING);
+            ASSERT(rv.second);
+            ASSERT("key"       == rv.first->first);
+            ASSERT(LONG_STRING == rv.first->second);
+            ASSERT(&sa == rv.first->first.get_allocator().mechanism());
+            ASSERT(&sa == rv.first->second.get_allocator().mechanism());
+
+            bsl::string value("unused", &sa);
+
+            bslma::TestAllocatorMonitor sam(&sa);
+
+            rv = mX.try_emplace("key", bslmf::MovableRefUtil::move(value));
+            ASSERT(!rv.second);
+            ASSERT(LONG_STRING == rv.first->second);
+            ASSERT("unused" == value);
+            ASSERT(sam.isTotalSame());
+
+            bsl::string key(LONG_STRING, &sa);
+            rv = mX.try_emplace(bslmf::MovableRefUtil::move(key), "xxx");
+            ASSERT(rv.second);
+            ASSERT("xxx" == rv.first->second);
+
+            rv = mX.try_emplace("empty");
+            ASSERT(rv.second);
+            ASSERT(rv.first->second.empty());
+
+            ASSERT(3 == X.size());
+            ASSERT(0 == da.numBlocksInUse());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Insert, modify, find, and erase a few elements.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        IntObj mX;  const IntObj& X = mX;
+
+        ASSERT(X.empty());
+
+        mX[1] = 10;
+        mX[2] = 20;
+        ++mX[1];
+
+        ASSERT(2  == X.size());
+        ASSERT(11 == X.at(1));
+        ASSERT(20 == X.find(2)->second);
+        ASSERT(X.end() == X.find(3));
+
+        IntObj mY(X);  const IntObj& Y = mY;
+
+        ASSERT(X == Y);
+
+        ASSERT(1 == mX.erase(1));
+        ASSERT(1 == X.size());
+        ASSERT(X != Y);
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST: 'bdlc::FlatHashMap' vs. 'bsl::unordered_map'
+        //   Compare the average time of the basic operations of the two
+        //   containers for a range of sizes.
+        //
+        // Concerns:
+        //: 1 'bdlc::FlatHashMap' outperforms 'bsl::unordered_map' for
+        //:   insertion, successful lookup, unsuccessful lookup, and erasure,
+        //:   especially once the container no longer fits in cache.
+        //
+        // Plan:
+        //: 1 For each size from 1,000 to the size optionally specified as the
+        //:   second command-line argument (by default, 10,000,000), in
+        //:   multiples of 10, time each operation on each container using the
+        //:   same pseudo-random keys, and print the results in nanoseconds
+        //:   per operation.  Note that the largest useful size (e.g.,
+        //:   100,000,000) is limited by the memory of the machine.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE TEST: 'bdlc::FlatHashMap' vs. 'bsl::unordered_map'
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE TEST: 'bdlc::FlatHashMap' vs. "
+             << "'bsl::unordered_map'" << endl
+             << "=========================================="
+             << "====================" << endl;
+
+        const bsl::size_t maxSize = argc > 2
+                                  ? static_cast<bsl::size_t>(atoi(argv[2]))
+                                  : 10000000;
+
+        typedef bsl::unordered_map<int, int> UnorderedMap;
+
+        cout << setw(11) << "size"
+             << setw(22) << "insert (ns)"
+             << setw(22) << "find hit (ns)"
+             << setw(22) << "find miss (ns)"
+             << setw(22) << "erase (ns)" << endl
+             << setw(11) << ""
+             << setw(22) << "flat / unordered"
+             << setw(22) << "flat / unordered"
+             << setw(22) << "flat / unordered"
+             << setw(22) << "flat / unordered" << endl;
+
+        for (bsl::size_t size = 1000; size <= maxSize; size *= 10) {
+            bsl::vector<int> keys(size);
+            bsl::vector<int> misses(size);
+
+            // Generate distinct keys by scrambling even integers with an odd
+            // multiplier (a bijection), and misses from odd integers.
+
+            for (bsl::size_t i = 0; i < size; ++i) {
+                keys[i]   = static_cast<int>(static_cast<unsigned int>(2 * i)
+                                                              * 2654435761u);
+                misses[i] = static_cast<int>(
+                                   static_cast<unsigned int>(2 * i + 1)
+                                                              * 2654435761u);
+            }
+
+            // Shuffle the keys to obtain the order of the lookups.
+
+            bsl::vector<int> hits(keys);
+
+            unsigned int seed = 1;
+            for (bsl::size_t i = size - 1; i > 0; --i) {
+                seed = seed * 1103515245 + 12345;
+                bsl::swap(hits[i], hits[seed % (i + 1)]);
+            }
+
+            const u::PerformanceResult<IntObj> flat =
+                         u::runPerformance<IntObj>(keys, hits, misses);
+            const u::PerformanceResult<UnorderedMap> node =
+                         u::runPerformance<UnorderedMap>(keys, hits, misses);
+
+            ASSERT(flat.d_checksum == node.d_checksum);
+
+            cout << fixed << setprecision(1)
+                 << setw(11) << size
+                 << setw(11) << flat.d_insert   << setw(11) << node.d_insert
+                 << setw(11) << flat.d_findHit  << setw(11) << node.d_findHit
+                 << setw(11) << flat.d_findMiss << setw(11) << node.d_findMiss
+                 << setw(11) << flat.d_erase    << setw(11) << node.d_erase
+                 << endl;
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
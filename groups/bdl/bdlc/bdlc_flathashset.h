@@ -0,0 +1,843 @@
+// bdlc_flathashset.h                                                 -*-C++-*-
+
+#ifndef INCLUDED_BDLC_FLATHASHSET
+#define INCLUDED_BDLC_FLATHASHSET
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an open-addressed unordered set container.
+//
+//@CLASSES:
+//  bdlc::FlatHashSet: open-addressed unordered set container
+//
+//@SEE_ALSO: bdlc_flathashtable, bdlc_flathashmap, bslstl_unorderedset
+//
+//@DESCRIPTION: This component defines a single class template,
+// 'bdlc::FlatHashSet', that implements an open-addressed unordered set of
+// unique keys.
+//
+// The unordered set provided by this component, 'bdlc::FlatHashSet', differs
+// from 'bsl::unordered_set' in that its elements are stored directly in a
+// single contiguous array (see 'bdlc_flathashtable') rather than in
+// individually allocated nodes linked into a list.  Consequently, inserting
+// an element does not allocate memory unless the set must grow, and a lookup
+// typically incurs a single cache miss on the control values followed by a
+// single cache miss on the element.
+//
+// As for 'bdlc::FlatHashMap', any operation that changes the capacity of the
+// set (including an insertion that causes the set to grow) invalidates all
+// iterators, pointers, and references to elements, and the bucket interface
+// of 'bsl::unordered_set' is not provided.
+//
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: Finding Repeat Customers
+/// - - - - - - - - - - - - - - - - -
+// Suppose one is analyzing batches of trades, each identifying the customer
+// that made the trade by a unique integer identifier, and wishes to count the
+// trades in a second batch that were made by customers already seen in the
+// first batch.  Membership tests on a 'bdlc::FlatHashSet' of the identifiers
+// seen in the first batch provide the answer:
+//..
+//  const int firstBatch[]  = { 1001, 1002, 1003, 1002, 1005 };
+//  const int secondBatch[] = { 1002, 1004, 1005 };
+//
+//  bdlc::FlatHashSet<int> seen(firstBatch,
+//                              firstBatch + sizeof firstBatch
+//                                                      / sizeof *firstBatch);
+//
+//  assert(4 == seen.size());
+//
+//  const bsl::size_t numSecond = sizeof secondBatch / sizeof *secondBatch;
+//
+//  int numRepeated = 0;
+//  for (bsl::size_t i = 0; i < numSecond; ++i) {
+//      if (seen.contains(secondBatch[i])) {
+//          ++numRepeated;
+//      }
+//  }
+//  assert(2 == numRepeated);
+//..
+
+#include <bdlscm_version.h>
+
+#include <bdlc_flathashtable.h>
+
+#include <bslma_allocator.h>
+#include <bslma_constructionutil.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_movableref.h>
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bsls_assert.h>
+#include <bsls_compilerfeatures.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_functional.h>
+#include <bsl_utility.h>
+
+namespace BloombergLP {
+namespace bdlc {
+
+                         // ============================
+                         // struct FlatHashSet_EntryUtil
+                         // ============================
+
+template <class ENTRY>
+struct FlatHashSet_EntryUtil {
+    // This templated utility provides methods to construct an 'ENTRY' and a
+    // method to extract the key from an 'ENTRY', as required by
+    // 'FlatHashTable'.  For a set, the entry is the key.
+
+    // CLASS METHODS
+    template <class KEY_TYPE>
+    static void construct(
+                        ENTRY                                       *entry,
+                        bslma::Allocator                            *allocator,
+                        BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE)  key);
+        // Load into the specified 'entry' the 'ENTRY' value constructed from
+        // the specified 'key', using the specified 'allocator' to supply
+        // memory.
+
+    static const ENTRY& key(const ENTRY& entry);
+        // Return the specified 'entry'.
+};
+
+                            // =================
+                            // class FlatHashSet
+                            // =================
+
+template <class KEY,
+          class HASH  = bsl::hash<KEY>,
+          class EQUAL = bsl::equal_to<KEY> >
+class FlatHashSet {
+    // This class template implements a value-semantic container type holding
+    // an unordered set of unique values, stored in an open-addressed hash
+    // table.  See the component-level documentation for details.
+
+    // PRIVATE TYPES
+    typedef FlatHashTable<KEY,
+                          KEY,
+                          FlatHashSet_EntryUtil<KEY>,
+                          HASH,
+                          EQUAL> ImplType;
+        // This is the underlying implementation class.
+
+    // FRIENDS
+    template <class K, class H, class E>
+    friend bool operator==(const FlatHashSet<K, H, E>&,
+                           const FlatHashSet<K, H, E>&);
+
+  public:
+    // TYPES
+    typedef KEY                                      key_type;
+    typedef KEY                                      value_type;
+    typedef bsl::size_t                              size_type;
+    typedef bsl::ptrdiff_t                           difference_type;
+    typedef EQUAL                                    key_equal;
+    typedef HASH                                     hasher;
+    typedef value_type&                              reference;
+    typedef const value_type&                        const_reference;
+    typedef value_type                              *pointer;
+    typedef const value_type                        *const_pointer;
+    typedef typename ImplType::const_iterator        iterator;
+    typedef typename ImplType::const_iterator        const_iterator;
+
+  private:
+    // DATA
+    ImplType d_impl;  // underlying flat hash table used by this flat hash set
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(FlatHashSet, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    FlatHashSet();
+    explicit FlatHashSet(bslma::Allocator *basicAllocator);
+    explicit FlatHashSet(bsl::size_t capacity);
+    FlatHashSet(bsl::size_t capacity, bslma::Allocator *basicAllocator);
+    FlatHashSet(bsl::size_t       capacity,
+                const HASH&       hash,
+                bslma::Allocator *basicAllocator = 0);
+    FlatHashSet(bsl::size_t       capacity,
+                const HASH&       hash,
+                const EQUAL&      equal,
+                bslma::Allocator *basicAllocator = 0);
+        // Create an empty 'FlatHashSet' object.  Optionally specify a
+        // 'capacity' indicating the minimum initial size of the underlying
+        // array of entries of this container.  If 'capacity' is not supplied
+        // or is 0, no memory is allocated.  Optionally specify a 'hash'
+        // functor used to generate the hash values associated with the
+        // elements in this container.  If 'hash' is not supplied, a
+        // default-constructed object of the (template parameter) type 'HASH'
+        // is used.  Optionally specify an equality functor 'equal' used to
+        // determine whether two elements are equivalent.  If 'equal' is not
+        // supplied, a default-constructed object of the (template parameter)
+        // type 'EQUAL' is used.  Optionally specify a 'basicAllocator' used to
+        // supply memory.  If 'basicAllocator' is not supplied or is 0, the
+        // currently installed default allocator is used.
+
+    template <class INPUT_ITERATOR>
+    FlatHashSet(INPUT_ITERATOR    first,
+                INPUT_ITERATOR    last,
+                bslma::Allocator *basicAllocator = 0);
+    template <class INPUT_ITERATOR>
+    FlatHashSet(INPUT_ITERATOR    first,
+                INPUT_ITERATOR    last,
+                bsl::size_t       capacity,
+                const HASH&       hash,
+                const EQUAL&      equal,
+                bslma::Allocator *basicAllocator = 0);
+        // Create a 'FlatHashSet' object initialized by insertion of the values
+        // from the input iterator range specified by 'first' through 'last'
+        // (including 'first', excluding 'last').  Optionally specify a
+        // 'capacity', 'hash' functor, and 'equal' functor (see above).
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is not supplied or is 0, the currently installed
+        // default allocator is used.  The behavior is undefined unless 'first'
+        // and 'last' refer to a sequence of valid values where 'first' is at a
+        // position at or before 'last'.
+
+    FlatHashSet(const FlatHashSet&  original,
+                bslma::Allocator   *basicAllocator = 0);
+        // Create a 'FlatHashSet' object having the same value, hasher, and
+        // equality comparator as the specified 'original' object.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is not specified or is 0, the currently installed
+        // default allocator is used.
+
+    FlatHashSet(bslmf::MovableRef<FlatHashSet> original);
+        // Create a 'FlatHashSet' object having the same value, hasher,
+        // equality comparator, and allocator as the specified 'original'
+        // object.  The contents of 'original' are moved (in constant time) to
+        // this object, 'original' is left in a (valid) unspecified state, and
+        // no exceptions will be thrown.
+
+    FlatHashSet(bslmf::MovableRef<FlatHashSet>  original,
+                bslma::Allocator               *basicAllocator);
+        // Create a 'FlatHashSet' object having the same value, hasher, and
+        // equality comparator as the specified 'original' object, using the
+        // specified 'basicAllocator' to supply memory.  If 'basicAllocator' is
+        // 0, the currently installed default allocator is used.  If 'original'
+        // and the newly created object have the same allocator then the
+        // contents of 'original' are moved (in constant time) to this object;
+        // otherwise, the elements of 'original' are move-inserted.  'original'
+        // is left in a (valid) unspecified state.
+
+    //! ~FlatHashSet() = default;
+        // Destroy this object and each of its elements.
+
+    // MANIPULATORS
+    FlatHashSet& operator=(const FlatHashSet& rhs);
+        // Assign to this object the value, hasher, and equality functor of
+        // the specified 'rhs' object, and return a reference providing
+        // modifiable access to this object.
+
+    FlatHashSet& operator=(bslmf::MovableRef<FlatHashSet> rhs);
+        // Assign to this object the value, hasher, and equality comparator of
+        // the specified 'rhs' object, and return a reference providing
+        // modifiable access to this object.  If this object and 'rhs' use the
+        // same allocator the contents of 'rhs' are moved (in constant time) to
+        // this object.  'rhs' is left in a (valid) unspecified state.
+
+    void clear();
+        // Remove all elements from this set.  Note that this set will be empty
+        // after calling this method, but allocated memory may be retained for
+        // future use.  See the 'capacity' method.
+
+    bsl::size_t erase(const KEY& key);
+        // Remove from this set the element equal to the specified 'key', if it
+        // exists, and return 1; otherwise (there is no element equal to 'key'
+        // in this set), return 0 with no other effect.
+
+    iterator erase(const_iterator position);
+        // Remove from this set the element at the specified 'position', and
+        // return an iterator referring to the element immediately following
+        // the removed element, or to the past-the-end position if the removed
+        // element was the last element in the sequence of elements maintained
+        // by this set.  The behavior is undefined unless 'position' refers to
+        // an element in this set.
+
+    iterator erase(const_iterator first, const_iterator last);
+        // Remove from this set the elements starting at the specified 'first'
+        // position up to, but not including, the specified 'last' position,
+        // and return 'last'.  The behavior is undefined unless 'first' and
+        // 'last' either refer to elements in this set or are the 'end'
+        // iterator, and the 'first' position is at or before the 'last'
+        // position in the iteration sequence provided by this container.
+
+    template <class KEY_TYPE>
+    bsl::pair<iterator, bool> insert(
+                           BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE) value);
+        // Insert the specified 'value' into this set if an element equal to
+        // 'value' does not already exist in this set; otherwise, this method
+        // has no effect.  Return a 'pair' whose 'first' member is an iterator
+        // referring to the (possibly newly inserted) element in this set equal
+        // to 'value', and whose 'second' member is 'true' if a new element was
+        // inserted, and 'false' otherwise.  The behavior is undefined unless
+        // 'KEY_TYPE' is 'KEY' or a type convertible to 'KEY'.
+
+    template <class INPUT_ITERATOR>
+    void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        // Insert into this set the value of each element in the range starting
+        // at the specified 'first' iterator and ending immediately before the
+        // specified 'last' iterator, if an equal element does not already
+        // exist in this set.  The behavior is undefined unless 'first' and
+        // 'last' refer to a sequence of valid values where 'first' is at a
+        // position at or before 'last'.
+
+    void rehash(bsl::size_t minimumCapacity);
+        // Change the capacity of this set to at least the specified
+        // 'minimumCapacity', and redistribute all the contained elements into
+        // a new sequence of entries, according to their hash values.  If
+        // '0 == minimumCapacity' and '0 == size()', the set is returned to the
+        // default constructed state.  This method invalidates all iterators,
+        // pointers, and references to elements.
+
+    void reserve(bsl::size_t numEntries);
+        // Change the capacity of this set to at least a capacity that can
+        // accommodate the specified 'numEntries' (accounting for the load
+        // factor invariant), and redistribute all the contained elements into
+        // a new sequence of entries, according to their hash values.  If
+        // '0 == numEntries' and '0 == size()', the set is returned to the
+        // default constructed state.
+
+    void reset();
+        // Remove all elements from this set and release all memory from this
+        // set, returning the set to the default constructed state.
+
+                                  // Aspects
+
+    void swap(FlatHashSet& other);
+        // Exchange the value of this object as well as its hasher and equality
+        // functors with those of the specified 'other' object.  The behavior
+        // is undefined unless this object was created with the same allocator
+        // as 'other'.
+
+    // ACCESSORS
+    bsl::size_t capacity() const;
+        // Return the number of elements this set could hold if the load factor
+        // were 1.
+
+    bool contains(const KEY& key) const;
+        // Return 'true' if this set contains an element equal to the specified
+        // 'key', and 'false' otherwise.
+
+    bsl::size_t count(const KEY& key) const;
+        // Return the number of elements in this set equal to the specified
+        // 'key'.  Note that the returned value will be either 0 or 1.
+
+    bool empty() const;
+        // Return 'true' if this set contains no elements, and 'false'
+        // otherwise.
+
+    bsl::pair<const_iterator, const_iterator> equal_range(
+                                                         const KEY& key) const;
+        // Return a pair of 'const_iterator's defining the sequence of elements
+        // in this set equal to the specified 'key', where the first iterator
+        // is positioned at the start of the sequence and the second iterator
+        // is positioned one past the end of the sequence.  If this set
+        // contains no elements equal to 'key', then the two returned iterators
+        // will have the same value.
+
+    const_iterator find(const KEY& key) const;
+        // Return a 'const_iterator' referring to the element in this set equal
+        // to the specified 'key', or 'end()' if no such element exists.
+
+    HASH hash_function() const;
+        // Return (a copy of) the unary hash functor used by this set.
+
+    EQUAL key_eq() const;
+        // Return (a copy of) the binary key-equality functor used by this set.
+
+    float load_factor() const;
+        // Return the current ratio between the number of elements in this
+        // container and its capacity.
+
+    float max_load_factor() const;
+        // Return the maximum load factor allowed for this set.
+
+    bsl::size_t size() const;
+        // Return the number of elements in this set.
+
+    const_iterator begin() const;
+        // Return a 'const_iterator' to the first element in the sequence of
+        // elements maintained by this set, or the 'end' iterator if this set
+        // is empty.
+
+    const_iterator cbegin() const;
+        // Return a 'const_iterator' to the first element in the sequence of
+        // elements maintained by this set, or the 'end' iterator if this set
+        // is empty.
+
+    const_iterator cend() const;
+        // Return a 'const_iterator' to the past-the-end element in the
+        // sequence of elements maintained by this set.
+
+    const_iterator end() const;
+        // Return a 'const_iterator' to the past-the-end element in the
+        // sequence of elements maintained by this set.
+
+                                  // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this flat hash set to supply memory.
+};
+
+// FREE OPERATORS
+template <class KEY, class HASH, class EQUAL>
+bool operator==(const FlatHashSet<KEY, HASH, EQUAL>& lhs,
+                const FlatHashSet<KEY, HASH, EQUAL>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects have the same
+    // value, and 'false' otherwise.  Two 'FlatHashSet' objects have the same
+    // value if their sizes are the same and each element contained in one is
+    // equal to an element of the other.
+
+template <class KEY, class HASH, class EQUAL>
+bool operator!=(const FlatHashSet<KEY, HASH, EQUAL>& lhs,
+                const FlatHashSet<KEY, HASH, EQUAL>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects do not have the
+    // same value, and 'false' otherwise.  Two 'FlatHashSet' objects do not
+    // have the same value if their sizes are different or one contains an
+    // element equal to no element of the other.
+
+// FREE FUNCTIONS
+template <class KEY, class HASH, class EQUAL>
+void swap(FlatHashSet<KEY, HASH, EQUAL>& a, FlatHashSet<KEY, HASH, EQUAL>& b);
+    // Exchange the value, the hasher, and the key-equality functor of the
+    // specified 'a' and 'b' objects.  This function provides the no-throw
+    // exception-safety guarantee if the two objects were created with the
+    // same allocator and the basic guarantee otherwise.
+
+// ============================================================================
+//                           INLINE DEFINITIONS
+// ============================================================================
+
+                         // ----------------------------
+                         // struct FlatHashSet_EntryUtil
+                         // ----------------------------
+
+// CLASS METHODS
+template <class ENTRY>
+template <class KEY_TYPE>
+inline
+void FlatHashSet_EntryUtil<ENTRY>::construct(
+                        ENTRY                                       *entry,
+                        bslma::Allocator                            *allocator,
+                        BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE)  key)
+{
+    BSLS_ASSERT_SAFE(entry);
+
+    bslma::ConstructionUtil::construct(
+                                 entry,
+                                 allocator,
+                                 BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, key));
+}
+
+template <class ENTRY>
+inline
+const ENTRY& FlatHashSet_EntryUtil<ENTRY>::key(const ENTRY& entry)
+{
+    return entry;
+}
+
+                            // -----------------
+                            // class FlatHashSet
+                            // -----------------
+
+// CREATORS
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet()
+: d_impl(0, HASH(), EQUAL())
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(bslma::Allocator *basicAllocator)
+: d_impl(0, HASH(), EQUAL(), basicAllocator)
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(bsl::size_t capacity)
+: d_impl(capacity, HASH(), EQUAL())
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(bsl::size_t       capacity,
+                                           bslma::Allocator *basicAllocator)
+: d_impl(capacity, HASH(), EQUAL(), basicAllocator)
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(bsl::size_t       capacity,
+                                           const HASH&       hash,
+                                           bslma::Allocator *basicAllocator)
+: d_impl(capacity, hash, EQUAL(), basicAllocator)
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(bsl::size_t       capacity,
+                                           const HASH&       hash,
+                                           const EQUAL&      equal,
+                                           bslma::Allocator *basicAllocator)
+: d_impl(capacity, hash, equal, basicAllocator)
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+template <class INPUT_ITERATOR>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(INPUT_ITERATOR    first,
+                                           INPUT_ITERATOR    last,
+                                           bslma::Allocator *basicAllocator)
+: d_impl(0, HASH(), EQUAL(), basicAllocator)
+{
+    insert(first, last);
+}
+
+template <class KEY, class HASH, class EQUAL>
+template <class INPUT_ITERATOR>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(INPUT_ITERATOR    first,
+                                           INPUT_ITERATOR    last,
+                                           bsl::size_t       capacity,
+                                           const HASH&       hash,
+                                           const EQUAL&      equal,
+                                           bslma::Allocator *basicAllocator)
+: d_impl(capacity, hash, equal, basicAllocator)
+{
+    insert(first, last);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(
+                                          const FlatHashSet&  original,
+                                          bslma::Allocator   *basicAllocator)
+: d_impl(original.d_impl, basicAllocator)
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(
+                                       bslmf::MovableRef<FlatHashSet> original)
+: d_impl(bslmf::MovableRefUtil::move(
+                          bslmf::MovableRefUtil::access(original).d_impl))
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(
+                              bslmf::MovableRef<FlatHashSet>  original,
+                              bslma::Allocator               *basicAllocator)
+: d_impl(bslmf::MovableRefUtil::move(
+                          bslmf::MovableRefUtil::access(original).d_impl),
+         basicAllocator)
+{
+}
+
+// MANIPULATORS
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>&
+FlatHashSet<KEY, HASH, EQUAL>::operator=(const FlatHashSet& rhs)
+{
+    d_impl = rhs.d_impl;
+
+    return *this;
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>&
+FlatHashSet<KEY, HASH, EQUAL>::operator=(bslmf::MovableRef<FlatHashSet> rhs)
+{
+    FlatHashSet& lvalue = rhs;
+
+    d_impl = bslmf::MovableRefUtil::move(lvalue.d_impl);
+
+    return *this;
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+void FlatHashSet<KEY, HASH, EQUAL>::clear()
+{
+    d_impl.clear();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashSet<KEY, HASH, EQUAL>::erase(const KEY& key)
+{
+    return d_impl.erase(key);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::iterator
+FlatHashSet<KEY, HASH, EQUAL>::erase(const_iterator position)
+{
+    BSLS_ASSERT_SAFE(position != end());
+
+    return d_impl.erase(position);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::iterator
+FlatHashSet<KEY, HASH, EQUAL>::erase(const_iterator first, const_iterator last)
+{
+    return d_impl.erase(first, last);
+}
+
+template <class KEY, class HASH, class EQUAL>
+template <class KEY_TYPE>
+inline
+bsl::pair<typename FlatHashSet<KEY, HASH, EQUAL>::iterator, bool>
+FlatHashSet<KEY, HASH, EQUAL>::insert(
+                             BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE) value)
+{
+    return d_impl.tryEmplace(BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, value));
+}
+
+template <class KEY, class HASH, class EQUAL>
+template <class INPUT_ITERATOR>
+inline
+void FlatHashSet<KEY, HASH, EQUAL>::insert(INPUT_ITERATOR first,
+                                           INPUT_ITERATOR last)
+{
+    for (; first != last; ++first) {
+        d_impl.tryEmplace(*first);
+    }
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+void FlatHashSet<KEY, HASH, EQUAL>::rehash(bsl::size_t minimumCapacity)
+{
+    d_impl.rehash(minimumCapacity);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+void FlatHashSet<KEY, HASH, EQUAL>::reserve(bsl::size_t numEntries)
+{
+    d_impl.reserve(numEntries);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+void FlatHashSet<KEY, HASH, EQUAL>::reset()
+{
+    d_impl.reset();
+}
+
+                                  // Aspects
+
+template <class KEY, class HASH, class EQUAL>
+inline
+void FlatHashSet<KEY, HASH, EQUAL>::swap(FlatHashSet& other)
+{
+    BSLS_ASSERT_SAFE(allocator() == other.allocator());
+
+    d_impl.swap(other.d_impl);
+}
+
+// ACCESSORS
+template <class KEY, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashSet<KEY, HASH, EQUAL>::capacity() const
+{
+    return d_impl.capacity();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bool FlatHashSet<KEY, HASH, EQUAL>::contains(const KEY& key) const
+{
+    return d_impl.contains(key);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashSet<KEY, HASH, EQUAL>::count(const KEY& key) const
+{
+    return d_impl.count(key);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bool FlatHashSet<KEY, HASH, EQUAL>::empty() const
+{
+    return d_impl.empty();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bsl::pair<typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator,
+          typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator>
+FlatHashSet<KEY, HASH, EQUAL>::equal_range(const KEY& key) const
+{
+    return d_impl.equal_range(key);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator
+FlatHashSet<KEY, HASH, EQUAL>::find(const KEY& key) const
+{
+    return d_impl.find(key);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+HASH FlatHashSet<KEY, HASH, EQUAL>::hash_function() const
+{
+    return d_impl.hash_function();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+EQUAL FlatHashSet<KEY, HASH, EQUAL>::key_eq() const
+{
+    return d_impl.key_eq();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+float FlatHashSet<KEY, HASH, EQUAL>::load_factor() const
+{
+    return d_impl.load_factor();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+float FlatHashSet<KEY, HASH, EQUAL>::max_load_factor() const
+{
+    return d_impl.max_load_factor();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashSet<KEY, HASH, EQUAL>::size() const
+{
+    return d_impl.size();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator
+FlatHashSet<KEY, HASH, EQUAL>::begin() const
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator
+FlatHashSet<KEY, HASH, EQUAL>::cbegin() const
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator
+FlatHashSet<KEY, HASH, EQUAL>::cend() const
+{
+    return d_impl.end();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator
+FlatHashSet<KEY, HASH, EQUAL>::end() const
+{
+    return d_impl.end();
+}
+
+                                  // Aspects
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bslma::Allocator *FlatHashSet<KEY, HASH, EQUAL>::allocator() const
+{
+    return d_impl.allocator();
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+template <class KEY, class HASH, class EQUAL>
+inline
+bool bdlc::operator==(const FlatHashSet<KEY, HASH, EQUAL>& lhs,
+                      const FlatHashSet<KEY, HASH, EQUAL>& rhs)
+{
+    return lhs.d_impl == rhs.d_impl;
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bool bdlc::operator!=(const FlatHashSet<KEY, HASH, EQUAL>& lhs,
+                      const FlatHashSet<KEY, HASH, EQUAL>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+// FREE FUNCTIONS
+template <class KEY, class HASH, class EQUAL>
+inline
+void bdlc::swap(FlatHashSet<KEY, HASH, EQUAL>& a,
+                FlatHashSet<KEY, HASH, EQUAL>& b)
+{
+    if (a.allocator() == b.allocator()) {
+        a.swap(b);
+
+        return;                                                       // RETURN
+    }
+
+    typedef FlatHashSet<KEY, HASH, EQUAL> Set;
+
+    Set futureA(b, a.allocator());
+    Set futureB(a, b.allocator());
+
+    a.swap(futureA);
+    b.swap(futureB);
+}
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
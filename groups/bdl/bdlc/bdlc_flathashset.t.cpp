@@ -0,0 +1,630 @@
+// bdlc_flathashset.t.cpp                                             -*-C++-*-
+#include <bdlc_flathashset.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatormonitor.h>
+
+#include <bslmf_movableref.h>
+
+#include <bsls_asserttest.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_iterator.h>
+#include <bsl_set.h>
+#include <bsl_string.h>
+#include <bsl_utility.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                              TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is a value-semantic container whose
+// implementation is provided by 'bdlc::FlatHashTable', which is tested
+// thoroughly in its own test driver.  This test driver verifies that each
+// method forwards correctly to the implementation and that the elements are
+// constructed using the allocator of the set.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] FlatHashSet();
+// [ 2] FlatHashSet(bslma::Allocator *basicAllocator);
+// [ 2] FlatHashSet(size_t capacity);
+// [ 2] FlatHashSet(size_t capacity, bslma::Allocator *basicAllocator);
+// [ 2] FlatHashSet(size_t capacity, const HASH& hash, *ba = 0);
+// [ 2] FlatHashSet(size_t capacity, hash, equal, *ba = 0);
+// [ 2] FlatHashSet(INPUT_ITERATOR first, INPUT_ITERATOR last, *ba = 0);
+// [ 2] FlatHashSet(first, last, capacity, hash, equal, *ba = 0);
+// [ 4] FlatHashSet(const FlatHashSet& original, *ba = 0);
+// [ 4] FlatHashSet(MovableRef<FlatHashSet> original);
+// [ 4] FlatHashSet(MovableRef<FlatHashSet> original, *ba);
+// [ 2] ~FlatHashSet();
+//
+// MANIPULATORS
+// [ 4] FlatHashSet& operator=(const FlatHashSet& rhs);
+// [ 4] FlatHashSet& operator=(MovableRef<FlatHashSet> rhs);
+// [ 3] void clear();
+// [ 3] size_t erase(const KEY& key);
+// [ 3] iterator erase(const_iterator position);
+// [ 3] iterator erase(const_iterator first, const_iterator last);
+// [ 2] pair<iterator, bool> insert(KEY_TYPE&& value);
+// [ 2] void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+// [ 3] void rehash(size_t minimumCapacity);
+// [ 3] void reserve(size_t numEntries);
+// [ 3] void reset();
+// [ 4] void swap(FlatHashSet& other);
+//
+// ACCESSORS
+// [ 2] size_t capacity() const;
+// [ 2] bool contains(const KEY& key) const;
+// [ 2] size_t count(const KEY& key) const;
+// [ 2] bool empty() const;
+// [ 2] pair<const_iterator, const_iterator> equal_range(const KEY&) const;
+// [ 2] const_iterator find(const KEY& key) const;
+// [ 2] HASH hash_function() const;
+// [ 2] EQUAL key_eq() const;
+// [ 2] float load_factor() const;
+// [ 2] float max_load_factor() const;
+// [ 2] size_t size() const;
+// [ 2] const_iterator begin() const;
+// [ 2] const_iterator cbegin() const;
+// [ 2] const_iterator cend() const;
+// [ 2] const_iterator end() const;
+// [ 2] bslma::Allocator *allocator() const;
+//
+// FREE OPERATORS
+// [ 4] bool operator==(const FlatHashSet& lhs, const FlatHashSet& rhs);
+// [ 4] bool operator!=(const FlatHashSet& lhs, const FlatHashSet& rhs);
+//
+// FREE FUNCTIONS
+// [ 4] void swap(FlatHashSet& a, FlatHashSet& b);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlc::FlatHashSet<int>         IntObj;
+typedef bdlc::FlatHashSet<bsl::string> Obj;
+
+const char *const LONG_STRING = "a string long enough to require allocation ";
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int  test    = argc > 1 ? atoi(argv[1]) : 0;
+    bool verbose = argc > 2;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Example 1: Finding Repeat Customers
+/// - - - - - - - - - - - - - - - - -
+// Suppose one is analyzing batches of trades, each identifying the customer
+// that made the trade by a unique integer identifier, and wishes to count the
+// trades in a second batch that were made by customers already seen in the
+// first batch.  Membership tests on a 'bdlc::FlatHashSet' of the identifiers
+// seen in the first batch provide the answer:
+//..
+    const int firstBatch[]  = { 1001, 1002, 1003, 1002, 1005 };
+    const int secondBatch[] = { 1002, 1004, 1005 };
+
+    bdlc::FlatHashSet<int> seen(firstBatch,
+                                firstBatch + sizeof firstBatch
+                                                        / sizeof *firstBatch);
+
+    ASSERT(4 == seen.size());
+
+    const bsl::size_t numSecond = sizeof secondBatch / sizeof *secondBatch;
+
+    int numRepeated = 0;
+    for (bsl::size_t i = 0; i < numSecond; ++i) {
+        if (seen.contains(secondBatch[i])) {
+            ++numRepeated;
+        }
+    }
+    ASSERT(2 == numRepeated);
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING VALUE SEMANTICS
+        //   Copy, move, assignment, swap, and equality behave as expected.
+        //
+        // Concerns:
+        //: 1 Copies have the same value as the original and use the supplied
+        //:   (or default) allocator.
+        //:
+        //: 2 A move using the same allocator does not allocate.
+        //:
+        //: 3 'swap' exchanges values; the free 'swap' supports objects using
+        //:   different allocators.
+        //
+        // Plan:
+        //: 1 Perform each operation using sets of allocating elements and
+        //:   verify the values and memory use.  (C-1..3)
+        //
+        // Testing:
+        //   FlatHashSet(const FlatHashSet& original, *ba = 0);
+        //   FlatHashSet(MovableRef<FlatHashSet> original);
+        //   FlatHashSet(MovableRef<FlatHashSet> original, *ba);
+        //   FlatHashSet& operator=(const FlatHashSet& rhs);
+        //   FlatHashSet& operator=(MovableRef<FlatHashSet> rhs);
+        //   void swap(FlatHashSet& other);
+        //   bool operator==(const FlatHashSet& lhs, const FlatHashSet& rhs);
+        //   bool operator!=(const FlatHashSet& lhs, const FlatHashSet& rhs);
+        //   void swap(FlatHashSet& a, FlatHashSet& b);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING VALUE SEMANTICS" << endl
+                          << "=======================" << endl;
+
+        bslma::TestAllocator da("default",   false);
+        bslma::TestAllocator sa1("supplied1", false);
+        bslma::TestAllocator sa2("supplied2", false);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        Obj mX(&sa1);  const Obj& X = mX;
+
+        for (int i = 0; i < 50; ++i) {
+            mX.insert(bsl::string(LONG_STRING) + char('A' + i % 26)
+                                               + char('a' + i / 26));
+        }
+
+        {
+            Obj mY(X, &sa2);  const Obj& Y = mY;
+
+            ASSERT(X == Y);
+            ASSERT(&sa2 == Y.allocator());
+
+            mY.erase(*Y.begin());
+            ASSERT(X != Y);
+
+            Obj mZ(X);  const Obj& Z = mZ;
+
+            ASSERT(X == Z);
+            ASSERT(&da == Z.allocator());
+        }
+        ASSERT(0 == sa2.numBlocksInUse());
+        ASSERT(0 == da.numBlocksInUse());
+
+        {
+            Obj mY(X, &sa1);
+
+            bslma::TestAllocatorMonitor sam1(&sa1);
+
+            Obj mZ(bslmf::MovableRefUtil::move(mY));  const Obj& Z = mZ;
+
+            ASSERT(X == Z);
+            ASSERT(sam1.isTotalSame());
+
+            Obj mW(bslmf::MovableRefUtil::move(mZ), &sa2);  const Obj& W = mW;
+
+            ASSERT(X == W);
+            ASSERT(&sa2 == W.allocator());
+
+            for (Obj::const_iterator it = W.begin(); it != W.end(); ++it) {
+                ASSERT(&sa2 == it->get_allocator().mechanism());
+            }
+        }
+        ASSERT(0 == sa2.numBlocksInUse());
+
+        {
+            Obj mY(&sa2);  const Obj& Y = mY;
+
+            mY.insert("discarded");
+
+            mY = X;
+            ASSERT(X == Y);
+
+            Obj mZ(&sa1);  const Obj& Z = mZ;
+
+            mZ = bslmf::MovableRefUtil::move(mY);
+            ASSERT(X == Z);
+        }
+        ASSERT(0 == sa2.numBlocksInUse());
+
+        {
+            Obj mY(&sa1);     const Obj& Y = mY;
+            Obj mZ(X, &sa1);  const Obj& Z = mZ;
+
+            mY.insert("one");
+
+            const Obj YY(Y, &sa2);
+
+            mY.swap(mZ);
+            ASSERT(X  == Y);
+            ASSERT(YY == Z);
+
+            Obj mW(&sa2);  const Obj& W = mW;
+
+            bdlc::swap(mY, mW);
+            ASSERT(X == W);
+            ASSERT(Y.empty());
+            ASSERT(&sa2 == W.allocator());
+        }
+        ASSERT(0 == sa2.numBlocksInUse());
+        ASSERT(0 == da.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING REMOVAL AND CAPACITY
+        //   Elements are removed as expected and capacity is managed.
+        //
+        // Concerns:
+        //: 1 Each 'erase' overload removes the expected elements.
+        //:
+        //: 2 'clear', 'rehash', 'reserve', and 'reset' affect the size and
+        //:   capacity as documented.
+        //
+        // Plan:
+        //: 1 Use a 'bsl::set' oracle to verify the contents of a set after
+        //:   each operation.  (C-1..2)
+        //
+        // Testing:
+        //   void clear();
+        //   size_t erase(const KEY& key);
+        //   iterator erase(const_iterator position);
+        //   iterator erase(const_iterator first, const_iterator last);
+        //   void rehash(size_t minimumCapacity);
+        //   void reserve(size_t numEntries);
+        //   void reset();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING REMOVAL AND CAPACITY" << endl
+                          << "============================" << endl;
+
+        bslma::TestAllocator sa("supplied", false);
+
+        IntObj mX(&sa);  const IntObj& X = mX;
+
+        bsl::set<int> oracle;
+
+        for (int i = 0; i < 1000; ++i) {
+            mX.insert(i * 5);
+            oracle.insert(i * 5);
+        }
+        for (int i = 0; i < 5000; i += 3) {
+            LOOP_ASSERT(i, oracle.erase(i) == mX.erase(i));
+        }
+        ASSERT(oracle.size() == X.size());
+
+        IntObj::const_iterator it = X.find(5);
+        ASSERT(it != X.end());
+        mX.erase(it);
+        oracle.erase(5);
+
+        for (IntObj::const_iterator cit = X.begin(); cit != X.end(); ++cit) {
+            ASSERT(1 == oracle.count(*cit));
+        }
+        ASSERT(oracle.size() == X.size());
+
+        mX.reserve(10000);
+        ASSERT(16384 == X.capacity());
+
+        mX.rehash(0);
+        ASSERT(1024 == X.capacity());
+        ASSERT(oracle.size() == X.size());
+
+        ASSERT(X.end() == mX.erase(X.begin(), X.end()));
+        ASSERT(X.empty());
+
+        mX.insert(1);
+        mX.clear();
+        ASSERT(X.empty());
+        ASSERT(1024 == X.capacity());
+
+        mX.reset();
+        ASSERT(0 == X.capacity());
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING CONSTRUCTORS, 'insert', AND ACCESSORS
+        //   Elements are inserted only if not already present.
+        //
+        // Concerns:
+        //: 1 'insert' adds a value only if no equal element exists, and
+        //:   returns the expected iterator and status.
+        //:
+        //: 2 The range constructors and range 'insert' insert each value in
+        //:   the range, ignoring duplicates.
+        //:
+        //: 3 All elements use the allocator of the set.
+        //:
+        //: 4 The constructors install the supplied capacity, functors, and
+        //:   allocator, and the accessors reflect the state of the set.
+        //
+        // Plan:
+        //: 1 Exercise each method and verify the results and memory use.
+        //:   (C-1..4)
+        //
+        // Testing:
+        //   FlatHashSet();
+        //   FlatHashSet(bslma::Allocator *basicAllocator);
+        //   FlatHashSet(size_t capacity);
+        //   FlatHashSet(size_t capacity, bslma::Allocator *basicAllocator);
+        //   FlatHashSet(size_t capacity, const HASH& hash, *ba = 0);
+        //   FlatHashSet(size_t capacity, hash, equal, *ba = 0);
+        //   FlatHashSet(INPUT_ITERATOR first, INPUT_ITERATOR last, *ba = 0);
+        //   FlatHashSet(first, last, capacity, hash, equal, *ba = 0);
+        //   ~FlatHashSet();
+        //   pair<iterator, bool> insert(KEY_TYPE&& value);
+        //   void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        //   size_t capacity() const;
+        //   bool contains(const KEY& key) const;
+        //   size_t count(const KEY& key) const;
+        //   bool empty() const;
+        //   pair<const_iterator, const_iterator> equal_range(const KEY&);
+        //   const_iterator find(const KEY& key) const;
+        //   HASH hash_function() const;
+        //   EQUAL key_eq() const;
+        //   float load_factor() const;
+        //   float max_load_factor() const;
+        //   size_t size() const;
+        //   const_iterator begin() const;
+        //   const_iterator cbegin() const;
+        //   const_iterator cend() const;
+        //   const_iterator end() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING CONSTRUCTORS, 'insert', AND ACCESSORS"
+                          << endl
+                          << "============================================="
+                          << endl;
+
+        bslma::TestAllocator da("default",  false);
+        bslma::TestAllocator sa("supplied", false);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        {
+            Obj mA;                      ASSERT(&da == mA.allocator());
+            Obj mB(&sa);                 ASSERT(&sa == mB.allocator());
+            Obj mC(100);                 ASSERT(128 == mC.capacity());
+            Obj mD(20, &sa);             ASSERT(32  == mD.capacity());
+            Obj mE(0, bsl::hash<bsl::string>(), &sa);
+            Obj mF(0,
+                   bsl::hash<bsl::string>(),
+                   bsl::equal_to<bsl::string>(),
+                   &sa);
+
+            ASSERT(0 == mA.capacity());
+            ASSERT(&sa == mE.allocator());
+            ASSERT(&sa == mF.allocator());
+            ASSERT(mF.empty());
+            ASSERT(0.875f == mF.max_load_factor());
+            ASSERT(0.0f   == mF.load_factor());
+            ASSERT(mF.key_eq()("a", "a"));
+            ASSERT(mF.hash_function()("a") == bsl::hash<bsl::string>()("a"));
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == da.numBlocksInUse());
+
+        {
+            Obj mX(&sa);  const Obj& X = mX;
+
+            const bsl::string VALUE(LONG_STRING, &sa);
+
+            bsl::pair<Obj::iterator, bool> rv = mX.insert(VALUE);
+            ASSERT(rv.second);
+            ASSERT(VALUE == *rv.first);
+            ASSERT(&sa == rv.first->get_allocator().mechanism());
+
+            rv = mX.insert(VALUE);
+            ASSERT(!rv.second);
+            ASSERT(rv.first == X.find(VALUE));
+
+            rv = mX.insert("literal");
+            ASSERT(rv.second);
+            ASSERT("literal" == *rv.first);
+
+            bsl::string moved(VALUE, &sa);
+            moved += "moved";
+            rv = mX.insert(bslmf::MovableRefUtil::move(moved));
+            ASSERT(rv.second);
+
+            ASSERT(3 == X.size());
+            ASSERT(X.contains("literal"));
+            ASSERT(1 == X.count(VALUE));
+            ASSERT(0 == X.count("absent"));
+            ASSERT(X.end() == X.find("absent"));
+            ASSERT(1 == bsl::distance(X.equal_range(VALUE).first,
+                                      X.equal_range(VALUE).second));
+            ASSERT(X.cbegin() == X.begin());
+            ASSERT(X.cend()   == X.end());
+            ASSERT(3 == bsl::distance(X.begin(), X.end()));
+            ASSERT(0 == da.numBlocksInUse());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+
+        {
+            const int DATA[] = { 3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5 };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            IntObj mX(DATA, DATA + NUM_DATA, &sa);  const IntObj& X = mX;
+
+            ASSERT(7 == X.size());
+            ASSERT(&sa == X.allocator());
+
+            IntObj mY(DATA,
+                      DATA + NUM_DATA,
+                      64,
+                      bsl::hash<int>(),
+                      bsl::equal_to<int>(),
+                      &sa);
+            const IntObj& Y = mY;
+
+            ASSERT(X == Y);
+            ASSERT(64 == Y.capacity());
+
+            IntObj mZ(&sa);  const IntObj& Z = mZ;
+
+            mZ.insert(DATA, DATA + NUM_DATA);
+            ASSERT(X == Z);
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Insert, find, and erase a few elements.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        IntObj mX;  const IntObj& X = mX;
+
+        ASSERT(X.empty());
+
+        ASSERT(mX.insert(1).second);
+        ASSERT(mX.insert(2).second);
+        ASSERT(!mX.insert(1).second);
+
+        ASSERT(2 == X.size());
+        ASSERT(X.contains(1));
+        ASSERT(!X.contains(3));
+
+        IntObj mY(X);  const IntObj& Y = mY;
+
+        ASSERT(X == Y);
+
+        ASSERT(1 == mX.erase(1));
+        ASSERT(1 == X.size());
+        ASSERT(X != Y);
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1580 @@
+// bdlc_flathashtable.h                                               -*-C++-*-
+
+#ifndef INCLUDED_BDLC_FLATHASHTABLE
+#define INCLUDED_BDLC_FLATHASHTABLE
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an open-addressed hash table like Abseil 'flat_hash_map'.
+//
+//@CLASSES:
+//  bdlc::FlatHashTable: open-addressed hash table like Abseil 'flat_hash_map'
+//  bdlc::FlatHashTable_IteratorImp: forward iterator implementation
+//
+//@SEE_ALSO: bdlc_flathashmap, bdlc_flathashset
+//
+//@DESCRIPTION: This component provides the class template
+// 'bdlc::FlatHashTable', which implements an open-addressed hash table, in the
+// style of the "SwissTable" design of Abseil's 'flat_hash_map', that is used
+// as the underlying implementation of 'bdlc::FlatHashMap' and
+// 'bdlc::FlatHashSet'.
+//
+// Unlike the node-based 'bsl::unordered_map' (see 'bslstl_hashtable'), which
+// allocates one node per element and links the nodes into a list, a
+// 'bdlc::FlatHashTable' stores its entries directly in a single contiguous
+// array.  Associated with each entry is a one-byte control value that
+// indicates whether the entry is empty, erased, or in use and, for entries in
+// use, holds seven bits of the hash value of the entry's key.  The control
+// values are organized into groups (see 'bdlc_flathashtable_groupcontrol')
+// that are examined in parallel, using SSE2 instructions where available, so
+// that a lookup typically touches a single cache line of control values and a
+// single entry.
+//
+// The capacity of a 'bdlc::FlatHashTable' is always either zero or a power of
+// two that is at least the size of a group.  The table rehashes, doubling its
+// capacity, whenever an insertion would cause the number of non-empty entries
+// (entries in use plus erased entries) to exceed seven-eighths of the
+// capacity.
+//
+///Template Parameters
+///-------------------
+// The 'ENTRY_UTIL' template parameter must provide the following 'static'
+// member functions:
+//..
+//  static const KEY& key(const ENTRY& entry);
+//      // Return the key of the specified 'entry'.
+//
+//  template <class KEY_TYPE, class... ARGS>
+//  static void construct(ENTRY            *entry,
+//                        bslma::Allocator *allocator,
+//                        KEY_TYPE&&        key,
+//                        ARGS&&...         args);
+//      // Load into the specified 'entry' the 'ENTRY' value comprised of the
+//      // specified 'key' and a value constructed from the specified 'args',
+//      // using the specified 'allocator' to supply memory.
+//..
+// The 'HASH' template parameter must be a functor, such as 'bsl::hash' or
+// 'bslh::Hash<>', whose function-call operator returns a 'bsl::size_t' hash
+// value for a 'KEY', and the 'EQUAL' template parameter must be a binary
+// predicate on two 'KEY' values.  Since only a few bits of each hash value are
+// used to select a group, the hash value is multiplied by a constant derived
+// from the golden ratio (i.e., "Fibonacci hashing") before use, which makes
+// the table resilient to weak (e.g., identity) hash functors such as
+// 'bsl::hash<int>'.
+//
+///Iterator, Pointer, and Reference Invalidation
+///---------------------------------------------
+// Any change in capacity of a 'bdlc::FlatHashTable' invalidates all pointers,
+// references, and iterators.  A 'bdlc::FlatHashTable' manipulator that erases
+// an element invalidates all pointers, references, and iterators to the
+// erased element.
+//
+///Exception Safety
+///----------------
+// A 'bdlc::FlatHashTable' is exception neutral, and all of the methods of
+// 'bdlc::FlatHashTable' provide the basic exception safety guarantee (see
+// {'bsldoc_glossary'|Basic Guarantee}).  Note that if the move constructor of
+// 'ENTRY' may throw, an exception thrown while the table is rehashing may
+// cause entries to be lost; such a table is nonetheless valid.
+//
+///Usage
+///-----
+// There is no usage example for this component since it is not meant for
+// direct client use.
+
+#include <bdlscm_version.h>
+
+#include <bdlb_bitutil.h>
+
+#include <bdlc_flathashtable_groupcontrol.h>
+
+#include <bslalg_swaputil.h>
+
+#include <bslma_allocator.h>
+#include <bslma_constructionutil.h>
+#include <bslma_default.h>
+#include <bslma_destructionutil.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_movableref.h>
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bsls_assert.h>
+#include <bsls_compilerfeatures.h>
+#include <bsls_performancehint.h>
+#include <bsls_types.h>
+
+#include <bslstl_forwarditerator.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_cstdint.h>
+#include <bsl_cstring.h>
+#include <bsl_utility.h>
+
+namespace BloombergLP {
+namespace bdlc {
+
+                      // ===============================
+                      // class FlatHashTable_IteratorImp
+                      // ===============================
+
+template <class ENTRY>
+class FlatHashTable_IteratorImp {
+    // This class implements the methods required by 'bslstl::ForwardIterator'
+    // to provide forward iterators over the entries of a 'FlatHashTable'.  An
+    // iterator whose 'd_entries_p' is 0 is the end iterator.
+
+    // DATA
+    ENTRY              *d_entries_p;         // current entry
+
+    const bsl::uint8_t *d_controls_p;        // control value of current entry
+
+    bsl::size_t         d_additionalLength;  // number of entries following
+                                             // the current entry
+
+    // FRIENDS
+    template <class ENTRY_TYPE>
+    friend bool operator==(const FlatHashTable_IteratorImp<ENTRY_TYPE>&,
+                           const FlatHashTable_IteratorImp<ENTRY_TYPE>&);
+
+  public:
+    // CREATORS
+    FlatHashTable_IteratorImp();
+        // Create an end iterator (i.e., an iterator not referring to any
+        // entry).
+
+    FlatHashTable_IteratorImp(ENTRY              *entries,
+                              const bsl::uint8_t *controls,
+                              bsl::size_t         additionalLength);
+        // Create an iterator referring to the specified 'entries' having the
+        // specified 'controls', and having the specified 'additionalLength'
+        // number of entries following the referenced entry.  The behavior is
+        // undefined unless 'entries' refers to an entry in use, and the
+        // 'additionalLength' entries and control values following 'entries'
+        // and 'controls' are valid.
+
+    //! FlatHashTable_IteratorImp(
+    //!                  const FlatHashTable_IteratorImp& original) = default;
+        // Create an iterator having the same value as the specified
+        // 'original'.
+
+    //! ~FlatHashTable_IteratorImp() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    //! FlatHashTable_IteratorImp& operator=(
+    //!                       const FlatHashTable_IteratorImp& rhs) = default;
+        // Assign to this object the value of the specified 'rhs' and return a
+        // reference providing modifiable access to this object.
+
+    void operator++();
+        // Advance this iterator to the next entry in use, or to the end
+        // iterator if there is no such entry.  The behavior is undefined
+        // unless this iterator refers to an entry.
+
+    // ACCESSORS
+    ENTRY& operator*() const;
+        // Return a reference to the entry referred to by this iterator.  The
+        // behavior is undefined unless this iterator refers to an entry.
+};
+
+// FREE OPERATORS
+template <class ENTRY>
+bool operator==(const FlatHashTable_IteratorImp<ENTRY>& lhs,
+                const FlatHashTable_IteratorImp<ENTRY>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' refer to the same entry,
+    // and 'false' otherwise.
+
+                            // ===================
+                            // class FlatHashTable
+                            // ===================
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+class FlatHashTable {
+    // This class template implements a value-semantic container that holds a
+    // set of uniquely-keyed 'ENTRY' values in an open-addressed hash table.
+    // See the component-level documentation for the requirements on the
+    // template parameters.
+
+    // PRIVATE TYPES
+    typedef FlatHashTable_GroupControl GroupControl;
+    typedef bsls::Types::Uint64        Uint64;
+
+    // PRIVATE CONSTANTS
+    static const Uint64 k_HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+        // the multiplier applied to the hash value of a key (the fractional
+        // part of the golden ratio scaled to 64 bits)
+
+    static const int    k_H2_SHIFT        = 57;
+        // the shift yielding the seven bits of the mixed hash value stored in
+        // the control value of an entry
+
+  public:
+    // TYPES
+    typedef ENTRY       entry_type;
+    typedef bsl::size_t size_type;
+
+    typedef bslstl::ForwardIterator<ENTRY,
+                                    FlatHashTable_IteratorImp<ENTRY> >
+                                                                      iterator;
+    typedef bslstl::ForwardIterator<const ENTRY,
+                                    FlatHashTable_IteratorImp<ENTRY> >
+                                                                const_iterator;
+
+    // CONSTANTS
+    enum { k_MIN_CAPACITY = GroupControl::k_SIZE };
+        // the minimum non-zero capacity of a table
+
+  private:
+    // DATA
+    ENTRY            *d_entries_p;     // array of entries
+
+    bsl::uint8_t     *d_controls_p;    // array of control values, allocated
+                                       // in the same block as 'd_entries_p'
+
+    bsl::size_t       d_size;          // number of entries in use
+
+    bsl::size_t       d_capacity;      // number of entries (0 or a power of
+                                       // two that is at least
+                                       // 'k_MIN_CAPACITY')
+
+    bsl::size_t       d_growthLeft;    // number of empty entries that may be
+                                       // consumed before a rehash is required
+
+    int               d_groupShift;    // shift applied to a mixed hash value
+                                       // to obtain the index of a group
+
+    HASH              d_hasher;        // hash functor
+
+    EQUAL             d_equal;         // key-equality functor
+
+    bslma::Allocator *d_allocator_p;   // allocator (held, not owned)
+
+    // PRIVATE CLASS METHODS
+    static bsl::size_t findCapacityForSize(bsl::size_t numEntries);
+        // Return the smallest valid capacity of a table that can hold the
+        // specified 'numEntries' without rehashing.
+
+    static bsl::size_t maxLoad(bsl::size_t capacity);
+        // Return the maximum number of non-empty entries in a table having
+        // the specified 'capacity'.
+
+    // PRIVATE MANIPULATORS
+    void allocateStorage(bsl::size_t capacity);
+        // Set the capacity of this table, which must have no storage, to the
+        // specified 'capacity', allocating and initializing the arrays of
+        // entries and control values.  The behavior is undefined unless
+        // '0 == d_capacity' and 'capacity' is a power of two that is at least
+        // 'k_MIN_CAPACITY'.
+
+    void destroyEntries();
+        // Destroy each entry in use and set all control values to 'k_EMPTY'.
+
+    void eraseAt(bsl::size_t index);
+        // Destroy the entry at the specified 'index' and mark it available.
+        // The behavior is undefined unless the entry at 'index' is in use.
+
+    bsl::size_t indexOfKey(bool       *notFound,
+                           Uint64     *mixedHashValue,
+                           const KEY&  key);
+        // Return the index of the entry having the specified 'key' and load
+        // 'false' into the specified 'notFound' if such an entry exists;
+        // otherwise, rehash if needed to make room for an additional entry,
+        // return the index of the available entry at which an entry having
+        // 'key' should be inserted, and load 'true' into 'notFound'.  Load
+        // into the specified 'mixedHashValue' the mixed hash value of 'key'.
+        // Note that, when 'true' is loaded into 'notFound', the returned
+        // entry is not marked as in use until 'markInUse' is invoked, so that
+        // a failure to construct the entry leaves this table unchanged.
+
+    void markInUse(bsl::size_t index, Uint64 mixedHashValue);
+        // Mark the entry at the specified 'index', in which an entry whose key
+        // has the specified 'mixedHashValue' has just been constructed, as in
+        // use.  The behavior is undefined unless 'index' was returned by
+        // 'indexOfKey' having loaded 'true' into its 'notFound' argument and
+        // no other manipulator has been invoked since.
+
+    void rehashRaw(bsl::size_t newCapacity);
+        // Change the capacity of this table to the specified 'newCapacity',
+        // relocating all entries.  The behavior is undefined unless
+        // 'newCapacity' is zero or a power of two that is at least
+        // 'k_MIN_CAPACITY' and 'size() <= maxLoad(newCapacity)'.
+
+    void resetToEmpty();
+        // Set this table's members to represent an empty table having no
+        // storage, without releasing any memory.
+
+    // PRIVATE ACCESSORS
+    bsl::size_t findAvailable(Uint64 mixedHash) const;
+        // Return the index of the first available entry in the probe
+        // sequence for the specified 'mixedHash'.  The behavior is undefined
+        // unless '0 != capacity()'.
+
+    bsl::size_t findKey(const KEY& key, Uint64 mixedHash) const;
+        // Return the index of the entry having the specified 'key', whose
+        // mixed hash value is the specified 'mixedHash', if such an entry
+        // exists, and 'capacity()' otherwise.
+
+    iterator makeIterator(bsl::size_t index) const;
+        // Return an iterator to the entry at the specified 'index', or the
+        // end iterator if 'index == capacity()'.
+
+    Uint64 mixedHash(const KEY& key) const;
+        // Return the hash value of the specified 'key' multiplied by the
+        // golden-ratio multiplier.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(FlatHashTable, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    FlatHashTable(bsl::size_t       capacity,
+                  const HASH&       hash,
+                  const EQUAL&      equal,
+                  bslma::Allocator *basicAllocator = 0);
+        // Create an empty table having at least the specified 'capacity' that
+        // will use the specified 'hash' to generate hash values for the keys
+        // of the entries contained in this table, and the specified 'equal'
+        // to verify that the keys of two entries are the same.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  If '0 == capacity', no memory is allocated and the object is
+        // defined to be in the "zero-capacity" state.
+
+    FlatHashTable(const FlatHashTable&  original,
+                  bslma::Allocator     *basicAllocator = 0);
+        // Create a table having the same value, hasher, and key-equality
+        // comparator as the specified 'original' object.  Optionally specify
+        // a 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.
+
+    FlatHashTable(bslmf::MovableRef<FlatHashTable> original);
+        // Create a table having the same value, hasher, key-equality
+        // comparator, and allocator as the specified 'original' object by
+        // moving (in constant time) the contents of 'original' to the new
+        // table.  'original' is left in a valid but unspecified state.
+
+    FlatHashTable(bslmf::MovableRef<FlatHashTable>  original,
+                  bslma::Allocator                 *basicAllocator);
+        // Create a table having the same value, hasher, and key-equality
+        // comparator as the specified 'original' object by moving the
+        // contents of 'original' to the new table, and using the specified
+        // 'basicAllocator' to supply memory.  If 'basicAllocator' is 0, the
+        // currently installed default allocator is used.  The contents of
+        // 'original' are moved (in constant time) to the new table if
+        // '*basicAllocator == *original.allocator()', and are move-inserted
+        // (in linear time) using 'basicAllocator' otherwise.  'original' is
+        // left in a valid but unspecified state.
+
+    ~FlatHashTable();
+        // Destroy this object and each of its entries.
+
+    // MANIPULATORS
+    FlatHashTable& operator=(const FlatHashTable& rhs);
+        // Assign to this object the value, hasher, and key-equality functor
+        // of the specified 'rhs' object, and return a reference providing
+        // modifiable access to this object.
+
+    FlatHashTable& operator=(bslmf::MovableRef<FlatHashTable> rhs);
+        // Assign to this object the value, hasher, and key-equality
+        // comparator of the specified 'rhs' object, and return a reference
+        // providing modifiable access to this object.  The contents of 'rhs'
+        // are moved (in constant time) to this table if
+        // '*allocator() == *rhs.allocator()', and are move-inserted (in
+        // linear time) using 'allocator()' otherwise.  'rhs' is left in a
+        // valid but unspecified state.
+
+    void clear();
+        // Erase all the entries from this table.  Note that the capacity of
+        // this table is not affected.
+
+    bsl::size_t erase(const KEY& key);
+        // Erase the entry having the specified 'key' from this table, if such
+        // an entry exists, and return the number of erased entries (0 or 1).
+
+    iterator erase(const_iterator position);
+    iterator erase(iterator position);
+        // Erase the entry at the specified 'position' from this table, and
+        // return an iterator referring to the entry immediately following the
+        // erased entry, or to 'end()' if the erased entry was the last entry
+        // in this table.  The behavior is undefined unless 'position' refers
+        // to an entry in this table.
+
+    iterator erase(const_iterator first, const_iterator last);
+        // Erase the entries in the range '[first, last)' from this table, and
+        // return an iterator referring to 'last' (having been converted to a
+        // modifiable iterator).  The behavior is undefined unless 'first' and
+        // 'last' either refer to entries in this table or are the 'end()'
+        // iterator, and 'first' is not after 'last' in the iteration order.
+
+    iterator find(const KEY& key);
+        // Return an iterator to the entry in this table having the specified
+        // 'key' if such an entry exists, and 'end()' otherwise.
+
+    bsl::pair<iterator, bool> insert(const ENTRY& entry);
+    bsl::pair<iterator, bool> insert(bslmf::MovableRef<ENTRY> entry);
+        // Insert the specified 'entry' into this table if the key of 'entry'
+        // does not already exist in this table; otherwise, this method has no
+        // effect.  Return a 'pair' whose 'first' member is an iterator
+        // referring to the (possibly newly inserted) entry having the key of
+        // 'entry', and whose 'second' member is 'true' if a new entry was
+        // inserted, and 'false' otherwise.  In the second form, 'entry' is
+        // left in a valid but unspecified state if it is inserted.
+
+    void rehash(bsl::size_t minimumCapacity);
+        // Change the capacity of this table to at least the specified
+        // 'minimumCapacity', and redistribute all the contained entries into
+        // the new sequence of entries according to their hash values.  If
+        // '0 == minimumCapacity' and '0 == size()', the table is returned to
+        // the zero-capacity state.  Note that the resulting capacity is also
+        // at least sufficient to hold 'size()' entries without rehashing.
+
+    void reserve(bsl::size_t numEntries);
+        // Change the capacity of this table to at least a capacity that can
+        // accommodate the specified 'numEntries' without rehashing (accounting
+        // for the maximum load factor), and redistribute all the contained
+        // entries into the new sequence of entries according to their hash
+        // values.  If '0 == numEntries' and '0 == size()', the table is
+        // returned to the zero-capacity state.  This method has no effect if
+        // the table can already hold 'numEntries' entries without rehashing.
+
+    void reset();
+        // Erase all the entries from this table and release all memory, so
+        // that this table is in the zero-capacity state.
+
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES
+    template <class KEY_TYPE, class... ARGS>
+    bsl::pair<iterator, bool> tryEmplace(KEY_TYPE&& key, ARGS&&... args);
+        // If an entry having the specified 'key' does not already exist in
+        // this table, insert into this table an entry constructed by
+        // 'ENTRY_UTIL::construct' from 'key' and the specified 'args';
+        // otherwise, this method has no effect (and, in particular, no object
+        // is constructed from 'args').  Return a 'pair' whose 'first' member
+        // is an iterator referring to the (possibly newly inserted) entry
+        // having 'key', and whose 'second' member is 'true' if a new entry was
+        // inserted, and 'false' otherwise.
+#else
+    template <class KEY_TYPE>
+    bsl::pair<iterator, bool> tryEmplace(
+                             BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE) key);
+    template <class KEY_TYPE, class ARG1>
+    bsl::pair<iterator, bool> tryEmplace(
+                             BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE) key,
+                             BSLS_COMPILERFEATURES_FORWARD_REF(ARG1)     arg1);
+        // If an entry having the specified 'key' does not already exist in
+        // this table, insert into this table an entry constructed by
+        // 'ENTRY_UTIL::construct' from 'key' and the optionally specified
+        // 'arg1'; otherwise, this method has no effect.  Return a 'pair' whose
+        // 'first' member is an iterator referring to the (possibly newly
+        // inserted) entry having 'key', and whose 'second' member is 'true' if
+        // a new entry was inserted, and 'false' otherwise.
+#endif
+
+    iterator begin();
+        // Return an iterator to the first entry in the sequence of entries
+        // maintained by this table, or the 'end' iterator if this table is
+        // empty.
+
+    iterator end();
+        // Return an iterator to the past-the-end entry in the sequence of
+        // entries maintained by this table.
+
+                                  // Aspects
+
+    void swap(FlatHashTable& other);
+        // Exchange the value, hasher, and key-equality functor of this object
+        // with those of the specified 'other' object.  This method provides
+        // the no-throw exception-safety guarantee if 'HASH' and 'EQUAL' have
+        // no-throw swap operations.  The behavior is undefined unless this
+        // object was created with the same allocator as 'other'.
+
+    // ACCESSORS
+    bsl::size_t capacity() const;
+        // Return the number of entries this table could hold if all of its
+        // entries were in use.
+
+    bool contains(const KEY& key) const;
+        // Return 'true' if this table contains an entry having the specified
+        // 'key', and 'false' otherwise.
+
+    const bsl::uint8_t *controls() const;
+        // Return the address of the array of control values of this table.
+        // Note that this method is intended for testing.
+
+    bsl::size_t count(const KEY& key) const;
+        // Return the number of entries in this table having the specified
+        // 'key'.  Note that since a table maintains unique keys, the returned
+        // value will be either 0 or 1.
+
+    bool empty() const;
+        // Return 'true' if this table contains no entries, and 'false'
+        // otherwise.
+
+    const ENTRY *entries() const;
+        // Return the address of the array of entries of this table.  Note
+        // that this method is intended for testing.
+
+    bsl::pair<const_iterator, const_iterator> equal_range(
+                                                         const KEY& key) const;
+        // Return a pair of iterators defining the sequence of entries in this
+        // table having the specified 'key', where the first iterator is
+        // positioned at the start of the sequence and the second iterator is
+        // positioned one past the end of the sequence.  If this table contains
+        // no entry having 'key', then the two returned iterators will have
+        // the same value, 'end()'.
+
+    const_iterator find(const KEY& key) const;
+        // Return a 'const_iterator' to the entry in this table having the
+        // specified 'key' if such an entry exists, and 'end()' otherwise.
+
+    const HASH& hash_function() const;
+        // Return (a reference providing non-modifiable access to) the hash
+        // functor used by this table.
+
+    const EQUAL& key_eq() const;
+        // Return (a reference providing non-modifiable access to) the
+        // key-equality functor used by this table.
+
+    float load_factor() const;
+        // Return the current ratio between the number of entries in this
+        // table and its capacity, or 0 if the table is in the zero-capacity
+        // state.
+
+    float max_load_factor() const;
+        // Return the maximum load factor allowed for this table.  Note that
+        // the maximum load factor of a 'FlatHashTable' is fixed.
+
+    bsl::size_t size() const;
+        // Return the number of entries in this table.
+
+    const_iterator begin() const;
+        // Return a 'const_iterator' to the first entry in the sequence of
+        // entries maintained by this table, or the 'end' iterator if this
+        // table is empty.
+
+    const_iterator end() const;
+        // Return a 'const_iterator' to the past-the-end entry in the sequence
+        // of entries maintained by this table.
+
+                                  // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this table to supply memory.
+};
+
+// FREE OPERATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bool operator==(const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& lhs,
+                const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects have the same
+    // value, and 'false' otherwise.  Two 'FlatHashTable' objects have the
+    // same value if their sizes are the same and each entry contained in one
+    // is equal (using 'operator==' on 'ENTRY') to the entry having the same
+    // key in the other.  Note that the hasher and key-equality functors are
+    // not compared.
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bool operator!=(const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& lhs,
+                const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects do not have the
+    // same value, and 'false' otherwise.  Two 'FlatHashTable' objects do not
+    // have the same value if their sizes differ or some entry contained in
+    // one is not equal to the entry having the same key in the other.
+
+// FREE FUNCTIONS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void swap(FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& a,
+          FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& b);
+    // Exchange the value, hasher, and key-equality functor of the specified
+    // 'a' and 'b' objects.  This function provides the no-throw
+    // exception-safety guarantee if the two objects were created with the
+    // same allocator and the basic guarantee otherwise.
+
+// ============================================================================
+//                           INLINE DEFINITIONS
+// ============================================================================
+
+                      // -------------------------------
+                      // class FlatHashTable_IteratorImp
+                      // -------------------------------
+
+// CREATORS
+template <class ENTRY>
+inline
+FlatHashTable_IteratorImp<ENTRY>::FlatHashTable_IteratorImp()
+: d_entries_p(0)
+, d_controls_p(0)
+, d_additionalLength(0)
+{
+}
+
+template <class ENTRY>
+inline
+FlatHashTable_IteratorImp<ENTRY>::FlatHashTable_IteratorImp(
+                                          ENTRY              *entries,
+                                          const bsl::uint8_t *controls,
+                                          bsl::size_t         additionalLength)
+: d_entries_p(entries)
+, d_controls_p(controls)
+, d_additionalLength(additionalLength)
+{
+    BSLS_ASSERT_SAFE(entries);
+    BSLS_ASSERT_SAFE(controls);
+    BSLS_ASSERT_SAFE(0 == (FlatHashTable_GroupControl::k_EMPTY & *controls));
+}
+
+// MANIPULATORS
+template <class ENTRY>
+void FlatHashTable_IteratorImp<ENTRY>::operator++()
+{
+    BSLS_ASSERT_SAFE(d_entries_p);
+
+    do {
+        if (0 == d_additionalLength) {
+            d_entries_p  = 0;
+            d_controls_p = 0;
+            return;                                                   // RETURN
+        }
+        ++d_entries_p;
+        ++d_controls_p;
+        --d_additionalLength;
+    } while (FlatHashTable_GroupControl::k_EMPTY & *d_controls_p);
+}
+
+// ACCESSORS
+template <class ENTRY>
+inline
+ENTRY& FlatHashTable_IteratorImp<ENTRY>::operator*() const
+{
+    BSLS_ASSERT_SAFE(d_entries_p);
+
+    return *d_entries_p;
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+template <class ENTRY>
+inline
+bool bdlc::operator==(const FlatHashTable_IteratorImp<ENTRY>& lhs,
+                      const FlatHashTable_IteratorImp<ENTRY>& rhs)
+{
+    return lhs.d_entries_p == rhs.d_entries_p;
+}
+
+namespace bdlc {
+
+                            // -------------------
+                            // class FlatHashTable
+                            // -------------------
+
+// PRIVATE CLASS METHODS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::
+                                 findCapacityForSize(bsl::size_t numEntries)
+{
+    bsl::size_t capacity = k_MIN_CAPACITY;
+
+    while (maxLoad(capacity) < numEntries) {
+        BSLS_ASSERT(capacity < (~static_cast<bsl::size_t>(0) >> 1)
+                                                             / sizeof(ENTRY));
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::maxLoad(
+                                                         bsl::size_t capacity)
+{
+    return capacity - capacity / 8;
+}
+
+// PRIVATE MANIPULATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::allocateStorage(
+                                                         bsl::size_t capacity)
+{
+    BSLS_ASSERT_SAFE(0 == d_capacity);
+    BSLS_ASSERT_SAFE(k_MIN_CAPACITY <= capacity);
+    BSLS_ASSERT_SAFE(0 == (capacity & (capacity - 1)));
+
+    // The entries and control values are allocated in a single block; the
+    // block is suitably aligned for 'ENTRY', and the control values have no
+    // alignment requirement.
+
+    void *block = d_allocator_p->allocate(capacity * sizeof(ENTRY) + capacity);
+
+    d_entries_p  = static_cast<ENTRY *>(block);
+    d_controls_p = reinterpret_cast<bsl::uint8_t *>(d_entries_p + capacity);
+
+    bsl::memset(d_controls_p, GroupControl::k_EMPTY, capacity);
+
+    d_capacity   = capacity;
+    d_growthLeft = maxLoad(capacity);
+    d_groupShift = k_H2_SHIFT - bdlb::BitUtil::log2(
+                  static_cast<bsl::uint64_t>(capacity / GroupControl::k_SIZE));
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::destroyEntries()
+{
+    for (bsl::size_t i = 0; i < d_capacity && d_size; ++i) {
+        if (0 == (GroupControl::k_EMPTY & d_controls_p[i])) {
+            bslma::DestructionUtil::destroy(d_entries_p + i);
+            --d_size;
+        }
+    }
+    BSLS_ASSERT(0 == d_size);
+
+    if (d_capacity) {
+        bsl::memset(d_controls_p, GroupControl::k_EMPTY, d_capacity);
+        d_growthLeft = maxLoad(d_capacity);
+    }
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::eraseAt(
+                                                            bsl::size_t index)
+{
+    BSLS_ASSERT_SAFE(index < d_capacity);
+    BSLS_ASSERT_SAFE(0 == (GroupControl::k_EMPTY & d_controls_p[index]));
+
+    bslma::DestructionUtil::destroy(d_entries_p + index);
+
+    // An entry may be marked empty, rather than erased, if its group still
+    // contains an empty entry, since then no probe sequence can have been
+    // extended past the group.
+
+    const bsl::size_t groupStart = index & ~static_cast<bsl::size_t>(
+                                                    GroupControl::k_SIZE - 1);
+
+    if (GroupControl(d_controls_p + groupStart).neverFull()) {
+        d_controls_p[index] = GroupControl::k_EMPTY;
+        ++d_growthLeft;
+    }
+    else {
+        d_controls_p[index] = GroupControl::k_ERASED;
+    }
+    --d_size;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::indexOfKey(
+                                                    bool       *notFound,
+                                                    Uint64     *mixedHashValue,
+                                                    const KEY&  key)
+{
+    BSLS_ASSERT_SAFE(notFound);
+    BSLS_ASSERT_SAFE(mixedHashValue);
+
+    const Uint64 hash = mixedHash(key);
+
+    *mixedHashValue = hash;
+
+    bsl::size_t index = findKey(key, hash);
+    if (index != d_capacity) {
+        *notFound = false;
+        return index;                                                 // RETURN
+    }
+
+    if (0 == d_capacity) {
+        rehashRaw(k_MIN_CAPACITY);
+    }
+
+    index = findAvailable(hash);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                              0 == d_growthLeft
+                           && GroupControl::k_ERASED != d_controls_p[index])) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        // Grow if at least half of the maximum load is live entries;
+        // otherwise, the table is mostly erased entries, so rehash in place
+        // to reclaim them.
+
+        rehashRaw(d_size * 2 >= maxLoad(d_capacity) ? d_capacity * 2
+                                                    : d_capacity);
+        index = findAvailable(hash);
+    }
+
+    *notFound = true;
+    return index;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::markInUse(
+                                                   bsl::size_t index,
+                                                   Uint64      mixedHashValue)
+{
+    BSLS_ASSERT_SAFE(index < d_capacity);
+    BSLS_ASSERT_SAFE(GroupControl::k_EMPTY & d_controls_p[index]);
+
+    if (GroupControl::k_EMPTY == d_controls_p[index]) {
+        --d_growthLeft;
+    }
+    d_controls_p[index] = static_cast<bsl::uint8_t>(
+                                                mixedHashValue >> k_H2_SHIFT);
+    ++d_size;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::rehashRaw(
+                                                      bsl::size_t newCapacity)
+{
+    BSLS_ASSERT_SAFE(d_size <= maxLoad(newCapacity));
+
+    FlatHashTable other(0, d_hasher, d_equal, d_allocator_p);
+
+    if (newCapacity) {
+        other.allocateStorage(newCapacity);
+    }
+
+    // Entries are relocated one at a time, marking the source entry erased
+    // once it no longer holds an object, so that both tables remain valid if
+    // a (non-bitwise) move constructor throws.
+
+    for (bsl::size_t i = 0; i < d_capacity && d_size; ++i) {
+        if (0 == (GroupControl::k_EMPTY & d_controls_p[i])) {
+            const Uint64      hash  = mixedHash(ENTRY_UTIL::key(
+                                                             d_entries_p[i]));
+            const bsl::size_t index = other.findAvailable(hash);
+
+            bslma::ConstructionUtil::destructiveMove(other.d_entries_p + index,
+                                                     d_allocator_p,
+                                                     d_entries_p + i);
+
+            d_controls_p[i] = GroupControl::k_ERASED;
+            --d_size;
+
+            other.d_controls_p[index] = static_cast<bsl::uint8_t>(
+                                                         hash >> k_H2_SHIFT);
+            --other.d_growthLeft;
+            ++other.d_size;
+        }
+    }
+
+    swap(other);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::resetToEmpty()
+{
+    d_entries_p  = 0;
+    d_controls_p = 0;
+    d_size       = 0;
+    d_capacity   = 0;
+    d_growthLeft = 0;
+    d_groupShift = 0;
+}
+
+// PRIVATE ACCESSORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::findAvailable(
+                                                        Uint64 mixedHash) const
+{
+    BSLS_ASSERT_SAFE(d_capacity);
+
+    const bsl::size_t mask  = d_capacity / GroupControl::k_SIZE - 1;
+    bsl::size_t       group = static_cast<bsl::size_t>(
+                                            mixedHash >> d_groupShift) & mask;
+
+    // Probe the groups using triangular numbers, which visits every group
+    // when the number of groups is a power of two.
+
+    for (bsl::size_t step = 1; ; ++step) {
+        const bsl::size_t   start     = group * GroupControl::k_SIZE;
+        const bsl::uint32_t available = GroupControl(d_controls_p + start)
+                                                                 .available();
+        if (available) {
+            return start + bdlb::BitUtil::numTrailingUnsetBits(available);
+                                                                      // RETURN
+        }
+        BSLS_ASSERT_SAFE(step <= mask);
+        group = (group + step) & mask;
+    }
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::findKey(
+                                                  const KEY& key,
+                                                  Uint64     mixedHash) const
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == d_capacity)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return 0;                                                     // RETURN
+    }
+
+    const bsl::uint8_t h2    = static_cast<bsl::uint8_t>(
+                                                     mixedHash >> k_H2_SHIFT);
+    const bsl::size_t  mask  = d_capacity / GroupControl::k_SIZE - 1;
+    bsl::size_t        group = static_cast<bsl::size_t>(
+                                            mixedHash >> d_groupShift) & mask;
+
+    for (bsl::size_t step = 1; step <= mask + 1; ++step) {
+        const bsl::size_t  start = group * GroupControl::k_SIZE;
+        GroupControl       control(d_controls_p + start);
+        bsl::uint32_t      candidates = control.match(h2);
+
+        while (candidates) {
+            const bsl::size_t index =
+                     start + bdlb::BitUtil::numTrailingUnsetBits(candidates);
+            if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(
+                          d_equal(ENTRY_UTIL::key(d_entries_p[index]), key))) {
+                return index;                                         // RETURN
+            }
+            candidates &= candidates - 1;
+        }
+        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(control.neverFull())) {
+            break;
+        }
+        group = (group + step) & mask;
+    }
+    return d_capacity;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::makeIterator(
+                                                       bsl::size_t index) const
+{
+    if (index == d_capacity) {
+        return iterator();                                            // RETURN
+    }
+    return iterator(FlatHashTable_IteratorImp<ENTRY>(
+                                                d_entries_p + index,
+                                                d_controls_p + index,
+                                                d_capacity - index - 1));
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsls::Types::Uint64
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::mixedHash(
+                                                         const KEY& key) const
+{
+    return static_cast<Uint64>(d_hasher(key)) * k_HASH_MULTIPLIER;
+}
+
+// CREATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::FlatHashTable(
+                                            bsl::size_t       capacity,
+                                            const HASH&       hash,
+                                            const EQUAL&      equal,
+                                            bslma::Allocator *basicAllocator)
+: d_entries_p(0)
+, d_controls_p(0)
+, d_size(0)
+, d_capacity(0)
+, d_growthLeft(0)
+, d_groupShift(0)
+, d_hasher(hash)
+, d_equal(equal)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    if (capacity) {
+        bsl::size_t actual = k_MIN_CAPACITY;
+        while (actual < capacity) {
+            actual *= 2;
+        }
+        allocateStorage(actual);
+    }
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::FlatHashTable(
+                                        const FlatHashTable&  original,
+                                        bslma::Allocator     *basicAllocator)
+: d_entries_p(0)
+, d_controls_p(0)
+, d_size(0)
+, d_capacity(0)
+, d_growthLeft(0)
+, d_groupShift(0)
+, d_hasher(original.d_hasher)
+, d_equal(original.d_equal)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    if (original.d_size) {
+        allocateStorage(findCapacityForSize(original.d_size));
+
+        const const_iterator end = original.end();
+        for (const_iterator it = original.begin(); it != end; ++it) {
+            insert(*it);
+        }
+    }
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::FlatHashTable(
+                                     bslmf::MovableRef<FlatHashTable> original)
+: d_entries_p(bslmf::MovableRefUtil::access(original).d_entries_p)
+, d_controls_p(bslmf::MovableRefUtil::access(original).d_controls_p)
+, d_size(bslmf::MovableRefUtil::access(original).d_size)
+, d_capacity(bslmf::MovableRefUtil::access(original).d_capacity)
+, d_growthLeft(bslmf::MovableRefUtil::access(original).d_growthLeft)
+, d_groupShift(bslmf::MovableRefUtil::access(original).d_groupShift)
+, d_hasher(bslmf::MovableRefUtil::access(original).d_hasher)
+, d_equal(bslmf::MovableRefUtil::access(original).d_equal)
+, d_allocator_p(bslmf::MovableRefUtil::access(original).d_allocator_p)
+{
+    bslmf::MovableRefUtil::access(original).resetToEmpty();
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::FlatHashTable(
+                            bslmf::MovableRef<FlatHashTable>  original,
+                            bslma::Allocator                 *basicAllocator)
+: d_entries_p(0)
+, d_controls_p(0)
+, d_size(0)
+, d_capacity(0)
+, d_growthLeft(0)
+, d_groupShift(0)
+, d_hasher(bslmf::MovableRefUtil::access(original).d_hasher)
+, d_equal(bslmf::MovableRefUtil::access(original).d_equal)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    FlatHashTable& lvalue = original;
+
+    if (d_allocator_p == lvalue.d_allocator_p) {
+        d_entries_p  = lvalue.d_entries_p;
+        d_controls_p = lvalue.d_controls_p;
+        d_size       = lvalue.d_size;
+        d_capacity   = lvalue.d_capacity;
+        d_growthLeft = lvalue.d_growthLeft;
+        d_groupShift = lvalue.d_groupShift;
+
+        lvalue.resetToEmpty();
+    }
+    else if (lvalue.d_size) {
+        allocateStorage(findCapacityForSize(lvalue.d_size));
+
+        for (iterator it = lvalue.begin(); it != lvalue.end(); ++it) {
+            insert(bslmf::MovableRefUtil::move(*it));
+        }
+    }
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::~FlatHashTable()
+{
+    if (d_capacity) {
+        destroyEntries();
+        d_allocator_p->deallocate(d_entries_p);
+    }
+}
+
+// MANIPULATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>&
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::operator=(
+                                                     const FlatHashTable& rhs)
+{
+    if (this != &rhs) {
+        FlatHashTable other(rhs, d_allocator_p);
+
+        swap(other);
+    }
+    return *this;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>&
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::operator=(
+                                          bslmf::MovableRef<FlatHashTable> rhs)
+{
+    FlatHashTable& lvalue = rhs;
+
+    if (this != &lvalue) {
+        FlatHashTable other(bslmf::MovableRefUtil::move(lvalue),
+                            d_allocator_p);
+
+        swap(other);
+    }
+    return *this;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::clear()
+{
+    destroyEntries();
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::erase(
+                                                                const KEY& key)
+{
+    const bsl::size_t index = findKey(key, mixedHash(key));
+
+    if (index == d_capacity) {
+        return 0;                                                     // RETURN
+    }
+    eraseAt(index);
+    return 1;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::erase(
+                                                       const_iterator position)
+{
+    BSLS_ASSERT(position != end());
+
+    const bsl::size_t index = &*position - d_entries_p;
+
+    iterator next(position.imp());
+    ++next;
+
+    eraseAt(index);
+
+    return next;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::erase(iterator position)
+{
+    return erase(const_iterator(position));
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::erase(const_iterator first,
+                                                          const_iterator last)
+{
+    // Erasing an entry does not relocate any other entry, so 'last' remains
+    // valid throughout.
+
+    while (first != last) {
+        first = erase(first);
+    }
+    return iterator(last.imp());
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::find(const KEY& key)
+{
+    return makeIterator(findKey(key, mixedHash(key)));
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bsl::pair<
+        typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator,
+        bool>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::insert(const ENTRY& entry)
+{
+    bool              notFound;
+    Uint64            hash;
+    const bsl::size_t index = indexOfKey(&notFound,
+                                         &hash,
+                                         ENTRY_UTIL::key(entry));
+
+    if (notFound) {
+        bslma::ConstructionUtil::construct(d_entries_p + index,
+                                           d_allocator_p,
+                                           entry);
+        markInUse(index, hash);
+    }
+    return bsl::pair<iterator, bool>(makeIterator(index), notFound);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bsl::pair<
+        typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator,
+        bool>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::insert(
+                                              bslmf::MovableRef<ENTRY> entry)
+{
+    ENTRY&            lvalue = entry;
+    bool              notFound;
+    Uint64            hash;
+    const bsl::size_t index  = indexOfKey(&notFound,
+                                          &hash,
+                                          ENTRY_UTIL::key(lvalue));
+
+    if (notFound) {
+        bslma::ConstructionUtil::construct(
+                                          d_entries_p + index,
+                                          d_allocator_p,
+                                          bslmf::MovableRefUtil::move(lvalue));
+        markInUse(index, hash);
+    }
+    return bsl::pair<iterator, bool>(makeIterator(index), notFound);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::rehash(
+                                                  bsl::size_t minimumCapacity)
+{
+    if (0 == minimumCapacity && 0 == d_size) {
+        reset();
+        return;                                                       // RETURN
+    }
+
+    bsl::size_t newCapacity = findCapacityForSize(d_size);
+    while (newCapacity < minimumCapacity) {
+        newCapacity *= 2;
+    }
+
+    if (newCapacity != d_capacity) {
+        rehashRaw(newCapacity);
+    }
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::reserve(
+                                                       bsl::size_t numEntries)
+{
+    if (0 == numEntries && 0 == d_size) {
+        reset();
+        return;                                                       // RETURN
+    }
+
+    const bsl::size_t newCapacity = findCapacityForSize(numEntries);
+
+    if (newCapacity > d_capacity) {
+        rehashRaw(newCapacity);
+    }
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::reset()
+{
+    if (d_capacity) {
+        destroyEntries();
+        d_allocator_p->deallocate(d_entries_p);
+        resetToEmpty();
+    }
+}
+
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+template <class KEY_TYPE, class... ARGS>
+bsl::pair<
+        typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator,
+        bool>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::tryEmplace(
+                                                           KEY_TYPE&&  key,
+                                                           ARGS&&...   args)
+{
+    bool              notFound;
+    Uint64            hash;
+    const bsl::size_t index = indexOfKey(&notFound, &hash, key);
+
+    if (notFound) {
+        ENTRY_UTIL::construct(d_entries_p + index,
+                              d_allocator_p,
+                              BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, key),
+                              BSLS_COMPILERFEATURES_FORWARD(ARGS, args)...);
+        markInUse(index, hash);
+    }
+    return bsl::pair<iterator, bool>(makeIterator(index), notFound);
+}
+#else
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+template <class KEY_TYPE>
+bsl::pair<
+        typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator,
+        bool>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::tryEmplace(
+                             BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE) key)
+{
+    bool              notFound;
+    Uint64            hash;
+    const bsl::size_t index = indexOfKey(&notFound, &hash, key);
+
+    if (notFound) {
+        ENTRY_UTIL::construct(d_entries_p + index,
+                              d_allocator_p,
+                              BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, key));
+        markInUse(index, hash);
+    }
+    return bsl::pair<iterator, bool>(makeIterator(index), notFound);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+template <class KEY_TYPE, class ARG1>
+bsl::pair<
+        typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator,
+        bool>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::tryEmplace(
+                             BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE) key,
+                             BSLS_COMPILERFEATURES_FORWARD_REF(ARG1)     arg1)
+{
+    bool              notFound;
+    Uint64            hash;
+    const bsl::size_t index = indexOfKey(&notFound, &hash, key);
+
+    if (notFound) {
+        ENTRY_UTIL::construct(d_entries_p + index,
+                              d_allocator_p,
+                              BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, key),
+                              BSLS_COMPILERFEATURES_FORWARD(ARG1, arg1));
+        markInUse(index, hash);
+    }
+    return bsl::pair<iterator, bool>(makeIterator(index), notFound);
+}
+#endif
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::begin()
+{
+    for (bsl::size_t i = 0; i < d_capacity && d_size;
+                                                   i += GroupControl::k_SIZE) {
+        const bsl::uint32_t inUse = GroupControl(d_controls_p + i).inUse();
+        if (inUse) {
+            return makeIterator(
+                             i + bdlb::BitUtil::numTrailingUnsetBits(inUse));
+                                                                      // RETURN
+        }
+    }
+    return iterator();
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::end()
+{
+    return iterator();
+}
+
+                                  // Aspects
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::swap(
+                                                          FlatHashTable& other)
+{
+    BSLS_ASSERT(allocator() == other.allocator());
+
+    bslalg::SwapUtil::swap(&d_entries_p,  &other.d_entries_p);
+    bslalg::SwapUtil::swap(&d_controls_p, &other.d_controls_p);
+    bslalg::SwapUtil::swap(&d_size,       &other.d_size);
+    bslalg::SwapUtil::swap(&d_capacity,   &other.d_capacity);
+    bslalg::SwapUtil::swap(&d_growthLeft, &other.d_growthLeft);
+    bslalg::SwapUtil::swap(&d_groupShift, &other.d_groupShift);
+    bslalg::SwapUtil::swap(&d_hasher,     &other.d_hasher);
+    bslalg::SwapUtil::swap(&d_equal,      &other.d_equal);
+}
+
+// ACCESSORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::size_t
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::capacity() const
+{
+    return d_capacity;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bool FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::contains(
+                                                          const KEY& key) const
+{
+    return d_capacity != findKey(key, mixedHash(key));
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+const bsl::uint8_t *
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::controls() const
+{
+    return d_controls_p;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::count(
+                                                          const KEY& key) const
+{
+    return contains(key) ? 1 : 0;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bool FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::empty() const
+{
+    return 0 == d_size;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+const ENTRY *
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::entries() const
+{
+    return d_entries_p;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bsl::pair<
+  typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::const_iterator,
+  typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::const_iterator>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::equal_range(
+                                                          const KEY& key) const
+{
+    const_iterator first = find(key);
+    const_iterator last  = first;
+
+    if (last != end()) {
+        ++last;
+    }
+    return bsl::pair<const_iterator, const_iterator>(first, last);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::const_iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::find(const KEY& key) const
+{
+    return makeIterator(findKey(key, mixedHash(key)));
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+const HASH&
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::hash_function() const
+{
+    return d_hasher;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+const EQUAL& FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::key_eq() const
+{
+    return d_equal;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+float FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::load_factor() const
+{
+    return d_capacity ? static_cast<float>(d_size)
+                                        / static_cast<float>(d_capacity)
+                      : 0.0f;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+float
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::max_load_factor() const
+{
+    return 0.875f;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::size() const
+{
+    return d_size;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::const_iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::begin() const
+{
+    return const_cast<FlatHashTable *>(this)->begin();
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::const_iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::end() const
+{
+    return const_iterator();
+}
+
+                                  // Aspects
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bslma::Allocator *
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::allocator() const
+{
+    return d_allocator_p;
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bool bdlc::operator==(
+                 const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& lhs,
+                 const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& rhs)
+{
+    typedef typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::
+                                                         const_iterator Iter;
+
+    if (lhs.size() != rhs.size()) {
+        return false;                                                 // RETURN
+    }
+
+    for (Iter it = lhs.begin(); it != lhs.end(); ++it) {
+        const Iter match = rhs.find(ENTRY_UTIL::key(*it));
+        if (match == rhs.end() || !(*match == *it)) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bool bdlc::operator!=(
+                 const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& lhs,
+                 const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+// FREE FUNCTIONS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void bdlc::swap(FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& a,
+                FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& b)
+{
+    if (a.allocator() == b.allocator()) {
+        a.swap(b);
+
+        return;                                                       // RETURN
+    }
+
+    typedef FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL> Table;
+
+    Table futureA(b, a.allocator());
+    Table futureB(a, b.allocator());
+
+    a.swap(futureA);
+    b.swap(futureB);
+}
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,976 @@
+// bdlc_flathashtable.t.cpp                                           -*-C++-*-
+#include <bdlc_flathashtable.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatormonitor.h>
+
+#include <bslmf_movableref.h>
+
+#include <bsls_asserttest.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_cstdlib.h>
+#include <bsl_functional.h>
+#include <bsl_iostream.h>
+#include <bsl_iterator.h>
+#include <bsl_new.h>         // placement syntax
+#include <bsl_set.h>
+#include <bsl_string.h>
+#include <bsl_utility.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                              TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is an implementation class for open-addressed
+// unordered containers.  Most of its behavior is observable through the
+// manipulators 'tryEmplace' and 'erase', which we verify against an oracle
+// ('bsl::set') for sequences of random operations, using both a well-behaved
+// hash functor and a degenerate one that forces long probe sequences.  The
+// remaining methods are verified directly, with particular attention to
+// memory allocation and to the invariants of the table (the number of
+// entries in use equals the number of in-use control values).
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] FlatHashTable(size_t capacity, hash, equal, *ba = 0);
+// [ 4] FlatHashTable(const FlatHashTable& original, *ba = 0);
+// [ 4] FlatHashTable(MovableRef<FlatHashTable> original);
+// [ 4] FlatHashTable(MovableRef<FlatHashTable> original, *ba);
+// [ 2] ~FlatHashTable();
+//
+// MANIPULATORS
+// [ 4] FlatHashTable& operator=(const FlatHashTable& rhs);
+// [ 4] FlatHashTable& operator=(MovableRef<FlatHashTable> rhs);
+// [ 3] void clear();
+// [ 3] size_t erase(const KEY& key);
+// [ 3] iterator erase(const_iterator position);
+// [ 3] iterator erase(iterator position);
+// [ 3] iterator erase(const_iterator first, const_iterator last);
+// [ 2] iterator find(const KEY& key);
+// [ 2] pair<iterator, bool> insert(const ENTRY& entry);
+// [ 2] pair<iterator, bool> insert(MovableRef<ENTRY> entry);
+// [ 5] void rehash(size_t minimumCapacity);
+// [ 5] void reserve(size_t numEntries);
+// [ 5] void reset();
+// [ 2] pair<iterator, bool> tryEmplace(KEY_TYPE&& key, ARGS&&... args);
+// [ 2] iterator begin();
+// [ 2] iterator end();
+// [ 4] void swap(FlatHashTable& other);
+//
+// ACCESSORS
+// [ 2] size_t capacity() const;
+// [ 2] bool contains(const KEY& key) const;
+// [ 2] const bsl::uint8_t *controls() const;
+// [ 2] size_t count(const KEY& key) const;
+// [ 2] bool empty() const;
+// [ 2] const ENTRY *entries() const;
+// [ 2] pair<const_iterator, const_iterator> equal_range(const KEY&) const;
+// [ 2] const_iterator find(const KEY& key) const;
+// [ 2] const HASH& hash_function() const;
+// [ 2] const EQUAL& key_eq() const;
+// [ 2] float load_factor() const;
+// [ 2] float max_load_factor() const;
+// [ 2] size_t size() const;
+// [ 2] const_iterator begin() const;
+// [ 2] const_iterator end() const;
+// [ 2] bslma::Allocator *allocator() const;
+//
+// FREE OPERATORS
+// [ 4] bool operator==(const FlatHashTable& lhs, const FlatHashTable& rhs);
+// [ 4] bool operator!=(const FlatHashTable& lhs, const FlatHashTable& rhs);
+//
+// FREE FUNCTIONS
+// [ 4] void swap(FlatHashTable& a, FlatHashTable& b);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// ----------------------------------------------------------------------------
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+struct IntEntryUtil {
+    // This utility provides the 'ENTRY_UTIL' methods for an 'int' entry that
+    // is its own key.
+
+    template <class KEY_TYPE>
+    static void construct(int *entry, bslma::Allocator *, KEY_TYPE key)
+        // Load the specified 'key' into the specified 'entry'.
+    {
+        *entry = key;
+    }
+
+    static const int& key(const int& entry)
+        // Return the specified 'entry'.
+    {
+        return entry;
+    }
+};
+
+struct StringEntryUtil {
+    // This utility provides the 'ENTRY_UTIL' methods for a 'bsl::string'
+    // entry that is its own key.
+
+    template <class KEY_TYPE>
+    static void construct(bsl::string      *entry,
+                          bslma::Allocator *allocator,
+                          const KEY_TYPE&   key)
+        // Construct in the specified 'entry' a string having the value of the
+        // specified 'key' and using the specified 'allocator'.
+    {
+        new (entry) bsl::string(key, allocator);
+    }
+
+    static const bsl::string& key(const bsl::string& entry)
+        // Return the specified 'entry'.
+    {
+        return entry;
+    }
+};
+
+class DegenerateHash {
+    // This functor returns a hash value having very few distinct values, so
+    // that many keys share a probe sequence and a control value.
+
+    // DATA
+    int d_modulus;  // number of distinct hash values
+
+  public:
+    // CREATORS
+    explicit DegenerateHash(int modulus = 3)
+        // Create a hash functor producing the optionally specified 'modulus'
+        // distinct hash values.
+    : d_modulus(modulus)
+    {
+    }
+
+    // ACCESSORS
+    bsl::size_t operator()(int key) const
+        // Return the hash value of the specified 'key'.
+    {
+        return static_cast<bsl::size_t>(key % d_modulus);
+    }
+
+    int modulus() const
+        // Return the modulus of this functor.
+    {
+        return d_modulus;
+    }
+};
+
+typedef bdlc::FlatHashTable<int,
+                            int,
+                            IntEntryUtil,
+                            bsl::hash<int>,
+                            bsl::equal_to<int> >     Obj;
+
+typedef bdlc::FlatHashTable<int,
+                            int,
+                            IntEntryUtil,
+                            DegenerateHash,
+                            bsl::equal_to<int> >     DegenerateObj;
+
+typedef bdlc::FlatHashTable<bsl::string,
+                            bsl::string,
+                            StringEntryUtil,
+                            bsl::hash<bsl::string>,
+                            bsl::equal_to<bsl::string> > StringObj;
+
+// ============================================================================
+//                          HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+template <class TABLE>
+bool verifyInvariants(const TABLE& table)
+    // Return 'true' if the number of in-use control values, and the number of
+    // entries visited by iteration, of the specified 'table' equal its size,
+    // and 'false' otherwise.
+{
+    bsl::size_t numInUse = 0;
+    for (bsl::size_t i = 0; i < table.capacity(); ++i) {
+        if (0 == (0x80 & table.controls()[i])) {
+            ++numInUse;
+        }
+    }
+
+    bsl::size_t numIterated = 0;
+    for (typename TABLE::const_iterator it = table.begin();
+         it != table.end();
+         ++it) {
+        ++numIterated;
+    }
+
+    return numInUse == table.size() && numIterated == table.size();
+}
+
+template <class TABLE>
+bool matchesOracle(const TABLE& table, const bsl::set<int>& oracle)
+    // Return 'true' if the specified 'table' contains exactly the values in
+    // the specified 'oracle', and 'false' otherwise.
+{
+    if (table.size() != oracle.size()) {
+        return false;                                                 // RETURN
+    }
+    for (bsl::set<int>::const_iterator it = oracle.begin();
+         it != oracle.end();
+         ++it) {
+        if (!table.contains(*it)) {
+            return false;                                             // RETURN
+        }
+    }
+    for (typename TABLE::const_iterator it = table.begin();
+         it != table.end();
+         ++it) {
+        if (0 == oracle.count(*it)) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+template <class TABLE>
+void testRandomOperations(TABLE *table, int numOperations, int keyRange)
+    // Apply the specified 'numOperations' pseudo-random insertions and
+    // removals of keys in the range '[0 .. keyRange)' to the specified
+    // 'table', and to an oracle, verifying after each operation that the
+    // table matches the oracle.
+{
+    bsl::set<int> oracle;
+
+    unsigned int seed = 987654321;
+
+    for (int i = 0; i < numOperations; ++i) {
+        seed = seed * 1103515245 + 12345;
+
+        const int key = static_cast<int>((seed >> 8) % keyRange);
+
+        if ((seed >> 4) % 3) {
+            const bool EXP = oracle.insert(key).second;
+
+            bsl::pair<typename TABLE::iterator, bool> rv =
+                                                      table->tryEmplace(key);
+            LOOP2_ASSERT(i, key, EXP == rv.second);
+            LOOP2_ASSERT(i, key, key == *rv.first);
+        }
+        else {
+            const bsl::size_t EXP = oracle.erase(key);
+
+            LOOP2_ASSERT(i, key, EXP == table->erase(key));
+        }
+        LOOP_ASSERT(i, oracle.size() == table->size());
+
+        if (0 == i % 97) {
+            LOOP_ASSERT(i, matchesOracle(*table, oracle));
+            LOOP_ASSERT(i, verifyInvariants(*table));
+            LOOP_ASSERT(i, table->size() <= table->capacity() / 8 * 7);
+        }
+    }
+    ASSERT(matchesOracle(*table, oracle));
+    ASSERT(verifyInvariants(*table));
+}
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int  test    = argc > 1 ? atoi(argv[1]) : 0;
+    bool verbose = argc > 2;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator da("default", false);
+    bslma::DefaultAllocatorGuard dag(&da);
+
+    switch (test) { case 0:
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING 'rehash', 'reserve', AND 'reset'
+        //   The capacity-management methods operate as expected.
+        //
+        // Concerns:
+        //: 1 'rehash' sets the capacity to the smallest valid capacity that is
+        //:   at least the requested capacity and can hold the current
+        //:   entries.
+        //:
+        //: 2 'reserve' ensures the requested number of entries can be held
+        //:   without a further rehash.
+        //:
+        //: 3 'reset' releases all memory.
+        //:
+        //: 4 The value of the table is not changed by these methods, other
+        //:   than by 'reset'.
+        //
+        // Plan:
+        //: 1 For a series of table sizes, invoke the methods and verify the
+        //:   resultant capacity, value, and memory use.  (C-1..4)
+        //
+        // Testing:
+        //   void rehash(size_t minimumCapacity);
+        //   void reserve(size_t numEntries);
+        //   void reset();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'rehash', 'reserve', AND 'reset'"
+                          << endl
+                          << "========================================"
+                          << endl;
+
+        bslma::TestAllocator sa("supplied", false);
+
+        for (int n = 0; n < 300; n += 7) {
+            Obj mX(0, bsl::hash<int>(), bsl::equal_to<int>(), &sa);
+            const Obj& X = mX;
+
+            bsl::set<int> oracle;
+            for (int i = 0; i < n; ++i) {
+                mX.tryEmplace(i * 13);
+                oracle.insert(i * 13);
+            }
+
+            mX.rehash(0);
+            LOOP_ASSERT(n, matchesOracle(X, oracle));
+            LOOP_ASSERT(n, n <= static_cast<int>(X.capacity() / 8 * 7));
+            LOOP_ASSERT(n, 0 != n || 0 == X.capacity());
+            LOOP_ASSERT(n, 0 != n || 0 == sa.numBlocksInUse());
+
+            mX.rehash(1000);
+            LOOP_ASSERT(n, matchesOracle(X, oracle));
+            LOOP_ASSERT(n, 1024 == X.capacity());
+            LOOP_ASSERT(n, 1 == sa.numBlocksInUse());
+
+            mX.reset();
+            LOOP_ASSERT(n, X.empty());
+            LOOP_ASSERT(n, 0 == X.capacity());
+            LOOP_ASSERT(n, 0 == sa.numBlocksInUse());
+
+            mX.reserve(n);
+            LOOP_ASSERT(n, n <= static_cast<int>(X.capacity() / 8 * 7));
+
+            const bsl::size_t CAPACITY = X.capacity();
+
+            for (int i = 0; i < n; ++i) {
+                mX.tryEmplace(i * 13);
+            }
+            LOOP_ASSERT(n, CAPACITY == X.capacity());
+            LOOP_ASSERT(n, matchesOracle(X, oracle));
+            LOOP_ASSERT(n, verifyInvariants(X));
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING COPY, MOVE, ASSIGNMENT, SWAP, AND EQUALITY
+        //   The value-semantic operations behave as expected.
+        //
+        // Concerns:
+        //: 1 A copy has the same value as the original, and uses the supplied
+        //:   (or default) allocator.
+        //:
+        //: 2 A move with the same allocator transfers the storage without
+        //:   allocation; a move with a different allocator copies the
+        //:   entries into memory from the new allocator.
+        //:
+        //: 3 Assignment and swap exchange values correctly.
+        //:
+        //: 4 Equality is independent of the capacity and of the order of
+        //:   insertion.
+        //
+        // Plan:
+        //: 1 Create tables of 'bsl::string' entries, which allocate, and
+        //:   verify value and memory use after each operation.  (C-1..4)
+        //
+        // Testing:
+        //   FlatHashTable(const FlatHashTable& original, *ba = 0);
+        //   FlatHashTable(MovableRef<FlatHashTable> original);
+        //   FlatHashTable(MovableRef<FlatHashTable> original, *ba);
+        //   FlatHashTable& operator=(const FlatHashTable& rhs);
+        //   FlatHashTable& operator=(MovableRef<FlatHashTable> rhs);
+        //   void swap(FlatHashTable& other);
+        //   bool operator==(const FlatHashTable& lhs, const FlatHashTable&);
+        //   bool operator!=(const FlatHashTable& lhs, const FlatHashTable&);
+        //   void swap(FlatHashTable& a, FlatHashTable& b);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                     << "TESTING COPY, MOVE, ASSIGNMENT, SWAP, AND EQUALITY"
+                     << endl
+                     << "=================================================="
+                     << endl;
+
+        typedef bsl::hash<bsl::string>     Hash;
+        typedef bsl::equal_to<bsl::string> Equal;
+
+        bslma::TestAllocator sa1("supplied1", false);
+        bslma::TestAllocator sa2("supplied2", false);
+
+        const char *const LONG_PREFIX = "a string too long for the short "
+                                        "string optimization, number ";
+
+        StringObj mX(0, Hash(), Equal(), &sa1);  const StringObj& X = mX;
+
+        for (int i = 0; i < 100; ++i) {
+            mX.tryEmplace(bsl::string(LONG_PREFIX) + char('A' + i % 26)
+                                                   + char('a' + i / 26));
+        }
+        ASSERT(100 == X.size());
+
+        if (verbose) cout << "\nCopy construction." << endl;
+        {
+            StringObj mY(X, &sa2);  const StringObj& Y = mY;
+
+            ASSERT(X == Y);
+            ASSERT(!(X != Y));
+            ASSERT(&sa2 == Y.allocator());
+            ASSERT(101 == sa2.numBlocksInUse());
+
+            StringObj mZ(X);  const StringObj& Z = mZ;
+
+            ASSERT(X == Z);
+            ASSERT(&da == Z.allocator());
+        }
+        ASSERT(0 == sa2.numBlocksInUse());
+        ASSERT(0 == da.numBlocksInUse());
+
+        if (verbose) cout << "\nEquality ignores capacity and order." << endl;
+        {
+            StringObj mY(1024, Hash(), Equal(), &sa2);
+            const StringObj& Y = mY;
+
+            for (StringObj::const_iterator it = X.begin(); it != X.end();
+                                                                        ++it) {
+                mY.tryEmplace(*it);
+            }
+            ASSERT(X.capacity() != Y.capacity());
+            ASSERT(X == Y);
+
+            mY.erase(*Y.begin());
+            ASSERT(X != Y);
+
+            mY.tryEmplace("other");
+            ASSERT(X.size() == Y.size());
+            ASSERT(X != Y);
+        }
+
+        if (verbose) cout << "\nMove construction." << endl;
+        {
+            StringObj mW(X, &sa1);
+            StringObj mY(X, &sa1);
+
+            bslma::TestAllocatorMonitor sam1(&sa1);
+
+            StringObj mZ(bslmf::MovableRefUtil::move(mY));
+            const StringObj& Z = mZ;
+
+            ASSERT(X == Z);
+            ASSERT(sam1.isTotalSame());
+            ASSERT(0 == mY.size());
+            ASSERT(0 == mY.capacity());
+
+            StringObj mV(bslmf::MovableRefUtil::move(mW), &sa2);
+            const StringObj& V = mV;
+
+            ASSERT(X == V);
+            ASSERT(&sa2 == V.allocator());
+            ASSERT(101 == sa2.numBlocksInUse());
+
+            // 'mY' is usable after having been moved from.
+
+            mY.tryEmplace("reuse");
+            ASSERT(1 == mY.size());
+        }
+        ASSERT(0 == sa2.numBlocksInUse());
+
+        if (verbose) cout << "\nAssignment." << endl;
+        {
+            StringObj mY(0, Hash(), Equal(), &sa2);  const StringObj& Y = mY;
+
+            mY.tryEmplace("discarded");
+
+            mY = X;
+            ASSERT(X == Y);
+            ASSERT(&sa2 == Y.allocator());
+
+            mY = Y;
+            ASSERT(X == Y);
+
+            StringObj mZ(0, Hash(), Equal(), &sa1);  const StringObj& Z = mZ;
+
+            mZ = bslmf::MovableRefUtil::move(mY);
+            ASSERT(X == Z);
+            ASSERT(&sa1 == Z.allocator());
+        }
+        ASSERT(0 == sa2.numBlocksInUse());
+
+        if (verbose) cout << "\nSwap." << endl;
+        {
+            StringObj mY(0, Hash(), Equal(), &sa1);  const StringObj& Y = mY;
+            StringObj mZ(X, &sa1);                   const StringObj& Z = mZ;
+
+            mY.tryEmplace("one");
+
+            const StringObj YY(Y, &sa2);
+
+            bslma::TestAllocatorMonitor sam1(&sa1);
+
+            mY.swap(mZ);
+            ASSERT(X  == Y);
+            ASSERT(YY == Z);
+            ASSERT(sam1.isTotalSame());
+
+            bdlc::swap(mY, mZ);
+            ASSERT(YY == Y);
+            ASSERT(X  == Z);
+            ASSERT(sam1.isTotalSame());
+
+            StringObj mV(X, &sa2);  const StringObj& V = mV;
+
+            bdlc::swap(mY, mV);
+            ASSERT(X  == Y);
+            ASSERT(YY == V);
+            ASSERT(&sa1 == Y.allocator());
+            ASSERT(&sa2 == V.allocator());
+        }
+        ASSERT(0 == sa2.numBlocksInUse());
+
+        if (verbose) cout << "\nNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            StringObj mY(0, Hash(), Equal(), &sa1);
+            StringObj mZ(0, Hash(), Equal(), &sa1);
+            StringObj mV(0, Hash(), Equal(), &sa2);
+
+            ASSERT_SAFE_PASS(mY.swap(mZ));
+            ASSERT_SAFE_FAIL(mY.swap(mV));
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'erase' AND 'clear'
+        //   Entries are removed as expected.
+        //
+        // Concerns:
+        //: 1 'erase(key)' removes the entry having the key, if any, and
+        //:   returns the number of entries removed.
+        //:
+        //: 2 'erase(position)' returns an iterator to the following entry.
+        //:
+        //: 3 Range 'erase' removes exactly the entries in the range.
+        //:
+        //: 4 Repeated insertions and removals (e.g., a table used as a queue
+        //:   of keys) do not cause unbounded growth: erased entries are
+        //:   reclaimed by rehashing in place.
+        //:
+        //: 5 'clear' removes all entries and retains the capacity.
+        //:
+        //: 6 QoI: asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Erase by key, position, and range, verifying the values against
+        //:   an oracle.  (C-1..3)
+        //:
+        //: 2 Insert a sliding window of keys, and verify the capacity remains
+        //:   bounded.  (C-4)
+        //:
+        //: 3 Invoke 'clear' and verify the size and capacity.  (C-5)
+        //:
+        //: 4 Verify defensive checks are triggered for invalid values.  (C-6)
+        //
+        // Testing:
+        //   void clear();
+        //   size_t erase(const KEY& key);
+        //   iterator erase(const_iterator position);
+        //   iterator erase(iterator position);
+        //   iterator erase(const_iterator first, const_iterator last);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'erase' AND 'clear'" << endl
+                          << "===========================" << endl;
+
+        bslma::TestAllocator sa("supplied", false);
+
+        if (verbose) cout << "\nErase by position." << endl;
+        {
+            Obj mX(0, bsl::hash<int>(), bsl::equal_to<int>(), &sa);
+            const Obj& X = mX;
+
+            bsl::set<int> oracle;
+            for (int i = 0; i < 500; ++i) {
+                mX.tryEmplace(i * 7);
+                oracle.insert(i * 7);
+            }
+
+            Obj::iterator it = mX.begin();
+            while (it != mX.end()) {
+                const int key = *it;
+                if (key % 2) {
+                    Obj::iterator next = it;
+                    ++next;
+                    it = mX.erase(it);
+                    LOOP_ASSERT(key, next == it);
+                    oracle.erase(key);
+                }
+                else {
+                    ++it;
+                }
+            }
+            ASSERT(matchesOracle(X, oracle));
+            ASSERT(verifyInvariants(X));
+
+            Obj::const_iterator first = X.begin();
+            Obj::const_iterator last  = X.begin();
+            for (int i = 0; i < 10; ++i) {
+                oracle.erase(*last);
+                ++last;
+            }
+            ASSERT(last == mX.erase(first, last));
+            ASSERT(matchesOracle(X, oracle));
+
+            ASSERT(X.end() == mX.erase(X.begin(), X.end()));
+            ASSERT(X.empty());
+            ASSERT(verifyInvariants(X));
+        }
+
+        if (verbose) cout << "\nSliding window of keys." << endl;
+        {
+            Obj mX(0, bsl::hash<int>(), bsl::equal_to<int>(), &sa);
+            const Obj& X = mX;
+
+            const int WINDOW = 100;
+
+            for (int i = 0; i < 100000; ++i) {
+                mX.tryEmplace(i);
+                if (i >= WINDOW) {
+                    LOOP_ASSERT(i, 1 == mX.erase(i - WINDOW));
+                }
+            }
+            ASSERT(WINDOW == static_cast<int>(X.size()));
+            ASSERTV(X.capacity(), X.capacity() <= 256);
+            ASSERT(verifyInvariants(X));
+        }
+
+        if (verbose) cout << "\nClear." << endl;
+        {
+            Obj mX(0, bsl::hash<int>(), bsl::equal_to<int>(), &sa);
+            const Obj& X = mX;
+
+            mX.clear();
+            ASSERT(0 == X.capacity());
+
+            for (int i = 0; i < 100; ++i) {
+                mX.tryEmplace(i);
+            }
+
+            const bsl::size_t CAPACITY = X.capacity();
+
+            mX.clear();
+            ASSERT(X.empty());
+            ASSERT(X.begin() == X.end());
+            ASSERT(CAPACITY == X.capacity());
+            ASSERT(0 == X.count(5));
+            ASSERT(verifyInvariants(X));
+        }
+
+        if (verbose) cout << "\nNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            Obj mX(0, bsl::hash<int>(), bsl::equal_to<int>(), &sa);
+
+            mX.tryEmplace(1);
+
+            ASSERT_SAFE_FAIL(mX.erase(mX.end()));
+            ASSERT_SAFE_PASS(mX.erase(mX.begin()));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING PRIMARY MANIPULATORS AND BASIC ACCESSORS
+        //   Insertion and lookup operate as expected.
+        //
+        // Concerns:
+        //: 1 'tryEmplace' inserts an entry only when the key is not present,
+        //:   and returns an iterator to the entry having the key.
+        //:
+        //: 2 The table grows as required, keeping the load factor at most
+        //:   'max_load_factor()'.
+        //:
+        //: 3 Lookup succeeds when many keys have the same hash value (and so
+        //:   the same control value and probe sequence).
+        //:
+        //: 4 All memory is supplied by the specified allocator, in a single
+        //:   block.
+        //:
+        //: 5 The accessors reflect the state of the table.
+        //
+        // Plan:
+        //: 1 Apply pseudo-random sequences of insertions and removals to
+        //:   tables having each hash functor and compare against an oracle.
+        //:   (C-1..3)
+        //:
+        //: 2 Verify the memory use and accessors.  (C-4..5)
+        //
+        // Testing:
+        //   FlatHashTable(size_t capacity, hash, equal, *ba = 0);
+        //   ~FlatHashTable();
+        //   iterator find(const KEY& key);
+        //   pair<iterator, bool> insert(const ENTRY& entry);
+        //   pair<iterator, bool> insert(MovableRef<ENTRY> entry);
+        //   pair<iterator, bool> tryEmplace(KEY_TYPE&& key, ARGS&&... args);
+        //   iterator begin();
+        //   iterator end();
+        //   size_t capacity() const;
+        //   bool contains(const KEY& key) const;
+        //   const bsl::uint8_t *controls() const;
+        //   size_t count(const KEY& key) const;
+        //   bool empty() const;
+        //   const ENTRY *entries() const;
+        //   pair<const_iterator, const_iterator> equal_range(const KEY&);
+        //   const_iterator find(const KEY& key) const;
+        //   const HASH& hash_function() const;
+        //   const EQUAL& key_eq() const;
+        //   float load_factor() const;
+        //   float max_load_factor() const;
+        //   size_t size() const;
+        //   const_iterator begin() const;
+        //   const_iterator end() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                 << "TESTING PRIMARY MANIPULATORS AND BASIC ACCESSORS" << endl
+                 << "================================================" << endl;
+
+        bslma::TestAllocator sa("supplied", false);
+
+        if (verbose) cout << "\nRandom operations, well-behaved hash." << endl;
+        {
+            Obj mX(0, bsl::hash<int>(), bsl::equal_to<int>(), &sa);
+
+            testRandomOperations(&mX, 20000, 3000);
+
+            ASSERT(1 == sa.numBlocksInUse());
+            ASSERT(&sa == mX.allocator());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+
+        if (verbose) cout << "\nRandom operations, degenerate hash." << endl;
+        {
+            DegenerateObj mX(0, DegenerateHash(5), bsl::equal_to<int>(), &sa);
+
+            testRandomOperations(&mX, 5000, 400);
+
+            ASSERT(5 == mX.hash_function().modulus());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+
+        if (verbose) cout << "\nAccessors." << endl;
+        {
+            Obj mX(0, bsl::hash<int>(), bsl::equal_to<int>(), &sa);
+            const Obj& X = mX;
+
+            ASSERT(X.empty());
+            ASSERT(0 == X.size());
+            ASSERT(0 == X.capacity());
+            ASSERT(0 == X.entries());
+            ASSERT(0 == X.controls());
+            ASSERT(0.0f == X.load_factor());
+            ASSERT(0.875f == X.max_load_factor());
+            ASSERT(X.begin() == X.end());
+            ASSERT(X.end() == X.find(0));
+            ASSERT(!X.contains(0));
+            ASSERT(0 == sa.numBlocksInUse());
+            ASSERT(X.key_eq()(3, 3));
+
+            bsl::pair<Obj::iterator, bool> rv = mX.tryEmplace(42);
+
+            ASSERT(rv.second);
+            ASSERT(42 == *rv.first);
+            ASSERT(rv.first == mX.find(42));
+            ASSERT(rv.first == mX.begin());
+            ASSERT(1 == X.size());
+            ASSERT(16 == X.capacity());
+            ASSERT(1.0f / 16 == X.load_factor());
+            ASSERT(X.entries() <= &*X.find(42));
+            ASSERT(&*X.find(42) < X.entries() + X.capacity());
+            ASSERT(1 == X.count(42));
+            ASSERT(0 == X.count(43));
+
+            bsl::pair<Obj::const_iterator, Obj::const_iterator> range =
+                                                           X.equal_range(42);
+            ASSERT(range.first == X.find(42));
+            ASSERT(1 == bsl::distance(range.first, range.second));
+
+            range = X.equal_range(43);
+            ASSERT(range.first == range.second);
+
+            const int VALUE = 17;
+
+            rv = mX.insert(VALUE);
+            ASSERT(rv.second);
+            ASSERT(17 == *rv.first);
+
+            int value = 17;
+            rv = mX.insert(bslmf::MovableRefUtil::move(value));
+            ASSERT(!rv.second);
+            ASSERT(17 == *rv.first);
+
+            // Growth keeps the load factor at most the maximum.
+
+            for (int i = 0; i < 1000; ++i) {
+                mX.tryEmplace(i);
+                LOOP_ASSERT(i, X.load_factor() <= X.max_load_factor());
+            }
+            ASSERT(1000 == X.size());
+            ASSERT(2048 == X.capacity());
+            ASSERT(1 == sa.numBlocksInUse());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+
+        if (verbose) cout << "\nInitial capacity." << endl;
+        {
+            Obj mX(100, bsl::hash<int>(), bsl::equal_to<int>(), &sa);
+            const Obj& X = mX;
+
+            ASSERT(128 == X.capacity());
+            ASSERT(1 == sa.numBlocksInUse());
+            ASSERT(X.empty());
+
+            Obj mY(1, bsl::hash<int>(), bsl::equal_to<int>());
+            ASSERT(16 == mY.capacity());
+            ASSERT(&da == mY.allocator());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == da.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Insert, find, and erase a few keys.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        Obj mX(0, bsl::hash<int>(), bsl::equal_to<int>());  const Obj& X = mX;
+
+        ASSERT(0 == X.size());
+
+        ASSERT(mX.tryEmplace(1).second);
+        ASSERT(mX.tryEmplace(2).second);
+        ASSERT(!mX.tryEmplace(1).second);
+        ASSERT(2 == X.size());
+        ASSERT(X.contains(1));
+        ASSERT(X.contains(2));
+        ASSERT(!X.contains(3));
+
+        ASSERT(1 == mX.erase(1));
+        ASSERT(0 == mX.erase(1));
+        ASSERT(1 == X.size());
+        ASSERT(!X.contains(1));
+        ASSERT(2 == *X.begin());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,288 @@
+// bdlc_flathashtable_groupcontrol.h                                  -*-C++-*-
+
+#ifndef INCLUDED_BDLC_FLATHASHTABLE_GROUPCONTROL
+#define INCLUDED_BDLC_FLATHASHTABLE_GROUPCONTROL
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide inquiries to a flat hash table group of control values.
+//
+//@CLASSES:
+//  bdlc::FlatHashTable_GroupControl: flat hash table group control inquiries
+//
+//@SEE_ALSO: bdlc_flathashtable
+//
+//@DESCRIPTION: This component implements the class,
+// 'bdlc::FlatHashTable_GroupControl', which provides query methods to a group
+// of flat hash table control values.  Note that the number of entries in a
+// group control and the inquiry performance is platform dependent.
+//
+// The control byte values in a group have the following meaning:
+//..
+//  k_EMPTY    - the associated entry is available for use and the probe
+//               sequence of any key does not extend past this group
+//  k_ERASED   - the associated entry is available for use but a probe
+//               sequence may extend past this group
+//  0..127     - the associated entry is in use and the value is the low seven
+//               bits of the hash value of the entry's key
+//..
+// On platforms providing SSE2 instructions, a group of 16 control values is
+// queried with a single 128-bit comparison; on all other platforms the group
+// is queried with portable 64-bit word operations (SWAR).  The bit masks
+// returned by the inquiry methods have, in either case, one bit per control
+// value, with the lowest-order bit corresponding to the first control value
+// of the group.
+//
+///Usage
+///-----
+// There is no usage example for this component since it is not meant for
+// direct client use.
+
+#include <bdlscm_version.h>
+
+#include <bsls_assert.h>
+#include <bsls_byteorder.h>
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdint.h>
+#include <bsl_cstring.h>
+
+#if defined(BSLS_PLATFORM_CPU_X86_64)                                         \
+ || (defined(BSLS_PLATFORM_CPU_X86) && defined(__SSE2__))
+    #define BDLC_FLATHASHTABLE_GROUPCONTROL_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlc {
+
+                       // ================================
+                       // class FlatHashTable_GroupControl
+                       // ================================
+
+class FlatHashTable_GroupControl {
+    // This class provides inquiries on a group of flat hash table control
+    // values.
+
+  public:
+    // CONSTANTS
+    static const bsl::uint8_t k_EMPTY  = 0x80;
+    static const bsl::uint8_t k_ERASED = 0xC0;
+
+    enum { k_SIZE = 16 };
+
+  private:
+    // PRIVATE TYPES
+#if defined(BDLC_FLATHASHTABLE_GROUPCONTROL_SSE2)
+    typedef __m128i             Storage;
+#else
+    typedef bsls::Types::Uint64 Storage[2];
+
+    // PRIVATE CLASS METHODS
+    static bsl::uint32_t compress(bsls::Types::Uint64 value);
+        // Return a bit mask having one bit for each of the eight bytes in the
+        // specified 'value', with the bit for the lowest-addressed byte being
+        // the lowest-order bit, that is set if and only if the highest-order
+        // bit of the corresponding byte is set.  The behavior is undefined
+        // unless each byte of 'value' is either 0x00 or 0x80.
+
+    static bsls::Types::Uint64 highBitsOfMatches(bsls::Types::Uint64 word,
+                                                 bsls::Types::Uint64 pattern);
+        // Return a word having the highest-order bit of each byte set if and
+        // only if the corresponding byte in the specified 'word' equals the
+        // corresponding byte in the specified 'pattern', and all other bits
+        // unset.
+#endif
+
+    // DATA
+    Storage d_value;  // copy of the group of control values
+
+    // NOT IMPLEMENTED
+    FlatHashTable_GroupControl();
+    FlatHashTable_GroupControl(const FlatHashTable_GroupControl&);
+    FlatHashTable_GroupControl& operator=(const FlatHashTable_GroupControl&);
+
+  public:
+    // CREATORS
+    explicit FlatHashTable_GroupControl(const bsl::uint8_t *data);
+        // Create a group control query object using the specified 'data'.  The
+        // behavior is undefined unless 'data' refers to at least 'k_SIZE'
+        // contiguous control values.  Note that 'data' need not be aligned.
+
+    //! ~FlatHashTable_GroupControl() = default;
+        // Destroy this object.
+
+    // ACCESSORS
+    bsl::uint32_t available() const;
+        // Return a bit mask of the entries in this group that are available
+        // for use (i.e., are either empty or erased).
+
+    bsl::uint32_t inUse() const;
+        // Return a bit mask of the entries in this group that are in use.
+
+    bsl::uint32_t match(bsl::uint8_t value) const;
+        // Return a bit mask of the entries in this group whose control value
+        // equals the specified 'value'.  The behavior is undefined unless
+        // '0 == (0x80 & value)'.
+
+    bool neverFull() const;
+        // Return 'true' if this group contains at least one empty entry (i.e.,
+        // an entry having control value 'k_EMPTY'), and 'false' otherwise.
+        // Note that no probe sequence extends past a group that was never
+        // full.
+};
+
+// ============================================================================
+//                           INLINE DEFINITIONS
+// ============================================================================
+
+                       // --------------------------------
+                       // class FlatHashTable_GroupControl
+                       // --------------------------------
+
+#if defined(BDLC_FLATHASHTABLE_GROUPCONTROL_SSE2)
+
+// CREATORS
+inline
+FlatHashTable_GroupControl::FlatHashTable_GroupControl(
+                                                     const bsl::uint8_t *data)
+{
+    BSLS_ASSERT_SAFE(data);
+
+    d_value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+}
+
+// ACCESSORS
+inline
+bsl::uint32_t FlatHashTable_GroupControl::available() const
+{
+    return static_cast<bsl::uint32_t>(_mm_movemask_epi8(d_value));
+}
+
+inline
+bsl::uint32_t FlatHashTable_GroupControl::inUse() const
+{
+    return static_cast<bsl::uint32_t>(_mm_movemask_epi8(d_value)) ^ 0xFFFFu;
+}
+
+inline
+bsl::uint32_t FlatHashTable_GroupControl::match(bsl::uint8_t value) const
+{
+    BSLS_ASSERT_SAFE(0 == (0x80 & value));
+
+    return static_cast<bsl::uint32_t>(_mm_movemask_epi8(
+                        _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(value)),
+                                       d_value)));
+}
+
+inline
+bool FlatHashTable_GroupControl::neverFull() const
+{
+    return 0 != _mm_movemask_epi8(
+                      _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(k_EMPTY)),
+                                     d_value));
+}
+
+#else
+
+// PRIVATE CLASS METHODS
+inline
+bsl::uint32_t FlatHashTable_GroupControl::compress(bsls::Types::Uint64 value)
+{
+    // Gather the high bit of each byte into the top byte by multiplication;
+    // each partial product lands on a distinct bit so no carries occur.
+
+    return static_cast<bsl::uint32_t>(
+                             ((value >> 7) * 0x0102040810204080ULL) >> 56);
+}
+
+inline
+bsls::Types::Uint64 FlatHashTable_GroupControl::highBitsOfMatches(
+                                                  bsls::Types::Uint64 word,
+                                                  bsls::Types::Uint64 pattern)
+{
+    const bsls::Types::Uint64 k_LOW7 = 0x7F7F7F7F7F7F7F7FULL;
+
+    bsls::Types::Uint64 x = word ^ pattern;
+
+    // A byte of 'x' is zero exactly when the corresponding bytes match;
+    // compute, without carries between bytes, the high bit of each zero byte.
+
+    return ~(((x & k_LOW7) + k_LOW7) | x | k_LOW7);
+}
+
+// CREATORS
+inline
+FlatHashTable_GroupControl::FlatHashTable_GroupControl(
+                                                     const bsl::uint8_t *data)
+{
+    BSLS_ASSERT_SAFE(data);
+
+    bsl::memcpy(d_value, data, k_SIZE);
+
+#if defined(BSLS_PLATFORM_IS_BIG_ENDIAN)
+    d_value[0] = BSLS_BYTEORDER_LE_U64_TO_HOST(d_value[0]);
+    d_value[1] = BSLS_BYTEORDER_LE_U64_TO_HOST(d_value[1]);
+#endif
+}
+
+// ACCESSORS
+inline
+bsl::uint32_t FlatHashTable_GroupControl::available() const
+{
+    const bsls::Types::Uint64 k_HIGH = 0x8080808080808080ULL;
+
+    return compress(d_value[0] & k_HIGH)
+         | (compress(d_value[1] & k_HIGH) << 8);
+}
+
+inline
+bsl::uint32_t FlatHashTable_GroupControl::inUse() const
+{
+    return available() ^ 0xFFFFu;
+}
+
+inline
+bsl::uint32_t FlatHashTable_GroupControl::match(bsl::uint8_t value) const
+{
+    BSLS_ASSERT_SAFE(0 == (0x80 & value));
+
+    const bsls::Types::Uint64 pattern = 0x0101010101010101ULL * value;
+
+    return compress(highBitsOfMatches(d_value[0], pattern))
+         | (compress(highBitsOfMatches(d_value[1], pattern)) << 8);
+}
+
+inline
+bool FlatHashTable_GroupControl::neverFull() const
+{
+    const bsls::Types::Uint64 pattern = 0x0101010101010101ULL * k_EMPTY;
+
+    return 0 != (highBitsOfMatches(d_value[0], pattern)
+               | highBitsOfMatches(d_value[1], pattern));
+}
+
+#endif
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,314 @@
+// bdlc_flathashtable_groupcontrol.t.cpp                              -*-C++-*-
+#include <bdlc_flathashtable_groupcontrol.h>
+
+#include <bslim_testutil.h>
+
+#include <bsls_asserttest.h>
+
+#include <bsl_cstdint.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                              TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is a query object over a group of control values
+// with platform-dependent implementations.  The methods are verified, on every
+// platform, against a straightforward byte-by-byte oracle, using data loaded
+// from every possible alignment.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] FlatHashTable_GroupControl(const bsl::uint8_t *data);
+// [ 2] ~FlatHashTable_GroupControl();
+//
+// ACCESSORS
+// [ 2] bsl::uint32_t available() const;
+// [ 2] bsl::uint32_t inUse() const;
+// [ 2] bsl::uint32_t match(bsl::uint8_t value) const;
+// [ 2] bool neverFull() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// ----------------------------------------------------------------------------
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlc::FlatHashTable_GroupControl Obj;
+
+const bsl::uint8_t EMPTY  = Obj::k_EMPTY;
+const bsl::uint8_t ERASED = Obj::k_ERASED;
+
+// ============================================================================
+//                          HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static bsl::uint32_t oracleMatch(const bsl::uint8_t *data, bsl::uint8_t value)
+    // Return the bit mask of the control values in the group at the specified
+    // 'data' that are equal to the specified 'value'.
+{
+    bsl::uint32_t rv = 0;
+    for (int i = 0; i < Obj::k_SIZE; ++i) {
+        if (value == data[i]) {
+            rv |= 1u << i;
+        }
+    }
+    return rv;
+}
+
+static bsl::uint32_t oracleAvailable(const bsl::uint8_t *data)
+    // Return the bit mask of the control values in the group at the specified
+    // 'data' that indicate an available entry.
+{
+    return oracleMatch(data, EMPTY) | oracleMatch(data, ERASED);
+}
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int  test    = argc > 1 ? atoi(argv[1]) : 0;
+    bool verbose = argc > 2;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING ACCESSORS
+        //   The accessors return the expected bit masks for every group.
+        //
+        // Concerns:
+        //: 1 Each accessor returns one bit per control value, with the lowest
+        //:   order bit corresponding to the first control value.
+        //:
+        //: 2 The methods operate correctly on unaligned data.
+        //:
+        //: 3 Control values outside of the group are ignored.
+        //:
+        //: 4 'match' distinguishes every in-use control value.
+        //:
+        //: 5 QoI: asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Generate pseudo-random groups of control values, containing
+        //:   in-use, empty, and erased values, at each offset within a buffer
+        //:   and compare the results of each accessor to a byte-by-byte
+        //:   oracle.  (C-1..4)
+        //:
+        //: 2 Verify defensive checks are triggered for invalid values.  (C-5)
+        //
+        // Testing:
+        //   FlatHashTable_GroupControl(const bsl::uint8_t *data);
+        //   ~FlatHashTable_GroupControl();
+        //   bsl::uint32_t available() const;
+        //   bsl::uint32_t inUse() const;
+        //   bsl::uint32_t match(bsl::uint8_t value) const;
+        //   bool neverFull() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING ACCESSORS" << endl
+                          << "=================" << endl;
+
+        bsl::uint8_t buffer[3 * Obj::k_SIZE];
+
+        unsigned int seed = 12345;
+
+        for (int iteration = 0; iteration < 2000; ++iteration) {
+            for (bsl::size_t i = 0; i < sizeof buffer; ++i) {
+                seed = seed * 1103515245 + 12345;
+
+                const unsigned int r = (seed >> 16) & 0xFF;
+
+                // Bias towards a small set of in-use values, so that 'match'
+                // commonly finds several candidates.
+
+                buffer[i] = r < 32 ? EMPTY
+                          : r < 64 ? ERASED
+                          : static_cast<bsl::uint8_t>(r % (iteration % 3
+                                                           ? 4
+                                                           : 128));
+            }
+
+            for (int offset = 0; offset <= Obj::k_SIZE; ++offset) {
+                const bsl::uint8_t *DATA = buffer + offset;
+
+                Obj mX(DATA);  const Obj& X = mX;
+
+                const bsl::uint32_t AVAILABLE = oracleAvailable(DATA);
+
+                LOOP2_ASSERT(iteration, offset, AVAILABLE == X.available());
+                LOOP2_ASSERT(iteration,
+                             offset,
+                             (AVAILABLE ^ 0xFFFFu) == X.inUse());
+                LOOP2_ASSERT(iteration,
+                             offset,
+                             (0 != oracleMatch(DATA, EMPTY))
+                                                           == X.neverFull());
+
+                for (int v = 0; v < 128; ++v) {
+                    const bsl::uint8_t VALUE = static_cast<bsl::uint8_t>(v);
+
+                    LOOP3_ASSERT(iteration,
+                                 offset,
+                                 v,
+                                 oracleMatch(DATA, VALUE) == X.match(VALUE));
+                }
+            }
+        }
+
+        if (verbose) cout << "\nNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            bsl::memset(buffer, EMPTY, sizeof buffer);
+
+            const bsl::uint8_t *NULL_DATA = 0;
+
+            ASSERT_SAFE_FAIL(Obj mZ(NULL_DATA));
+            ASSERT_SAFE_PASS(Obj mZ(buffer));
+
+            Obj mX(buffer);  const Obj& X = mX;
+
+            ASSERT_SAFE_PASS(X.match(0x7F));
+            ASSERT_SAFE_FAIL(X.match(0x80));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an object from a group of control values and verify the
+        //:   results of the accessors.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        const bsl::uint8_t DATA[Obj::k_SIZE] = {
+            EMPTY,  0x01,   ERASED, 0x7F,   0x01,   EMPTY,  0x00,   0x42,
+            ERASED, ERASED, 0x01,   0x00,   0x7F,   0x42,   EMPTY,  0x13
+        };
+
+        Obj mX(DATA);  const Obj& X = mX;
+
+        ASSERTV(X.available(), 0x4325u == X.available());
+        ASSERTV(X.inUse(),     0xBCDAu == X.inUse());
+        ASSERTV(X.match(0x01), 0x0412u == X.match(0x01));
+        ASSERTV(X.match(0x00), 0x0840u == X.match(0x00));
+        ASSERTV(X.match(0x7F), 0x1008u == X.match(0x7F));
+        ASSERTV(X.match(0x13), 0x8000u == X.match(0x13));
+        ASSERTV(X.match(0x55), 0x0000u == X.match(0x55));
+        ASSERT(X.neverFull());
+
+        const bsl::uint8_t FULL[Obj::k_SIZE] = {
+            ERASED, 0x01,   ERASED, 0x7F,   0x01,   0x02,   0x00,   0x42,
+            ERASED, ERASED, 0x01,   0x00,   0x7F,   0x42,   0x03,   0x13
+        };
+
+        Obj mY(FULL);  const Obj& Y = mY;
+
+        ASSERTV(Y.available(), 0x0305u == Y.available());
+        ASSERT(!Y.neverFull());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
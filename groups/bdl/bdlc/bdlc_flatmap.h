@@ -0,0 +1,1181 @@
+// bdlc_flatmap.h                                                     -*-C++-*-
+
+#ifndef INCLUDED_BDLC_FLATMAP
+#define INCLUDED_BDLC_FLATMAP
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an ordered map container held in a sorted vector.
+//
+//@CLASSES:
+//  bdlc::FlatMap: ordered map container held in a sorted vector
+//
+//@SEE_ALSO: bdlc_flattree, bdlc_flatset, bslstl_map
+//
+//@DESCRIPTION: This component defines a single class template,
+// 'bdlc::FlatMap', that implements an ordered map of items with unique keys,
+// stored in key order in a single contiguous array.
+//
+// The ordered map provided by this component, 'bdlc::FlatMap', differs from
+// 'bsl::map' in that its elements are stored in a sorted vector (see
+// 'bdlc_flattree') rather than in individually allocated nodes of a red-black
+// tree.  Consequently, the map incurs one allocation per growth of its array
+// rather than one per element, a lookup is a binary search over contiguous
+// memory (implemented without data-dependent branches), and iteration is a
+// linear scan.  A map that is built once and then searched many times, e.g., a
+// table of reference data loaded at startup, is the ideal use case.
+//
+// The performance characteristics of 'bdlc::FlatMap' are, however, different
+// from those of 'bsl::map':
+//: o Inserting or erasing a single element is linear in the number of
+//:   elements that follow it.  To build a map from many elements, use the
+//:   range constructor or the range form of 'insert', which sort the new
+//:   elements once and merge them into the map in 'O[N * log(N) + size()]'
+//:   time.
+//:
+//: o Any insertion or erasure invalidates the iterators, pointers, and
+//:   references to the elements at or after the point of insertion or
+//:   erasure, and, if the capacity of the map changes, to all elements; in
+//:   particular, the address of an element is not stable.
+//:
+//: o The iterators of a 'bdlc::FlatMap' are random-access iterators.
+//
+// Note that 'value_type' is 'bsl::pair<KEY, VALUE>', rather than
+// 'bsl::pair<const KEY, VALUE>', so that elements can be relocated
+// efficiently; modifying the key of an element in a map results in undefined
+// behavior.
+//
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: A Table of Reference Data
+/// - - - - - - - - - - - - - - - - - -
+// Suppose we are writing a service that must translate, many thousands of
+// times per second, an ISO 4217 currency code to the number of digits used
+// after the decimal point for that currency.  The table is loaded once at
+// startup and never modified afterwards, so a sorted array offers faster
+// lookups and a smaller memory footprint than a node-based map.
+//
+// First, we define the (unordered) raw data from which the table is loaded:
+//..
+//  struct CurrencyData {
+//      const char *d_code;    // ISO 4217 currency code
+//      int         d_digits;  // number of minor-unit digits
+//  };
+//
+//  static const CurrencyData DATA[] = {
+//      { "USD", 2 },
+//      { "JPY", 0 },
+//      { "EUR", 2 },
+//      { "BHD", 3 },
+//      { "GBP", 2 },
+//      { "KWD", 3 },
+//      { "CLF", 4 },
+//  };
+//  const bsl::size_t NUM_DATA = sizeof DATA / sizeof *DATA;
+//..
+// Then, we gather the raw data into a sequence of 'value_type' objects:
+//..
+//  typedef bdlc::FlatMap<bsl::string, int> CurrencyTable;
+//
+//  bsl::vector<CurrencyTable::value_type> rawData;
+//  for (bsl::size_t i = 0; i < NUM_DATA; ++i) {
+//      rawData.push_back(CurrencyTable::value_type(DATA[i].d_code,
+//                                                  DATA[i].d_digits));
+//  }
+//..
+// Next, we create the table with a single bulk insertion, which sorts the
+// data once rather than inserting each element in turn:
+//..
+//  CurrencyTable table(rawData.begin(), rawData.end());
+//  assert(NUM_DATA == table.size());
+//..
+// Then, we look up the number of digits for a few currencies:
+//..
+//  assert(2 == table.at("USD"));
+//  assert(0 == table.at("JPY"));
+//  assert(3 == table.find("KWD")->second);
+//  assert(table.end() == table.find("XYZ"));
+//..
+// Now, we observe that the elements are held in key order:
+//..
+//  assert("BHD" == table.begin()->first);
+//  assert("USD" == (table.end() - 1)->first);
+//..
+// Finally, we use 'lower_bound' to find the range of currencies whose codes
+// begin with a given letter:
+//..
+//  CurrencyTable::const_iterator first = table.lower_bound("E");
+//  CurrencyTable::const_iterator last  = table.lower_bound("F");
+//  assert(1     == last - first);
+//  assert("EUR" == first->first);
+//..
+
+#include <bdlscm_version.h>
+
+#include <bdlc_flattree.h>
+
+#include <bslma_allocator.h>
+#include <bslma_constructionutil.h>
+#include <bslma_destructorguard.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_enableif.h>
+#include <bslmf_isconvertible.h>
+#include <bslmf_movableref.h>
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bsls_assert.h>
+#include <bsls_compilerfeatures.h>
+#include <bsls_objectbuffer.h>
+
+#include <bslstl_stdexceptutil.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_functional.h>
+#include <bsl_utility.h>
+
+namespace BloombergLP {
+namespace bdlc {
+
+                           // ========================
+                           // struct FlatMap_EntryUtil
+                           // ========================
+
+template <class KEY, class VALUE, class ENTRY>
+struct FlatMap_EntryUtil {
+    // This templated utility provides methods to construct an 'ENTRY' and a
+    // method to extract the key from an 'ENTRY', as required by 'FlatTree'.
+
+    // CLASS METHODS
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES
+    template <class KEY_TYPE, class... ARGS>
+    static void construct(ENTRY            *entry,
+                          bslma::Allocator *allocator,
+                          KEY_TYPE&&        key,
+                          ARGS&&...         args);
+        // Load into the specified 'entry' the 'ENTRY' value comprised of the
+        // specified 'key' and a 'VALUE' constructed from the specified 'args',
+        // using the specified 'allocator' to supply memory.  Note that the
+        // 'VALUE' is constructed before the 'ENTRY', and is then moved into
+        // the 'ENTRY'.
+#else
+    template <class KEY_TYPE>
+    static void construct(
+                    ENTRY                                       *entry,
+                    bslma::Allocator                            *allocator,
+                    BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE)  key);
+    template <class KEY_TYPE, class ARG1>
+    static void construct(
+                    ENTRY                                       *entry,
+                    bslma::Allocator                            *allocator,
+                    BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE)  key,
+                    BSLS_COMPILERFEATURES_FORWARD_REF(ARG1)      arg1);
+        // Load into the specified 'entry' the 'ENTRY' value comprised of the
+        // specified 'key' and a 'VALUE' constructed from the optionally
+        // specified 'arg1', using the specified 'allocator' to supply memory.
+#endif
+
+    static const KEY& key(const ENTRY& entry);
+        // Return the key of the specified 'entry'.
+};
+
+                               // =============
+                               // class FlatMap
+                               // =============
+
+template <class KEY, class VALUE, class COMPARATOR = bsl::less<KEY> >
+class FlatMap {
+    // This class template implements a value-semantic container type holding
+    // an ordered set of uniquely-keyed values, stored in a sorted vector.  See
+    // the component-level documentation for details.
+
+    // PRIVATE TYPES
+    typedef FlatTree<KEY,
+                     bsl::pair<KEY, VALUE>,
+                     FlatMap_EntryUtil<KEY, VALUE, bsl::pair<KEY, VALUE> >,
+                     COMPARATOR> ImplType;
+        // This is the underlying implementation class.
+
+    // FRIENDS
+    template <class K, class V, class C>
+    friend bool operator==(const FlatMap<K, V, C>&, const FlatMap<K, V, C>&);
+
+  public:
+    // TYPES
+    typedef KEY                                      key_type;
+    typedef VALUE                                    mapped_type;
+    typedef bsl::pair<KEY, VALUE>                    value_type;
+    typedef bsl::size_t                              size_type;
+    typedef bsl::ptrdiff_t                           difference_type;
+    typedef COMPARATOR                               key_compare;
+    typedef value_type&                              reference;
+    typedef const value_type&                        const_reference;
+    typedef value_type                              *pointer;
+    typedef const value_type                        *const_pointer;
+    typedef typename ImplType::iterator              iterator;
+    typedef typename ImplType::const_iterator        const_iterator;
+
+  private:
+    // DATA
+    ImplType d_impl;  // underlying flat tree used by this flat map
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(FlatMap, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    FlatMap();
+    explicit FlatMap(bslma::Allocator *basicAllocator);
+    explicit FlatMap(const COMPARATOR&  comparator,
+                     bslma::Allocator  *basicAllocator = 0);
+        // Create an empty 'FlatMap' object.  Optionally specify a
+        // 'comparator' used to order the keys of elements in this container.
+        // If 'comparator' is not supplied, a default-constructed object of the
+        // (template parameter) type 'COMPARATOR' is used.  Optionally specify
+        // a 'basicAllocator' used to supply memory.  If 'basicAllocator' is
+        // not supplied or is 0, the currently installed default allocator is
+        // used.  Note that no memory is allocated.
+
+    template <class INPUT_ITERATOR>
+    FlatMap(INPUT_ITERATOR    first,
+            INPUT_ITERATOR    last,
+            bslma::Allocator *basicAllocator = 0);
+    template <class INPUT_ITERATOR>
+    FlatMap(INPUT_ITERATOR     first,
+            INPUT_ITERATOR     last,
+            const COMPARATOR&  comparator,
+            bslma::Allocator  *basicAllocator = 0);
+        // Create a 'FlatMap' object initialized by insertion of the values
+        // from the input iterator range specified by 'first' through 'last'
+        // (including 'first', excluding 'last'), using a single sort followed
+        // by a single merge.  Optionally specify a 'comparator' (see above).
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is not supplied or is 0, the currently installed
+        // default allocator is used.  The behavior is undefined unless 'first'
+        // and 'last' refer to a sequence of valid values where 'first' is at a
+        // position at or before 'last'.  Note that if the input sequence
+        // contains several members having equivalent keys, it is unspecified
+        // which of them is inserted.
+
+    FlatMap(const FlatMap& original, bslma::Allocator *basicAllocator = 0);
+        // Create a 'FlatMap' object having the same value and comparator as
+        // the specified 'original' object.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is not
+        // specified or is 0, the currently installed default allocator is
+        // used.
+
+    FlatMap(bslmf::MovableRef<FlatMap> original);
+        // Create a 'FlatMap' object having the same value, comparator, and
+        // allocator as the specified 'original' object.  The contents of
+        // 'original' are moved (in constant time) to this object, 'original'
+        // is left in a (valid) unspecified state, and no exceptions will be
+        // thrown.
+
+    FlatMap(bslmf::MovableRef<FlatMap>  original,
+            bslma::Allocator           *basicAllocator);
+        // Create a 'FlatMap' object having the same value and comparator as
+        // the specified 'original' object, using the specified
+        // 'basicAllocator' to supply memory.  If 'basicAllocator' is 0, the
+        // currently installed default allocator is used.  The allocator of
+        // 'original' remains unchanged.  If 'original' and the newly created
+        // object have the same allocator then the contents of 'original' are
+        // moved (in constant time) to this object, 'original' is left in a
+        // (valid) unspecified state, and no exceptions will be thrown;
+        // otherwise, 'original' is left in a (valid) unspecified state (and an
+        // exception may be thrown).
+
+    //! ~FlatMap() = default;
+        // Destroy this object and each of its elements.
+
+    // MANIPULATORS
+    FlatMap& operator=(const FlatMap& rhs);
+        // Assign to this object the value and comparator of the specified
+        // 'rhs' object, and return a reference providing modifiable access to
+        // this object.
+
+    FlatMap& operator=(bslmf::MovableRef<FlatMap> rhs);
+        // Assign to this object the value and comparator of the specified
+        // 'rhs' object, and return a reference providing modifiable access to
+        // this object.  If this object and 'rhs' use the same allocator the
+        // contents of 'rhs' are moved (in constant time) to this object.
+        // 'rhs' is left in a (valid) unspecified state.
+
+    VALUE& operator[](const KEY& key);
+    VALUE& operator[](bslmf::MovableRef<KEY> key);
+        // Return a reference providing modifiable access to the mapped value
+        // associated with the specified 'key' in this map.  If this map does
+        // not already contain an element having 'key', insert an element
+        // having 'key' (in the second form, moved into the element) and a
+        // default-constructed 'VALUE', and return a reference to the newly
+        // mapped value.
+
+    VALUE& at(const KEY& key);
+        // Return a reference providing modifiable access to the mapped value
+        // associated with the specified 'key' in this map, if such an entry
+        // exists; otherwise throw a 'std::out_of_range' exception.  Note that
+        // this method is not exception-neutral.
+
+    void clear();
+        // Remove all elements from this map.  Note that this map will be empty
+        // after calling this method, but allocated memory may be retained for
+        // future use.  See the 'capacity' method.
+
+    bsl::pair<iterator, iterator> equal_range(const KEY& key);
+        // Return a pair of iterators defining the sequence of modifiable
+        // elements in this map having the specified 'key', where the first
+        // iterator is positioned at the start of the sequence and the second
+        // iterator is positioned one past the end of the sequence.  If this
+        // map contains no elements having a key equivalent to 'key', then the
+        // two returned iterators will have the same value.  Note that since a
+        // map maintains unique keys, the range will contain at most one
+        // element.
+
+    bsl::size_t erase(const KEY& key);
+        // Remove from this map the element whose key is equal to the specified
+        // 'key', if it exists, and return 1; otherwise (there is no element
+        // having 'key' in this map), return 0 with no other effect.  This
+        // method invalidates iterators and references to the removed element
+        // and to the elements that follow it.
+
+    iterator erase(const_iterator position);
+        // Remove from this map the element at the specified 'position', and
+        // return an iterator referring to the modifiable element immediately
+        // following the removed element, or to the past-the-end position if
+        // the removed element was the last element in the sequence of elements
+        // maintained by this map.  This method invalidates iterators and
+        // references to the removed element and to the elements that follow
+        // it.  The behavior is undefined unless 'position' refers to an
+        // element in this map.
+
+    iterator erase(const_iterator first, const_iterator last);
+        // Remove from this map the elements starting at the specified 'first'
+        // position up to, but not including, the specified 'last' position,
+        // and return an iterator referring to the element that followed the
+        // removed elements.  This method invalidates iterators and references
+        // to the removed elements and to the elements that follow them.  The
+        // behavior is undefined unless 'first' and 'last' either refer to
+        // elements in this map or are the 'end' iterator, and the 'first'
+        // position is at or before the 'last' position.
+
+    iterator find(const KEY& key);
+        // Return an iterator referring to the modifiable element in this map
+        // having the specified 'key', or 'end()' if no such entry exists in
+        // this map.
+
+    bsl::pair<iterator, bool> insert(const value_type& value);
+    bsl::pair<iterator, bool> insert(bslmf::MovableRef<value_type> value);
+        // Insert the specified 'value' into this map if the key (the 'first'
+        // element) of 'value' does not already exist in this map; otherwise,
+        // this method has no effect.  Return a 'pair' whose 'first' member is
+        // an iterator referring to the (possibly newly inserted) modifiable
+        // element in this map whose key is equivalent to that of the element
+        // to be inserted, and whose 'second' member is 'true' if a new element
+        // was inserted, and 'false' if an element with an equivalent key was
+        // already present.  In the second form, 'value' is left in a valid but
+        // unspecified state if it is inserted.
+
+    template <class INSERT_VALUE_TYPE>
+    typename bsl::enable_if<
+                 bsl::is_convertible<INSERT_VALUE_TYPE, value_type>::value,
+                 bsl::pair<iterator, bool> >::type
+    insert(BSLS_COMPILERFEATURES_FORWARD_REF(INSERT_VALUE_TYPE) value);
+        // Create a 'value_type' object from the specified 'value', and insert
+        // it into this map if the key of the created object does not already
+        // exist in this map; otherwise, this method has no effect.  Return a
+        // 'pair' whose 'first' member is an iterator referring to the
+        // (possibly newly inserted) modifiable element in this map whose key
+        // is equivalent to that of the created object, and whose 'second'
+        // member is 'true' if a new element was inserted, and 'false'
+        // otherwise.
+
+    template <class INPUT_ITERATOR>
+    void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        // Create a 'value_type' object for each iterator in the range starting
+        // at the specified 'first' iterator and ending immediately before the
+        // specified 'last' iterator, and insert it into this map if its key
+        // does not already exist in this map, using a single sort of the new
+        // elements followed by a single merge.  If the range contains several
+        // elements having equivalent keys, it is unspecified which of them is
+        // inserted.  The behavior is undefined unless 'first' and 'last' refer
+        // to a sequence of valid values where 'first' is at a position at or
+        // before 'last'.
+
+    iterator lower_bound(const KEY& key);
+        // Return an iterator referring to the first modifiable element in
+        // this map whose key is not ordered before the specified 'key', or
+        // 'end()' if no such element exists.
+
+    void reserve(bsl::size_t numElements);
+        // Change the capacity of this map, if necessary, so that it can hold
+        // at least the specified 'numElements' without reallocating.
+
+    void shrink_to_fit();
+        // Reduce the capacity of this map, if possible, to 'size()'.
+
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES
+    template <class... ARGS>
+    bsl::pair<iterator, bool> try_emplace(const KEY& key, ARGS&&... args);
+    template <class... ARGS>
+    bsl::pair<iterator, bool> try_emplace(bslmf::MovableRef<KEY> key,
+                                          ARGS&&...              args);
+        // If a key equivalent to the specified 'key' already exists in this
+        // map, return a pair containing an iterator referring to the existing
+        // item and 'false'.  Otherwise, insert into this map a newly-created
+        // 'value_type' object, constructed from 'key' (in the second form,
+        // moved) and a 'VALUE' constructed from the specified 'args', and
+        // return a pair containing an iterator referring to the newly-created
+        // entry and 'true'.  Note that no 'VALUE' is constructed if 'key' is
+        // already present.
+#else
+    bsl::pair<iterator, bool> try_emplace(const KEY& key);
+    template <class ARG1>
+    bsl::pair<iterator, bool> try_emplace(
+                                const KEY&                              key,
+                                BSLS_COMPILERFEATURES_FORWARD_REF(ARG1) arg1);
+        // If a key equivalent to the specified 'key' already exists in this
+        // map, return a pair containing an iterator referring to the existing
+        // item and 'false'.  Otherwise, insert into this map a newly-created
+        // 'value_type' object, constructed from 'key' and a 'VALUE'
+        // constructed from the optionally specified 'arg1', and return a pair
+        // containing an iterator referring to the newly-created entry and
+        // 'true'.
+#endif
+
+    iterator upper_bound(const KEY& key);
+        // Return an iterator referring to the first modifiable element in
+        // this map whose key is ordered after the specified 'key', or 'end()'
+        // if no such element exists.
+
+    iterator begin();
+        // Return an iterator to the first element in the sequence of
+        // modifiable elements maintained by this map, or the 'end' iterator if
+        // this map is empty.
+
+    iterator end();
+        // Return an iterator to the past-the-end element in the sequence of
+        // modifiable elements maintained by this map.
+
+                                  // Aspects
+
+    void swap(FlatMap& other);
+        // Exchange the value of this object as well as its comparator with
+        // those of the specified 'other' object.  This method provides the
+        // no-throw exception-safety guarantee if 'COMPARATOR' has a no-throw
+        // swap operation.  The behavior is undefined unless this object was
+        // created with the same allocator as 'other'.
+
+    // ACCESSORS
+    const VALUE& at(const KEY& key) const;
+        // Return a reference providing non-modifiable access to the mapped
+        // value associated with the specified 'key' in this map, if such an
+        // entry exists; otherwise throw a 'std::out_of_range' exception.  Note
+        // that this method is not exception-neutral.
+
+    bsl::size_t capacity() const;
+        // Return the number of elements this map can hold without
+        // reallocating.
+
+    bool contains(const KEY& key) const;
+        // Return 'true' if this map contains an element having the specified
+        // 'key', and 'false' otherwise.
+
+    bsl::size_t count(const KEY& key) const;
+        // Return the number of elements in this map having the specified
+        // 'key'.  Note that since a flat map maintains unique keys, the
+        // returned value will be either 0 or 1.
+
+    bool empty() const;
+        // Return 'true' if this map contains no elements, and 'false'
+        // otherwise.
+
+    bsl::pair<const_iterator, const_iterator> equal_range(
+                                                         const KEY& key) const;
+        // Return a pair of 'const_iterator's defining the sequence of elements
+        // in this map having the specified 'key', where the first iterator is
+        // positioned at the start of the sequence and the second iterator is
+        // positioned one past the end of the sequence.  If this map contains
+        // no elements having a key equivalent to 'key', then the two returned
+        // iterators will have the same value.
+
+    const_iterator find(const KEY& key) const;
+        // Return a 'const_iterator' referring to the element in this map
+        // having the specified 'key', or 'end()' if no such entry exists in
+        // this map.
+
+    COMPARATOR key_comp() const;
+        // Return (a copy of) the key-ordering functor used by this map.
+
+    const_iterator lower_bound(const KEY& key) const;
+        // Return a 'const_iterator' referring to the first element in this map
+        // whose key is not ordered before the specified 'key', or 'end()' if
+        // no such element exists.
+
+    bsl::size_t size() const;
+        // Return the number of elements in this map.
+
+    const_iterator upper_bound(const KEY& key) const;
+        // Return a 'const_iterator' referring to the first element in this map
+        // whose key is ordered after the specified 'key', or 'end()' if no
+        // such element exists.
+
+    const_iterator begin() const;
+        // Return a 'const_iterator' to the first element in the sequence of
+        // elements maintained by this map, or the 'end' iterator if this map
+        // is empty.
+
+    const_iterator cbegin() const;
+        // Return a 'const_iterator' to the first element in the sequence of
+        // elements maintained by this map, or the 'end' iterator if this map
+        // is empty.
+
+    const_iterator cend() const;
+        // Return a 'const_iterator' to the past-the-end element in the
+        // sequence of elements maintained by this map.
+
+    const_iterator end() const;
+        // Return a 'const_iterator' to the past-the-end element in the
+        // sequence of elements maintained by this map.
+
+                                  // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this flat map to supply memory.
+};
+
+// FREE OPERATORS
+template <class KEY, class VALUE, class COMPARATOR>
+bool operator==(const FlatMap<KEY, VALUE, COMPARATOR>& lhs,
+                const FlatMap<KEY, VALUE, COMPARATOR>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects have the same
+    // value, and 'false' otherwise.  Two 'FlatMap' objects have the same value
+    // if their sizes are the same and each element contained in one is equal
+    // to the element at the same position in the other.  The comparators are
+    // not involved in the comparison.
+
+template <class KEY, class VALUE, class COMPARATOR>
+bool operator!=(const FlatMap<KEY, VALUE, COMPARATOR>& lhs,
+                const FlatMap<KEY, VALUE, COMPARATOR>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects do not have the
+    // same value, and 'false' otherwise.  Two 'FlatMap' objects do not have
+    // the same value if their sizes are different or some element contained
+    // in one is not equal to the element at the same position in the other.
+    // The comparators are not involved in the comparison.
+
+// FREE FUNCTIONS
+template <class KEY, class VALUE, class COMPARATOR>
+void swap(FlatMap<KEY, VALUE, COMPARATOR>& a,
+          FlatMap<KEY, VALUE, COMPARATOR>& b);
+    // Exchange the value and the comparator of the specified 'a' and 'b'
+    // objects.  This function provides the no-throw exception-safety guarantee
+    // if the two objects were created with the same allocator and the basic
+    // guarantee otherwise.
+
+// ============================================================================
+//                           INLINE DEFINITIONS
+// ============================================================================
+
+                           // ------------------------
+                           // struct FlatMap_EntryUtil
+                           // ------------------------
+
+// CLASS METHODS
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES
+template <class KEY, class VALUE, class ENTRY>
+template <class KEY_TYPE, class... ARGS>
+inline
+void FlatMap_EntryUtil<KEY, VALUE, ENTRY>::construct(
+                                                 ENTRY            *entry,
+                                                 bslma::Allocator *allocator,
+                                                 KEY_TYPE&&        key,
+                                                 ARGS&&...         args)
+{
+    BSLS_ASSERT_SAFE(entry);
+
+    bsls::ObjectBuffer<VALUE> value;
+    bslma::ConstructionUtil::construct(
+                                 value.address(),
+                                 allocator,
+                                 BSLS_COMPILERFEATURES_FORWARD(ARGS, args)...);
+    bslma::DestructorGuard<VALUE> guard(value.address());
+
+    bslma::ConstructionUtil::construct(
+                                 entry,
+                                 allocator,
+                                 BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, key),
+                                 bslmf::MovableRefUtil::move(value.object()));
+}
+#else
+template <class KEY, class VALUE, class ENTRY>
+template <class KEY_TYPE>
+inline
+void FlatMap_EntryUtil<KEY, VALUE, ENTRY>::construct(
+                        ENTRY                                       *entry,
+                        bslma::Allocator                            *allocator,
+                        BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE)  key)
+{
+    BSLS_ASSERT_SAFE(entry);
+
+    bsls::ObjectBuffer<VALUE> value;
+    bslma::ConstructionUtil::construct(value.address(), allocator);
+    bslma::DestructorGuard<VALUE> guard(value.address());
+
+    bslma::ConstructionUtil::construct(
+                                 entry,
+                                 allocator,
+                                 BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, key),
+                                 bslmf::MovableRefUtil::move(value.object()));
+}
+
+template <class KEY, class VALUE, class ENTRY>
+template <class KEY_TYPE, class ARG1>
+inline
+void FlatMap_EntryUtil<KEY, VALUE, ENTRY>::construct(
+                        ENTRY                                       *entry,
+                        bslma::Allocator                            *allocator,
+                        BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE)  key,
+                        BSLS_COMPILERFEATURES_FORWARD_REF(ARG1)      arg1)
+{
+    BSLS_ASSERT_SAFE(entry);
+
+    bsls::ObjectBuffer<VALUE> value;
+    bslma::ConstructionUtil::construct(
+                                    value.address(),
+                                    allocator,
+                                    BSLS_COMPILERFEATURES_FORWARD(ARG1, arg1));
+    bslma::DestructorGuard<VALUE> guard(value.address());
+
+    bslma::ConstructionUtil::construct(
+                                 entry,
+                                 allocator,
+                                 BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, key),
+                                 bslmf::MovableRefUtil::move(value.object()));
+}
+#endif
+
+template <class KEY, class VALUE, class ENTRY>
+inline
+const KEY& FlatMap_EntryUtil<KEY, VALUE, ENTRY>::key(const ENTRY& entry)
+{
+    return entry.first;
+}
+
+                               // -------------
+                               // class FlatMap
+                               // -------------
+
+// CREATORS
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+FlatMap<KEY, VALUE, COMPARATOR>::FlatMap()
+: d_impl(COMPARATOR())
+{
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+FlatMap<KEY, VALUE, COMPARATOR>::FlatMap(bslma::Allocator *basicAllocator)
+: d_impl(COMPARATOR(), basicAllocator)
+{
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+FlatMap<KEY, VALUE, COMPARATOR>::FlatMap(const COMPARATOR&  comparator,
+                                         bslma::Allocator  *basicAllocator)
+: d_impl(comparator, basicAllocator)
+{
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+template <class INPUT_ITERATOR>
+inline
+FlatMap<KEY, VALUE, COMPARATOR>::FlatMap(INPUT_ITERATOR    first,
+                                         INPUT_ITERATOR    last,
+                                         bslma::Allocator *basicAllocator)
+: d_impl(COMPARATOR(), basicAllocator)
+{
+    d_impl.insert(first, last);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+template <class INPUT_ITERATOR>
+inline
+FlatMap<KEY, VALUE, COMPARATOR>::FlatMap(INPUT_ITERATOR     first,
+                                         INPUT_ITERATOR     last,
+                                         const COMPARATOR&  comparator,
+                                         bslma::Allocator  *basicAllocator)
+: d_impl(comparator, basicAllocator)
+{
+    d_impl.insert(first, last);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+FlatMap<KEY, VALUE, COMPARATOR>::FlatMap(const FlatMap&    original,
+                                         bslma::Allocator *basicAllocator)
+: d_impl(original.d_impl, basicAllocator)
+{
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+FlatMap<KEY, VALUE, COMPARATOR>::FlatMap(bslmf::MovableRef<FlatMap> original)
+: d_impl(bslmf::MovableRefUtil::move(
+                               bslmf::MovableRefUtil::access(original).d_impl))
+{
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+FlatMap<KEY, VALUE, COMPARATOR>::FlatMap(
+                                   bslmf::MovableRef<FlatMap>  original,
+                                   bslma::Allocator           *basicAllocator)
+: d_impl(bslmf::MovableRefUtil::move(
+                              bslmf::MovableRefUtil::access(original).d_impl),
+         basicAllocator)
+{
+}
+
+// MANIPULATORS
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+FlatMap<KEY, VALUE, COMPARATOR>&
+FlatMap<KEY, VALUE, COMPARATOR>::operator=(const FlatMap& rhs)
+{
+    d_impl = rhs.d_impl;
+
+    return *this;
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+FlatMap<KEY, VALUE, COMPARATOR>&
+FlatMap<KEY, VALUE, COMPARATOR>::operator=(bslmf::MovableRef<FlatMap> rhs)
+{
+    FlatMap& lvalue = rhs;
+
+    d_impl = bslmf::MovableRefUtil::move(lvalue.d_impl);
+
+    return *this;
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+VALUE& FlatMap<KEY, VALUE, COMPARATOR>::operator[](const KEY& key)
+{
+    return d_impl.tryEmplace(key).first->second;
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+VALUE& FlatMap<KEY, VALUE, COMPARATOR>::operator[](
+                                                 bslmf::MovableRef<KEY> key)
+{
+    return d_impl.tryEmplace(bslmf::MovableRefUtil::move(key)).first->second;
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+VALUE& FlatMap<KEY, VALUE, COMPARATOR>::at(const KEY& key)
+{
+    iterator node = d_impl.find(key);
+
+    if (node == d_impl.end()) {
+        BloombergLP::bslstl::StdExceptUtil::throwOutOfRange(
+                              "FlatMap<...>::at(key_type): invalid key value");
+    }
+
+    return node->second;
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+void FlatMap<KEY, VALUE, COMPARATOR>::clear()
+{
+    d_impl.clear();
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+bsl::pair<typename FlatMap<KEY, VALUE, COMPARATOR>::iterator,
+          typename FlatMap<KEY, VALUE, COMPARATOR>::iterator>
+FlatMap<KEY, VALUE, COMPARATOR>::equal_range(const KEY& key)
+{
+    iterator it1 = d_impl.lower_bound(key);
+    iterator it2 = it1;
+
+    if (it1 != d_impl.end() && !d_impl.key_comp()(key, it1->first)) {
+        ++it2;
+    }
+    return bsl::pair<iterator, iterator>(it1, it2);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+bsl::size_t FlatMap<KEY, VALUE, COMPARATOR>::erase(const KEY& key)
+{
+    return d_impl.erase(key);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+typename FlatMap<KEY, VALUE, COMPARATOR>::iterator
+FlatMap<KEY, VALUE, COMPARATOR>::erase(const_iterator position)
+{
+    BSLS_ASSERT_SAFE(position != end());
+
+    return d_impl.erase(position);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+typename FlatMap<KEY, VALUE, COMPARATOR>::iterator
+FlatMap<KEY, VALUE, COMPARATOR>::erase(const_iterator first,
+                                       const_iterator last)
+{
+    return d_impl.erase(first, last);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+typename FlatMap<KEY, VALUE, COMPARATOR>::iterator
+FlatMap<KEY, VALUE, COMPARATOR>::find(const KEY& key)
+{
+    return d_impl.find(key);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+bsl::pair<typename FlatMap<KEY, VALUE, COMPARATOR>::iterator, bool>
+FlatMap<KEY, VALUE, COMPARATOR>::insert(const value_type& value)
+{
+    return d_impl.insert(value);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+bsl::pair<typename FlatMap<KEY, VALUE, COMPARATOR>::iterator, bool>
+FlatMap<KEY, VALUE, COMPARATOR>::insert(bslmf::MovableRef<value_type> value)
+{
+    return d_impl.insert(bslmf::MovableRefUtil::move(value));
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+template <class INSERT_VALUE_TYPE>
+inline
+typename bsl::enable_if<
+      bsl::is_convertible<INSERT_VALUE_TYPE,
+                          typename FlatMap<KEY, VALUE, COMPARATOR>::value_type>
+                                                                       ::value,
+      bsl::pair<typename FlatMap<KEY, VALUE, COMPARATOR>::iterator, bool> >
+                                                                        ::type
+FlatMap<KEY, VALUE, COMPARATOR>::insert(
+                  BSLS_COMPILERFEATURES_FORWARD_REF(INSERT_VALUE_TYPE) value)
+{
+    value_type entry(BSLS_COMPILERFEATURES_FORWARD(INSERT_VALUE_TYPE, value),
+                     d_impl.allocator());
+
+    return d_impl.insert(bslmf::MovableRefUtil::move(entry));
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+template <class INPUT_ITERATOR>
+inline
+void FlatMap<KEY, VALUE, COMPARATOR>::insert(INPUT_ITERATOR first,
+                                             INPUT_ITERATOR last)
+{
+    d_impl.insert(first, last);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+typename FlatMap<KEY, VALUE, COMPARATOR>::iterator
+FlatMap<KEY, VALUE, COMPARATOR>::lower_bound(const KEY& key)
+{
+    return d_impl.lower_bound(key);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+void FlatMap<KEY, VALUE, COMPARATOR>::reserve(bsl::size_t numElements)
+{
+    d_impl.reserve(numElements);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+void FlatMap<KEY, VALUE, COMPARATOR>::shrink_to_fit()
+{
+    d_impl.shrink_to_fit();
+}
+
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES
+template <class KEY, class VALUE, class COMPARATOR>
+template <class... ARGS>
+inline
+bsl::pair<typename FlatMap<KEY, VALUE, COMPARATOR>::iterator, bool>
+FlatMap<KEY, VALUE, COMPARATOR>::try_emplace(const KEY& key, ARGS&&... args)
+{
+    return d_impl.tryEmplace(key,
+                             BSLS_COMPILERFEATURES_FORWARD(ARGS, args)...);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+template <class... ARGS>
+inline
+bsl::pair<typename FlatMap<KEY, VALUE, COMPARATOR>::iterator, bool>
+FlatMap<KEY, VALUE, COMPARATOR>::try_emplace(bslmf::MovableRef<KEY> key,
+                                             ARGS&&...              args)
+{
+    return d_impl.tryEmplace(bslmf::MovableRefUtil::move(key),
+                             BSLS_COMPILERFEATURES_FORWARD(ARGS, args)...);
+}
+#else
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+bsl::pair<typename FlatMap<KEY, VALUE, COMPARATOR>::iterator, bool>
+FlatMap<KEY, VALUE, COMPARATOR>::try_emplace(const KEY& key)
+{
+    return d_impl.tryEmplace(key);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+template <class ARG1>
+inline
+bsl::pair<typename FlatMap<KEY, VALUE, COMPARATOR>::iterator, bool>
+FlatMap<KEY, VALUE, COMPARATOR>::try_emplace(
+                                const KEY&                              key,
+                                BSLS_COMPILERFEATURES_FORWARD_REF(ARG1) arg1)
+{
+    return d_impl.tryEmplace(key, BSLS_COMPILERFEATURES_FORWARD(ARG1, arg1));
+}
+#endif
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+typename FlatMap<KEY, VALUE, COMPARATOR>::iterator
+FlatMap<KEY, VALUE, COMPARATOR>::upper_bound(const KEY& key)
+{
+    return d_impl.upper_bound(key);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+typename FlatMap<KEY, VALUE, COMPARATOR>::iterator
+FlatMap<KEY, VALUE, COMPARATOR>::begin()
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+typename FlatMap<KEY, VALUE, COMPARATOR>::iterator
+FlatMap<KEY, VALUE, COMPARATOR>::end()
+{
+    return d_impl.end();
+}
+
+                                  // Aspects
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+void FlatMap<KEY, VALUE, COMPARATOR>::swap(FlatMap& other)
+{
+    BSLS_ASSERT_SAFE(allocator() == other.allocator());
+
+    d_impl.swap(other.d_impl);
+}
+
+// ACCESSORS
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+const VALUE& FlatMap<KEY, VALUE, COMPARATOR>::at(const KEY& key) const
+{
+    const_iterator node = d_impl.find(key);
+
+    if (node == d_impl.end()) {
+        BloombergLP::bslstl::StdExceptUtil::throwOutOfRange(
+                              "FlatMap<...>::at(key_type): invalid key value");
+    }
+
+    return node->second;
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+bsl::size_t FlatMap<KEY, VALUE, COMPARATOR>::capacity() const
+{
+    return d_impl.capacity();
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+bool FlatMap<KEY, VALUE, COMPARATOR>::contains(const KEY& key) const
+{
+    return d_impl.contains(key);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+bsl::size_t FlatMap<KEY, VALUE, COMPARATOR>::count(const KEY& key) const
+{
+    return d_impl.count(key);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+bool FlatMap<KEY, VALUE, COMPARATOR>::empty() const
+{
+    return d_impl.empty();
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+bsl::pair<typename FlatMap<KEY, VALUE, COMPARATOR>::const_iterator,
+          typename FlatMap<KEY, VALUE, COMPARATOR>::const_iterator>
+FlatMap<KEY, VALUE, COMPARATOR>::equal_range(const KEY& key) const
+{
+    return d_impl.equal_range(key);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+typename FlatMap<KEY, VALUE, COMPARATOR>::const_iterator
+FlatMap<KEY, VALUE, COMPARATOR>::find(const KEY& key) const
+{
+    return d_impl.find(key);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+COMPARATOR FlatMap<KEY, VALUE, COMPARATOR>::key_comp() const
+{
+    return d_impl.key_comp();
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+typename FlatMap<KEY, VALUE, COMPARATOR>::const_iterator
+FlatMap<KEY, VALUE, COMPARATOR>::lower_bound(const KEY& key) const
+{
+    return d_impl.lower_bound(key);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+bsl::size_t FlatMap<KEY, VALUE, COMPARATOR>::size() const
+{
+    return d_impl.size();
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+typename FlatMap<KEY, VALUE, COMPARATOR>::const_iterator
+FlatMap<KEY, VALUE, COMPARATOR>::upper_bound(const KEY& key) const
+{
+    return d_impl.upper_bound(key);
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+typename FlatMap<KEY, VALUE, COMPARATOR>::const_iterator
+FlatMap<KEY, VALUE, COMPARATOR>::begin() const
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+typename FlatMap<KEY, VALUE, COMPARATOR>::const_iterator
+FlatMap<KEY, VALUE, COMPARATOR>::cbegin() const
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+typename FlatMap<KEY, VALUE, COMPARATOR>::const_iterator
+FlatMap<KEY, VALUE, COMPARATOR>::cend() const
+{
+    return d_impl.end();
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+typename FlatMap<KEY, VALUE, COMPARATOR>::const_iterator
+FlatMap<KEY, VALUE, COMPARATOR>::end() const
+{
+    return d_impl.end();
+}
+
+                                  // Aspects
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+bslma::Allocator *FlatMap<KEY, VALUE, COMPARATOR>::allocator() const
+{
+    return d_impl.allocator();
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+bool bdlc::operator==(const FlatMap<KEY, VALUE, COMPARATOR>& lhs,
+                      const FlatMap<KEY, VALUE, COMPARATOR>& rhs)
+{
+    return lhs.d_impl == rhs.d_impl;
+}
+
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+bool bdlc::operator!=(const FlatMap<KEY, VALUE, COMPARATOR>& lhs,
+                      const FlatMap<KEY, VALUE, COMPARATOR>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+// FREE FUNCTIONS
+template <class KEY, class VALUE, class COMPARATOR>
+inline
+void bdlc::swap(FlatMap<KEY, VALUE, COMPARATOR>& a,
+                FlatMap<KEY, VALUE, COMPARATOR>& b)
+{
+    if (a.allocator() == b.allocator()) {
+        a.swap(b);
+
+        return;                                                       // RETURN
+    }
+
+    typedef FlatMap<KEY, VALUE, COMPARATOR> Map;
+
+    Map futureA(b, a.allocator());
+    Map futureB(a, b.allocator());
+
+    a.swap(futureA);
+    b.swap(futureB);
+}
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
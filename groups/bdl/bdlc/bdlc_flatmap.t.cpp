@@ -0,0 +1,1069 @@
+// bdlc_flatmap.t.cpp                                                 -*-C++-*-
+#include <bdlc_flatmap.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatormonitor.h>
+
+#include <bslmf_movableref.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_stopwatch.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstddef.h>
+#include <bsl_cstdlib.h>
+#include <bsl_functional.h>
+#include <bsl_iomanip.h>
+#include <bsl_iostream.h>
+#include <bsl_map.h>
+#include <bsl_stdexcept.h>
+#include <bsl_string.h>
+#include <bsl_utility.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                              TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is a value-semantic container whose
+// implementation is provided by 'bdlc::FlatTree', which is tested thoroughly
+// in its own test driver.  This test driver verifies that each method
+// forwards correctly to the implementation, that the 'value_type' objects are
+// constructed using the allocator of the map, and that the map-specific
+// methods ('operator[]', 'at', 'try_emplace') behave as their 'bsl::map'
+// counterparts.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] FlatMap();
+// [ 2] FlatMap(bslma::Allocator *basicAllocator);
+// [ 2] FlatMap(const COMPARATOR& comparator, *ba = 0);
+// [ 3] FlatMap(INPUT_ITERATOR first, INPUT_ITERATOR last, *ba = 0);
+// [ 3] FlatMap(first, last, const COMPARATOR& comparator, *ba = 0);
+// [ 5] FlatMap(const FlatMap& original, *ba = 0);
+// [ 5] FlatMap(MovableRef<FlatMap> original);
+// [ 5] FlatMap(MovableRef<FlatMap> original, *ba);
+// [ 2] ~FlatMap();
+//
+// MANIPULATORS
+// [ 5] FlatMap& operator=(const FlatMap& rhs);
+// [ 5] FlatMap& operator=(MovableRef<FlatMap> rhs);
+// [ 2] VALUE& operator[](const KEY& key);
+// [ 2] VALUE& operator[](MovableRef<KEY> key);
+// [ 2] VALUE& at(const KEY& key);
+// [ 4] void clear();
+// [ 4] pair<iterator, iterator> equal_range(const KEY& key);
+// [ 4] size_t erase(const KEY& key);
+// [ 4] iterator erase(const_iterator position);
+// [ 4] iterator erase(const_iterator first, const_iterator last);
+// [ 4] iterator find(const KEY& key);
+// [ 3] pair<iterator, bool> insert(const value_type& value);
+// [ 3] pair<iterator, bool> insert(MovableRef<value_type> value);
+// [ 3] pair<iterator, bool> insert(INSERT_VALUE_TYPE&& value);
+// [ 3] void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+// [ 4] iterator lower_bound(const KEY& key);
+// [ 4] void reserve(size_t numElements);
+// [ 4] void shrink_to_fit();
+// [ 2] pair<iterator, bool> try_emplace(const KEY& key, ARGS&&... args);
+// [ 2] pair<iterator, bool> try_emplace(MovableRef<KEY> key, ARGS&&...);
+// [ 4] iterator upper_bound(const KEY& key);
+// [ 4] iterator begin();
+// [ 4] iterator end();
+// [ 5] void swap(FlatMap& other);
+//
+// ACCESSORS
+// [ 2] const VALUE& at(const KEY& key) const;
+// [ 4] size_t capacity() const;
+// [ 2] bool contains(const KEY& key) const;
+// [ 2] size_t count(const KEY& key) const;
+// [ 2] bool empty() const;
+// [ 4] pair<const_iterator, const_iterator> equal_range(const KEY&) const;
+// [ 2] const_iterator find(const KEY& key) const;
+// [ 2] COMPARATOR key_comp() const;
+// [ 4] const_iterator lower_bound(const KEY& key) const;
+// [ 2] size_t size() const;
+// [ 4] const_iterator upper_bound(const KEY& key) const;
+// [ 4] const_iterator begin() const;
+// [ 4] const_iterator cbegin() const;
+// [ 4] const_iterator cend() const;
+// [ 4] const_iterator end() const;
+// [ 2] bslma::Allocator *allocator() const;
+//
+// FREE OPERATORS
+// [ 5] bool operator==(const FlatMap& lhs, const FlatMap& rhs);
+// [ 5] bool operator!=(const FlatMap& lhs, const FlatMap& rhs);
+//
+// FREE FUNCTIONS
+// [ 5] void swap(FlatMap& a, FlatMap& b);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST: 'bdlc::FlatMap' vs. 'bsl::map'
+// ----------------------------------------------------------------------------
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlc::FlatMap<int, int>                 IntObj;
+typedef bdlc::FlatMap<bsl::string, bsl::string> Obj;
+
+const char *const LONG_STRING = "a string long enough to require allocation ";
+
+// ============================================================================
+//                          HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+bool matchesOracle(const IntObj& map, const bsl::map<int, int>& oracle)
+    // Return 'true' if the specified 'map' contains exactly the elements of
+    // the specified 'oracle', in the same order, and 'false' otherwise.
+{
+    if (map.size() != oracle.size()) {
+        return false;                                                 // RETURN
+    }
+
+    bsl::map<int, int>::const_iterator jt = oracle.begin();
+    for (IntObj::const_iterator it = map.begin();
+         it != map.end();
+         ++it, ++jt) {
+        if (it->first != jt->first || it->second != jt->second) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+//                          PERFORMANCE TEST SUPPORT
+// ----------------------------------------------------------------------------
+
+namespace {
+namespace u {
+
+template <class MAP>
+struct PerformanceResult {
+    // This 'struct' holds the results, in nanoseconds per operation, of
+    // running the standard performance operations on a 'MAP'.
+
+    // DATA
+    double d_build;        // average time of building from a range
+    double d_findHit;      // average time of finding an existing key
+    double d_findMiss;     // average time of failing to find a key
+    double d_lowerBound;   // average time of 'lower_bound'
+    long   d_checksum;     // value accumulated to defeat optimization
+};
+
+template <class MAP>
+PerformanceResult<MAP> runPerformance(
+                           const bsl::vector<bsl::pair<int, int> >& data,
+                           const bsl::vector<int>&                  hits,
+                           const bsl::vector<int>&                  misses)
+    // Return the times taken by the standard operations on a 'MAP' built from
+    // the specified 'data' while looking up each of the specified 'hits', and
+    // each of the specified 'misses', and then finding the lower bound of
+    // each of 'misses'.  The behavior is undefined unless the keys of 'data'
+    // are unique, 'hits' is a permutation of those keys, 'misses' has the
+    // same length as 'data', and none of 'misses' is a key of 'data'.
+{
+    PerformanceResult<MAP> result;
+    bsls::Stopwatch        timer;
+
+    const double scale = 1.0e9 / static_cast<double>(data.size());
+
+    long checksum = 0;
+
+    timer.start(true);
+    MAP map(data.begin(), data.end());
+    timer.stop();
+    result.d_build = timer.accumulatedWallTime() * scale;
+
+    timer.reset();
+    timer.start(true);
+    for (bsl::size_t i = 0; i < hits.size(); ++i) {
+        checksum += map.find(hits[i])->second;
+    }
+    timer.stop();
+    result.d_findHit = timer.accumulatedWallTime() * scale;
+
+    timer.reset();
+    timer.start(true);
+    for (bsl::size_t i = 0; i < misses.size(); ++i) {
+        checksum += map.end() == map.find(misses[i]);
+    }
+    timer.stop();
+    result.d_findMiss = timer.accumulatedWallTime() * scale;
+
+    timer.reset();
+    timer.start(true);
+    for (bsl::size_t i = 0; i < misses.size(); ++i) {
+        checksum += map.end() == map.lower_bound(misses[i]);
+    }
+    timer.stop();
+    result.d_lowerBound = timer.accumulatedWallTime() * scale;
+
+    result.d_checksum = checksum;
+
+    return result;
+}
+
+}  // close namespace u
+}  // close unnamed namespace
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int  test    = argc > 1 ? atoi(argv[1]) : 0;
+    bool verbose = argc > 2;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Example 1: A Table of Reference Data
+/// - - - - - - - - - - - - - - - - - -
+// Suppose we are writing a service that must translate, many thousands of
+// times per second, an ISO 4217 currency code to the number of digits used
+// after the decimal point for that currency.  The table is loaded once at
+// startup and never modified afterwards, so a sorted array offers faster
+// lookups and a smaller memory footprint than a node-based map.
+//
+// First, we define the (unordered) raw data from which the table is loaded:
+//..
+    struct CurrencyData {
+        const char *d_code;    // ISO 4217 currency code
+        int         d_digits;  // number of minor-unit digits
+    };
+
+    static const CurrencyData DATA[] = {
+        { "USD", 2 },
+        { "JPY", 0 },
+        { "EUR", 2 },
+        { "BHD", 3 },
+        { "GBP", 2 },
+        { "KWD", 3 },
+        { "CLF", 4 },
+    };
+    const bsl::size_t NUM_DATA = sizeof DATA / sizeof *DATA;
+//..
+// Then, we gather the raw data into a sequence of 'value_type' objects:
+//..
+    typedef bdlc::FlatMap<bsl::string, int> CurrencyTable;
+
+    bsl::vector<CurrencyTable::value_type> rawData;
+    for (bsl::size_t i = 0; i < NUM_DATA; ++i) {
+        rawData.push_back(CurrencyTable::value_type(DATA[i].d_code,
+                                                    DATA[i].d_digits));
+    }
+//..
+// Next, we create the table with a single bulk insertion, which sorts the
+// data once rather than inserting each element in turn:
+//..
+    CurrencyTable table(rawData.begin(), rawData.end());
+    ASSERT(NUM_DATA == table.size());
+//..
+// Then, we look up the number of digits for a few currencies:
+//..
+    ASSERT(2 == table.at("USD"));
+    ASSERT(0 == table.at("JPY"));
+    ASSERT(3 == table.find("KWD")->second);
+    ASSERT(table.end() == table.find("XYZ"));
+//..
+// Now, we observe that the elements are held in key order:
+//..
+    ASSERT("BHD" == table.begin()->first);
+    ASSERT("USD" == (table.end() - 1)->first);
+//..
+// Finally, we use 'lower_bound' to find the range of currencies whose codes
+// begin with a given letter:
+//..
+    CurrencyTable::const_iterator first = table.lower_bound("E");
+    CurrencyTable::const_iterator last  = table.lower_bound("F");
+    ASSERT(1     == last - first);
+    ASSERT("EUR" == first->first);
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING VALUE SEMANTICS
+        //   Copy, move, assignment, swap, and equality behave as expected.
+        //
+        // Concerns:
+        //: 1 Copies have the same value as the original and use the supplied
+        //:   (or default) allocator.
+        //:
+        //: 2 A move using the same allocator does not allocate; a move using
+        //:   a different allocator yields elements using the new allocator.
+        //:
+        //: 3 Equality compares both keys and mapped values.
+        //:
+        //: 4 'swap' exchanges values; the free 'swap' supports objects using
+        //:   different allocators.
+        //
+        // Plan:
+        //: 1 Perform each operation using maps of allocating elements and
+        //:   verify the values and memory use.  (C-1..4)
+        //
+        // Testing:
+        //   FlatMap(const FlatMap& original, *ba = 0);
+        //   FlatMap(MovableRef<FlatMap> original);
+        //   FlatMap(MovableRef<FlatMap> original, *ba);
+        //   FlatMap& operator=(const FlatMap& rhs);
+        //   FlatMap& operator=(MovableRef<FlatMap> rhs);
+        //   void swap(FlatMap& other);
+        //   bool operator==(const FlatMap& lhs, const FlatMap& rhs);
+        //   bool operator!=(const FlatMap& lhs, const FlatMap& rhs);
+        //   void swap(FlatMap& a, FlatMap& b);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING VALUE SEMANTICS" << endl
+                          << "=======================" << endl;
+
+        bslma::TestAllocator da("default",   false);
+        bslma::TestAllocator sa1("supplied1", false);
+        bslma::TestAllocator sa2("supplied2", false);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        Obj mX(&sa1);  const Obj& X = mX;
+
+        for (int i = 0; i < 50; ++i) {
+            mX[bsl::string(LONG_STRING, &sa1) + char('A' + i % 26)
+                                              + char('a' + i / 26)] =
+                                       bsl::string(LONG_STRING, &sa1)
+                                                                   + char(i);
+        }
+
+        {
+            Obj mY(X, &sa2);  const Obj& Y = mY;
+
+            ASSERT(X == Y);
+            ASSERT(!(X != Y));
+            ASSERT(&sa2 == Y.allocator());
+            ASSERT(&sa2 == Y.begin()->first.get_allocator().mechanism());
+            ASSERT(&sa2 == Y.begin()->second.get_allocator().mechanism());
+
+            (mY.end() - 1)->second += "x";
+
+            ASSERT(X != Y);
+
+            mY = X;
+
+            ASSERT(X == Y);
+            ASSERT(&sa2 == Y.allocator());
+
+            mY.erase(mY.begin());
+
+            ASSERT(X != Y);
+            ASSERT(X.size() == Y.size() + 1);
+        }
+        {
+            Obj mY(X);  const Obj& Y = mY;
+
+            ASSERT(X == Y);
+            ASSERT(&da == Y.allocator());
+        }
+        {
+            Obj mY(X, &sa1);
+
+            bslma::TestAllocatorMonitor sam(&sa1);
+
+            Obj mZ(bslmf::MovableRefUtil::move(mY));  const Obj& Z = mZ;
+
+            ASSERT(sam.isTotalSame());
+            ASSERT(X == Z);
+            ASSERT(&sa1 == Z.allocator());
+        }
+        {
+            Obj mY(X, &sa1);
+
+            Obj mZ(bslmf::MovableRefUtil::move(mY), &sa2);
+            const Obj& Z = mZ;
+
+            ASSERT(X == Z);
+            ASSERT(&sa2 == Z.allocator());
+            ASSERT(&sa2 == Z.begin()->first.get_allocator().mechanism());
+            ASSERT(&sa2 == Z.begin()->second.get_allocator().mechanism());
+        }
+        {
+            Obj mY(X, &sa2);  const Obj& Y = mY;
+            Obj mZ(&sa1);     const Obj& Z = mZ;
+
+            mZ = bslmf::MovableRefUtil::move(mY);
+
+            ASSERT(X == Z);
+            ASSERT(&sa1 == Z.allocator());
+            ASSERT(&sa1 == Z.begin()->first.get_allocator().mechanism());
+
+            (void)Y;
+        }
+        {
+            Obj mY(X, &sa1);  const Obj& Y = mY;
+            Obj mZ(&sa1);     const Obj& Z = mZ;
+
+            mZ["a"] = "b";
+
+            const Obj W(Z, &sa1);
+
+            mY.swap(mZ);
+
+            ASSERT(W == Y);
+            ASSERT(X == Z);
+
+            Obj mV(X, &sa2);  const Obj& V = mV;
+
+            swap(mV, mY);
+
+            ASSERT(W == V);
+            ASSERT(X == Y);
+            ASSERT(&sa2 == V.allocator());
+            ASSERT(&sa1 == Y.allocator());
+        }
+
+        ASSERT(0 == sa2.numBlocksInUse());
+        ASSERT(0 == da.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING LOOKUP, ITERATION, AND REMOVAL
+        //   The remaining manipulators and accessors forward correctly.
+        //
+        // Concerns:
+        //: 1 Iteration visits each element exactly once in key order, and
+        //:   mapped values are modifiable through an 'iterator'.
+        //:
+        //: 2 'find', 'lower_bound', 'upper_bound', and 'equal_range' locate
+        //:   the expected elements.
+        //:
+        //: 3 Each 'erase' overload removes the expected elements.
+        //:
+        //: 4 'clear', 'reserve', and 'shrink_to_fit' affect the size and
+        //:   capacity as documented.
+        //
+        // Plan:
+        //: 1 Use a 'bsl::map' oracle to verify the contents of a map after
+        //:   each operation.  (C-1..4)
+        //
+        // Testing:
+        //   void clear();
+        //   pair<iterator, iterator> equal_range(const KEY& key);
+        //   size_t erase(const KEY& key);
+        //   iterator erase(const_iterator position);
+        //   iterator erase(const_iterator first, const_iterator last);
+        //   iterator find(const KEY& key);
+        //   iterator lower_bound(const KEY& key);
+        //   void reserve(size_t numElements);
+        //   void shrink_to_fit();
+        //   iterator upper_bound(const KEY& key);
+        //   iterator begin();
+        //   iterator end();
+        //   size_t capacity() const;
+        //   pair<const_iterator, const_iterator> equal_range(const KEY&);
+        //   const_iterator lower_bound(const KEY& key) const;
+        //   const_iterator upper_bound(const KEY& key) const;
+        //   const_iterator begin() const;
+        //   const_iterator cbegin() const;
+        //   const_iterator cend() const;
+        //   const_iterator end() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING LOOKUP, ITERATION, AND REMOVAL" << endl
+                          << "======================================" << endl;
+
+        bslma::TestAllocator sa("supplied", false);
+
+        IntObj mX(&sa);  const IntObj& X = mX;
+
+        bsl::map<int, int> oracle(&sa);
+
+        for (int i = 0; i < 1000; ++i) {
+            mX[i * 3] = i;
+            oracle[i * 3] = i;
+        }
+
+        for (IntObj::iterator it = mX.begin(); it != mX.end(); ++it) {
+            it->second *= 2;
+            oracle[it->first] *= 2;
+        }
+
+        ASSERT(matchesOracle(X, oracle));
+        ASSERT(X.cbegin() == X.begin());
+        ASSERT(X.cend()   == X.end());
+
+        const bsl::map<int, int>& ORACLE = oracle;
+
+        for (int key = -1; key < 3001; ++key) {
+            const bsl::map<int, int>::const_iterator lb =
+                                                       ORACLE.lower_bound(key);
+            const bsl::map<int, int>::const_iterator ub =
+                                                       ORACLE.upper_bound(key);
+
+            const bsl::ptrdiff_t lbIndex = bsl::distance(ORACLE.begin(), lb);
+            const bsl::ptrdiff_t ubIndex = bsl::distance(ORACLE.begin(), ub);
+
+            LOOP_ASSERT(key, lbIndex == X.lower_bound(key) - X.begin());
+            LOOP_ASSERT(key, ubIndex == X.upper_bound(key) - X.begin());
+            LOOP_ASSERT(key, lbIndex == mX.lower_bound(key) - mX.begin());
+            LOOP_ASSERT(key, ubIndex == mX.upper_bound(key) - mX.begin());
+
+            typedef IntObj::const_iterator CIter;
+            typedef IntObj::iterator       Iter;
+
+            const bsl::pair<CIter, CIter> cRange =  X.equal_range(key);
+            const bsl::pair<Iter,  Iter>  mRange = mX.equal_range(key);
+
+            LOOP_ASSERT(key, lbIndex == cRange.first  - X.begin());
+            LOOP_ASSERT(key, ubIndex == cRange.second - X.begin());
+            LOOP_ASSERT(key, lbIndex == mRange.first  - mX.begin());
+            LOOP_ASSERT(key, ubIndex == mRange.second - mX.begin());
+
+            LOOP_ASSERT(key, (lb == ub) == (mX.end() == mX.find(key)));
+        }
+
+        ASSERT(1 == mX.erase(3));
+        ASSERT(0 == mX.erase(4));
+        oracle.erase(3);
+        ASSERT(oracle.size() == X.size());
+
+        {
+            IntObj::iterator it = mX.erase(mX.find(6));
+            ASSERT(9 == it->first);
+            oracle.erase(6);
+        }
+        {
+            IntObj::iterator it = mX.erase(mX.lower_bound(300),
+                                           mX.lower_bound(600));
+            ASSERT(600 == it->first);
+            oracle.erase(oracle.lower_bound(300), oracle.lower_bound(600));
+        }
+        ASSERT(matchesOracle(X, oracle));
+
+        mX.shrink_to_fit();
+        ASSERT(X.size() == X.capacity());
+
+        mX.reserve(2000);
+        ASSERT(2000 <= X.capacity());
+
+        mX.clear();
+        ASSERT(0 == X.size());
+        ASSERT(X.begin() == X.end());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING INSERTION
+        //   The 'insert' methods and range constructors forward correctly.
+        //
+        // Concerns:
+        //: 1 Single insertion of an absent key inserts the value; insertion
+        //:   of a present key leaves the map unchanged, and each returns an
+        //:   iterator to the element having the key.
+        //:
+        //: 2 Values convertible to 'value_type' are inserted using the
+        //:   allocator of the map.
+        //:
+        //: 3 The range constructors and range 'insert' result in the union of
+        //:   the keys, retaining the value of a key that is already present.
+        //:
+        //: 4 A non-default comparator determines the order of the elements.
+        //
+        // Plan:
+        //: 1 Insert values through each method and verify the result against
+        //:   a 'bsl::map' oracle and the allocators in use.  (C-1..4)
+        //
+        // Testing:
+        //   FlatMap(INPUT_ITERATOR first, INPUT_ITERATOR last, *ba = 0);
+        //   FlatMap(first, last, const COMPARATOR& comparator, *ba = 0);
+        //   pair<iterator, bool> insert(const value_type& value);
+        //   pair<iterator, bool> insert(MovableRef<value_type> value);
+        //   pair<iterator, bool> insert(INSERT_VALUE_TYPE&& value);
+        //   void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING INSERTION" << endl
+                          << "=================" << endl;
+
+        bslma::TestAllocator da("default",  false);
+        bslma::TestAllocator sa("supplied", false);
+
+        {
+            IntObj mX(&sa);  const IntObj& X = mX;
+
+            const IntObj::value_type V(5, 50);
+
+            bsl::pair<IntObj::iterator, bool> rv = mX.insert(V);
+            ASSERT(rv.second);
+            ASSERT(5 == rv.first->first && 50 == rv.first->second);
+
+            IntObj::value_type W(5, 51);
+
+            rv = mX.insert(bslmf::MovableRefUtil::move(W));
+            ASSERT(!rv.second);
+            ASSERT(50 == rv.first->second);
+
+            ASSERT(1 == X.size());
+        }
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        {
+            Obj mX(&sa);  const Obj& X = mX;
+
+            bsl::pair<Obj::iterator, bool> rv =
+                    mX.insert(bsl::pair<const char *, const char *>("b", "2"));
+            ASSERT(rv.second);
+            ASSERT("2" == rv.first->second);
+            ASSERT(&sa == rv.first->first.get_allocator().mechanism());
+            ASSERT(&sa == rv.first->second.get_allocator().mechanism());
+
+            rv = mX.insert(bsl::pair<const char *, const char *>("a", "1"));
+            ASSERT(rv.second);
+            ASSERT(X.begin() == rv.first);
+
+            rv = mX.insert(bsl::pair<const char *, const char *>("a", "x"));
+            ASSERT(!rv.second);
+            ASSERT("1" == rv.first->second);
+            ASSERT(2 == X.size());
+        }
+
+        ASSERT(0 == da.numBlocksTotal());
+        ASSERT(0 == sa.numBlocksInUse());
+
+        bsl::vector<IntObj::value_type> data(&sa);
+        for (int i = 0; i < 150; ++i) {
+            data.push_back(IntObj::value_type((i * 37) % 150, i));
+        }
+
+        bsl::map<int, int> oracle(&sa);
+        for (bsl::size_t i = 0; i < data.size(); ++i) {
+            oracle.insert(data[i]);
+        }
+
+        {
+            IntObj mX(data.begin(), data.end(), &sa);  const IntObj& X = mX;
+
+            ASSERT(&sa == X.allocator());
+            ASSERT(oracle.size() == X.size());
+            ASSERT(matchesOracle(X, oracle));
+        }
+        {
+            IntObj mX(&sa);  const IntObj& X = mX;
+
+            for (int i = 0; i < 150; i += 2) {
+                mX[i] = -i;
+            }
+
+            mX.insert(data.begin(), data.end());
+
+            ASSERT(oracle.size() == X.size());
+            for (IntObj::const_iterator it = X.begin(); it != X.end(); ++it) {
+                const int expected = it->first % 2 ? oracle[it->first]
+                                                   : -it->first;
+                LOOP_ASSERT(it->first, expected == it->second);
+            }
+        }
+        {
+            typedef bdlc::FlatMap<int, int, bsl::greater<int> > ReverseObj;
+
+            ReverseObj mX(data.begin(),
+                          data.end(),
+                          bsl::greater<int>(),
+                          &sa);
+            const ReverseObj& X = mX;
+
+            ASSERT(oracle.size() == X.size());
+            ASSERT(149 == X.begin()->first);
+            ASSERT(  0 == (X.end() - 1)->first);
+        }
+
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING PRIMARY MANIPULATORS AND BASIC ACCESSORS
+        //   The constructors, element access, and 'try_emplace' methods
+        //   behave as their 'bsl::map' counterparts.
+        //
+        // Concerns:
+        //: 1 The constructors create an empty map using the intended
+        //:   allocator and comparator.
+        //:
+        //: 2 'operator[]' inserts a default-constructed value for an absent
+        //:   key, and returns a modifiable reference to the value.
+        //:
+        //: 3 'at' returns the value of a present key and throws
+        //:   'bsl::out_of_range' for an absent key.
+        //:
+        //: 4 'try_emplace' constructs the value from the arguments only if the
+        //:   key is absent.
+        //:
+        //: 5 The basic accessors reflect the state of the map.
+        //
+        // Plan:
+        //: 1 Perform each operation and verify the result with the basic
+        //:   accessors.  (C-1..5)
+        //
+        // Testing:
+        //   FlatMap();
+        //   FlatMap(bslma::Allocator *basicAllocator);
+        //   FlatMap(const COMPARATOR& comparator, *ba = 0);
+        //   ~FlatMap();
+        //   VALUE& operator[](const KEY& key);
+        //   VALUE& operator[](MovableRef<KEY> key);
+        //   VALUE& at(const KEY& key);
+        //   pair<iterator, bool> try_emplace(const KEY& key, ARGS&&... args);
+        //   pair<iterator, bool> try_emplace(MovableRef<KEY> key, ARGS&&...);
+        //   const VALUE& at(const KEY& key) const;
+        //   bool contains(const KEY& key) const;
+        //   size_t count(const KEY& key) const;
+        //   bool empty() const;
+        //   const_iterator find(const KEY& key) const;
+        //   COMPARATOR key_comp() const;
+        //   size_t size() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                       << endl
+                       << "TESTING PRIMARY MANIPULATORS AND BASIC ACCESSORS"
+                       << endl
+                       << "================================================"
+                       << endl;
+
+        bslma::TestAllocator da("default",  false);
+        bslma::TestAllocator sa("supplied", false);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        {
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT(&da == X.allocator());
+            ASSERT(X.empty());
+            ASSERT(0 == X.size());
+        }
+        {
+            Obj mX(&sa);  const Obj& X = mX;
+
+            ASSERT(&sa == X.allocator());
+            ASSERT(X.key_comp()("a", "b"));
+        }
+        {
+            typedef bdlc::FlatMap<int, int, bsl::greater<int> > ReverseObj;
+
+            ReverseObj mX(bsl::greater<int>(), &sa);  const ReverseObj& X = mX;
+
+            ASSERT(&sa == X.allocator());
+            ASSERT(X.key_comp()(2, 1));
+        }
+
+        ASSERT(0 == da.numBlocksTotal());
+
+        {
+            Obj mX(&sa);  const Obj& X = mX;
+
+            const bsl::string KEY(LONG_STRING, &sa);
+
+            ASSERT(!X.contains(KEY));
+            ASSERT(0 == X.count(KEY));
+            ASSERT(X.end() == X.find(KEY));
+
+            mX[KEY] = KEY;
+
+            ASSERT(!X.empty());
+            ASSERT(1 == X.size());
+            ASSERT(X.contains(KEY));
+            ASSERT(1 == X.count(KEY));
+            ASSERT(KEY == X.find(KEY)->second);
+            ASSERT(KEY == X.at(KEY));
+            ASSERT(&sa == X.begin()->second.get_allocator().mechanism());
+
+            mX.at(KEY) += "x";
+            ASSERT(KEY + "x" == X.at(KEY));
+
+            bsl::string movedKey(bsl::string(LONG_STRING) + "y", &sa);
+            mX[bslmf::MovableRefUtil::move(movedKey)];
+            ASSERT(2 == X.size());
+            ASSERT(X.at(bsl::string(LONG_STRING) + "y").empty());
+
+            bsl::pair<Obj::iterator, bool> rv = mX.try_emplace(KEY, "z");
+            ASSERT(!rv.second);
+            ASSERT(KEY + "x" == rv.first->second);
+
+            rv = mX.try_emplace("z", "zzz");
+            ASSERT(rv.second);
+            ASSERT("zzz" == rv.first->second);
+            ASSERT(&sa == rv.first->second.get_allocator().mechanism());
+
+            bsl::string movedKey2("w", &sa);
+            rv = mX.try_emplace(bslmf::MovableRefUtil::move(movedKey2));
+            ASSERT(rv.second);
+            ASSERT(4 == X.size());
+
+#if defined(BDE_BUILD_TARGET_EXC)
+            bool caught = false;
+            try {
+                X.at("absent");
+            }
+            catch (const bsl::out_of_range&) {
+                caught = true;
+            }
+            ASSERT(caught);
+
+            caught = false;
+            try {
+                mX.at("absent");
+            }
+            catch (const bsl::out_of_range&) {
+                caught = true;
+            }
+            ASSERT(caught);
+#endif
+        }
+
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an object, insert and find elements, and compare objects.
+        //:   (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        IntObj mX;  const IntObj& X = mX;
+
+        ASSERT(0 == X.size());
+
+        mX[3] = 30;
+        mX[1] = 10;
+
+        ASSERT(2  == X.size());
+        ASSERT(1  == X.begin()->first);
+        ASSERT(30 == X.at(3));
+
+        IntObj mY(X);  const IntObj& Y = mY;
+
+        ASSERT(X == Y);
+
+        ASSERT(1 == mX.erase(1));
+        ASSERT(1 == X.size());
+        ASSERT(X != Y);
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST: 'bdlc::FlatMap' vs. 'bsl::map'
+        //   Compare the average time of building and searching the two
+        //   containers for a range of sizes.
+        //
+        // Concerns:
+        //: 1 'bdlc::FlatMap' outperforms 'bsl::map' for construction from an
+        //:   unordered range, successful lookup, unsuccessful lookup, and
+        //:   'lower_bound'.
+        //
+        // Plan:
+        //: 1 For each size from 1,000 to the size optionally specified as the
+        //:   second command-line argument (by default, 10,000,000), in
+        //:   multiples of 10, time each operation on each container using the
+        //:   same pseudo-random keys, and print the results in nanoseconds
+        //:   per operation.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE TEST: 'bdlc::FlatMap' vs. 'bsl::map'
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE TEST: 'bdlc::FlatMap' vs. 'bsl::map'" << endl
+             << "================================================" << endl;
+
+        const bsl::size_t maxSize = argc > 2
+                                  ? static_cast<bsl::size_t>(atoi(argv[2]))
+                                  : 10000000;
+
+        typedef bsl::map<int, int> Map;
+
+        cout << setw(11) << "size"
+             << setw(22) << "build (ns)"
+             << setw(22) << "find hit (ns)"
+             << setw(22) << "find miss (ns)"
+             << setw(22) << "lower_bound (ns)" << endl
+             << setw(11) << ""
+             << setw(22) << "flat / map"
+             << setw(22) << "flat / map"
+             << setw(22) << "flat / map"
+             << setw(22) << "flat / map" << endl;
+
+        for (bsl::size_t size = 1000; size <= maxSize; size *= 10) {
+            bsl::vector<bsl::pair<int, int> > data(size);
+            bsl::vector<int>                  misses(size);
+
+            // Generate distinct keys by scrambling even integers with an odd
+            // multiplier (a bijection), and misses from odd integers.
+
+            for (bsl::size_t i = 0; i < size; ++i) {
+                data[i].first  = static_cast<int>(
+                                       static_cast<unsigned int>(2 * i)
+                                                              * 2654435761u);
+                data[i].second = static_cast<int>(i);
+                misses[i]      = static_cast<int>(
+                                       static_cast<unsigned int>(2 * i + 1)
+                                                              * 2654435761u);
+            }
+
+            // Shuffle the keys to obtain the order of the lookups.
+
+            bsl::vector<int> hits(size);
+            for (bsl::size_t i = 0; i < size; ++i) {
+                hits[i] = data[i].first;
+            }
+
+            unsigned int seed = 1;
+            for (bsl::size_t i = size - 1; i > 0; --i) {
+                seed = seed * 1103515245 + 12345;
+                bsl::swap(hits[i], hits[seed % (i + 1)]);
+            }
+
+            const u::PerformanceResult<IntObj> flat =
+                                 u::runPerformance<IntObj>(data, hits, misses);
+            const u::PerformanceResult<Map>    node =
+                                    u::runPerformance<Map>(data, hits, misses);
+
+            ASSERT(flat.d_checksum == node.d_checksum);
+
+            cout << fixed << setprecision(1)
+                 << setw(11) << size
+                 << setw(11) << flat.d_build    << setw(11) << node.d_build
+                 << setw(11) << flat.d_findHit  << setw(11) << node.d_findHit
+                 << setw(11) << flat.d_findMiss << setw(11) << node.d_findMiss
+                 << setw(11) << flat.d_lowerBound
+                 << setw(11) << node.d_lowerBound
+                 << endl;
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
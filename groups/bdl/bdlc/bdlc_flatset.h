@@ -0,0 +1,787 @@
+// bdlc_flatset.h                                                     -*-C++-*-
+
+#ifndef INCLUDED_BDLC_FLATSET
+#define INCLUDED_BDLC_FLATSET
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an ordered set container held in a sorted vector.
+//
+//@CLASSES:
+//  bdlc::FlatSet: ordered set container held in a sorted vector
+//
+//@SEE_ALSO: bdlc_flattree, bdlc_flatmap, bslstl_set
+//
+//@DESCRIPTION: This component defines a single class template,
+// 'bdlc::FlatSet', that implements an ordered set of unique keys, stored in
+// key order in a single contiguous array.
+//
+// The ordered set provided by this component, 'bdlc::FlatSet', differs from
+// 'bsl::set' in that its elements are stored in a sorted vector (see
+// 'bdlc_flattree') rather than in individually allocated nodes of a red-black
+// tree.  Consequently, a lookup is a binary search over contiguous memory
+// (implemented without data-dependent branches), and iteration is a linear
+// scan, but inserting or erasing a single element is linear in the number of
+// elements that follow it.  To build a set from many elements, use the range
+// constructor or the range form of 'insert', which sort the new elements once
+// and merge them into the set.
+//
+// As for 'bdlc::FlatMap', any insertion or erasure invalidates the iterators,
+// pointers, and references to the elements at or after the point of
+// insertion or erasure, and, if the capacity of the set changes, to all
+// elements.
+//
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: Checking Identifiers Against a Watch List
+/// - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose a trading system must check the identifier of every incoming order
+// against a watch list of restricted securities that is published once per
+// day.  The watch list is built in bulk and then searched very frequently, so
+// we hold it in a 'bdlc::FlatSet'.
+//
+// First, we build the watch list from the (unsorted, and possibly repetitive)
+// published identifiers with a single bulk insertion:
+//..
+//  const int published[] = { 31337, 4096, 271828, 4096, 1618, 141421 };
+//  const int numPublished = sizeof published / sizeof *published;
+//
+//  bdlc::FlatSet<int> watchList(published, published + numPublished);
+//  assert(5 == watchList.size());
+//..
+// Then, we check a few order identifiers against the watch list:
+//..
+//  assert( watchList.contains(4096));
+//  assert(!watchList.contains(4097));
+//..
+// Next, a late addendum to the watch list is merged in, again in bulk:
+//..
+//  const int addendum[] = { 99, 1618, 500000 };
+//
+//  watchList.insert(addendum, addendum + sizeof addendum / sizeof *addendum);
+//  assert(7 == watchList.size());
+//..
+// Finally, we observe that the watch list is held in sorted order:
+//..
+//  assert(    99 == *watchList.begin());
+//  assert(500000 == *(watchList.end() - 1));
+//  assert(  1618 == *watchList.upper_bound(99));
+//..
+
+#include <bdlscm_version.h>
+
+#include <bdlc_flattree.h>
+
+#include <bslma_allocator.h>
+#include <bslma_constructionutil.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_movableref.h>
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bsls_assert.h>
+#include <bsls_compilerfeatures.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_functional.h>
+#include <bsl_utility.h>
+
+namespace BloombergLP {
+namespace bdlc {
+
+                           // ========================
+                           // struct FlatSet_EntryUtil
+                           // ========================
+
+template <class ENTRY>
+struct FlatSet_EntryUtil {
+    // This templated utility provides methods to construct an 'ENTRY' and a
+    // method to extract the key from an 'ENTRY', as required by 'FlatTree'.
+    // For a set, the entry is the key.
+
+    // CLASS METHODS
+    template <class KEY_TYPE>
+    static void construct(
+                        ENTRY                                       *entry,
+                        bslma::Allocator                            *allocator,
+                        BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE)  key);
+        // Load into the specified 'entry' the 'ENTRY' value constructed from
+        // the specified 'key', using the specified 'allocator' to supply
+        // memory.
+
+    static const ENTRY& key(const ENTRY& entry);
+        // Return the specified 'entry'.
+};
+
+                               // =============
+                               // class FlatSet
+                               // =============
+
+template <class KEY, class COMPARATOR = bsl::less<KEY> >
+class FlatSet {
+    // This class template implements a value-semantic container type holding
+    // an ordered set of unique values, stored in a sorted vector.  See the
+    // component-level documentation for details.
+
+    // PRIVATE TYPES
+    typedef FlatTree<KEY, KEY, FlatSet_EntryUtil<KEY>, COMPARATOR> ImplType;
+        // This is the underlying implementation class.
+
+    // FRIENDS
+    template <class K, class C>
+    friend bool operator==(const FlatSet<K, C>&, const FlatSet<K, C>&);
+
+  public:
+    // TYPES
+    typedef KEY                                      key_type;
+    typedef KEY                                      value_type;
+    typedef bsl::size_t                              size_type;
+    typedef bsl::ptrdiff_t                           difference_type;
+    typedef COMPARATOR                               key_compare;
+    typedef COMPARATOR                               value_compare;
+    typedef value_type&                              reference;
+    typedef const value_type&                        const_reference;
+    typedef value_type                              *pointer;
+    typedef const value_type                        *const_pointer;
+    typedef typename ImplType::const_iterator        iterator;
+    typedef typename ImplType::const_iterator        const_iterator;
+
+  private:
+    // DATA
+    ImplType d_impl;  // underlying flat tree used by this flat set
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(FlatSet, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    FlatSet();
+    explicit FlatSet(bslma::Allocator *basicAllocator);
+    explicit FlatSet(const COMPARATOR&  comparator,
+                     bslma::Allocator  *basicAllocator = 0);
+        // Create an empty 'FlatSet' object.  Optionally specify a
+        // 'comparator' used to order the elements in this container.  If
+        // 'comparator' is not supplied, a default-constructed object of the
+        // (template parameter) type 'COMPARATOR' is used.  Optionally specify
+        // a 'basicAllocator' used to supply memory.  If 'basicAllocator' is
+        // not supplied or is 0, the currently installed default allocator is
+        // used.  Note that no memory is allocated.
+
+    template <class INPUT_ITERATOR>
+    FlatSet(INPUT_ITERATOR    first,
+            INPUT_ITERATOR    last,
+            bslma::Allocator *basicAllocator = 0);
+    template <class INPUT_ITERATOR>
+    FlatSet(INPUT_ITERATOR     first,
+            INPUT_ITERATOR     last,
+            const COMPARATOR&  comparator,
+            bslma::Allocator  *basicAllocator = 0);
+        // Create a 'FlatSet' object initialized by insertion of the values
+        // from the input iterator range specified by 'first' through 'last'
+        // (including 'first', excluding 'last'), using a single sort followed
+        // by a single merge.  Optionally specify a 'comparator' (see above).
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is not supplied or is 0, the currently installed
+        // default allocator is used.  The behavior is undefined unless 'first'
+        // and 'last' refer to a sequence of valid values where 'first' is at a
+        // position at or before 'last'.
+
+    FlatSet(const FlatSet& original, bslma::Allocator *basicAllocator = 0);
+        // Create a 'FlatSet' object having the same value and comparator as
+        // the specified 'original' object.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is not
+        // specified or is 0, the currently installed default allocator is
+        // used.
+
+    FlatSet(bslmf::MovableRef<FlatSet> original);
+        // Create a 'FlatSet' object having the same value, comparator, and
+        // allocator as the specified 'original' object.  The contents of
+        // 'original' are moved (in constant time) to this object, 'original'
+        // is left in a (valid) unspecified state, and no exceptions will be
+        // thrown.
+
+    FlatSet(bslmf::MovableRef<FlatSet>  original,
+            bslma::Allocator           *basicAllocator);
+        // Create a 'FlatSet' object having the same value and comparator as
+        // the specified 'original' object, using the specified
+        // 'basicAllocator' to supply memory.  If 'basicAllocator' is 0, the
+        // currently installed default allocator is used.  If 'original' and
+        // the newly created object have the same allocator then the contents
+        // of 'original' are moved (in constant time) to this object;
+        // otherwise, the elements of 'original' are move-inserted.
+        // 'original' is left in a (valid) unspecified state.
+
+    //! ~FlatSet() = default;
+        // Destroy this object and each of its elements.
+
+    // MANIPULATORS
+    FlatSet& operator=(const FlatSet& rhs);
+        // Assign to this object the value and comparator of the specified
+        // 'rhs' object, and return a reference providing modifiable access to
+        // this object.
+
+    FlatSet& operator=(bslmf::MovableRef<FlatSet> rhs);
+        // Assign to this object the value and comparator of the specified
+        // 'rhs' object, and return a reference providing modifiable access to
+        // this object.  If this object and 'rhs' use the same allocator the
+        // contents of 'rhs' are moved (in constant time) to this object.
+        // 'rhs' is left in a (valid) unspecified state.
+
+    void clear();
+        // Remove all elements from this set.  Note that this set will be empty
+        // after calling this method, but allocated memory may be retained for
+        // future use.  See the 'capacity' method.
+
+    bsl::size_t erase(const KEY& key);
+        // Remove from this set the element equal to the specified 'key', if it
+        // exists, and return 1; otherwise (there is no element equal to 'key'
+        // in this set), return 0 with no other effect.
+
+    iterator erase(const_iterator position);
+        // Remove from this set the element at the specified 'position', and
+        // return an iterator referring to the element immediately following
+        // the removed element, or to the past-the-end position if the removed
+        // element was the last element in the sequence of elements maintained
+        // by this set.  The behavior is undefined unless 'position' refers to
+        // an element in this set.
+
+    iterator erase(const_iterator first, const_iterator last);
+        // Remove from this set the elements starting at the specified 'first'
+        // position up to, but not including, the specified 'last' position,
+        // and return an iterator referring to the element that followed the
+        // removed elements.  The behavior is undefined unless 'first' and
+        // 'last' either refer to elements in this set or are the 'end'
+        // iterator, and the 'first' position is at or before the 'last'
+        // position.
+
+    template <class KEY_TYPE>
+    bsl::pair<iterator, bool> insert(
+                           BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE) value);
+        // Insert the specified 'value' into this set if an element equal to
+        // 'value' does not already exist in this set; otherwise, this method
+        // has no effect.  Return a 'pair' whose 'first' member is an iterator
+        // referring to the (possibly newly inserted) element in this set equal
+        // to 'value', and whose 'second' member is 'true' if a new element was
+        // inserted, and 'false' otherwise.  The behavior is undefined unless
+        // 'KEY_TYPE' is 'KEY' or a type convertible to 'KEY'.
+
+    template <class INPUT_ITERATOR>
+    void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        // Insert into this set the value of each element in the range starting
+        // at the specified 'first' iterator and ending immediately before the
+        // specified 'last' iterator, if an equal element does not already
+        // exist in this set, using a single sort of the new elements followed
+        // by a single merge.  The behavior is undefined unless 'first' and
+        // 'last' refer to a sequence of valid values where 'first' is at a
+        // position at or before 'last'.
+
+    void reserve(bsl::size_t numElements);
+        // Change the capacity of this set, if necessary, so that it can hold
+        // at least the specified 'numElements' without reallocating.
+
+    void shrink_to_fit();
+        // Reduce the capacity of this set, if possible, to 'size()'.
+
+                                  // Aspects
+
+    void swap(FlatSet& other);
+        // Exchange the value of this object as well as its comparator with
+        // those of the specified 'other' object.  This method provides the
+        // no-throw exception-safety guarantee if 'COMPARATOR' has a no-throw
+        // swap operation.  The behavior is undefined unless this object was
+        // created with the same allocator as 'other'.
+
+    // ACCESSORS
+    bsl::size_t capacity() const;
+        // Return the number of elements this set can hold without
+        // reallocating.
+
+    bool contains(const KEY& key) const;
+        // Return 'true' if this set contains an element equal to the specified
+        // 'key', and 'false' otherwise.
+
+    bsl::size_t count(const KEY& key) const;
+        // Return the number of elements in this set equal to the specified
+        // 'key'.  Note that since a flat set maintains unique keys, the
+        // returned value will be either 0 or 1.
+
+    bool empty() const;
+        // Return 'true' if this set contains no elements, and 'false'
+        // otherwise.
+
+    bsl::pair<const_iterator, const_iterator> equal_range(
+                                                         const KEY& key) const;
+        // Return a pair of 'const_iterator's defining the sequence of elements
+        // in this set equal to the specified 'key', where the first iterator
+        // is positioned at the start of the sequence and the second iterator
+        // is positioned one past the end of the sequence.  If this set
+        // contains no elements equal to 'key', then the two returned iterators
+        // will have the same value.
+
+    const_iterator find(const KEY& key) const;
+        // Return a 'const_iterator' referring to the element in this set equal
+        // to the specified 'key', or 'end()' if no such element exists in this
+        // set.
+
+    COMPARATOR key_comp() const;
+        // Return (a copy of) the ordering functor used by this set.
+
+    const_iterator lower_bound(const KEY& key) const;
+        // Return a 'const_iterator' referring to the first element in this set
+        // that is not ordered before the specified 'key', or 'end()' if no
+        // such element exists.
+
+    bsl::size_t size() const;
+        // Return the number of elements in this set.
+
+    const_iterator upper_bound(const KEY& key) const;
+        // Return a 'const_iterator' referring to the first element in this set
+        // that is ordered after the specified 'key', or 'end()' if no such
+        // element exists.
+
+    COMPARATOR value_comp() const;
+        // Return (a copy of) the ordering functor used by this set.
+
+    const_iterator begin() const;
+        // Return a 'const_iterator' to the first element in the sequence of
+        // elements maintained by this set, or the 'end' iterator if this set
+        // is empty.
+
+    const_iterator cbegin() const;
+        // Return a 'const_iterator' to the first element in the sequence of
+        // elements maintained by this set, or the 'end' iterator if this set
+        // is empty.
+
+    const_iterator cend() const;
+        // Return a 'const_iterator' to the past-the-end element in the
+        // sequence of elements maintained by this set.
+
+    const_iterator end() const;
+        // Return a 'const_iterator' to the past-the-end element in the
+        // sequence of elements maintained by this set.
+
+                                  // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this flat set to supply memory.
+};
+
+// FREE OPERATORS
+template <class KEY, class COMPARATOR>
+bool operator==(const FlatSet<KEY, COMPARATOR>& lhs,
+                const FlatSet<KEY, COMPARATOR>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects have the same
+    // value, and 'false' otherwise.  Two 'FlatSet' objects have the same value
+    // if their sizes are the same and each element contained in one is equal
+    // to the element at the same position in the other.  The comparators are
+    // not involved in the comparison.
+
+template <class KEY, class COMPARATOR>
+bool operator!=(const FlatSet<KEY, COMPARATOR>& lhs,
+                const FlatSet<KEY, COMPARATOR>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects do not have the
+    // same value, and 'false' otherwise.  Two 'FlatSet' objects do not have
+    // the same value if their sizes are different or some element contained
+    // in one is not equal to the element at the same position in the other.
+    // The comparators are not involved in the comparison.
+
+// FREE FUNCTIONS
+template <class KEY, class COMPARATOR>
+void swap(FlatSet<KEY, COMPARATOR>& a, FlatSet<KEY, COMPARATOR>& b);
+    // Exchange the value and the comparator of the specified 'a' and 'b'
+    // objects.  This function provides the no-throw exception-safety guarantee
+    // if the two objects were created with the same allocator and the basic
+    // guarantee otherwise.
+
+// ============================================================================
+//                           INLINE DEFINITIONS
+// ============================================================================
+
+                           // ------------------------
+                           // struct FlatSet_EntryUtil
+                           // ------------------------
+
+// CLASS METHODS
+template <class ENTRY>
+template <class KEY_TYPE>
+inline
+void FlatSet_EntryUtil<ENTRY>::construct(
+                        ENTRY                                       *entry,
+                        bslma::Allocator                            *allocator,
+                        BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE)  key)
+{
+    BSLS_ASSERT_SAFE(entry);
+
+    bslma::ConstructionUtil::construct(
+                                 entry,
+                                 allocator,
+                                 BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, key));
+}
+
+template <class ENTRY>
+inline
+const ENTRY& FlatSet_EntryUtil<ENTRY>::key(const ENTRY& entry)
+{
+    return entry;
+}
+
+                               // -------------
+                               // class FlatSet
+                               // -------------
+
+// CREATORS
+template <class KEY, class COMPARATOR>
+inline
+FlatSet<KEY, COMPARATOR>::FlatSet()
+: d_impl(COMPARATOR())
+{
+}
+
+template <class KEY, class COMPARATOR>
+inline
+FlatSet<KEY, COMPARATOR>::FlatSet(bslma::Allocator *basicAllocator)
+: d_impl(COMPARATOR(), basicAllocator)
+{
+}
+
+template <class KEY, class COMPARATOR>
+inline
+FlatSet<KEY, COMPARATOR>::FlatSet(const COMPARATOR&  comparator,
+                                  bslma::Allocator  *basicAllocator)
+: d_impl(comparator, basicAllocator)
+{
+}
+
+template <class KEY, class COMPARATOR>
+template <class INPUT_ITERATOR>
+inline
+FlatSet<KEY, COMPARATOR>::FlatSet(INPUT_ITERATOR    first,
+                                  INPUT_ITERATOR    last,
+                                  bslma::Allocator *basicAllocator)
+: d_impl(COMPARATOR(), basicAllocator)
+{
+    d_impl.insert(first, last);
+}
+
+template <class KEY, class COMPARATOR>
+template <class INPUT_ITERATOR>
+inline
+FlatSet<KEY, COMPARATOR>::FlatSet(INPUT_ITERATOR     first,
+                                  INPUT_ITERATOR     last,
+                                  const COMPARATOR&  comparator,
+                                  bslma::Allocator  *basicAllocator)
+: d_impl(comparator, basicAllocator)
+{
+    d_impl.insert(first, last);
+}
+
+template <class KEY, class COMPARATOR>
+inline
+FlatSet<KEY, COMPARATOR>::FlatSet(const FlatSet&    original,
+                                  bslma::Allocator *basicAllocator)
+: d_impl(original.d_impl, basicAllocator)
+{
+}
+
+template <class KEY, class COMPARATOR>
+inline
+FlatSet<KEY, COMPARATOR>::FlatSet(bslmf::MovableRef<FlatSet> original)
+: d_impl(bslmf::MovableRefUtil::move(
+                               bslmf::MovableRefUtil::access(original).d_impl))
+{
+}
+
+template <class KEY, class COMPARATOR>
+inline
+FlatSet<KEY, COMPARATOR>::FlatSet(bslmf::MovableRef<FlatSet>  original,
+                                  bslma::Allocator           *basicAllocator)
+: d_impl(bslmf::MovableRefUtil::move(
+                              bslmf::MovableRefUtil::access(original).d_impl),
+         basicAllocator)
+{
+}
+
+// MANIPULATORS
+template <class KEY, class COMPARATOR>
+inline
+FlatSet<KEY, COMPARATOR>& FlatSet<KEY, COMPARATOR>::operator=(
+                                                            const FlatSet& rhs)
+{
+    d_impl = rhs.d_impl;
+
+    return *this;
+}
+
+template <class KEY, class COMPARATOR>
+inline
+FlatSet<KEY, COMPARATOR>& FlatSet<KEY, COMPARATOR>::operator=(
+                                                bslmf::MovableRef<FlatSet> rhs)
+{
+    FlatSet& lvalue = rhs;
+
+    d_impl = bslmf::MovableRefUtil::move(lvalue.d_impl);
+
+    return *this;
+}
+
+template <class KEY, class COMPARATOR>
+inline
+void FlatSet<KEY, COMPARATOR>::clear()
+{
+    d_impl.clear();
+}
+
+template <class KEY, class COMPARATOR>
+inline
+bsl::size_t FlatSet<KEY, COMPARATOR>::erase(const KEY& key)
+{
+    return d_impl.erase(key);
+}
+
+template <class KEY, class COMPARATOR>
+inline
+typename FlatSet<KEY, COMPARATOR>::iterator
+FlatSet<KEY, COMPARATOR>::erase(const_iterator position)
+{
+    BSLS_ASSERT_SAFE(position != end());
+
+    return d_impl.erase(position);
+}
+
+template <class KEY, class COMPARATOR>
+inline
+typename FlatSet<KEY, COMPARATOR>::iterator
+FlatSet<KEY, COMPARATOR>::erase(const_iterator first, const_iterator last)
+{
+    return d_impl.erase(first, last);
+}
+
+template <class KEY, class COMPARATOR>
+template <class KEY_TYPE>
+inline
+bsl::pair<typename FlatSet<KEY, COMPARATOR>::iterator, bool>
+FlatSet<KEY, COMPARATOR>::insert(
+                             BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE) value)
+{
+    return d_impl.tryEmplace(BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, value));
+}
+
+template <class KEY, class COMPARATOR>
+template <class INPUT_ITERATOR>
+inline
+void FlatSet<KEY, COMPARATOR>::insert(INPUT_ITERATOR first,
+                                      INPUT_ITERATOR last)
+{
+    d_impl.insert(first, last);
+}
+
+template <class KEY, class COMPARATOR>
+inline
+void FlatSet<KEY, COMPARATOR>::reserve(bsl::size_t numElements)
+{
+    d_impl.reserve(numElements);
+}
+
+template <class KEY, class COMPARATOR>
+inline
+void FlatSet<KEY, COMPARATOR>::shrink_to_fit()
+{
+    d_impl.shrink_to_fit();
+}
+
+                                  // Aspects
+
+template <class KEY, class COMPARATOR>
+inline
+void FlatSet<KEY, COMPARATOR>::swap(FlatSet& other)
+{
+    BSLS_ASSERT_SAFE(allocator() == other.allocator());
+
+    d_impl.swap(other.d_impl);
+}
+
+// ACCESSORS
+template <class KEY, class COMPARATOR>
+inline
+bsl::size_t FlatSet<KEY, COMPARATOR>::capacity() const
+{
+    return d_impl.capacity();
+}
+
+template <class KEY, class COMPARATOR>
+inline
+bool FlatSet<KEY, COMPARATOR>::contains(const KEY& key) const
+{
+    return d_impl.contains(key);
+}
+
+template <class KEY, class COMPARATOR>
+inline
+bsl::size_t FlatSet<KEY, COMPARATOR>::count(const KEY& key) const
+{
+    return d_impl.count(key);
+}
+
+template <class KEY, class COMPARATOR>
+inline
+bool FlatSet<KEY, COMPARATOR>::empty() const
+{
+    return d_impl.empty();
+}
+
+template <class KEY, class COMPARATOR>
+inline
+bsl::pair<typename FlatSet<KEY, COMPARATOR>::const_iterator,
+          typename FlatSet<KEY, COMPARATOR>::const_iterator>
+FlatSet<KEY, COMPARATOR>::equal_range(const KEY& key) const
+{
+    return d_impl.equal_range(key);
+}
+
+template <class KEY, class COMPARATOR>
+inline
+typename FlatSet<KEY, COMPARATOR>::const_iterator
+FlatSet<KEY, COMPARATOR>::find(const KEY& key) const
+{
+    return d_impl.find(key);
+}
+
+template <class KEY, class COMPARATOR>
+inline
+COMPARATOR FlatSet<KEY, COMPARATOR>::key_comp() const
+{
+    return d_impl.key_comp();
+}
+
+template <class KEY, class COMPARATOR>
+inline
+typename FlatSet<KEY, COMPARATOR>::const_iterator
+FlatSet<KEY, COMPARATOR>::lower_bound(const KEY& key) const
+{
+    return d_impl.lower_bound(key);
+}
+
+template <class KEY, class COMPARATOR>
+inline
+bsl::size_t FlatSet<KEY, COMPARATOR>::size() const
+{
+    return d_impl.size();
+}
+
+template <class KEY, class COMPARATOR>
+inline
+typename FlatSet<KEY, COMPARATOR>::const_iterator
+FlatSet<KEY, COMPARATOR>::upper_bound(const KEY& key) const
+{
+    return d_impl.upper_bound(key);
+}
+
+template <class KEY, class COMPARATOR>
+inline
+COMPARATOR FlatSet<KEY, COMPARATOR>::value_comp() const
+{
+    return d_impl.key_comp();
+}
+
+template <class KEY, class COMPARATOR>
+inline
+typename FlatSet<KEY, COMPARATOR>::const_iterator
+FlatSet<KEY, COMPARATOR>::begin() const
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class COMPARATOR>
+inline
+typename FlatSet<KEY, COMPARATOR>::const_iterator
+FlatSet<KEY, COMPARATOR>::cbegin() const
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class COMPARATOR>
+inline
+typename FlatSet<KEY, COMPARATOR>::const_iterator
+FlatSet<KEY, COMPARATOR>::cend() const
+{
+    return d_impl.end();
+}
+
+template <class KEY, class COMPARATOR>
+inline
+typename FlatSet<KEY, COMPARATOR>::const_iterator
+FlatSet<KEY, COMPARATOR>::end() const
+{
+    return d_impl.end();
+}
+
+                                  // Aspects
+
+template <class KEY, class COMPARATOR>
+inline
+bslma::Allocator *FlatSet<KEY, COMPARATOR>::allocator() const
+{
+    return d_impl.allocator();
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+template <class KEY, class COMPARATOR>
+inline
+bool bdlc::operator==(const FlatSet<KEY, COMPARATOR>& lhs,
+                      const FlatSet<KEY, COMPARATOR>& rhs)
+{
+    return lhs.d_impl == rhs.d_impl;
+}
+
+template <class KEY, class COMPARATOR>
+inline
+bool bdlc::operator!=(const FlatSet<KEY, COMPARATOR>& lhs,
+                      const FlatSet<KEY, COMPARATOR>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+// FREE FUNCTIONS
+template <class KEY, class COMPARATOR>
+inline
+void bdlc::swap(FlatSet<KEY, COMPARATOR>& a, FlatSet<KEY, COMPARATOR>& b)
+{
+    if (a.allocator() == b.allocator()) {
+        a.swap(b);
+
+        return;                                                       // RETURN
+    }
+
+    typedef FlatSet<KEY, COMPARATOR> Set;
+
+    Set futureA(b, a.allocator());
+    Set futureB(a, b.allocator());
+
+    a.swap(futureA);
+    b.swap(futureB);
+}
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,688 @@
+// bdlc_flatset.t.cpp                                                 -*-C++-*-
+#include <bdlc_flatset.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatormonitor.h>
+
+#include <bslmf_movableref.h>
+
+#include <bsls_asserttest.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstddef.h>
+#include <bsl_cstdlib.h>
+#include <bsl_functional.h>
+#include <bsl_iostream.h>
+#include <bsl_set.h>
+#include <bsl_string.h>
+#include <bsl_utility.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                              TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is a value-semantic container whose
+// implementation is provided by 'bdlc::FlatTree', which is tested thoroughly
+// in its own test driver.  This test driver verifies that each method
+// forwards correctly to the implementation, and that the elements are
+// constructed using the allocator of the set.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] FlatSet();
+// [ 2] FlatSet(bslma::Allocator *basicAllocator);
+// [ 2] FlatSet(const COMPARATOR& comparator, *ba = 0);
+// [ 3] FlatSet(INPUT_ITERATOR first, INPUT_ITERATOR last, *ba = 0);
+// [ 3] FlatSet(first, last, const COMPARATOR& comparator, *ba = 0);
+// [ 4] FlatSet(const FlatSet& original, *ba = 0);
+// [ 4] FlatSet(MovableRef<FlatSet> original);
+// [ 4] FlatSet(MovableRef<FlatSet> original, *ba);
+// [ 2] ~FlatSet();
+//
+// MANIPULATORS
+// [ 4] FlatSet& operator=(const FlatSet& rhs);
+// [ 4] FlatSet& operator=(MovableRef<FlatSet> rhs);
+// [ 3] void clear();
+// [ 3] size_t erase(const KEY& key);
+// [ 3] iterator erase(const_iterator position);
+// [ 3] iterator erase(const_iterator first, const_iterator last);
+// [ 2] pair<iterator, bool> insert(KEY_TYPE&& value);
+// [ 3] void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+// [ 3] void reserve(size_t numElements);
+// [ 3] void shrink_to_fit();
+// [ 4] void swap(FlatSet& other);
+//
+// ACCESSORS
+// [ 3] size_t capacity() const;
+// [ 2] bool contains(const KEY& key) const;
+// [ 2] size_t count(const KEY& key) const;
+// [ 2] bool empty() const;
+// [ 3] pair<const_iterator, const_iterator> equal_range(const KEY&) const;
+// [ 2] const_iterator find(const KEY& key) const;
+// [ 2] COMPARATOR key_comp() const;
+// [ 3] const_iterator lower_bound(const KEY& key) const;
+// [ 2] size_t size() const;
+// [ 3] const_iterator upper_bound(const KEY& key) const;
+// [ 2] COMPARATOR value_comp() const;
+// [ 3] const_iterator begin() const;
+// [ 3] const_iterator cbegin() const;
+// [ 3] const_iterator cend() const;
+// [ 3] const_iterator end() const;
+// [ 2] bslma::Allocator *allocator() const;
+//
+// FREE OPERATORS
+// [ 4] bool operator==(const FlatSet& lhs, const FlatSet& rhs);
+// [ 4] bool operator!=(const FlatSet& lhs, const FlatSet& rhs);
+//
+// FREE FUNCTIONS
+// [ 4] void swap(FlatSet& a, FlatSet& b);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlc::FlatSet<int>         IntObj;
+typedef bdlc::FlatSet<bsl::string> Obj;
+
+const char *const LONG_STRING = "a string long enough to require allocation ";
+
+// ============================================================================
+//                          HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+bool matchesOracle(const IntObj& set, const bsl::set<int>& oracle)
+    // Return 'true' if the specified 'set' contains exactly the elements of
+    // the specified 'oracle', in the same order, and 'false' otherwise.
+{
+    return set.size() == oracle.size()
+        && bsl::equal(oracle.begin(), oracle.end(), set.begin());
+}
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int  test    = argc > 1 ? atoi(argv[1]) : 0;
+    bool verbose = argc > 2;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Example 1: Checking Identifiers Against a Watch List
+/// - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose a trading system must check the identifier of every incoming order
+// against a watch list of restricted securities that is published once per
+// day.  The watch list is built in bulk and then searched very frequently, so
+// we hold it in a 'bdlc::FlatSet'.
+//
+// First, we build the watch list from the (unsorted, and possibly repetitive)
+// published identifiers with a single bulk insertion:
+//..
+    const int published[] = { 31337, 4096, 271828, 4096, 1618, 141421 };
+    const int numPublished = sizeof published / sizeof *published;
+
+    bdlc::FlatSet<int> watchList(published, published + numPublished);
+    ASSERT(5 == watchList.size());
+//..
+// Then, we check a few order identifiers against the watch list:
+//..
+    ASSERT( watchList.contains(4096));
+    ASSERT(!watchList.contains(4097));
+//..
+// Next, a late addendum to the watch list is merged in, again in bulk:
+//..
+    const int addendum[] = { 99, 1618, 500000 };
+
+    watchList.insert(addendum, addendum + sizeof addendum / sizeof *addendum);
+    ASSERT(7 == watchList.size());
+//..
+// Finally, we observe that the watch list is held in sorted order:
+//..
+    ASSERT(    99 == *watchList.begin());
+    ASSERT(500000 == *(watchList.end() - 1));
+    ASSERT(  1618 == *watchList.upper_bound(99));
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING VALUE SEMANTICS
+        //   Copy, move, assignment, swap, and equality behave as expected.
+        //
+        // Concerns:
+        //: 1 Copies have the same value as the original and use the supplied
+        //:   (or default) allocator.
+        //:
+        //: 2 A move using the same allocator does not allocate; a move using
+        //:   a different allocator yields elements using the new allocator.
+        //:
+        //: 3 'swap' exchanges values; the free 'swap' supports objects using
+        //:   different allocators.
+        //
+        // Plan:
+        //: 1 Perform each operation using sets of allocating elements and
+        //:   verify the values and memory use.  (C-1..3)
+        //
+        // Testing:
+        //   FlatSet(const FlatSet& original, *ba = 0);
+        //   FlatSet(MovableRef<FlatSet> original);
+        //   FlatSet(MovableRef<FlatSet> original, *ba);
+        //   FlatSet& operator=(const FlatSet& rhs);
+        //   FlatSet& operator=(MovableRef<FlatSet> rhs);
+        //   void swap(FlatSet& other);
+        //   bool operator==(const FlatSet& lhs, const FlatSet& rhs);
+        //   bool operator!=(const FlatSet& lhs, const FlatSet& rhs);
+        //   void swap(FlatSet& a, FlatSet& b);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING VALUE SEMANTICS" << endl
+                          << "=======================" << endl;
+
+        bslma::TestAllocator da("default",   false);
+        bslma::TestAllocator sa1("supplied1", false);
+        bslma::TestAllocator sa2("supplied2", false);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        Obj mX(&sa1);  const Obj& X = mX;
+
+        for (int i = 0; i < 50; ++i) {
+            mX.insert(bsl::string(LONG_STRING, &sa1) + char('A' + i % 26)
+                                                     + char('a' + i / 26));
+        }
+
+        {
+            Obj mY(X, &sa2);  const Obj& Y = mY;
+
+            ASSERT(X == Y);
+            ASSERT(!(X != Y));
+            ASSERT(&sa2 == Y.allocator());
+            ASSERT(&sa2 == Y.begin()->get_allocator().mechanism());
+
+            mY.erase(mY.begin());
+
+            ASSERT(X != Y);
+
+            mY = X;
+
+            ASSERT(X == Y);
+            ASSERT(&sa2 == Y.allocator());
+        }
+        {
+            Obj mY(X);  const Obj& Y = mY;
+
+            ASSERT(X == Y);
+            ASSERT(&da == Y.allocator());
+        }
+        {
+            Obj mY(X, &sa1);
+
+            bslma::TestAllocatorMonitor sam(&sa1);
+
+            Obj mZ(bslmf::MovableRefUtil::move(mY));  const Obj& Z = mZ;
+
+            ASSERT(sam.isTotalSame());
+            ASSERT(X == Z);
+            ASSERT(&sa1 == Z.allocator());
+        }
+        {
+            Obj mY(X, &sa1);
+
+            Obj mZ(bslmf::MovableRefUtil::move(mY), &sa2);
+            const Obj& Z = mZ;
+
+            ASSERT(X == Z);
+            ASSERT(&sa2 == Z.allocator());
+            ASSERT(&sa2 == Z.begin()->get_allocator().mechanism());
+        }
+        {
+            Obj mY(X, &sa2);
+            Obj mZ(&sa1);     const Obj& Z = mZ;
+
+            mZ = bslmf::MovableRefUtil::move(mY);
+
+            ASSERT(X == Z);
+            ASSERT(&sa1 == Z.allocator());
+            ASSERT(&sa1 == Z.begin()->get_allocator().mechanism());
+        }
+        {
+            Obj mY(X, &sa1);  const Obj& Y = mY;
+            Obj mZ(&sa1);     const Obj& Z = mZ;
+
+            mZ.insert("a");
+
+            const Obj W(Z, &sa1);
+
+            mY.swap(mZ);
+
+            ASSERT(W == Y);
+            ASSERT(X == Z);
+
+            Obj mV(X, &sa2);  const Obj& V = mV;
+
+            swap(mV, mY);
+
+            ASSERT(W == V);
+            ASSERT(X == Y);
+            ASSERT(&sa2 == V.allocator());
+            ASSERT(&sa1 == Y.allocator());
+        }
+
+        ASSERT(0 == sa2.numBlocksInUse());
+        ASSERT(0 == da.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING BULK INSERTION, LOOKUP, ITERATION, AND REMOVAL
+        //   The remaining manipulators and accessors forward correctly.
+        //
+        // Concerns:
+        //: 1 The range constructors and range 'insert' result in the union of
+        //:   the keys, ordered by the comparator.
+        //:
+        //: 2 'lower_bound', 'upper_bound', and 'equal_range' locate the
+        //:   expected elements.
+        //:
+        //: 3 Each 'erase' overload removes the expected elements.
+        //:
+        //: 4 'clear', 'reserve', and 'shrink_to_fit' affect the size and
+        //:   capacity as documented.
+        //
+        // Plan:
+        //: 1 Use a 'bsl::set' oracle to verify the contents of a set after
+        //:   each operation.  (C-1..4)
+        //
+        // Testing:
+        //   FlatSet(INPUT_ITERATOR first, INPUT_ITERATOR last, *ba = 0);
+        //   FlatSet(first, last, const COMPARATOR& comparator, *ba = 0);
+        //   void clear();
+        //   size_t erase(const KEY& key);
+        //   iterator erase(const_iterator position);
+        //   iterator erase(const_iterator first, const_iterator last);
+        //   void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        //   void reserve(size_t numElements);
+        //   void shrink_to_fit();
+        //   size_t capacity() const;
+        //   pair<const_iterator, const_iterator> equal_range(const KEY&);
+        //   const_iterator lower_bound(const KEY& key) const;
+        //   const_iterator upper_bound(const KEY& key) const;
+        //   const_iterator begin() const;
+        //   const_iterator cbegin() const;
+        //   const_iterator cend() const;
+        //   const_iterator end() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                 << endl
+                 << "TESTING BULK INSERTION, LOOKUP, ITERATION, AND REMOVAL"
+                 << endl
+                 << "======================================================"
+                 << endl;
+
+        bslma::TestAllocator da("default",  false);
+        bslma::TestAllocator sa("supplied", false);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        bsl::vector<int> data(&sa);
+        for (int i = 0; i < 300; ++i) {
+            data.push_back((i * 37) % 200 * 3);
+        }
+
+        bsl::set<int> oracle(data.begin(), data.end(), &sa);
+
+        IntObj mX(data.begin(), data.end(), &sa);  const IntObj& X = mX;
+
+        ASSERT(&sa == X.allocator());
+        ASSERT(matchesOracle(X, oracle));
+        ASSERT(X.cbegin() == X.begin());
+        ASSERT(X.cend()   == X.end());
+
+        {
+            typedef bdlc::FlatSet<int, bsl::greater<int> > ReverseObj;
+
+            ReverseObj mY(data.begin(),
+                          data.end(),
+                          bsl::greater<int>(),
+                          &sa);
+            const ReverseObj& Y = mY;
+
+            ASSERT(oracle.size() == Y.size());
+            ASSERT(bsl::equal(oracle.rbegin(), oracle.rend(), Y.begin()));
+        }
+
+        for (int key = -1; key < 601; ++key) {
+            const bsl::ptrdiff_t lbIndex = bsl::distance(
+                                   oracle.begin(), oracle.lower_bound(key));
+            const bsl::ptrdiff_t ubIndex = bsl::distance(
+                                   oracle.begin(), oracle.upper_bound(key));
+
+            LOOP_ASSERT(key, lbIndex == X.lower_bound(key) - X.begin());
+            LOOP_ASSERT(key, ubIndex == X.upper_bound(key) - X.begin());
+
+            const bsl::pair<IntObj::const_iterator, IntObj::const_iterator>
+                                                    range = X.equal_range(key);
+
+            LOOP_ASSERT(key, lbIndex == range.first  - X.begin());
+            LOOP_ASSERT(key, ubIndex == range.second - X.begin());
+        }
+
+        bsl::vector<int> more(&sa);
+        for (int i = 0; i < 300; ++i) {
+            more.push_back(i * 2);
+        }
+
+        mX.insert(more.begin(), more.end());
+        oracle.insert(more.begin(), more.end());
+        ASSERT(matchesOracle(X, oracle));
+
+        ASSERT(1 == mX.erase(3));
+        ASSERT(0 == mX.erase(5));
+        oracle.erase(3);
+        ASSERT(matchesOracle(X, oracle));
+
+        {
+            IntObj::iterator it = mX.erase(X.find(6));
+            ASSERT(8 == *it);
+            oracle.erase(6);
+        }
+        {
+            IntObj::iterator it = mX.erase(X.lower_bound(100),
+                                           X.lower_bound(200));
+            ASSERT(200 == *it);
+            oracle.erase(oracle.lower_bound(100), oracle.lower_bound(200));
+        }
+        ASSERT(matchesOracle(X, oracle));
+
+        mX.shrink_to_fit();
+        ASSERT(X.size() == X.capacity());
+
+        mX.reserve(2000);
+        ASSERT(2000 <= X.capacity());
+
+        mX.clear();
+        ASSERT(0 == X.size());
+        ASSERT(X.begin() == X.end());
+
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING PRIMARY MANIPULATORS AND BASIC ACCESSORS
+        //   The constructors and single-element 'insert' behave as their
+        //   'bsl::set' counterparts.
+        //
+        // Concerns:
+        //: 1 The constructors create an empty set using the intended
+        //:   allocator and comparator.
+        //:
+        //: 2 'insert' adds an absent key, leaves the set unchanged for a
+        //:   present key, and returns an iterator to the element having the
+        //:   key.
+        //:
+        //: 3 Elements are constructed using the allocator of the set.
+        //:
+        //: 4 The basic accessors reflect the state of the set.
+        //
+        // Plan:
+        //: 1 Perform each operation and verify the result with the basic
+        //:   accessors.  (C-1..4)
+        //
+        // Testing:
+        //   FlatSet();
+        //   FlatSet(bslma::Allocator *basicAllocator);
+        //   FlatSet(const COMPARATOR& comparator, *ba = 0);
+        //   ~FlatSet();
+        //   pair<iterator, bool> insert(KEY_TYPE&& value);
+        //   bool contains(const KEY& key) const;
+        //   size_t count(const KEY& key) const;
+        //   bool empty() const;
+        //   const_iterator find(const KEY& key) const;
+        //   COMPARATOR key_comp() const;
+        //   size_t size() const;
+        //   COMPARATOR value_comp() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                       << endl
+                       << "TESTING PRIMARY MANIPULATORS AND BASIC ACCESSORS"
+                       << endl
+                       << "================================================"
+                       << endl;
+
+        bslma::TestAllocator da("default",  false);
+        bslma::TestAllocator sa("supplied", false);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        {
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT(&da == X.allocator());
+            ASSERT(X.empty());
+            ASSERT(0 == X.size());
+        }
+        {
+            Obj mX(&sa);  const Obj& X = mX;
+
+            ASSERT(&sa == X.allocator());
+            ASSERT(X.key_comp()("a", "b"));
+            ASSERT(X.value_comp()("a", "b"));
+        }
+        {
+            typedef bdlc::FlatSet<int, bsl::greater<int> > ReverseObj;
+
+            ReverseObj mX(bsl::greater<int>(), &sa);  const ReverseObj& X = mX;
+
+            ASSERT(&sa == X.allocator());
+            ASSERT(X.key_comp()(2, 1));
+
+            mX.insert(1);
+            mX.insert(2);
+            ASSERT(2 == *X.begin());
+        }
+
+        ASSERT(0 == da.numBlocksTotal());
+
+        {
+            Obj mX(&sa);  const Obj& X = mX;
+
+            const bsl::string KEY(LONG_STRING, &sa);
+
+            ASSERT(!X.contains(KEY));
+            ASSERT(0 == X.count(KEY));
+            ASSERT(X.end() == X.find(KEY));
+
+            bsl::pair<Obj::iterator, bool> rv = mX.insert(KEY);
+
+            ASSERT(rv.second);
+            ASSERT(KEY == *rv.first);
+            ASSERT(!X.empty());
+            ASSERT(1 == X.size());
+            ASSERT(X.contains(KEY));
+            ASSERT(1 == X.count(KEY));
+            ASSERT(X.begin() == X.find(KEY));
+            ASSERT(&sa == X.begin()->get_allocator().mechanism());
+
+            rv = mX.insert(KEY);
+
+            ASSERT(!rv.second);
+            ASSERT(X.begin() == rv.first);
+            ASSERT(1 == X.size());
+
+            bsl::string movedKey(bsl::string(LONG_STRING) + "y", &sa);
+
+            rv = mX.insert(bslmf::MovableRefUtil::move(movedKey));
+
+            ASSERT(rv.second);
+            ASSERT(2 == X.size());
+            ASSERT(X.end() - 1 == rv.first);
+
+            rv = mX.insert("a");
+
+            ASSERT(rv.second);
+            ASSERT(X.begin() == rv.first);
+            ASSERT(&sa == rv.first->get_allocator().mechanism());
+        }
+
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an object, insert and find elements, and compare objects.
+        //:   (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        IntObj mX;  const IntObj& X = mX;
+
+        ASSERT(0 == X.size());
+
+        mX.insert(3);
+        mX.insert(1);
+
+        ASSERT(2 == X.size());
+        ASSERT(1 == *X.begin());
+        ASSERT(X.contains(3));
+
+        IntObj mY(X);  const IntObj& Y = mY;
+
+        ASSERT(X == Y);
+
+        ASSERT(1 == mX.erase(1));
+        ASSERT(1 == X.size());
+        ASSERT(X != Y);
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1188 @@
+// bdlc_flattree.h                                                    -*-C++-*-
+
+#ifndef INCLUDED_BDLC_FLATTREE
+#define INCLUDED_BDLC_FLATTREE
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an ordered table of uniquely-keyed entries in a vector.
+//
+//@CLASSES:
+//  bdlc::FlatTree: ordered table of uniquely-keyed entries held in a vector
+//
+//@SEE_ALSO: bdlc_flatmap, bdlc_flatset
+//
+//@DESCRIPTION: This component provides the class template 'bdlc::FlatTree',
+// which implements an ordered table of uniquely-keyed entries held in a single
+// sorted, contiguous array, and which is used as the underlying implementation
+// of 'bdlc::FlatMap' and 'bdlc::FlatSet'.
+//
+// Unlike the red-black tree used by 'bsl::map' and 'bsl::set' (see
+// 'bslstl_treenode'), which allocates one node per element and links the
+// nodes by pointers, a 'bdlc::FlatTree' stores its entries, in key order, in a
+// 'bsl::vector'.  A lookup is therefore a binary search over contiguous
+// memory: it does not chase pointers, touches roughly half as many cache
+// lines as a tree lookup for small entries, and iteration is a linear scan.
+// The price is that inserting or erasing a single entry is linear in the
+// number of entries that follow it, so a 'bdlc::FlatTree' is best suited to
+// tables that are built once (or in bulk) and then searched many times.
+//
+///Bulk Insertion
+///--------------
+// Inserting the 'N' elements of a range one at a time costs 'O[N * size()]'
+// element moves.  The range form of 'insert' instead appends the whole range
+// to the array, sorts the appended entries, removes the appended entries
+// having duplicate keys, and finally merges the two sorted sequences, for a
+// total cost of 'O[N * log(N) + size()]'.  When every appended key is greater
+// than the greatest existing key (e.g., when the table is being built from
+// sorted or empty input) the final merge is skipped entirely.  All temporary
+// storage used by the merge is obtained from the table's allocator.
+//
+///Branchless Search
+///-----------------
+// The 'lower_bound' and 'upper_bound' searches of a 'bdlc::FlatTree' are
+// written so that the loop body contains no data-dependent branch: each step
+// halves the remaining length and conditionally advances the base of the
+// search range by an arithmetic select, which compilers emit as a conditional
+// move.  For read-heavy workloads over tables that exceed the first-level
+// cache this avoids the branch mispredictions (one per level, on average
+// half the time) of a conventional binary search; the number of iterations
+// depends only on 'size()'.
+//
+///Template Parameters
+///-------------------
+// The 'ENTRY_UTIL' template parameter must provide the following 'static'
+// member functions:
+//..
+//  static const KEY& key(const ENTRY& entry);
+//      // Return the key of the specified 'entry'.
+//
+//  template <class KEY_TYPE, class... ARGS>
+//  static void construct(ENTRY            *entry,
+//                        bslma::Allocator *allocator,
+//                        KEY_TYPE&&        key,
+//                        ARGS&&...         args);
+//      // Load into the specified 'entry' the 'ENTRY' value comprised of the
+//      // specified 'key' and a value constructed from the specified 'args',
+//      // using the specified 'allocator' to supply memory.
+//..
+// The 'COMPARATOR' template parameter must be a binary predicate that induces
+// a strict weak ordering on 'KEY' values.
+//
+///Iterator, Pointer, and Reference Invalidation
+///---------------------------------------------
+// Any manipulator of a 'bdlc::FlatTree' that inserts or erases an entry
+// invalidates all pointers, references, and iterators to entries at or after
+// the point of insertion or erasure, and, if the capacity changes, to all
+// entries.
+//
+///Exception Safety
+///----------------
+// A 'bdlc::FlatTree' is exception neutral, and all of the methods of
+// 'bdlc::FlatTree' provide the basic exception safety guarantee (see
+// {'bsldoc_glossary'|Basic Guarantee}).  Insertion of a single entry provides
+// the strong guarantee if the move constructor and move-assignment operator
+// of 'ENTRY' do not throw.  Note that if an exception is thrown while the
+// range form of 'insert' is merging, the table may be left empty.
+//
+///Usage
+///-----
+// There is no usage example for this component since it is not meant for
+// direct client use.
+
+#include <bdlscm_version.h>
+
+#include <bslma_allocator.h>
+#include <bslma_constructionutil.h>
+#include <bslma_default.h>
+#include <bslma_destructorguard.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_movableref.h>
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bsls_assert.h>
+#include <bsls_compilerfeatures.h>
+#include <bsls_objectbuffer.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstddef.h>
+#include <bsl_utility.h>
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace bdlc {
+
+                       // ===========================
+                       // class FlatTree_EraseProctor
+                       // ===========================
+
+template <class VECTOR>
+class FlatTree_EraseProctor {
+    // This class implements a proctor that, unless its 'release' method is
+    // invoked, erases, upon destruction, the elements at and after a fixed
+    // position of a vector.
+
+    // DATA
+    VECTOR      *d_vector_p;  // managed vector, or 0 if released
+    bsl::size_t  d_length;    // length to which to truncate 'd_vector_p'
+
+    // NOT IMPLEMENTED
+    FlatTree_EraseProctor(const FlatTree_EraseProctor&);
+    FlatTree_EraseProctor& operator=(const FlatTree_EraseProctor&);
+
+  public:
+    // CREATORS
+    FlatTree_EraseProctor(VECTOR *vector, bsl::size_t length);
+        // Create a proctor that, upon destruction, erases the elements of the
+        // specified 'vector' at and after the specified 'length' position.
+
+    ~FlatTree_EraseProctor();
+        // Destroy this proctor and, unless 'release' has been called, erase
+        // the elements of the managed vector at and after the managed length.
+
+    // MANIPULATORS
+    void release();
+        // Release from management the vector managed by this proctor.
+
+    void setLength(bsl::size_t length);
+        // Set the position at and after which the elements of the managed
+        // vector are erased upon destruction of this proctor to the specified
+        // 'length'.
+};
+
+                     // ==============================
+                     // class FlatTree_EntryComparator
+                     // ==============================
+
+template <class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+class FlatTree_EntryComparator {
+    // This class adapts a key-ordering functor to a functor ordering entries
+    // by their keys, as required by 'bsl::sort'.
+
+    // DATA
+    const COMPARATOR *d_comparator_p;  // key-ordering functor (held)
+
+  public:
+    // CREATORS
+    explicit FlatTree_EntryComparator(const COMPARATOR& comparator);
+        // Create an entry comparator that orders entries by applying the
+        // specified 'comparator' to their keys.  The behavior is undefined
+        // unless 'comparator' outlives this object.
+
+    // ACCESSORS
+    bool operator()(const ENTRY& lhs, const ENTRY& rhs) const;
+        // Return 'true' if the key of the specified 'lhs' is ordered before
+        // the key of the specified 'rhs', and 'false' otherwise.
+};
+
+                              // ==============
+                              // class FlatTree
+                              // ==============
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+class FlatTree {
+    // This class template implements a value-semantic ordered table of
+    // uniquely-keyed entries, stored in sorted order in a contiguous array.
+    // See the component-level documentation for details.
+
+    // PRIVATE TYPES
+    typedef bsl::vector<ENTRY>                        ContainerType;
+    typedef FlatTree_EntryComparator<ENTRY, ENTRY_UTIL, COMPARATOR>
+                                                      EntryComparator;
+    typedef bslmf::MovableRefUtil                     MoveUtil;
+
+  public:
+    // TYPES
+    typedef typename ContainerType::iterator        iterator;
+    typedef typename ContainerType::const_iterator  const_iterator;
+
+  private:
+    // DATA
+    COMPARATOR    d_comparator;  // key-ordering functor
+    ContainerType d_entries;     // entries, ordered by key
+
+    // PRIVATE MANIPULATORS
+    void mergeAppended(bsl::size_t numExisting);
+        // Restore the ordering invariant of this table after entries have
+        // been appended to it, where the specified 'numExisting' is the
+        // number of entries, in key order, preceding the appended entries.
+        // The appended entries are sorted, those whose keys are equivalent to
+        // that of an existing entry or an earlier appended entry are removed,
+        // and the remaining appended entries are merged into the existing
+        // entries.
+
+    // PRIVATE ACCESSORS
+    bsl::size_t lowerBoundIndex(const KEY& key) const;
+        // Return the index of the first entry in this table whose key is not
+        // ordered before the specified 'key', or 'size()' if no such entry
+        // exists.
+
+    bsl::size_t upperBoundIndex(const KEY& key) const;
+        // Return the index of the first entry in this table whose key is
+        // ordered after the specified 'key', or 'size()' if no such entry
+        // exists.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(FlatTree, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit FlatTree(const COMPARATOR&  comparator,
+                      bslma::Allocator  *basicAllocator = 0);
+        // Create an empty table that uses the specified 'comparator' to order
+        // the keys of its entries.  Optionally specify a 'basicAllocator' used
+        // to supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.
+
+    FlatTree(const FlatTree& original, bslma::Allocator *basicAllocator = 0);
+        // Create a table having the same value and comparator as the
+        // specified 'original' object.  Optionally specify a 'basicAllocator'
+        // used to supply memory.  If 'basicAllocator' is 0, the currently
+        // installed default allocator is used.
+
+    FlatTree(bslmf::MovableRef<FlatTree> original);
+        // Create a table having the same value, comparator, and allocator as
+        // the specified 'original' object by moving (in constant time) the
+        // contents of 'original' to the new table.  'original' is left in a
+        // valid but unspecified state.
+
+    FlatTree(bslmf::MovableRef<FlatTree>  original,
+             bslma::Allocator            *basicAllocator);
+        // Create a table having the same value and comparator as the
+        // specified 'original' object by moving the contents of 'original' to
+        // the new table, and using the specified 'basicAllocator' to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  The contents of 'original' are moved (in
+        // constant time) to the new table if 'basicAllocator' is
+        // 'original.allocator()', and are move-inserted (in linear time)
+        // using 'basicAllocator' otherwise.  'original' is left in a valid but
+        // unspecified state.
+
+    //! ~FlatTree() = default;
+        // Destroy this object and each of its entries.
+
+    // MANIPULATORS
+    FlatTree& operator=(const FlatTree& rhs);
+        // Assign to this object the value and comparator of the specified
+        // 'rhs' object, and return a reference providing modifiable access to
+        // this object.
+
+    FlatTree& operator=(bslmf::MovableRef<FlatTree> rhs);
+        // Assign to this object the value and comparator of the specified
+        // 'rhs' object, and return a reference providing modifiable access to
+        // this object.  The contents of 'rhs' are moved (in constant time) to
+        // this table if 'allocator() == rhs.allocator()', and are
+        // move-inserted (in linear time) using 'allocator()' otherwise.
+        // 'rhs' is left in a valid but unspecified state.
+
+    void clear();
+        // Erase all the entries from this table.  Note that the capacity of
+        // this table is not affected.
+
+    bsl::size_t erase(const KEY& key);
+        // Erase the entry having the specified 'key' from this table, if such
+        // an entry exists, and return the number of erased entries (0 or 1).
+
+    iterator erase(const_iterator position);
+        // Erase the entry at the specified 'position' from this table, and
+        // return an iterator referring to the entry immediately following the
+        // erased entry, or to 'end()' if the erased entry was the last entry
+        // in this table.  The behavior is undefined unless 'position' refers
+        // to an entry in this table.
+
+    iterator erase(const_iterator first, const_iterator last);
+        // Erase the entries in the range '[first, last)' from this table, and
+        // return an iterator referring to the entry that followed the erased
+        // range.  The behavior is undefined unless 'first' and 'last' either
+        // refer to entries in this table or are the 'end()' iterator, and
+        // 'first' is not after 'last'.
+
+    iterator find(const KEY& key);
+        // Return an iterator to the entry in this table having the specified
+        // 'key' if such an entry exists, and 'end()' otherwise.
+
+    bsl::pair<iterator, bool> insert(const ENTRY& entry);
+    bsl::pair<iterator, bool> insert(bslmf::MovableRef<ENTRY> entry);
+        // Insert the specified 'entry' into this table if the key of 'entry'
+        // does not already exist in this table; otherwise, this method has no
+        // effect.  Return a 'pair' whose 'first' member is an iterator
+        // referring to the (possibly newly inserted) entry having the key of
+        // 'entry', and whose 'second' member is 'true' if a new entry was
+        // inserted, and 'false' otherwise.  In the second form, 'entry' is
+        // left in a valid but unspecified state if it is inserted.
+
+    template <class INPUT_ITERATOR>
+    void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        // Insert into this table an entry created from each element in the
+        // range starting at the specified 'first' iterator and ending
+        // immediately before the specified 'last' iterator whose key does not
+        // already exist in this table, using a single sort of the range
+        // followed by a single merge (see {Bulk Insertion}).  If the range
+        // contains several elements having equivalent keys, it is unspecified
+        // which of them is inserted.  The behavior is undefined unless 'first'
+        // and 'last' refer to a sequence of valid values where 'first' is at a
+        // position at or before 'last'.
+
+    iterator lower_bound(const KEY& key);
+        // Return an iterator to the first entry in this table whose key is
+        // not ordered before the specified 'key', or 'end()' if no such entry
+        // exists.
+
+    void reserve(bsl::size_t numEntries);
+        // Change the capacity of this table, if necessary, so that it can
+        // hold at least the specified 'numEntries' without reallocating.
+
+    void shrink_to_fit();
+        // Reduce the capacity of this table, if possible, to 'size()'.
+
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES
+    template <class KEY_TYPE, class... ARGS>
+    bsl::pair<iterator, bool> tryEmplace(KEY_TYPE&& key, ARGS&&... args);
+        // If an entry having the specified 'key' does not already exist in
+        // this table, insert into this table an entry constructed by
+        // 'ENTRY_UTIL::construct' from 'key' and the specified 'args';
+        // otherwise, this method has no effect (and, in particular, no object
+        // is constructed from 'args').  Return a 'pair' whose 'first' member
+        // is an iterator referring to the (possibly newly inserted) entry
+        // having 'key', and whose 'second' member is 'true' if a new entry was
+        // inserted, and 'false' otherwise.
+#else
+    template <class KEY_TYPE>
+    bsl::pair<iterator, bool> tryEmplace(
+                             BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE) key);
+    template <class KEY_TYPE, class ARG1>
+    bsl::pair<iterator, bool> tryEmplace(
+                             BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE) key,
+                             BSLS_COMPILERFEATURES_FORWARD_REF(ARG1)     arg1);
+        // If an entry having the specified 'key' does not already exist in
+        // this table, insert into this table an entry constructed by
+        // 'ENTRY_UTIL::construct' from 'key' and the optionally specified
+        // 'arg1'; otherwise, this method has no effect.  Return a 'pair' whose
+        // 'first' member is an iterator referring to the (possibly newly
+        // inserted) entry having 'key', and whose 'second' member is 'true' if
+        // a new entry was inserted, and 'false' otherwise.
+#endif
+
+    iterator upper_bound(const KEY& key);
+        // Return an iterator to the first entry in this table whose key is
+        // ordered after the specified 'key', or 'end()' if no such entry
+        // exists.
+
+    iterator begin();
+        // Return an iterator to the first entry in the sequence of entries
+        // maintained by this table, or the 'end' iterator if this table is
+        // empty.
+
+    iterator end();
+        // Return an iterator to the past-the-end entry in the sequence of
+        // entries maintained by this table.
+
+                                  // Aspects
+
+    void swap(FlatTree& other);
+        // Exchange the value and comparator of this object with those of the
+        // specified 'other' object.  This method provides the no-throw
+        // exception-safety guarantee if 'COMPARATOR' has a no-throw swap
+        // operation.  The behavior is undefined unless this object was
+        // created with the same allocator as 'other'.
+
+    // ACCESSORS
+    bsl::size_t capacity() const;
+        // Return the number of entries this table can hold without
+        // reallocating.
+
+    bool contains(const KEY& key) const;
+        // Return 'true' if this table contains an entry having the specified
+        // 'key', and 'false' otherwise.
+
+    bsl::size_t count(const KEY& key) const;
+        // Return the number of entries in this table having the specified
+        // 'key'.  Note that since a table maintains unique keys, the returned
+        // value will be either 0 or 1.
+
+    bool empty() const;
+        // Return 'true' if this table contains no entries, and 'false'
+        // otherwise.
+
+    bsl::pair<const_iterator, const_iterator> equal_range(
+                                                         const KEY& key) const;
+        // Return a pair of iterators defining the sequence of entries in this
+        // table having the specified 'key', where the first iterator is
+        // positioned at the start of the sequence and the second iterator is
+        // positioned one past the end of the sequence.  If this table contains
+        // no entry having 'key', then the two returned iterators will have
+        // the same value.
+
+    const_iterator find(const KEY& key) const;
+        // Return a 'const_iterator' to the entry in this table having the
+        // specified 'key' if such an entry exists, and 'end()' otherwise.
+
+    const COMPARATOR& key_comp() const;
+        // Return (a reference providing non-modifiable access to) the
+        // key-ordering functor used by this table.
+
+    const_iterator lower_bound(const KEY& key) const;
+        // Return a 'const_iterator' to the first entry in this table whose key
+        // is not ordered before the specified 'key', or 'end()' if no such
+        // entry exists.
+
+    bsl::size_t size() const;
+        // Return the number of entries in this table.
+
+    const_iterator upper_bound(const KEY& key) const;
+        // Return a 'const_iterator' to the first entry in this table whose key
+        // is ordered after the specified 'key', or 'end()' if no such entry
+        // exists.
+
+    const_iterator begin() const;
+        // Return a 'const_iterator' to the first entry in the sequence of
+        // entries maintained by this table, or the 'end' iterator if this
+        // table is empty.
+
+    const_iterator end() const;
+        // Return a 'const_iterator' to the past-the-end entry in the sequence
+        // of entries maintained by this table.
+
+                                  // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this table to supply memory.
+};
+
+// FREE OPERATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+bool operator==(const FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>& lhs,
+                const FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects have the same
+    // value, and 'false' otherwise.  Two 'FlatTree' objects have the same
+    // value if their sizes are the same and each entry contained in one is
+    // equal (using 'operator==' on 'ENTRY') to the entry at the same position
+    // in the other.  Note that the comparators are not compared.
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+bool operator!=(const FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>& lhs,
+                const FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects do not have the
+    // same value, and 'false' otherwise.  Two 'FlatTree' objects do not have
+    // the same value if their sizes differ or some entry contained in one is
+    // not equal to the entry at the same position in the other.
+
+// FREE FUNCTIONS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+void swap(FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>& a,
+          FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>& b);
+    // Exchange the value and comparator of the specified 'a' and 'b' objects.
+    // This function provides the no-throw exception-safety guarantee if the
+    // two objects were created with the same allocator and the basic
+    // guarantee otherwise.
+
+// ============================================================================
+//                           INLINE DEFINITIONS
+// ============================================================================
+
+                       // ---------------------------
+                       // class FlatTree_EraseProctor
+                       // ---------------------------
+
+// CREATORS
+template <class VECTOR>
+inline
+FlatTree_EraseProctor<VECTOR>::FlatTree_EraseProctor(VECTOR      *vector,
+                                                     bsl::size_t  length)
+: d_vector_p(vector)
+, d_length(length)
+{
+}
+
+template <class VECTOR>
+inline
+FlatTree_EraseProctor<VECTOR>::~FlatTree_EraseProctor()
+{
+    if (d_vector_p) {
+        d_vector_p->erase(d_vector_p->begin() + d_length, d_vector_p->end());
+    }
+}
+
+// MANIPULATORS
+template <class VECTOR>
+inline
+void FlatTree_EraseProctor<VECTOR>::release()
+{
+    d_vector_p = 0;
+}
+
+template <class VECTOR>
+inline
+void FlatTree_EraseProctor<VECTOR>::setLength(bsl::size_t length)
+{
+    d_length = length;
+}
+
+                     // ------------------------------
+                     // class FlatTree_EntryComparator
+                     // ------------------------------
+
+// CREATORS
+template <class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+FlatTree_EntryComparator<ENTRY, ENTRY_UTIL, COMPARATOR>::
+                      FlatTree_EntryComparator(const COMPARATOR& comparator)
+: d_comparator_p(&comparator)
+{
+}
+
+// ACCESSORS
+template <class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+bool FlatTree_EntryComparator<ENTRY, ENTRY_UTIL, COMPARATOR>::operator()(
+                                                        const ENTRY& lhs,
+                                                        const ENTRY& rhs) const
+{
+    return (*d_comparator_p)(ENTRY_UTIL::key(lhs), ENTRY_UTIL::key(rhs));
+}
+
+                              // --------------
+                              // class FlatTree
+                              // --------------
+
+// PRIVATE MANIPULATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+void FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::mergeAppended(
+                                                      bsl::size_t numExisting)
+{
+    BSLS_ASSERT_SAFE(numExisting <= d_entries.size());
+
+    FlatTree_EraseProctor<ContainerType> proctor(&d_entries, numExisting);
+
+    // Sort the appended entries and remove those having duplicate keys.  As
+    // the appended entries are sorted, an entry has the same key as its
+    // predecessor unless its predecessor is ordered before it.
+
+    const iterator mid = d_entries.begin() + numExisting;
+    const iterator end = d_entries.end();
+
+    bsl::sort(mid, end, EntryComparator(d_comparator));
+
+    iterator out = mid;
+    for (iterator it = mid; it != end; ++it) {
+        if (out == mid || d_comparator(ENTRY_UTIL::key(out[-1]),
+                                       ENTRY_UTIL::key(*it))) {
+            if (out != it) {
+                *out = MoveUtil::move(*it);
+            }
+            ++out;
+        }
+    }
+    d_entries.erase(out, end);
+
+    const bsl::size_t numAppended = d_entries.size() - numExisting;
+
+    if (0 == numExisting
+     || 0 == numAppended
+     || d_comparator(ENTRY_UTIL::key(d_entries[numExisting - 1]),
+                     ENTRY_UTIL::key(d_entries[numExisting]))) {
+        // The appended entries already follow the existing entries.
+
+        proctor.release();
+        return;                                                       // RETURN
+    }
+
+    // Merge into new storage obtained from this table's allocator; the
+    // existing entry is kept when an appended key is already present.  An
+    // exception thrown while entries are being moved leaves this table empty.
+
+    ContainerType merged(d_entries.get_allocator());
+    merged.reserve(d_entries.size());
+
+    proctor.setLength(0);
+
+    ENTRY       *lhs    = d_entries.data();
+    ENTRY *const lhsEnd = lhs + numExisting;
+    ENTRY       *rhs    = lhsEnd;
+    ENTRY *const rhsEnd = lhs + d_entries.size();
+
+    while (lhs != lhsEnd && rhs != rhsEnd) {
+        const KEY& lhsKey = ENTRY_UTIL::key(*lhs);
+        const KEY& rhsKey = ENTRY_UTIL::key(*rhs);
+
+        if (d_comparator(rhsKey, lhsKey)) {
+            merged.push_back(MoveUtil::move(*rhs));
+            ++rhs;
+        }
+        else {
+            if (!d_comparator(lhsKey, rhsKey)) {
+                ++rhs;
+            }
+            merged.push_back(MoveUtil::move(*lhs));
+            ++lhs;
+        }
+    }
+    for (; lhs != lhsEnd; ++lhs) {
+        merged.push_back(MoveUtil::move(*lhs));
+    }
+    for (; rhs != rhsEnd; ++rhs) {
+        merged.push_back(MoveUtil::move(*rhs));
+    }
+
+    d_entries.swap(merged);
+    proctor.release();
+}
+
+// PRIVATE ACCESSORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+bsl::size_t FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::lowerBoundIndex(
+                                                          const KEY& key) const
+{
+    const ENTRY *const data   = d_entries.data();
+    const ENTRY       *base   = data;
+    bsl::size_t        length = d_entries.size();
+
+    if (0 == length) {
+        return 0;                                                     // RETURN
+    }
+
+    // The result lies in '[base, base + length]'.  Each step discards the
+    // lower or upper half of the range without a data-dependent branch.
+
+    while (length > 1) {
+        const bsl::size_t half = length / 2;
+
+        base   += d_comparator(ENTRY_UTIL::key(base[half - 1]), key)
+                ? half
+                : 0;
+        length -= half;
+    }
+
+    return (base - data) + d_comparator(ENTRY_UTIL::key(*base), key);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+bsl::size_t FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::upperBoundIndex(
+                                                          const KEY& key) const
+{
+    const ENTRY *const data   = d_entries.data();
+    const ENTRY       *base   = data;
+    bsl::size_t        length = d_entries.size();
+
+    if (0 == length) {
+        return 0;                                                     // RETURN
+    }
+
+    while (length > 1) {
+        const bsl::size_t half = length / 2;
+
+        base   += d_comparator(key, ENTRY_UTIL::key(base[half - 1]))
+                ? 0
+                : half;
+        length -= half;
+    }
+
+    return (base - data) + !d_comparator(key, ENTRY_UTIL::key(*base));
+}
+
+// CREATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::FlatTree(
+                                          const COMPARATOR&  comparator,
+                                          bslma::Allocator  *basicAllocator)
+: d_comparator(comparator)
+, d_entries(bslma::Default::allocator(basicAllocator))
+{
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::FlatTree(
+                                            const FlatTree&   original,
+                                            bslma::Allocator *basicAllocator)
+: d_comparator(original.d_comparator)
+, d_entries(original.d_entries, bslma::Default::allocator(basicAllocator))
+{
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::FlatTree(
+                                          bslmf::MovableRef<FlatTree> original)
+: d_comparator(MoveUtil::access(original).d_comparator)
+, d_entries(MoveUtil::move(MoveUtil::access(original).d_entries))
+{
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::FlatTree(
+                                 bslmf::MovableRef<FlatTree>  original,
+                                 bslma::Allocator            *basicAllocator)
+: d_comparator(MoveUtil::access(original).d_comparator)
+, d_entries(MoveUtil::move(MoveUtil::access(original).d_entries),
+            bslma::Default::allocator(basicAllocator))
+{
+}
+
+// MANIPULATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>&
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::operator=(const FlatTree& rhs)
+{
+    if (this != &rhs) {
+        FlatTree(rhs, allocator()).swap(*this);
+    }
+    return *this;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>&
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::operator=(
+                                               bslmf::MovableRef<FlatTree> rhs)
+{
+    FlatTree& lvalue = rhs;
+
+    if (this != &lvalue) {
+        FlatTree(MoveUtil::move(lvalue), allocator()).swap(*this);
+    }
+    return *this;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+void FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::clear()
+{
+    d_entries.clear();
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+bsl::size_t FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::erase(
+                                                                const KEY& key)
+{
+    const iterator it = find(key);
+
+    if (it == end()) {
+        return 0;                                                     // RETURN
+    }
+    d_entries.erase(it);
+    return 1;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+typename FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::iterator
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::erase(const_iterator position)
+{
+    BSLS_ASSERT_SAFE(begin() <= position);
+    BSLS_ASSERT_SAFE(position < end());
+
+    return d_entries.erase(position);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+typename FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::iterator
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::erase(const_iterator first,
+                                                    const_iterator last)
+{
+    BSLS_ASSERT_SAFE(begin() <= first);
+    BSLS_ASSERT_SAFE(first <= last);
+    BSLS_ASSERT_SAFE(last <= end());
+
+    return d_entries.erase(first, last);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+typename FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::iterator
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::find(const KEY& key)
+{
+    const bsl::size_t index = lowerBoundIndex(key);
+
+    if (index == d_entries.size()
+     || d_comparator(key, ENTRY_UTIL::key(d_entries[index]))) {
+        return end();                                                 // RETURN
+    }
+    return begin() + index;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+bsl::pair<typename FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::iterator,
+          bool>
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::insert(const ENTRY& entry)
+{
+    const KEY&        key   = ENTRY_UTIL::key(entry);
+    const bsl::size_t index = lowerBoundIndex(key);
+
+    if (index != d_entries.size()
+     && !d_comparator(key, ENTRY_UTIL::key(d_entries[index]))) {
+        return bsl::pair<iterator, bool>(begin() + index, false);     // RETURN
+    }
+    return bsl::pair<iterator, bool>(d_entries.insert(begin() + index, entry),
+                                     true);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+bsl::pair<typename FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::iterator,
+          bool>
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::insert(
+                                                bslmf::MovableRef<ENTRY> entry)
+{
+    ENTRY&            lvalue = entry;
+    const KEY&        key    = ENTRY_UTIL::key(lvalue);
+    const bsl::size_t index  = lowerBoundIndex(key);
+
+    if (index != d_entries.size()
+     && !d_comparator(key, ENTRY_UTIL::key(d_entries[index]))) {
+        return bsl::pair<iterator, bool>(begin() + index, false);     // RETURN
+    }
+    return bsl::pair<iterator, bool>(
+                  d_entries.insert(begin() + index, MoveUtil::move(lvalue)),
+                  true);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+template <class INPUT_ITERATOR>
+inline
+void FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::insert(INPUT_ITERATOR first,
+                                                          INPUT_ITERATOR last)
+{
+    const bsl::size_t numExisting = d_entries.size();
+
+    {
+        FlatTree_EraseProctor<ContainerType> proctor(&d_entries, numExisting);
+
+        d_entries.insert(d_entries.end(), first, last);
+        proctor.release();
+    }
+
+    mergeAppended(numExisting);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+typename FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::iterator
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::lower_bound(const KEY& key)
+{
+    return begin() + lowerBoundIndex(key);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+void FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::reserve(
+                                                        bsl::size_t numEntries)
+{
+    d_entries.reserve(numEntries);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+void FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::shrink_to_fit()
+{
+    d_entries.shrink_to_fit();
+}
+
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+template <class KEY_TYPE, class... ARGS>
+bsl::pair<typename FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::iterator,
+          bool>
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::tryEmplace(KEY_TYPE&&  key,
+                                                         ARGS&&...   args)
+{
+    const bsl::size_t index = lowerBoundIndex(key);
+
+    if (index != d_entries.size()
+     && !d_comparator(key, ENTRY_UTIL::key(d_entries[index]))) {
+        return bsl::pair<iterator, bool>(begin() + index, false);     // RETURN
+    }
+
+    bsls::ObjectBuffer<ENTRY> entry;
+    ENTRY_UTIL::construct(entry.address(),
+                          allocator(),
+                          BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, key),
+                          BSLS_COMPILERFEATURES_FORWARD(ARGS, args)...);
+    bslma::DestructorGuard<ENTRY> guard(entry.address());
+
+    return bsl::pair<iterator, bool>(
+                        d_entries.insert(begin() + index,
+                                         MoveUtil::move(entry.object())),
+                        true);
+}
+#else
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+template <class KEY_TYPE>
+bsl::pair<typename FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::iterator,
+          bool>
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::tryEmplace(
+                             BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE) key)
+{
+    const bsl::size_t index = lowerBoundIndex(key);
+
+    if (index != d_entries.size()
+     && !d_comparator(key, ENTRY_UTIL::key(d_entries[index]))) {
+        return bsl::pair<iterator, bool>(begin() + index, false);     // RETURN
+    }
+
+    bsls::ObjectBuffer<ENTRY> entry;
+    ENTRY_UTIL::construct(entry.address(),
+                          allocator(),
+                          BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, key));
+    bslma::DestructorGuard<ENTRY> guard(entry.address());
+
+    return bsl::pair<iterator, bool>(
+                        d_entries.insert(begin() + index,
+                                         MoveUtil::move(entry.object())),
+                        true);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+template <class KEY_TYPE, class ARG1>
+bsl::pair<typename FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::iterator,
+          bool>
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::tryEmplace(
+                             BSLS_COMPILERFEATURES_FORWARD_REF(KEY_TYPE) key,
+                             BSLS_COMPILERFEATURES_FORWARD_REF(ARG1)     arg1)
+{
+    const bsl::size_t index = lowerBoundIndex(key);
+
+    if (index != d_entries.size()
+     && !d_comparator(key, ENTRY_UTIL::key(d_entries[index]))) {
+        return bsl::pair<iterator, bool>(begin() + index, false);     // RETURN
+    }
+
+    bsls::ObjectBuffer<ENTRY> entry;
+    ENTRY_UTIL::construct(entry.address(),
+                          allocator(),
+                          BSLS_COMPILERFEATURES_FORWARD(KEY_TYPE, key),
+                          BSLS_COMPILERFEATURES_FORWARD(ARG1, arg1));
+    bslma::DestructorGuard<ENTRY> guard(entry.address());
+
+    return bsl::pair<iterator, bool>(
+                        d_entries.insert(begin() + index,
+                                         MoveUtil::move(entry.object())),
+                        true);
+}
+#endif
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+typename FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::iterator
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::upper_bound(const KEY& key)
+{
+    return begin() + upperBoundIndex(key);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+typename FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::iterator
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::begin()
+{
+    return d_entries.begin();
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+typename FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::iterator
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::end()
+{
+    return d_entries.end();
+}
+
+                                  // Aspects
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+void FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::swap(FlatTree& other)
+{
+    BSLS_ASSERT_SAFE(allocator() == other.allocator());
+
+    using bsl::swap;
+    swap(d_comparator, other.d_comparator);
+    d_entries.swap(other.d_entries);
+}
+
+// ACCESSORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+bsl::size_t FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::capacity() const
+{
+    return d_entries.capacity();
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+bool FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::contains(
+                                                          const KEY& key) const
+{
+    return find(key) != end();
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+bsl::size_t FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::count(
+                                                          const KEY& key) const
+{
+    return contains(key) ? 1 : 0;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+bool FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::empty() const
+{
+    return d_entries.empty();
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+bsl::pair<
+      typename FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::const_iterator,
+      typename FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::const_iterator>
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::equal_range(
+                                                          const KEY& key) const
+{
+    const const_iterator first = lower_bound(key);
+    const const_iterator last  =
+                            first != end()
+                         && !d_comparator(key, ENTRY_UTIL::key(*first))
+                            ? first + 1
+                            : first;
+
+    return bsl::pair<const_iterator, const_iterator>(first, last);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+typename FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::const_iterator
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::find(const KEY& key) const
+{
+    const bsl::size_t index = lowerBoundIndex(key);
+
+    if (index == d_entries.size()
+     || d_comparator(key, ENTRY_UTIL::key(d_entries[index]))) {
+        return end();                                                 // RETURN
+    }
+    return begin() + index;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+const COMPARATOR&
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::key_comp() const
+{
+    return d_comparator;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+typename FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::const_iterator
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::lower_bound(const KEY& key) const
+{
+    return begin() + lowerBoundIndex(key);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+bsl::size_t FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::size() const
+{
+    return d_entries.size();
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+typename FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::const_iterator
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::upper_bound(const KEY& key) const
+{
+    return begin() + upperBoundIndex(key);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+typename FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::const_iterator
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::begin() const
+{
+    return d_entries.begin();
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+typename FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::const_iterator
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::end() const
+{
+    return d_entries.end();
+}
+
+                                  // Aspects
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+bslma::Allocator *
+FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>::allocator() const
+{
+    return d_entries.get_allocator().mechanism();
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+bool bdlc::operator==(const FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>& lhs,
+                      const FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>& rhs)
+{
+    return lhs.size() == rhs.size()
+        && bsl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+bool bdlc::operator!=(const FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>& lhs,
+                      const FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+// FREE FUNCTIONS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class COMPARATOR>
+inline
+void bdlc::swap(FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>& a,
+                FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR>& b)
+{
+    if (a.allocator() == b.allocator()) {
+        a.swap(b);
+
+        return;                                                       // RETURN
+    }
+
+    typedef FlatTree<KEY, ENTRY, ENTRY_UTIL, COMPARATOR> Tree;
+
+    Tree futureA(b, a.allocator());
+    Tree futureB(a, b.allocator());
+
+    a.swap(futureA);
+    b.swap(futureB);
+}
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1056 @@
+// bdlc_flattree.t.cpp                                                -*-C++-*-
+#include <bdlc_flattree.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatormonitor.h>
+
+#include <bslmf_movableref.h>
+
+#include <bsls_asserttest.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstddef.h>
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_functional.h>
+#include <bsl_iostream.h>
+#include <bsl_map.h>
+#include <bsl_new.h>         // placement syntax
+#include <bsl_set.h>
+#include <bsl_string.h>
+#include <bsl_utility.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                              TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is a value-semantic ordered table held in a sorted
+// vector.  The primary concerns are that the branchless searches agree with
+// the standard binary search for every size and every key, that single
+// insertions and erasures maintain the ordering invariant, that the bulk
+// insertion sorts, removes duplicates, keeps existing entries, and takes all
+// of its memory from the table's allocator, and that the table remains valid
+// when an allocation fails during a bulk insertion.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] FlatTree(const COMPARATOR& comparator, *ba = 0);
+// [ 5] FlatTree(const FlatTree& original, *ba = 0);
+// [ 5] FlatTree(MovableRef<FlatTree> original);
+// [ 5] FlatTree(MovableRef<FlatTree> original, *ba);
+// [ 2] ~FlatTree();
+//
+// MANIPULATORS
+// [ 5] FlatTree& operator=(const FlatTree& rhs);
+// [ 5] FlatTree& operator=(MovableRef<FlatTree> rhs);
+// [ 3] void clear();
+// [ 3] size_t erase(const KEY& key);
+// [ 3] iterator erase(const_iterator position);
+// [ 3] iterator erase(const_iterator first, const_iterator last);
+// [ 2] iterator find(const KEY& key);
+// [ 3] pair<iterator, bool> insert(const ENTRY& entry);
+// [ 3] pair<iterator, bool> insert(MovableRef<ENTRY> entry);
+// [ 4] void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+// [ 2] iterator lower_bound(const KEY& key);
+// [ 3] void reserve(size_t numEntries);
+// [ 3] void shrink_to_fit();
+// [ 3] pair<iterator, bool> tryEmplace(KEY_TYPE&& key, ARGS&&... args);
+// [ 2] iterator upper_bound(const KEY& key);
+// [ 2] iterator begin();
+// [ 2] iterator end();
+// [ 5] void swap(FlatTree& other);
+//
+// ACCESSORS
+// [ 3] size_t capacity() const;
+// [ 2] bool contains(const KEY& key) const;
+// [ 2] size_t count(const KEY& key) const;
+// [ 2] bool empty() const;
+// [ 2] pair<const_iterator, const_iterator> equal_range(const KEY&) const;
+// [ 2] const_iterator find(const KEY& key) const;
+// [ 2] const COMPARATOR& key_comp() const;
+// [ 2] const_iterator lower_bound(const KEY& key) const;
+// [ 2] size_t size() const;
+// [ 2] const_iterator upper_bound(const KEY& key) const;
+// [ 2] const_iterator begin() const;
+// [ 2] const_iterator end() const;
+// [ 2] bslma::Allocator *allocator() const;
+//
+// FREE OPERATORS
+// [ 5] bool operator==(const FlatTree& lhs, const FlatTree& rhs);
+// [ 5] bool operator!=(const FlatTree& lhs, const FlatTree& rhs);
+//
+// FREE FUNCTIONS
+// [ 5] void swap(FlatTree& a, FlatTree& b);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] EXCEPTION SAFETY OF BULK INSERTION
+// ----------------------------------------------------------------------------
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+struct IntEntryUtil {
+    // This utility provides the 'ENTRY_UTIL' methods for an 'int' entry that
+    // is its own key.
+
+    template <class KEY_TYPE>
+    static void construct(int *entry, bslma::Allocator *, KEY_TYPE key)
+        // Load the specified 'key' into the specified 'entry'.
+    {
+        *entry = key;
+    }
+
+    static const int& key(const int& entry)
+        // Return the specified 'entry'.
+    {
+        return entry;
+    }
+};
+
+struct PairEntryUtil {
+    // This utility provides the 'ENTRY_UTIL' methods for a
+    // 'bsl::pair<int, int>' entry whose key is its 'first' member.
+
+    template <class KEY_TYPE>
+    static void construct(bsl::pair<int, int> *entry,
+                          bslma::Allocator    *,
+                          KEY_TYPE             key)
+        // Load into the specified 'entry' a pair having the specified 'key'
+        // and a second member of -1.
+    {
+        new (entry) bsl::pair<int, int>(key, -1);
+    }
+
+    static const int& key(const bsl::pair<int, int>& entry)
+        // Return the 'first' member of the specified 'entry'.
+    {
+        return entry.first;
+    }
+};
+
+struct StringEntryUtil {
+    // This utility provides the 'ENTRY_UTIL' methods for a 'bsl::string'
+    // entry that is its own key.
+
+    template <class KEY_TYPE>
+    static void construct(bsl::string      *entry,
+                          bslma::Allocator *allocator,
+                          const KEY_TYPE&   key)
+        // Construct in the specified 'entry' a string having the value of the
+        // specified 'key' and using the specified 'allocator'.
+    {
+        new (entry) bsl::string(key, allocator);
+    }
+
+    static const bsl::string& key(const bsl::string& entry)
+        // Return the specified 'entry'.
+    {
+        return entry;
+    }
+};
+
+typedef bdlc::FlatTree<int, int, IntEntryUtil, bsl::less<int> >    Obj;
+
+typedef bdlc::FlatTree<int, int, IntEntryUtil, bsl::greater<int> > ReverseObj;
+
+typedef bdlc::FlatTree<int,
+                       bsl::pair<int, int>,
+                       PairEntryUtil,
+                       bsl::less<int> >                            PairObj;
+
+typedef bdlc::FlatTree<bsl::string,
+                       bsl::string,
+                       StringEntryUtil,
+                       bsl::less<bsl::string> >                    StringObj;
+
+const char *const LONG_STRING = "a string long enough to require allocation ";
+
+// ============================================================================
+//                          HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+template <class TABLE>
+bool isStrictlyOrdered(const TABLE& table)
+    // Return 'true' if the keys of the entries of the specified 'table' are
+    // strictly increasing with respect to its comparator, and 'false'
+    // otherwise.
+{
+    typename TABLE::const_iterator it = table.begin();
+
+    if (it == table.end()) {
+        return true;                                                  // RETURN
+    }
+    for (typename TABLE::const_iterator prev = it++;
+         it != table.end();
+         prev = it++) {
+        if (!table.key_comp()(*prev, *it)) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+bool matchesOracle(const Obj& table, const bsl::set<int>& oracle)
+    // Return 'true' if the specified 'table' contains exactly the values in
+    // the specified 'oracle', in the same order, and 'false' otherwise.
+{
+    return table.size() == oracle.size()
+        && bsl::equal(oracle.begin(), oracle.end(), table.begin());
+}
+
+bsl::string makeString(int value)
+    // Return a string, long enough to require allocation, that is unique to
+    // the specified 'value' and orders as 'value' does for non-negative
+    // 'value' less than 1,000,000.
+{
+    char buffer[16];
+    bsl::sprintf(buffer, "%06d", value);
+
+    return bsl::string(buffer) + LONG_STRING;
+}
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int  test                = argc > 1 ? atoi(argv[1]) : 0;
+    bool verbose             = argc > 2;
+    bool veryVerbose         = argc > 3;
+    bool veryVeryVerbose     = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // EXCEPTION SAFETY OF BULK INSERTION
+        //   A bulk insertion interrupted by an allocation failure leaves a
+        //   valid table.
+        //
+        // Concerns:
+        //: 1 If an exception is thrown at any allocation of a bulk insertion,
+        //:   the table remains strictly ordered and contains only entries
+        //:   that were present before, or that were being inserted.
+        //:
+        //: 2 No memory is leaked.
+        //
+        // Plan:
+        //: 1 Using the 'BSLMA_TESTALLOCATOR_EXCEPTION_TEST_*' macros, bulk
+        //:   insert a range of allocating strings that interleaves with the
+        //:   existing strings, and verify the invariants of the table at the
+        //:   start of each attempt and upon completion.  (C-1)
+        //:
+        //: 2 Verify that the test allocator reports no outstanding memory
+        //:   after the table is destroyed.  (C-2)
+        //
+        // Testing:
+        //   EXCEPTION SAFETY OF BULK INSERTION
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "EXCEPTION SAFETY OF BULK INSERTION" << endl
+                          << "==================================" << endl;
+
+        bslma::TestAllocator sa("supplied",  veryVeryVerbose);
+
+        for (int numExisting = 0; numExisting <= 30; numExisting += 10) {
+            bsl::vector<bsl::string> incoming(&sa);
+            for (int i = 0; i < 40; ++i) {
+                incoming.push_back(makeString((i * 7) % 60));
+            }
+
+            StringObj mX(bsl::less<bsl::string>(), &sa);
+            const StringObj& X = mX;
+
+            for (int i = 0; i < numExisting; ++i) {
+                mX.tryEmplace(makeString(2 * i));
+            }
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                LOOP_ASSERT(numExisting, isStrictlyOrdered(X));
+                LOOP_ASSERT(numExisting, X.size() <= 60u + numExisting);
+
+                mX.insert(incoming.begin(), incoming.end());
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+            LOOP_ASSERT(numExisting, isStrictlyOrdered(X));
+
+            bsl::set<bsl::string> expected(incoming.begin(),
+                                           incoming.end(),
+                                           &sa);
+            for (int i = 0; i < numExisting; ++i) {
+                expected.insert(makeString(2 * i));
+            }
+            LOOP_ASSERT(numExisting, expected.size() == X.size());
+            LOOP_ASSERT(numExisting,
+                        bsl::equal(X.begin(), X.end(), expected.begin()));
+        }
+
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING VALUE SEMANTICS
+        //   Copy, move, assignment, swap, and equality behave as expected.
+        //
+        // Concerns:
+        //: 1 Copies have the same value as the original and use the supplied
+        //:   (or default) allocator.
+        //:
+        //: 2 A move using the same allocator does not allocate; a move using
+        //:   a different allocator yields entries using the new allocator.
+        //:
+        //: 3 Equality compares the entries in order.
+        //:
+        //: 4 'swap' exchanges values; the free 'swap' supports objects using
+        //:   different allocators.
+        //
+        // Plan:
+        //: 1 Perform each operation using tables of allocating entries and
+        //:   verify the values and memory use.  (C-1..4)
+        //
+        // Testing:
+        //   FlatTree(const FlatTree& original, *ba = 0);
+        //   FlatTree(MovableRef<FlatTree> original);
+        //   FlatTree(MovableRef<FlatTree> original, *ba);
+        //   FlatTree& operator=(const FlatTree& rhs);
+        //   FlatTree& operator=(MovableRef<FlatTree> rhs);
+        //   void swap(FlatTree& other);
+        //   bool operator==(const FlatTree& lhs, const FlatTree& rhs);
+        //   bool operator!=(const FlatTree& lhs, const FlatTree& rhs);
+        //   void swap(FlatTree& a, FlatTree& b);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING VALUE SEMANTICS" << endl
+                          << "=======================" << endl;
+
+        bslma::TestAllocator da("default",   veryVeryVerbose);
+        bslma::TestAllocator sa1("supplied1", veryVeryVerbose);
+        bslma::TestAllocator sa2("supplied2", veryVeryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        typedef bsl::less<bsl::string> Less;
+
+        StringObj mX(Less(), &sa1);  const StringObj& X = mX;
+
+        for (int i = 0; i < 50; ++i) {
+            mX.tryEmplace(makeString(i * 37 % 50));
+        }
+        ASSERT(50 == X.size());
+
+        if (verbose) cout << "\tCopy construction and equality." << endl;
+        {
+            StringObj mY(X, &sa2);  const StringObj& Y = mY;
+
+            ASSERT(X == Y);
+            ASSERT(!(X != Y));
+            ASSERT(&sa2 == Y.allocator());
+
+            mY.erase(makeString(7));
+            ASSERT(X != Y);
+
+            mY.tryEmplace(makeString(7));
+            ASSERT(X == Y);
+
+            mY.erase(makeString(7));
+            mY.tryEmplace(makeString(77));
+            ASSERT(X.size() == Y.size());
+            ASSERT(X != Y);
+
+            StringObj mZ(X);  const StringObj& Z = mZ;
+            ASSERT(X == Z);
+            ASSERT(&da == Z.allocator());
+        }
+
+        if (verbose) cout << "\tMove construction." << endl;
+        {
+            StringObj mY(X, &sa2);  const StringObj& Y = mY;
+
+            bslma::TestAllocatorMonitor sam(&sa2);
+
+            StringObj mZ(bslmf::MovableRefUtil::move(mY));
+            const StringObj& Z = mZ;
+
+            ASSERT(sam.isTotalSame());
+            ASSERT(X == Z);
+            ASSERT(&sa2 == Z.allocator());
+            ASSERT(0 == Y.size());
+
+            StringObj mW(bslmf::MovableRefUtil::move(mZ), &sa1);
+            const StringObj& W = mW;
+
+            ASSERT(X == W);
+            ASSERT(&sa1 == W.allocator());
+            for (StringObj::const_iterator it = W.begin();
+                 it != W.end();
+                 ++it) {
+                ASSERT(&sa1 == it->get_allocator().mechanism());
+            }
+        }
+
+        if (verbose) cout << "\tAssignment." << endl;
+        {
+            StringObj mY(Less(), &sa2);  const StringObj& Y = mY;
+            mY.tryEmplace(makeString(1000));
+
+            mY = X;
+            ASSERT(X == Y);
+            ASSERT(&sa2 == Y.allocator());
+
+            StringObj mZ(X, &sa2);
+            StringObj mW(Less(), &sa2);  const StringObj& W = mW;
+
+            bslma::TestAllocatorMonitor sam(&sa2);
+
+            mW = bslmf::MovableRefUtil::move(mZ);
+            ASSERT(sam.isTotalSame());
+            ASSERT(X == W);
+
+            StringObj mV(X, &sa1);
+            mW = bslmf::MovableRefUtil::move(mV);
+            ASSERT(X == W);
+            ASSERT(&sa2 == W.allocator());
+
+            mW = W;
+            ASSERT(X == W);
+        }
+
+        if (verbose) cout << "\tSwap." << endl;
+        {
+            StringObj mY(Less(), &sa1);  const StringObj& Y = mY;
+            mY.tryEmplace(makeString(1000));
+
+            StringObj mZ(X, &sa1);  const StringObj& Z = mZ;
+
+            bslma::TestAllocatorMonitor sam(&sa1);
+
+            mY.swap(mZ);
+            ASSERT(sam.isTotalSame());
+            ASSERT(X == Y);
+            ASSERT(1 == Z.size());
+
+            swap(mY, mZ);
+            ASSERT(sam.isTotalSame());
+            ASSERT(X == Z);
+
+            StringObj mW(Less(), &sa2);  const StringObj& W = mW;
+
+            swap(mZ, mW);
+            ASSERT(X == W);
+            ASSERT(0 == Z.size());
+            ASSERT(&sa1 == Z.allocator());
+            ASSERT(&sa2 == W.allocator());
+        }
+
+        ASSERT(0 == sa2.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING BULK INSERTION
+        //   The range form of 'insert' produces the union of the existing and
+        //   the inserted keys.
+        //
+        // Concerns:
+        //: 1 The result is sorted, without duplicate keys, and contains
+        //:   exactly the existing keys and the inserted keys.
+        //:
+        //: 2 When an inserted key is already present, the existing entry is
+        //:   kept.
+        //:
+        //: 3 Duplicates within the inserted range are reduced to one entry.
+        //:
+        //: 4 The insertion works for every combination of empty and
+        //:   non-empty existing and inserted sequences, whether or not the
+        //:   inserted keys all follow the existing keys, and with a
+        //:   non-default comparator.
+        //:
+        //: 5 All memory, including any temporary memory, is supplied by the
+        //:   table's allocator.
+        //
+        // Plan:
+        //: 1 For a set of existing sizes and inserted sizes, bulk insert
+        //:   pseudo-random keys (with duplicates) into a table of
+        //:   'bsl::pair<int, int>' entries whose existing second members are
+        //:   0, and verify the result against an oracle, including that the
+        //:   second member of every existing key is still 0.  (C-1..4)
+        //:
+        //: 2 Repeat P-1 for inserted keys that all follow the existing keys.
+        //:   (C-4)
+        //:
+        //: 3 Repeat P-1 using a table ordered by 'bsl::greater'.  (C-4)
+        //:
+        //: 4 Install a test allocator as the default allocator and verify it
+        //:   is never used.  (C-5)
+        //
+        // Testing:
+        //   void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING BULK INSERTION" << endl
+                          << "======================" << endl;
+
+        bslma::TestAllocator da("default",  veryVeryVerbose);
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        static const int SIZES[]   = { 0, 1, 2, 3, 7, 16, 100, 1000 };
+        const int        NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+        unsigned int seed = 12345;
+
+        if (verbose) cout << "\tInterleaved keys." << endl;
+
+        for (int ti = 0; ti < NUM_SIZES; ++ti) {
+            const int NUM_EXISTING = SIZES[ti];
+
+            for (int tj = 0; tj < NUM_SIZES; ++tj) {
+                const int NUM_INSERTED = SIZES[tj];
+                const int RANGE        = 2 * (NUM_EXISTING + NUM_INSERTED) + 1;
+
+                PairObj mX(bsl::less<int>(), &sa);  const PairObj& X = mX;
+
+                bsl::map<int, int> oracle(&sa);
+
+                for (int i = 0; i < NUM_EXISTING; ++i) {
+                    seed = seed * 1103515245 + 12345;
+
+                    const int key = static_cast<int>((seed >> 8) % RANGE);
+
+                    mX.insert(bsl::pair<int, int>(key, 0));
+                    oracle.insert(bsl::pair<int, int>(key, 0));
+                }
+
+                bsl::vector<bsl::pair<int, int> > input(&sa);
+                for (int i = 0; i < NUM_INSERTED; ++i) {
+                    seed = seed * 1103515245 + 12345;
+
+                    const int key = static_cast<int>((seed >> 8) % RANGE);
+
+                    input.push_back(bsl::pair<int, int>(key, 1));
+                    oracle.insert(bsl::pair<int, int>(key, 1));
+                }
+
+                mX.insert(input.begin(), input.end());
+
+                LOOP2_ASSERT(NUM_EXISTING, NUM_INSERTED,
+                             oracle.size() == X.size());
+
+                PairObj::const_iterator it = X.begin();
+                for (bsl::map<int, int>::const_iterator jt = oracle.begin();
+                     jt != oracle.end() && it != X.end();
+                     ++jt, ++it) {
+                    LOOP3_ASSERT(NUM_EXISTING, NUM_INSERTED, jt->first,
+                                 jt->first  == it->first);
+                    LOOP3_ASSERT(NUM_EXISTING, NUM_INSERTED, jt->first,
+                                 jt->second == it->second);
+                }
+            }
+        }
+
+        if (verbose) cout << "\tAppended keys." << endl;
+
+        for (int ti = 0; ti < NUM_SIZES; ++ti) {
+            const int NUM_EXISTING = SIZES[ti];
+
+            for (int tj = 0; tj < NUM_SIZES; ++tj) {
+                const int NUM_INSERTED = SIZES[tj];
+
+                Obj           mX(bsl::less<int>(), &sa);
+                bsl::set<int> oracle(&sa);
+
+                for (int i = 0; i < NUM_EXISTING; ++i) {
+                    mX.tryEmplace(i * 3);
+                    oracle.insert(i * 3);
+                }
+
+                bsl::vector<int> input(&sa);
+                for (int i = NUM_INSERTED - 1; i >= 0; --i) {
+                    input.push_back(3 * NUM_EXISTING + i / 2);
+                    oracle.insert(3 * NUM_EXISTING + i / 2);
+                }
+
+                mX.insert(input.begin(), input.end());
+
+                LOOP2_ASSERT(NUM_EXISTING, NUM_INSERTED,
+                             matchesOracle(mX, oracle));
+            }
+        }
+
+        if (verbose) cout << "\tNon-default comparator." << endl;
+        {
+            ReverseObj mX(bsl::greater<int>(), &sa);
+            const ReverseObj& X = mX;
+
+            const int DATA1[] = { 5, 1, 9, 5, 3 };
+            const int DATA2[] = { 4, 10, 1, 0, 10 };
+
+            mX.insert(DATA1, DATA1 + 5);
+            ASSERT(4 == X.size());
+            ASSERT(isStrictlyOrdered(X));
+
+            mX.insert(DATA2, DATA2 + 5);
+            ASSERT(7 == X.size());
+            ASSERT(isStrictlyOrdered(X));
+            ASSERT(10 == *X.begin());
+            ASSERT( 0 == *(X.end() - 1));
+        }
+
+        ASSERT(0 == da.numBlocksTotal());
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING SINGLE INSERTION AND ERASURE
+        //   Single-entry manipulators maintain the ordering invariant.
+        //
+        // Concerns:
+        //: 1 'tryEmplace' and both forms of 'insert' insert an entry if and
+        //:   only if its key is absent, and return an iterator to the entry
+        //:   having the key.
+        //:
+        //: 2 The 'erase' methods remove exactly the specified entries and
+        //:   return an iterator to the following entry.
+        //:
+        //: 3 'clear', 'reserve', and 'shrink_to_fit' affect the capacity as
+        //:   documented, and 'clear' retains the capacity.
+        //:
+        //: 4 Entries are constructed using the table's allocator.
+        //
+        // Plan:
+        //: 1 Apply a sequence of pseudo-random insertions and erasures to a
+        //:   table and to an oracle, and verify that the table matches the
+        //:   oracle.  (C-1..2)
+        //:
+        //: 2 Exercise the remaining manipulators directly.  (C-2..3)
+        //:
+        //: 3 Insert allocating strings and verify the allocator of each entry
+        //:   and that the default allocator is unused.  (C-4)
+        //
+        // Testing:
+        //   void clear();
+        //   size_t erase(const KEY& key);
+        //   iterator erase(const_iterator position);
+        //   iterator erase(const_iterator first, const_iterator last);
+        //   pair<iterator, bool> insert(const ENTRY& entry);
+        //   pair<iterator, bool> insert(MovableRef<ENTRY> entry);
+        //   void reserve(size_t numEntries);
+        //   void shrink_to_fit();
+        //   pair<iterator, bool> tryEmplace(KEY_TYPE&& key, ARGS&&... args);
+        //   size_t capacity() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING SINGLE INSERTION AND ERASURE" << endl
+                          << "====================================" << endl;
+
+        bslma::TestAllocator da("default",  veryVeryVerbose);
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        if (verbose) cout << "\tRandom operations." << endl;
+        {
+            Obj           mX(bsl::less<int>(), &sa);  const Obj& X = mX;
+            bsl::set<int> oracle;
+
+            unsigned int seed = 987654321;
+
+            for (int i = 0; i < 5000; ++i) {
+                seed = seed * 1103515245 + 12345;
+
+                const int key = static_cast<int>((seed >> 8) % 300);
+
+                switch ((seed >> 4) % 4) {
+                  case 0: {
+                    const bool EXP = oracle.insert(key).second;
+
+                    bsl::pair<Obj::iterator, bool> rv = mX.tryEmplace(key);
+                    LOOP2_ASSERT(i, key, EXP == rv.second);
+                    LOOP2_ASSERT(i, key, key == *rv.first);
+                  } break;
+                  case 1: {
+                    const bool EXP = oracle.insert(key).second;
+
+                    bsl::pair<Obj::iterator, bool> rv = mX.insert(key);
+                    LOOP2_ASSERT(i, key, EXP == rv.second);
+                    LOOP2_ASSERT(i, key, key == *rv.first);
+                  } break;
+                  case 2: {
+                    const bsl::size_t EXP = oracle.erase(key);
+
+                    LOOP2_ASSERT(i, key, EXP == mX.erase(key));
+                  } break;
+                  default: {
+                    Obj::iterator it = mX.lower_bound(key);
+                    if (it != mX.end()) {
+                        const int                     value = *it;
+                        const bsl::set<int>::iterator next  =
+                                           oracle.erase(oracle.find(value));
+
+                        Obj::iterator rv = mX.erase(it);
+                        LOOP2_ASSERT(i, key, (next == oracle.end())
+                                                          == (rv == mX.end()));
+                        if (rv != mX.end()) {
+                            LOOP2_ASSERT(i, key, *next == *rv);
+                        }
+                    }
+                  } break;
+                }
+                LOOP_ASSERT(i, matchesOracle(X, oracle));
+            }
+        }
+
+        if (verbose) cout << "\tRange erase, clear, and capacity." << endl;
+        {
+            Obj mX(bsl::less<int>(), &sa);  const Obj& X = mX;
+
+            for (int i = 0; i < 20; ++i) {
+                mX.tryEmplace(i);
+            }
+
+            Obj::iterator rv = mX.erase(X.begin() + 5, X.begin() + 10);
+            ASSERT(15 == X.size());
+            ASSERT(10 == *rv);
+            ASSERT( 4 == *(rv - 1));
+
+            rv = mX.erase(X.begin() + 3, X.begin() + 3);
+            ASSERT(15 == X.size());
+            ASSERT( 3 == *rv);
+
+            rv = mX.erase(X.begin() + 10, X.end());
+            ASSERT(10 == X.size());
+            ASSERT(X.end() == rv);
+
+            mX.reserve(100);
+            ASSERT(100 <= X.capacity());
+
+            const bsl::size_t capacity = X.capacity();
+
+            mX.clear();
+            ASSERT(X.empty());
+            ASSERT(capacity == X.capacity());
+
+            mX.shrink_to_fit();
+            ASSERT(0 == X.capacity());
+        }
+
+        if (verbose) cout << "\tAllocator propagation." << endl;
+        {
+            StringObj mX(bsl::less<bsl::string>(), &sa);
+            const StringObj& X = mX;
+
+            const bsl::string KEY1(makeString(1), &sa);
+            bsl::string       key2(makeString(2), &sa);
+
+            mX.tryEmplace(makeString(3));
+            mX.insert(KEY1);
+            mX.insert(bslmf::MovableRefUtil::move(key2));
+
+            ASSERT(3 == X.size());
+            ASSERT(isStrictlyOrdered(X));
+
+            for (StringObj::const_iterator it = X.begin();
+                 it != X.end();
+                 ++it) {
+                ASSERT(&sa == it->get_allocator().mechanism());
+            }
+
+            bsl::pair<StringObj::iterator, bool> rv = mX.insert(KEY1);
+            ASSERT(!rv.second);
+            ASSERT(KEY1 == *rv.first);
+        }
+
+        ASSERT(0 == da.numBlocksInUse());
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING SEARCH
+        //   The branchless searches agree with the standard binary search.
+        //
+        // Concerns:
+        //: 1 'lower_bound', 'upper_bound', 'find', 'equal_range', 'contains',
+        //:   and 'count' return the correct result for every table size
+        //:   (including sizes that are not a power of two), and for keys
+        //:   before, between, equal to, and after the keys of the table.
+        //:
+        //: 2 The searches honor a non-default comparator.
+        //:
+        //: 3 The basic accessors report the state of the table.
+        //
+        // Plan:
+        //: 1 For each size from 0 to 70, create a table of the even integers
+        //:   less than twice the size, and compare the results of each search
+        //:   for every integer from -1 to twice the size, inclusive, against
+        //:   'bsl::lower_bound' and 'bsl::upper_bound'.  (C-1)
+        //:
+        //: 2 Repeat P-1 using a table ordered by 'bsl::greater'.  (C-2)
+        //:
+        //: 3 Verify the basic accessors for each table.  (C-3)
+        //
+        // Testing:
+        //   FlatTree(const COMPARATOR& comparator, *ba = 0);
+        //   ~FlatTree();
+        //   iterator find(const KEY& key);
+        //   iterator lower_bound(const KEY& key);
+        //   iterator upper_bound(const KEY& key);
+        //   iterator begin();
+        //   iterator end();
+        //   bool contains(const KEY& key) const;
+        //   size_t count(const KEY& key) const;
+        //   bool empty() const;
+        //   pair<const_iterator, const_iterator> equal_range(key) const;
+        //   const_iterator find(const KEY& key) const;
+        //   const COMPARATOR& key_comp() const;
+        //   const_iterator lower_bound(const KEY& key) const;
+        //   size_t size() const;
+        //   const_iterator upper_bound(const KEY& key) const;
+        //   const_iterator begin() const;
+        //   const_iterator end() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING SEARCH" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator da("default",  veryVeryVerbose);
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        if (verbose) cout << "\tAscending order." << endl;
+
+        for (int size = 0; size <= 70; ++size) {
+            Obj mX(bsl::less<int>(), &sa);  const Obj& X = mX;
+
+            ASSERT(&sa == X.allocator());
+
+            bsl::vector<int> model(&sa);
+            for (int i = 0; i < size; ++i) {
+                mX.tryEmplace(2 * i);
+                model.push_back(2 * i);
+            }
+
+            LOOP_ASSERT(size, static_cast<bsl::size_t>(size) == X.size());
+            LOOP_ASSERT(size, (0 == size) == X.empty());
+            LOOP_ASSERT(size, X.key_comp()(0, 1));
+
+            for (int key = -1; key <= 2 * size; ++key) {
+                const bsl::ptrdiff_t LB =
+                       bsl::lower_bound(model.begin(), model.end(), key)
+                                                              - model.begin();
+                const bsl::ptrdiff_t UB =
+                       bsl::upper_bound(model.begin(), model.end(), key)
+                                                              - model.begin();
+                const bool           FOUND = LB != UB;
+
+                LOOP2_ASSERT(size, key, LB == X.lower_bound(key) - X.begin());
+                LOOP2_ASSERT(size, key, UB == X.upper_bound(key) - X.begin());
+                LOOP2_ASSERT(size, key,
+                             LB == mX.lower_bound(key) - mX.begin());
+                LOOP2_ASSERT(size, key,
+                             UB == mX.upper_bound(key) - mX.begin());
+
+                LOOP2_ASSERT(size, key, FOUND == X.contains(key));
+                LOOP2_ASSERT(size, key,
+                             static_cast<bsl::size_t>(FOUND) == X.count(key));
+
+                if (FOUND) {
+                    LOOP2_ASSERT(size, key, key == *X.find(key));
+                    LOOP2_ASSERT(size, key, key == *mX.find(key));
+                }
+                else {
+                    LOOP2_ASSERT(size, key, X.end()  == X.find(key));
+                    LOOP2_ASSERT(size, key, mX.end() == mX.find(key));
+                }
+
+                bsl::pair<Obj::const_iterator, Obj::const_iterator> range =
+                                                         X.equal_range(key);
+                LOOP2_ASSERT(size, key, LB == range.first  - X.begin());
+                LOOP2_ASSERT(size, key, UB == range.second - X.begin());
+            }
+        }
+
+        if (verbose) cout << "\tDescending order." << endl;
+
+        for (int size = 0; size <= 70; ++size) {
+            ReverseObj mX(bsl::greater<int>(), &sa);
+            const ReverseObj& X = mX;
+
+            bsl::vector<int> model(&sa);
+            for (int i = size - 1; i >= 0; --i) {
+                mX.tryEmplace(2 * i);
+                model.push_back(2 * i);
+            }
+
+            for (int key = -1; key <= 2 * size; ++key) {
+                const bsl::ptrdiff_t LB =
+                       bsl::lower_bound(model.begin(),
+                                        model.end(),
+                                        key,
+                                        bsl::greater<int>()) - model.begin();
+                const bsl::ptrdiff_t UB =
+                       bsl::upper_bound(model.begin(),
+                                        model.end(),
+                                        key,
+                                        bsl::greater<int>()) - model.begin();
+
+                LOOP2_ASSERT(size, key, LB == X.lower_bound(key) - X.begin());
+                LOOP2_ASSERT(size, key, UB == X.upper_bound(key) - X.begin());
+                LOOP2_ASSERT(size, key, (LB != UB) == X.contains(key));
+            }
+        }
+
+        ASSERT(0 == da.numBlocksTotal());
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create a table, insert, find, bulk insert, and erase entries.
+        //:   (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+
+        Obj mX(bsl::less<int>(), &sa);  const Obj& X = mX;
+
+        ASSERT(0 == X.size());
+        ASSERT(X.begin() == X.end());
+        ASSERT(X.end() == X.find(1));
+
+        ASSERT(true  == mX.tryEmplace(3).second);
+        ASSERT(true  == mX.tryEmplace(1).second);
+        ASSERT(false == mX.tryEmplace(3).second);
+        ASSERT(true  == mX.insert(2).second);
+
+        ASSERT(3 == X.size());
+        ASSERT(1 == *X.begin());
+        ASSERT(2 == *X.find(2));
+        ASSERT(isStrictlyOrdered(X));
+
+        const int DATA[] = { 9, 0, 4, 2, 9, 7 };
+        mX.insert(DATA, DATA + sizeof DATA / sizeof *DATA);
+
+        ASSERT(7 == X.size());
+        ASSERT(isStrictlyOrdered(X));
+        ASSERT(0 == *X.begin());
+        ASSERT(9 == *(X.end() - 1));
+
+        ASSERT(1 == mX.erase(4));
+        ASSERT(0 == mX.erase(4));
+        ASSERT(6 == X.size());
+        ASSERT(7 == *X.upper_bound(4));
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
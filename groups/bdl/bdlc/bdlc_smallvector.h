@@ -0,0 +1,1983 @@
+// bdlc_smallvector.h                                                 -*-C++-*-
+
+#ifndef INCLUDED_BDLC_SMALLVECTOR
+#define INCLUDED_BDLC_SMALLVECTOR
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a vector holding its first few elements in place.
+//
+//@CLASSES:
+//  bdlc::SmallVector: sequence container having inline capacity
+//
+//@SEE_ALSO: bslstl_vector, bslalg_arrayprimitives
+//
+//@DESCRIPTION: This component provides a class template,
+// 'bdlc::SmallVector', implementing a sequence container having the interface
+// of 'bsl::vector' that holds up to a fixed number of elements, specified by
+// the 'INLINE_CAPACITY' template parameter, in a buffer embedded within the
+// object itself.  Memory is obtained from the allocator supplied at
+// construction only when the number of elements exceeds the inline capacity.
+//
+// Many objects hold a sequence that almost always has only a handful of
+// elements: the arguments of a call, the fields of a small record, the
+// children of a node in a shallow tree, etc.  Holding such a sequence in a
+// 'bsl::vector' costs an allocation and a deallocation, both virtual calls
+// through 'bslma::Allocator', per object, and an indirection (that is likely
+// a cache miss) per access.  A 'bdlc::SmallVector' whose inline capacity
+// covers the common case avoids all three, and degrades gracefully to the
+// behavior of a 'bsl::vector' when the common case does not hold.
+//
+// The elements are manipulated using the 'bslalg::ArrayPrimitives' utility
+// that also underlies 'bsl::vector'.  In particular, elements of a type
+// having the 'bslmf::IsBitwiseMoveable' trait are relocated (e.g., when the
+// sequence spills from the inline buffer to allocated memory, or when an
+// element is inserted or erased in the middle of the sequence) using
+// 'memcpy' and 'memmove' rather than element-by-element move construction and
+// destruction.
+//
+///Inline Capacity and Object Size
+///-------------------------------
+// The inline buffer is part of the footprint of every 'bdlc::SmallVector',
+// so 'sizeof(bdlc::SmallVector<TYPE, N>)' is roughly
+// 'N * sizeof(TYPE) + 4 * sizeof(void *)'.  The inline capacity should
+// therefore be chosen to cover the typical, not the maximal, number of
+// elements.  The 'capacity' of a 'bdlc::SmallVector' is never less than its
+// inline capacity, and 'shrink_to_fit' returns the elements to the inline
+// buffer when they fit.
+//
+///Iterator Invalidation
+///---------------------
+// In addition to the circumstances in which the iterators of a 'bsl::vector'
+// are invalidated, moving from (or swapping) a 'bdlc::SmallVector' whose
+// elements are held in its inline buffer invalidates all iterators,
+// references, and pointers to its elements, as the elements are relocated to
+// the other object.
+//
+///Exception Safety
+///----------------
+// Unless otherwise documented, the methods of 'bdlc::SmallVector' provide the
+// same exception-safety guarantees as the corresponding methods of
+// 'bsl::vector'.  'swap', and construction or assignment from an rvalue using
+// the same allocator, provide the no-throw guarantee if the elements of the
+// objects involved are held in allocated memory, or if 'TYPE' is bitwise
+// moveable, and the basic guarantee otherwise.
+//
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: Splitting a Path Without Allocating
+/// - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we need to split, many times per second, a file-system path into
+// its components, and we know that almost all of the paths we see have at
+// most eight components.
+//
+// First, we define a function that loads the components of a path into a
+// 'bdlc::SmallVector' having an inline capacity of 8:
+//..
+//  typedef bdlc::SmallVector<bslstl::StringRef, 8> PathComponents;
+//
+//  void splitPath(PathComponents *result, const bslstl::StringRef& path)
+//      // Load into the specified 'result' the non-empty components of the
+//      // specified 'path', delimited by '/'.
+//  {
+//      result->clear();
+//
+//      const char *begin = path.begin();
+//      for (const char *it = path.begin(); it != path.end(); ++it) {
+//          if ('/' == *it) {
+//              if (begin != it) {
+//                  result->push_back(bslstl::StringRef(begin, it));
+//              }
+//              begin = it + 1;
+//          }
+//      }
+//      if (begin != path.end()) {
+//          result->push_back(bslstl::StringRef(begin, path.end()));
+//      }
+//  }
+//..
+// Then, we create a test allocator, which we will use to verify that typical
+// paths are split without allocating memory:
+//..
+//  bslma::TestAllocator ta;
+//
+//  PathComponents components(&ta);
+//..
+// Next, we split a typical path, and observe that no memory was allocated:
+//..
+//  splitPath(&components, "/usr/local/include/bdlc_smallvector.h");
+//
+//  assert(4                     == components.size());
+//  assert("usr"                 == components[0]);
+//  assert("bdlc_smallvector.h"  == components.back());
+//  assert(components.isInline());
+//  assert(0                     == ta.numBlocksTotal());
+//..
+// Now, we split an unusually deep path, which spills to memory obtained from
+// the allocator:
+//..
+//  splitPath(&components, "a/b/c/d/e/f/g/h/i/j");
+//
+//  assert(10 == components.size());
+//  assert(!components.isInline());
+//  assert(1  == ta.numBlocksInUse());
+//..
+// Finally, we split a typical path again, and return the elements to the
+// inline buffer using 'shrink_to_fit', which releases the allocated memory:
+//..
+//  splitPath(&components, "/tmp/x");
+//  components.shrink_to_fit();
+//
+//  assert(2 == components.size());
+//  assert(components.isInline());
+//  assert(0 == ta.numBlocksInUse());
+//..
+
+#include <bdlscm_version.h>
+
+#include <bslalg_arraydestructionprimitives.h>
+#include <bslalg_arrayprimitives.h>
+
+#include <bslma_allocator.h>
+#include <bslma_constructionutil.h>
+#include <bslma_deallocatorproctor.h>
+#include <bslma_default.h>
+#include <bslma_destructionutil.h>
+#include <bslma_stdallocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_assert.h>
+#include <bslmf_matchanytype.h>
+#include <bslmf_matcharithmetictype.h>
+#include <bslmf_movableref.h>
+#include <bslmf_nestedtraitdeclaration.h>
+#include <bslmf_nil.h>
+
+#include <bsls_alignedbuffer.h>
+#include <bsls_alignmentfromtype.h>
+#include <bsls_assert.h>
+#include <bsls_compilerfeatures.h>
+#include <bsls_performancehint.h>
+
+#include <bslstl_stdexceptutil.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstddef.h>
+#include <bsl_iterator.h>
+#include <bsl_limits.h>
+
+namespace BloombergLP {
+namespace bdlc {
+
+                         // =========================
+                         // class SmallVector_Proctor
+                         // =========================
+
+template <class VECTOR>
+class SmallVector_Proctor {
+    // This class implements a proctor that, unless its 'release' method is
+    // invoked, destroys, upon destruction, the elements of a small vector and
+    // releases any memory it has allocated.
+
+    // DATA
+    VECTOR *d_vector_p;  // managed small vector, or 0 if released
+
+    // NOT IMPLEMENTED
+    SmallVector_Proctor(const SmallVector_Proctor&);
+    SmallVector_Proctor& operator=(const SmallVector_Proctor&);
+
+  public:
+    // CREATORS
+    explicit SmallVector_Proctor(VECTOR *vector);
+        // Create a proctor that, upon destruction, destroys the elements of
+        // the specified 'vector' and releases any memory it has allocated.
+
+    ~SmallVector_Proctor();
+        // Destroy this proctor and, unless 'release' has been called, destroy
+        // the elements of the managed small vector and release any memory it
+        // has allocated.
+
+    // MANIPULATORS
+    void release();
+        // Release from management the small vector managed by this proctor.
+};
+
+                             // =================
+                             // class SmallVector
+                             // =================
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+class SmallVector {
+    // This class template implements a value-semantic sequence container,
+    // having the interface of 'bsl::vector', that holds up to
+    // 'INLINE_CAPACITY' elements of the (template parameter) 'TYPE' within
+    // the object itself, and obtains memory from its allocator only to hold
+    // a larger number of elements.
+
+    BSLMF_ASSERT(0 < INLINE_CAPACITY);
+
+    // PRIVATE TYPES
+    typedef bslalg::ArrayPrimitives ArrayPrimitives;
+    typedef bsl::allocator<TYPE>    ElementAllocator;
+    typedef bslmf::MovableRefUtil   MoveUtil;
+
+    enum {
+        k_BUFFER_SIZE = INLINE_CAPACITY * sizeof(TYPE),
+        k_ALIGNMENT   = bsls::AlignmentFromType<TYPE>::VALUE
+    };
+
+    // DATA
+    TYPE                                             *d_begin_p;
+                                              // first element
+
+    TYPE                                             *d_end_p;
+                                              // past-the-end element
+
+    bsl::size_t                                       d_capacity;
+                                              // number of elements the
+                                              // storage at 'd_begin_p' can
+                                              // hold
+
+    bsls::AlignedBuffer<k_BUFFER_SIZE, k_ALIGNMENT>   d_inlineBuffer;
+                                              // storage for up to
+                                              // 'INLINE_CAPACITY' elements
+
+    bslma::Allocator                                 *d_allocator_p;
+                                              // memory allocator (held, not
+                                              // owned)
+
+    // PRIVATE MANIPULATORS
+    TYPE *allocateStorage(bsl::size_t capacity);
+        // Return the address of uninitialized memory, obtained from the
+        // allocator of this object, sufficient to hold the specified
+        // 'capacity' elements.
+
+    void adoptStorage(TYPE        *storage,
+                      bsl::size_t  size,
+                      bsl::size_t  capacity);
+        // Release the memory (if any) allocated by this object, and make the
+        // specified 'storage', holding the specified 'size' elements and
+        // sufficient to hold the specified 'capacity' elements, the storage of
+        // this object.  The behavior is undefined unless the elements held in
+        // the current storage of this object have been destroyed or
+        // relocated.
+
+    TYPE *inlineData();
+        // Return the address of the inline buffer of this object.
+
+    template <class INPUT_ITER>
+    void insertDispatch(const TYPE                    *position,
+                        INPUT_ITER                     count,
+                        INPUT_ITER                     value,
+                        bslmf::MatchArithmeticType     ,
+                        bslmf::Nil                     );
+    template <class INPUT_ITER>
+    void insertDispatch(const TYPE                    *position,
+                        INPUT_ITER                     first,
+                        INPUT_ITER                     last,
+                        bslmf::MatchAnyType            ,
+                        bslmf::MatchAnyType            );
+        // Insert at the specified 'position' either the specified 'count'
+        // copies of the specified 'value', if the (template parameter)
+        // 'INPUT_ITER' is an arithmetic type, or the elements in the range
+        // starting at the specified 'first' and ending immediately before the
+        // specified 'last', otherwise.
+
+    template <class INPUT_ITER>
+    void insertRange(const TYPE                     *position,
+                     INPUT_ITER                      first,
+                     INPUT_ITER                      last,
+                     const bsl::input_iterator_tag&);
+    template <class INPUT_ITER>
+    void insertRange(const TYPE                       *position,
+                     INPUT_ITER                        first,
+                     INPUT_ITER                        last,
+                     const bsl::forward_iterator_tag&);
+        // Insert at the specified 'position' the elements in the range
+        // starting at the specified 'first' and ending immediately before the
+        // specified 'last'.  Note that the overload for input iterators
+        // appends each element and then rotates the appended elements into
+        // place, as the length of the range cannot be computed in advance.
+
+    void relocateFrom(SmallVector *original);
+        // Move the elements of the specified 'original' object to this
+        // object, leaving 'original' empty.  If the elements of 'original' are
+        // held in allocated memory, that memory is transferred to this object;
+        // otherwise, the elements are relocated from the inline buffer of
+        // 'original' to the inline buffer of this object.  The behavior is
+        // undefined unless this object is empty, its elements are held in its
+        // inline buffer, and it uses the same allocator as 'original'.
+
+    // PRIVATE ACCESSORS
+    bsl::size_t computeNewCapacity(bsl::size_t newSize) const;
+        // Return the capacity to which to grow this object in order to hold
+        // the specified 'newSize' elements, which is at least twice the
+        // current capacity (up to 'max_size()').  Throw 'bsl::length_error' if
+        // 'max_size() < newSize'.
+
+    ElementAllocator elementAllocator() const;
+        // Return the allocator of this object as an allocator suitable for
+        // the methods of 'bslalg::ArrayPrimitives'.
+
+    const TYPE *inlineData() const;
+        // Return the address of the inline buffer of this object.
+
+  public:
+    // TYPES
+    typedef TYPE                                  value_type;
+    typedef TYPE&                                 reference;
+    typedef const TYPE&                           const_reference;
+    typedef TYPE                                 *pointer;
+    typedef const TYPE                           *const_pointer;
+    typedef TYPE                                 *iterator;
+    typedef const TYPE                           *const_iterator;
+    typedef bsl::reverse_iterator<iterator>       reverse_iterator;
+    typedef bsl::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef bsl::size_t                           size_type;
+    typedef bsl::ptrdiff_t                        difference_type;
+
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(SmallVector, bslma::UsesBslmaAllocator);
+
+    // CLASS METHODS
+    static size_type inlineCapacity();
+        // Return the number of elements a 'SmallVector' can hold without
+        // allocating memory, i.e., 'INLINE_CAPACITY'.
+
+    // CREATORS
+    SmallVector();
+    explicit SmallVector(bslma::Allocator *basicAllocator);
+        // Create an empty small vector.  Optionally specify a
+        // 'basicAllocator' used to supply memory should the number of elements
+        // exceed 'INLINE_CAPACITY'.  If 'basicAllocator' is 0, the currently
+        // installed default allocator is used.
+
+    explicit SmallVector(size_type         initialSize,
+                         bslma::Allocator *basicAllocator = 0);
+        // Create a small vector holding the specified 'initialSize'
+        // value-initialized elements.  Optionally specify a 'basicAllocator'
+        // used to supply memory.  If 'basicAllocator' is 0, the currently
+        // installed default allocator is used.
+
+    SmallVector(size_type         initialSize,
+                const TYPE&       value,
+                bslma::Allocator *basicAllocator = 0);
+        // Create a small vector holding the specified 'initialSize' copies of
+        // the specified 'value'.  Optionally specify a 'basicAllocator' used
+        // to supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.
+
+    template <class INPUT_ITER>
+    SmallVector(INPUT_ITER        first,
+                INPUT_ITER        last,
+                bslma::Allocator *basicAllocator = 0);
+        // Create a small vector holding, in order, the elements in the range
+        // starting at the specified 'first' and ending immediately before the
+        // specified 'last'.  Optionally specify a 'basicAllocator' used to
+        // supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.  The behavior is undefined unless
+        // '[first .. last)' is a valid range and its elements are
+        // convertible to 'TYPE'.  Note that if the (template parameter)
+        // 'INPUT_ITER' is an arithmetic type, this constructor behaves as the
+        // constructor taking a size and a value.
+
+    SmallVector(const SmallVector&  original,
+                bslma::Allocator   *basicAllocator = 0);
+        // Create a small vector having the same value as the specified
+        // 'original' object.  Optionally specify a 'basicAllocator' used to
+        // supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.
+
+    SmallVector(bslmf::MovableRef<SmallVector> original);
+        // Create a small vector having the same value as the specified
+        // 'original' object by moving (in constant time) the contents of
+        // 'original' to the new object.  The allocator associated with
+        // 'original' is propagated for use in the newly-created object.
+        // 'original' is left empty.  Note that, if the elements of 'original'
+        // are held in its inline buffer, they are relocated to the inline
+        // buffer of the new object, which for a type that is not bitwise
+        // moveable invokes the move constructor of each element.
+
+    SmallVector(bslmf::MovableRef<SmallVector>  original,
+                bslma::Allocator               *basicAllocator);
+        // Create a small vector having the same value as the specified
+        // 'original' object that uses the specified 'basicAllocator' to
+        // supply memory.  The contents of 'original' are moved to the newly
+        // created object as described above if 'basicAllocator' is the
+        // allocator of 'original', and are move-inserted (in linear time)
+        // into the newly created object otherwise, leaving 'original' in a
+        // valid but unspecified state.  If 'basicAllocator' is 0, the
+        // currently installed default allocator is used.
+
+    ~SmallVector();
+        // Destroy this object and each of its elements.
+
+    // MANIPULATORS
+    SmallVector& operator=(const SmallVector& rhs);
+        // Assign to this object the value of the specified 'rhs' object, and
+        // return a reference providing modifiable access to this object.
+        // Memory is allocated only if the capacity of this object is
+        // insufficient to hold the elements of 'rhs'.
+
+    SmallVector& operator=(bslmf::MovableRef<SmallVector> rhs);
+        // Assign to this object the value of the specified 'rhs' object, and
+        // return a reference providing modifiable access to this object.  The
+        // contents of 'rhs' are moved to this object as described for the
+        // move constructor if 'rhs' uses the same allocator as this object,
+        // and are move-inserted (in linear time) into this object otherwise,
+        // leaving 'rhs' in a valid but unspecified state.
+
+    reference operator[](size_type position);
+        // Return a reference providing modifiable access to the element at the
+        // specified 'position' in this object.  The behavior is undefined
+        // unless 'position < size()'.
+
+    void assign(size_type numElements, const TYPE& value);
+        // Assign to this object the value of a sequence holding the specified
+        // 'numElements' copies of the specified 'value'.
+
+    template <class INPUT_ITER>
+    void assign(INPUT_ITER first, INPUT_ITER last);
+        // Assign to this object the value of the sequence of elements in the
+        // range starting at the specified 'first' and ending immediately
+        // before the specified 'last'.  The behavior is undefined unless
+        // '[first .. last)' is a valid range that does not refer to the
+        // elements of this object.
+
+    reference at(size_type position);
+        // Return a reference providing modifiable access to the element at the
+        // specified 'position' in this object.  Throw 'bsl::out_of_range' if
+        // 'size() <= position'.
+
+    reference back();
+        // Return a reference providing modifiable access to the last element
+        // of this object.  The behavior is undefined unless this object is not
+        // empty.
+
+    iterator begin();
+        // Return an iterator to the first element of this object, or the
+        // 'end' iterator if this object is empty.
+
+    void clear();
+        // Destroy each element of this object, leaving it empty.  Note that
+        // the capacity of this object is not changed.
+
+    pointer data();
+        // Return the address of the (modifiable) first element of this
+        // object.
+
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES
+    template <class... ARGS>
+    iterator emplace(const_iterator position, ARGS&&... arguments);
+        // Insert at the specified 'position' in this object an element
+        // constructed by forwarding the allocator of this object (if 'TYPE'
+        // uses one) and the specified (variable number of) 'arguments' to
+        // the corresponding constructor of 'TYPE', and return an iterator to
+        // the inserted element.  The behavior is undefined unless 'position'
+        // is an iterator in the range '[begin() .. end()]', and no argument
+        // refers to an element of this object.
+
+    template <class... ARGS>
+    reference emplace_back(ARGS&&... arguments);
+        // Append to this object an element constructed by forwarding the
+        // allocator of this object (if 'TYPE' uses one) and the specified
+        // (variable number of) 'arguments' to the corresponding constructor of
+        // 'TYPE', and return a reference providing modifiable access to the
+        // appended element.
+#else
+    iterator emplace(const_iterator position);
+    template <class ARG1>
+    iterator emplace(const_iterator                          position,
+                     BSLS_COMPILERFEATURES_FORWARD_REF(ARG1) arg1);
+        // Insert at the specified 'position' in this object an element
+        // constructed by forwarding the allocator of this object (if 'TYPE'
+        // uses one) and the optionally specified 'arg1' to the corresponding
+        // constructor of 'TYPE', and return an iterator to the inserted
+        // element.  The behavior is undefined unless 'position' is an iterator
+        // in the range '[begin() .. end()]', and 'arg1' does not refer to an
+        // element of this object.
+
+    reference emplace_back();
+    template <class ARG1>
+    reference emplace_back(BSLS_COMPILERFEATURES_FORWARD_REF(ARG1) arg1);
+        // Append to this object an element constructed by forwarding the
+        // allocator of this object (if 'TYPE' uses one) and the optionally
+        // specified 'arg1' to the corresponding constructor of 'TYPE', and
+        // return a reference providing modifiable access to the appended
+        // element.
+#endif
+
+    iterator end();
+        // Return the past-the-end iterator of this object.
+
+    iterator erase(const_iterator position);
+        // Remove from this object the element at the specified 'position',
+        // and return an iterator to the element that followed it.  The
+        // behavior is undefined unless 'position' is an iterator in the range
+        // '[begin() .. end())'.
+
+    iterator erase(const_iterator first, const_iterator last);
+        // Remove from this object the elements starting at the specified
+        // 'first' position and ending immediately before the specified 'last'
+        // position, and return an iterator to the element that followed the
+        // removed elements.  The behavior is undefined unless
+        // '[first .. last)' is a valid range of iterators of this object.
+
+    reference front();
+        // Return a reference providing modifiable access to the first element
+        // of this object.  The behavior is undefined unless this object is not
+        // empty.
+
+    iterator insert(const_iterator position, const TYPE& value);
+    iterator insert(const_iterator position, bslmf::MovableRef<TYPE> value);
+        // Insert at the specified 'position' in this object a copy of (or,
+        // for the second overload, the value moved from) the specified
+        // 'value', and return an iterator to the inserted element.  The
+        // behavior is undefined unless 'position' is an iterator in the range
+        // '[begin() .. end()]'.  Note that, unlike 'emplace', these methods
+        // may be passed a reference to an element of this object.
+
+    iterator insert(const_iterator  position,
+                    size_type       numElements,
+                    const TYPE&     value);
+        // Insert at the specified 'position' in this object the specified
+        // 'numElements' copies of the specified 'value', and return an
+        // iterator to the first inserted element (or 'position' if
+        // 'numElements' is 0).  The behavior is undefined unless 'position' is
+        // an iterator in the range '[begin() .. end()]'.
+
+    template <class INPUT_ITER>
+    iterator insert(const_iterator position,
+                    INPUT_ITER     first,
+                    INPUT_ITER     last);
+        // Insert at the specified 'position' in this object the elements in
+        // the range starting at the specified 'first' and ending immediately
+        // before the specified 'last', and return an iterator to the first
+        // inserted element (or 'position' if the range is empty).  The
+        // behavior is undefined unless 'position' is an iterator in the range
+        // '[begin() .. end()]', and '[first .. last)' is a valid range that
+        // does not refer to the elements of this object.
+
+    void pop_back();
+        // Remove the last element of this object.  The behavior is undefined
+        // unless this object is not empty.
+
+    void push_back(const TYPE& value);
+    void push_back(bslmf::MovableRef<TYPE> value);
+        // Append to this object a copy of (or, for the second overload, the
+        // value moved from) the specified 'value'.
+
+    reverse_iterator rbegin();
+        // Return a reverse iterator to the last element of this object, or
+        // the 'rend' iterator if this object is empty.
+
+    reverse_iterator rend();
+        // Return the past-the-end reverse iterator of this object.
+
+    void reserve(size_type newCapacity);
+        // Change the capacity of this object to at least the specified
+        // 'newCapacity'.  This method has no effect if
+        // 'newCapacity <= capacity()'.  Throw 'bsl::length_error' if
+        // 'max_size() < newCapacity'.
+
+    void resize(size_type newSize);
+        // Change the size of this object to the specified 'newSize', removing
+        // trailing elements if 'newSize < size()', and appending
+        // value-initialized elements if 'size() < newSize'.
+
+    void resize(size_type newSize, const TYPE& value);
+        // Change the size of this object to the specified 'newSize', removing
+        // trailing elements if 'newSize < size()', and appending copies of the
+        // specified 'value' if 'size() < newSize'.
+
+    void shrink_to_fit();
+        // Minimize the memory used by this object: if the elements fit in the
+        // inline buffer, relocate them there and release any allocated
+        // memory; otherwise, reduce the capacity of this object to its size.
+
+                                  // Aspects
+
+    void swap(SmallVector& other);
+        // Exchange the value of this object with that of the specified
+        // 'other' object.  This method provides the no-throw exception-safety
+        // guarantee if the elements of both objects are held in allocated
+        // memory or if 'TYPE' is bitwise moveable, and the basic guarantee
+        // otherwise.  The behavior is undefined unless this object was
+        // created with the same allocator as 'other'.
+
+    // ACCESSORS
+    const_reference operator[](size_type position) const;
+        // Return a reference providing non-modifiable access to the element at
+        // the specified 'position' in this object.  The behavior is undefined
+        // unless 'position < size()'.
+
+    const_reference at(size_type position) const;
+        // Return a reference providing non-modifiable access to the element at
+        // the specified 'position' in this object.  Throw 'bsl::out_of_range'
+        // if 'size() <= position'.
+
+    const_reference back() const;
+        // Return a reference providing non-modifiable access to the last
+        // element of this object.  The behavior is undefined unless this
+        // object is not empty.
+
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+        // Return an iterator to the first element of this object, or the
+        // 'end' iterator if this object is empty.
+
+    size_type capacity() const;
+        // Return the number of elements this object can hold without
+        // allocating memory.  Note that the capacity is never less than
+        // 'INLINE_CAPACITY'.
+
+    const_iterator cend() const;
+    const_iterator end() const;
+        // Return the past-the-end iterator of this object.
+
+    const_reverse_iterator crbegin() const;
+    const_reverse_iterator rbegin() const;
+        // Return a reverse iterator to the last element of this object, or
+        // the 'rend' iterator if this object is empty.
+
+    const_reverse_iterator crend() const;
+    const_reverse_iterator rend() const;
+        // Return the past-the-end reverse iterator of this object.
+
+    const_pointer data() const;
+        // Return the address of the (non-modifiable) first element of this
+        // object.
+
+    bool empty() const;
+        // Return 'true' if this object has no elements, and 'false'
+        // otherwise.
+
+    const_reference front() const;
+        // Return a reference providing non-modifiable access to the first
+        // element of this object.  The behavior is undefined unless this
+        // object is not empty.
+
+    bool isInline() const;
+        // Return 'true' if the elements of this object are held in its inline
+        // buffer, and 'false' if they are held in memory obtained from its
+        // allocator.
+
+    size_type max_size() const;
+        // Return the maximum number of elements this object can hold.
+
+    size_type size() const;
+        // Return the number of elements in this object.
+
+                                  // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this object to supply memory.
+};
+
+// FREE OPERATORS
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+bool operator==(const SmallVector<TYPE, INLINE_CAPACITY>& lhs,
+                const SmallVector<TYPE, INLINE_CAPACITY>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects have the same
+    // value, and 'false' otherwise.  Two 'SmallVector' objects have the same
+    // value if they have the same size and each element of one is equal
+    // (using 'operator==' on 'TYPE') to the element at the same position in
+    // the other.
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+bool operator!=(const SmallVector<TYPE, INLINE_CAPACITY>& lhs,
+                const SmallVector<TYPE, INLINE_CAPACITY>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects do not have the
+    // same value, and 'false' otherwise.  Two 'SmallVector' objects do not
+    // have the same value if they do not have the same size or some element
+    // of one is not equal to the element at the same position in the other.
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+bool operator<(const SmallVector<TYPE, INLINE_CAPACITY>& lhs,
+               const SmallVector<TYPE, INLINE_CAPACITY>& rhs);
+    // Return 'true' if the value of the specified 'lhs' object is
+    // lexicographically less than that of the specified 'rhs' object (using
+    // 'operator<' on 'TYPE'), and 'false' otherwise.
+
+// FREE FUNCTIONS
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+void swap(SmallVector<TYPE, INLINE_CAPACITY>& a,
+          SmallVector<TYPE, INLINE_CAPACITY>& b);
+    // Exchange the values of the specified 'a' and 'b' objects.  This
+    // function provides the no-throw exception-safety guarantee under the
+    // conditions documented for the 'swap' method if the two objects were
+    // created with the same allocator, and the basic guarantee otherwise.
+
+// ============================================================================
+//                           INLINE DEFINITIONS
+// ============================================================================
+
+                         // -------------------------
+                         // class SmallVector_Proctor
+                         // -------------------------
+
+// CREATORS
+template <class VECTOR>
+inline
+SmallVector_Proctor<VECTOR>::SmallVector_Proctor(VECTOR *vector)
+: d_vector_p(vector)
+{
+}
+
+template <class VECTOR>
+inline
+SmallVector_Proctor<VECTOR>::~SmallVector_Proctor()
+{
+    if (d_vector_p) {
+        d_vector_p->clear();
+        d_vector_p->shrink_to_fit();
+    }
+}
+
+// MANIPULATORS
+template <class VECTOR>
+inline
+void SmallVector_Proctor<VECTOR>::release()
+{
+    d_vector_p = 0;
+}
+
+                             // -----------------
+                             // class SmallVector
+                             // -----------------
+
+// PRIVATE MANIPULATORS
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+TYPE *SmallVector<TYPE, INLINE_CAPACITY>::allocateStorage(
+                                                        bsl::size_t capacity)
+{
+    return static_cast<TYPE *>(d_allocator_p->allocate(capacity
+                                                              * sizeof(TYPE)));
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+void SmallVector<TYPE, INLINE_CAPACITY>::adoptStorage(TYPE        *storage,
+                                                      bsl::size_t  size,
+                                                      bsl::size_t  capacity)
+{
+    if (!isInline()) {
+        d_allocator_p->deallocate(d_begin_p);
+    }
+    d_begin_p  = storage;
+    d_end_p    = storage + size;
+    d_capacity = capacity;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+TYPE *SmallVector<TYPE, INLINE_CAPACITY>::inlineData()
+{
+    return reinterpret_cast<TYPE *>(d_inlineBuffer.buffer());
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+template <class INPUT_ITER>
+inline
+void SmallVector<TYPE, INLINE_CAPACITY>::insertDispatch(
+                                     const_iterator             position,
+                                     INPUT_ITER                 count,
+                                     INPUT_ITER                 value,
+                                     bslmf::MatchArithmeticType ,
+                                     bslmf::Nil                 )
+{
+    insert(position,
+           static_cast<size_type>(count),
+           static_cast<TYPE>(value));
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+template <class INPUT_ITER>
+inline
+void SmallVector<TYPE, INLINE_CAPACITY>::insertDispatch(
+                                            const_iterator      position,
+                                            INPUT_ITER          first,
+                                            INPUT_ITER          last,
+                                            bslmf::MatchAnyType ,
+                                            bslmf::MatchAnyType )
+{
+    typedef typename bsl::iterator_traits<INPUT_ITER>::iterator_category Tag;
+
+    insertRange(position, first, last, Tag());
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+template <class INPUT_ITER>
+void SmallVector<TYPE, INLINE_CAPACITY>::insertRange(
+                                      const_iterator                  position,
+                                      INPUT_ITER                      first,
+                                      INPUT_ITER                      last,
+                                      const bsl::input_iterator_tag&)
+{
+    const size_type index   = position - d_begin_p;
+    const size_type oldSize = size();
+
+    for (; first != last; ++first) {
+        emplace_back(*first);
+    }
+
+    ArrayPrimitives::rotate(d_begin_p + index, d_begin_p + oldSize, d_end_p);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+template <class INPUT_ITER>
+void SmallVector<TYPE, INLINE_CAPACITY>::insertRange(
+                                    const_iterator                    position,
+                                    INPUT_ITER                        first,
+                                    INPUT_ITER                        last,
+                                    const bsl::forward_iterator_tag&)
+{
+    const size_type numElements = bsl::distance(first, last);
+
+    if (0 == numElements) {
+        return;                                                       // RETURN
+    }
+
+    TYPE *pos = const_cast<TYPE *>(position);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                                      numElements > d_capacity - size())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        if (numElements > max_size() - size()) {
+            bslstl::StdExceptUtil::throwLengthError(
+                        "SmallVector<...>::insert(pos,first,last): too long");
+        }
+
+        const size_type newSize     = size() + numElements;
+        const size_type newCapacity = computeNewCapacity(newSize);
+
+        TYPE *storage = allocateStorage(newCapacity);
+        bslma::DeallocatorProctor<bslma::Allocator> proctor(storage,
+                                                            d_allocator_p);
+
+        ArrayPrimitives::destructiveMoveAndInsert(storage,
+                                                  &d_end_p,
+                                                  d_begin_p,
+                                                  pos,
+                                                  d_end_p,
+                                                  first,
+                                                  last,
+                                                  numElements,
+                                                  elementAllocator());
+        proctor.release();
+
+        adoptStorage(storage, newSize, newCapacity);
+    }
+    else {
+        ArrayPrimitives::insert(pos,
+                                d_end_p,
+                                first,
+                                last,
+                                numElements,
+                                elementAllocator());
+        d_end_p += numElements;
+    }
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+void SmallVector<TYPE, INLINE_CAPACITY>::relocateFrom(SmallVector *original)
+{
+    BSLS_ASSERT_SAFE(original);
+    BSLS_ASSERT_SAFE(empty());
+    BSLS_ASSERT_SAFE(isInline());
+    BSLS_ASSERT_SAFE(allocator() == original->allocator());
+
+    if (!original->isInline()) {
+        d_begin_p  = original->d_begin_p;
+        d_end_p    = original->d_end_p;
+        d_capacity = original->d_capacity;
+
+        original->d_begin_p  = original->inlineData();
+        original->d_end_p    = original->d_begin_p;
+        original->d_capacity = INLINE_CAPACITY;
+
+        return;                                                       // RETURN
+    }
+
+    ArrayPrimitives::destructiveMove(d_begin_p,
+                                     original->d_begin_p,
+                                     original->d_end_p,
+                                     elementAllocator());
+
+    d_end_p           = d_begin_p + original->size();
+    original->d_end_p = original->d_begin_p;
+}
+
+// PRIVATE ACCESSORS
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+bsl::size_t SmallVector<TYPE, INLINE_CAPACITY>::computeNewCapacity(
+                                                   bsl::size_t newSize) const
+{
+    const size_type maxSize = max_size();
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(newSize > maxSize)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        bslstl::StdExceptUtil::throwLengthError(
+                                              "SmallVector<...>: too long");
+    }
+
+    const size_type doubled = d_capacity <= maxSize / 2
+                            ? 2 * d_capacity
+                            : maxSize;
+
+    return doubled < newSize ? newSize : doubled;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::ElementAllocator
+SmallVector<TYPE, INLINE_CAPACITY>::elementAllocator() const
+{
+    return ElementAllocator(d_allocator_p);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+const TYPE *SmallVector<TYPE, INLINE_CAPACITY>::inlineData() const
+{
+    return reinterpret_cast<const TYPE *>(d_inlineBuffer.buffer());
+}
+
+// CLASS METHODS
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::size_type
+SmallVector<TYPE, INLINE_CAPACITY>::inlineCapacity()
+{
+    return INLINE_CAPACITY;
+}
+
+// CREATORS
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+SmallVector<TYPE, INLINE_CAPACITY>::SmallVector()
+: d_begin_p(inlineData())
+, d_end_p(d_begin_p)
+, d_capacity(INLINE_CAPACITY)
+, d_allocator_p(bslma::Default::allocator())
+{
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+SmallVector<TYPE, INLINE_CAPACITY>::SmallVector(
+                                              bslma::Allocator *basicAllocator)
+: d_begin_p(inlineData())
+, d_end_p(d_begin_p)
+, d_capacity(INLINE_CAPACITY)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+SmallVector<TYPE, INLINE_CAPACITY>::SmallVector(
+                                              size_type         initialSize,
+                                              bslma::Allocator *basicAllocator)
+: d_begin_p(inlineData())
+, d_end_p(d_begin_p)
+, d_capacity(INLINE_CAPACITY)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    SmallVector_Proctor<SmallVector> proctor(this);
+
+    resize(initialSize);
+
+    proctor.release();
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+SmallVector<TYPE, INLINE_CAPACITY>::SmallVector(
+                                              size_type         initialSize,
+                                              const TYPE&       value,
+                                              bslma::Allocator *basicAllocator)
+: d_begin_p(inlineData())
+, d_end_p(d_begin_p)
+, d_capacity(INLINE_CAPACITY)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    SmallVector_Proctor<SmallVector> proctor(this);
+
+    insert(d_end_p, initialSize, value);
+
+    proctor.release();
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+template <class INPUT_ITER>
+SmallVector<TYPE, INLINE_CAPACITY>::SmallVector(
+                                              INPUT_ITER        first,
+                                              INPUT_ITER        last,
+                                              bslma::Allocator *basicAllocator)
+: d_begin_p(inlineData())
+, d_end_p(d_begin_p)
+, d_capacity(INLINE_CAPACITY)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    SmallVector_Proctor<SmallVector> proctor(this);
+
+    insert(d_end_p, first, last);
+
+    proctor.release();
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+SmallVector<TYPE, INLINE_CAPACITY>::SmallVector(
+                                          const SmallVector&  original,
+                                          bslma::Allocator   *basicAllocator)
+: d_begin_p(inlineData())
+, d_end_p(d_begin_p)
+, d_capacity(INLINE_CAPACITY)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    SmallVector_Proctor<SmallVector> proctor(this);
+
+    reserve(original.size());
+
+    ArrayPrimitives::copyConstruct(d_begin_p,
+                                   original.d_begin_p,
+                                   original.d_end_p,
+                                   elementAllocator());
+    d_end_p = d_begin_p + original.size();
+
+    proctor.release();
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+SmallVector<TYPE, INLINE_CAPACITY>::SmallVector(
+                                      bslmf::MovableRef<SmallVector> original)
+: d_begin_p(inlineData())
+, d_end_p(d_begin_p)
+, d_capacity(INLINE_CAPACITY)
+, d_allocator_p(MoveUtil::access(original).d_allocator_p)
+{
+    relocateFrom(&MoveUtil::access(original));
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+SmallVector<TYPE, INLINE_CAPACITY>::SmallVector(
+                               bslmf::MovableRef<SmallVector>  original,
+                               bslma::Allocator               *basicAllocator)
+: d_begin_p(inlineData())
+, d_end_p(d_begin_p)
+, d_capacity(INLINE_CAPACITY)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    SmallVector& lvalue = original;
+
+    if (d_allocator_p == lvalue.d_allocator_p) {
+        relocateFrom(&lvalue);
+    }
+    else {
+        SmallVector_Proctor<SmallVector> proctor(this);
+
+        reserve(lvalue.size());
+
+        ArrayPrimitives::moveConstruct(d_begin_p,
+                                       lvalue.d_begin_p,
+                                       lvalue.d_end_p,
+                                       elementAllocator());
+        d_end_p = d_begin_p + lvalue.size();
+
+        proctor.release();
+    }
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+SmallVector<TYPE, INLINE_CAPACITY>::~SmallVector()
+{
+    bslalg::ArrayDestructionPrimitives::destroy(d_begin_p, d_end_p);
+
+    if (!isInline()) {
+        d_allocator_p->deallocate(d_begin_p);
+    }
+}
+
+// MANIPULATORS
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+SmallVector<TYPE, INLINE_CAPACITY>&
+SmallVector<TYPE, INLINE_CAPACITY>::operator=(const SmallVector& rhs)
+{
+    if (this != &rhs) {
+        assign(rhs.d_begin_p, rhs.d_end_p);
+    }
+    return *this;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+SmallVector<TYPE, INLINE_CAPACITY>&
+SmallVector<TYPE, INLINE_CAPACITY>::operator=(
+                                           bslmf::MovableRef<SmallVector> rhs)
+{
+    SmallVector& lvalue = rhs;
+
+    if (this != &lvalue) {
+        SmallVector other(MoveUtil::move(lvalue), d_allocator_p);
+
+        clear();
+        shrink_to_fit();
+        relocateFrom(&other);
+    }
+    return *this;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::reference
+SmallVector<TYPE, INLINE_CAPACITY>::operator[](size_type position)
+{
+    BSLS_ASSERT_SAFE(position < size());
+
+    return d_begin_p[position];
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+void SmallVector<TYPE, INLINE_CAPACITY>::assign(size_type   numElements,
+                                                const TYPE& value)
+{
+    if (numElements <= size()) {
+        bsl::fill_n(d_begin_p, numElements, value);
+        erase(d_begin_p + numElements, d_end_p);
+    }
+    else if (numElements <= d_capacity) {
+        bsl::fill(d_begin_p, d_end_p, value);
+        insert(d_end_p, numElements - size(), value);
+    }
+    else {
+        // 'value' may refer to an element of this object, so the new elements
+        // are created before the existing ones are destroyed.
+
+        SmallVector other(numElements, value, d_allocator_p);
+
+        clear();
+        shrink_to_fit();
+        relocateFrom(&other);
+    }
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+template <class INPUT_ITER>
+inline
+void SmallVector<TYPE, INLINE_CAPACITY>::assign(INPUT_ITER first,
+                                                INPUT_ITER last)
+{
+    clear();
+    insert(d_end_p, first, last);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+typename SmallVector<TYPE, INLINE_CAPACITY>::reference
+SmallVector<TYPE, INLINE_CAPACITY>::at(size_type position)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(position >= size())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        bslstl::StdExceptUtil::throwOutOfRange(
+                        "SmallVector<...>::at(position): invalid position");
+    }
+    return d_begin_p[position];
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::reference
+SmallVector<TYPE, INLINE_CAPACITY>::back()
+{
+    BSLS_ASSERT_SAFE(!empty());
+
+    return d_end_p[-1];
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::iterator
+SmallVector<TYPE, INLINE_CAPACITY>::begin()
+{
+    return d_begin_p;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+void SmallVector<TYPE, INLINE_CAPACITY>::clear()
+{
+    bslalg::ArrayDestructionPrimitives::destroy(d_begin_p, d_end_p);
+    d_end_p = d_begin_p;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::pointer
+SmallVector<TYPE, INLINE_CAPACITY>::data()
+{
+    return d_begin_p;
+}
+
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+template <class... ARGS>
+typename SmallVector<TYPE, INLINE_CAPACITY>::iterator
+SmallVector<TYPE, INLINE_CAPACITY>::emplace(const_iterator position,
+                                            ARGS&&...      arguments)
+{
+    BSLS_ASSERT_SAFE(d_begin_p <= position);
+    BSLS_ASSERT_SAFE(position  <= d_end_p);
+
+    const size_type index = position - d_begin_p;
+    TYPE           *pos   = const_cast<TYPE *>(position);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(size() == d_capacity)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        const size_type newSize     = size() + 1;
+        const size_type newCapacity = computeNewCapacity(newSize);
+
+        TYPE *storage = allocateStorage(newCapacity);
+        bslma::DeallocatorProctor<bslma::Allocator> proctor(storage,
+                                                            d_allocator_p);
+
+        ArrayPrimitives::destructiveMoveAndEmplace(
+                          storage,
+                          &d_end_p,
+                          d_begin_p,
+                          pos,
+                          d_end_p,
+                          elementAllocator(),
+                          BSLS_COMPILERFEATURES_FORWARD(ARGS, arguments)...);
+        proctor.release();
+
+        adoptStorage(storage, newSize, newCapacity);
+    }
+    else {
+        ArrayPrimitives::emplace(
+                          pos,
+                          d_end_p,
+                          elementAllocator(),
+                          BSLS_COMPILERFEATURES_FORWARD(ARGS, arguments)...);
+        ++d_end_p;
+    }
+
+    return d_begin_p + index;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+template <class... ARGS>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::reference
+SmallVector<TYPE, INLINE_CAPACITY>::emplace_back(ARGS&&... arguments)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(size() < d_capacity)) {
+        bslma::ConstructionUtil::construct(
+                          d_end_p,
+                          d_allocator_p,
+                          BSLS_COMPILERFEATURES_FORWARD(ARGS, arguments)...);
+        ++d_end_p;
+        return d_end_p[-1];                                           // RETURN
+    }
+
+    return *emplace(d_end_p,
+                    BSLS_COMPILERFEATURES_FORWARD(ARGS, arguments)...);
+}
+#else
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+typename SmallVector<TYPE, INLINE_CAPACITY>::iterator
+SmallVector<TYPE, INLINE_CAPACITY>::emplace(const_iterator position)
+{
+    BSLS_ASSERT_SAFE(d_begin_p <= position);
+    BSLS_ASSERT_SAFE(position  <= d_end_p);
+
+    const size_type index = position - d_begin_p;
+    TYPE           *pos   = const_cast<TYPE *>(position);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(size() == d_capacity)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        const size_type newSize     = size() + 1;
+        const size_type newCapacity = computeNewCapacity(newSize);
+
+        TYPE *storage = allocateStorage(newCapacity);
+        bslma::DeallocatorProctor<bslma::Allocator> proctor(storage,
+                                                            d_allocator_p);
+
+        ArrayPrimitives::destructiveMoveAndEmplace(storage,
+                                                   &d_end_p,
+                                                   d_begin_p,
+                                                   pos,
+                                                   d_end_p,
+                                                   elementAllocator());
+        proctor.release();
+
+        adoptStorage(storage, newSize, newCapacity);
+    }
+    else {
+        ArrayPrimitives::emplace(pos, d_end_p, elementAllocator());
+        ++d_end_p;
+    }
+
+    return d_begin_p + index;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+template <class ARG1>
+typename SmallVector<TYPE, INLINE_CAPACITY>::iterator
+SmallVector<TYPE, INLINE_CAPACITY>::emplace(
+                          const_iterator                          position,
+                          BSLS_COMPILERFEATURES_FORWARD_REF(ARG1) arg1)
+{
+    BSLS_ASSERT_SAFE(d_begin_p <= position);
+    BSLS_ASSERT_SAFE(position  <= d_end_p);
+
+    const size_type index = position - d_begin_p;
+    TYPE           *pos   = const_cast<TYPE *>(position);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(size() == d_capacity)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        const size_type newSize     = size() + 1;
+        const size_type newCapacity = computeNewCapacity(newSize);
+
+        TYPE *storage = allocateStorage(newCapacity);
+        bslma::DeallocatorProctor<bslma::Allocator> proctor(storage,
+                                                            d_allocator_p);
+
+        ArrayPrimitives::destructiveMoveAndEmplace(
+                                   storage,
+                                   &d_end_p,
+                                   d_begin_p,
+                                   pos,
+                                   d_end_p,
+                                   elementAllocator(),
+                                   BSLS_COMPILERFEATURES_FORWARD(ARG1, arg1));
+        proctor.release();
+
+        adoptStorage(storage, newSize, newCapacity);
+    }
+    else {
+        ArrayPrimitives::emplace(pos,
+                                 d_end_p,
+                                 elementAllocator(),
+                                 BSLS_COMPILERFEATURES_FORWARD(ARG1, arg1));
+        ++d_end_p;
+    }
+
+    return d_begin_p + index;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::reference
+SmallVector<TYPE, INLINE_CAPACITY>::emplace_back()
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(size() < d_capacity)) {
+        bslma::ConstructionUtil::construct(d_end_p, d_allocator_p);
+        ++d_end_p;
+        return d_end_p[-1];                                           // RETURN
+    }
+
+    return *emplace(d_end_p);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+template <class ARG1>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::reference
+SmallVector<TYPE, INLINE_CAPACITY>::emplace_back(
+                                  BSLS_COMPILERFEATURES_FORWARD_REF(ARG1) arg1)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(size() < d_capacity)) {
+        bslma::ConstructionUtil::construct(
+                                   d_end_p,
+                                   d_allocator_p,
+                                   BSLS_COMPILERFEATURES_FORWARD(ARG1, arg1));
+        ++d_end_p;
+        return d_end_p[-1];                                           // RETURN
+    }
+
+    return *emplace(d_end_p, BSLS_COMPILERFEATURES_FORWARD(ARG1, arg1));
+}
+#endif
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::iterator
+SmallVector<TYPE, INLINE_CAPACITY>::end()
+{
+    return d_end_p;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::iterator
+SmallVector<TYPE, INLINE_CAPACITY>::erase(const_iterator position)
+{
+    BSLS_ASSERT_SAFE(d_begin_p <= position);
+    BSLS_ASSERT_SAFE(position  <  d_end_p);
+
+    return erase(position, position + 1);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+typename SmallVector<TYPE, INLINE_CAPACITY>::iterator
+SmallVector<TYPE, INLINE_CAPACITY>::erase(const_iterator first,
+                                          const_iterator last)
+{
+    BSLS_ASSERT_SAFE(d_begin_p <= first);
+    BSLS_ASSERT_SAFE(first     <= last);
+    BSLS_ASSERT_SAFE(last      <= d_end_p);
+
+    TYPE *pos = const_cast<TYPE *>(first);
+
+    if (first != last) {
+        ArrayPrimitives::erase(pos,
+                               const_cast<TYPE *>(last),
+                               d_end_p,
+                               elementAllocator());
+        d_end_p -= last - first;
+    }
+    return pos;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::reference
+SmallVector<TYPE, INLINE_CAPACITY>::front()
+{
+    BSLS_ASSERT_SAFE(!empty());
+
+    return *d_begin_p;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::iterator
+SmallVector<TYPE, INLINE_CAPACITY>::insert(const_iterator position,
+                                           const TYPE&    value)
+{
+    return insert(position, size_type(1), value);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+typename SmallVector<TYPE, INLINE_CAPACITY>::iterator
+SmallVector<TYPE, INLINE_CAPACITY>::insert(const_iterator          position,
+                                           bslmf::MovableRef<TYPE> value)
+{
+    BSLS_ASSERT_SAFE(d_begin_p <= position);
+    BSLS_ASSERT_SAFE(position  <= d_end_p);
+
+    TYPE& lvalue = value;
+
+    const size_type index = position - d_begin_p;
+    TYPE           *pos   = const_cast<TYPE *>(position);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(size() == d_capacity)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        const size_type newSize     = size() + 1;
+        const size_type newCapacity = computeNewCapacity(newSize);
+
+        TYPE *storage = allocateStorage(newCapacity);
+        bslma::DeallocatorProctor<bslma::Allocator> proctor(storage,
+                                                            d_allocator_p);
+
+        ArrayPrimitives::destructiveMoveAndEmplace(storage,
+                                                   &d_end_p,
+                                                   d_begin_p,
+                                                   pos,
+                                                   d_end_p,
+                                                   elementAllocator(),
+                                                   MoveUtil::move(lvalue));
+        proctor.release();
+
+        adoptStorage(storage, newSize, newCapacity);
+    }
+    else {
+        ArrayPrimitives::insert(pos,
+                                d_end_p,
+                                MoveUtil::move(lvalue),
+                                elementAllocator());
+        ++d_end_p;
+    }
+
+    return d_begin_p + index;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+typename SmallVector<TYPE, INLINE_CAPACITY>::iterator
+SmallVector<TYPE, INLINE_CAPACITY>::insert(const_iterator position,
+                                           size_type      numElements,
+                                           const TYPE&    value)
+{
+    BSLS_ASSERT_SAFE(d_begin_p <= position);
+    BSLS_ASSERT_SAFE(position  <= d_end_p);
+
+    const size_type index = position - d_begin_p;
+    TYPE           *pos   = const_cast<TYPE *>(position);
+
+    if (0 == numElements) {
+        return pos;                                                   // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                                      numElements > d_capacity - size())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        if (numElements > max_size() - size()) {
+            bslstl::StdExceptUtil::throwLengthError(
+                              "SmallVector<...>::insert(pos,n,v): too long");
+        }
+
+        const size_type newSize     = size() + numElements;
+        const size_type newCapacity = computeNewCapacity(newSize);
+
+        TYPE *storage = allocateStorage(newCapacity);
+        bslma::DeallocatorProctor<bslma::Allocator> proctor(storage,
+                                                            d_allocator_p);
+
+        ArrayPrimitives::destructiveMoveAndInsert(storage,
+                                                  &d_end_p,
+                                                  d_begin_p,
+                                                  pos,
+                                                  d_end_p,
+                                                  value,
+                                                  numElements,
+                                                  elementAllocator());
+        proctor.release();
+
+        adoptStorage(storage, newSize, newCapacity);
+    }
+    else {
+        ArrayPrimitives::insert(pos,
+                                d_end_p,
+                                value,
+                                numElements,
+                                elementAllocator());
+        d_end_p += numElements;
+    }
+
+    return d_begin_p + index;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+template <class INPUT_ITER>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::iterator
+SmallVector<TYPE, INLINE_CAPACITY>::insert(const_iterator position,
+                                           INPUT_ITER     first,
+                                           INPUT_ITER     last)
+{
+    BSLS_ASSERT_SAFE(d_begin_p <= position);
+    BSLS_ASSERT_SAFE(position  <= d_end_p);
+
+    // If 'first' and 'last' are integral, then they are not iterators, and
+    // are instead a count and a value, respectively.  The 'bslmf::Nil'
+    // argument is an exact match for the arithmetic overload, so that
+    // overload is preferred when both overloads are viable.
+
+    const size_type index = position - d_begin_p;
+
+    insertDispatch(position, first, last, first, bslmf::Nil());
+
+    return d_begin_p + index;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+void SmallVector<TYPE, INLINE_CAPACITY>::pop_back()
+{
+    BSLS_ASSERT_SAFE(!empty());
+
+    --d_end_p;
+    bslma::DestructionUtil::destroy(d_end_p);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+void SmallVector<TYPE, INLINE_CAPACITY>::push_back(const TYPE& value)
+{
+    emplace_back(value);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+void SmallVector<TYPE, INLINE_CAPACITY>::push_back(
+                                                 bslmf::MovableRef<TYPE> value)
+{
+    emplace_back(MoveUtil::move(value));
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::reverse_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::rbegin()
+{
+    return reverse_iterator(d_end_p);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::reverse_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::rend()
+{
+    return reverse_iterator(d_begin_p);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+void SmallVector<TYPE, INLINE_CAPACITY>::reserve(size_type newCapacity)
+{
+    if (newCapacity <= d_capacity) {
+        return;                                                       // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(newCapacity > max_size())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        bslstl::StdExceptUtil::throwLengthError(
+                          "SmallVector<...>::reserve(newCapacity): too long");
+    }
+
+    TYPE *storage = allocateStorage(newCapacity);
+    bslma::DeallocatorProctor<bslma::Allocator> proctor(storage,
+                                                        d_allocator_p);
+
+    ArrayPrimitives::destructiveMove(storage,
+                                     d_begin_p,
+                                     d_end_p,
+                                     elementAllocator());
+    proctor.release();
+
+    adoptStorage(storage, size(), newCapacity);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+void SmallVector<TYPE, INLINE_CAPACITY>::resize(size_type newSize)
+{
+    if (newSize <= size()) {
+        erase(d_begin_p + newSize, d_end_p);
+        return;                                                       // RETURN
+    }
+
+    if (newSize > d_capacity) {
+        const size_type newCapacity = computeNewCapacity(newSize);
+
+        TYPE *storage = allocateStorage(newCapacity);
+        bslma::DeallocatorProctor<bslma::Allocator> proctor(storage,
+                                                            d_allocator_p);
+
+        ArrayPrimitives::destructiveMoveAndInsert(storage,
+                                                  &d_end_p,
+                                                  d_begin_p,
+                                                  d_end_p,
+                                                  d_end_p,
+                                                  newSize - size(),
+                                                  elementAllocator());
+        proctor.release();
+
+        adoptStorage(storage, newSize, newCapacity);
+    }
+    else {
+        ArrayPrimitives::defaultConstruct(d_end_p,
+                                          newSize - size(),
+                                          elementAllocator());
+        d_end_p = d_begin_p + newSize;
+    }
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+void SmallVector<TYPE, INLINE_CAPACITY>::resize(size_type   newSize,
+                                                const TYPE& value)
+{
+    if (newSize <= size()) {
+        erase(d_begin_p + newSize, d_end_p);
+    }
+    else {
+        insert(d_end_p, newSize - size(), value);
+    }
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+void SmallVector<TYPE, INLINE_CAPACITY>::shrink_to_fit()
+{
+    if (isInline() || size() == d_capacity) {
+        return;                                                       // RETURN
+    }
+
+    if (size() <= INLINE_CAPACITY) {
+        ArrayPrimitives::destructiveMove(inlineData(),
+                                         d_begin_p,
+                                         d_end_p,
+                                         elementAllocator());
+
+        adoptStorage(inlineData(), size(), INLINE_CAPACITY);
+        return;                                                       // RETURN
+    }
+
+    TYPE *storage = allocateStorage(size());
+    bslma::DeallocatorProctor<bslma::Allocator> proctor(storage,
+                                                        d_allocator_p);
+
+    ArrayPrimitives::destructiveMove(storage,
+                                     d_begin_p,
+                                     d_end_p,
+                                     elementAllocator());
+    proctor.release();
+
+    adoptStorage(storage, size(), size());
+}
+
+                                  // Aspects
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+void SmallVector<TYPE, INLINE_CAPACITY>::swap(SmallVector& other)
+{
+    BSLS_ASSERT_SAFE(allocator() == other.allocator());
+
+    if (!isInline() && !other.isInline()) {
+        bsl::swap(d_begin_p,  other.d_begin_p);
+        bsl::swap(d_end_p,    other.d_end_p);
+        bsl::swap(d_capacity, other.d_capacity);
+        return;                                                       // RETURN
+    }
+
+    SmallVector temp(MoveUtil::move(*this));
+
+    relocateFrom(&other);
+    other.relocateFrom(&temp);
+}
+
+// ACCESSORS
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_reference
+SmallVector<TYPE, INLINE_CAPACITY>::operator[](size_type position) const
+{
+    BSLS_ASSERT_SAFE(position < size());
+
+    return d_begin_p[position];
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_reference
+SmallVector<TYPE, INLINE_CAPACITY>::at(size_type position) const
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(position >= size())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        bslstl::StdExceptUtil::throwOutOfRange(
+                        "SmallVector<...>::at(position): invalid position");
+    }
+    return d_begin_p[position];
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_reference
+SmallVector<TYPE, INLINE_CAPACITY>::back() const
+{
+    BSLS_ASSERT_SAFE(!empty());
+
+    return d_end_p[-1];
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::begin() const
+{
+    return d_begin_p;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::cbegin() const
+{
+    return d_begin_p;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::size_type
+SmallVector<TYPE, INLINE_CAPACITY>::capacity() const
+{
+    return d_capacity;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::cend() const
+{
+    return d_end_p;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::end() const
+{
+    return d_end_p;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_reverse_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::crbegin() const
+{
+    return const_reverse_iterator(d_end_p);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_reverse_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::rbegin() const
+{
+    return const_reverse_iterator(d_end_p);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_reverse_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::crend() const
+{
+    return const_reverse_iterator(d_begin_p);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_reverse_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::rend() const
+{
+    return const_reverse_iterator(d_begin_p);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_pointer
+SmallVector<TYPE, INLINE_CAPACITY>::data() const
+{
+    return d_begin_p;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+bool SmallVector<TYPE, INLINE_CAPACITY>::empty() const
+{
+    return d_begin_p == d_end_p;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_reference
+SmallVector<TYPE, INLINE_CAPACITY>::front() const
+{
+    BSLS_ASSERT_SAFE(!empty());
+
+    return *d_begin_p;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+bool SmallVector<TYPE, INLINE_CAPACITY>::isInline() const
+{
+    return d_begin_p == inlineData();
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::size_type
+SmallVector<TYPE, INLINE_CAPACITY>::max_size() const
+{
+    return bsl::numeric_limits<size_type>::max() / sizeof(TYPE);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::size_type
+SmallVector<TYPE, INLINE_CAPACITY>::size() const
+{
+    return d_end_p - d_begin_p;
+}
+
+                                  // Aspects
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+bslma::Allocator *SmallVector<TYPE, INLINE_CAPACITY>::allocator() const
+{
+    return d_allocator_p;
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+bool bdlc::operator==(const SmallVector<TYPE, INLINE_CAPACITY>& lhs,
+                      const SmallVector<TYPE, INLINE_CAPACITY>& rhs)
+{
+    return lhs.size() == rhs.size()
+        && bsl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+bool bdlc::operator!=(const SmallVector<TYPE, INLINE_CAPACITY>& lhs,
+                      const SmallVector<TYPE, INLINE_CAPACITY>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+bool bdlc::operator<(const SmallVector<TYPE, INLINE_CAPACITY>& lhs,
+                     const SmallVector<TYPE, INLINE_CAPACITY>& rhs)
+{
+    return bsl::lexicographical_compare(lhs.begin(),
+                                        lhs.end(),
+                                        rhs.begin(),
+                                        rhs.end());
+}
+
+// FREE FUNCTIONS
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+void bdlc::swap(SmallVector<TYPE, INLINE_CAPACITY>& a,
+                SmallVector<TYPE, INLINE_CAPACITY>& b)
+{
+    if (a.allocator() == b.allocator()) {
+        a.swap(b);
+
+        return;                                                       // RETURN
+    }
+
+    SmallVector<TYPE, INLINE_CAPACITY> futureA(b, a.allocator());
+    SmallVector<TYPE, INLINE_CAPACITY> futureB(a, b.allocator());
+
+    futureA.swap(a);
+    futureB.swap(b);
+}
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1562 @@
+// bdlc_smallvector.t.cpp                                             -*-C++-*-
+#include <bdlc_smallvector.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+
+#include <bslmf_isbitwisemoveable.h>
+#include <bslmf_movableref.h>
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_keyword.h>
+#include <bsls_stopwatch.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstddef.h>
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_iomanip.h>
+#include <bsl_iostream.h>
+#include <bsl_iterator.h>
+#include <bsl_list.h>
+#include <bsl_sstream.h>
+#include <bsl_stdexcept.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                              TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is a sequence container that holds its first few
+// elements in an inline buffer and spills to allocated memory.  The elements
+// are manipulated by 'bslalg::ArrayPrimitives', which is tested thoroughly in
+// its own test driver; this test driver therefore concentrates on the
+// transitions between the inline buffer and allocated memory, comparing the
+// value of each object with that of a 'bsl::vector' oracle, and verifying
+// that memory is allocated only when the inline capacity is exceeded, that
+// bitwise-moveable elements are relocated without invoking their
+// constructors, and that no memory is leaked when an exception is thrown.
+//-----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 2] size_type inlineCapacity();
+//
+// CREATORS
+// [ 2] SmallVector();
+// [ 2] SmallVector(bslma::Allocator *basicAllocator);
+// [ 4] SmallVector(size_type initialSize, *ba = 0);
+// [ 4] SmallVector(size_type initialSize, const TYPE& value, *ba = 0);
+// [ 3] SmallVector(INPUT_ITER first, INPUT_ITER last, *ba = 0);
+// [ 5] SmallVector(const SmallVector& original, *ba = 0);
+// [ 5] SmallVector(MovableRef<SmallVector> original);
+// [ 5] SmallVector(MovableRef<SmallVector> original, *ba);
+// [ 2] ~SmallVector();
+//
+// MANIPULATORS
+// [ 5] SmallVector& operator=(const SmallVector& rhs);
+// [ 5] SmallVector& operator=(MovableRef<SmallVector> rhs);
+// [ 2] reference operator[](size_type position);
+// [ 4] void assign(size_type numElements, const TYPE& value);
+// [ 4] void assign(INPUT_ITER first, INPUT_ITER last);
+// [ 4] reference at(size_type position);
+// [ 2] reference back();
+// [ 2] iterator begin();
+// [ 2] void clear();
+// [ 2] pointer data();
+// [ 3] iterator emplace(const_iterator position, ARGS&&... arguments);
+// [ 2] reference emplace_back(ARGS&&... arguments);
+// [ 2] iterator end();
+// [ 3] iterator erase(const_iterator position);
+// [ 3] iterator erase(const_iterator first, const_iterator last);
+// [ 2] reference front();
+// [ 3] iterator insert(const_iterator position, const TYPE& value);
+// [ 3] iterator insert(const_iterator position, MovableRef<TYPE> value);
+// [ 3] iterator insert(const_iterator position, size_type n, const TYPE&);
+// [ 3] iterator insert(const_iterator position, INPUT_ITER f, INPUT_ITER l);
+// [ 2] void pop_back();
+// [ 2] void push_back(const TYPE& value);
+// [ 2] void push_back(MovableRef<TYPE> value);
+// [ 2] reverse_iterator rbegin();
+// [ 2] reverse_iterator rend();
+// [ 4] void reserve(size_type newCapacity);
+// [ 4] void resize(size_type newSize);
+// [ 4] void resize(size_type newSize, const TYPE& value);
+// [ 4] void shrink_to_fit();
+// [ 5] void swap(SmallVector& other);
+//
+// ACCESSORS
+// [ 2] const_reference operator[](size_type position) const;
+// [ 4] const_reference at(size_type position) const;
+// [ 2] const_reference back() const;
+// [ 2] const_iterator begin() const;
+// [ 2] const_iterator cbegin() const;
+// [ 2] size_type capacity() const;
+// [ 2] const_iterator cend() const;
+// [ 2] const_iterator end() const;
+// [ 2] const_reverse_iterator crbegin() const;
+// [ 2] const_reverse_iterator rbegin() const;
+// [ 2] const_reverse_iterator crend() const;
+// [ 2] const_reverse_iterator rend() const;
+// [ 2] const_pointer data() const;
+// [ 2] bool empty() const;
+// [ 2] const_reference front() const;
+// [ 2] bool isInline() const;
+// [ 4] size_type max_size() const;
+// [ 2] size_type size() const;
+// [ 2] bslma::Allocator *allocator() const;
+//
+// FREE OPERATORS
+// [ 5] bool operator==(const SmallVector& lhs, const SmallVector& rhs);
+// [ 5] bool operator!=(const SmallVector& lhs, const SmallVector& rhs);
+// [ 5] bool operator<(const SmallVector& lhs, const SmallVector& rhs);
+//
+// FREE FUNCTIONS
+// [ 5] void swap(SmallVector& a, SmallVector& b);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] RELOCATION OF BITWISE-MOVEABLE ELEMENTS
+// [ 7] EXCEPTION SAFETY
+// [ 8] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST: 'bdlc::SmallVector' vs. 'bsl::vector'
+// ----------------------------------------------------------------------------
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlc::SmallVector<int, 4>         IntObj;
+typedef bdlc::SmallVector<bsl::string, 4> Obj;
+
+const char *const LONG_STRING = "a string long enough to require allocation ";
+
+// ============================================================================
+//                          HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+
+bsl::string makeString(int value, bslma::Allocator *basicAllocator = 0)
+    // Return a string, long enough to require allocation, that is unique to
+    // the specified 'value'.  Optionally specify a 'basicAllocator' used to
+    // supply memory.  If 'basicAllocator' is 0, the currently installed
+    // default allocator is used.
+{
+    char buffer[16];
+    bsl::sprintf(buffer, "%d", value);
+
+    bsl::string result(LONG_STRING, basicAllocator);
+    result += buffer;
+    return result;
+}
+
+template <class VECTOR, class ORACLE>
+bool matchesOracle(const VECTOR& vector, const ORACLE& oracle)
+    // Return 'true' if the specified 'vector' holds the same elements, in the
+    // same order, as the specified 'oracle', and 'false' otherwise.
+{
+    return vector.size() == oracle.size()
+        && bsl::equal(oracle.begin(), oracle.end(), vector.begin());
+}
+
+                              // =============
+                              // class Tracked
+                              // =============
+
+template <bool BITWISE_MOVEABLE>
+class Tracked {
+    // This class holds an 'int' value and counts the invocations of its copy
+    // constructor, move constructor, and destructor.  It has the
+    // 'bslmf::IsBitwiseMoveable' trait if the (template parameter)
+    // 'BITWISE_MOVEABLE' is 'true'.
+
+    // DATA
+    int d_value;
+
+  public:
+    // CLASS DATA
+    static int s_numCopies;       // number of copy constructions
+    static int s_numMoves;        // number of move constructions
+    static int s_numDestroyed;    // number of destructions
+
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION_IF(Tracked,
+                                      bslmf::IsBitwiseMoveable,
+                                      BITWISE_MOVEABLE);
+
+    // CLASS METHODS
+    static void resetCounts()
+        // Set each of the counts to 0.
+    {
+        s_numCopies    = 0;
+        s_numMoves     = 0;
+        s_numDestroyed = 0;
+    }
+
+    // CREATORS
+    explicit Tracked(int value = 0)
+    : d_value(value)
+    {
+    }
+
+    Tracked(const Tracked& original)
+    : d_value(original.d_value)
+    {
+        ++s_numCopies;
+    }
+
+    Tracked(bslmf::MovableRef<Tracked> original) BSLS_KEYWORD_NOEXCEPT
+    : d_value(bslmf::MovableRefUtil::access(original).d_value)
+    {
+        ++s_numMoves;
+    }
+
+    ~Tracked()
+    {
+        ++s_numDestroyed;
+    }
+
+    // MANIPULATORS
+    Tracked& operator=(const Tracked& rhs)
+    {
+        d_value = rhs.d_value;
+        return *this;
+    }
+
+    Tracked& operator=(bslmf::MovableRef<Tracked> rhs)
+    {
+        d_value = bslmf::MovableRefUtil::access(rhs).d_value;
+        return *this;
+    }
+
+    // ACCESSORS
+    int value() const
+    {
+        return d_value;
+    }
+};
+
+template <bool BITWISE_MOVEABLE>
+int Tracked<BITWISE_MOVEABLE>::s_numCopies = 0;
+
+template <bool BITWISE_MOVEABLE>
+int Tracked<BITWISE_MOVEABLE>::s_numMoves = 0;
+
+template <bool BITWISE_MOVEABLE>
+int Tracked<BITWISE_MOVEABLE>::s_numDestroyed = 0;
+
+template <bool BITWISE_MOVEABLE>
+void testRelocation()
+    // Verify that growing, inserting into, erasing from, shrinking, and
+    // moving a small vector of 'Tracked<BITWISE_MOVEABLE>' relocates the
+    // existing elements without invoking their constructors or destructors if
+    // 'BITWISE_MOVEABLE' is 'true', and by moving them otherwise.
+{
+    typedef Tracked<BITWISE_MOVEABLE>         Element;
+    typedef bdlc::SmallVector<Element, 4>     Vector;
+
+    bslma::TestAllocator sa("supplied");
+
+    Vector mX(&sa);  const Vector& X = mX;
+
+    for (int i = 0; i < 4; ++i) {
+        mX.emplace_back(i);
+    }
+    ASSERT(X.isInline());
+
+    // Spill from the inline buffer: 4 elements are relocated.
+
+    Element::resetCounts();
+    mX.emplace_back(4);
+    ASSERT(!X.isInline());
+    ASSERTV(Element::s_numCopies, 0 == Element::s_numCopies);
+    if (BITWISE_MOVEABLE) {
+        ASSERTV(Element::s_numMoves,     0 == Element::s_numMoves);
+        ASSERTV(Element::s_numDestroyed, 0 == Element::s_numDestroyed);
+    }
+    else {
+        ASSERTV(Element::s_numMoves,     4 == Element::s_numMoves);
+        ASSERTV(Element::s_numDestroyed, 4 == Element::s_numDestroyed);
+    }
+
+    // Insert at the front: each element is shifted.
+
+    mX.reserve(8);
+    Element::resetCounts();
+    mX.emplace(X.begin(), -1);
+    ASSERT(6 == X.size());
+    ASSERT(-1 == X.front().value());
+    ASSERT( 4 == X.back().value());
+    ASSERTV(Element::s_numCopies, 0 == Element::s_numCopies);
+    if (BITWISE_MOVEABLE) {
+        ASSERTV(Element::s_numMoves, 0 == Element::s_numMoves);
+    }
+
+    // Erase from the front: each element is shifted, and only the erased
+    // element is destroyed.
+
+    Element::resetCounts();
+    mX.erase(X.begin());
+    mX.erase(X.begin());
+    ASSERT(4 == X.size());
+    ASSERT(1 == X.front().value());
+    ASSERTV(Element::s_numCopies, 0 == Element::s_numCopies);
+    if (BITWISE_MOVEABLE) {
+        ASSERTV(Element::s_numMoves,     0 == Element::s_numMoves);
+        ASSERTV(Element::s_numDestroyed, 2 == Element::s_numDestroyed);
+    }
+
+    // Return to the inline buffer.
+
+    Element::resetCounts();
+    mX.shrink_to_fit();
+    ASSERT(X.isInline());
+    ASSERT(0 == sa.numBlocksInUse());
+    ASSERTV(Element::s_numCopies, 0 == Element::s_numCopies);
+    if (BITWISE_MOVEABLE) {
+        ASSERTV(Element::s_numMoves,     0 == Element::s_numMoves);
+        ASSERTV(Element::s_numDestroyed, 0 == Element::s_numDestroyed);
+    }
+
+    // Move an inline object: elements are relocated into the new object.
+
+    Element::resetCounts();
+    Vector mY(bslmf::MovableRefUtil::move(mX));  const Vector& Y = mY;
+    ASSERT(4 == Y.size());
+    ASSERT(X.empty());
+    ASSERT(1 == Y.front().value());
+    ASSERTV(Element::s_numCopies, 0 == Element::s_numCopies);
+    if (BITWISE_MOVEABLE) {
+        ASSERTV(Element::s_numMoves,     0 == Element::s_numMoves);
+        ASSERTV(Element::s_numDestroyed, 0 == Element::s_numDestroyed);
+    }
+    else {
+        ASSERTV(Element::s_numMoves,     4 == Element::s_numMoves);
+        ASSERTV(Element::s_numDestroyed, 4 == Element::s_numDestroyed);
+    }
+
+    // Move an allocated object: the memory is transferred.
+
+    mY.emplace_back(5);
+    ASSERT(!Y.isInline());
+
+    Element::resetCounts();
+    Vector mZ(bslmf::MovableRefUtil::move(mY));  const Vector& Z = mZ;
+    ASSERT(5 == Z.size());
+    ASSERT(Y.empty());
+    ASSERT(Y.isInline());
+    ASSERT(0 == Element::s_numCopies);
+    ASSERT(0 == Element::s_numMoves);
+    ASSERT(0 == Element::s_numDestroyed);
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                       PERFORMANCE TEST SUPPORT
+// ----------------------------------------------------------------------------
+
+namespace {
+namespace u {
+
+template <class VECTOR>
+double timeFill(int numObjects, int numElements, long *checksum)
+    // Return the average time, in nanoseconds, of creating a 'VECTOR' using
+    // the default allocator, appending the specified 'numElements' elements
+    // to it, summing them, and destroying it, measured over the specified
+    // 'numObjects' objects, and add the sums to the specified 'checksum'.
+{
+    bsls::Stopwatch timer;
+
+    timer.start(true);
+    for (int i = 0; i < numObjects; ++i) {
+        VECTOR vector;
+        for (int j = 0; j < numElements; ++j) {
+            vector.push_back(i + j);
+        }
+        for (typename VECTOR::const_iterator it = vector.begin();
+             it != vector.end();
+             ++it) {
+            *checksum += *it;
+        }
+    }
+    timer.stop();
+
+    return timer.accumulatedWallTime() * 1.0e9 / numObjects;
+}
+
+}  // close namespace u
+}  // close unnamed namespace
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int  test                = argc > 1 ? atoi(argv[1]) : 0;
+    bool verbose             = argc > 2;
+    bool veryVerbose         = argc > 3;
+    bool veryVeryVerbose     = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        struct Local {
+            typedef bdlc::SmallVector<bslstl::StringRef, 8> PathComponents;
+
+            static void splitPath(PathComponents           *result,
+                                  const bslstl::StringRef&  path)
+                // Load into the specified 'result' the non-empty components
+                // of the specified 'path', delimited by '/'.
+            {
+                result->clear();
+
+                const char *begin = path.begin();
+                for (const char *it = path.begin(); it != path.end(); ++it) {
+                    if ('/' == *it) {
+                        if (begin != it) {
+                            result->push_back(bslstl::StringRef(begin, it));
+                        }
+                        begin = it + 1;
+                    }
+                }
+                if (begin != path.end()) {
+                    result->push_back(bslstl::StringRef(begin, path.end()));
+                }
+            }
+        };
+
+        typedef Local::PathComponents PathComponents;
+
+        bslma::TestAllocator ta;
+
+        PathComponents components(&ta);
+
+        Local::splitPath(&components, "/usr/local/include/bdlc_smallvector.h");
+
+        ASSERT(4                     == components.size());
+        ASSERT("usr"                 == components[0]);
+        ASSERT("bdlc_smallvector.h"  == components.back());
+        ASSERT(components.isInline());
+        ASSERT(0                     == ta.numBlocksTotal());
+
+        Local::splitPath(&components, "a/b/c/d/e/f/g/h/i/j");
+
+        ASSERT(10 == components.size());
+        ASSERT(!components.isInline());
+        ASSERT(1  == ta.numBlocksInUse());
+
+        Local::splitPath(&components, "/tmp/x");
+        components.shrink_to_fit();
+
+        ASSERT(2 == components.size());
+        ASSERT(components.isInline());
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // EXCEPTION SAFETY
+        //   Allocation failures while growing leave a valid object.
+        //
+        // Concerns:
+        //: 1 If an exception is thrown by the allocator or by the copy
+        //:   constructor of an element while appending, the object retains
+        //:   its original value; while inserting elsewhere, the object
+        //:   retains its original size and remains valid (as for
+        //:   'bsl::vector').
+        //:
+        //: 2 If an exception is thrown while constructing an object, no
+        //:   memory is leaked.
+        //
+        // Plan:
+        //: 1 Using the 'BSLMA_TESTALLOCATOR_EXCEPTION_TEST_*' macros, append
+        //:   allocating strings to, and insert allocating strings at the front
+        //:   of, objects of every size from 0 through 8, and verify that an
+        //:   interrupted append leaves the original value, and an interrupted
+        //:   insertion the original size.  (C-1)
+        //:
+        //: 2 Using the same macros, construct objects by copying and from
+        //:   ranges, and verify that no memory is outstanding afterwards.
+        //:   (C-2)
+        //
+        // Testing:
+        //   EXCEPTION SAFETY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "EXCEPTION SAFETY" << endl
+                          << "================" << endl;
+
+        bslma::TestAllocator sa("supplied",  veryVeryVerbose);
+
+        for (int size = 0; size <= 8; ++size) {
+            bsl::vector<bsl::string> oracle(&sa);
+            for (int i = 0; i < size; ++i) {
+                oracle.push_back(makeString(i));
+            }
+            const bsl::string value(makeString(-1), &sa);
+
+            {
+                Obj mX(oracle.begin(), oracle.end(), &sa);  const Obj& X = mX;
+
+                BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                    LOOP_ASSERT(size, matchesOracle(X, oracle));
+
+                    mX.push_back(value);
+                } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+                oracle.push_back(value);
+                LOOP_ASSERT(size, matchesOracle(X, oracle));
+                oracle.pop_back();
+            }
+            {
+                Obj mX(oracle.begin(), oracle.end(), &sa);  const Obj& X = mX;
+
+                BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                    LOOP_ASSERT(size, oracle.size() == X.size());
+
+                    mX.insert(X.begin(), value);
+                } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+                LOOP_ASSERT(size, oracle.size() + 1 == X.size());
+                LOOP_ASSERT(size, value == X.front());
+            }
+            {
+                Obj mX(oracle.begin(), oracle.end(), &sa);  const Obj& X = mX;
+
+                BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                    mX.insert(X.begin() + size / 2,
+                              oracle.begin(),
+                              oracle.end());
+                } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+                LOOP_ASSERT(size, 2 * oracle.size() == X.size());
+            }
+            {
+                const Obj Z(oracle.begin(), oracle.end(), &sa);
+
+                BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                    Obj mX(Z, &sa);  const Obj& X = mX;
+                    LOOP_ASSERT(size, Z == X);
+                } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+                BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                    Obj mX(Z.begin(), Z.end(), &sa);  const Obj& X = mX;
+                    LOOP_ASSERT(size, Z == X);
+                } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+            }
+
+            oracle.clear();
+            oracle.shrink_to_fit();
+            LOOP_ASSERT(size, 1 >= sa.numBlocksInUse());
+        }
+
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // RELOCATION OF BITWISE-MOVEABLE ELEMENTS
+        //   Bitwise-moveable elements are relocated using 'memcpy'.
+        //
+        // Concerns:
+        //: 1 Growing out of the inline buffer, inserting and erasing in the
+        //:   middle, shrinking back into the inline buffer, and moving an
+        //:   inline object relocate elements of a bitwise-moveable type
+        //:   without invoking any constructor or destructor.
+        //:
+        //: 2 The same operations on elements of a type that is not bitwise
+        //:   moveable use the move constructor (never the copy constructor)
+        //:   and destroy the moved-from elements.
+        //:
+        //: 3 Moving an object whose elements are held in allocated memory
+        //:   transfers the memory, touching no element.
+        //
+        // Plan:
+        //: 1 Using 'Tracked', which counts constructions and destructions,
+        //:   perform each operation and verify the counts.  (C-1..3)
+        //
+        // Testing:
+        //   RELOCATION OF BITWISE-MOVEABLE ELEMENTS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "RELOCATION OF BITWISE-MOVEABLE ELEMENTS" << endl
+                          << "=======================================" << endl;
+
+        ASSERT( bslmf::IsBitwiseMoveable<Tracked<true> >::value);
+        ASSERT(!bslmf::IsBitwiseMoveable<Tracked<false> >::value);
+
+        if (veryVerbose) cout << "\tBitwise moveable." << endl;
+
+        testRelocation<true>();
+
+        if (veryVerbose) cout << "\tNot bitwise moveable." << endl;
+
+        testRelocation<false>();
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING VALUE SEMANTICS
+        //   Copy, move, assignment, swap, and comparison behave as expected
+        //   for every combination of inline and allocated storage.
+        //
+        // Concerns:
+        //: 1 The copy constructor creates an object having the same value,
+        //:   using the supplied (or default) allocator, and allocating only if
+        //:   the value does not fit in the inline buffer.
+        //:
+        //: 2 The move constructor leaves the source empty and propagates its
+        //:   allocator; moving with a different allocator copies the value
+        //:   into memory from that allocator.
+        //:
+        //: 3 Copy and move assignment, from objects of every size, give the
+        //:   target the value of the source, and leave the target using its
+        //:   own allocator.
+        //:
+        //: 4 'swap' exchanges the values of inline and allocated objects in
+        //:   every combination without allocating, and the free 'swap'
+        //:   function also works for objects using different allocators.
+        //:
+        //: 5 '==', '!=', and '<' compare the values of objects.
+        //
+        // Plan:
+        //: 1 For each pair of sizes from 0 through 7 (where the inline
+        //:   capacity is 4), exercise each operation and compare the results
+        //:   with 'bsl::vector' oracles.  (C-1..5)
+        //
+        // Testing:
+        //   SmallVector(const SmallVector& original, *ba = 0);
+        //   SmallVector(MovableRef<SmallVector> original);
+        //   SmallVector(MovableRef<SmallVector> original, *ba);
+        //   SmallVector& operator=(const SmallVector& rhs);
+        //   SmallVector& operator=(MovableRef<SmallVector> rhs);
+        //   void swap(SmallVector& other);
+        //   bool operator==(const SmallVector& lhs, const SmallVector& rhs);
+        //   bool operator!=(const SmallVector& lhs, const SmallVector& rhs);
+        //   bool operator<(const SmallVector& lhs, const SmallVector& rhs);
+        //   void swap(SmallVector& a, SmallVector& b);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING VALUE SEMANTICS" << endl
+                          << "=======================" << endl;
+
+        bslma::TestAllocator da("default",   veryVeryVerbose);
+        bslma::TestAllocator sa("supplied",  veryVeryVerbose);
+        bslma::TestAllocator oa("other",     veryVeryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        typedef bdlc::SmallVector<bsl::string, 4>::size_type Size;
+
+        for (int i = 0; i < 8; ++i) {
+            bsl::vector<bsl::string> oracleI(&sa);
+            for (int k = 0; k < i; ++k) {
+                oracleI.push_back(makeString(k, &sa));
+            }
+
+            if (veryVerbose) cout << "\tCopy construction." << endl;
+            {
+                const Obj W(oracleI.begin(), oracleI.end(), &sa);
+
+                const bsls::Types::Int64 before = oa.numBlocksTotal();
+                const Obj X(W, &oa);
+                LOOP_ASSERT(i, matchesOracle(X, oracleI));
+                LOOP_ASSERT(i, &oa == X.allocator());
+                LOOP_ASSERT(i, W == X);
+                LOOP_ASSERT(i, !(W != X));
+                LOOP_ASSERT(i, (i > 4) == !X.isInline());
+
+                // Each string allocates; the buffer only if 4 < i.
+
+                LOOP_ASSERT(i, i + (i > 4) == oa.numBlocksTotal() - before);
+            }
+
+            if (veryVerbose) cout << "\tMove construction." << endl;
+            {
+                Obj mW(oracleI.begin(), oracleI.end(), &sa);
+
+                const bsls::Types::Int64 before = sa.numBlocksTotal();
+                const Obj X(bslmf::MovableRefUtil::move(mW));
+                LOOP_ASSERT(i, matchesOracle(X, oracleI));
+                LOOP_ASSERT(i, &sa == X.allocator());
+                LOOP_ASSERT(i, mW.empty());
+                LOOP_ASSERT(i, mW.isInline());
+                LOOP_ASSERT(i, before == sa.numBlocksTotal());
+
+                Obj mY(oracleI.begin(), oracleI.end(), &sa);
+                const Obj Z(bslmf::MovableRefUtil::move(mY), &oa);
+                LOOP_ASSERT(i, matchesOracle(Z, oracleI));
+                LOOP_ASSERT(i, &oa == Z.allocator());
+            }
+
+            for (int j = 0; j < 8; ++j) {
+                bsl::vector<bsl::string> oracleJ(&sa);
+                for (int k = 0; k < j; ++k) {
+                    oracleJ.push_back(makeString(100 + k, &sa));
+                }
+
+                if (veryVeryVerbose) { T_ P_(i) P(j) }
+
+                // Copy assignment.
+                {
+                    Obj mX(oracleI.begin(), oracleI.end(), &sa);
+                    const Obj& X = mX;
+                    const Obj  Y(oracleJ.begin(), oracleJ.end(), &oa);
+
+                    Obj *mR = &(mX = Y);
+                    LOOP2_ASSERT(i, j, mR == &X);
+                    LOOP2_ASSERT(i, j, matchesOracle(X, oracleJ));
+                    LOOP2_ASSERT(i, j, &sa == X.allocator());
+                    LOOP2_ASSERT(i, j, X == Y);
+                    LOOP2_ASSERT(i, j, (0 == i && 0 == j) ==
+                                             (Obj(oracleI.begin(),
+                                                  oracleI.end(),
+                                                  &sa) == Y));
+                }
+
+                // Move assignment, same and different allocators.
+                {
+                    Obj mX(oracleI.begin(), oracleI.end(), &sa);
+                    const Obj& X = mX;
+                    Obj mY(oracleJ.begin(), oracleJ.end(), &sa);
+
+                    mX = bslmf::MovableRefUtil::move(mY);
+                    LOOP2_ASSERT(i, j, matchesOracle(X, oracleJ));
+                    LOOP2_ASSERT(i, j, mY.empty());
+
+                    Obj mZ(oracleI.begin(), oracleI.end(), &oa);
+                    mX = bslmf::MovableRefUtil::move(mZ);
+                    LOOP2_ASSERT(i, j, matchesOracle(X, oracleI));
+                    LOOP2_ASSERT(i, j, &sa == X.allocator());
+                }
+
+                // Member and free 'swap'.
+                {
+                    Obj mX(oracleI.begin(), oracleI.end(), &sa);
+                    const Obj& X = mX;
+                    Obj mY(oracleJ.begin(), oracleJ.end(), &sa);
+                    const Obj& Y = mY;
+
+                    const bsls::Types::Int64 before = sa.numBlocksTotal();
+                    mX.swap(mY);
+                    LOOP2_ASSERT(i, j, matchesOracle(X, oracleJ));
+                    LOOP2_ASSERT(i, j, matchesOracle(Y, oracleI));
+                    LOOP2_ASSERT(i, j, before == sa.numBlocksTotal());
+
+                    swap(mX, mY);
+                    LOOP2_ASSERT(i, j, matchesOracle(X, oracleI));
+                    LOOP2_ASSERT(i, j, matchesOracle(Y, oracleJ));
+
+                    Obj mZ(oracleJ.begin(), oracleJ.end(), &oa);
+                    const Obj& Z = mZ;
+                    swap(mX, mZ);
+                    LOOP2_ASSERT(i, j, matchesOracle(X, oracleJ));
+                    LOOP2_ASSERT(i, j, matchesOracle(Z, oracleI));
+                    LOOP2_ASSERT(i, j, &sa == X.allocator());
+                    LOOP2_ASSERT(i, j, &oa == Z.allocator());
+                }
+
+                // Comparison.
+                {
+                    const Obj X(oracleI.begin(), oracleI.end(), &sa);
+                    const Obj Y(oracleJ.begin(), oracleJ.end(), &sa);
+
+                    LOOP2_ASSERT(i, j, (oracleI == oracleJ) == (X == Y));
+                    LOOP2_ASSERT(i, j, (oracleI != oracleJ) == (X != Y));
+                    LOOP2_ASSERT(i, j, (oracleI <  oracleJ) == (X <  Y));
+                }
+            }
+        }
+
+        ASSERT(0 == static_cast<Size>(da.numBlocksTotal()));
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == oa.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING CAPACITY AND SIZE MANAGEMENT
+        //   'reserve', 'resize', 'shrink_to_fit', 'assign', and 'at' behave
+        //   as for 'bsl::vector', moving between the inline buffer and
+        //   allocated memory as required.
+        //
+        // Concerns:
+        //: 1 'reserve' allocates only if the requested capacity exceeds the
+        //:   current capacity, and preserves the elements.
+        //:
+        //: 2 'resize' appends value-initialized elements or copies of the
+        //:   supplied value, or removes trailing elements.
+        //:
+        //: 3 'shrink_to_fit' returns the elements to the inline buffer and
+        //:   releases memory if they fit, and otherwise reduces the capacity
+        //:   to the size.
+        //:
+        //: 4 'assign' replaces the value, reusing the existing capacity.
+        //:
+        //: 5 'at' throws 'bsl::out_of_range' for an invalid position, and
+        //:   'reserve' throws 'bsl::length_error' beyond 'max_size'.
+        //:
+        //: 6 The size constructors create the expected value.
+        //
+        // Plan:
+        //: 1 For each initial and final size from 0 through 10, exercise each
+        //:   operation, comparing with a 'bsl::vector' oracle and checking the
+        //:   capacity and the memory in use.  (C-1..4, 6)
+        //:
+        //: 2 Verify the exceptions thrown by 'at' and 'reserve'.  (C-5)
+        //
+        // Testing:
+        //   SmallVector(size_type initialSize, *ba = 0);
+        //   SmallVector(size_type initialSize, const TYPE& value, *ba = 0);
+        //   void assign(size_type numElements, const TYPE& value);
+        //   void assign(INPUT_ITER first, INPUT_ITER last);
+        //   reference at(size_type position);
+        //   void reserve(size_type newCapacity);
+        //   void resize(size_type newSize);
+        //   void resize(size_type newSize, const TYPE& value);
+        //   void shrink_to_fit();
+        //   const_reference at(size_type position) const;
+        //   size_type max_size() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING CAPACITY AND SIZE MANAGEMENT" << endl
+                          << "====================================" << endl;
+
+        bslma::TestAllocator sa("supplied",  veryVeryVerbose);
+
+        for (int i = 0; i <= 10; ++i) {
+            bsl::vector<bsl::string> initial(&sa);
+            for (int k = 0; k < i; ++k) {
+                initial.push_back(makeString(k));
+            }
+
+            {
+                const IntObj X(i, &sa);
+                LOOP_ASSERT(i, static_cast<int>(X.size()) == i);
+                LOOP_ASSERT(i, i == bsl::count(X.begin(), X.end(), 0));
+
+                const IntObj Y(i, 7, &sa);
+                LOOP_ASSERT(i, static_cast<int>(Y.size()) == i);
+                LOOP_ASSERT(i, i == bsl::count(Y.begin(), Y.end(), 7));
+            }
+
+            for (int j = 0; j <= 10; ++j) {
+                if (veryVeryVerbose) { T_ P_(i) P(j) }
+
+                // 'reserve'
+                {
+                    Obj mX(initial.begin(), initial.end(), &sa);
+                    const Obj& X = mX;
+                    const bsl::size_t oldCapacity = X.capacity();
+
+                    mX.reserve(j);
+                    LOOP2_ASSERT(i, j, matchesOracle(X, initial));
+                    const bsl::size_t expected =
+                                       bsl::max<bsl::size_t>(oldCapacity, j);
+                    LOOP2_ASSERT(i, j, expected == X.capacity());
+                    LOOP2_ASSERT(i, j, X.isInline() == (X.capacity() == 4));
+                }
+
+                // 'resize'
+                {
+                    bsl::vector<bsl::string> oracle(initial, &sa);
+                    Obj mX(initial.begin(), initial.end(), &sa);
+                    const Obj& X = mX;
+
+                    mX.resize(j);
+                    oracle.resize(j);
+                    LOOP2_ASSERT(i, j, matchesOracle(X, oracle));
+
+                    mX.resize(i, "x");
+                    oracle.resize(i, "x");
+                    LOOP2_ASSERT(i, j, matchesOracle(X, oracle));
+                }
+
+                // 'assign'
+                {
+                    bsl::vector<bsl::string> oracle(initial, &sa);
+                    Obj mX(initial.begin(), initial.end(), &sa);
+                    const Obj& X = mX;
+
+                    mX.assign(j, X.empty() ? bsl::string("y") : X.front());
+                    oracle.assign(j, oracle.empty() ? bsl::string("y")
+                                                    : oracle.front());
+                    LOOP2_ASSERT(i, j, matchesOracle(X, oracle));
+
+                    mX.assign(initial.begin(), initial.begin() + (j < i ? j
+                                                                        : i));
+                    oracle.assign(initial.begin(), initial.begin() + (j < i
+                                                                      ? j
+                                                                      : i));
+                    LOOP2_ASSERT(i, j, matchesOracle(X, oracle));
+                }
+            }
+
+            // 'shrink_to_fit'
+            {
+                Obj mX(&sa);  const Obj& X = mX;
+                mX.reserve(20);
+                mX.assign(initial.begin(), initial.end());
+                LOOP_ASSERT(i, !X.isInline());
+
+                mX.shrink_to_fit();
+                LOOP_ASSERT(i, matchesOracle(X, initial));
+                if (i <= 4) {
+                    LOOP_ASSERT(i, X.isInline());
+                    LOOP_ASSERT(i, 4 == X.capacity());
+                }
+                else {
+                    LOOP_ASSERT(i, !X.isInline());
+                    LOOP_ASSERT(i, X.size() == X.capacity());
+                }
+            }
+        }
+
+        if (veryVerbose) cout << "\tTesting exceptions." << endl;
+        {
+            IntObj mX(3, 1, &sa);  const IntObj& X = mX;
+
+            ASSERT(1 == mX.at(2));
+            ASSERT(1 ==  X.at(2));
+
+            bool caught = false;
+            try {
+                mX.at(3);
+            }
+            catch (const bsl::out_of_range&) {
+                caught = true;
+            }
+            ASSERT(caught);
+
+            caught = false;
+            try {
+                X.at(3);
+            }
+            catch (const bsl::out_of_range&) {
+                caught = true;
+            }
+            ASSERT(caught);
+
+            ASSERT(X.max_size() < ~static_cast<bsl::size_t>(0));
+
+            caught = false;
+            try {
+                mX.reserve(X.max_size() + 1);
+            }
+            catch (const bsl::length_error&) {
+                caught = true;
+            }
+            ASSERT(caught);
+            ASSERT(3 == X.size());
+        }
+
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING INSERTION AND REMOVAL
+        //   Elements can be inserted and removed at any position.
+        //
+        // Concerns:
+        //: 1 Each 'insert', 'emplace', and 'erase' overload produces the same
+        //:   sequence as the corresponding 'bsl::vector' method, at every
+        //:   position, whether or not the operation moves the elements out of
+        //:   the inline buffer.
+        //:
+        //: 2 The returned iterator refers to the first inserted element, or
+        //:   to the element following the erased ones.
+        //:
+        //: 3 Ranges of input iterators, forward iterators, and arithmetic
+        //:   values (treated as a count and a value) are inserted correctly.
+        //:
+        //: 4 Inserting a copy of an element of the object itself works.
+        //
+        // Plan:
+        //: 1 For each initial size from 0 through 9, each position, and each
+        //:   number of elements from 0 through 6, perform each insertion and
+        //:   removal on an object and on an oracle, and compare.  (C-1..3)
+        //:
+        //: 2 Insert, at the front of objects of each size, an element of the
+        //:   object.  (C-4)
+        //
+        // Testing:
+        //   SmallVector(INPUT_ITER first, INPUT_ITER last, *ba = 0);
+        //   iterator emplace(const_iterator position, ARGS&&... arguments);
+        //   iterator erase(const_iterator position);
+        //   iterator erase(const_iterator first, const_iterator last);
+        //   iterator insert(const_iterator position, const TYPE& value);
+        //   iterator insert(const_iterator position, MovableRef<TYPE> value);
+        //   iterator insert(const_iterator pos, size_type n, const TYPE&);
+        //   iterator insert(const_iterator pos, INPUT_ITER f, INPUT_ITER l);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING INSERTION AND REMOVAL" << endl
+                          << "=============================" << endl;
+
+        bslma::TestAllocator sa("supplied",  veryVeryVerbose);
+        bslma::TestAllocator ta("source",    veryVeryVerbose);
+
+        bsl::vector<bsl::string> source(&ta);
+        for (int k = 0; k < 6; ++k) {
+            source.push_back(makeString(100 + k));
+        }
+        const bsl::list<bsl::string> sourceList(source.begin(),
+                                                source.end(),
+                                                &ta);
+
+        for (int size = 0; size <= 9; ++size) {
+            bsl::vector<bsl::string> initial(&sa);
+            for (int k = 0; k < size; ++k) {
+                initial.push_back(makeString(k));
+            }
+
+            for (int pos = 0; pos <= size; ++pos) {
+                // Single element.
+                {
+                    bsl::vector<bsl::string> oracle(initial, &sa);
+                    Obj mX(initial.begin(), initial.end(), &sa);
+                    const Obj& X = mX;
+
+                    Obj::iterator it = mX.insert(X.begin() + pos, source[0]);
+                    oracle.insert(oracle.begin() + pos, source[0]);
+                    LOOP2_ASSERT(size, pos, matchesOracle(X, oracle));
+                    LOOP2_ASSERT(size, pos, X.begin() + pos == it);
+
+                    bsl::string moved(source[1], &sa);
+                    it = mX.insert(X.begin() + pos,
+                                   bslmf::MovableRefUtil::move(moved));
+                    oracle.insert(oracle.begin() + pos, source[1]);
+                    LOOP2_ASSERT(size, pos, matchesOracle(X, oracle));
+                    LOOP2_ASSERT(size, pos, X.begin() + pos == it);
+
+                    it = mX.emplace(X.begin() + pos, "zzz");
+                    oracle.insert(oracle.begin() + pos, bsl::string("zzz"));
+                    LOOP2_ASSERT(size, pos, matchesOracle(X, oracle));
+                    LOOP2_ASSERT(size, pos, X.begin() + pos == it);
+
+                    it = mX.erase(X.begin() + pos);
+                    oracle.erase(oracle.begin() + pos);
+                    LOOP2_ASSERT(size, pos, matchesOracle(X, oracle));
+                    LOOP2_ASSERT(size, pos, X.begin() + pos == it);
+                }
+
+                for (int n = 0; n <= 6; ++n) {
+                    if (veryVeryVerbose) { T_ P_(size) P_(pos) P(n) }
+
+                    // Copies of a value.
+                    {
+                        bsl::vector<bsl::string> oracle(initial, &sa);
+                        Obj mX(initial.begin(), initial.end(), &sa);
+                        const Obj& X = mX;
+
+                        Obj::iterator it = mX.insert(X.begin() + pos,
+                                                     n,
+                                                     source[2]);
+                        oracle.insert(oracle.begin() + pos, n, source[2]);
+                        LOOP3_ASSERT(size, pos, n, matchesOracle(X, oracle));
+                        LOOP3_ASSERT(size, pos, n, X.begin() + pos == it);
+
+                        it = mX.erase(X.begin() + pos, X.begin() + pos + n);
+                        LOOP3_ASSERT(size, pos, n, matchesOracle(X, initial));
+                        LOOP3_ASSERT(size, pos, n, X.begin() + pos == it);
+                    }
+
+                    // Forward iterators.
+                    {
+                        bsl::vector<bsl::string> oracle(initial, &sa);
+                        Obj mX(initial.begin(), initial.end(), &sa);
+                        const Obj& X = mX;
+
+                        bsl::list<bsl::string>::const_iterator last =
+                                                            sourceList.begin();
+                        bsl::advance(last, n);
+
+                        Obj::iterator it = mX.insert(X.begin() + pos,
+                                                     sourceList.begin(),
+                                                     last);
+                        oracle.insert(oracle.begin() + pos,
+                                      source.begin(),
+                                      source.begin() + n);
+                        LOOP3_ASSERT(size, pos, n, matchesOracle(X, oracle));
+                        LOOP3_ASSERT(size, pos, n, X.begin() + pos == it);
+                    }
+
+                    // Input iterators and arithmetic values.
+                    {
+                        bsl::vector<int> oracle(size, 1, &sa);
+                        IntObj mX(size, 1, &sa);  const IntObj& X = mX;
+
+                        bsl::ostringstream out;
+                        for (int k = 0; k < n; ++k) {
+                            out << k << ' ';
+                        }
+                        bsl::istringstream in(out.str());
+
+                        IntObj::iterator it = mX.insert(
+                                             X.begin() + pos,
+                                             bsl::istream_iterator<int>(in),
+                                             bsl::istream_iterator<int>());
+                        for (int k = 0; k < n; ++k) {
+                            oracle.insert(oracle.begin() + pos + k, k);
+                        }
+                        LOOP3_ASSERT(size, pos, n, matchesOracle(X, oracle));
+                        LOOP3_ASSERT(size, pos, n, X.begin() + pos == it);
+
+                        mX.insert(X.begin() + pos, n, 9);
+                        oracle.insert(oracle.begin() + pos, n, 9);
+                        LOOP3_ASSERT(size, pos, n, matchesOracle(X, oracle));
+                    }
+                }
+            }
+
+            // Range construction.
+            {
+                const Obj X(initial.begin(), initial.end(), &sa);
+                LOOP_ASSERT(size, matchesOracle(X, initial));
+                LOOP_ASSERT(size, (size <= 4) == X.isInline());
+
+                const IntObj Y(size, 5, &sa);
+                LOOP_ASSERT(size, static_cast<int>(Y.size()) == size);
+            }
+
+            // Aliased insertion.
+            if (size) {
+                bsl::vector<bsl::string> oracle(initial, &sa);
+                Obj mX(initial.begin(), initial.end(), &sa);
+                const Obj& X = mX;
+
+                mX.insert(X.begin(), X.back());
+                oracle.insert(oracle.begin(), bsl::string(oracle.back()));
+                LOOP_ASSERT(size, matchesOracle(X, oracle));
+
+                mX.insert(X.begin(), 3, X.back());
+                oracle.insert(oracle.begin(), 3, bsl::string(oracle.back()));
+                LOOP_ASSERT(size, matchesOracle(X, oracle));
+
+                mX.push_back(X.front());
+                oracle.push_back(bsl::string(oracle.front()));
+                LOOP_ASSERT(size, matchesOracle(X, oracle));
+            }
+        }
+
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING PRIMARY MANIPULATORS AND BASIC ACCESSORS
+        //   Elements can be appended and removed, and memory is allocated
+        //   only when the inline capacity is exceeded.
+        //
+        // Concerns:
+        //: 1 A default-constructed object is empty, inline, and uses the
+        //:   default (or supplied) allocator.
+        //:
+        //: 2 Appending up to 'INLINE_CAPACITY' elements allocates no memory
+        //:   for the buffer; appending more obtains memory from the supplied
+        //:   allocator, and never from the default allocator.
+        //:
+        //: 3 Elements are constructed using the allocator of the object.
+        //:
+        //: 4 Each accessor, and iterator, reports the state of the object.
+        //:
+        //: 5 'pop_back' and 'clear' destroy elements without changing the
+        //:   capacity, and the destructor releases all memory.
+        //:
+        //: 6 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Append elements one at a time using each of 'push_back' (both
+        //:   overloads) and 'emplace_back', and after each verify every
+        //:   accessor and the memory allocated.  (C-1..4)
+        //:
+        //: 2 Remove the elements using 'pop_back' and 'clear'.  (C-5)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid positions and empty objects.  (C-6)
+        //
+        // Testing:
+        //   size_type inlineCapacity();
+        //   SmallVector();
+        //   SmallVector(bslma::Allocator *basicAllocator);
+        //   ~SmallVector();
+        //   reference operator[](size_type position);
+        //   reference back();
+        //   iterator begin();
+        //   void clear();
+        //   pointer data();
+        //   reference emplace_back(ARGS&&... arguments);
+        //   iterator end();
+        //   reference front();
+        //   void pop_back();
+        //   void push_back(const TYPE& value);
+        //   void push_back(MovableRef<TYPE> value);
+        //   reverse_iterator rbegin();
+        //   reverse_iterator rend();
+        //   const_reference operator[](size_type position) const;
+        //   const_reference back() const;
+        //   const_iterator begin() const;
+        //   const_iterator cbegin() const;
+        //   size_type capacity() const;
+        //   const_iterator cend() const;
+        //   const_iterator end() const;
+        //   const_reverse_iterator crbegin() const;
+        //   const_reverse_iterator rbegin() const;
+        //   const_reverse_iterator crend() const;
+        //   const_reverse_iterator rend() const;
+        //   const_pointer data() const;
+        //   bool empty() const;
+        //   const_reference front() const;
+        //   bool isInline() const;
+        //   size_type size() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING PRIMARY MANIPULATORS AND BASIC ACCESSORS"
+                          << endl
+                          << "================================================"
+                          << endl;
+
+        bslma::TestAllocator da("default",   veryVeryVerbose);
+        bslma::TestAllocator sa("supplied",  veryVeryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        ASSERT(4 == Obj::inlineCapacity());
+
+        {
+            const Obj X;
+            ASSERT(&da == X.allocator());
+            ASSERT(X.empty());
+            ASSERT(X.isInline());
+        }
+        ASSERT(0 == da.numBlocksTotal());
+
+        for (int method = 0; method < 3; ++method) {
+            Obj mX(&sa);  const Obj& X = mX;
+
+            ASSERT(&sa == X.allocator());
+            ASSERT(X.empty());
+            ASSERT(X.isInline());
+            ASSERT(0 == X.size());
+            ASSERT(4 == X.capacity());
+            ASSERT(X.begin() == X.end());
+            ASSERT(X.rbegin() == X.rend());
+
+            bsl::vector<bsl::string> oracle(&sa);
+
+            for (int i = 0; i < 12; ++i) {
+                const bsl::string value(makeString(i, &sa), &sa);
+
+                const bsls::Types::Int64 before = sa.numBlocksTotal();
+
+                switch (method) {
+                  case 0: {
+                    mX.push_back(value);
+                  } break;
+                  case 1: {
+                    bsl::string temp(value, &sa);
+                    mX.push_back(bslmf::MovableRefUtil::move(temp));
+                  } break;
+                  default: {
+                    bsl::string& r = mX.emplace_back(value.c_str());
+                    LOOP2_ASSERT(method, i, &r == &X.back());
+                  } break;
+                }
+                // Each element allocates once (copy or 'emplace_back'), and
+                // the buffer when the capacity 4 or 8 is exceeded.
+
+                const int expected = 4 == i || 8 == i ? 2 : 1;
+                LOOP2_ASSERT(method, i,
+                             expected == sa.numBlocksTotal() - before);
+
+                oracle.push_back(value);
+
+                LOOP2_ASSERT(method, i, matchesOracle(X, oracle));
+                LOOP2_ASSERT(method, i, !X.empty());
+                LOOP2_ASSERT(method, i, X.size() == oracle.size());
+                LOOP2_ASSERT(method, i, (i < 4) == X.isInline());
+                LOOP2_ASSERT(method, i, X.capacity() >= X.size());
+                LOOP2_ASSERT(method, i, (i < 4) == (4 == X.capacity()));
+                LOOP2_ASSERT(method, i, value == X.back());
+                LOOP2_ASSERT(method, i, value == mX.back());
+                LOOP2_ASSERT(method, i, oracle.front() == X.front());
+                LOOP2_ASSERT(method, i, oracle.front() == mX.front());
+                LOOP2_ASSERT(method, i, value == X[i]);
+                LOOP2_ASSERT(method, i, value == mX[i]);
+                LOOP2_ASSERT(method, i, &*X.begin() == X.data());
+                LOOP2_ASSERT(method, i, mX.data() == X.data());
+                LOOP2_ASSERT(method, i, mX.begin() == X.cbegin());
+                LOOP2_ASSERT(method, i, mX.end() == X.cend());
+                LOOP2_ASSERT(method, i, X.end() - X.begin() == i + 1);
+                LOOP2_ASSERT(method, i, value == *X.rbegin());
+                LOOP2_ASSERT(method, i, value == *mX.rbegin());
+                LOOP2_ASSERT(method, i, value == *X.crbegin());
+                LOOP2_ASSERT(method, i, X.crend() == X.rend());
+                LOOP2_ASSERT(method, i, mX.rend() == X.rend());
+                LOOP2_ASSERT(method, i, &sa == X.back().get_allocator());
+            }
+
+            const bsl::size_t capacity = X.capacity();
+
+            mX.pop_back();
+            oracle.pop_back();
+            LOOP_ASSERT(method, matchesOracle(X, oracle));
+            LOOP_ASSERT(method, capacity == X.capacity());
+
+            mX.clear();
+            LOOP_ASSERT(method, X.empty());
+            LOOP_ASSERT(method, capacity == X.capacity());
+        }
+
+        ASSERT(0 == da.numBlocksTotal());
+        ASSERT(0 == sa.numBlocksInUse());
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            Obj mX(&sa);  const Obj& X = mX;
+
+            ASSERT_SAFE_FAIL(mX.back());
+            ASSERT_SAFE_FAIL(X.front());
+            ASSERT_SAFE_FAIL(mX.pop_back());
+            ASSERT_SAFE_FAIL(X[0]);
+
+            mX.push_back("a");
+
+            ASSERT_SAFE_PASS(mX.back());
+            ASSERT_SAFE_PASS(X.front());
+            ASSERT_SAFE_PASS(X[0]);
+            ASSERT_SAFE_FAIL(X[1]);
+            ASSERT_SAFE_FAIL(mX.erase(X.end()));
+            ASSERT_SAFE_PASS(mX.erase(X.begin()));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an object, append elements past the inline capacity,
+        //:   insert, erase, copy, and compare.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator sa("supplied",  veryVeryVerbose);
+
+        IntObj mX(&sa);  const IntObj& X = mX;
+
+        ASSERT(X.empty());
+        ASSERT(X.isInline());
+
+        for (int i = 0; i < 4; ++i) {
+            mX.push_back(i);
+        }
+        ASSERT(4 == X.size());
+        ASSERT(X.isInline());
+        ASSERT(0 == sa.numBlocksTotal());
+
+        mX.push_back(4);
+        ASSERT(5 == X.size());
+        ASSERT(!X.isInline());
+        ASSERT(1 == sa.numBlocksInUse());
+
+        mX.insert(X.begin(), -1);
+        ASSERT(-1 == X.front());
+        ASSERT( 4 == X.back());
+
+        mX.erase(X.begin(), X.begin() + 3);
+        ASSERT(3 == X.size());
+        ASSERT(2 == X[0]);
+
+        IntObj mY(X, &sa);  const IntObj& Y = mY;
+        ASSERT(X == Y);
+        ASSERT(Y.isInline());
+
+        mY.push_back(5);
+        ASSERT(X != Y);
+
+        mX.shrink_to_fit();
+        ASSERT(X.isInline());
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST: 'bdlc::SmallVector' vs. 'bsl::vector'
+        //   Compare the average time of filling and destroying short-lived
+        //   sequences of a range of lengths.
+        //
+        // Concerns:
+        //: 1 'bdlc::SmallVector' outperforms 'bsl::vector' for sequences that
+        //:   fit in its inline buffer, and is competitive otherwise.
+        //
+        // Plan:
+        //: 1 For each length from 1 to 16, time creating, filling, summing,
+        //:   and destroying the optionally specified (as the second
+        //:   command-line argument) number of objects (by default, 1,000,000)
+        //:   of each type, and print the results in nanoseconds per object.
+        //:   (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE TEST: 'bdlc::SmallVector' vs. 'bsl::vector'
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE TEST: 'bdlc::SmallVector' vs. 'bsl::vector'"
+             << endl
+             << "======================================================="
+             << endl;
+
+        const int numObjects = argc > 2 ? atoi(argv[2]) : 1000000;
+
+        typedef bdlc::SmallVector<int, 8> Small;
+        typedef bsl::vector<int>          Vector;
+
+        long checksum = 0;
+
+        cout << setw(8)  << "length"
+             << setw(16) << "small (ns)"
+             << setw(16) << "vector (ns)" << endl;
+
+        for (int length = 1; length <= 16; ++length) {
+            const double small  = u::timeFill<Small>(numObjects,
+                                                     length,
+                                                     &checksum);
+            const double vector = u::timeFill<Vector>(numObjects,
+                                                      length,
+                                                      &checksum);
+
+            cout << setw(8)  << length
+                 << setw(16) << fixed << setprecision(1) << small
+                 << setw(16) << fixed << setprecision(1) << vector << endl;
+        }
+
+        if (veryVerbose) { P(checksum) }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -42,6 +42,35 @@ BSLS_IDENT("$Id: $")
 // 'popFront' immediately and return an error code.  The queue may be restored
 // to normal operation with the 'enablePopFront' method.
 //
+///Batch Operations
+///----------------
+// The queue also provides methods for transferring a range of elements in a
+// single operation.  'tryPushBack', when supplied an iterator range, appends
+// as many elements from the front of the range as there is available capacity
+// (without blocking) and returns the number of elements appended.
+// 'popFront' and 'tryPopFront', when supplied a maximum number of items and a
+// 'bsl::vector', append up to that many elements to the vector; 'popFront'
+// blocks until at least one element is available.  A batch operation
+// acquires all of its capacity (or elements) from the semaphore with a single
+// atomic operation, reserves a contiguous run of nodes with a single update
+// of the push (or pop) index, and makes the transferred nodes visible to the
+// opposite side of the queue with a single 'post', so that a consumer blocked
+// on an empty queue is woken once per batch rather than once per element.
+// Elements pushed in a single batch appear in the queue contiguously and in
+// the order of the supplied range.
+//
+///Wait Strategy
+///-------------
+// By default, a thread invoking a blocking 'popFront' on an empty queue
+// blocks on a semaphore immediately, and is woken by a system call when an
+// element is pushed.  Latency-critical consumers can instead supply a
+// 'bdlcc::WaitStrategy' at construction, in which case a blocking 'popFront'
+// that finds the queue empty re-checks for an element the configured number
+// of times while spinning, and then while yielding, before it blocks (see
+// 'bdlcc_waitstrategy').  The 'waitStrategyCounters' accessor reports how many
+// of those waits were satisfied while spinning, were satisfied while
+// yielding, or blocked.
+//
 ///Template Requirements
 ///---------------------
 // 'bdlcc::BoundedQueue' is a template that is parameterized on the type of
@@ -56,7 +85,15 @@ BSLS_IDENT("$Id: $")
 ///----------------
 // A 'bdlcc::BoundedQueue' is exception neutral, and all of the methods of
 // 'bdlcc::BoundedQueue' provide the basic exception safety guarantee (see
-// 'bsldoc_glossary').
+// 'bsldoc_glossary').  Note that the batch 'popFront' and 'tryPopFront'
+// methods reserve capacity in the supplied vector for 'maxNumItems' elements
+// (but no more than the capacity of the queue) before acquiring any element,
+// so that an allocation failure leaves the queue unchanged.  These methods
+// then acquire all the elements they remove with a single operation, and
+// these elements are removed from the queue even if the copy or move of an
+// element into the vector throws: the elements already appended remain in the
+// vector, and the element being appended, and those not yet appended, are
+// destroyed.
 //
 ///Move Semantics in C++03
 ///-----------------------
@@ -178,6 +215,8 @@ BSLS_IDENT("$Id: $")
 
 #include <bdlscm_version.h>
 
+#include <bdlcc_waitstrategy.h>
+
 #include <bdlb_bitutil.h>
 
 #include <bslalg_scalarprimitives.h>
@@ -198,7 +237,12 @@ BSLS_IDENT("$Id: $")
 #include <bsls_objectbuffer.h>
 #include <bsls_types.h>
 
+#include <bsl_algorithm.h>
+#include <bsl_climits.h>
+#include <bsl_cstddef.h>
 #include <bsl_cstdint.h>
+#include <bsl_iterator.h>
+#include <bsl_vector.h>
 
 namespace BloombergLP {
 namespace bdlcc {
@@ -272,6 +316,117 @@ class BoundedQueue_PushExceptionCompleteProctor {
         // If no queue is currently managed, this method has no effect.
 };
 
+                // ===========================================
+                // class BoundedQueue_PopRangeCompleteGuard
+                // ===========================================
+
+template <class TYPE, class NODE>
+class BoundedQueue_PopRangeCompleteGuard {
+    // This class implements a guard that locates, in order, the nodes holding
+    // a reserved number of values to be popped from a 'TYPE' queue, destroys
+    // the value of each located node when the next node is requested, and,
+    // upon destruction, destroys the values that were not yet located and
+    // invokes 'TYPE::popRangeComplete'.
+
+    // PRIVATE TYPES
+    typedef bsls::Types::Uint64         Uint64;
+    typedef typename TYPE::value_type   ValueType;
+
+    // DATA
+    TYPE   *d_queue_p;    // managed queue owning the managed nodes
+    NODE   *d_node_p;     // most recently located node, or 0
+    Uint64  d_index;      // index of the next node of the current run
+    Uint64  d_numInRun;   // number of unexamined nodes in the current run
+    Uint64  d_numToPop;   // number of values not yet located
+    Uint64  d_numPopped;  // number of values destroyed
+    Uint64  d_numSkipped; // number of nodes marked for reclamation skipped
+    bool    d_isEmpty;    // if true, the empty condition will be signalled
+
+    // NOT IMPLEMENTED
+    BoundedQueue_PopRangeCompleteGuard();
+    BoundedQueue_PopRangeCompleteGuard(
+                                    const BoundedQueue_PopRangeCompleteGuard&);
+    BoundedQueue_PopRangeCompleteGuard& operator=(
+                                    const BoundedQueue_PopRangeCompleteGuard&);
+
+    // PRIVATE MANIPULATORS
+    void locate();
+        // Reserve further node indices from the managed queue if the current
+        // run is exhausted, and load into 'd_node_p' the next node of the
+        // current run not marked for reclamation.  The behavior is undefined
+        // unless a value remains to be located and 'd_node_p' is 0.
+
+    void release();
+        // Destroy the value of the most recently located node, if any.
+
+  public:
+    // CREATORS
+    BoundedQueue_PopRangeCompleteGuard(TYPE   *queue,
+                                       Uint64  numToPop,
+                                       bool    isEmpty);
+        // Create a 'popRangeComplete' guard managing the specified 'numToPop'
+        // values to be popped from the specified 'queue' that will cause the
+        // empty condition to be signalled if the specified 'isEmpty' is
+        // 'true'.  The behavior is undefined unless 'numToPop' "pop"
+        // operations have been started, but no node indices have been
+        // reserved, on 'queue'.
+
+    ~BoundedQueue_PopRangeCompleteGuard();
+        // Destroy this object, destroy the values of the managed nodes that
+        // have not yet been destroyed, and invoke the 'TYPE::popRangeComplete'
+        // method.
+
+    // MANIPULATORS
+    NODE *next();
+        // Destroy the value of the most recently located node, if any, and
+        // return the next node holding a value to be popped.  The behavior
+        // is undefined if 'next' has already been invoked 'numToPop' times.
+};
+
+               // ===========================================
+               // class BoundedQueue_PushRangeCompleteGuard
+               // ===========================================
+
+template <class TYPE>
+class BoundedQueue_PushRangeCompleteGuard {
+    // This class implements a guard that invokes 'TYPE::pushRangeComplete'
+    // upon destruction, supplying the number of nodes of a reserved range into
+    // which values have been constructed.
+
+    // PRIVATE TYPES
+    typedef bsls::Types::Uint64 Uint64;
+
+    // DATA
+    TYPE   *d_queue_p;         // managed queue
+    Uint64  d_index;           // index of the first reserved node
+    Uint64  d_numReserved;     // number of reserved nodes
+    Uint64  d_numConstructed;  // number of constructed nodes
+
+    // NOT IMPLEMENTED
+    BoundedQueue_PushRangeCompleteGuard();
+    BoundedQueue_PushRangeCompleteGuard(
+                                   const BoundedQueue_PushRangeCompleteGuard&);
+    BoundedQueue_PushRangeCompleteGuard& operator=(
+                                   const BoundedQueue_PushRangeCompleteGuard&);
+
+  public:
+    // CREATORS
+    BoundedQueue_PushRangeCompleteGuard(TYPE   *queue,
+                                        Uint64  index,
+                                        Uint64  numReserved);
+        // Create a 'pushRangeComplete' guard managing the specified
+        // 'numReserved' nodes of the specified 'queue' starting at the
+        // specified 'index', none of which has yet been constructed.
+
+    ~BoundedQueue_PushRangeCompleteGuard();
+        // Destroy this object and invoke the 'TYPE::pushRangeComplete' method
+        // with the managed range and the number of constructed nodes.
+
+    // MANIPULATORS
+    void increment();
+        // Increment the number of constructed nodes of the managed range.
+};
+
                          // ========================
                          // struct BoundedQueue_Node
                          // ========================
@@ -394,6 +549,12 @@ class BoundedQueue {
     mutable bslmt::Condition  d_emptyCondition;  // condition variable for
                                                  // 'waitUntilEmpty'
 
+    WaitStrategy              d_waitStrategy;    // strategy for blocking
+                                                 // "pop" operations
+
+    WaitStrategyCounters      d_waitCounters;    // outcomes of the waits of
+                                                 // blocking "pop" operations
+
     bslma::Allocator         *d_allocator_p;     // allocator, held not owned
 
     // FRIENDS
@@ -404,6 +565,12 @@ class BoundedQueue {
     friend class BoundedQueue_PushExceptionCompleteProctor<
                                                           BoundedQueue<TYPE> >;
 
+    friend class BoundedQueue_PopRangeCompleteGuard<
+                                            BoundedQueue<TYPE>,
+                                            typename BoundedQueue<TYPE>::Node>;
+
+    friend class BoundedQueue_PushRangeCompleteGuard<BoundedQueue<TYPE> >;
+
     // PRIVATE CLASS METHODS
     static bool isQuiescentState(bsls::Types::Uint64 count);
         // Return 'true' if the specified 'count' implies a quiescent state
@@ -422,6 +589,29 @@ class BoundedQueue {
         // element into the specified 'value'.  This method is invoked by
         // 'popFront' and 'tryPopFront' once an element is available.
 
+    void popFrontRange(Uint64 numToPop, bsl::vector<TYPE> *buffer);
+        // Remove the specified 'numToPop' elements from the front of this
+        // queue and append them, in order, to the specified 'buffer'.  This
+        // method is invoked by the batch 'popFront' and 'tryPopFront' once
+        // 'numToPop' elements have been acquired from 'd_popSemaphore'.  The
+        // behavior is undefined unless 'buffer' has the capacity to hold
+        // 'numToPop' more elements.  If the copy or move of an element
+        // throws, the elements already appended remain in 'buffer', and the
+        // other elements are removed and destroyed.
+
+    void popRangeComplete(Uint64 numPopped, Uint64 numSkipped, bool isEmpty);
+        // Mark the specified 'numPopped' "pop" operations, and the "pop"
+        // operations of the specified 'numSkipped' nodes marked for
+        // reclamation, as complete, 'post' to the 'd_pushSemaphore' if
+        // appropriate, and if the specified 'isEmpty' is 'true' then signal
+        // the queue empty condition.  This method is used within
+        // 'popFrontRange' by a guard.
+
+    Uint64 reservePopIndices(Uint64 numIndices);
+        // Reserve the specified 'numIndices' consecutive node indices for
+        // "pop" operations, mark the "pop" operations of the reserved nodes as
+        // started, and return the first reserved index.
+
     void pushComplete();
         // Mark a "push" operation as complete, and 'post' to the
         // 'd_popSemaphore' if appropriate.
@@ -432,6 +622,23 @@ class BoundedQueue {
         // 'pushFront' by a proctor to complete the marking of a node to
         // reclaim in the presence of an exception.
 
+    void pushRangeComplete(Uint64 index,
+                           Uint64 numReserved,
+                           Uint64 numConstructed);
+        // Mark the first specified 'numConstructed' of the specified
+        // 'numReserved' nodes starting at the specified 'index' as pushed,
+        // mark the remaining nodes for reclamation, and 'post' to the
+        // 'd_popSemaphore' if appropriate.  This method is used within the
+        // batch 'tryPushBack' by a guard, and also completes the "push"
+        // operation in the presence of an exception.
+
+    int waitToPop();
+        // Acquire one element from 'd_popSemaphore', spinning and then
+        // yielding as configured by 'd_waitStrategy' before blocking, and
+        // record the outcome of the wait in 'd_waitCounters'.  Return 0 on
+        // success, and the non-zero value returned by 'd_popSemaphore'
+        // otherwise.
+
     // NOT IMPLEMENTED
     BoundedQueue(const BoundedQueue&);
     BoundedQueue& operator=(const BoundedQueue&);
@@ -455,10 +662,16 @@ class BoundedQueue {
     // CREATORS
     explicit
     BoundedQueue(bsl::size_t capacity, bslma::Allocator *basicAllocator = 0);
+    BoundedQueue(bsl::size_t          capacity,
+                 const WaitStrategy&  waitStrategy,
+                 bslma::Allocator    *basicAllocator = 0);
         // Create a thread-aware queue with, at least, the specified
-        // 'capacity'.  Optionally specify a 'basicAllocator' used to supply
-        // memory.  If 'basicAllocator' is 0, the currently installed default
-        // allocator is used.
+        // 'capacity'.  Optionally specify a 'waitStrategy' used by blocking
+        // 'popFront' invocations that find the queue empty (see
+        // {Wait Strategy}).  If 'waitStrategy' is not specified, such
+        // invocations block immediately.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.
 
     ~BoundedQueue();
         // Destroy this object.
@@ -474,6 +687,26 @@ class BoundedQueue {
         // the queue being empty will return 'e_DISABLED' if 'disablePopFront'
         // is invoked.
 
+    int popFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *buffer);
+        // Remove up to the specified 'maxNumItems' elements from the front of
+        // this queue and append them, in order, to the specified 'buffer'.  If
+        // the queue is empty, block until it is not empty.  Return 0 on
+        // success, and a non-zero value otherwise.  Specifically, return
+        // 'e_SUCCESS' on success, 'e_DISABLED' if 'isPopFrontDisabled()' and
+        // 'e_FAILED' if an error occurs.  On failure, 'buffer' is not changed.
+        // Threads blocked due to the queue being empty will return
+        // 'e_DISABLED' if 'disablePopFront' is invoked.  The capacity of
+        // 'buffer' is grown to hold 'maxNumItems' more elements (but no more
+        // than the capacity of this queue) before any element is removed, so
+        // that an allocation failure leaves this queue unchanged.  If the
+        // copy or move of an element into 'buffer' throws, the elements
+        // already appended remain in 'buffer', and the other removed elements
+        // are destroyed (see {Exception safety}).  The behavior is undefined
+        // unless '0 < maxNumItems'.  Note that at least one element is
+        // appended to 'buffer' on success, and that all the removed elements
+        // are acquired with a single operation on the queue (see {Batch
+        // Operations}).
+
     int pushBack(const TYPE& value);
         // Append the specified 'value' to the back of this queue.  If the
         // queue is full, block until it is not full.  Return 0 on success, and
@@ -507,6 +740,23 @@ class BoundedQueue {
         // '!isPopFrontDisabled()' and the queue was empty, and 'e_FAILED' if
         // an error occurs.  On failure, 'value' is not changed.
 
+    int tryPopFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *buffer);
+        // Attempt to remove up to the specified 'maxNumItems' elements from
+        // the front of this queue without blocking, and append the removed
+        // elements, in order, to the specified 'buffer'.  Return 0 on success,
+        // and a non-zero value otherwise.  Specifically, return 'e_SUCCESS' on
+        // success, 'e_DISABLED' if 'isPopFrontDisabled()', 'e_EMPTY' if
+        // '!isPopFrontDisabled()' and the queue was empty, and 'e_FAILED' if
+        // an error occurs.  On failure, 'buffer' is not changed.  The
+        // capacity of 'buffer' is grown to hold 'maxNumItems' more elements
+        // (but no more than the capacity of this queue) before any element is
+        // removed, so that an allocation failure leaves this queue unchanged.
+        // If the copy or move of an element into 'buffer' throws, the
+        // elements already appended remain in 'buffer', and the other removed
+        // elements are destroyed (see {Exception safety}).  The behavior is
+        // undefined unless '0 < maxNumItems'.  Note that at least one element
+        // is appended to 'buffer' on success.
+
     int tryPushBack(const TYPE& value);
         // Append the specified 'value' to the back of this queue.  Return 0 on
         // success, and a non-zero value otherwise.  Specifically, return
@@ -522,6 +772,20 @@ class BoundedQueue {
         // 'e_FULL' if '!isPushBackDisabled()' and the queue was full, and
         // 'e_FAILED' if an error occurs.  On failure, 'value' is not changed.
 
+    template <class FORWARD_ITER>
+    bsl::size_t tryPushBack(FORWARD_ITER begin, FORWARD_ITER end);
+        // Append, without blocking, the longest prefix of the elements in the
+        // range starting at the specified 'begin' and ending immediately
+        // before the specified 'end' for which this queue has available
+        // capacity to the back of this queue, in order, and return the number
+        // of elements appended.  Return 0, and append no elements, if
+        // 'isPushBackDisabled()' or the queue is full.  The behavior is
+        // undefined unless '[begin .. end)' is a valid range of elements
+        // convertible to 'TYPE'.  Note that the capacity for the appended
+        // elements is acquired, and the appended elements are made available
+        // to "pop" operations, with a single operation on the queue (see
+        // {Batch Operations}).
+
                        // Enqueue/Dequeue State
 
     void disablePopFront();
@@ -576,6 +840,15 @@ class BoundedQueue {
         // the queue to empty will return 'e_DISABLED' if 'disablePopFront' is
         // invoked.
 
+    const WaitStrategy& waitStrategy() const;
+        // Return a reference providing non-modifiable access to the wait
+        // strategy used by blocking 'popFront' invocations.
+
+    const WaitStrategyCounters& waitStrategyCounters() const;
+        // Return a reference providing non-modifiable access to the counters
+        // of the outcomes of the waits of blocking 'popFront' invocations
+        // that found this queue empty.
+
                                   // Aspects
 
     bslma::Allocator *allocator() const;
@@ -641,6 +914,129 @@ void BoundedQueue_PushExceptionCompleteProctor<TYPE>::release()
     d_queue_p = 0;
 }
 
+                // -------------------------------------------
+                // class BoundedQueue_PopRangeCompleteGuard
+                // -------------------------------------------
+
+// PRIVATE MANIPULATORS
+template <class TYPE, class NODE>
+void BoundedQueue_PopRangeCompleteGuard<TYPE, NODE>::locate()
+{
+    while (true) {
+        if (0 == d_numInRun) {
+            d_numInRun = d_numToPop;
+            d_index    = d_queue_p->reservePopIndices(d_numInRun);
+        }
+
+        NODE *node = &d_queue_p->d_element_p[d_index % d_queue_p->d_capacity];
+
+        ++d_index;
+        --d_numInRun;
+
+        // Nodes marked for reclamation are not counted in 'd_popSemaphore'
+        // and are skipped (see 'BoundedQueue::popFrontHelper').
+
+        if (!node->reclaim()) {
+            --d_numToPop;
+            d_node_p = node;
+            return;                                                   // RETURN
+        }
+
+        ++d_numSkipped;
+    }
+}
+
+template <class TYPE, class NODE>
+inline
+void BoundedQueue_PopRangeCompleteGuard<TYPE, NODE>::release()
+{
+    if (d_node_p) {
+        d_node_p->d_value.object().~ValueType();
+        d_node_p = 0;
+        ++d_numPopped;
+    }
+}
+
+// CREATORS
+template <class TYPE, class NODE>
+inline
+BoundedQueue_PopRangeCompleteGuard<TYPE, NODE>::
+                         BoundedQueue_PopRangeCompleteGuard(TYPE   *queue,
+                                                            Uint64  numToPop,
+                                                            bool    isEmpty)
+: d_queue_p(queue)
+, d_node_p(0)
+, d_index(0)
+, d_numInRun(0)
+, d_numToPop(numToPop)
+, d_numPopped(0)
+, d_numSkipped(0)
+, d_isEmpty(isEmpty)
+{
+}
+
+template <class TYPE, class NODE>
+BoundedQueue_PopRangeCompleteGuard<TYPE, NODE>::
+                                          ~BoundedQueue_PopRangeCompleteGuard()
+{
+    release();
+
+    // In the presence of an exception, the values not yet located are still
+    // removed from the queue.
+
+    while (0 < d_numToPop) {
+        locate();
+        release();
+    }
+
+    d_queue_p->popRangeComplete(d_numPopped, d_numSkipped, d_isEmpty);
+}
+
+// MANIPULATORS
+template <class TYPE, class NODE>
+inline
+NODE *BoundedQueue_PopRangeCompleteGuard<TYPE, NODE>::next()
+{
+    release();
+    locate();
+
+    return d_node_p;
+}
+
+               // -------------------------------------------
+               // class BoundedQueue_PushRangeCompleteGuard
+               // -------------------------------------------
+
+// CREATORS
+template <class TYPE>
+inline
+BoundedQueue_PushRangeCompleteGuard<TYPE>::
+                      BoundedQueue_PushRangeCompleteGuard(TYPE   *queue,
+                                                          Uint64  index,
+                                                          Uint64  numReserved)
+: d_queue_p(queue)
+, d_index(index)
+, d_numReserved(numReserved)
+, d_numConstructed(0)
+{
+}
+
+template <class TYPE>
+inline
+BoundedQueue_PushRangeCompleteGuard<TYPE>::
+                                         ~BoundedQueue_PushRangeCompleteGuard()
+{
+    d_queue_p->pushRangeComplete(d_index, d_numReserved, d_numConstructed);
+}
+
+// MANIPULATORS
+template <class TYPE>
+inline
+void BoundedQueue_PushRangeCompleteGuard<TYPE>::increment()
+{
+    ++d_numConstructed;
+}
+
                          // ------------------------
                          // struct BoundedQueue_Node
                          // ------------------------
@@ -753,6 +1149,70 @@ void BoundedQueue<TYPE>::popFrontHelper(TYPE *value)
 #endif
 }
 
+template <class TYPE>
+void BoundedQueue<TYPE>::popFrontRange(Uint64             numToPop,
+                                       bsl::vector<TYPE> *buffer)
+{
+    bool empty = isEmpty();
+
+    BoundedQueue_PopRangeCompleteGuard<BoundedQueue<TYPE>, Node>
+                                                  guard(this, numToPop, empty);
+
+    for (Uint64 i = 0; i < numToPop; ++i) {
+        Node *node = guard.next();
+
+#if defined(BSLMF_MOVABLEREF_USES_RVALUE_REFERENCES)
+        buffer->push_back(bslmf::MovableRefUtil::move(node->d_value.object()));
+#else
+        buffer->push_back(node->d_value.object());
+#endif
+    }
+}
+
+template <class TYPE>
+void BoundedQueue<TYPE>::popRangeComplete(Uint64 numPopped,
+                                          Uint64 numSkipped,
+                                          bool   isEmpty)
+{
+    Uint64 count = AtomicOp::addUint64NvAcqRel(
+                                    &d_popCount,
+                                    (numPopped + numSkipped) * k_FINISHED_INC);
+    if (isQuiescentState(count)) {
+
+        // The total number of popped elements is 'count & k_STARTED_MASK'.
+        // Attempt, once, to zero the count and, if successful, post to the
+        // push semaphore.
+
+        if (AtomicOp::testAndSwapUint64AcqRel(&d_popCount,
+                                              count,
+                                              0) == count) {
+            d_pushSemaphore.post(static_cast<int>(count & k_STARTED_MASK));
+        }
+    }
+
+    if (isEmpty) {
+        AtomicOp::addUintAcqRel(&d_emptyGeneration, 1);
+        if (0 < AtomicOp::getUintAcquire(&d_emptyCount)) {
+            {
+                bslmt::LockGuard<bslmt::Mutex> guard(&d_emptyMutex);
+            }
+            d_emptyCondition.broadcast();
+        }
+    }
+}
+
+template <class TYPE>
+inline
+typename BoundedQueue<TYPE>::Uint64
+BoundedQueue<TYPE>::reservePopIndices(Uint64 numIndices)
+{
+    AtomicOp::addUint64AcqRel(&d_popCount, numIndices * k_STARTED_INC);
+
+    // 'd_popIndex' stores the next location to use (want the original value)
+
+    return AtomicOp::addUint64NvAcqRel(&d_popIndex, numIndices) - numIndices;
+}
+
 template <class TYPE>
 void BoundedQueue<TYPE>::pushComplete()
 {
@@ -792,6 +1252,62 @@ void BoundedQueue<TYPE>::pushExceptionComplete()
     }
 }
 
+template <class TYPE>
+void BoundedQueue<TYPE>::pushRangeComplete(Uint64 index,
+                                           Uint64 numReserved,
+                                           Uint64 numConstructed)
+{
+    for (Uint64 i = numConstructed; i < numReserved; ++i) {
+        d_element_p[(index + i) % d_capacity].assignReclaim(true);
+    }
+
+    // Nodes marked for reclamation are removed from the started "push"
+    // operations (see 'pushExceptionComplete').
+
+    Uint64 count = AtomicOp::addUint64NvAcqRel(
+                                 &d_pushCount,
+                                 numConstructed * k_FINISHED_INC
+                                  - (numReserved - numConstructed)
+                                                             * k_STARTED_INC);
+
+    int numToPost = static_cast<int>(count & k_STARTED_MASK);
+
+    if (0 != numToPost && isQuiescentState(count)) {
+
+        // The total number of pushed elements is 'count & k_STARTED_MASK'.
+        // Attempt, once, to zero the count and, if successful, post to the pop
+        // semaphore.
+
+        if (AtomicOp::testAndSwapUint64AcqRel(&d_pushCount,
+                                               count,
+                                               0) == count) {
+            d_popSemaphore.post(numToPost);
+        }
+    }
+}
+
+template <class TYPE>
+int BoundedQueue<TYPE>::waitToPop()
+{
+    int rv = d_popSemaphore.tryWait();
+    if (bslmt::FastPostSemaphore::e_WOULD_BLOCK != rv) {
+        return rv;                                                    // RETURN
+    }
+
+    WaitStrategyBackoff backoff(d_waitStrategy, &d_waitCounters);
+    while (backoff.backoff()) {
+        rv = d_popSemaphore.tryWait();
+        if (bslmt::FastPostSemaphore::e_WOULD_BLOCK != rv) {
+            if (0 == rv) {
+                backoff.recordAcquire();
+            }
+            return rv;                                                // RETURN
+        }
+    }
+
+    return d_popSemaphore.wait();
+}
+
 // CREATORS
 template <class TYPE>
 BoundedQueue<TYPE>::BoundedQueue(bsl::size_t       capacity,
@@ -802,6 +1318,40 @@ BoundedQueue<TYPE>::BoundedQueue(bsl::size_t       capacity,
 , d_capacity(capacity > 2 ? capacity : 2)
 , d_emptyMutex()
 , d_emptyCondition()
+, d_waitStrategy()
+, d_waitCounters()
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    AtomicOp::initUint64(&d_pushCount, 0);
+    AtomicOp::initUint64(&d_pushIndex, 0);
+    AtomicOp::initUint64(&d_popCount,  0);
+    AtomicOp::initUint64(&d_popIndex,  0);
+
+    AtomicOp::initUint(&d_emptyCount,      0);
+    AtomicOp::initUint(&d_emptyGeneration, 0);
+
+    d_element_p = static_cast<Node *>(
+                           d_allocator_p->allocate(d_capacity * sizeof(Node)));
+
+    for (bsl::size_t i = 0; i < d_capacity; ++i) {
+        d_element_p[i].assignReclaim(false);
+    }
+
+    d_pushSemaphore.post(static_cast<int>(d_capacity));
+}
+
+template <class TYPE>
+BoundedQueue<TYPE>::BoundedQueue(bsl::size_t          capacity,
+                                 const WaitStrategy&  waitStrategy,
+                                 bslma::Allocator    *basicAllocator)
+: d_pushSemaphore()
+, d_popSemaphore()
+, d_element_p(0)
+, d_capacity(capacity > 2 ? capacity : 2)
+, d_emptyMutex()
+, d_emptyCondition()
+, d_waitStrategy(waitStrategy)
+, d_waitCounters()
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     AtomicOp::initUint64(&d_pushCount, 0);
@@ -836,7 +1386,7 @@ template <class TYPE>
 inline
 int BoundedQueue<TYPE>::popFront(TYPE *value)
 {
-    int rv = d_popSemaphore.wait();
+    int rv = waitToPop();
     if (rv) {
         if (bslmt::FastPostSemaphore::e_DISABLED == rv) {
             return e_DISABLED;                                        // RETURN
@@ -849,6 +1399,43 @@ int BoundedQueue<TYPE>::popFront(TYPE *value)
     return e_SUCCESS;
 }
 
+template <class TYPE>
+int BoundedQueue<TYPE>::popFront(bsl::size_t        maxNumItems,
+                                 bsl::vector<TYPE> *buffer)
+{
+    BSLS_ASSERT(0 < maxNumItems);
+    BSLS_ASSERT(buffer);
+
+    // Reserve before acquiring any element, so that only the copy or move of
+    // an element can throw once the elements are removed from the queue.
+
+    buffer->reserve(buffer->size() +
+                    bsl::min(maxNumItems,
+                             static_cast<bsl::size_t>(d_capacity)));
+
+    int rv = waitToPop();
+    if (rv) {
+        if (bslmt::FastPostSemaphore::e_DISABLED == rv) {
+            return e_DISABLED;                                        // RETURN
+        }
+        return e_FAILED;                                              // RETURN
+    }
+
+    // Acquire, without blocking, as many of the remaining requested elements
+    // as are available.
+
+    int numToPop = 1;
+    if (1 < maxNumItems) {
+        numToPop += d_popSemaphore.take(maxNumItems - 1 < INT_MAX
+                                        ? static_cast<int>(maxNumItems - 1)
+                                        : INT_MAX - 1);
+    }
+
+    popFrontRange(numToPop, buffer);
+
+    return e_SUCCESS;
+}
+
 template <class TYPE>
 int BoundedQueue<TYPE>::pushBack(const TYPE& value)
 {
@@ -980,6 +1567,40 @@ int BoundedQueue<TYPE>::tryPopFront(TYPE *value)
     return e_SUCCESS;
 }
 
+template <class TYPE>
+int BoundedQueue<TYPE>::tryPopFront(bsl::size_t        maxNumItems,
+                                    bsl::vector<TYPE> *buffer)
+{
+    BSLS_ASSERT(0 < maxNumItems);
+    BSLS_ASSERT(buffer);
+
+    buffer->reserve(buffer->size() +
+                    bsl::min(maxNumItems,
+                             static_cast<bsl::size_t>(d_capacity)));
+
+    int rv = d_popSemaphore.tryWait();
+    if (rv) {
+        if (bslmt::FastPostSemaphore::e_DISABLED == rv) {
+            return e_DISABLED;                                        // RETURN
+        }
+        if (bslmt::FastPostSemaphore::e_WOULD_BLOCK == rv) {
+            return e_EMPTY;                                           // RETURN
+        }
+        return e_FAILED;                                              // RETURN
+    }
+
+    int numToPop = 1;
+    if (1 < maxNumItems) {
+        numToPop += d_popSemaphore.take(maxNumItems - 1 < INT_MAX
+                                        ? static_cast<int>(maxNumItems - 1)
+                                        : INT_MAX - 1);
+    }
+
+    popFrontRange(numToPop, buffer);
+
+    return e_SUCCESS;
+}
+
 template <class TYPE>
 int BoundedQueue<TYPE>::tryPushBack(const TYPE& value)
 {
@@ -1059,6 +1680,58 @@ int BoundedQueue<TYPE>::tryPushBack(bslmf::MovableRef<TYPE> value)
     return e_SUCCESS;
 }
 
+template <class TYPE>
+template <class FORWARD_ITER>
+bsl::size_t BoundedQueue<TYPE>::tryPushBack(FORWARD_ITER begin,
+                                            FORWARD_ITER end)
+{
+    if (begin == end) {
+        return 0;                                                     // RETURN
+    }
+
+    if (0 != d_pushSemaphore.tryWait()) {
+        return 0;                                                     // RETURN
+    }
+
+    // Acquire, without blocking, capacity for as many of the remaining
+    // elements as is available.
+
+    const bsl::size_t numRemaining = bsl::distance(begin, end) - 1;
+
+    int numReserved = 1;
+    if (0 < numRemaining) {
+        numReserved += d_pushSemaphore.take(numRemaining < INT_MAX
+                                            ? static_cast<int>(numRemaining)
+                                            : INT_MAX - 1);
+    }
+
+    AtomicOp::addUint64AcqRel(&d_pushCount, numReserved * k_STARTED_INC);
+
+    // 'd_pushIndex' stores the next location to use (want the original value)
+
+    Uint64 index = AtomicOp::addUint64NvAcqRel(&d_pushIndex, numReserved)
+                                                                 - numReserved;
+
+    BoundedQueue_PushRangeCompleteGuard<BoundedQueue<TYPE> > guard(
+                                                                  this,
+                                                                  index,
+                                                                  numReserved);
+
+    for (int i = 0; i < numReserved; ++i, ++begin) {
+        Node& node = d_element_p[(index + i) % d_capacity];
+
+        bslalg::ScalarPrimitives::copyConstruct<TYPE>(node.d_value.address(),
+                                                      *begin,
+                                                      d_allocator_p);
+
+        node.assignReclaim(false);
+
+        guard.increment();
+    }
+
+    return numReserved;
+}
+
                        // Enqueue/Dequeue State
 
 template <class TYPE>
@@ -1164,6 +1837,20 @@ int BoundedQueue<TYPE>::waitUntilEmpty() const
     return e_SUCCESS;
 }
 
+template <class TYPE>
+inline
+const WaitStrategy& BoundedQueue<TYPE>::waitStrategy() const
+{
+    return d_waitStrategy;
+}
+
+template <class TYPE>
+inline
+const WaitStrategyCounters& BoundedQueue<TYPE>::waitStrategyCounters() const
+{
+    return d_waitCounters;
+}
+
                                   // Aspects
 
 template <class TYPE>
@@ -77,6 +77,7 @@ using namespace bsl;
 //: o ACCESSOR methods are 'const' thread-safe.
 // ----------------------------------------------------------------------------
 // [ 2] BoundedQueue(bsl::size_t capacity, bslma::Allocator bA = 0);
+// [13] BoundedQueue(size_t capacity, const WaitStrategy&, Allocator bA = 0);
 // [ 2] ~BoundedQueue();
 // [ 2] int popFront(TYPE *value);
 // [ 2] int pushBack(const TYPE& value);
@@ -85,6 +86,9 @@ using namespace bsl;
 // [ 7] int tryPopFront(TYPE *value);
 // [ 6] int tryPushBack(const TYPE& value);
 // [ 9] int tryPushBack(bslmf::MovableRef<TYPE> value);
+// [12] int popFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *buffer);
+// [12] int tryPopFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *buffer);
+// [12] bsl::size_t tryPushBack(FORWARD_ITER begin, FORWARD_ITER end);
 // [ 5] void disablePopFront();
 // [ 5] void disablePushBack();
 // [ 5] void enablePopFront();
@@ -96,9 +100,11 @@ using namespace bsl;
 // [ 4] bsl::size_t numElements() const;
 // [ 8] int waitUntilEmpty() const;
 // [ 4] bslma::Allocator *allocator() const;
+// [13] const WaitStrategy& waitStrategy() const;
+// [13] const WaitStrategyCounters& waitStrategyCounters() const;
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [12] USAGE EXAMPLE
+// [14] USAGE EXAMPLE
 // [ 3] Obj& gg(Obj *object, const char *spec);
 // [ 3] int ggg(Obj *object, const char *spec);
 // [ 2] CONCERN: 0 == e_SUCCESS
@@ -106,6 +112,8 @@ using namespace bsl;
 // [ 9] CONCERN: 'popFront' and 'tryPopFront' honor move-semantics
 // [10] CONCERN: template requirements
 // [11] CONCERN: ordering guarantee
+// [12] CONCERN: batch operations
+// [13] CONCERN: wait strategy
 // ----------------------------------------------------------------------------
 
 // ============================================================================
@@ -152,6 +160,13 @@ void aSsErT(bool condition, const char *message, int line)
 #define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
 #define L_           BSLIM_TESTUTIL_L_  // current Line number
 
+// ============================================================================
+//                     NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_FAIL(expr) BSLS_ASSERTTEST_ASSERT_FAIL(expr)
+#define ASSERT_PASS(expr) BSLS_ASSERTTEST_ASSERT_PASS(expr)
+
 // ============================================================================
 //                        GLOBAL MACROS FOR TESTING
 // ----------------------------------------------------------------------------
@@ -512,6 +527,17 @@ extern "C" void *deferredDisablePopFront(void *arg)
     return 0;
 }
 
+extern "C" void *deferredPushBack(void *arg)
+{
+    Obj& mX = *static_cast<Obj *>(arg);
+
+    bslmt::ThreadUtil::microSleep(k_DECISECOND);
+
+    mX.pushBack(7);
+
+    return 0;
+}
+
 static bsls::TimeInterval s_deferredPopFrontInterval;
 
 extern "C" void *deferredPopFront(void *arg)
@@ -735,6 +761,160 @@ void orderingGuaranteeTest(const int numPushThread, const int numPopThread)
     bslmt::ThreadUtil::join(watchdogHandle);
 }
 
+struct BatchPopData {
+    OrderingObj                                              *d_obj_p;
+    bsl::unordered_map<bsls::Types::Uint64, bsls::Types::Uint64>
+                                                              d_sequenceNumber;
+    bsl::size_t                                               d_numPopped;
+    bool                                                      d_isStrongTest;
+};
+
+extern "C" void *batchPop(void *arg)
+{
+    BatchPopData *data = static_cast<BatchPopData *>(arg);
+    OrderingObj&  mX   = *data->d_obj_p;
+
+    bsl::vector<OrderingValue> buffer;
+
+    bsl::size_t maxNumItems = 1;
+
+    while (0 == mX.popFront(maxNumItems, &buffer)) {
+        ASSERTV(maxNumItems, buffer.size(), 0 < buffer.size());
+        ASSERTV(maxNumItems, buffer.size(), maxNumItems >= buffer.size());
+
+        for (bsl::size_t i = 0; i < buffer.size(); ++i) {
+            bsls::Types::Uint64 pushThreadId   = buffer[i].d_pushThreadId;
+            bsls::Types::Uint64 sequenceNumber = buffer[i].d_sequenceNumber;
+
+            bsls::Types::Uint64& lastSequenceNumber =
+                                          data->d_sequenceNumber[pushThreadId];
+
+            if (data->d_isStrongTest) {
+                ASSERTV(pushThreadId,
+                        lastSequenceNumber,
+                        sequenceNumber,
+                        lastSequenceNumber + 1 == sequenceNumber);
+            }
+            else {
+                ASSERTV(pushThreadId,
+                        lastSequenceNumber,
+                        sequenceNumber,
+                        lastSequenceNumber < sequenceNumber);
+            }
+
+            lastSequenceNumber = sequenceNumber;
+        }
+
+        data->d_numPopped += buffer.size();
+        buffer.clear();
+
+        maxNumItems = maxNumItems % 11 + 1;
+    }
+
+    return 0;
+}
+
+const bsls::Types::Uint64 k_NUM_BATCH_VALUES = 20000;  // per push thread
+
+extern "C" void *batchPush(void *arg)
+{
+    OrderingObj& mX = *static_cast<OrderingObj *>(arg);
+
+    bsl::vector<OrderingValue> values;
+
+    bsls::Types::Uint64 pushThreadId   = bslmt::ThreadUtil::selfIdAsUint64();
+    bsls::Types::Uint64 sequenceNumber = 1;
+
+    bsl::size_t batchSize = 1;
+
+    while (sequenceNumber <= k_NUM_BATCH_VALUES) {
+        values.clear();
+        for (bsl::size_t i = 0;
+             i < batchSize && sequenceNumber <= k_NUM_BATCH_VALUES;
+             ++i) {
+            OrderingValue value;
+            value.d_pushThreadId   = pushThreadId;
+            value.d_sequenceNumber = sequenceNumber++;
+            values.push_back(value);
+        }
+
+        // Append the values, retrying the suffix that did not fit.
+
+        bsl::vector<OrderingValue>::const_iterator begin = values.begin();
+        while (begin != values.end()) {
+            bsl::size_t numPushed = mX.tryPushBack(begin, values.cend());
+            if (0 == numPushed) {
+                bslmt::ThreadUtil::yield();
+            }
+            begin += numPushed;
+        }
+
+        batchSize = batchSize % 7 + 1;
+    }
+
+    return 0;
+}
+
+void batchOrderingTest(const int numPushThread, const int numPopThread)
+    // Exercise an 'OrderingObj' using only the batch "push" and "pop" methods
+    // from the specified 'numPushThread' and 'numPopThread' threads, and
+    // verify that every enqueued element is dequeued exactly once and that,
+    // for the set of elements enqueued by a particular thread and dequeued by
+    // a particular thread, the order in which the elements of this set are
+    // dequeued matches the order these elements were enqueued.
+{
+    bslmt::ThreadUtil::Handle              watchdogHandle;
+    bsl::vector<bslmt::ThreadUtil::Handle> pushHandle(numPushThread);
+    bsl::vector<bslmt::ThreadUtil::Handle> popHandle(numPopThread);
+    bsl::vector<BatchPopData>              batchPopData(numPopThread);
+
+    s_continue = 1;
+
+    OrderingObj mX(16);  const OrderingObj& X = mX;
+
+    setWatchdogText("batch ordering");
+    bslmt::ThreadUtil::create(&watchdogHandle, watchdog, 0);
+
+    for (int i = 0; i < numPopThread; ++i) {
+        batchPopData[i].d_obj_p        = &mX;
+        batchPopData[i].d_numPopped    = 0;
+        batchPopData[i].d_isStrongTest = (   1 == numPushThread
+                                          && 1 == numPopThread);
+        bslmt::ThreadUtil::create(&popHandle[i],
+                                  batchPop,
+                                  &batchPopData[i]);
+    }
+    for (int i = 0; i < numPushThread; ++i) {
+        bslmt::ThreadUtil::create(&pushHandle[i], batchPush, &mX);
+    }
+
+    setWatchdogText("batch ordering: join push");
+    for (int i = 0; i < numPushThread; ++i) {
+        bslmt::ThreadUtil::join(pushHandle[i]);
+    }
+
+    setWatchdogText("batch ordering: wait until empty");
+    int rv = X.waitUntilEmpty();
+    ASSERT(0 == rv);
+    ASSERT(0 == X.numElements());
+
+    mX.disablePopFront();
+
+    setWatchdogText("batch ordering: join pop");
+    bsl::size_t numPopped = 0;
+    for (int i = 0; i < numPopThread; ++i) {
+        bslmt::ThreadUtil::join(popHandle[i]);
+        numPopped += batchPopData[i].d_numPopped;
+    }
+
+    ASSERTV(numPopped, numPopped == numPushThread * k_NUM_BATCH_VALUES);
+
+    s_continue = 0;
+
+    setWatchdogText("batch ordering: join watchdog");
+    bslmt::ThreadUtil::join(watchdogHandle);
+}
+
 // ============================================================================
 //               GENERATOR FUNCTIONS 'gg' AND 'ggg' FOR TESTING
 // ----------------------------------------------------------------------------
@@ -955,7 +1135,7 @@ int main(int argc, char *argv[])
     ASSERT(0 == bslma::Default::setDefaultAllocator(&defaultAllocator));
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 12: {
+      case 14: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -993,6 +1173,517 @@ int main(int argc, char *argv[])
 
         bslmt::ThreadUtil::join(watchdogHandle);
       } break;
+      case 13: {
+        // --------------------------------------------------------------------
+        // WAIT STRATEGY
+        //   Ensure a blocking 'popFront' follows the wait strategy supplied at
+        //   construction and records the outcomes of its waits.
+        //
+        // Concerns:
+        //: 1 The queue reports the wait strategy supplied at construction, or
+        //:   a strategy that parks immediately if none was supplied.
+        //:
+        //: 2 A 'popFront' that finds an element available records nothing.
+        //:
+        //: 3 A 'popFront' that waits records exactly one outcome: a spin, a
+        //:   yield, or a park, according to the strategy.
+        //:
+        //: 4 A spinning 'popFront' returns 'e_DISABLED' if the queue is
+        //:   dequeue disabled while it spins.
+        //:
+        //: 5 The batch 'popFront' follows the strategy too.
+        //
+        // Plan:
+        //: 1 Create queues with and without a strategy and verify the
+        //:   accessors.  (C-1)
+        //:
+        //: 2 Pop from a non-empty queue and verify the counters.  (C-2)
+        //:
+        //: 3 For strategies that only park, only spin (with a spin count
+        //:   large enough to outlast the delay), and only yield, pop from an
+        //:   empty queue while another thread pushes an element after a delay,
+        //:   and verify the counters.  (C-3, 5)
+        //:
+        //: 4 Spin in 'popFront' while another thread disables the queue.
+        //:   (C-4)
+        //
+        // Testing:
+        //   BoundedQueue(size_t capacity, const WaitStrategy&, Allocator bA);
+        //   const WaitStrategy& waitStrategy() const;
+        //   const WaitStrategyCounters& waitStrategyCounters() const;
+        //   CONCERN: wait strategy
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "WAIT STRATEGY" << endl
+                          << "=============" << endl;
+
+        typedef bdlcc::WaitStrategy         Strategy;
+        typedef bdlcc::WaitStrategyCounters Counters;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        const int k_LARGE = 1 << 30;
+
+        {
+            Obj mX(4, &ta);  const Obj& X = mX;
+            ASSERT(Strategy() == X.waitStrategy());
+            ASSERT(&ta        == X.allocator());
+
+            Obj mY(4, Strategy(100, 2), &ta);  const Obj& Y = mY;
+            ASSERT(Strategy(100, 2) == Y.waitStrategy());
+            ASSERT(&ta              == Y.allocator());
+
+            const Counters& C = Y.waitStrategyCounters();
+            ASSERT(0 == C.numSpins());
+            ASSERT(0 == C.numYields());
+            ASSERT(0 == C.numParks());
+
+            int value = 0;
+            mY.pushBack(1);
+            ASSERT(e_SUCCESS == mY.popFront(&value));
+            ASSERT(1 == value);
+            ASSERT(0 == C.numSpins() + C.numYields() + C.numParks());
+        }
+
+        static const struct {
+            int                 d_line;
+            int                 d_spinCount;
+            int                 d_yieldCount;
+            bool                d_batch;
+            bsls::Types::Uint64 d_expSpins;
+            bsls::Types::Uint64 d_expYields;
+            bsls::Types::Uint64 d_expParks;
+        } DATA[] = {
+            { L_,       0,       0, false, 0, 0, 1 },
+            { L_, k_LARGE,       0, false, 1, 0, 0 },
+            { L_,       0, k_LARGE, false, 0, 1, 0 },
+            { L_,       0,       0,  true, 0, 0, 1 },
+            { L_, k_LARGE,       0,  true, 1, 0, 0 },
+            { L_,       0, k_LARGE,  true, 0, 1, 0 },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int  LINE  = DATA[ti].d_line;
+            const int  SPIN  = DATA[ti].d_spinCount;
+            const int  YIELD = DATA[ti].d_yieldCount;
+            const bool BATCH = DATA[ti].d_batch;
+
+            if (veryVerbose) { T_ P_(LINE) P_(SPIN) P_(YIELD) P(BATCH) }
+
+            Obj mX(4, Strategy(SPIN, YIELD), &ta);  const Obj& X = mX;
+
+            bslmt::ThreadUtil::Handle handle;
+            bslmt::ThreadUtil::create(&handle, deferredPushBack, &mX);
+
+            if (BATCH) {
+                bsl::vector<int> buffer;
+                ASSERTV(LINE, e_SUCCESS == mX.popFront(4, &buffer));
+                ASSERTV(LINE, 1 == buffer.size() && 7 == buffer[0]);
+            }
+            else {
+                int value = 0;
+                ASSERTV(LINE, e_SUCCESS == mX.popFront(&value));
+                ASSERTV(LINE, 7 == value);
+            }
+
+            bslmt::ThreadUtil::join(handle);
+
+            const bsls::Types::Uint64 EXP_SPINS  = DATA[ti].d_expSpins;
+            const bsls::Types::Uint64 EXP_YIELDS = DATA[ti].d_expYields;
+            const bsls::Types::Uint64 EXP_PARKS  = DATA[ti].d_expParks;
+
+            const Counters& C = X.waitStrategyCounters();
+            ASSERTV(LINE, C.numSpins(),  EXP_SPINS  == C.numSpins());
+            ASSERTV(LINE, C.numYields(), EXP_YIELDS == C.numYields());
+            ASSERTV(LINE, C.numParks(),  EXP_PARKS  == C.numParks());
+        }
+
+        if (verbose) cout << "\tDisabling a spinning 'popFront'" << endl;
+        {
+            Obj mX(4, Strategy(k_LARGE, 0), &ta);
+
+            bslmt::ThreadUtil::Handle handle;
+            bslmt::ThreadUtil::create(&handle, deferredDisablePopFront, &mX);
+
+            int value = 0;
+            ASSERT(e_DISABLED == mX.popFront(&value));
+
+            bslmt::ThreadUtil::join(handle);
+
+            ASSERT(0 == mX.waitStrategyCounters().numParks());
+        }
+      } break;
+      case 12: {
+        // --------------------------------------------------------------------
+        // BATCH OPERATIONS
+        //   Ensure the batch "push" and "pop" methods transfer ranges of
+        //   elements correctly.
+        //
+        // Concerns:
+        //: 1 'tryPushBack' of a range appends the longest prefix of the range
+        //:   for which there is capacity, in order, and returns its length.
+        //:
+        //: 2 'popFront' and 'tryPopFront' append, in order, at most the
+        //:   requested number of elements, and at least one element, to the
+        //:   supplied buffer.
+        //:
+        //: 3 The batch methods honor the enqueue and dequeue disabled states,
+        //:   and, on failure, do not modify the supplied buffer.
+        //:
+        //: 4 Batches correctly wrap around the end of the underlying array.
+        //:
+        //: 5 An exception thrown while constructing an element of a batch
+        //:   leaves the queue in a usable state with no loss of capacity, and
+        //:   the elements constructed before the exception are available.
+        //:
+        //: 6 Every element enqueued by concurrent batch producers is dequeued
+        //:   exactly once by concurrent batch consumers, and the ordering
+        //:   guarantee is provided.
+        //:
+        //: 7 Supplying a 'maxNumItems' of 0 is detected in appropriate build
+        //:   modes.
+        //:
+        //: 8 An exception thrown while appending an element of a batch to the
+        //:   buffer leaves the elements already appended in the buffer, and
+        //:   removes all the acquired elements from the queue.
+        //:
+        //: 9 An exception thrown while reserving capacity in the buffer
+        //:   leaves the queue unchanged.
+        //
+        // Plan:
+        //: 1 Directly exercise the batch methods on a small queue, verifying
+        //:   return values, the contents of the buffer, and the number of
+        //:   elements in the queue.  (C-1..4)
+        //:
+        //: 2 Using a type whose copy allocates, cause an exception part way
+        //:   through a batch 'tryPushBack' and verify the subsequent behavior
+        //:   of the queue.  (C-5)
+        //:
+        //: 3 Using multiple threads performing only batch operations on
+        //:   elements that store a sequence number, verify the number of
+        //:   dequeued elements and the per-thread sequence numbers.  (C-6)
+        //:
+        //: 4 Verify defensive checks are triggered for invalid values.  (C-7)
+        //:
+        //: 5 Using a type whose copy allocates, cause an exception part way
+        //:   through a batch 'popFront' and verify the contents of the buffer
+        //:   and the subsequent behavior of the queue.  (C-8)
+        //:
+        //: 6 Cause the allocation of the buffer to fail in the batch methods,
+        //:   and verify the buffer and the queue are unchanged.  (C-9)
+        //
+        // Testing:
+        //   int popFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *buffer);
+        //   int tryPopFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *buf);
+        //   bsl::size_t tryPushBack(FORWARD_ITER begin, FORWARD_ITER end);
+        //   CONCERN: batch operations
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BATCH OPERATIONS" << endl
+                          << "================" << endl;
+
+        if (verbose) cout << "\nTesting basic functionality." << endl;
+        {
+            Obj mX(4);  const Obj& X = mX;
+
+            const int VALUES[]   = { 1, 2, 3, 4, 5, 6 };
+            const int NUM_VALUES = static_cast<int>(sizeof VALUES
+                                                    / sizeof *VALUES);
+
+            bsl::vector<int> buffer;
+
+            ASSERT(0 == mX.tryPushBack(VALUES, VALUES));
+            ASSERT(0 == X.numElements());
+
+            ASSERT(e_EMPTY == mX.tryPopFront(3, &buffer));
+            ASSERT(buffer.empty());
+
+            ASSERT(4 == mX.tryPushBack(VALUES, VALUES + NUM_VALUES));
+            ASSERT(4 == X.numElements());
+            ASSERT(X.isFull());
+
+            ASSERT(0 == mX.tryPushBack(VALUES + 4, VALUES + NUM_VALUES));
+            ASSERT(4 == X.numElements());
+
+            ASSERT(e_SUCCESS == mX.tryPopFront(3, &buffer));
+            ASSERT(3 == buffer.size());
+            ASSERT(1 == X.numElements());
+
+            ASSERT(e_SUCCESS == mX.popFront(10, &buffer));
+            ASSERT(4 == buffer.size());
+            ASSERT(0 == X.numElements());
+
+            for (bsl::size_t i = 0; i < buffer.size(); ++i) {
+                ASSERTV(i, buffer[i], VALUES[i] == buffer[i]);
+            }
+
+            // Exercise wrapping around the end of the array with every
+            // combination of batch sizes.
+
+            int next     = 0;
+            int expected = 0;
+            for (int numPush = 1; numPush <= 4; ++numPush) {
+                for (int numPop = 1; numPop <= 4; ++numPop) {
+                    bsl::vector<int> values;
+                    for (int i = 0; i < numPush; ++i) {
+                        values.push_back(next++);
+                    }
+
+                    ASSERTV(numPush,
+                            numPop,
+                            static_cast<bsl::size_t>(numPush) ==
+                                 mX.tryPushBack(values.begin(), values.end()));
+
+                    while (!X.isEmpty()) {
+                        buffer.clear();
+
+                        int rv = mX.tryPopFront(numPop, &buffer);
+                        ASSERTV(numPush, numPop, e_SUCCESS == rv);
+                        ASSERTV(numPush,
+                                numPop,
+                                buffer.size(),
+                                0 < buffer.size()
+                                 && static_cast<bsl::size_t>(numPop) >=
+                                                                buffer.size());
+
+                        for (bsl::size_t i = 0; i < buffer.size(); ++i) {
+                            ASSERTV(numPush,
+                                    numPop,
+                                    expected,
+                                    buffer[i],
+                                    expected == buffer[i]);
+                            ++expected;
+                        }
+                    }
+                }
+            }
+            ASSERT(next == expected);
+
+            // The single-element and batch methods interoperate.
+
+            ASSERT(e_SUCCESS == mX.pushBack(7));
+            ASSERT(3 == mX.tryPushBack(VALUES, VALUES + 3));
+
+            int value = 0;
+            ASSERT(e_SUCCESS == mX.popFront(&value));
+            ASSERT(7 == value);
+
+            buffer.clear();
+            ASSERT(e_SUCCESS == mX.popFront(4, &buffer));
+            ASSERT(3 == buffer.size());
+            ASSERT(0 == X.numElements());
+        }
+
+        if (verbose) cout << "\nTesting disabled states." << endl;
+        {
+            Obj mX(8);  const Obj& X = mX;
+
+            const int VALUES[] = { 1, 2, 3 };
+
+            bsl::vector<int> buffer(1, 9);
+
+            ASSERT(3 == mX.tryPushBack(VALUES, VALUES + 3));
+
+            mX.disablePushBack();
+            ASSERT(0 == mX.tryPushBack(VALUES, VALUES + 3));
+            ASSERT(3 == X.numElements());
+
+            mX.disablePopFront();
+            ASSERT(e_DISABLED == mX.popFront(2, &buffer));
+            ASSERT(e_DISABLED == mX.tryPopFront(2, &buffer));
+            ASSERT(1 == buffer.size());
+            ASSERT(9 == buffer[0]);
+            ASSERT(3 == X.numElements());
+
+            mX.enablePopFront();
+            mX.enablePushBack();
+
+            ASSERT(e_SUCCESS == mX.popFront(8, &buffer));
+            ASSERT(4 == buffer.size());
+            ASSERT(0 == X.numElements());
+        }
+
+        if (verbose) cout << "\nTesting 'popFront' blocks." << endl;
+        {
+            Obj mX(8);
+
+            bsl::vector<int> buffer;
+
+            bslmt::ThreadUtil::Handle handle;
+            bslmt::ThreadUtil::create(&handle, deferredDisablePopFront, &mX);
+
+            ASSERT(e_DISABLED == mX.popFront(4, &buffer));
+            ASSERT(buffer.empty());
+
+            bslmt::ThreadUtil::join(handle);
+        }
+
+#ifdef BDE_BUILD_TARGET_EXC
+        if (verbose) cout << "\nTesting exception safety." << endl;
+        {
+            // white-box test for when the element copy throws part way through
+            // a batch
+
+            bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+
+            typedef bdlcc::BoundedQueue<AllocExceptionHelper> HelperObj;
+
+            HelperObj mX(8, &sa);  const HelperObj& X = mX;
+
+            bsl::vector<AllocExceptionHelper> values(3,
+                                                     AllocExceptionHelper(&sa),
+                                                     &sa);
+            bsl::vector<AllocExceptionHelper> buffer(&sa);
+
+            int numException = 0;
+
+            sa.setAllocationLimit(1);
+            try {
+                mX.tryPushBack(values.begin(), values.end());
+            } catch (BloombergLP::bslma::TestAllocatorException& e) {
+                ++numException;
+            }
+            sa.setAllocationLimit(-1);
+
+            ASSERT(1 == numException);
+            ASSERT(1 == X.numElements());
+
+            ASSERT(e_SUCCESS == mX.tryPopFront(8, &buffer));
+            ASSERT(1 == buffer.size());
+            ASSERT(0 == X.numElements());
+
+            // Every node is usable once the skipped nodes have been passed.
+
+            for (int i = 0; i < 4; ++i) {
+                bsl::size_t numPushed = mX.tryPushBack(values.begin(),
+                                                       values.end());
+                buffer.clear();
+                ASSERT(e_SUCCESS == mX.popFront(8, &buffer));
+                ASSERTV(i, numPushed, buffer.size(),
+                        numPushed == buffer.size());
+            }
+
+            ASSERT(3 == mX.tryPushBack(values.begin(), values.end()));
+            ASSERT(3 == mX.tryPushBack(values.begin(), values.end()));
+            ASSERT(2 == mX.tryPushBack(values.begin(), values.end()));
+            ASSERT(8 == X.numElements());
+            ASSERT(X.isFull());
+
+            buffer.clear();
+            ASSERT(e_SUCCESS == mX.popFront(8, &buffer));
+            ASSERT(8 == buffer.size());
+            ASSERT(X.isEmpty());
+        }
+        {
+            // white-box test for when appending an element to the buffer
+            // throws part way through a batch
+
+            bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+            bslma::TestAllocator ba("buffer",   veryVeryVeryVerbose);
+
+            typedef bdlcc::BoundedQueue<AllocExceptionHelper> HelperObj;
+
+            HelperObj mX(8, &sa);  const HelperObj& X = mX;
+
+            bsl::vector<AllocExceptionHelper> values(3,
+                                                     AllocExceptionHelper(&sa),
+                                                     &sa);
+            bsl::vector<AllocExceptionHelper> buffer(&ba);
+            buffer.reserve(8);
+
+            ASSERT(3 == mX.tryPushBack(values.begin(), values.end()));
+
+            int numException = 0;
+
+            ba.setAllocationLimit(1);
+            try {
+                mX.popFront(8, &buffer);
+            } catch (BloombergLP::bslma::TestAllocatorException& e) {
+                ++numException;
+            }
+            ba.setAllocationLimit(-1);
+
+            ASSERT(1 == numException);
+            ASSERTV(buffer.size(), 1 == buffer.size());
+            ASSERTV(X.numElements(), 0 == X.numElements());
+
+            // The queue is usable, with no loss of capacity.
+
+            for (int i = 0; i < 3; ++i) {
+                ASSERT(3 == mX.tryPushBack(values.begin(), values.end()));
+                buffer.clear();
+                ASSERT(e_SUCCESS == mX.tryPopFront(8, &buffer));
+                ASSERTV(i, buffer.size(), 3 == buffer.size());
+            }
+        }
+        {
+            // white-box test for when reserving capacity in the buffer throws
+
+            bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+            bslma::TestAllocator ba("buffer",   veryVeryVeryVerbose);
+
+            Obj mX(8, &sa);  const Obj& X = mX;
+
+            bsl::vector<int> buffer(&ba);
+
+            ASSERT(e_SUCCESS == mX.pushBack(1));
+            ASSERT(e_SUCCESS == mX.pushBack(2));
+
+            for (int i = 0; i < 2; ++i) {
+                int numException = 0;
+
+                ba.setAllocationLimit(0);
+                try {
+                    if (0 == i) {
+                        mX.popFront(8, &buffer);
+                    }
+                    else {
+                        mX.tryPopFront(8, &buffer);
+                    }
+                } catch (BloombergLP::bslma::TestAllocatorException& e) {
+                    ++numException;
+                }
+                ba.setAllocationLimit(-1);
+
+                ASSERTV(i, numException, 1 == numException);
+                ASSERTV(i, buffer.size(), buffer.empty());
+                ASSERTV(i, X.numElements(), 2 == X.numElements());
+            }
+
+            ASSERT(e_SUCCESS == mX.tryPopFront(8, &buffer));
+            ASSERTV(buffer.size(), 2 == buffer.size());
+            ASSERT(1 == buffer[0]);
+            ASSERT(2 == buffer[1]);
+            ASSERT(X.isEmpty());
+        }
+#endif
+
+        if (verbose) cout << "\nTesting concurrent batches." << endl;
+        {
+            batchOrderingTest(1, 1);  // single producer, single consumer
+            batchOrderingTest(4, 4);  // multiple producers, multiple consumers
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            Obj mX(8);
+
+            const int VALUE = 1;
+
+            bsl::vector<int> buffer;
+
+            mX.tryPushBack(&VALUE, &VALUE + 1);
+            ASSERT_FAIL(mX.popFront(0, &buffer));
+            ASSERT_PASS(mX.popFront(1, &buffer));
+            ASSERT_FAIL(mX.tryPopFront(0, &buffer));
+            ASSERT_PASS(mX.tryPopFront(1, &buffer));
+        }
+      } break;
       case 11: {
         // ---------------------------------------------------------
         // ORDERING GUARANTEE TEST
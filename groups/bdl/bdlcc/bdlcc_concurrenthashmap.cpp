@@ -0,0 +1,33 @@
+// bdlcc_concurrenthashmap.cpp                                        -*-C++-*-
+#include <bdlcc_concurrenthashmap.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlcc_concurrenthashmap,"$Id$ $CSID$")
+
+///IMPLEMENTATION NOTES
+///--------------------
+// Memory reclamation is delegated to 'bdlcc::EpochManager'.  A writer reserves
+// the retirement of the nodes it is about to unlink (see
+// 'EpochManager::reserve') before modifying a bucket, so that once a bucket
+// has been modified nothing can throw, and each modification either completes
+// or leaves the map unchanged.
+//
+// All stores to the links that readers traverse from a bucket head use
+// sequentially consistent ordering, as required by 'bdlcc::EpochManager' (the
+// unlinking store must not be reordered with the subsequent retirement).
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License.  You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1910 @@
+// bdlcc_concurrenthashmap.h                                          -*-C++-*-
+#ifndef INCLUDED_BDLCC_CONCURRENTHASHMAP
+#define INCLUDED_BDLCC_CONCURRENTHASHMAP
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a concurrent unordered map having wait-free readers.
+//
+//@CLASSES:
+//  bdlcc::ConcurrentHashMap: hash map with lock-free lookup and online rehash
+//
+//@SEE_ALSO: bdlcc_stripedunorderedmap, bdlcc_epochmanager
+//
+//@DESCRIPTION: This component provides a single concurrent (fully thread-safe)
+// associative container, 'bdlcc::ConcurrentHashMap', whose lookup operations
+// ('getValue' and 'visitReadOnly') neither acquire a lock nor wait for any
+// other thread.  Modifying operations are serialized by a (user defined)
+// number of mutexes, each guarding a group of buckets (a *stripe*), as in
+// 'bdlcc::StripedUnorderedMap', but readers never touch those mutexes.  For
+// read-mostly workloads this avoids the cache-line transfers that a
+// reader-writer lock incurs on every lookup, even when no writer is present.
+//
+// The interface mirrors that of 'bdlcc::StripedUnorderedMap' (see
+// {'bdlcc_stripedunorderedmap'}), including the visitor-style 'update',
+// 'visit', and 'setComputedValue' methods, with two additions providing
+// read-only access to elements without copying them.  As with that class,
+// iterators are not provided, and 'bdlcc::ConcurrentHashMap' is an
+// *irregular* value-semantic type.
+//
+///Thread Safety
+///-------------
+// The 'bdlcc::ConcurrentHashMap' class template is fully thread-safe (see
+// {'bsldoc_glossary'|Fully Thread-Safe}), assuming that the allocator is fully
+// thread-safe.  Each method is executed by the calling thread.  'getValue' and
+// both 'visitReadOnly' methods are wait-free (excluding the time spent in
+// user-supplied functors and in copying values) once the calling thread has
+// been registered by its first access to the map (see {Memory Reclamation}).
+//
+///Readers and Writers
+///-------------------
+// Elements are never modified once they are reachable by readers.  A writer
+// that changes the value associated with a key builds a new element holding
+// the new value and then links it into the bucket in place of the old
+// element, which is *retired*.  Consequently, a reader always observes either
+// the complete old value or the complete new value, and the visitor supplied
+// to 'update', 'visit', and 'setComputedValue' operates on a private copy of
+// the value that is published when the visitor returns.  The cost of this
+// design is that every modification of an existing element allocates a new
+// element and copies its key and value; the container is therefore best
+// suited to workloads where lookups greatly outnumber modifications.
+//
+///Memory Reclamation
+///------------------
+// A retired element cannot be destroyed while a reader may still be examining
+// it.  Each map owns a 'bdlcc::EpochManager' (see {'bdlcc_epochmanager'}):
+// every operation accesses the buckets within a critical section of that epoch
+// manager, and the elements and bucket arrays that are replaced, removed, or
+// superseded by a rehash are retired to it.  An element is destroyed only once
+// every thread that could have observed it has left its critical section.
+// Readers therefore never wait, and a reader that is slow (or that runs a slow
+// visitor) merely delays the release of memory.
+//
+// A thread is registered with the epoch manager of a map on its first access
+// to the map, which allocates a small record from the allocator of the map.
+// The record is retained (and reused by threads registering later) until the
+// map is destroyed.
+//
+///Concurrent Rehash
+///-----------------
+// When an insertion causes the load factor to exceed 'maxLoadFactor()' (and
+// rehash is enabled), the inserting thread allocates a larger bucket array and
+// migrates the buckets of the current array one at a time, holding only the
+// mutex of the stripe owning the bucket being migrated.  A migrated bucket is
+// marked as such, and readers and writers that reach it proceed to the new
+// array.  Other operations, including operations on the stripe being
+// migrated, are delayed at most for the migration of a single bucket; the
+// container is never locked as a whole.  Migration copies the elements of
+// each bucket except for the longest suffix of its chain that moves to a
+// single bucket of the new array, which is reused in place.
+//
+// If an exception interrupts a rehash, the elements are left reachable and the
+// operation that initiated the rehash propagates the exception after having
+// completed its own update; the rehash is resumed by a subsequent write.
+//
+// 'enableRehash' and 'disableRehash' methods are provided to control the
+// rehash enable flag.  Note that disabling rehash does not impact a rehash in
+// progress.
+//
+///Runtime Complexity
+///------------------
+//..
+//  +----------------------------------------------------+--------------------+
+//  | Operation                                          | Complexity         |
+//  +====================================================+====================+
+//  | insert, setValue, setComputedValue, update         | Average: O[1]      |
+//  |                                                    | Worst:   O[n]      |
+//  +----------------------------------------------------+--------------------+
+//  | erase, getValue, visitReadOnly(key, visitor)       | Average: O[1]      |
+//  |                                                    | Worst:   O[n]      |
+//  +----------------------------------------------------+--------------------+
+//  | insertBulk, k elements                             | Average: O[k]      |
+//  |                                                    | Worst:   O[n*k]    |
+//  +----------------------------------------------------+--------------------+
+//  | eraseBulk, k elements                              | Average: O[k]      |
+//  |                                                    | Worst:   O[n*k]    |
+//  +----------------------------------------------------+--------------------+
+//  | rehash, clear, visit, visitReadOnly(visitor)       | O[n]               |
+//  +----------------------------------------------------+--------------------+
+//..
+//
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: A Read-Mostly Reference Data Cache
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that many threads of a service look up static reference data (here,
+// the display name of a security identified by an integer) for every request
+// they process, while a single thread occasionally applies updates published
+// by an upstream system.  A 'bdlcc::ConcurrentHashMap' lets the lookups
+// proceed without contending with each other or with the updater.
+//
+// First, we define the cache type and create an object, 'names', of that type:
+//..
+//  typedef bdlcc::ConcurrentHashMap<int, bsl::string> NameCache;
+//
+//  NameCache names;
+//..
+// Then, the updater thread loads the initial reference data:
+//..
+//  names.insert(1001, "IBM US Equity");
+//  names.insert(1002, "VOD LN Equity");
+//  names.insert(1003, "BMW GR Equity");
+//  assert(3 == names.size());
+//..
+// Next, a request-processing thread looks up a name by copying it out of the
+// cache:
+//..
+//  bsl::string name;
+//  bsl::size_t rc = names.getValue(&name, 1002);
+//  assert(1               == rc);
+//  assert("VOD LN Equity" == name);
+//..
+// Then, a thread that needs only to inspect the cached value (and not to keep
+// a copy) uses 'visitReadOnly', which gives access to the element in place:
+//..
+//  struct LengthReader {
+//      bsl::size_t *d_length_p;
+//
+//      bool operator()(const bsl::string& value, const int&) const
+//      {
+//          *d_length_p = value.length();
+//          return true;
+//      }
+//  };
+//
+//  bsl::size_t  length = 0;
+//  LengthReader reader = { &length };
+//  int          found  = names.visitReadOnly(1003, reader);
+//  assert( 1 == found);
+//  assert(13 == length);
+//..
+// Now, the updater replaces a name and removes a delisted security.  Readers
+// running concurrently observe either the old or the new name, but never a
+// partially assigned string:
+//..
+//  rc = names.setValue(1001, "IBM UN Equity");
+//  assert(1 == rc);
+//
+//  rc = names.erase(1003);
+//  assert(1 == rc);
+//  assert(2 == names.size());
+//..
+// Finally, we confirm the new contents of the cache:
+//..
+//  rc = names.getValue(&name, 1001);
+//  assert(1               == rc);
+//  assert("IBM UN Equity" == name);
+//
+//  rc = names.getValue(&name, 1003);
+//  assert(0 == rc);
+//..
+
+#include <bdlscm_version.h>
+
+#include <bdlcc_epochmanager.h>
+
+#include <bdlb_bitutil.h>
+
+#include <bslma_allocator.h>
+#include <bslma_constructionutil.h>
+#include <bslma_default.h>
+#include <bslma_destructionutil.h>
+#include <bslma_destructorproctor.h>
+#include <bslma_rawdeleterproctor.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_assert.h>
+#include <bslmf_movableref.h>
+
+#include <bslmt_lockguard.h>
+#include <bslmt_mutex.h>
+#include <bslmt_platform.h>
+
+#include <bsls_assert.h>
+#include <bsls_atomic.h>
+#include <bsls_objectbuffer.h>
+#include <bsls_types.h>
+
+#include <bslstl_hash.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_cstring.h>
+#include <bsl_functional.h>
+#include <bsl_utility.h>
+
+namespace BloombergLP {
+namespace bdlcc {
+
+                      // ==============================
+                      // struct ConcurrentHashMap_Stripe
+                      // ==============================
+
+struct ConcurrentHashMap_Stripe {
+    // This 'struct' holds the mutex serializing the writers of a group of
+    // buckets.  Trailing padding keeps the mutexes of adjacent stripes on
+    // different cache lines.
+
+    // PUBLIC DATA
+    bslmt::Mutex d_mutex;
+    char         d_pad[bslmt::Platform::e_CACHE_LINE_SIZE];
+};
+
+                        // ============================
+                        // class ConcurrentHashMap_Node
+                        // ============================
+
+template <class KEY, class VALUE>
+class ConcurrentHashMap_Node {
+    // This class template represents an element of the singly-linked list
+    // forming a bucket of a 'ConcurrentHashMap'.  The key and value of a node
+    // are not modified once the node is reachable by readers.
+
+    // DATA
+    bsls::AtomicPointer<ConcurrentHashMap_Node>  d_next;   // next in bucket
+
+    bsl::size_t                                  d_hash;   // hash of 'd_key'
+
+    bsls::ObjectBuffer<KEY>                      d_key;    // footprint of key
+
+    bsls::ObjectBuffer<VALUE>                    d_value;  // footprint of
+                                                           // value
+
+    // NOT IMPLEMENTED
+    ConcurrentHashMap_Node(const ConcurrentHashMap_Node&);
+    ConcurrentHashMap_Node& operator=(const ConcurrentHashMap_Node&);
+
+  public:
+    // CREATORS
+    ConcurrentHashMap_Node(bsl::size_t       hash,
+                           const KEY&        key,
+                           bslma::Allocator *basicAllocator);
+        // Create a node having the specified 'hash' of the specified 'key',
+        // and a default-constructed value, using the specified
+        // 'basicAllocator' to supply memory.
+
+    ConcurrentHashMap_Node(bsl::size_t       hash,
+                           const KEY&        key,
+                           const VALUE&      value,
+                           bslma::Allocator *basicAllocator);
+    ConcurrentHashMap_Node(bsl::size_t               hash,
+                           const KEY&                key,
+                           bslmf::MovableRef<VALUE>  value,
+                           bslma::Allocator         *basicAllocator);
+        // Create a node having the specified 'hash' of the specified 'key',
+        // and the specified 'value', using the specified 'basicAllocator' to
+        // supply memory.
+
+    ~ConcurrentHashMap_Node();
+        // Destroy this object.
+
+    // MANIPULATORS
+    bsls::AtomicPointer<ConcurrentHashMap_Node>& next();
+        // Return a reference providing modifiable access to the link to the
+        // next node of the bucket.
+
+    VALUE& value();
+        // Return a reference providing modifiable access to the value of this
+        // node.  The behavior is undefined if this node is reachable by
+        // readers.
+
+    // ACCESSORS
+    bsl::size_t hash() const;
+        // Return the hash of the key of this node.
+
+    const KEY& key() const;
+        // Return a reference providing non-modifiable access to the key of
+        // this node.
+
+    const VALUE& value() const;
+        // Return a reference providing non-modifiable access to the value of
+        // this node.
+};
+
+                       // =============================
+                       // class ConcurrentHashMap_Table
+                       // =============================
+
+template <class KEY, class VALUE>
+class ConcurrentHashMap_Table {
+    // This class template represents an array of buckets of a
+    // 'ConcurrentHashMap'.  While the map is being rehashed, the table being
+    // replaced refers to its replacement, and each of its buckets that has
+    // been migrated holds the value returned by 'movedMarker'.
+
+  public:
+    // PUBLIC TYPES
+    typedef ConcurrentHashMap_Node<KEY, VALUE> Node;
+    typedef bsls::AtomicPointer<Node>          Link;
+
+  private:
+    // DATA
+    Link                                         *d_buckets_p;   // buckets
+
+    bsl::size_t                                   d_numBuckets;  // power of
+                                                                 // 2
+
+    bsls::AtomicPointer<ConcurrentHashMap_Table>  d_next;        // table
+                                                                 // replacing
+                                                                 // this one
+
+    bslma::Allocator                             *d_allocator_p; // memory
+                                                                 // allocator
+
+    // NOT IMPLEMENTED
+    ConcurrentHashMap_Table(const ConcurrentHashMap_Table&);
+    ConcurrentHashMap_Table& operator=(const ConcurrentHashMap_Table&);
+
+  public:
+    // CLASS METHODS
+    static Node *movedMarker();
+        // Return the value held by a bucket whose elements have been migrated
+        // to the table replacing the table of the bucket.
+
+    // CREATORS
+    ConcurrentHashMap_Table(bsl::size_t       numBuckets,
+                            bslma::Allocator *basicAllocator);
+        // Create a table having the specified 'numBuckets' empty buckets,
+        // using the specified 'basicAllocator' to supply memory.  The behavior
+        // is undefined unless 'numBuckets' is a power of 2.
+
+    ~ConcurrentHashMap_Table();
+        // Destroy this object.  Note that the nodes of the buckets are not
+        // destroyed.
+
+    // MANIPULATORS
+    Link& bucket(bsl::size_t hash);
+        // Return a reference providing modifiable access to the bucket for the
+        // specified 'hash'.
+
+    Link& bucketAt(bsl::size_t index);
+        // Return a reference providing modifiable access to the bucket at the
+        // specified 'index'.  The behavior is undefined unless
+        // 'index < numBuckets()'.
+
+    bsls::AtomicPointer<ConcurrentHashMap_Table>& next();
+        // Return a reference providing modifiable access to the link to the
+        // table replacing this table.
+
+    // ACCESSORS
+    bsl::size_t numBuckets() const;
+        // Return the number of buckets of this table.
+};
+
+                   // ========================================
+                   // class ConcurrentHashMap_NodeChainProctor
+                   // ========================================
+
+template <class KEY, class VALUE>
+class ConcurrentHashMap_NodeChainProctor {
+    // This class template implements a proctor that, unless its 'release'
+    // method is invoked, destroys, on its own destruction, every node of the
+    // chain whose head is held in a variable supplied at construction.
+
+    // PRIVATE TYPES
+    typedef ConcurrentHashMap_Node<KEY, VALUE> Node;
+
+    // DATA
+    Node             **d_head_p;       // address of the head of the chain, or
+                                       // 0 if released
+
+    bslma::Allocator  *d_allocator_p;  // allocator of the nodes
+
+    // NOT IMPLEMENTED
+    ConcurrentHashMap_NodeChainProctor(
+                                    const ConcurrentHashMap_NodeChainProctor&);
+    ConcurrentHashMap_NodeChainProctor& operator=(
+                                    const ConcurrentHashMap_NodeChainProctor&);
+
+  public:
+    // CREATORS
+    ConcurrentHashMap_NodeChainProctor(Node             **head,
+                                       bslma::Allocator  *basicAllocator);
+        // Create a proctor for the chain of nodes whose head is held by the
+        // specified 'head' variable, allocated by the specified
+        // 'basicAllocator'.
+
+    ~ConcurrentHashMap_NodeChainProctor();
+        // Destroy this proctor, and destroy every node of the managed chain
+        // unless 'release' has been called.
+
+    // MANIPULATORS
+    void release();
+        // Release from management the chain of nodes managed by this proctor.
+};
+
+                          // =======================
+                          // class ConcurrentHashMap
+                          // =======================
+
+template <class KEY,
+          class VALUE,
+          class HASH  = bsl::hash<KEY>,
+          class EQUAL = bsl::equal_to<KEY> >
+class ConcurrentHashMap {
+    // This class template defines a fully thread-safe container that provides
+    // a mapping from keys (of template parameter type 'KEY') to their
+    // associated mapped values (of template parameter type 'VALUE').  Lookups
+    // do not acquire locks and do not wait for other threads; modifications
+    // are serialized by 'numStripes' mutexes, a value specified on
+    // construction.  'KEY' and 'VALUE' must be copy-constructible.
+    //
+    // The interface is inspired by, but not identical to that of
+    // 'bdlcc::StripedUnorderedMap'.
+
+    // PRIVATE TYPES
+    typedef ConcurrentHashMap_Node<KEY, VALUE>  Node;
+    typedef ConcurrentHashMap_Table<KEY, VALUE> Table;
+    typedef typename Table::Link                Link;
+    typedef ConcurrentHashMap_Stripe            Stripe;
+    typedef ConcurrentHashMap_NodeChainProctor<KEY, VALUE>
+                                                NodeChainProctor;
+
+    // DATA
+    bsls::AtomicPointer<Table>             d_table;          // current table
+
+    bsls::AtomicInt64                      d_numElements;    // current size
+
+    bsls::AtomicUint64                     d_maxNumElements; // size above
+                                                             // which to
+                                                             // rehash
+
+    bsls::AtomicBool                       d_rehashEnabled;  // rehash flag
+
+    bsls::AtomicUint                       d_maxLoadFactor;  // bit pattern
+                                                             // of the 'float'
+                                                             // maximum load
+                                                             // factor
+
+    bsl::size_t                            d_numStripes;     // power of 2
+
+    Stripe                                *d_stripes_p;      // writer mutexes
+
+    HASH                                   d_hasher;         // hash functor
+
+    EQUAL                                  d_comparator;     // equality
+                                                             // functor
+
+    mutable EpochManager                   d_epochManager;   // reclamation
+                                                             // of retired
+                                                             // elements
+
+    bslmt::Mutex                           d_rehashMutex;    // serializes
+                                                             // rehash
+
+    bslma::Allocator                      *d_allocator_p;    // memory
+                                                             // allocator
+
+    // NOT IMPLEMENTED
+    ConcurrentHashMap(const ConcurrentHashMap&);
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&);
+
+    // PRIVATE CLASS METHODS
+    static void deleteNode(void *node, void *allocator);
+        // Destroy the specified 'node', an object of type 'Node', and return
+        // its memory to the specified 'allocator', an object of type
+        // 'bslma::Allocator'.
+
+    static float fromBits(unsigned int bits);
+        // Return the 'float' value having the specified 'bits' as its object
+        // representation.
+
+    static unsigned int toBits(float value);
+        // Return the object representation of the specified 'value'.
+
+    // PRIVATE MANIPULATORS
+    void checkLoadFactor();
+        // Rehash this map if rehash is enabled, the maximum load factor is
+        // exceeded, and no other thread is rehashing this map.
+
+    Link *findLink(Link *head, const KEY& key, bsl::size_t hash);
+        // Return the address of the link, in the chain starting at the
+        // specified 'head', to the node having the specified 'key' of the
+        // specified 'hash', or 0 if there is no such node.  The behavior is
+        // undefined unless the mutex of the stripe of 'hash' is locked.
+
+    void migrateBucket(Table *oldTable, Table *newTable, bsl::size_t index);
+        // Migrate the elements of the bucket at the specified 'index' of the
+        // specified 'oldTable' to the specified 'newTable', and mark the
+        // bucket as moved.  The behavior is undefined unless 'd_rehashMutex'
+        // is locked and 'newTable' replaces 'oldTable'.
+
+    void rehashImp(bsl::size_t numBuckets);
+        // Complete a rehash in progress, if any, and otherwise rehash this map
+        // to have the specified 'numBuckets' if 'numBuckets' exceeds the
+        // current number of buckets.  The behavior is undefined unless
+        // 'd_rehashMutex' is locked and 'numBuckets' is 0 or a power of 2.
+
+    void replace(Link *link, Node *node);
+        // Replace the node referred to by the specified 'link' with the
+        // specified 'node', and retire the replaced node.  The behavior is
+        // undefined unless the mutex of the stripe of the nodes is locked, the
+        // nodes have equal keys, and the calling thread has reserved (see
+        // 'EpochManager::reserve') the retirement of a node.
+
+    void retire(Node *node);
+        // Retire the specified 'node', which is no longer reachable from any
+        // bucket, to 'd_epochManager'.  The behavior is undefined unless the
+        // calling thread has reserved (see 'EpochManager::reserve') the
+        // retirement of a node.
+
+    bsl::size_t setNode(Node *node);
+        // Insert the specified 'node' into this map, replacing the element (if
+        // any) having the same key.  Return 1 if an element was replaced and 0
+        // otherwise.  The behavior is undefined unless 'node' was allocated
+        // by 'd_allocator_p'.  Note that this map takes ownership of 'node',
+        // even if an exception is thrown.
+
+    Stripe& stripe(bsl::size_t hash);
+        // Return a reference providing modifiable access to the stripe of the
+        // specified 'hash'.
+
+    void updateMaxNumElements(bsl::size_t numBuckets);
+        // Set the number of elements above which this map is rehashed from
+        // the specified 'numBuckets' and the maximum load factor.
+
+    Link& writerBucket(bsl::size_t hash);
+        // Return a reference providing modifiable access to the bucket in the
+        // current table for the specified 'hash', following the replacement
+        // of migrated buckets.  The behavior is undefined unless the mutex of
+        // the stripe of 'hash' is locked and the calling thread is within a
+        // critical section of 'd_epochManager'.
+
+    // PRIVATE ACCESSORS
+    const Node *find(const KEY& key, bsl::size_t hash) const;
+        // Return the address of the node having the specified 'key' of the
+        // specified 'hash', or 0 if there is no such node.  The behavior is
+        // undefined unless the calling thread is within a critical section of
+        // 'd_epochManager'.
+
+    template <class VISITOR>
+    bool visitBucket(Table       *table,
+                     bsl::size_t  index,
+                     VISITOR&     visitor,
+                     int         *count) const;
+        // Invoke the specified 'visitor' on each element of the bucket at the
+        // specified 'index' of the specified 'table', following the
+        // replacement of migrated buckets, and increment the specified 'count'
+        // for each invocation.  Return 'false' if 'visitor' returned 'false',
+        // and 'true' otherwise.  The behavior is undefined unless the calling
+        // thread is within a critical section of 'd_epochManager'.
+
+  public:
+    // PUBLIC CONSTANTS
+    enum {
+        k_DEFAULT_NUM_BUCKETS  = 16, // Default number of buckets
+        k_DEFAULT_NUM_STRIPES  = 16  // Default number of stripes
+    };
+
+    // PUBLIC TYPES
+    typedef bsl::pair<KEY, VALUE> KVType;
+        // Value type of a bulk insert entry.
+
+    typedef bsl::function<bool (VALUE *, const KEY&)> VisitorFunction;
+        // An alias to a function meeting the following contract:
+        //..
+        //  bool visitorFunction(VALUE *value, const KEY& key);
+        //      // Visit the specified 'value' attribute associated with the
+        //      // specified 'key'.  Return 'true' if this function may be
+        //      // called on additional elements, and 'false' otherwise (i.e.,
+        //      // if no other elements should be visited).  Note that this
+        //      // functor can change the value associated with 'key'.
+        //..
+
+    typedef bsl::function<bool (const VALUE&, const KEY&)>
+                                                       ReadOnlyVisitorFunction;
+        // An alias to a function meeting the following contract:
+        //..
+        //  bool visitorFunction(const VALUE& value, const KEY& key);
+        //      // Visit the specified 'value' attribute associated with the
+        //      // specified 'key'.  Return 'true' if this function may be
+        //      // called on additional elements, and 'false' otherwise (i.e.,
+        //      // if no other elements should be visited).
+        //..
+
+    // CREATORS
+    explicit ConcurrentHashMap(
+                   bsl::size_t       numInitialBuckets = k_DEFAULT_NUM_BUCKETS,
+                   bsl::size_t       numStripes        = k_DEFAULT_NUM_STRIPES,
+                   bslma::Allocator *basicAllocator    = 0);
+        // Create an empty 'ConcurrentHashMap' object, a fully thread-safe hash
+        // map whose modifications are partitioned into "stripes" (a group of
+        // buckets protected by a mutex) and whose lookups acquire no lock.
+        // Optionally specify 'numInitialBuckets' and 'numStripes', which
+        // define the minimum number of buckets and the (fixed) number of
+        // stripes in this map; each is rounded up to a power of 2, and the
+        // number of buckets is at least the number of stripes.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The hash map has rehash enabled.
+
+    ~ConcurrentHashMap();
+        // Destroy this hash map.  The behavior is undefined if any other
+        // method of this object is executing.
+
+    // MANIPULATORS
+    void clear();
+        // Remove all elements from this hash map.  If rehash is in progress,
+        // block until it completes.
+
+    void disableRehash();
+        // Prevent future rehash until 'enableRehash' is called.
+
+    void enableRehash();
+        // Allow rehash.  If conditions warrant, rehash will be started by the
+        // *next* method call that observes the load factor is exceeded (see
+        // {Concurrent Rehash}).
+
+    bsl::size_t erase(const KEY& key);
+        // Erase from this hash map the element having the specified 'key'.
+        // Return 1 on success and 0 if 'key' does not exist.  Note that the
+        // returned value equals the number of elements removed.
+
+    template <class RANDOM_ITER>
+    bsl::size_t eraseBulk(RANDOM_ITER first, RANDOM_ITER last);
+        // Erase from this hash map the elements having any of the keys
+        // contained between the specified 'first' (inclusive) and 'last'
+        // (exclusive) random-access iterators.  The iterators provide read
+        // access to a sequence of 'KEY' objects.  Return the number of
+        // elements removed.  The behavior is undefined unless 'first <= last'.
+
+    bsl::size_t insert(const KEY& key, const VALUE& value);
+        // Insert into this hash map an element having the specified 'key' and
+        // 'value'.  If 'key' already exists in this hash map, the value
+        // attribute of that element is set to 'value'.  Return 1 if an element
+        // is inserted, and 0 if an existing element is updated.  Note that the
+        // return value equals the number of elements inserted.
+
+    bsl::size_t insert(const KEY& key, bslmf::MovableRef<VALUE> value);
+        // Insert into this hash map an element having the specified 'key' and
+        // the specified move-insertable 'value'.  If 'key' already exists in
+        // this hash map, the value attribute of that element is set to
+        // 'value'.  Return 1 if an element is inserted, and 0 if an existing
+        // element is updated.  The 'value' object is left in a valid but
+        // unspecified state.  Note that the return value equals the number of
+        // elements inserted.
+
+    template <class RANDOM_ITER>
+    bsl::size_t insertBulk(RANDOM_ITER first, RANDOM_ITER last);
+        // Insert into this hash map elements having the key-value pairs
+        // obtained between the specified 'first' (inclusive) and 'last'
+        // (exclusive) random-access iterators.  The iterators provide read
+        // access to a sequence of 'bsl::pair<KEY, VALUE>' objects.  If an
+        // element having one of the keys already exists in this hash map, set
+        // the value attribute to the corresponding value.  Return the number
+        // of elements inserted.  The behavior is undefined unless
+        // 'first <= last'.
+
+    void maxLoadFactor(float newMaxLoadFactor);
+        // Set the maximum load factor of this hash map to the specified
+        // 'newMaxLoadFactor'.  If 'newMaxLoadFactor < loadFactor()' and rehash
+        // is enabled, this operation will cause an immediate rehash;
+        // otherwise, this operation has a constant-time cost.  The behavior is
+        // undefined unless '0 < newMaxLoadFactor'.
+
+    void rehash(bsl::size_t numBuckets);
+        // Recreate this hash map to one having at least the specified
+        // 'numBuckets'.  This operation is a no-op if *any* of the following
+        // are true: 1) rehash is disabled; 2) 'numBuckets' less or equals the
+        // current number of buckets.  See {Concurrent Rehash}.
+
+    int setComputedValue(const KEY&             key,
+                         const VisitorFunction& visitor);
+        // Invoke the specified 'visitor' on a copy of the value associated
+        // with the specified 'key' and replace the value by the result.  If
+        // 'key' is not in the map, invoke 'visitor' on a default constructed
+        // value and insert '(key, value)'.  That is, 'visitor' must be
+        // invocable with the 'VisitorFunction' signature:
+        //..
+        //  bool visitor(VALUE *value, const Key& key);
+        //..
+        // Return 1 if 'key' was found and 'visitor' returned 'true', 0 if
+        // 'key' was not found, and -1 if 'key' was found and 'visitor'
+        // returned 'false'.  'visitor', when invoked, has exclusive access to
+        // the value it modifies.  If 'visitor' throws, the map is not
+        // modified.  The behavior is undefined if hash map manipulators are
+        // invoked from within 'visitor', as it may lead to a deadlock.  Note
+        // that the return value equals the number of elements found having
+        // 'key'.  Also note that a return value of '0' implies that an element
+        // was inserted.
+
+    bsl::size_t setValue(const KEY& key, const VALUE& value);
+        // Set the value attribute of the element in this hash map having the
+        // specified 'key' to the specified 'value'.  If no such element
+        // exists, insert '(key, value)'.  Return 1 if 'key' was found, and 0
+        // otherwise.  Note that the return value equals the number of elements
+        // found having 'key'.
+
+    bsl::size_t setValue(const KEY& key, bslmf::MovableRef<VALUE> value);
+        // Set the value attribute of the element in this hash map having the
+        // specified 'key' to the specified move-insertable 'value'.  If no
+        // such element exists, insert '(key, value)'.  Return 1 if 'key' was
+        // found, and 0 otherwise.  The 'value' object is left in a valid but
+        // unspecified state.  Note that the return value equals the number of
+        // elements found having 'key'.
+
+    int update(const KEY& key, const VisitorFunction& visitor);
+        // Invoke the specified 'visitor' on a copy of the value of the element
+        // (if one exists) in this hash map having the specified 'key', and
+        // replace the value by the result.  That is:
+        //..
+        //  bool visitor(&value, key);
+        //..
+        // Return the number of elements updated or -1 if 'visitor' returned
+        // 'false'.  If 'visitor' throws, the map is not modified.  The
+        // behavior is undefined if hash map manipulators are invoked from
+        // within 'visitor', as it may lead to a deadlock.
+
+    int visit(const VisitorFunction& visitor);
+        // Call the specified 'visitor' (in an unspecified order) on a copy of
+        // the value of each element in this hash table, replacing the value by
+        // the result, until each such element has been visited or until
+        // 'visitor' returns 'false'.  That is, for '(key, value)', invoke:
+        //..
+        //  bool visitor(&value, key);
+        //..
+        // Return the number of elements visited or the negation of that value
+        // if visitations stopped because 'visitor' returned 'false'.  Every
+        // element present in this hash map at the time 'visit' is invoked will
+        // be visited unless it is removed before 'visitor' is called for that
+        // element.  Elements inserted during the execution of 'visit' may or
+        // may not be visited.  Rehash is delayed until 'visit' returns.  The
+        // behavior is undefined if hash map manipulators are invoked from
+        // within 'visitor', as it may lead to a deadlock.  Note that each
+        // visited element is copied; see 'visitReadOnly' for read access
+        // without copies.
+
+    // ACCESSORS
+    bsl::size_t bucketCount() const;
+        // Return the number of buckets in the array of buckets maintained by
+        // this hash map.  Note that unless rehash is disabled, the value
+        // returned may be obsolete by the time it is received.
+
+    bool empty() const;
+        // Return 'true' if this hash map contains no elements, and 'false'
+        // otherwise.
+
+    EQUAL equalFunction() const;
+        // Return (a copy of) the key-equality functor used by this hash map.
+
+    bsl::size_t getValue(VALUE *value, const KEY& key) const;
+        // Load, into the specified '*value', the value attribute of the
+        // element in this hash map having the specified 'key'.  Return 1 on
+        // success and 0 if 'key' does not exist in this hash map.  This method
+        // does not acquire any lock.  Note that the return value equals the
+        // number of values returned.
+
+    HASH hashFunction() const;
+        // Return (a copy of) the unary hash functor used by this hash map.
+
+    bool isRehashEnabled() const;
+        // Return 'true' if rehash is enabled, or 'false' otherwise.
+
+    float loadFactor() const;
+        // Return the current quotient of the size of this hash map and the
+        // number of buckets.
+
+    float maxLoadFactor() const;
+        // Return the maximum load factor allowed for this hash map.  If an
+        // insert operation would cause the load factor to exceed the
+        // 'maxLoadFactor()' and rehashing is enabled, then that insert
+        // increases the number of buckets and rehashes the elements of the
+        // container into that larger set of buckets.
+
+    bsl::size_t numStripes() const;
+        // Return the number of stripes in the hash.
+
+    bsl::size_t size() const;
+        // Return the current number of elements in this hash map.
+
+    int visitReadOnly(const ReadOnlyVisitorFunction& visitor) const;
+        // Call the specified 'visitor' (in an unspecified order) on each
+        // element in this hash table until each such element has been visited
+        // or until 'visitor' returns 'false'.  That is, for '(key, value)',
+        // invoke:
+        //..
+        //  bool visitor(value, key);
+        //..
+        // Return the number of elements visited or the negation of that value
+        // if visitations stopped because 'visitor' returned 'false'.  Every
+        // element present in this hash map at the time 'visitReadOnly' is
+        // invoked, and not modified or removed during its execution, will be
+        // visited.  This method does not acquire any lock; however, memory of
+        // elements removed from this hash map is not reclaimed while 'visitor'
+        // executes.  The behavior is undefined if hash map manipulators are
+        // invoked from within 'visitor'.
+
+    int visitReadOnly(const KEY&                     key,
+                      const ReadOnlyVisitorFunction& visitor) const;
+        // Call the specified 'visitor' on the element (if one exists) in this
+        // hash map having the specified 'key'.  That is:
+        //..
+        //  bool visitor(value, key);
+        //..
+        // Return the number of elements visited or -1 if 'visitor' returned
+        // 'false'.  This method does not acquire any lock.  The behavior is
+        // undefined if hash map manipulators are invoked from within
+        // 'visitor'.
+
+                               // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this hash map to supply memory.  Note
+        // that if no allocator was supplied at construction the default
+        // allocator installed at that time is used.
+};
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                        // ----------------------------
+                        // class ConcurrentHashMap_Node
+                        // ----------------------------
+
+// CREATORS
+template <class KEY, class VALUE>
+inline
+ConcurrentHashMap_Node<KEY, VALUE>::ConcurrentHashMap_Node(
+                                              bsl::size_t       hash,
+                                              const KEY&        key,
+                                              bslma::Allocator *basicAllocator)
+: d_next(0)
+, d_hash(hash)
+{
+    bslma::ConstructionUtil::construct(d_key.address(), basicAllocator, key);
+    bslma::DestructorProctor<KEY> proctor(&d_key.object());
+
+    bslma::ConstructionUtil::construct(d_value.address(), basicAllocator);
+    proctor.release();
+}
+
+template <class KEY, class VALUE>
+inline
+ConcurrentHashMap_Node<KEY, VALUE>::ConcurrentHashMap_Node(
+                                              bsl::size_t       hash,
+                                              const KEY&        key,
+                                              const VALUE&      value,
+                                              bslma::Allocator *basicAllocator)
+: d_next(0)
+, d_hash(hash)
+{
+    bslma::ConstructionUtil::construct(d_key.address(), basicAllocator, key);
+    bslma::DestructorProctor<KEY> proctor(&d_key.object());
+
+    bslma::ConstructionUtil::construct(d_value.address(),
+                                       basicAllocator,
+                                       value);
+    proctor.release();
+}
+
+template <class KEY, class VALUE>
+inline
+ConcurrentHashMap_Node<KEY, VALUE>::ConcurrentHashMap_Node(
+                                      bsl::size_t               hash,
+                                      const KEY&                key,
+                                      bslmf::MovableRef<VALUE>  value,
+                                      bslma::Allocator         *basicAllocator)
+: d_next(0)
+, d_hash(hash)
+{
+    bslma::ConstructionUtil::construct(d_key.address(), basicAllocator, key);
+    bslma::DestructorProctor<KEY> proctor(&d_key.object());
+
+    bslma::ConstructionUtil::construct(d_value.address(),
+                                       basicAllocator,
+                                       bslmf::MovableRefUtil::move(value));
+    proctor.release();
+}
+
+template <class KEY, class VALUE>
+inline
+ConcurrentHashMap_Node<KEY, VALUE>::~ConcurrentHashMap_Node()
+{
+    bslma::DestructionUtil::destroy(d_key.address());
+    bslma::DestructionUtil::destroy(d_value.address());
+}
+
+// MANIPULATORS
+template <class KEY, class VALUE>
+inline
+bsls::AtomicPointer<ConcurrentHashMap_Node<KEY, VALUE> >&
+ConcurrentHashMap_Node<KEY, VALUE>::next()
+{
+    return d_next;
+}
+
+template <class KEY, class VALUE>
+inline
+VALUE& ConcurrentHashMap_Node<KEY, VALUE>::value()
+{
+    return d_value.object();
+}
+
+// ACCESSORS
+template <class KEY, class VALUE>
+inline
+bsl::size_t ConcurrentHashMap_Node<KEY, VALUE>::hash() const
+{
+    return d_hash;
+}
+
+template <class KEY, class VALUE>
+inline
+const KEY& ConcurrentHashMap_Node<KEY, VALUE>::key() const
+{
+    return d_key.object();
+}
+
+template <class KEY, class VALUE>
+inline
+const VALUE& ConcurrentHashMap_Node<KEY, VALUE>::value() const
+{
+    return d_value.object();
+}
+
+                       // -----------------------------
+                       // class ConcurrentHashMap_Table
+                       // -----------------------------
+
+// CLASS METHODS
+template <class KEY, class VALUE>
+inline
+typename ConcurrentHashMap_Table<KEY, VALUE>::Node *
+ConcurrentHashMap_Table<KEY, VALUE>::movedMarker()
+{
+    // Nodes are at least pointer-aligned, so the address 1 is never the
+    // address of a node.
+
+    return reinterpret_cast<Node *>(1);
+}
+
+// CREATORS
+template <class KEY, class VALUE>
+ConcurrentHashMap_Table<KEY, VALUE>::ConcurrentHashMap_Table(
+                                              bsl::size_t       numBuckets,
+                                              bslma::Allocator *basicAllocator)
+: d_buckets_p(0)
+, d_numBuckets(numBuckets)
+, d_next(0)
+, d_allocator_p(basicAllocator)
+{
+    BSLS_ASSERT(0 < numBuckets);
+    BSLS_ASSERT(0 == (numBuckets & (numBuckets - 1)));
+
+    d_buckets_p = static_cast<Link *>(
+                          d_allocator_p->allocate(numBuckets * sizeof(Link)));
+    for (bsl::size_t i = 0; i < numBuckets; ++i) {
+        new (d_buckets_p + i) Link(0);
+    }
+}
+
+template <class KEY, class VALUE>
+inline
+ConcurrentHashMap_Table<KEY, VALUE>::~ConcurrentHashMap_Table()
+{
+    d_allocator_p->deallocate(d_buckets_p);
+}
+
+// MANIPULATORS
+template <class KEY, class VALUE>
+inline
+typename ConcurrentHashMap_Table<KEY, VALUE>::Link&
+ConcurrentHashMap_Table<KEY, VALUE>::bucket(bsl::size_t hash)
+{
+    return d_buckets_p[hash & (d_numBuckets - 1)];
+}
+
+template <class KEY, class VALUE>
+inline
+typename ConcurrentHashMap_Table<KEY, VALUE>::Link&
+ConcurrentHashMap_Table<KEY, VALUE>::bucketAt(bsl::size_t index)
+{
+    BSLS_ASSERT_SAFE(index < d_numBuckets);
+
+    return d_buckets_p[index];
+}
+
+template <class KEY, class VALUE>
+inline
+bsls::AtomicPointer<ConcurrentHashMap_Table<KEY, VALUE> >&
+ConcurrentHashMap_Table<KEY, VALUE>::next()
+{
+    return d_next;
+}
+
+// ACCESSORS
+template <class KEY, class VALUE>
+inline
+bsl::size_t ConcurrentHashMap_Table<KEY, VALUE>::numBuckets() const
+{
+    return d_numBuckets;
+}
+
+                   // ----------------------------------------
+                   // class ConcurrentHashMap_NodeChainProctor
+                   // ----------------------------------------
+
+// CREATORS
+template <class KEY, class VALUE>
+inline
+ConcurrentHashMap_NodeChainProctor<KEY, VALUE>::
+ConcurrentHashMap_NodeChainProctor(Node             **head,
+                                   bslma::Allocator  *basicAllocator)
+: d_head_p(head)
+, d_allocator_p(basicAllocator)
+{
+}
+
+template <class KEY, class VALUE>
+ConcurrentHashMap_NodeChainProctor<KEY, VALUE>::
+~ConcurrentHashMap_NodeChainProctor()
+{
+    if (d_head_p) {
+        for (Node *node = *d_head_p; node; ) {
+            Node *next = node->next().loadRelaxed();
+            d_allocator_p->deleteObject(node);
+            node = next;
+        }
+    }
+}
+
+// MANIPULATORS
+template <class KEY, class VALUE>
+inline
+void ConcurrentHashMap_NodeChainProctor<KEY, VALUE>::release()
+{
+    d_head_p = 0;
+}
+
+                          // -----------------------
+                          // class ConcurrentHashMap
+                          // -----------------------
+
+// PRIVATE CLASS METHODS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::deleteNode(void *node,
+                                                            void *allocator)
+{
+    bslma::Allocator *basicAllocator = static_cast<bslma::Allocator *>(
+                                                                    allocator);
+    basicAllocator->deleteObject(static_cast<Node *>(node));
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+float ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::fromBits(unsigned int bits)
+{
+    BSLMF_ASSERT(sizeof(float) == sizeof(unsigned int));
+
+    float value;
+    bsl::memcpy(&value, &bits, sizeof value);
+    return value;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+unsigned int ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::toBits(float value)
+{
+    BSLMF_ASSERT(sizeof(float) == sizeof(unsigned int));
+
+    unsigned int bits;
+    bsl::memcpy(&bits, &value, sizeof bits);
+    return bits;
+}
+
+// PRIVATE MANIPULATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::checkLoadFactor()
+{
+    if (static_cast<bsls::Types::Uint64>(d_numElements.loadRelaxed()) <=
+                                             d_maxNumElements.loadRelaxed()
+     || !d_rehashEnabled.loadRelaxed()) {
+        return;                                                       // RETURN
+    }
+
+    if (0 != d_rehashMutex.tryLock()) {
+        return;                                                       // RETURN
+    }
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_rehashMutex, true);
+
+    const double maxLoadFactor = fromBits(d_maxLoadFactor.loadRelaxed());
+    const double size = static_cast<double>(d_numElements.loadRelaxed());
+
+    bsl::size_t numBuckets = d_table.loadRelaxed()->numBuckets();
+    do {
+        numBuckets *= 2;
+    } while (size > static_cast<double>(numBuckets) * maxLoadFactor);
+
+    rehashImp(numBuckets);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::Link *
+ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::findLink(Link        *head,
+                                                     const KEY&   key,
+                                                     bsl::size_t  hash)
+{
+    for (Link *link = head;; ) {
+        Node *node = link->loadRelaxed();
+        if (0 == node) {
+            return 0;                                                 // RETURN
+        }
+        if (hash == node->hash() && d_comparator(node->key(), key)) {
+            return link;                                              // RETURN
+        }
+        link = &node->next();
+    }
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::migrateBucket(
+                                                         Table       *oldTable,
+                                                         Table       *newTable,
+                                                         bsl::size_t  index)
+{
+    Stripe&                        stripe = d_stripes_p[index &
+                                                          (d_numStripes - 1)];
+    bslmt::LockGuard<bslmt::Mutex> guard(&stripe.d_mutex);
+
+    Link& bucket = oldTable->bucketAt(index);
+    Node *head   = bucket.loadRelaxed();
+
+    if (Table::movedMarker() == head) {
+        return;                                                       // RETURN
+    }
+    if (0 == head) {
+        bucket.store(Table::movedMarker());
+        return;                                                       // RETURN
+    }
+
+    // Find the longest suffix of the chain whose nodes all move to the same
+    // bucket of 'newTable'; these nodes are moved without being copied.
+
+    const bsl::size_t mask     = newTable->numBuckets() - 1;
+    Node             *lastRun  = head;
+    bsl::size_t       numNodes = 0;
+    for (Node *node = head; node; node = node->next().loadRelaxed()) {
+        if ((node->hash() & mask) != (lastRun->hash() & mask)) {
+            lastRun = node;
+        }
+        ++numNodes;
+    }
+
+    d_epochManager.reserve(numNodes);
+
+    // Copy the nodes preceding 'lastRun' into a private chain, so that an
+    // exception leaves the buckets unchanged.
+
+    Node             *copies = 0;
+    NodeChainProctor  copiesProctor(&copies, d_allocator_p);
+    for (Node *node = head; node != lastRun;
+                                           node = node->next().loadRelaxed()) {
+        Node *copy = new (*d_allocator_p) Node(node->hash(),
+                                               node->key(),
+                                               node->value(),
+                                               d_allocator_p);
+        copy->next().storeRelaxed(copies);
+        copies = copy;
+    }
+    copiesProctor.release();
+
+    newTable->bucket(lastRun->hash()).store(lastRun);
+    while (copies) {
+        Node *node = copies;
+        copies     = node->next().loadRelaxed();
+
+        Link& target = newTable->bucket(node->hash());
+        node->next().storeRelaxed(target.loadRelaxed());
+        target.store(node);
+    }
+
+    bucket.store(Table::movedMarker());
+
+    for (Node *node = head; node != lastRun; ) {
+        Node *next = node->next().loadRelaxed();
+        retire(node);
+        node = next;
+    }
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::rehashImp(
+                                                        bsl::size_t numBuckets)
+{
+    Table *oldTable = d_table.loadRelaxed();
+    Table *newTable = oldTable->next().loadRelaxed();
+
+    if (0 == newTable) {
+        if (numBuckets <= oldTable->numBuckets()) {
+            return;                                                   // RETURN
+        }
+        newTable = new (*d_allocator_p) Table(numBuckets, d_allocator_p);
+        oldTable->next().store(newTable);
+    }
+
+    const bsl::size_t oldNumBuckets = oldTable->numBuckets();
+    for (bsl::size_t i = 0; i < oldNumBuckets; ++i) {
+        migrateBucket(oldTable, newTable, i);
+    }
+
+    d_epochManager.reserve(1);
+
+    d_table.store(newTable);
+    updateMaxNumElements(newTable->numBuckets());
+
+    // Readers and writers may still be examining 'oldTable', which is released
+    // once they have all left their critical sections.
+
+    d_epochManager.retireObject(oldTable, d_allocator_p);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::replace(Link *link,
+                                                         Node *node)
+{
+    Node *oldNode = link->loadRelaxed();
+    node->next().storeRelaxed(oldNode->next().loadRelaxed());
+    link->store(node);
+    retire(oldNode);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::retire(Node *node)
+{
+    d_epochManager.retire(node, &deleteNode, d_allocator_p);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+bsl::size_t ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::setNode(Node *node)
+{
+    bslma::RawDeleterProctor<Node, bslma::Allocator> proctor(node,
+                                                             d_allocator_p);
+    bsl::size_t                                      found = 0;
+    {
+        EpochManagerGuard              epochGuard(&d_epochManager);
+        Stripe&                        s = stripe(node->hash());
+        bslmt::LockGuard<bslmt::Mutex> guard(&s.d_mutex);
+
+        d_epochManager.reserve(1);
+
+        Link& head = writerBucket(node->hash());
+        Link *link = findLink(&head, node->key(), node->hash());
+        proctor.release();
+
+        if (link) {
+            replace(link, node);
+            found = 1;
+        }
+        else {
+            node->next().storeRelaxed(head.loadRelaxed());
+            head.store(node);
+            d_numElements.addRelaxed(1);
+        }
+    }
+
+    // Check the load factor even if no element was added, so that a rehash
+    // abandoned due to an exception is eventually completed.
+
+    checkLoadFactor();
+    return found;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+ConcurrentHashMap_Stripe&
+ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::stripe(bsl::size_t hash)
+{
+    return d_stripes_p[hash & (d_numStripes - 1)];
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::updateMaxNumElements(
+                                                        bsl::size_t numBuckets)
+{
+    d_maxNumElements.storeRelaxed(static_cast<bsls::Types::Uint64>(
+                             static_cast<double>(numBuckets)
+                                   * fromBits(d_maxLoadFactor.loadRelaxed())));
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::Link&
+ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::writerBucket(bsl::size_t hash)
+{
+    Table *table = d_table.load();
+    for (;;) {
+        Link& bucket = table->bucket(hash);
+        if (Table::movedMarker() != bucket.loadRelaxed()) {
+            return bucket;                                            // RETURN
+        }
+        table = table->next().load();
+    }
+}
+
+// PRIVATE ACCESSORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+const typename ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::Node *
+ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::find(const KEY&  key,
+                                                 bsl::size_t hash) const
+{
+    Table *table = d_table.load();
+    Node  *node  = table->bucket(hash).load();
+    while (Table::movedMarker() == node) {
+        table = table->next().load();
+        node  = table->bucket(hash).load();
+    }
+
+    for (; node; node = node->next().loadAcquire()) {
+        if (hash == node->hash() && d_comparator(node->key(), key)) {
+            return node;                                              // RETURN
+        }
+    }
+    return 0;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class VISITOR>
+bool ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::visitBucket(
+                                                   Table       *table,
+                                                   bsl::size_t  index,
+                                                   VISITOR&     visitor,
+                                                   int         *count) const
+{
+    Node *node = table->bucketAt(index).load();
+
+    if (Table::movedMarker() == node) {
+        Table *next = table->next().load();
+        for (bsl::size_t i = index; i < next->numBuckets();
+                                                  i += table->numBuckets()) {
+            if (!visitBucket(next, i, visitor, count)) {
+                return false;                                         // RETURN
+            }
+        }
+        return true;                                                  // RETURN
+    }
+
+    for (; node; node = node->next().loadAcquire()) {
+        ++*count;
+        if (!visitor(node->value(), node->key())) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+// CREATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::ConcurrentHashMap(
+                                           bsl::size_t       numInitialBuckets,
+                                           bsl::size_t       numStripes,
+                                           bslma::Allocator *basicAllocator)
+: d_table(0)
+, d_numElements(0)
+, d_maxNumElements(0)
+, d_rehashEnabled(true)
+, d_maxLoadFactor(toBits(1.0f))
+, d_numStripes(static_cast<bsl::size_t>(
+                       bdlb::BitUtil::roundUpToBinaryPower(
+                           static_cast<bdlb::BitUtil::uint64_t>(
+                                               numStripes ? numStripes : 1))))
+, d_stripes_p(0)
+, d_hasher()
+, d_comparator()
+, d_epochManager(basicAllocator)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    bsl::size_t numBuckets = static_cast<bsl::size_t>(
+                        bdlb::BitUtil::roundUpToBinaryPower(
+                            static_cast<bdlb::BitUtil::uint64_t>(
+                                 numInitialBuckets ? numInitialBuckets : 1)));
+    if (numBuckets < d_numStripes) {
+        numBuckets = d_numStripes;
+    }
+
+    Table *table = new (*d_allocator_p) Table(numBuckets, d_allocator_p);
+    bslma::RawDeleterProctor<Table, bslma::Allocator> tableProctor(
+                                                               table,
+                                                               d_allocator_p);
+
+    d_stripes_p = static_cast<Stripe *>(
+                      d_allocator_p->allocate(d_numStripes * sizeof(Stripe)));
+    for (bsl::size_t i = 0; i < d_numStripes; ++i) {
+        new (d_stripes_p + i) Stripe();
+    }
+
+    d_table.storeRelaxed(table);
+    tableProctor.release();
+    updateMaxNumElements(numBuckets);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::~ConcurrentHashMap()
+{
+    for (Table *table = d_table.loadRelaxed(); table; ) {
+        for (bsl::size_t i = 0; i < table->numBuckets(); ++i) {
+            Node *node = table->bucketAt(i).loadRelaxed();
+            if (Table::movedMarker() == node) {
+                continue;
+            }
+            while (node) {
+                Node *next = node->next().loadRelaxed();
+                d_allocator_p->deleteObject(node);
+                node = next;
+            }
+        }
+        Table *next = table->next().loadRelaxed();
+        d_allocator_p->deleteObject(table);
+        table = next;
+    }
+
+    for (bsl::size_t i = 0; i < d_numStripes; ++i) {
+        d_stripes_p[i].~Stripe();
+    }
+    d_allocator_p->deallocate(d_stripes_p);
+}
+
+// MANIPULATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::clear()
+{
+    bslmt::LockGuard<bslmt::Mutex> rehashGuard(&d_rehashMutex);
+
+    rehashImp(0);
+
+    Table *table = d_table.loadRelaxed();
+    for (bsl::size_t i = 0; i < table->numBuckets(); ++i) {
+        Stripe&                        s = d_stripes_p[i & (d_numStripes - 1)];
+        bslmt::LockGuard<bslmt::Mutex> guard(&s.d_mutex);
+
+        Link&       bucket   = table->bucketAt(i);
+        bsl::size_t numNodes = 0;
+        for (Node *node = bucket.loadRelaxed(); node;
+                                           node = node->next().loadRelaxed()) {
+            ++numNodes;
+        }
+        d_epochManager.reserve(numNodes);
+
+        Node *node = bucket.loadRelaxed();
+        bucket.store(0);
+        while (node) {
+            Node *next = node->next().loadRelaxed();
+            retire(node);
+            node = next;
+        }
+        d_numElements.addRelaxed(-static_cast<bsls::Types::Int64>(numNodes));
+    }
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::disableRehash()
+{
+    d_rehashEnabled.store(false);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::enableRehash()
+{
+    d_rehashEnabled.store(true);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+bsl::size_t ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::erase(const KEY& key)
+{
+    const bsl::size_t              hash = d_hasher(key);
+    EpochManagerGuard              epochGuard(&d_epochManager);
+    Stripe&                        s = stripe(hash);
+    bslmt::LockGuard<bslmt::Mutex> guard(&s.d_mutex);
+
+    Link *link = findLink(&writerBucket(hash), key, hash);
+    if (0 == link) {
+        return 0;                                                     // RETURN
+    }
+
+    d_epochManager.reserve(1);
+
+    Node *node = link->loadRelaxed();
+    link->store(node->next().loadRelaxed());
+    d_numElements.addRelaxed(-1);
+    retire(node);
+    return 1;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class RANDOM_ITER>
+bsl::size_t ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::eraseBulk(
+                                                             RANDOM_ITER first,
+                                                             RANDOM_ITER last)
+{
+    BSLS_ASSERT(first <= last);
+
+    bsl::size_t count = 0;
+    for (; first != last; ++first) {
+        count += erase(*first);
+    }
+    return count;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::insert(
+                                                            const KEY&   key,
+                                                            const VALUE& value)
+{
+    return 1 - setNode(new (*d_allocator_p) Node(d_hasher(key),
+                                                 key,
+                                                 value,
+                                                 d_allocator_p));
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::insert(
+                                                const KEY&               key,
+                                                bslmf::MovableRef<VALUE> value)
+{
+    return 1 - setNode(new (*d_allocator_p) Node(
+                                          d_hasher(key),
+                                          key,
+                                          bslmf::MovableRefUtil::move(value),
+                                          d_allocator_p));
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class RANDOM_ITER>
+bsl::size_t ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::insertBulk(
+                                                             RANDOM_ITER first,
+                                                             RANDOM_ITER last)
+{
+    BSLS_ASSERT(first <= last);
+
+    bsl::size_t count = 0;
+    for (; first != last; ++first) {
+        count += insert(first->first, first->second);
+    }
+    return count;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::maxLoadFactor(
+                                                        float newMaxLoadFactor)
+{
+    BSLS_ASSERT(0 < newMaxLoadFactor);
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_rehashMutex);
+
+        d_maxLoadFactor.storeRelaxed(toBits(newMaxLoadFactor));
+        updateMaxNumElements(d_table.loadRelaxed()->numBuckets());
+    }
+    checkLoadFactor();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::rehash(bsl::size_t numBuckets)
+{
+    if (!d_rehashEnabled.load()) {
+        return;                                                       // RETURN
+    }
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_rehashMutex);
+
+    if (numBuckets > d_table.loadRelaxed()->numBuckets()) {
+        rehashImp(static_cast<bsl::size_t>(
+                              bdlb::BitUtil::roundUpToBinaryPower(
+                                  static_cast<bdlb::BitUtil::uint64_t>(
+                                                              numBuckets))));
+    }
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+int ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::setComputedValue(
+                                                const KEY&             key,
+                                                const VisitorFunction& visitor)
+{
+    const bsl::size_t hash = d_hasher(key);
+    int               rc   = 0;
+    {
+        EpochManagerGuard              epochGuard(&d_epochManager);
+        Stripe&                        s = stripe(hash);
+        bslmt::LockGuard<bslmt::Mutex> guard(&s.d_mutex);
+
+        d_epochManager.reserve(1);
+
+        Link& head = writerBucket(hash);
+        Link *link = findLink(&head, key, hash);
+        Node *node = link
+                   ? new (*d_allocator_p) Node(hash,
+                                               link->loadRelaxed()->key(),
+                                               link->loadRelaxed()->value(),
+                                               d_allocator_p)
+                   : new (*d_allocator_p) Node(hash, key, d_allocator_p);
+
+        bslma::RawDeleterProctor<Node, bslma::Allocator> proctor(
+                                                                node,
+                                                                d_allocator_p);
+        const bool result = visitor(&node->value(), node->key());
+        proctor.release();
+
+        if (link) {
+            replace(link, node);
+            rc = result ? 1 : -1;
+        }
+        else {
+            node->next().storeRelaxed(head.loadRelaxed());
+            head.store(node);
+            d_numElements.addRelaxed(1);
+        }
+    }
+
+    checkLoadFactor();
+    return rc;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::setValue(
+                                                            const KEY&   key,
+                                                            const VALUE& value)
+{
+    return setNode(new (*d_allocator_p) Node(d_hasher(key),
+                                             key,
+                                             value,
+                                             d_allocator_p));
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::setValue(
+                                                const KEY&               key,
+                                                bslmf::MovableRef<VALUE> value)
+{
+    return setNode(new (*d_allocator_p) Node(
+                                          d_hasher(key),
+                                          key,
+                                          bslmf::MovableRefUtil::move(value),
+                                          d_allocator_p));
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+int ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::update(
+                                                const KEY&             key,
+                                                const VisitorFunction& visitor)
+{
+    const bsl::size_t              hash = d_hasher(key);
+    EpochManagerGuard              epochGuard(&d_epochManager);
+    Stripe&                        s = stripe(hash);
+    bslmt::LockGuard<bslmt::Mutex> guard(&s.d_mutex);
+
+    Link *link = findLink(&writerBucket(hash), key, hash);
+    if (0 == link) {
+        return 0;                                                     // RETURN
+    }
+
+    d_epochManager.reserve(1);
+
+    const Node *oldNode = link->loadRelaxed();
+    Node       *node    = new (*d_allocator_p) Node(hash,
+                                                    oldNode->key(),
+                                                    oldNode->value(),
+                                                    d_allocator_p);
+    bslma::RawDeleterProctor<Node, bslma::Allocator> proctor(node,
+                                                             d_allocator_p);
+    const bool result = visitor(&node->value(), key);
+
+    replace(link, node);
+    proctor.release();
+    return result ? 1 : -1;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+int ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::visit(
+                                                const VisitorFunction& visitor)
+{
+    int count = 0;
+    {
+        bslmt::LockGuard<bslmt::Mutex> rehashGuard(&d_rehashMutex);
+
+        rehashImp(0);
+
+        Table *table = d_table.loadRelaxed();
+        for (bsl::size_t i = 0; i < table->numBuckets(); ++i) {
+            Stripe&                        s = d_stripes_p[i
+                                                         & (d_numStripes - 1)];
+            bslmt::LockGuard<bslmt::Mutex> guard(&s.d_mutex);
+
+            for (Link *link = &table->bucketAt(i); link->loadRelaxed();
+                                       link = &link->loadRelaxed()->next()) {
+                d_epochManager.reserve(1);
+
+                const Node *oldNode = link->loadRelaxed();
+                Node       *node    = new (*d_allocator_p) Node(
+                                                              oldNode->hash(),
+                                                              oldNode->key(),
+                                                              oldNode->value(),
+                                                              d_allocator_p);
+                bslma::RawDeleterProctor<Node, bslma::Allocator> proctor(
+                                                                node,
+                                                                d_allocator_p);
+                const bool result = visitor(&node->value(), node->key());
+
+                replace(link, node);
+                proctor.release();
+
+                ++count;
+                if (!result) {
+                    return -count;                                    // RETURN
+                }
+            }
+        }
+    }
+    checkLoadFactor();
+    return count;
+}
+
+// ACCESSORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::bucketCount() const
+{
+    EpochManagerGuard epochGuard(&d_epochManager);
+
+    return d_table.load()->numBuckets();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bool ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::empty() const
+{
+    return 0 == size();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+EQUAL ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::equalFunction() const
+{
+    return d_comparator;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::getValue(
+                                                         VALUE      *value,
+                                                         const KEY&  key) const
+{
+    BSLS_ASSERT(value);
+
+    const bsl::size_t hash = d_hasher(key);
+    EpochManagerGuard epochGuard(&d_epochManager);
+
+    const Node *node = find(key, hash);
+    if (0 == node) {
+        return 0;                                                     // RETURN
+    }
+    *value = node->value();
+    return 1;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+HASH ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::hashFunction() const
+{
+    return d_hasher;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bool ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::isRehashEnabled() const
+{
+    return d_rehashEnabled.load();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+float ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::loadFactor() const
+{
+    return static_cast<float>(size()) / static_cast<float>(bucketCount());
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+float ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::maxLoadFactor() const
+{
+    return fromBits(d_maxLoadFactor.loadRelaxed());
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::numStripes() const
+{
+    return d_numStripes;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::size() const
+{
+    const bsls::Types::Int64 numElements = d_numElements.loadRelaxed();
+
+    return numElements > 0 ? static_cast<bsl::size_t>(numElements) : 0;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+int ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::visitReadOnly(
+                                 const ReadOnlyVisitorFunction& visitor) const
+{
+    int               count = 0;
+    EpochManagerGuard epochGuard(&d_epochManager);
+
+    Table *table = d_table.load();
+    for (bsl::size_t i = 0; i < table->numBuckets(); ++i) {
+        if (!visitBucket(table, i, visitor, &count)) {
+            return -count;                                            // RETURN
+        }
+    }
+    return count;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+int ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::visitReadOnly(
+                                  const KEY&                     key,
+                                  const ReadOnlyVisitorFunction& visitor) const
+{
+    const bsl::size_t hash = d_hasher(key);
+    EpochManagerGuard epochGuard(&d_epochManager);
+
+    const Node *node = find(key, hash);
+    if (0 == node) {
+        return 0;                                                     // RETURN
+    }
+    return visitor(node->value(), node->key()) ? 1 : -1;
+}
+
+                               // Aspects
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bslma::Allocator *ConcurrentHashMap<KEY, VALUE, HASH, EQUAL>::allocator() const
+{
+    return d_allocator_p;
+}
+
+}  // close package namespace
+
+namespace bslma {
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+struct UsesBslmaAllocator<bdlcc::ConcurrentHashMap<KEY, VALUE, HASH, EQUAL> >
+    : bsl::true_type {
+};
+
+}  // close namespace bslma
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License.  You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
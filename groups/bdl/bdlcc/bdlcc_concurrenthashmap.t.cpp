@@ -0,0 +1,1567 @@
+// bdlcc_concurrenthashmap.t.cpp                                      -*-C++-*-
+
+#include <bdlcc_concurrenthashmap.h>
+
+#include <bdlcc_stripedunorderedmap.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+#include <bslma_testallocatormonitor.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_semaphore.h>
+#include <bslmt_threadgroup.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_utility.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test defines a fully thread-safe container template,
+// 'bdlcc::ConcurrentHashMap', whose lookups acquire no lock, and which relies
+// on 'bdlcc::EpochManager' for safe memory reclamation.  As for
+// 'bdlcc::StripedUnorderedMap', the container is an *irregular* value-semantic
+// type and the canonical value-semantic test cases do not apply.
+//
+// Single-threaded behavior is tested in test cases [1 .. 11], using a
+// 'bslma::TestAllocator' to verify that all memory comes from the supplied
+// allocator and is returned, and that memory of replaced and removed elements
+// is reclaimed as the map is modified.  Test case 12 verifies that an element
+// referenced by an active reader is not reclaimed, and test case 13 exercises
+// concurrent readers, writers and rehash.
+//
+// Global Concerns:
+//: o All allocations from the intended allocator.
+//: o The default allocator is never used by the container.
+//: o All memory is returned on destruction.
+//: o Rehash is started whenever necessary.
+//: o Exceptions leave the hash map unchanged.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] ConcurrentHashMap(numInitialBuckets, numStripes, *basicAllocator);
+// [ 2] ~ConcurrentHashMap();
+//
+// MANIPULATORS
+// [ 8] void clear();
+// [ 9] void disableRehash();
+// [ 9] void enableRehash();
+// [ 4] bsl::size_t erase(const KEY& key);
+// [ 4] bsl::size_t eraseBulk(RANDOM_ITER first, last);
+// [ 3] bsl::size_t insert(const KEY& key, const VALUE& value);
+// [ 3] bsl::size_t insert(const KEY& key, VALUE&& value);
+// [ 3] bsl::size_t insertBulk(RANDOM_ITER first, last);
+// [ 9] void maxLoadFactor(float newMaxLoadFactor);
+// [ 9] void rehash(bsl::size_t numBuckets);
+// [ 6] int setComputedValue(const KEY& key, visitor);
+// [ 5] bsl::size_t setValue(const KEY& key, const VALUE& value);
+// [ 5] bsl::size_t setValue(const KEY& key, VALUE&& value);
+// [ 6] int update(const KEY& key, const VisitorFunction& visitor);
+// [ 7] int visit(const VisitorFunction& visitor);
+//
+// ACCESSORS
+// [ 2] bsl::size_t bucketCount() const;
+// [ 2] bool empty() const;
+// [ 2] EQUAL equalFunction() const;
+// [ 3] bsl::size_t getValue(VALUE *value, const KEY& key) const;
+// [ 2] HASH hashFunction() const;
+// [ 9] bool isRehashEnabled() const;
+// [ 9] float loadFactor() const;
+// [ 9] float maxLoadFactor() const;
+// [ 2] bsl::size_t numStripes() const;
+// [ 2] bsl::size_t size() const;
+// [ 7] int visitReadOnly(const ReadOnlyVisitorFunction& visitor) const;
+// [ 7] int visitReadOnly(const KEY& key, visitor) const;
+//
+// [ 2] bslma::Allocator *allocator() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [10] EXCEPTION SAFETY
+// [11] MEMORY RECLAMATION
+// [12] ACTIVE READERS DELAY RECLAMATION
+// [13] MULTI-THREADED STRESS TEST
+// [14] USAGE EXAMPLE
+// [-1] READ-MOSTLY PERFORMANCE TEST
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static bool             verbose;
+static bool         veryVerbose;
+static bool     veryVeryVerbose;
+static bool veryVeryVeryVerbose;
+
+typedef bdlcc::ConcurrentHashMap<int, int>         IntMap;
+typedef bdlcc::ConcurrentHashMap<int, bsl::string> StringMap;
+
+// ============================================================================
+//                     GLOBAL HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+namespace u {
+
+bsl::string makeValue(int key, int version)
+    // Return a string, too long for the short string optimization, that
+    // encodes the specified 'key' and 'version'.
+{
+    char buffer[128];
+    bsl::sprintf(buffer,
+                 "key %08d version %08d -- padding to defeat the short "
+                 "string optimization",
+                 key,
+                 version);
+    return buffer;
+}
+
+bool isValueOfKey(const bsl::string& value, int key)
+    // Return 'true' if the specified 'value' was produced by 'makeValue' for
+    // the specified 'key', and 'false' otherwise.
+{
+    int k = -1;
+    int v = -1;
+    return 2 == bsl::sscanf(value.c_str(), "key %d version %d", &k, &v)
+        && k == key
+        && value == makeValue(k, v);
+}
+
+struct IncrementVisitor {
+    // This 'struct' provides a visitor that increments the visited value.
+
+    bool operator()(int *value, const int&) const
+        // Increment the specified 'value' and return 'true'.
+    {
+        ++*value;
+        return true;
+    }
+};
+
+struct StopAtVisitor {
+    // This 'struct' provides a visitor that counts its invocations, and
+    // returns 'false' from the invocation numbered 'd_stopAt'.
+
+    int *d_count_p;
+    int  d_stopAt;
+
+    bool operator()(int *value, const int&) const
+        // Increment the specified 'value' and the count of invocations, and
+        // return 'false' if the count reaches 'd_stopAt'.
+    {
+        ++*value;
+        return ++*d_count_p != d_stopAt;
+    }
+};
+
+struct SumReader {
+    // This 'struct' provides a read-only visitor summing the visited keys and
+    // values.
+
+    bsls::Types::Int64 *d_keySum_p;
+    bsls::Types::Int64 *d_valueSum_p;
+
+    bool operator()(const int& value, const int& key) const
+        // Add the specified 'key' and 'value' to the sums, and return 'true'.
+    {
+        *d_keySum_p   += key;
+        *d_valueSum_p += value;
+        return true;
+    }
+};
+
+struct ThrowingVisitor {
+    // This 'struct' provides a visitor that modifies the visited value, then
+    // throws.
+
+    bool operator()(int *value, const int&) const
+        // Set the specified 'value' to -1 and throw an 'int'.
+    {
+        *value = -1;
+        throw 17;
+    }
+};
+
+}  // close namespace u
+}  // close unnamed namespace
+
+// ============================================================================
+//                       MULTI-THREADED TEST SUPPORT
+// ----------------------------------------------------------------------------
+
+namespace {
+namespace threaded {
+
+enum { k_NUM_KEYS = 1000 };
+
+struct ReaderState {
+    // This 'struct' holds the state shared by the threads of the stress test.
+
+    StringMap        *d_map_p;
+    bsls::AtomicBool  d_done;
+    bsls::AtomicInt   d_numErrors;
+    bsls::AtomicInt64 d_numReads;
+};
+
+struct Reader {
+    // Functor repeatedly looking up random keys and verifying that any value
+    // found is consistent with its key.
+
+    ReaderState *d_state_p;
+    unsigned     d_seed;
+
+    void operator()()
+    {
+        bsl::string        value;
+        unsigned           seed     = d_seed;
+        bsls::Types::Int64 numReads = 0;
+
+        while (!d_state_p->d_done) {
+            seed = seed * 1103515245 + 12345;
+            const int key = static_cast<int>((seed >> 8) % k_NUM_KEYS);
+
+            if (d_state_p->d_map_p->getValue(&value, key)
+             && !u::isValueOfKey(value, key)) {
+                ++d_state_p->d_numErrors;
+            }
+            ++numReads;
+        }
+        d_state_p->d_numReads += numReads;
+    }
+};
+
+struct Writer {
+    // Functor repeatedly inserting, replacing and erasing random keys.
+
+    ReaderState *d_state_p;
+    unsigned     d_seed;
+    int          d_numIterations;
+
+    void operator()()
+    {
+        unsigned seed = d_seed;
+        for (int i = 0; i < d_numIterations; ++i) {
+            seed = seed * 1103515245 + 12345;
+            const int key = static_cast<int>((seed >> 8) % k_NUM_KEYS);
+
+            switch ((seed >> 4) & 3) {
+              case 0: {
+                d_state_p->d_map_p->erase(key);
+              } break;
+              case 1: {
+                d_state_p->d_map_p->insert(key, u::makeValue(key, i));
+              } break;
+              default: {
+                d_state_p->d_map_p->setValue(key, u::makeValue(key, i));
+              } break;
+            }
+        }
+    }
+};
+
+struct Scanner {
+    // Functor repeatedly visiting all elements, verifying their consistency.
+
+    ReaderState *d_state_p;
+
+    struct Check {
+        bsls::AtomicInt *d_numErrors_p;
+
+        bool operator()(const bsl::string& value, const int& key) const
+        {
+            if (!u::isValueOfKey(value, key)) {
+                ++*d_numErrors_p;
+            }
+            return true;
+        }
+    };
+
+    void operator()()
+    {
+        Check check = { &d_state_p->d_numErrors };
+        while (!d_state_p->d_done) {
+            d_state_p->d_map_p->visitReadOnly(check);
+        }
+    }
+};
+
+}  // close namespace threaded
+}  // close unnamed namespace
+
+// ============================================================================
+//                          PERFORMANCE TEST SUPPORT
+// ----------------------------------------------------------------------------
+
+namespace {
+namespace perf {
+
+template <class MAP>
+struct Worker {
+    // Functor performing lookups on, and occasional updates to, a 'MAP'.
+
+    MAP              *d_map_p;
+    int               d_numKeys;
+    int               d_writePerMille;
+    unsigned          d_seed;
+    bslmt::Barrier   *d_barrier_p;
+    bsls::AtomicBool *d_done_p;
+    bsls::AtomicInt64 *d_numOps_p;
+
+    void operator()()
+    {
+        unsigned           seed   = d_seed;
+        bsls::Types::Int64 numOps = 0;
+        int                value  = 0;
+
+        d_barrier_p->wait();
+        while (!*d_done_p) {
+            for (int i = 0; i < 256; ++i) {
+                seed = seed * 1103515245 + 12345;
+                const int key = static_cast<int>((seed >> 8) % d_numKeys);
+                if (static_cast<int>((seed >> 4) % 1000) < d_writePerMille) {
+                    d_map_p->setValue(key, key);
+                }
+                else {
+                    d_map_p->getValue(&value, key);
+                }
+            }
+            numOps += 256;
+        }
+        *d_numOps_p += numOps;
+    }
+};
+
+template <class MAP>
+double run(MAP *map, int numThreads, int numKeys, int writePerMille)
+    // Populate the specified 'map' with the specified 'numKeys' and return the
+    // number of operations per second performed by the specified 'numThreads'
+    // threads, each performing the specified 'writePerMille' writes per
+    // thousand operations.
+{
+    for (int i = 0; i < numKeys; ++i) {
+        map->insert(i, i);
+    }
+
+    bslmt::Barrier    barrier(numThreads + 1);
+    bsls::AtomicBool  done(false);
+    bsls::AtomicInt64 numOps(0);
+
+    bslmt::ThreadGroup group;
+    for (int t = 0; t < numThreads; ++t) {
+        Worker<MAP> worker = { map,
+                               numKeys,
+                               writePerMille,
+                               static_cast<unsigned>(t * 7919 + 1),
+                               &barrier,
+                               &done,
+                               &numOps };
+        group.addThread(worker);
+    }
+
+    barrier.wait();
+    bsls::Stopwatch timer;
+    timer.start();
+    bslmt::ThreadUtil::microSleep(0, 1);
+    done = true;
+    group.joinAll();
+    timer.stop();
+
+    return static_cast<double>(numOps.load()) / timer.elapsedTime();
+}
+
+}  // close namespace perf
+}  // close unnamed namespace
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+namespace usage {
+
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: A Read-Mostly Reference Data Cache
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that many threads of a service look up static reference data (here,
+// the display name of a security identified by an integer) for every request
+// they process, while a single thread occasionally applies updates published
+// by an upstream system.  A 'bdlcc::ConcurrentHashMap' lets the lookups
+// proceed without contending with each other or with the updater.
+//
+// Then, a thread that needs only to inspect the cached value (and not to keep
+// a copy) uses 'visitReadOnly', which gives access to the element in place:
+//..
+    struct LengthReader {
+        bsl::size_t *d_length_p;
+
+        bool operator()(const bsl::string& value, const int&) const
+        {
+            *d_length_p = value.length();
+            return true;
+        }
+    };
+//..
+
+void example1()
+{
+// First, we define the cache type and create an object, 'names', of that type:
+//..
+    typedef bdlcc::ConcurrentHashMap<int, bsl::string> NameCache;
+
+    NameCache names;
+//..
+// Then, the updater thread loads the initial reference data:
+//..
+    names.insert(1001, "IBM US Equity");
+    names.insert(1002, "VOD LN Equity");
+    names.insert(1003, "BMW GR Equity");
+    ASSERT(3 == names.size());
+//..
+// Next, a request-processing thread looks up a name by copying it out of the
+// cache:
+//..
+    bsl::string name;
+    bsl::size_t rc = names.getValue(&name, 1002);
+    ASSERT(1               == rc);
+    ASSERT("VOD LN Equity" == name);
+//..
+// Then, a thread that needs only to inspect the cached value uses
+// 'visitReadOnly':
+//..
+    bsl::size_t  length = 0;
+    LengthReader reader = { &length };
+    int          found  = names.visitReadOnly(1003, reader);
+    ASSERT( 1 == found);
+    ASSERT(13 == length);
+//..
+// Now, the updater replaces a name and removes a delisted security.  Readers
+// running concurrently observe either the old or the new name, but never a
+// partially assigned string:
+//..
+    rc = names.setValue(1001, "IBM UN Equity");
+    ASSERT(1 == rc);
+
+    rc = names.erase(1003);
+    ASSERT(1 == rc);
+    ASSERT(2 == names.size());
+//..
+// Finally, we confirm the new contents of the cache:
+//..
+    rc = names.getValue(&name, 1001);
+    ASSERT(1               == rc);
+    ASSERT("IBM UN Equity" == name);
+
+    rc = names.getValue(&name, 1003);
+    ASSERT(0 == rc);
+//..
+}
+
+}  // close namespace usage
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test            = argc > 1 ? atoi(argv[1]) : 0;
+    verbose             = argc > 2;
+    veryVerbose         = argc > 3;
+    veryVeryVerbose     = argc > 4;
+    veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator         defaultAllocator("default",
+                                                  veryVeryVeryVerbose);
+    bslma::DefaultAllocatorGuard defaultAllocatorGuard(&defaultAllocator);
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 14: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        usage::example1();
+      } break;
+      case 13: {
+        // --------------------------------------------------------------------
+        // MULTI-THREADED STRESS TEST
+        //
+        // Concerns:
+        //: 1 Readers running concurrently with writers never observe a
+        //:   partially constructed or destroyed value.
+        //:
+        //: 2 Rehashing concurrently with readers and writers loses no
+        //:   element.
+        //:
+        //: 3 All memory is returned when the map is destroyed.
+        //
+        // Plan:
+        //: 1 Run reader threads performing 'getValue', a scanner thread
+        //:   performing 'visitReadOnly', and writer threads inserting,
+        //:   replacing and erasing elements whose values encode their keys,
+        //:   starting with a single bucket so that rehash occurs repeatedly.
+        //:   Readers verify every value they observe.  (C-1..2)
+        //:
+        //: 2 Verify that the size of the map matches the number of elements
+        //:   visited, and that all memory is returned.  (C-2..3)
+        //
+        // Testing:
+        //   MULTI-THREADED STRESS TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MULTI-THREADED STRESS TEST" << endl
+                          << "==========================" << endl;
+
+        enum {
+            k_NUM_READERS    = 6,
+            k_NUM_WRITERS    = 4,
+            k_NUM_ITERATIONS = 40000
+        };
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            StringMap mX(1, 4, &ta);
+
+            threaded::ReaderState state;
+            state.d_map_p = &mX;
+            state.d_done  = false;
+
+            bslmt::ThreadGroup readers(&ta);
+            for (int i = 0; i < k_NUM_READERS; ++i) {
+                threaded::Reader reader = { &state,
+                                            static_cast<unsigned>(i + 1) };
+                readers.addThread(reader);
+            }
+            threaded::Scanner scanner = { &state };
+            readers.addThread(scanner);
+
+            bslmt::ThreadGroup writers(&ta);
+            for (int i = 0; i < k_NUM_WRITERS; ++i) {
+                threaded::Writer writer = { &state,
+                                            static_cast<unsigned>(i + 101),
+                                            k_NUM_ITERATIONS };
+                writers.addThread(writer);
+            }
+
+            writers.joinAll();
+            state.d_done = true;
+            readers.joinAll();
+
+            if (verbose) {
+                P_(state.d_numReads) P_(mX.size()) P(mX.bucketCount());
+            }
+
+            ASSERTV(state.d_numErrors, 0 == state.d_numErrors);
+            ASSERT(0 < state.d_numReads);
+            ASSERT(1 < mX.bucketCount());
+
+            bsls::Types::Int64 numVisited = 0;
+            for (int key = 0; key < threaded::k_NUM_KEYS; ++key) {
+                bsl::string value;
+                if (mX.getValue(&value, key)) {
+                    ASSERTV(key, u::isValueOfKey(value, key));
+                    ++numVisited;
+                }
+            }
+            ASSERTV(numVisited, mX.size(),
+                    numVisited == static_cast<bsls::Types::Int64>(mX.size()));
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 12: {
+        // --------------------------------------------------------------------
+        // ACTIVE READERS DELAY RECLAMATION
+        //
+        // Concerns:
+        //: 1 An element being examined by a reader is not destroyed, however
+        //:   many elements are retired meanwhile.
+        //:
+        //: 2 Once the reader completes, the retired elements are reclaimed.
+        //
+        // Plan:
+        //: 1 In a separate thread, invoke 'visitReadOnly' for a key with a
+        //:   visitor that blocks on a semaphore.  While it blocks, replace the
+        //:   value of that key many times.  Then release the visitor and have
+        //:   it verify the value it references (the test allocator scribbles
+        //:   over deallocated memory).  (C-1)
+        //:
+        //: 2 Perform further modifications and verify that the number of
+        //:   blocks in use returns to a small bound.  (C-2)
+        //
+        // Testing:
+        //   ACTIVE READERS DELAY RECLAMATION
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "ACTIVE READERS DELAY RECLAMATION" << endl
+                          << "================================" << endl;
+
+        struct BlockingReader {
+            bslmt::Semaphore *d_started_p;
+            bslmt::Semaphore *d_go_p;
+            bool             *d_valid_p;
+
+            bool operator()(const bsl::string& value, const int& key) const
+            {
+                d_started_p->post();
+                d_go_p->wait();
+                *d_valid_p = u::isValueOfKey(value, key)
+                          && value == u::makeValue(key, 0);
+                return true;
+            }
+        };
+
+        struct ReaderThread {
+            StringMap      *d_map_p;
+            BlockingReader  d_reader;
+
+            void operator()()
+            {
+                d_map_p->visitReadOnly(7, d_reader);
+            }
+        };
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            StringMap mX(16, 1, &ta);
+            mX.insert(7, u::makeValue(7, 0));
+
+            bslmt::Semaphore started;
+            bslmt::Semaphore go;
+            bool             valid = false;
+
+            ReaderThread        thread = { &mX, { &started, &go, &valid } };
+            bslmt::ThreadGroup  group(&ta);
+            group.addThread(thread);
+
+            started.wait();
+            for (int i = 1; i <= 5000; ++i) {
+                mX.setValue(7, u::makeValue(7, i));
+            }
+            go.post();
+            group.joinAll();
+
+            ASSERT(valid);
+
+            for (int i = 1; i <= 5000; ++i) {
+                mX.setValue(7, u::makeValue(7, i));
+            }
+            if (veryVerbose) P(ta.numBlocksInUse());
+            ASSERTV(ta.numBlocksInUse(), ta.numBlocksInUse() < 1000);
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 11: {
+        // --------------------------------------------------------------------
+        // MEMORY RECLAMATION
+        //
+        // Concerns:
+        //: 1 The memory of replaced and erased elements is reclaimed while the
+        //:   map is in use, so that memory in use stays bounded.
+        //
+        // Plan:
+        //: 1 Repeatedly replace, erase and re-insert the elements of a map,
+        //:   and verify that the number of blocks in use remains below a bound
+        //:   independent of the number of operations.  (C-1)
+        //
+        // Testing:
+        //   MEMORY RECLAMATION
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MEMORY RECLAMATION" << endl
+                          << "==================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            StringMap mX(64, 4, &ta);
+            for (int i = 0; i < 64; ++i) {
+                mX.insert(i, u::makeValue(i, 0));
+            }
+
+            bsls::Types::Int64 maxInUse = 0;
+            for (int round = 1; round <= 200; ++round) {
+                for (int i = 0; i < 64; ++i) {
+                    mX.setValue(i, u::makeValue(i, round));
+                }
+                for (int i = 0; i < 64; i += 2) {
+                    mX.erase(i);
+                    mX.insert(i, u::makeValue(i, round));
+                }
+                if (ta.numBlocksInUse() > maxInUse) {
+                    maxInUse = ta.numBlocksInUse();
+                }
+            }
+            if (veryVerbose) P(maxInUse);
+            ASSERTV(maxInUse, maxInUse < 2000);
+            ASSERT(64 == mX.size());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 10: {
+        // --------------------------------------------------------------------
+        // EXCEPTION SAFETY
+        //
+        // Concerns:
+        //: 1 An exception thrown by the allocator during 'insert', 'setValue',
+        //:   'update', 'setComputedValue' or a rehash leaves the map with its
+        //:   prior contents, and leaks no memory.
+        //:
+        //: 2 An exception thrown by a visitor leaves the map unchanged.
+        //:
+        //: 3 A rehash interrupted by an exception is completed by a later
+        //:   rehash.
+        //
+        // Plan:
+        //: 1 Use the standard 'bslma' exception-test macros to perform each
+        //:   operation on a map holding values too long for the short string
+        //:   optimization, and verify the contents afterwards.  (C-1, 3)
+        //:
+        //: 2 Invoke 'update' and 'setComputedValue' with a throwing visitor.
+        //:   (C-2)
+        //
+        // Testing:
+        //   EXCEPTION SAFETY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "EXCEPTION SAFETY" << endl
+                          << "================" << endl;
+
+#ifdef BDE_BUILD_TARGET_EXC
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        if (verbose) cout << "\tInsertion and rehash." << endl;
+        {
+            StringMap mX(1, 1, &ta);  const StringMap& X = mX;
+
+            for (int i = 0; i < 40; ++i) {
+                BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(ta) {
+                    mX.insert(i, u::makeValue(i, 0));
+                } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+                ASSERTV(i, X.size(), static_cast<bsl::size_t>(i + 1) ==
+                                                                    X.size());
+                for (int j = 0; j <= i; ++j) {
+                    bsl::string value;
+                    ASSERTV(i, j, 1 == X.getValue(&value, j));
+                    ASSERTV(i, j, u::makeValue(j, 0) == value);
+                }
+            }
+            ASSERT(X.loadFactor() <= X.maxLoadFactor());
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(ta) {
+                mX.rehash(1024);
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+            ASSERTV(X.bucketCount(), 1024 == X.bucketCount());
+            for (int j = 0; j < 40; ++j) {
+                bsl::string value;
+                ASSERTV(j, 1 == X.getValue(&value, j));
+                ASSERTV(j, u::makeValue(j, 0) == value);
+            }
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tReplacement." << endl;
+        {
+            StringMap mX(16, 4, &ta);  const StringMap& X = mX;
+            for (int i = 0; i < 8; ++i) {
+                mX.insert(i, u::makeValue(i, 0));
+            }
+
+            for (int i = 0; i < 8; ++i) {
+                BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(ta) {
+                    bsl::string value;
+                    ASSERT(1 == X.getValue(&value, i));
+                    ASSERTV(i, u::makeValue(i, 0) == value
+                            || u::makeValue(i, 1) == value);
+                    mX.setValue(i, u::makeValue(i, 1));
+                } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+            }
+            ASSERT(8 == X.size());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tThrowing visitor." << endl;
+        {
+            IntMap mX(16, 4, &ta);  const IntMap& X = mX;
+            mX.insert(1, 10);
+
+            try {
+                mX.update(1, u::ThrowingVisitor());
+                ASSERT(false);
+            }
+            catch (int) {
+            }
+            int value = 0;
+            ASSERT(1  == X.getValue(&value, 1));
+            ASSERT(10 == value);
+
+            try {
+                mX.setComputedValue(2, u::ThrowingVisitor());
+                ASSERT(false);
+            }
+            catch (int) {
+            }
+            ASSERT(0 == X.getValue(&value, 2));
+            ASSERT(1 == X.size());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+#else
+        if (verbose) cout << "\tSkipped: exceptions are disabled." << endl;
+#endif
+      } break;
+      case 9: {
+        // --------------------------------------------------------------------
+        // REHASH
+        //
+        // Concerns:
+        //: 1 Inserting elements beyond the maximum load factor increases the
+        //:   number of buckets, if rehash is enabled.
+        //:
+        //: 2 'rehash' rounds up to a power of 2, and is a no-op if rehash is
+        //:   disabled or the number of buckets would not increase.
+        //:
+        //: 3 'maxLoadFactor' sets the maximum load factor, and rehashes if it
+        //:   is exceeded.
+        //:
+        //: 4 No element is lost or duplicated by a rehash.
+        //
+        // Plan:
+        //: 1 Perform the operations and verify the bucket count, the load
+        //:   factor, and the contents of the map, including by visiting all
+        //:   elements.  (C-1..4)
+        //
+        // Testing:
+        //   void disableRehash();
+        //   void enableRehash();
+        //   void maxLoadFactor(float newMaxLoadFactor);
+        //   void rehash(bsl::size_t numBuckets);
+        //   bool isRehashEnabled() const;
+        //   float loadFactor() const;
+        //   float maxLoadFactor() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "REHASH" << endl
+                          << "======" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            IntMap mX(4, 2, &ta);  const IntMap& X = mX;
+
+            ASSERT(true == X.isRehashEnabled());
+            ASSERT(1.0f == X.maxLoadFactor());
+            ASSERT(4    == X.bucketCount());
+
+            for (int i = 0; i < 100; ++i) {
+                mX.insert(i, i);
+                ASSERTV(i, X.loadFactor() <= X.maxLoadFactor());
+            }
+            ASSERTV(X.bucketCount(), 128 == X.bucketCount());
+
+            mX.disableRehash();
+            ASSERT(false == X.isRehashEnabled());
+            for (int i = 100; i < 300; ++i) {
+                mX.insert(i, i);
+            }
+            ASSERT(128 == X.bucketCount());
+            mX.rehash(1000);
+            ASSERT(128 == X.bucketCount());
+
+            mX.enableRehash();
+            ASSERT(true == X.isRehashEnabled());
+            mX.rehash(1000);
+            ASSERTV(X.bucketCount(), 1024 == X.bucketCount());
+            mX.rehash(10);
+            ASSERT(1024 == X.bucketCount());
+
+            mX.maxLoadFactor(0.25f);
+            ASSERT(0.25f == X.maxLoadFactor());
+            ASSERTV(X.bucketCount(), 2048 == X.bucketCount());
+            ASSERT(X.loadFactor() <= X.maxLoadFactor());
+
+            bsls::Types::Int64 keySum   = 0;
+            bsls::Types::Int64 valueSum = 0;
+            u::SumReader       reader   = { &keySum, &valueSum };
+            ASSERT(300 == X.visitReadOnly(reader));
+            ASSERT(299 * 300 / 2 == keySum);
+            ASSERT(299 * 300 / 2 == valueSum);
+            ASSERT(300 == X.size());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            IntMap mX(4, 2, &ta);
+
+            ASSERT_PASS(mX.maxLoadFactor(0.5f));
+            ASSERT_FAIL(mX.maxLoadFactor(0.0f));
+        }
+      } break;
+      case 8: {
+        // --------------------------------------------------------------------
+        // 'clear'
+        //
+        // Concerns:
+        //: 1 'clear' removes all elements and reclaims their memory, without
+        //:   changing the number of buckets.
+        //:
+        //: 2 The map is usable after 'clear'.
+        //
+        // Plan:
+        //: 1 Populate a map, clear it, and verify its state and the memory in
+        //:   use.  Repopulate it.  (C-1..2)
+        //
+        // Testing:
+        //   void clear();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'clear'" << endl
+                          << "=======" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            StringMap mX(16, 4, &ta);  const StringMap& X = mX;
+
+            bslma::TestAllocatorMonitor tam(&ta);
+
+            for (int i = 0; i < 100; ++i) {
+                mX.insert(i, u::makeValue(i, 0));
+            }
+            const bsl::size_t numBuckets = X.bucketCount();
+
+            mX.clear();
+            ASSERT(0          == X.size());
+            ASSERT(true       == X.empty());
+            ASSERT(numBuckets == X.bucketCount());
+
+            bsl::string value;
+            for (int i = 0; i < 100; ++i) {
+                ASSERTV(i, 0 == X.getValue(&value, i));
+            }
+
+            mX.insert(5, u::makeValue(5, 1));
+            ASSERT(1 == X.size());
+            ASSERT(1 == X.getValue(&value, 5));
+            ASSERT(u::makeValue(5, 1) == value);
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // 'visit' AND 'visitReadOnly'
+        //
+        // Concerns:
+        //: 1 'visit' invokes the visitor on every element, publishing the
+        //:   modified values, and returns the number of elements visited.
+        //:
+        //: 2 'visit' stops when the visitor returns 'false', and returns the
+        //:   negated number of elements visited.
+        //:
+        //: 3 'visitReadOnly' presents every element, and stops when the
+        //:   visitor returns 'false'.
+        //:
+        //: 4 'visitReadOnly' for a key presents the element having the key,
+        //:   if any.
+        //
+        // Plan:
+        //: 1 Visit a populated map and check the results.  (C-1..4)
+        //
+        // Testing:
+        //   int visit(const VisitorFunction& visitor);
+        //   int visitReadOnly(const ReadOnlyVisitorFunction& visitor) const;
+        //   int visitReadOnly(const KEY& key, visitor) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'visit' AND 'visitReadOnly'" << endl
+                          << "===========================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            IntMap mX(16, 4, &ta);  const IntMap& X = mX;
+
+            ASSERT(0 == mX.visit(u::IncrementVisitor()));
+
+            for (int i = 0; i < 50; ++i) {
+                mX.insert(i, 100 * i);
+            }
+
+            ASSERT(50 == mX.visit(u::IncrementVisitor()));
+            for (int i = 0; i < 50; ++i) {
+                int value = 0;
+                ASSERT(1 == X.getValue(&value, i));
+                ASSERTV(i, value, 100 * i + 1 == value);
+            }
+
+            int              count   = 0;
+            u::StopAtVisitor stopper = { &count, 10 };
+            ASSERT(-10 == mX.visit(stopper));
+
+            bsls::Types::Int64 keySum   = 0;
+            bsls::Types::Int64 valueSum = 0;
+            u::SumReader       reader   = { &keySum, &valueSum };
+            ASSERT(50 == X.visitReadOnly(reader));
+            ASSERT(49 * 50 / 2            == keySum);
+            ASSERT(100 * 49 * 50 / 2 + 60 == valueSum);
+
+            keySum   = 0;
+            valueSum = 0;
+            ASSERT(1   == X.visitReadOnly(7, reader));
+            ASSERT(7   == keySum);
+            ASSERTV(valueSum, 701 == valueSum || 702 == valueSum);
+            ASSERT(0   == X.visitReadOnly(70, reader));
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // 'update' AND 'setComputedValue'
+        //
+        // Concerns:
+        //: 1 'update' applies the visitor to the value of an existing key and
+        //:   returns 1, returns -1 if the visitor returns 'false', and returns
+        //:   0 for a missing key.
+        //:
+        //: 2 'setComputedValue' applies the visitor to the value of an
+        //:   existing key, or to a default-constructed value that it inserts.
+        //
+        // Plan:
+        //: 1 Invoke the methods and verify the results.  (C-1..2)
+        //
+        // Testing:
+        //   int setComputedValue(const KEY& key, visitor);
+        //   int update(const KEY& key, const VisitorFunction& visitor);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'update' AND 'setComputedValue'" << endl
+                          << "===============================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            IntMap mX(16, 4, &ta);  const IntMap& X = mX;
+
+            int value = 0;
+
+            ASSERT(0 == mX.update(1, u::IncrementVisitor()));
+            ASSERT(0 == X.size());
+
+            ASSERT(0 == mX.setComputedValue(1, u::IncrementVisitor()));
+            ASSERT(1 == X.size());
+            ASSERT(1 == X.getValue(&value, 1));
+            ASSERT(1 == value);
+
+            ASSERT(1 == mX.setComputedValue(1, u::IncrementVisitor()));
+            ASSERT(1 == X.getValue(&value, 1));
+            ASSERT(2 == value);
+
+            ASSERT(1 == mX.update(1, u::IncrementVisitor()));
+            ASSERT(1 == X.getValue(&value, 1));
+            ASSERT(3 == value);
+
+            int              count   = 0;
+            u::StopAtVisitor stopper = { &count, 1 };
+            ASSERT(-1 == mX.update(1, stopper));
+            ASSERT(1  == X.getValue(&value, 1));
+            ASSERT(4  == value);
+
+            count = 0;
+            ASSERT(-1 == mX.setComputedValue(1, stopper));
+            ASSERT(1  == X.getValue(&value, 1));
+            ASSERT(5  == value);
+            ASSERT(1  == X.size());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // 'setValue'
+        //
+        // Concerns:
+        //: 1 'setValue' replaces the value of an existing key and returns 1,
+        //:   or inserts the element and returns 0.
+        //:
+        //: 2 The movable overload leaves the source in a valid state.
+        //
+        // Plan:
+        //: 1 Invoke both overloads and verify the results.  (C-1..2)
+        //
+        // Testing:
+        //   bsl::size_t setValue(const KEY& key, const VALUE& value);
+        //   bsl::size_t setValue(const KEY& key, VALUE&& value);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'setValue'" << endl
+                          << "==========" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            StringMap mX(16, 4, &ta);  const StringMap& X = mX;
+
+            bsl::string value;
+
+            ASSERT(0 == mX.setValue(1, u::makeValue(1, 0)));
+            ASSERT(1 == X.size());
+            ASSERT(1 == mX.setValue(1, u::makeValue(1, 1)));
+            ASSERT(1 == X.size());
+            ASSERT(1 == X.getValue(&value, 1));
+            ASSERT(u::makeValue(1, 1) == value);
+
+            bsl::string source = u::makeValue(1, 2);
+            ASSERT(1 == mX.setValue(1, bslmf::MovableRefUtil::move(source)));
+            ASSERT(1 == X.getValue(&value, 1));
+            ASSERT(u::makeValue(1, 2) == value);
+
+            source = u::makeValue(2, 0);
+            ASSERT(0 == mX.setValue(2, bslmf::MovableRefUtil::move(source)));
+            ASSERT(2 == X.size());
+            ASSERT(1 == X.getValue(&value, 2));
+            ASSERT(u::makeValue(2, 0) == value);
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // 'erase' AND 'eraseBulk'
+        //
+        // Concerns:
+        //: 1 'erase' removes the element having the key and returns 1, or
+        //:   returns 0 if there is no such element.
+        //:
+        //: 2 'eraseBulk' returns the number of elements removed.
+        //:
+        //: 3 Elements in the same bucket as an erased element are unaffected.
+        //
+        // Plan:
+        //: 1 Using a map having a single bucket (so that all elements collide)
+        //:   and rehash disabled, erase elements at the head, middle and tail
+        //:   of the chain, and verify the remaining elements.  (C-1..3)
+        //
+        // Testing:
+        //   bsl::size_t erase(const KEY& key);
+        //   bsl::size_t eraseBulk(RANDOM_ITER first, last);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'erase' AND 'eraseBulk'" << endl
+                          << "=======================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            IntMap mX(1, 1, &ta);  const IntMap& X = mX;
+            mX.disableRehash();
+
+            for (int i = 0; i < 10; ++i) {
+                mX.insert(i, i);
+            }
+            ASSERT(1 == X.bucketCount());
+
+            ASSERT(1 == mX.erase(0));  // tail of the chain
+            ASSERT(1 == mX.erase(9));  // head of the chain
+            ASSERT(1 == mX.erase(5));
+            ASSERT(0 == mX.erase(5));
+            ASSERT(7 == X.size());
+
+            for (int i = 0; i < 10; ++i) {
+                int value = -1;
+                const bsl::size_t expected = 0 == i || 5 == i || 9 == i
+                                           ? 0
+                                           : 1;
+                ASSERTV(i, expected == X.getValue(&value, i));
+                if (expected) {
+                    ASSERTV(i, i == value);
+                }
+            }
+
+            bsl::vector<int> keys;
+            keys.push_back(1);
+            keys.push_back(2);
+            keys.push_back(5);
+            keys.push_back(42);
+            ASSERT(2 == mX.eraseBulk(keys.begin(), keys.end()));
+            ASSERT(5 == X.size());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'insert', 'insertBulk' AND 'getValue'
+        //
+        // Concerns:
+        //: 1 'insert' adds an element for a new key and returns 1, and
+        //:   replaces the value for an existing key and returns 0.
+        //:
+        //: 2 'getValue' finds exactly the inserted keys.
+        //:
+        //: 3 The movable overload of 'insert' inserts the value.
+        //:
+        //: 4 'insertBulk' returns the number of elements inserted.
+        //:
+        //: 5 All memory comes from the supplied allocator.
+        //
+        // Plan:
+        //: 1 Insert elements, verifying the return values, the size, and the
+        //:   values obtained with 'getValue'.  (C-1..4)
+        //:
+        //: 2 Verify that the default allocator is not used.  (C-5)
+        //
+        // Testing:
+        //   bsl::size_t insert(const KEY& key, const VALUE& value);
+        //   bsl::size_t insert(const KEY& key, VALUE&& value);
+        //   bsl::size_t insertBulk(RANDOM_ITER first, last);
+        //   bsl::size_t getValue(VALUE *value, const KEY& key) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'insert', 'insertBulk' AND 'getValue'" << endl
+                          << "=====================================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            StringMap mX(16, 4, &ta);  const StringMap& X = mX;
+
+            bsl::vector<bsl::string> values(&ta);
+            for (int i = 0; i < 100; ++i) {
+                values.push_back(u::makeValue(i, 0));
+            }
+
+            bslma::TestAllocatorMonitor dam(&defaultAllocator);
+
+            for (int i = 0; i < 100; ++i) {
+                ASSERTV(i, 1 == mX.insert(i, values[i]));
+                ASSERTV(i, static_cast<bsl::size_t>(i + 1) == X.size());
+            }
+            ASSERT(dam.isTotalSame());
+
+            for (int i = 0; i < 100; ++i) {
+                ASSERTV(i, 0 == mX.insert(i, u::makeValue(i, 1)));
+            }
+            ASSERT(100 == X.size());
+
+            bsl::string value(&ta);
+            for (int i = -10; i < 110; ++i) {
+                const bsl::size_t expected = 0 <= i && i < 100 ? 1 : 0;
+                ASSERTV(i, expected == X.getValue(&value, i));
+                if (expected) {
+                    ASSERTV(i, u::makeValue(i, 1) == value);
+                }
+            }
+
+            bsl::string source = u::makeValue(200, 0);
+            ASSERT(1 == mX.insert(200, bslmf::MovableRefUtil::move(source)));
+            ASSERT(1 == X.getValue(&value, 200));
+            ASSERT(u::makeValue(200, 0) == value);
+
+            typedef StringMap::KVType KV;
+            bsl::vector<KV> data;
+            data.push_back(KV(300, u::makeValue(300, 0)));
+            data.push_back(KV(301, u::makeValue(301, 0)));
+            data.push_back(KV(200, u::makeValue(200, 1)));
+            ASSERT(2 == mX.insertBulk(data.begin(), data.end()));
+            ASSERT(103 == X.size());
+            ASSERT(1 == X.getValue(&value, 200));
+            ASSERT(u::makeValue(200, 1) == value);
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 The number of buckets and stripes are rounded up to powers of 2,
+        //:   and the number of buckets is at least the number of stripes.
+        //:
+        //: 2 The allocator is installed, and defaults to the default
+        //:   allocator.
+        //:
+        //: 3 A new map is empty, and all memory is returned on destruction.
+        //
+        // Plan:
+        //: 1 Create maps with various arguments and verify their attributes.
+        //:   (C-1..3)
+        //
+        // Testing:
+        //   ConcurrentHashMap(numInitialBuckets, numStripes, *basicAllocator);
+        //   ~ConcurrentHashMap();
+        //   bsl::size_t bucketCount() const;
+        //   bool empty() const;
+        //   EQUAL equalFunction() const;
+        //   HASH hashFunction() const;
+        //   bsl::size_t numStripes() const;
+        //   bsl::size_t size() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS AND BASIC ACCESSORS" << endl
+                          << "============================" << endl;
+
+        static const struct {
+            int         d_line;
+            bsl::size_t d_numBuckets;
+            bsl::size_t d_numStripes;
+            bsl::size_t d_expBuckets;
+            bsl::size_t d_expStripes;
+        } DATA[] = {
+            //LINE  BUCKETS  STRIPES  EXP_B  EXP_S
+            //----  -------  -------  -----  -----
+            { L_,         0,       0,     1,     1 },
+            { L_,         1,       1,     1,     1 },
+            { L_,         3,       1,     4,     1 },
+            { L_,        16,      16,    16,    16 },
+            { L_,         4,      16,    16,    16 },
+            { L_,       100,       5,   128,     8 },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int LINE = DATA[ti].d_line;
+            {
+                IntMap mX(DATA[ti].d_numBuckets, DATA[ti].d_numStripes, &ta);
+                const IntMap& X = mX;
+
+                ASSERTV(LINE, DATA[ti].d_expBuckets == X.bucketCount());
+                ASSERTV(LINE, DATA[ti].d_expStripes == X.numStripes());
+                ASSERTV(LINE, &ta  == X.allocator());
+                ASSERTV(LINE, 0    == X.size());
+                ASSERTV(LINE, true == X.empty());
+                ASSERTV(LINE, 0 < ta.numBlocksInUse());
+            }
+            ASSERTV(LINE, 0 == ta.numBlocksInUse());
+        }
+
+        {
+            IntMap mX;  const IntMap& X = mX;
+
+            ASSERT(&defaultAllocator == X.allocator());
+            ASSERT(IntMap::k_DEFAULT_NUM_BUCKETS == X.bucketCount());
+            ASSERT(IntMap::k_DEFAULT_NUM_STRIPES == X.numStripes());
+            ASSERT(X.hashFunction()(3) == bsl::hash<int>()(3));
+            ASSERT(X.equalFunction()(3, 3));
+            ASSERT(!X.equalFunction()(3, 4));
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+        ASSERT(bslma::UsesBslmaAllocator<IntMap>::value);
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Insert, look up, update and erase a few elements.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            IntMap mX(16, 4, &ta);  const IntMap& X = mX;
+
+            ASSERT(0 == X.size());
+            ASSERT(1 == mX.insert(1, 10));
+            ASSERT(1 == mX.insert(2, 20));
+            ASSERT(2 == X.size());
+
+            int value = 0;
+            ASSERT(1  == X.getValue(&value, 1));
+            ASSERT(10 == value);
+            ASSERT(0  == X.getValue(&value, 3));
+
+            ASSERT(1  == mX.setValue(1, 11));
+            ASSERT(1  == X.getValue(&value, 1));
+            ASSERT(11 == value);
+
+            ASSERT(1 == mX.erase(1));
+            ASSERT(0 == X.getValue(&value, 1));
+            ASSERT(1 == X.size());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // READ-MOSTLY PERFORMANCE TEST
+        //   Compare the throughput of 'bdlcc::ConcurrentHashMap' and
+        //   'bdlcc::StripedUnorderedMap' under a read-mostly load.
+        //
+        //   2nd parameter: number of threads (default 8)
+        //   3rd parameter: writes per thousand operations (default 10)
+        //   4th parameter: number of keys (default 10000)
+        //
+        // Testing:
+        //   READ-MOSTLY PERFORMANCE TEST
+        // --------------------------------------------------------------------
+
+        const int numThreads = argc > 2 ? atoi(argv[2]) : 8;
+        const int writes     = argc > 3 ? atoi(argv[3]) : 10;
+        const int numKeys    = argc > 4 ? atoi(argv[4]) : 10000;
+
+        cout << "READ-MOSTLY PERFORMANCE TEST" << endl
+             << "============================" << endl;
+        P_(numThreads) P_(writes) P(numKeys);
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            bdlcc::StripedUnorderedMap<int, int> striped(numKeys, 64, &ta);
+            const double rate = perf::run(&striped,
+                                          numThreads,
+                                          numKeys,
+                                          writes);
+            printf("StripedUnorderedMap: %12.0f ops/s\n", rate);
+        }
+        {
+            IntMap concurrent(numKeys, 64, &ta);
+            const double rate = perf::run(&concurrent,
+                                          numThreads,
+                                          numKeys,
+                                          writes);
+            printf("ConcurrentHashMap:   %12.0f ops/s\n", rate);
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    ASSERTV(globalAllocator.numBlocksTotal(),
+            0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License.  You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+// ----------------------------------------------------------------------------
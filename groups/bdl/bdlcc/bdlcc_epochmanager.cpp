@@ -0,0 +1,511 @@
+// bdlcc_epochmanager.cpp                                             -*-C++-*-
+#include <bdlcc_epochmanager.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlcc_epochmanager_cpp,"$Id$ $CSID$")
+
+///IMPLEMENTATION NOTES
+///--------------------
+// Consider an object retired at epoch 'r', i.e., unlinked before the retiring
+// thread loaded 'd_epoch' and observed 'r'.  'tryAdvance' moves the epoch from
+// 'e' to 'e + 1' only after loading 'e' and then observing that no record
+// holds a state of a critical section entered at an epoch other than 'e'.  The
+// advance from 'r + 1' to 'r + 2' therefore observed every thread that was
+// within a critical section at the time the object was unlinked either to be
+// outside of any critical section, or to have recorded epoch 'r + 1'.  A
+// thread records epoch 'r + 1' only after loading it from 'd_epoch', which
+// (the total order of sequentially consistent operations being consistent
+// with the order in which 'd_epoch' is modified) follows the retiring
+// thread's load of 'r', and hence the unlinking of the object; such a thread
+// cannot reach the object.  Hence the object may be destroyed once the epoch
+// reaches 'r + 2'.
+//
+// A thread entering a critical section re-reads the epoch after publishing its
+// state, and republishes its state if the epoch has changed meanwhile, so
+// that a thread delayed between its two operations does not hold back the
+// advance of the epoch for the whole of its critical section.
+//
+// Each thread keeps a small direct-mapped cache, referenced by a single
+// process-wide thread-specific key, mapping the unique identifiers of epoch
+// managers to the records of the thread.  Using unique identifiers rather
+// than addresses makes the stale entries of destroyed epoch managers harmless,
+// and using one key for all epoch managers avoids exhausting the limited
+// number of thread-specific keys available to a process.  The caches are
+// allocated using the new-delete allocator, since they outlive any epoch
+// manager.
+
+#include <bslma_newdeleteallocator.h>
+
+#include <bslmt_lockguard.h>
+#include <bslmt_once.h>
+#include <bslmt_threadutil.h>
+
+#include <bsl_algorithm.h>
+
+namespace BloombergLP {
+namespace {
+
+enum { k_CACHE_SIZE = 16 };  // number of entries in a thread's cache
+
+struct ThreadCacheEntry {
+    // An entry of the cache of the records of a thread.
+
+    bsls::Types::Uint64               d_managerId;  // 0 if unused
+    bdlcc::EpochManager_ThreadRecord *d_record_p;
+};
+
+struct ThreadCache {
+    // The cache of the records of a thread, indexed by the low bits of the
+    // identifier of an epoch manager.
+
+    ThreadCacheEntry d_entries[k_CACHE_SIZE];
+};
+
+bsls::AtomicUint64     s_nextManagerId(1);  // identifier of the next manager
+bslmt::ThreadUtil::Key s_cacheKey;          // key of the thread caches
+
+}  // close unnamed namespace
+}  // close enterprise namespace
+
+extern "C" {
+
+static void bdlcc_EpochManager_deleteThreadCache(void *cache)
+    // Deallocate the specified thread 'cache'.
+{
+    BloombergLP::bslma::NewDeleteAllocator::singleton().deallocate(cache);
+}
+
+}  // extern "C"
+
+namespace BloombergLP {
+namespace {
+
+ThreadCacheEntry *cacheEntry(bsls::Types::Uint64 managerId, bool create)
+    // Return the entry of the cache of the calling thread for the epoch
+    // manager having the specified 'managerId'.  If the calling thread has no
+    // cache, create it if the specified 'create' is 'true', and otherwise
+    // return 0.
+{
+    ThreadCache *cache = static_cast<ThreadCache *>(
+                                bslmt::ThreadUtil::getSpecific(s_cacheKey));
+    if (0 == cache) {
+        if (!create) {
+            return 0;                                                 // RETURN
+        }
+
+        bslma::Allocator *allocator = &bslma::NewDeleteAllocator::singleton();
+
+        cache = static_cast<ThreadCache *>(
+                                      allocator->allocate(sizeof *cache));
+        for (int i = 0; i < k_CACHE_SIZE; ++i) {
+            cache->d_entries[i].d_managerId = 0;
+            cache->d_entries[i].d_record_p  = 0;
+        }
+
+        if (0 != bslmt::ThreadUtil::setSpecific(s_cacheKey, cache)) {
+            allocator->deallocate(cache);
+            return 0;                                                 // RETURN
+        }
+    }
+    return cache->d_entries + (managerId & (k_CACHE_SIZE - 1));
+}
+
+}  // close unnamed namespace
+
+namespace bdlcc {
+
+                     // ---------------------------------
+                     // struct EpochManager_ThreadRecord
+                     // ---------------------------------
+
+// CREATORS
+EpochManager_ThreadRecord::EpochManager_ThreadRecord(
+                                              bslma::Allocator *basicAllocator)
+: d_state(0)
+, d_inUse(false)
+, d_owner(0)
+, d_nesting(0)
+, d_retired(basicAllocator)
+, d_next_p(0)
+{
+}
+
+                            // ------------------
+                            // class EpochManager
+                            // ------------------
+
+// PRIVATE CLASS METHODS
+bool EpochManager::isReclaimable(bsls::Types::Uint64 retireEpoch,
+                                 bsls::Types::Uint64 currentEpoch)
+{
+    return currentEpoch >= retireEpoch + 2;
+}
+
+// PRIVATE MANIPULATORS
+EpochManager::Record *EpochManager::acquireRecord()
+{
+    Record *record = findRecord();
+    if (record) {
+        return record;                                                // RETURN
+    }
+
+    const bsls::Types::Uint64 self = bslmt::ThreadUtil::selfIdAsUint64();
+
+    // Reuse a record that is not in use, if any.
+
+    for (Record *r = d_records.load(); r; r = r->d_next_p) {
+        if (!r->d_inUse.load() && !r->d_inUse.testAndSwap(false, true)) {
+            record = r;
+            break;
+        }
+    }
+
+    if (0 == record) {
+        record = new (*d_allocator_p) Record(d_allocator_p);
+        record->d_inUse = true;
+
+        Record *head = d_records.load();
+        for (;;) {
+            record->d_next_p = head;
+
+            Record *previous = d_records.testAndSwap(head, record);
+            if (previous == head) {
+                break;
+            }
+            head = previous;
+        }
+    }
+
+    record->d_owner = self;
+    ++d_numRegisteredThreads;
+
+    ThreadCacheEntry *entry = cacheEntry(d_id, true);
+    if (entry) {
+        entry->d_managerId = d_id;
+        entry->d_record_p  = record;
+    }
+    return record;
+}
+
+void EpochManager::reclaimList(bsl::vector<Entry> *list)
+{
+    const bsls::Types::Uint64 epoch = d_epoch.load();
+
+    // The objects retired by a thread are tagged with non-decreasing epochs,
+    // hence the objects that can be destroyed form a prefix of 'list'.
+
+    bsl::size_t numReclaimed = 0;
+    while (numReclaimed < list->size()
+        && isReclaimable((*list)[numReclaimed].d_epoch, epoch)) {
+        const Entry& entry = (*list)[numReclaimed];
+        entry.d_deleter(entry.d_object_p, entry.d_context_p);
+        ++numReclaimed;
+    }
+
+    if (numReclaimed) {
+        list->erase(list->begin(), list->begin() + numReclaimed);
+        d_numRetired.add(-static_cast<bsls::Types::Int64>(numReclaimed));
+    }
+}
+
+void EpochManager::reclaimOrphans(bool wait)
+{
+    if (wait) {
+        d_orphansMutex.lock();
+    }
+    else if (0 != d_orphansMutex.tryLock()) {
+        return;                                                       // RETURN
+    }
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_orphansMutex, true);
+
+    // The orphans handed over by different threads are not ordered by epoch,
+    // so the whole list is examined.
+
+    const bsls::Types::Uint64 epoch = d_epoch.load();
+
+    bsl::size_t numKept = 0;
+    for (bsl::size_t i = 0; i < d_orphans.size(); ++i) {
+        const Entry& entry = d_orphans[i];
+        if (isReclaimable(entry.d_epoch, epoch)) {
+            entry.d_deleter(entry.d_object_p, entry.d_context_p);
+        }
+        else {
+            d_orphans[numKept++] = entry;
+        }
+    }
+
+    const bsl::size_t numReclaimed = d_orphans.size() - numKept;
+    if (numReclaimed) {
+        d_orphans.erase(d_orphans.begin() + numKept, d_orphans.end());
+        d_numRetired.add(-static_cast<bsls::Types::Int64>(numReclaimed));
+    }
+}
+
+// PRIVATE ACCESSORS
+EpochManager::Record *EpochManager::findRecord() const
+{
+    ThreadCacheEntry *entry = cacheEntry(d_id, false);
+    if (entry && d_id == entry->d_managerId) {
+        return entry->d_record_p;                                     // RETURN
+    }
+
+    // The record of the calling thread, if any, was evicted from its cache
+    // (or the thread had no cache).
+
+    const bsls::Types::Uint64 self = bslmt::ThreadUtil::selfIdAsUint64();
+
+    for (Record *r = d_records.load(); r; r = r->d_next_p) {
+        if (self == r->d_owner.load() && r->d_inUse.load()) {
+            entry = cacheEntry(d_id, true);
+            if (entry) {
+                entry->d_managerId = d_id;
+                entry->d_record_p  = r;
+            }
+            return r;                                                 // RETURN
+        }
+    }
+    return 0;
+}
+
+// CREATORS
+EpochManager::EpochManager(bslma::Allocator *basicAllocator)
+: d_epoch(0)
+, d_records(0)
+, d_id(s_nextManagerId.add(1) - 1)
+, d_numRegisteredThreads(0)
+, d_numRetired(0)
+, d_orphans(basicAllocator)
+, d_orphansMutex()
+, d_reclaimThreshold(k_DEFAULT_RECLAIM_THRESHOLD)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLMT_ONCE_DO {
+        int rc = bslmt::ThreadUtil::createKey(
+                                        &s_cacheKey,
+                                        &bdlcc_EpochManager_deleteThreadCache);
+        BSLS_ASSERT_OPT(0 == rc);  (void)rc;
+    }
+}
+
+EpochManager::EpochManager(int reclaimThreshold,
+                           bslma::Allocator *basicAllocator)
+: d_epoch(0)
+, d_records(0)
+, d_id(s_nextManagerId.add(1) - 1)
+, d_numRegisteredThreads(0)
+, d_numRetired(0)
+, d_orphans(basicAllocator)
+, d_orphansMutex()
+, d_reclaimThreshold(reclaimThreshold)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 < reclaimThreshold);
+
+    BSLMT_ONCE_DO {
+        int rc = bslmt::ThreadUtil::createKey(
+                                        &s_cacheKey,
+                                        &bdlcc_EpochManager_deleteThreadCache);
+        BSLS_ASSERT_OPT(0 == rc);  (void)rc;
+    }
+}
+
+EpochManager::~EpochManager()
+{
+    Record *record = d_records.load();
+    while (record) {
+        BSLS_ASSERT(0 == record->d_state.load());
+
+        Record *next = record->d_next_p;
+        for (bsl::size_t i = 0; i < record->d_retired.size(); ++i) {
+            const Entry& entry = record->d_retired[i];
+            entry.d_deleter(entry.d_object_p, entry.d_context_p);
+        }
+        d_allocator_p->deleteObject(record);
+        record = next;
+    }
+
+    for (bsl::size_t i = 0; i < d_orphans.size(); ++i) {
+        d_orphans[i].d_deleter(d_orphans[i].d_object_p,
+                               d_orphans[i].d_context_p);
+    }
+}
+
+// MANIPULATORS
+void EpochManager::deregisterThread()
+{
+    Record *record = findRecord();
+    if (0 == record) {
+        return;                                                       // RETURN
+    }
+
+    BSLS_ASSERT(0 == record->d_nesting);
+
+    tryAdvance();
+    reclaimList(&record->d_retired);
+
+    if (!record->d_retired.empty()) {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_orphansMutex);
+
+        d_orphans.insert(d_orphans.end(),
+                         record->d_retired.begin(),
+                         record->d_retired.end());
+        record->d_retired.clear();
+    }
+
+    ThreadCacheEntry *entry = cacheEntry(d_id, false);
+    if (entry && d_id == entry->d_managerId) {
+        entry->d_managerId = 0;
+        entry->d_record_p  = 0;
+    }
+
+    record->d_owner = 0;
+    --d_numRegisteredThreads;
+    record->d_inUse = false;
+}
+
+void EpochManager::enter()
+{
+    Record *record = acquireRecord();
+
+    if (0 == record->d_nesting++) {
+        bsls::Types::Uint64 epoch = d_epoch.load();
+        for (;;) {
+            record->d_state.swap(2 * epoch + 1);
+
+            const bsls::Types::Uint64 current = d_epoch.load();
+            if (current == epoch) {
+                break;
+            }
+            epoch = current;
+        }
+    }
+}
+
+void EpochManager::leave()
+{
+    Record *record = findRecord();
+
+    BSLS_ASSERT(record);
+    BSLS_ASSERT(0 < record->d_nesting);
+
+    if (0 == --record->d_nesting) {
+        record->d_state.store(0);
+    }
+}
+
+void EpochManager::reclaim()
+{
+    tryAdvance();
+
+    Record *record = findRecord();
+    if (record) {
+        reclaimList(&record->d_retired);
+    }
+    reclaimOrphans(false);
+}
+
+void EpochManager::registerThread()
+{
+    acquireRecord();
+}
+
+void EpochManager::reserve(bsl::size_t numObjects)
+{
+    Record *record = acquireRecord();
+
+    // Grow geometrically, so that reserving before each retirement does not
+    // reallocate the list each time.
+
+    const bsl::size_t required = record->d_retired.size() + numObjects;
+    if (required > record->d_retired.capacity()) {
+        record->d_retired.reserve(bsl::max(required,
+                                           2 * record->d_retired.capacity()));
+    }
+}
+
+void EpochManager::retire(void *object, Deleter deleter, void *context)
+{
+    BSLS_ASSERT(deleter);
+
+    Record *record = acquireRecord();
+
+    const Entry entry = { object, deleter, context, d_epoch.load() };
+    record->d_retired.push_back(entry);
+    ++d_numRetired;
+
+    // Attempt reclamation each time another 'd_reclaimThreshold' objects have
+    // accumulated, so that a thread staying long in a critical section does
+    // not make every subsequent retirement scan all records.
+
+    const bsl::size_t size = record->d_retired.size();
+    if (0 == size % d_reclaimThreshold) {
+        tryAdvance();
+        reclaimList(&record->d_retired);
+    }
+}
+
+void EpochManager::synchronize()
+{
+    BSLS_ASSERT(!isInCriticalSection());
+
+    const bsls::Types::Uint64 target = d_epoch.load() + 2;
+
+    while (d_epoch.load() < target) {
+        if (!tryAdvance()) {
+            bslmt::ThreadUtil::yield();
+        }
+    }
+
+    Record *record = findRecord();
+    if (record) {
+        reclaimList(&record->d_retired);
+    }
+    reclaimOrphans(true);
+}
+
+bool EpochManager::tryAdvance()
+{
+    const bsls::Types::Uint64 epoch = d_epoch.load();
+    const bsls::Types::Uint64 state = 2 * epoch + 1;
+
+    for (Record *r = d_records.load(); r; r = r->d_next_p) {
+        const bsls::Types::Uint64 s = r->d_state.load();
+        if (0 != s && state != s) {
+            return false;                                             // RETURN
+        }
+    }
+
+    d_epoch.testAndSwap(epoch, epoch + 1);
+    return true;
+}
+
+// ACCESSORS
+bool EpochManager::isInCriticalSection() const
+{
+    const Record *record = findRecord();
+    return record && 0 < record->d_nesting;
+}
+
+bool EpochManager::isRegistered() const
+{
+    return 0 != findRecord();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License.  You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,584 @@
+// bdlcc_epochmanager.h                                               -*-C++-*-
+#ifndef INCLUDED_BDLCC_EPOCHMANAGER
+#define INCLUDED_BDLCC_EPOCHMANAGER
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide epoch-based reclamation of memory shared between threads.
+//
+//@CLASSES:
+//  bdlcc::EpochManager: registry of threads and deferred-destruction lists
+//  bdlcc::EpochManagerGuard: scoped critical section of an 'EpochManager'
+//
+//@SEE_ALSO: bdlcc_concurrenthashmap
+//
+//@DESCRIPTION: This component provides a mechanism, 'bdlcc::EpochManager',
+// that solves the *safe memory reclamation* problem of lock-free data
+// structures: once a node has been unlinked from such a structure, it cannot
+// be destroyed immediately, because other threads may have obtained its
+// address before it was unlinked and may still be examining it.  Instead of
+// protecting every access with a lock or a reference count (each of which
+// costs an atomic read-modify-write operation on memory shared with all other
+// accessing threads), a thread accessing the data structure brackets that
+// access in a *critical* *section* of an epoch manager, and a thread that
+// unlinks a node *retires* it, supplying a function that destroys it.  The
+// epoch manager invokes that function once every thread that could have
+// obtained the address of the node has left its critical section.
+//
+// A critical section is entered and left using 'enter' and 'leave', or for
+// the lifetime of a 'bdlcc::EpochManagerGuard' object.  Critical sections may
+// be nested; the calling thread leaves its critical section when the outermost
+// section ends.  Entering and leaving a critical section touches only memory
+// private to the calling thread (together with one read of the global epoch),
+// so that concurrent readers do not contend with each other.
+//
+///Thread Registration
+///-------------------
+// Each thread accessing an epoch manager is represented by a record, allocated
+// from the manager's allocator, that holds the state of the thread's critical
+// section and the list of objects retired by that thread.  A thread is
+// registered automatically the first time it enters a critical section or
+// retires an object, and can be registered explicitly (e.g., to move the
+// allocation of its record out of a latency-sensitive path) using
+// 'registerThread'.  A thread should call 'deregisterThread' before it exits;
+// its pending retired objects are then handed to the manager, and its record
+// is made available to threads registering later.  The record of a thread
+// that exits without calling 'deregisterThread' is retained (without
+// hindering reclamation) until it is reused by a thread that is assigned the
+// same thread id, or until the epoch manager is destroyed.
+//
+///Epochs and Reclamation
+///----------------------
+// The epoch manager maintains a global epoch number.  A thread entering its
+// critical section records the current epoch in its record, and each retired
+// object is tagged with the epoch current when it was retired.  The epoch can
+// advance from 'e' to 'e + 1' only when every thread within a critical
+// section has recorded epoch 'e'; hence, once the epoch has advanced twice
+// since an object was retired, every thread that was within a critical section
+// at the time of retirement has left it, and the object can be destroyed.
+//
+// Reclamation is batched: each thread accumulates the objects it retires in a
+// private list, and once the length of that list reaches the
+// 'reclaimThreshold' supplied at construction, the retiring thread attempts to
+// advance the epoch and destroys those of its objects that have become safe
+// to destroy.  'reclaim' performs the same step on demand, and 'synchronize'
+// waits for all objects retired before it was called to become safe to
+// destroy.  All objects still pending are destroyed by the destructor of the
+// epoch manager.
+//
+// An object is destroyed by invoking the function supplied to 'retire', with
+// the context argument supplied along with it.  'retireObject' provides the
+// common case of an object that is to be destroyed and deallocated using a
+// 'bslma::Allocator', which is used as the context argument.
+//
+///Memory Ordering
+///---------------
+// 'enter' executes a sequentially consistent read-modify-write operation on
+// the record of the calling thread, and every other operation on the global
+// epoch and on the thread records is sequentially consistent.  A data
+// structure using an epoch manager must unlink a node (using a sequentially
+// consistent store or read-modify-write operation) before retiring it, and
+// its readers must load the links of the structure with sequentially
+// consistent loads (the default for 'bsls::AtomicPointer::load').
+//
+///Thread Safety
+///-------------
+// 'bdlcc::EpochManager' is fully thread-safe, meaning any operation can be
+// called on the same object from multiple threads.  The behavior is undefined
+// if 'synchronize' or 'deregisterThread' is called by a thread within a
+// critical section of the same epoch manager.  The destructor must not be
+// called while any thread is within a critical section of the epoch manager.
+// The allocator supplied at construction must be thread-safe.
+//
+// Note that each thread caches the location of its records for the epoch
+// managers it used most recently; a thread alternating between many epoch
+// managers incurs a search of the manager's list of records on a cache miss.
+//
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: Publishing a Configuration Without Locks
+///- - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that many threads of a service consult a configuration object on
+// every request, while the configuration is occasionally replaced by a
+// control thread.  The request threads should neither lock a mutex nor update
+// a reference count to read the configuration.
+//
+// First, we define the configuration type, and a class holding the current
+// configuration behind an atomic pointer, together with an epoch manager:
+//..
+//  struct Config {
+//      int d_timeout;
+//      int d_maxConnections;
+//  };
+//
+//  class ConfigHolder {
+//      // This class holds the current configuration of a service.
+//
+//      // DATA
+//      bsls::AtomicPointer<Config>  d_config;
+//      mutable bdlcc::EpochManager  d_epochManager;
+//      bslma::Allocator            *d_allocator_p;
+//
+//    public:
+//      // CREATORS
+//      explicit ConfigHolder(const Config&     initial,
+//                            bslma::Allocator *basicAllocator = 0)
+//      : d_config(0)
+//      , d_epochManager(basicAllocator)
+//      , d_allocator_p(bslma::Default::allocator(basicAllocator))
+//      {
+//          d_config = new (*d_allocator_p) Config(initial);
+//      }
+//
+//      ~ConfigHolder()
+//      {
+//          d_allocator_p->deleteObject(d_config.load());
+//      }
+//..
+// Then, we replace the configuration by publishing a new object and retiring
+// the object it replaces:
+//..
+//      // MANIPULATORS
+//      void update(const Config& config)
+//      {
+//          Config *newConfig = new (*d_allocator_p) Config(config);
+//          Config *oldConfig = d_config.swap(newConfig);
+//          d_epochManager.retireObject(oldConfig, d_allocator_p);
+//      }
+//..
+// Next, we read the configuration within a critical section, during which the
+// object referenced cannot be destroyed:
+//..
+//      // ACCESSORS
+//      int timeout() const
+//      {
+//          bdlcc::EpochManagerGuard guard(&d_epochManager);
+//          return d_config.load()->d_timeout;
+//      }
+//  };
+//..
+// Now, we create a holder and a few threads reading the configuration, while
+// the main thread updates it:
+//..
+//  Config       initial = { 30, 100 };
+//  ConfigHolder holder(initial);
+//
+//  // ... start threads calling 'holder.timeout()' ...
+//
+//  for (int i = 0; i < 1000; ++i) {
+//      Config config = { 30 + i % 7, 100 };
+//      holder.update(config);
+//  }
+//..
+// Finally, note that the replaced configurations are destroyed in batches as
+// the control thread retires them, once no reader can be examining them.
+
+#include <bdlscm_version.h>
+
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+#include <bslma_deleterhelper.h>
+
+#include <bslmt_mutex.h>
+#include <bslmt_platform.h>
+
+#include <bsls_assert.h>
+#include <bsls_atomic.h>
+#include <bsls_types.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace bdlcc {
+
+                     // =================================
+                     // struct EpochManager_ThreadRecord
+                     // =================================
+
+struct EpochManager_ThreadRecord {
+    // This 'struct' holds the state of a thread registered with an
+    // 'EpochManager'.  Only 'd_state', 'd_inUse', 'd_owner' and 'd_next_p'
+    // are accessed by threads other than the owner of the record.
+
+    // TYPES
+    typedef void (*Deleter)(void *object, void *context);
+
+    struct Entry {
+        // An object awaiting destruction.
+
+        void                *d_object_p;   // retired object
+        Deleter              d_deleter;    // function destroying the object
+        void                *d_context_p;  // argument to 'd_deleter'
+        bsls::Types::Uint64  d_epoch;      // epoch at retirement
+    };
+
+    // DATA
+    bsls::AtomicUint64         d_state;     // '2 * epoch + 1' within a
+                                            // critical section, and 0
+                                            // otherwise
+
+    char                       d_pad[bslmt::Platform::e_CACHE_LINE_SIZE -
+                                     sizeof(bsls::AtomicUint64)];
+                                            // isolates 'd_state'
+
+    bsls::AtomicBool           d_inUse;     // 'true' while owned by a thread
+
+    bsls::AtomicUint64         d_owner;     // 'selfIdAsUint64' of the owner
+
+    int                        d_nesting;   // depth of nested critical
+                                            // sections
+
+    bsl::vector<Entry>         d_retired;   // objects retired by the owner,
+                                            // in non-decreasing epoch order
+
+    EpochManager_ThreadRecord *d_next_p;    // next record (immutable once
+                                            // published)
+
+    // CREATORS
+    explicit EpochManager_ThreadRecord(bslma::Allocator *basicAllocator);
+        // Create a record, not in use, whose retired objects are held in
+        // memory supplied by the specified 'basicAllocator'.
+};
+
+                            // ==================
+                            // class EpochManager
+                            // ==================
+
+class EpochManager {
+    // This class provides a registry of threads accessing a shared data
+    // structure, and defers the destruction of objects unlinked from that
+    // structure until no thread can be accessing them.  This class is fully
+    // thread-safe.
+
+    // PRIVATE TYPES
+    typedef EpochManager_ThreadRecord Record;
+    typedef Record::Entry             Entry;
+
+  public:
+    // TYPES
+    typedef Record::Deleter Deleter;
+        // 'Deleter' is an alias for a function that destroys the specified
+        // 'object' given the specified 'context', having the signature:
+        //..
+        //  void deleter(void *object, void *context);
+        //..
+
+    enum { k_DEFAULT_RECLAIM_THRESHOLD = 64 };
+
+  private:
+    // DATA
+    bsls::AtomicUint64     d_epoch;               // global epoch
+
+    char                   d_pad[bslmt::Platform::e_CACHE_LINE_SIZE -
+                                 sizeof(bsls::AtomicUint64)];
+                                                  // isolates 'd_epoch'
+
+    bsls::AtomicPointer<Record>
+                           d_records;             // list of all records
+
+    bsls::Types::Uint64    d_id;                  // unique identifier of this
+                                                  // manager, used as the key
+                                                  // of per-thread caches
+
+    bsls::AtomicInt        d_numRegisteredThreads;
+                                                  // number of records in use
+
+    bsls::AtomicInt64      d_numRetired;          // number of objects
+                                                  // awaiting destruction
+
+    bsl::vector<Entry>     d_orphans;             // objects retired by
+                                                  // deregistered threads
+
+    bslmt::Mutex           d_orphansMutex;        // guards 'd_orphans'
+
+    int                    d_reclaimThreshold;    // length of a thread's list
+                                                  // of retired objects
+                                                  // triggering reclamation
+
+    bslma::Allocator      *d_allocator_p;         // memory allocator (held,
+                                                  // not owned)
+
+    // NOT IMPLEMENTED
+    EpochManager(const EpochManager&);
+    EpochManager& operator=(const EpochManager&);
+
+    // PRIVATE CLASS METHODS
+    template <class TYPE>
+    static void deleteObject(void *object, void *allocator);
+        // Destroy the specified 'object' of (template parameter) 'TYPE', and
+        // return its memory to the specified 'allocator'.
+
+    static bool isReclaimable(bsls::Types::Uint64 retireEpoch,
+                              bsls::Types::Uint64 currentEpoch);
+        // Return 'true' if an object retired at the specified 'retireEpoch'
+        // can be destroyed now that the epoch is the specified
+        // 'currentEpoch', and 'false' otherwise.
+
+    // PRIVATE MANIPULATORS
+    Record *acquireRecord();
+        // Return the record of the calling thread, registering the thread if
+        // necessary.
+
+    void reclaimList(bsl::vector<Entry> *list);
+        // Destroy the objects in the specified 'list' that can be destroyed at
+        // the current epoch, and remove them from 'list'.  The behavior is
+        // undefined unless the objects in 'list' are in the order in which
+        // they were retired.
+
+    void reclaimOrphans(bool wait);
+        // Destroy the objects retired by deregistered threads that can be
+        // destroyed at the current epoch.  If the specified 'wait' is 'false',
+        // return immediately if another thread is reclaiming those objects.
+
+    // PRIVATE ACCESSORS
+    Record *findRecord() const;
+        // Return the record of the calling thread, or 0 if the calling thread
+        // is not registered.
+
+  public:
+    // CREATORS
+    explicit EpochManager(bslma::Allocator *basicAllocator = 0);
+    explicit EpochManager(int               reclaimThreshold,
+                          bslma::Allocator *basicAllocator = 0);
+        // Create an epoch manager having no registered threads.  Optionally
+        // specify a 'reclaimThreshold', the number of objects retired by a
+        // thread that triggers an attempt to destroy them; if
+        // 'reclaimThreshold' is not specified, 'k_DEFAULT_RECLAIM_THRESHOLD'
+        // is used.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  The behavior is undefined unless
+        // '0 < reclaimThreshold'.
+
+    ~EpochManager();
+        // Destroy all objects awaiting destruction, and destroy this object.
+        // The behavior is undefined if any thread is within a critical section
+        // of this epoch manager.
+
+    // MANIPULATORS
+    void deregisterThread();
+        // Deregister the calling thread from this epoch manager, handing over
+        // the objects it retired that are still awaiting destruction.  This
+        // method has no effect if the calling thread is not registered.  The
+        // behavior is undefined if the calling thread is within a critical
+        // section of this epoch manager.
+
+    void enter();
+        // Enter a critical section of this epoch manager, registering the
+        // calling thread if necessary.  Until the matching call to 'leave',
+        // no object retired after this call is destroyed.  Critical sections
+        // may be nested.
+
+    void leave();
+        // Leave the critical section entered by the matching call to 'enter'.
+        // The behavior is undefined unless the calling thread is within a
+        // critical section of this epoch manager.
+
+    void reclaim();
+        // Attempt to advance the epoch, and destroy the objects retired by the
+        // calling thread, or by deregistered threads, that can be destroyed.
+        // Note that this method never blocks waiting for other threads to
+        // leave their critical sections.
+
+    void registerThread();
+        // Register the calling thread with this epoch manager.  This method
+        // has no effect if the calling thread is already registered.
+
+    void reserve(bsl::size_t numObjects);
+        // Ensure that the next specified 'numObjects' calls to 'retire' (or
+        // 'retireObject') by the calling thread do not allocate memory,
+        // registering the calling thread if necessary.  Note that a data
+        // structure providing the strong exception guarantee can call this
+        // method before unlinking an object, so that retiring the object
+        // cannot fail.
+
+    void retire(void *object, Deleter deleter, void *context = 0);
+        // Arrange for the specified 'deleter' to be invoked with the specified
+        // 'object' and the optionally specified 'context' once no thread can
+        // be accessing 'object', registering the calling thread if
+        // necessary.  If the number of objects retired by the calling thread
+        // and not yet destroyed reaches 'reclaimThreshold()', attempt to
+        // destroy them (see 'reclaim').  'object' must have been made
+        // unreachable to threads entering a critical section after this call.
+        // If an exception is thrown, 'object' is not retired.  The behavior is
+        // undefined if 'deleter' invokes any method of this epoch manager.
+
+    template <class TYPE>
+    void retireObject(TYPE *object, bslma::Allocator *allocator = 0);
+        // Arrange for the specified 'object' to be destroyed and its memory
+        // returned to the optionally specified 'allocator' once no thread can
+        // be accessing 'object'.  If 'allocator' is 0, the allocator of this
+        // epoch manager is used.  See 'retire'.
+
+    void synchronize();
+        // Block until every object retired before this call can be destroyed,
+        // then destroy the objects retired by the calling thread, or by
+        // deregistered threads, that can be destroyed.  The behavior is
+        // undefined if the calling thread is within a critical section of
+        // this epoch manager.
+
+    bool tryAdvance();
+        // Attempt to advance the epoch of this manager.  Return 'true' if the
+        // epoch was advanced (possibly by another thread), and 'false' if a
+        // thread within a critical section has not yet observed the current
+        // epoch.
+
+    // ACCESSORS
+    bsls::Types::Uint64 epoch() const;
+        // Return the current epoch of this manager.
+
+    bool isInCriticalSection() const;
+        // Return 'true' if the calling thread is within a critical section of
+        // this epoch manager, and 'false' otherwise.
+
+    bool isRegistered() const;
+        // Return 'true' if the calling thread is registered with this epoch
+        // manager, and 'false' otherwise.
+
+    int numRegisteredThreads() const;
+        // Return the number of threads currently registered with this epoch
+        // manager.
+
+    bsls::Types::Int64 numRetired() const;
+        // Return the number of retired objects that have not yet been
+        // destroyed.
+
+    int reclaimThreshold() const;
+        // Return the number of objects retired by a thread that triggers an
+        // attempt to destroy them.
+
+                               // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this epoch manager to supply memory.
+};
+
+                          // =======================
+                          // class EpochManagerGuard
+                          // =======================
+
+class EpochManagerGuard {
+    // This class implements a guard keeping the calling thread within a
+    // critical section of an 'EpochManager' for its lifetime.
+
+    // DATA
+    EpochManager *d_manager_p;  // guarded epoch manager
+
+    // NOT IMPLEMENTED
+    EpochManagerGuard(const EpochManagerGuard&);
+    EpochManagerGuard& operator=(const EpochManagerGuard&);
+
+  public:
+    // CREATORS
+    explicit EpochManagerGuard(EpochManager *manager);
+        // Create a guard object that enters a critical section of the
+        // specified 'manager'.
+
+    ~EpochManagerGuard();
+        // Leave the critical section of the guarded epoch manager and destroy
+        // this object.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                            // ------------------
+                            // class EpochManager
+                            // ------------------
+
+// PRIVATE CLASS METHODS
+template <class TYPE>
+void EpochManager::deleteObject(void *object, void *allocator)
+{
+    bslma::DeleterHelper::deleteObject(
+                                   static_cast<TYPE *>(object),
+                                   static_cast<bslma::Allocator *>(allocator));
+}
+
+// MANIPULATORS
+template <class TYPE>
+inline
+void EpochManager::retireObject(TYPE *object, bslma::Allocator *allocator)
+{
+    retire(object,
+           &deleteObject<TYPE>,
+           allocator ? allocator : d_allocator_p);
+}
+
+// ACCESSORS
+inline
+bsls::Types::Uint64 EpochManager::epoch() const
+{
+    return d_epoch.load();
+}
+
+inline
+int EpochManager::numRegisteredThreads() const
+{
+    return d_numRegisteredThreads.load();
+}
+
+inline
+bsls::Types::Int64 EpochManager::numRetired() const
+{
+    return d_numRetired.load();
+}
+
+inline
+int EpochManager::reclaimThreshold() const
+{
+    return d_reclaimThreshold;
+}
+
+                               // Aspects
+
+inline
+bslma::Allocator *EpochManager::allocator() const
+{
+    return d_allocator_p;
+}
+
+                          // -----------------------
+                          // class EpochManagerGuard
+                          // -----------------------
+
+// CREATORS
+inline
+EpochManagerGuard::EpochManagerGuard(EpochManager *manager)
+: d_manager_p(manager)
+{
+    BSLS_ASSERT(manager);
+
+    d_manager_p->enter();
+}
+
+inline
+EpochManagerGuard::~EpochManagerGuard()
+{
+    d_manager_p->leave();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License.  You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1220 @@
+// bdlcc_epochmanager.t.cpp                                           -*-C++-*-
+
+#include <bdlcc_epochmanager.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatormonitor.h>
+
+#include <bslmt_semaphore.h>
+#include <bslmt_threadgroup.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test provides a mechanism, 'bdlcc::EpochManager', that
+// defers the destruction of retired objects until no thread within a critical
+// section can be accessing them, and a guard, 'bdlcc::EpochManagerGuard'.
+//
+// We first verify thread registration and the tracking of critical sections
+// in a single thread, then use helper threads held within critical sections
+// (synchronized with semaphores) to verify that the epoch does not advance,
+// and retired objects are not destroyed, while such a thread could be
+// accessing them.  Finally, a stress test has reader threads examine objects
+// published through an atomic pointer while writer threads replace and retire
+// them; the test allocator scribbles over deallocated memory, so that a
+// premature destruction is detected by the readers.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] EpochManager(bslma::Allocator *basicAllocator = 0);
+// [ 2] EpochManager(int reclaimThreshold, bslma::Allocator *ba = 0);
+// [ 5] ~EpochManager();
+//
+// MANIPULATORS
+// [ 3] void deregisterThread();
+// [ 4] void enter();
+// [ 4] void leave();
+// [ 5] void reclaim();
+// [ 3] void registerThread();
+// [ 5] void reserve(bsl::size_t numObjects);
+// [ 5] void retire(void *object, Deleter deleter, void *context = 0);
+// [ 5] void retireObject(TYPE *object, bslma::Allocator *allocator = 0);
+// [ 6] void synchronize();
+// [ 4] bool tryAdvance();
+//
+// ACCESSORS
+// [ 2] bsls::Types::Uint64 epoch() const;
+// [ 4] bool isInCriticalSection() const;
+// [ 3] bool isRegistered() const;
+// [ 3] int numRegisteredThreads() const;
+// [ 5] bsls::Types::Int64 numRetired() const;
+// [ 2] int reclaimThreshold() const;
+// [ 2] bslma::Allocator *allocator() const;
+//
+// EpochManagerGuard
+// [ 4] EpochManagerGuard(EpochManager *manager);
+// [ 4] ~EpochManagerGuard();
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 7] MULTI-THREADED STRESS TEST
+// [ 8] USAGE EXAMPLE
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static bool             verbose;
+static bool         veryVerbose;
+static bool     veryVeryVerbose;
+static bool veryVeryVeryVerbose;
+
+typedef bdlcc::EpochManager      Obj;
+typedef bdlcc::EpochManagerGuard Guard;
+
+// ============================================================================
+//                     GLOBAL HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+namespace u {
+
+void countingDeleter(void *, void *context)
+    // Increment the 'int' addressed by the specified 'context'.
+{
+    ++*static_cast<int *>(context);
+}
+
+struct CountedObject {
+    // This 'struct' provides an object that counts its destructions.
+
+    int *d_numDestroyed_p;
+
+    explicit CountedObject(int *numDestroyed)
+    : d_numDestroyed_p(numDestroyed)
+    {
+    }
+
+    ~CountedObject()
+    {
+        ++*d_numDestroyed_p;
+    }
+};
+
+struct CriticalSectionThread {
+    // Functor entering a critical section of an epoch manager, signaling
+    // 'd_entered_p', and leaving it once 'd_leave_p' is signaled.
+
+    Obj              *d_manager_p;
+    bslmt::Semaphore *d_entered_p;
+    bslmt::Semaphore *d_leave_p;
+
+    void operator()() const
+    {
+        {
+            Guard guard(d_manager_p);
+            d_entered_p->post();
+            d_leave_p->wait();
+        }
+        d_manager_p->deregisterThread();
+    }
+};
+
+struct RegisterThread {
+    // Functor registering with, and optionally deregistering from, an epoch
+    // manager, retiring an object in between.
+
+    Obj  *d_manager_p;
+    bool  d_deregister;
+    int  *d_numDestroyed_p;
+
+    void operator()() const
+    {
+        d_manager_p->registerThread();
+        d_manager_p->retire(0, &countingDeleter, d_numDestroyed_p);
+        if (d_deregister) {
+            d_manager_p->deregisterThread();
+        }
+    }
+};
+
+}  // close namespace u
+}  // close unnamed namespace
+
+// ============================================================================
+//                       MULTI-THREADED TEST SUPPORT
+// ----------------------------------------------------------------------------
+
+namespace {
+namespace threaded {
+
+enum { k_NUM_SLOTS = 4 };
+
+struct Node {
+    // A published object whose fields readers verify.
+
+    int d_key;
+    int d_check;  // '~d_key'
+};
+
+struct State {
+    // This 'struct' holds the state shared by the threads of the stress test.
+
+    Obj                       *d_manager_p;
+    bsls::AtomicPointer<Node>  d_slots[k_NUM_SLOTS];
+    bslma::Allocator          *d_allocator_p;
+    bsls::AtomicBool           d_done;
+    bsls::AtomicInt            d_numErrors;
+    bsls::AtomicInt64          d_numReads;
+};
+
+struct Reader {
+    // Functor repeatedly examining the published nodes within a critical
+    // section.
+
+    State *d_state_p;
+
+    void operator()() const
+    {
+        bsls::Types::Int64 numReads = 0;
+        while (!d_state_p->d_done) {
+            Guard guard(d_state_p->d_manager_p);
+            for (int i = 0; i < k_NUM_SLOTS; ++i) {
+                const Node *node = d_state_p->d_slots[i].load();
+                for (int j = 0; j < 16; ++j) {
+                    if (~node->d_key != node->d_check) {
+                        ++d_state_p->d_numErrors;
+                    }
+                }
+                ++numReads;
+            }
+        }
+        d_state_p->d_numReads += numReads;
+        d_state_p->d_manager_p->deregisterThread();
+    }
+};
+
+struct Writer {
+    // Functor repeatedly replacing the published nodes and retiring the nodes
+    // replaced.
+
+    State *d_state_p;
+    int    d_numIterations;
+    int    d_seed;
+
+    void operator()() const
+    {
+        for (int i = 0; i < d_numIterations; ++i) {
+            Node *node = new (*d_state_p->d_allocator_p) Node;
+            node->d_key   = d_seed + i;
+            node->d_check = ~node->d_key;
+
+            Node *old = d_state_p->d_slots[i % k_NUM_SLOTS].swap(node);
+            d_state_p->d_manager_p->retireObject(old,
+                                                 d_state_p->d_allocator_p);
+        }
+        d_state_p->d_manager_p->deregisterThread();
+    }
+};
+
+}  // close namespace threaded
+}  // close unnamed namespace
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+namespace usage {
+
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: Publishing a Configuration Without Locks
+///- - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that many threads of a service consult a configuration object on
+// every request, while the configuration is occasionally replaced by a
+// control thread.  The request threads should neither lock a mutex nor update
+// a reference count to read the configuration.
+//
+// First, we define the configuration type, and a class holding the current
+// configuration behind an atomic pointer, together with an epoch manager:
+//..
+    struct Config {
+        int d_timeout;
+        int d_maxConnections;
+    };
+
+    class ConfigHolder {
+        // This class holds the current configuration of a service.
+
+        // DATA
+        bsls::AtomicPointer<Config>  d_config;
+        mutable bdlcc::EpochManager  d_epochManager;
+        bslma::Allocator            *d_allocator_p;
+
+      public:
+        // CREATORS
+        explicit ConfigHolder(const Config&     initial,
+                              bslma::Allocator *basicAllocator = 0)
+        : d_config(0)
+        , d_epochManager(basicAllocator)
+        , d_allocator_p(bslma::Default::allocator(basicAllocator))
+        {
+            d_config = new (*d_allocator_p) Config(initial);
+        }
+
+        ~ConfigHolder()
+        {
+            d_allocator_p->deleteObject(d_config.load());
+        }
+//..
+// Then, we replace the configuration by publishing a new object and retiring
+// the object it replaces:
+//..
+        // MANIPULATORS
+        void update(const Config& config)
+        {
+            Config *newConfig = new (*d_allocator_p) Config(config);
+            Config *oldConfig = d_config.swap(newConfig);
+            d_epochManager.retireObject(oldConfig, d_allocator_p);
+        }
+//..
+// Next, we read the configuration within a critical section, during which the
+// object referenced cannot be destroyed:
+//..
+        // ACCESSORS
+        int timeout() const
+        {
+            bdlcc::EpochManagerGuard guard(&d_epochManager);
+            return d_config.load()->d_timeout;
+        }
+    };
+//..
+
+struct TimeoutReader {
+    ConfigHolder     *d_holder_p;
+    bsls::AtomicBool *d_done_p;
+    bsls::AtomicInt  *d_numErrors_p;
+
+    void operator()() const
+    {
+        while (!*d_done_p) {
+            const int timeout = d_holder_p->timeout();
+            if (timeout < 30 || 36 < timeout) {
+                ++*d_numErrors_p;
+            }
+        }
+    }
+};
+
+void example1()
+{
+    bslma::TestAllocator ta;
+    {
+//..
+// Now, we create a holder and a few threads reading the configuration, while
+// the main thread updates it:
+//..
+    Config       initial = { 30, 100 };
+    ConfigHolder holder(initial, &ta);
+//
+//  // ... start threads calling 'holder.timeout()' ...
+//..
+    bsls::AtomicBool   done(false);
+    bsls::AtomicInt    numErrors(0);
+    TimeoutReader      reader = { &holder, &done, &numErrors };
+    bslmt::ThreadGroup group(&ta);
+    group.addThreads(reader, 3);
+//..
+    for (int i = 0; i < 1000; ++i) {
+        Config config = { 30 + i % 7, 100 };
+        holder.update(config);
+    }
+//..
+    done = true;
+    group.joinAll();
+    ASSERT(0 == numErrors);
+    }
+    ASSERT(0 == ta.numBlocksInUse());
+//..
+// Finally, note that the replaced configurations are destroyed in batches as
+// the control thread retires them, once no reader can be examining them.
+}
+
+}  // close namespace usage
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test            = argc > 1 ? atoi(argv[1]) : 0;
+    verbose             = argc > 2;
+    veryVerbose         = argc > 3;
+    veryVeryVerbose     = argc > 4;
+    veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator         defaultAllocator("default",
+                                                  veryVeryVeryVerbose);
+    bslma::DefaultAllocatorGuard defaultAllocatorGuard(&defaultAllocator);
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        usage::example1();
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // MULTI-THREADED STRESS TEST
+        //
+        // Concerns:
+        //: 1 No object is destroyed while a thread within a critical section
+        //:   may be examining it.
+        //:
+        //: 2 Retired objects are eventually destroyed, and all memory is
+        //:   returned.
+        //
+        // Plan:
+        //: 1 Have reader threads repeatedly examine nodes published through
+        //:   atomic pointers, within critical sections, while writer threads
+        //:   replace those nodes and retire the nodes replaced.  The test
+        //:   allocator scribbles over deallocated memory, so that a node
+        //:   destroyed prematurely fails the readers' consistency check.
+        //:   (C-1)
+        //:
+        //: 2 Verify that the number of blocks in use remains bounded, and that
+        //:   all memory is returned on destruction.  (C-2)
+        //
+        // Testing:
+        //   MULTI-THREADED STRESS TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MULTI-THREADED STRESS TEST" << endl
+                          << "==========================" << endl;
+
+        enum {
+            k_NUM_READERS    = 6,
+            k_NUM_WRITERS    = 2,
+            k_NUM_ITERATIONS = 100000
+        };
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        bslma::TestAllocator na("nodes", veryVeryVeryVerbose);
+        {
+            Obj mX(&ta);
+
+            threaded::State state;
+            state.d_manager_p   = &mX;
+            state.d_allocator_p = &na;
+            state.d_done        = false;
+            for (int i = 0; i < threaded::k_NUM_SLOTS; ++i) {
+                threaded::Node *node = new (na) threaded::Node;
+                node->d_key   = i;
+                node->d_check = ~i;
+                state.d_slots[i] = node;
+            }
+
+            bslmt::ThreadGroup readers(&ta);
+            threaded::Reader   reader = { &state };
+            readers.addThreads(reader, k_NUM_READERS);
+
+            bslmt::ThreadGroup writers(&ta);
+            for (int i = 0; i < k_NUM_WRITERS; ++i) {
+                threaded::Writer writer = { &state,
+                                            k_NUM_ITERATIONS,
+                                            i * k_NUM_ITERATIONS };
+                writers.addThread(writer);
+            }
+
+            writers.joinAll();
+            state.d_done = true;
+            readers.joinAll();
+
+            if (verbose) {
+                P_(state.d_numReads) P_(mX.epoch()) P(mX.numRetired());
+            }
+
+            ASSERTV(state.d_numErrors, 0 == state.d_numErrors);
+            ASSERT(0 < mX.epoch());
+            ASSERT(0 == mX.numRegisteredThreads());
+            ASSERTV(na.numBlocksInUse(),
+                    na.numBlocksInUse() < k_NUM_ITERATIONS);
+
+            mX.synchronize();
+            ASSERTV(mX.numRetired(), 0 == mX.numRetired());
+            ASSERTV(na.numBlocksInUse(),
+                    threaded::k_NUM_SLOTS == na.numBlocksInUse());
+
+            for (int i = 0; i < threaded::k_NUM_SLOTS; ++i) {
+                na.deleteObject(state.d_slots[i].load());
+            }
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        ASSERTV(na.numBlocksInUse(), 0 == na.numBlocksInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // 'synchronize' AND ORPHANED OBJECTS
+        //
+        // Concerns:
+        //: 1 'synchronize' waits for threads within critical sections entered
+        //:   before the call, then destroys the objects retired before the
+        //:   call.
+        //:
+        //: 2 The objects retired by a thread that deregisters are destroyed by
+        //:   a subsequent 'synchronize' or 'reclaim' of another thread.
+        //
+        // Plan:
+        //: 1 Retire objects while a helper thread is within a critical
+        //:   section.  Call 'synchronize' from another helper thread, verify
+        //:   that it does not complete until the first helper leaves its
+        //:   critical section.  (C-1)
+        //:
+        //: 2 Have a helper thread retire an object and deregister while a
+        //:   thread is within a critical section, and verify the object is
+        //:   destroyed by 'synchronize' in the main thread.  (C-2)
+        //
+        // Testing:
+        //   void synchronize();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'synchronize' AND ORPHANED OBJECTS" << endl
+                          << "==================================" << endl;
+
+        struct SynchronizeThread {
+            Obj             *d_manager_p;
+            bsls::AtomicBool *d_done_p;
+
+            void operator()() const
+            {
+                d_manager_p->synchronize();
+                *d_done_p = true;
+            }
+        };
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            Obj mX(1000, &ta);  const Obj& X = mX;
+
+            bslmt::Semaphore entered;
+            bslmt::Semaphore leave;
+
+            u::CriticalSectionThread cs = { &mX, &entered, &leave };
+            bslmt::ThreadGroup       group(&ta);
+            group.addThread(cs);
+            entered.wait();
+
+            int numDestroyed = 0;
+            mX.retire(0, &u::countingDeleter, &numDestroyed);
+
+            bsls::AtomicBool  done(false);
+            SynchronizeThread sync = { &mX, &done };
+            group.addThread(sync);
+
+            bslmt::ThreadUtil::microSleep(50000);
+            ASSERT(false == done);
+
+            leave.post();
+            group.joinAll();
+            ASSERT(true == done);
+
+            // The object was retired by the main thread, and can now be
+            // destroyed.
+
+            ASSERT(0 == numDestroyed);
+            mX.synchronize();
+            ASSERT(1 == numDestroyed);
+            ASSERT(0 == X.numRetired());
+
+            // Orphaned objects.
+
+            group.addThread(cs);
+            entered.wait();
+
+            u::RegisterThread rt = { &mX, true, &numDestroyed };
+            group.addThread(rt);
+            bslmt::ThreadUtil::microSleep(20000);
+            ASSERT(1 == numDestroyed);
+            ASSERT(1 == X.numRetired());
+
+            leave.post();
+            group.joinAll();
+
+            mX.synchronize();
+            ASSERT(2 == numDestroyed);
+            ASSERT(0 == X.numRetired());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            Obj mX(&ta);
+
+            ASSERT_PASS(mX.synchronize());
+            {
+                Guard guard(&mX);
+                ASSERT_FAIL(mX.synchronize());
+            }
+        }
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // 'retire', 'retireObject' AND 'reclaim'
+        //
+        // Concerns:
+        //: 1 A retired object is destroyed, by invoking the deleter with the
+        //:   supplied context, once the epoch has advanced twice.
+        //:
+        //: 2 Reclamation is attempted each time the number of objects pending
+        //:   for a thread reaches a multiple of the reclaim threshold.
+        //:
+        //: 3 An object is not destroyed while a thread that entered a critical
+        //:   section before the object was retired remains within it.
+        //:
+        //: 4 'retireObject' destroys the object and deallocates its memory
+        //:   using the specified allocator, or by default the allocator of the
+        //:   epoch manager.
+        //:
+        //: 5 The destructor destroys all pending objects.
+        //:
+        //: 6 'reserve' registers the calling thread, and the reserved number
+        //:   of subsequent retirements do not allocate memory.
+        //
+        // Plan:
+        //: 1 Retire objects using a counting deleter and verify the number of
+        //:   objects destroyed and pending after each operation, with and
+        //:   without a helper thread held within a critical section.
+        //:   (C-1..3, 5)
+        //:
+        //: 2 Retire objects allocated from test allocators.  (C-4..5)
+        //:
+        //: 3 Call 'reserve', then retire the reserved number of objects and
+        //:   verify that the allocator of the epoch manager is not used.
+        //:   (C-6)
+        //
+        // Testing:
+        //   ~EpochManager();
+        //   void reclaim();
+        //   void reserve(bsl::size_t numObjects);
+        //   void retire(void *object, Deleter deleter, void *context = 0);
+        //   void retireObject(TYPE *object, bslma::Allocator *allocator = 0);
+        //   bsls::Types::Int64 numRetired() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'retire', 'retireObject' AND 'reclaim'" << endl
+                          << "======================================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        if (verbose) cout << "\tReclamation at two epochs." << endl;
+        {
+            Obj mX(1000, &ta);  const Obj& X = mX;
+
+            int numDestroyed = 0;
+            mX.retire(0, &u::countingDeleter, &numDestroyed);
+            ASSERT(1 == X.numRetired());
+
+            mX.reclaim();                    // epoch 0 -> 1
+            ASSERT(0 == numDestroyed);
+            ASSERT(1 == X.epoch());
+
+            mX.reclaim();                    // epoch 1 -> 2
+            ASSERT(1 == numDestroyed);
+            ASSERT(0 == X.numRetired());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tBatching." << endl;
+        {
+            Obj mX(8, &ta);  const Obj& X = mX;
+
+            int numDestroyed = 0;
+            for (int i = 1; i <= 7; ++i) {
+                mX.retire(0, &u::countingDeleter, &numDestroyed);
+                ASSERTV(i, 0 == numDestroyed);
+                ASSERTV(i, 0 == X.epoch());
+            }
+
+            mX.retire(0, &u::countingDeleter, &numDestroyed);
+            ASSERT(1 == X.epoch());
+            ASSERT(0 == numDestroyed);
+
+            for (int i = 9; i <= 16; ++i) {
+                mX.retire(0, &u::countingDeleter, &numDestroyed);
+            }
+            ASSERT(2  == X.epoch());
+            ASSERT(8  == numDestroyed);
+            ASSERT(8  == X.numRetired());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tActive critical sections." << endl;
+        {
+            Obj mX(1, &ta);  const Obj& X = mX;
+
+            bslmt::Semaphore entered;
+            bslmt::Semaphore leave;
+
+            u::CriticalSectionThread cs = { &mX, &entered, &leave };
+            bslmt::ThreadGroup       group(&ta);
+            group.addThread(cs);
+            entered.wait();
+
+            int numDestroyed = 0;
+            for (int i = 0; i < 100; ++i) {
+                mX.retire(0, &u::countingDeleter, &numDestroyed);
+                mX.reclaim();
+            }
+            ASSERT(0   == numDestroyed);
+            ASSERT(100 == X.numRetired());
+            ASSERT(1   >= X.epoch());
+
+            leave.post();
+            group.joinAll();
+
+            mX.reclaim();
+            mX.reclaim();
+            ASSERT(100 == numDestroyed);
+            ASSERT(0   == X.numRetired());
+
+            for (int i = 0; i < 10; ++i) {
+                mX.retire(0, &u::countingDeleter, &numDestroyed);
+            }
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\t'retireObject' and destructor." << endl;
+        {
+            bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+            int numDestroyed = 0;
+            {
+                Obj mX(1000, &ta);  const Obj& X = mX;
+
+                mX.retireObject(new (oa) u::CountedObject(&numDestroyed),
+                                &oa);
+                mX.retireObject(new (ta) u::CountedObject(&numDestroyed));
+                ASSERT(2 == X.numRetired());
+                ASSERT(1 == oa.numBlocksInUse());
+                mX.synchronize();
+                ASSERT(2 == numDestroyed);
+                ASSERT(0 == oa.numBlocksInUse());
+
+                mX.retireObject(new (oa) u::CountedObject(&numDestroyed),
+                                &oa);
+                ASSERT(1 == oa.numBlocksInUse());
+            }
+            ASSERT(3 == numDestroyed);
+            ASSERT(0 == oa.numBlocksInUse());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\t'reserve'." << endl;
+        {
+            Obj mX(1000, &ta);  const Obj& X = mX;
+
+            mX.reserve(100);
+            ASSERT(true == X.isRegistered());
+
+            const bsls::Types::Int64 numAllocations = ta.numAllocations();
+
+            int numDestroyed = 0;
+            for (int i = 0; i < 100; ++i) {
+                mX.retire(0, &u::countingDeleter, &numDestroyed);
+            }
+            ASSERTV(ta.numAllocations(), numAllocations,
+                    numAllocations == ta.numAllocations());
+            ASSERT(100 == X.numRetired());
+
+            for (int i = 0; i < 3; ++i) {
+                mX.reserve(1);
+                mX.retire(0, &u::countingDeleter, &numDestroyed);
+            }
+            ASSERT(103 == X.numRetired());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // CRITICAL SECTIONS AND 'tryAdvance'
+        //
+        // Concerns:
+        //: 1 'enter' and 'leave' (and the guard) bracket a critical section,
+        //:   which can be nested.
+        //:
+        //: 2 The epoch advances when no thread is within a critical section,
+        //:   or when all such threads have observed the current epoch.
+        //:
+        //: 3 The epoch does not advance twice while a thread remains within
+        //:   a critical section.
+        //
+        // Plan:
+        //: 1 Enter and leave nested critical sections, and verify
+        //:   'isInCriticalSection'.  (C-1)
+        //:
+        //: 2 Invoke 'tryAdvance' while the main thread or a helper thread is
+        //:   within a critical section.  (C-2..3)
+        //
+        // Testing:
+        //   void enter();
+        //   void leave();
+        //   bool tryAdvance();
+        //   bool isInCriticalSection() const;
+        //   EpochManagerGuard(EpochManager *manager);
+        //   ~EpochManagerGuard();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CRITICAL SECTIONS AND 'tryAdvance'" << endl
+                          << "==================================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERT(false == X.isInCriticalSection());
+            mX.enter();
+            ASSERT(true  == X.isInCriticalSection());
+            ASSERT(true  == X.isRegistered());
+            {
+                Guard guard(&mX);
+                ASSERT(true == X.isInCriticalSection());
+            }
+            ASSERT(true  == X.isInCriticalSection());
+
+            // The calling thread has observed epoch 0.
+
+            ASSERT(true  == mX.tryAdvance());
+            ASSERT(1     == X.epoch());
+            ASSERT(false == mX.tryAdvance());
+            ASSERT(1     == X.epoch());
+
+            mX.leave();
+            ASSERT(false == X.isInCriticalSection());
+            ASSERT(true  == mX.tryAdvance());
+            ASSERT(true  == mX.tryAdvance());
+            ASSERT(3     == X.epoch());
+
+            bslmt::Semaphore entered;
+            bslmt::Semaphore leave;
+
+            u::CriticalSectionThread cs = { &mX, &entered, &leave };
+            bslmt::ThreadGroup       group(&ta);
+            group.addThread(cs);
+            entered.wait();
+
+            ASSERT(true  == mX.tryAdvance());
+            ASSERT(false == mX.tryAdvance());
+            ASSERT(4     == X.epoch());
+
+            {
+                Guard guard(&mX);
+                ASSERT(false == mX.tryAdvance());
+            }
+
+            // The helper thread advances the epoch when it deregisters.
+
+            leave.post();
+            group.joinAll();
+            ASSERT(5     == X.epoch());
+            ASSERT(true  == mX.tryAdvance());
+            ASSERT(6     == X.epoch());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            Obj mX(&ta);
+
+            ASSERT_FAIL(mX.leave());
+            mX.enter();
+            ASSERT_PASS(mX.leave());
+            ASSERT_FAIL(mX.leave());
+
+            ASSERT_FAIL(Guard(0));
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // THREAD REGISTRATION
+        //
+        // Concerns:
+        //: 1 'registerThread' registers the calling thread once, and
+        //:   'deregisterThread' deregisters it.
+        //:
+        //: 2 The record of a deregistered thread is reused.
+        //:
+        //: 3 A thread can be registered with more epoch managers than its
+        //:   cache holds.
+        //:
+        //: 4 'deregisterThread' is a no-op for an unregistered thread, and
+        //:   fails for a thread within a critical section.
+        //
+        // Plan:
+        //: 1 Register and deregister the main thread and helper threads, and
+        //:   verify 'isRegistered', 'numRegisteredThreads', and the number of
+        //:   allocations.  (C-1..2)
+        //:
+        //: 2 Register with 40 epoch managers and verify 'isRegistered' for
+        //:   each.  (C-3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered.  (C-4)
+        //
+        // Testing:
+        //   void deregisterThread();
+        //   void registerThread();
+        //   bool isRegistered() const;
+        //   int numRegisteredThreads() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "THREAD REGISTRATION" << endl
+                          << "===================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        int                  numDestroyed = 0;
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERT(false == X.isRegistered());
+            ASSERT(0     == X.numRegisteredThreads());
+
+            mX.deregisterThread();
+            ASSERT(0     == X.numRegisteredThreads());
+
+            mX.registerThread();
+            ASSERT(true  == X.isRegistered());
+            ASSERT(1     == X.numRegisteredThreads());
+            ASSERT(1     == ta.numBlocksInUse());
+
+            mX.registerThread();
+            ASSERT(1     == X.numRegisteredThreads());
+            ASSERT(1     == ta.numBlocksInUse());
+
+            mX.deregisterThread();
+            ASSERT(false == X.isRegistered());
+            ASSERT(0     == X.numRegisteredThreads());
+            ASSERT(1     == ta.numBlocksInUse());
+
+            // A helper thread reuses the record.
+
+            u::RegisterThread rt = { &mX, true, &numDestroyed };
+            {
+                bslmt::ThreadGroup group;
+                group.addThread(rt);
+                group.joinAll();
+            }
+            ASSERT(0 == X.numRegisteredThreads());
+            ASSERT(1 == X.numRetired());
+
+            bslma::TestAllocatorMonitor tam(&ta);
+            mX.registerThread();
+            ASSERT(tam.isTotalSame());
+            mX.deregisterThread();
+
+            // A helper thread exiting without deregistering keeps its record,
+            // and the objects it retired are destroyed with the epoch
+            // manager.
+
+            rt.d_deregister = false;
+            {
+                bslmt::ThreadGroup group;
+                group.addThread(rt);
+                group.joinAll();
+            }
+            ASSERT(1 == X.numRegisteredThreads());
+            ASSERT(2 == X.numRetired());
+
+            mX.synchronize();
+            ASSERT(1 == numDestroyed);
+            ASSERT(1 == X.numRetired());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        ASSERT(2 == numDestroyed);
+
+        if (verbose) cout << "\tMany epoch managers." << endl;
+        {
+            enum { k_NUM_MANAGERS = 40 };
+
+            bsl::vector<Obj *> managers(&ta);
+            for (int i = 0; i < k_NUM_MANAGERS; ++i) {
+                managers.push_back(new (ta) Obj(&ta));
+                managers.back()->registerThread();
+            }
+            for (int i = 0; i < k_NUM_MANAGERS; ++i) {
+                ASSERTV(i, managers[i]->isRegistered());
+                ASSERTV(i, 1 == managers[i]->numRegisteredThreads());
+                managers[i]->enter();
+            }
+            for (int i = 0; i < k_NUM_MANAGERS; ++i) {
+                ASSERTV(i, managers[i]->isInCriticalSection());
+                managers[i]->leave();
+                ASSERTV(i, !managers[i]->isInCriticalSection());
+            }
+            for (int i = 0; i < k_NUM_MANAGERS; ++i) {
+                ta.deleteObject(managers[i]);
+            }
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            Obj mX(&ta);
+
+            mX.enter();
+            ASSERT_FAIL(mX.deregisterThread());
+            mX.leave();
+            ASSERT_PASS(mX.deregisterThread());
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 A new epoch manager has epoch 0, no registered thread, and no
+        //:   retired object.
+        //:
+        //: 2 The reclaim threshold is installed, and defaults to
+        //:   'k_DEFAULT_RECLAIM_THRESHOLD'.
+        //:
+        //: 3 The allocator is installed, and defaults to the default
+        //:   allocator.
+        //:
+        //: 4 The reclaim threshold must be positive.
+        //
+        // Plan:
+        //: 1 Create epoch managers using each constructor, and verify their
+        //:   attributes.  (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered.  (C-4)
+        //
+        // Testing:
+        //   EpochManager(bslma::Allocator *basicAllocator = 0);
+        //   EpochManager(int reclaimThreshold, bslma::Allocator *ba = 0);
+        //   bsls::Types::Uint64 epoch() const;
+        //   int reclaimThreshold() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS AND BASIC ACCESSORS" << endl
+                          << "============================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            const Obj X;
+
+            ASSERT(0                 == X.epoch());
+            ASSERT(0                 == X.numRegisteredThreads());
+            ASSERT(0                 == X.numRetired());
+            ASSERT(&defaultAllocator == X.allocator());
+            ASSERT(Obj::k_DEFAULT_RECLAIM_THRESHOLD == X.reclaimThreshold());
+        }
+        {
+            const Obj X(&ta);
+
+            ASSERT(&ta == X.allocator());
+            ASSERT(Obj::k_DEFAULT_RECLAIM_THRESHOLD == X.reclaimThreshold());
+        }
+        {
+            const Obj X(5, &ta);
+
+            ASSERT(0   == X.epoch());
+            ASSERT(5   == X.reclaimThreshold());
+            ASSERT(&ta == X.allocator());
+            ASSERT(0   == ta.numBlocksInUse());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+        if (verbose) cout << "\tNegative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_PASS(Obj(1, &ta));
+            ASSERT_FAIL(Obj(0, &ta));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Enter and leave a critical section, retire objects, and
+        //:   synchronize.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            int numDestroyed = 0;
+            {
+                Guard guard(&mX);
+                ASSERT(X.isInCriticalSection());
+                mX.retireObject(new (ta) u::CountedObject(&numDestroyed));
+            }
+            ASSERT(0 == numDestroyed);
+            ASSERT(1 == X.numRetired());
+
+            mX.synchronize();
+            ASSERT(1 == numDestroyed);
+            ASSERT(0 == X.numRetired());
+
+            mX.deregisterThread();
+            ASSERT(0 == X.numRegisteredThreads());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    ASSERTV(globalAllocator.numBlocksTotal(),
+            0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License.  You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -35,6 +35,25 @@ BSLS_IDENT("$Id: $")
 // block and any blocked invocations will fail immediately).  The queue may be
 // restored to normal operation with the 'enable' method.
 //
+// The queue also provides batch methods: 'tryPushBack', when supplied an
+// iterator range, appends as many elements from the front of the range as
+// there is free space for (without blocking) and returns the number appended,
+// and 'popFront' and 'tryPopFront', when supplied a maximum number of items
+// and a 'bsl::vector', append up to that many elements to the vector.  Each
+// element still occupies its own cell reservation, but threads blocked on the
+// opposite side of the queue are woken once per batch (at most one wake-up per
+// transferred element, and only as many as are waiting) rather than once per
+// element.
+//
+// By default, a thread popping from an empty queue blocks on a semaphore
+// immediately, and is woken by a system call when an element is pushed.
+// Latency-critical consumers can instead supply a 'bdlcc::WaitStrategy' at
+// construction, in which case a blocking 'popFront' that finds the queue empty
+// re-checks for an element the configured number of times while spinning, and
+// then while yielding, before it blocks (see 'bdlcc_waitstrategy').  The
+// 'waitStrategyCounters' accessor reports how many of those waits were
+// satisfied while spinning, were satisfied while yielding, or blocked.
+//
 // Unlike 'bdlcc::Queue', a fixed queue is not double-ended, there is no timed
 // API like 'timedPushBack' and 'timedPopFront', and no 'forcePush' methods, as
 // the queue capacity is fixed.  Also, this component is not based on
@@ -56,8 +75,13 @@ BSLS_IDENT("$Id: $")
 ///----------------
 // A 'bdlcc::FixedQueue' is exception neutral, and all of the methods of
 // 'bdlcc::FixedQueue' provide the strong exception safety guarantee except for
-// 'pushBack' and 'tryPushBack', which provide the basic exception guarantee
-// (see 'bsldoc_glossary').
+// 'pushBack' and 'tryPushBack', and the batch 'popFront' and 'tryPopFront',
+// which provide the basic exception guarantee (see 'bsldoc_glossary').  The
+// batch pop methods remove and append the elements one at a time: if an
+// exception is thrown while an element is appended to the supplied vector,
+// the elements already appended remain in the vector, the element being
+// appended is removed from the queue and destroyed, and the elements not yet
+// removed remain in the queue.
 //
 ///Memory Usage
 ///------------
@@ -184,6 +208,7 @@ BSLS_IDENT("$Id: $")
 #include <bdlscm_version.h>
 
 #include <bdlcc_fixedqueueindexmanager.h>
+#include <bdlcc_waitstrategy.h>
 
 #include <bslmt_semaphore.h>
 #include <bslmt_threadutil.h>
@@ -205,6 +230,7 @@ BSLS_IDENT("$Id: $")
 #include <bsls_types.h>
 
 #include <bsl_algorithm.h>
+#include <bsl_cstddef.h>
 #include <bsl_vector.h>
 
 namespace BloombergLP {
@@ -261,6 +287,13 @@ class FixedQueue {
     const char        d_pushControlSemaPad[k_SEMA_PADDING];
                                            // padding to prevent false sharing
 
+    WaitStrategy      d_waitStrategy;      // strategy for blocking "pop"
+                                           // operations
+
+    WaitStrategyCounters
+                      d_waitCounters;      // outcomes of the waits of
+                                           // blocking "pop" operations
+
     bslma::Allocator *d_allocator_p;       // allocator, held not owned
 
   private:
@@ -272,17 +305,40 @@ class FixedQueue {
     template <class VAL> friend class FixedQueue_PushProctor;
     template <class VAL> friend class FixedQueue_PopGuard;
 
+    // PRIVATE MANIPULATORS
+    bsl::size_t popFrontRange(bsl::size_t        maxNumItems,
+                              bsl::vector<TYPE> *values);
+        // Remove up to the specified 'maxNumItems' elements from the front of
+        // this queue without blocking, append the removed elements, in order,
+        // to the specified 'values', and return the number of elements
+        // removed.  Threads waiting to push are woken once the batch is
+        // complete.  If an exception is thrown, the elements already appended
+        // remain in 'values', and the element being appended is removed and
+        // destroyed.
+
+    void waitToPop(WaitStrategyBackoff *backoff);
+        // Wait for an element to be pushed into this queue: perform the next
+        // step of the specified 'backoff' if its spin and yield steps are not
+        // exhausted, and otherwise block on 'd_popControlSema' if this queue
+        // is empty.
+
   public:
     // TRAITS
     BSLMF_NESTED_TRAIT_DECLARATION(FixedQueue, bslma::UsesBslmaAllocator);
     // CREATORS
     explicit
     FixedQueue(bsl::size_t capacity, bslma::Allocator *basicAllocator = 0);
+    FixedQueue(bsl::size_t          capacity,
+               const WaitStrategy&  waitStrategy,
+               bslma::Allocator    *basicAllocator = 0);
         // Create a thread-enabled lock-free queue having the specified
-        // 'capacity'.  Optionally specify a 'basicAllocator' used to supply
-        // memory.  If 'basicAllocator' is 0, the currently installed default
-        // allocator is used.  The behavior is undefined unless '0 < capacity'
-        // and 'capacity <= bdlcc::FixedQueueIndexManager::k_MAX_CAPACITY'.
+        // 'capacity'.  Optionally specify a 'waitStrategy' used by 'popFront'
+        // invocations that find the queue empty; if 'waitStrategy' is not
+        // specified, such invocations block immediately.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless '0 < capacity' and
+        // 'capacity <= bdlcc::FixedQueueIndexManager::k_MAX_CAPACITY'.
 
     ~FixedQueue();
         // Destroy this object.
@@ -327,6 +383,37 @@ class FixedQueue {
         // removed element.  Return 0 on success, and a non-zero value if queue
         // was empty.  On failure, 'value' is not changed.
 
+    void popFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *values);
+        // Remove up to the specified 'maxNumItems' elements from the front of
+        // this queue and append them, in order, to the specified 'values'.  If
+        // the queue is empty, block until it is not empty.  If an exception
+        // is thrown, the elements already appended remain in 'values', and
+        // the element being appended is lost (see {Exception safety}).  The
+        // behavior is undefined unless '0 < maxNumItems'.  Note that at least
+        // one element is appended to 'values'.
+
+    int tryPopFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *values);
+        // Attempt to remove up to the specified 'maxNumItems' elements from
+        // the front of this queue without blocking, and append the removed
+        // elements, in order, to the specified 'values'.  Return 0 if at least
+        // one element was removed, and a non-zero value if the queue was
+        // empty.  On failure, 'values' is not changed.  If an exception is
+        // thrown, the elements already appended remain in 'values', and the
+        // element being appended is lost (see {Exception safety}).  The
+        // behavior is undefined unless '0 < maxNumItems'.
+
+    template <class FORWARD_ITER>
+    bsl::size_t tryPushBack(FORWARD_ITER begin, FORWARD_ITER end);
+        // Append, without blocking, the longest prefix of the elements in the
+        // range starting at the specified 'begin' and ending immediately
+        // before the specified 'end' for which this queue has free space to
+        // the back of this queue, in order, and return the number of elements
+        // appended.  Return 0, and append no elements, if the queue is full or
+        // disabled.  The behavior is undefined unless '[begin .. end)' is a
+        // valid range of elements convertible to 'TYPE'.  Note that elements
+        // pushed concurrently by other threads may be interleaved with the
+        // appended elements.
+
     void removeAll();
         // Remove all items from this queue.  Note that this operation is not
         // atomic; if other threads are concurrently pushing items into the
@@ -369,6 +456,15 @@ class FixedQueue {
     int size() const;
         // [!DEPRECATED!] Invoke 'capacity'.
 
+    const WaitStrategy& waitStrategy() const;
+        // Return a reference providing non-modifiable access to the wait
+        // strategy used by 'popFront' invocations.
+
+    const WaitStrategyCounters& waitStrategyCounters() const;
+        // Return a reference providing non-modifiable access to the counters
+        // of the outcomes of the waits of 'popFront' invocations that found
+        // this queue empty.
+
 };
 
                          // =========================
@@ -393,6 +489,10 @@ class FixedQueue_PopGuard {
     unsigned int                  d_index;
                                      // index of cell being popped
 
+    bool                          d_notify;
+                                     // if 'true', a waiting pusher is woken
+                                     // upon destruction
+
   private:
     // NOT IMPLEMENTED
     FixedQueue_PopGuard(const FixedQueue_PopGuard&);
@@ -402,13 +502,16 @@ class FixedQueue_PopGuard {
     // CREATORS
     FixedQueue_PopGuard(FixedQueue<VALUE> *queue,
                         unsigned int       generation,
-                        unsigned int       index);
+                        unsigned int       index,
+                        bool               notify = true);
         // Create a guard that, upon its destruction, will update the state of
         // the specified 'queue' to remove (pop) the element at the specified
         // 'index' having the specified 'generation', and destroy that popped
-        // object.  The behavior is undefined unless 'index' and 'generation'
-        // refer to a valid element in 'queue' that the current thread has
-        // acquired a reservation to pop (using
+        // object.  Optionally specify 'notify'; if 'notify' is 'false', no
+        // waiting pusher is woken by this guard (the caller assumes that
+        // responsibility).  The behavior is undefined unless 'index' and
+        // 'generation' refer to a valid element in 'queue' that the current
+        // thread has acquired a reservation to pop (using
         // 'FixedQueueIndexManager::reservePopIndex').
 
     ~FixedQueue_PopGuard();
@@ -417,6 +520,44 @@ class FixedQueue_PopGuard {
         // object.
 };
 
+                       // =============================
+                       // class FixedQueue_NotifyGuard
+                       // =============================
+
+class FixedQueue_NotifyGuard {
+    // This class provides a guard that, upon its destruction, posts a
+    // semaphore once for each of a counted number of transferred elements, but
+    // no more times than there are threads waiting on that semaphore.  Note
+    // that this guard is used by the batch operations of 'FixedQueue' to wake
+    // the threads blocked on the opposite side of the queue once per batch.
+
+    // DATA
+    bslmt::Semaphore      *d_semaphore_p;   // semaphore to post
+    const bsls::AtomicInt *d_numWaiting_p;  // number of waiting threads
+    int                    d_count;         // number of transferred elements
+
+  private:
+    // NOT IMPLEMENTED
+    FixedQueue_NotifyGuard(const FixedQueue_NotifyGuard&);
+    FixedQueue_NotifyGuard& operator=(const FixedQueue_NotifyGuard&);
+
+  public:
+    // CREATORS
+    FixedQueue_NotifyGuard(bslmt::Semaphore      *semaphore,
+                           const bsls::AtomicInt *numWaiting);
+        // Create a guard that, upon its destruction, will post the specified
+        // 'semaphore' the lesser of the number of times 'increment' was
+        // invoked and the value of the specified 'numWaiting'.
+
+    ~FixedQueue_NotifyGuard();
+        // Destroy this guard and post the managed semaphore as described
+        // above.
+
+    // MANIPULATORS
+    void increment();
+        // Increment the number of transferred elements.
+};
+
                         // ============================
                         // class FixedQueue_PushProctor
                         // ============================
@@ -493,6 +634,29 @@ FixedQueue<TYPE>::FixedQueue(bsl::size_t       capacity,
 , d_numWaitingPushers(0)
 , d_pushControlSema(0)
 , d_pushControlSemaPad()
+, d_waitStrategy()
+, d_waitCounters()
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    d_elements = static_cast<TYPE *>(
+                            d_allocator_p->allocate(capacity * sizeof(TYPE)));
+}
+
+template <class TYPE>
+FixedQueue<TYPE>::FixedQueue(bsl::size_t          capacity,
+                             const WaitStrategy&  waitStrategy,
+                             bslma::Allocator    *basicAllocator)
+: d_elements()
+, d_elementsPad()
+, d_impl(capacity, basicAllocator)
+, d_numWaitingPoppers(0)
+, d_popControlSema(0)
+, d_popControlSemaPad()
+, d_numWaitingPushers(0)
+, d_pushControlSema(0)
+, d_pushControlSemaPad()
+, d_waitStrategy(waitStrategy)
+, d_waitCounters()
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     d_elements = static_cast<TYPE *>(
@@ -624,6 +788,77 @@ int FixedQueue<TYPE>::tryPopFront(TYPE *value)
     return 0;
 }
 
+template <class TYPE>
+bsl::size_t FixedQueue<TYPE>::popFrontRange(bsl::size_t        maxNumItems,
+                                            bsl::vector<TYPE> *values)
+{
+    // Reserve the space for the elements currently in the queue up front, so
+    // that an allocation failure leaves the queue unchanged.  Elements pushed
+    // concurrently may still require 'values' to grow, and an exception
+    // thrown then loses the element being appended (see {Exception safety}).
+
+    const int length = numElements();
+
+    values->reserve(values->size() +
+                    bsl::min(maxNumItems,
+                             static_cast<bsl::size_t>(length > 0 ? length
+                                                                 : 0)));
+
+    // Each element is popped with its own reservation (see
+    // 'FixedQueueIndexManager'), but waiting pushers are woken only once the
+    // batch is complete, by 'notifyGuard'.
+
+    FixedQueue_NotifyGuard notifyGuard(&d_pushControlSema,
+                                       &d_numWaitingPushers);
+
+    bsl::size_t numPopped = 0;
+    while (numPopped < maxNumItems) {
+        unsigned int generation;
+        unsigned int index;
+
+        // SYNCHRONIZATION POINT 2 (see 'tryPopFront')
+
+        if (0 != d_impl.reservePopIndex(&generation, &index)) {
+            break;
+        }
+
+        notifyGuard.increment();
+
+        FixedQueue_PopGuard<TYPE> guard(this, generation, index, false);
+#if defined(BSLMF_MOVABLEREF_USES_RVALUE_REFERENCES)
+        values->push_back(bslmf::MovableRefUtil::move(d_elements[index]));
+#else
+        values->push_back(d_elements[index]);
+#endif
+        ++numPopped;
+    }
+
+    return numPopped;
+}
+
+template <class TYPE>
+void FixedQueue<TYPE>::waitToPop(WaitStrategyBackoff *backoff)
+{
+    if (backoff->backoff()) {
+        return;                                                       // RETURN
+    }
+
+    d_numWaitingPoppers.addRelaxed(1);
+
+    // SYNCHRONIZATION POINT 2-Prime
+    //
+    // The following call to 'isEmpty' loads
+    // 'FixedQueueIndexManager::d_pushIndex' with full sequential consistency,
+    // which is required to ensure the visibility of the preceding change to
+    // 'd_numWaitingPoppers' to SYNCHRONIZATION POINT 1.
+
+    if (isEmpty()) {
+        d_popControlSema.wait();
+    }
+
+    d_numWaitingPoppers.addRelaxed(-1);
+}
+
 // MANIPULATORS
 template <class TYPE>
 int FixedQueue<TYPE>::pushBack(const TYPE& value)
@@ -690,23 +925,16 @@ int FixedQueue<TYPE>::pushBack(bslmf::MovableRef<TYPE> value)
 template <class TYPE>
 void FixedQueue<TYPE>::popFront(TYPE *value)
 {
-    while (0 != tryPopFront(value)) {
-        d_numWaitingPoppers.addRelaxed(1);
-
-        // SYNCHRONIZATION POINT 2-Prime
-        //
-        // The following call to 'isEmpty' loads
-        // 'FixedQueueIndexManager::d_pushIndex' with full sequential
-        // consistency, which is required to ensure the visibility of the
-        // preceding change to 'd_numWaitingPushers' to SYNCHRONIZATION POINT
-        // 2.
+    if (0 == tryPopFront(value)) {
+        return;                                                       // RETURN
+    }
 
-        if (isEmpty()) {
-            d_popControlSema.wait();
-        }
+    WaitStrategyBackoff backoff(d_waitStrategy, &d_waitCounters);
+    do {
+        waitToPop(&backoff);
+    } while (0 != tryPopFront(value));
 
-        d_numWaitingPoppers.addRelaxed(-1);
-    }
+    backoff.recordAcquire();
 }
 
 template <class TYPE>
@@ -715,14 +943,13 @@ TYPE FixedQueue<TYPE>::popFront()
     unsigned int generation;
     unsigned int index;
 
-    while (0 != d_impl.reservePopIndex(&generation, &index)) {
-        d_numWaitingPoppers.addRelaxed(1);
-
-        if (isEmpty()) {
-            d_popControlSema.wait();
-        }
+    if (0 != d_impl.reservePopIndex(&generation, &index)) {
+        WaitStrategyBackoff backoff(d_waitStrategy, &d_waitCounters);
+        do {
+            waitToPop(&backoff);
+        } while (0 != d_impl.reservePopIndex(&generation, &index));
 
-        d_numWaitingPoppers.addRelaxed(-1);
+        backoff.recordAcquire();
     }
 
     // Copy the element.  'FixedQueue_PopGuard' will destroy original object,
@@ -741,6 +968,72 @@ TYPE FixedQueue<TYPE>::popFront()
 #endif
 }
 
+template <class TYPE>
+void FixedQueue<TYPE>::popFront(bsl::size_t        maxNumItems,
+                                bsl::vector<TYPE> *values)
+{
+    BSLS_ASSERT(0 < maxNumItems);
+    BSLS_ASSERT(values);
+
+    if (0 != popFrontRange(maxNumItems, values)) {
+        return;                                                       // RETURN
+    }
+
+    WaitStrategyBackoff backoff(d_waitStrategy, &d_waitCounters);
+    do {
+        waitToPop(&backoff);
+    } while (0 == popFrontRange(maxNumItems, values));
+
+    backoff.recordAcquire();
+}
+
+template <class TYPE>
+int FixedQueue<TYPE>::tryPopFront(bsl::size_t        maxNumItems,
+                                  bsl::vector<TYPE> *values)
+{
+    BSLS_ASSERT(0 < maxNumItems);
+    BSLS_ASSERT(values);
+
+    return 0 == popFrontRange(maxNumItems, values) ? 1 : 0;
+}
+
+template <class TYPE>
+template <class FORWARD_ITER>
+bsl::size_t FixedQueue<TYPE>::tryPushBack(FORWARD_ITER begin,
+                                          FORWARD_ITER end)
+{
+    // Each element is pushed with its own reservation (see
+    // 'FixedQueueIndexManager'), but waiting poppers are woken only once the
+    // batch is complete, by 'notifyGuard'.
+
+    FixedQueue_NotifyGuard notifyGuard(&d_popControlSema,
+                                       &d_numWaitingPoppers);
+
+    bsl::size_t numPushed = 0;
+    for (; begin != end; ++begin) {
+        unsigned int generation;
+        unsigned int index;
+
+        // SYNCHRONIZATION POINT 1 (see 'tryPushBack(const TYPE&)')
+
+        if (0 != d_impl.reservePushIndex(&generation, &index)) {
+            break;
+        }
+
+        FixedQueue_PushProctor<TYPE> guard(this, generation, index);
+        bslalg::ScalarPrimitives::copyConstruct<TYPE>(&d_elements[index],
+                                                      *begin,
+                                                      d_allocator_p);
+        guard.release();
+        d_impl.commitPushIndex(generation, index);
+
+        notifyGuard.increment();
+        ++numPushed;
+    }
+
+    return numPushed;
+}
+
 template <class TYPE>
 void FixedQueue<TYPE>::removeAll()
 {
@@ -836,6 +1129,20 @@ int FixedQueue<TYPE>::size() const
     return static_cast<int>(capacity());
 }
 
+template <class TYPE>
+inline
+const WaitStrategy& FixedQueue<TYPE>::waitStrategy() const
+{
+    return d_waitStrategy;
+}
+
+template <class TYPE>
+inline
+const WaitStrategyCounters& FixedQueue<TYPE>::waitStrategyCounters() const
+{
+    return d_waitCounters;
+}
+
                          // -------------------------
                          // class FixedQueue_PopGuard
                          // -------------------------
@@ -845,10 +1152,12 @@ template <class VALUE>
 inline
 FixedQueue_PopGuard<VALUE>::FixedQueue_PopGuard(FixedQueue<VALUE> *queue,
                                                 unsigned int       generation,
-                                                unsigned int       index)
+                                                unsigned int       index,
+                                                bool               notify)
 : d_parent_p(queue)
 , d_generation(generation)
 , d_index(index)
+, d_notify(notify)
 {
 }
 
@@ -867,11 +1176,44 @@ FixedQueue_PopGuard<VALUE>::~FixedQueue_PopGuard()
     // Notify pusher of available element.
 
     if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
-            d_parent_p->d_numWaitingPushers)) {
+            d_notify && d_parent_p->d_numWaitingPushers)) {
         d_parent_p->d_pushControlSema.post();
     }
 }
 
+                       // -----------------------------
+                       // class FixedQueue_NotifyGuard
+                       // -----------------------------
+
+// CREATORS
+inline
+FixedQueue_NotifyGuard::FixedQueue_NotifyGuard(
+                                         bslmt::Semaphore      *semaphore,
+                                         const bsls::AtomicInt *numWaiting)
+: d_semaphore_p(semaphore)
+, d_numWaiting_p(numWaiting)
+, d_count(0)
+{
+}
+
+inline
+FixedQueue_NotifyGuard::~FixedQueue_NotifyGuard()
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(d_count && *d_numWaiting_p)) {
+        int numWakeUps = bsl::min(d_count, d_numWaiting_p->loadRelaxed());
+        while (0 < numWakeUps--) {
+            d_semaphore_p->post();
+        }
+    }
+}
+
+// MANIPULATORS
+inline
+void FixedQueue_NotifyGuard::increment()
+{
+    ++d_count;
+}
+
                         // ----------------------------
                         // class FixedQueue_PushProctor
                         // ----------------------------
@@ -46,10 +46,13 @@
 #include <bsl_ctime.h>
 #include <bsl_cstdio.h>
 #include <bsl_cstdlib.h>
+#include <bsl_cstddef.h>
 #include <bsl_cstring.h>
 #include <bsl_functional.h>
 #include <bsl_iostream.h>
 #include <bsl_memory.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
 
 #include <bsl_c_stdlib.h>            // 'atoi'
 
@@ -986,6 +989,134 @@ void runtest(int numIterations, int numPushers, int numPoppers)
 }
 }  // close namespace zerotst
 
+namespace batchtst {
+
+struct Control {
+    bslmt::Barrier           *d_barrier;
+
+    bdlcc::FixedQueue<int>   *d_queue;
+
+    int                       d_numExpectedPushers;
+    int                       d_iterations;
+    bool                      d_blockingPop;
+
+    bsls::AtomicInt           d_numPushers;
+    bsls::AtomicInt           d_numPopped;
+};
+
+enum { k_BATCH_SIZE = 13, k_THREAD_SHIFT = 24 };
+
+void pusherThread(Control *control)
+{
+    bdlcc::FixedQueue<int> *queue = control->d_queue;
+
+    int threadId = control->d_numPushers++;
+
+    bsl::vector<int> values;
+    for (int i = 0; i < control->d_iterations; ++i) {
+        values.push_back((threadId << k_THREAD_SHIFT) | i);
+    }
+
+    control->d_barrier->wait();
+
+    // Push the values in batches, blocking on a single 'pushBack' whenever
+    // the queue is full.
+
+    bsl::vector<int>::const_iterator begin = values.begin();
+    while (begin != values.end()) {
+        bsl::vector<int>::const_iterator end =
+                       begin + bsl::min<bsl::ptrdiff_t>(k_BATCH_SIZE,
+                                                        values.end() - begin);
+
+        bsl::size_t numPushed = queue->tryPushBack(begin, end);
+        if (0 == numPushed) {
+            ASSERTT(0 == queue->pushBack(*begin));
+            numPushed = 1;
+        }
+        begin += numPushed;
+    }
+}
+
+void popperThread(Control *control)
+{
+    bsl::vector<int> seq(control->d_numExpectedPushers, -1);
+
+    bdlcc::FixedQueue<int> *queue = control->d_queue;
+
+    int totalToPop = control->d_numExpectedPushers * control->d_iterations;
+
+    control->d_barrier->wait();
+
+    bsl::vector<int> values;
+    while (control->d_numPopped < totalToPop) {
+        values.clear();
+        if (control->d_blockingPop) {
+            queue->popFront(k_BATCH_SIZE, &values);
+        }
+        else if (0 != queue->tryPopFront(k_BATCH_SIZE, &values)) {
+            ASSERTT(values.empty());
+            bslmt::ThreadUtil::yield();
+            continue;
+        }
+        ASSERTT(0 < values.size());
+        ASSERTT(k_BATCH_SIZE >= values.size());
+
+        for (bsl::size_t i = 0; i < values.size(); ++i) {
+            int threadId    = values[i] >> k_THREAD_SHIFT;
+            int sequenceNum = values[i] & ((1 << k_THREAD_SHIFT) - 1);
+
+            LOOP2_ASSERTT(seq[threadId], sequenceNum,
+                          seq[threadId] < sequenceNum);
+            seq[threadId] = sequenceNum;
+        }
+        control->d_numPopped += static_cast<int>(values.size());
+    }
+}
+
+void runtest(int  numIterations,
+             int  numPushers,
+             int  numPoppers,
+             int  queueSize)
+{
+    bdlcc::FixedQueue<int> queue(queueSize);
+
+    bslmt::Barrier barrier(numPushers + numPoppers);
+
+    Control control;
+
+    control.d_numExpectedPushers = numPushers;
+    control.d_iterations = numIterations;
+    control.d_blockingPop = 1 == numPoppers;
+    control.d_queue = &queue;
+
+    control.d_numPopped = 0;
+    control.d_numPushers = 0;
+
+    control.d_barrier = &barrier;
+
+    bslmt::ThreadGroup tg;
+    tg.addThreads(bdlf::BindUtil::bind(&pusherThread,&control),
+            numPushers);
+    tg.addThreads(bdlf::BindUtil::bind(&popperThread,&control),
+            numPoppers);
+
+    tg.joinAll();
+    ASSERT(numPushers * numIterations == control.d_numPopped);
+    ASSERT(queue.isEmpty());
+}
+}  // close namespace batchtst
+
+namespace waittst {
+
+void deferredPushBack(bdlcc::FixedQueue<int> *queue)
+    // Push a single value onto the specified 'queue' after a short delay.
+{
+    bslmt::ThreadUtil::microSleep(100 * 1000);
+    queue->pushBack(7);
+}
+
+}  // close namespace waittst
+
 namespace case18 {
 
                               // ==========
@@ -1305,7 +1436,7 @@ int main(int argc, char *argv[])
                     bslmt::Configuration::recommendedDefaultThreadStackSize());
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 19: {
+      case 21: {
         // ---------------------------------------------------------
         // Usage example test
         //
@@ -1321,6 +1452,354 @@ int main(int argc, char *argv[])
         break;
       }
 
+      case 20: {
+        // ---------------------------------------------------------
+        // Wait strategy test
+        //
+        // Concerns:
+        //: 1 The queue reports the wait strategy supplied at construction,
+        //:   or a strategy that parks immediately if none was supplied.
+        //:
+        //: 2 A 'popFront' that finds an element available records nothing.
+        //:
+        //: 3 Each blocking 'popFront' variant that waits records exactly one
+        //:   outcome: a spin, a yield, or a park, according to the strategy.
+        //
+        // Plan:
+        //: 1 Create queues with and without a strategy and verify the
+        //:   accessors.  (C-1)
+        //:
+        //: 2 Pop from a non-empty queue and verify the counters.  (C-2)
+        //:
+        //: 3 For strategies that only park, only spin (with a spin count
+        //:   large enough to outlast the delay), and only yield, pop from
+        //:   an empty queue using each 'popFront' variant while another
+        //:   thread pushes an element after a delay, and verify the
+        //:   counters.  (C-3)
+        //
+        // Testing:
+        //   FixedQueue(size_t, const WaitStrategy&, Allocator *);
+        //   const WaitStrategy& waitStrategy() const;
+        //   const WaitStrategyCounters& waitStrategyCounters() const;
+        // ---------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "Wait strategy test" << endl
+                          << "==================" << endl;
+
+        typedef bdlcc::WaitStrategy         Strategy;
+        typedef bdlcc::WaitStrategyCounters Counters;
+
+        const int k_LARGE = 1 << 30;
+
+        {
+            bdlcc::FixedQueue<int> x(4);
+            ASSERT(Strategy() == x.waitStrategy());
+
+            bdlcc::FixedQueue<int> y(4, Strategy(100, 2));
+            ASSERT(Strategy(100, 2) == y.waitStrategy());
+
+            const Counters& C = y.waitStrategyCounters();
+            ASSERT(0 == C.numSpins());
+            ASSERT(0 == C.numYields());
+            ASSERT(0 == C.numParks());
+
+            y.pushBack(1);
+            ASSERT(1 == y.popFront());
+            ASSERT(0 == C.numSpins() + C.numYields() + C.numParks());
+        }
+
+        enum { e_POP_VALUE, e_POP_RETURN, e_POP_BATCH, e_NUM_MODES };
+
+        static const struct {
+            int                 d_line;
+            int                 d_spinCount;
+            int                 d_yieldCount;
+            bsls::Types::Uint64 d_expSpins;
+            bsls::Types::Uint64 d_expYields;
+            bsls::Types::Uint64 d_expParks;
+        } DATA[] = {
+            { L_,       0,       0, 0, 0, 1 },
+            { L_, k_LARGE,       0, 1, 0, 0 },
+            { L_,       0, k_LARGE, 0, 1, 0 },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int                 LINE       = DATA[ti].d_line;
+            const int                 SPIN       = DATA[ti].d_spinCount;
+            const int                 YIELD      = DATA[ti].d_yieldCount;
+            const bsls::Types::Uint64 EXP_SPINS  = DATA[ti].d_expSpins;
+            const bsls::Types::Uint64 EXP_YIELDS = DATA[ti].d_expYields;
+            const bsls::Types::Uint64 EXP_PARKS  = DATA[ti].d_expParks;
+
+            for (int mode = 0; mode < e_NUM_MODES; ++mode) {
+                if (veryVerbose) { T_ P_(LINE) P_(SPIN) P_(YIELD) P(mode) }
+
+                bdlcc::FixedQueue<int> queue(4, Strategy(SPIN, YIELD));
+
+                bslmt::ThreadGroup tg;
+                tg.addThread(bdlf::BindUtil::bind(&waittst::deferredPushBack,
+                                                  &queue));
+
+                switch (mode) {
+                  case e_POP_VALUE: {
+                    int value = 0;
+                    queue.popFront(&value);
+                    ASSERTV(LINE, 7 == value);
+                  } break;
+                  case e_POP_RETURN: {
+                    ASSERTV(LINE, 7 == queue.popFront());
+                  } break;
+                  default: {
+                    bsl::vector<int> values;
+                    queue.popFront(4, &values);
+                    ASSERTV(LINE, 1 == values.size() && 7 == values[0]);
+                  } break;
+                }
+
+                tg.joinAll();
+
+                const Counters& C = queue.waitStrategyCounters();
+                ASSERTV(LINE, mode, C.numSpins(),  EXP_SPINS  == C.numSpins());
+                ASSERTV(LINE, mode, C.numYields(),
+                        EXP_YIELDS == C.numYields());
+                ASSERTV(LINE, mode, C.numParks(),  EXP_PARKS  == C.numParks());
+            }
+        }
+        break;
+      }
+
+      case 19: {
+        // ---------------------------------------------------------
+        // Batch operations test
+        //
+        // Concerns:
+        //: 1 'tryPushBack' on a range appends the longest prefix of the range
+        //:   that fits, in order, and returns the number appended.
+        //:
+        //: 2 'tryPushBack' on a range appends nothing to a full or disabled
+        //:   queue.
+        //:
+        //: 3 'popFront' and 'tryPopFront' with a maximum number of items
+        //:   append, in order, at most that many elements to the vector, and
+        //:   'tryPopFront' fails without modifying the vector on an empty
+        //:   queue.
+        //:
+        //: 4 A blocked 'pushBack' is released by a batch pop, and a blocked
+        //:   batch 'popFront' is released by a batch push.
+        //:
+        //: 5 Concurrent batch pushers and poppers transfer every element,
+        //:   preserving the order of each pusher's elements.
+        //:
+        //: 6 The batch methods work with allocating element types and use the
+        //:   queue's allocator for the elements.
+        //:
+        //: 7 An exception thrown while appending an element to the vector
+        //:   leaves the elements already appended in the vector, loses only
+        //:   the element being appended, and leaves the others in the queue.
+        //
+        // Plan:
+        //: 1 Exercise the batch methods on a small queue, including across
+        //:   the end of the underlying ring buffer.  (C-1..3, 6)
+        //:
+        //: 2 Block a thread in 'pushBack' (or batch 'popFront') and release
+        //:   it with a batch operation from the main thread.  (C-4)
+        //:
+        //: 3 Run multiple pushers and poppers using the batch methods on
+        //:   queues of various capacities and verify the sequence numbers
+        //:   received from each pusher are increasing.  (C-5)
+        //:
+        //: 4 Using a vector whose allocator fails part way through a batch
+        //:   'tryPopFront', verify the contents of the vector and of the
+        //:   queue.  (C-7)
+        //
+        // Testing:
+        //   size_t tryPushBack(FORWARD_ITER, FORWARD_ITER);
+        //   void popFront(size_t, vector<TYPE> *);
+        //   int tryPopFront(size_t, vector<TYPE> *);
+        // ---------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "Batch operations test" << endl
+                          << "=====================" << endl;
+
+        if (verbose) cout << "\tBasic behavior" << endl;
+        {
+            bdlcc::FixedQueue<int> queue(5);
+
+            const int DATA[] = { 1, 2, 3, 4, 5, 6, 7 };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            bsl::vector<int> values;
+            values.push_back(-1);
+
+            ASSERT(0 == queue.tryPushBack(DATA, DATA));
+            ASSERT(0 != queue.tryPopFront(3, &values));
+            ASSERT(1 == values.size());
+
+            ASSERT(3 == queue.tryPushBack(DATA, DATA + 3));
+            ASSERT(3 == queue.numElements());
+            ASSERT(2 == queue.tryPushBack(DATA + 3, DATA + NUM_DATA));
+            ASSERT(queue.isFull());
+            ASSERT(0 == queue.tryPushBack(DATA, DATA + 1));
+
+            ASSERT(0 == queue.tryPopFront(2, &values));
+            ASSERT(3 == values.size());
+            ASSERT(-1 == values[0] && 1 == values[1] && 2 == values[2]);
+
+            // Wrap around the end of the ring buffer.
+
+            ASSERT(2 == queue.tryPushBack(DATA + 5, DATA + NUM_DATA));
+
+            values.clear();
+            queue.popFront(100, &values);
+            ASSERT(5 == values.size());
+            for (int i = 0; i < 5; ++i) {
+                LOOP_ASSERT(i, DATA[i + 2] == values[i]);
+            }
+            ASSERT(queue.isEmpty());
+
+            // Interoperate with the single-element methods.
+
+            ASSERT(0 == queue.pushBack(10));
+            ASSERT(2 == queue.tryPushBack(DATA, DATA + 2));
+            ASSERT(10 == queue.popFront());
+            values.clear();
+            ASSERT(0 == queue.tryPopFront(1, &values));
+            ASSERT(1 == values.size() && 1 == values[0]);
+            ASSERT(0 == queue.tryPopFront(5, &values));
+            ASSERT(2 == values.size() && 2 == values[1]);
+            ASSERT(queue.isEmpty());
+
+            queue.disable();
+            ASSERT(0 == queue.tryPushBack(DATA, DATA + NUM_DATA));
+            ASSERT(queue.isEmpty());
+            queue.enable();
+            ASSERT(NUM_DATA - 2 == queue.tryPushBack(DATA, DATA + NUM_DATA));
+            queue.removeAll();
+        }
+
+        if (verbose) cout << "\tAllocating element type" << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            bslma::TestAllocator da(veryVeryVerbose);
+            bslma::DefaultAllocatorGuard guard(&da);
+
+            bdlcc::FixedQueue<bsl::string> queue(4, &ta);
+
+            bsl::vector<bsl::string> strings;
+            strings.push_back("a string long enough to require allocation");
+            strings.push_back("another string long enough to allocate too");
+
+            bsls::Types::Int64 numAllocations = ta.numAllocations();
+            bsls::Types::Int64 numBlocksInUse = ta.numBlocksInUse();
+            ASSERT(2 == queue.tryPushBack(strings.begin(), strings.end()));
+            ASSERT(numAllocations + 2 == ta.numAllocations());
+
+            bsl::vector<bsl::string> values;
+            ASSERT(0 == queue.tryPopFront(4, &values));
+            ASSERT(strings == values);
+            ASSERT(numBlocksInUse == ta.numBlocksInUse());
+        }
+
+#ifdef BDE_BUILD_TARGET_EXC
+        if (verbose) cout << "\tException in batch pop" << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            bslma::TestAllocator tb(veryVeryVerbose);
+
+            bdlcc::FixedQueue<bsl::string> queue(4, &ta);
+
+            bsl::vector<bsl::string> strings;
+            strings.push_back("the first string long enough to allocate");
+            strings.push_back("the second string long enough to allocate");
+            strings.push_back("the third string long enough to allocate");
+
+            bsls::Types::Int64 numBlocksInUse = ta.numBlocksInUse();
+            ASSERT(3 == queue.tryPushBack(strings.begin(), strings.end()));
+
+            // Moving an element into 'values', whose allocator differs from
+            // the queue's, copies it.  The second copy fails.
+
+            bsl::vector<bsl::string> values(&tb);
+            values.reserve(4);
+
+            int numException = 0;
+
+            tb.setAllocationLimit(1);
+            try {
+                queue.tryPopFront(4, &values);
+            } catch (bslma::TestAllocatorException&) {
+                ++numException;
+            }
+            tb.setAllocationLimit(-1);
+
+            ASSERT(1 == numException);
+            ASSERTV(values.size(), 1 == values.size());
+            ASSERT(strings[0] == values[0]);
+            ASSERTV(queue.numElements(), 1 == queue.numElements());
+            ASSERT(strings[2] == queue.popFront());
+            ASSERT(numBlocksInUse == ta.numBlocksInUse());
+        }
+#endif
+
+        if (verbose) cout << "\tBlocking" << endl;
+        {
+            bdlcc::FixedQueue<int> queue(2);
+
+            const int DATA[] = { 1, 2, 3 };
+
+            ASSERT(2 == queue.tryPushBack(DATA, DATA + 3));
+
+            bslmt::ThreadUtil::Handle handle;
+            ASSERT(0 == bslmt::ThreadUtil::create(
+                      &handle,
+                      bdlf::BindUtil::bind(
+                          static_cast<int (bdlcc::FixedQueue<int>::*)(
+                                              const int&)>(
+                                          &bdlcc::FixedQueue<int>::pushBack),
+                          &queue,
+                          3)));
+
+            bslmt::ThreadUtil::microSleep(100000);
+
+            bsl::vector<int> values;
+            ASSERT(0 == queue.tryPopFront(2, &values));
+            ASSERT(2 == values.size());
+            ASSERT(0 == bslmt::ThreadUtil::join(handle));
+            ASSERT(1 == queue.numElements());
+            ASSERT(3 == queue.popFront());
+
+            values.clear();
+            ASSERT(0 == bslmt::ThreadUtil::create(
+                      &handle,
+                      bdlf::BindUtil::bind(
+                          static_cast<void (bdlcc::FixedQueue<int>::*)(
+                                             bsl::size_t, bsl::vector<int> *)>(
+                                          &bdlcc::FixedQueue<int>::popFront),
+                          &queue,
+                          5,
+                          &values)));
+
+            bslmt::ThreadUtil::microSleep(100000);
+
+            ASSERT(2 == queue.tryPushBack(DATA, DATA + 2));
+            ASSERT(0 == bslmt::ThreadUtil::join(handle));
+            ASSERT(1 <= values.size() && 2 >= values.size());
+            ASSERT(1 == values[0]);
+            queue.removeAll();
+        }
+
+        if (verbose) cout << "\tConcurrency" << endl;
+        {
+            batchtst::runtest(20000, 1, 1, 7);
+            batchtst::runtest(20000, 1, 1, 2047);
+            batchtst::runtest(10000, 4, 1, 31);
+            batchtst::runtest(10000, 4, 4, 31);
+            batchtst::runtest(10000, 4, 4, 2047);
+        }
+      } break;
       case 18: {
           // ---------------------------------------------------------
           // Moving tests
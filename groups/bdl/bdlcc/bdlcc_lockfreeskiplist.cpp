@@ -0,0 +1,125 @@
+// bdlcc_lockfreeskiplist.cpp                                         -*-C++-*-
+#include <bdlcc_lockfreeskiplist.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlcc_lockfreeskiplist_cpp,"$Id$ $CSID$")
+
+///IMPLEMENTATION NOTES
+///--------------------
+// The list follows the lock-free skip list of Fraser and of Herlihy and
+// Shavit.  A node is removed by setting the mark bit of each of its links,
+// from its highest level down to level 0; the thread that marks the link at
+// level 0 has removed the node.  A marked node is unlinked from a level by any
+// thread whose 'search' encounters it, using a compare-and-swap on the
+// (unmarked) link of its predecessor, so that a node can never be linked after
+// a marked node.  All nodes are ordered by key and then by a sequence number
+// assigned when they are added, which makes the position of every node
+// unique, so that a 'search' for the key and sequence number of a node
+// encounters the node on every level to which it is linked.
+//
+// A node may be retired only once it is unreachable, i.e., unlinked from every
+// level.  The thread adding a node links it at level 0, and then at each
+// higher level, stopping if the node is removed meanwhile; a node removed
+// before it is fully linked could otherwise be linked at a higher level after
+// the remover's 'search' has passed.  The adding and the removing threads
+// therefore each set a bit of 'd_state' when they are done, and the thread
+// that sets the second bit performs a final 'search' for the node (which
+// unlinks it from every level, all of its links being marked) and retires it.
+//
+// A removed node is traversed only within the critical section during which
+// it was reached from the head of the list: after that, its links may refer
+// to nodes that have been reclaimed.  For that reason 'nextRaw' and
+// 'skipForwardRaw' search for the successor of a node from the head of the
+// list rather than following the links of the node.
+//
+// The list holds one reference to each of its nodes, which is released by the
+// epoch manager once the node can no longer be traversed; hence any node
+// reached within a critical section has a non-zero reference count, and a
+// reference to it can be acquired by a simple increment.
+//
+// The level of a new node is derived from the output of a 'splitmix64'
+// generator whose state is a thread-local variable, seeded from the thread id
+// on first use.  Where thread-local variables are not supported, the state is
+// shared and advanced atomically.
+
+#include <bslmt_threadlocalvariable.h>
+#include <bslmt_threadutil.h>
+
+#include <bdlb_bitutil.h>
+
+#include <bsl_cstdint.h>
+
+namespace BloombergLP {
+namespace {
+
+const bsls::Types::Uint64 k_GOLDEN_GAMMA = 0x9e3779b97f4a7c15ULL;
+
+#ifdef BSLMT_THREAD_LOCAL_VARIABLE
+BSLMT_THREAD_LOCAL_VARIABLE(bsls::Types::Uint64, g_levelState, 0);
+#else
+bsls::AtomicUint64 g_levelState(0);
+#endif
+
+inline
+bsls::Types::Uint64 mix(bsls::Types::Uint64 value)
+    // Return the 'splitmix64' finalization of the specified 'value'.
+{
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+inline
+bsls::Types::Uint64 nextRandom()
+    // Return the next output of the level generator of the calling thread.
+{
+#ifdef BSLMT_THREAD_LOCAL_VARIABLE
+    bsls::Types::Uint64 state = g_levelState;
+    if (0 == state) {
+        state = mix(bslmt::ThreadUtil::selfIdAsUint64() + k_GOLDEN_GAMMA);
+    }
+    state += k_GOLDEN_GAMMA;
+    g_levelState = state;
+#else
+    bsls::Types::Uint64 state = g_levelState.addRelaxed(k_GOLDEN_GAMMA);
+#endif
+    return mix(state);
+}
+
+}  // close unnamed namespace
+
+namespace bdlcc {
+
+               // --------------------------------------------
+               // struct LockFreeSkipList_RandomLevelGenerator
+               // --------------------------------------------
+
+// CLASS METHODS
+int LockFreeSkipList_RandomLevelGenerator::randomLevel()
+{
+    // Each pair of trailing zero bits raises the level by one, so that level
+    // 'l' is chosen with probability '3 * 4^-(l + 1)'.
+
+    const bsl::uint64_t random = nextRandom() | (bsl::uint64_t(1) << 62);
+
+    return bdlb::BitUtil::numTrailingUnsetBits(random) / 2;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License.  You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
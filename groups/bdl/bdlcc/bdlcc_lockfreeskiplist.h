@@ -0,0 +1,1751 @@
+// bdlcc_lockfreeskiplist.h                                           -*-C++-*-
+#ifndef INCLUDED_BDLCC_LOCKFREESKIPLIST
+#define INCLUDED_BDLCC_LOCKFREESKIPLIST
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a lock-free ordered associative container (Skip List).
+//
+//@CLASSES:
+//  bdlcc::LockFreeSkipList: lock-free ordered map allowing duplicate keys
+//  bdlcc::LockFreeSkipListPair: type for opaque pointers
+//  bdlcc::LockFreeSkipListPairHandle: scope mechanism for safe item references
+//
+//@SEE_ALSO: bdlcc_skiplist, bdlcc_epochmanager
+//
+//@DESCRIPTION: This component provides a thread-safe associative Skip List
+// container, 'bdlcc::LockFreeSkipList', whose insertion, lookup, and removal
+// operations do not acquire a lock.  Like 'bdlcc::SkipList', a
+// 'bdlcc::LockFreeSkipList' stores objects of a parameterized 'DATA' type,
+// ordered by values of a parameterized 'KEY' type, and identifies the
+// associations (pairs) in the list by 'bdlcc::LockFreeSkipListPairHandle'
+// objects or 'bdlcc::LockFreeSkipListPair' pointers, which remain valid (and
+// keep the key and data of the pair alive) after the pair has been removed
+// from the list, until they are released.  The rules governing the use of
+// 'bdlcc::SkipListPair' pointers (see {'bdlcc_skiplist'}) apply unchanged to
+// 'bdlcc::LockFreeSkipListPair' pointers.
+//
+// 'bdlcc::SkipList' serializes every operation on a single mutex, which
+// becomes a point of contention when many threads insert into (e.g., schedule
+// events in) the same list.  Threads inserting into, searching, or removing
+// from a 'bdlcc::LockFreeSkipList' instead synchronize by single-word
+// compare-and-swap operations on the links of the nodes they modify, so that
+// operations on different parts of the list proceed in parallel, and a thread
+// that is suspended during an operation never prevents other threads from
+// completing theirs.
+//
+// The interface of 'bdlcc::LockFreeSkipList' is the subset of the interface of
+// 'bdlcc::SkipList' that can be provided without a lock: the list is linked
+// in the forward direction only, so that there are no "R" methods and no
+// 'back' or 'previous' methods, and the key of a pair in the list cannot be
+// changed (i.e., there are no 'update' methods); to re-key a pair, remove it
+// and add a new pair.  Copy construction, assignment, and comparison of lists
+// are not supported.
+//
+///Duplicate Keys
+///--------------
+// A 'bdlcc::LockFreeSkipList' may contain multiple pairs having the same key.
+// Pairs with equivalent keys are ordered by the order in which they were
+// added: 'add' places the new pair *after* all pairs already in the list
+// having an equivalent key (i.e., like 'bdlcc::SkipList::addR').  This
+// guarantees, for example, that events scheduled for the same time are popped
+// in the order in which they were scheduled.
+//
+///Node Levels
+///-----------
+// The level of each new node is chosen by a pseudo-random generator private
+// to the calling thread, so that, unlike 'bdlcc::SkipList', threads adding
+// pairs do not contend on the state of a shared generator.  Note that this
+// component also maintains a (shared) atomic counter used to order pairs
+// having equivalent keys.
+//
+///Template Requirements
+///---------------------
+// The 'bdlcc::LockFreeSkipList' ordered associative container is parameterized
+// on two types, 'KEY' and 'DATA'.  Each type must have a public copy
+// constructor, and it is important to declare the "Uses bslma Allocator" trait
+// if the type accepts a 'bslma::Allocator' in its constructor.  In addition,
+// operator '<' must be defined for the type 'KEY', and must define a Strict
+// Weak Ordering on 'KEY' values.  The key and data of a pair are destroyed by
+// the thread that releases the last reference to the pair, which is not
+// necessarily the thread that removed the pair from the list.
+//
+///Memory Reclamation
+///------------------
+// A node that has been unlinked from the list may still be examined by
+// threads that obtained its address before it was unlinked.  Each
+// 'bdlcc::LockFreeSkipList' therefore owns a 'bdlcc::EpochManager': every
+// operation on the list is performed within a critical section of the epoch
+// manager, and a removed node is retired to the epoch manager once it is
+// unlinked from every level of the list.  The memory of a node is returned to
+// the allocator when the epoch manager has determined that no thread can
+// still be traversing the node, and all references to the pair have been
+// released.  Consequently, the memory held by the list lags behind the number
+// of pairs in it by (a bounded number of) recently removed nodes.
+//
+///Thread Safety
+///-------------
+// 'bdlcc::LockFreeSkipList' is fully thread-safe, meaning that all non-creator
+// operations on an object can be safely invoked simultaneously from multiple
+// threads.  Note that the result of 'length' and 'isEmpty' is a snapshot that
+// may be out of date as soon as it is returned.  Each thread accessing a list
+// is registered with the epoch manager of the list on its first access, which
+// allocates memory from the allocator of the list; threads that access many
+// short-lived lists should therefore prefer a pooling allocator.  The
+// allocator supplied at construction must be thread-safe.
+//
+///Exception Safety
+///----------------
+// 'bdlcc::LockFreeSkipList' is exception neutral: if an exception is thrown by
+// the allocator or by the copy constructor of 'KEY' or 'DATA' while a pair is
+// being added, the list is left unchanged.  If an exception is thrown by the
+// allocator while a removed node is being retired to the epoch manager (which
+// allocates memory only as its lists of retired nodes grow), the node is
+// removed from the list but its memory is not reclaimed.
+//
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: A Timer Queue Shared by Many Producers
+///- - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that many threads schedule timers in a queue from which a single
+// dispatcher thread pops those that have expired, and that scheduled timers
+// can be cancelled by the threads that scheduled them.
+//
+// First, we define the queue, keyed on the expiration time of each timer:
+//..
+//  typedef bdlcc::LockFreeSkipList<bsls::Types::Int64, bsl::string>
+//                                                                TimerQueue;
+//
+//  TimerQueue queue;
+//..
+// Then, threads schedule timers, keeping a handle to each timer they may want
+// to cancel.  Note that timers having equal expiration times are dispatched in
+// the order in which they were scheduled:
+//..
+//  TimerQueue::PairHandle h1;
+//  TimerQueue::PairHandle h2;
+//
+//  queue.add(&h1, 300, "third");
+//  queue.add(&h2, 100, "first");
+//  queue.add(200, "second");
+//  queue.add(300, "fourth");
+//  assert(4 == queue.length());
+//..
+// Next, a timer is cancelled using its handle; removing it a second time
+// fails:
+//..
+//  assert(0 == queue.remove(h1));
+//  assert(0 != queue.remove(h1));
+//  assert("third" == h1.data());    // the handle still refers to the pair
+//..
+// Now, the dispatcher pops the timers having expired by time 250:
+//..
+//  TimerQueue::PairHandle timer;
+//  while (0 == queue.front(&timer) && timer.key() <= 250) {
+//      if (0 == queue.remove(timer)) {
+//          // ... dispatch 'timer.data()' ...
+//      }
+//  }
+//  assert(1 == queue.length());
+//..
+// Finally, we observe that the remaining timer is the one scheduled last:
+//..
+//  assert(0 == queue.popFront(&timer));
+//  assert("fourth" == timer.data());
+//  assert(queue.isEmpty());
+//..
+
+#include <bdlscm_version.h>
+
+#include <bdlcc_epochmanager.h>
+
+#include <bslalg_scalarprimitives.h>
+
+#include <bslma_allocator.h>
+#include <bslma_deallocatorproctor.h>
+#include <bslma_default.h>
+#include <bslma_destructorproctor.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bsls_assert.h>
+#include <bsls_atomic.h>
+#include <bsls_objectbuffer.h>
+#include <bsls_types.h>
+
+#include <bsl_new.h>
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace bdlcc {
+
+template <class KEY, class DATA>
+class LockFreeSkipList;
+
+               // ============================================
+               // struct LockFreeSkipList_RandomLevelGenerator
+               // ============================================
+
+struct LockFreeSkipList_RandomLevelGenerator {
+    // This component-private utility chooses the levels of new list nodes
+    // using a pseudo-random generator private to the calling thread.
+
+    // CONSTANTS
+    enum {
+        k_MAX_LEVEL = 31  // Also defined in 'LockFreeSkipList'
+    };
+
+    // CLASS METHODS
+    static int randomLevel();
+        // Return a pseudo-random integer in the range '[0, k_MAX_LEVEL]',
+        // where each value 'l' is returned with probability proportional to
+        // '4^-l'.
+};
+
+                    // ==================================
+                    // local struct LockFreeSkipList_Node
+                    // ==================================
+
+template <class KEY, class DATA>
+struct LockFreeSkipList_Node {
+    // This component-private structure is a node in a 'LockFreeSkipList'.
+    // The low-order bit of a link is set when the node holding the link has
+    // been (logically) removed from the level of the list to which the link
+    // belongs.
+
+    // TYPES
+    typedef bsls::AtomicPointer<LockFreeSkipList_Node> Link;
+
+    enum {
+        e_LINKED  = 1,  // the thread adding the node has finished linking it
+        e_REMOVED = 2   // the node has been removed from the list
+    };
+
+    // PUBLIC DATA
+    bsls::AtomicInt           d_refCount;  // references, including the one
+                                           // held by the list until the node
+                                           // is reclaimed
+
+    bsls::AtomicInt           d_state;     // 'e_LINKED' and 'e_REMOVED' bits
+
+    bsls::Types::Uint64       d_sequence;  // orders equivalent keys
+
+    int                       d_level;     // highest level of the node
+
+    bsls::ObjectBuffer<KEY>   d_key;
+
+    bsls::ObjectBuffer<DATA>  d_data;
+
+    Link                      d_next[1];   // Must be last; each node has
+                                           // space for 'd_level' additional
+                                           // links.
+};
+
+                         // ==========================
+                         // class LockFreeSkipListPair
+                         // ==========================
+
+template <class KEY, class DATA>
+class LockFreeSkipListPair {
+    // Pointers to objects of this class are used in the "raw" API of
+    // 'LockFreeSkipList'; however, objects of the class are never constructed
+    // as the class serves only to provide type-safe pointers.
+
+    // DATA
+    LockFreeSkipList_Node<KEY, DATA> d_node;    // never directly accessed
+
+  private:
+    // NOT IMPLEMENTED
+    LockFreeSkipListPair();
+    LockFreeSkipListPair(const LockFreeSkipListPair&);
+    LockFreeSkipListPair& operator=(const LockFreeSkipListPair&);
+
+  public:
+    // ACCESSORS
+    DATA& data() const;
+        // Return a reference to the modifiable "data" of this pair.
+
+    const KEY& key() const;
+        // Return a reference to the non-modifiable "key" value of this pair.
+};
+
+                      // ================================
+                      // class LockFreeSkipListPairHandle
+                      // ================================
+
+template <class KEY, class DATA>
+class LockFreeSkipListPairHandle {
+    // Objects of this class refer to an association (pair) in a
+    // 'LockFreeSkipList'.  A 'bdlcc::LockFreeSkipListPairHandle' is implicitly
+    // convertible to a 'const Pair*' and thus may be used anywhere in the
+    // 'LockFreeSkipList' API that a 'const Pair*' is expected.
+
+    // PRIVATE TYPES
+    typedef LockFreeSkipListPair<KEY, DATA> Pair;
+
+    // DATA
+    LockFreeSkipList<KEY, DATA> *d_list_p;
+    Pair                        *d_node_p;
+
+    // FRIENDS
+    friend class LockFreeSkipList<KEY, DATA>;
+
+  private:
+    // PRIVATE CREATORS
+    LockFreeSkipListPairHandle(LockFreeSkipList<KEY, DATA> *list,
+                               Pair                        *reference);
+        // Construct a new pair handle for the specified 'list' that manages
+        // the specified 'reference'.  Note that it is assumed that the
+        // creating (calling) scope already owns the 'reference'.
+
+    // PRIVATE MANIPULATORS
+    void reset(const LockFreeSkipList<KEY, DATA> *list, Pair *reference);
+        // Change this 'LockFreeSkipListPairHandle' to manage the specified
+        // 'reference' in the specified 'list'.  If this handle refers to a
+        // pair, release the reference.  Note that it is assumed that the
+        // calling scope already owns the 'reference'.
+
+  public:
+    // CREATORS
+    LockFreeSkipListPairHandle();
+        // Construct a new pair handle that does not refer to a pair.
+
+    LockFreeSkipListPairHandle(const LockFreeSkipListPairHandle& original);
+        // Construct a new pair handle for the same list and pair as the
+        // specified 'original'.
+
+    ~LockFreeSkipListPairHandle();
+        // Destroy this pair handle.  If this handle refers to a pair, release
+        // the reference.
+
+    // MANIPULATORS
+    LockFreeSkipListPairHandle& operator=(
+                                        const LockFreeSkipListPairHandle& rhs);
+        // Change this pair handle to refer to the same list and pair as the
+        // specified 'rhs'.  If this handle initially refers to a pair, release
+        // the reference.  Return '*this'.
+
+    void release();
+        // Release the reference (if any) managed by this pair handle.
+
+    void releaseReferenceRaw(LockFreeSkipList<KEY, DATA> **list,
+                             Pair                        **reference);
+        // Load into the specified 'list' and 'reference' the list and
+        // reference values of this pair handle, and reset this handle so that
+        // it does not refer to a pair, *without* releasing the reference,
+        // which the caller must release (using
+        // 'LockFreeSkipList::releaseReferenceRaw') when it is no longer
+        // needed.
+
+    // ACCESSORS
+    operator const Pair*() const;
+        // Return the address of the pair referred to by this pair handle, or
+        // 0 if this handle does not manage a reference.
+
+    DATA& data() const;
+        // Return a reference to the "data" value of the pair referred to by
+        // this object.  The behavior is undefined unless 'isValid' returns
+        // 'true'.
+
+    const KEY& key() const;
+        // Return a reference to the non-modifiable "key" value of the pair
+        // referred to by this object.  The behavior is undefined unless
+        // 'isValid' returns 'true'.
+
+    bool isValid() const;
+        // Return 'true' if this pair handle currently refers to a pair, and
+        // 'false' otherwise.
+};
+
+                           // ======================
+                           // class LockFreeSkipList
+                           // ======================
+
+template <class KEY, class DATA>
+class LockFreeSkipList {
+    // This class provides a generic thread-safe Skip List (an ordered
+    // associative container) whose operations do not acquire a lock.
+
+  public:
+    // CONSTANTS
+    enum {
+        e_SUCCESS   = 0,
+        e_NOT_FOUND = 1,
+        e_DUPLICATE = 2
+    };
+
+    // TYPES
+    typedef LockFreeSkipListPair<KEY, DATA>       Pair;
+    typedef LockFreeSkipListPairHandle<KEY, DATA> PairHandle;
+
+  private:
+    // PRIVATE CONSTANTS
+    enum {
+        k_MAX_NUM_LEVELS = 32,  // Also defined in RandomLevelGenerator
+
+        k_MAX_LEVEL      = 31
+    };
+
+    // PRIVATE TYPES
+    typedef LockFreeSkipList_Node<KEY, DATA>      Node;
+    typedef typename Node::Link                   Link;
+    typedef LockFreeSkipList_RandomLevelGenerator LevelGenerator;
+    typedef bsls::Types::Uint64                   Uint64;
+    typedef bsls::Types::UintPtr                  UintPtr;
+
+    // DATA
+    bslma::Allocator     *d_allocator_p;   // memory allocator (held, not
+                                           // owned)
+
+    Node                 *d_head_p;        // sentinel node having
+                                           // 'k_MAX_NUM_LEVELS' levels (owned)
+
+    bsls::AtomicInt       d_listLevel;     // highest level of any node ever
+                                           // added
+
+    bsls::AtomicInt       d_length;        // number of pairs in the list
+
+    bsls::AtomicUint64    d_sequence;      // source of sequence numbers
+                                           // ordering equivalent keys
+
+    mutable EpochManager  d_epochManager;  // reclaims unlinked nodes
+
+    // FRIENDS
+    friend class LockFreeSkipListPair<KEY, DATA>;
+    friend class LockFreeSkipListPairHandle<KEY, DATA>;
+
+    // NOT IMPLEMENTED
+    LockFreeSkipList(const LockFreeSkipList&);
+    LockFreeSkipList& operator=(const LockFreeSkipList&);
+
+    // PRIVATE CLASS METHODS
+    static DATA& data(const Pair *reference);
+        // Return a non-'const' reference to the "data" value of the pair
+        // identified by the specified 'reference'.
+
+    static bool isMarked(const Node *link);
+        // Return 'true' if the mark bit of the specified 'link' is set, and
+        // 'false' otherwise.
+
+    static const KEY& key(const Pair *reference);
+        // Return a 'const' reference to the "key" value of the pair
+        // identified by the specified 'reference'.
+
+    static bool less(const Node *node, const KEY& key, Uint64 sequence);
+        // Return 'true' if the specified 'node' is ordered before the
+        // position identified by the specified 'key' and 'sequence' number,
+        // and 'false' otherwise.
+
+    static Node *marked(Node *link);
+        // Return the specified 'link' having its mark bit set.
+
+    static Node *pairToNode(const Pair *reference);
+        // Cast the specified 'reference' to a 'Node *'.
+
+    static void releaseNode(Node *node, bslma::Allocator *allocator);
+        // Release a reference to the specified 'node', and, if it was the last
+        // reference, destroy the pair it holds and return its memory to the
+        // specified 'allocator'.
+
+    static void releaseRetiredNode(void *node, void *allocator);
+        // Release the reference held by the list to the specified 'node',
+        // whose memory was supplied by the specified 'allocator'.  This
+        // function is invoked by the epoch manager once no thread can be
+        // traversing 'node'.
+
+    static Node *unmarked(Node *link);
+        // Return the specified 'link' having its mark bit cleared.
+
+    // PRIVATE MANIPULATORS
+    Node *allocateNode(const KEY& key, const DATA& data);
+        // Return a new node, having a single reference, holding a copy of the
+        // specified 'key' and 'data'.
+
+    void finishRemoval(Node *node);
+        // Unlink the specified 'node', which has been removed from the list
+        // and is no longer being linked into the list, from every level of
+        // the list and retire it.  The behavior is undefined unless the
+        // calling thread is within a critical section of the epoch manager.
+
+    int insertNode(bool *newFrontFlag, Node *node, bool uniqueFlag);
+        // Link the specified 'node' into the list after all nodes having a
+        // key equivalent to that of 'node'.  If the specified 'uniqueFlag' is
+        // 'true' and the list contains a pair having a key equivalent to that
+        // of 'node', return 'e_DUPLICATE' with no effect.  If the specified
+        // 'newFrontFlag' is not 0, load into it 'true' if 'node' was inserted
+        // at the front of the list, and 'false' otherwise.  Return 0 on
+        // success.
+
+    void raiseListLevel(int level);
+        // Raise the level of the list to at least the specified 'level'.
+
+    int removeNode(Node *node);
+        // Remove the specified 'node' from the list.  Return 0 on success, and
+        // 'e_NOT_FOUND' if 'node' has already been removed.  The behavior is
+        // undefined unless the calling thread is within a critical section of
+        // the epoch manager.
+
+    void search(Node   **preds,
+                Node   **succs,
+                const KEY&  key,
+                Uint64      sequence);
+        // Load into the specified 'preds' and 'succs', for each level of the
+        // list, the last node ordered before the position identified by the
+        // specified 'key' and 'sequence' number, and the node following it,
+        // unlinking from the list any removed nodes encountered.  The
+        // behavior is undefined unless the calling thread is within a
+        // critical section of the epoch manager.
+
+    // PRIVATE ACCESSORS
+    Node *findNode(const KEY& key, Uint64 sequence) const;
+        // Return the first node in the list, not yet removed, that is not
+        // ordered before the position identified by the specified 'key' and
+        // 'sequence' number, or 0 if there is no such node.  The behavior is
+        // undefined unless the calling thread is within a critical section of
+        // the epoch manager.
+
+    Node *frontNode() const;
+        // Return the first node in the list not yet removed, or 0 if there is
+        // no such node.  The behavior is undefined unless the calling thread
+        // is within a critical section of the epoch manager.
+
+    int loadReference(Pair **result, Node *node) const;
+        // If the specified 'node' is not 0, add a reference to it, load it
+        // into the specified 'result', and return 0; otherwise, return
+        // 'e_NOT_FOUND' with no effect on 'result'.
+
+    int loadReference(PairHandle *result, Node *node) const;
+        // If the specified 'node' is not 0, add a reference to it, load it
+        // into the specified 'result', and return 0; otherwise, return
+        // 'e_NOT_FOUND' with no effect on 'result'.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(LockFreeSkipList,
+                                   bslma::UsesBslmaAllocator);
+
+    // CLASS METHODS
+    static int level(const Pair *reference);
+        // Return the level of the pair identified by the specified
+        // 'reference'.  This method is provided for testing.
+
+    // CREATORS
+    explicit LockFreeSkipList(bslma::Allocator *basicAllocator = 0);
+        // Create an empty Skip List.  Optionally specify a 'basicAllocator'
+        // used to supply memory.  If 'basicAllocator' is 0, the currently
+        // installed default allocator is used.
+
+    ~LockFreeSkipList();
+        // Destroy this Skip List.  The behavior is undefined if references
+        // are outstanding to any pairs in the list, or if any thread is
+        // accessing the list.
+
+    // MANIPULATORS
+    void releaseReferenceRaw(const Pair *reference);
+        // Release the specified 'reference'.  After calling this method, the
+        // value of 'reference' must not be used or released again.
+
+                         // Insertion Methods
+
+    void add(const KEY& key, const DATA& data, bool *newFrontFlag = 0);
+        // Add the specified 'key' / 'data' pair to this list, after any pairs
+        // having an equivalent key.  Load into the optionally specified
+        // 'newFrontFlag' a 'true' value if the pair was added at the front of
+        // the list, and a 'false' value otherwise.
+
+    void add(PairHandle  *result,
+             const KEY&   key,
+             const DATA&  data,
+             bool        *newFrontFlag = 0);
+        // Add the specified 'key' / 'data' pair to this list, after any pairs
+        // having an equivalent key, and load into the specified 'result' a
+        // reference to the pair in the list.  Load into the optionally
+        // specified 'newFrontFlag' a 'true' value if the pair was added at the
+        // front of the list, and a 'false' value otherwise.
+
+    void addRaw(Pair        **result,
+                const KEY&    key,
+                const DATA&   data,
+                bool         *newFrontFlag = 0);
+        // Add the specified 'key' / 'data' pair to this list, after any pairs
+        // having an equivalent key, and load into the specified 'result' a
+        // reference to the pair in the list.  The 'result' reference must be
+        // released (using 'releaseReferenceRaw') when it is no longer needed.
+        // Load into the optionally specified 'newFrontFlag' a 'true' value if
+        // the pair was added at the front of the list, and a 'false' value
+        // otherwise.
+
+    int addUnique(const KEY& key, const DATA& data, bool *newFrontFlag = 0);
+        // Add the specified 'key' / 'data' pair to this list.  Load into the
+        // optionally specified 'newFrontFlag' a 'true' value if the pair was
+        // added at the front of the list, and a 'false' value otherwise.
+        // Return 0 on success, and 'e_DUPLICATE' (with no effect on the list)
+        // if 'key' is already in the list.
+
+    int addUnique(PairHandle  *result,
+                  const KEY&   key,
+                  const DATA&  data,
+                  bool        *newFrontFlag = 0);
+        // Add the specified 'key' / 'data' pair to this list, and load into
+        // the specified 'result' a reference to the pair in the list.  Load
+        // into the optionally specified 'newFrontFlag' a 'true' value if the
+        // pair was added at the front of the list, and a 'false' value
+        // otherwise.  Return 0 on success, and 'e_DUPLICATE' (with no effect
+        // on the list or 'result') if 'key' is already in the list.
+
+    int addUniqueRaw(Pair        **result,
+                     const KEY&    key,
+                     const DATA&   data,
+                     bool         *newFrontFlag = 0);
+        // Add the specified 'key' / 'data' pair to this list, and load into
+        // the specified 'result' a reference to the pair in the list.  The
+        // 'result' reference must be released (using 'releaseReferenceRaw')
+        // when it is no longer needed.  Load into the optionally specified
+        // 'newFrontFlag' a 'true' value if the pair was added at the front of
+        // the list, and a 'false' value otherwise.  Return 0 on success, and
+        // 'e_DUPLICATE' (with no effect on the list or 'result') if 'key' is
+        // already in the list.
+
+                         // Removal Methods
+
+    int popFront(PairHandle *item = 0);
+        // Remove the first item from the list and load a reference to it into
+        // the optionally specified 'item'.  Return 0 on success, and a
+        // non-zero value if the list is empty.
+
+    int popFrontRaw(Pair **item);
+        // Remove the first item from the list and load a reference to it into
+        // the specified 'item'.  This reference must be released (using
+        // 'releaseReferenceRaw') when it is no longer needed.  Return 0 on
+        // success, and a non-zero value if the list is empty.
+
+    int remove(const Pair *reference);
+        // Remove the item identified by the specified 'reference' from the
+        // list.  Return 0 on success, and a non-zero value if the pair has
+        // already been removed from the list.
+
+    int removeAll(bsl::vector<PairHandle> *removed = 0);
+        // Remove all items from this list.  Load into the optionally specified
+        // 'removed' vector handles that can be used to refer to the removed
+        // items.  Note that the items in 'removed' will be in ascending order
+        // by key value.  Note also that all references in 'removed' must be
+        // released (i.e., destroyed) before this skip list is destroyed.
+        // Return the number of items that were removed from this list.  Note
+        // that items added concurrently with a call to this method may or may
+        // not be removed.
+
+    int removeAllRaw(bsl::vector<Pair *> *removed);
+        // Remove all items from this list.  Load into the specified 'removed'
+        // vector pointers that can be used to refer to the removed items.
+        // *Each* such pointer must be released (using 'releaseReferenceRaw')
+        // when it is no longer needed.  Note that the pairs in 'removed' will
+        // be in ascending order by key value.  Return the number of items
+        // that were removed from this list.
+
+    // ACCESSORS
+    Pair *addPairReferenceRaw(const Pair *reference) const;
+        // Increment the reference count for the list element referred to by
+        // the specified 'reference'.  There must be a corresponding call to
+        // 'releaseReferenceRaw' when the reference is no longer needed.  The
+        // behavior is undefined if 'reference' has already been released.
+        // Return 'reference'.
+
+    bool exists(const KEY& key) const;
+        // Return 'true' if there is a pair in the list with the specified
+        // 'key', and 'false' otherwise.
+
+    int front(PairHandle *front) const;
+        // Load into the specified 'front' a reference to the first item in the
+        // list.  Return 0 on success, and a non-zero value (with no effect on
+        // 'front') if the list is empty.
+
+    int frontRaw(Pair **front) const;
+        // Load into the specified 'front' a reference to the first item in the
+        // list.  The 'front' reference must be released (using
+        // 'releaseReferenceRaw') when it is no longer needed.  Return 0 on
+        // success, and a non-zero value if the list is empty.
+
+    bool isEmpty() const;
+        // Return 'true' if this list is empty, and 'false' otherwise.
+
+    int length() const;
+        // Return the number of items in this list.
+
+                            // finds
+
+    int find(PairHandle *item, const KEY& key) const;
+        // Load into the specified 'item' a reference to the first element in
+        // this list having the specified 'key'.  Return 0 on success, and a
+        // non-zero value (with no effect on 'item') if no such element exists.
+
+    int findRaw(Pair **item, const KEY& key) const;
+        // Load into the specified 'item' a reference to the first element in
+        // this list having the specified 'key'.  The 'item' reference must be
+        // released (using 'releaseReferenceRaw') when it is no longer needed.
+        // Return 0 on success, and a non-zero value (with no effect on 'item')
+        // if no such element exists.
+
+    int findLowerBound(PairHandle *item, const KEY& key) const;
+        // Load into the specified 'item' a reference to the first element in
+        // this list whose key value is not less than the specified 'key'.
+        // Return 0 on success, and a non-zero value (with no effect on 'item')
+        // if no such element exists.
+
+    int findLowerBoundRaw(Pair **item, const KEY& key) const;
+        // Load into the specified 'item' a reference to the first element in
+        // this list whose key value is not less than the specified 'key'.  The
+        // 'item' reference must be released (using 'releaseReferenceRaw') when
+        // it is no longer needed.  Return 0 on success, and a non-zero value
+        // (with no effect on 'item') if no such element exists.
+
+    int findUpperBound(PairHandle *item, const KEY& key) const;
+        // Load into the specified 'item' a reference to the first element in
+        // this list whose key value is greater than the specified 'key'.
+        // Return 0 on success, and a non-zero value (with no effect on 'item')
+        // if no such element exists.
+
+    int findUpperBoundRaw(Pair **item, const KEY& key) const;
+        // Load into the specified 'item' a reference to the first element in
+        // this list whose key value is greater than the specified 'key'.  The
+        // 'item' reference must be released (using 'releaseReferenceRaw') when
+        // it is no longer needed.  Return 0 on success, and a non-zero value
+        // (with no effect on 'item') if no such element exists.
+
+                            // next & skipForward
+
+    int next(PairHandle *next, const Pair *reference) const;
+        // Load into the specified 'next' a reference to the item that appears
+        // in the list after the item identified by the specified 'reference'.
+        // Return 0 on success, and a non-zero value (with no effect on 'next')
+        // if 'reference' refers to the back of the list or has been removed
+        // from the list.
+
+    int nextRaw(Pair **next, const Pair *reference) const;
+        // Load into the specified 'next' a reference to the item that appears
+        // in the list after the item identified by the specified 'reference'.
+        // The 'next' reference must be released (using 'releaseReferenceRaw')
+        // when it is no longer needed.  Return 0 on success, and a non-zero
+        // value (with no effect on 'next') if 'reference' refers to the back
+        // of the list or has been removed from the list.
+
+    int skipForward(PairHandle *item) const;
+    int skipForwardRaw(Pair **item) const;
+        // If the item identified by the specified 'item' is not at the end of
+        // the list, load a reference to the next item in the list into 'item';
+        // otherwise reset the value of 'item'.  Return 0 on success, and
+        // 'e_NOT_FOUND' (with no effect on the value of 'item') if 'item' is
+        // no longer in the list.
+
+                                  // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this object to supply memory.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                         // --------------------------
+                         // class LockFreeSkipListPair
+                         // --------------------------
+
+// ACCESSORS
+template <class KEY, class DATA>
+inline
+DATA& LockFreeSkipListPair<KEY, DATA>::data() const
+{
+    return LockFreeSkipList<KEY, DATA>::data(this);
+}
+
+template <class KEY, class DATA>
+inline
+const KEY& LockFreeSkipListPair<KEY, DATA>::key() const
+{
+    return LockFreeSkipList<KEY, DATA>::key(this);
+}
+
+                      // --------------------------------
+                      // class LockFreeSkipListPairHandle
+                      // --------------------------------
+
+// PRIVATE CREATORS
+template <class KEY, class DATA>
+inline
+LockFreeSkipListPairHandle<KEY, DATA>::LockFreeSkipListPairHandle(
+                                        LockFreeSkipList<KEY, DATA> *list,
+                                        Pair                        *reference)
+: d_list_p(list)
+, d_node_p(reference)
+{
+}
+
+// PRIVATE MANIPULATORS
+template <class KEY, class DATA>
+inline
+void LockFreeSkipListPairHandle<KEY, DATA>::reset(
+                                  const LockFreeSkipList<KEY, DATA> *list,
+                                  Pair                              *reference)
+{
+    release();
+    d_list_p = const_cast<LockFreeSkipList<KEY, DATA> *>(list);
+    d_node_p = reference;
+}
+
+// CREATORS
+template <class KEY, class DATA>
+inline
+LockFreeSkipListPairHandle<KEY, DATA>::LockFreeSkipListPairHandle()
+: d_list_p(0)
+, d_node_p(0)
+{
+}
+
+template <class KEY, class DATA>
+inline
+LockFreeSkipListPairHandle<KEY, DATA>::LockFreeSkipListPairHandle(
+                                 const LockFreeSkipListPairHandle& original)
+: d_list_p(original.d_list_p)
+, d_node_p(original.d_node_p
+           ? original.d_list_p->addPairReferenceRaw(original.d_node_p)
+           : 0)
+{
+}
+
+template <class KEY, class DATA>
+inline
+LockFreeSkipListPairHandle<KEY, DATA>::~LockFreeSkipListPairHandle()
+{
+    release();
+}
+
+// MANIPULATORS
+template <class KEY, class DATA>
+inline
+LockFreeSkipListPairHandle<KEY, DATA>&
+LockFreeSkipListPairHandle<KEY, DATA>::operator=(
+                                         const LockFreeSkipListPairHandle& rhs)
+{
+    if (this != &rhs) {
+        reset(rhs.d_list_p,
+              rhs.d_node_p ? rhs.d_list_p->addPairReferenceRaw(rhs.d_node_p)
+                           : 0);
+    }
+    return *this;
+}
+
+template <class KEY, class DATA>
+inline
+void LockFreeSkipListPairHandle<KEY, DATA>::release()
+{
+    if (d_node_p) {
+        d_list_p->releaseReferenceRaw(d_node_p);
+        d_node_p = 0;
+    }
+}
+
+template <class KEY, class DATA>
+inline
+void LockFreeSkipListPairHandle<KEY, DATA>::releaseReferenceRaw(
+                                    LockFreeSkipList<KEY, DATA> **list,
+                                    Pair                        **reference)
+{
+    BSLS_ASSERT(list);
+    BSLS_ASSERT(reference);
+
+    *list      = d_list_p;
+    *reference = d_node_p;
+    d_list_p   = 0;
+    d_node_p   = 0;
+}
+
+// ACCESSORS
+template <class KEY, class DATA>
+inline
+LockFreeSkipListPairHandle<KEY, DATA>::operator const Pair*() const
+{
+    return d_node_p;
+}
+
+template <class KEY, class DATA>
+inline
+DATA& LockFreeSkipListPairHandle<KEY, DATA>::data() const
+{
+    BSLS_ASSERT(isValid());
+
+    return d_node_p->data();
+}
+
+template <class KEY, class DATA>
+inline
+const KEY& LockFreeSkipListPairHandle<KEY, DATA>::key() const
+{
+    BSLS_ASSERT(isValid());
+
+    return d_node_p->key();
+}
+
+template <class KEY, class DATA>
+inline
+bool LockFreeSkipListPairHandle<KEY, DATA>::isValid() const
+{
+    return d_list_p && d_node_p;
+}
+
+                           // ----------------------
+                           // class LockFreeSkipList
+                           // ----------------------
+
+// PRIVATE CLASS METHODS
+template <class KEY, class DATA>
+inline
+DATA& LockFreeSkipList<KEY, DATA>::data(const Pair *reference)
+{
+    return pairToNode(reference)->d_data.object();
+}
+
+template <class KEY, class DATA>
+inline
+bool LockFreeSkipList<KEY, DATA>::isMarked(const Node *link)
+{
+    return reinterpret_cast<UintPtr>(link) & 1;
+}
+
+template <class KEY, class DATA>
+inline
+const KEY& LockFreeSkipList<KEY, DATA>::key(const Pair *reference)
+{
+    return pairToNode(reference)->d_key.object();
+}
+
+template <class KEY, class DATA>
+inline
+bool LockFreeSkipList<KEY, DATA>::less(const Node *node,
+                                       const KEY&  key,
+                                       Uint64      sequence)
+{
+    const KEY& nodeKey = node->d_key.object();
+
+    if (nodeKey < key) {
+        return true;                                                  // RETURN
+    }
+    return !(key < nodeKey) && node->d_sequence < sequence;
+}
+
+template <class KEY, class DATA>
+inline
+typename LockFreeSkipList<KEY, DATA>::Node *
+LockFreeSkipList<KEY, DATA>::marked(Node *link)
+{
+    return reinterpret_cast<Node *>(reinterpret_cast<UintPtr>(link) | 1);
+}
+
+template <class KEY, class DATA>
+inline
+typename LockFreeSkipList<KEY, DATA>::Node *
+LockFreeSkipList<KEY, DATA>::pairToNode(const Pair *reference)
+{
+    return static_cast<Node *>(static_cast<void *>(
+                                               const_cast<Pair *>(reference)));
+}
+
+template <class KEY, class DATA>
+void LockFreeSkipList<KEY, DATA>::releaseNode(Node             *node,
+                                              bslma::Allocator *allocator)
+{
+    BSLS_ASSERT(node);
+
+    if (0 == node->d_refCount.addAcqRel(-1)) {
+        node->d_key.object().~KEY();
+        node->d_data.object().~DATA();
+        allocator->deallocate(node);
+    }
+}
+
+template <class KEY, class DATA>
+void LockFreeSkipList<KEY, DATA>::releaseRetiredNode(void *node,
+                                                     void *allocator)
+{
+    releaseNode(static_cast<Node *>(node),
+                static_cast<bslma::Allocator *>(allocator));
+}
+
+template <class KEY, class DATA>
+inline
+typename LockFreeSkipList<KEY, DATA>::Node *
+LockFreeSkipList<KEY, DATA>::unmarked(Node *link)
+{
+    return reinterpret_cast<Node *>(
+                                reinterpret_cast<UintPtr>(link) & ~UintPtr(1));
+}
+
+// PRIVATE MANIPULATORS
+template <class KEY, class DATA>
+typename LockFreeSkipList<KEY, DATA>::Node *
+LockFreeSkipList<KEY, DATA>::allocateNode(const KEY& key, const DATA& data)
+{
+    // Register the calling thread (which may allocate) before allocating the
+    // node, so that the node is not leaked if registration fails.
+
+    d_epochManager.registerThread();
+
+    const int level = LevelGenerator::randomLevel();
+
+    Node *node = static_cast<Node *>(d_allocator_p->allocate(
+                                        sizeof(Node) + level * sizeof(Link)));
+    bslma::DeallocatorProctor<bslma::Allocator> deallocator(node,
+                                                            d_allocator_p);
+
+    bslalg::ScalarPrimitives::copyConstruct(&node->d_key.object(),
+                                            key,
+                                            d_allocator_p);
+    bslma::DestructorProctor<KEY> keyDestructor(&node->d_key.object());
+
+    bslalg::ScalarPrimitives::copyConstruct(&node->d_data.object(),
+                                            data,
+                                            d_allocator_p);
+
+    keyDestructor.release();
+    deallocator.release();
+
+    new (&node->d_refCount) bsls::AtomicInt(1);
+    new (&node->d_state) bsls::AtomicInt(0);
+    node->d_sequence = 0;
+    node->d_level    = level;
+    for (int i = 0; i <= level; ++i) {
+        new (&node->d_next[i]) Link(0);
+    }
+    return node;
+}
+
+template <class KEY, class DATA>
+void LockFreeSkipList<KEY, DATA>::finishRemoval(Node *node)
+{
+    Node *preds[k_MAX_NUM_LEVELS];
+    Node *succs[k_MAX_NUM_LEVELS];
+
+    // Every link of 'node' is marked, hence 'search' unlinks 'node' from
+    // every level on which it is found.
+
+    search(preds, succs, node->d_key.object(), node->d_sequence);
+
+    d_epochManager.retire(node, &releaseRetiredNode, d_allocator_p);
+}
+
+template <class KEY, class DATA>
+int LockFreeSkipList<KEY, DATA>::insertNode(bool *newFrontFlag,
+                                            Node *node,
+                                            bool  uniqueFlag)
+{
+    Node *preds[k_MAX_NUM_LEVELS];
+    Node *succs[k_MAX_NUM_LEVELS];
+
+    const KEY& key   = node->d_key.object();
+    const int  level = node->d_level;
+
+    raiseListLevel(level);
+
+    EpochManagerGuard guard(&d_epochManager);
+
+    node->d_sequence = d_sequence.addRelaxed(1);
+
+    // Link 'node' at level 0, which adds it to the list.
+
+    for (;;) {
+        search(preds, succs, key, node->d_sequence);
+
+        if (uniqueFlag) {
+            // Nodes having a key equivalent to 'key' are found immediately
+            // before or (if added concurrently) immediately after the new
+            // position.
+
+            if ((preds[0] != d_head_p && !(preds[0]->d_key.object() < key))
+             || (succs[0] && !(key < succs[0]->d_key.object()))) {
+                return e_DUPLICATE;                                   // RETURN
+            }
+        }
+
+        for (int i = 0; i <= level; ++i) {
+            node->d_next[i].storeRelaxed(succs[i]);
+        }
+
+        if (succs[0] == preds[0]->d_next[0].testAndSwap(succs[0], node)) {
+            break;
+        }
+    }
+
+    d_length.addRelaxed(1);
+
+    if (newFrontFlag) {
+        *newFrontFlag = preds[0] == d_head_p;
+    }
+
+    // Link 'node' at the higher levels, unless it is removed meanwhile.
+
+    bool linkingFlag = true;
+    for (int i = 1; linkingFlag && i <= level; ++i) {
+        for (;;) {
+            Node *succ = node->d_next[i].load();
+            if (isMarked(succ)
+             || (succ != succs[i]
+              && succ != node->d_next[i].testAndSwap(succ, succs[i]))) {
+                // 'node' is being removed.
+
+                linkingFlag = false;
+                break;
+            }
+            if (succs[i] == preds[i]->d_next[i].testAndSwap(succs[i], node)) {
+                break;
+            }
+            search(preds, succs, key, node->d_sequence);
+        }
+    }
+
+    // If 'node' was removed while it was being linked, the remover left it to
+    // this thread to unlink and retire it.
+
+    if (node->d_state.add(Node::e_LINKED) & Node::e_REMOVED) {
+        finishRemoval(node);
+    }
+    return 0;
+}
+
+template <class KEY, class DATA>
+void LockFreeSkipList<KEY, DATA>::raiseListLevel(int level)
+{
+    int listLevel = d_listLevel.loadRelaxed();
+    while (listLevel < level) {
+        listLevel = d_listLevel.testAndSwap(listLevel, level);
+    }
+}
+
+template <class KEY, class DATA>
+int LockFreeSkipList<KEY, DATA>::removeNode(Node *node)
+{
+    BSLS_ASSERT(node);
+
+    // Mark the links of 'node' from the top down; the thread that marks the
+    // link at level 0 removes 'node'.
+
+    for (int i = node->d_level; i > 0; --i) {
+        Node *succ = node->d_next[i].load();
+        while (!isMarked(succ)) {
+            Node *prev = node->d_next[i].testAndSwap(succ, marked(succ));
+            if (prev == succ) {
+                break;
+            }
+            succ = prev;
+        }
+    }
+
+    Node *succ = node->d_next[0].load();
+    for (;;) {
+        if (isMarked(succ)) {
+            return e_NOT_FOUND;                                       // RETURN
+        }
+        Node *prev = node->d_next[0].testAndSwap(succ, marked(succ));
+        if (prev == succ) {
+            break;
+        }
+        succ = prev;
+    }
+
+    d_length.addRelaxed(-1);
+
+    // Unless the thread adding 'node' is still linking it, unlink it now.
+
+    if (node->d_state.add(Node::e_REMOVED) & Node::e_LINKED) {
+        finishRemoval(node);
+    }
+    return 0;
+}
+
+template <class KEY, class DATA>
+void LockFreeSkipList<KEY, DATA>::search(Node       **preds,
+                                         Node       **succs,
+                                         const KEY&   key,
+                                         Uint64       sequence)
+{
+    const int topLevel = d_listLevel.load();
+
+  retry:
+    Node *pred = d_head_p;
+    for (int i = topLevel; i >= 0; --i) {
+        Node *curr = unmarked(pred->d_next[i].load());
+        while (curr) {
+            Node *succ = curr->d_next[i].load();
+            while (isMarked(succ)) {
+                // 'curr' has been removed; unlink it from this level.
+
+                if (curr != pred->d_next[i].testAndSwap(curr,
+                                                        unmarked(succ))) {
+                    goto retry;
+                }
+                curr = unmarked(succ);
+                if (!curr) {
+                    break;
+                }
+                succ = curr->d_next[i].load();
+            }
+            if (!curr || !less(curr, key, sequence)) {
+                break;
+            }
+            pred = curr;
+            curr = succ;
+        }
+        preds[i] = pred;
+        succs[i] = curr;
+    }
+}
+
+// PRIVATE ACCESSORS
+template <class KEY, class DATA>
+typename LockFreeSkipList<KEY, DATA>::Node *
+LockFreeSkipList<KEY, DATA>::findNode(const KEY& key, Uint64 sequence) const
+{
+    Node *pred = d_head_p;
+    Node *curr = 0;
+    for (int i = d_listLevel.load(); i >= 0; --i) {
+        curr = unmarked(pred->d_next[i].load());
+        while (curr) {
+            Node *succ = curr->d_next[i].load();
+            if (isMarked(succ)) {
+                // Skip over 'curr', which has been removed.
+
+                curr = unmarked(succ);
+                continue;
+            }
+            if (!less(curr, key, sequence)) {
+                break;
+            }
+            pred = curr;
+            curr = succ;
+        }
+    }
+    return curr;
+}
+
+template <class KEY, class DATA>
+typename LockFreeSkipList<KEY, DATA>::Node *
+LockFreeSkipList<KEY, DATA>::frontNode() const
+{
+    Node *node = unmarked(d_head_p->d_next[0].load());
+    while (node) {
+        Node *succ = node->d_next[0].load();
+        if (!isMarked(succ)) {
+            break;
+        }
+        node = unmarked(succ);
+    }
+    return node;
+}
+
+template <class KEY, class DATA>
+inline
+int LockFreeSkipList<KEY, DATA>::loadReference(Pair **result, Node *node) const
+{
+    if (!node) {
+        return e_NOT_FOUND;                                           // RETURN
+    }
+    node->d_refCount.addRelaxed(1);
+    *result = reinterpret_cast<Pair *>(node);
+    return 0;
+}
+
+template <class KEY, class DATA>
+inline
+int LockFreeSkipList<KEY, DATA>::loadReference(PairHandle *result,
+                                               Node       *node) const
+{
+    if (!node) {
+        return e_NOT_FOUND;                                           // RETURN
+    }
+    node->d_refCount.addRelaxed(1);
+    result->reset(this, reinterpret_cast<Pair *>(node));
+    return 0;
+}
+
+// CLASS METHODS
+template <class KEY, class DATA>
+inline
+int LockFreeSkipList<KEY, DATA>::level(const Pair *reference)
+{
+    BSLS_ASSERT(reference);
+
+    return pairToNode(reference)->d_level;
+}
+
+// CREATORS
+template <class KEY, class DATA>
+LockFreeSkipList<KEY, DATA>::LockFreeSkipList(bslma::Allocator *basicAllocator)
+: d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_head_p(0)
+, d_listLevel(0)
+, d_length(0)
+, d_sequence(1)
+, d_epochManager(d_allocator_p)
+{
+    // The head node holds no key or data.
+
+    d_head_p = static_cast<Node *>(d_allocator_p->allocate(
+                                 sizeof(Node) + k_MAX_LEVEL * sizeof(Link)));
+    for (int i = 0; i < k_MAX_NUM_LEVELS; ++i) {
+        new (&d_head_p->d_next[i]) Link(0);
+    }
+    d_head_p->d_level = k_MAX_LEVEL;
+}
+
+template <class KEY, class DATA>
+LockFreeSkipList<KEY, DATA>::~LockFreeSkipList()
+{
+    // Release the reference held by the list to every node still linked;
+    // removed nodes are released by the epoch manager.
+
+    Node *node = unmarked(d_head_p->d_next[0].loadRelaxed());
+    while (node) {
+        Node *next = unmarked(node->d_next[0].loadRelaxed());
+        releaseNode(node, d_allocator_p);
+        node = next;
+    }
+    d_allocator_p->deallocate(d_head_p);
+}
+
+// MANIPULATORS
+template <class KEY, class DATA>
+inline
+void LockFreeSkipList<KEY, DATA>::releaseReferenceRaw(const Pair *reference)
+{
+    BSLS_ASSERT(reference);
+
+    releaseNode(pairToNode(reference), d_allocator_p);
+}
+
+                         // Insertion Methods
+
+template <class KEY, class DATA>
+inline
+void LockFreeSkipList<KEY, DATA>::add(const KEY&   key,
+                                      const DATA&  data,
+                                      bool        *newFrontFlag)
+{
+    insertNode(newFrontFlag, allocateNode(key, data), false);
+}
+
+template <class KEY, class DATA>
+inline
+void LockFreeSkipList<KEY, DATA>::add(PairHandle  *result,
+                                      const KEY&   key,
+                                      const DATA&  data,
+                                      bool        *newFrontFlag)
+{
+    BSLS_ASSERT(result);
+
+    Pair *reference;
+    addRaw(&reference, key, data, newFrontFlag);
+    result->reset(this, reference);
+}
+
+template <class KEY, class DATA>
+void LockFreeSkipList<KEY, DATA>::addRaw(Pair        **result,
+                                         const KEY&    key,
+                                         const DATA&   data,
+                                         bool         *newFrontFlag)
+{
+    BSLS_ASSERT(result);
+
+    Node *node = allocateNode(key, data);
+    node->d_refCount.storeRelaxed(2);
+
+    insertNode(newFrontFlag, node, false);
+    *result = reinterpret_cast<Pair *>(node);
+}
+
+template <class KEY, class DATA>
+inline
+int LockFreeSkipList<KEY, DATA>::addUnique(const KEY&   key,
+                                           const DATA&  data,
+                                           bool        *newFrontFlag)
+{
+    Node *node = allocateNode(key, data);
+
+    int rc = insertNode(newFrontFlag, node, true);
+    if (rc) {
+        releaseNode(node, d_allocator_p);
+    }
+    return rc;
+}
+
+template <class KEY, class DATA>
+inline
+int LockFreeSkipList<KEY, DATA>::addUnique(PairHandle  *result,
+                                           const KEY&   key,
+                                           const DATA&  data,
+                                           bool        *newFrontFlag)
+{
+    BSLS_ASSERT(result);
+
+    Pair *reference;
+    int   rc = addUniqueRaw(&reference, key, data, newFrontFlag);
+    if (0 == rc) {
+        result->reset(this, reference);
+    }
+    return rc;
+}
+
+template <class KEY, class DATA>
+int LockFreeSkipList<KEY, DATA>::addUniqueRaw(Pair        **result,
+                                              const KEY&    key,
+                                              const DATA&   data,
+                                              bool         *newFrontFlag)
+{
+    BSLS_ASSERT(result);
+
+    Node *node = allocateNode(key, data);
+    node->d_refCount.storeRelaxed(2);
+
+    int rc = insertNode(newFrontFlag, node, true);
+    if (rc) {
+        node->d_refCount.storeRelaxed(1);
+        releaseNode(node, d_allocator_p);
+        return rc;                                                    // RETURN
+    }
+    *result = reinterpret_cast<Pair *>(node);
+    return 0;
+}
+
+                         // Removal Methods
+
+template <class KEY, class DATA>
+inline
+int LockFreeSkipList<KEY, DATA>::popFront(PairHandle *item)
+{
+    Pair *reference;
+    int   rc = popFrontRaw(&reference);
+    if (0 == rc) {
+        if (item) {
+            item->reset(this, reference);
+        }
+        else {
+            releaseReferenceRaw(reference);
+        }
+    }
+    return rc;
+}
+
+template <class KEY, class DATA>
+int LockFreeSkipList<KEY, DATA>::popFrontRaw(Pair **item)
+{
+    BSLS_ASSERT(item);
+
+    EpochManagerGuard guard(&d_epochManager);
+
+    for (;;) {
+        Node *node = frontNode();
+        if (!node) {
+            return e_NOT_FOUND;                                       // RETURN
+        }
+        if (0 == removeNode(node)) {
+            // 'node' cannot be reclaimed before this critical section ends.
+
+            return loadReference(item, node);                         // RETURN
+        }
+    }
+}
+
+template <class KEY, class DATA>
+inline
+int LockFreeSkipList<KEY, DATA>::remove(const Pair *reference)
+{
+    BSLS_ASSERT(reference);
+
+    EpochManagerGuard guard(&d_epochManager);
+
+    return removeNode(pairToNode(reference));
+}
+
+template <class KEY, class DATA>
+int LockFreeSkipList<KEY, DATA>::removeAll(bsl::vector<PairHandle> *removed)
+{
+    int numRemoved = 0;
+
+    PairHandle item;
+    while (0 == popFront(removed ? &item : 0)) {
+        if (removed) {
+            removed->push_back(item);
+        }
+        ++numRemoved;
+    }
+    return numRemoved;
+}
+
+template <class KEY, class DATA>
+int LockFreeSkipList<KEY, DATA>::removeAllRaw(bsl::vector<Pair *> *removed)
+{
+    BSLS_ASSERT(removed);
+
+    int numRemoved = 0;
+
+    Pair *item;
+    while (0 == popFrontRaw(&item)) {
+        removed->push_back(item);
+        ++numRemoved;
+    }
+    return numRemoved;
+}
+
+// ACCESSORS
+template <class KEY, class DATA>
+inline
+typename LockFreeSkipList<KEY, DATA>::Pair *
+LockFreeSkipList<KEY, DATA>::addPairReferenceRaw(const Pair *reference) const
+{
+    BSLS_ASSERT(reference);
+
+    Node *node = pairToNode(reference);
+    node->d_refCount.addRelaxed(1);
+    return reinterpret_cast<Pair *>(node);
+}
+
+template <class KEY, class DATA>
+bool LockFreeSkipList<KEY, DATA>::exists(const KEY& key) const
+{
+    EpochManagerGuard guard(&d_epochManager);
+
+    Node *node = findNode(key, 0);
+    return node && !(key < node->d_key.object());
+}
+
+template <class KEY, class DATA>
+inline
+int LockFreeSkipList<KEY, DATA>::front(PairHandle *front) const
+{
+    BSLS_ASSERT(front);
+
+    EpochManagerGuard guard(&d_epochManager);
+
+    return loadReference(front, frontNode());
+}
+
+template <class KEY, class DATA>
+inline
+int LockFreeSkipList<KEY, DATA>::frontRaw(Pair **front) const
+{
+    BSLS_ASSERT(front);
+
+    EpochManagerGuard guard(&d_epochManager);
+
+    return loadReference(front, frontNode());
+}
+
+template <class KEY, class DATA>
+inline
+bool LockFreeSkipList<KEY, DATA>::isEmpty() const
+{
+    EpochManagerGuard guard(&d_epochManager);
+
+    return 0 == frontNode();
+}
+
+template <class KEY, class DATA>
+inline
+int LockFreeSkipList<KEY, DATA>::length() const
+{
+    return d_length.loadRelaxed();
+}
+
+                            // finds
+
+template <class KEY, class DATA>
+inline
+int LockFreeSkipList<KEY, DATA>::find(PairHandle *item, const KEY& key) const
+{
+    BSLS_ASSERT(item);
+
+    EpochManagerGuard guard(&d_epochManager);
+
+    Node *node = findNode(key, 0);
+    return loadReference(item,
+                         node && !(key < node->d_key.object()) ? node : 0);
+}
+
+template <class KEY, class DATA>
+inline
+int LockFreeSkipList<KEY, DATA>::findRaw(Pair **item, const KEY& key) const
+{
+    BSLS_ASSERT(item);
+
+    EpochManagerGuard guard(&d_epochManager);
+
+    Node *node = findNode(key, 0);
+    return loadReference(item,
+                         node && !(key < node->d_key.object()) ? node : 0);
+}
+
+template <class KEY, class DATA>
+inline
+int LockFreeSkipList<KEY, DATA>::findLowerBound(PairHandle *item,
+                                                const KEY&  key) const
+{
+    BSLS_ASSERT(item);
+
+    EpochManagerGuard guard(&d_epochManager);
+
+    return loadReference(item, findNode(key, 0));
+}
+
+template <class KEY, class DATA>
+inline
+int LockFreeSkipList<KEY, DATA>::findLowerBoundRaw(Pair       **item,
+                                                   const KEY&   key) const
+{
+    BSLS_ASSERT(item);
+
+    EpochManagerGuard guard(&d_epochManager);
+
+    return loadReference(item, findNode(key, 0));
+}
+
+template <class KEY, class DATA>
+inline
+int LockFreeSkipList<KEY, DATA>::findUpperBound(PairHandle *item,
+                                                const KEY&  key) const
+{
+    BSLS_ASSERT(item);
+
+    EpochManagerGuard guard(&d_epochManager);
+
+    return loadReference(item, findNode(key, ~Uint64(0)));
+}
+
+template <class KEY, class DATA>
+inline
+int LockFreeSkipList<KEY, DATA>::findUpperBoundRaw(Pair       **item,
+                                                   const KEY&   key) const
+{
+    BSLS_ASSERT(item);
+
+    EpochManagerGuard guard(&d_epochManager);
+
+    return loadReference(item, findNode(key, ~Uint64(0)));
+}
+
+                            // next & skipForward
+
+template <class KEY, class DATA>
+inline
+int LockFreeSkipList<KEY, DATA>::next(PairHandle *next,
+                                      const Pair *reference) const
+{
+    BSLS_ASSERT(next);
+
+    Pair *item;
+    int   rc = nextRaw(&item, reference);
+    if (0 == rc) {
+        next->reset(this, item);
+    }
+    return rc;
+}
+
+template <class KEY, class DATA>
+int LockFreeSkipList<KEY, DATA>::nextRaw(Pair       **next,
+                                         const Pair  *reference) const
+{
+    BSLS_ASSERT(next);
+    BSLS_ASSERT(reference);
+
+    Node *node = pairToNode(reference);
+
+    EpochManagerGuard guard(&d_epochManager);
+
+    if (isMarked(node->d_next[0].load())) {
+        return e_NOT_FOUND;                                           // RETURN
+    }
+
+    // The links of 'node' may refer to nodes that are no longer protected by
+    // the epoch manager once 'node' is removed, so the successor of 'node' is
+    // searched for from the head of the list.
+
+    return loadReference(next,
+                         findNode(node->d_key.object(), node->d_sequence + 1));
+}
+
+template <class KEY, class DATA>
+inline
+int LockFreeSkipList<KEY, DATA>::skipForward(PairHandle *item) const
+{
+    BSLS_ASSERT(item);
+    BSLS_ASSERT(item->isValid());
+
+    Pair *reference = addPairReferenceRaw(*item);
+    int   rc        = skipForwardRaw(&reference);
+    if (0 == rc) {
+        if (reference) {
+            item->reset(this, reference);
+        }
+        else {
+            item->release();
+        }
+    }
+    else {
+        releaseNode(pairToNode(reference), d_allocator_p);
+    }
+    return rc;
+}
+
+template <class KEY, class DATA>
+int LockFreeSkipList<KEY, DATA>::skipForwardRaw(Pair **item) const
+{
+    BSLS_ASSERT(item);
+    BSLS_ASSERT(*item);
+
+    Node *node = pairToNode(*item);
+    Node *next;
+    {
+        EpochManagerGuard guard(&d_epochManager);
+
+        if (isMarked(node->d_next[0].load())) {
+            return e_NOT_FOUND;                                       // RETURN
+        }
+        next = findNode(node->d_key.object(), node->d_sequence + 1);
+        if (next) {
+            next->d_refCount.addRelaxed(1);
+        }
+    }
+    releaseNode(node, d_allocator_p);
+    *item = reinterpret_cast<Pair *>(next);
+    return 0;
+}
+
+                                  // Aspects
+
+template <class KEY, class DATA>
+inline
+bslma::Allocator *LockFreeSkipList<KEY, DATA>::allocator() const
+{
+    return d_allocator_p;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License.  You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
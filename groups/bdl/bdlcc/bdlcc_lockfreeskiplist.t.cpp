@@ -0,0 +1,1372 @@
+// bdlcc_lockfreeskiplist.t.cpp                                       -*-C++-*-
+
+#include <bdlcc_lockfreeskiplist.h>
+
+#include <bdlcc_skiplist.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_threadgroup.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test provides an ordered associative container,
+// 'bdlcc::LockFreeSkipList', whose pairs are referred to by
+// 'bdlcc::LockFreeSkipListPairHandle' objects or 'bdlcc::LockFreeSkipListPair'
+// pointers.
+//
+// We first verify, in a single thread, the primary manipulators ('add' and
+// 'popFront') and the basic accessors, then the reference semantics of pair
+// handles (including the lifetime of removed pairs), the remaining insertion
+// methods, the search methods, and the removal and iteration methods.  The
+// distribution of node levels is checked statistically.  Exception neutrality
+// is verified using the standard 'bslma' exception test macros.  Finally, a
+// stress test has threads concurrently add, find, remove, and pop pairs; the
+// test allocator scribbles over deallocated memory, so that a pair reclaimed
+// while still referenced fails the consistency check of its key and data.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 7] static int level(const Pair *reference);
+//
+// CREATORS
+// [ 2] LockFreeSkipList(bslma::Allocator *basicAllocator = 0);
+// [ 2] ~LockFreeSkipList();
+//
+// MANIPULATORS
+// [ 3] void releaseReferenceRaw(const Pair *reference);
+// [ 2] void add(const KEY& key, const DATA& data, bool *newFrontFlag = 0);
+// [ 3] void add(PairHandle *result, const KEY&, const DATA&, bool * = 0);
+// [ 4] void addRaw(Pair **result, const KEY&, const DATA&, bool * = 0);
+// [ 4] int addUnique(const KEY&, const DATA&, bool *newFrontFlag = 0);
+// [ 4] int addUnique(PairHandle *, const KEY&, const DATA&, bool * = 0);
+// [ 4] int addUniqueRaw(Pair **, const KEY&, const DATA&, bool * = 0);
+// [ 2] int popFront(PairHandle *item = 0);
+// [ 6] int popFrontRaw(Pair **item);
+// [ 6] int remove(const Pair *reference);
+// [ 6] int removeAll(bsl::vector<PairHandle> *removed = 0);
+// [ 6] int removeAllRaw(bsl::vector<Pair *> *removed);
+//
+// ACCESSORS
+// [ 3] Pair *addPairReferenceRaw(const Pair *reference) const;
+// [ 5] bool exists(const KEY& key) const;
+// [ 2] int front(PairHandle *front) const;
+// [ 4] int frontRaw(Pair **front) const;
+// [ 2] bool isEmpty() const;
+// [ 2] int length() const;
+// [ 5] int find(PairHandle *item, const KEY& key) const;
+// [ 5] int findRaw(Pair **item, const KEY& key) const;
+// [ 5] int findLowerBound(PairHandle *item, const KEY& key) const;
+// [ 5] int findLowerBoundRaw(Pair **item, const KEY& key) const;
+// [ 5] int findUpperBound(PairHandle *item, const KEY& key) const;
+// [ 5] int findUpperBoundRaw(Pair **item, const KEY& key) const;
+// [ 6] int next(PairHandle *next, const Pair *reference) const;
+// [ 6] int nextRaw(Pair **next, const Pair *reference) const;
+// [ 6] int skipForward(PairHandle *item) const;
+// [ 6] int skipForwardRaw(Pair **item) const;
+// [ 2] bslma::Allocator *allocator() const;
+//
+// LockFreeSkipListPairHandle
+// [ 3] LockFreeSkipListPairHandle();
+// [ 3] LockFreeSkipListPairHandle(const LockFreeSkipListPairHandle&);
+// [ 3] ~LockFreeSkipListPairHandle();
+// [ 3] operator=(const LockFreeSkipListPairHandle& rhs);
+// [ 3] void release();
+// [ 3] void releaseReferenceRaw(LockFreeSkipList **, Pair **);
+// [ 3] operator const Pair*() const;
+// [ 3] DATA& data() const;
+// [ 3] const KEY& key() const;
+// [ 3] bool isValid() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 8] EXCEPTION SAFETY
+// [ 9] MULTI-THREADED STRESS TEST
+// [10] USAGE EXAMPLE
+// [-1] CONCURRENT ADD/POP PERFORMANCE TEST
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static bool             verbose;
+static bool         veryVerbose;
+static bool     veryVeryVerbose;
+static bool veryVeryVeryVerbose;
+
+typedef bdlcc::LockFreeSkipList<int, int> Obj;
+typedef Obj::Pair                         Pair;
+typedef Obj::PairHandle                   PairHandle;
+
+typedef bdlcc::LockFreeSkipList<int, bsl::string> StringObj;
+
+// ============================================================================
+//                     GLOBAL HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+namespace u {
+
+int verifyOrder(const Obj& list)
+    // Return the number of pairs in the specified 'list', asserting that they
+    // are in ascending order of key.  The behavior is undefined if 'list' is
+    // modified concurrently.
+{
+    int        count = 0;
+    PairHandle item;
+    int        prevKey = -1;
+
+    if (0 == list.front(&item)) {
+        do {
+            ASSERTV(prevKey, item.key(), prevKey <= item.key());
+            prevKey = item.key();
+            ++count;
+            ASSERT(0 == list.skipForward(&item));
+        } while (item.isValid());
+    }
+    return count;
+}
+
+struct LevelRecorder {
+    // Functor adding 64 pairs to a list, and recording the level of each.
+
+    Obj              *d_list_p;
+    bsl::vector<int> *d_levels_p;
+    int               d_firstKey;
+    bslmt::Barrier   *d_barrier_p;
+
+    void operator()() const
+    {
+        d_barrier_p->wait();
+        for (int i = 0; i < 64; ++i) {
+            Pair *p;
+            d_list_p->addRaw(&p, d_firstKey + i, i);
+            d_levels_p->push_back(Obj::level(p));
+            d_list_p->releaseReferenceRaw(p);
+        }
+        d_barrier_p->wait();
+    }
+};
+
+struct StressThread {
+    // Functor adding pairs to, and finding and removing pairs from, a shared
+    // list.  The data of each pair is derived from its key, so that the
+    // premature reclamation of a pair is detected.
+
+    Obj               *d_list_p;
+    int                d_numIterations;
+    unsigned           d_seed;
+    bsls::AtomicInt   *d_numAdded_p;
+    bsls::AtomicInt   *d_numRemoved_p;
+    bslmt::Barrier    *d_barrier_p;
+
+    void operator()() const
+    {
+        enum { k_NUM_KEYS = 128, k_NUM_HELD = 16 };
+
+        unsigned   seed       = d_seed;
+        int        numAdded   = 0;
+        int        numRemoved = 0;
+        PairHandle held[k_NUM_HELD];
+
+        d_barrier_p->wait();
+        for (int i = 0; i < d_numIterations; ++i) {
+            seed = seed * 1103515245 + 12345;
+            const int key    = static_cast<int>((seed >> 8) % k_NUM_KEYS);
+            const int slot   = static_cast<int>((seed >> 4) % k_NUM_HELD);
+            const int action = static_cast<int>((seed >> 20) % 8);
+
+            PairHandle item;
+            switch (action) {
+              case 0:
+              case 1:
+              case 2: {
+                d_list_p->add(&held[slot], key, key * 3);
+                ++numAdded;
+              } break;
+              case 3: {
+                if (0 == d_list_p->addUnique(key, key * 3)) {
+                    ++numAdded;
+                }
+              } break;
+              case 4: {
+                if (held[slot].isValid()
+                 && 0 == d_list_p->remove(held[slot])) {
+                    ++numRemoved;
+                }
+                held[slot].release();
+              } break;
+              case 5: {
+                if (0 == d_list_p->popFront(&item)) {
+                    ++numRemoved;
+                    ASSERTV(item.key(), item.data(),
+                            item.key() * 3 == item.data());
+                }
+              } break;
+              case 6: {
+                if (0 == d_list_p->findLowerBound(&item, key)) {
+                    ASSERTV(key, item.key(), key <= item.key());
+                    ASSERTV(item.key(), item.data(),
+                            item.key() * 3 == item.data());
+                    if (0 == d_list_p->skipForward(&item) && item.isValid()) {
+                        ASSERTV(item.key(), item.data(),
+                                item.key() * 3 == item.data());
+                    }
+                }
+              } break;
+              default: {
+                if (held[slot].isValid()) {
+                    ASSERTV(held[slot].key(), held[slot].data(),
+                            held[slot].key() * 3 == held[slot].data());
+                }
+              } break;
+            }
+        }
+        *d_numAdded_p   += numAdded;
+        *d_numRemoved_p += numRemoved;
+    }
+};
+
+}  // close namespace u
+
+namespace perf {
+
+template <class LIST>
+struct Worker {
+    // Functor adding pairs to, and popping pairs from, a 'LIST'.
+
+    LIST               *d_list_p;
+    unsigned            d_seed;
+    bslmt::Barrier     *d_barrier_p;
+    bsls::AtomicBool   *d_done_p;
+    bsls::AtomicInt64  *d_numOps_p;
+
+    void operator()()
+    {
+        unsigned           seed   = d_seed;
+        bsls::Types::Int64 numOps = 0;
+
+        d_barrier_p->wait();
+        while (!*d_done_p) {
+            for (int i = 0; i < 256; ++i) {
+                seed = seed * 1103515245 + 12345;
+                d_list_p->add(static_cast<int>((seed >> 8) % 100000), i);
+                d_list_p->popFront();
+            }
+            numOps += 512;
+        }
+        *d_numOps_p += numOps;
+    }
+};
+
+template <class LIST>
+double run(LIST *list, int numThreads)
+    // Return the number of operations per second performed on the specified
+    // 'list' by the specified 'numThreads' threads.
+{
+    for (int i = 0; i < 10000; ++i) {
+        list->add(i * 10, i);
+    }
+
+    bslmt::Barrier    barrier(numThreads + 1);
+    bsls::AtomicBool  done(false);
+    bsls::AtomicInt64 numOps(0);
+
+    bslmt::ThreadGroup group;
+    for (int t = 0; t < numThreads; ++t) {
+        Worker<LIST> worker = { list,
+                                static_cast<unsigned>(t * 7919 + 1),
+                                &barrier,
+                                &done,
+                                &numOps };
+        group.addThread(worker);
+    }
+
+    barrier.wait();
+    bsls::Stopwatch timer;
+    timer.start();
+    bslmt::ThreadUtil::microSleep(0, 1);
+    done = true;
+    group.joinAll();
+    timer.stop();
+
+    return static_cast<double>(numOps) / timer.elapsedTime();
+}
+
+}  // close namespace perf
+}  // close unnamed namespace
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+namespace usage {
+
+void example1()
+{
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: A Timer Queue Shared by Many Producers
+///- - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that many threads schedule timers in a queue from which a single
+// dispatcher thread pops those that have expired, and that scheduled timers
+// can be cancelled by the threads that scheduled them.
+//
+// First, we define the queue, keyed on the expiration time of each timer:
+//..
+    typedef bdlcc::LockFreeSkipList<bsls::Types::Int64, bsl::string>
+                                                                  TimerQueue;
+
+    TimerQueue queue;
+//..
+// Then, threads schedule timers, keeping a handle to each timer they may want
+// to cancel.  Note that timers having equal expiration times are dispatched in
+// the order in which they were scheduled:
+//..
+    TimerQueue::PairHandle h1;
+    TimerQueue::PairHandle h2;
+
+    queue.add(&h1, 300, "third");
+    queue.add(&h2, 100, "first");
+    queue.add(200, "second");
+    queue.add(300, "fourth");
+    ASSERT(4 == queue.length());
+//..
+// Next, a timer is cancelled using its handle; removing it a second time
+// fails:
+//..
+    ASSERT(0 == queue.remove(h1));
+    ASSERT(0 != queue.remove(h1));
+    ASSERT("third" == h1.data());    // the handle still refers to the pair
+//..
+// Now, the dispatcher pops the timers having expired by time 250:
+//..
+    TimerQueue::PairHandle timer;
+    while (0 == queue.front(&timer) && timer.key() <= 250) {
+        if (0 == queue.remove(timer)) {
+            // ... dispatch 'timer.data()' ...
+        }
+    }
+    ASSERT(1 == queue.length());
+//..
+// Finally, we observe that the remaining timer is the one scheduled last:
+//..
+    ASSERT(0 == queue.popFront(&timer));
+    ASSERT("fourth" == timer.data());
+    ASSERT(queue.isEmpty());
+//..
+}
+
+}  // close namespace usage
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test            = argc > 1 ? atoi(argv[1]) : 0;
+    verbose             = argc > 2;
+    veryVerbose         = argc > 3;
+    veryVeryVerbose     = argc > 4;
+    veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator         defaultAllocator("default",
+                                                  veryVeryVeryVerbose);
+    bslma::DefaultAllocatorGuard defaultAllocatorGuard(&defaultAllocator);
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 10: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        usage::example1();
+      } break;
+      case 9: {
+        // --------------------------------------------------------------------
+        // MULTI-THREADED STRESS TEST
+        //
+        // Concerns:
+        //: 1 Concurrent additions, searches, and removals leave the list
+        //:   ordered, and account for every pair.
+        //:
+        //: 2 No pair is reclaimed while it is referenced or may be traversed.
+        //:
+        //: 3 All memory is returned once the list is destroyed.
+        //
+        // Plan:
+        //: 1 Have several threads add, find, and remove (by handle and by
+        //:   'popFront') pairs having keys in a small range, keeping handles
+        //:   to some of the pairs they added.  Verify that the number of pairs
+        //:   remaining equals the number added less the number removed, and
+        //:   that they are in order.  (C-1)
+        //:
+        //: 2 The data of each pair is derived from its key, and the test
+        //:   allocator scribbles over deallocated memory; verify the
+        //:   consistency of every pair examined.  (C-2)
+        //:
+        //: 3 Verify that no memory is in use after the list is destroyed.
+        //:   (C-3)
+        //
+        // Testing:
+        //   MULTI-THREADED STRESS TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MULTI-THREADED STRESS TEST" << endl
+                          << "==========================" << endl;
+
+        enum { k_NUM_THREADS = 4, k_NUM_ITERATIONS = 20000 };
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            bsls::AtomicInt    numAdded(0);
+            bsls::AtomicInt    numRemoved(0);
+            bslmt::Barrier     barrier(k_NUM_THREADS);
+            bslmt::ThreadGroup group;
+
+            for (int t = 0; t < k_NUM_THREADS; ++t) {
+                u::StressThread thread = { &mX,
+                                           k_NUM_ITERATIONS,
+                                           static_cast<unsigned>(t * 7919 + 1),
+                                           &numAdded,
+                                           &numRemoved,
+                                           &barrier };
+                group.addThread(thread);
+            }
+            group.joinAll();
+
+            const int numRemaining = numAdded - numRemoved;
+
+            if (veryVerbose) {
+                P_(numAdded) P_(numRemoved) P(numRemaining);
+            }
+
+            ASSERTV(numRemaining, X.length(), numRemaining == X.length());
+            ASSERTV(numRemaining, numRemaining == u::verifyOrder(X));
+            ASSERTV(numRemaining, numRemaining == mX.removeAll());
+            ASSERT(X.isEmpty());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 8: {
+        // --------------------------------------------------------------------
+        // EXCEPTION SAFETY
+        //
+        // Concerns:
+        //: 1 If an allocation fails while a pair is being added, the list is
+        //:   left unchanged and no memory is leaked.
+        //
+        // Plan:
+        //: 1 Using the standard 'bslma' exception test macros, add pairs
+        //:   having allocating data to lists, and verify the value of the
+        //:   list in each iteration.  (C-1)
+        //
+        // Testing:
+        //   EXCEPTION SAFETY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "EXCEPTION SAFETY" << endl
+                          << "================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            const bsl::string LONG("a string too long for the short buffer",
+                                   &ta);
+
+            StringObj mX(&ta);  const StringObj& X = mX;
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(ta) {
+                const int LENGTH = X.length();
+
+                StringObj::PairHandle h;
+                mX.add(&h, LENGTH, LONG);
+
+                ASSERT(LENGTH + 1 == X.length());
+                ASSERT(LONG == h.data());
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+            ASSERT(0 < X.length());
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(ta) {
+                const int LENGTH = X.length();
+
+                ASSERT(StringObj::e_DUPLICATE == mX.addUnique(0, LONG));
+                ASSERT(0 == mX.addUnique(-LENGTH, LONG));
+
+                ASSERT(LENGTH + 1 == X.length());
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // NODE LEVELS
+        //
+        // Concerns:
+        //: 1 The level of each new node is in the range '[0, 31]', and levels
+        //:   are distributed geometrically, with each level being one quarter
+        //:   as likely as the level below it.
+        //:
+        //: 2 Threads choose levels independently.
+        //
+        // Plan:
+        //: 1 Add many pairs and count the number at each level using 'level'.
+        //:   (C-1)
+        //:
+        //: 2 Repeat P-1 from several threads, and verify that the sequences
+        //:   of levels chosen by different threads differ.  (C-2)
+        //
+        // Testing:
+        //   static int level(const Pair *reference);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "NODE LEVELS" << endl
+                          << "===========" << endl;
+
+        enum { k_NUM_PAIRS = 16384 };
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            Obj mX(&ta);
+
+            int counts[32] = { 0 };
+            for (int i = 0; i < k_NUM_PAIRS; ++i) {
+                Pair *p;
+                mX.addRaw(&p, i, i);
+                const int level = Obj::level(p);
+                ASSERTV(level, 0 <= level && level < 32);
+                ++counts[level];
+                mX.releaseReferenceRaw(p);
+            }
+
+            if (veryVerbose) {
+                P_(counts[0]) P_(counts[1]) P_(counts[2]) P(counts[3]);
+            }
+
+            // Expected: 12288, 3072, 768, 192.
+
+            ASSERTV(counts[0], 11500 < counts[0] && counts[0] < 13000);
+            ASSERTV(counts[1],  2700 < counts[1] && counts[1] <  3450);
+            ASSERTV(counts[2],   600 < counts[2] && counts[2] <   950);
+        }
+        {
+            Obj mX(&ta);
+
+            // The threads run concurrently, so that their ids (from which
+            // their generators are seeded) differ.
+
+            bsl::vector<int>   levels[2] = { bsl::vector<int>(&ta),
+                                             bsl::vector<int>(&ta) };
+            bslmt::Barrier     barrier(2);
+            bslmt::ThreadGroup group;
+            for (int t = 0; t < 2; ++t) {
+                levels[t].reserve(64);
+                u::LevelRecorder recorder = { &mX,
+                                              &levels[t],
+                                              t * 1000,
+                                              &barrier };
+                group.addThread(recorder);
+            }
+            group.joinAll();
+            ASSERT(levels[0] != levels[1]);
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // REMOVAL AND ITERATION
+        //
+        // Concerns:
+        //: 1 'remove' removes the pair referred to, and fails if the pair has
+        //:   already been removed (by 'remove' or 'popFront').
+        //:
+        //: 2 'next' and 'skipForward' visit the pairs in order, report the end
+        //:   of the list, and fail for a pair that has been removed.
+        //:
+        //: 3 'removeAll' and 'removeAllRaw' remove every pair, optionally
+        //:   supplying references to them in order.
+        //:
+        //: 4 The memory of a removed pair is reclaimed only after every
+        //:   reference to it has been released.
+        //
+        // Plan:
+        //: 1 Add pairs, and verify the results of the methods under test
+        //:   against the expected sequence of pairs.  (C-1..3)
+        //:
+        //: 2 Keep references to removed pairs, verify that their data
+        //:   remains intact, and that all memory is returned when the list is
+        //:   destroyed.  (C-4)
+        //
+        // Testing:
+        //   int popFrontRaw(Pair **item);
+        //   int remove(const Pair *reference);
+        //   int removeAll(bsl::vector<PairHandle> *removed = 0);
+        //   int removeAllRaw(bsl::vector<Pair *> *removed);
+        //   int next(PairHandle *next, const Pair *reference) const;
+        //   int nextRaw(Pair **next, const Pair *reference) const;
+        //   int skipForward(PairHandle *item) const;
+        //   int skipForwardRaw(Pair **item) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "REMOVAL AND ITERATION" << endl
+                          << "=====================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            PairHandle handles[10];
+            for (int i = 0; i < 10; ++i) {
+                mX.add(&handles[i], i, i * 10);
+            }
+
+            if (veryVerbose) cout << "\tremove" << endl;
+
+            ASSERT(0 == mX.remove(handles[3]));
+            ASSERT(0 != mX.remove(handles[3]));
+            ASSERT(9 == X.length());
+            ASSERT(30 == handles[3].data());
+            ASSERT(!X.exists(3));
+
+            Pair *p;
+            ASSERT(0 == mX.popFrontRaw(&p));
+            ASSERT(0 == p->key());
+            ASSERT(0 != mX.remove(p));
+            ASSERT(0 != mX.remove(handles[0]));
+            mX.releaseReferenceRaw(p);
+            ASSERT(8 == X.length());
+
+            if (veryVerbose) cout << "\tnext" << endl;
+
+            PairHandle item;
+            ASSERT(0 == X.next(&item, handles[2]));
+            ASSERT(4 == item.key());
+            ASSERT(0 != X.next(&item, handles[3]));  // removed
+            ASSERT(4 == item.key());
+            ASSERT(0 != X.next(&item, handles[9]));  // back
+            ASSERT(4 == item.key());
+
+            ASSERT(0 == X.nextRaw(&p, handles[8]));
+            ASSERT(9 == p->key());
+            mX.releaseReferenceRaw(p);
+
+            if (veryVerbose) cout << "\tskipForward" << endl;
+
+            const int EXP[] = { 1, 2, 4, 5, 6, 7, 8, 9 };
+            ASSERT(0 == X.front(&item));
+            for (int i = 0; i < 8; ++i) {
+                ASSERTV(i, item.isValid());
+                ASSERTV(i, EXP[i] == item.key());
+                ASSERTV(i, 0 == X.skipForward(&item));
+            }
+            ASSERT(!item.isValid());
+
+            ASSERT(0 == X.frontRaw(&p));
+            for (int i = 0; i < 8; ++i) {
+                ASSERTV(i, p);
+                ASSERTV(i, EXP[i] == p->key());
+                ASSERTV(i, 0 == X.skipForwardRaw(&p));
+            }
+            ASSERT(0 == p);
+
+            item = handles[3];
+            ASSERT(Obj::e_NOT_FOUND == X.skipForward(&item));
+            ASSERT(3 == item.key());
+
+            p = X.addPairReferenceRaw(handles[3]);
+            ASSERT(Obj::e_NOT_FOUND == X.skipForwardRaw(&p));
+            ASSERT(3 == p->key());
+            mX.releaseReferenceRaw(p);
+
+            if (veryVerbose) cout << "\tremoveAll" << endl;
+
+            bsl::vector<PairHandle> removed(&ta);
+            ASSERT(8 == mX.removeAll(&removed));
+            ASSERT(8 == removed.size());
+            for (int i = 0; i < 8; ++i) {
+                ASSERTV(i, EXP[i] == removed[i].key());
+                ASSERTV(i, EXP[i] * 10 == removed[i].data());
+            }
+            ASSERT(X.isEmpty());
+            ASSERT(0 == X.length());
+            ASSERT(0 == mX.removeAll());
+
+            for (int i = 0; i < 5; ++i) {
+                mX.add(5 - i, i);
+            }
+            bsl::vector<Pair *> removedRaw(&ta);
+            ASSERT(5 == mX.removeAllRaw(&removedRaw));
+            ASSERT(5 == removedRaw.size());
+            for (int i = 0; i < 5; ++i) {
+                ASSERTV(i, i + 1 == removedRaw[i]->key());
+                mX.releaseReferenceRaw(removedRaw[i]);
+            }
+            ASSERT(X.isEmpty());
+
+            for (int i = 0; i < 10; ++i) {
+                ASSERTV(i, i * 10 == handles[i].data());
+            }
+            for (int i = 0; i < 8; ++i) {
+                ASSERTV(i, EXP[i] * 10 == removed[i].data());
+            }
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // SEARCH METHODS
+        //
+        // Concerns:
+        //: 1 'find' finds the first pair having a given key, and fails if
+        //:   there is none.
+        //:
+        //: 2 'findLowerBound' and 'findUpperBound' find the first pair whose
+        //:   key is not less than, respectively greater than, a given key.
+        //:
+        //: 3 Removed pairs are not found.
+        //:
+        //: 4 On failure, the reference supplied is unchanged.
+        //
+        // Plan:
+        //: 1 Add pairs having duplicate keys, with the data identifying the
+        //:   order of addition, and verify the result of each search method
+        //:   for keys before, between, at, and after the pairs in the list.
+        //:   (C-1..4)
+        //
+        // Testing:
+        //   bool exists(const KEY& key) const;
+        //   int find(PairHandle *item, const KEY& key) const;
+        //   int findRaw(Pair **item, const KEY& key) const;
+        //   int findLowerBound(PairHandle *item, const KEY& key) const;
+        //   int findLowerBoundRaw(Pair **item, const KEY& key) const;
+        //   int findUpperBound(PairHandle *item, const KEY& key) const;
+        //   int findUpperBoundRaw(Pair **item, const KEY& key) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "SEARCH METHODS" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            // Keys 10, 20, 20, 20, 30, 40; the data records the order.
+
+            mX.add(20, 1);
+            mX.add(40, 2);
+            mX.add(20, 3);
+            mX.add(10, 4);
+            mX.add(30, 5);
+            mX.add(20, 6);
+
+            static const struct {
+                int d_line;
+                int d_key;
+                int d_find;   // data of pair found by 'find', or -1
+                int d_lower;  // data of pair found by 'findLowerBound'
+                int d_upper;  // data of pair found by 'findUpperBound'
+            } DATA[] = {
+                //LINE  KEY  FIND  LOWER  UPPER
+                //----  ---  ----  -----  -----
+                { L_,     5,   -1,     4,     4 },
+                { L_,    10,    4,     4,     1 },
+                { L_,    15,   -1,     1,     1 },
+                { L_,    20,    1,     1,     5 },
+                { L_,    30,    5,     5,     2 },
+                { L_,    35,   -1,     2,     2 },
+                { L_,    40,    2,     2,    -1 },
+                { L_,    45,   -1,    -1,    -1 },
+            };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int LINE  = DATA[ti].d_line;
+                const int KEY   = DATA[ti].d_key;
+                const int FIND  = DATA[ti].d_find;
+                const int LOWER = DATA[ti].d_lower;
+                const int UPPER = DATA[ti].d_upper;
+
+                if (veryVerbose) { T_ P_(LINE) P(KEY) }
+
+                PairHandle item;
+                Pair      *p = 0;
+
+                ASSERTV(LINE, (-1 != FIND) == X.exists(KEY));
+
+                ASSERTV(LINE, (-1 == FIND) == (0 != X.find(&item, KEY)));
+                ASSERTV(LINE, (-1 == FIND) == !item.isValid());
+                if (-1 != FIND) {
+                    ASSERTV(LINE, FIND == item.data());
+                }
+                ASSERTV(LINE, (-1 == FIND) == (0 != X.findRaw(&p, KEY)));
+                if (-1 != FIND) {
+                    ASSERTV(LINE, FIND == p->data());
+                    mX.releaseReferenceRaw(p);
+                }
+
+                item.release();
+                p = 0;
+                ASSERTV(LINE,
+                        (-1 == LOWER) == (0 != X.findLowerBound(&item, KEY)));
+                ASSERTV(LINE, (-1 == LOWER) == !item.isValid());
+                if (-1 != LOWER) {
+                    ASSERTV(LINE, LOWER == item.data());
+                }
+                ASSERTV(LINE,
+                        (-1 == LOWER) == (0 != X.findLowerBoundRaw(&p, KEY)));
+                if (-1 != LOWER) {
+                    ASSERTV(LINE, LOWER == p->data());
+                    mX.releaseReferenceRaw(p);
+                }
+
+                item.release();
+                p = 0;
+                ASSERTV(LINE,
+                        (-1 == UPPER) == (0 != X.findUpperBound(&item, KEY)));
+                ASSERTV(LINE, (-1 == UPPER) == !item.isValid());
+                if (-1 != UPPER) {
+                    ASSERTV(LINE, UPPER == item.data());
+                }
+                ASSERTV(LINE,
+                        (-1 == UPPER) == (0 != X.findUpperBoundRaw(&p, KEY)));
+                if (-1 != UPPER) {
+                    ASSERTV(LINE, UPPER == p->data());
+                    mX.releaseReferenceRaw(p);
+                }
+            }
+
+            if (veryVerbose) cout << "\tRemoved pairs are not found." << endl;
+
+            PairHandle item;
+            ASSERT(0 == X.find(&item, 20));
+            ASSERT(0 == mX.remove(item));
+            ASSERT(0 == X.find(&item, 20));
+            ASSERT(3 == item.data());
+            ASSERT(0 == mX.remove(item));
+            ASSERT(0 == X.find(&item, 20));
+            ASSERT(6 == item.data());
+            ASSERT(0 == mX.remove(item));
+            ASSERT(!X.exists(20));
+            ASSERT(0 != X.find(&item, 20));
+            ASSERT(6 == item.data());
+            ASSERT(0 == X.findLowerBound(&item, 20));
+            ASSERT(5 == item.data());
+            ASSERT(0 == X.findUpperBound(&item, 10));
+            ASSERT(5 == item.data());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // INSERTION METHODS
+        //
+        // Concerns:
+        //: 1 'add' places a pair after all pairs having an equivalent key.
+        //:
+        //: 2 The 'addUnique' methods fail, with no effect, if a pair having an
+        //:   equivalent key is in the list, but not if such a pair has been
+        //:   removed.
+        //:
+        //: 3 'newFrontFlag' is loaded with 'true' if and only if the pair was
+        //:   added at the front of the list.
+        //:
+        //: 4 The raw methods load a reference that must be released.
+        //
+        // Plan:
+        //: 1 Add pairs using each method under test and verify the resulting
+        //:   sequence, return values, and flags.  (C-1..4)
+        //
+        // Testing:
+        //   void addRaw(Pair **result, const KEY&, const DATA&, bool * = 0);
+        //   int addUnique(const KEY&, const DATA&, bool *newFrontFlag = 0);
+        //   int addUnique(PairHandle *, const KEY&, const DATA&, bool * = 0);
+        //   int addUniqueRaw(Pair **, const KEY&, const DATA&, bool * = 0);
+        //   int frontRaw(Pair **front) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "INSERTION METHODS" << endl
+                          << "=================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            bool  newFront = false;
+            Pair *p        = 0;
+
+            mX.addRaw(&p, 5, 1, &newFront);
+            ASSERT(newFront);
+            ASSERT(5 == p->key());
+            ASSERT(1 == p->data());
+            mX.releaseReferenceRaw(p);
+
+            mX.add(5, 2, &newFront);
+            ASSERT(!newFront);
+
+            mX.add(3, 3, &newFront);
+            ASSERT(newFront);
+
+            ASSERT(Obj::e_DUPLICATE == mX.addUnique(5, 4, &newFront));
+            ASSERT(Obj::e_DUPLICATE == mX.addUnique(3, 4));
+            ASSERT(0 == mX.addUnique(4, 4, &newFront));
+            ASSERT(!newFront);
+            ASSERT(0 == mX.addUnique(1, 5, &newFront));
+            ASSERT(newFront);
+
+            PairHandle h;
+            ASSERT(Obj::e_DUPLICATE == mX.addUnique(&h, 4, 6));
+            ASSERT(!h.isValid());
+            ASSERT(0 == mX.addUnique(&h, 9, 6, &newFront));
+            ASSERT(!newFront);
+            ASSERT(9 == h.key());
+
+            p = 0;
+            ASSERT(Obj::e_DUPLICATE == mX.addUniqueRaw(&p, 9, 7));
+            ASSERT(0 == p);
+            ASSERT(0 == mX.addUniqueRaw(&p, 7, 7));
+            ASSERT(7 == p->key());
+            mX.releaseReferenceRaw(p);
+
+            // A removed key can be added again.
+
+            ASSERT(0 == mX.remove(h));
+            ASSERT(0 == mX.addUnique(9, 8));
+
+            const int EXP_KEY[]  = { 1, 3, 4, 5, 5, 7, 9 };
+            const int EXP_DATA[] = { 5, 3, 4, 1, 2, 7, 8 };
+
+            ASSERT(7 == X.length());
+            ASSERT(0 == X.frontRaw(&p));
+            for (int i = 0; i < 7; ++i) {
+                ASSERTV(i, p);
+                ASSERTV(i, EXP_KEY[i]  == p->key());
+                ASSERTV(i, EXP_DATA[i] == p->data());
+                X.skipForwardRaw(&p);
+            }
+            ASSERT(0 == p);
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // PAIR HANDLES
+        //
+        // Concerns:
+        //: 1 A default-constructed handle is not valid.
+        //:
+        //: 2 Copying and assigning handles adds references, and destroying or
+        //:   releasing a handle releases its reference.
+        //:
+        //: 3 'releaseReferenceRaw' transfers the reference to the caller.
+        //:
+        //: 4 A pair removed from the list remains accessible (and modifiable)
+        //:   through its references, and its memory is reclaimed once all
+        //:   references are released.
+        //
+        // Plan:
+        //: 1 Exercise the handle operations on pairs in lists of strings
+        //:   supplied by a test allocator, verifying the key and data referred
+        //:   to, and the memory in use.  (C-1..4)
+        //
+        // Testing:
+        //   void releaseReferenceRaw(const Pair *reference);
+        //   void add(PairHandle *result, const KEY&, const DATA&, bool * = 0);
+        //   Pair *addPairReferenceRaw(const Pair *reference) const;
+        //   LockFreeSkipListPairHandle();
+        //   LockFreeSkipListPairHandle(const LockFreeSkipListPairHandle&);
+        //   ~LockFreeSkipListPairHandle();
+        //   operator=(const LockFreeSkipListPairHandle& rhs);
+        //   void release();
+        //   void releaseReferenceRaw(LockFreeSkipList **, Pair **);
+        //   operator const Pair*() const;
+        //   DATA& data() const;
+        //   const KEY& key() const;
+        //   bool isValid() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PAIR HANDLES" << endl
+                          << "============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            const bsl::string A("a string too long for the short buffer", &ta);
+            const bsl::string B("another long string, different from 'A'",
+                                &ta);
+
+            StringObj mX(&ta);  const StringObj& X = mX;
+
+            StringObj::PairHandle h1;
+            ASSERT(!h1.isValid());
+            ASSERT(0 == static_cast<const StringObj::Pair *>(h1));
+
+            mX.add(&h1, 1, A);
+            ASSERT(h1.isValid());
+            ASSERT(1 == h1.key());
+            ASSERT(A == h1.data());
+            ASSERT(&ta == h1.data().get_allocator().mechanism());
+
+            {
+                StringObj::PairHandle h2(h1);
+                ASSERT(h2.isValid());
+                ASSERT(static_cast<const StringObj::Pair *>(h1) ==
+                       static_cast<const StringObj::Pair *>(h2));
+
+                StringObj::PairHandle h3;
+                mX.add(&h3, 2, B);
+                h3 = h2;
+                ASSERT(1 == h3.key());
+                h3 = h3;
+                ASSERT(1 == h3.key());
+
+                h2.release();
+                ASSERT(!h2.isValid());
+            }
+
+            if (veryVerbose) cout << "\tRemoved pairs remain valid." << endl;
+
+            StringObj::Pair *p = X.addPairReferenceRaw(h1);
+            ASSERT(0 == mX.remove(h1));
+            ASSERT(1 == X.length());
+
+            h1.data() = B;
+            ASSERT(B == p->data());
+
+            StringObj       *list;
+            StringObj::Pair *q;
+            h1.releaseReferenceRaw(&list, &q);
+            ASSERT(!h1.isValid());
+            ASSERT(&mX == list);
+            ASSERT(p == q);
+            mX.releaseReferenceRaw(q);
+
+            ASSERT(B == p->data());
+            ASSERT(1 == p->key());
+
+            // Reclaim the removed pair before releasing the last reference.
+
+            for (int i = 0; i < 300; ++i) {
+                mX.add(i, A);
+                ASSERT(0 == mX.popFront());
+            }
+            ASSERT(B == p->data());
+
+            const bsls::Types::Int64 numBlocks = ta.numBlocksInUse();
+            mX.releaseReferenceRaw(p);
+            ASSERTV(numBlocks, ta.numBlocksInUse(),
+                    numBlocks > ta.numBlocksInUse());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // PRIMARY MANIPULATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 A newly constructed list is empty, and uses the specified (or
+        //:   default) allocator.
+        //:
+        //: 2 'add' adds pairs in order of key, and 'popFront' removes them in
+        //:   order.
+        //:
+        //: 3 'front', 'length', and 'isEmpty' reflect the pairs in the list.
+        //:
+        //: 4 The destructor releases all memory, including that of pairs
+        //:   still in the list.
+        //
+        // Plan:
+        //: 1 Create lists with and without an allocator and verify their
+        //:   initial state.  (C-1)
+        //:
+        //: 2 Add pairs in an arbitrary order, verify the accessors, pop the
+        //:   pairs, and verify the order in which they are popped.  (C-2..3)
+        //:
+        //: 3 Destroy a list holding pairs, and verify that all memory is
+        //:   returned.  (C-4)
+        //
+        // Testing:
+        //   LockFreeSkipList(bslma::Allocator *basicAllocator = 0);
+        //   ~LockFreeSkipList();
+        //   void add(const KEY& key, const DATA& data, bool *newFront = 0);
+        //   int popFront(PairHandle *item = 0);
+        //   int front(PairHandle *front) const;
+        //   bool isEmpty() const;
+        //   int length() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PRIMARY MANIPULATORS AND BASIC ACCESSORS" << endl
+                          << "========================================"
+                          << endl;
+
+        {
+            Obj mX;  const Obj& X = mX;
+            ASSERT(&defaultAllocator == X.allocator());
+            ASSERT(X.isEmpty());
+        }
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+            ASSERT(&ta == X.allocator());
+            ASSERT(X.isEmpty());
+            ASSERT(0 == X.length());
+
+            PairHandle item;
+            ASSERT(0 != X.front(&item));
+            ASSERT(0 != mX.popFront(&item));
+            ASSERT(!item.isValid());
+
+            const int KEYS[] = { 50, 20, 80, 10, 30, 70, 90, 60, 40, 0 };
+            enum { k_NUM_KEYS = sizeof KEYS / sizeof *KEYS };
+
+            for (int i = 0; i < k_NUM_KEYS; ++i) {
+                mX.add(KEYS[i], KEYS[i] + 1);
+                ASSERTV(i, i + 1 == X.length());
+                ASSERTV(i, !X.isEmpty());
+            }
+
+            ASSERT(0 == X.front(&item));
+            ASSERT(0 == item.key());
+            ASSERT(1 == item.data());
+
+            for (int i = 0; i < k_NUM_KEYS; ++i) {
+                ASSERTV(i, 0 == mX.popFront(&item));
+                ASSERTV(i, item.key(), i * 10 == item.key());
+                ASSERTV(i, i * 10 + 1 == item.data());
+                ASSERTV(i, k_NUM_KEYS - i - 1 == X.length());
+            }
+            ASSERT(X.isEmpty());
+            ASSERT(0 != mX.popFront());
+
+            for (int i = 0; i < k_NUM_KEYS; ++i) {
+                mX.add(KEYS[i], KEYS[i]);
+            }
+            ASSERT(0 == mX.popFront());
+            ASSERT(k_NUM_KEYS - 1 == X.length());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Add, find, remove, and pop a few pairs.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            PairHandle h;
+            mX.add(3, 30);
+            mX.add(&h, 1, 10);
+            mX.add(2, 20);
+            ASSERT(3 == X.length());
+
+            PairHandle item;
+            ASSERT(0 == X.find(&item, 2));
+            ASSERT(20 == item.data());
+            ASSERT(0 != X.find(&item, 4));
+
+            ASSERT(0 == mX.remove(h));
+            ASSERT(2 == X.length());
+
+            ASSERT(0 == mX.popFront(&item));
+            ASSERT(2 == item.key());
+            ASSERT(0 == mX.popFront(&item));
+            ASSERT(3 == item.key());
+            ASSERT(X.isEmpty());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // CONCURRENT ADD/POP PERFORMANCE TEST
+        //   Compare the throughput of 'bdlcc::SkipList' and
+        //   'bdlcc::LockFreeSkipList' when several threads add pairs to, and
+        //   pop pairs from, the same list.
+        //
+        //   2nd parameter: number of threads (default 4)
+        //
+        // Testing:
+        //   CONCURRENT ADD/POP PERFORMANCE TEST
+        // --------------------------------------------------------------------
+
+        const int numThreads = argc > 2 ? atoi(argv[2]) : 4;
+
+        cout << "CONCURRENT ADD/POP PERFORMANCE TEST" << endl
+             << "===================================" << endl;
+        P(numThreads);
+
+        // Use a fast allocator, as 'bdlcc::LockFreeSkipList' (unlike
+        // 'bdlcc::SkipList') does not pool its nodes.
+
+        bslma::Allocator *alloc = &bslma::NewDeleteAllocator::singleton();
+        {
+            bdlcc::SkipList<int, int> list(alloc);
+            const double rate = perf::run(&list, numThreads);
+            printf("SkipList:         %12.0f ops/s\n", rate);
+        }
+        {
+            Obj list(alloc);
+            const double rate = perf::run(&list, numThreads);
+            printf("LockFreeSkipList: %12.0f ops/s\n", rate);
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    ASSERTV(globalAllocator.numBlocksTotal(),
+            0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License.  You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -40,6 +40,18 @@ BSLS_IDENT("$Id: $")
 // blocked in 'popFront' when the queue is dequeue disabled return from
 // 'popFront' immediately and return an error code.
 //
+///Batch Operations
+///----------------
+// The queue also provides methods for transferring a range of elements in a
+// single operation.  'tryPushBack', when supplied an iterator range, appends
+// all the elements of the range, reserving previously allocated nodes for as
+// many of the elements as possible with a single atomic operation and
+// signalling a blocked consumer at most once for those elements.  'popFront'
+// and 'tryPopFront', when supplied a maximum number of items and a
+// 'bsl::vector', append up to that many elements to the vector and return
+// the nodes of those elements to the queue with a single atomic operation;
+// 'popFront' blocks until at least one element is available.
+//
 ///Template Requirements
 ///---------------------
 // 'bdlcc::SingleConsumerQueue' is a template that is parameterized on the type
@@ -161,6 +173,9 @@ BSLS_IDENT("$Id: $")
 
 #include <bsls_atomicoperations.h>
 
+#include <bsl_cstddef.h>
+#include <bsl_vector.h>
+
 namespace BloombergLP {
 namespace bdlcc {
 
@@ -230,6 +245,18 @@ class SingleConsumerQueue {
         // 'e_DISABLED' if 'disablePopFront' is invoked.  The behavior is
         // undefined unless the invoker of this method is the single consumer.
 
+    int popFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *buffer);
+        // Remove up to the specified 'maxNumItems' elements from the front of
+        // this queue and append them, in order, to the specified 'buffer'.  If
+        // the queue is empty, block until it is not empty.  Return 0 on
+        // success, and a non-zero value otherwise.  Specifically, return
+        // 'e_DISABLED' if 'isPopFrontDisabled()'.  On failure, 'buffer' is not
+        // changed.  Threads blocked due to the queue being empty will return
+        // 'e_DISABLED' if 'disablePopFront' is invoked.  The behavior is
+        // undefined unless '0 < maxNumItems' and the invoker of this method is
+        // the single consumer.  Note that at least one element is appended to
+        // 'buffer' on success.
+
     int pushBack(const TYPE& value);
         // Append the specified 'value' to the back of this queue.  Return 0 on
         // success, and a non-zero value otherwise.  Specifically, return
@@ -259,6 +286,16 @@ class SingleConsumerQueue {
         // behavior is undefined unless the invoker of this method is the
         // single consumer.
 
+    int tryPopFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *buffer);
+        // Attempt to remove up to the specified 'maxNumItems' elements from
+        // the front of this queue without blocking, and append the removed
+        // elements, in order, to the specified 'buffer'.  Return 0 on success,
+        // and a non-zero value otherwise.  Specifically, return 'e_DISABLED'
+        // if 'isPopFrontDisabled()', and 'e_EMPTY' if '!isPopFrontDisabled()'
+        // and the queue was empty.  On failure, 'buffer' is not changed.  The
+        // behavior is undefined unless '0 < maxNumItems' and the invoker of
+        // this method is the single consumer.
+
     int tryPushBack(const TYPE& value);
         // Append the specified 'value' to the back of this queue.  Return 0 on
         // success, and a non-zero value otherwise.  Specifically, return
@@ -271,6 +308,19 @@ class SingleConsumerQueue {
         // 'e_DISABLED' if 'isPushBackDisabled()'.  On failure, 'value' is not
         // changed.
 
+    template <class FORWARD_ITER>
+    bsl::size_t tryPushBack(FORWARD_ITER begin, FORWARD_ITER end);
+        // Append the elements in the range starting at the specified 'begin'
+        // and ending immediately before the specified 'end' to the back of
+        // this queue, in order, and return the number of elements appended.
+        // Return 0, and append no elements, if 'isPushBackDisabled()'.  The
+        // behavior is undefined unless '[begin .. end)' is a valid range of
+        // elements convertible to 'TYPE'.  Note that, since this queue is
+        // unbounded, all the elements of the range are appended unless the
+        // queue is enqueue disabled during the operation, and that the
+        // consumer is signalled at most once for each group of elements
+        // placed into previously allocated nodes.
+
                        // Enqueue/Dequeue State
 
     void disablePopFront();
@@ -361,6 +411,13 @@ int SingleConsumerQueue<TYPE>::popFront(TYPE *value)
     return d_impl.popFront(value);
 }
 
+template <class TYPE>
+int SingleConsumerQueue<TYPE>::popFront(bsl::size_t        maxNumItems,
+                                        bsl::vector<TYPE> *buffer)
+{
+    return d_impl.popFront(maxNumItems, buffer);
+}
+
 template <class TYPE>
 int SingleConsumerQueue<TYPE>::pushBack(const TYPE& value)
 {
@@ -385,6 +442,13 @@ int SingleConsumerQueue<TYPE>::tryPopFront(TYPE *value)
     return d_impl.tryPopFront(value);
 }
 
+template <class TYPE>
+int SingleConsumerQueue<TYPE>::tryPopFront(bsl::size_t        maxNumItems,
+                                           bsl::vector<TYPE> *buffer)
+{
+    return d_impl.tryPopFront(maxNumItems, buffer);
+}
+
 template <class TYPE>
 int SingleConsumerQueue<TYPE>::tryPushBack(const TYPE& value)
 {
@@ -397,6 +461,15 @@ int SingleConsumerQueue<TYPE>::tryPushBack(bslmf::MovableRef<TYPE> value)
     return d_impl.tryPushBack(bslmf::MovableRefUtil::move(value));
 }
 
+template <class TYPE>
+template <class FORWARD_ITER>
+inline
+bsl::size_t SingleConsumerQueue<TYPE>::tryPushBack(FORWARD_ITER begin,
+                                                   FORWARD_ITER end)
+{
+    return d_impl.tryPushBack(begin, end);
+}
+
                        // Enqueue/Dequeue State
 
 template <class TYPE>
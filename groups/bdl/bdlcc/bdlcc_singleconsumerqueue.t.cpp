@@ -85,6 +85,9 @@ using namespace bsl;
 // [ 8] int tryPopFront(TYPE *value);
 // [ 7] int tryPushBack(const TYPE& value);
 // [10] int tryPushBack(bslmf::MovableRef<TYPE> value);
+// [13] int popFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *buffer);
+// [13] int tryPopFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *buffer);
+// [13] bsl::size_t tryPushBack(FORWARD_ITER begin, FORWARD_ITER end);
 // [ 6] void disablePopFront();
 // [ 6] void disablePushBack();
 // [ 6] void enablePopFront();
@@ -98,13 +101,14 @@ using namespace bsl;
 // [ 4] bslma::Allocator *allocator() const;
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [13] USAGE EXAMPLE
+// [14] USAGE EXAMPLE
 // [ 3] Obj& gg(Obj *object, const char *spec);
 // [ 3] int ggg(Obj *object, const char *spec);
 // [ 2] CONCERN: 0 == e_SUCCESS
 // [10] CONCERN: 'popFront' and 'tryPopFront' honor move-semantics
 // [11] CONCERN: template requirements
 // [12] CONCERN: ordering guarantee
+// [13] CONCERN: batch operations
 // ----------------------------------------------------------------------------
 
 // ============================================================================
@@ -872,7 +876,7 @@ int main(int argc, char *argv[])
     ASSERT(0 == bslma::Default::setDefaultAllocator(&defaultAllocator));
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 13: {
+      case 14: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -910,6 +914,78 @@ int main(int argc, char *argv[])
 
         bslmt::ThreadUtil::join(watchdogHandle);
       } break;
+      case 13: {
+        // --------------------------------------------------------------------
+        // BATCH OPERATIONS
+        //   Ensure the batch "push" and "pop" methods are correctly forwarded
+        //   to the implementation.  Note that the batch methods are
+        //   thoroughly tested in 'bdlcc_singleconsumerqueueimpl'.
+        //
+        // Concerns:
+        //: 1 The batch methods transfer elements in order and return the
+        //:   values produced by the implementation.
+        //:
+        //: 2 The batch methods honor the enqueue and dequeue disabled states.
+        //
+        // Plan:
+        //: 1 Directly exercise the batch methods, verifying return values,
+        //:   the contents of the buffer, and the number of elements in the
+        //:   queue.  (C-1,2)
+        //
+        // Testing:
+        //   int popFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *buffer);
+        //   int tryPopFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *buf);
+        //   bsl::size_t tryPushBack(FORWARD_ITER begin, FORWARD_ITER end);
+        //   CONCERN: batch operations
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BATCH OPERATIONS" << endl
+                          << "================" << endl;
+
+        Obj mX(4);  const Obj& X = mX;
+
+        const int VALUES[]   = { 1, 2, 3, 4, 5, 6 };
+        const int NUM_VALUES = static_cast<int>(sizeof VALUES
+                                                / sizeof *VALUES);
+
+        bsl::vector<int> buffer;
+
+        ASSERT(e_EMPTY == mX.tryPopFront(3, &buffer));
+        ASSERT(buffer.empty());
+
+        ASSERT(6 == mX.tryPushBack(VALUES, VALUES + NUM_VALUES));
+        ASSERT(6 == X.numElements());
+
+        ASSERT(e_SUCCESS == mX.tryPopFront(4, &buffer));
+        ASSERT(4 == buffer.size());
+
+        ASSERT(e_SUCCESS == mX.popFront(10, &buffer));
+        ASSERT(6 == buffer.size());
+        ASSERT(X.isEmpty());
+
+        for (bsl::size_t i = 0; i < buffer.size(); ++i) {
+            ASSERTV(i, buffer[i], VALUES[i] == buffer[i]);
+        }
+
+        buffer.clear();
+
+        mX.disablePushBack();
+        ASSERT(0 == mX.tryPushBack(VALUES, VALUES + NUM_VALUES));
+        mX.enablePushBack();
+
+        ASSERT(2 == mX.tryPushBack(VALUES, VALUES + 2));
+
+        mX.disablePopFront();
+        ASSERT(e_DISABLED == mX.popFront(2, &buffer));
+        ASSERT(e_DISABLED == mX.tryPopFront(2, &buffer));
+        ASSERT(buffer.empty());
+        mX.enablePopFront();
+
+        ASSERT(e_SUCCESS == mX.popFront(2, &buffer));
+        ASSERT(2 == buffer.size());
+        ASSERT(X.isEmpty());
+      } break;
       case 12: {
         // ---------------------------------------------------------
         // Ordering Guarantee Test
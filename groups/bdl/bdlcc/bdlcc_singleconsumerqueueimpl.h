@@ -40,6 +40,17 @@ BSLS_IDENT("$Id: $")
 // blocked in 'popFront' when the queue is dequeue disabled return from
 // 'popFront' immediately and return an error code.
 //
+///Batch Operations
+///----------------
+// 'tryPushBack', when supplied an iterator range, appends the elements of the
+// range in order.  Whenever enough previously allocated nodes are available,
+// the nodes for the range are reserved with a single update of the queue
+// state and a single advance of the write position, and the consumer is
+// signalled at most once for the entire range.  'popFront' and 'tryPopFront',
+// when supplied a maximum number of items and a 'bsl::vector', append up to
+// that many consecutive elements to the vector and return the nodes of those
+// elements to the queue with a single update of the queue state.
+//
 ///Exception safety
 ///----------------
 // A 'bdlcc::SingleConsumerQueueImpl' is exception neutral, and all of the
@@ -101,6 +112,8 @@ BSLS_IDENT("$Id: $")
 #include <bsls_types.h>
 
 #include <bsl_cstddef.h>
+#include <bsl_iterator.h>
+#include <bsl_vector.h>
 
 namespace BloombergLP {
 namespace bdlcc {
@@ -209,6 +222,98 @@ class SingleConsumerQueueImpl_PopCompleteGuard {
         // managed queue.
 };
 
+           // ===================================================
+           // class SingleConsumerQueueImpl_PopRangeCompleteGuard
+           // ===================================================
+
+template <class TYPE>
+class SingleConsumerQueueImpl_PopRangeCompleteGuard {
+    // This class implements a guard that counts the nodes released by a batch
+    // "pop" operation on the managed queue, releases the node holding a value
+    // being popped if an exception occurs, and automatically invokes
+    // 'popRangeComplete' on the managed queue upon destruction.
+
+    // DATA
+    TYPE               *d_queue_p;      // managed queue
+    bsls::Types::Int64  d_numNodes;     // number of released nodes
+    bsls::Types::Int64  d_numReclaim;   // number of released nodes that were
+                                        // marked for reclamation
+    bool                d_isHolding;    // the next node to read holds a value
+                                        // being popped
+
+    // NOT IMPLEMENTED
+    SingleConsumerQueueImpl_PopRangeCompleteGuard();
+    SingleConsumerQueueImpl_PopRangeCompleteGuard(
+                         const SingleConsumerQueueImpl_PopRangeCompleteGuard&);
+    SingleConsumerQueueImpl_PopRangeCompleteGuard& operator=(
+                         const SingleConsumerQueueImpl_PopRangeCompleteGuard&);
+
+  public:
+    // CREATORS
+    explicit
+    SingleConsumerQueueImpl_PopRangeCompleteGuard(TYPE *queue);
+        // Create a 'popRangeComplete' guard managing the specified 'queue'.
+
+    ~SingleConsumerQueueImpl_PopRangeCompleteGuard();
+        // Destroy this object, release the next node to read of the managed
+        // queue if 'hold' has been invoked since the most recent 'release',
+        // and invoke the 'popRangeComplete' method on the managed queue.
+
+    // MANIPULATORS
+    void hold();
+        // Indicate that the next node to read of the managed queue holds a
+        // value being popped.
+
+    void release(bool destruct);
+        // Release the next node to read of the managed queue, destructing the
+        // value stored in the node if the specified 'destruct' is 'true', and
+        // otherwise counting the node as one marked for reclamation.
+};
+
+           // ====================================================
+           // class SingleConsumerQueueImpl_PushRangeCompleteGuard
+           // ====================================================
+
+template <class TYPE, class NODE>
+class SingleConsumerQueueImpl_PushRangeCompleteGuard {
+    // This class implements a guard that automatically invokes
+    // 'pushRangeComplete' on the managed queue upon destruction, supplying the
+    // number of nodes of a reserved range into which values have been
+    // constructed.
+
+    // DATA
+    TYPE               *d_queue_p;         // managed queue
+    NODE               *d_node_p;          // first reserved node
+    bsls::Types::Int64  d_numReserved;     // number of reserved nodes
+    bsls::Types::Int64  d_numConstructed;  // number of constructed nodes
+
+    // NOT IMPLEMENTED
+    SingleConsumerQueueImpl_PushRangeCompleteGuard();
+    SingleConsumerQueueImpl_PushRangeCompleteGuard(
+                        const SingleConsumerQueueImpl_PushRangeCompleteGuard&);
+    SingleConsumerQueueImpl_PushRangeCompleteGuard& operator=(
+                        const SingleConsumerQueueImpl_PushRangeCompleteGuard&);
+
+  public:
+    // CREATORS
+    SingleConsumerQueueImpl_PushRangeCompleteGuard(
+                                       TYPE               *queue,
+                                       NODE               *node,
+                                       bsls::Types::Int64  numReserved);
+        // Create a 'pushRangeComplete' guard managing the specified
+        // 'numReserved' consecutive nodes of the specified 'queue' starting at
+        // the specified 'node', none of which has yet been constructed.
+
+    ~SingleConsumerQueueImpl_PushRangeCompleteGuard();
+        // Destroy this object and invoke the 'pushRangeComplete' method on the
+        // managed queue with the managed range and the number of constructed
+        // nodes.
+
+    // MANIPULATORS
+    void increment();
+        // Increment the number of constructed nodes of the managed range.
+};
+
                       // =============================
                       // class SingleConsumerQueueImpl
                       // =============================
@@ -334,6 +439,22 @@ class SingleConsumerQueueImpl {
                                                                   MUTEX,
                                                                   CONDITION> >;
 
+    friend class SingleConsumerQueueImpl_PopRangeCompleteGuard<
+                                          SingleConsumerQueueImpl<TYPE,
+                                                                  ATOMIC_OP,
+                                                                  MUTEX,
+                                                                  CONDITION> >;
+
+    friend class SingleConsumerQueueImpl_PushRangeCompleteGuard<
+                           SingleConsumerQueueImpl<TYPE,
+                                                   ATOMIC_OP,
+                                                   MUTEX,
+                                                   CONDITION>,
+                           typename SingleConsumerQueueImpl<TYPE,
+                                                            ATOMIC_OP,
+                                                            MUTEX,
+                                                            CONDITION>::Node >;
+
     // PRIVATE CLASS METHODS
     static bsls::Types::Int64 available(bsls::Types::Int64 state);
         // Return the available attribute from the specified 'state'.
@@ -348,10 +469,56 @@ class SingleConsumerQueueImpl {
         // then signal the queue empty condition.  This method is used to
         // complete the reclamation of a node in the presence of an exception.
 
+    bsl::size_t popFrontRange(bsl::size_t        maxNumItems,
+                              bsl::vector<TYPE> *buffer);
+        // Remove up to the specified 'maxNumItems' consecutive elements from
+        // the front of this queue, append them, in order, to the specified
+        // 'buffer', and return the number of elements removed.  Nodes marked
+        // for reclamation encountered at the front of this queue are released.
+
+    void popRangeComplete(bsls::Types::Int64 numNodes,
+                          bsls::Types::Int64 numReclaim);
+        // Make the specified 'numNodes' released nodes, of which the specified
+        // 'numReclaim' were marked for reclamation, available for reuse, and
+        // if the queue is empty then signal the queue empty condition.  This
+        // method is used by a guard to complete a batch "pop" operation.
+
     Node *pushBackHelper();
         // Return a pointer to the node to assign the value being pushed into
         // this queue, or 0 if 'isPushBackDisabled()'.
 
+    Node *pushBackRangeHelper(bsls::Types::Int64 *numNodes);
+        // Reserve at most the specified '*numNodes' consecutive nodes to
+        // assign values being pushed into this queue, load the number of
+        // reserved nodes into '*numNodes', and return a pointer to the first
+        // reserved node, or return 0 if 'isPushBackDisabled()'.  Up to
+        // '*numNodes' existing available nodes are reserved with a single
+        // update of 'd_state' when possible; otherwise, exactly one node is
+        // reserved as if by 'pushBackHelper'.  The behavior is undefined
+        // unless '0 < *numNodes'.
+
+    void pushRangeComplete(Node               *node,
+                           bsls::Types::Int64  numReserved,
+                           bsls::Types::Int64  numConstructed);
+        // Mark readable the first specified 'numConstructed' of the specified
+        // 'numReserved' consecutive nodes starting at the specified 'node',
+        // mark the remaining nodes as nodes to be reclaimed, and signal the
+        // consumer, at most once, if it is blocked on one of the nodes.  This
+        // method is used by a guard to complete a batch "push" operation,
+        // including in the presence of an exception.
+
+    void releaseNextRead(bool destruct);
+        // If the specified 'destruct' is true, destruct the value stored in
+        // 'd_nextRead'.  Mark 'd_nextRead' writable and advance 'd_nextRead',
+        // without making the node available for reuse.
+
+    int waitUntilReadable(unsigned int generation);
+        // Block until 'd_nextRead' is readable, releasing the nodes marked for
+        // reclamation that are encountered.  Return 0 on success, and
+        // 'e_DISABLED' if the generation count of 'd_popFrontDisabled' differs
+        // from the specified 'generation' while blocked.  The behavior is
+        // undefined unless the invoker of this method is the single consumer.
+
     void incrementUntil(AtomicUint *value, unsigned int bitValue);
         // If the specified 'value' does not have its lowest-order bit set to
         // the value of the specified 'bitValue', increment 'value' until it
@@ -413,6 +580,18 @@ class SingleConsumerQueueImpl {
         // 'e_DISABLED' if 'disablePopFront' is invoked.  The behavior is
         // undefined unless the invoker of this method is the single consumer.
 
+    int popFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *buffer);
+        // Remove up to the specified 'maxNumItems' elements from the front of
+        // this queue and append them, in order, to the specified 'buffer'.  If
+        // the queue is empty, block until it is not empty.  Return 0 on
+        // success, and a non-zero value otherwise.  Specifically, return
+        // 'e_DISABLED' if 'isPopFrontDisabled()'.  On failure, 'buffer' is not
+        // changed.  Threads blocked due to the queue being empty will return
+        // 'e_DISABLED' if 'disablePopFront' is invoked.  The behavior is
+        // undefined unless '0 < maxNumItems' and the invoker of this method is
+        // the single consumer.  Note that at least one element is appended to
+        // 'buffer' on success.
+
     int pushBack(const TYPE& value);
         // Append the specified 'value' to the back of this queue.  Return 0 on
         // success, and a non-zero value otherwise.  Specifically, return
@@ -442,6 +621,16 @@ class SingleConsumerQueueImpl {
         // behavior is undefined unless the invoker of this method is the
         // single consumer.
 
+    int tryPopFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *buffer);
+        // Attempt to remove up to the specified 'maxNumItems' elements from
+        // the front of this queue without blocking, and append the removed
+        // elements, in order, to the specified 'buffer'.  Return 0 on success,
+        // and a non-zero value otherwise.  Specifically, return 'e_DISABLED'
+        // if 'isPopFrontDisabled()', and 'e_EMPTY' if '!isPopFrontDisabled()'
+        // and the queue was empty.  On failure, 'buffer' is not changed.  The
+        // behavior is undefined unless '0 < maxNumItems' and the invoker of
+        // this method is the single consumer.
+
     int tryPushBack(const TYPE& value);
         // Append the specified 'value' to the back of this queue.  Return 0 on
         // success, and a non-zero value otherwise.  Specifically, retun
@@ -454,6 +643,17 @@ class SingleConsumerQueueImpl {
         // 'e_DISABLED' if 'isPushBackDisabled()'.  On failure, 'value' is not
         // changed.
 
+    template <class FORWARD_ITER>
+    bsl::size_t tryPushBack(FORWARD_ITER begin, FORWARD_ITER end);
+        // Append the elements in the range starting at the specified 'begin'
+        // and ending immediately before the specified 'end' to the back of
+        // this queue, in order, and return the number of elements appended.
+        // Return 0, and append no elements, if 'isPushBackDisabled()'.  The
+        // behavior is undefined unless '[begin .. end)' is a valid range of
+        // elements convertible to 'TYPE'.  Note that, since this queue is
+        // unbounded, all the elements of the range are appended unless the
+        // queue is enqueue disabled during the operation.
+
                        // Enqueue/Dequeue State
 
     void disablePopFront();
@@ -593,6 +793,84 @@ SingleConsumerQueueImpl_PopCompleteGuard<TYPE>::
     d_queue_p->popComplete(true);
 }
 
+           // ---------------------------------------------------
+           // class SingleConsumerQueueImpl_PopRangeCompleteGuard
+           // ---------------------------------------------------
+
+// CREATORS
+template <class TYPE>
+SingleConsumerQueueImpl_PopRangeCompleteGuard<TYPE>::
+                     SingleConsumerQueueImpl_PopRangeCompleteGuard(TYPE *queue)
+: d_queue_p(queue)
+, d_numNodes(0)
+, d_numReclaim(0)
+, d_isHolding(false)
+{
+}
+
+template <class TYPE>
+SingleConsumerQueueImpl_PopRangeCompleteGuard<TYPE>::
+                               ~SingleConsumerQueueImpl_PopRangeCompleteGuard()
+{
+    if (d_isHolding) {
+        release(true);
+    }
+    d_queue_p->popRangeComplete(d_numNodes, d_numReclaim);
+}
+
+// MANIPULATORS
+template <class TYPE>
+void SingleConsumerQueueImpl_PopRangeCompleteGuard<TYPE>::hold()
+{
+    d_isHolding = true;
+}
+
+template <class TYPE>
+void SingleConsumerQueueImpl_PopRangeCompleteGuard<TYPE>::release(
+                                                                 bool destruct)
+{
+    d_isHolding = false;
+
+    d_queue_p->releaseNextRead(destruct);
+
+    ++d_numNodes;
+    if (!destruct) {
+        ++d_numReclaim;
+    }
+}
+
+           // ----------------------------------------------------
+           // class SingleConsumerQueueImpl_PushRangeCompleteGuard
+           // ----------------------------------------------------
+
+// CREATORS
+template <class TYPE, class NODE>
+SingleConsumerQueueImpl_PushRangeCompleteGuard<TYPE, NODE>::
+                               SingleConsumerQueueImpl_PushRangeCompleteGuard(
+                                           TYPE               *queue,
+                                           NODE               *node,
+                                           bsls::Types::Int64  numReserved)
+: d_queue_p(queue)
+, d_node_p(node)
+, d_numReserved(numReserved)
+, d_numConstructed(0)
+{
+}
+
+template <class TYPE, class NODE>
+SingleConsumerQueueImpl_PushRangeCompleteGuard<TYPE, NODE>::
+                              ~SingleConsumerQueueImpl_PushRangeCompleteGuard()
+{
+    d_queue_p->pushRangeComplete(d_node_p, d_numReserved, d_numConstructed);
+}
+
+// MANIPULATORS
+template <class TYPE, class NODE>
+void SingleConsumerQueueImpl_PushRangeCompleteGuard<TYPE, NODE>::increment()
+{
+    ++d_numConstructed;
+}
+
                       // -----------------------------
                       // class SingleConsumerQueueImpl
                       // -----------------------------
@@ -653,6 +931,76 @@ void SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>
     }
 }
 
+template <class TYPE, class ATOMIC_OP, class MUTEX, class CONDITION>
+bsl::size_t SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>
+                            ::popFrontRange(bsl::size_t        maxNumItems,
+                                            bsl::vector<TYPE> *buffer)
+{
+    // The nodes are released individually, but are made available for reuse
+    // with a single update of 'd_state' by the guard.
+
+    SingleConsumerQueueImpl_PopRangeCompleteGuard<
+                              SingleConsumerQueueImpl<TYPE,
+                                                      ATOMIC_OP,
+                                                      MUTEX,
+                                                      CONDITION> > guard(this);
+
+    bsl::size_t numPopped = 0;
+
+    while (numPopped < maxNumItems) {
+        Node *nextRead =
+                    static_cast<Node *>(ATOMIC_OP::getPtrAcquire(&d_nextRead));
+        int nodeState = ATOMIC_OP::getIntAcquire(&nextRead->d_state);
+
+        if (e_RECLAIM == nodeState) {
+            guard.release(false);
+        }
+        else if (e_READABLE == nodeState) {
+            guard.hold();
+
+#if defined(BSLMF_MOVABLEREF_USES_RVALUE_REFERENCES)
+            buffer->push_back(bslmf::MovableRefUtil::move(
+                                                  nextRead->d_value.object()));
+#else
+            buffer->push_back(nextRead->d_value.object());
+#endif
+
+            guard.release(true);
+            ++numPopped;
+        }
+        else {
+            break;
+        }
+    }
+
+    return numPopped;
+}
+
+template <class TYPE, class ATOMIC_OP, class MUTEX, class CONDITION>
+void SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>
+                           ::popRangeComplete(bsls::Types::Int64 numNodes,
+                                              bsls::Types::Int64 numReclaim)
+{
+    if (0 == numNodes) {
+        return;                                                       // RETURN
+    }
+
+    if (0 < numReclaim) {
+        ATOMIC_OP::addInt64AcqRel(&d_capacity, numReclaim);
+    }
+
+    bsls::Types::Int64 state = ATOMIC_OP::addInt64NvAcqRel(
+                                                  &d_state,
+                                                  k_AVAILABLE_INC * numNodes);
+
+    if (ATOMIC_OP::getInt64Acquire(&d_capacity) == available(state)) {
+        {
+            bslmt::LockGuard<MUTEX> guard(&d_emptyMutex);
+        }
+        d_emptyCondition.broadcast();
+    }
+}
+
 template <class TYPE, class ATOMIC_OP, class MUTEX, class CONDITION>
 typename SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>::Node *
                      SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>
@@ -754,6 +1102,167 @@ typename SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>::Node *
     return nextWrite;
 }
 
+template <class TYPE, class ATOMIC_OP, class MUTEX, class CONDITION>
+typename SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>::Node *
+                     SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>
+                          ::pushBackRangeHelper(bsls::Types::Int64 *numNodes)
+{
+    BSLS_ASSERT(0 < *numNodes);
+
+    if (1 == (ATOMIC_OP::getUintAcquire(&d_pushBackDisabled) & 1)) {
+        return 0;                                                     // RETURN
+    }
+
+    bsls::Types::Int64 count = available(ATOMIC_OP::getInt64Acquire(&d_state));
+    if (count > *numNodes) {
+        count = *numNodes;
+    }
+
+    if (1 < count) {
+        // Indicate the intention to use 'count' existing nodes.  As in
+        // 'pushBackHelper', the indication is undone if it was premature, in
+        // which case a single node is obtained below.
+
+        bsls::Types::Int64 state = ATOMIC_OP::addInt64NvAcqRel(
+                                          &d_state,
+                                          k_USE_INC - count * k_AVAILABLE_INC);
+
+        if (0 <= state && 0 == (state & k_ALLOCATE_MASK)) {
+            // Note that there are no threads attempting to allocate new nodes,
+            // so the links between the available nodes are stable.
+
+            Node *nextWrite = static_cast<Node *>(
+                                       ATOMIC_OP::getPtrAcquire(&d_nextWrite));
+            Node *expNextWrite;
+            do {
+                expNextWrite = nextWrite;
+
+                Node *next = nextWrite;
+                for (bsls::Types::Int64 i = 0; i < count; ++i) {
+                    next = static_cast<Node *>(
+                                     ATOMIC_OP::getPtrAcquire(&next->d_next));
+                }
+
+                nextWrite = static_cast<Node *>(
+                                 ATOMIC_OP::testAndSwapPtrAcqRel(&d_nextWrite,
+                                                                 nextWrite,
+                                                                 next));
+            } while (nextWrite != expNextWrite);
+
+            ATOMIC_OP::addInt64AcqRel(&d_state, -k_USE_INC);
+
+            *numNodes = count;
+
+            return nextWrite;                                         // RETURN
+        }
+
+        ATOMIC_OP::addInt64AcqRel(&d_state,
+                                  count * k_AVAILABLE_INC - k_USE_INC);
+    }
+
+    *numNodes = 1;
+
+    return pushBackHelper();
+}
+
+template <class TYPE, class ATOMIC_OP, class MUTEX, class CONDITION>
+void SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>
+                     ::pushRangeComplete(Node               *node,
+                                         bsls::Types::Int64  numReserved,
+                                         bsls::Types::Int64  numConstructed)
+{
+    // See 'markReclaim' for the treatment of nodes that suffered an exception.
+
+    if (numConstructed < numReserved) {
+        ATOMIC_OP::addInt64AcqRel(&d_capacity, numConstructed - numReserved);
+    }
+
+    bool isBlocked = false;
+
+    for (bsls::Types::Int64 i = 0; i < numReserved; ++i) {
+        // Obtain the next node before the consumer may read this node.
+
+        Node *next = static_cast<Node *>(ATOMIC_OP::getPtrAcquire(
+                                                              &node->d_next));
+
+        int nodeState = ATOMIC_OP::swapIntAcqRel(
+                                 &node->d_state,
+                                 i < numConstructed ? e_READABLE : e_RECLAIM);
+        if (e_WRITABLE_AND_BLOCKED == nodeState) {
+            isBlocked = true;
+        }
+
+        node = next;
+    }
+
+    if (isBlocked) {
+        {
+            bslmt::LockGuard<MUTEX> guard(&d_readMutex);
+        }
+        d_readCondition.signal();
+    }
+}
+
+template <class TYPE, class ATOMIC_OP, class MUTEX, class CONDITION>
+void SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>
+                                               ::releaseNextRead(bool destruct)
+{
+    Node *nextRead =
+                    static_cast<Node *>(ATOMIC_OP::getPtrAcquire(&d_nextRead));
+
+    if (destruct) {
+        nextRead->d_value.object().~TYPE();
+    }
+
+    ATOMIC_OP::setIntRelease(&nextRead->d_state, e_WRITABLE);
+
+    ATOMIC_OP::setPtrRelease(&d_nextRead,
+                             ATOMIC_OP::getPtrAcquire(&nextRead->d_next));
+}
+
+template <class TYPE, class ATOMIC_OP, class MUTEX, class CONDITION>
+int SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>
+                                 ::waitUntilReadable(unsigned int generation)
+{
+    Node *nextRead =
+                    static_cast<Node *>(ATOMIC_OP::getPtrAcquire(&d_nextRead));
+    int nodeState = ATOMIC_OP::getIntAcquire(&nextRead->d_state);
+    do {
+        // Note that 'e_WRITABLE_AND_BLOCKED != nodeState' since if the one
+        // consumer sets this state, the one consumer waits until the node is
+        // readable, and either the producer that signalled the consumer
+        // changed the node state already, or the consumer will change the node
+        // state in 'popComplete'.
+
+        if (e_WRITABLE == nodeState) {
+            bslmt::ThreadUtil::yield();
+            nodeState = ATOMIC_OP::getIntAcquire(&nextRead->d_state);
+            if (e_WRITABLE == nodeState) {
+                bslmt::LockGuard<MUTEX> guard(&d_readMutex);
+                nodeState = ATOMIC_OP::swapIntAcqRel(&nextRead->d_state,
+                                                     e_WRITABLE_AND_BLOCKED);
+                while (e_READABLE != nodeState && e_RECLAIM != nodeState) {
+                    if (generation !=
+                              ATOMIC_OP::getUintAcquire(&d_popFrontDisabled)) {
+                        return e_DISABLED;                            // RETURN
+                    }
+                    d_readCondition.wait(&d_readMutex);
+                    nodeState = ATOMIC_OP::getIntAcquire(&nextRead->d_state);
+                }
+            }
+        }
+        if (e_RECLAIM == nodeState) {
+            ATOMIC_OP::addInt64AcqRel(&d_capacity, 1);
+            popComplete(false);
+            nextRead =
+                    static_cast<Node *>(ATOMIC_OP::getPtrAcquire(&d_nextRead));
+            nodeState = ATOMIC_OP::getIntAcquire(&nextRead->d_state);
+        }
+    } while (e_RECLAIM == nodeState);
+
+    return 0;
+}
+
 template <class TYPE, class ATOMIC_OP, class MUTEX, class CONDITION>
 void SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>
                      ::incrementUntil(AtomicUint *value, unsigned int bitValue)
@@ -899,41 +1408,13 @@ int SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>::popFront(
         return e_DISABLED;                                            // RETURN
     }
 
-    Node *nextRead =
-                    static_cast<Node *>(ATOMIC_OP::getPtrAcquire(&d_nextRead));
-    int nodeState = ATOMIC_OP::getIntAcquire(&nextRead->d_state);
-    do {
-        // Note that 'e_WRITABLE_AND_BLOCKED != nodeState' since if the one
-        // consumer sets this state, the one consumer waits until the node is
-        // readable, and either the producer that signalled the consumer
-        // changed the node state already, or the consumer will change the node
-        // state in 'popComplete'.
+    int rv = waitUntilReadable(generation);
+    if (rv) {
+        return rv;                                                    // RETURN
+    }
 
-        if (e_WRITABLE == nodeState) {
-            bslmt::ThreadUtil::yield();
-            nodeState = ATOMIC_OP::getIntAcquire(&nextRead->d_state);
-            if (e_WRITABLE == nodeState) {
-                bslmt::LockGuard<MUTEX> guard(&d_readMutex);
-                nodeState = ATOMIC_OP::swapIntAcqRel(&nextRead->d_state,
-                                                     e_WRITABLE_AND_BLOCKED);
-                while (e_READABLE != nodeState && e_RECLAIM != nodeState) {
-                    if (generation !=
-                              ATOMIC_OP::getUintAcquire(&d_popFrontDisabled)) {
-                        return e_DISABLED;                            // RETURN
-                    }
-                    d_readCondition.wait(&d_readMutex);
-                    nodeState = ATOMIC_OP::getIntAcquire(&nextRead->d_state);
-                }
-            }
-        }
-        if (e_RECLAIM == nodeState) {
-            ATOMIC_OP::addInt64AcqRel(&d_capacity, 1);
-            popComplete(false);
-            nextRead =
+    Node *nextRead =
                     static_cast<Node *>(ATOMIC_OP::getPtrAcquire(&d_nextRead));
-            nodeState = ATOMIC_OP::getIntAcquire(&nextRead->d_state);
-        }
-    } while (e_RECLAIM == nodeState);
 
     SingleConsumerQueueImpl_PopCompleteGuard<
                               SingleConsumerQueueImpl<TYPE,
@@ -950,6 +1431,29 @@ int SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>::popFront(
     return 0;
 }
 
+template <class TYPE, class ATOMIC_OP, class MUTEX, class CONDITION>
+int SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>::popFront(
+                                                bsl::size_t        maxNumItems,
+                                                bsl::vector<TYPE> *buffer)
+{
+    BSLS_ASSERT(0 < maxNumItems);
+    BSLS_ASSERT(buffer);
+
+    unsigned int generation = ATOMIC_OP::getUintAcquire(&d_popFrontDisabled);
+    if (1 == (generation & 1)) {
+        return e_DISABLED;                                            // RETURN
+    }
+
+    int rv = waitUntilReadable(generation);
+    if (rv) {
+        return rv;                                                    // RETURN
+    }
+
+    popFrontRange(maxNumItems, buffer);
+
+    return 0;
+}
+
 template <class TYPE, class ATOMIC_OP, class MUTEX, class CONDITION>
 int SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>::pushBack(
                                                              const TYPE& value)
@@ -1092,6 +1596,26 @@ int SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>::tryPopFront(
     return 0;
 }
 
+template <class TYPE, class ATOMIC_OP, class MUTEX, class CONDITION>
+int SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>::tryPopFront(
+                                                bsl::size_t        maxNumItems,
+                                                bsl::vector<TYPE> *buffer)
+{
+    BSLS_ASSERT(0 < maxNumItems);
+    BSLS_ASSERT(buffer);
+
+    unsigned int generation = ATOMIC_OP::getUintAcquire(&d_popFrontDisabled);
+    if (1 == (generation & 1)) {
+        return e_DISABLED;                                            // RETURN
+    }
+
+    if (0 == popFrontRange(maxNumItems, buffer)) {
+        return e_EMPTY;                                               // RETURN
+    }
+
+    return 0;
+}
+
 template <class TYPE, class ATOMIC_OP, class MUTEX, class CONDITION>
 int SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>::tryPushBack(
                                                              const TYPE& value)
@@ -1106,6 +1630,48 @@ int SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>::tryPushBack(
     return pushBack(bslmf::MovableRefUtil::move(value));
 }
 
+template <class TYPE, class ATOMIC_OP, class MUTEX, class CONDITION>
+template <class FORWARD_ITER>
+bsl::size_t SingleConsumerQueueImpl<TYPE, ATOMIC_OP, MUTEX, CONDITION>
+                                 ::tryPushBack(FORWARD_ITER begin,
+                                               FORWARD_ITER end)
+{
+    bsls::Types::Int64 numRemaining = bsl::distance(begin, end);
+    bsl::size_t        numPushed    = 0;
+
+    while (0 < numRemaining) {
+        bsls::Types::Int64  numNodes = numRemaining;
+        Node               *node     = pushBackRangeHelper(&numNodes);
+
+        if (0 == node) {
+            break;
+        }
+
+        SingleConsumerQueueImpl_PushRangeCompleteGuard<
+                                            SingleConsumerQueueImpl<TYPE,
+                                                                    ATOMIC_OP,
+                                                                    MUTEX,
+                                                                    CONDITION>,
+                                            Node> guard(this, node, numNodes);
+
+        for (bsls::Types::Int64 i = 0; i < numNodes; ++i, ++begin) {
+            bslalg::ScalarPrimitives::copyConstruct<TYPE>(
+                                                      node->d_value.address(),
+                                                      *begin,
+                                                      d_allocator_p);
+            guard.increment();
+
+            node = static_cast<Node *>(ATOMIC_OP::getPtrAcquire(
+                                                              &node->d_next));
+        }
+
+        numRemaining -= numNodes;
+        numPushed    += static_cast<bsl::size_t>(numNodes);
+    }
+
+    return numPushed;
+}
+
                        // Enqueue/Dequeue State
 
 template <class TYPE, class ATOMIC_OP, class MUTEX, class CONDITION>
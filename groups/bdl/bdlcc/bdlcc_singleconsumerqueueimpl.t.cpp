@@ -83,6 +83,9 @@ using namespace bsl;
 // [ 8] int tryPopFront(TYPE *value);
 // [ 7] int tryPushBack(const TYPE& value);
 // [10] int tryPushBack(bslmf::MovableRef<TYPE> value);
+// [13] int popFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *buffer);
+// [13] int tryPopFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *buffer);
+// [13] bsl::size_t tryPushBack(FORWARD_ITER begin, FORWARD_ITER end);
 // [ 6] void disablePopFront();
 // [ 6] void disablePushBack();
 // [ 6] void enablePopFront();
@@ -102,6 +105,7 @@ using namespace bsl;
 // [10] CONCERN: 'popFront' and 'tryPopFront' honor move-semantics
 // [11] CONCERN: template requirements
 // [12] CONCERN: ordering guarantee
+// [13] CONCERN: batch operations
 // ----------------------------------------------------------------------------
 
 // ============================================================================
@@ -145,6 +149,13 @@ void aSsErT(int c, const char *s, int i)
 #define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
 #define L_           BSLIM_TESTUTIL_L_  // current Line number
 
+// ============================================================================
+//                     NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_FAIL(expr) BSLS_ASSERTTEST_ASSERT_FAIL(expr)
+#define ASSERT_PASS(expr) BSLS_ASSERTTEST_ASSERT_PASS(expr)
+
 // ============================================================================
 //                        GLOBAL MACROS FOR TESTING
 // ----------------------------------------------------------------------------
@@ -687,6 +698,146 @@ void orderingGuaranteeTest(const int numPushThread, const int numPopThread)
     bslmt::ThreadUtil::join(watchdogHandle);
 }
 
+struct BatchPopData {
+    OrderingObj                                              *d_obj_p;
+    bsl::unordered_map<bsls::Types::Uint64, bsls::Types::Uint64>
+                                                              d_sequenceNumber;
+    bsl::size_t                                               d_numPopped;
+    bool                                                      d_isStrongTest;
+};
+
+extern "C" void *batchPop(void *arg)
+{
+    BatchPopData *data = static_cast<BatchPopData *>(arg);
+    OrderingObj&  mX   = *data->d_obj_p;
+
+    bsl::vector<OrderingValue> buffer;
+
+    bsl::size_t maxNumItems = 1;
+
+    while (0 == mX.popFront(maxNumItems, &buffer)) {
+        ASSERTV(maxNumItems, buffer.size(), 0 < buffer.size());
+        ASSERTV(maxNumItems, buffer.size(), maxNumItems >= buffer.size());
+
+        for (bsl::size_t i = 0; i < buffer.size(); ++i) {
+            bsls::Types::Uint64 pushThreadId   = buffer[i].d_pushThreadId;
+            bsls::Types::Uint64 sequenceNumber = buffer[i].d_sequenceNumber;
+
+            bsls::Types::Uint64& lastSequenceNumber =
+                                          data->d_sequenceNumber[pushThreadId];
+
+            if (data->d_isStrongTest) {
+                ASSERTV(pushThreadId,
+                        lastSequenceNumber,
+                        sequenceNumber,
+                        lastSequenceNumber + 1 == sequenceNumber);
+            }
+            else {
+                ASSERTV(pushThreadId,
+                        lastSequenceNumber,
+                        sequenceNumber,
+                        lastSequenceNumber < sequenceNumber);
+            }
+
+            lastSequenceNumber = sequenceNumber;
+        }
+
+        data->d_numPopped += buffer.size();
+        buffer.clear();
+
+        maxNumItems = maxNumItems % 11 + 1;
+    }
+
+    return 0;
+}
+
+const bsls::Types::Uint64 k_NUM_BATCH_VALUES = 20000;  // per push thread
+
+extern "C" void *batchPush(void *arg)
+{
+    OrderingObj& mX = *static_cast<OrderingObj *>(arg);
+
+    bsl::vector<OrderingValue> values;
+
+    bsls::Types::Uint64 pushThreadId   = bslmt::ThreadUtil::selfIdAsUint64();
+    bsls::Types::Uint64 sequenceNumber = 1;
+
+    bsl::size_t batchSize = 1;
+
+    while (sequenceNumber <= k_NUM_BATCH_VALUES) {
+        values.clear();
+        for (bsl::size_t i = 0;
+             i < batchSize && sequenceNumber <= k_NUM_BATCH_VALUES;
+             ++i) {
+            OrderingValue value;
+            value.d_pushThreadId   = pushThreadId;
+            value.d_sequenceNumber = sequenceNumber++;
+            values.push_back(value);
+        }
+
+        bsl::size_t numPushed = mX.tryPushBack(values.begin(), values.end());
+        ASSERTV(numPushed, values.size(), numPushed == values.size());
+
+        batchSize = batchSize % 7 + 1;
+    }
+
+    return 0;
+}
+
+void batchOrderingTest(const int numPushThread, bsl::size_t capacity)
+    // Exercise an 'OrderingObj' having the specified initial 'capacity' using
+    // only the batch "push" and "pop" methods from the specified
+    // 'numPushThread' threads and one consumer thread, and verify that every
+    // enqueued element is dequeued exactly once and that, for the set of
+    // elements enqueued by a particular thread, the order in which the
+    // elements of this set are dequeued matches the order these elements were
+    // enqueued.
+{
+    bslmt::ThreadUtil::Handle              watchdogHandle;
+    bsl::vector<bslmt::ThreadUtil::Handle> pushHandle(numPushThread);
+    bslmt::ThreadUtil::Handle              popHandle;
+    BatchPopData                           batchPopData;
+
+    s_continue = 1;
+
+    OrderingObj mX(capacity);  const OrderingObj& X = mX;
+
+    setWatchdogText("batch ordering");
+    bslmt::ThreadUtil::create(&watchdogHandle, watchdog, 0);
+
+    batchPopData.d_obj_p        = &mX;
+    batchPopData.d_numPopped    = 0;
+    batchPopData.d_isStrongTest = 1 == numPushThread;
+    bslmt::ThreadUtil::create(&popHandle, batchPop, &batchPopData);
+
+    for (int i = 0; i < numPushThread; ++i) {
+        bslmt::ThreadUtil::create(&pushHandle[i], batchPush, &mX);
+    }
+
+    setWatchdogText("batch ordering: join push");
+    for (int i = 0; i < numPushThread; ++i) {
+        bslmt::ThreadUtil::join(pushHandle[i]);
+    }
+
+    setWatchdogText("batch ordering: wait until empty");
+    int rv = X.waitUntilEmpty();
+    ASSERT(0 == rv);
+    ASSERT(0 == X.numElements());
+
+    mX.disablePopFront();
+
+    setWatchdogText("batch ordering: join pop");
+    bslmt::ThreadUtil::join(popHandle);
+
+    ASSERTV(batchPopData.d_numPopped,
+            batchPopData.d_numPopped == numPushThread * k_NUM_BATCH_VALUES);
+
+    s_continue = 0;
+
+    setWatchdogText("batch ordering: join watchdog");
+    bslmt::ThreadUtil::join(watchdogHandle);
+}
+
 // ============================================================================
 //               GENERATOR FUNCTIONS 'gg' AND 'ggg' FOR TESTING
 // ----------------------------------------------------------------------------
@@ -805,6 +956,282 @@ int main(int argc, char *argv[])
     ASSERT(0 == bslma::Default::setDefaultAllocator(&defaultAllocator));
 
     switch (test) { case 0:  // Zero is always the leading case.
+      case 13: {
+        // --------------------------------------------------------------------
+        // BATCH OPERATIONS
+        //   Ensure the batch "push" and "pop" methods transfer ranges of
+        //   elements correctly.
+        //
+        // Concerns:
+        //: 1 'tryPushBack' of a range appends all the elements of the range,
+        //:   in order, using existing nodes when available and allocating
+        //:   nodes otherwise, and returns the number of elements appended.
+        //:
+        //: 2 'popFront' and 'tryPopFront' append, in order, at most the
+        //:   requested number of elements, and at least one element, to the
+        //:   supplied buffer.
+        //:
+        //: 3 The batch methods honor the enqueue and dequeue disabled states,
+        //:   and, on failure, do not modify the supplied buffer.
+        //:
+        //: 4 An exception thrown while constructing an element of a batch
+        //:   leaves the queue in a usable state, the elements constructed
+        //:   before the exception are available, and the nodes of the
+        //:   remaining elements are reclaimed.
+        //:
+        //: 5 Every element enqueued by concurrent batch producers is dequeued
+        //:   exactly once by a batch consumer, and the ordering guarantee is
+        //:   provided.
+        //:
+        //: 6 Supplying a 'maxNumItems' of 0 is detected in appropriate build
+        //:   modes.
+        //
+        // Plan:
+        //: 1 Directly exercise the batch methods, verifying return values,
+        //:   the contents of the buffer, the number of elements in the queue,
+        //:   and the number of allocations.  (C-1..3)
+        //:
+        //: 2 Using a type whose copy allocates, cause an exception part way
+        //:   through a batch 'tryPushBack' and verify the subsequent behavior
+        //:   of the queue.  (C-4)
+        //:
+        //: 3 Using multiple threads performing only batch operations on
+        //:   elements that store a sequence number, verify the number of
+        //:   dequeued elements and the per-thread sequence numbers.  (C-5)
+        //:
+        //: 4 Verify defensive checks are triggered for invalid values.  (C-6)
+        //
+        // Testing:
+        //   int popFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *buffer);
+        //   int tryPopFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *buf);
+        //   bsl::size_t tryPushBack(FORWARD_ITER begin, FORWARD_ITER end);
+        //   CONCERN: batch operations
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BATCH OPERATIONS" << endl
+                          << "================" << endl;
+
+        if (verbose) cout << "\nTesting basic functionality." << endl;
+        {
+            bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+
+            Obj mX(4, &sa);  const Obj& X = mX;
+
+            const int VALUES[]   = { 1, 2, 3, 4, 5, 6 };
+            const int NUM_VALUES = static_cast<int>(sizeof VALUES
+                                                    / sizeof *VALUES);
+
+            bsl::vector<int> buffer;
+
+            ASSERT(0 == mX.tryPushBack(VALUES, VALUES));
+            ASSERT(0 == X.numElements());
+
+            ASSERT(e_EMPTY == mX.tryPopFront(3, &buffer));
+            ASSERT(buffer.empty());
+
+            // Four elements use the existing nodes; two require allocation.
+
+            bsls::Types::Int64 na = sa.numAllocations();
+
+            ASSERT(6 == mX.tryPushBack(VALUES, VALUES + NUM_VALUES));
+            ASSERT(6 == X.numElements());
+            ASSERT(na + 2 == sa.numAllocations());
+
+            ASSERT(e_SUCCESS == mX.tryPopFront(4, &buffer));
+            ASSERT(4 == buffer.size());
+            ASSERT(2 == X.numElements());
+
+            ASSERT(e_SUCCESS == mX.popFront(10, &buffer));
+            ASSERT(6 == buffer.size());
+            ASSERT(0 == X.numElements());
+            ASSERT(X.isEmpty());
+
+            for (bsl::size_t i = 0; i < buffer.size(); ++i) {
+                ASSERTV(i, buffer[i], VALUES[i] == buffer[i]);
+            }
+
+            // Exercise every combination of batch sizes with no further
+            // allocation.
+
+            na = sa.numAllocations();
+
+            int next     = 0;
+            int expected = 0;
+            for (int numPush = 1; numPush <= 6; ++numPush) {
+                for (int numPop = 1; numPop <= 6; ++numPop) {
+                    bsl::vector<int> values;
+                    for (int i = 0; i < numPush; ++i) {
+                        values.push_back(next++);
+                    }
+
+                    ASSERTV(numPush,
+                            numPop,
+                            static_cast<bsl::size_t>(numPush) ==
+                                 mX.tryPushBack(values.begin(), values.end()));
+
+                    while (!X.isEmpty()) {
+                        buffer.clear();
+
+                        int rv = mX.tryPopFront(numPop, &buffer);
+                        ASSERTV(numPush, numPop, e_SUCCESS == rv);
+                        ASSERTV(numPush,
+                                numPop,
+                                buffer.size(),
+                                0 < buffer.size()
+                                 && static_cast<bsl::size_t>(numPop) >=
+                                                                buffer.size());
+
+                        for (bsl::size_t i = 0; i < buffer.size(); ++i) {
+                            ASSERTV(numPush,
+                                    numPop,
+                                    expected,
+                                    buffer[i],
+                                    expected == buffer[i]);
+                            ++expected;
+                        }
+                    }
+                }
+            }
+            ASSERT(next == expected);
+            ASSERT(na   == sa.numAllocations());
+
+            // The single-element and batch methods interoperate.
+
+            ASSERT(e_SUCCESS == mX.pushBack(7));
+            ASSERT(3 == mX.tryPushBack(VALUES, VALUES + 3));
+
+            int value = 0;
+            ASSERT(e_SUCCESS == mX.popFront(&value));
+            ASSERT(7 == value);
+
+            buffer.clear();
+            ASSERT(e_SUCCESS == mX.popFront(4, &buffer));
+            ASSERT(3 == buffer.size());
+            ASSERT(0 == X.numElements());
+        }
+
+        if (verbose) cout << "\nTesting disabled states." << endl;
+        {
+            Obj mX(8);  const Obj& X = mX;
+
+            const int VALUES[] = { 1, 2, 3 };
+
+            bsl::vector<int> buffer(1, 9);
+
+            ASSERT(3 == mX.tryPushBack(VALUES, VALUES + 3));
+
+            mX.disablePushBack();
+            ASSERT(0 == mX.tryPushBack(VALUES, VALUES + 3));
+            ASSERT(3 == X.numElements());
+
+            mX.disablePopFront();
+            ASSERT(e_DISABLED == mX.popFront(2, &buffer));
+            ASSERT(e_DISABLED == mX.tryPopFront(2, &buffer));
+            ASSERT(1 == buffer.size());
+            ASSERT(9 == buffer[0]);
+            ASSERT(3 == X.numElements());
+
+            mX.enablePopFront();
+            mX.enablePushBack();
+
+            ASSERT(e_SUCCESS == mX.popFront(8, &buffer));
+            ASSERT(4 == buffer.size());
+            ASSERT(0 == X.numElements());
+        }
+
+        if (verbose) cout << "\nTesting 'popFront' blocks." << endl;
+        {
+            Obj mX(8);
+
+            bsl::vector<int> buffer;
+
+            bslmt::ThreadUtil::Handle handle;
+            bslmt::ThreadUtil::create(&handle, deferredDisablePopFront, &mX);
+
+            ASSERT(e_DISABLED == mX.popFront(4, &buffer));
+            ASSERT(buffer.empty());
+
+            bslmt::ThreadUtil::join(handle);
+        }
+
+#ifdef BDE_BUILD_TARGET_EXC
+        if (verbose) cout << "\nTesting exception safety." << endl;
+        {
+            // white-box test for when the element copy throws part way through
+            // a batch
+
+            bsl::string longString("abc");
+            for (bsl::size_t i = 0; i < sizeof(bsl::string); ++i) {
+                longString += " ";
+            }
+
+            bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+
+            AllocObj mX(8, &sa);  const AllocObj& X = mX;
+
+            bsl::vector<bsl::string> values(3, longString);
+            bsl::vector<bsl::string> buffer;
+
+            int numException = 0;
+
+            sa.setAllocationLimit(1);
+            try {
+                mX.tryPushBack(values.begin(), values.end());
+            } catch (BloombergLP::bslma::TestAllocatorException& e) {
+                ++numException;
+            }
+            sa.setAllocationLimit(-1);
+
+            ASSERT(1 == numException);
+            ASSERT(1 == X.numElements());
+
+            ASSERT(e_SUCCESS == mX.tryPopFront(8, &buffer));
+            ASSERT(1 == buffer.size());
+            ASSERT(0 == X.numElements());
+            ASSERT(X.isEmpty());
+
+            // The reclaimed nodes are reused without further allocation.
+
+            bsls::Types::Int64 na = sa.numAllocations();
+
+            ASSERT(8 == mX.tryPushBack(values.begin(), values.end())
+                      + mX.tryPushBack(values.begin(), values.end())
+                      + mX.tryPushBack(values.begin(), values.begin() + 2));
+            ASSERT(8 == X.numElements());
+            ASSERT(na + 8 == sa.numAllocations());
+
+            buffer.clear();
+            ASSERT(e_SUCCESS == mX.popFront(8, &buffer));
+            ASSERT(8 == buffer.size());
+            ASSERT(X.isEmpty());
+        }
+#endif
+
+        if (verbose) cout << "\nTesting concurrent batches." << endl;
+        {
+            batchOrderingTest(1, 0);   // SPSC, allocating
+            batchOrderingTest(4, 0);   // MPSC, allocating
+            batchOrderingTest(4, 64);  // MPSC, mostly existing nodes
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            Obj mX(8);
+
+            const int VALUE = 1;
+
+            bsl::vector<int> buffer;
+
+            mX.tryPushBack(&VALUE, &VALUE + 1);
+            ASSERT_FAIL(mX.popFront(0, &buffer));
+            ASSERT_PASS(mX.popFront(1, &buffer));
+            ASSERT_FAIL(mX.tryPopFront(0, &buffer));
+            ASSERT_PASS(mX.tryPopFront(1, &buffer));
+        }
+      } break;
       case 12: {
         // ---------------------------------------------------------
         // Ordering Guarantee Test
@@ -46,6 +46,17 @@ BSLS_IDENT("$Id: $")
 // disabled return immediately and return an error code.  The queue may be
 // restored to normal operation with the 'enablePopFront' method.
 //
+///Wait Strategy
+///-------------
+// By default, the consumer invoking 'popFront' on an empty queue yields the
+// processor once, re-checks for an element, and then blocks on a condition
+// variable until the producer signals it.  Latency-critical consumers can
+// instead supply a 'bdlcc::WaitStrategy' at construction, specifying the
+// number of times 'popFront' re-checks for an element while spinning, and
+// then while yielding, before it blocks (see 'bdlcc_waitstrategy').  The
+// 'waitStrategyCounters' accessor reports how many of those waits were
+// satisfied while spinning, were satisfied while yielding, or blocked.
+//
 ///Template Requirements
 ///---------------------
 // 'bdlcc::SingleProducerSingleConsumerBoundedQueue' is a template that is
@@ -177,6 +188,8 @@ BSLS_IDENT("$Id: $")
 
 #include <bdlscm_version.h>
 
+#include <bdlcc_waitstrategy.h>
+
 #include <bslalg_scalarprimitives.h>
 
 #include <bslma_default.h>
@@ -365,6 +378,12 @@ class SingleProducerSingleConsumerBoundedQueue {
     mutable bslmt::Condition  d_emptyCondition;  // condition variable for
                                                  // 'waitUntilEmpty'
 
+    WaitStrategy              d_waitStrategy;    // strategy for blocking
+                                                 // "pop" operations
+
+    WaitStrategyCounters      d_waitCounters;    // outcomes of the waits of
+                                                 // blocking "pop" operations
+
     bslma::Allocator         *d_allocator_p;     // allocator, held not owned
 
     // FRIENDS
@@ -460,10 +479,16 @@ class SingleProducerSingleConsumerBoundedQueue {
     SingleProducerSingleConsumerBoundedQueue(
                                          bsl::size_t       capacity,
                                          bslma::Allocator *basicAllocator = 0);
+    SingleProducerSingleConsumerBoundedQueue(
+                                      bsl::size_t          capacity,
+                                      const WaitStrategy&  waitStrategy,
+                                      bslma::Allocator    *basicAllocator = 0);
         // Create a thread-aware queue with, at least, the specified
-        // 'capacity'.  Optionally specify a 'basicAllocator' used to supply
-        // memory.  If 'basicAllocator' is 0, the currently installed default
-        // allocator is used.
+        // 'capacity'.  Optionally specify a 'waitStrategy' used by 'popFront'
+        // when the queue is empty (see {Wait Strategy}); if 'waitStrategy' is
+        // not specified, 'WaitStrategy(0, 1)' is used.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.
 
     ~SingleProducerSingleConsumerBoundedQueue();
         // Destroy this object.
@@ -589,6 +614,15 @@ class SingleProducerSingleConsumerBoundedQueue {
         // thread waiting for the queue to empty will return a non-zero value
         // if 'disablePopFront' is invoked.
 
+    const WaitStrategy& waitStrategy() const;
+        // Return a reference providing non-modifiable access to the wait
+        // strategy used by 'popFront'.
+
+    const WaitStrategyCounters& waitStrategyCounters() const;
+        // Return a reference providing non-modifiable access to the counters
+        // of the outcomes of the waits of 'popFront' invocations that found
+        // this queue empty.
+
                                   // Aspects
 
     bslma::Allocator *allocator() const;
@@ -698,7 +732,8 @@ int SingleProducerSingleConsumerBoundedQueue<TYPE>::popFrontImp(TYPE *value,
 
     // If the node is not available for reading:
     //   * if this is a "try" invocation, return
-    //   * otherwise, yield and check again, then block
+    //   * otherwise, spin and yield as configured by 'd_waitStrategy',
+    //     checking again after each step, then block
     // Note that 'e_WRITABLE_AND_BLOCKED != nodeState' since this is the one
     // consumer.
 
@@ -707,9 +742,19 @@ int SingleProducerSingleConsumerBoundedQueue<TYPE>::popFrontImp(TYPE *value,
             return e_EMPTY;                                           // RETURN
         }
 
-        bslmt::ThreadUtil::yield();
-        nodeState = AtomicOp::getUintAcquire(&node.d_state);
-        if (e_WRITABLE == nodeState) {
+        WaitStrategyBackoff backoff(d_waitStrategy, &d_waitCounters);
+        while (e_WRITABLE == nodeState && backoff.backoff()) {
+            if (disabledGen !=
+                          AtomicOp::getUintAcquire(&d_popDisabledGeneration)) {
+                return e_DISABLED;                                    // RETURN
+            }
+            nodeState = AtomicOp::getUintAcquire(&node.d_state);
+        }
+
+        if (e_WRITABLE != nodeState) {
+            backoff.recordAcquire();
+        }
+        else {
             bslmt::LockGuard<bslmt::Mutex> guard(&d_popMutex);
 
             nodeState = AtomicOp::testAndSwapUintAcqRel(
@@ -934,6 +979,47 @@ SingleProducerSingleConsumerBoundedQueue<TYPE>::
 , d_pushCondition()
 , d_emptyMutex()
 , d_emptyCondition()
+, d_waitStrategy(0, 1)
+, d_waitCounters()
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    AtomicOp::initUint64(&d_popIndex,  0);
+    AtomicOp::initUint64(&d_pushIndex, 0);
+
+    AtomicOp::initUint(&d_popDisabledGeneration,  0);
+    AtomicOp::initUint(&d_emptyCount,             0);
+    AtomicOp::initUint(&d_emptyGeneration,        0);
+    AtomicOp::initUint(&d_pushDisabledGeneration, 0);
+
+    d_popElement_p = static_cast<Node *>(
+                        d_allocator_p->allocate(d_popCapacity * sizeof(Node)));
+
+    d_pushElement_p = d_popElement_p;
+
+    for (bsl::size_t i = 0; i < d_popCapacity; ++i) {
+        AtomicOp::initUint(&d_popElement_p[i].d_state, e_WRITABLE);
+    }
+}
+
+template <class TYPE>
+SingleProducerSingleConsumerBoundedQueue<TYPE>::
+     SingleProducerSingleConsumerBoundedQueue(
+                                      bsl::size_t          capacity,
+                                      const WaitStrategy&  waitStrategy,
+                                      bslma::Allocator    *basicAllocator)
+: d_popElement_p(0)
+, d_popCapacity(capacity > 0 ? capacity : 1)
+, d_popPad()
+, d_pushCapacity(capacity > 0 ? capacity : 1)
+, d_pushPad()
+, d_popMutex()
+, d_popCondition()
+, d_pushMutex()
+, d_pushCondition()
+, d_emptyMutex()
+, d_emptyCondition()
+, d_waitStrategy(waitStrategy)
+, d_waitCounters()
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     AtomicOp::initUint64(&d_popIndex,  0);
@@ -1191,6 +1277,22 @@ int SingleProducerSingleConsumerBoundedQueue<TYPE>::waitUntilEmpty() const
     return e_SUCCESS;
 }
 
+template <class TYPE>
+inline
+const WaitStrategy&
+SingleProducerSingleConsumerBoundedQueue<TYPE>::waitStrategy() const
+{
+    return d_waitStrategy;
+}
+
+template <class TYPE>
+inline
+const WaitStrategyCounters&
+SingleProducerSingleConsumerBoundedQueue<TYPE>::waitStrategyCounters() const
+{
+    return d_waitCounters;
+}
+
                                   // Aspects
 
 template <class TYPE>
@@ -81,6 +81,7 @@ using namespace bsl;
 //: o ACCESSOR methods are 'const' thread-safe.
 // ----------------------------------------------------------------------------
 // [ 2] SingleProducerSingleConsumerBoundedQueue(capacity, bA = 0);
+// [12] SingleProducerSingleConsumerBoundedQueue(capacity, strategy, bA);
 // [ 2] ~SingleProducerSingleConsumerBoundedQueue();
 // [ 2] int popFront(TYPE *value);
 // [ 2] int pushBack(const TYPE& value);
@@ -100,9 +101,11 @@ using namespace bsl;
 // [ 4] bsl::size_t numElements() const;
 // [ 8] int waitUntilEmpty() const;
 // [ 4] bslma::Allocator *allocator() const;
+// [12] const WaitStrategy& waitStrategy() const;
+// [12] const WaitStrategyCounters& waitStrategyCounters() const;
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [12] USAGE EXAMPLE
+// [13] USAGE EXAMPLE
 // [ 3] Obj& gg(Obj *object, const char *spec);
 // [ 3] int ggg(Obj *object, const char *spec);
 // [ 2] CONCERN: 0 == e_SUCCESS
@@ -110,6 +113,7 @@ using namespace bsl;
 // [ 9] CONCERN: 'popFront' and 'tryPopFront' honor move-semantics
 // [10] CONCERN: template requirements
 // [11] CONCERN: ordering guarantee
+// [12] CONCERN: wait strategy
 // ----------------------------------------------------------------------------
 
 // ============================================================================
@@ -516,6 +520,17 @@ extern "C" void *deferredDisablePopFront(void *arg)
     return 0;
 }
 
+extern "C" void *deferredPushBack(void *arg)
+{
+    Obj& mX = *static_cast<Obj *>(arg);
+
+    bslmt::ThreadUtil::microSleep(k_DECISECOND);
+
+    mX.pushBack(7);
+
+    return 0;
+}
+
 static bsls::TimeInterval s_deferredPopFrontInterval;
 
 extern "C" void *deferredPopFront(void *arg)
@@ -954,7 +969,7 @@ int main(int argc, char *argv[])
     ASSERT(0 == bslma::Default::setDefaultAllocator(&defaultAllocator));
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 12: {
+      case 13: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -992,6 +1007,147 @@ int main(int argc, char *argv[])
 
         bslmt::ThreadUtil::join(watchdogHandle);
       } break;
+      case 12: {
+        // --------------------------------------------------------------------
+        // WAIT STRATEGY
+        //   Ensure a blocking 'popFront' follows the wait strategy supplied at
+        //   construction and records the outcomes of its waits.
+        //
+        // Concerns:
+        //: 1 The queue reports the wait strategy supplied at construction, or
+        //:   a strategy that yields once before blocking if none was
+        //:   supplied.
+        //:
+        //: 2 A 'popFront' that finds an element available records nothing.
+        //:
+        //: 3 A 'popFront' that waits records exactly one outcome: a spin, a
+        //:   yield, or a park, according to the strategy.
+        //:
+        //: 4 A spinning 'popFront' returns 'e_DISABLED' if the queue is
+        //:   dequeue disabled while it spins.
+        //
+        // Plan:
+        //: 1 Create queues with and without a strategy and verify the
+        //:   accessors.  (C-1)
+        //:
+        //: 2 Pop from a non-empty queue and verify the counters.  (C-2)
+        //:
+        //: 3 For strategies that only park, only spin (with a spin count
+        //:   large enough to outlast the delay), and only yield, pop from an
+        //:   empty queue while another thread pushes an element after a delay,
+        //:   and verify the counters.  (C-3)
+        //:
+        //: 4 Spin in 'popFront' while another thread disables the queue.
+        //:   (C-4)
+        //
+        // Testing:
+        //   SingleProducerSingleConsumerBoundedQueue(capacity, strategy, bA);
+        //   const WaitStrategy& waitStrategy() const;
+        //   const WaitStrategyCounters& waitStrategyCounters() const;
+        //   CONCERN: wait strategy
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "WAIT STRATEGY" << endl
+                          << "=============" << endl;
+
+        typedef bdlcc::WaitStrategy         Strategy;
+        typedef bdlcc::WaitStrategyCounters Counters;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        bslmt::ThreadUtil::Handle watchdogHandle;
+
+        s_continue = 1;
+
+        bslmt::ThreadUtil::create(&watchdogHandle,
+                                  watchdog,
+                                  const_cast<char *>("wait strategy"));
+
+        const int k_LARGE = 1 << 30;
+
+        {
+            Obj mX(4, &ta);  const Obj& X = mX;
+            ASSERT(Strategy(0, 1) == X.waitStrategy());
+            ASSERT(&ta            == X.allocator());
+
+            Obj mY(4, Strategy(100, 2), &ta);  const Obj& Y = mY;
+            ASSERT(Strategy(100, 2) == Y.waitStrategy());
+            ASSERT(&ta              == Y.allocator());
+
+            const Counters& C = Y.waitStrategyCounters();
+            ASSERT(0 == C.numSpins());
+            ASSERT(0 == C.numYields());
+            ASSERT(0 == C.numParks());
+
+            int value = 0;
+            mY.pushBack(1);
+            ASSERT(e_SUCCESS == mY.popFront(&value));
+            ASSERT(1 == value);
+            ASSERT(0 == C.numSpins() + C.numYields() + C.numParks());
+        }
+
+        static const struct {
+            int                 d_line;
+            int                 d_spinCount;
+            int                 d_yieldCount;
+            bsls::Types::Uint64 d_expSpins;
+            bsls::Types::Uint64 d_expYields;
+            bsls::Types::Uint64 d_expParks;
+        } DATA[] = {
+            { L_,       0,       0, 0, 0, 1 },
+            { L_,       0,       1, 0, 0, 1 },
+            { L_, k_LARGE,       0, 1, 0, 0 },
+            { L_,       0, k_LARGE, 0, 1, 0 },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int                 LINE       = DATA[ti].d_line;
+            const int                 SPIN       = DATA[ti].d_spinCount;
+            const int                 YIELD      = DATA[ti].d_yieldCount;
+            const bsls::Types::Uint64 EXP_SPINS  = DATA[ti].d_expSpins;
+            const bsls::Types::Uint64 EXP_YIELDS = DATA[ti].d_expYields;
+            const bsls::Types::Uint64 EXP_PARKS  = DATA[ti].d_expParks;
+
+            if (veryVerbose) { T_ P_(LINE) P_(SPIN) P(YIELD) }
+
+            Obj mX(4, Strategy(SPIN, YIELD), &ta);  const Obj& X = mX;
+
+            bslmt::ThreadUtil::Handle handle;
+            bslmt::ThreadUtil::create(&handle, deferredPushBack, &mX);
+
+            int value = 0;
+            ASSERTV(LINE, e_SUCCESS == mX.popFront(&value));
+            ASSERTV(LINE, 7 == value);
+
+            bslmt::ThreadUtil::join(handle);
+
+            const Counters& C = X.waitStrategyCounters();
+            ASSERTV(LINE, C.numSpins(),  EXP_SPINS  == C.numSpins());
+            ASSERTV(LINE, C.numYields(), EXP_YIELDS == C.numYields());
+            ASSERTV(LINE, C.numParks(),  EXP_PARKS  == C.numParks());
+        }
+
+        if (verbose) cout << "\tDisabling a spinning 'popFront'" << endl;
+        {
+            Obj mX(4, Strategy(k_LARGE, 0), &ta);
+
+            bslmt::ThreadUtil::Handle handle;
+            bslmt::ThreadUtil::create(&handle, deferredDisablePopFront, &mX);
+
+            int value = 0;
+            ASSERT(e_DISABLED == mX.popFront(&value));
+
+            bslmt::ThreadUtil::join(handle);
+
+            ASSERT(0 == mX.waitStrategyCounters().numParks());
+        }
+
+        s_continue = 0;
+
+        bslmt::ThreadUtil::join(watchdogHandle);
+      } break;
       case 11: {
         // ---------------------------------------------------------
         // ORDERING GUARANTEE TEST
@@ -0,0 +1,54 @@
+// bdlcc_waitstrategy.cpp                                             -*-C++-*-
+#include <bdlcc_waitstrategy.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlcc_waitstrategy_cpp,"$Id$ $CSID$")
+
+#include <bslmt_threadutil.h>
+
+#include <bsls_platform.h>
+
+#if defined(BSLS_PLATFORM_CPU_X86) || defined(BSLS_PLATFORM_CPU_X86_64)
+#include <emmintrin.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlcc {
+
+                         // -------------------------
+                         // class WaitStrategyBackoff
+                         // -------------------------
+
+// CLASS METHODS
+void WaitStrategyBackoff::pause()
+{
+#if defined(BSLS_PLATFORM_CPU_X86) || defined(BSLS_PLATFORM_CPU_X86_64)
+    _mm_pause();
+#elif defined(BSLS_PLATFORM_CPU_ARM) && defined(BSLS_PLATFORM_CMP_GNU)
+    __asm__ __volatile__("yield" ::: "memory");
+#endif
+}
+
+void WaitStrategyBackoff::yield()
+{
+    bslmt::ThreadUtil::yield();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
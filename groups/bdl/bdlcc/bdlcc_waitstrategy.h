@@ -0,0 +1,574 @@
+// bdlcc_waitstrategy.h                                               -*-C++-*-
+#ifndef INCLUDED_BDLCC_WAITSTRATEGY
+#define INCLUDED_BDLCC_WAITSTRATEGY
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a spin-then-yield-then-park strategy for blocking waits.
+//
+//@CLASSES:
+//  bdlcc::WaitStrategy: attributes configuring a spin-yield-park wait
+//  bdlcc::WaitStrategyCounters: thread-safe counters of how waits completed
+//  bdlcc::WaitStrategyBackoff: mechanism stepping through a 'WaitStrategy'
+//
+//@SEE_ALSO: bdlcc_boundedqueue, bdlcc_fixedqueue,
+//           bdlcc_singleproducersingleconsumerboundedqueue
+//
+//@DESCRIPTION: This component provides an attribute class,
+// 'bdlcc::WaitStrategy', that configures how a thread waiting for a condition
+// (e.g., a consumer waiting for an element to appear in a queue) behaves
+// before it blocks in the operating system ("parks"), a mechanism,
+// 'bdlcc::WaitStrategyBackoff', that carries out the steps configured by a
+// 'WaitStrategy', and a class, 'bdlcc::WaitStrategyCounters', that counts how
+// the waits performed according to a strategy were satisfied.
+//
+// Parking a thread (waiting on a semaphore or condition variable) and waking
+// it again each require a system call, and the latency between the wake-up
+// and the woken thread running is typically tens of microseconds.  A waiter
+// that expects the condition to be satisfied shortly can instead re-check the
+// condition in a loop.  A 'WaitStrategy' has two attributes:
+//
+//: 'spinCount': the number of times the condition is re-checked, executing a
+//:   CPU "pause" instruction (where available) between checks, before
+//:   yielding.  Spinning keeps the waiting thread on its CPU and gives a
+//:   hand-off latency well below a microsecond, at the cost of fully using a
+//:   CPU while spinning.
+//:
+//: 'yieldCount': the number of times the condition is re-checked, yielding
+//:   the processor between checks, after spinning and before parking.
+//
+// The default strategy has both counts 0: the waiter parks as soon as the
+// condition is found to be unsatisfied.  Note that spinning is beneficial
+// only when the waiting thread and the thread satisfying the condition run on
+// different CPUs; a large 'spinCount' on an over-subscribed machine wastes the
+// CPU time that the thread satisfying the condition needs.
+//
+// 'bdlcc::WaitStrategyBackoff' is used by the implementation of a blocking
+// wait: after each unsuccessful check of the condition, 'backoff' performs
+// the next pause or yield of the strategy, or returns 'false' once the spin
+// and yield steps are exhausted, after which the waiter parks.  The backoff
+// object records, in a 'bdlcc::WaitStrategyCounters' object, whether the wait
+// was satisfied while spinning or while yielding (when 'recordAcquire' is
+// invoked), or required parking (when 'backoff' first returns 'false'), so
+// that the effectiveness of a strategy can be measured.
+//
+///Thread Safety
+///-------------
+// 'bdlcc::WaitStrategy' is *const* *thread-safe*, and
+// 'bdlcc::WaitStrategyCounters' is *fully* *thread-safe*.  A
+// 'bdlcc::WaitStrategyBackoff' object is intended to be used by a single
+// thread for the duration of a single wait.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Waiting for a Flag
+///- - - - - - - - - - - - - - -
+// Suppose we have a flag that is set by another thread, and a semaphore that
+// the other thread posts after setting the flag if a waiter has announced
+// that it is parked.  First, we define a function that waits for the flag
+// according to a supplied 'bdlcc::WaitStrategy':
+//..
+//  void waitForFlag(bsls::AtomicBool            *flag,
+//                   bsls::AtomicInt             *numParked,
+//                   bslmt::Semaphore            *semaphore,
+//                   const bdlcc::WaitStrategy&   strategy,
+//                   bdlcc::WaitStrategyCounters *counters)
+//  {
+//      if (*flag) {
+//          return;                                                   // RETURN
+//      }
+//
+//      bdlcc::WaitStrategyBackoff backoff(strategy, counters);
+//      while (!*flag) {
+//          if (backoff.backoff()) {
+//              continue;
+//          }
+//
+//          // The spin and yield steps are exhausted; park.
+//
+//          ++*numParked;
+//          if (!*flag) {
+//              semaphore->wait();
+//          }
+//          --*numParked;
+//      }
+//      backoff.recordAcquire();
+//  }
+//..
+// Next, we define the function that sets the flag, and then wakes the waiter
+// if it has parked:
+//..
+//  void setFlag(bsls::AtomicBool *flag,
+//               bsls::AtomicInt  *numParked,
+//               bslmt::Semaphore *semaphore)
+//  {
+//      *flag = true;
+//      if (*numParked) {
+//          semaphore->post();
+//      }
+//  }
+//..
+// Then, we set the flag in a separate thread, and wait for it using a
+// strategy that spins for a while before yielding and then parking:
+//..
+//  bsls::AtomicBool            flag(false);
+//  bsls::AtomicInt             numParked(0);
+//  bslmt::Semaphore            semaphore;
+//  bdlcc::WaitStrategyCounters counters;
+//
+//  bslmt::ThreadUtil::Handle handle;
+//  bslmt::ThreadUtil::create(&handle,
+//                            bdlf::BindUtil::bind(&setFlag,
+//                                                 &flag,
+//                                                 &numParked,
+//                                                 &semaphore));
+//
+//  waitForFlag(&flag,
+//              &numParked,
+//              &semaphore,
+//              bdlcc::WaitStrategy(1000, 10),
+//              &counters);
+//
+//  bslmt::ThreadUtil::join(handle);
+//..
+// Finally, we observe that the wait was recorded at most once, as satisfied
+// while spinning, satisfied while yielding, or requiring parking:
+//..
+//  assert(1 >= counters.numSpins()
+//            + counters.numYields()
+//            + counters.numParks());
+//..
+// Note that no outcome is recorded if the flag was already set when
+// 'waitForFlag' was called.
+
+#include <bdlscm_version.h>
+
+#include <bsls_assert.h>
+#include <bsls_atomic.h>
+#include <bsls_performancehint.h>
+#include <bsls_types.h>
+
+namespace BloombergLP {
+namespace bdlcc {
+
+                             // ==================
+                             // class WaitStrategy
+                             // ==================
+
+class WaitStrategy {
+    // This simply constrained (value-semantic) attribute class describes the
+    // number of times a waiting thread re-checks its condition while spinning,
+    // and then while yielding, before it parks.
+
+    // DATA
+    int d_spinCount;   // number of checks separated by a CPU pause
+    int d_yieldCount;  // number of checks separated by a processor yield
+
+  public:
+    // CREATORS
+    WaitStrategy();
+        // Create a wait strategy having a 'spinCount' and 'yieldCount' of 0
+        // (i.e., a strategy that parks immediately).
+
+    WaitStrategy(int spinCount, int yieldCount);
+        // Create a wait strategy having the specified 'spinCount' and
+        // 'yieldCount'.  The behavior is undefined unless '0 <= spinCount' and
+        // '0 <= yieldCount'.
+
+    //! WaitStrategy(const WaitStrategy& original) = default;
+    //! ~WaitStrategy() = default;
+
+    // MANIPULATORS
+    //! WaitStrategy& operator=(const WaitStrategy& rhs) = default;
+
+    WaitStrategy& setSpinCount(int value);
+        // Set the 'spinCount' attribute of this object to the specified
+        // 'value', and return a reference providing modifiable access to this
+        // object.  The behavior is undefined unless '0 <= value'.
+
+    WaitStrategy& setYieldCount(int value);
+        // Set the 'yieldCount' attribute of this object to the specified
+        // 'value', and return a reference providing modifiable access to this
+        // object.  The behavior is undefined unless '0 <= value'.
+
+    // ACCESSORS
+    bool parksImmediately() const;
+        // Return 'true' if both the 'spinCount' and 'yieldCount' attributes of
+        // this object are 0, and 'false' otherwise.
+
+    int spinCount() const;
+        // Return the number of times a waiting thread re-checks its condition,
+        // pausing the CPU between checks, before yielding.
+
+    int yieldCount() const;
+        // Return the number of times a waiting thread re-checks its condition,
+        // yielding the processor between checks, after spinning and before
+        // parking.
+};
+
+// FREE OPERATORS
+bool operator==(const WaitStrategy& lhs, const WaitStrategy& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects have the same
+    // value, and 'false' otherwise.  Two 'WaitStrategy' objects have the same
+    // value if their 'spinCount' and 'yieldCount' attributes are respectively
+    // the same.
+
+bool operator!=(const WaitStrategy& lhs, const WaitStrategy& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' objects do not have the
+    // same value, and 'false' otherwise.  Two 'WaitStrategy' objects do not
+    // have the same value if either their 'spinCount' or 'yieldCount'
+    // attributes differ.
+
+                         // ==========================
+                         // class WaitStrategyCounters
+                         // ==========================
+
+class WaitStrategyCounters {
+    // This class provides thread-safe counters of the waits, performed
+    // according to a 'WaitStrategy', that were satisfied while spinning, were
+    // satisfied while yielding, or required the waiting thread to park.
+
+    // DATA
+    bsls::AtomicUint64 d_numSpins;   // waits satisfied while spinning
+    bsls::AtomicUint64 d_numYields;  // waits satisfied while yielding
+    bsls::AtomicUint64 d_numParks;   // waits that required parking
+
+    // NOT IMPLEMENTED
+    WaitStrategyCounters(const WaitStrategyCounters&);
+    WaitStrategyCounters& operator=(const WaitStrategyCounters&);
+
+  public:
+    // CREATORS
+    WaitStrategyCounters();
+        // Create a counters object having all counts 0.
+
+    //! ~WaitStrategyCounters() = default;
+
+    // MANIPULATORS
+    void recordPark();
+        // Increment the number of waits that required parking.
+
+    void recordSpin();
+        // Increment the number of waits satisfied while spinning.
+
+    void recordYield();
+        // Increment the number of waits satisfied while yielding.
+
+    void reset();
+        // Set all the counts of this object to 0.  Note that this operation
+        // is not atomic with respect to concurrent increments.
+
+    // ACCESSORS
+    bsls::Types::Uint64 numParks() const;
+        // Return the number of waits that required parking.
+
+    bsls::Types::Uint64 numSpins() const;
+        // Return the number of waits satisfied while spinning.
+
+    bsls::Types::Uint64 numYields() const;
+        // Return the number of waits satisfied while yielding.
+};
+
+                         // =========================
+                         // class WaitStrategyBackoff
+                         // =========================
+
+class WaitStrategyBackoff {
+    // This mechanism class carries out the spin and yield steps of a
+    // 'WaitStrategy' for a single wait, and records the outcome of the wait
+    // in an optional 'WaitStrategyCounters' object.
+
+    // DATA
+    int                   d_spinCount;   // spin steps of the strategy
+    int                   d_yieldCount;  // yield steps of the strategy
+    int                   d_numSpins;    // number of spin steps performed
+    int                   d_numYields;   // number of yield steps performed
+    bool                  d_isParked;    // 'true' if the steps are exhausted
+    WaitStrategyCounters *d_counters_p;  // counters to update (held, not
+                                         // owned), or 0
+
+    // NOT IMPLEMENTED
+    WaitStrategyBackoff(const WaitStrategyBackoff&);
+    WaitStrategyBackoff& operator=(const WaitStrategyBackoff&);
+
+  public:
+    // CLASS METHODS
+    static void pause();
+        // If available, execute a CPU pause instruction (e.g., Intel's
+        // 'pause'), which improves the performance of spin-wait loops;
+        // otherwise do nothing.
+
+    static void yield();
+        // Move the current thread to the end of the scheduler's queue and
+        // schedule another thread to run.
+
+    // CREATORS
+    explicit
+    WaitStrategyBackoff(const WaitStrategy&    strategy,
+                        WaitStrategyCounters  *counters = 0);
+        // Create a backoff object that performs the steps of the specified
+        // 'strategy'.  Optionally specify 'counters' in which to record the
+        // outcome of the wait.
+
+    //! ~WaitStrategyBackoff() = default;
+
+    // MANIPULATORS
+    bool backoff();
+        // If fewer than 'spinCount' steps of the strategy supplied at
+        // construction have been performed, pause the CPU; otherwise, if
+        // fewer than 'spinCount + yieldCount' steps have been performed, yield
+        // the processor.  Return 'true' if a step was performed, and 'false'
+        // (without pausing or yielding) if the spin and yield steps are
+        // exhausted and the caller should park.  The first time 'false' is
+        // returned, record, in the counters supplied at construction (if
+        // any), that the wait required parking.
+
+    void recordAcquire();
+        // Record, in the counters supplied at construction (if any), that the
+        // wait was satisfied while spinning or while yielding, as indicated by
+        // the steps performed so far.  If no step has been performed (the
+        // condition was satisfied immediately), or the wait has been recorded
+        // as requiring parking, this method has no effect.
+
+    // ACCESSORS
+    bool isParked() const;
+        // Return 'true' if 'backoff' has returned 'false' (i.e., the spin and
+        // yield steps are exhausted), and 'false' otherwise.
+
+    bsls::Types::Int64 numSteps() const;
+        // Return the number of spin and yield steps performed so far.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                             // ------------------
+                             // class WaitStrategy
+                             // ------------------
+
+// CREATORS
+inline
+WaitStrategy::WaitStrategy()
+: d_spinCount(0)
+, d_yieldCount(0)
+{
+}
+
+inline
+WaitStrategy::WaitStrategy(int spinCount, int yieldCount)
+: d_spinCount(spinCount)
+, d_yieldCount(yieldCount)
+{
+    BSLS_ASSERT(0 <= spinCount);
+    BSLS_ASSERT(0 <= yieldCount);
+}
+
+// MANIPULATORS
+inline
+WaitStrategy& WaitStrategy::setSpinCount(int value)
+{
+    BSLS_ASSERT(0 <= value);
+
+    d_spinCount = value;
+    return *this;
+}
+
+inline
+WaitStrategy& WaitStrategy::setYieldCount(int value)
+{
+    BSLS_ASSERT(0 <= value);
+
+    d_yieldCount = value;
+    return *this;
+}
+
+// ACCESSORS
+inline
+bool WaitStrategy::parksImmediately() const
+{
+    return 0 == d_spinCount && 0 == d_yieldCount;
+}
+
+inline
+int WaitStrategy::spinCount() const
+{
+    return d_spinCount;
+}
+
+inline
+int WaitStrategy::yieldCount() const
+{
+    return d_yieldCount;
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+inline
+bool bdlcc::operator==(const WaitStrategy& lhs, const WaitStrategy& rhs)
+{
+    return lhs.spinCount()  == rhs.spinCount()
+        && lhs.yieldCount() == rhs.yieldCount();
+}
+
+inline
+bool bdlcc::operator!=(const WaitStrategy& lhs, const WaitStrategy& rhs)
+{
+    return !(lhs == rhs);
+}
+
+namespace bdlcc {
+
+                         // --------------------------
+                         // class WaitStrategyCounters
+                         // --------------------------
+
+// CREATORS
+inline
+WaitStrategyCounters::WaitStrategyCounters()
+: d_numSpins(0)
+, d_numYields(0)
+, d_numParks(0)
+{
+}
+
+// MANIPULATORS
+inline
+void WaitStrategyCounters::recordPark()
+{
+    d_numParks.addRelaxed(1);
+}
+
+inline
+void WaitStrategyCounters::recordSpin()
+{
+    d_numSpins.addRelaxed(1);
+}
+
+inline
+void WaitStrategyCounters::recordYield()
+{
+    d_numYields.addRelaxed(1);
+}
+
+inline
+void WaitStrategyCounters::reset()
+{
+    d_numSpins.storeRelaxed(0);
+    d_numYields.storeRelaxed(0);
+    d_numParks.storeRelaxed(0);
+}
+
+// ACCESSORS
+inline
+bsls::Types::Uint64 WaitStrategyCounters::numParks() const
+{
+    return d_numParks.loadRelaxed();
+}
+
+inline
+bsls::Types::Uint64 WaitStrategyCounters::numSpins() const
+{
+    return d_numSpins.loadRelaxed();
+}
+
+inline
+bsls::Types::Uint64 WaitStrategyCounters::numYields() const
+{
+    return d_numYields.loadRelaxed();
+}
+
+                         // -------------------------
+                         // class WaitStrategyBackoff
+                         // -------------------------
+
+// CREATORS
+inline
+WaitStrategyBackoff::WaitStrategyBackoff(const WaitStrategy&    strategy,
+                                         WaitStrategyCounters  *counters)
+: d_spinCount(strategy.spinCount())
+, d_yieldCount(strategy.yieldCount())
+, d_numSpins(0)
+, d_numYields(0)
+, d_isParked(false)
+, d_counters_p(counters)
+{
+}
+
+// MANIPULATORS
+inline
+bool WaitStrategyBackoff::backoff()
+{
+    // Note that the spin and yield steps are counted separately, so that a
+    // strategy whose total number of steps is not representable as an 'int'
+    // is supported.
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(d_numSpins < d_spinCount)) {
+        ++d_numSpins;
+        pause();
+        return true;                                                  // RETURN
+    }
+    if (d_numYields < d_yieldCount) {
+        ++d_numYields;
+        yield();
+        return true;                                                  // RETURN
+    }
+    if (!d_isParked) {
+        d_isParked = true;
+        if (d_counters_p) {
+            d_counters_p->recordPark();
+        }
+    }
+    return false;
+}
+
+inline
+void WaitStrategyBackoff::recordAcquire()
+{
+    if (d_counters_p && (0 < d_numSpins || 0 < d_numYields) && !d_isParked) {
+        if (0 == d_numYields) {
+            d_counters_p->recordSpin();
+        }
+        else {
+            d_counters_p->recordYield();
+        }
+    }
+}
+
+// ACCESSORS
+inline
+bool WaitStrategyBackoff::isParked() const
+{
+    return d_isParked;
+}
+
+inline
+bsls::Types::Int64 WaitStrategyBackoff::numSteps() const
+{
+    return static_cast<bsls::Types::Int64>(d_numSpins) + d_numYields;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
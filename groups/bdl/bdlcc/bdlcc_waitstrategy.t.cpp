@@ -0,0 +1,646 @@
+// bdlcc_waitstrategy.t.cpp                                           -*-C++-*-
+
+#include <bdlcc_waitstrategy.h>
+
+#include <bdlf_bind.h>
+
+#include <bslim_testutil.h>
+
+#include <bslmt_semaphore.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_limits.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test provides a simply constrained attribute class,
+// 'bdlcc::WaitStrategy', a class of thread-safe counters,
+// 'bdlcc::WaitStrategyCounters', and a mechanism,
+// 'bdlcc::WaitStrategyBackoff', that performs the steps of a strategy and
+// records the outcome of a wait.
+//
+// The attribute class is tested by setting and comparing attribute values.
+// The mechanism is tested by counting the steps it performs for strategies
+// having various spin and yield counts, and by verifying the outcome recorded
+// after each number of steps.
+// ----------------------------------------------------------------------------
+// WaitStrategy
+// [ 2] WaitStrategy();
+// [ 2] WaitStrategy(int spinCount, int yieldCount);
+// [ 2] WaitStrategy& setSpinCount(int value);
+// [ 2] WaitStrategy& setYieldCount(int value);
+// [ 2] bool parksImmediately() const;
+// [ 2] int spinCount() const;
+// [ 2] int yieldCount() const;
+// [ 2] bool operator==(const WaitStrategy&, const WaitStrategy&);
+// [ 2] bool operator!=(const WaitStrategy&, const WaitStrategy&);
+//
+// WaitStrategyCounters
+// [ 3] WaitStrategyCounters();
+// [ 3] void recordPark();
+// [ 3] void recordSpin();
+// [ 3] void recordYield();
+// [ 3] void reset();
+// [ 3] bsls::Types::Uint64 numParks() const;
+// [ 3] bsls::Types::Uint64 numSpins() const;
+// [ 3] bsls::Types::Uint64 numYields() const;
+//
+// WaitStrategyBackoff
+// [ 4] static void pause();
+// [ 4] static void yield();
+// [ 4] WaitStrategyBackoff(const WaitStrategy&, WaitStrategyCounters *);
+// [ 4] bool backoff();
+// [ 4] void recordAcquire();
+// [ 4] bool isParked() const;
+// [ 4] bsls::Types::Int64 numSteps() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] USAGE EXAMPLE
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static bool             verbose;
+static bool         veryVerbose;
+static bool     veryVeryVerbose;
+static bool veryVeryVeryVerbose;
+
+typedef bdlcc::WaitStrategy         Obj;
+typedef bdlcc::WaitStrategyCounters Counters;
+typedef bdlcc::WaitStrategyBackoff  Backoff;
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+namespace usage {
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Waiting for a Flag
+///- - - - - - - - - - - - - - -
+// Suppose we have a flag that is set by another thread, and a semaphore that
+// the other thread posts after setting the flag if a waiter has announced
+// that it is parked.  First, we define a function that waits for the flag
+// according to a supplied 'bdlcc::WaitStrategy':
+//..
+    void waitForFlag(bsls::AtomicBool            *flag,
+                     bsls::AtomicInt             *numParked,
+                     bslmt::Semaphore            *semaphore,
+                     const bdlcc::WaitStrategy&   strategy,
+                     bdlcc::WaitStrategyCounters *counters)
+    {
+        if (*flag) {
+            return;                                                   // RETURN
+        }
+
+        bdlcc::WaitStrategyBackoff backoff(strategy, counters);
+        while (!*flag) {
+            if (backoff.backoff()) {
+                continue;
+            }
+
+            // The spin and yield steps are exhausted; park.
+
+            ++*numParked;
+            if (!*flag) {
+                semaphore->wait();
+            }
+            --*numParked;
+        }
+        backoff.recordAcquire();
+    }
+//..
+// Next, we define the function that sets the flag, and then wakes the waiter
+// if it has parked:
+//..
+    void setFlag(bsls::AtomicBool *flag,
+                 bsls::AtomicInt  *numParked,
+                 bslmt::Semaphore *semaphore)
+    {
+        *flag = true;
+        if (*numParked) {
+            semaphore->post();
+        }
+    }
+//..
+
+void example1()
+{
+// Then, we set the flag in a separate thread, and wait for it using a
+// strategy that spins for a while before yielding and then parking:
+//..
+    bsls::AtomicBool            flag(false);
+    bsls::AtomicInt             numParked(0);
+    bslmt::Semaphore            semaphore;
+    bdlcc::WaitStrategyCounters counters;
+
+    bslmt::ThreadUtil::Handle handle;
+    bslmt::ThreadUtil::create(&handle,
+                              bdlf::BindUtil::bind(&setFlag,
+                                                   &flag,
+                                                   &numParked,
+                                                   &semaphore));
+
+    waitForFlag(&flag,
+                &numParked,
+                &semaphore,
+                bdlcc::WaitStrategy(1000, 10),
+                &counters);
+
+    bslmt::ThreadUtil::join(handle);
+//..
+// Finally, we observe that the wait was recorded at most once, as satisfied
+// while spinning, satisfied while yielding, or requiring parking:
+//..
+    ASSERT(1 >= counters.numSpins()
+              + counters.numYields()
+              + counters.numParks());
+//..
+// Note that no outcome is recorded if the flag was already set when
+// 'waitForFlag' was called.
+}
+
+}  // close namespace usage
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test            = argc > 1 ? atoi(argv[1]) : 0;
+    verbose             = argc > 2;
+    veryVerbose         = argc > 3;
+    veryVeryVerbose     = argc > 4;
+    veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        usage::example1();
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // WAITSTRATEGYBACKOFF
+        //
+        // Concerns:
+        //: 1 'backoff' returns 'true' exactly 'spinCount + yieldCount' times,
+        //:   and 'false' thereafter.
+        //:
+        //: 2 The first 'false' returned by 'backoff' records one park, and
+        //:   subsequent calls record nothing further.
+        //:
+        //: 3 'recordAcquire' records a spin if at most 'spinCount' steps were
+        //:   performed, a yield if more were performed, and nothing if no
+        //:   step was performed or the wait has been recorded as parked.
+        //:
+        //: 4 The backoff operates without counters.
+        //:
+        //: 5 'pause' and 'yield' may be invoked directly.
+        //:
+        //: 6 A strategy whose total number of steps exceeds 'INT_MAX' is
+        //:   supported.
+        //
+        // Plan:
+        //: 1 For a table of strategies, perform each possible number of
+        //:   steps with a fresh backoff object, then invoke 'recordAcquire',
+        //:   and verify the counters.  (C-1..3)
+        //:
+        //: 2 Repeat P-1 without counters.  (C-4)
+        //:
+        //: 3 Invoke 'pause' and 'yield'.  (C-5)
+        //:
+        //: 4 Back off with strategies having 'INT_MAX' spin or yield steps,
+        //:   and verify the step count and recorded counters.  (C-6)
+        //
+        // Testing:
+        //   static void pause();
+        //   static void yield();
+        //   WaitStrategyBackoff(const WaitStrategy&, WaitStrategyCounters *);
+        //   bool backoff();
+        //   void recordAcquire();
+        //   bool isParked() const;
+        //   bsls::Types::Int64 numSteps() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "WAITSTRATEGYBACKOFF" << endl
+                          << "===================" << endl;
+
+        static const struct {
+            int d_line;
+            int d_spinCount;
+            int d_yieldCount;
+        } DATA[] = {
+            { L_,   0,   0 },
+            { L_,   1,   0 },
+            { L_,   0,   1 },
+            { L_,   3,   2 },
+            { L_, 100,   0 },
+            { L_,  10,   5 },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int LINE  = DATA[ti].d_line;
+            const int SPIN  = DATA[ti].d_spinCount;
+            const int YIELD = DATA[ti].d_yieldCount;
+
+            if (veryVerbose) { T_ P_(LINE) P_(SPIN) P(YIELD) }
+
+            const Obj STRATEGY(SPIN, YIELD);
+
+            for (int numSteps = 0; numSteps <= SPIN + YIELD + 1; ++numSteps) {
+                Counters counters;
+                Backoff  mX(STRATEGY, &counters);  const Backoff& X = mX;
+
+                ASSERTV(LINE, 0 == X.numSteps());
+                ASSERTV(LINE, !X.isParked());
+
+                for (int i = 0; i < numSteps; ++i) {
+                    const bool EXP = i < SPIN + YIELD;
+                    ASSERTV(LINE, numSteps, i, EXP == mX.backoff());
+                }
+
+                const bool PARKED = numSteps > SPIN + YIELD;
+                const int  STEPS  = PARKED ? SPIN + YIELD : numSteps;
+
+                ASSERTV(LINE, numSteps, STEPS  == X.numSteps());
+                ASSERTV(LINE, numSteps, PARKED == X.isParked());
+                ASSERTV(LINE, numSteps, PARKED == counters.numParks());
+
+                // Further unsuccessful steps record nothing further.
+
+                if (PARKED) {
+                    ASSERTV(LINE, !mX.backoff());
+                    ASSERTV(LINE, 1 == counters.numParks());
+                }
+
+                mX.recordAcquire();
+
+                const bool SPUN    = !PARKED && 0 < STEPS && STEPS <= SPIN;
+                const bool YIELDED = !PARKED && STEPS > SPIN;
+
+                ASSERTV(LINE, numSteps, SPUN    == counters.numSpins());
+                ASSERTV(LINE, numSteps, YIELDED == counters.numYields());
+                ASSERTV(LINE, numSteps, PARKED  == counters.numParks());
+
+                // Without counters.
+
+                Backoff mY(STRATEGY);  const Backoff& Y = mY;
+                for (int i = 0; i < numSteps; ++i) {
+                    mY.backoff();
+                }
+                mY.recordAcquire();
+                ASSERTV(LINE, numSteps, STEPS  == Y.numSteps());
+                ASSERTV(LINE, numSteps, PARKED == Y.isParked());
+            }
+        }
+
+        if (verbose) cout << "\tExtreme step counts" << endl;
+        {
+            // The total number of steps of these strategies is not
+            // representable as an 'int'.
+
+            const int MAX = bsl::numeric_limits<int>::max();
+
+            Counters counters;
+            Backoff  mX(Obj(MAX, 1), &counters);  const Backoff& X = mX;
+
+            for (int i = 0; i < 3; ++i) {
+                ASSERTV(i, mX.backoff());
+            }
+            ASSERTV(X.numSteps(), 3 == X.numSteps());
+            ASSERT(!X.isParked());
+
+            mX.recordAcquire();
+            ASSERTV(counters.numSpins(), 1 == counters.numSpins());
+            ASSERTV(counters.numYields(), 0 == counters.numYields());
+
+            Backoff mY(Obj(0, MAX));  const Backoff& Y = mY;
+            ASSERT(mY.backoff());
+            ASSERTV(Y.numSteps(), 1 == Y.numSteps());
+            ASSERT(!Y.isParked());
+        }
+
+        if (verbose) cout << "\tPause and yield" << endl;
+        {
+            for (int i = 0; i < 10; ++i) {
+                Backoff::pause();
+            }
+            Backoff::yield();
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // WAITSTRATEGYCOUNTERS
+        //
+        // Concerns:
+        //: 1 A default-constructed object has all counts 0.
+        //:
+        //: 2 Each 'record*' method increments only its own count.
+        //:
+        //: 3 'reset' sets all counts to 0.
+        //
+        // Plan:
+        //: 1 Record various numbers of each outcome and verify the counts,
+        //:   then reset the object and verify the counts.  (C-1..3)
+        //
+        // Testing:
+        //   WaitStrategyCounters();
+        //   void recordPark();
+        //   void recordSpin();
+        //   void recordYield();
+        //   void reset();
+        //   bsls::Types::Uint64 numParks() const;
+        //   bsls::Types::Uint64 numSpins() const;
+        //   bsls::Types::Uint64 numYields() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "WAITSTRATEGYCOUNTERS" << endl
+                          << "====================" << endl;
+
+        Counters mX;  const Counters& X = mX;
+
+        ASSERT(0 == X.numSpins());
+        ASSERT(0 == X.numYields());
+        ASSERT(0 == X.numParks());
+
+        mX.recordSpin();
+        ASSERT(1 == X.numSpins());
+        ASSERT(0 == X.numYields());
+        ASSERT(0 == X.numParks());
+
+        mX.recordYield();
+        mX.recordYield();
+        ASSERT(1 == X.numSpins());
+        ASSERT(2 == X.numYields());
+        ASSERT(0 == X.numParks());
+
+        mX.recordPark();
+        mX.recordPark();
+        mX.recordPark();
+        ASSERT(1 == X.numSpins());
+        ASSERT(2 == X.numYields());
+        ASSERT(3 == X.numParks());
+
+        mX.reset();
+        ASSERT(0 == X.numSpins());
+        ASSERT(0 == X.numYields());
+        ASSERT(0 == X.numParks());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // WAITSTRATEGY
+        //
+        // Concerns:
+        //: 1 The default constructor creates a strategy that parks
+        //:   immediately.
+        //:
+        //: 2 The value constructor and the manipulators set the attributes,
+        //:   and the manipulators return a reference to the object.
+        //:
+        //: 3 The equality operators compare both attributes.
+        //:
+        //: 4 The copy constructor and assignment operator copy the value.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create objects using each constructor, modify them, and verify
+        //:   their attributes and comparisons.  (C-1..4)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for negative attribute values.  (C-5)
+        //
+        // Testing:
+        //   WaitStrategy();
+        //   WaitStrategy(int spinCount, int yieldCount);
+        //   WaitStrategy& setSpinCount(int value);
+        //   WaitStrategy& setYieldCount(int value);
+        //   bool parksImmediately() const;
+        //   int spinCount() const;
+        //   int yieldCount() const;
+        //   bool operator==(const WaitStrategy&, const WaitStrategy&);
+        //   bool operator!=(const WaitStrategy&, const WaitStrategy&);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "WAITSTRATEGY" << endl
+                          << "============" << endl;
+
+        Obj mX;  const Obj& X = mX;
+        ASSERT(0 == X.spinCount());
+        ASSERT(0 == X.yieldCount());
+        ASSERT(X.parksImmediately());
+
+        const Obj Y(100, 3);
+        ASSERT(100 == Y.spinCount());
+        ASSERT(  3 == Y.yieldCount());
+        ASSERT(!Y.parksImmediately());
+
+        ASSERT(  X == Obj());
+        ASSERT(!(X != Obj()));
+        ASSERT(  X != Y);
+        ASSERT(!(X == Y));
+
+        ASSERT(&mX == &mX.setSpinCount(100));
+        ASSERT(100 == X.spinCount());
+        ASSERT(!X.parksImmediately());
+        ASSERT(X != Y);
+        ASSERT(X == Obj(100, 0));
+
+        ASSERT(&mX == &mX.setYieldCount(3));
+        ASSERT(3 == X.yieldCount());
+        ASSERT(X == Y);
+
+        mX.setSpinCount(0);
+        ASSERT(!X.parksImmediately());
+        ASSERT(X == Obj(0, 3));
+        mX.setYieldCount(0);
+        ASSERT(X.parksImmediately());
+
+        Obj mZ(Y);  const Obj& Z = mZ;
+        ASSERT(Z == Y);
+        mZ = X;
+        ASSERT(Z == X);
+
+        if (verbose) cout << "\tNegative testing" << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_PASS(Obj(0, 0));
+            ASSERT_FAIL(Obj(-1, 0));
+            ASSERT_FAIL(Obj(0, -1));
+            ASSERT_PASS(mX.setSpinCount(0));
+            ASSERT_FAIL(mX.setSpinCount(-1));
+            ASSERT_PASS(mX.setYieldCount(0));
+            ASSERT_FAIL(mX.setYieldCount(-1));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The classes are sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create a strategy, perform its steps using a backoff object, and
+        //:   verify the recorded outcome.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        Counters counters;
+        {
+            Backoff backoff(Obj(2, 1), &counters);
+            ASSERT(backoff.backoff());
+            backoff.recordAcquire();
+        }
+        {
+            Backoff backoff(Obj(2, 1), &counters);
+            ASSERT(backoff.backoff());
+            ASSERT(backoff.backoff());
+            ASSERT(backoff.backoff());
+            backoff.recordAcquire();
+        }
+        {
+            Backoff backoff(Obj(2, 1), &counters);
+            while (backoff.backoff()) {
+            }
+            ASSERT(backoff.isParked());
+            backoff.recordAcquire();
+        }
+        ASSERT(1 == counters.numSpins());
+        ASSERT(1 == counters.numYields());
+        ASSERT(1 == counters.numParks());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,505 @@
+// bdlma_mappedregionallocator.cpp                                    -*-C++-*-
+#include <bdlma_mappedregionallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_mappedregionallocator_cpp,"$Id$ $CSID$")
+
+#include <bslmt_lockguard.h>
+
+#include <bslmf_assert.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_atomic.h>
+#include <bsls_exceptionutil.h>      // 'BSLS_THROW'
+#include <bsls_performancehint.h>
+#include <bsls_platform.h>
+
+#include <bsl_cstddef.h>             // 'bsl::size_t'
+#include <bsl_new.h>                 // 'bsl::bad_alloc'
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+#include <windows.h>   // 'GetSystemInfo', 'VirtualAlloc', 'VirtualFree'
+
+#else
+
+#include <sys/mman.h>  // 'madvise', 'mmap', 'munmap'
+#include <unistd.h>    // 'sysconf'
+
+#endif
+
+namespace BloombergLP {
+namespace {
+
+typedef bsls::Types::size_type size_type;
+
+enum {
+    k_MAX_ALIGNMENT    = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT,
+
+    k_MIN_SIZE_CLASS   = 6,                // smallest block is 64 bytes
+
+    k_DEDICATED        = -1,               // size class of a block having a
+                                           // dedicated mapping
+
+    k_HUGE_PAGE_SIZE   = 2 * 1024 * 1024,  // huge page size assumed on all
+                                           // supported platforms
+
+    k_DEFAULT_REGION_SIZE = 64 * 1024 * 1024
+};
+
+union BlockHeader {
+    // This 'union' prefixes each block returned by the allocator, and records
+    // the size class of the block.
+
+    int                                 d_sizeClass;  // 'log2' of the block
+                                                      // size, or
+                                                      // 'k_DEDICATED'
+
+    bsls::AlignmentUtil::MaxAlignedType d_dummy;      // force alignment
+};
+
+BSLMF_ASSERT(sizeof(BlockHeader) == k_MAX_ALIGNMENT);
+
+// HELPER FUNCTIONS
+
+size_type getSystemPageSize()
+    // Return the size (in bytes) of a system memory page.
+{
+    static bsls::AtomicInt pageSize(0);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == pageSize.loadRelaxed())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        pageSize = static_cast<int>(info.dwPageSize);
+
+#else
+
+        pageSize = static_cast<int>(sysconf(_SC_PAGESIZE));
+
+#endif
+    }
+
+    return pageSize.loadRelaxed();
+}
+
+inline
+size_type roundUp(size_type size, size_type alignment)
+    // Return the specified 'size' rounded up to a multiple of the specified
+    // 'alignment'.  The behavior is undefined unless 'alignment' is a power
+    // of two.
+{
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+inline
+int sizeClassOf(size_type size)
+    // Return the smallest 'i' such that '2^i' is at least the specified
+    // 'size', and is at least '2^k_MIN_SIZE_CLASS'.
+{
+    int       sizeClass = k_MIN_SIZE_CLASS;
+    size_type blockSize = static_cast<size_type>(1) << k_MIN_SIZE_CLASS;
+
+    while (blockSize < size) {
+        blockSize <<= 1;
+        ++sizeClass;
+    }
+    return sizeClass;
+}
+
+void *systemMap(size_type                                size,
+                bdlma::MappedRegionAllocator::HugePageMode mode)
+    // Map a range of the specified 'size' bytes of zero-initialized memory,
+    // using huge pages as indicated by the specified 'mode', and return its
+    // address, or 0 if the range cannot be mapped.  The behavior is undefined
+    // unless 'size' is a multiple of the system page size or, if 'mode' is
+    // not 'e_NO_HUGE_PAGES', of 'k_HUGE_PAGE_SIZE'.
+{
+    BSLS_ASSERT(size > 0);
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+    (void) mode;
+
+    return VirtualAlloc(0, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+                                                                      // RETURN
+
+#else
+
+    typedef bdlma::MappedRegionAllocator Obj;
+
+    int flags = MAP_ANON | MAP_PRIVATE;
+
+#ifdef MAP_HUGETLB
+    if (Obj::e_EXPLICIT_HUGE_PAGES == mode) {
+        void *address = mmap(0,
+                             size,
+                             PROT_READ | PROT_WRITE,
+                             flags | MAP_HUGETLB,
+                             -1,
+                             0);
+        if (MAP_FAILED != address) {
+            return address;                                           // RETURN
+        }
+
+        // The reserved pool of huge pages is exhausted (or was never
+        // configured): fall back to transparent huge pages.
+    }
+#endif
+
+#ifdef MAP_NORESERVE
+    // Regions are committed lazily, as they are touched; do not reserve swap
+    // space for the untouched part of a region.
+
+    flags |= MAP_NORESERVE;
+#endif
+
+    if (Obj::e_NO_HUGE_PAGES == mode) {
+        void *address = mmap(0, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+
+        return MAP_FAILED == address ? 0 : address;                   // RETURN
+    }
+
+    // Over-map by one huge page so that a huge page aligned range of 'size'
+    // bytes can be retained, and unmap the excess at both ends.  Note that a
+    // transparent huge page can back only an aligned range.
+
+    const size_type mappedSize = size + k_HUGE_PAGE_SIZE;
+
+    void *address = mmap(0, mappedSize, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (MAP_FAILED == address) {
+        return 0;                                                     // RETURN
+    }
+
+    char *begin   = static_cast<char *>(address);
+    char *aligned = begin + (roundUp(reinterpret_cast<size_type>(begin),
+                                     k_HUGE_PAGE_SIZE)
+                             - reinterpret_cast<size_type>(begin));
+
+    const size_type head = aligned - begin;
+    const size_type tail = mappedSize - head - size;
+
+    if (head) {
+        munmap(begin, head);
+    }
+    if (tail) {
+        munmap(aligned + size, tail);
+    }
+
+#ifdef MADV_HUGEPAGE
+    // Failure to apply the advice (e.g., if transparent huge pages are
+    // disabled) is not an error: the region is then backed by normal pages.
+
+    madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+
+    return aligned;
+
+#endif
+}
+
+void systemUnmap(void *address, size_type size)
+    // Return the range of the specified 'size' bytes at the specified
+    // 'address' to the operating system.  The behavior is undefined unless
+    // 'address' and 'size' describe a range returned by 'systemMap'.
+{
+    BSLS_ASSERT(address);
+
+#ifdef BSLS_PLATFORM_OS_WINDOWS
+
+    VirtualFree(address, 0, MEM_RELEASE);
+    (void) size;
+
+#else
+
+    // On some of our platforms, 'munmap' takes a 'char*' argument, while on
+    // others it takes a 'void*'.  Casting to 'char*', which will work in both
+    // cases.
+
+    munmap(static_cast<char *>(address), size);
+
+#endif
+}
+
+}  // close unnamed namespace
+
+namespace bdlma {
+
+                   // ------------------------------------
+                   // struct MappedRegionAllocator::Mapping
+                   // ------------------------------------
+
+struct MappedRegionAllocator::Mapping {
+    // This 'struct' is located at the beginning of each range mapped by the
+    // allocator, and links it into the list of all mappings.
+
+    Mapping   *d_next_p;  // next mapping
+    Mapping   *d_prev_p;  // previous mapping
+    size_type  d_size;    // size of the mapped range (in bytes)
+};
+
+                  // --------------------------------------
+                  // struct MappedRegionAllocator::FreeBlock
+                  // --------------------------------------
+
+struct MappedRegionAllocator::FreeBlock {
+    // This 'struct' overlays each free block of a region.
+
+    FreeBlock *d_next_p;  // next free block of the same size class
+};
+
+                        // ---------------------------
+                        // class MappedRegionAllocator
+                        // ---------------------------
+
+// PRIVATE MANIPULATORS
+void *MappedRegionAllocator::allocateDedicated(size_type size)
+{
+    const size_type mappingSize = roundUp(sizeof(Mapping), k_MAX_ALIGNMENT);
+    const size_type overhead    = mappingSize + sizeof(BlockHeader)
+                                                           + k_HUGE_PAGE_SIZE;
+
+    if (size > ~static_cast<size_type>(0) - overhead) {
+        BSLS_THROW(bsl::bad_alloc());
+    }
+
+    Mapping *mapping = map(mappingSize + sizeof(BlockHeader) + size);
+
+    BlockHeader *header = reinterpret_cast<BlockHeader *>(
+                              reinterpret_cast<char *>(mapping) + mappingSize);
+    header->d_sizeClass = k_DEDICATED;
+
+    return header + 1;
+}
+
+void MappedRegionAllocator::addFreeRange(char *address, size_type size)
+{
+    for (int sizeClass = k_NUM_SIZE_CLASSES - 1;
+         sizeClass >= k_MIN_SIZE_CLASS;
+         --sizeClass) {
+        const size_type blockSize = static_cast<size_type>(1) << sizeClass;
+
+        if (blockSize <= size) {
+            FreeBlock *block = reinterpret_cast<FreeBlock *>(address);
+
+            block->d_next_p       = d_freeLists[sizeClass];
+            d_freeLists[sizeClass] = block;
+
+            address += blockSize;
+            size    -= blockSize;
+        }
+    }
+}
+
+MappedRegionAllocator::Mapping *MappedRegionAllocator::map(size_type size)
+{
+    size = roundUp(size,
+                   e_NO_HUGE_PAGES == d_hugePageMode
+                   ? getSystemPageSize()
+                   : static_cast<size_type>(k_HUGE_PAGE_SIZE));
+
+    void *address = systemMap(size, d_hugePageMode);
+    if (!address) {
+        BSLS_THROW(bsl::bad_alloc());
+    }
+
+    Mapping *mapping = static_cast<Mapping *>(address);
+
+    mapping->d_next_p = d_mappings_p;
+    mapping->d_prev_p = 0;
+    mapping->d_size   = size;
+    if (d_mappings_p) {
+        d_mappings_p->d_prev_p = mapping;
+    }
+    d_mappings_p = mapping;
+
+    d_numBytesMapped += size;
+
+    return mapping;
+}
+
+void MappedRegionAllocator::unmap(Mapping *mapping)
+{
+    BSLS_ASSERT(mapping);
+
+    if (mapping->d_prev_p) {
+        mapping->d_prev_p->d_next_p = mapping->d_next_p;
+    }
+    else {
+        d_mappings_p = mapping->d_next_p;
+    }
+    if (mapping->d_next_p) {
+        mapping->d_next_p->d_prev_p = mapping->d_prev_p;
+    }
+
+    d_numBytesMapped -= mapping->d_size;
+
+    systemUnmap(mapping, mapping->d_size);
+}
+
+// CREATORS
+MappedRegionAllocator::MappedRegionAllocator()
+: d_regionSize(k_DEFAULT_REGION_SIZE)
+, d_hugePageMode(e_NO_HUGE_PAGES)
+, d_mappings_p(0)
+, d_cursor_p(0)
+, d_end_p(0)
+, d_numBytesMapped(0)
+{
+    for (int i = 0; i < k_NUM_SIZE_CLASSES; ++i) {
+        d_freeLists[i] = 0;
+    }
+}
+
+MappedRegionAllocator::MappedRegionAllocator(size_type    regionSize,
+                                             HugePageMode hugePageMode)
+: d_regionSize(0)
+, d_hugePageMode(hugePageMode)
+, d_mappings_p(0)
+, d_cursor_p(0)
+, d_end_p(0)
+, d_numBytesMapped(0)
+{
+    BSLS_ASSERT(0 < regionSize);
+
+    d_regionSize = roundUp(regionSize,
+                           e_NO_HUGE_PAGES == hugePageMode
+                           ? getSystemPageSize()
+                           : static_cast<size_type>(k_HUGE_PAGE_SIZE));
+
+    for (int i = 0; i < k_NUM_SIZE_CLASSES; ++i) {
+        d_freeLists[i] = 0;
+    }
+}
+
+MappedRegionAllocator::~MappedRegionAllocator()
+{
+    release();
+}
+
+// MANIPULATORS
+void *MappedRegionAllocator::allocate(size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return 0;                                                     // RETURN
+    }
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (size > d_regionSize / 2 - sizeof(BlockHeader)) {
+        return allocateDedicated(size);                               // RETURN
+    }
+
+    const int sizeClass = sizeClassOf(sizeof(BlockHeader) + size);
+
+    BlockHeader *header;
+
+    if (d_freeLists[sizeClass]) {
+        FreeBlock *block       = d_freeLists[sizeClass];
+        d_freeLists[sizeClass] = block->d_next_p;
+
+        header = reinterpret_cast<BlockHeader *>(block);
+    }
+    else {
+        const size_type roundedSize = static_cast<size_type>(1) << sizeClass;
+
+        if (static_cast<size_type>(d_end_p - d_cursor_p) < roundedSize) {
+            // Retire the remainder of the current region to the free lists,
+            // and continue in a new region.
+
+            if (d_cursor_p) {
+                addFreeRange(d_cursor_p, d_end_p - d_cursor_p);
+            }
+
+            Mapping *region = map(d_regionSize);
+
+            d_cursor_p = reinterpret_cast<char *>(region)
+                              + roundUp(sizeof(Mapping), k_MAX_ALIGNMENT);
+            d_end_p    = reinterpret_cast<char *>(region) + region->d_size;
+        }
+
+        header      = reinterpret_cast<BlockHeader *>(d_cursor_p);
+        d_cursor_p += roundedSize;
+    }
+
+    header->d_sizeClass = sizeClass;
+
+    return header + 1;
+}
+
+void MappedRegionAllocator::deallocate(void *address)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == address)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return;                                                       // RETURN
+    }
+
+    BlockHeader *header = static_cast<BlockHeader *>(address) - 1;
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    const int sizeClass = header->d_sizeClass;
+
+    if (k_DEDICATED == sizeClass) {
+        unmap(reinterpret_cast<Mapping *>(
+                                reinterpret_cast<char *>(header)
+                                - roundUp(sizeof(Mapping), k_MAX_ALIGNMENT)));
+        return;                                                       // RETURN
+    }
+
+    BSLS_ASSERT(k_MIN_SIZE_CLASS <= sizeClass);
+    BSLS_ASSERT(sizeClass < k_NUM_SIZE_CLASSES);
+
+    FreeBlock *block       = reinterpret_cast<FreeBlock *>(header);
+    block->d_next_p        = d_freeLists[sizeClass];
+    d_freeLists[sizeClass] = block;
+}
+
+void MappedRegionAllocator::release()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    while (d_mappings_p) {
+        unmap(d_mappings_p);
+    }
+
+    BSLS_ASSERT(0 == d_numBytesMapped);
+
+    d_cursor_p = 0;
+    d_end_p    = 0;
+    for (int i = 0; i < k_NUM_SIZE_CLASSES; ++i) {
+        d_freeLists[i] = 0;
+    }
+}
+
+// ACCESSORS
+size_type MappedRegionAllocator::numBytesMapped() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return d_numBytesMapped;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
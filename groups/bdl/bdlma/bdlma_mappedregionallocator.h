@@ -0,0 +1,338 @@
+// bdlma_mappedregionallocator.h                                      -*-C++-*-
+#ifndef INCLUDED_BDLMA_MAPPEDREGIONALLOCATOR
+#define INCLUDED_BDLMA_MAPPEDREGIONALLOCATOR
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an allocator serving blocks from memory-mapped regions.
+//
+//@CLASSES:
+//  bdlma::MappedRegionAllocator: allocator carving large mapped regions
+//
+//@SEE_ALSO: bdlma_sequentialallocator, bdlma_multipool,
+//           bdlma_guardingallocator
+//
+//@DESCRIPTION: This component provides a thread-safe allocator,
+// 'bdlma::MappedRegionAllocator', that implements the
+// 'bdlma::ManagedAllocator' protocol, and that obtains its memory directly
+// from the operating system as large virtual memory *regions* (using 'mmap' on
+// POSIX platforms, and 'VirtualAlloc' on Windows), optionally backed by huge
+// pages.  It is intended
+// to be supplied as the underlying allocator of the pools and arenas of
+// 'bdlma' -- e.g., 'bdlma::SequentialAllocator', 'bdlma::BufferManager' (via
+// its owner), 'bdlma::Multipool', and 'bdlma::MultipoolAllocator' -- which
+// obtain relatively few, relatively large, chunks of memory from their
+// underlying allocator:
+//..
+//   ,----------------------------.
+//  ( bdlma::MappedRegionAllocator )
+//   `----------------------------'
+//                 |       ctor/dtor
+//                 |       hugePageMode
+//                 |       numBytesMapped
+//                 |       regionSize
+//                 V
+//     ,-----------------------.
+//    ( bdlma::ManagedAllocator )
+//     `-----------------------'
+//                 |       release
+//                 V
+//         ,----------------.
+//        ( bslma::Allocator )
+//         `----------------'
+//                         allocate
+//                         deallocate
+//..
+// Note that, like a 'bdlma::GuardingAllocator', and unlike most other BDE
+// allocators, a 'bdlma::MappedRegionAllocator' does not take an optional
+// 'bslma::Allocator *' at construction, as all of its memory, including its
+// bookkeeping, is obtained from the operating system.
+//
+///Regions and Blocks
+///------------------
+// The allocator maps regions of 'regionSize()' bytes (64 MiB by default) as
+// needed, and carves the blocks it returns from the most recently mapped
+// region.  The physical memory backing a region is committed by the operating
+// system only when it is first touched, so that reserving a large region is
+// inexpensive.  Each block is rounded up, together with a small header, to a
+// power of two.  Deallocated blocks are kept on a free list for their size,
+// and reused by later requests of the same rounded size; they are returned to
+// the operating system only by 'release' or by the destructor, each of which
+// unmaps every region with a single system call per region -- typically far
+// faster than returning each chunk of a multi-gigabyte arena to 'malloc'.
+//
+// Requests whose rounded size exceeds half the region size are each satisfied
+// by a dedicated mapping, which 'deallocate' unmaps immediately.
+//
+///Huge Pages
+///----------
+// On most platforms, the virtual memory of a process is mapped with pages of
+// 4 KiB, so that an arena of several gigabytes spans about a million pages,
+// far exceeding the capacity of the TLB (the processor's cache of address
+// translations).  Mapping the arena with huge pages (2 MiB on x86-64 and on
+// most AArch64 configurations) reduces the number of TLB entries needed by a
+// factor of 512.  A 'bdlma::MappedRegionAllocator' may be constructed with
+// one of the following huge page modes:
+//..
+//  Mode                          Effect (Linux)
+//  ---------------------------   --------------------------------------------
+//  e_NO_HUGE_PAGES (default)     Regions are mapped with normal pages.
+//
+//  e_TRANSPARENT_HUGE_PAGES      Regions are aligned on a huge page boundary,
+//                                and 'madvise(MADV_HUGEPAGE)' requests that
+//                                the kernel back them with transparent huge
+//                                pages.
+//
+//  e_EXPLICIT_HUGE_PAGES         Regions are mapped with 'MAP_HUGETLB' from
+//                                the pool of huge pages reserved by the
+//                                administrator (see 'vm.nr_hugepages'); if
+//                                that fails, the transparent mode is used.
+//..
+// In both huge page modes, the region size is rounded up to a multiple of the
+// huge page size.  On platforms that do not support these facilities
+// (including Windows), the huge page modes have no effect.
+//
+///Thread Safety
+///-------------
+// 'bdlma::MappedRegionAllocator' is *fully* *thread-safe*, meaning that any
+// operation on the same instance can be safely invoked from any thread.  Note
+// that the allocator serializes its operations using a mutex, which is
+// appropriate for its intended use as the source of (infrequent) chunk
+// allocations by pools.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Backing a Large Arena with Huge Pages
+/// - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we load a large data set into a 'bsl::unordered_map' whose
+// nodes are allocated by a 'bdlma::MultipoolAllocator', and that lookups in
+// the map, which touch memory spread over gigabytes, are dominated by TLB
+// misses.
+//
+// First, we create a mapped region allocator that reserves regions of 1 GiB
+// using transparent huge pages:
+//..
+//  typedef bdlma::MappedRegionAllocator Obj;
+//
+//  Obj regionAllocator(1024 * 1024 * 1024, Obj::e_TRANSPARENT_HUGE_PAGES);
+//..
+// Then, we create a multipool allocator obtaining its chunks from
+// 'regionAllocator', and a map using the multipool:
+//..
+//  {
+//      bdlma::MultipoolAllocator multipool(&regionAllocator);
+//
+//      bsl::unordered_map<int, double> prices(&multipool);
+//      for (int i = 0; i < 100000; ++i) {
+//          prices[i] = i * 0.5;
+//      }
+//      assert(100000 == prices.size());
+//..
+// Now, we observe that the nodes of the map were allocated from a region
+// (which is committed only as far as it was touched):
+//..
+//      assert(regionAllocator.numBytesMapped() >= 1024 * 1024 * 1024);
+//  }
+//..
+// Finally, when we are done with the data set, we observe that the chunks of
+// the multipool, which were returned to 'regionAllocator' when the multipool
+// was destroyed, are returned to the operating system, one region at a time,
+// when 'regionAllocator' is destroyed, or when 'release' is called:
+//..
+//  regionAllocator.release();
+//  assert(0 == regionAllocator.numBytesMapped());
+//..
+
+#include <bdlscm_version.h>
+
+#include <bdlma_managedallocator.h>
+
+#include <bslmt_mutex.h>
+
+#include <bsls_keyword.h>
+#include <bsls_types.h>
+
+namespace BloombergLP {
+namespace bdlma {
+
+                        // ===========================
+                        // class MappedRegionAllocator
+                        // ===========================
+
+class MappedRegionAllocator : public ManagedAllocator {
+    // This class implements the 'bdlma::ManagedAllocator' protocol to provide
+    // a thread-safe allocator that carves blocks, rounded to powers of two,
+    // from large virtual memory regions obtained from the operating system,
+    // optionally backed by huge pages.  Deallocated blocks are reused by
+    // later requests of the same rounded size.  Both the 'release' method and
+    // the destructor return all regions to the operating system.
+
+  public:
+    // TYPES
+    enum HugePageMode {
+        // Enumerate the use of huge pages for the regions of an allocator.
+
+        e_NO_HUGE_PAGES,           // use pages of the default size
+
+        e_TRANSPARENT_HUGE_PAGES,  // align regions on huge page boundaries,
+                                   // and advise the system to back them with
+                                   // transparent huge pages
+
+        e_EXPLICIT_HUGE_PAGES      // map regions from the reserved pool of
+                                   // huge pages, falling back to the
+                                   // transparent mode
+    };
+
+  private:
+    // PRIVATE TYPES
+    struct Mapping;
+    struct FreeBlock;
+        // These types are defined in the implementation file.
+
+    enum { k_NUM_SIZE_CLASSES = 64 };
+
+    // DATA
+    bsls::Types::size_type  d_regionSize;     // size of each region
+
+    HugePageMode            d_hugePageMode;   // use of huge pages
+
+    Mapping                *d_mappings_p;     // list of all mappings
+                                              // (regions and dedicated
+                                              // mappings)
+
+    char                   *d_cursor_p;       // next free byte of the
+                                              // current region
+
+    char                   *d_end_p;          // end of the current region
+
+    FreeBlock              *d_freeLists[k_NUM_SIZE_CLASSES];
+                                              // free blocks of each size
+                                              // class ('2^i' bytes)
+
+    bsls::Types::size_type  d_numBytesMapped; // bytes currently mapped
+
+    mutable bslmt::Mutex    d_mutex;          // serializes all operations
+
+  private:
+    // NOT IMPLEMENTED
+    MappedRegionAllocator(const MappedRegionAllocator&);
+    MappedRegionAllocator& operator=(const MappedRegionAllocator&);
+
+    // PRIVATE MANIPULATORS
+    void *allocateDedicated(bsls::Types::size_type size);
+        // Return the address of a block of at least the specified 'size'
+        // bytes from a new mapping dedicated to that block.  Throw
+        // 'bsl::bad_alloc' if the mapping fails.
+
+    void addFreeRange(char *address, bsls::Types::size_type size);
+        // Add the range of the specified 'size' bytes at the specified
+        // 'address' to the free lists, as blocks of decreasing powers of two.
+        // Bytes that cannot form a block of the minimum size are lost.
+
+    Mapping *map(bsls::Types::size_type size);
+        // Map a new range of at least the specified 'size' bytes using the
+        // huge page mode of this allocator, add it to the list of mappings,
+        // and return its descriptor, which is located at the beginning of the
+        // range.  Throw 'bsl::bad_alloc' if the mapping fails.
+
+    void unmap(Mapping *mapping);
+        // Remove the specified 'mapping' from the list of mappings, and return
+        // its memory to the operating system.
+
+  public:
+    // CREATORS
+    MappedRegionAllocator();
+    explicit MappedRegionAllocator(bsls::Types::size_type regionSize,
+                                   HugePageMode           hugePageMode =
+                                                              e_NO_HUGE_PAGES);
+        // Create an allocator that obtains memory from the operating system
+        // in regions of the optionally specified 'regionSize' bytes (rounded
+        // up to a multiple of the system page size, or, if huge pages are
+        // used, of the huge page size), using huge pages as indicated by the
+        // optionally specified 'hugePageMode'.  If 'regionSize' is not
+        // specified, 64 MiB is used.  If 'hugePageMode' is not specified,
+        // 'e_NO_HUGE_PAGES' is used.  No memory is mapped until the first
+        // allocation.  The behavior is undefined unless '0 < regionSize'.
+
+    ~MappedRegionAllocator() BSLS_KEYWORD_OVERRIDE;
+        // Destroy this allocator, returning all of its memory to the operating
+        // system.
+
+    // MANIPULATORS
+    void *allocate(bsls::Types::size_type size) BSLS_KEYWORD_OVERRIDE;
+        // Return the address of a maximally-aligned block of memory of at
+        // least the specified 'size' (in bytes).  If 'size' is 0, return 0
+        // with no effect.  Throw 'bsl::bad_alloc' if the memory cannot be
+        // obtained from the operating system.
+
+    void deallocate(void *address) BSLS_KEYWORD_OVERRIDE;
+        // Return the memory block at the specified 'address' to this
+        // allocator.  If 'address' is 0, this function has no effect.  If the
+        // block was allocated from a dedicated mapping, return its memory to
+        // the operating system; otherwise, make the block available to later
+        // requests of the same rounded size.  The behavior is undefined
+        // unless 'address' was allocated using this allocator object and has
+        // not already been deallocated.
+
+    void release() BSLS_KEYWORD_OVERRIDE;
+        // Return all memory currently allocated through this allocator to the
+        // operating system.  The allocator may be used again after this call.
+
+    // ACCESSORS
+    HugePageMode hugePageMode() const;
+        // Return the huge page mode requested at construction.
+
+    bsls::Types::size_type numBytesMapped() const;
+        // Return the number of bytes of virtual memory currently mapped by
+        // this allocator.  Note that physical memory is committed only for
+        // the pages that have been touched.
+
+    bsls::Types::size_type regionSize() const;
+        // Return the size (in bytes) of each region mapped by this allocator.
+};
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                        // ---------------------------
+                        // class MappedRegionAllocator
+                        // ---------------------------
+
+// ACCESSORS
+inline
+MappedRegionAllocator::HugePageMode
+MappedRegionAllocator::hugePageMode() const
+{
+    return d_hugePageMode;
+}
+
+inline
+bsls::Types::size_type MappedRegionAllocator::regionSize() const
+{
+    return d_regionSize;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,846 @@
+// bdlma_mappedregionallocator.t.cpp                                  -*-C++-*-
+#include <bdlma_mappedregionallocator.h>
+
+#include <bdlma_multipoolallocator.h>
+#include <bdlma_sequentialallocator.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bslmt_threadutil.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_unordered_map.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                              TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is a thread-safe allocator that obtains its memory
+// from the operating system in large regions.  Since it takes no underlying
+// allocator, its behavior is observed through 'numBytesMapped', which reveals
+// when regions and dedicated mappings are mapped and unmapped, and through
+// the addresses of the blocks it returns, which reveal the reuse of
+// deallocated blocks.  Each test case installs a 'bslma::TestAllocator' as
+// the default allocator, to verify that no memory is obtained from it.  Huge
+// pages may be unavailable on the test machine; the huge page modes are
+// therefore verified to work whether or not the system honors them.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] MappedRegionAllocator();
+// [ 2] MappedRegionAllocator(size_type regionSize, HugePageMode mode);
+// [ 2] ~MappedRegionAllocator();
+//
+// MANIPULATORS
+// [ 3] void *allocate(bsls::Types::size_type size);
+// [ 3] void deallocate(void *address);
+// [ 5] void release();
+//
+// ACCESSORS
+// [ 2] HugePageMode hugePageMode() const;
+// [ 2] bsls::Types::size_type numBytesMapped() const;
+// [ 2] bsls::Types::size_type regionSize() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] DEDICATED MAPPINGS
+// [ 6] HUGE PAGE MODES
+// [ 7] CONCURRENCY TEST
+// [ 8] USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlma::MappedRegionAllocator Obj;
+typedef bsls::Types::size_type       size_type;
+
+enum {
+    k_MAX_ALIGNMENT  = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT,
+    k_HUGE_PAGE_SIZE = 2 * 1024 * 1024,
+    k_MEGABYTE       = 1024 * 1024
+};
+
+// ============================================================================
+//                          HELPER FUNCTIONS
+// ----------------------------------------------------------------------------
+
+static
+bool isMaximallyAligned(const void *address)
+    // Return 'true' if the specified 'address' is maximally aligned, and
+    // 'false' otherwise.
+{
+    return 0 == reinterpret_cast<bsls::Types::UintPtr>(address)
+                                                         % k_MAX_ALIGNMENT;
+}
+
+static
+bool isFilled(const void *address, size_type size, char value)
+    // Return 'true' if each of the specified 'size' bytes at the specified
+    // 'address' has the specified 'value', and 'false' otherwise.
+{
+    const char *p = static_cast<const char *>(address);
+    for (size_type i = 0; i < size; ++i) {
+        if (value != p[i]) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+                           // ===================
+                           // struct ChurnArgs
+                           // ===================
+
+struct ChurnArgs {
+    // This 'struct' holds the arguments of 'churn'.
+
+    Obj *d_allocator_p;  // allocator under test
+    int  d_id;           // identifies the thread (used as fill value)
+    int  d_numRounds;    // number of rounds of allocation
+};
+
+extern "C"
+void *churn(void *arg)
+    // Repeatedly allocate, fill, verify, and deallocate blocks of various
+    // sizes from the allocator specified by 'arg', which must be the address
+    // of a 'ChurnArgs' object.
+{
+    ChurnArgs *args = static_cast<ChurnArgs *>(arg);
+
+    enum { k_NUM_BLOCKS = 64 };
+
+    const char value = static_cast<char>('a' + args->d_id);
+
+    void      *blocks[k_NUM_BLOCKS];
+    size_type  sizes[k_NUM_BLOCKS];
+
+    for (int round = 0; round < args->d_numRounds; ++round) {
+        for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+            sizes[i]  = 1 + (i * 97 + round * 31) % 5000;
+            blocks[i] = args->d_allocator_p->allocate(sizes[i]);
+            bsl::memset(blocks[i], value, sizes[i]);
+        }
+        for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+            ASSERTV(args->d_id, round, i,
+                    isFilled(blocks[i], sizes[i], value));
+            args->d_allocator_p->deallocate(blocks[i]);
+        }
+    }
+    return 0;
+}
+
+//=============================================================================
+//                              USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Backing a Large Arena with Huge Pages
+/// - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we load a large data set into a 'bsl::unordered_map' whose
+// nodes are allocated by a 'bdlma::MultipoolAllocator', and that lookups in
+// the map, which touch memory spread over gigabytes, are dominated by TLB
+// misses.
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int  test                = argc > 1 ? atoi(argv[1]) : 0;
+    bool verbose             = argc > 2;
+    bool veryVerbose         = argc > 3;
+    bool veryVeryVerbose     = argc > 4;
+
+    (void)veryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: No memory is obtained from the default allocator.
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+// First, we create a mapped region allocator that reserves regions of 1 GiB
+// using transparent huge pages:
+//..
+    typedef bdlma::MappedRegionAllocator Obj;
+
+    Obj regionAllocator(1024 * 1024 * 1024, Obj::e_TRANSPARENT_HUGE_PAGES);
+//..
+// Then, we create a multipool allocator obtaining its chunks from
+// 'regionAllocator', and a map using the multipool:
+//..
+    {
+        bdlma::MultipoolAllocator multipool(&regionAllocator);
+
+        bsl::unordered_map<int, double> prices(&multipool);
+        for (int i = 0; i < 100000; ++i) {
+            prices[i] = i * 0.5;
+        }
+        ASSERT(100000 == prices.size());
+//..
+// Now, we observe that the nodes of the map were allocated from a region
+// (which is committed only as far as it was touched):
+//..
+        ASSERT(regionAllocator.numBytesMapped() >= 1024 * 1024 * 1024);
+    }
+//..
+// Finally, when we are done with the data set, we observe that the chunks of
+// the multipool, which were returned to 'regionAllocator' when the multipool
+// was destroyed, are returned to the operating system, one region at a time,
+// when 'regionAllocator' is destroyed, or when 'release' is called:
+//..
+    regionAllocator.release();
+    ASSERT(0 == regionAllocator.numBytesMapped());
+//..
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY TEST
+        //
+        // Concerns:
+        //: 1 The allocator can be used concurrently by several threads, each
+        //:   obtaining blocks distinct from those of the other threads.
+        //
+        // Plan:
+        //: 1 Have several threads repeatedly allocate, fill with a value
+        //:   specific to the thread, verify, and deallocate blocks of various
+        //:   sizes from an allocator having small regions (so that regions
+        //:   are mapped concurrently with other operations).  (C-1)
+        //
+        // Testing:
+        //   CONCURRENCY TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENCY TEST" << endl
+                          << "================" << endl;
+
+        enum { k_NUM_THREADS = 8 };
+
+        Obj mX(256 * 1024);
+
+        ChurnArgs                 args[k_NUM_THREADS];
+        bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            args[i].d_allocator_p = &mX;
+            args[i].d_id          = i;
+            args[i].d_numRounds   = 200;
+            ASSERTV(i, 0 == bslmt::ThreadUtil::create(&handles[i],
+                                                      churn,
+                                                      &args[i]));
+        }
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            bslmt::ThreadUtil::join(handles[i]);
+        }
+
+        ASSERT(0 < mX.numBytesMapped());
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // HUGE PAGE MODES
+        //
+        // Concerns:
+        //: 1 In the huge page modes, the region size is rounded up to a
+        //:   multiple of the huge page size.
+        //:
+        //: 2 In each mode, the allocator provides usable memory, whether or
+        //:   not the system supports (or has been configured to provide) huge
+        //:   pages; in particular, 'e_EXPLICIT_HUGE_PAGES' falls back when
+        //:   no huge pages are reserved.
+        //:
+        //: 3 Dedicated mappings are also mapped in multiples of the huge page
+        //:   size in the huge page modes.
+        //
+        // Plan:
+        //: 1 For each mode, create an allocator with a region size that is
+        //:   not a multiple of the huge page size, and verify 'regionSize'.
+        //:   (C-1)
+        //:
+        //: 2 Allocate, fill, and verify blocks spanning several regions, and
+        //:   a block having a dedicated mapping; verify 'numBytesMapped'.
+        //:   (C-2..3)
+        //
+        // Testing:
+        //   HUGE PAGE MODES
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "HUGE PAGE MODES" << endl
+                          << "===============" << endl;
+
+        const Obj::HugePageMode MODES[] = {
+            Obj::e_NO_HUGE_PAGES,
+            Obj::e_TRANSPARENT_HUGE_PAGES,
+            Obj::e_EXPLICIT_HUGE_PAGES
+        };
+        const int NUM_MODES = static_cast<int>(sizeof MODES / sizeof *MODES);
+
+        bslma::TestAllocator scratch("scratch", veryVeryVerbose);
+
+        for (int ti = 0; ti < NUM_MODES; ++ti) {
+            const Obj::HugePageMode MODE = MODES[ti];
+
+            Obj mX(3 * k_MEGABYTE, MODE);  const Obj& X = mX;
+
+            ASSERTV(ti, MODE == X.hugePageMode());
+            if (Obj::e_NO_HUGE_PAGES == MODE) {
+                ASSERTV(ti, 3 * k_MEGABYTE == X.regionSize());
+            }
+            else {
+                ASSERTV(ti, 2 * k_HUGE_PAGE_SIZE == X.regionSize());
+            }
+
+            const size_type SIZE = 500 * 1000;
+
+            bsl::vector<char *> blocks(&scratch);
+            for (int i = 0; i < 20; ++i) {
+                char *p = static_cast<char *>(mX.allocate(SIZE));
+                ASSERTV(ti, i, isMaximallyAligned(p));
+                bsl::memset(p, static_cast<char>(i), SIZE);
+                blocks.push_back(p);
+            }
+            for (int i = 0; i < 20; ++i) {
+                ASSERTV(ti, i,
+                        isFilled(blocks[i], SIZE, static_cast<char>(i)));
+            }
+
+            const size_type NUM_MAPPED = X.numBytesMapped();
+            ASSERTV(ti, NUM_MAPPED, 0 == NUM_MAPPED % X.regionSize());
+
+            char *large = static_cast<char *>(mX.allocate(5 * k_MEGABYTE));
+            bsl::memset(large, 'x', 5 * k_MEGABYTE);
+            ASSERTV(ti, isFilled(large, 5 * k_MEGABYTE, 'x'));
+
+            const size_type DEDICATED = X.numBytesMapped() - NUM_MAPPED;
+            ASSERTV(ti, DEDICATED, 5 * k_MEGABYTE < DEDICATED);
+            if (Obj::e_NO_HUGE_PAGES != MODE) {
+                ASSERTV(ti, DEDICATED, 0 == DEDICATED % k_HUGE_PAGE_SIZE);
+            }
+
+            mX.deallocate(large);
+            ASSERTV(ti, NUM_MAPPED == X.numBytesMapped());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // 'release'
+        //
+        // Concerns:
+        //: 1 'release' unmaps all regions and dedicated mappings, whether or
+        //:   not their blocks were deallocated.
+        //:
+        //: 2 The allocator can be used after 'release'.
+        //:
+        //: 3 'release' on an allocator having no mappings has no effect.
+        //
+        // Plan:
+        //: 1 Allocate blocks spanning several regions and a dedicated mapping,
+        //:   deallocate some, invoke 'release', and verify that
+        //:   'numBytesMapped' is 0.  (C-1)
+        //:
+        //: 2 Allocate and use a block after 'release'.  (C-2)
+        //:
+        //: 3 Invoke 'release' twice in a row.  (C-3)
+        //
+        // Testing:
+        //   void release();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'release'" << endl
+                          << "=========" << endl;
+
+        Obj mX(64 * 1024);  const Obj& X = mX;
+
+        mX.release();
+        ASSERT(0 == X.numBytesMapped());
+
+        for (int round = 0; round < 3; ++round) {
+            void *p = 0;
+            for (int i = 0; i < 100; ++i) {
+                p = mX.allocate(1000 + i);
+                bsl::memset(p, 'a', 1000 + i);
+                if (i % 3) {
+                    mX.deallocate(p);
+                }
+            }
+            mX.allocate(1024 * 1024);
+
+            ASSERTV(round, 3 * 64 * 1024 < X.numBytesMapped());
+
+            mX.release();
+            ASSERTV(round, 0 == X.numBytesMapped());
+
+            mX.release();
+            ASSERTV(round, 0 == X.numBytesMapped());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // DEDICATED MAPPINGS
+        //
+        // Concerns:
+        //: 1 A request of more than half the region size is satisfied by a
+        //:   dedicated mapping, which does not affect the current region.
+        //:
+        //: 2 Deallocating a block having a dedicated mapping unmaps it.
+        //:
+        //: 3 A request of up to half the region size is satisfied from a
+        //:   region.
+        //
+        // Plan:
+        //: 1 Allocate blocks of various sizes around half the region size,
+        //:   and verify the change in 'numBytesMapped'.  (C-1, 3)
+        //:
+        //: 2 Deallocate the blocks having dedicated mappings and verify that
+        //:   'numBytesMapped' decreases accordingly.  (C-2)
+        //
+        // Testing:
+        //   DEDICATED MAPPINGS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "DEDICATED MAPPINGS" << endl
+                          << "==================" << endl;
+
+        const size_type REGION = 1024 * 1024;
+
+        Obj mX(REGION);  const Obj& X = mX;
+
+        char *small = static_cast<char *>(mX.allocate(100));
+        ASSERT(REGION == X.numBytesMapped());
+
+        // The largest size served from a region.
+
+        char *half = static_cast<char *>(mX.allocate(REGION / 4));
+        ASSERT(REGION == X.numBytesMapped());
+
+        char *big = static_cast<char *>(mX.allocate(REGION));
+        ASSERT(REGION + REGION < X.numBytesMapped());
+        ASSERT(isMaximallyAligned(big));
+        bsl::memset(big, 'b', REGION);
+
+        const size_type WITH_BIG = X.numBytesMapped();
+
+        char *huge = static_cast<char *>(mX.allocate(10 * REGION + 3));
+        ASSERT(WITH_BIG + 10 * REGION < X.numBytesMapped());
+        bsl::memset(huge, 'h', 10 * REGION + 3);
+
+        ASSERT(isFilled(big, REGION, 'b'));
+
+        mX.deallocate(big);
+        ASSERT(WITH_BIG < X.numBytesMapped());
+
+        mX.deallocate(huge);
+        ASSERT(REGION == X.numBytesMapped());
+
+        mX.deallocate(half);
+        mX.deallocate(small);
+        ASSERT(REGION == X.numBytesMapped());
+
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'allocate' AND 'deallocate'
+        //
+        // Concerns:
+        //: 1 'allocate' returns maximally-aligned, distinct, and writable
+        //:   blocks of at least the requested size.
+        //:
+        //: 2 'allocate(0)' returns 0, and 'deallocate(0)' has no effect.
+        //:
+        //: 3 A deallocated block is reused by the next request of the same
+        //:   rounded size, and is not used for requests of other sizes.
+        //:
+        //: 4 When a region is exhausted, a new region is mapped, and the
+        //:   remainder of the exhausted region is used for later requests of
+        //:   smaller sizes.
+        //
+        // Plan:
+        //: 1 Allocate blocks of every size from 1 to 600, fill each with a
+        //:   distinct value, and verify that all values are intact.  (C-1)
+        //:
+        //: 2 Invoke 'allocate(0)' and 'deallocate(0)'.  (C-2)
+        //:
+        //: 3 Deallocate a block, and verify that requests of the same
+        //:   rounded size obtain it, in LIFO order.  (C-3)
+        //:
+        //: 4 Using an allocator having a region of one page, allocate blocks
+        //:   until a second region is mapped, and verify that a smaller
+        //:   request is then satisfied from the first region.  (C-4)
+        //
+        // Testing:
+        //   void *allocate(bsls::Types::size_type size);
+        //   void deallocate(void *address);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'allocate' AND 'deallocate'" << endl
+                          << "===========================" << endl;
+
+        bslma::TestAllocator scratch("scratch", veryVeryVerbose);
+
+        if (verbose) cout << "\nBlocks are aligned and distinct." << endl;
+        {
+            Obj mX;
+
+            enum { k_MAX_SIZE = 600 };
+
+            bsl::vector<char *> blocks(&scratch);
+            for (int size = 1; size <= k_MAX_SIZE; ++size) {
+                char *p = static_cast<char *>(mX.allocate(size));
+                ASSERTV(size, p);
+                ASSERTV(size, isMaximallyAligned(p));
+                bsl::memset(p, static_cast<char>(size), size);
+                blocks.push_back(p);
+            }
+            for (int size = 1; size <= k_MAX_SIZE; ++size) {
+                ASSERTV(size, isFilled(blocks[size - 1],
+                                       size,
+                                       static_cast<char>(size)));
+            }
+            for (int size = 1; size <= k_MAX_SIZE; ++size) {
+                mX.deallocate(blocks[size - 1]);
+            }
+        }
+
+        if (verbose) cout << "\nZero-sized and null blocks." << endl;
+        {
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT(0 == mX.allocate(0));
+            mX.deallocate(0);
+            ASSERT(0 == X.numBytesMapped());
+        }
+
+        if (verbose) cout << "\nDeallocated blocks are reused." << endl;
+        {
+            Obj mX;
+
+            void *a = mX.allocate(100);
+            void *b = mX.allocate(100);
+            void *c = mX.allocate(1000);
+
+            mX.deallocate(a);
+            mX.deallocate(b);
+
+            void *d = mX.allocate(1000);  // different size class
+            ASSERT(d != a);  ASSERT(d != b);  ASSERT(d != c);
+
+            ASSERT(b == mX.allocate(100));
+            ASSERT(a == mX.allocate(90));  // same rounded size
+
+            void *e = mX.allocate(100);
+            ASSERT(e != a);  ASSERT(e != b);
+        }
+
+        if (verbose) cout << "\nRegions are exhausted and retired." << endl;
+        {
+            Obj mX(1);  const Obj& X = mX;
+
+            const size_type PAGE = X.regionSize();
+            ASSERT(0 < PAGE);
+
+            // Allocate blocks of an eighth of a page until a second region
+            // is mapped; the header of the region prevents the last eighth of
+            // the first region from being used.
+
+            bsl::vector<char *> blocks(&scratch);
+            while (X.numBytesMapped() <= PAGE) {
+                blocks.push_back(static_cast<char *>(mX.allocate(PAGE / 8)));
+            }
+            ASSERT(2 * PAGE == X.numBytesMapped());
+
+            char *first = blocks.front();
+            char *small = static_cast<char *>(mX.allocate(16));
+
+            ASSERTV(first <= small && small < first + PAGE);
+            ASSERT(2 * PAGE == X.numBytesMapped());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 The default constructor creates an allocator having a region
+        //:   size of 64 MiB and no huge pages.
+        //:
+        //: 2 The region size is rounded up to a multiple of the page size.
+        //:
+        //: 3 No memory is mapped until the first allocation.
+        //:
+        //: 4 The destructor unmaps all memory, including blocks that were
+        //:   not deallocated.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create allocators using each constructor, and verify the values
+        //:   of the accessors.  (C-1..3)
+        //:
+        //: 2 Allocate blocks without deallocating them, and let the allocator
+        //:   go out of scope (verified by ASan/valgrind builds).  (C-4)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for a region size of 0 (using the 'BSLS_ASSERTTEST_*'
+        //:   macros).  (C-5)
+        //
+        // Testing:
+        //   MappedRegionAllocator();
+        //   MappedRegionAllocator(size_type regionSize, HugePageMode mode);
+        //   ~MappedRegionAllocator();
+        //   HugePageMode hugePageMode() const;
+        //   bsls::Types::size_type numBytesMapped() const;
+        //   bsls::Types::size_type regionSize() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS AND ACCESSORS" << endl
+                          << "======================" << endl;
+
+        {
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT(64 * k_MEGABYTE       == X.regionSize());
+            ASSERT(Obj::e_NO_HUGE_PAGES  == X.hugePageMode());
+            ASSERT(0                     == X.numBytesMapped());
+
+            mX.allocate(10);
+            ASSERT(64 * k_MEGABYTE       == X.numBytesMapped());
+        }
+        {
+            Obj mX(1);  const Obj& X = mX;
+
+            const size_type PAGE = X.regionSize();
+
+            ASSERT(0 < PAGE);
+            ASSERT(0 == (PAGE & (PAGE - 1)));
+            ASSERT(Obj::e_NO_HUGE_PAGES == X.hugePageMode());
+            ASSERT(0                    == X.numBytesMapped());
+
+            Obj mY(PAGE + 1);  const Obj& Y = mY;
+            ASSERT(2 * PAGE == Y.regionSize());
+
+            Obj mZ(3 * PAGE, Obj::e_NO_HUGE_PAGES);  const Obj& Z = mZ;
+            ASSERT(3 * PAGE == Z.regionSize());
+        }
+        {
+            Obj mX(100, Obj::e_TRANSPARENT_HUGE_PAGES);  const Obj& X = mX;
+
+            ASSERT(k_HUGE_PAGE_SIZE              == X.regionSize());
+            ASSERT(Obj::e_TRANSPARENT_HUGE_PAGES == X.hugePageMode());
+            ASSERT(0                             == X.numBytesMapped());
+        }
+        {
+            Obj mX(k_HUGE_PAGE_SIZE + 1, Obj::e_EXPLICIT_HUGE_PAGES);
+            const Obj& X = mX;
+
+            ASSERT(2 * k_HUGE_PAGE_SIZE       == X.regionSize());
+            ASSERT(Obj::e_EXPLICIT_HUGE_PAGES == X.hugePageMode());
+            ASSERT(0                          == X.numBytesMapped());
+        }
+        {
+            Obj mX(64 * 1024);
+
+            for (int i = 0; i < 1000; ++i) {
+                mX.allocate(i + 1);
+            }
+            mX.allocate(1024 * 1024);
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_FAIL(Obj(0));
+            ASSERT_PASS(Obj(1));
+        }
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic
+        //   functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate blocks of several sizes, verify their
+        //:   contents, and use the allocator as the underlying allocator of
+        //:   a sequential allocator.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        {
+            Obj mX;  const Obj& X = mX;
+
+            char *p = static_cast<char *>(mX.allocate(5));
+            char *q = static_cast<char *>(mX.allocate(100));
+            char *r = static_cast<char *>(mX.allocate(100000));
+
+            ASSERT(p);  ASSERT(q);  ASSERT(r);
+            ASSERT(p != q);
+
+            bsl::strcpy(p, "abcd");
+            bsl::memset(q, 'q', 100);
+            bsl::memset(r, 'r', 100000);
+
+            ASSERT(0 == bsl::strcmp(p, "abcd"));
+            ASSERT(isFilled(q, 100, 'q'));
+            ASSERT(isFilled(r, 100000, 'r'));
+
+            mX.deallocate(q);
+            ASSERT(q == mX.allocate(100));
+
+            ASSERT(X.regionSize() == X.numBytesMapped());
+
+            bdlma::SequentialAllocator sa(&mX);
+            for (int i = 0; i < 10000; ++i) {
+                bsl::memset(sa.allocate(1000), 's', 1000);
+            }
+            sa.release();
+        }
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,588 @@
+// bdlma_threadcachingmultipoolallocator.cpp                          -*-C++-*-
+#include <bdlma_threadcachingmultipoolallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_threadcachingmultipoolallocator_cpp,"$Id$ $CSID$")
+
+#include <bdlma_concurrentpool.h>
+
+#include <bdlb_bitutil.h>
+
+#include <bslma_autodestructor.h>
+#include <bslma_deallocatorproctor.h>
+
+#include <bslmt_lockguard.h>
+
+#include <bsls_assert.h>
+#include <bsls_blockgrowth.h>
+#include <bsls_bslexceptionutil.h>
+#include <bsls_exceptionutil.h>
+#include <bsls_performancehint.h>
+#include <bsls_spinlock.h>
+
+#include <bsl_cstdint.h>
+#include <bsl_cstring.h>  // 'memset'
+#include <bsl_limits.h>
+
+#include <new>            // placement 'new'
+
+namespace BloombergLP {
+namespace {
+
+enum {
+    k_DEFAULT_NUM_POOLS    = 10,
+    k_DEFAULT_BATCH_SIZE   = 32,
+    k_MIN_BLOCK_SIZE       = 8,
+    k_MAX_DEPOT_BATCHES    = 64,  // full batches held by the depot of each
+                                  // pool
+    k_CHUNKS_PER_BATCH     = 4    // batches obtained from each chunk of a
+                                  // pool at its maximum chunk size
+};
+
+}  // close unnamed namespace
+
+namespace bdlma {
+
+           // --------------------------------------------------------
+           // struct ThreadCachingMultipoolAllocator::{Link, Magazine}
+           // --------------------------------------------------------
+
+struct ThreadCachingMultipoolAllocator::Link {
+    // This 'struct' overlays the header of a free memory block held by a
+    // thread cache or a depot, linking it to the next free block of the same
+    // magazine or batch.
+
+    Link *d_next_p;  // next free block, or 0
+};
+
+struct ThreadCachingMultipoolAllocator::Magazine {
+    // This 'struct' holds a singly-linked list of at most 'd_batchSize' free
+    // memory blocks of a single pool.
+
+    Link *d_head_p;     // first block, or 0 if empty
+    int   d_numBlocks;  // number of blocks in the list
+};
+
+                 // ------------------------------------------
+                 // struct ThreadCachingMultipoolAllocator::Depot
+                 // ------------------------------------------
+
+struct ThreadCachingMultipoolAllocator::Depot {
+    // This 'struct' holds the full batches of free blocks of a single pool
+    // that are shared by all threads.  Each batch is a list of exactly
+    // 'd_batchSize' blocks.
+
+    bsls::SpinLock d_lock;                            // protects the batches
+    int            d_numBatches;                      // number of batches
+    Link          *d_batches[k_MAX_DEPOT_BATCHES];    // batches
+
+    // CREATORS
+    Depot()
+    : d_lock(bsls::SpinLock::s_unlocked)
+    , d_numBatches(0)
+    {
+    }
+};
+
+              // ------------------------------------------------
+              // struct ThreadCachingMultipoolAllocator::ThreadCache
+              // ------------------------------------------------
+
+struct ThreadCachingMultipoolAllocator::ThreadCache {
+    // This 'struct' holds, for a single thread, two magazines of free blocks
+    // for each pool of an allocator: the "loaded" magazine, from which blocks
+    // are allocated and to which they are deallocated, and the "previous"
+    // magazine, which is always either empty or full.  The magazines are
+    // stored immediately following this object.
+
+    ThreadCachingMultipoolAllocator *d_allocator_p;  // owning allocator
+                                                     // (held)
+
+    ThreadCache                     *d_prev_p;       // previous cache of the
+                                                     // allocator, or 0
+
+    ThreadCache                     *d_next_p;       // next cache of the
+                                                     // allocator, or 0
+
+    Magazine                        *d_loaded_p;     // array of loaded
+                                                     // magazines
+
+    Magazine                        *d_previous_p;   // array of previous
+                                                     // magazines
+};
+
+                   // -------------------------------------
+                   // class ThreadCachingMultipoolAllocator
+                   // -------------------------------------
+
+// PRIVATE MANIPULATORS
+ThreadCachingMultipoolAllocator::ThreadCache *
+ThreadCachingMultipoolAllocator::createThreadCache()
+{
+    const bsls::Types::size_type size = sizeof(ThreadCache)
+                                      + 2 * d_numPools * sizeof(Magazine);
+
+    ThreadCache *cache =
+                     static_cast<ThreadCache *>(d_allocAdapter.allocate(size));
+
+    cache->d_allocator_p = this;
+    cache->d_prev_p      = 0;
+    cache->d_loaded_p    = reinterpret_cast<Magazine *>(cache + 1);
+    cache->d_previous_p  = cache->d_loaded_p + d_numPools;
+
+    bsl::memset(cache->d_loaded_p, 0, 2 * d_numPools * sizeof(Magazine));
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_cachesMutex);
+
+        cache->d_next_p = d_caches_p;
+        if (d_caches_p) {
+            d_caches_p->d_prev_p = cache;
+        }
+        d_caches_p = cache;
+    }
+
+    if (0 != bslmt::ThreadUtil::setSpecific(d_key, cache)) {
+        destroyThreadCache(cache);
+        bsls::BslExceptionUtil::throwBadAlloc();
+    }
+
+    return cache;
+}
+
+void ThreadCachingMultipoolAllocator::destroyThreadCache(ThreadCache *cache)
+{
+    BSLS_ASSERT(cache);
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_cachesMutex);
+
+        if (cache->d_prev_p) {
+            cache->d_prev_p->d_next_p = cache->d_next_p;
+        }
+        else {
+            d_caches_p = cache->d_next_p;
+        }
+        if (cache->d_next_p) {
+            cache->d_next_p->d_prev_p = cache->d_prev_p;
+        }
+    }
+
+    d_allocAdapter.deallocate(cache);
+}
+
+void ThreadCachingMultipoolAllocator::flushCache(ThreadCache *cache)
+{
+    BSLS_ASSERT(cache);
+
+    for (int i = 0; i < d_numPools; ++i) {
+        Magazine& loaded   = cache->d_loaded_p[i];
+        Magazine& previous = cache->d_previous_p[i];
+
+        if (d_batchSize == loaded.d_numBlocks) {
+            pushBatch(i, loaded.d_head_p);
+        }
+        else {
+            Link *link = loaded.d_head_p;
+            while (link) {
+                Link *next = link->d_next_p;
+                d_pools_p[i].deallocate(link);
+                link = next;
+            }
+        }
+        loaded.d_head_p    = 0;
+        loaded.d_numBlocks = 0;
+
+        if (previous.d_numBlocks) {
+            pushBatch(i, previous.d_head_p);
+        }
+        previous.d_head_p    = 0;
+        previous.d_numBlocks = 0;
+    }
+}
+
+void ThreadCachingMultipoolAllocator::initialize(int maxBlocksPerChunk)
+{
+    BSLS_ASSERT(1 <= d_numPools);
+    BSLS_ASSERT(1 <= d_batchSize);
+
+    d_maxBlockSize = k_MIN_BLOCK_SIZE;
+
+    d_depots_p = static_cast<Depot *>(
+                     d_allocAdapter.allocate(d_numPools * sizeof *d_depots_p));
+
+    bslma::DeallocatorProctor<bslma::Allocator> autoDepotsDeallocator(
+                                                             d_depots_p,
+                                                             &d_allocAdapter);
+
+    for (int i = 0; i < d_numPools; ++i) {
+        new (d_depots_p + i) Depot();
+    }
+
+    d_pools_p = static_cast<ConcurrentPool *>(
+                      d_allocAdapter.allocate(d_numPools * sizeof *d_pools_p));
+
+    bslma::DeallocatorProctor<bslma::Allocator> autoPoolsDeallocator(
+                                                              d_pools_p,
+                                                              &d_allocAdapter);
+    bslma::AutoDestructor<ConcurrentPool> autoDtor(d_pools_p, 0);
+
+    for (int i = 0; i < d_numPools; ++i, ++autoDtor) {
+        new (d_pools_p + i) ConcurrentPool(
+                             d_maxBlockSize + static_cast<int>(sizeof(Header)),
+                             bsls::BlockGrowth::BSLS_GEOMETRIC,
+                             maxBlocksPerChunk,
+                             &d_allocAdapter);
+
+        BSLS_ASSERT(d_maxBlockSize <=
+                       bsl::numeric_limits<bsls::Types::size_type>::max() / 2);
+
+        d_maxBlockSize *= 2;
+    }
+
+    d_maxBlockSize /= 2;
+
+    if (0 != bslmt::ThreadUtil::createKey(
+                      &d_key,
+                      &::bdlma_ThreadCachingMultipoolAllocator_threadExit)) {
+        bsls::BslExceptionUtil::throwBadAlloc();
+    }
+
+    autoDtor.release();
+    autoPoolsDeallocator.release();
+    autoDepotsDeallocator.release();
+}
+
+void ThreadCachingMultipoolAllocator::pushBatch(int pool, Link *batch)
+{
+    BSLS_ASSERT(0 <= pool);
+    BSLS_ASSERT(pool < d_numPools);
+    BSLS_ASSERT(batch);
+
+    Depot& depot = d_depots_p[pool];
+    {
+        bsls::SpinLockGuard guard(&depot.d_lock);
+
+        if (depot.d_numBatches < k_MAX_DEPOT_BATCHES) {
+            depot.d_batches[depot.d_numBatches++] = batch;
+            return;                                                   // RETURN
+        }
+    }
+
+    // The depot is full; return the blocks of 'batch' to the pool.
+
+    while (batch) {
+        Link *next = batch->d_next_p;
+        d_pools_p[pool].deallocate(batch);
+        batch = next;
+    }
+}
+
+void *ThreadCachingMultipoolAllocator::refill(ThreadCache *cache, int pool)
+{
+    Magazine& loaded   = cache->d_loaded_p[pool];
+    Magazine& previous = cache->d_previous_p[pool];
+
+    BSLS_ASSERT(0 == loaded.d_numBlocks);
+
+    if (previous.d_numBlocks) {
+        // 'previous' is full; exchange it with the empty 'loaded'.
+
+        loaded               = previous;
+        previous.d_head_p    = 0;
+        previous.d_numBlocks = 0;
+    }
+    else {
+        Depot& depot = d_depots_p[pool];
+        Link  *batch = 0;
+        {
+            bsls::SpinLockGuard guard(&depot.d_lock);
+
+            if (depot.d_numBatches) {
+                batch = depot.d_batches[--depot.d_numBatches];
+            }
+        }
+
+        if (batch) {
+            loaded.d_head_p    = batch;
+            loaded.d_numBlocks = d_batchSize;
+        }
+        else {
+            // Allocate a batch from the pool.  Each block is added to
+            // 'loaded' as soon as it is obtained, so that no block is lost if
+            // an allocation throws.
+
+            for (int i = 0; i < d_batchSize; ++i) {
+                Link *link = static_cast<Link *>(d_pools_p[pool].allocate());
+                link->d_next_p  = loaded.d_head_p;
+                loaded.d_head_p = link;
+                ++loaded.d_numBlocks;
+            }
+        }
+    }
+
+    Link *link = loaded.d_head_p;
+    loaded.d_head_p = link->d_next_p;
+    --loaded.d_numBlocks;
+
+    return link;
+}
+
+void ThreadCachingMultipoolAllocator::spill(ThreadCache *cache, int pool)
+{
+    Magazine& loaded   = cache->d_loaded_p[pool];
+    Magazine& previous = cache->d_previous_p[pool];
+
+    BSLS_ASSERT(d_batchSize == loaded.d_numBlocks);
+
+    if (previous.d_numBlocks) {
+        pushBatch(pool, previous.d_head_p);
+    }
+
+    previous           = loaded;
+    loaded.d_head_p    = 0;
+    loaded.d_numBlocks = 0;
+}
+
+// PRIVATE ACCESSORS
+inline
+int ThreadCachingMultipoolAllocator::findPool(
+                                             bsls::Types::size_type size) const
+{
+    return 31 - bdlb::BitUtil::numLeadingUnsetBits(static_cast<bsl::uint32_t>(
+                                ((size + k_MIN_BLOCK_SIZE - 1) >> 3) * 2 - 1));
+}
+
+// CREATORS
+ThreadCachingMultipoolAllocator::ThreadCachingMultipoolAllocator(
+                                              bslma::Allocator *basicAllocator)
+: d_pools_p(0)
+, d_depots_p(0)
+, d_numPools(k_DEFAULT_NUM_POOLS)
+, d_batchSize(k_DEFAULT_BATCH_SIZE)
+, d_maxBlockSize(0)
+, d_caches_p(0)
+, d_blockList(basicAllocator)
+, d_allocAdapter(&d_mutex, basicAllocator)
+{
+    initialize(k_CHUNKS_PER_BATCH * d_batchSize);
+}
+
+ThreadCachingMultipoolAllocator::ThreadCachingMultipoolAllocator(
+                                              int               numPools,
+                                              bslma::Allocator *basicAllocator)
+: d_pools_p(0)
+, d_depots_p(0)
+, d_numPools(numPools)
+, d_batchSize(k_DEFAULT_BATCH_SIZE)
+, d_maxBlockSize(0)
+, d_caches_p(0)
+, d_blockList(basicAllocator)
+, d_allocAdapter(&d_mutex, basicAllocator)
+{
+    initialize(k_CHUNKS_PER_BATCH * d_batchSize);
+}
+
+ThreadCachingMultipoolAllocator::ThreadCachingMultipoolAllocator(
+                                              int               numPools,
+                                              int               batchSize,
+                                              bslma::Allocator *basicAllocator)
+: d_pools_p(0)
+, d_depots_p(0)
+, d_numPools(numPools)
+, d_batchSize(batchSize)
+, d_maxBlockSize(0)
+, d_caches_p(0)
+, d_blockList(basicAllocator)
+, d_allocAdapter(&d_mutex, basicAllocator)
+{
+    initialize(k_CHUNKS_PER_BATCH * d_batchSize);
+}
+
+ThreadCachingMultipoolAllocator::~ThreadCachingMultipoolAllocator()
+{
+    // Deleting the key first guarantees that the exit handler is not invoked
+    // for threads exiting after this point.
+
+    bslmt::ThreadUtil::deleteKey(d_key);
+
+    while (d_caches_p) {
+        ThreadCache *next = d_caches_p->d_next_p;
+        d_allocAdapter.deallocate(d_caches_p);
+        d_caches_p = next;
+    }
+
+    d_blockList.release();
+    for (int i = 0; i < d_numPools; ++i) {
+        d_pools_p[i].release();
+        d_pools_p[i].~ConcurrentPool();
+    }
+    d_allocAdapter.deallocate(d_pools_p);
+    d_allocAdapter.deallocate(d_depots_p);
+}
+
+// MANIPULATORS
+void *ThreadCachingMultipoolAllocator::allocate(bsls::Types::size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return 0;                                                     // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(size <= d_maxBlockSize)) {
+        const int pool = findPool(size);
+
+        ThreadCache *cache = static_cast<ThreadCache *>(
+                                        bslmt::ThreadUtil::getSpecific(d_key));
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == cache)) {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+            cache = createThreadCache();
+        }
+
+        Magazine& loaded = cache->d_loaded_p[pool];
+        Header   *p;
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(0 != loaded.d_head_p)) {
+            Link *link = loaded.d_head_p;
+            loaded.d_head_p = link->d_next_p;
+            --loaded.d_numBlocks;
+
+            p = reinterpret_cast<Header *>(link);
+        }
+        else {
+            p = static_cast<Header *>(refill(cache, pool));
+        }
+
+        p->d_header.d_poolIdx = pool;
+
+        return p + 1;                                                 // RETURN
+    }
+
+    // The requested size is larger than the largest pool; allocate it from
+    // the block list.
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    Header *p = static_cast<Header *>(
+                                  d_blockList.allocate(size + sizeof(Header)));
+
+    p->d_header.d_poolIdx = -1;
+
+    return p + 1;
+}
+
+void ThreadCachingMultipoolAllocator::deallocate(void *address)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == address)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        return;                                                       // RETURN
+    }
+
+    Header *h = static_cast<Header *>(address) - 1;
+
+    const int pool = h->d_header.d_poolIdx;
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(-1 == pool)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        d_blockList.deallocate(h);
+        return;                                                       // RETURN
+    }
+
+    ThreadCache *cache = static_cast<ThreadCache *>(
+                                        bslmt::ThreadUtil::getSpecific(d_key));
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == cache)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        // 'deallocate' must not throw; if the cache of this thread cannot be
+        // created, return the block directly to its pool.
+
+        BSLS_TRY {
+            cache = createThreadCache();
+        }
+        BSLS_CATCH(...) {
+            d_pools_p[pool].deallocate(h);
+            return;                                                   // RETURN
+        }
+    }
+
+    Magazine& loaded = cache->d_loaded_p[pool];
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                                        d_batchSize == loaded.d_numBlocks)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        spill(cache, pool);
+    }
+
+    Link *link = reinterpret_cast<Link *>(h);
+    link->d_next_p  = loaded.d_head_p;
+    loaded.d_head_p = link;
+    ++loaded.d_numBlocks;
+}
+
+void ThreadCachingMultipoolAllocator::flushThreadCache()
+{
+    ThreadCache *cache = static_cast<ThreadCache *>(
+                                        bslmt::ThreadUtil::getSpecific(d_key));
+    if (cache) {
+        flushCache(cache);
+    }
+}
+
+void ThreadCachingMultipoolAllocator::release()
+{
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_cachesMutex);
+
+        for (ThreadCache *cache = d_caches_p; cache; cache = cache->d_next_p) {
+            bsl::memset(cache->d_loaded_p,
+                        0,
+                        2 * d_numPools * sizeof(Magazine));
+        }
+    }
+
+    for (int i = 0; i < d_numPools; ++i) {
+        d_depots_p[i].d_numBatches = 0;
+        d_pools_p[i].release();
+    }
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+    d_blockList.release();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// FREE FUNCTIONS
+extern "C"
+void bdlma_ThreadCachingMultipoolAllocator_threadExit(void *cache)
+{
+    using namespace BloombergLP;
+
+    typedef bdlma::ThreadCachingMultipoolAllocator::ThreadCache ThreadCache;
+
+    ThreadCache *threadCache = static_cast<ThreadCache *>(cache);
+
+    bdlma::ThreadCachingMultipoolAllocator *allocator =
+                                                   threadCache->d_allocator_p;
+
+    allocator->flushCache(threadCache);
+    allocator->destroyThreadCache(threadCache);
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,446 @@
+// bdlma_threadcachingmultipoolallocator.h                            -*-C++-*-
+#ifndef INCLUDED_BDLMA_THREADCACHINGMULTIPOOLALLOCATOR
+#define INCLUDED_BDLMA_THREADCACHINGMULTIPOOLALLOCATOR
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a multipool allocator with per-thread block caches.
+//
+//@CLASSES:
+//  bdlma::ThreadCachingMultipoolAllocator: multipool with thread caches
+//
+//@SEE_ALSO: bdlma_concurrentmultipoolallocator, bdlma_concurrentpool
+//
+//@DESCRIPTION: This component provides a thread-safe allocator,
+// 'bdlma::ThreadCachingMultipoolAllocator', that implements the
+// 'bdlma::ManagedAllocator' protocol.  Like a
+// 'bdlma::ConcurrentMultipoolAllocator', it maintains a configurable number
+// of 'bdlma::ConcurrentPool' objects, each dispensing memory blocks of twice
+// the size of the previous pool, starting with 8 bytes, and satisfies
+// requests for larger blocks directly from the underlying allocator.  Unlike
+// a 'bdlma::ConcurrentMultipoolAllocator', it places in front of the shared
+// pools a small cache of free blocks *per* *thread*, so that most allocation
+// and deallocation requests are satisfied without any atomic operation or
+// lock.
+//..
+//   ,--------------------------------------.
+//  ( bdlma::ThreadCachingMultipoolAllocator )
+//   `--------------------------------------'
+//                     |       ctor/dtor
+//                     |       batchSize
+//                     |       flushThreadCache
+//                     |       maxPooledBlockSize
+//                     |       numPools
+//                     V
+//          ,-----------------------.
+//         ( bdlma::ManagedAllocator )
+//          `-----------------------'
+//                     |       release
+//                     V
+//             ,----------------.
+//            ( bslma::Allocator )
+//             `----------------'
+//                             allocate
+//                             deallocate
+//..
+//
+///Thread Caches, Batches, and the Depot
+///-------------------------------------
+// Under heavy concurrent use, the lock-free free lists of the pools of a
+// 'bdlma::ConcurrentMultipoolAllocator' become a point of contention: every
+// allocation and deallocation, by every thread, performs an atomic
+// read-modify-write on the head of the free list of the pool for the block
+// size, so that the throughput of the allocator does not increase (and often
+// decreases) as threads are added.
+//
+// A 'bdlma::ThreadCachingMultipoolAllocator' avoids that contention using the
+// "magazine" design of the Solaris slab allocator.  Each thread using the
+// allocator owns, for each pool, two *magazines* of free blocks, each holding
+// at most 'batchSize()' blocks:
+//
+//: o An allocation takes a block from the first magazine.  If that magazine
+//:   is empty, the two magazines are exchanged if the second is full;
+//:   otherwise, a full magazine (a *batch* of 'batchSize()' blocks) is taken
+//:   from the *depot* shared by all threads, or, if the depot is empty, a
+//:   batch of blocks is allocated from the pool.
+//:
+//: o A deallocation returns the block to the first magazine.  If that
+//:   magazine is full, the second magazine (if it is full) is given to the
+//:   depot, and the first magazine becomes the second.
+//
+// Blocks are therefore exchanged between the thread caches and the shared
+// structures a whole batch at a time, taking a single (briefly held) lock per
+// 'batchSize()' operations.  The depot holds a bounded number of batches for
+// each pool; batches given to a full depot are returned to the pool.  A
+// thread therefore never caches more than '2 * batchSize()' blocks of each
+// size, and blocks deallocated by a thread other than the one that allocated
+// them flow back to other threads through the depot.
+//
+// When a thread that has used the allocator exits, the blocks in its cache
+// are returned to the depot (and the pools), so that short-lived threads do
+// not strand memory.  A long-lived thread that stops using the allocator can
+// return its cached blocks explicitly by calling 'flushThreadCache'.
+//
+// The thread caches are found using a thread-specific storage key (see
+// 'bslmt::ThreadUtil::createKey') owned by each allocator.  As the number of
+// such keys is limited by the platform (to 1024 on Linux), this allocator is
+// intended for a small number of long-lived, process-wide instances, and not
+// as a replacement for short-lived pools.
+//
+///Thread Safety
+///-------------
+// 'allocate', 'deallocate', and 'flushThreadCache' may be invoked
+// concurrently from any number of threads.  'release' and the destructor must
+// not be invoked while any other thread is using the allocator.  In
+// addition, the behavior is undefined if a thread that has used the allocator
+// exits concurrently with the destruction of the allocator; threads should be
+// joined, or have called 'flushThreadCache', before the allocator is
+// destroyed.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Allocating Messages in Many Threads
+/// - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we have a service in which many worker threads each create and
+// destroy large numbers of small message objects, often deallocating a
+// message in a different thread than the one that allocated it.
+//
+// First, we define a function that each worker thread runs, which allocates
+// a number of messages, and then deallocates them:
+//..
+//  struct Message {
+//      int  d_id;
+//      char d_payload[52];
+//  };
+//
+//  void processMessages(bslma::Allocator *allocator, int numMessages)
+//      // Allocate the specified 'numMessages' messages from the specified
+//      // 'allocator', and then deallocate them.
+//  {
+//      bsl::vector<Message *> messages(allocator);
+//      messages.reserve(numMessages);
+//
+//      for (int i = 0; i < numMessages; ++i) {
+//          Message *message = new (*allocator) Message;
+//          message->d_id = i;
+//          messages.push_back(message);
+//      }
+//
+//      for (int i = 0; i < numMessages; ++i) {
+//          assert(i == messages[i]->d_id);
+//
+//          allocator->deleteObject(messages[i]);
+//      }
+//  }
+//..
+// Next, we define the entry point of the worker threads, which is passed the
+// address of the allocator:
+//..
+//  extern "C" void *workerFunction(void *arg)
+//  {
+//      processMessages(static_cast<bslma::Allocator *>(arg), 1000);
+//      return 0;
+//  }
+//..
+// Then, we create a thread-caching multipool allocator, which obtains its
+// memory from a counting allocator, and a group of worker threads using it:
+//..
+//  bdlma::CountingAllocator countingAllocator;
+//  {
+//      bdlma::ThreadCachingMultipoolAllocator allocator(&countingAllocator);
+//
+//      bslmt::ThreadUtil::Handle handles[4];
+//      for (int i = 0; i < 4; ++i) {
+//          bslmt::ThreadUtil::create(&handles[i],
+//                                    workerFunction,
+//                                    &allocator);
+//      }
+//..
+// Now, we join the threads.  Each exiting thread has returned the blocks in
+// its cache to the allocator, where they remain available to other threads:
+//..
+//      for (int i = 0; i < 4; ++i) {
+//          bslmt::ThreadUtil::join(handles[i]);
+//      }
+//  }
+//..
+// Finally, we observe that all of the memory was released to the counting
+// allocator when 'allocator' was destroyed:
+//..
+//  assert(0 == countingAllocator.numBytesInUse());
+//..
+
+#include <bdlscm_version.h>
+
+#include <bdlma_blocklist.h>
+#include <bdlma_concurrentallocatoradapter.h>
+#include <bdlma_managedallocator.h>
+
+#include <bslma_allocator.h>
+
+#include <bslmt_mutex.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_keyword.h>
+#include <bsls_types.h>
+
+extern "C" void bdlma_ThreadCachingMultipoolAllocator_threadExit(
+                                                                 void *cache);
+    // Return the blocks held in the specified thread 'cache' to the
+    // 'bdlma::ThreadCachingMultipoolAllocator' that owns it, and destroy
+    // 'cache'.  This function is registered as the destructor of the
+    // thread-specific key of each allocator, and is invoked when a thread that
+    // has used the allocator exits.  Note that this function is for *private*
+    // use only.
+
+namespace BloombergLP {
+namespace bdlma {
+
+class ConcurrentPool;
+
+                   // =====================================
+                   // class ThreadCachingMultipoolAllocator
+                   // =====================================
+
+class ThreadCachingMultipoolAllocator : public ManagedAllocator {
+    // This class implements the 'bdlma::ManagedAllocator' protocol to provide
+    // a thread-safe allocator that maintains a configurable number of
+    // 'bdlma::ConcurrentPool' objects, each dispensing memory blocks of twice
+    // the size of the previous pool, fronted by a bounded cache of free
+    // blocks for each thread using the allocator.  Blocks move between the
+    // thread caches and the pools in batches, through a shared depot of full
+    // batches.  Both the 'release' method and the destructor release all
+    // memory currently allocated via the object.
+
+    // PRIVATE TYPES
+    struct Header {
+        // This 'struct' provides header information for each allocated memory
+        // block.  The header stores the index of the pool used for the memory
+        // allocation, or -1 if the block was not pooled.
+
+        union {
+            int                    d_poolIdx;  // pool used for this memory
+                                               // block
+
+            bsls::AlignmentUtil::MaxAlignedType
+                                   d_dummy;    // force maximum alignment
+        } d_header;
+    };
+
+    struct Link;
+    struct Magazine;
+    struct ThreadCache;
+    struct Depot;
+        // These types are defined in the implementation file.
+
+    // DATA
+    ConcurrentPool            *d_pools_p;       // array of memory pools,
+                                                // each dispensing fixed-size
+                                                // memory blocks
+
+    Depot                     *d_depots_p;      // array of shared depots of
+                                                // full batches, one per pool
+
+    int                        d_numPools;      // number of memory pools
+
+    int                        d_batchSize;     // number of blocks in a
+                                                // magazine, and moved between
+                                                // a thread cache and a depot
+                                                // at once
+
+    bsls::Types::size_type     d_maxBlockSize;  // largest pooled block size;
+                                                // always a power of 2
+
+    bslmt::ThreadUtil::Key     d_key;           // thread-specific key of the
+                                                // thread caches
+
+    ThreadCache               *d_caches_p;      // list of the thread caches
+                                                // of this allocator
+
+    bslmt::Mutex               d_cachesMutex;   // protects 'd_caches_p'
+
+    BlockList                  d_blockList;     // memory manager for "large"
+                                                // memory blocks
+
+    bslmt::Mutex               d_mutex;         // synchronizes access to the
+                                                // underlying allocator
+
+    ConcurrentAllocatorAdapter d_allocAdapter;  // thread-safe adapter
+
+  private:
+    // NOT IMPLEMENTED
+    ThreadCachingMultipoolAllocator(const ThreadCachingMultipoolAllocator&);
+    ThreadCachingMultipoolAllocator& operator=(
+                                       const ThreadCachingMultipoolAllocator&);
+
+    // FRIENDS
+    friend void ::bdlma_ThreadCachingMultipoolAllocator_threadExit(void *);
+
+    // PRIVATE MANIPULATORS
+    ThreadCache *createThreadCache();
+        // Create a cache for the calling thread, register it with this
+        // allocator, make it the value of the thread-specific key of this
+        // allocator for the calling thread, and return its address.
+
+    void destroyThreadCache(ThreadCache *cache);
+        // Unregister the specified 'cache' from this allocator and release
+        // its memory.  The behavior is undefined unless 'cache' holds no
+        // blocks.
+
+    void flushCache(ThreadCache *cache);
+        // Return each block held in the specified 'cache' to the depot or to
+        // the pool from which it was allocated, leaving 'cache' empty.
+
+    void initialize(int maxBlocksPerChunk);
+        // Create the pools and depots of this allocator, and its
+        // thread-specific key, using the specified 'maxBlocksPerChunk' as the
+        // maximum chunk size of each pool.
+
+    void pushBatch(int pool, Link *batch);
+        // Give the specified 'batch' of 'd_batchSize' free blocks of the
+        // specified 'pool' to the depot for 'pool', or, if that depot is full,
+        // return its blocks to 'pool'.
+
+    void *refill(ThreadCache *cache, int pool);
+        // Replenish the empty magazine for the specified 'pool' in the
+        // specified 'cache', from its second magazine, from the depot, or
+        // from the pool, and return the address of a block taken from it.
+
+    void spill(ThreadCache *cache, int pool);
+        // Make room in the full magazine for the specified 'pool' in the
+        // specified 'cache' by making it the second magazine, giving the
+        // previous second magazine (if it is not empty) to the depot.
+
+    // PRIVATE ACCESSORS
+    int findPool(bsls::Types::size_type size) const;
+        // Return the index of the pool dispensing blocks of the smallest size
+        // not less than the specified 'size'.  The behavior is undefined
+        // unless '1 <= size <= d_maxBlockSize'.
+
+  public:
+    // CREATORS
+    explicit ThreadCachingMultipoolAllocator(
+                                         bslma::Allocator *basicAllocator = 0);
+    explicit ThreadCachingMultipoolAllocator(
+                                         int               numPools,
+                                         bslma::Allocator *basicAllocator = 0);
+    ThreadCachingMultipoolAllocator(int               numPools,
+                                    int               batchSize,
+                                    bslma::Allocator *basicAllocator = 0);
+        // Create a thread-caching multipool allocator.  Optionally specify
+        // 'numPools', indicating the number of internally created pools; the
+        // block size of the first pool is 8 bytes, with the block size of each
+        // additional pool successively doubling.  If 'numPools' is not
+        // specified, an implementation-defined number of pools 'N' -- covering
+        // memory blocks ranging in size from '2^3 = 8' to '2^(N+2)' -- are
+        // created.  Optionally specify a 'batchSize', indicating the number of
+        // blocks held in a magazine, and moved at once between a thread cache
+        // and the shared pools; each thread caches at most '2 * batchSize'
+        // blocks of each size.  If 'batchSize' is not specified, an
+        // implementation-defined value is used.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  Throw
+        // 'bsl::bad_alloc' if a thread-specific storage key cannot be
+        // created.  The behavior is undefined unless '1 <= numPools' and
+        // '1 <= batchSize'.
+
+    ~ThreadCachingMultipoolAllocator() BSLS_KEYWORD_OVERRIDE;
+        // Destroy this allocator, and release all memory currently allocated
+        // through it, including the caches of the threads that have used it.
+        // The behavior is undefined unless no other thread is using this
+        // allocator, and no thread that has used it exits concurrently.
+
+    // MANIPULATORS
+    void *allocate(bsls::Types::size_type size) BSLS_KEYWORD_OVERRIDE;
+        // Return the address of a contiguous block of maximally-aligned memory
+        // of (at least) the specified 'size' (in bytes).  If 'size' is 0, no
+        // memory is allocated and 0 is returned.  If
+        // 'size > maxPooledBlockSize()', the memory is allocated directly from
+        // the underlying allocator; otherwise, it is taken from the cache of
+        // the calling thread.
+
+    void deallocate(void *address) BSLS_KEYWORD_OVERRIDE;
+        // Return the memory block at the specified 'address' back to this
+        // allocator.  If 'address' is 0, this function has no effect.  The
+        // behavior is undefined unless 'address' was allocated using this
+        // allocator object and has not already been deallocated.  Note that
+        // the block is placed in the cache of the calling thread, which need
+        // not be the thread that allocated it.
+
+    void flushThreadCache();
+        // Return each block cached by the calling thread to the shared depot
+        // or pools, where it is available to other threads.  Note that this
+        // method is invoked automatically when a thread that has used this
+        // allocator exits.
+
+    void release() BSLS_KEYWORD_OVERRIDE;
+        // Release all memory currently allocated through this allocator,
+        // emptying the caches of all threads.  The behavior is undefined
+        // unless no other thread is using this allocator.
+
+    // ACCESSORS
+    int batchSize() const;
+        // Return the number of blocks moved at once between a thread cache and
+        // the shared pools.
+
+    bsls::Types::size_type maxPooledBlockSize() const;
+        // Return the maximum size of memory blocks that are pooled by this
+        // allocator.  Larger requests are satisfied by the underlying
+        // allocator.
+
+    int numPools() const;
+        // Return the number of pools managed by this allocator.
+};
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                   // -------------------------------------
+                   // class ThreadCachingMultipoolAllocator
+                   // -------------------------------------
+
+// ACCESSORS
+inline
+int ThreadCachingMultipoolAllocator::batchSize() const
+{
+    return d_batchSize;
+}
+
+inline
+bsls::Types::size_type
+ThreadCachingMultipoolAllocator::maxPooledBlockSize() const
+{
+    return d_maxBlockSize;
+}
+
+inline
+int ThreadCachingMultipoolAllocator::numPools() const
+{
+    return d_numPools;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
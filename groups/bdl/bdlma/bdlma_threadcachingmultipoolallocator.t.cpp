@@ -0,0 +1,1237 @@
+// bdlma_threadcachingmultipoolallocator.t.cpp                        -*-C++-*-
+#include <bdlma_threadcachingmultipoolallocator.h>
+
+#include <bdlma_concurrentmultipoolallocator.h>
+#include <bdlma_countingallocator.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                              TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is a thread-safe multipool allocator that caches
+// free blocks per thread.  The pools themselves ('bdlma::ConcurrentPool') are
+// tested in their own test driver; this test driver concentrates on the
+// routing of requests to pools by size, on the movement of blocks between
+// the thread caches, the shared depots, and the pools, on the return of the
+// cache of a thread to the allocator when the thread exits, and on the
+// correctness of the allocator when used concurrently by many threads.  The
+// underlying allocator is a 'bslma::TestAllocator', whose statistics reveal
+// when memory is obtained from the underlying allocator.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] ThreadCachingMultipoolAllocator(bslma::Allocator *ba = 0);
+// [ 2] ThreadCachingMultipoolAllocator(int numPools, *ba = 0);
+// [ 2] ThreadCachingMultipoolAllocator(int numPools, int batchSize, *ba);
+// [ 2] ~ThreadCachingMultipoolAllocator();
+//
+// MANIPULATORS
+// [ 3] void *allocate(bsls::Types::size_type size);
+// [ 3] void deallocate(void *address);
+// [ 4] void flushThreadCache();
+// [ 7] void release();
+//
+// ACCESSORS
+// [ 2] int batchSize() const;
+// [ 2] bsls::Types::size_type maxPooledBlockSize() const;
+// [ 2] int numPools() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] THREAD EXIT RETURNS THE CACHE
+// [ 6] CONCURRENCY TEST
+// [ 8] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST: throughput vs. 'ConcurrentMultipoolAllocator'
+// ----------------------------------------------------------------------------
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlma::ThreadCachingMultipoolAllocator Obj;
+
+enum { k_MAX_ALIGNMENT = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT };
+
+// ============================================================================
+//                          HELPER FUNCTIONS
+// ----------------------------------------------------------------------------
+
+static
+bool isMaximallyAligned(const void *address)
+    // Return 'true' if the specified 'address' is maximally aligned, and
+    // 'false' otherwise.
+{
+    return 0 == reinterpret_cast<bsls::Types::UintPtr>(address)
+                                                         % k_MAX_ALIGNMENT;
+}
+
+static
+void fill(void *address, bsls::Types::size_type size, char value)
+    // Set each of the specified 'size' bytes at the specified 'address' to
+    // the specified 'value'.
+{
+    bsl::memset(address, value, size);
+}
+
+static
+bool isFilled(const void *address, bsls::Types::size_type size, char value)
+    // Return 'true' if each of the specified 'size' bytes at the specified
+    // 'address' has the specified 'value', and 'false' otherwise.
+{
+    const char *p = static_cast<const char *>(address);
+    for (bsls::Types::size_type i = 0; i < size; ++i) {
+        if (value != p[i]) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+                       // ==========================
+                       // struct AllocateAndFreeArgs
+                       // ==========================
+
+struct AllocateAndFreeArgs {
+    // This 'struct' holds the arguments of 'allocateAndFree'.
+
+    bslma::Allocator *d_allocator_p;  // allocator under test
+    int               d_numBlocks;    // number of blocks to allocate
+    int               d_size;         // size of each block
+    bool              d_flush;        // 'true' to call 'flushThreadCache'
+};
+
+extern "C"
+void *allocateAndFree(void *arg)
+    // Allocate the number of blocks of the size specified by 'arg', which
+    // must be the address of an 'AllocateAndFreeArgs' object, and then
+    // deallocate them.  If 'd_flush' is 'true', flush the thread cache
+    // before returning.
+{
+    AllocateAndFreeArgs *args = static_cast<AllocateAndFreeArgs *>(arg);
+
+    bsl::vector<void *> blocks;
+    blocks.reserve(args->d_numBlocks);
+
+    for (int i = 0; i < args->d_numBlocks; ++i) {
+        void *p = args->d_allocator_p->allocate(args->d_size);
+        fill(p, args->d_size, static_cast<char>(i));
+        blocks.push_back(p);
+    }
+    for (int i = 0; i < args->d_numBlocks; ++i) {
+        ASSERTV(i, isFilled(blocks[i], args->d_size, static_cast<char>(i)));
+        args->d_allocator_p->deallocate(blocks[i]);
+    }
+
+    if (args->d_flush) {
+        dynamic_cast<Obj *>(args->d_allocator_p)->flushThreadCache();
+    }
+
+    return 0;
+}
+
+                           // ==================
+                           // struct OutliveArgs
+                           // ==================
+
+struct OutliveArgs {
+    // This 'struct' holds the arguments of 'outliveAllocator'.
+
+    Obj            *d_allocator_p;  // allocator under test
+    bslmt::Barrier *d_barrier_p;    // barrier shared with the main thread
+};
+
+extern "C"
+void *outliveAllocator(void *arg)
+    // Populate the cache of this thread in the allocator specified by 'arg',
+    // which must be the address of an 'OutliveArgs' object, wait on its
+    // barrier, and then wait on it again (while the allocator is destroyed)
+    // before exiting.
+{
+    OutliveArgs    *args    = static_cast<OutliveArgs *>(arg);
+    bslmt::Barrier *barrier = args->d_barrier_p;
+
+    args->d_allocator_p->deallocate(args->d_allocator_p->allocate(64));
+
+    barrier->wait();  // cache populated; 'args' goes out of scope
+    barrier->wait();  // allocator destroyed
+
+    return 0;
+}
+
+                         // =====================
+                         // struct ExchangeShared
+                         // =====================
+
+enum { k_EXCHANGE_MAX_THREADS = 16, k_EXCHANGE_BLOCKS = 200 };
+
+struct ExchangeShared {
+    // This 'struct' holds the state shared by the threads of the concurrency
+    // test.  In each round, each thread allocates blocks into its slot, and
+    // then, after a barrier, verifies and deallocates the blocks in the slot
+    // of the next thread.
+
+    Obj            *d_allocator_p;
+    int             d_numThreads;
+    int             d_numRounds;
+    bslmt::Barrier *d_barrier_p;
+    void           *d_blocks[k_EXCHANGE_MAX_THREADS][k_EXCHANGE_BLOCKS];
+    int             d_sizes[k_EXCHANGE_MAX_THREADS][k_EXCHANGE_BLOCKS];
+};
+
+struct ExchangeArgs {
+    // This 'struct' holds the arguments of a thread of the concurrency test.
+
+    ExchangeShared *d_shared_p;
+    int             d_id;
+};
+
+static
+int blockSize(int thread, int round, int block)
+    // Return the size of the block having the specified 'block' index that
+    // is allocated by the specified 'thread' in the specified 'round'.  The
+    // sizes cover all pools of a default allocator, and occasionally exceed
+    // the largest pooled size.
+{
+    const unsigned hash = static_cast<unsigned>(thread * 7919
+                                              + round * 104729
+                                              + block * 1299709);
+    return 0 == hash % 97 ? 5000 + static_cast<int>(hash % 100)
+                          : 1 + static_cast<int>((hash >> 3) % 4096);
+}
+
+extern "C"
+void *exchangeBlocks(void *arg)
+    // Run the rounds of the concurrency test for the thread described by
+    // 'arg', which must be the address of an 'ExchangeArgs' object.
+{
+    ExchangeArgs   *args   = static_cast<ExchangeArgs *>(arg);
+    ExchangeShared *shared = args->d_shared_p;
+    const int       id     = args->d_id;
+    const int       next   = (id + 1) % shared->d_numThreads;
+
+    for (int round = 0; round < shared->d_numRounds; ++round) {
+        for (int i = 0; i < k_EXCHANGE_BLOCKS; ++i) {
+            const int size = blockSize(id, round, i);
+            void     *p    = shared->d_allocator_p->allocate(size);
+
+            ASSERTV(id, round, i, isMaximallyAligned(p));
+
+            fill(p, size, static_cast<char>(id + i));
+            shared->d_blocks[id][i] = p;
+            shared->d_sizes[id][i]  = size;
+        }
+
+        shared->d_barrier_p->wait();
+
+        for (int i = 0; i < k_EXCHANGE_BLOCKS; ++i) {
+            ASSERTV(id, round, i, isFilled(shared->d_blocks[next][i],
+                                           shared->d_sizes[next][i],
+                                           static_cast<char>(next + i)));
+            shared->d_allocator_p->deallocate(shared->d_blocks[next][i]);
+        }
+
+        shared->d_barrier_p->wait();
+    }
+
+    return 0;
+}
+
+// ============================================================================
+//                        PERFORMANCE TEST SUPPORT
+// ----------------------------------------------------------------------------
+
+namespace {
+namespace u {
+
+struct ThroughputArgs {
+    // This 'struct' holds the arguments of a thread of the performance test.
+
+    bslma::Allocator *d_allocator_p;
+    int               d_numIterations;
+    bslmt::Barrier   *d_barrier_p;
+};
+
+extern "C"
+void *churn(void *arg)
+    // Repeatedly allocate, and then deallocate, a burst of small blocks from
+    // the allocator specified by 'arg', which must be the address of a
+    // 'ThroughputArgs' object.
+{
+    enum { k_BURST = 16 };
+
+    ThroughputArgs   *args      = static_cast<ThroughputArgs *>(arg);
+    bslma::Allocator *allocator = args->d_allocator_p;
+    void             *blocks[k_BURST];
+
+    args->d_barrier_p->wait();
+
+    for (int i = 0; i < args->d_numIterations; ++i) {
+        for (int j = 0; j < k_BURST; ++j) {
+            blocks[j] = allocator->allocate(8 << (j % 5));
+        }
+        for (int j = 0; j < k_BURST; ++j) {
+            allocator->deallocate(blocks[j]);
+        }
+    }
+
+    return 0;
+}
+
+double measure(bslma::Allocator *allocator,
+               int               numThreads,
+               int               numIterations)
+    // Return the number of allocations per second achieved by the specified
+    // 'numThreads' threads each performing the specified 'numIterations'
+    // bursts of allocations from the specified 'allocator'.
+{
+    bslmt::Barrier barrier(numThreads + 1);
+    ThroughputArgs args = { allocator, numIterations, &barrier };
+
+    bsl::vector<bslmt::ThreadUtil::Handle> handles(numThreads);
+    for (int i = 0; i < numThreads; ++i) {
+        bslmt::ThreadUtil::create(&handles[i], churn, &args);
+    }
+
+    bsls::Stopwatch timer;
+    barrier.wait();
+    timer.start(true);
+    for (int i = 0; i < numThreads; ++i) {
+        bslmt::ThreadUtil::join(handles[i]);
+    }
+    timer.stop();
+
+    return 16.0 * numThreads * numIterations / timer.accumulatedWallTime();
+}
+
+}  // close namespace u
+}  // close unnamed namespace
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Allocating Messages in Many Threads
+/// - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we have a service in which many worker threads each create and
+// destroy large numbers of small message objects, often deallocating a
+// message in a different thread than the one that allocated it.
+//
+// First, we define a function that each worker thread runs, which allocates
+// a number of messages, and then deallocates them:
+//..
+    struct Message {
+        int  d_id;
+        char d_payload[52];
+    };
+
+    void processMessages(bslma::Allocator *allocator, int numMessages)
+        // Allocate the specified 'numMessages' messages from the specified
+        // 'allocator', and then deallocate them.
+    {
+        bsl::vector<Message *> messages(allocator);
+        messages.reserve(numMessages);
+
+        for (int i = 0; i < numMessages; ++i) {
+            Message *message = new (*allocator) Message;
+            message->d_id = i;
+            messages.push_back(message);
+        }
+
+        for (int i = 0; i < numMessages; ++i) {
+            ASSERT(i == messages[i]->d_id);
+
+            allocator->deleteObject(messages[i]);
+        }
+    }
+//..
+// Next, we define the entry point of the worker threads, which is passed the
+// address of the allocator:
+//..
+    extern "C" void *workerFunction(void *arg)
+    {
+        processMessages(static_cast<bslma::Allocator *>(arg), 1000);
+        return 0;
+    }
+//..
+
+// ============================================================================
+//                                 MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int  test                = argc > 1 ? atoi(argv[1]) : 0;
+    bool verbose             = argc > 2;
+    bool veryVerbose         = argc > 3;
+    bool veryVeryVerbose     = argc > 4;
+
+    (void)veryVeryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+// Then, we create a thread-caching multipool allocator, which obtains its
+// memory from a counting allocator, and a group of worker threads using it:
+//..
+    bdlma::CountingAllocator countingAllocator;
+    {
+        bdlma::ThreadCachingMultipoolAllocator allocator(&countingAllocator);
+
+        bslmt::ThreadUtil::Handle handles[4];
+        for (int i = 0; i < 4; ++i) {
+            bslmt::ThreadUtil::create(&handles[i],
+                                      workerFunction,
+                                      &allocator);
+        }
+//..
+// Now, we join the threads.  Each exiting thread has returned the blocks in
+// its cache to the allocator, where they remain available to other threads:
+//..
+        for (int i = 0; i < 4; ++i) {
+            bslmt::ThreadUtil::join(handles[i]);
+        }
+    }
+//..
+// Finally, we observe that all of the memory was released to the counting
+// allocator when 'allocator' was destroyed:
+//..
+    ASSERT(0 == countingAllocator.numBytesInUse());
+//..
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // 'release'
+        //
+        // Concerns:
+        //: 1 'release' returns all memory obtained from the underlying
+        //:   allocator for pooled and large blocks, including blocks held in
+        //:   the thread caches and the depots.
+        //:
+        //: 2 The allocator, including the cache of the calling thread, can be
+        //:   used after 'release'.
+        //
+        // Plan:
+        //: 1 Allocate blocks of each pooled size and a few large blocks,
+        //:   deallocating some of them so that blocks are held in the thread
+        //:   cache and the depot.  Invoke 'release', and verify that the only
+        //:   memory still in use from the test allocator is that of the
+        //:   allocator's arrays and of the thread cache.  (C-1)
+        //:
+        //: 2 Allocate and deallocate again after 'release', and verify that
+        //:   the blocks are usable and that 'release' again returns the
+        //:   memory.  (C-2)
+        //
+        // Testing:
+        //   void release();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'release'" << endl
+                          << "=========" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVerbose);
+
+        Obj mX(4, 4, &ta);
+
+        const bsls::Types::Int64 numBlocksOnCreation = ta.numBlocksInUse();
+
+        // Create the thread cache.
+
+        mX.deallocate(mX.allocate(1));
+
+        // The cache of this thread, and the chunks of the first pool, were
+        // obtained from the test allocator.
+
+        const bsls::Types::Int64 numBlocksBase = numBlocksOnCreation + 1;
+        ASSERTV(numBlocksBase, ta.numBlocksInUse(),
+                numBlocksBase < ta.numBlocksInUse());
+
+        for (int iteration = 0; iteration < 2; ++iteration) {
+            bsl::vector<void *> blocks;
+            for (int i = 0; i < 100; ++i) {
+                for (int size = 1; size <= 128; size *= 2) {
+                    void *p = mX.allocate(size);
+                    fill(p, size, 'x');
+                    blocks.push_back(p);
+                }
+            }
+            for (int i = 0; i < 50; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+
+            blocks.push_back(mX.allocate(1000));
+            blocks.push_back(mX.allocate(2000));
+
+            ASSERTV(iteration, numBlocksBase + 2 < ta.numBlocksInUse());
+
+            mX.release();
+
+            ASSERTV(iteration, numBlocksBase, ta.numBlocksInUse(),
+                    numBlocksBase == ta.numBlocksInUse());
+        }
+
+        void *p = mX.allocate(16);
+        fill(p, 16, 'y');
+        ASSERT(isFilled(p, 16, 'y'));
+        mX.deallocate(p);
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY TEST
+        //
+        // Concerns:
+        //: 1 Blocks allocated concurrently by many threads are distinct: the
+        //:   contents of each block are not modified by any other thread.
+        //:
+        //: 2 Blocks may be deallocated by a thread other than the one that
+        //:   allocated them.
+        //:
+        //: 3 All memory is returned to the underlying allocator on
+        //:   destruction.
+        //
+        // Plan:
+        //: 1 In each of several rounds, have each of a number of threads
+        //:   allocate blocks of varying sizes (including large blocks), and
+        //:   fill each with a value identifying the thread and block.  After
+        //:   a barrier, have each thread verify the contents of, and
+        //:   deallocate, the blocks allocated by the next thread.  (C-1..2)
+        //:
+        //: 2 Verify that no memory is in use from the underlying test
+        //:   allocator once the allocator under test is destroyed.  (C-3)
+        //
+        // Testing:
+        //   CONCURRENCY TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENCY TEST" << endl
+                          << "================" << endl;
+
+        const int NUM_THREADS[] = { 2, 5, 16 };
+        const int NUM_CONFIGS   = sizeof NUM_THREADS / sizeof *NUM_THREADS;
+
+        for (int ti = 0; ti < NUM_CONFIGS; ++ti) {
+            const int numThreads = NUM_THREADS[ti];
+
+            if (veryVerbose) { T_ P(numThreads) }
+
+            bslma::TestAllocator ta("test", veryVeryVerbose);
+            {
+                Obj mX(&ta);
+
+                bslmt::Barrier barrier(numThreads);
+
+                ExchangeShared shared;
+                shared.d_allocator_p = &mX;
+                shared.d_numThreads  = numThreads;
+                shared.d_numRounds   = 20;
+                shared.d_barrier_p   = &barrier;
+
+                ExchangeArgs args[k_EXCHANGE_MAX_THREADS];
+
+                bslmt::ThreadUtil::Handle handles[k_EXCHANGE_MAX_THREADS];
+                for (int i = 0; i < numThreads; ++i) {
+                    args[i].d_shared_p = &shared;
+                    args[i].d_id       = i;
+                    ASSERTV(i, 0 == bslmt::ThreadUtil::create(&handles[i],
+                                                              exchangeBlocks,
+                                                              &args[i]));
+                }
+                for (int i = 0; i < numThreads; ++i) {
+                    bslmt::ThreadUtil::join(handles[i]);
+                }
+            }
+            ASSERTV(numThreads, ta.numBlocksInUse(),
+                    0 == ta.numBlocksInUse());
+        }
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // THREAD EXIT RETURNS THE CACHE
+        //
+        // Concerns:
+        //: 1 When a thread that has used the allocator exits, the blocks in
+        //:   its cache are returned to the allocator, and are reused by other
+        //:   threads, so that the memory used by the allocator does not grow
+        //:   with the number of threads that have used it.
+        //:
+        //: 2 The memory of the cache itself is released when the thread
+        //:   exits.
+        //:
+        //: 3 Threads that have not exited when the allocator is destroyed do
+        //:   not leak memory.
+        //
+        // Plan:
+        //: 1 Repeatedly create a thread that allocates, and then deallocates,
+        //:   more blocks than its cache can hold, and exits without calling
+        //:   'flushThreadCache', and join it.  Verify that the number of bytes
+        //:   and blocks in use from the underlying test allocator after each
+        //:   thread exits is the same as after the first thread exits.
+        //:   (C-1..2)
+        //:
+        //: 2 Repeat P-1 with several concurrent threads per generation, and
+        //:   verify that the memory in use is bounded.  (C-1..2)
+        //:
+        //: 3 Let a thread block, holding a cache, until after the allocator is
+        //:   destroyed, and verify that no memory is in use from the test
+        //:   allocator once the allocator is destroyed.  (C-3)
+        //
+        // Testing:
+        //   THREAD EXIT RETURNS THE CACHE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "THREAD EXIT RETURNS THE CACHE" << endl
+                          << "=============================" << endl;
+
+        if (verbose) cout << "\nOne thread per generation." << endl;
+        {
+            bslma::TestAllocator ta("test", veryVeryVerbose);
+
+            Obj mX(&ta);
+
+            AllocateAndFreeArgs args = { &mX, 5 * mX.batchSize(), 24, false };
+
+            bsls::Types::Int64 numBytes  = 0;
+            bsls::Types::Int64 numBlocks = 0;
+
+            for (int generation = 0; generation < 50; ++generation) {
+                bslmt::ThreadUtil::Handle handle;
+                ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                      allocateAndFree,
+                                                      &args));
+                bslmt::ThreadUtil::join(handle);
+
+                if (0 == generation) {
+                    numBytes  = ta.numBytesInUse();
+                    numBlocks = ta.numBlocksInUse();
+                }
+
+                ASSERTV(generation, numBytes, ta.numBytesInUse(),
+                        numBytes == ta.numBytesInUse());
+                ASSERTV(generation, numBlocks, ta.numBlocksInUse(),
+                        numBlocks == ta.numBlocksInUse());
+            }
+        }
+
+        if (verbose) cout << "\nSeveral threads per generation." << endl;
+        {
+            enum { k_NUM_THREADS = 8 };
+
+            bslma::TestAllocator ta("test", veryVeryVerbose);
+
+            Obj mX(&ta);
+
+            AllocateAndFreeArgs args = { &mX, 3 * mX.batchSize(), 100, false };
+
+            bsls::Types::Int64 maxBytes = 0;
+
+            for (int generation = 0; generation < 20; ++generation) {
+                bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+                for (int i = 0; i < k_NUM_THREADS; ++i) {
+                    ASSERT(0 == bslmt::ThreadUtil::create(&handles[i],
+                                                          allocateAndFree,
+                                                          &args));
+                }
+                for (int i = 0; i < k_NUM_THREADS; ++i) {
+                    bslmt::ThreadUtil::join(handles[i]);
+                }
+
+                if (veryVerbose) { T_ P_(generation) P(ta.numBytesInUse()) }
+
+                if (0 == generation) {
+                    // The blocks in flight at once are bounded by the blocks
+                    // held by all threads at their peak, and the blocks in
+                    // their caches; pools allocate at most twice that in
+                    // chunks.  Allow for all of it a second time.
+
+                    maxBytes = 2 * ta.numBytesInUse();
+                }
+
+                ASSERTV(generation, maxBytes, ta.numBytesInUse(),
+                        ta.numBytesInUse() <= maxBytes);
+            }
+        }
+
+        if (verbose) cout << "\nThread outliving the allocator." << endl;
+        {
+            bslma::TestAllocator ta("test", veryVeryVerbose);
+
+            bslmt::Barrier barrier(2);
+
+            bslmt::ThreadUtil::Handle handle;
+            {
+                Obj mX(&ta);
+
+                OutliveArgs args = { &mX, &barrier };
+
+                ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                      outliveAllocator,
+                                                      &args));
+                barrier.wait();
+            }
+            ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+            barrier.wait();
+            bslmt::ThreadUtil::join(handle);
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // 'flushThreadCache'
+        //
+        // Concerns:
+        //: 1 Blocks deallocated by one thread are cached by that thread, and
+        //:   reused by its subsequent allocations without obtaining memory
+        //:   from the underlying allocator.
+        //:
+        //: 2 'flushThreadCache' makes the cached blocks available to other
+        //:   threads, which obtain them without allocating from the pools'
+        //:   underlying allocator.
+        //:
+        //: 3 'flushThreadCache' has no effect for a thread that has not used
+        //:   the allocator.
+        //
+        // Plan:
+        //: 1 In the main thread, allocate and deallocate several batches of
+        //:   blocks, and verify that allocating them again obtains no memory
+        //:   from the underlying test allocator.  (C-1)
+        //:
+        //: 2 Flush the cache of the main thread, and then, in another thread,
+        //:   allocate the same number of blocks, and verify that the only
+        //:   memory obtained from the test allocator is the cache of the new
+        //:   thread.  (C-2)
+        //:
+        //: 3 Call 'flushThreadCache' on a new allocator, and verify that no
+        //:   memory is allocated.  (C-3)
+        //
+        // Testing:
+        //   void flushThreadCache();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'flushThreadCache'" << endl
+                          << "==================" << endl;
+
+        const int BATCH_SIZES[] = { 1, 2, 7, 32 };
+        const int NUM_BATCH_SIZES = sizeof BATCH_SIZES / sizeof *BATCH_SIZES;
+
+        for (int ti = 0; ti < NUM_BATCH_SIZES; ++ti) {
+            const int BATCH_SIZE = BATCH_SIZES[ti];
+            const int NUM_BLOCKS = 3 * BATCH_SIZE;
+
+            if (veryVerbose) { T_ P(BATCH_SIZE) }
+
+            bslma::TestAllocator ta("test", veryVeryVerbose);
+
+            Obj mX(5, BATCH_SIZE, &ta);
+
+            {
+                const bsls::Types::Int64 numBlocks = ta.numBlocksTotal();
+                mX.flushThreadCache();
+                ASSERTV(BATCH_SIZE, numBlocks == ta.numBlocksTotal());
+            }
+
+            AllocateAndFreeArgs args = { &mX, NUM_BLOCKS, 40, false };
+
+            allocateAndFree(&args);
+
+            bsls::Types::Int64 numBlocks = ta.numBlocksTotal();
+
+            allocateAndFree(&args);
+
+            ASSERTV(BATCH_SIZE, numBlocks, ta.numBlocksTotal(),
+                    numBlocks == ta.numBlocksTotal());
+
+            mX.flushThreadCache();
+
+            bslmt::ThreadUtil::Handle handle;
+            ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                  allocateAndFree,
+                                                  &args));
+            bslmt::ThreadUtil::join(handle);
+
+            ASSERTV(BATCH_SIZE, numBlocks, ta.numBlocksTotal(),
+                    numBlocks + 1 == ta.numBlocksTotal());
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'allocate' AND 'deallocate'
+        //
+        // Concerns:
+        //: 1 'allocate' returns 0 for a size of 0, and 'deallocate' has no
+        //:   effect for a null address.
+        //:
+        //: 2 'allocate' returns maximally-aligned, writable, distinct blocks
+        //:   of at least the requested size, for every size up to, and
+        //:   beyond, 'maxPooledBlockSize()'.
+        //:
+        //: 3 Requests for more than 'maxPooledBlockSize()' bytes obtain a
+        //:   block directly from the underlying allocator, which
+        //:   'deallocate' returns immediately.
+        //:
+        //: 4 Pooled blocks are obtained from the underlying allocator in
+        //:   chunks, not one at a time.
+        //:
+        //: 5 A block just deallocated is reused by the next allocation of the
+        //:   same size class in the same thread.
+        //:
+        //: 6 The default allocator is not used.
+        //
+        // Plan:
+        //: 1 Verify 'allocate(0)' and 'deallocate(0)'.  (C-1)
+        //:
+        //: 2 For each size from 1 to 'maxPooledBlockSize() + 10', allocate a
+        //:   block, verify its alignment, fill it with a value, and verify,
+        //:   after all allocations, that the value of each block is intact.
+        //:   (C-2)
+        //:
+        //: 3 Allocate and deallocate a large block, and verify the number of
+        //:   blocks in use from the test allocator.  (C-3)
+        //:
+        //: 4 Allocate many blocks of the same size, and verify that the
+        //:   number of allocations from the test allocator is much smaller.
+        //:   (C-4)
+        //:
+        //: 5 Deallocate a block and allocate one of the same size class, and
+        //:   verify that the same address is returned.  (C-5)
+        //:
+        //: 6 Install a test allocator as the default, and verify that it is
+        //:   not used.  (C-6)
+        //
+        // Testing:
+        //   void *allocate(bsls::Types::size_type size);
+        //   void deallocate(void *address);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'allocate' AND 'deallocate'" << endl
+                          << "===========================" << endl;
+
+        bslma::TestAllocator da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        const int NUM_POOLS[] = { 1, 2, 5, 10 };
+        const int NUM_CONFIGS = sizeof NUM_POOLS / sizeof *NUM_POOLS;
+
+        for (int ti = 0; ti < NUM_CONFIGS; ++ti) {
+            const int NP = NUM_POOLS[ti];
+
+            if (veryVerbose) { T_ P(NP) }
+
+            bslma::TestAllocator ta("test", veryVeryVerbose);
+
+            Obj mX(NP, &ta);  const Obj& X = mX;
+
+            const int MAX = static_cast<int>(X.maxPooledBlockSize());
+
+            // P-1
+
+            ASSERTV(NP, 0 == mX.allocate(0));
+            mX.deallocate(0);
+
+            // P-2
+
+            bsl::vector<void *> blocks(&ta);
+            for (int size = 1; size <= MAX + 10; ++size) {
+                void *p = mX.allocate(size);
+                ASSERTV(NP, size, p);
+                ASSERTV(NP, size, isMaximallyAligned(p));
+                fill(p, size, static_cast<char>(size));
+                blocks.push_back(p);
+            }
+            for (int size = 1; size <= MAX + 10; ++size) {
+                ASSERTV(NP, size, isFilled(blocks[size - 1],
+                                           size,
+                                           static_cast<char>(size)));
+                mX.deallocate(blocks[size - 1]);
+            }
+            blocks.clear();
+
+            // P-3
+
+            {
+                const bsls::Types::Int64 numBlocks = ta.numBlocksInUse();
+
+                void *p = mX.allocate(MAX + 1);
+                ASSERTV(NP, numBlocks + 1 == ta.numBlocksInUse());
+                fill(p, MAX + 1, 'L');
+
+                mX.deallocate(p);
+                ASSERTV(NP, numBlocks == ta.numBlocksInUse());
+            }
+
+            // P-4
+
+            {
+                const bsls::Types::Int64 numBlocks = ta.numBlocksTotal();
+
+                for (int i = 0; i < 1000; ++i) {
+                    blocks.push_back(mX.allocate(MAX));
+                }
+                ASSERTV(NP, ta.numBlocksTotal() - numBlocks,
+                        ta.numBlocksTotal() - numBlocks < 100);
+
+                for (int i = 0; i < 1000; ++i) {
+                    mX.deallocate(blocks[i]);
+                }
+                blocks.clear();
+            }
+
+            // P-5
+
+            for (int size = 1; size <= MAX; size *= 2) {
+                void *p = mX.allocate(size);
+                mX.deallocate(p);
+
+                ASSERTV(NP, size, p == mX.allocate(size));
+                mX.deallocate(p);
+            }
+        }
+
+        ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 Each constructor creates an allocator with the specified (or
+        //:   default) number of pools and batch size, and the maximum pooled
+        //:   block size corresponding to the number of pools.
+        //:
+        //: 2 The specified allocator (or the default allocator) supplies
+        //:   memory.
+        //:
+        //: 3 The destructor releases all memory.
+        //
+        // Plan:
+        //: 1 Create objects using each constructor, with and without an
+        //:   allocator, and verify the values of the accessors, and which
+        //:   allocator supplies memory.  (C-1..2)
+        //:
+        //: 2 Allocate from each object, and verify that all memory is
+        //:   returned when it is destroyed.  (C-3)
+        //
+        // Testing:
+        //   ThreadCachingMultipoolAllocator(bslma::Allocator *ba = 0);
+        //   ThreadCachingMultipoolAllocator(int numPools, *ba = 0);
+        //   ThreadCachingMultipoolAllocator(int numPools, int batchSize, *ba);
+        //   ~ThreadCachingMultipoolAllocator();
+        //   int batchSize() const;
+        //   bsls::Types::size_type maxPooledBlockSize() const;
+        //   int numPools() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS AND ACCESSORS" << endl
+                          << "======================" << endl;
+
+        bslma::TestAllocator da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        for (char cfg = 'a'; cfg <= 'f'; ++cfg) {
+            const char CONFIG = cfg;
+
+            if (veryVerbose) { T_ P(CONFIG) }
+
+            bslma::TestAllocator sa("supplied", veryVeryVerbose);
+
+            Obj *objPtr = 0;
+            int  expNumPools  = 10;
+            int  expBatchSize = 32;
+
+            switch (CONFIG) {
+              case 'a': {
+                objPtr = new (sa) Obj();
+              } break;
+              case 'b': {
+                objPtr = new (sa) Obj(&sa);
+              } break;
+              case 'c': {
+                objPtr = new (sa) Obj(3);
+                expNumPools = 3;
+              } break;
+              case 'd': {
+                objPtr = new (sa) Obj(1, &sa);
+                expNumPools = 1;
+              } break;
+              case 'e': {
+                objPtr = new (sa) Obj(12, 1);
+                expNumPools  = 12;
+                expBatchSize = 1;
+              } break;
+              case 'f': {
+                objPtr = new (sa) Obj(4, 100, &sa);
+                expNumPools  = 4;
+                expBatchSize = 100;
+              } break;
+            }
+
+            Obj& mX = *objPtr;  const Obj& X = mX;
+
+            bslma::TestAllocator& oa = 'a' == CONFIG
+                                    || 'c' == CONFIG
+                                    || 'e' == CONFIG ? da : sa;
+
+            ASSERTV(CONFIG, expNumPools  == X.numPools());
+            ASSERTV(CONFIG, expBatchSize == X.batchSize());
+            ASSERTV(CONFIG, static_cast<bsls::Types::size_type>(
+                                                 8 << (expNumPools - 1)) ==
+                                                      X.maxPooledBlockSize());
+
+            const bsls::Types::Int64 numBlocks = oa.numBlocksInUse();
+
+            void *p = mX.allocate(X.maxPooledBlockSize());
+            void *q = mX.allocate(X.maxPooledBlockSize() + 1);
+
+            ASSERTV(CONFIG, numBlocks < oa.numBlocksInUse());
+
+            mX.deallocate(p);
+            mX.deallocate(q);
+
+            sa.deleteObject(objPtr);
+
+            ASSERTV(CONFIG, 0 == sa.numBlocksInUse());
+            ASSERTV(CONFIG, 0 == da.numBlocksInUse());
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic
+        //   functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate blocks of several sizes, in this thread
+        //:   and in another, and verify their contents.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERT(10   == X.numPools());
+            ASSERT(32   == X.batchSize());
+            ASSERT(4096 == X.maxPooledBlockSize());
+
+            char *p = static_cast<char *>(mX.allocate(5));
+            char *q = static_cast<char *>(mX.allocate(100));
+            char *r = static_cast<char *>(mX.allocate(10000));
+
+            ASSERT(p);  ASSERT(q);  ASSERT(r);
+            ASSERT(p != q);
+
+            bsl::strcpy(p, "abcd");
+            bsl::memset(q, 'q', 100);
+            bsl::memset(r, 'r', 10000);
+
+            ASSERT(0 == bsl::strcmp(p, "abcd"));
+            ASSERT(isFilled(q, 100, 'q'));
+            ASSERT(isFilled(r, 10000, 'r'));
+
+            mX.deallocate(q);
+            mX.deallocate(r);
+
+            ASSERT(q == mX.allocate(128));
+            mX.deallocate(q);
+
+            AllocateAndFreeArgs args = { &mX, 100, 50, false };
+
+            bslmt::ThreadUtil::Handle handle;
+            ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                  allocateAndFree,
+                                                  &args));
+            bslmt::ThreadUtil::join(handle);
+
+            mX.deallocate(p);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST: throughput vs. 'ConcurrentMultipoolAllocator'
+        //
+        // Concerns:
+        //: 1 The allocation throughput of the thread-caching allocator scales
+        //:   with the number of threads, unlike that of a
+        //:   'bdlma::ConcurrentMultipoolAllocator'.
+        //
+        // Plan:
+        //: 1 For an increasing number of threads, have each thread repeatedly
+        //:   allocate and deallocate bursts of small blocks from each
+        //:   allocator, and report the aggregate number of allocations per
+        //:   second.  The number of iterations per thread may be specified as
+        //:   the second argument.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE TEST: throughput vs. 'ConcurrentMultipoolAllocator'
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE TEST: throughput vs. "
+             << "'ConcurrentMultipoolAllocator'" << endl
+             << "================================="
+             << "==============================" << endl;
+
+        const int numIterations = argc > 2 ? atoi(argv[2]) : 100000;
+
+        cout << "threads  multipool (allocs/s)  thread-caching (allocs/s)"
+             << endl;
+
+        for (int numThreads = 1; numThreads <= 32; numThreads *= 2) {
+            double multipool, caching;
+            {
+                bdlma::ConcurrentMultipoolAllocator allocator;
+                multipool = u::measure(&allocator, numThreads, numIterations);
+            }
+            {
+                Obj allocator;
+                caching = u::measure(&allocator, numThreads, numIterations);
+            }
+
+            cout << "  " << numThreads
+                 << "\t\t" << multipool
+                 << "\t\t" << caching << endl;
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
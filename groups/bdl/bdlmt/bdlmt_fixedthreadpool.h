@@ -54,7 +54,10 @@ BSLS_IDENT("$Id: $")
 // (e.g., thread priority or stack size), by providing a
 // 'bslmt::ThreadAttributes' object with the desired values set.  See
 // 'bslmt_threadutil' package documentation for a description of
-// 'bslmt::ThreadAttributes'.
+// 'bslmt::ThreadAttributes'.  In particular, the 'cpuAffinity' and 'numaNode'
+// attributes pin every thread of the pool to the specified CPUs or NUMA node,
+// which keeps the caches of the threads warm and the memory they allocate
+// local to the CPUs that use it.
 //
 // Thread pools are ideal for developing multi-threaded server applications.  A
 // server need only package client requests to execute as jobs, and
@@ -30,6 +30,52 @@ BSLS_IDENT("$Id: $")
 // clients are able to tune the underlying thread pool in accordance with the
 // 'bdlmt::ThreadPool' documentation.
 //
+///Per-NUMA-Node Worker Groups
+///---------------------------
+// On a system having several NUMA nodes (typically, one per socket), a job
+// run on a node other than the one that produced its data pays for every
+// remote memory access, and a queue processed alternately by threads of
+// different nodes moves its working set back and forth between them.  Since
+// the jobs of a queue are processed by the threads of a single underlying
+// thread pool, confining a queue to a node amounts to confining the threads
+// of that pool.  A 'bdlmt::MultiQueueThreadPool' constructed with
+// 'bslmt::ThreadAttributes' whose 'numaNode' (or 'cpuAffinity') attribute is
+// set runs all of its queues on the CPUs of that node.
+//
+// To spread queues over all the nodes while keeping each queue on one node,
+// create one worker group per node -- a 'bdlmt::ThreadPool' whose threads are
+// bound to the node, and a 'bdlmt::MultiQueueThreadPool' sharing it -- and
+// create each queue in the group of the node where its data lives:
+//..
+//  const int numNodes = bslmt::ThreadUtil::numNumaNodes();
+//
+//  bsl::vector<bsl::shared_ptr<bdlmt::ThreadPool> >           pools;
+//  bsl::vector<bsl::shared_ptr<bdlmt::MultiQueueThreadPool> > groups;
+//
+//  for (int node = 0; node < numNodes; ++node) {
+//      bsl::vector<int> cpus;
+//      bslmt::ThreadUtil::numaNodeCpus(&cpus, node);
+//
+//      bslmt::ThreadAttributes attributes;
+//      attributes.setNumaNode(node);
+//
+//      const int numThreads = static_cast<int>(cpus.size());
+//
+//      pools.push_back(bsl::make_shared<bdlmt::ThreadPool>(attributes,
+//                                                          numThreads,
+//                                                          numThreads,
+//                                                          1000));
+//      pools.back()->start();
+//
+//      bdlmt::ThreadPool *pool = pools.back().get();
+//      groups.push_back(bsl::make_shared<bdlmt::MultiQueueThreadPool>(pool));
+//      groups.back()->start();
+//  }
+//..
+// Jobs enqueued to a queue created by 'groups[node]->createQueue()' are then
+// processed only by threads running on 'node'.  Note that the groups must be
+// stopped (and destroyed) before the thread pools they share.
+//
 ///Disabled Queues
 ///---------------
 // 'bdlmt::MultiQueueThreadPool' allows clients to disable and re-enable
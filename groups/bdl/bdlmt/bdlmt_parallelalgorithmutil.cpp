@@ -0,0 +1,224 @@
+// bdlmt_parallelalgorithmutil.cpp                                    -*-C++-*-
+#include <bdlmt_parallelalgorithmutil.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlmt_parallelalgorithmutil_cpp,"$Id$ $CSID$")
+
+///IMPLEMENTATION NOTES
+///--------------------
+// A task is counted in 'd_numUnfinishedTasks' when it is added, and is
+// destroyed *before* its completion is accounted for, so that no memory of
+// the group's allocator is in use by a task once 'wait' returns.  A helper
+// job started after 'wait' returned finds no task, and only releases its
+// reference to the group.
+//
+// 'd_numQueuedHelpers' is incremented under 'd_mutex' by the thread that
+// decides to enqueue a helper job, and the job is enqueued after releasing
+// the mutex, as 'enqueueJob' may block (e.g., on the full queue of a
+// 'bdlmt::FixedThreadPool').  A helper job that starts decrements the count,
+// so that a new helper job is enqueued as soon as tasks are left and no
+// helper job is waiting, allowing as many threads of the pool as there are
+// tasks to join the invocation one after the other.
+//
+// Only the thread in 'wait' blocks on 'd_condition', and it does so only
+// when no task is left to start and some tasks are running; it is signaled
+// when a task is added and when the last task completes.
+
+#include <bslmt_lockguard.h>
+
+#include <bsl_stdexcept.h>
+
+namespace BloombergLP {
+namespace bdlmt {
+
+                   // -------------------------------------
+                   // class ParallelAlgorithmUtil_TaskGroup
+                   // -------------------------------------
+
+// PRIVATE CLASS METHODS
+void ParallelAlgorithmUtil_TaskGroup::helperJob(
+                const bsl::shared_ptr<ParallelAlgorithmUtil_TaskGroup>& group)
+{
+    BSLS_ASSERT(group);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&group->d_mutex);
+
+    --group->d_numQueuedHelpers;
+
+    while (!group->d_tasks.empty()) {
+        Task task(bsl::allocator_arg, group->d_allocator_p);
+        task.swap(group->d_tasks.front());
+        group->d_tasks.pop_front();
+
+        bool enqueue = false;
+        if (!group->d_tasks.empty() && 0 == group->d_numQueuedHelpers) {
+            ++group->d_numQueuedHelpers;
+            enqueue = true;
+        }
+
+        bslmt::LockGuardUnlock<bslmt::Mutex> unlockGuard(&group->d_mutex);
+
+        if (enqueue) {
+            group->enqueueHelper();
+        }
+        group->executeTask(&task);
+    }
+}
+
+// PRIVATE MANIPULATORS
+void ParallelAlgorithmUtil_TaskGroup::addTask(Task *task)
+{
+    BSLS_ASSERT(task);
+
+    bool enqueue = false;
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        d_tasks.push_back(Task(bsl::allocator_arg, d_allocator_p));
+        d_tasks.back().swap(*task);
+        ++d_numUnfinishedTasks;
+
+        if (0 == d_numQueuedHelpers && !d_isCanceled) {
+            ++d_numQueuedHelpers;
+            enqueue = true;
+        }
+        d_condition.signal();
+    }
+
+    if (enqueue) {
+        enqueueHelper();
+    }
+}
+
+void ParallelAlgorithmUtil_TaskGroup::enqueueHelper()
+{
+    const Task job(bsl::allocator_arg,
+                   d_allocator_p,
+                   bdlf::BindUtil::bind(&helperJob, shared_from_this()));
+
+    if (0 != d_enqueue(d_pool_p, job)) {
+        // The tasks are executed by the thread in 'wait', or by other helper
+        // jobs.
+
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        --d_numQueuedHelpers;
+    }
+}
+
+void ParallelAlgorithmUtil_TaskGroup::executeTask(Task *task)
+{
+    BSLS_ASSERT(task);
+
+    bool isCanceled;
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        isCanceled = d_isCanceled;
+    }
+
+    if (!isCanceled) {
+        BSLS_TRY {
+            (*task)();
+        }
+        BSLS_CATCH(...) {
+            bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+            if (!d_isCanceled) {
+                d_isCanceled = true;
+#ifdef BSLS_LIBRARYFEATURES_HAS_CPP11_EXCEPTION_HANDLING
+                d_exception  = bsl::current_exception();
+#endif
+            }
+        }
+    }
+
+    // Release the memory of the task before its completion is accounted for.
+
+    Task(bsl::allocator_arg, d_allocator_p).swap(*task);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+    if (0 == --d_numUnfinishedTasks) {
+        d_condition.signal();
+    }
+}
+
+// CREATORS
+ParallelAlgorithmUtil_TaskGroup::ParallelAlgorithmUtil_TaskGroup(
+                                              void             *pool,
+                                              EnqueueFunction   enqueue,
+                                              bslma::Allocator *basicAllocator)
+: d_mutex()
+, d_condition()
+, d_tasks(basicAllocator)
+, d_numUnfinishedTasks(0)
+, d_numQueuedHelpers(0)
+, d_isCanceled(false)
+#ifdef BSLS_LIBRARYFEATURES_HAS_CPP11_EXCEPTION_HANDLING
+, d_exception()
+#endif
+, d_pool_p(pool)
+, d_enqueue(enqueue)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(pool);
+    BSLS_ASSERT(enqueue);
+}
+
+ParallelAlgorithmUtil_TaskGroup::~ParallelAlgorithmUtil_TaskGroup()
+{
+    BSLS_ASSERT(0 == d_numUnfinishedTasks);
+    BSLS_ASSERT(d_tasks.empty());
+}
+
+// MANIPULATORS
+void ParallelAlgorithmUtil_TaskGroup::wait()
+{
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        while (0 < d_numUnfinishedTasks) {
+            if (d_tasks.empty()) {
+                d_condition.wait(&d_mutex);
+                continue;
+            }
+
+            Task task(bsl::allocator_arg, d_allocator_p);
+            task.swap(d_tasks.front());
+            d_tasks.pop_front();
+
+            bslmt::LockGuardUnlock<bslmt::Mutex> unlockGuard(&d_mutex);
+
+            executeTask(&task);
+        }
+    }
+
+    // No task is running, so that 'd_isCanceled' and 'd_exception' are no
+    // longer modified.
+
+    if (d_isCanceled) {
+#ifdef BSLS_LIBRARYFEATURES_HAS_CPP11_EXCEPTION_HANDLING
+        bsl::rethrow_exception(d_exception);
+#else
+        BSLS_THROW(bsl::runtime_error(
+                    "bdlmt::ParallelAlgorithmUtil: exception thrown by task"));
+#endif
+    }
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License.  You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
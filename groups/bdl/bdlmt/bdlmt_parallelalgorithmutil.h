@@ -0,0 +1,1037 @@
+// bdlmt_parallelalgorithmutil.h                                      -*-C++-*-
+#ifndef INCLUDED_BDLMT_PARALLELALGORITHMUTIL
+#define INCLUDED_BDLMT_PARALLELALGORITHMUTIL
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide parallel 'forEach', 'transform', 'reduce', and 'sort'.
+//
+//@CLASSES:
+//  bdlmt::ParallelAlgorithmUtil: namespace for parallel algorithms
+//  bdlmt::ParallelAlgorithmUtil_TaskGroup: group of tasks shared by threads
+//
+//@SEE_ALSO: bdlmt_fixedthreadpool, bdlmt_threadpool,
+//           bdlmt_workstealingthreadpool
+//
+//@DESCRIPTION: This component provides a utility 'struct',
+// 'bdlmt::ParallelAlgorithmUtil', containing function templates that apply an
+// algorithm to a range of random-access iterators (e.g., the elements of a
+// 'bsl::vector'), using the threads of a supplied thread pool in addition to
+// the calling thread:
+//..
+//  Algorithm   Description
+//  ---------   ----------------------------------------------------------
+//  forEach     invoke a function on each element of a range
+//
+//  transform   store the result of a function applied to each element of
+//              a range into an output range
+//
+//  reduce      combine the elements of a range with an associative binary
+//              operation
+//
+//  sort        sort the elements of a range
+//..
+// The thread pool is specified by a pointer to any type, 'POOL', providing a
+// method that can be invoked as follows, and returning 0 on success:
+//..
+//  int rc = pool->enqueueJob(bsl::function<void()>(job));
+//..
+// such as 'bdlmt::FixedThreadPool', 'bdlmt::ThreadPool', and
+// 'bdlmt::WorkStealingThreadPool'.  The pool must be started, and may be
+// shared with other (unrelated) jobs.
+//
+///Splitting the Work
+///------------------
+// An algorithm divides its range into *chunks* of 'grainSize' consecutive
+// elements (the last chunk possibly being smaller), where 'grainSize' is an
+// optional argument of each algorithm.  The processing of all the chunks is a
+// single task, which splits itself recursively: a task processing more than
+// one chunk hands one half of its chunks to a new task, and continues with
+// the other half, until it is left with a single chunk, which it processes
+// sequentially.  'sort' splits its range recursively as well, by partitioning
+// it around a pivot element (as in quicksort), until the parts have no more
+// than 'grainSize' elements, which are then sorted sequentially.
+//
+// The grain size controls the trade-off between the overhead of the tasks
+// and the balance of the work among the threads: a chunk should take long
+// enough to process (e.g., a few tens of microseconds) for the overhead of a
+// task (an allocation, and a mutex lock) to be negligible, while there should
+// be enough chunks for all the threads to be kept busy.  If 'grainSize' is 0
+// (the default), the grain size is chosen so that the range is divided into
+// about 'k_DEFAULT_NUM_CHUNKS' chunks.
+//
+///Execution Model
+///---------------
+// The tasks of an invocation are held in a 'ParallelAlgorithmUtil_TaskGroup'
+// shared by the calling thread and by *helper* jobs enqueued on the pool.  A
+// helper job executes the tasks of the group until there are none left, and
+// then returns; a new helper job is enqueued whenever tasks are created while
+// no helper job of the group is waiting to be started, so that the number of
+// threads working on an invocation grows as the threads of the pool become
+// available, while at most one job of an invocation waits in the queue of
+// the pool at any time.
+//
+// The calling thread executes tasks of the group as well, and returns once
+// all the tasks of the group have completed, without waiting for the helper
+// jobs that have not started.  As a consequence, an algorithm completes even
+// if the threads of the pool are all busy (including when the algorithm is
+// invoked from a job of the pool), or if the pool fails to enqueue the
+// helper jobs (in which case the algorithm runs sequentially).
+//
+// Note that the functions supplied to an algorithm are invoked concurrently
+// from several threads, and must therefore be safe to invoke concurrently on
+// distinct elements.
+//
+///Exceptions
+///----------
+// If a supplied function throws an exception, the tasks of the invocation
+// that have not started are discarded, the algorithm waits for the tasks
+// that are running to complete, and then rethrows the first exception thrown
+// into the calling thread.  The elements of the range are then in a valid
+// but unspecified state.  On platforms lacking 'bsl::exception_ptr', an
+// exception thrown by a supplied function cannot be transported from one
+// thread to another, and is reported by throwing a 'bsl::runtime_error'
+// instead.
+//
+///Memory Allocation
+///-----------------
+// Each algorithm takes an optional 'basicAllocator' argument used to supply
+// memory for the shared state of the invocation and for its tasks.  Since a
+// helper job that has not started when the algorithm returns refers to the
+// shared state, which it releases when it eventually runs, the allocator must
+// remain valid until the pool has executed all the jobs enqueued before the
+// algorithm returned (e.g., until the pool is drained or stopped).  The
+// default allocator, which is used if 'basicAllocator' is 0, satisfies this
+// requirement.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Processing a Vector in Parallel
+///- - - - - - - - - - - - - - - - - - - - -
+// In this example, we square the elements of a vector, sum the squares, and
+// sort them, all in parallel on the threads of a 'bdlmt::FixedThreadPool'.
+//
+// First, we define the functors to be applied to the elements:
+//..
+//  struct Square {
+//      // This 'struct' defines a functor returning the square of its
+//      // argument.
+//
+//      int operator()(int value) const
+//          // Return the square of the specified 'value'.
+//      {
+//          return value * value;
+//      }
+//  };
+//
+//  struct Add {
+//      // This 'struct' defines a functor returning the sum of its arguments.
+//
+//      bsls::Types::Int64 operator()(bsls::Types::Int64 lhs,
+//                                    bsls::Types::Int64 rhs) const
+//          // Return the sum of the specified 'lhs' and 'rhs'.
+//      {
+//          return lhs + rhs;
+//      }
+//  };
+//..
+// Then, we create and start a pool of four threads:
+//..
+//  bdlmt::FixedThreadPool pool(4, 1000);
+//  int rc = pool.start();
+//  assert(0 == rc);
+//..
+// Next, we create a vector of values in decreasing order:
+//..
+//  bsl::vector<int> values(10000);
+//  for (int i = 0; i < static_cast<int>(values.size()); ++i) {
+//      values[i] = static_cast<int>(values.size()) - i;
+//  }
+//..
+// Then, we replace each value by its square, in chunks of 100 elements:
+//..
+//  bdlmt::ParallelAlgorithmUtil::transform(&pool,
+//                                          values.begin(),
+//                                          values.end(),
+//                                          values.begin(),
+//                                          Square(),
+//                                          100);
+//  assert(100 * 100 == values[10000 - 100]);
+//..
+// Next, we sum the squares, using the default grain size:
+//..
+//  bsls::Types::Int64 sum = bdlmt::ParallelAlgorithmUtil::reduce(
+//                                                      &pool,
+//                                                      values.begin(),
+//                                                      values.end(),
+//                                                      bsls::Types::Int64(0),
+//                                                      Add());
+//..
+// Then, we verify the sum, using the formula for the sum of the first 'n'
+// squares, 'n * (n + 1) * (2 * n + 1) / 6':
+//..
+//  const bsls::Types::Int64 n = 10000;
+//  assert(n * (n + 1) * (2 * n + 1) / 6 == sum);
+//..
+// Now, we sort the squares in increasing order:
+//..
+//  bdlmt::ParallelAlgorithmUtil::sort(&pool, values.begin(), values.end());
+//..
+// Finally, we verify the order, and stop the pool:
+//..
+//  for (int i = 0; i < static_cast<int>(values.size()); ++i) {
+//      assert((i + 1) * (i + 1) == values[i]);
+//  }
+//
+//  pool.stop();
+//..
+
+#include <bdlscm_version.h>
+
+#include <bdlf_bind.h>
+
+#include <bslma_allocator.h>
+#include <bslma_default.h>
+
+#include <bslmt_condition.h>
+#include <bslmt_mutex.h>
+
+#include <bsls_assert.h>
+#include <bsls_libraryfeatures.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstddef.h>
+#include <bsl_deque.h>
+#include <bsl_exception.h>
+#include <bsl_functional.h>
+#include <bsl_iterator.h>
+#include <bsl_memory.h>
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace bdlmt {
+
+                   // =====================================
+                   // class ParallelAlgorithmUtil_TaskGroup
+                   // =====================================
+
+class ParallelAlgorithmUtil_TaskGroup
+: public bsl::enable_shared_from_this<ParallelAlgorithmUtil_TaskGroup> {
+    // This class implements a group of tasks, executed by the thread waiting
+    // for the group and by helper jobs enqueued on a thread pool.  Tasks may
+    // add further tasks to their group.  Objects of this class must be owned
+    // by a 'bsl::shared_ptr', as the helper jobs share the ownership of their
+    // group.
+
+  public:
+    // TYPES
+    typedef bsl::function<void()> Task;
+
+    typedef int (*EnqueueFunction)(void *pool, const Task& job);
+        // Type of a function enqueuing the specified 'job' on the specified
+        // 'pool', and returning 0 on success, and a non-zero value otherwise.
+
+  private:
+    // DATA
+    mutable bslmt::Mutex  d_mutex;          // guards the data below
+
+    bslmt::Condition      d_condition;      // signaled when a task is added,
+                                            // or when the last task completes
+
+    bsl::deque<Task>      d_tasks;          // tasks not yet started, oldest
+                                            // (and largest) first
+
+    int                   d_numUnfinishedTasks;
+                                            // number of tasks added and not
+                                            // yet completed
+
+    int                   d_numQueuedHelpers;
+                                            // number of helper jobs enqueued
+                                            // and not yet started
+
+    bool                  d_isCanceled;     // 'true' once a task threw
+
+#ifdef BSLS_LIBRARYFEATURES_HAS_CPP11_EXCEPTION_HANDLING
+    bsl::exception_ptr    d_exception;      // first exception thrown by a
+                                            // task
+#endif
+
+    void                 *d_pool_p;         // pool on which the helper jobs
+                                            // are enqueued (held, not owned)
+
+    EnqueueFunction       d_enqueue;        // function enqueuing on 'd_pool_p'
+
+    bslma::Allocator     *d_allocator_p;    // memory allocator (held, not
+                                            // owned)
+
+    // NOT IMPLEMENTED
+    ParallelAlgorithmUtil_TaskGroup(const ParallelAlgorithmUtil_TaskGroup&);
+    ParallelAlgorithmUtil_TaskGroup& operator=(
+                                       const ParallelAlgorithmUtil_TaskGroup&);
+
+    // PRIVATE CLASS METHODS
+    static void helperJob(
+                const bsl::shared_ptr<ParallelAlgorithmUtil_TaskGroup>& group);
+        // Execute the tasks of the specified 'group' until it has none left.
+
+    // PRIVATE MANIPULATORS
+    void addTask(Task *task);
+        // Add the specified 'task' to this group, leaving 'task' empty, and
+        // enqueue a helper job if none is waiting to be started.
+
+    void enqueueHelper();
+        // Enqueue a helper job of this group on the pool, and account for the
+        // failure to do so.  The behavior is undefined unless the caller has
+        // already counted the job in 'd_numQueuedHelpers', and does not hold
+        // 'd_mutex'.
+
+    void executeTask(Task *task);
+        // Invoke the specified 'task' unless this group has been canceled,
+        // record the exception it throws, if any, destroy it, and account for
+        // its completion.  The behavior is undefined if the caller holds
+        // 'd_mutex'.
+
+  public:
+    // CREATORS
+    ParallelAlgorithmUtil_TaskGroup(void             *pool,
+                                    EnqueueFunction   enqueue,
+                                    bslma::Allocator *basicAllocator = 0);
+        // Create an empty group of tasks whose helper jobs are enqueued on the
+        // specified 'pool' using the specified 'enqueue' function.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.
+
+    ~ParallelAlgorithmUtil_TaskGroup();
+        // Destroy this object.
+
+    // MANIPULATORS
+    template <class FUNCTION>
+    void run(const FUNCTION& function);
+        // Add to this group a task invoking the specified 'function', to be
+        // executed by the thread waiting for this group or by a helper job.
+        // The behavior is undefined unless this object is owned by a
+        // 'bsl::shared_ptr', and 'wait' has not returned.
+
+    void wait();
+        // Execute the tasks of this group until all of them have completed.
+        // If a task threw an exception, rethrow the first exception thrown.
+        // The behavior is undefined unless this method is invoked at most
+        // once, by a thread that is not executing a task of this group.
+
+    // ACCESSORS
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this object to supply memory.
+};
+
+                    // ===================================
+                    // struct ParallelAlgorithmUtil_Enqueue
+                    // ===================================
+
+template <class POOL>
+struct ParallelAlgorithmUtil_Enqueue {
+    // This 'struct' provides a function enqueuing a job on a pool of type
+    // 'POOL', for use as a 'ParallelAlgorithmUtil_TaskGroup::EnqueueFunction'.
+
+    // CLASS METHODS
+    static int enqueue(void                                         *pool,
+                       const ParallelAlgorithmUtil_TaskGroup::Task&  job);
+        // Enqueue the specified 'job' on the specified 'pool', which must be
+        // a 'POOL', and return the value returned by its 'enqueueJob' method.
+};
+
+                   // =====================================
+                   // struct ParallelAlgorithmUtil_ChunkTask
+                   // =====================================
+
+template <class CHUNK_FUNCTION>
+struct ParallelAlgorithmUtil_ChunkTask {
+    // This 'struct' provides a task invoking a function on a range of chunk
+    // indices, splitting the range recursively.
+
+    // CLASS METHODS
+    static void run(ParallelAlgorithmUtil_TaskGroup *group,
+                    const CHUNK_FUNCTION            *function,
+                    bsl::size_t                      firstChunk,
+                    bsl::size_t                      lastChunk);
+        // Invoke the specified 'function' on each chunk index in the range
+        // '[firstChunk, lastChunk)', handing halves of the range to new tasks
+        // of the specified 'group' until a single chunk index is left.  The
+        // behavior is undefined unless 'firstChunk < lastChunk'.
+};
+
+                    // ====================================
+                    // struct ParallelAlgorithmUtil_SortTask
+                    // ====================================
+
+template <class RANDOM_ACCESS_ITERATOR, class COMPARATOR>
+struct ParallelAlgorithmUtil_SortTask {
+    // This 'struct' provides a task sorting a range, partitioning the range
+    // recursively.
+
+  private:
+    // PRIVATE TYPES
+    typedef typename bsl::iterator_traits<RANDOM_ACCESS_ITERATOR>::value_type
+                                                                    ValueType;
+
+    struct IsLess {
+        // This 'struct' defines a predicate returning 'true' for the elements
+        // ordered before a pivot.
+
+        // DATA
+        const COMPARATOR *d_comparator_p;  // ordering of the elements
+        const ValueType  *d_pivot_p;       // pivot element
+
+        // ACCESSORS
+        bool operator()(const ValueType& value) const
+            // Return 'true' if the specified 'value' is ordered before the
+            // pivot, and 'false' otherwise.
+        {
+            return (*d_comparator_p)(value, *d_pivot_p);
+        }
+    };
+
+    struct IsNotGreater {
+        // This 'struct' defines a predicate returning 'true' for the elements
+        // not ordered after a pivot.
+
+        // DATA
+        const COMPARATOR *d_comparator_p;  // ordering of the elements
+        const ValueType  *d_pivot_p;       // pivot element
+
+        // ACCESSORS
+        bool operator()(const ValueType& value) const
+            // Return 'true' if the specified 'value' is not ordered after the
+            // pivot, and 'false' otherwise.
+        {
+            return !(*d_comparator_p)(*d_pivot_p, value);
+        }
+    };
+
+  public:
+    // CLASS METHODS
+    static void run(ParallelAlgorithmUtil_TaskGroup *group,
+                    RANDOM_ACCESS_ITERATOR           first,
+                    RANDOM_ACCESS_ITERATOR           last,
+                    const COMPARATOR                *comparator,
+                    bsl::size_t                      grainSize);
+        // Sort the elements in the specified range '[first, last)' according
+        // to the specified 'comparator', partitioning the range, and handing
+        // parts of it to new tasks of the specified 'group', until the parts
+        // have no more than the specified 'grainSize' elements.
+};
+
+                         // ============================
+                         // struct ParallelAlgorithmUtil
+                         // ============================
+
+struct ParallelAlgorithmUtil {
+    // This 'struct' provides a namespace for algorithms applied to ranges of
+    // random-access iterators using the threads of a thread pool.
+
+  private:
+    // PRIVATE TYPES
+    template <class RANDOM_ACCESS_ITERATOR, class FUNCTION>
+    struct ForEachChunk;
+    template <class INPUT_ITERATOR, class OUTPUT_ITERATOR, class FUNCTION>
+    struct TransformChunk;
+    template <class RANDOM_ACCESS_ITERATOR, class TYPE, class BINARY_OPERATION>
+    struct ReduceChunk;
+        // Functors applying an algorithm to one chunk of a range.
+
+    // PRIVATE CLASS METHODS
+    static bsl::size_t chooseGrainSize(bsl::size_t length,
+                                       bsl::size_t grainSize);
+        // Return the specified 'grainSize' if it is positive, and otherwise a
+        // positive grain size dividing a range of the specified 'length' into
+        // at most 'k_DEFAULT_NUM_CHUNKS' chunks.
+
+    template <class POOL, class CHUNK_FUNCTION>
+    static void runChunks(POOL                  *pool,
+                          bsl::size_t            numChunks,
+                          const CHUNK_FUNCTION&  function,
+                          bslma::Allocator      *basicAllocator);
+        // Invoke the specified 'function' on each chunk index in the range
+        // '[0, numChunks)', using the threads of the specified 'pool' and the
+        // specified 'basicAllocator'.
+
+  public:
+    // CONSTANTS
+    enum {
+        k_DEFAULT_NUM_CHUNKS = 256  // number of chunks of a range when the
+                                    // grain size is not specified
+    };
+
+    // CLASS METHODS
+    template <class POOL, class RANDOM_ACCESS_ITERATOR, class FUNCTION>
+    static void forEach(POOL                   *pool,
+                        RANDOM_ACCESS_ITERATOR  first,
+                        RANDOM_ACCESS_ITERATOR  last,
+                        const FUNCTION&         function,
+                        bsl::size_t             grainSize = 0,
+                        bslma::Allocator       *basicAllocator = 0);
+        // Invoke the specified 'function' on each element in the specified
+        // range '[first, last)', using the threads of the specified 'pool' in
+        // addition to the calling thread.  Optionally specify a 'grainSize',
+        // the number of consecutive elements processed sequentially by a
+        // task; if 'grainSize' is 0, a grain size is chosen based on the
+        // length of the range.  Optionally specify a 'basicAllocator' used to
+        // supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.  If 'function' throws, rethrow the first
+        // exception thrown, after the invocations that have started have
+        // completed.  The behavior is undefined unless 'function' can be
+        // invoked concurrently on distinct elements of the range.  See
+        // {Memory Allocation} for the requirement on the lifetime of
+        // 'basicAllocator'.
+
+    template <class POOL,
+              class RANDOM_ACCESS_ITERATOR,
+              class OUTPUT_ITERATOR,
+              class FUNCTION>
+    static OUTPUT_ITERATOR transform(
+                                 POOL                   *pool,
+                                 RANDOM_ACCESS_ITERATOR  first,
+                                 RANDOM_ACCESS_ITERATOR  last,
+                                 OUTPUT_ITERATOR         result,
+                                 const FUNCTION&         function,
+                                 bsl::size_t             grainSize = 0,
+                                 bslma::Allocator       *basicAllocator = 0);
+        // Assign the result of the specified 'function' invoked on each
+        // element in the specified range '[first, last)' to the element at
+        // the same position in the range starting at the specified 'result',
+        // using the threads of the specified 'pool' in addition to the
+        // calling thread, and return an iterator past the last element
+        // assigned.  Optionally specify a 'grainSize', the number of
+        // consecutive elements processed sequentially by a task; if
+        // 'grainSize' is 0, a grain size is chosen based on the length of the
+        // range.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  If 'function' throws, rethrow the first
+        // exception thrown, after the invocations that have started have
+        // completed.  The behavior is undefined unless 'OUTPUT_ITERATOR' is a
+        // random-access iterator, the output range does not overlap the input
+        // range except by being identical to it, and 'function' can be
+        // invoked concurrently on distinct elements of the range.  See
+        // {Memory Allocation} for the requirement on the lifetime of
+        // 'basicAllocator'.
+
+    template <class POOL,
+              class RANDOM_ACCESS_ITERATOR,
+              class TYPE,
+              class BINARY_OPERATION>
+    static TYPE reduce(POOL                    *pool,
+                       RANDOM_ACCESS_ITERATOR   first,
+                       RANDOM_ACCESS_ITERATOR   last,
+                       const TYPE&              initialValue,
+                       const BINARY_OPERATION&  operation,
+                       bsl::size_t              grainSize = 0,
+                       bslma::Allocator        *basicAllocator = 0);
+        // Return the combination, using the specified binary 'operation', of
+        // the specified 'initialValue' and of the elements in the specified
+        // range '[first, last)', using the threads of the specified 'pool' in
+        // addition to the calling thread.  Optionally specify a 'grainSize',
+        // the number of consecutive elements combined sequentially by a task;
+        // if 'grainSize' is 0, a grain size is chosen based on the length of
+        // the range.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  If 'operation' throws, rethrow the first
+        // exception thrown, after the invocations that have started have
+        // completed.  The elements of each chunk are combined from left to
+        // right, and the results of the chunks are then combined, from left
+        // to right, with 'initialValue', so that, for a given grain size, the
+        // result does not depend on the scheduling of the tasks.  The
+        // behavior is undefined unless 'operation' is associative, and can be
+        // invoked concurrently.  See {Memory Allocation} for the requirement
+        // on the lifetime of 'basicAllocator'.
+
+    template <class POOL, class RANDOM_ACCESS_ITERATOR>
+    static void sort(POOL                   *pool,
+                     RANDOM_ACCESS_ITERATOR  first,
+                     RANDOM_ACCESS_ITERATOR  last);
+    template <class POOL, class RANDOM_ACCESS_ITERATOR, class COMPARATOR>
+    static void sort(POOL                   *pool,
+                     RANDOM_ACCESS_ITERATOR  first,
+                     RANDOM_ACCESS_ITERATOR  last,
+                     const COMPARATOR&       comparator,
+                     bsl::size_t             grainSize = 0,
+                     bslma::Allocator       *basicAllocator = 0);
+        // Sort the elements in the specified range '[first, last)' in
+        // non-decreasing order according to the optionally specified
+        // 'comparator', or to 'operator<' if 'comparator' is not specified,
+        // using the threads of the specified 'pool' in addition to the
+        // calling thread.  Optionally specify a 'grainSize', the number of
+        // elements below which a part of the range is sorted sequentially; if
+        // 'grainSize' is 0, a grain size is chosen based on the length of the
+        // range.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  If 'comparator' throws, rethrow the first
+        // exception thrown, after the parts of the range being processed have
+        // been processed.  The sort is not stable.  The behavior is undefined
+        // unless 'comparator' defines a strict weak ordering, and can be
+        // invoked concurrently.  See {Memory Allocation} for the requirement
+        // on the lifetime of 'basicAllocator'.
+};
+
+                    // =========================================
+                    // struct ParallelAlgorithmUtil::ForEachChunk
+                    // =========================================
+
+template <class RANDOM_ACCESS_ITERATOR, class FUNCTION>
+struct ParallelAlgorithmUtil::ForEachChunk {
+    // This 'struct' defines a functor invoking a function on each element of
+    // a chunk of a range.
+
+    // DATA
+    RANDOM_ACCESS_ITERATOR  d_first;       // beginning of the range
+    bsl::size_t             d_length;      // length of the range
+    bsl::size_t             d_grainSize;   // length of a chunk
+    const FUNCTION         *d_function_p;  // function to invoke
+
+    // ACCESSORS
+    void operator()(bsl::size_t chunk) const
+        // Invoke the function on each element of the specified 'chunk'.
+    {
+        const bsl::size_t begin = chunk * d_grainSize;
+        const bsl::size_t end   = bsl::min(begin + d_grainSize, d_length);
+
+        RANDOM_ACCESS_ITERATOR       it  = d_first + begin;
+        const RANDOM_ACCESS_ITERATOR itE = d_first + end;
+        for (; it != itE; ++it) {
+            (*d_function_p)(*it);
+        }
+    }
+};
+
+                   // ===========================================
+                   // struct ParallelAlgorithmUtil::TransformChunk
+                   // ===========================================
+
+template <class INPUT_ITERATOR, class OUTPUT_ITERATOR, class FUNCTION>
+struct ParallelAlgorithmUtil::TransformChunk {
+    // This 'struct' defines a functor assigning the result of a function
+    // invoked on each element of a chunk of a range to an output range.
+
+    // DATA
+    INPUT_ITERATOR   d_first;       // beginning of the input range
+    OUTPUT_ITERATOR  d_result;      // beginning of the output range
+    bsl::size_t      d_length;      // length of the ranges
+    bsl::size_t      d_grainSize;   // length of a chunk
+    const FUNCTION  *d_function_p;  // function to invoke
+
+    // ACCESSORS
+    void operator()(bsl::size_t chunk) const
+        // Assign the result of the function invoked on each element of the
+        // specified 'chunk' of the input range to the output range.
+    {
+        const bsl::size_t begin = chunk * d_grainSize;
+        const bsl::size_t end   = bsl::min(begin + d_grainSize, d_length);
+
+        INPUT_ITERATOR       it     = d_first + begin;
+        const INPUT_ITERATOR itE    = d_first + end;
+        OUTPUT_ITERATOR      output = d_result + begin;
+        for (; it != itE; ++it, ++output) {
+            *output = (*d_function_p)(*it);
+        }
+    }
+};
+
+                    // ========================================
+                    // struct ParallelAlgorithmUtil::ReduceChunk
+                    // ========================================
+
+template <class RANDOM_ACCESS_ITERATOR, class TYPE, class BINARY_OPERATION>
+struct ParallelAlgorithmUtil::ReduceChunk {
+    // This 'struct' defines a functor combining the elements of a chunk of a
+    // range, and storing the result at the index of the chunk.
+
+    // DATA
+    RANDOM_ACCESS_ITERATOR   d_first;        // beginning of the range
+    bsl::size_t              d_length;       // length of the range
+    bsl::size_t              d_grainSize;    // length of a chunk
+    const BINARY_OPERATION  *d_operation_p;  // operation to apply
+    bsl::vector<TYPE>       *d_results_p;    // result of each chunk
+
+    // ACCESSORS
+    void operator()(bsl::size_t chunk) const
+        // Combine the elements of the specified 'chunk', and store the result
+        // at index 'chunk' of the results.
+    {
+        const bsl::size_t begin = chunk * d_grainSize;
+        const bsl::size_t end   = bsl::min(begin + d_grainSize, d_length);
+
+        RANDOM_ACCESS_ITERATOR       it     = d_first + begin;
+        const RANDOM_ACCESS_ITERATOR itE    = d_first + end;
+        TYPE&                        result = (*d_results_p)[chunk];
+
+        result = *it;
+        for (++it; it != itE; ++it) {
+            result = (*d_operation_p)(result, *it);
+        }
+    }
+};
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                   // -------------------------------------
+                   // class ParallelAlgorithmUtil_TaskGroup
+                   // -------------------------------------
+
+// MANIPULATORS
+template <class FUNCTION>
+inline
+void ParallelAlgorithmUtil_TaskGroup::run(const FUNCTION& function)
+{
+    Task task(bsl::allocator_arg, d_allocator_p, function);
+    addTask(&task);
+}
+
+// ACCESSORS
+inline
+bslma::Allocator *ParallelAlgorithmUtil_TaskGroup::allocator() const
+{
+    return d_allocator_p;
+}
+
+                    // -----------------------------------
+                    // struct ParallelAlgorithmUtil_Enqueue
+                    // -----------------------------------
+
+// CLASS METHODS
+template <class POOL>
+inline
+int ParallelAlgorithmUtil_Enqueue<POOL>::enqueue(
+                           void                                         *pool,
+                           const ParallelAlgorithmUtil_TaskGroup::Task&  job)
+{
+    BSLS_ASSERT(pool);
+
+    return static_cast<POOL *>(pool)->enqueueJob(job);
+}
+
+                   // -------------------------------------
+                   // struct ParallelAlgorithmUtil_ChunkTask
+                   // -------------------------------------
+
+// CLASS METHODS
+template <class CHUNK_FUNCTION>
+void ParallelAlgorithmUtil_ChunkTask<CHUNK_FUNCTION>::run(
+                                   ParallelAlgorithmUtil_TaskGroup *group,
+                                   const CHUNK_FUNCTION            *function,
+                                   bsl::size_t                      firstChunk,
+                                   bsl::size_t                      lastChunk)
+{
+    BSLS_ASSERT(group);
+    BSLS_ASSERT(function);
+    BSLS_ASSERT(firstChunk < lastChunk);
+
+    while (lastChunk - firstChunk > 1) {
+        const bsl::size_t middle = firstChunk + (lastChunk - firstChunk) / 2;
+
+        group->run(bdlf::BindUtil::bind(&run,
+                                        group,
+                                        function,
+                                        middle,
+                                        lastChunk));
+        lastChunk = middle;
+    }
+
+    (*function)(firstChunk);
+}
+
+                    // ------------------------------------
+                    // struct ParallelAlgorithmUtil_SortTask
+                    // ------------------------------------
+
+// CLASS METHODS
+template <class RANDOM_ACCESS_ITERATOR, class COMPARATOR>
+void ParallelAlgorithmUtil_SortTask<RANDOM_ACCESS_ITERATOR, COMPARATOR>::run(
+                                  ParallelAlgorithmUtil_TaskGroup *group,
+                                  RANDOM_ACCESS_ITERATOR           first,
+                                  RANDOM_ACCESS_ITERATOR           last,
+                                  const COMPARATOR                *comparator,
+                                  bsl::size_t                      grainSize)
+{
+    BSLS_ASSERT(group);
+    BSLS_ASSERT(comparator);
+    BSLS_ASSERT(0 < grainSize);
+
+    while (static_cast<bsl::size_t>(last - first) > grainSize) {
+        // Choose the median of the first, middle, and last elements as the
+        // pivot, and partition the range into the elements less than, equal
+        // to, and greater than the pivot.  The middle part contains at least
+        // the pivot, so that both outer parts are smaller than the range.
+
+        RANDOM_ACCESS_ITERATOR a = first;
+        RANDOM_ACCESS_ITERATOR b = first + (last - first) / 2;
+        RANDOM_ACCESS_ITERATOR c = last - 1;
+
+        if ((*comparator)(*b, *a)) {
+            bsl::swap(a, b);
+        }
+        if ((*comparator)(*c, *b)) {
+            b = (*comparator)(*c, *a) ? a : c;
+        }
+
+        const ValueType pivot(*b);
+
+        const IsLess       isLess       = { comparator, &pivot };
+        const IsNotGreater isNotGreater = { comparator, &pivot };
+
+        RANDOM_ACCESS_ITERATOR lower = bsl::partition(first, last, isLess);
+        RANDOM_ACCESS_ITERATOR upper = bsl::partition(lower,
+                                                      last,
+                                                      isNotGreater);
+
+        // Hand the larger part to a new task, and continue with the smaller
+        // part.
+
+        if (lower - first < last - upper) {
+            group->run(bdlf::BindUtil::bind(&run,
+                                            group,
+                                            upper,
+                                            last,
+                                            comparator,
+                                            grainSize));
+            last = lower;
+        }
+        else {
+            group->run(bdlf::BindUtil::bind(&run,
+                                            group,
+                                            first,
+                                            lower,
+                                            comparator,
+                                            grainSize));
+            first = upper;
+        }
+    }
+
+    bsl::sort(first, last, *comparator);
+}
+
+                         // ----------------------------
+                         // struct ParallelAlgorithmUtil
+                         // ----------------------------
+
+// PRIVATE CLASS METHODS
+inline
+bsl::size_t ParallelAlgorithmUtil::chooseGrainSize(bsl::size_t length,
+                                                   bsl::size_t grainSize)
+{
+    if (0 < grainSize) {
+        return grainSize;                                             // RETURN
+    }
+
+    const bsl::size_t numChunks = k_DEFAULT_NUM_CHUNKS;
+
+    return bsl::max<bsl::size_t>((length + numChunks - 1) / numChunks, 1);
+}
+
+template <class POOL, class CHUNK_FUNCTION>
+void ParallelAlgorithmUtil::runChunks(POOL                  *pool,
+                                      bsl::size_t            numChunks,
+                                      const CHUNK_FUNCTION&  function,
+                                      bslma::Allocator      *basicAllocator)
+{
+    BSLS_ASSERT(pool);
+
+    if (0 == numChunks) {
+        return;                                                       // RETURN
+    }
+
+    if (1 == numChunks) {
+        function(0);
+        return;                                                       // RETURN
+    }
+
+    basicAllocator = bslma::Default::allocator(basicAllocator);
+
+    bsl::shared_ptr<ParallelAlgorithmUtil_TaskGroup> group =
+                      bsl::allocate_shared<ParallelAlgorithmUtil_TaskGroup>(
+                               basicAllocator,
+                               static_cast<void *>(pool),
+                               &ParallelAlgorithmUtil_Enqueue<POOL>::enqueue,
+                               basicAllocator);
+
+    group->run(bdlf::BindUtil::bind(
+                         &ParallelAlgorithmUtil_ChunkTask<CHUNK_FUNCTION>::run,
+                         group.get(),
+                         &function,
+                         bsl::size_t(0),
+                         numChunks));
+    group->wait();
+}
+
+// CLASS METHODS
+template <class POOL, class RANDOM_ACCESS_ITERATOR, class FUNCTION>
+void ParallelAlgorithmUtil::forEach(POOL                   *pool,
+                                    RANDOM_ACCESS_ITERATOR  first,
+                                    RANDOM_ACCESS_ITERATOR  last,
+                                    const FUNCTION&         function,
+                                    bsl::size_t             grainSize,
+                                    bslma::Allocator       *basicAllocator)
+{
+    BSLS_ASSERT(pool);
+
+    const bsl::size_t length = last - first;
+
+    ForEachChunk<RANDOM_ACCESS_ITERATOR, FUNCTION> chunkFunction;
+    chunkFunction.d_first      = first;
+    chunkFunction.d_length     = length;
+    chunkFunction.d_grainSize  = chooseGrainSize(length, grainSize);
+    chunkFunction.d_function_p = &function;
+
+    runChunks(pool,
+              (length + chunkFunction.d_grainSize - 1) /
+                                                     chunkFunction.d_grainSize,
+              chunkFunction,
+              basicAllocator);
+}
+
+template <class POOL,
+          class RANDOM_ACCESS_ITERATOR,
+          class OUTPUT_ITERATOR,
+          class FUNCTION>
+OUTPUT_ITERATOR ParallelAlgorithmUtil::transform(
+                                       POOL                   *pool,
+                                       RANDOM_ACCESS_ITERATOR  first,
+                                       RANDOM_ACCESS_ITERATOR  last,
+                                       OUTPUT_ITERATOR         result,
+                                       const FUNCTION&         function,
+                                       bsl::size_t             grainSize,
+                                       bslma::Allocator       *basicAllocator)
+{
+    BSLS_ASSERT(pool);
+
+    const bsl::size_t length = last - first;
+
+    TransformChunk<RANDOM_ACCESS_ITERATOR, OUTPUT_ITERATOR, FUNCTION>
+                                                                 chunkFunction;
+    chunkFunction.d_first      = first;
+    chunkFunction.d_result     = result;
+    chunkFunction.d_length     = length;
+    chunkFunction.d_grainSize  = chooseGrainSize(length, grainSize);
+    chunkFunction.d_function_p = &function;
+
+    runChunks(pool,
+              (length + chunkFunction.d_grainSize - 1) /
+                                                     chunkFunction.d_grainSize,
+              chunkFunction,
+              basicAllocator);
+
+    return result + length;
+}
+
+template <class POOL,
+          class RANDOM_ACCESS_ITERATOR,
+          class TYPE,
+          class BINARY_OPERATION>
+TYPE ParallelAlgorithmUtil::reduce(POOL                    *pool,
+                                   RANDOM_ACCESS_ITERATOR   first,
+                                   RANDOM_ACCESS_ITERATOR   last,
+                                   const TYPE&              initialValue,
+                                   const BINARY_OPERATION&  operation,
+                                   bsl::size_t              grainSize,
+                                   bslma::Allocator        *basicAllocator)
+{
+    BSLS_ASSERT(pool);
+
+    const bsl::size_t length       = last - first;
+    const bsl::size_t theGrainSize = chooseGrainSize(length, grainSize);
+    const bsl::size_t numChunks    = (length + theGrainSize - 1) /
+                                                                  theGrainSize;
+
+    bsl::vector<TYPE> results(numChunks, initialValue, basicAllocator);
+
+    ReduceChunk<RANDOM_ACCESS_ITERATOR, TYPE, BINARY_OPERATION> chunkFunction;
+    chunkFunction.d_first       = first;
+    chunkFunction.d_length      = length;
+    chunkFunction.d_grainSize   = theGrainSize;
+    chunkFunction.d_operation_p = &operation;
+    chunkFunction.d_results_p   = &results;
+
+    runChunks(pool, numChunks, chunkFunction, basicAllocator);
+
+    TYPE result(initialValue);
+    for (bsl::size_t i = 0; i < numChunks; ++i) {
+        result = operation(result, results[i]);
+    }
+    return result;
+}
+
+template <class POOL, class RANDOM_ACCESS_ITERATOR>
+inline
+void ParallelAlgorithmUtil::sort(POOL                   *pool,
+                                 RANDOM_ACCESS_ITERATOR  first,
+                                 RANDOM_ACCESS_ITERATOR  last)
+{
+    typedef typename bsl::iterator_traits<RANDOM_ACCESS_ITERATOR>::value_type
+                                                                    ValueType;
+
+    sort(pool, first, last, bsl::less<ValueType>());
+}
+
+template <class POOL, class RANDOM_ACCESS_ITERATOR, class COMPARATOR>
+void ParallelAlgorithmUtil::sort(POOL                   *pool,
+                                 RANDOM_ACCESS_ITERATOR  first,
+                                 RANDOM_ACCESS_ITERATOR  last,
+                                 const COMPARATOR&       comparator,
+                                 bsl::size_t             grainSize,
+                                 bslma::Allocator       *basicAllocator)
+{
+    BSLS_ASSERT(pool);
+
+    const bsl::size_t length       = last - first;
+    const bsl::size_t theGrainSize = bsl::max<bsl::size_t>(
+                                          chooseGrainSize(length, grainSize),
+                                          2);
+
+    if (length <= theGrainSize) {
+        bsl::sort(first, last, comparator);
+        return;                                                       // RETURN
+    }
+
+    basicAllocator = bslma::Default::allocator(basicAllocator);
+
+    bsl::shared_ptr<ParallelAlgorithmUtil_TaskGroup> group =
+                      bsl::allocate_shared<ParallelAlgorithmUtil_TaskGroup>(
+                               basicAllocator,
+                               static_cast<void *>(pool),
+                               &ParallelAlgorithmUtil_Enqueue<POOL>::enqueue,
+                               basicAllocator);
+
+    group->run(bdlf::BindUtil::bind(
+         &ParallelAlgorithmUtil_SortTask<RANDOM_ACCESS_ITERATOR,
+                                         COMPARATOR>::run,
+         group.get(),
+         first,
+         last,
+         &comparator,
+         theGrainSize));
+    group->wait();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License.  You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1503 @@
+// bdlmt_parallelalgorithmutil.t.cpp                                  -*-C++-*-
+
+#include <bdlmt_parallelalgorithmutil.h>
+
+#include <bdlmt_fixedthreadpool.h>
+#include <bdlmt_threadpool.h>
+#include <bdlmt_workstealingthreadpool.h>
+
+#include <bdlf_bind.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bslmt_semaphore.h>
+#include <bslmt_threadattributes.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_functional.h>
+#include <bsl_iostream.h>
+#include <bsl_stdexcept.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test provides a utility 'struct',
+// 'bdlmt::ParallelAlgorithmUtil', whose algorithms run on a group of tasks,
+// 'bdlmt::ParallelAlgorithmUtil_TaskGroup', executed by the calling thread and
+// by helper jobs enqueued on a thread pool.
+//
+// The task group is tested first: tasks adding tasks are all executed exactly
+// once, 'wait' returns once they have completed, and the tasks are executed
+// by the calling thread alone when the pool fails to enqueue the helper jobs.
+//
+// Each algorithm is then tested on ranges of various lengths, with various
+// grain sizes, on each of the thread pools of this package, comparing its
+// result to that of the corresponding sequential algorithm.  The propagation
+// of exceptions, the use of the supplied allocator, and the invocation of the
+// algorithms from jobs of a saturated pool are tested separately.  A negative
+// test case compares the speed of the algorithms with that of their
+// sequential counterparts.
+// ----------------------------------------------------------------------------
+// ParallelAlgorithmUtil_TaskGroup
+// [ 2] ParallelAlgorithmUtil_TaskGroup(pool, enqueue, Allocator *a = 0);
+// [ 2] ~ParallelAlgorithmUtil_TaskGroup();
+// [ 2] void run(const Task& task);
+// [ 2] void wait();
+// [ 2] bslma::Allocator *allocator() const;
+//
+// ParallelAlgorithmUtil
+// [ 3] void forEach(pool, first, last, function, grainSize, allocator);
+// [ 4] OUT transform(pool, first, last, result, function, grain, alloc);
+// [ 5] TYPE reduce(pool, first, last, init, operation, grain, alloc);
+// [ 6] void sort(pool, first, last);
+// [ 6] void sort(pool, first, last, comparator, grainSize, allocator);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 7] EXCEPTION PROPAGATION
+// [ 8] MEMORY ALLOCATION
+// [ 9] INVOCATION FROM JOBS OF A SATURATED POOL
+// [10] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST
+
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static bool             verbose;
+static bool         veryVerbose;
+static bool     veryVeryVerbose;
+static bool veryVeryVeryVerbose;
+
+typedef bdlmt::ParallelAlgorithmUtil           Util;
+typedef bdlmt::ParallelAlgorithmUtil_TaskGroup TaskGroup;
+typedef bsls::Types::Int64                     Int64;
+
+// ============================================================================
+//                     GLOBAL HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+namespace u {
+
+const bsl::size_t LENGTHS[] = { 0, 1, 2, 3, 10, 100, 1000, 10007 };
+const int         NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+    // lengths of the ranges on which the algorithms are tested
+
+const bsl::size_t GRAIN_SIZES[] = { 0, 1, 2, 7, 100, 100000 };
+const int         NUM_GRAIN_SIZES = sizeof GRAIN_SIZES / sizeof *GRAIN_SIZES;
+    // grain sizes with which the algorithms are tested
+
+class FailingPool {
+    // This class provides a pool failing to enqueue any job.
+
+    // DATA
+    bsls::AtomicInt d_numCalls;  // number of calls to 'enqueueJob'
+
+  public:
+    // CREATORS
+    FailingPool()
+    : d_numCalls(0)
+    {
+    }
+
+    // MANIPULATORS
+    int enqueueJob(const bsl::function<void()>&)
+        // Return a non-zero value.
+    {
+        ++d_numCalls;
+        return -1;
+    }
+
+    // ACCESSORS
+    int numCalls() const
+        // Return the number of calls to 'enqueueJob'.
+    {
+        return d_numCalls;
+    }
+};
+
+struct Increment {
+    // This 'struct' defines a functor incrementing its argument.
+
+    void operator()(int& value) const
+        // Increment the specified 'value'.
+    {
+        ++value;
+    }
+};
+
+struct Negate {
+    // This 'struct' defines a functor returning the negation of its
+    // argument.
+
+    Int64 operator()(int value) const
+        // Return the negation of the specified 'value'.
+    {
+        return -static_cast<Int64>(value);
+    }
+};
+
+struct Add {
+    // This 'struct' defines a functor returning the sum of its arguments.
+
+    Int64 operator()(Int64 lhs, Int64 rhs) const
+        // Return the sum of the specified 'lhs' and 'rhs'.
+    {
+        return lhs + rhs;
+    }
+};
+
+struct Concatenate {
+    // This 'struct' defines an associative, but not commutative, functor
+    // returning the concatenation of its arguments.
+
+    bsl::string operator()(const bsl::string& lhs,
+                           const bsl::string& rhs) const
+        // Return the concatenation of the specified 'lhs' and 'rhs'.
+    {
+        return lhs + rhs;
+    }
+};
+
+struct ThrowAt {
+    // This 'struct' defines a functor throwing the value of its argument if
+    // it is equal to a given value.
+
+    // DATA
+    int d_value;  // value to throw
+
+    // ACCESSORS
+    void operator()(int value) const
+        // Throw the specified 'value' if it is equal to the value of this
+        // object.
+    {
+        if (value == d_value) {
+            BSLS_THROW(value);
+        }
+    }
+
+    Int64 operator()(Int64 lhs, Int64 rhs) const
+        // Return the sum of the specified 'lhs' and 'rhs', or throw 'rhs' if
+        // it is equal to the value of this object.
+    {
+        if (rhs == d_value) {
+            BSLS_THROW(d_value);
+        }
+        return lhs + rhs;
+    }
+
+    bool operator()(int lhs, int rhs) const
+        // Return 'true' if the specified 'lhs' is less than the specified
+        // 'rhs', and 'false' otherwise, or throw 'lhs' if it is equal to the
+        // value of this object.
+    {
+        if (lhs == d_value) {
+            BSLS_THROW(d_value);
+        }
+        return lhs < rhs;
+    }
+};
+
+struct ThrowingNegate {
+    // This 'struct' defines a functor returning the negation of its
+    // argument, or throwing it if it is equal to a given value.
+
+    // DATA
+    int d_value;  // value to throw
+
+    // ACCESSORS
+    Int64 operator()(int value) const
+        // Return the negation of the specified 'value', or throw 'value' if
+        // it is equal to the value of this object.
+    {
+        if (value == d_value) {
+            BSLS_THROW(value);
+        }
+        return -static_cast<Int64>(value);
+    }
+};
+
+void fillRandom(bsl::vector<int> *values, int seed, int range)
+    // Assign pseudo-random values in the range '[0, range)', determined by
+    // the specified 'seed', to the elements of the specified 'values'.
+{
+    unsigned int state = static_cast<unsigned int>(seed) * 2654435761u + 1;
+    for (bsl::size_t i = 0; i < values->size(); ++i) {
+        state = state * 1103515245u + 12345u;
+        (*values)[i] = static_cast<int>((state >> 8) % range);
+    }
+}
+
+void spawnTree(TaskGroup *group, int depth, bsls::AtomicInt *counter)
+    // Increment the specified 'counter', and, unless the specified 'depth' is
+    // 0, add to the specified 'group' two tasks doing the same at
+    // 'depth - 1'.  The number of increments resulting from a call at
+    // 'depth' is '2^(depth + 1) - 1'.
+{
+    ++*counter;
+    if (0 < depth) {
+        for (int i = 0; i < 2; ++i) {
+            group->run(bdlf::BindUtil::bind(&spawnTree,
+                                            group,
+                                            depth - 1,
+                                            counter));
+        }
+    }
+}
+
+template <class POOL>
+void testTaskGroup(POOL *pool, bslma::Allocator *basicAllocator)
+    // Test the task group using the specified 'pool' and 'basicAllocator'.
+{
+    for (int depth = 0; depth < 12; ++depth) {
+        bsls::AtomicInt counter(0);
+
+        bsl::shared_ptr<TaskGroup> mX = bsl::allocate_shared<TaskGroup>(
+                          basicAllocator,
+                          static_cast<void *>(pool),
+                          &bdlmt::ParallelAlgorithmUtil_Enqueue<POOL>::enqueue,
+                          basicAllocator);
+        ASSERT(basicAllocator == mX->allocator());
+
+        mX->run(bdlf::BindUtil::bind(&spawnTree, mX.get(), depth, &counter));
+        mX->wait();
+
+        ASSERTV(depth, counter, (2 << depth) - 1 == counter);
+    }
+}
+
+template <class POOL>
+void testForEach(POOL *pool, bslma::Allocator *basicAllocator)
+    // Test 'forEach' using the specified 'pool' and 'basicAllocator'.
+{
+    for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+        const bsl::size_t LENGTH = LENGTHS[ti];
+
+        for (int tj = 0; tj < NUM_GRAIN_SIZES; ++tj) {
+            const bsl::size_t GRAIN_SIZE = GRAIN_SIZES[tj];
+
+            bsl::vector<int> values(LENGTH, 0, basicAllocator);
+
+            Util::forEach(pool,
+                          values.begin(),
+                          values.end(),
+                          Increment(),
+                          GRAIN_SIZE,
+                          basicAllocator);
+
+            bsl::size_t numOnes = bsl::count(values.begin(), values.end(), 1);
+            ASSERTV(LENGTH, GRAIN_SIZE, numOnes, LENGTH == numOnes);
+        }
+    }
+}
+
+template <class POOL>
+void testTransform(POOL *pool, bslma::Allocator *basicAllocator)
+    // Test 'transform' using the specified 'pool' and 'basicAllocator'.
+{
+    for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+        const bsl::size_t LENGTH = LENGTHS[ti];
+
+        for (int tj = 0; tj < NUM_GRAIN_SIZES; ++tj) {
+            const bsl::size_t GRAIN_SIZE = GRAIN_SIZES[tj];
+
+            bsl::vector<int> values(LENGTH, 0, basicAllocator);
+            fillRandom(&values, static_cast<int>(ti * 100 + tj), 1000);
+
+            bsl::vector<Int64> results(LENGTH, 1, basicAllocator);
+
+            bsl::vector<Int64>::iterator end = Util::transform(
+                                                            pool,
+                                                            values.begin(),
+                                                            values.end(),
+                                                            results.begin(),
+                                                            Negate(),
+                                                            GRAIN_SIZE,
+                                                            basicAllocator);
+            ASSERTV(LENGTH, GRAIN_SIZE, results.end() == end);
+
+            for (bsl::size_t i = 0; i < LENGTH; ++i) {
+                ASSERTV(LENGTH, GRAIN_SIZE, i, -values[i] == results[i]);
+            }
+
+            // In place.
+
+            bsl::vector<int> expected(values, basicAllocator);
+            for (bsl::size_t i = 0; i < LENGTH; ++i) {
+                ++expected[i];
+            }
+
+            Util::transform(pool,
+                            values.begin(),
+                            values.end(),
+                            values.begin(),
+                            bdlf::BindUtil::bind(bsl::plus<int>(),
+                                                 bdlf::PlaceHolders::_1,
+                                                 1),
+                            GRAIN_SIZE,
+                            basicAllocator);
+            ASSERTV(LENGTH, GRAIN_SIZE, expected == values);
+        }
+    }
+}
+
+template <class POOL>
+void testReduce(POOL *pool, bslma::Allocator *basicAllocator)
+    // Test 'reduce' using the specified 'pool' and 'basicAllocator'.
+{
+    for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+        const bsl::size_t LENGTH = LENGTHS[ti];
+
+        for (int tj = 0; tj < NUM_GRAIN_SIZES; ++tj) {
+            const bsl::size_t GRAIN_SIZE = GRAIN_SIZES[tj];
+
+            bsl::vector<Int64> values(LENGTH, 0, basicAllocator);
+            Int64              expectedSum = 42;
+            for (bsl::size_t i = 0; i < LENGTH; ++i) {
+                values[i]    = static_cast<Int64>(i * i) - 1000;
+                expectedSum += values[i];
+            }
+
+            const Int64 sum = Util::reduce(pool,
+                                           values.begin(),
+                                           values.end(),
+                                           Int64(42),
+                                           Add(),
+                                           GRAIN_SIZE,
+                                           basicAllocator);
+            ASSERTV(LENGTH, GRAIN_SIZE, expectedSum, sum, expectedSum == sum);
+
+            // A non-commutative operation is applied in order.
+
+            bsl::vector<bsl::string> strings(basicAllocator);
+            bsl::string              expected("<", basicAllocator);
+            for (bsl::size_t i = 0; i < LENGTH; ++i) {
+                strings.push_back(bsl::string(1, char('a' + i % 26)));
+                expected += strings.back();
+            }
+
+            const bsl::string result = Util::reduce(pool,
+                                                    strings.begin(),
+                                                    strings.end(),
+                                                    bsl::string("<"),
+                                                    Concatenate(),
+                                                    GRAIN_SIZE,
+                                                    basicAllocator);
+            ASSERTV(LENGTH, GRAIN_SIZE, expected == result);
+        }
+    }
+}
+
+template <class POOL>
+void testSort(POOL *pool, bslma::Allocator *basicAllocator)
+    // Test 'sort' using the specified 'pool' and 'basicAllocator'.
+{
+    const int RANGES[] = { 1, 2, 10, 1000000 };
+    const int NUM_RANGES = sizeof RANGES / sizeof *RANGES;
+
+    for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+        const bsl::size_t LENGTH = LENGTHS[ti];
+
+        for (int tj = 0; tj < NUM_GRAIN_SIZES; ++tj) {
+            const bsl::size_t GRAIN_SIZE = GRAIN_SIZES[tj];
+
+            for (int tk = 0; tk < NUM_RANGES; ++tk) {
+                const int RANGE = RANGES[tk];
+
+                bsl::vector<int> values(LENGTH, 0, basicAllocator);
+                fillRandom(&values, static_cast<int>(ti * 100 + tj), RANGE);
+
+                bsl::vector<int> expected(values, basicAllocator);
+                bsl::sort(expected.begin(), expected.end());
+
+                bsl::vector<int> mX(values, basicAllocator);
+                Util::sort(pool,
+                           mX.begin(),
+                           mX.end(),
+                           bsl::less<int>(),
+                           GRAIN_SIZE,
+                           basicAllocator);
+                ASSERTV(LENGTH, GRAIN_SIZE, RANGE, expected == mX);
+
+                // Already sorted.
+
+                Util::sort(pool,
+                           mX.begin(),
+                           mX.end(),
+                           bsl::less<int>(),
+                           GRAIN_SIZE,
+                           basicAllocator);
+                ASSERTV(LENGTH, GRAIN_SIZE, RANGE, expected == mX);
+
+                // Reverse order, with a custom comparator.
+
+                Util::sort(pool,
+                           mX.begin(),
+                           mX.end(),
+                           bsl::greater<int>(),
+                           GRAIN_SIZE,
+                           basicAllocator);
+                ASSERTV(LENGTH,
+                        GRAIN_SIZE,
+                        RANGE,
+                        bsl::equal(mX.begin(), mX.end(), expected.rbegin()));
+            }
+        }
+    }
+
+    // Default comparator and grain size.
+
+    bsl::vector<int> values(10007, 0, basicAllocator);
+    fillRandom(&values, 7, 100000);
+
+    bsl::vector<int> expected(values, basicAllocator);
+    bsl::sort(expected.begin(), expected.end());
+
+    Util::sort(pool, values.begin(), values.end());
+    ASSERT(expected == values);
+}
+
+template <class POOL>
+void testExceptions(POOL *pool, bslma::Allocator *basicAllocator)
+    // Test the propagation of exceptions using the specified 'pool' and
+    // 'basicAllocator'.
+{
+#ifdef BDE_BUILD_TARGET_EXC
+    const int LENGTH = 10000;
+
+    bsl::vector<int> values(LENGTH, 0, basicAllocator);
+    for (int i = 0; i < LENGTH; ++i) {
+        values[i] = i;
+    }
+
+    const int THROWN[] = { 0, 1, 5000, LENGTH - 1 };
+    const int NUM_THROWN = sizeof THROWN / sizeof *THROWN;
+
+    for (int ti = 0; ti < NUM_THROWN; ++ti) {
+        const ThrowAt        THROW_AT        = { THROWN[ti] };
+        const ThrowingNegate THROWING_NEGATE = { THROWN[ti] };
+
+        for (int algorithm = 0; algorithm < 4; ++algorithm) {
+            int thrown = -1;
+            try {
+                switch (algorithm) {
+                  case 0: {
+                    Util::forEach(pool,
+                                  values.begin(),
+                                  values.end(),
+                                  THROW_AT,
+                                  10,
+                                  basicAllocator);
+                  } break;
+                  case 1: {
+                    bsl::vector<Int64> results(LENGTH, 0, basicAllocator);
+                    Util::transform(pool,
+                                    values.begin(),
+                                    values.end(),
+                                    results.begin(),
+                                    THROWING_NEGATE,
+                                    10,
+                                    basicAllocator);
+                  } break;
+                  case 2: {
+                    bsl::vector<Int64> int64s(values.begin(),
+                                              values.end(),
+                                              basicAllocator);
+                    Util::reduce(pool,
+                                 int64s.begin(),
+                                 int64s.end(),
+                                 Int64(0),
+                                 THROW_AT,
+                                 10,
+                                 basicAllocator);
+                  } break;
+                  case 3: {
+                    bsl::vector<int> mX(values, basicAllocator);
+                    bsl::reverse(mX.begin(), mX.end());
+                    Util::sort(pool,
+                               mX.begin(),
+                               mX.end(),
+                               THROW_AT,
+                               10,
+                               basicAllocator);
+                  } break;
+                }
+            }
+#ifdef BSLS_LIBRARYFEATURES_HAS_CPP11_EXCEPTION_HANDLING
+            catch (int value) {
+                thrown = value;
+            }
+#else
+            catch (const bsl::runtime_error&) {
+                thrown = THROWN[ti];
+            }
+#endif
+
+            // The first element of a chunk is not combined by 'reduce'.
+
+            if (2 == algorithm && 0 == THROWN[ti] % 10) {
+                ASSERTV(ti, thrown, -1 == thrown);
+            }
+            else {
+                ASSERTV(algorithm, ti, thrown, THROWN[ti] == thrown);
+            }
+        }
+    }
+
+    // The algorithms remain usable.
+
+    bsl::vector<int> ones(LENGTH, 0, basicAllocator);
+    Util::forEach(pool, ones.begin(), ones.end(), Increment(), 10);
+    ASSERT(LENGTH == bsl::count(ones.begin(), ones.end(), 1));
+#else
+    (void)pool;
+    (void)basicAllocator;
+#endif
+}
+
+void nestedForEach(bdlmt::WorkStealingThreadPool *pool,
+                   bsls::AtomicInt               *counter,
+                   int)
+    // Increment the specified 'counter' by the result of a parallel reduction
+    // of 100 ones, using the specified 'pool'.  The (unnamed) element value is
+    // ignored.
+{
+    bsl::vector<Int64> ones(100, 1);
+    *counter += static_cast<int>(Util::reduce(pool,
+                                              ones.begin(),
+                                              ones.end(),
+                                              Int64(0),
+                                              Add(),
+                                              3));
+}
+
+void forEachJob(bdlmt::FixedThreadPool *pool,
+                bsl::vector<int>       *values,
+                bslmt::Semaphore       *done)
+    // Increment each element of the specified 'values' using the specified
+    // 'pool', and post the specified 'done'.
+{
+    Util::forEach(pool, values->begin(), values->end(), Increment(), 1);
+    done->post();
+}
+
+}  // close namespace u
+}  // close unnamed namespace
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+namespace usage {
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Processing a Vector in Parallel
+///- - - - - - - - - - - - - - - - - - - - -
+// In this example, we square the elements of a vector, sum the squares, and
+// sort them, all in parallel on the threads of a 'bdlmt::FixedThreadPool'.
+//
+// First, we define the functors to be applied to the elements:
+//..
+    struct Square {
+        // This 'struct' defines a functor returning the square of its
+        // argument.
+
+        int operator()(int value) const
+            // Return the square of the specified 'value'.
+        {
+            return value * value;
+        }
+    };
+
+    struct Add {
+        // This 'struct' defines a functor returning the sum of its arguments.
+
+        bsls::Types::Int64 operator()(bsls::Types::Int64 lhs,
+                                      bsls::Types::Int64 rhs) const
+            // Return the sum of the specified 'lhs' and 'rhs'.
+        {
+            return lhs + rhs;
+        }
+    };
+//..
+
+void example1()
+{
+// Then, we create and start a pool of four threads:
+//..
+    bdlmt::FixedThreadPool pool(4, 1000);
+    int rc = pool.start();
+    ASSERT(0 == rc);
+//..
+// Next, we create a vector of values in decreasing order:
+//..
+    bsl::vector<int> values(10000);
+    for (int i = 0; i < static_cast<int>(values.size()); ++i) {
+        values[i] = static_cast<int>(values.size()) - i;
+    }
+//..
+// Then, we replace each value by its square, in chunks of 100 elements:
+//..
+    bdlmt::ParallelAlgorithmUtil::transform(&pool,
+                                            values.begin(),
+                                            values.end(),
+                                            values.begin(),
+                                            Square(),
+                                            100);
+    ASSERT(100 * 100 == values[10000 - 100]);
+//..
+// Next, we sum the squares, using the default grain size:
+//..
+    bsls::Types::Int64 sum = bdlmt::ParallelAlgorithmUtil::reduce(
+                                                        &pool,
+                                                        values.begin(),
+                                                        values.end(),
+                                                        bsls::Types::Int64(0),
+                                                        Add());
+//..
+// Then, we verify the sum, using the formula for the sum of the first 'n'
+// squares, 'n * (n + 1) * (2 * n + 1) / 6':
+//..
+    const bsls::Types::Int64 n = 10000;
+    ASSERT(n * (n + 1) * (2 * n + 1) / 6 == sum);
+//..
+// Now, we sort the squares in increasing order:
+//..
+    bdlmt::ParallelAlgorithmUtil::sort(&pool, values.begin(), values.end());
+//..
+// Finally, we verify the order, and stop the pool:
+//..
+    for (int i = 0; i < static_cast<int>(values.size()); ++i) {
+        ASSERT((i + 1) * (i + 1) == values[i]);
+    }
+
+    pool.stop();
+//..
+}
+
+}  // close namespace usage
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test            = argc > 1 ? atoi(argv[1]) : 0;
+    verbose             = argc > 2;
+    veryVerbose         = argc > 3;
+    veryVeryVerbose     = argc > 4;
+    veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator         defaultAllocator("default",
+                                                  veryVeryVeryVerbose);
+    bslma::DefaultAllocatorGuard defaultAllocatorGuard(&defaultAllocator);
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 10: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        usage::example1();
+      } break;
+      case 9: {
+        // --------------------------------------------------------------------
+        // INVOCATION FROM JOBS OF A SATURATED POOL
+        //
+        // Concerns:
+        //: 1 An algorithm invoked from a job of the pool it uses completes,
+        //:   even if no other thread of the pool is available.
+        //:
+        //: 2 Algorithms can be nested, all the threads of the pool invoking
+        //:   algorithms from within the functions supplied to an algorithm.
+        //
+        // Plan:
+        //: 1 From the only job of a pool having a single thread, invoke
+        //:   'forEach' on that pool, and verify that the job completes.
+        //:   (C-1)
+        //:
+        //: 2 Invoke 'forEach' with a function invoking 'reduce' on the same
+        //:   pool, and verify the result.  (C-2)
+        //
+        // Testing:
+        //   INVOCATION FROM JOBS OF A SATURATED POOL
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                      << endl
+                      << "INVOCATION FROM JOBS OF A SATURATED POOL" << endl
+                      << "========================================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        if (verbose) cout << "\tFrom the job of a single-threaded pool.\n";
+        {
+            bdlmt::FixedThreadPool pool(1, 1, &ta);
+            ASSERT(0 == pool.start());
+
+            bsl::vector<int> values(1000, 0, &ta);
+            bslmt::Semaphore done;
+
+            ASSERT(0 == pool.enqueueJob(bdlf::BindUtil::bind(&u::forEachJob,
+                                                             &pool,
+                                                             &values,
+                                                             &done)));
+            done.wait();
+
+            ASSERT(1000 == bsl::count(values.begin(), values.end(), 1));
+
+            pool.stop();
+        }
+
+        if (verbose) cout << "\tNested algorithms.\n";
+        {
+            bdlmt::WorkStealingThreadPool pool(2, &ta);
+            ASSERT(0 == pool.start());
+
+            bsl::vector<int> values(1000, 0, &ta);
+            bsls::AtomicInt  counter(0);
+
+            Util::forEach(&pool,
+                          values.begin(),
+                          values.end(),
+                          bdlf::BindUtil::bind(&u::nestedForEach,
+                                               &pool,
+                                               &counter,
+                                               bdlf::PlaceHolders::_1),
+                          10);
+            ASSERTV(counter, 1000 * 100 == counter);
+
+            pool.stop();
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 8: {
+        // --------------------------------------------------------------------
+        // MEMORY ALLOCATION
+        //
+        // Concerns:
+        //: 1 The algorithms use the supplied allocator, and not the default
+        //:   allocator.
+        //:
+        //: 2 All the memory allocated by an invocation is released once the
+        //:   pool has executed the helper jobs of the invocation.
+        //:
+        //: 3 If no allocator is supplied, the default allocator is used.
+        //
+        // Plan:
+        //: 1 Invoke each algorithm with a test allocator, drain the pool, and
+        //:   verify that the test allocator was used and has no blocks in
+        //:   use, and that the default allocator was not used.  (C-1..2)
+        //:
+        //: 2 Invoke 'forEach' without allocator, and verify that the default
+        //:   allocator was used.  (C-3)
+        //
+        // Testing:
+        //   MEMORY ALLOCATION
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MEMORY ALLOCATION" << endl
+                          << "=================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+
+        bdlmt::FixedThreadPool pool(4, 100, &ta);
+        ASSERT(0 == pool.start());
+
+        bsl::vector<int> values(10000, 0, &ta);
+        u::fillRandom(&values, 1, 1000);
+        bsl::vector<Int64> results(10000, 0, &ta);
+
+        const Int64 numDefaultBlocks = defaultAllocator.numBlocksTotal();
+
+        for (int algorithm = 0; algorithm < 4; ++algorithm) {
+            const Int64 numBlocks = sa.numBlocksTotal();
+
+            switch (algorithm) {
+              case 0: {
+                Util::forEach(&pool,
+                              values.begin(),
+                              values.end(),
+                              u::Increment(),
+                              10,
+                              &sa);
+              } break;
+              case 1: {
+                Util::transform(&pool,
+                                values.begin(),
+                                values.end(),
+                                results.begin(),
+                                u::Negate(),
+                                10,
+                                &sa);
+              } break;
+              case 2: {
+                Util::reduce(&pool,
+                             results.begin(),
+                             results.end(),
+                             Int64(0),
+                             u::Add(),
+                             10,
+                             &sa);
+              } break;
+              case 3: {
+                Util::sort(&pool,
+                           values.begin(),
+                           values.end(),
+                           bsl::less<int>(),
+                           10,
+                           &sa);
+              } break;
+            }
+            pool.drain();
+
+            ASSERTV(algorithm, numBlocks < sa.numBlocksTotal());
+            ASSERTV(algorithm, sa.numBlocksInUse(), 0 == sa.numBlocksInUse());
+            ASSERTV(algorithm,
+                    numDefaultBlocks == defaultAllocator.numBlocksTotal());
+        }
+
+        Util::forEach(&pool, values.begin(), values.end(), u::Increment(), 10);
+        pool.drain();
+
+        ASSERT(numDefaultBlocks < defaultAllocator.numBlocksTotal());
+        ASSERTV(defaultAllocator.numBlocksInUse(),
+                0 == defaultAllocator.numBlocksInUse());
+
+        pool.stop();
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // EXCEPTION PROPAGATION
+        //
+        // Concerns:
+        //: 1 An exception thrown by a function supplied to an algorithm, in
+        //:   any thread, is rethrown by the algorithm.
+        //:
+        //: 2 The pool, and the algorithms, remain usable after an exception.
+        //:
+        //: 3 No memory is leaked.
+        //
+        // Plan:
+        //: 1 For each algorithm, and each pool, have the supplied function
+        //:   throw for a given element, at the beginning, middle, and end of
+        //:   the range, and verify that the exception is rethrown.  (C-1)
+        //:
+        //: 2 Invoke 'forEach' after the exceptions, and verify the result.
+        //:   (C-2)
+        //:
+        //: 3 Verify that the test allocator has no blocks in use after the
+        //:   pools are stopped.  (C-3)
+        //
+        // Testing:
+        //   EXCEPTION PROPAGATION
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "EXCEPTION PROPAGATION" << endl
+                          << "=====================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            bdlmt::FixedThreadPool pool(4, 100, &ta);
+            ASSERT(0 == pool.start());
+            u::testExceptions(&pool, &ta);
+            pool.stop();
+        }
+        {
+            bdlmt::ThreadPool pool(bslmt::ThreadAttributes(), 1, 4, 100, &ta);
+            ASSERT(0 == pool.start());
+            u::testExceptions(&pool, &ta);
+            pool.stop();
+        }
+        {
+            bdlmt::WorkStealingThreadPool pool(4, &ta);
+            ASSERT(0 == pool.start());
+            u::testExceptions(&pool, &ta);
+            pool.stop();
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // 'sort'
+        //
+        // Concerns:
+        //: 1 'sort' orders the elements of the range according to the
+        //:   comparator, or to 'operator<' if none is supplied.
+        //:
+        //: 2 Ranges with many equal elements, and ranges already sorted, are
+        //:   sorted correctly.
+        //:
+        //: 3 Any grain size, including 0, can be used.
+        //:
+        //: 4 'sort' works with each of the thread pools of this package.
+        //
+        // Plan:
+        //: 1 For each pool, sort ranges of pseudo-random values in ranges of
+        //:   various sizes (including a range of a single value), for
+        //:   various lengths and grain sizes, first in increasing order, then
+        //:   again, then in decreasing order, and compare the results with
+        //:   those of 'bsl::sort'.  (C-1..4)
+        //
+        // Testing:
+        //   void sort(pool, first, last);
+        //   void sort(pool, first, last, comparator, grainSize, allocator);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'sort'" << endl
+                          << "======" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            bdlmt::FixedThreadPool pool(4, 100, &ta);
+            ASSERT(0 == pool.start());
+            u::testSort(&pool, &ta);
+            pool.stop();
+        }
+        {
+            bdlmt::ThreadPool pool(bslmt::ThreadAttributes(), 1, 4, 100, &ta);
+            ASSERT(0 == pool.start());
+            u::testSort(&pool, &ta);
+            pool.stop();
+        }
+        {
+            bdlmt::WorkStealingThreadPool pool(4, &ta);
+            ASSERT(0 == pool.start());
+            u::testSort(&pool, &ta);
+            pool.stop();
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // 'reduce'
+        //
+        // Concerns:
+        //: 1 'reduce' returns the combination of the initial value and of
+        //:   all the elements of the range.
+        //:
+        //: 2 The operation is applied in the order of the elements, so that
+        //:   an associative, but not commutative, operation yields the same
+        //:   result as a sequential left fold.
+        //:
+        //: 3 Any grain size, including 0, can be used.
+        //:
+        //: 4 'reduce' works with each of the thread pools of this package.
+        //
+        // Plan:
+        //: 1 For each pool, and for various lengths and grain sizes, sum a
+        //:   range of integers, and concatenate a range of strings, and
+        //:   compare the results with those of sequential loops.  (C-1..4)
+        //
+        // Testing:
+        //   TYPE reduce(pool, first, last, init, operation, grain, alloc);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'reduce'" << endl
+                          << "========" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            bdlmt::FixedThreadPool pool(4, 100, &ta);
+            ASSERT(0 == pool.start());
+            u::testReduce(&pool, &ta);
+            pool.stop();
+        }
+        {
+            bdlmt::ThreadPool pool(bslmt::ThreadAttributes(), 1, 4, 100, &ta);
+            ASSERT(0 == pool.start());
+            u::testReduce(&pool, &ta);
+            pool.stop();
+        }
+        {
+            bdlmt::WorkStealingThreadPool pool(4, &ta);
+            ASSERT(0 == pool.start());
+            u::testReduce(&pool, &ta);
+            pool.stop();
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // 'transform'
+        //
+        // Concerns:
+        //: 1 'transform' assigns the result of the function applied to each
+        //:   element of the input range to the element at the same position
+        //:   of the output range, and returns the end of the output range.
+        //:
+        //: 2 The output range may be the input range.
+        //:
+        //: 3 Any grain size, including 0, can be used.
+        //:
+        //: 4 'transform' works with each of the thread pools of this package.
+        //
+        // Plan:
+        //: 1 For each pool, and for various lengths and grain sizes,
+        //:   transform a range of pseudo-random integers into a distinct
+        //:   range of a different type, and then into itself, and verify the
+        //:   results.  (C-1..4)
+        //
+        // Testing:
+        //   OUT transform(pool, first, last, result, function, grain, alloc);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'transform'" << endl
+                          << "===========" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            bdlmt::FixedThreadPool pool(4, 100, &ta);
+            ASSERT(0 == pool.start());
+            u::testTransform(&pool, &ta);
+            pool.stop();
+        }
+        {
+            bdlmt::ThreadPool pool(bslmt::ThreadAttributes(), 1, 4, 100, &ta);
+            ASSERT(0 == pool.start());
+            u::testTransform(&pool, &ta);
+            pool.stop();
+        }
+        {
+            bdlmt::WorkStealingThreadPool pool(4, &ta);
+            ASSERT(0 == pool.start());
+            u::testTransform(&pool, &ta);
+            pool.stop();
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'forEach'
+        //
+        // Concerns:
+        //: 1 'forEach' invokes the function exactly once on each element of
+        //:   the range.
+        //:
+        //: 2 Any grain size, including 0, and larger than the range, can be
+        //:   used.
+        //:
+        //: 3 'forEach' works with each of the thread pools of this package.
+        //
+        // Plan:
+        //: 1 For each pool, and for various lengths and grain sizes, increment
+        //:   each element of a range of zeros, and verify that all the
+        //:   elements are then one.  (C-1..3)
+        //
+        // Testing:
+        //   void forEach(pool, first, last, function, grainSize, allocator);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'forEach'" << endl
+                          << "=========" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            bdlmt::FixedThreadPool pool(4, 100, &ta);
+            ASSERT(0 == pool.start());
+            u::testForEach(&pool, &ta);
+            pool.stop();
+        }
+        {
+            bdlmt::ThreadPool pool(bslmt::ThreadAttributes(), 1, 4, 100, &ta);
+            ASSERT(0 == pool.start());
+            u::testForEach(&pool, &ta);
+            pool.stop();
+        }
+        {
+            bdlmt::WorkStealingThreadPool pool(4, &ta);
+            ASSERT(0 == pool.start());
+            u::testForEach(&pool, &ta);
+            pool.stop();
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TASK GROUP
+        //
+        // Concerns:
+        //: 1 All the tasks of a group, including the tasks added by tasks,
+        //:   are executed exactly once before 'wait' returns.
+        //:
+        //: 2 If the pool fails to enqueue the helper jobs, the tasks are
+        //:   executed by the thread in 'wait'.
+        //:
+        //: 3 'allocator' returns the allocator supplied at construction.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Run trees of tasks of various depths on each pool, and on a pool
+        //:   failing to enqueue jobs, and verify the number of executed
+        //:   tasks.  (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments (using the 'BSLS_ASSERTTEST_*'
+        //:   macros).  (C-4)
+        //
+        // Testing:
+        //   ParallelAlgorithmUtil_TaskGroup(pool, enqueue, Allocator *a = 0);
+        //   ~ParallelAlgorithmUtil_TaskGroup();
+        //   void run(const FUNCTION& function);
+        //   void wait();
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TASK GROUP" << endl
+                          << "==========" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            bdlmt::FixedThreadPool pool(4, 100, &ta);
+            ASSERT(0 == pool.start());
+            u::testTaskGroup(&pool, &ta);
+            pool.stop();
+        }
+        {
+            bdlmt::ThreadPool pool(bslmt::ThreadAttributes(), 1, 4, 100, &ta);
+            ASSERT(0 == pool.start());
+            u::testTaskGroup(&pool, &ta);
+            pool.stop();
+        }
+        {
+            bdlmt::WorkStealingThreadPool pool(4, &ta);
+            ASSERT(0 == pool.start());
+            u::testTaskGroup(&pool, &ta);
+            pool.stop();
+        }
+        {
+            u::FailingPool pool;
+            u::testTaskGroup(&pool, &ta);
+            ASSERTV(pool.numCalls(), 0 < pool.numCalls());
+
+            bsl::vector<int> values(1000, 0, &ta);
+            Util::forEach(&pool, values.begin(), values.end(),
+                          u::Increment(), 1, &ta);
+            ASSERT(1000 == bsl::count(values.begin(), values.end(), 1));
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            u::FailingPool pool;
+
+            ASSERT_PASS(TaskGroup(&pool,
+                                  &bdlmt::ParallelAlgorithmUtil_Enqueue<
+                                                      u::FailingPool>::enqueue,
+                                  &ta));
+            ASSERT_FAIL(TaskGroup(0,
+                                  &bdlmt::ParallelAlgorithmUtil_Enqueue<
+                                                      u::FailingPool>::enqueue,
+                                  &ta));
+            ASSERT_FAIL(TaskGroup(&pool, 0, &ta));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The algorithms operate as expected.
+        //
+        // Plan:
+        //: 1 Apply each algorithm to a vector on a 'bdlmt::FixedThreadPool',
+        //:   and verify the results.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            bdlmt::FixedThreadPool pool(4, 100, &ta);
+            ASSERT(0 == pool.start());
+
+            bsl::vector<int> values(1000, 0, &ta);
+            Util::forEach(&pool, values.begin(), values.end(),
+                          u::Increment());
+            ASSERT(1000 == bsl::count(values.begin(), values.end(), 1));
+
+            for (int i = 0; i < 1000; ++i) {
+                values[i] = 1000 - i;
+            }
+
+            bsl::vector<Int64> results(1000, 0, &ta);
+            Util::transform(&pool, values.begin(), values.end(),
+                            results.begin(), u::Negate());
+            ASSERT(-1000 == results[0]);
+            ASSERT(   -1 == results[999]);
+
+            ASSERT(-500500 == Util::reduce(&pool,
+                                           results.begin(),
+                                           results.end(),
+                                           Int64(0),
+                                           u::Add()));
+
+            Util::sort(&pool, values.begin(), values.end());
+            for (int i = 0; i < 1000; ++i) {
+                ASSERTV(i, values[i], i + 1 == values[i]);
+            }
+
+            pool.stop();
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST
+        //
+        // Concerns:
+        //: 1 The algorithms are faster than their sequential counterparts on
+        //:   large ranges when several cores are available.
+        //
+        // Plan:
+        //: 1 Time each algorithm, and its sequential counterpart, on a range
+        //:   of 2^22 pseudo-random integers, using a
+        //:   'bdlmt::WorkStealingThreadPool' having one thread per core, and
+        //:   print the results.  The optional second argument of the test
+        //:   case specifies the grain size.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE TEST" << endl
+                          << "================" << endl;
+
+        const bsl::size_t LENGTH     = 1 << 22;
+        const bsl::size_t GRAIN_SIZE = argc > 2 ? atoi(argv[2]) : 0;
+        const int         NUM_THREADS = bsl::max(
+                   static_cast<int>(bslmt::ThreadUtil::hardwareConcurrency()),
+                   1);
+
+        bdlmt::WorkStealingThreadPool pool(NUM_THREADS);
+        ASSERT(0 == pool.start());
+
+        bsl::vector<int> values(LENGTH);
+        u::fillRandom(&values, 1, 1 << 30);
+        bsl::vector<Int64> results(LENGTH);
+
+        printf("%d threads, %d elements, grain size %d\n",
+               NUM_THREADS,
+               static_cast<int>(LENGTH),
+               static_cast<int>(GRAIN_SIZE));
+
+        bsls::Stopwatch stopwatch;
+
+        stopwatch.start();
+        bsl::transform(values.begin(),
+                       values.end(),
+                       results.begin(),
+                       u::Negate());
+        stopwatch.stop();
+        printf("  transform, sequential: %10.6f s\n",
+               stopwatch.accumulatedWallTime());
+
+        stopwatch.reset();
+        stopwatch.start();
+        Util::transform(&pool,
+                        values.begin(),
+                        values.end(),
+                        results.begin(),
+                        u::Negate(),
+                        GRAIN_SIZE);
+        stopwatch.stop();
+        printf("  transform, parallel:   %10.6f s\n",
+               stopwatch.accumulatedWallTime());
+
+        stopwatch.reset();
+        stopwatch.start();
+        Int64 sum = 0;
+        for (bsl::size_t i = 0; i < LENGTH; ++i) {
+            sum += results[i];
+        }
+        stopwatch.stop();
+        printf("  reduce, sequential:    %10.6f s\n",
+               stopwatch.accumulatedWallTime());
+
+        stopwatch.reset();
+        stopwatch.start();
+        ASSERT(sum == Util::reduce(&pool,
+                                   results.begin(),
+                                   results.end(),
+                                   Int64(0),
+                                   u::Add(),
+                                   GRAIN_SIZE));
+        stopwatch.stop();
+        printf("  reduce, parallel:      %10.6f s\n",
+               stopwatch.accumulatedWallTime());
+
+        bsl::vector<int> copy(values);
+
+        stopwatch.reset();
+        stopwatch.start();
+        bsl::sort(copy.begin(), copy.end());
+        stopwatch.stop();
+        printf("  sort, sequential:      %10.6f s\n",
+               stopwatch.accumulatedWallTime());
+
+        stopwatch.reset();
+        stopwatch.start();
+        Util::sort(&pool,
+                   values.begin(),
+                   values.end(),
+                   bsl::less<int>(),
+                   GRAIN_SIZE);
+        stopwatch.stop();
+        printf("  sort, parallel:        %10.6f s\n",
+               stopwatch.accumulatedWallTime());
+        ASSERT(copy == values);
+
+        pool.stop();
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (test >= 0) {
+        // CONCERN: In no case does memory come from the global allocator.
+
+        ASSERTV(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License.  You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -57,7 +57,9 @@ BSLS_IDENT("$Id: $")
 // attributes of the threads in the pool (e.g., thread priority or stack size),
 // by providing a 'bslmt::ThreadAttributes' object with the desired values set.
 // See 'bslmt_threadutil' package documentation for a description of
-// 'bslmt::ThreadAttributes'.
+// 'bslmt::ThreadAttributes'.  In particular, the 'cpuAffinity' and 'numaNode'
+// attributes pin every thread of the pool, including the threads created
+// dynamically to handle bursts, to the specified CPUs or NUMA node.
 //
 // Thread pools are ideal for developing multi-threaded server applications.  A
 // server need only package client requests to execute as jobs, and
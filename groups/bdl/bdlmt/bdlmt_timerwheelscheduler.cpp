@@ -0,0 +1,917 @@
+// bdlmt_timerwheelscheduler.cpp                                      -*-C++-*-
+#include <bdlmt_timerwheelscheduler.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlmt_timerwheelscheduler_cpp,"$Id$ $CSID$")
+
+///IMPLEMENTATION NOTES
+///--------------------
+// Time is divided into ticks of 'd_tickNanoseconds', tick 0 ending at
+// 'd_originNanoseconds'.  An event due at time 't' is due in the first tick
+// ending at or after 't', and the dispatcher thread processes tick 'k' once
+// the current time has reached the end of tick 'k', so that no event is
+// dispatched early.
+//
+// A node due at tick 'k' is kept at the lowest level 'l' such that 'k' and
+// 'd_nextTick' agree on all bits above the lowest '8 * (l + 1)' bits, in the
+// slot given by bits '[8 * l, 8 * l + 8)' of 'k'; nodes for which no such
+// level exists are kept in the overflow list.  A node at level 'l > 0' is
+// therefore in a slot that 'd_nextTick' has not yet reached at that level, and
+// is cascaded (i.e., reinserted, at a lower level) when 'd_nextTick' reaches
+// the first tick of that slot.  Processing a tick first cascades the due
+// slots of the higher levels (highest first, so that the nodes they hold can
+// be cascaded further down in the same tick), and then collects the slot of
+// the tick at level 0.
+//
+// When all the nodes are at level 'l > 0' or above, no node can be due, and no
+// list needs to be cascaded, before the next multiple of '2^(8 * l)', so
+// 'skipEmptyTicks' advances 'd_nextTick' to it directly.  Similarly, the
+// dispatcher thread sleeps until the first non-empty slot at level 0, or the
+// next such multiple, and is signaled by 'insertNode' when a node is inserted
+// for an earlier tick.
+//
+// Nodes are stored in a vector, and linked by index, so that the handle of a
+// node is its index combined with a generation count incremented each time
+// the node is released.  The callbacks are stored separately, in a deque, so
+// that growing the vector does not copy them.
+
+#include <bdlmt_threadpool.h>
+
+#include <bdlf_bind.h>
+
+#include <bslma_default.h>
+
+#include <bslmt_lockguard.h>
+
+#include <bsls_assert.h>
+#include <bsls_systemtime.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_limits.h>
+
+namespace BloombergLP {
+namespace {
+
+const bsls::Types::Int64 k_DEFAULT_TICK_NANOSECONDS = 1000 * 1000;
+    // default tick granularity (one millisecond)
+
+const bsls::Types::Uint64 k_MAX_TICK =
+                               bsl::numeric_limits<bsls::Types::Uint64>::max();
+
+const bsl::size_t k_MAX_COLLECTED = 1024;
+    // number of callbacks after which the dispatcher thread stops collecting
+    // and dispatches the callbacks, so as not to hold the lock for long
+
+bsl::function<bsls::TimeInterval()> createDefaultCurrentTimeFunctor(
+                                         bsls::SystemClockType::Enum clockType)
+{
+    // Must cast the pointer to 'now' to the correct signature so that the
+    // correct now function is passed to the bind template.
+
+    return bdlf::BindUtil::bind(
+              static_cast<bsls::TimeInterval (*)(bsls::SystemClockType::Enum)>(
+                                                       &bsls::SystemTime::now),
+              clockType);
+}
+
+void invokeCallbacks(
+       const bsl::shared_ptr<bsl::vector<bsl::function<void()> > >& callbacks)
+    // Invoke, in order, the specified 'callbacks'.
+{
+    for (bsl::size_t i = 0; i < callbacks->size(); ++i) {
+        (*callbacks)[i]();
+    }
+}
+
+}  // close unnamed namespace
+
+namespace bdlmt {
+
+               // ============================================
+               // class TimerWheelSchedulerTestTimeSource_Data
+               // ============================================
+
+class TimerWheelSchedulerTestTimeSource_Data {
+    // This 'class' provides storage for the current time and a mutex to
+    // protect access to the current time.
+
+    // DATA
+    bsls::TimeInterval   d_currentTime;       // the current time
+
+    mutable bslmt::Mutex d_currentTimeMutex;  // mutex used to synchronize
+                                              // 'd_currentTime' access
+
+    // NOT IMPLEMENTED
+    TimerWheelSchedulerTestTimeSource_Data(
+                                const TimerWheelSchedulerTestTimeSource_Data&);
+    TimerWheelSchedulerTestTimeSource_Data& operator=(
+                                const TimerWheelSchedulerTestTimeSource_Data&);
+
+  public:
+    // CREATORS
+    explicit
+    TimerWheelSchedulerTestTimeSource_Data(bsls::TimeInterval currentTime);
+        // Create a test time-source data object that will store the
+        // "system-time", initialized to the specified 'currentTime'.
+
+    // MANIPULATORS
+    bsls::TimeInterval advanceTime(bsls::TimeInterval amount);
+        // Advance this object's current-time value by the specified 'amount'
+        // of time.  Return the updated current-time value.  The behavior is
+        // undefined unless 'amount' is positive.
+
+    // ACCESSORS
+    bsls::TimeInterval currentTime() const;
+        // Return this object's current-time value.
+};
+
+// CREATORS
+TimerWheelSchedulerTestTimeSource_Data::TimerWheelSchedulerTestTimeSource_Data(
+                                                bsls::TimeInterval currentTime)
+: d_currentTime(currentTime)
+{
+}
+
+// MANIPULATORS
+bsls::TimeInterval TimerWheelSchedulerTestTimeSource_Data::advanceTime(
+                                                     bsls::TimeInterval amount)
+{
+    BSLS_ASSERT(amount > 0);
+
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_currentTimeMutex);
+    d_currentTime += amount;
+    return d_currentTime;
+}
+
+// ACCESSORS
+bsls::TimeInterval TimerWheelSchedulerTestTimeSource_Data::currentTime() const
+{
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_currentTimeMutex);
+    return d_currentTime;
+}
+
+                         // -------------------------
+                         // class TimerWheelScheduler
+                         // -------------------------
+
+// PRIVATE MANIPULATORS
+int TimerWheelScheduler::acquireNode(const bsl::function<void()>& callback)
+{
+    if (k_NONE == d_freeList) {
+        // Reserve first, so that appending the node cannot fail after the
+        // callback is appended.
+
+        if (d_nodes.size() == d_nodes.capacity()) {
+            d_nodes.reserve(bsl::max<bsl::size_t>(16, 2 * d_nodes.size()));
+        }
+        d_callbacks.push_back(callback);
+
+        Node node;
+        node.d_time       = 0;
+        node.d_interval   = 0;
+        node.d_tick       = 0;
+        node.d_next       = k_NONE;
+        node.d_prev       = k_NONE;
+        node.d_list       = k_FREE;
+        node.d_generation = 0;
+
+        d_nodes.push_back(node);
+
+        return static_cast<int>(d_nodes.size()) - 1;                  // RETURN
+    }
+
+    const int index = d_freeList;
+
+    d_callbacks[index] = callback;
+    d_freeList         = d_nodes[index].d_next;
+
+    return index;
+}
+
+void TimerWheelScheduler::cascade(int list)
+{
+    int index = d_lists[list];
+
+    d_lists[list] = k_NONE;
+
+    while (k_NONE != index) {
+        const int next = d_nodes[index].d_next;
+
+        --d_levelCounts[list / k_NUM_SLOTS];
+        d_nodes[index].d_list = k_FREE;
+        insertNode(index);
+
+        index = next;
+    }
+}
+
+void TimerWheelScheduler::dispatchBatch(
+                                   bsl::vector<bsl::function<void()> > *batch)
+{
+    if (0 == d_threadPool_p) {
+        for (bsl::size_t i = 0; i < batch->size(); ++i) {
+            (*batch)[i]();
+        }
+        batch->clear();
+        return;                                                       // RETURN
+    }
+
+    typedef bsl::vector<bsl::function<void()> > Callbacks;
+
+    bsl::size_t begin = 0;
+    while (begin < batch->size()) {
+        const bsl::size_t end = bsl::min(
+                                   batch->size(),
+                                   begin + static_cast<bsl::size_t>(
+                                                             d_maxBatchSize));
+
+        bsl::shared_ptr<Callbacks> job = bsl::allocate_shared<Callbacks>(
+                                    bsl::allocator<Callbacks>(d_allocator_p));
+        job->resize(end - begin);
+        for (bsl::size_t i = begin; i < end; ++i) {
+            (*job)[i - begin].swap((*batch)[i]);
+        }
+
+        if (0 != d_threadPool_p->enqueueJob(
+                    bdlf::BindUtil::bindS(d_allocator_p,
+                                          &invokeCallbacks,
+                                          job))) {
+            invokeCallbacks(job);
+        }
+
+        begin = end;
+    }
+    batch->clear();
+}
+
+void TimerWheelScheduler::dispatchEvents()
+{
+    bsl::vector<bsl::function<void()> > batch(d_allocator_p);
+
+    while (1) {
+        {
+            bslmt::LockGuard<bslmt::Mutex> lock(&d_mutex);
+
+            while (1) {
+                if (!d_running) {
+                    return;                                           // RETURN
+                }
+
+                const bsls::Types::Int64 now =
+                                   d_currentTimeFunctor().totalNanoseconds();
+
+                // Tick 'k' is due once its end, 'tickTime(k)', is reached.
+
+                const bsls::Types::Uint64 lastDueTick =
+                                        now < d_originNanoseconds
+                                        ? 0
+                                        : (now - d_originNanoseconds)
+                                                           / d_tickNanoseconds;
+
+                while (d_nextTick <= lastDueTick
+                    && batch.size() < k_MAX_COLLECTED) {
+                    skipEmptyTicks(lastDueTick + 1);
+                    if (d_nextTick <= lastDueTick) {
+                        processTick(&batch);
+                    }
+                }
+
+                if (!batch.empty()) {
+                    break;
+                }
+
+                d_wakeTick = nextWakeTick();
+                if (k_MAX_TICK == d_wakeTick) {
+                    d_condition.wait(&d_mutex);
+                }
+                else {
+                    d_condition.timedWait(&d_mutex, tickTime(d_wakeTick));
+                }
+                d_wakeTick = 0;
+            }
+        }
+
+        dispatchBatch(&batch);
+    }
+}
+
+void TimerWheelScheduler::insertNode(int index)
+{
+    Node& node = d_nodes[index];
+
+    BSLS_ASSERT(k_FREE == node.d_list);
+
+    const int list = listIndex(bsl::max(node.d_tick, d_nextTick));
+
+    node.d_list = list;
+    node.d_prev = k_NONE;
+    node.d_next = d_lists[list];
+    if (k_NONE != node.d_next) {
+        d_nodes[node.d_next].d_prev = index;
+    }
+    d_lists[list] = index;
+    ++d_levelCounts[list / k_NUM_SLOTS];
+
+    if (node.d_tick < d_wakeTick) {
+        d_condition.signal();
+    }
+}
+
+void TimerWheelScheduler::processTick(
+                                   bsl::vector<bsl::function<void()> > *batch)
+{
+    const bsls::Types::Uint64 tick = d_nextTick;
+
+    // Cascade the higher levels, highest first.
+
+    if (0 == (tick & ((bsls::Types::Uint64(1) << (k_SLOT_BITS * k_NUM_LEVELS))
+                                                                      - 1))) {
+        cascade(k_OVERFLOW_LIST);
+    }
+    for (int level = k_NUM_LEVELS - 1; 0 < level; --level) {
+        const int shift = k_SLOT_BITS * level;
+        if (0 == (tick & ((bsls::Types::Uint64(1) << shift) - 1))) {
+            cascade(level * k_NUM_SLOTS
+                  + static_cast<int>((tick >> shift) & (k_NUM_SLOTS - 1)));
+        }
+    }
+
+    // Collect the nodes due at 'tick'.  Clocks are reinserted for their next
+    // occurrence, which is due at 'tick + 1' at the earliest.
+
+    const int list = static_cast<int>(tick & (k_NUM_SLOTS - 1));
+
+    int index = d_lists[list];
+    d_lists[list] = k_NONE;
+    ++d_nextTick;
+
+    while (k_NONE != index) {
+        Node&     node = d_nodes[index];
+        const int next = node.d_next;
+
+        --d_levelCounts[0];
+        node.d_list = k_FREE;
+
+        if (0 == node.d_interval) {
+            batch->resize(batch->size() + 1);
+            releaseNode(index, &batch->back());
+            --d_numEvents;
+        }
+        else {
+            batch->push_back(d_callbacks[index]);
+            node.d_time += node.d_interval;
+            node.d_tick  = toTick(node.d_time);
+            insertNode(index);
+        }
+
+        index = next;
+    }
+}
+
+void TimerWheelScheduler::releaseNode(int                    index,
+                                      bsl::function<void()> *callback)
+{
+    Node& node = d_nodes[index];
+
+    BSLS_ASSERT(k_FREE == node.d_list);
+
+    d_callbacks[index].swap(*callback);
+
+    ++node.d_generation;
+    node.d_next = d_freeList;
+    d_freeList  = index;
+}
+
+void TimerWheelScheduler::skipEmptyTicks(bsls::Types::Uint64 limit)
+{
+    int level = 0;
+    while (level <= k_NUM_LEVELS && 0 == d_levelCounts[level]) {
+        ++level;
+    }
+
+    if (0 == level) {
+        return;                                                       // RETURN
+    }
+
+    if (k_NUM_LEVELS < level) {
+        d_nextTick = limit;
+        return;                                                       // RETURN
+    }
+
+    // Round 'd_nextTick' up to the next multiple of '2^(8 * level)', the
+    // next tick at which a list of 'level' may be cascaded.
+
+    const bsls::Types::Uint64 mask =
+                        (bsls::Types::Uint64(1) << (k_SLOT_BITS * level)) - 1;
+
+    d_nextTick = bsl::min(limit, ((d_nextTick - 1) | mask) + 1);
+}
+
+void TimerWheelScheduler::unlinkNode(int index)
+{
+    Node& node = d_nodes[index];
+
+    BSLS_ASSERT(k_FREE != node.d_list);
+
+    if (k_NONE != node.d_prev) {
+        d_nodes[node.d_prev].d_next = node.d_next;
+    }
+    else {
+        d_lists[node.d_list] = node.d_next;
+    }
+    if (k_NONE != node.d_next) {
+        d_nodes[node.d_next].d_prev = node.d_prev;
+    }
+
+    --d_levelCounts[node.d_list / k_NUM_SLOTS];
+    node.d_list = k_FREE;
+}
+
+// PRIVATE ACCESSORS
+int TimerWheelScheduler::findNode(Handle handle, bool clockFlag) const
+{
+    if (0 > handle) {
+        return k_NONE;                                                // RETURN
+    }
+
+    const bsls::Types::Uint64 value = static_cast<bsls::Types::Uint64>(handle);
+    const bsls::Types::Uint64 index = value & 0xffffffffULL;
+
+    if (index >= d_nodes.size()) {
+        return k_NONE;                                                // RETURN
+    }
+
+    const Node& node = d_nodes[static_cast<bsl::size_t>(index)];
+
+    if (k_FREE == node.d_list
+     || (node.d_generation & 0x7fffffffU) != (value >> 32)
+     || clockFlag != (0 != node.d_interval)) {
+        return k_NONE;                                                // RETURN
+    }
+
+    return static_cast<int>(index);
+}
+
+int TimerWheelScheduler::listIndex(bsls::Types::Uint64 tick) const
+{
+    BSLS_ASSERT(d_nextTick <= tick);
+
+    const bsls::Types::Uint64 difference = tick ^ d_nextTick;
+
+    for (int level = 0; level < k_NUM_LEVELS; ++level) {
+        const int shift = k_SLOT_BITS * level;
+        if (0 == (difference >> (shift + k_SLOT_BITS))) {
+            return level * k_NUM_SLOTS                                // RETURN
+                 + static_cast<int>((tick >> shift) & (k_NUM_SLOTS - 1));
+        }
+    }
+
+    return k_OVERFLOW_LIST;
+}
+
+bsls::Types::Uint64 TimerWheelScheduler::nextWakeTick() const
+{
+    if (0 != d_levelCounts[0]) {
+        // The nodes at level 0 are in the slots from that of 'd_nextTick' to
+        // the end of the wheel.
+
+        bsls::Types::Uint64 tick = d_nextTick;
+        while (k_NONE == d_lists[tick & (k_NUM_SLOTS - 1)]) {
+            ++tick;
+        }
+        return tick;                                                  // RETURN
+    }
+
+    for (int level = 1; level <= k_NUM_LEVELS; ++level) {
+        if (0 != d_levelCounts[level]) {
+            const bsls::Types::Uint64 mask =
+                        (bsls::Types::Uint64(1) << (k_SLOT_BITS * level)) - 1;
+            return ((d_nextTick - 1) | mask) + 1;                     // RETURN
+        }
+    }
+
+    return k_MAX_TICK;
+}
+
+bsls::TimeInterval TimerWheelScheduler::tickTime(
+                                               bsls::Types::Uint64 tick) const
+{
+    bsls::TimeInterval result;
+    result.addNanoseconds(d_originNanoseconds);
+    result.addNanoseconds(static_cast<bsls::Types::Int64>(tick)
+                                                         * d_tickNanoseconds);
+    return result;
+}
+
+bsls::Types::Uint64 TimerWheelScheduler::toTick(
+                                        bsls::Types::Int64 nanoseconds) const
+{
+    if (nanoseconds <= d_originNanoseconds) {
+        return 0;                                                     // RETURN
+    }
+
+    return (nanoseconds - d_originNanoseconds + d_tickNanoseconds - 1)
+                                                          / d_tickNanoseconds;
+}
+
+// CREATORS
+TimerWheelScheduler::TimerWheelScheduler(bslma::Allocator *basicAllocator)
+: d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_currentTimeFunctor(bsl::allocator_arg_t(),
+                       basicAllocator,
+                       createDefaultCurrentTimeFunctor(
+                                            bsls::SystemClockType::e_REALTIME))
+, d_clockType(bsls::SystemClockType::e_REALTIME)
+, d_tickNanoseconds(k_DEFAULT_TICK_NANOSECONDS)
+, d_originNanoseconds(d_currentTimeFunctor().totalNanoseconds())
+, d_threadPool_p(0)
+, d_maxBatchSize(k_DEFAULT_MAX_BATCH_SIZE)
+, d_nodes(basicAllocator)
+, d_callbacks(basicAllocator)
+, d_freeList(k_NONE)
+, d_nextTick(0)
+, d_wakeTick(0)
+, d_numEvents(0)
+, d_numClocks(0)
+, d_condition(bsls::SystemClockType::e_REALTIME)
+, d_dispatcherThread(bslmt::ThreadUtil::invalidHandle())
+, d_running(false)
+{
+    bsl::fill(d_lists, d_lists + k_NUM_LISTS, static_cast<int>(k_NONE));
+    bsl::fill(d_levelCounts, d_levelCounts + k_NUM_LEVELS + 1, 0);
+}
+
+TimerWheelScheduler::TimerWheelScheduler(
+                                const bsls::TimeInterval&  tickInterval,
+                                bslma::Allocator          *basicAllocator)
+: d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_currentTimeFunctor(bsl::allocator_arg_t(),
+                       basicAllocator,
+                       createDefaultCurrentTimeFunctor(
+                                            bsls::SystemClockType::e_REALTIME))
+, d_clockType(bsls::SystemClockType::e_REALTIME)
+, d_tickNanoseconds(tickInterval.totalNanoseconds())
+, d_originNanoseconds(d_currentTimeFunctor().totalNanoseconds())
+, d_threadPool_p(0)
+, d_maxBatchSize(k_DEFAULT_MAX_BATCH_SIZE)
+, d_nodes(basicAllocator)
+, d_callbacks(basicAllocator)
+, d_freeList(k_NONE)
+, d_nextTick(0)
+, d_wakeTick(0)
+, d_numEvents(0)
+, d_numClocks(0)
+, d_condition(bsls::SystemClockType::e_REALTIME)
+, d_dispatcherThread(bslmt::ThreadUtil::invalidHandle())
+, d_running(false)
+{
+    BSLS_ASSERT(0 < d_tickNanoseconds);
+
+    bsl::fill(d_lists, d_lists + k_NUM_LISTS, static_cast<int>(k_NONE));
+    bsl::fill(d_levelCounts, d_levelCounts + k_NUM_LEVELS + 1, 0);
+}
+
+TimerWheelScheduler::TimerWheelScheduler(
+                              const bsls::TimeInterval&    tickInterval,
+                              bsls::SystemClockType::Enum  clockType,
+                              bslma::Allocator            *basicAllocator)
+: d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_currentTimeFunctor(bsl::allocator_arg_t(),
+                       basicAllocator,
+                       createDefaultCurrentTimeFunctor(clockType))
+, d_clockType(clockType)
+, d_tickNanoseconds(tickInterval.totalNanoseconds())
+, d_originNanoseconds(d_currentTimeFunctor().totalNanoseconds())
+, d_threadPool_p(0)
+, d_maxBatchSize(k_DEFAULT_MAX_BATCH_SIZE)
+, d_nodes(basicAllocator)
+, d_callbacks(basicAllocator)
+, d_freeList(k_NONE)
+, d_nextTick(0)
+, d_wakeTick(0)
+, d_numEvents(0)
+, d_numClocks(0)
+, d_condition(clockType)
+, d_dispatcherThread(bslmt::ThreadUtil::invalidHandle())
+, d_running(false)
+{
+    BSLS_ASSERT(0 < d_tickNanoseconds);
+
+    bsl::fill(d_lists, d_lists + k_NUM_LISTS, static_cast<int>(k_NONE));
+    bsl::fill(d_levelCounts, d_levelCounts + k_NUM_LEVELS + 1, 0);
+}
+
+TimerWheelScheduler::TimerWheelScheduler(
+                              const bsls::TimeInterval&    tickInterval,
+                              bsls::SystemClockType::Enum  clockType,
+                              ThreadPool                  *threadPool,
+                              int                          maxBatchSize,
+                              bslma::Allocator            *basicAllocator)
+: d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_currentTimeFunctor(bsl::allocator_arg_t(),
+                       basicAllocator,
+                       createDefaultCurrentTimeFunctor(clockType))
+, d_clockType(clockType)
+, d_tickNanoseconds(tickInterval.totalNanoseconds())
+, d_originNanoseconds(d_currentTimeFunctor().totalNanoseconds())
+, d_threadPool_p(threadPool)
+, d_maxBatchSize(maxBatchSize)
+, d_nodes(basicAllocator)
+, d_callbacks(basicAllocator)
+, d_freeList(k_NONE)
+, d_nextTick(0)
+, d_wakeTick(0)
+, d_numEvents(0)
+, d_numClocks(0)
+, d_condition(clockType)
+, d_dispatcherThread(bslmt::ThreadUtil::invalidHandle())
+, d_running(false)
+{
+    BSLS_ASSERT(0 < d_tickNanoseconds);
+    BSLS_ASSERT(threadPool);
+    BSLS_ASSERT(0 < maxBatchSize);
+
+    bsl::fill(d_lists, d_lists + k_NUM_LISTS, static_cast<int>(k_NONE));
+    bsl::fill(d_levelCounts, d_levelCounts + k_NUM_LEVELS + 1, 0);
+}
+
+TimerWheelScheduler::~TimerWheelScheduler()
+{
+    stop();
+}
+
+// MANIPULATORS
+void TimerWheelScheduler::cancelAllClocks()
+{
+    bsl::vector<bsl::function<void()> > callbacks(d_allocator_p);
+
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_mutex);
+
+    callbacks.reserve(d_numClocks.loadRelaxed());
+    for (int i = 0; i < static_cast<int>(d_nodes.size()); ++i) {
+        if (k_FREE != d_nodes[i].d_list && 0 != d_nodes[i].d_interval) {
+            unlinkNode(i);
+            callbacks.resize(callbacks.size() + 1);
+            releaseNode(i, &callbacks.back());
+            --d_numClocks;
+        }
+    }
+
+    // Note that 'callbacks' is destroyed after the lock is released.
+}
+
+void TimerWheelScheduler::cancelAllEvents()
+{
+    bsl::vector<bsl::function<void()> > callbacks(d_allocator_p);
+
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_mutex);
+
+    callbacks.reserve(d_numEvents.loadRelaxed());
+    for (int i = 0; i < static_cast<int>(d_nodes.size()); ++i) {
+        if (k_FREE != d_nodes[i].d_list && 0 == d_nodes[i].d_interval) {
+            unlinkNode(i);
+            callbacks.resize(callbacks.size() + 1);
+            releaseNode(i, &callbacks.back());
+            --d_numEvents;
+        }
+    }
+}
+
+int TimerWheelScheduler::cancelClock(Handle handle)
+{
+    bsl::function<void()> callback(bsl::allocator_arg_t(), d_allocator_p);
+
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_mutex);
+
+    const int index = findNode(handle, true);
+    if (k_NONE == index) {
+        return -1;                                                    // RETURN
+    }
+
+    unlinkNode(index);
+    releaseNode(index, &callback);
+    --d_numClocks;
+
+    return 0;
+}
+
+int TimerWheelScheduler::cancelEvent(Handle handle)
+{
+    bsl::function<void()> callback(bsl::allocator_arg_t(), d_allocator_p);
+
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_mutex);
+
+    const int index = findNode(handle, false);
+    if (k_NONE == index) {
+        return -1;                                                    // RETURN
+    }
+
+    unlinkNode(index);
+    releaseNode(index, &callback);
+    --d_numEvents;
+
+    return 0;
+}
+
+int TimerWheelScheduler::rescheduleEvent(Handle                    handle,
+                                         const bsls::TimeInterval& newTime)
+{
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_mutex);
+
+    const int index = findNode(handle, false);
+    if (k_NONE == index) {
+        return -1;                                                    // RETURN
+    }
+
+    Node& node = d_nodes[index];
+
+    node.d_time = newTime.totalNanoseconds();
+    node.d_tick = toTick(node.d_time);
+
+    // Moving a node within its slot is not needed.
+
+    if (node.d_list != listIndex(bsl::max(node.d_tick, d_nextTick))) {
+        unlinkNode(index);
+        insertNode(index);
+    }
+
+    return 0;
+}
+
+TimerWheelScheduler::Handle
+TimerWheelScheduler::scheduleEvent(const bsls::TimeInterval&    time,
+                                   const bsl::function<void()>& callback)
+{
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_mutex);
+
+    const int index = acquireNode(callback);
+    Node&     node  = d_nodes[index];
+
+    node.d_time     = time.totalNanoseconds();
+    node.d_interval = 0;
+    node.d_tick     = toTick(node.d_time);
+    insertNode(index);
+
+    ++d_numEvents;
+
+    return (static_cast<Handle>(node.d_generation & 0x7fffffffU) << 32)
+         | index;
+}
+
+int TimerWheelScheduler::start()
+{
+    bslmt::ThreadAttributes attr;
+
+    return start(attr);
+}
+
+int TimerWheelScheduler::start(
+                              const bslmt::ThreadAttributes& threadAttributes)
+{
+    BSLS_ASSERT(!bslmt::ThreadUtil::isEqual(bslmt::ThreadUtil::self(),
+                                            d_dispatcherThread));
+
+    // Implementation note: 'd_dispatcherMutex' is in a lock hierarchy with
+    // 'd_mutex' and must be locked first.
+
+    bslmt::LockGuard<bslmt::Mutex> dispatcherLock(&d_dispatcherMutex);
+
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_mutex);
+    if (d_running) {
+        return 0;                                                     // RETURN
+    }
+
+    bslmt::ThreadAttributes modAttr(threadAttributes);
+    modAttr.setDetachedState(bslmt::ThreadAttributes::e_CREATE_JOINABLE);
+
+    if (bslmt::ThreadUtil::createWithAllocator(
+              &d_dispatcherThread,
+              modAttr,
+              bdlf::BindUtil::bind(&TimerWheelScheduler::dispatchEvents, this),
+              d_allocator_p)) {
+        return -1;                                                    // RETURN
+    }
+
+    d_running = true;
+    return 0;
+}
+
+TimerWheelScheduler::Handle
+TimerWheelScheduler::startClock(const bsls::TimeInterval&    interval,
+                                const bsl::function<void()>& callback,
+                                const bsls::TimeInterval&    startTime)
+{
+    BSLS_ASSERT(0 < interval.totalNanoseconds());
+
+    const bsls::TimeInterval time = bsls::TimeInterval(0) == startTime
+                                    ? now() + interval
+                                    : startTime;
+
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_mutex);
+
+    const int index = acquireNode(callback);
+    Node&     node  = d_nodes[index];
+
+    node.d_time     = time.totalNanoseconds();
+    node.d_interval = interval.totalNanoseconds();
+    node.d_tick     = toTick(node.d_time);
+    insertNode(index);
+
+    ++d_numClocks;
+
+    return (static_cast<Handle>(node.d_generation & 0x7fffffffU) << 32)
+         | index;
+}
+
+void TimerWheelScheduler::stop()
+{
+    BSLS_ASSERT(!bslmt::ThreadUtil::isEqual(bslmt::ThreadUtil::self(),
+                                            d_dispatcherThread));
+
+    bslmt::LockGuard<bslmt::Mutex> dispatcherLock(&d_dispatcherMutex);
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> lock(&d_mutex);
+        if (!d_running) {
+            return;                                                   // RETURN
+        }
+
+        d_running = false;
+        d_condition.signal();
+    }
+
+    bslmt::ThreadUtil::join(d_dispatcherThread);
+    d_dispatcherThread = bslmt::ThreadUtil::invalidHandle();
+}
+
+                  // ---------------------------------------
+                  // class TimerWheelSchedulerTestTimeSource
+                  // ---------------------------------------
+
+// CREATORS
+TimerWheelSchedulerTestTimeSource::TimerWheelSchedulerTestTimeSource(
+                                                TimerWheelScheduler *scheduler)
+: d_scheduler_p(scheduler)
+{
+    BSLS_ASSERT(0 != scheduler);
+
+    // As for 'bdlmt::TimerEventSchedulerTestTimeSource', the time source
+    // starts 1000 days in the future, so that the system clock (which
+    // controls the timed waits of the dispatcher thread) lags behind it in any
+    // reasonable test driver, and the dispatcher thread sleeps until the next
+    // call to 'advanceTime'.  The data uses the default allocator since its
+    // lifetime is shared between this object and the scheduler.
+
+    d_data_p = bsl::make_shared<TimerWheelSchedulerTestTimeSource_Data>(
+                                  bsls::SystemTime::now(scheduler->d_clockType)
+                                + bsls::TimeInterval(1000 * 24 * 60 * 60, 0));
+
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_scheduler_p->d_mutex);
+
+    d_scheduler_p->d_currentTimeFunctor = bdlf::BindUtil::bind(
+                          &TimerWheelSchedulerTestTimeSource_Data::currentTime,
+                          d_data_p);
+    d_scheduler_p->d_originNanoseconds =
+                                   d_data_p->currentTime().totalNanoseconds();
+}
+
+// MANIPULATORS
+bsls::TimeInterval TimerWheelSchedulerTestTimeSource::advanceTime(
+                                                     bsls::TimeInterval amount)
+{
+    BSLS_ASSERT(amount > 0);
+
+    bsls::TimeInterval ret = d_data_p->advanceTime(amount);
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> lock(&d_scheduler_p->d_mutex);
+        d_scheduler_p->d_condition.signal();
+    }
+
+    return ret;
+}
+
+// ACCESSORS
+bsls::TimeInterval TimerWheelSchedulerTestTimeSource::now() const
+{
+    return d_data_p->currentTime();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License.  You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
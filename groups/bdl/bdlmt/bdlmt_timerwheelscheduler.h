@@ -0,0 +1,731 @@
+// bdlmt_timerwheelscheduler.h                                        -*-C++-*-
+#ifndef INCLUDED_BDLMT_TIMERWHEELSCHEDULER
+#define INCLUDED_BDLMT_TIMERWHEELSCHEDULER
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an event scheduler with constant-time schedule and cancel.
+//
+//@CLASSES:
+//  bdlmt::TimerWheelScheduler: hierarchical timer-wheel event scheduler
+//  bdlmt::TimerWheelSchedulerTestTimeSource: test clock for the scheduler
+//
+//@SEE_ALSO: bdlmt_timereventscheduler, bdlmt_eventscheduler, bdlmt_threadpool
+//
+//@DESCRIPTION: This component provides a thread-safe event scheduler,
+// 'bdlmt::TimerWheelScheduler', that keeps its recurring and non-recurring
+// events in a hashed, hierarchical timer wheel rather than in an ordered
+// queue.  Scheduling, rescheduling, and cancelling an event take constant
+// time, independent of the number of events being managed, which makes this
+// component well suited to managing large numbers of timeouts, most of which
+// are cancelled before they expire.  The interface of this class follows that
+// of 'bdlmt::TimerEventScheduler': events and clocks are identified by
+// integral handles that need not be released.
+//
+///Comparison to 'bdlmt::EventScheduler' and 'bdlmt::TimerEventScheduler'
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// 'bdlmt::EventScheduler' and 'bdlmt::TimerEventScheduler' keep their events
+// ordered by time, so that adding or removing an event costs (at least)
+// logarithmic time, and each event is dispatched as soon as its time is
+// reached.  'bdlmt::TimerWheelScheduler' quantizes time into *ticks* of a
+// granularity supplied at construction (one millisecond by default), and
+// events due in the same tick are not ordered with respect to one another.
+// An event is never dispatched before its scheduled time, but may be
+// dispatched up to one tick after it (in addition to any delay due to thread
+// contention).  Events due in different ticks are dispatched in increasing
+// order of their ticks.
+//
+///The Timer Wheel
+///---------------
+// The scheduler maintains four wheels of 256 slots each.  The first wheel
+// holds the events due within the current block of 256 ticks, one slot per
+// tick; each subsequent wheel holds, one slot per block, the events due in the
+// subsequent blocks of the next larger block size (256 times larger than that
+// of the previous wheel).  The events in a slot of a higher wheel are
+// redistributed ("cascaded") to the lower wheels when the current tick reaches
+// the block the slot represents.  Events due more than 2^32 ticks in the
+// future are kept in an overflow list, which is examined once every 2^32
+// ticks.  Each event is therefore moved at most four times before it is
+// dispatched, and ticks for which no events are scheduled are skipped.
+//
+///The Dispatcher Thread and Batched Dispatch
+///------------------------------------------
+// Between calls to 'start' and 'stop', the scheduler runs a separate thread
+// (called the *dispatcher thread*) that collects, for each tick that has
+// elapsed, the callbacks of the events that are due, and then dispatches the
+// collected callbacks as a batch, without holding the lock of the scheduler.
+// By default the callbacks are invoked in the dispatcher thread.
+// Alternatively, a 'bdlmt::ThreadPool' may be supplied at construction, in
+// which case each batch is divided into jobs of at most a (configurable)
+// maximum number of callbacks, each of which is enqueued to the thread pool as
+// a single job; the callbacks of a job are invoked in order.  Should enqueuing
+// a job fail (e.g., because the thread pool is not started), its callbacks are
+// invoked in the dispatcher thread.
+//
+// Note that a callback that has been collected for dispatch can no longer be
+// cancelled: 'cancelEvent' (or 'cancelClock', for the current occurrence of a
+// clock) fails for a callback that is about to be dispatched, or is being
+// dispatched.
+//
+///Thread Safety
+///-------------
+// 'bdlmt::TimerWheelScheduler' is fully thread-safe, meaning that all
+// non-creator methods can be invoked concurrently, and is thread-enabled.
+// Callbacks may schedule and cancel events, but must not invoke 'stop'.
+//
+///Supported Clock-Types
+///---------------------
+// The component 'bsls::SystemClockType' supplies the enumeration indicating
+// the system clock on which times supplied to other methods should be based.
+// If the clock type indicated at construction is
+// 'bsls::SystemClockType::e_REALTIME', time should be expressed as an absolute
+// offset since 00:00:00 UTC, January 1, 1970.  If the clock type indicated at
+// construction is 'bsls::SystemClockType::e_MONOTONIC', time should be
+// expressed as an absolute offset since the epoch of this clock.  The current
+// time according to the clock of a scheduler is available via its 'now'
+// accessor.
+//
+///Event Clock Substitution
+///------------------------
+// For testing purposes, a class 'bdlmt::TimerWheelSchedulerTestTimeSource' is
+// provided to allow manual manipulation of the system-time observed by a
+// 'bdlmt::TimerWheelScheduler', in the same manner as
+// 'bdlmt::TimerEventSchedulerTestTimeSource' for
+// 'bdlmt::TimerEventScheduler'.  A test time-source must be created before any
+// events are scheduled on the scheduler, and before the scheduler is started.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Managing Connection Timeouts
+///- - - - - - - - - - - - - - - - - - - -
+// A server closes each of its connections if no data arrives on it within a
+// timeout, and re-arms the timeout every time data arrives.  Since data
+// usually arrives in time, almost every timeout is cancelled, which a
+// 'bdlmt::TimerWheelScheduler' does in constant time.  The timeouts need not
+// be accurate to better than 10 milliseconds, so we use that as the tick of
+// the scheduler.
+//
+// First, we define a 'Connection' type holding the handle of its timeout, and
+// a server managing a set of connections:
+//..
+//  struct Connection {
+//      // This 'struct' represents a connection of a server.
+//
+//      bdlmt::TimerWheelScheduler::Handle d_timeout;  // timeout event
+//      bool                               d_closed;   // 'true' if timed out
+//  };
+//
+//  class Server {
+//      // This class implements a server closing idle connections.
+//
+//      // DATA
+//      bsls::TimeInterval          d_ioTimeout;  // time out
+//      bdlmt::TimerWheelScheduler  d_scheduler;  // timeout scheduler
+//
+//    private:
+//      // PRIVATE MANIPULATORS
+//      void closeConnection(Connection *connection);
+//          // Close the specified 'connection'.
+//
+//    public:
+//      // CREATORS
+//      explicit Server(const bsls::TimeInterval& ioTimeout);
+//          // Create a server closing connections on which no data arrives
+//          // for the specified 'ioTimeout'.
+//
+//      ~Server();
+//          // Destroy this object.
+//
+//      // MANIPULATORS
+//      void dataAvailable(Connection *connection);
+//          // Process the arrival of data on the specified 'connection'.
+//
+//      void newConnection(Connection *connection);
+//          // Start monitoring the specified 'connection'.
+//  };
+//..
+// Then, we implement the constructor and destructor, which start and stop the
+// dispatcher thread of the scheduler:
+//..
+//  Server::Server(const bsls::TimeInterval& ioTimeout)
+//  : d_ioTimeout(ioTimeout)
+//  , d_scheduler(bsls::TimeInterval(0.01),
+//                bsls::SystemClockType::e_MONOTONIC)
+//  {
+//      d_scheduler.start();
+//  }
+//
+//  Server::~Server()
+//  {
+//      d_scheduler.stop();
+//  }
+//..
+// Next, we implement the closing of a connection, which the scheduler invokes
+// when the timeout of the connection expires:
+//..
+//  void Server::closeConnection(Connection *connection)
+//  {
+//      connection->d_closed = true;
+//  }
+//..
+// Then, we arm the timeout of a new connection:
+//..
+//  void Server::newConnection(Connection *connection)
+//  {
+//      connection->d_closed  = false;
+//      connection->d_timeout = d_scheduler.scheduleEvent(
+//                    d_scheduler.now() + d_ioTimeout,
+//                    bdlf::BindUtil::bind(&Server::closeConnection,
+//                                         this,
+//                                         connection));
+//  }
+//..
+// Next, we re-arm the timeout when data arrives, unless the connection has
+// already timed out (in which case 'rescheduleEvent' fails):
+//..
+//  void Server::dataAvailable(Connection *connection)
+//  {
+//      const bsls::TimeInterval timeout = d_scheduler.now() + d_ioTimeout;
+//
+//      if (0 != d_scheduler.rescheduleEvent(connection->d_timeout, timeout)) {
+//          return;                                                   // RETURN
+//      }
+//
+//      // process the data
+//  }
+//..
+// Finally, we create a server and a connection, and observe that the
+// connection is closed once data stops arriving:
+//..
+//  Server     server(bsls::TimeInterval(0.05));
+//  Connection connection;
+//
+//  server.newConnection(&connection);
+//  for (int i = 0; i < 5; ++i) {
+//      bslmt::ThreadUtil::microSleep(10 * 1000);
+//      server.dataAvailable(&connection);
+//  }
+//  assert(false == connection.d_closed);
+//
+//  bslmt::ThreadUtil::microSleep(500 * 1000);
+//  assert(true  == connection.d_closed);
+//..
+
+#include <bdlscm_version.h>
+
+#include <bslma_allocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bslmt_condition.h>
+#include <bslmt_mutex.h>
+#include <bslmt_threadattributes.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_atomic.h>
+#include <bsls_systemclocktype.h>
+#include <bsls_timeinterval.h>
+#include <bsls_types.h>
+
+#include <bsl_deque.h>
+#include <bsl_functional.h>
+#include <bsl_memory.h>
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace bdlmt {
+
+class ThreadPool;
+class TimerWheelSchedulerTestTimeSource_Data;
+
+                         // =========================
+                         // class TimerWheelScheduler
+                         // =========================
+
+class TimerWheelScheduler {
+    // This class provides a thread-safe event scheduler keeping its events in
+    // a hierarchical timer wheel.  'scheduleEvent' schedules a non-recurring
+    // event, returning a handle that can be used to reschedule the event by
+    // invoking 'rescheduleEvent', or to cancel it by invoking 'cancelEvent'.
+    // Similarly, 'startClock' schedules a recurring event, returning a handle
+    // that can be used to cancel the clock by invoking 'cancelClock'.  All of
+    // these operations take constant time.  The callbacks are collected by a
+    // separate thread (called the dispatcher thread) and invoked either in
+    // that thread or, if a thread pool is supplied at construction, in the
+    // threads of that pool.  'start' must be invoked to start dispatching the
+    // callbacks, and 'stop' stops the dispatching of the callbacks without
+    // removing the pending events.
+
+  public:
+    // TYPES
+    typedef bsls::Types::Int64 Handle;
+        // Defines a type alias for a handle that identifies a scheduled clock
+        // or event.
+
+    // CONSTANTS
+    enum {
+        e_INVALID_HANDLE = -1  // value of an invalid event or clock handle
+    };
+
+    enum {
+        k_DEFAULT_MAX_BATCH_SIZE = 64  // default maximum number of callbacks
+                                       // enqueued to a thread pool as a
+                                       // single job
+    };
+
+  private:
+    // PRIVATE TYPES
+    typedef bsl::function<bsls::TimeInterval()> CurrentTimeFunctor;
+
+    enum {
+        k_SLOT_BITS       = 8,                              // bits per wheel
+        k_NUM_SLOTS       = 1 << k_SLOT_BITS,               // slots per wheel
+        k_NUM_LEVELS      = 4,                              // wheels
+        k_OVERFLOW_LIST   = k_NUM_LEVELS * k_NUM_SLOTS,     // list of far
+                                                            // events
+        k_NUM_LISTS       = k_OVERFLOW_LIST + 1,            // all lists
+        k_FREE            = -1,                             // 'd_list' of a
+                                                            // free node
+        k_NONE            = -1                              // null link
+    };
+
+    struct Node {
+        // This 'struct' holds the scheduling state of an event or clock.  The
+        // callback of the node having index 'i' is 'd_callbacks[i]'.
+
+        bsls::Types::Int64  d_time;        // due time, in nanoseconds from
+                                           // the epoch of the clock
+
+        bsls::Types::Int64  d_interval;    // period of a clock (nanoseconds),
+                                           // or 0 for an event
+
+        bsls::Types::Uint64 d_tick;        // tick in which the node is due
+
+        int                 d_next;        // next node in the same list, or
+                                           // in the free list
+
+        int                 d_prev;        // previous node in the same list
+
+        int                 d_list;        // index of the list holding the
+                                           // node, or 'k_FREE'
+
+        unsigned int        d_generation;  // incremented on each release of
+                                           // the node, to invalidate handles
+    };
+
+    // DATA
+    bslma::Allocator                   *d_allocator_p;   // memory allocator
+                                                         // (held)
+
+    CurrentTimeFunctor                  d_currentTimeFunctor;
+                                                         // when called,
+                                                         // returns the
+                                                         // current time
+
+    bsls::SystemClockType::Enum         d_clockType;     // clock type used
+
+    bsls::Types::Int64                  d_tickNanoseconds;
+                                                         // tick granularity
+
+    bsls::Types::Int64                  d_originNanoseconds;
+                                                         // time of tick 0
+
+    ThreadPool                         *d_threadPool_p;  // pool running the
+                                                         // callbacks, or 0
+                                                         // (held)
+
+    int                                 d_maxBatchSize;  // maximum number of
+                                                         // callbacks per
+                                                         // thread pool job
+
+    bsl::vector<Node>                   d_nodes;         // events and clocks
+
+    bsl::deque<bsl::function<void()> >  d_callbacks;     // callbacks of
+                                                         // 'd_nodes'
+
+    int                                 d_freeList;      // first free node,
+                                                         // or 'k_NONE'
+
+    int                                 d_lists[k_NUM_LISTS];
+                                                         // first node of each
+                                                         // slot, and of the
+                                                         // overflow list
+
+    int                                 d_levelCounts[k_NUM_LEVELS + 1];
+                                                         // number of nodes in
+                                                         // each wheel, and in
+                                                         // the overflow list
+
+    bsls::Types::Uint64                 d_nextTick;      // next tick to be
+                                                         // processed
+
+    bsls::Types::Uint64                 d_wakeTick;      // tick at which the
+                                                         // waiting dispatcher
+                                                         // wakes up, or 0 if
+                                                         // it is not waiting
+
+    bsls::AtomicInt                     d_numEvents;     // number of pending
+                                                         // events
+
+    bsls::AtomicInt                     d_numClocks;     // number of clocks
+
+    bslmt::Mutex                        d_dispatcherMutex;
+                                                         // serialize starting
+                                                         // and stopping
+
+    mutable bslmt::Mutex                d_mutex;         // protects the wheel
+
+    bslmt::Condition                    d_condition;     // wakes up the
+                                                         // dispatcher thread
+
+    bslmt::ThreadUtil::Handle           d_dispatcherThread;
+                                                         // dispatcher thread
+
+    bool                                d_running;       // 'true' between
+                                                         // 'start' and 'stop'
+
+    // FRIENDS
+    friend class TimerWheelSchedulerTestTimeSource;
+
+  private:
+    // NOT IMPLEMENTED
+    TimerWheelScheduler(const TimerWheelScheduler&);
+    TimerWheelScheduler& operator=(const TimerWheelScheduler&);
+
+    // PRIVATE MANIPULATORS
+    int acquireNode(const bsl::function<void()>& callback);
+        // Return the index of a free node, which is removed from the free
+        // list, and whose callback is set to the specified 'callback'.
+
+    void cascade(int list);
+        // Remove the nodes of the specified 'list' and insert them anew, with
+        // respect to the current value of 'd_nextTick'.
+
+    void dispatchBatch(bsl::vector<bsl::function<void()> > *batch);
+        // Invoke, or enqueue to the thread pool of this scheduler, the
+        // callbacks of the specified 'batch', and clear 'batch'.
+
+    void dispatchEvents();
+        // Run the dispatcher thread until 'stop' is invoked.
+
+    void insertNode(int index);
+        // Insert the node having the specified 'index' into the list for its
+        // tick, or for 'd_nextTick' if its tick has passed, and signal the
+        // dispatcher thread if it needs to wake up earlier.
+
+    void processTick(bsl::vector<bsl::function<void()> > *batch);
+        // Cascade the lists of the higher wheels that are due at
+        // 'd_nextTick', append to the specified 'batch' the callbacks of the
+        // events and clocks due at 'd_nextTick', and increment 'd_nextTick'.
+
+    void releaseNode(int index, bsl::function<void()> *callback);
+        // Return the node having the specified 'index' to the free list,
+        // invalidating the handles to it, and swap its callback with the
+        // specified 'callback'.  The behavior is undefined unless the node is
+        // not in any list.
+
+    void skipEmptyTicks(bsls::Types::Uint64 limit);
+        // Advance 'd_nextTick' over ticks for which no node may be due and
+        // for which no list needs to be cascaded, but not beyond the
+        // specified 'limit'.
+
+    void unlinkNode(int index);
+        // Remove the node having the specified 'index' from its list.
+
+    // PRIVATE ACCESSORS
+    int findNode(Handle handle, bool clockFlag) const;
+        // Return the index of the node identified by the specified 'handle' if
+        // it refers to a scheduled clock (if the specified 'clockFlag' is
+        // 'true') or event (otherwise), and 'k_NONE' otherwise.
+
+    int listIndex(bsls::Types::Uint64 tick) const;
+        // Return the index of the list holding the nodes due at the specified
+        // 'tick', with respect to the current value of 'd_nextTick'.  The
+        // behavior is undefined unless 'd_nextTick <= tick'.
+
+    bsls::Types::Uint64 nextWakeTick() const;
+        // Return the earliest tick at which the dispatcher thread needs to
+        // process the wheel, or the maximum 'bsls::Types::Uint64' value if
+        // the wheel is empty.
+
+    bsls::TimeInterval tickTime(bsls::Types::Uint64 tick) const;
+        // Return the time at which the specified 'tick' is due.
+
+    bsls::Types::Uint64 toTick(bsls::Types::Int64 nanoseconds) const;
+        // Return the first tick not earlier than the specified 'nanoseconds'
+        // from the epoch of the clock of this scheduler.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(TimerWheelScheduler,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit TimerWheelScheduler(bslma::Allocator *basicAllocator = 0);
+        // Create a scheduler having a tick of one millisecond, using the
+        // realtime clock epoch for all time intervals (see {Supported
+        // Clock-Types} in the component documentation), and invoking the
+        // callbacks in the dispatcher thread.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.
+
+    explicit TimerWheelScheduler(
+                          const bsls::TimeInterval&  tickInterval,
+                          bslma::Allocator          *basicAllocator = 0);
+    TimerWheelScheduler(const bsls::TimeInterval&    tickInterval,
+                        bsls::SystemClockType::Enum  clockType,
+                        bslma::Allocator            *basicAllocator = 0);
+        // Create a scheduler having a tick of the specified 'tickInterval',
+        // invoking the callbacks in the dispatcher thread.  Optionally specify
+        // a 'clockType' indicating the epoch used for all time intervals (see
+        // {Supported Clock-Types} in the component documentation).  If
+        // 'clockType' is not specified, the realtime clock is used.
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless
+        // 'bsls::TimeInterval(0, 1) <= tickInterval'.
+
+    TimerWheelScheduler(const bsls::TimeInterval&    tickInterval,
+                        bsls::SystemClockType::Enum  clockType,
+                        ThreadPool                  *threadPool,
+                        int                          maxBatchSize,
+                        bslma::Allocator            *basicAllocator = 0);
+        // Create a scheduler having a tick of the specified 'tickInterval',
+        // using the specified 'clockType' to indicate the epoch used for all
+        // time intervals (see {Supported Clock-Types} in the component
+        // documentation), and enqueuing the callbacks to the specified
+        // 'threadPool' in jobs of at most the specified 'maxBatchSize'
+        // callbacks each.  Optionally specify a 'basicAllocator' used to
+        // supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.  The behavior is undefined unless
+        // 'bsls::TimeInterval(0, 1) <= tickInterval', '0 < maxBatchSize', and
+        // 'threadPool' outlives this object.
+
+    ~TimerWheelScheduler();
+        // Stop this scheduler, discard all the unprocessed events and clocks,
+        // and destroy this object.
+
+    // MANIPULATORS
+    void cancelAllClocks();
+        // Cancel all the clocks of this scheduler.  Note that occurrences of
+        // the clocks that have already been collected for dispatch are still
+        // dispatched.
+
+    void cancelAllEvents();
+        // Cancel all the events of this scheduler that have not yet been
+        // collected for dispatch.
+
+    int cancelClock(Handle handle);
+        // Cancel the clock having the specified 'handle'.  Return 0 on
+        // success, and a non-zero value if 'handle' does not identify a clock
+        // of this scheduler.  Note that an occurrence of the clock that has
+        // already been collected for dispatch is still dispatched.
+
+    int cancelEvent(Handle handle);
+        // Cancel the event having the specified 'handle'.  Return 0 on
+        // success, and a non-zero value if 'handle' does not identify an
+        // event of this scheduler that has not yet been collected for
+        // dispatch.
+
+    int rescheduleEvent(Handle handle, const bsls::TimeInterval& newTime);
+        // Reschedule the event having the specified 'handle' at the specified
+        // 'newTime'.  Return 0 on success, and a non-zero value if 'handle'
+        // does not identify an event of this scheduler that has not yet been
+        // collected for dispatch.  The 'newTime' is an absolute time
+        // represented as an interval from the epoch of the clock indicated at
+        // construction.
+
+    Handle scheduleEvent(const bsls::TimeInterval&    time,
+                         const bsl::function<void()>& callback);
+        // Schedule the specified 'callback' to be dispatched at the specified
+        // 'time', and return a handle that can be used to reschedule or
+        // cancel the event.  The 'time' is an absolute time represented as an
+        // interval from the epoch of the clock indicated at construction.
+
+    int start();
+        // Begin dispatching events on this scheduler using default attributes
+        // for the dispatcher thread.  Return 0 on success, and a non-zero
+        // value otherwise.  If this scheduler has already been started, this
+        // method has no effect and 0 is returned.  The behavior is undefined
+        // if this method is invoked from a callback of this scheduler.  Note
+        // that any event whose time has already passed is dispatched
+        // immediately.
+
+    int start(const bslmt::ThreadAttributes& threadAttributes);
+        // Begin dispatching events on this scheduler using the specified
+        // 'threadAttributes' for the dispatcher thread (except that the
+        // detached state attribute is ignored).  Return 0 on success, and a
+        // non-zero value otherwise.  If this scheduler has already been
+        // started, this method has no effect and 0 is returned.  The behavior
+        // is undefined if this method is invoked from a callback of this
+        // scheduler.  Note that any event whose time has already passed is
+        // dispatched immediately.
+
+    Handle startClock(
+               const bsls::TimeInterval&    interval,
+               const bsl::function<void()>& callback,
+               const bsls::TimeInterval&    startTime = bsls::TimeInterval(0));
+        // Schedule a recurring event that invokes the specified 'callback' at
+        // every specified 'interval', starting at the optionally specified
+        // 'startTime', and return a handle that can be used to cancel the
+        // clock.  If no start time is specified, it is the 'interval' time
+        // from now.  The 'startTime' is an absolute time represented as an
+        // interval from the epoch of the clock indicated at construction.  The
+        // behavior is undefined unless 'bsls::TimeInterval(0, 1) <= interval'.
+
+    void stop();
+        // End the dispatching of events on this scheduler (but do not remove
+        // any pending events), and wait for the dispatcher thread to complete
+        // the dispatching of its current batch.  If this scheduler is already
+        // stopped, this method has no effect.  This scheduler can be restarted
+        // by invoking 'start'.  The behavior is undefined if this method is
+        // invoked from a callback of this scheduler.  Note that callbacks
+        // already enqueued to a thread pool may still be running after this
+        // method returns.
+
+    // ACCESSORS
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this scheduler to supply memory.
+
+    bsls::SystemClockType::Enum clockType() const;
+        // Return the value of the clock type that this object was created
+        // with.
+
+    bsls::TimeInterval now() const;
+        // Return the current epoch time, an absolute time represented as an
+        // interval from the epoch of the clock indicated at construction.
+
+    int numClocks() const;
+        // Return a *snapshot* of the number of clocks of this scheduler.
+
+    int numEvents() const;
+        // Return a *snapshot* of the number of events of this scheduler that
+        // have not yet been collected for dispatch.
+
+    bsls::TimeInterval tickInterval() const;
+        // Return the granularity of the ticks of this scheduler.
+};
+
+                  // =======================================
+                  // class TimerWheelSchedulerTestTimeSource
+                  // =======================================
+
+class TimerWheelSchedulerTestTimeSource {
+    // This class provides a means to change the clock that is used by a given
+    // scheduler to determine when events should be triggered.  Constructing a
+    // 'TimerWheelSchedulerTestTimeSource' alters the behavior of the supplied
+    // scheduler: after a test time-source is created, the scheduler runs
+    // events according to a discrete timeline, whose successive values are
+    // determined by calls to 'advanceTime' on the test time-source, and can be
+    // retrieved by calling 'now' on that test time-source.
+
+    // DATA
+    bsl::shared_ptr<TimerWheelSchedulerTestTimeSource_Data>
+                          d_data_p;       // shared pointer to the state whose
+                                          // lifetime must be as long as
+                                          // '*this' and '*d_scheduler_p'
+
+    TimerWheelScheduler  *d_scheduler_p;  // scheduler whose clock is replaced
+                                          // (held, not owned)
+
+  private:
+    // NOT IMPLEMENTED
+    TimerWheelSchedulerTestTimeSource(
+                                     const TimerWheelSchedulerTestTimeSource&);
+    TimerWheelSchedulerTestTimeSource& operator=(
+                                     const TimerWheelSchedulerTestTimeSource&);
+
+  public:
+    // CREATORS
+    explicit
+    TimerWheelSchedulerTestTimeSource(TimerWheelScheduler *scheduler);
+        // Create a test time-source object that will control the
+        // "system-time" observed by the specified 'scheduler'.  Initialize
+        // 'now' to be an arbitrary time value.  The behavior is undefined if
+        // any events or clocks have been scheduled on 'scheduler', or if
+        // 'scheduler' has been started.
+
+    // MANIPULATORS
+    bsls::TimeInterval advanceTime(bsls::TimeInterval amount);
+        // Advance this object's current-time value by the specified 'amount'
+        // of time, and notify the scheduler that the time has changed.  Return
+        // the updated current-time value.  The behavior is undefined unless
+        // 'amount' is positive, and 'now() + amount' can be represented by a
+        // 'bsls::TimeInterval'.
+
+    // ACCESSORS
+    bsls::TimeInterval now() const;
+        // Return this object's current-time value.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                         // -------------------------
+                         // class TimerWheelScheduler
+                         // -------------------------
+
+// ACCESSORS
+inline
+bslma::Allocator *TimerWheelScheduler::allocator() const
+{
+    return d_allocator_p;
+}
+
+inline
+bsls::SystemClockType::Enum TimerWheelScheduler::clockType() const
+{
+    return d_clockType;
+}
+
+inline
+bsls::TimeInterval TimerWheelScheduler::now() const
+{
+    return d_currentTimeFunctor();
+}
+
+inline
+int TimerWheelScheduler::numClocks() const
+{
+    return d_numClocks.loadRelaxed();
+}
+
+inline
+int TimerWheelScheduler::numEvents() const
+{
+    return d_numEvents.loadRelaxed();
+}
+
+inline
+bsls::TimeInterval TimerWheelScheduler::tickInterval() const
+{
+    bsls::TimeInterval result;
+    result.addNanoseconds(d_tickNanoseconds);
+    return result;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License.  You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1372 @@
+// bdlmt_timerwheelscheduler.t.cpp                                    -*-C++-*-
+
+#include <bdlmt_timerwheelscheduler.h>
+
+#include <bdlmt_eventscheduler.h>
+#include <bdlmt_threadpool.h>
+#include <bdlmt_timereventscheduler.h>
+
+#include <bdlf_bind.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+
+#include <bslmt_lockguard.h>
+#include <bslmt_mutex.h>
+#include <bslmt_semaphore.h>
+#include <bslmt_threadgroup.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_stopwatch.h>
+#include <bsls_systemtime.h>
+#include <bsls_types.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_set.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test provides an event scheduler,
+// 'bdlmt::TimerWheelScheduler', that keeps its events in a hierarchical timer
+// wheel, and a test time source, 'bdlmt::TimerWheelSchedulerTestTimeSource'.
+//
+// Most of the tests use a test time source, so that the time observed by the
+// scheduler is under the control of the test driver.  After advancing the
+// time, a test waits (for a bounded time) for the dispatcher thread to invoke
+// the callbacks that became due, and then verifies that no other callback is
+// invoked.  The cascading of events between the wheels, and the skipping of
+// ticks for which no event is due, are verified by scheduling events at
+// offsets spanning every level of the wheel (and the overflow list), and
+// advancing the time by amounts up to several times 2^32 ticks.  The thread
+// pool dispatch is verified by observing the jobs pending in a single-thread
+// pool whose thread is blocked.  Finally, a stress test has several threads
+// concurrently schedule, reschedule, and cancel events while the scheduler
+// runs on the system clock.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] TimerWheelScheduler(bslma::Allocator *basicAllocator = 0);
+// [ 2] TimerWheelScheduler(const TimeInterval& tick, Allocator *a = 0);
+// [ 2] TimerWheelScheduler(tick, ClockType::Enum clockType, a = 0);
+// [ 6] TimerWheelScheduler(tick, clock, threadPool, maxBatchSize, a = 0);
+// [ 2] ~TimerWheelScheduler();
+//
+// MANIPULATORS
+// [ 5] void cancelAllClocks();
+// [ 4] void cancelAllEvents();
+// [ 5] int cancelClock(Handle handle);
+// [ 2] int cancelEvent(Handle handle);
+// [ 4] int rescheduleEvent(Handle handle, const bsls::TimeInterval& newTime);
+// [ 2] Handle scheduleEvent(const TimeInterval& time, callback);
+// [ 2] int start();
+// [ 2] int start(const bslmt::ThreadAttributes& threadAttributes);
+// [ 5] Handle startClock(interval, callback, startTime = 0);
+// [ 2] void stop();
+//
+// ACCESSORS
+// [ 2] bslma::Allocator *allocator() const;
+// [ 2] bsls::SystemClockType::Enum clockType() const;
+// [ 2] bsls::TimeInterval now() const;
+// [ 5] int numClocks() const;
+// [ 2] int numEvents() const;
+// [ 2] bsls::TimeInterval tickInterval() const;
+//
+// TimerWheelSchedulerTestTimeSource
+// [ 2] TimerWheelSchedulerTestTimeSource(TimerWheelScheduler *scheduler);
+// [ 2] bsls::TimeInterval advanceTime(bsls::TimeInterval amount);
+// [ 2] bsls::TimeInterval now() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] CASCADING AND TICK SKIPPING
+// [ 7] MULTI-THREADED STRESS TEST
+// [ 8] USAGE EXAMPLE
+// [-1] SCHEDULE/CANCEL PERFORMANCE TEST
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static bool             verbose;
+static bool         veryVerbose;
+static bool     veryVeryVerbose;
+static bool veryVeryVeryVerbose;
+
+typedef bdlmt::TimerWheelScheduler               Obj;
+typedef bdlmt::TimerWheelSchedulerTestTimeSource TimeSource;
+typedef Obj::Handle                              Handle;
+
+const bsls::TimeInterval k_MILLISECOND(0, 1000 * 1000);
+
+// ============================================================================
+//                     GLOBAL HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+namespace u {
+
+class Recorder {
+    // This class records, in order, the identifiers passed to 'record' by the
+    // callbacks of a scheduler.
+
+    // DATA
+    mutable bslmt::Mutex d_mutex;   // protects 'd_ids'
+    bsl::vector<int>     d_ids;     // recorded identifiers
+    bsls::AtomicInt      d_count;   // number of recorded identifiers
+
+  public:
+    // CREATORS
+    explicit Recorder(bslma::Allocator *basicAllocator = 0)
+    : d_ids(basicAllocator)
+    , d_count(0)
+    {
+    }
+
+    // MANIPULATORS
+    void record(int id)
+        // Record the specified 'id'.
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        d_ids.push_back(id);
+        ++d_count;
+    }
+
+    // ACCESSORS
+    int count() const
+        // Return the number of recorded identifiers.
+    {
+        return d_count;
+    }
+
+    bsl::vector<int> ids() const
+        // Return the recorded identifiers.
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        return d_ids;
+    }
+
+    bool waitFor(int count) const
+        // Wait, for at most 10 seconds, until at least the specified 'count'
+        // identifiers are recorded, then wait for another 20 milliseconds,
+        // during which no further identifiers are expected.  Return 'true'
+        // if exactly 'count' identifiers are then recorded, and 'false'
+        // otherwise.
+    {
+        for (int i = 0; i < 10000 && d_count < count; ++i) {
+            bslmt::ThreadUtil::microSleep(1000);
+        }
+        bslmt::ThreadUtil::microSleep(20 * 1000);
+        return count == d_count;
+    }
+};
+
+bsl::function<void()> recordCallback(Recorder *recorder, int id)
+    // Return a callback recording the specified 'id' in the specified
+    // 'recorder'.  The returned callback uses the default allocator.
+{
+    return bdlf::BindUtil::bind(&Recorder::record, recorder, id);
+}
+
+bsls::TimeInterval ticks(bsls::Types::Int64 numTicks)
+    // Return the duration of the specified 'numTicks' milliseconds.
+{
+    bsls::TimeInterval result;
+    result.addMilliseconds(numTicks);
+    return result;
+}
+
+void noop()
+    // Do nothing.
+{
+}
+
+void postSemaphore(bslmt::Semaphore *semaphore)
+    // Post the specified 'semaphore'.
+{
+    semaphore->post();
+}
+
+}  // close namespace u
+}  // close unnamed namespace
+
+// ============================================================================
+//                 MULTI-THREADED STRESS TEST SUPPORT
+// ----------------------------------------------------------------------------
+
+namespace stress {
+
+const int k_NUM_THREADS    = 4;
+const int k_NUM_ITERATIONS = 20000;
+
+bsls::AtomicInt s_numDispatched(0);
+
+void dispatched()
+    // Count a dispatched event.
+{
+    ++s_numDispatched;
+}
+
+class Worker {
+    // This functor schedules, reschedules, and cancels events on a scheduler,
+    // counting the events it schedules and the events it successfully
+    // cancels.
+
+    // DATA
+    Obj             *d_scheduler_p;   // scheduler under test
+    bsls::AtomicInt *d_numScheduled;  // number of scheduled events
+    bsls::AtomicInt *d_numCanceled;   // number of cancelled events
+    int              d_seed;          // seed of the pseudo-random sequence
+
+  public:
+    // CREATORS
+    Worker(Obj             *scheduler,
+           bsls::AtomicInt *numScheduled,
+           bsls::AtomicInt *numCanceled,
+           int              seed)
+    : d_scheduler_p(scheduler)
+    , d_numScheduled(numScheduled)
+    , d_numCanceled(numCanceled)
+    , d_seed(seed)
+    {
+    }
+
+    // MANIPULATORS
+    void operator()()
+        // Keep a small set of events, replacing a random one with a new event
+        // due within 5 milliseconds at each iteration (cancelling the old
+        // event, or rescheduling it every 4th iteration).
+    {
+        enum { k_NUM_HELD = 16 };
+        Handle       held[k_NUM_HELD];
+        unsigned int random = d_seed;
+
+        for (int i = 0; i < k_NUM_HELD; ++i) {
+            held[i] = Obj::e_INVALID_HANDLE;
+        }
+
+        for (int i = 0; i < k_NUM_ITERATIONS; ++i) {
+            random = random * 1103515245 + 12345;
+            const int                slot  = (random >> 16) % k_NUM_HELD;
+            const bsls::TimeInterval delay(0, ((random >> 8) % 5000) * 1000);
+            const bsls::TimeInterval time  = d_scheduler_p->now() + delay;
+
+            if (Obj::e_INVALID_HANDLE != held[slot]) {
+                if (0 == i % 4) {
+                    if (0 == d_scheduler_p->rescheduleEvent(held[slot],
+                                                            time)) {
+                        continue;
+                    }
+                }
+                else if (0 == d_scheduler_p->cancelEvent(held[slot])) {
+                    ++*d_numCanceled;
+                }
+            }
+            held[slot] = d_scheduler_p->scheduleEvent(time, &dispatched);
+            ++*d_numScheduled;
+        }
+    }
+};
+
+}  // close namespace stress
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+namespace usage {
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Managing Connection Timeouts
+///- - - - - - - - - - - - - - - - - - - -
+// A server closes each of its connections if no data arrives on it within a
+// timeout, and re-arms the timeout every time data arrives.  Since data
+// usually arrives in time, almost every timeout is cancelled, which a
+// 'bdlmt::TimerWheelScheduler' does in constant time.  The timeouts need not
+// be accurate to better than 10 milliseconds, so we use that as the tick of
+// the scheduler.
+//
+// First, we define a 'Connection' type holding the handle of its timeout, and
+// a server managing a set of connections:
+//..
+    struct Connection {
+        // This 'struct' represents a connection of a server.
+
+        bdlmt::TimerWheelScheduler::Handle d_timeout;  // timeout event
+        bool                               d_closed;   // 'true' if timed out
+    };
+
+    class Server {
+        // This class implements a server closing idle connections.
+
+        // DATA
+        bsls::TimeInterval          d_ioTimeout;  // time out
+        bdlmt::TimerWheelScheduler  d_scheduler;  // timeout scheduler
+
+      private:
+        // PRIVATE MANIPULATORS
+        void closeConnection(Connection *connection);
+            // Close the specified 'connection'.
+
+      public:
+        // CREATORS
+        explicit Server(const bsls::TimeInterval& ioTimeout);
+            // Create a server closing connections on which no data arrives
+            // for the specified 'ioTimeout'.
+
+        ~Server();
+            // Destroy this object.
+
+        // MANIPULATORS
+        void dataAvailable(Connection *connection);
+            // Process the arrival of data on the specified 'connection'.
+
+        void newConnection(Connection *connection);
+            // Start monitoring the specified 'connection'.
+    };
+//..
+// Then, we implement the constructor and destructor, which start and stop the
+// dispatcher thread of the scheduler:
+//..
+    Server::Server(const bsls::TimeInterval& ioTimeout)
+    : d_ioTimeout(ioTimeout)
+    , d_scheduler(bsls::TimeInterval(0.01),
+                  bsls::SystemClockType::e_MONOTONIC)
+    {
+        d_scheduler.start();
+    }
+
+    Server::~Server()
+    {
+        d_scheduler.stop();
+    }
+//..
+// Next, we implement the closing of a connection, which the scheduler invokes
+// when the timeout of the connection expires:
+//..
+    void Server::closeConnection(Connection *connection)
+    {
+        connection->d_closed = true;
+    }
+//..
+// Then, we arm the timeout of a new connection:
+//..
+    void Server::newConnection(Connection *connection)
+    {
+        connection->d_closed  = false;
+        connection->d_timeout = d_scheduler.scheduleEvent(
+                      d_scheduler.now() + d_ioTimeout,
+                      bdlf::BindUtil::bind(&Server::closeConnection,
+                                           this,
+                                           connection));
+    }
+//..
+// Next, we re-arm the timeout when data arrives, unless the connection has
+// already timed out (in which case 'rescheduleEvent' fails):
+//..
+    void Server::dataAvailable(Connection *connection)
+    {
+        const bsls::TimeInterval timeout = d_scheduler.now() + d_ioTimeout;
+
+        if (0 != d_scheduler.rescheduleEvent(connection->d_timeout, timeout)) {
+            return;                                                   // RETURN
+        }
+
+        // process the data
+    }
+//..
+
+void example1()
+{
+// Finally, we create a server and a connection, and observe that the
+// connection is closed once data stops arriving:
+//..
+    Server     server(bsls::TimeInterval(0.05));
+    Connection connection;
+
+    server.newConnection(&connection);
+    for (int i = 0; i < 5; ++i) {
+        bslmt::ThreadUtil::microSleep(10 * 1000);
+        server.dataAvailable(&connection);
+    }
+    ASSERT(false == connection.d_closed);
+
+    bslmt::ThreadUtil::microSleep(500 * 1000);
+    ASSERT(true  == connection.d_closed);
+//..
+}
+
+}  // close namespace usage
+
+// ============================================================================
+//                       PERFORMANCE TEST SUPPORT
+// ----------------------------------------------------------------------------
+
+namespace perf {
+
+template <class SCHEDULER>
+double timerEventRun(SCHEDULER *scheduler, int numOutstanding, int numOps)
+    // Keep the specified 'numOutstanding' events scheduled on the specified
+    // 'scheduler', which has the interface of 'bdlmt::TimerEventScheduler',
+    // and perform the specified 'numOps' pairs of cancelling an event and
+    // scheduling a new one.  Return the number of pairs per second.
+{
+    typedef typename SCHEDULER::Handle PerfHandle;
+
+    const bsls::TimeInterval  later = scheduler->now() + 3600;
+    bsl::vector<PerfHandle>   handles(numOutstanding);
+
+    for (int i = 0; i < numOutstanding; ++i) {
+        handles[i] = scheduler->scheduleEvent(later + u::ticks(i), &u::noop);
+    }
+
+    bsls::Stopwatch timer;
+    timer.start();
+    for (int i = 0; i < numOps; ++i) {
+        const int slot = i % numOutstanding;
+        scheduler->cancelEvent(handles[slot]);
+        handles[slot] = scheduler->scheduleEvent(later + u::ticks(i % 7919),
+                                                 &u::noop);
+    }
+    timer.stop();
+
+    scheduler->cancelAllEvents();
+    return numOps / timer.elapsedTime();
+}
+
+double eventSchedulerRun(bdlmt::EventScheduler *scheduler,
+                         int                    numOutstanding,
+                         int                    numOps)
+    // Keep the specified 'numOutstanding' events scheduled on the specified
+    // 'scheduler', and perform the specified 'numOps' pairs of cancelling an
+    // event and scheduling a new one.  Return the number of pairs per
+    // second.
+{
+    typedef bdlmt::EventScheduler::EventHandle EventHandle;
+
+    const bsls::TimeInterval later = scheduler->now() + 3600;
+    bsl::vector<EventHandle> handles(numOutstanding);
+
+    for (int i = 0; i < numOutstanding; ++i) {
+        scheduler->scheduleEvent(&handles[i], later + u::ticks(i), &u::noop);
+    }
+
+    bsls::Stopwatch timer;
+    timer.start();
+    for (int i = 0; i < numOps; ++i) {
+        const int slot = i % numOutstanding;
+        scheduler->cancelEvent(&handles[slot]);
+        scheduler->scheduleEvent(&handles[slot],
+                                 later + u::ticks(i % 7919),
+                                 &u::noop);
+    }
+    timer.stop();
+
+    handles.clear();
+    scheduler->cancelAllEvents();
+    return numOps / timer.elapsedTime();
+}
+
+}  // close namespace perf
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test            = argc > 1 ? atoi(argv[1]) : 0;
+    verbose             = argc > 2;
+    veryVerbose         = argc > 3;
+    veryVeryVerbose     = argc > 4;
+    veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator         defaultAllocator("default",
+                                                  veryVeryVeryVerbose);
+    bslma::DefaultAllocatorGuard defaultAllocatorGuard(&defaultAllocator);
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        usage::example1();
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // MULTI-THREADED STRESS TEST
+        //
+        // Concerns:
+        //: 1 Concurrent scheduling, rescheduling, and cancellation of events,
+        //:   while the dispatcher thread runs, account for every event: each
+        //:   event is either cancelled or dispatched exactly once.
+        //:
+        //: 2 All memory is returned once the scheduler is destroyed.
+        //
+        // Plan:
+        //: 1 Have several threads schedule events due within a few
+        //:   milliseconds, and cancel or reschedule some of them, on a
+        //:   scheduler running on the system clock.  Once all events are due,
+        //:   verify that the numbers of dispatched and cancelled events add
+        //:   up to the number of scheduled events.  (C-1)
+        //:
+        //: 2 Verify that the test allocator has no blocks in use after the
+        //:   scheduler is destroyed.  (C-2)
+        //
+        // Testing:
+        //   MULTI-THREADED STRESS TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MULTI-THREADED STRESS TEST" << endl
+                          << "==========================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            Obj             mX(k_MILLISECOND,
+                               bsls::SystemClockType::e_MONOTONIC,
+                               &ta);
+            const Obj&      X = mX;
+            bsls::AtomicInt numScheduled(0);
+            bsls::AtomicInt numCanceled(0);
+
+            ASSERT(0 == mX.start());
+
+            bslmt::ThreadGroup threads(&ta);
+            for (int i = 0; i < stress::k_NUM_THREADS; ++i) {
+                threads.addThread(stress::Worker(&mX,
+                                                 &numScheduled,
+                                                 &numCanceled,
+                                                 i + 1));
+            }
+            threads.joinAll();
+
+            for (int i = 0; i < 10000 && 0 != X.numEvents(); ++i) {
+                bslmt::ThreadUtil::microSleep(1000);
+            }
+            mX.stop();
+
+            if (veryVerbose) {
+                P_(numScheduled); P_(numCanceled); P(stress::s_numDispatched);
+            }
+
+            ASSERTV(X.numEvents(), 0 == X.numEvents());
+
+            const int total = numCanceled + stress::s_numDispatched;
+            ASSERTV(numScheduled, total, numScheduled == total);
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // THREAD POOL DISPATCH
+        //
+        // Concerns:
+        //: 1 When a thread pool is supplied, the due callbacks are enqueued to
+        //:   it in jobs of at most 'maxBatchSize' callbacks.
+        //:
+        //: 2 Every callback is invoked exactly once.
+        //:
+        //: 3 If the thread pool does not accept jobs, the callbacks are
+        //:   invoked in the dispatcher thread.
+        //
+        // Plan:
+        //: 1 Using a single-thread pool, schedule an event that blocks on a
+        //:   semaphore, and 10 events due in the same tick, with a maximum
+        //:   batch size of 4.  Once the blocking event runs, verify that the
+        //:   thread pool has 2 pending jobs, then release the semaphore and
+        //:   verify that all callbacks are invoked.  (C-1..2)
+        //:
+        //: 2 Stop the thread pool, and verify that due callbacks are still
+        //:   invoked.  (C-3)
+        //
+        // Testing:
+        //   TimerWheelScheduler(tick, clock, threadPool, maxBatchSize, a = 0);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "THREAD POOL DISPATCH" << endl
+                          << "====================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            bslmt::ThreadAttributes attributes;
+            bdlmt::ThreadPool       pool(attributes, 1, 1, 1000, &ta);
+            ASSERT(0 == pool.start());
+
+            Obj        mX(k_MILLISECOND,
+                          bsls::SystemClockType::e_REALTIME,
+                          &pool,
+                          4,
+                          &ta);
+            TimeSource timeSource(&mX);
+            u::Recorder recorder(&ta);
+            bslmt::Semaphore blocker;
+            bslmt::Semaphore blocked;
+
+            const bsls::TimeInterval T = timeSource.now();
+
+            mX.scheduleEvent(T + u::ticks(1),
+                             bdlf::BindUtil::bind(&bslmt::Semaphore::wait,
+                                                  &blocker));
+            mX.scheduleEvent(T + u::ticks(1),
+                             bdlf::BindUtil::bind(&u::postSemaphore,
+                                                  &blocked));
+            for (int i = 0; i < 10; ++i) {
+                mX.scheduleEvent(T + u::ticks(2),
+                                 u::recordCallback(&recorder, i));
+            }
+
+            ASSERT(0 == mX.start());
+
+            // The first tick yields one job of 2 callbacks, which blocks the
+            // only thread of the pool.
+
+            timeSource.advanceTime(u::ticks(1));
+            for (int i = 0; i < 10000 && 0 == pool.numActiveThreads(); ++i) {
+                bslmt::ThreadUtil::microSleep(1000);
+            }
+
+            // The second tick yields 3 jobs (of 4, 4, and 2 callbacks).
+
+            timeSource.advanceTime(u::ticks(1));
+            for (int i = 0; i < 10000 && 3 > pool.numPendingJobs(); ++i) {
+                bslmt::ThreadUtil::microSleep(1000);
+            }
+            ASSERTV(pool.numPendingJobs(), 3 == pool.numPendingJobs());
+            ASSERT(0 == recorder.count());
+
+            blocker.post();
+            blocked.wait();
+            ASSERT(recorder.waitFor(10));
+
+            // Callbacks due in the same tick are not ordered.
+
+            bsl::vector<int> ids = recorder.ids();
+            bsl::sort(ids.begin(), ids.end());
+            for (int i = 0; i < static_cast<int>(ids.size()); ++i) {
+                ASSERTV(i, ids[i], i == ids[i]);
+            }
+
+            // A stopped pool does not accept jobs.
+
+            pool.stop();
+            mX.scheduleEvent(timeSource.now() + u::ticks(1),
+                             u::recordCallback(&recorder, 10));
+            timeSource.advanceTime(u::ticks(1));
+            ASSERT(recorder.waitFor(11));
+
+            mX.stop();
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CLOCKS
+        //
+        // Concerns:
+        //: 1 A clock is dispatched at each interval, from its start time
+        //:   (which defaults to 'now() + interval').
+        //:
+        //: 2 'cancelClock' stops a clock, and fails for an invalid handle or
+        //:   an event handle; 'cancelEvent' fails for a clock handle.
+        //:
+        //: 3 'cancelAllClocks' stops all clocks, but not the events.
+        //:
+        //: 4 'numClocks' reflects the number of clocks.
+        //
+        // Plan:
+        //: 1 Using a test time source, start clocks with and without a start
+        //:   time, and advance the time tick by tick, verifying the number of
+        //:   dispatched callbacks.  (C-1, 4)
+        //:
+        //: 2 Cancel the clocks individually and all at once, and verify the
+        //:   return values and subsequent dispatching.  (C-2..4)
+        //
+        // Testing:
+        //   Handle startClock(interval, callback, startTime = 0);
+        //   int cancelClock(Handle handle);
+        //   void cancelAllClocks();
+        //   int numClocks() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CLOCKS" << endl
+                          << "======" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            Obj         mX(k_MILLISECOND, &ta);  const Obj& X = mX;
+            TimeSource  timeSource(&mX);
+            u::Recorder recorder(&ta);
+
+            const bsls::TimeInterval T = timeSource.now();
+
+            // Clock 0 every 3 ticks from T + 3; clock 1 every 2 ticks from
+            // T + 5.
+
+            const Handle C0 = mX.startClock(u::ticks(3),
+                                            u::recordCallback(&recorder, 0));
+            const Handle C1 = mX.startClock(u::ticks(2),
+                                            u::recordCallback(&recorder, 1),
+                                            T + u::ticks(5));
+            const Handle E  = mX.scheduleEvent(T + u::ticks(100),
+                                               u::recordCallback(&recorder,
+                                                                 2));
+            ASSERT(2 == X.numClocks());
+            ASSERT(1 == X.numEvents());
+
+            ASSERT(0 != mX.cancelEvent(C0));
+            ASSERT(0 != mX.cancelClock(E));
+            ASSERT(0 != mX.cancelClock(Obj::e_INVALID_HANDLE));
+
+            ASSERT(0 == mX.start());
+
+            // Expected cumulative number of dispatches after each tick.
+
+            static const int EXP[] = { 0, 0, 0, 1, 1, 2, 3, 4, 4, 6, 6 };
+
+            for (int t = 1; t <= 10; ++t) {
+                timeSource.advanceTime(u::ticks(1));
+                ASSERTV(t, recorder.count(), recorder.waitFor(EXP[t]));
+            }
+
+            ASSERT(0 == mX.cancelClock(C1));
+            ASSERT(0 != mX.cancelClock(C1));
+            ASSERT(1 == X.numClocks());
+
+            timeSource.advanceTime(u::ticks(2));         // T + 12
+            ASSERT(recorder.waitFor(7));
+
+            mX.startClock(u::ticks(1), u::recordCallback(&recorder, 3));
+            ASSERT(2 == X.numClocks());
+
+            mX.cancelAllClocks();
+            ASSERT(0 == X.numClocks());
+            ASSERT(1 == X.numEvents());
+
+            timeSource.advanceTime(u::ticks(10));
+            ASSERT(recorder.waitFor(7));
+
+            timeSource.advanceTime(u::ticks(100));
+            ASSERT(recorder.waitFor(8));
+            ASSERT(0 == X.numEvents());
+
+            mX.stop();
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // RESCHEDULING AND HANDLE VALIDITY
+        //
+        // Concerns:
+        //: 1 'rescheduleEvent' moves an event earlier or later, including
+        //:   into the past (in which case it is due immediately).
+        //:
+        //: 2 'rescheduleEvent' and 'cancelEvent' fail for a dispatched or
+        //:   cancelled event, including after its node has been reused by
+        //:   another event.
+        //:
+        //: 3 'cancelAllEvents' cancels all events.
+        //
+        // Plan:
+        //: 1 Using a test time source, schedule events, reschedule them,
+        //:   and verify the order and times of their dispatch.  (C-1)
+        //:
+        //: 2 Verify that the handles of dispatched and cancelled events are
+        //:   rejected, after new events are scheduled.  (C-2)
+        //:
+        //: 3 Schedule several events, invoke 'cancelAllEvents', and verify
+        //:   that none is dispatched.  (C-3)
+        //
+        // Testing:
+        //   int rescheduleEvent(Handle handle, const TimeInterval& newTime);
+        //   void cancelAllEvents();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "RESCHEDULING AND HANDLE VALIDITY" << endl
+                          << "================================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            Obj         mX(k_MILLISECOND, &ta);  const Obj& X = mX;
+            TimeSource  timeSource(&mX);
+            u::Recorder recorder(&ta);
+
+            const bsls::TimeInterval T = timeSource.now();
+
+            const Handle H0 = mX.scheduleEvent(T + u::ticks(10),
+                                               u::recordCallback(&recorder,
+                                                                 0));
+            const Handle H1 = mX.scheduleEvent(T + u::ticks(1000),
+                                               u::recordCallback(&recorder,
+                                                                 1));
+            const Handle H2 = mX.scheduleEvent(T + u::ticks(100000),
+                                               u::recordCallback(&recorder,
+                                                                 2));
+
+            ASSERT(0 == mX.rescheduleEvent(H0, T + u::ticks(20)));
+            ASSERT(0 == mX.rescheduleEvent(H1, T + u::ticks(5)));
+            ASSERT(0 == mX.rescheduleEvent(H2, T - u::ticks(5)));
+            ASSERT(3 == X.numEvents());
+
+            ASSERT(0 == mX.start());
+
+            ASSERT(recorder.waitFor(1));                 // H2 (past)
+            timeSource.advanceTime(u::ticks(5));
+            ASSERT(recorder.waitFor(2));                 // H1
+            timeSource.advanceTime(u::ticks(14));
+            ASSERT(recorder.waitFor(2));
+            timeSource.advanceTime(u::ticks(1));
+            ASSERT(recorder.waitFor(3));                 // H0
+
+            const bsl::vector<int> ids = recorder.ids();
+            ASSERT(2 == ids[0]);
+            ASSERT(1 == ids[1]);
+            ASSERT(0 == ids[2]);
+
+            // Reuse the nodes of the dispatched events.
+
+            Handle H[3];
+            for (int i = 0; i < 3; ++i) {
+                H[i] = mX.scheduleEvent(T + u::ticks(1000),
+                                        u::recordCallback(&recorder, 10 + i));
+            }
+            ASSERT(0 != mX.rescheduleEvent(H0, T));
+            ASSERT(0 != mX.cancelEvent(H1));
+            ASSERT(0 != mX.cancelEvent(H2));
+            ASSERT(3 == X.numEvents());
+
+            ASSERT(0 == mX.cancelEvent(H[0]));
+            ASSERT(0 != mX.cancelEvent(H[0]));
+            ASSERT(0 != mX.rescheduleEvent(H[0], T));
+            ASSERT(2 == X.numEvents());
+
+            mX.cancelAllEvents();
+            ASSERT(0 == X.numEvents());
+            ASSERT(0 != mX.cancelEvent(H[1]));
+
+            timeSource.advanceTime(u::ticks(2000));
+            ASSERT(recorder.waitFor(3));
+
+            mX.stop();
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CASCADING AND TICK SKIPPING
+        //
+        // Concerns:
+        //: 1 Events due at any level of the wheel, or in the overflow list,
+        //:   are dispatched in the tick they are due, and not before.
+        //:
+        //: 2 Events due in different ticks are dispatched in order of their
+        //:   ticks.
+        //:
+        //: 3 The dispatcher thread does not iterate over every elapsed tick
+        //:   (which would take far too long for 2^32 ticks).
+        //:
+        //: 4 An event is due in the first tick ending at or after its time.
+        //
+        // Plan:
+        //: 1 Using a test time source, schedule events at tick offsets near
+        //:   the boundaries of each level, in a scrambled order.  Advance the
+        //:   time to one tick before each event is due, verifying that it is
+        //:   not dispatched, and then to the tick it is due, verifying that it
+        //:   is dispatched.  (C-1, 3)
+        //:
+        //: 2 Advance the time past several events at once, and verify the
+        //:   order of their dispatch.  (C-2)
+        //:
+        //: 3 Schedule an event in the middle of a tick, and verify that it is
+        //:   dispatched at the end of that tick.  (C-4)
+        //
+        // Testing:
+        //   CASCADING AND TICK SKIPPING
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CASCADING AND TICK SKIPPING" << endl
+                          << "===========================" << endl;
+
+        typedef bsls::Types::Int64 Int64;
+
+        const Int64 K = 1LL << 32;
+
+        static const Int64 OFFSETS[] = {
+            1, 2, 255, 256, 257, 511, 512, 65535, 65536, 65537, 70000,
+            (1 << 24) - 1, 1 << 24, (1 << 24) + 1, K - 1, K, K + 1,
+            3 * K + 12345
+        };
+        const int NUM_OFFSETS = sizeof OFFSETS / sizeof *OFFSETS;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        if (verbose) cout << "\tOne event at a time." << endl;
+        {
+            Obj         mX(k_MILLISECOND, &ta);
+            TimeSource  timeSource(&mX);
+            u::Recorder recorder(&ta);
+
+            const bsls::TimeInterval T = timeSource.now();
+
+            for (int i = 0; i < NUM_OFFSETS; ++i) {
+                const int j = (i * 7) % NUM_OFFSETS;    // scramble
+
+                mX.scheduleEvent(T + u::ticks(OFFSETS[j]),
+                                 u::recordCallback(&recorder, j));
+            }
+            ASSERT(0 == mX.start());
+
+            Int64 elapsed = 0;
+            for (int i = 0; i < NUM_OFFSETS; ++i) {
+                if (OFFSETS[i] - 1 > elapsed) {
+                    timeSource.advanceTime(u::ticks(OFFSETS[i] - 1 - elapsed));
+                    elapsed = OFFSETS[i] - 1;
+                    ASSERTV(i, recorder.count(), recorder.waitFor(i));
+                }
+                timeSource.advanceTime(u::ticks(1));
+                ++elapsed;
+                ASSERTV(i, recorder.count(), recorder.waitFor(i + 1));
+            }
+
+            const bsl::vector<int> ids = recorder.ids();
+            for (int i = 0; i < static_cast<int>(ids.size()); ++i) {
+                ASSERTV(i, ids[i], i == ids[i]);
+            }
+            mX.stop();
+        }
+
+        if (verbose) cout << "\tAll events at once." << endl;
+        {
+            Obj         mX(k_MILLISECOND, &ta);
+            TimeSource  timeSource(&mX);
+            u::Recorder recorder(&ta);
+
+            const bsls::TimeInterval T = timeSource.now();
+
+            for (int i = 0; i < NUM_OFFSETS; ++i) {
+                const int j = (i * 5) % NUM_OFFSETS;    // scramble
+
+                mX.scheduleEvent(T + u::ticks(OFFSETS[j]),
+                                 u::recordCallback(&recorder, j));
+            }
+            ASSERT(0 == mX.start());
+
+            timeSource.advanceTime(u::ticks(OFFSETS[NUM_OFFSETS - 1]));
+            ASSERT(recorder.waitFor(NUM_OFFSETS));
+
+            const bsl::vector<int> ids = recorder.ids();
+            for (int i = 0; i < static_cast<int>(ids.size()); ++i) {
+                ASSERTV(i, ids[i], i == ids[i]);
+            }
+            mX.stop();
+        }
+
+        if (verbose) cout << "\tRounding to ticks." << endl;
+        {
+            Obj         mX(bsls::TimeInterval(0, 10 * 1000 * 1000), &ta);
+            TimeSource  timeSource(&mX);
+            u::Recorder recorder(&ta);
+
+            const bsls::TimeInterval T = timeSource.now();
+
+            mX.scheduleEvent(T + bsls::TimeInterval(0, 15 * 1000 * 1000),
+                             u::recordCallback(&recorder, 0));
+            ASSERT(0 == mX.start());
+
+            timeSource.advanceTime(bsls::TimeInterval(0, 15 * 1000 * 1000));
+            ASSERT(recorder.waitFor(0));
+            timeSource.advanceTime(bsls::TimeInterval(0,  4 * 1000 * 1000));
+            ASSERT(recorder.waitFor(0));
+            timeSource.advanceTime(bsls::TimeInterval(0,  1 * 1000 * 1000));
+            ASSERT(recorder.waitFor(1));
+            mX.stop();
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // PRIMARY MANIPULATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 The constructors set the tick interval, the clock type, and the
+        //:   allocator; the default tick is one millisecond.
+        //:
+        //: 2 'scheduleEvent' returns a valid handle, and increments
+        //:   'numEvents'; 'cancelEvent' removes the event, and fails for an
+        //:   invalid or cancelled handle.
+        //:
+        //: 3 Events are dispatched only between 'start' and 'stop'; events
+        //:   scheduled while stopped are kept, and due events are dispatched
+        //:   on 'start'.
+        //:
+        //: 4 'start' and 'stop' are idempotent, and 'start' honors the
+        //:   supplied thread attributes.
+        //:
+        //: 5 'now' reports the time of the test time source.
+        //:
+        //: 6 The destructor discards pending events and releases all memory.
+        //
+        // Plan:
+        //: 1 Create schedulers with each constructor, and verify the
+        //:   accessors.  (C-1)
+        //:
+        //: 2 Using a test time source, schedule and cancel events, and
+        //:   advance the time while the scheduler is stopped and started.
+        //:   (C-2..5)
+        //:
+        //: 3 Destroy a scheduler having pending events, and verify that all
+        //:   memory is released.  (C-6)
+        //
+        // Testing:
+        //   TimerWheelScheduler(bslma::Allocator *basicAllocator = 0);
+        //   TimerWheelScheduler(const TimeInterval& tick, Allocator *a = 0);
+        //   TimerWheelScheduler(tick, ClockType::Enum clockType, a = 0);
+        //   ~TimerWheelScheduler();
+        //   int cancelEvent(Handle handle);
+        //   Handle scheduleEvent(const TimeInterval& time, callback);
+        //   int start();
+        //   int start(const bslmt::ThreadAttributes& threadAttributes);
+        //   void stop();
+        //   bslma::Allocator *allocator() const;
+        //   bsls::SystemClockType::Enum clockType() const;
+        //   bsls::TimeInterval now() const;
+        //   int numEvents() const;
+        //   bsls::TimeInterval tickInterval() const;
+        //   TimerWheelSchedulerTestTimeSource(TimerWheelScheduler *scheduler);
+        //   bsls::TimeInterval advanceTime(bsls::TimeInterval amount);
+        //   bsls::TimeInterval now() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                      << "PRIMARY MANIPULATORS AND BASIC ACCESSORS" << endl
+                      << "========================================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        if (verbose) cout << "\tConstructors." << endl;
+        {
+            Obj mX;  const Obj& X = mX;
+            ASSERT(&defaultAllocator == X.allocator());
+            ASSERT(k_MILLISECOND == X.tickInterval());
+            ASSERT(bsls::SystemClockType::e_REALTIME == X.clockType());
+            ASSERT(0 == X.numEvents());
+            ASSERT(0 == X.numClocks());
+        }
+        {
+            const bsls::TimeInterval TICK(0, 250);
+
+            Obj mX(TICK, &ta);  const Obj& X = mX;
+            ASSERT(&ta  == X.allocator());
+            ASSERT(TICK == X.tickInterval());
+            ASSERT(bsls::SystemClockType::e_REALTIME == X.clockType());
+        }
+        {
+            const bsls::TimeInterval TICK(2, 0);
+
+            Obj mX(TICK, bsls::SystemClockType::e_MONOTONIC, &ta);
+            const Obj& X = mX;
+            ASSERT(&ta  == X.allocator());
+            ASSERT(TICK == X.tickInterval());
+            ASSERT(bsls::SystemClockType::e_MONOTONIC == X.clockType());
+
+            const bsls::TimeInterval before =
+                                        bsls::SystemTime::nowMonotonicClock();
+            const bsls::TimeInterval now    = X.now();
+            const bsls::TimeInterval after  =
+                                        bsls::SystemTime::nowMonotonicClock();
+            ASSERT(before <= now);
+            ASSERT(now    <= after);
+        }
+
+        if (verbose) cout << "\tScheduling and cancelling." << endl;
+        {
+            Obj         mX(k_MILLISECOND, &ta);  const Obj& X = mX;
+            TimeSource  timeSource(&mX);
+            u::Recorder recorder(&ta);
+
+            const bsls::TimeInterval T = timeSource.now();
+            ASSERT(T == X.now());
+
+            const Handle H0 = mX.scheduleEvent(T + u::ticks(1),
+                                               u::recordCallback(&recorder,
+                                                                 0));
+            const Handle H1 = mX.scheduleEvent(T + u::ticks(1),
+                                               u::recordCallback(&recorder,
+                                                                 1));
+            ASSERT(Obj::e_INVALID_HANDLE != H0);
+            ASSERT(Obj::e_INVALID_HANDLE != H1);
+            ASSERT(H0 != H1);
+            ASSERT(2 == X.numEvents());
+
+            ASSERT(0 == mX.cancelEvent(H1));
+            ASSERT(0 != mX.cancelEvent(H1));
+            ASSERT(0 != mX.cancelEvent(Obj::e_INVALID_HANDLE));
+            ASSERT(1 == X.numEvents());
+
+            // Not dispatched while stopped.
+
+            ASSERT(T + u::ticks(5) == timeSource.advanceTime(u::ticks(5)));
+            ASSERT(T + u::ticks(5) == X.now());
+            ASSERT(T + u::ticks(5) == timeSource.now());
+            ASSERT(recorder.waitFor(0));
+
+            bslmt::ThreadAttributes attributes;
+            attributes.setStackSize(256 * 1024);
+            ASSERT(0 == mX.start(attributes));
+            ASSERT(0 == mX.start());
+            ASSERT(recorder.waitFor(1));
+            ASSERT(0 == X.numEvents());
+            ASSERT(0 != mX.cancelEvent(H0));
+
+            mX.stop();
+            mX.stop();
+
+            mX.scheduleEvent(T + u::ticks(6),
+                             u::recordCallback(&recorder, 2));
+            timeSource.advanceTime(u::ticks(1));
+            ASSERT(recorder.waitFor(1));
+
+            ASSERT(0 == mX.start());
+            ASSERT(recorder.waitFor(2));
+
+            // Pending events are discarded on destruction.
+
+            mX.scheduleEvent(T + u::ticks(100),
+                             u::recordCallback(&recorder, 3));
+            mX.scheduleEvent(T + u::ticks(100000),
+                             u::recordCallback(&recorder, 4));
+            ASSERT(2 == X.numEvents());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Using the system clock, schedule events, cancel one of them, and
+        //:   verify that the others are dispatched.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            Obj         mX(k_MILLISECOND,
+                           bsls::SystemClockType::e_MONOTONIC,
+                           &ta);
+            const Obj&  X = mX;
+            u::Recorder recorder(&ta);
+
+            ASSERT(0 == mX.start());
+
+            const bsls::TimeInterval T = X.now();
+
+            mX.scheduleEvent(T + u::ticks(20),
+                             u::recordCallback(&recorder, 0));
+            const Handle H = mX.scheduleEvent(T + u::ticks(10),
+                                              u::recordCallback(&recorder, 1));
+            mX.scheduleEvent(T + u::ticks(10),
+                             u::recordCallback(&recorder, 2));
+            ASSERT(3 == X.numEvents());
+
+            ASSERT(0 == mX.cancelEvent(H));
+            ASSERT(2 == X.numEvents());
+
+            ASSERT(recorder.waitFor(2));
+            ASSERT(X.now() >= T + u::ticks(20));
+
+            const bsl::vector<int> ids = recorder.ids();
+            ASSERT(2 == ids[0]);
+            ASSERT(0 == ids[1]);
+
+            mX.stop();
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // SCHEDULE/CANCEL PERFORMANCE TEST
+        //   Compare the throughput of cancelling an event and scheduling a new
+        //   one on 'bdlmt::TimerEventScheduler', 'bdlmt::EventScheduler', and
+        //   'bdlmt::TimerWheelScheduler', with a given number of events
+        //   outstanding.
+        //
+        //   2nd parameter: number of outstanding events (default 100000)
+        //
+        // Testing:
+        //   SCHEDULE/CANCEL PERFORMANCE TEST
+        // --------------------------------------------------------------------
+
+        const int numOutstanding = argc > 2 ? atoi(argv[2]) : 100000;
+        const int numOps         = 1000000;
+
+        cout << "SCHEDULE/CANCEL PERFORMANCE TEST" << endl
+             << "================================" << endl;
+        P(numOutstanding);
+
+        bslma::Allocator *alloc = &bslma::NewDeleteAllocator::singleton();
+        {
+            bdlmt::TimerEventScheduler scheduler(numOutstanding + 1,
+                                                 0,
+                                                 alloc);
+            const double rate = perf::timerEventRun(&scheduler,
+                                                    numOutstanding,
+                                                    numOps);
+            printf("TimerEventScheduler: %12.0f ops/s\n", rate);
+        }
+        {
+            bdlmt::EventScheduler scheduler(alloc);
+            const double rate = perf::eventSchedulerRun(&scheduler,
+                                                        numOutstanding,
+                                                        numOps);
+            printf("EventScheduler:      %12.0f ops/s\n", rate);
+        }
+        {
+            Obj scheduler(k_MILLISECOND, alloc);
+            const double rate = perf::timerEventRun(&scheduler,
+                                                    numOutstanding,
+                                                    numOps);
+            printf("TimerWheelScheduler: %12.0f ops/s\n", rate);
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    ASSERTV(globalAllocator.numBlocksTotal(),
+            0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License.  You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
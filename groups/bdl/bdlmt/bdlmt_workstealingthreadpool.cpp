@@ -0,0 +1,701 @@
+// bdlmt_workstealingthreadpool.cpp                                   -*-C++-*-
+#include <bdlmt_workstealingthreadpool.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlmt_workstealingthreadpool_cpp,"$Id$ $CSID$")
+
+///IMPLEMENTATION NOTES
+///--------------------
+// The deque follows Chase and Lev, "Dynamic Circular Work-Stealing Deque"
+// (SPAA 2005), in the formulation of Le et al., "Correct and Efficient
+// Work-Stealing for Weak Memory Models" (PPoPP 2013), without the growth of
+// the array.  The sequentially consistent store of 'd_bottom' followed by the
+// sequentially consistent load of 'd_top' in 'popBottom', and the
+// sequentially consistent loads of 'd_top' then 'd_bottom' in 'steal', take
+// the place of the fences of the latter paper, ensuring that the owner and a
+// thief cannot both take the last job.
+//
+// A job is counted in 'd_numUnfinishedJobs' *before* it is published, so
+// that a job enqueued by another job is counted before its parent completes,
+// even if it is stolen and completed before 'enqueueJobImp' returns.  A job
+// is counted in 'd_numPendingJobs' *after* it is published, so that a thread
+// observing a positive count can find a job (or a job is about to be
+// published).
+//
+// A thread finding no job increments 'd_numIdleThreads' and then checks
+// 'd_numPendingJobs' (under 'd_waitMutex'), while an enqueuing thread
+// increments 'd_numPendingJobs' and then checks 'd_numIdleThreads'; as these
+// operations are sequentially consistent, at least one of the two threads
+// observes the increment of the other, so that a job cannot be left pending
+// while all the threads wait.  The same reasoning applies to
+// 'd_numUnfinishedJobs' and 'd_numDrainers'.
+//
+// The threads of the pool are identified using a process-wide thread-specific
+// key holding the 'Worker' state of the calling thread, if any; comparing the
+// pool of that state with 'this' distinguishes the threads of different
+// pools.
+
+#include <bdlf_bind.h>
+
+#include <bslma_default.h>
+
+#include <bslmt_lockguard.h>
+#include <bslmt_once.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_assert.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstddef.h>
+
+namespace BloombergLP {
+namespace {
+
+const bsl::size_t k_MAX_BATCH_SIZE = 64;
+    // maximum number of jobs moved from the shared queue to the deque of a
+    // thread at once
+
+bslmt::ThreadUtil::Key s_workerKey;  // key of the 'Worker' of each thread
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+void initBlockSet(sigset_t *blockSet)
+    // Load into the specified 'blockSet' all the signals except the
+    // synchronous signals.
+{
+    sigfillset(blockSet);
+
+    const int synchronousSignals[] = {
+      SIGBUS,
+      SIGFPE,
+      SIGILL,
+      SIGSEGV,
+      SIGSYS,
+      SIGABRT,
+      SIGTRAP,
+     #if !defined(BSLS_PLATFORM_OS_CYGWIN) || defined(SIGIOT)
+      SIGIOT
+     #endif
+    };
+
+    const int SIZE = sizeof synchronousSignals / sizeof *synchronousSignals;
+
+    for (int i = 0; i < SIZE; ++i) {
+        sigdelset(blockSet, synchronousSignals[i]);
+    }
+}
+#endif
+
+}  // close unnamed namespace
+
+namespace bdlmt {
+
+                    // ----------------------------------
+                    // class WorkStealingThreadPool_Deque
+                    // ----------------------------------
+
+// CREATORS
+WorkStealingThreadPool_Deque::WorkStealingThreadPool_Deque(
+                                             int               capacity,
+                                             bslma::Allocator *basicAllocator)
+: d_top(0)
+, d_bottom(0)
+, d_slots_p(0)
+, d_mask(capacity - 1)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 < capacity);
+    BSLS_ASSERT(0 == (capacity & (capacity - 1)));
+
+    d_slots_p = static_cast<Slot *>(
+                             d_allocator_p->allocate(capacity * sizeof(Slot)));
+    for (int i = 0; i < capacity; ++i) {
+        bsls::AtomicOperations::initPointer(d_slots_p + i, 0);
+    }
+}
+
+WorkStealingThreadPool_Deque::~WorkStealingThreadPool_Deque()
+{
+    d_allocator_p->deallocate(d_slots_p);
+}
+
+// MANIPULATORS
+WorkStealingThreadPool_Deque::Job *WorkStealingThreadPool_Deque::popBottom()
+{
+    const bsls::Types::Int64 bottom = d_bottom.loadRelaxed() - 1;
+
+    d_bottom = bottom;
+
+    const bsls::Types::Int64 top = d_top;
+
+    if (top > bottom) {
+        d_bottom.storeRelaxed(bottom + 1);
+        return 0;                                                     // RETURN
+    }
+
+    Job *job = static_cast<Job *>(bsls::AtomicOperations::getPtrRelaxed(
+                                            d_slots_p + (bottom & d_mask)));
+
+    if (top == bottom) {
+        // This is the last job: race the thieves for it.
+
+        if (top != d_top.testAndSwap(top, top + 1)) {
+            job = 0;
+        }
+        d_bottom.storeRelaxed(bottom + 1);
+    }
+
+    return job;
+}
+
+int WorkStealingThreadPool_Deque::pushBottom(Job *job)
+{
+    const bsls::Types::Int64 bottom = d_bottom.loadRelaxed();
+    const bsls::Types::Int64 top    = d_top.loadAcquire();
+
+    if (bottom - top > d_mask) {
+        return -1;                                                    // RETURN
+    }
+
+    bsls::AtomicOperations::setPtrRelaxed(d_slots_p + (bottom & d_mask), job);
+    d_bottom.storeRelease(bottom + 1);
+
+    return 0;
+}
+
+WorkStealingThreadPool_Deque::Job *WorkStealingThreadPool_Deque::steal()
+{
+    const bsls::Types::Int64 top    = d_top;
+    const bsls::Types::Int64 bottom = d_bottom;
+
+    if (top >= bottom) {
+        return 0;                                                     // RETURN
+    }
+
+    Job *job = static_cast<Job *>(bsls::AtomicOperations::getPtrRelaxed(
+                                               d_slots_p + (top & d_mask)));
+
+    if (top != d_top.testAndSwap(top, top + 1)) {
+        return 0;                                                     // RETURN
+    }
+
+    return job;
+}
+
+                   // ------------------------------------
+                   // struct WorkStealingThreadPool::Worker
+                   // ------------------------------------
+
+struct WorkStealingThreadPool::Worker {
+    // This 'struct' holds the state of a thread of a pool.
+
+    // DATA
+    WorkStealingThreadPool_Deque  d_deque;     // jobs of the thread
+
+    WorkStealingThreadPool       *d_pool_p;    // pool of the thread
+
+    bsls::AtomicInt               d_isActive;  // 1 while executing a job
+
+    unsigned int                  d_random;    // state of the generator used
+                                               // to select victims
+
+    // CREATORS
+    Worker(WorkStealingThreadPool *pool,
+           int                     index,
+           int                     dequeCapacity,
+           bslma::Allocator       *basicAllocator)
+    : d_deque(dequeCapacity, basicAllocator)
+    , d_pool_p(pool)
+    , d_isActive(0)
+    , d_random(2654435769u * (index + 1))
+    {
+    }
+
+    // MANIPULATORS
+    unsigned int random()
+        // Return the next value of the pseudo-random sequence of this thread.
+    {
+        // Marsaglia's xorshift generator.
+
+        d_random ^= d_random << 13;
+        d_random ^= d_random >> 17;
+        d_random ^= d_random << 5;
+        return d_random;
+    }
+};
+
+                        // ----------------------------
+                        // class WorkStealingThreadPool
+                        // ----------------------------
+
+// PRIVATE MANIPULATORS
+void WorkStealingThreadPool::deleteJob(Job *job)
+{
+    d_allocator_p->deleteObject(job);
+}
+
+void WorkStealingThreadPool::discardJobs()
+{
+    int numDiscarded = 0;
+
+    for (bsl::size_t i = 0; i < d_workers.size(); ++i) {
+        while (Job *job = d_workers[i]->d_deque.popBottom()) {
+            deleteJob(job);
+            ++numDiscarded;
+        }
+    }
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> lock(&d_queueMutex);
+
+        while (!d_queue.empty()) {
+            deleteJob(d_queue.front());
+            d_queue.pop_front();
+            ++numDiscarded;
+        }
+    }
+
+    if (0 == numDiscarded) {
+        return;                                                       // RETURN
+    }
+
+    d_numPendingJobs.add(-numDiscarded);
+    if (0 == d_numUnfinishedJobs.add(-numDiscarded)) {
+        bslmt::LockGuard<bslmt::Mutex> lock(&d_waitMutex);
+        d_drainCondition.broadcast();
+    }
+}
+
+void WorkStealingThreadPool::enqueueJobImp(Job *job, Worker *self)
+{
+    ++d_numUnfinishedJobs;
+
+    if (0 == self || 0 != self->d_deque.pushBottom(job)) {
+        bslmt::LockGuard<bslmt::Mutex> lock(&d_queueMutex);
+        d_queue.push_back(job);
+    }
+
+    ++d_numPendingJobs;
+
+    if (0 < d_numIdleThreads) {
+        bslmt::LockGuard<bslmt::Mutex> lock(&d_waitMutex);
+        d_idleCondition.signal();
+    }
+}
+
+WorkStealingThreadPool::Job *WorkStealingThreadPool::findJob(Worker *worker)
+{
+    Job *job = worker->d_deque.popBottom();
+    if (job) {
+        return job;                                                   // RETURN
+    }
+
+    if (0 == takeFromQueue(worker, &job)) {
+        return job;                                                   // RETURN
+    }
+
+    // Visit the other threads, starting at a random one.
+
+    const int numWorkers = static_cast<int>(d_workers.size());
+    const int first      = static_cast<int>(worker->random() % numWorkers);
+
+    for (int i = 0; i < numWorkers; ++i) {
+        Worker *victim = d_workers[(first + i) % numWorkers];
+
+        if (victim != worker) {
+            job = victim->d_deque.steal();
+            if (job) {
+                return job;                                           // RETURN
+            }
+        }
+    }
+
+    return 0;
+}
+
+void WorkStealingThreadPool::runJob(Worker *worker, Job *job)
+{
+    --d_numPendingJobs;
+
+    worker->d_isActive.storeRelaxed(1);
+    (*job)();
+    deleteJob(job);
+    worker->d_isActive.storeRelaxed(0);
+
+    if (0 == --d_numUnfinishedJobs && 0 < d_numDrainers) {
+        bslmt::LockGuard<bslmt::Mutex> lock(&d_waitMutex);
+        d_drainCondition.broadcast();
+    }
+}
+
+int WorkStealingThreadPool::startNewThread(int index)
+{
+#if defined(BSLS_PLATFORM_OS_UNIX)
+    // Block all asynchronous signals.
+
+    sigset_t oldset;
+    pthread_sigmask(SIG_BLOCK, &d_blockSet, &oldset);
+#endif
+
+    int rc = d_threadGroup.addThread(
+                    bdlf::BindUtil::bind(&WorkStealingThreadPool::workerThread,
+                                         this,
+                                         index),
+                    d_threadAttributes);
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+    // Restore the mask.
+
+    pthread_sigmask(SIG_SETMASK, &oldset, 0);
+#endif
+
+    return rc;
+}
+
+void WorkStealingThreadPool::stopThreads()
+{
+    {
+        bslmt::LockGuard<bslmt::Mutex> lock(&d_waitMutex);
+        d_control.storeRelease(e_STOP);
+        d_idleCondition.broadcast();
+    }
+    d_threadGroup.joinAll();
+}
+
+int WorkStealingThreadPool::takeFromQueue(Worker *worker, Job **job)
+{
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_queueMutex);
+
+    if (d_queue.empty()) {
+        return -1;                                                    // RETURN
+    }
+
+    *job = d_queue.front();
+    d_queue.pop_front();
+
+    // Move a fair share of the remaining jobs, pushing the newest first so
+    // that this thread pops the oldest first.
+
+    const bsl::size_t numMoved = bsl::min(d_queue.size() / d_numThreads,
+                                          k_MAX_BATCH_SIZE);
+
+    for (bsl::size_t i = numMoved; 0 < i; --i) {
+        if (0 != worker->d_deque.pushBottom(d_queue[i - 1])) {
+            // The deque is full: leave the jobs not yet moved in the queue.
+
+            d_queue.erase(d_queue.begin() + i, d_queue.begin() + numMoved);
+            return 0;                                                 // RETURN
+        }
+    }
+    d_queue.erase(d_queue.begin(), d_queue.begin() + numMoved);
+
+    return 0;
+}
+
+void WorkStealingThreadPool::waitForJob()
+{
+    if (0 < d_numPendingJobs) {
+        // A job is pending, but was taken or is being published by another
+        // thread.
+
+        bslmt::ThreadUtil::yield();
+        return;                                                       // RETURN
+    }
+
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_waitMutex);
+
+    ++d_numIdleThreads;
+    while (0 >= d_numPendingJobs && e_RUN == d_control.loadAcquire()) {
+        d_idleCondition.wait(&d_waitMutex);
+    }
+    --d_numIdleThreads;
+}
+
+void WorkStealingThreadPool::workerThread(int index)
+{
+    Worker *worker = d_workers[index];
+
+    bslmt::ThreadUtil::setSpecific(s_workerKey, worker);
+
+    while (e_RUN == d_control.loadAcquire()) {
+        Job *job = findJob(worker);
+        if (job) {
+            runJob(worker, job);
+        }
+        else {
+            waitForJob();
+        }
+    }
+
+    bslmt::ThreadUtil::setSpecific(s_workerKey, 0);
+}
+
+// CREATORS
+WorkStealingThreadPool::WorkStealingThreadPool(
+                                             int               numThreads,
+                                             bslma::Allocator *basicAllocator)
+: d_numPendingJobs(0)
+, d_numIdleThreads(0)
+, d_numUnfinishedJobs(0)
+, d_numDrainers(0)
+, d_enabled(false)
+, d_control(e_STOP)
+, d_workers(basicAllocator)
+, d_queue(basicAllocator)
+, d_threadGroup(basicAllocator)
+, d_threadAttributes()
+, d_numThreads(numThreads)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(1 <= numThreads);
+
+    BSLMT_ONCE_DO {
+        int rc = bslmt::ThreadUtil::createKey(&s_workerKey, 0);
+        BSLS_ASSERT_OPT(0 == rc);  (void)rc;
+    }
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+    initBlockSet(&d_blockSet);
+#endif
+
+    d_workers.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i) {
+        d_workers.push_back(new (*d_allocator_p) Worker(
+                                                     this,
+                                                     i,
+                                                     k_DEFAULT_DEQUE_CAPACITY,
+                                                     d_allocator_p));
+    }
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool(
+                       const bslmt::ThreadAttributes&  threadAttributes,
+                       int                             numThreads,
+                       bslma::Allocator               *basicAllocator)
+: d_numPendingJobs(0)
+, d_numIdleThreads(0)
+, d_numUnfinishedJobs(0)
+, d_numDrainers(0)
+, d_enabled(false)
+, d_control(e_STOP)
+, d_workers(basicAllocator)
+, d_queue(basicAllocator)
+, d_threadGroup(basicAllocator)
+, d_threadAttributes(threadAttributes)
+, d_numThreads(numThreads)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(1 <= numThreads);
+
+    BSLMT_ONCE_DO {
+        int rc = bslmt::ThreadUtil::createKey(&s_workerKey, 0);
+        BSLS_ASSERT_OPT(0 == rc);  (void)rc;
+    }
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+    initBlockSet(&d_blockSet);
+#endif
+
+    d_workers.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i) {
+        d_workers.push_back(new (*d_allocator_p) Worker(
+                                                     this,
+                                                     i,
+                                                     k_DEFAULT_DEQUE_CAPACITY,
+                                                     d_allocator_p));
+    }
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool(
+                       const bslmt::ThreadAttributes&  threadAttributes,
+                       int                             numThreads,
+                       int                             dequeCapacity,
+                       bslma::Allocator               *basicAllocator)
+: d_numPendingJobs(0)
+, d_numIdleThreads(0)
+, d_numUnfinishedJobs(0)
+, d_numDrainers(0)
+, d_enabled(false)
+, d_control(e_STOP)
+, d_workers(basicAllocator)
+, d_queue(basicAllocator)
+, d_threadGroup(basicAllocator)
+, d_threadAttributes(threadAttributes)
+, d_numThreads(numThreads)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(1 <= numThreads);
+    BSLS_ASSERT(0 < dequeCapacity);
+    BSLS_ASSERT(0 == (dequeCapacity & (dequeCapacity - 1)));
+
+    BSLMT_ONCE_DO {
+        int rc = bslmt::ThreadUtil::createKey(&s_workerKey, 0);
+        BSLS_ASSERT_OPT(0 == rc);  (void)rc;
+    }
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+    initBlockSet(&d_blockSet);
+#endif
+
+    d_workers.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i) {
+        d_workers.push_back(new (*d_allocator_p) Worker(this,
+                                                        i,
+                                                        dequeCapacity,
+                                                        d_allocator_p));
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+    shutdown();
+
+    for (bsl::size_t i = 0; i < d_workers.size(); ++i) {
+        d_allocator_p->deleteObject(d_workers[i]);
+    }
+}
+
+// MANIPULATORS
+int WorkStealingThreadPool::enqueueJob(const Job& functor)
+{
+    BSLS_ASSERT(functor);
+
+    Worker *self = currentWorker();
+
+    if (0 == self && !d_enabled) {
+        return -1;                                                    // RETURN
+    }
+
+    enqueueJobImp(new (*d_allocator_p) Job(bsl::allocator_arg,
+                                           d_allocator_p,
+                                           functor),
+                  self);
+    return 0;
+}
+
+int WorkStealingThreadPool::enqueueJob(bslmf::MovableRef<Job> functor)
+{
+    BSLS_ASSERT(bslmf::MovableRefUtil::access(functor));
+
+    Worker *self = currentWorker();
+
+    if (0 == self && !d_enabled) {
+        return -1;                                                    // RETURN
+    }
+
+    enqueueJobImp(new (*d_allocator_p) Job(
+                                     bsl::allocator_arg,
+                                     d_allocator_p,
+                                     bslmf::MovableRefUtil::move(functor)),
+                  self);
+    return 0;
+}
+
+void WorkStealingThreadPool::drain()
+{
+    if (!isStarted()) {
+        return;                                                       // RETURN
+    }
+
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_waitMutex);
+
+    ++d_numDrainers;
+    while (0 < d_numUnfinishedJobs) {
+        d_drainCondition.wait(&d_waitMutex);
+    }
+    --d_numDrainers;
+}
+
+void WorkStealingThreadPool::shutdown()
+{
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_metaMutex);
+
+    d_enabled = false;
+
+    if (e_RUN == d_control.loadAcquire()) {
+        stopThreads();
+    }
+    discardJobs();
+}
+
+int WorkStealingThreadPool::start()
+{
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_metaMutex);
+
+    if (e_RUN == d_control.loadAcquire()) {
+        return 0;                                                     // RETURN
+    }
+
+    d_control.storeRelease(e_RUN);
+
+    for (int i = 0; i < d_numThreads; ++i) {
+        if (0 != startNewThread(i)) {
+            stopThreads();
+            return -1;                                                // RETURN
+        }
+    }
+
+    d_enabled = true;
+
+    return 0;
+}
+
+void WorkStealingThreadPool::stop()
+{
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_metaMutex);
+
+    d_enabled = false;
+
+    if (e_RUN == d_control.loadAcquire()) {
+        drain();
+        stopThreads();
+    }
+
+    // Discard the jobs that were enqueued concurrently with disabling the
+    // pool, if any.
+
+    discardJobs();
+}
+
+// PRIVATE ACCESSORS
+WorkStealingThreadPool::Worker *WorkStealingThreadPool::currentWorker() const
+{
+    Worker *worker = static_cast<Worker *>(
+                                  bslmt::ThreadUtil::getSpecific(s_workerKey));
+
+    return worker && this == worker->d_pool_p ? worker : 0;
+}
+
+// ACCESSORS
+int WorkStealingThreadPool::dequeCapacity() const
+{
+    return d_workers[0]->d_deque.capacity();
+}
+
+int WorkStealingThreadPool::numActiveThreads() const
+{
+    int numActiveThreads = 0;
+
+    for (bsl::size_t i = 0; i < d_workers.size(); ++i) {
+        numActiveThreads += d_workers[i]->d_isActive.loadRelaxed();
+    }
+    return numActiveThreads;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License.  You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,635 @@
+// bdlmt_workstealingthreadpool.h                                     -*-C++-*-
+#ifndef INCLUDED_BDLMT_WORKSTEALINGTHREADPOOL
+#define INCLUDED_BDLMT_WORKSTEALINGTHREADPOOL
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a fixed-size thread pool with per-thread work stealing.
+//
+//@CLASSES:
+//  bdlmt::WorkStealingThreadPool: fixed-size work-stealing thread pool
+//  bdlmt::WorkStealingThreadPool_Deque: work-stealing deque of a thread
+//
+//@SEE_ALSO: bdlmt_fixedthreadpool, bdlmt_threadpool
+//
+//@DESCRIPTION: This component defines a thread pool,
+// 'bdlmt::WorkStealingThreadPool', that executes user-supplied functions
+// ("jobs") on a fixed number of threads, and that, unlike
+// 'bdlmt::FixedThreadPool' and 'bdlmt::ThreadPool', does not feed all its
+// threads from a single queue.  Instead, each thread of the pool owns a
+// work-stealing deque (see 'bdlmt::WorkStealingThreadPool_Deque'):
+//
+//: o A job enqueued by a job running in the pool (i.e., from one of the
+//:   threads of the pool) is pushed onto the deque of that thread, without
+//:   locking.
+//:
+//: o A thread executes the jobs of its own deque in last-in, first-out
+//:   order, so that the most recently enqueued (and most likely cache-hot)
+//:   job runs first.
+//:
+//: o A thread finding its deque empty takes a batch of jobs from a shared
+//:   queue, which holds the jobs enqueued by threads outside of the pool,
+//:   and, failing that, steals the oldest job of the deque of another
+//:   thread, chosen at random.
+//:
+//: o A thread finding no job at all waits until a job is enqueued.
+//
+// This organization makes a 'bdlmt::WorkStealingThreadPool' well suited to
+// fine-grained jobs (a few microseconds each), and in particular to jobs that
+// are divided recursively into smaller jobs (e.g., parallel divide and
+// conquer algorithms), on many cores.  For jobs enqueued from outside of the
+// pool, the shared queue (guarded by a mutex) remains a point of contention,
+// but each thread of the pool accesses it once per batch of jobs rather than
+// once per job.  Note that, in contrast to the other thread pools, the
+// execution order of jobs is not first-in, first-out.
+//
+// A 'bdlmt::WorkStealingThreadPool' otherwise follows the interface of
+// 'bdlmt::FixedThreadPool': the number of threads is fixed at construction,
+// 'start' creates the threads and enables enqueuing, 'drain' waits for all
+// the jobs (including the jobs they enqueue) to complete, 'stop' waits for
+// all the jobs to complete and then joins the threads, and 'shutdown'
+// discards the jobs not yet started and then joins the threads.  Unlike
+// 'bdlmt::FixedThreadPool', the number of pending jobs is not bounded, so
+// 'enqueueJob' never blocks.
+//
+// Enabling and disabling enqueuing only affects the threads outside of the
+// pool: the jobs of a started pool can always enqueue further jobs, so that
+// 'stop', which disables enqueuing and then waits for all the jobs to
+// complete, does not make the jobs it waits for fail to enqueue their parts.
+//
+///The Work-Stealing Deque
+///-----------------------
+// 'bdlmt::WorkStealingThreadPool_Deque' is a fixed-capacity Chase-Lev deque
+// of pointers: its owner thread pushes and pops at the bottom end, and any
+// thread may steal from the top end, all without locking.  When the deque of
+// a thread is full, the jobs it enqueues go to the shared queue instead,
+// which avoids having to reclaim the arrays of a growable deque while other
+// threads may still be stealing from them.  This class is an implementation
+// detail of this component, and is documented only to support its testing.
+//
+///Memory Allocation
+///-----------------
+// Each enqueued job is allocated, by the thread enqueuing it, using the
+// allocator supplied at construction, and deallocated by the thread executing
+// it.  When a large number of fine-grained jobs is expected, supplying an
+// allocator that scales across threads is therefore recommended.
+//
+///Thread Safety
+///-------------
+// The 'bdlmt::WorkStealingThreadPool' class is both *fully thread-safe*
+// (i.e., all non-creator methods can correctly execute concurrently), and is
+// *thread-enabled* (i.e., the class does not function correctly in a
+// non-multi-threading environment).  See 'bsldoc_glossary' for complete
+// definitions of *fully thread-safe* and *thread-enabled*.  Note that 'drain',
+// 'shutdown', and 'stop' must not be invoked from a job of the same pool.
+//
+///Synchronous Signals on Unix
+///---------------------------
+// As for 'bdlmt::FixedThreadPool', all the threads of the pool block all
+// asynchronous signals on Unix platforms.  Specifically, all the signals
+// except the following synchronous signals are blocked:
+//..
+// SIGBUS
+// SIGFPE
+// SIGILL
+// SIGSEGV
+// SIGSYS
+// SIGABRT
+// SIGTRAP
+// SIGIOT
+//..
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Parallel Recursive Summation
+///- - - - - - - - - - - - - - - - - - - -
+// In this example, we sum the elements of an array by recursively splitting
+// the array in halves, enqueuing a job for one half and processing the other
+// half in the current job, until the ranges are small enough to be summed
+// directly.  The jobs enqueued by the jobs of the pool go to the deque of the
+// enqueuing thread, from which idle threads steal them.
+//
+// First, we define a function summing a range of an array, and adding the
+// result to a total:
+//..
+//  void sumRange(bdlmt::WorkStealingThreadPool *pool,
+//                const int                     *begin,
+//                const int                     *end,
+//                bsls::AtomicInt64             *total)
+//      // Add the sum of the elements in the specified range '[begin, end)' to
+//      // the specified 'total', enqueuing jobs on the specified 'pool' for
+//      // parts of the range.
+//  {
+//      while (end - begin > 1000) {
+//          const int *middle = begin + (end - begin) / 2;
+//
+//          pool->enqueueJob(bdlf::BindUtil::bind(&sumRange,
+//                                                pool,
+//                                                middle,
+//                                                end,
+//                                                total));
+//          end = middle;
+//      }
+//
+//      bsls::Types::Int64 sum = 0;
+//      for (; begin != end; ++begin) {
+//          sum += *begin;
+//      }
+//      total->add(sum);
+//  }
+//..
+// Then, we create and start a pool of four threads:
+//..
+//  bdlmt::WorkStealingThreadPool pool(4);
+//  int rc = pool.start();
+//  assert(0 == rc);
+//..
+// Next, we create an array whose elements sum to a known value:
+//..
+//  bsl::vector<int> values(100000);
+//  for (int i = 0; i < static_cast<int>(values.size()); ++i) {
+//      values[i] = i % 10;
+//  }
+//..
+// Now, we enqueue the job summing the whole array, and wait for it, and all
+// the jobs it enqueues, to complete:
+//..
+//  bsls::AtomicInt64 total(0);
+//  rc = pool.enqueueJob(bdlf::BindUtil::bind(&sumRange,
+//                                            &pool,
+//                                            values.data(),
+//                                            values.data() + values.size(),
+//                                            &total));
+//  assert(0 == rc);
+//
+//  pool.drain();
+//..
+// Finally, we verify the result, and stop the pool:
+//..
+//  assert(450000 == total);
+//
+//  pool.stop();
+//..
+
+#include <bdlscm_version.h>
+
+#include <bslma_allocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_movableref.h>
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bslmt_condition.h>
+#include <bslmt_mutex.h>
+#include <bslmt_platform.h>
+#include <bslmt_threadattributes.h>
+#include <bslmt_threadgroup.h>
+
+#include <bsls_atomic.h>
+#include <bsls_atomicoperations.h>
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
+#include <bsl_deque.h>
+#include <bsl_functional.h>
+#include <bsl_vector.h>
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+#include <bsl_c_signal.h>              // sigset_t
+#endif
+
+namespace BloombergLP {
+namespace bdlmt {
+
+                    // ==================================
+                    // class WorkStealingThreadPool_Deque
+                    // ==================================
+
+class WorkStealingThreadPool_Deque {
+    // This class implements a fixed-capacity Chase-Lev work-stealing deque of
+    // pointers to jobs.  The owner thread of a deque pushes and pops jobs at
+    // its bottom end, and any thread may steal jobs from its top end.  The
+    // deque does not own the jobs it holds.
+
+  public:
+    // TYPES
+    typedef bsl::function<void()> Job;
+
+  private:
+    // PRIVATE TYPES
+    typedef bsls::AtomicOperations::AtomicTypes::Pointer Slot;
+
+    // DATA
+    bsls::AtomicInt64    d_top;     // index of the oldest job (stealers)
+
+    char                 d_topPad[bslmt::Platform::e_CACHE_LINE_SIZE -
+                                                   sizeof(bsls::AtomicInt64)];
+
+    bsls::AtomicInt64    d_bottom;  // index past the newest job (owner)
+
+    char                 d_bottomPad[bslmt::Platform::e_CACHE_LINE_SIZE -
+                                                   sizeof(bsls::AtomicInt64)];
+
+    Slot                *d_slots_p; // circular array of 'd_mask + 1' slots
+
+    bsls::Types::Int64   d_mask;    // capacity minus one
+
+    bslma::Allocator    *d_allocator_p;  // memory allocator (held, not owned)
+
+    // NOT IMPLEMENTED
+    WorkStealingThreadPool_Deque(const WorkStealingThreadPool_Deque&);
+    WorkStealingThreadPool_Deque& operator=(
+                                          const WorkStealingThreadPool_Deque&);
+
+  public:
+    // CREATORS
+    explicit WorkStealingThreadPool_Deque(
+                                      int               capacity,
+                                      bslma::Allocator *basicAllocator = 0);
+        // Create an empty deque able to hold the specified 'capacity' jobs.
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless 'capacity' is a positive
+        // power of two.
+
+    ~WorkStealingThreadPool_Deque();
+        // Destroy this object.
+
+    // MANIPULATORS
+    Job *popBottom();
+        // Remove the newest job from this deque and return it, or return 0 if
+        // this deque is empty.  The behavior is undefined unless this method
+        // is invoked by the owner thread of this deque.
+
+    int pushBottom(Job *job);
+        // Push the specified 'job' onto the bottom end of this deque.  Return
+        // 0 on success, and a non-zero value, with no effect, if this deque is
+        // full.  The behavior is undefined unless this method is invoked by
+        // the owner thread of this deque.
+
+    Job *steal();
+        // Remove the oldest job from this deque and return it, or return 0 if
+        // this deque is empty or if another thread removed the oldest job
+        // concurrently.
+
+    // ACCESSORS
+    int capacity() const;
+        // Return the maximum number of jobs this deque can hold.
+
+    int length() const;
+        // Return a snapshot of the number of jobs in this deque.
+};
+
+                        // ============================
+                        // class WorkStealingThreadPool
+                        // ============================
+
+class WorkStealingThreadPool {
+    // This class implements a thread pool executing jobs on a fixed number of
+    // threads, each of which owns a work-stealing deque of jobs.
+
+  public:
+    // TYPES
+    typedef bsl::function<void()> Job;
+
+    enum {
+        k_DEFAULT_DEQUE_CAPACITY = 4096  // default capacity of the deque of
+                                         // each thread
+    };
+
+  private:
+    // PRIVATE TYPES
+    struct Worker;
+        // The state of a thread of the pool, defined in the implementation.
+
+    enum {
+        e_STOP,  // the threads are stopped, or are stopping
+        e_RUN    // the threads are running
+    };
+
+    // DATA
+    bsls::AtomicInt          d_numPendingJobs;   // number of jobs enqueued
+                                                 // and not yet started
+
+    bsls::AtomicInt          d_numIdleThreads;   // number of threads waiting
+                                                 // for a job
+
+    char                     d_pad[bslmt::Platform::e_CACHE_LINE_SIZE];
+                                                 // separates the counters
+                                                 // above from the counter
+                                                 // below
+
+    bsls::AtomicInt          d_numUnfinishedJobs;
+                                                 // number of jobs enqueued
+                                                 // and not yet completed
+
+    bsls::AtomicInt          d_numDrainers;      // number of threads waiting
+                                                 // in 'drain'
+
+    bsls::AtomicBool         d_enabled;          // 'true' if enqueuing is
+                                                 // enabled
+
+    bsls::AtomicInt          d_control;          // 'e_RUN' or 'e_STOP'
+
+    bsl::vector<Worker *>    d_workers;          // state of each thread
+
+    bsl::deque<Job *>        d_queue;            // jobs enqueued from
+                                                 // outside of the pool
+
+    bslmt::Mutex             d_queueMutex;       // protects 'd_queue'
+
+    bslmt::Mutex             d_waitMutex;        // mutex for the conditions
+                                                 // below
+
+    bslmt::Condition         d_idleCondition;    // signaled when a job is
+                                                 // enqueued, or the threads
+                                                 // must stop
+
+    bslmt::Condition         d_drainCondition;   // signaled when the last
+                                                 // unfinished job completes
+
+    bslmt::Mutex             d_metaMutex;        // serializes 'start',
+                                                 // 'stop', and 'shutdown'
+
+    bslmt::ThreadGroup       d_threadGroup;      // threads of the pool
+
+    bslmt::ThreadAttributes  d_threadAttributes; // attributes of the threads
+
+    const int                d_numThreads;       // number of threads
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+    sigset_t                 d_blockSet;         // signals blocked in the
+                                                 // threads of the pool
+#endif
+
+    bslma::Allocator        *d_allocator_p;      // memory allocator (held,
+                                                 // not owned)
+
+    // PRIVATE MANIPULATORS
+    void deleteJob(Job *job);
+        // Destroy and deallocate the specified 'job'.
+
+    void discardJobs();
+        // Delete the jobs not yet started.  The behavior is undefined unless
+        // the threads of this pool are stopped.
+
+    void enqueueJobImp(Job *job, Worker *self);
+        // Enqueue the specified 'job' onto the deque of the specified 'self'
+        // state of the calling thread, or onto the shared queue if 'self' is
+        // 0 or its deque is full, and wake up a thread of this pool if any is
+        // waiting for a job.
+
+    Job *findJob(Worker *worker);
+        // Return a job for the thread having the specified 'worker' state to
+        // execute, taken from its deque, from the shared queue, or from the
+        // deque of another thread, in that order, or return 0 if no job is
+        // found.
+
+    void runJob(Worker *worker, Job *job);
+        // Execute, in the thread having the specified 'worker' state, and
+        // then delete, the specified 'job'.
+
+    int startNewThread(int index);
+        // Create the thread of this pool having the specified 'index'.
+        // Return 0 on success, and a non-zero value otherwise.
+
+    void stopThreads();
+        // Signal the threads of this pool to stop, and join them.
+
+    int takeFromQueue(Worker *worker, Job **job);
+        // Load into the specified 'job' the oldest job of the shared queue,
+        // and move up to a fair share of the following jobs of the shared
+        // queue to the deque of the specified 'worker'.  Return 0 on success,
+        // and a non-zero value if the shared queue is empty.
+
+    void waitForJob();
+        // Block until a job may be available, or the threads must stop.
+
+    void workerThread(int index);
+        // Execute jobs in the thread having the specified 'index' until the
+        // threads must stop.
+
+    // PRIVATE ACCESSORS
+    Worker *currentWorker() const;
+        // Return the state of the calling thread if it is a thread of this
+        // pool, and 0 otherwise.
+
+    // NOT IMPLEMENTED
+    WorkStealingThreadPool(const WorkStealingThreadPool&);
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&);
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(WorkStealingThreadPool,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit WorkStealingThreadPool(int               numThreads,
+                                    bslma::Allocator *basicAllocator = 0);
+    WorkStealingThreadPool(
+                       const bslmt::ThreadAttributes&  threadAttributes,
+                       int                             numThreads,
+                       bslma::Allocator               *basicAllocator = 0);
+    WorkStealingThreadPool(
+                       const bslmt::ThreadAttributes&  threadAttributes,
+                       int                             numThreads,
+                       int                             dequeCapacity,
+                       bslma::Allocator               *basicAllocator = 0);
+        // Create a thread pool of the specified 'numThreads' threads.
+        // Optionally specify 'threadAttributes' used to create the threads;
+        // if 'threadAttributes' is not specified, default-constructed
+        // attributes are used.  Optionally specify 'dequeCapacity', the
+        // number of jobs the deque of each thread can hold; if
+        // 'dequeCapacity' is not specified, 'k_DEFAULT_DEQUE_CAPACITY' is
+        // used.  Optionally specify a 'basicAllocator' used to supply memory.
+        // If 'basicAllocator' is 0, the currently installed default allocator
+        // is used.  The pool is created stopped, and enqueuing is disabled.
+        // The behavior is undefined unless '1 <= numThreads' and
+        // 'dequeCapacity' is a positive power of two.
+
+    ~WorkStealingThreadPool();
+        // Discard the jobs not yet started, block until the running jobs
+        // complete, and destroy this thread pool.
+
+    // MANIPULATORS
+    void disable();
+        // Disable enqueuing into this pool from threads outside of this pool.
+        // Subsequent calls to 'enqueueJob' from such threads will fail.  Note
+        // that this method has no effect on the jobs already in the pool, nor
+        // on the jobs they enqueue.
+
+    void enable();
+        // Enable enqueuing into this pool.
+
+    int enqueueJob(const Job& functor);
+    int enqueueJob(bslmf::MovableRef<Job> functor);
+        // Enqueue the specified 'functor' to be executed by a thread of this
+        // pool.  Return 0 on success, and a non-zero value if enqueuing is
+        // disabled and this method is invoked from a thread outside of this
+        // pool.  If this method is invoked from a thread of this pool, the
+        // job is pushed onto the deque of that thread (unless the deque is
+        // full), and is otherwise appended to the shared queue.  The behavior
+        // is undefined unless 'functor' is not "unset".
+
+    void drain();
+        // Block until all the jobs enqueued into this pool, including the
+        // jobs enqueued by those jobs, have completed.  Return immediately if
+        // this pool is not started.  The behavior is undefined if this method
+        // is invoked from a job of this pool.  Note that if jobs are enqueued
+        // from outside of this pool concurrently with this method, this
+        // method may or may not wait until they have also completed.
+
+    void shutdown();
+        // Disable enqueuing into this pool, discard the jobs not yet started,
+        // block until the running jobs complete, and join the threads of this
+        // pool.  The behavior is undefined if this method is invoked from a
+        // job of this pool.
+
+    int start();
+        // Create the threads of this pool and enable enqueuing.  Return 0 on
+        // success, and a non-zero value, with all the threads stopped, if the
+        // threads could not all be created.  This method has no effect if
+        // this pool is already started.
+
+    void stop();
+        // Disable enqueuing into this pool, block until all the jobs in this
+        // pool (including the jobs enqueued by those jobs) have completed,
+        // and join the threads of this pool.  The behavior is undefined if
+        // this method is invoked from a job of this pool.
+
+    // ACCESSORS
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this object to supply memory.
+
+    int dequeCapacity() const;
+        // Return the number of jobs the deque of each thread can hold.
+
+    bool isEnabled() const;
+        // Return 'true' if enqueuing is enabled on this thread pool, and
+        // 'false' otherwise.
+
+    bool isStarted() const;
+        // Return 'true' if the threads of this pool are started, and 'false'
+        // otherwise.
+
+    int numActiveThreads() const;
+        // Return a snapshot of the number of threads of this pool that are
+        // executing a job.
+
+    int numPendingJobs() const;
+        // Return a snapshot of the number of jobs enqueued into this pool and
+        // not yet started.
+
+    int numThreads() const;
+        // Return the number of threads of this pool.
+
+    int numThreadsStarted() const;
+        // Return a snapshot of the number of threads currently started by
+        // this pool.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                    // ----------------------------------
+                    // class WorkStealingThreadPool_Deque
+                    // ----------------------------------
+
+// ACCESSORS
+inline
+int WorkStealingThreadPool_Deque::capacity() const
+{
+    return static_cast<int>(d_mask + 1);
+}
+
+inline
+int WorkStealingThreadPool_Deque::length() const
+{
+    const bsls::Types::Int64 length = d_bottom.load() - d_top.load();
+
+    return 0 < length ? static_cast<int>(length) : 0;
+}
+
+                        // ----------------------------
+                        // class WorkStealingThreadPool
+                        // ----------------------------
+
+// MANIPULATORS
+inline
+void WorkStealingThreadPool::disable()
+{
+    d_enabled = false;
+}
+
+inline
+void WorkStealingThreadPool::enable()
+{
+    d_enabled = true;
+}
+
+// ACCESSORS
+inline
+bslma::Allocator *WorkStealingThreadPool::allocator() const
+{
+    return d_allocator_p;
+}
+
+inline
+bool WorkStealingThreadPool::isEnabled() const
+{
+    return d_enabled;
+}
+
+inline
+bool WorkStealingThreadPool::isStarted() const
+{
+    return e_RUN == d_control.loadAcquire();
+}
+
+inline
+int WorkStealingThreadPool::numPendingJobs() const
+{
+    // 'd_numPendingJobs' can be transiently negative, as a job is counted
+    // after it is published.
+
+    const int numPendingJobs = d_numPendingJobs;
+
+    return 0 < numPendingJobs ? numPendingJobs : 0;
+}
+
+inline
+int WorkStealingThreadPool::numThreads() const
+{
+    return d_numThreads;
+}
+
+inline
+int WorkStealingThreadPool::numThreadsStarted() const
+{
+    return d_threadGroup.numThreads();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License.  You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1382 @@
+// bdlmt_workstealingthreadpool.t.cpp                                 -*-C++-*-
+
+#include <bdlmt_workstealingthreadpool.h>
+
+#include <bdlmt_fixedthreadpool.h>
+#include <bdlmt_threadpool.h>
+
+#include <bdlf_bind.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+
+#include <bslmt_latch.h>
+#include <bslmt_lockguard.h>
+#include <bslmt_mutex.h>
+#include <bslmt_semaphore.h>
+#include <bslmt_threadgroup.h>
+#include <bslmt_threadutil.h>
+#include <bslmt_throughputbenchmark.h>
+#include <bslmt_throughputbenchmarkresult.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_timeinterval.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test provides a thread pool,
+// 'bdlmt::WorkStealingThreadPool', in which each thread owns a work-stealing
+// deque, 'bdlmt::WorkStealingThreadPool_Deque'.
+//
+// The deque is first tested on its own: single-threaded, to verify its
+// last-in, first-out behavior at the bottom end, its first-in, first-out
+// behavior at the top end, and its capacity; and multi-threaded, with thieves
+// stealing while the owner pushes and pops, to verify that each job is taken
+// exactly once.
+//
+// The pool is then tested through its public interface: the life cycle
+// ('start', 'stop', 'shutdown', 'enable', 'disable'), the execution order of
+// jobs enqueued by jobs, the overflow of a full deque into the shared queue,
+// 'drain' with recursively enqueued jobs, the discarding of pending jobs by
+// 'shutdown', and a stress test combining external producers and recursive
+// jobs.  A negative test case compares the throughput of this pool with that
+// of 'bdlmt::ThreadPool' and 'bdlmt::FixedThreadPool' using
+// 'bslmt::ThroughputBenchmark'.
+// ----------------------------------------------------------------------------
+// WorkStealingThreadPool_Deque
+// [ 2] WorkStealingThreadPool_Deque(int capacity, Allocator *a = 0);
+// [ 2] ~WorkStealingThreadPool_Deque();
+// [ 2] Job *popBottom();
+// [ 2] int pushBottom(Job *job);
+// [ 2] Job *steal();
+// [ 2] int capacity() const;
+// [ 2] int length() const;
+//
+// WorkStealingThreadPool
+// [ 4] WorkStealingThreadPool(int numThreads, Allocator *a = 0);
+// [ 4] WorkStealingThreadPool(attributes, numThreads, Allocator *a = 0);
+// [ 4] WorkStealingThreadPool(attributes, numThreads, capacity, a = 0);
+// [ 4] ~WorkStealingThreadPool();
+// [ 4] void disable();
+// [ 4] void enable();
+// [ 4] int enqueueJob(const Job& functor);
+// [ 4] int enqueueJob(bslmf::MovableRef<Job> functor);
+// [ 6] void drain();
+// [ 7] void shutdown();
+// [ 4] int start();
+// [ 4] void stop();
+// [ 4] bslma::Allocator *allocator() const;
+// [ 4] int dequeCapacity() const;
+// [ 4] bool isEnabled() const;
+// [ 4] bool isStarted() const;
+// [ 6] int numActiveThreads() const;
+// [ 6] int numPendingJobs() const;
+// [ 4] int numThreads() const;
+// [ 4] int numThreadsStarted() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] CONCURRENT DEQUE TEST
+// [ 5] LOCAL EXECUTION ORDER AND DEQUE OVERFLOW
+// [ 8] MULTI-THREADED STRESS TEST
+// [ 9] USAGE EXAMPLE
+// [-1] THROUGHPUT BENCHMARK
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static bool             verbose;
+static bool         veryVerbose;
+static bool     veryVeryVerbose;
+static bool veryVeryVeryVerbose;
+
+typedef bdlmt::WorkStealingThreadPool       Obj;
+typedef bdlmt::WorkStealingThreadPool_Deque Deque;
+typedef Obj::Job                            Job;
+
+// ============================================================================
+//                     GLOBAL HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+namespace u {
+
+class Recorder {
+    // This class records, in order, the identifiers passed to 'record' by
+    // jobs.
+
+    // DATA
+    mutable bslmt::Mutex d_mutex;   // protects 'd_ids'
+    bsl::vector<int>     d_ids;     // recorded identifiers
+
+  public:
+    // CREATORS
+    explicit Recorder(bslma::Allocator *basicAllocator = 0)
+    : d_ids(basicAllocator)
+    {
+    }
+
+    // MANIPULATORS
+    void record(int id)
+        // Record the specified 'id'.
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        d_ids.push_back(id);
+    }
+
+    // ACCESSORS
+    bsl::vector<int> ids() const
+        // Return the recorded identifiers.
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        return d_ids;
+    }
+};
+
+void increment(bsls::AtomicInt *counter)
+    // Increment the specified 'counter'.
+{
+    ++*counter;
+}
+
+void waitAndIncrement(bslmt::Semaphore *semaphore, bsls::AtomicInt *counter)
+    // Wait on the specified 'semaphore', then increment the specified
+    // 'counter'.
+{
+    semaphore->wait();
+    ++*counter;
+}
+
+void postAfter(bslmt::Semaphore *semaphore, int milliseconds)
+    // Post the specified 'semaphore' after sleeping for the specified
+    // 'milliseconds'.
+{
+    bslmt::ThreadUtil::microSleep(milliseconds * 1000);
+    semaphore->post();
+}
+
+void enqueueRecorders(Obj *pool, u::Recorder *recorder, int numJobs)
+    // Enqueue on the specified 'pool' the specified 'numJobs' jobs, the
+    // 'i'th of which records 'i' in the specified 'recorder'.
+{
+    for (int i = 0; i < numJobs; ++i) {
+        ASSERT(0 == pool->enqueueJob(bdlf::BindUtil::bind(&Recorder::record,
+                                                          recorder,
+                                                          i)));
+    }
+}
+
+void spawnTree(Obj *pool, int depth, bsls::AtomicInt *counter)
+    // Increment the specified 'counter', and, unless the specified 'depth' is
+    // 0, enqueue on the specified 'pool' two jobs doing the same at
+    // 'depth - 1'.  The number of increments resulting from a call at
+    // 'depth' is '2^(depth + 1) - 1'.
+{
+    ++*counter;
+    if (0 < depth) {
+        for (int i = 0; i < 2; ++i) {
+            ASSERT(0 == pool->enqueueJob(bdlf::BindUtil::bind(&spawnTree,
+                                                              pool,
+                                                              depth - 1,
+                                                              counter)));
+        }
+    }
+}
+
+}  // close namespace u
+}  // close unnamed namespace
+
+// ============================================================================
+//                 CONCURRENT DEQUE TEST SUPPORT
+// ----------------------------------------------------------------------------
+
+namespace dequeTest {
+
+const int k_NUM_JOBS    = 200000;
+const int k_NUM_THIEVES = 3;
+
+struct Shared {
+    // This 'struct' holds the state shared by the owner and the thieves.
+
+    Deque            *d_deque_p;      // deque under test
+    Job              *d_jobs_p;       // array of 'k_NUM_JOBS' jobs
+    bsls::AtomicInt  *d_taken_p;      // number of times each job was taken
+    bsls::AtomicInt   d_numTaken;     // total number of jobs taken
+    bsls::AtomicBool  d_done;         // 'true' once the owner is done
+};
+
+void take(Shared *shared, Job *job)
+    // Record that the specified 'job' of the specified 'shared' state was
+    // taken.
+{
+    ++shared->d_taken_p[job - shared->d_jobs_p];
+    ++shared->d_numTaken;
+}
+
+void owner(Shared *shared)
+    // Push all the jobs of the specified 'shared' state, popping one after
+    // every third push, and then pop until the deque is empty.
+{
+    int next = 0;
+    while (next < k_NUM_JOBS) {
+        if (0 == shared->d_deque_p->pushBottom(shared->d_jobs_p + next)) {
+            ++next;
+        }
+        if (0 == next % 3) {
+            if (Job *job = shared->d_deque_p->popBottom()) {
+                take(shared, job);
+            }
+        }
+    }
+    while (Job *job = shared->d_deque_p->popBottom()) {
+        take(shared, job);
+    }
+    shared->d_done = true;
+}
+
+void thief(Shared *shared)
+    // Steal jobs from the deque of the specified 'shared' state until the
+    // owner is done and the deque is empty.
+{
+    while (!shared->d_done || 0 < shared->d_deque_p->length()) {
+        if (Job *job = shared->d_deque_p->steal()) {
+            take(shared, job);
+        }
+    }
+}
+
+}  // close namespace dequeTest
+
+// ============================================================================
+//                 MULTI-THREADED STRESS TEST SUPPORT
+// ----------------------------------------------------------------------------
+
+namespace stress {
+
+const int k_NUM_PRODUCERS = 3;
+const int k_NUM_TREES     = 200;
+const int k_TREE_DEPTH    = 6;
+
+void producer(Obj *pool, bsls::AtomicInt *counter)
+    // Enqueue 'k_NUM_TREES' jobs spawning trees of jobs of depth
+    // 'k_TREE_DEPTH' on the specified 'pool', each job incrementing the
+    // specified 'counter'.
+{
+    for (int i = 0; i < k_NUM_TREES; ++i) {
+        ASSERT(0 == pool->enqueueJob(bdlf::BindUtil::bind(&u::spawnTree,
+                                                          pool,
+                                                          k_TREE_DEPTH,
+                                                          counter)));
+    }
+}
+
+}  // close namespace stress
+
+// ============================================================================
+//                       THROUGHPUT BENCHMARK SUPPORT
+// ----------------------------------------------------------------------------
+
+namespace bench {
+
+void work(bslmt::Latch *latch, bsls::Types::Int64 amount)
+    // Perform the specified 'amount' of busy work, then count down the
+    // specified 'latch'.
+{
+    bslmt::ThroughputBenchmark::busyWork(amount);
+    latch->arrive();
+}
+
+template <class POOL>
+void splitWork(POOL               *pool,
+               bslmt::Latch       *latch,
+               int                 numJobs,
+               bsls::Types::Int64  amount)
+    // Perform, on the specified 'pool', the specified 'numJobs' jobs each
+    // performing the specified 'amount' of busy work and counting down the
+    // specified 'latch', by recursively enqueuing half of the jobs and
+    // splitting the other half.
+{
+    while (1 < numJobs) {
+        const int half = numJobs / 2;
+        pool->enqueueJob(bdlf::BindUtil::bind(&splitWork<POOL>,
+                                              pool,
+                                              latch,
+                                              half,
+                                              amount));
+        numJobs -= half;
+    }
+    work(latch, amount);
+}
+
+template <class POOL>
+void flatRun(POOL *pool, int numJobs, bsls::Types::Int64 amount, int)
+    // Enqueue, from the calling thread, the specified 'numJobs' jobs each
+    // performing the specified 'amount' of busy work on the specified 'pool',
+    // and wait for their completion.
+{
+    bslmt::Latch latch(numJobs);
+    for (int i = 0; i < numJobs; ++i) {
+        pool->enqueueJob(bdlf::BindUtil::bind(&work, &latch, amount));
+    }
+    latch.wait();
+}
+
+template <class POOL>
+void nestedRun(POOL *pool, int numJobs, bsls::Types::Int64 amount, int)
+    // Enqueue on the specified 'pool' a job recursively enqueuing the
+    // specified 'numJobs' jobs each performing the specified 'amount' of busy
+    // work, and wait for their completion.
+{
+    bslmt::Latch latch(numJobs);
+    pool->enqueueJob(bdlf::BindUtil::bind(&splitWork<POOL>,
+                                          pool,
+                                          &latch,
+                                          numJobs,
+                                          amount));
+    latch.wait();
+}
+
+template <class POOL>
+double measure(POOL               *pool,
+               bool                nested,
+               int                 numSubmitters,
+               int                 numJobs,
+               bsls::Types::Int64  amount)
+    // Return the median number of jobs per second executed by the specified
+    // 'pool' when the specified 'numSubmitters' threads each repeatedly
+    // submit the specified 'numJobs' jobs, each performing the specified
+    // 'amount' of busy work, and wait for their completion; the jobs are
+    // enqueued by the submitting thread, or, if the specified 'nested' is
+    // 'true', recursively by the jobs themselves.
+{
+    bslma::Allocator *allocator = &bslma::NewDeleteAllocator::singleton();
+
+    bslmt::ThroughputBenchmark       benchmark(allocator);
+    bslmt::ThroughputBenchmarkResult result(allocator);
+
+    bsl::function<void(int)> run;
+    if (nested) {
+        run = bdlf::BindUtil::bind(&nestedRun<POOL>,
+                                   pool,
+                                   numJobs,
+                                   amount,
+                                   bdlf::PlaceHolders::_1);
+    }
+    else {
+        run = bdlf::BindUtil::bind(&flatRun<POOL>,
+                                   pool,
+                                   numJobs,
+                                   amount,
+                                   bdlf::PlaceHolders::_1);
+    }
+
+    const int group = benchmark.addThreadGroup(run, numSubmitters, 0);
+    benchmark.execute(&result, 500, 5);
+
+    double median;
+    result.getMedian(&median, group);
+    return median * numJobs;
+}
+
+}  // close namespace bench
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+namespace usage {
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Parallel Recursive Summation
+///- - - - - - - - - - - - - - - - - - - -
+// In this example, we sum the elements of an array by recursively splitting
+// the array in halves, enqueuing a job for one half and processing the other
+// half in the current job, until the ranges are small enough to be summed
+// directly.  The jobs enqueued by the jobs of the pool go to the deque of the
+// enqueuing thread, from which idle threads steal them.
+//
+// First, we define a function summing a range of an array, and adding the
+// result to a total:
+//..
+    void sumRange(bdlmt::WorkStealingThreadPool *pool,
+                  const int                     *begin,
+                  const int                     *end,
+                  bsls::AtomicInt64             *total)
+        // Add the sum of the elements in the specified range '[begin, end)' to
+        // the specified 'total', enqueuing jobs on the specified 'pool' for
+        // parts of the range.
+    {
+        while (end - begin > 1000) {
+            const int *middle = begin + (end - begin) / 2;
+
+            pool->enqueueJob(bdlf::BindUtil::bind(&sumRange,
+                                                  pool,
+                                                  middle,
+                                                  end,
+                                                  total));
+            end = middle;
+        }
+
+        bsls::Types::Int64 sum = 0;
+        for (; begin != end; ++begin) {
+            sum += *begin;
+        }
+        total->add(sum);
+    }
+//..
+
+void example1()
+{
+// Then, we create and start a pool of four threads:
+//..
+    bdlmt::WorkStealingThreadPool pool(4);
+    int rc = pool.start();
+    ASSERT(0 == rc);
+//..
+// Next, we create an array whose elements sum to a known value:
+//..
+    bsl::vector<int> values(100000);
+    for (int i = 0; i < static_cast<int>(values.size()); ++i) {
+        values[i] = i % 10;
+    }
+//..
+// Now, we enqueue the job summing the whole array, and wait for it, and all
+// the jobs it enqueues, to complete:
+//..
+    bsls::AtomicInt64 total(0);
+    rc = pool.enqueueJob(bdlf::BindUtil::bind(&sumRange,
+                                              &pool,
+                                              values.data(),
+                                              values.data() + values.size(),
+                                              &total));
+    ASSERT(0 == rc);
+
+    pool.drain();
+//..
+// Finally, we verify the result, and stop the pool:
+//..
+    ASSERT(450000 == total);
+
+    pool.stop();
+//..
+}
+
+}  // close namespace usage
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test            = argc > 1 ? atoi(argv[1]) : 0;
+    verbose             = argc > 2;
+    veryVerbose         = argc > 3;
+    veryVeryVerbose     = argc > 4;
+    veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator         defaultAllocator("default",
+                                                  veryVeryVeryVerbose);
+    bslma::DefaultAllocatorGuard defaultAllocatorGuard(&defaultAllocator);
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:
+      case 9: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        usage::example1();
+      } break;
+      case 8: {
+        // --------------------------------------------------------------------
+        // MULTI-THREADED STRESS TEST
+        //
+        // Concerns:
+        //: 1 Every job enqueued concurrently by threads outside of the pool,
+        //:   and recursively by jobs of the pool, is executed exactly once.
+        //:
+        //: 2 'drain' waits for all those jobs.
+        //:
+        //: 3 All memory is returned.
+        //
+        // Plan:
+        //: 1 Have several threads enqueue jobs spawning trees of jobs on a
+        //:   pool whose deques are small (so that they overflow), drain the
+        //:   pool, and verify the number of executed jobs.  (C-1..2)
+        //:
+        //: 2 Verify that the test allocator has no blocks in use after the
+        //:   pool is destroyed.  (C-3)
+        //
+        // Testing:
+        //   MULTI-THREADED STRESS TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MULTI-THREADED STRESS TEST" << endl
+                          << "==========================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            Obj             mX(bslmt::ThreadAttributes(), 4, 16, &ta);
+            bsls::AtomicInt counter(0);
+
+            ASSERT(0 == mX.start());
+
+            for (int iteration = 0; iteration < 3; ++iteration) {
+                counter = 0;
+
+                bslmt::ThreadGroup producers(&ta);
+                producers.addThreads(bdlf::BindUtil::bind(&stress::producer,
+                                                          &mX,
+                                                          &counter),
+                                     stress::k_NUM_PRODUCERS);
+                producers.joinAll();
+                mX.drain();
+
+                const int EXPECTED = stress::k_NUM_PRODUCERS
+                                   * stress::k_NUM_TREES
+                                   * ((2 << stress::k_TREE_DEPTH) - 1);
+
+                ASSERTV(iteration, EXPECTED, counter, EXPECTED == counter);
+                ASSERTV(mX.numPendingJobs(), 0 == mX.numPendingJobs());
+            }
+            mX.stop();
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // SHUTDOWN
+        //
+        // Concerns:
+        //: 1 'shutdown' waits for the running jobs, and discards the jobs not
+        //:   yet started, releasing their memory.
+        //:
+        //: 2 The destructor of a started pool behaves as 'shutdown'.
+        //:
+        //: 3 A pool can be restarted after 'shutdown'.
+        //
+        // Plan:
+        //: 1 Using a single-thread pool, enqueue a job blocking on a
+        //:   semaphore, and then several other jobs.  Have another thread post
+        //:   the semaphore after a delay, and invoke 'shutdown'.  Verify that
+        //:   only the blocking job has run, and that no memory is in use.
+        //:   (C-1)
+        //:
+        //: 2 Restart the pool, and verify that jobs run.  (C-3)
+        //:
+        //: 3 Repeat P-1 with the destructor in place of 'shutdown'.  (C-2)
+        //
+        // Testing:
+        //   void shutdown();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "SHUTDOWN" << endl
+                          << "========" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        if (verbose) cout << "\tShutdown and restart." << endl;
+        {
+            Obj              mX(1, &ta);  const Obj& X = mX;
+            bslmt::Semaphore semaphore;
+            bsls::AtomicInt  counter(0);
+
+            ASSERT(0 == mX.start());
+            ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(
+                                                        &u::waitAndIncrement,
+                                                        &semaphore,
+                                                        &counter)));
+            for (int i = 0; i < 100 && 0 == X.numActiveThreads(); ++i) {
+                bslmt::ThreadUtil::microSleep(10 * 1000);
+            }
+            ASSERT(1 == X.numActiveThreads());
+
+            for (int i = 0; i < 10; ++i) {
+                ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(&u::increment,
+                                                               &counter)));
+            }
+            ASSERT(10 == X.numPendingJobs());
+
+            bslmt::ThreadUtil::Handle handle;
+            ASSERT(0 == bslmt::ThreadUtil::createWithAllocator(
+                                 &handle,
+                                 bdlf::BindUtil::bind(&u::postAfter,
+                                                      &semaphore,
+                                                      100),
+                                 &ta));
+            mX.shutdown();
+            ASSERT(0 == bslmt::ThreadUtil::join(handle));
+
+            ASSERT(1 == counter);
+            ASSERT(0 == X.numPendingJobs());
+            ASSERT(false == X.isStarted());
+            ASSERT(false == X.isEnabled());
+            ASSERT(0 == X.numThreadsStarted());
+            ASSERT(0 != mX.enqueueJob(bdlf::BindUtil::bind(&u::increment,
+                                                           &counter)));
+
+            ASSERT(0 == mX.start());
+            ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(&u::increment,
+                                                           &counter)));
+            mX.drain();
+            ASSERT(2 == counter);
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tDestructor." << endl;
+        {
+            bslmt::Semaphore          semaphore;
+            bsls::AtomicInt           counter(0);
+            bslmt::ThreadUtil::Handle handle;
+            {
+                Obj mX(1, &ta);  const Obj& X = mX;
+
+                ASSERT(0 == mX.start());
+                ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(
+                                                        &u::waitAndIncrement,
+                                                        &semaphore,
+                                                        &counter)));
+                for (int i = 0; i < 100 && 0 == X.numActiveThreads(); ++i) {
+                    bslmt::ThreadUtil::microSleep(10 * 1000);
+                }
+                for (int i = 0; i < 10; ++i) {
+                    ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(
+                                                               &u::increment,
+                                                               &counter)));
+                }
+                ASSERT(0 == bslmt::ThreadUtil::createWithAllocator(
+                                 &handle,
+                                 bdlf::BindUtil::bind(&u::postAfter,
+                                                      &semaphore,
+                                                      100),
+                                 &ta));
+            }
+            ASSERT(0 == bslmt::ThreadUtil::join(handle));
+            ASSERT(1 == counter);
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // DRAIN AND JOB COUNTS
+        //
+        // Concerns:
+        //: 1 'drain' waits for all the jobs, including the jobs enqueued
+        //:   recursively by jobs, and leaves the pool running.
+        //:
+        //: 2 'drain' returns immediately on a pool that is not started.
+        //:
+        //: 3 'numPendingJobs' and 'numActiveThreads' reflect the jobs waiting
+        //:   and running.
+        //
+        // Plan:
+        //: 1 Enqueue a job spawning a tree of jobs, drain the pool, and verify
+        //:   the number of executed jobs; repeat.  (C-1)
+        //:
+        //: 2 Invoke 'drain' on a pool that is not started.  (C-2)
+        //:
+        //: 3 Block all the threads of a pool in jobs waiting on a semaphore,
+        //:   enqueue further jobs, and verify the counts; then post the
+        //:   semaphore and verify the counts after draining.  (C-3)
+        //
+        // Testing:
+        //   void drain();
+        //   int numActiveThreads() const;
+        //   int numPendingJobs() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "DRAIN AND JOB COUNTS" << endl
+                          << "====================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            Obj mX(4, &ta);  const Obj& X = mX;
+
+            mX.drain();
+
+            ASSERT(0 == mX.start());
+
+            for (int depth = 0; depth < 12; ++depth) {
+                bsls::AtomicInt counter(0);
+
+                ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(&u::spawnTree,
+                                                               &mX,
+                                                               depth,
+                                                               &counter)));
+                mX.drain();
+                ASSERTV(depth, counter, (2 << depth) - 1 == counter);
+                ASSERT(X.isStarted());
+            }
+
+            bslmt::Semaphore semaphore;
+            bsls::AtomicInt  counter(0);
+
+            for (int i = 0; i < 4; ++i) {
+                ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(
+                                                        &u::waitAndIncrement,
+                                                        &semaphore,
+                                                        &counter)));
+            }
+            for (int i = 0; i < 100 && 4 != X.numActiveThreads(); ++i) {
+                bslmt::ThreadUtil::microSleep(10 * 1000);
+            }
+            ASSERTV(X.numActiveThreads(), 4 == X.numActiveThreads());
+            ASSERTV(X.numPendingJobs(),   0 == X.numPendingJobs());
+
+            for (int i = 0; i < 6; ++i) {
+                ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(&u::increment,
+                                                               &counter)));
+            }
+            ASSERTV(X.numPendingJobs(), 6 == X.numPendingJobs());
+
+            semaphore.post(4);
+            mX.drain();
+            ASSERT(10 == counter);
+            ASSERT(0  == X.numActiveThreads());
+            ASSERT(0  == X.numPendingJobs());
+
+            mX.stop();
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // LOCAL EXECUTION ORDER AND DEQUE OVERFLOW
+        //
+        // Concerns:
+        //: 1 Jobs enqueued by a job are executed, by the same thread, in
+        //:   last-in, first-out order.
+        //:
+        //: 2 Jobs enqueued from outside of the pool are executed, by a single
+        //:   thread, in first-in, first-out order.
+        //:
+        //: 3 Jobs enqueued by a job whose deque is full are not lost.
+        //
+        // Plan:
+        //: 1 Using a single-thread pool, enqueue a job enqueuing jobs
+        //:   recording their index, and verify the recorded order.  (C-1)
+        //:
+        //: 2 Using a single-thread pool, enqueue from the main thread, while
+        //:   the thread of the pool is blocked, jobs recording their index,
+        //:   and verify the recorded order.  (C-2)
+        //:
+        //: 3 Using a pool whose deques hold 4 jobs, enqueue a job enqueuing
+        //:   100 jobs, and verify that all of them are executed.  (C-3)
+        //
+        // Testing:
+        //   LOCAL EXECUTION ORDER AND DEQUE OVERFLOW
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                      << "LOCAL EXECUTION ORDER AND DEQUE OVERFLOW" << endl
+                      << "========================================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        if (verbose) cout << "\tLast-in, first-out." << endl;
+        {
+            Obj         mX(1, &ta);
+            u::Recorder recorder(&ta);
+
+            ASSERT(0 == mX.start());
+            ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(
+                                                         &u::enqueueRecorders,
+                                                         &mX,
+                                                         &recorder,
+                                                         10)));
+            mX.drain();
+
+            const bsl::vector<int> ids = recorder.ids();
+            ASSERTV(ids.size(), 10 == ids.size());
+            for (int i = 0; i < static_cast<int>(ids.size()); ++i) {
+                ASSERTV(i, ids[i], 9 - i == ids[i]);
+            }
+        }
+
+        if (verbose) cout << "\tFirst-in, first-out." << endl;
+        {
+            Obj              mX(1, &ta);
+            u::Recorder      recorder(&ta);
+            bslmt::Semaphore semaphore;
+            bsls::AtomicInt  counter(0);
+
+            ASSERT(0 == mX.start());
+            ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(
+                                                        &u::waitAndIncrement,
+                                                        &semaphore,
+                                                        &counter)));
+            u::enqueueRecorders(&mX, &recorder, 300);
+            semaphore.post();
+            mX.drain();
+
+            const bsl::vector<int> ids = recorder.ids();
+            ASSERTV(ids.size(), 300 == ids.size());
+            for (int i = 0; i < static_cast<int>(ids.size()); ++i) {
+                ASSERTV(i, ids[i], i == ids[i]);
+            }
+        }
+
+        if (verbose) cout << "\tDeque overflow." << endl;
+        {
+            Obj         mX(bslmt::ThreadAttributes(), 2, 4, &ta);
+            u::Recorder recorder(&ta);
+
+            ASSERT(4 == mX.dequeCapacity());
+            ASSERT(0 == mX.start());
+            ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(
+                                                         &u::enqueueRecorders,
+                                                         &mX,
+                                                         &recorder,
+                                                         100)));
+            mX.drain();
+
+            bsl::vector<int> ids = recorder.ids();
+            ASSERTV(ids.size(), 100 == ids.size());
+
+            bsl::vector<int> seen(100, 0);
+            for (int i = 0; i < static_cast<int>(ids.size()); ++i) {
+                ++seen[ids[i]];
+            }
+            for (int i = 0; i < 100; ++i) {
+                ASSERTV(i, seen[i], 1 == seen[i]);
+            }
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // CREATORS, LIFE CYCLE, AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 The constructors set the number of threads, the deque capacity,
+        //:   and the allocator; a pool is created stopped and disabled.
+        //:
+        //: 2 'start' creates the threads and enables enqueuing, and is
+        //:   idempotent.
+        //:
+        //: 3 'disable' makes 'enqueueJob' fail, and 'enable' restores it.
+        //:
+        //: 4 'stop' executes all the jobs, joins the threads, and disables
+        //:   enqueuing; the pool can be restarted.
+        //:
+        //: 5 Both 'enqueueJob' overloads enqueue the job.
+        //:
+        //: 6 Thread attributes are honored.
+        //:
+        //: 7 The destructor of a stopped pool releases all memory.
+        //
+        // Plan:
+        //: 1 Create pools with each constructor and verify the accessors.
+        //:   (C-1)
+        //:
+        //: 2 Exercise the life cycle, verifying the accessors and the jobs
+        //:   executed at each step.  (C-2..6)
+        //:
+        //: 3 Verify that the test allocator has no blocks in use after the
+        //:   pool is destroyed.  (C-7)
+        //
+        // Testing:
+        //   WorkStealingThreadPool(int numThreads, Allocator *a = 0);
+        //   WorkStealingThreadPool(attributes, numThreads, Allocator *a = 0);
+        //   WorkStealingThreadPool(attributes, numThreads, capacity, a = 0);
+        //   ~WorkStealingThreadPool();
+        //   void disable();
+        //   void enable();
+        //   int enqueueJob(const Job& functor);
+        //   int enqueueJob(bslmf::MovableRef<Job> functor);
+        //   int start();
+        //   void stop();
+        //   bslma::Allocator *allocator() const;
+        //   int dequeCapacity() const;
+        //   bool isEnabled() const;
+        //   bool isStarted() const;
+        //   int numThreads() const;
+        //   int numThreadsStarted() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                     << "CREATORS, LIFE CYCLE, AND BASIC ACCESSORS" << endl
+                     << "=========================================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        if (verbose) cout << "\tConstructors." << endl;
+        {
+            Obj mX(3);  const Obj& X = mX;
+
+            ASSERT(&defaultAllocator == X.allocator());
+            ASSERT(3 == X.numThreads());
+            ASSERT(Obj::k_DEFAULT_DEQUE_CAPACITY == X.dequeCapacity());
+            ASSERT(false == X.isStarted());
+            ASSERT(false == X.isEnabled());
+            ASSERT(0 == X.numThreadsStarted());
+            ASSERT(0 == X.numPendingJobs());
+            ASSERT(0 == X.numActiveThreads());
+        }
+        {
+            Obj mX(bslmt::ThreadAttributes(), 2, &ta);  const Obj& X = mX;
+
+            ASSERT(&ta == X.allocator());
+            ASSERT(2 == X.numThreads());
+            ASSERT(Obj::k_DEFAULT_DEQUE_CAPACITY == X.dequeCapacity());
+        }
+        {
+            Obj mX(bslmt::ThreadAttributes(), 5, 64, &ta);  const Obj& X = mX;
+
+            ASSERT(&ta == X.allocator());
+            ASSERT(5  == X.numThreads());
+            ASSERT(64 == X.dequeCapacity());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tLife cycle." << endl;
+        {
+            bslmt::ThreadAttributes attributes;
+            attributes.setStackSize(256 * 1024);
+
+            Obj             mX(attributes, 3, &ta);  const Obj& X = mX;
+            bsls::AtomicInt counter(0);
+
+            ASSERT(0 != mX.enqueueJob(bdlf::BindUtil::bind(&u::increment,
+                                                           &counter)));
+
+            ASSERT(0 == mX.start());
+            ASSERT(true == X.isStarted());
+            ASSERT(true == X.isEnabled());
+            ASSERT(3 == X.numThreadsStarted());
+            ASSERT(0 == mX.start());
+            ASSERT(3 == X.numThreadsStarted());
+
+            for (int i = 0; i < 50; ++i) {
+                ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(&u::increment,
+                                                               &counter)));
+                Job job(bdlf::BindUtil::bind(&u::increment, &counter));
+                ASSERT(0 == mX.enqueueJob(bslmf::MovableRefUtil::move(job)));
+            }
+
+            mX.disable();
+            ASSERT(false == X.isEnabled());
+            ASSERT(0 != mX.enqueueJob(bdlf::BindUtil::bind(&u::increment,
+                                                           &counter)));
+            mX.enable();
+            ASSERT(true == X.isEnabled());
+
+            mX.stop();
+            ASSERT(100   == counter);
+            ASSERT(false == X.isStarted());
+            ASSERT(false == X.isEnabled());
+            ASSERT(0     == X.numThreadsStarted());
+            ASSERT(0 != mX.enqueueJob(bdlf::BindUtil::bind(&u::increment,
+                                                           &counter)));
+            mX.stop();
+
+            ASSERT(0 == mX.start());
+            ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(&u::increment,
+                                                           &counter)));
+            mX.stop();
+            ASSERT(101 == counter);
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CONCURRENT DEQUE TEST
+        //
+        // Concerns:
+        //: 1 When thieves steal from a deque while its owner pushes and pops,
+        //:   each job is taken exactly once, including when the owner and the
+        //:   thieves race for the last job.
+        //
+        // Plan:
+        //: 1 Have the owner push many jobs into a small deque, popping one of
+        //:   every three, while several thieves steal.  Verify that each job
+        //:   was taken exactly once.  (C-1)
+        //
+        // Testing:
+        //   CONCURRENT DEQUE TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENT DEQUE TEST" << endl
+                          << "=====================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            Deque                   deque(64, &ta);
+            bsl::vector<Job>        jobs(&ta);
+            bsls::AtomicInt        *taken = new bsls::AtomicInt[
+                                                      dequeTest::k_NUM_JOBS];
+            dequeTest::Shared       shared;
+
+            jobs.resize(dequeTest::k_NUM_JOBS);
+
+            shared.d_deque_p = &deque;
+            shared.d_jobs_p  = jobs.data();
+            shared.d_taken_p = taken;
+
+            bslmt::ThreadGroup threads(&ta);
+            threads.addThreads(bdlf::BindUtil::bind(&dequeTest::thief,
+                                                    &shared),
+                               dequeTest::k_NUM_THIEVES);
+            threads.addThread(bdlf::BindUtil::bind(&dequeTest::owner,
+                                                   &shared));
+            threads.joinAll();
+
+            ASSERTV(shared.d_numTaken,
+                    dequeTest::k_NUM_JOBS == shared.d_numTaken);
+            for (int i = 0; i < dequeTest::k_NUM_JOBS; ++i) {
+                ASSERTV(i, taken[i], 1 == taken[i]);
+            }
+            ASSERT(0 == deque.length());
+
+            delete [] taken;
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // DEQUE BASIC OPERATIONS
+        //
+        // Concerns:
+        //: 1 'popBottom' returns the jobs in last-in, first-out order.
+        //:
+        //: 2 'steal' returns the jobs in first-in, first-out order.
+        //:
+        //: 3 'pushBottom' fails, with no effect, once the deque holds
+        //:   'capacity' jobs.
+        //:
+        //: 4 'popBottom' and 'steal' return 0 on an empty deque.
+        //:
+        //: 5 'length' reflects the number of jobs, and the deque keeps
+        //:   working as its indices wrap around the array.
+        //:
+        //: 6 Memory is supplied by the specified allocator and released on
+        //:   destruction.
+        //
+        // Plan:
+        //: 1 Fill a deque to capacity, and verify that a further push fails.
+        //:   (C-3, 5)
+        //:
+        //: 2 Empty it alternately with 'popBottom' and 'steal', verifying the
+        //:   jobs returned.  (C-1..2, 4..5)
+        //:
+        //: 3 Repeat many times, so that the indices wrap around.  (C-5)
+        //:
+        //: 4 Verify the allocator usage.  (C-6)
+        //
+        // Testing:
+        //   WorkStealingThreadPool_Deque(int capacity, Allocator *a = 0);
+        //   ~WorkStealingThreadPool_Deque();
+        //   Job *popBottom();
+        //   int pushBottom(Job *job);
+        //   Job *steal();
+        //   int capacity() const;
+        //   int length() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "DEQUE BASIC OPERATIONS" << endl
+                          << "======================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            const int CAPACITY = 8;
+
+            Deque mX(CAPACITY, &ta);  const Deque& X = mX;
+            Job   jobs[CAPACITY + 1];
+
+            ASSERT(1 == ta.numBlocksInUse());
+            ASSERT(CAPACITY == X.capacity());
+            ASSERT(0 == X.length());
+            ASSERT(0 == mX.popBottom());
+            ASSERT(0 == mX.steal());
+
+            for (int round = 0; round < 100; ++round) {
+                for (int i = 0; i < CAPACITY; ++i) {
+                    ASSERTV(round, i, 0 == mX.pushBottom(jobs + i));
+                    ASSERTV(round, i, i + 1 == X.length());
+                }
+                ASSERT(0 != mX.pushBottom(jobs + CAPACITY));
+                ASSERT(CAPACITY == X.length());
+
+                // Alternate: pop the newest, steal the oldest.
+
+                int bottom = CAPACITY - 1;
+                int top    = 0;
+                for (int i = 0; i < CAPACITY; ++i) {
+                    if (i % 2) {
+                        ASSERTV(round, i, jobs + top == mX.steal());
+                        ++top;
+                    }
+                    else {
+                        ASSERTV(round, i, jobs + bottom == mX.popBottom());
+                        --bottom;
+                    }
+                    ASSERTV(round, i, CAPACITY - i - 1 == X.length());
+                }
+                ASSERT(0 == mX.popBottom());
+                ASSERT(0 == mX.steal());
+
+                // An odd number of operations, so that the indices are not
+                // aligned on the capacity in the next round.
+
+                ASSERT(0 == mX.pushBottom(jobs));
+                ASSERT(jobs == mX.steal());
+            }
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Start a pool, enqueue jobs from the main thread and from jobs,
+        //:   drain and stop the pool, and verify that all the jobs ran.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        {
+            Obj             mX(4, &ta);  const Obj& X = mX;
+            bsls::AtomicInt counter(0);
+
+            ASSERT(4 == X.numThreads());
+            ASSERT(0 == mX.start());
+
+            for (int i = 0; i < 1000; ++i) {
+                ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(&u::increment,
+                                                               &counter)));
+            }
+            mX.drain();
+            ASSERT(1000 == counter);
+
+            ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(&u::spawnTree,
+                                                           &mX,
+                                                           5,
+                                                           &counter)));
+            mX.stop();
+            ASSERT(1063 == counter);
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // THROUGHPUT BENCHMARK
+        //   Compare the throughput, in jobs per second, of
+        //   'bdlmt::ThreadPool', 'bdlmt::FixedThreadPool', and
+        //   'bdlmt::WorkStealingThreadPool', for jobs enqueued by submitting
+        //   threads ("flat") and for jobs enqueued recursively by jobs
+        //   ("nested").
+        //
+        //   2nd parameter: number of threads of the pools (default 4)
+        //   3rd parameter: number of submitting threads (default 2)
+        //   4th parameter: number of jobs per submission (default 1000)
+        //   5th parameter: duration of a job, in microseconds (default 2)
+        //
+        // Testing:
+        //   THROUGHPUT BENCHMARK
+        // --------------------------------------------------------------------
+
+        const int numThreads    = argc > 2 ? atoi(argv[2]) : 4;
+        const int numSubmitters = argc > 3 ? atoi(argv[3]) : 2;
+        const int numJobs       = argc > 4 ? atoi(argv[4]) : 1000;
+        const int microseconds  = argc > 5 ? atoi(argv[5]) : 2;
+
+        cout << "THROUGHPUT BENCHMARK" << endl
+             << "====================" << endl;
+        P_(numThreads); P_(numSubmitters); P_(numJobs); P(microseconds);
+
+        bslma::Allocator *alloc = &bslma::NewDeleteAllocator::singleton();
+
+        const bsls::Types::Int64 amount =
+            bslmt::ThroughputBenchmark::estimateBusyWorkAmount(
+                               bsls::TimeInterval(0, microseconds * 1000));
+
+        for (int nested = 0; nested < 2; ++nested) {
+            printf("%s jobs:\n", nested ? "nested" : "flat");
+            {
+                bdlmt::ThreadPool pool(bslmt::ThreadAttributes(),
+                                       numThreads,
+                                       numThreads,
+                                       1000,
+                                       alloc);
+                pool.start();
+                printf("  ThreadPool:             %12.0f jobs/s\n",
+                       bench::measure(&pool,
+                                      nested,
+                                      numSubmitters,
+                                      numJobs,
+                                      amount));
+                pool.stop();
+            }
+            {
+                bdlmt::FixedThreadPool pool(numThreads,
+                                            numJobs * numSubmitters,
+                                            alloc);
+                pool.start();
+                printf("  FixedThreadPool:        %12.0f jobs/s\n",
+                       bench::measure(&pool,
+                                      nested,
+                                      numSubmitters,
+                                      numJobs,
+                                      amount));
+                pool.stop();
+            }
+            {
+                Obj pool(numThreads, alloc);
+                pool.start();
+                printf("  WorkStealingThreadPool: %12.0f jobs/s\n",
+                       bench::measure(&pool,
+                                      nested,
+                                      numSubmitters,
+                                      numJobs,
+                                      amount));
+                pool.stop();
+            }
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (test >= 0) {
+        // CONCERN: In no case does memory come from the global allocator.
+
+        ASSERTV(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not
+// use this file except in compliance with the License.  You may obtain a copy
+// of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
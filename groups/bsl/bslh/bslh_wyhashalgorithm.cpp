@@ -0,0 +1,82 @@
+// bslh_wyhashalgorithm.cpp                                           -*-C++-*-
+#include <bslh_wyhashalgorithm.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id$ $CSID$")
+
+#include <string.h>  // for 'memcpy', 'memmove'
+
+///Implementation Notes
+///--------------------
+// The canonical implementation of wyhash processes its input in a single
+// call, consuming blocks of 48 bytes while *more* than 48 bytes remain, then
+// blocks of 16 bytes while more than 16 bytes remain, and finally the last 16
+// bytes of the input, which may overlap the bytes already consumed.  To
+// produce the same hash from input supplied in pieces, 'update' consumes a
+// block of 48 bytes only once at least one byte following it has been
+// supplied, and retains the last 16 bytes of the last consumed block in front
+// of the unprocessed data, where they are found by 'computeHash' should the
+// final read overlap them.
+
+namespace BloombergLP {
+namespace bslh {
+
+                          // ---------------------
+                          // class WyHashAlgorithm
+                          // ---------------------
+
+// PRIVATE MANIPULATORS
+void WyHashAlgorithm::processBlock(const unsigned char *block)
+{
+    d_seed = mix(load64(block)      ^ k_SECRET1, load64(block +  8) ^ d_seed);
+    d_see1 = mix(load64(block + 16) ^ k_SECRET2, load64(block + 24) ^ d_see1);
+    d_see2 = mix(load64(block + 32) ^ k_SECRET3, load64(block + 40) ^ d_see2);
+}
+
+void WyHashAlgorithm::update(const unsigned char *data, size_t numBytes)
+{
+    BSLS_ASSERT(d_bufferLength + numBytes > k_BLOCK_SIZE);
+
+    unsigned char       *buffered = d_buffer + k_TAIL_SIZE;
+    const unsigned char *blockEnd = buffered + k_BLOCK_SIZE;
+
+    if (d_bufferLength) {
+        const size_t numFill = k_BLOCK_SIZE - d_bufferLength;
+
+        memcpy(buffered + d_bufferLength, data, numFill);
+        data     += numFill;
+        numBytes -= numFill;
+
+        processBlock(buffered);
+    }
+
+    while (numBytes > k_BLOCK_SIZE) {
+        processBlock(data);
+        data     += k_BLOCK_SIZE;
+        numBytes -= k_BLOCK_SIZE;
+        blockEnd  = data;
+    }
+
+    memmove(d_buffer, blockEnd - k_TAIL_SIZE, k_TAIL_SIZE);
+    memcpy(buffered, data, numBytes);
+    d_bufferLength = numBytes;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,509 @@
+// bslh_wyhashalgorithm.h                                             -*-C++-*-
+#ifndef INCLUDED_BSLH_WYHASHALGORITHM
+#define INCLUDED_BSLH_WYHASHALGORITHM
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an implementation of the wyhash algorithm.
+//
+//@CLASSES:
+//  bslh::WyHashAlgorithm: functor implementing the wyhash algorithm
+//
+//@SEE_ALSO: bslh_hash, bslh_seededhash, bslh_spookyhashalgorithm
+//
+//@DESCRIPTION: 'bslh::WyHashAlgorithm' implements the wyhash algorithm by Wang
+// Yi (final version 4).  wyhash is a general purpose, non-cryptographic
+// algorithm built on a single primitive, the "multiply-mix" of two 64-bit
+// words into their full 128-bit product, whose high and low halves are
+// combined with exclusive-or.  The algorithm is particularly fast for the
+// short keys (a few machine words) that dominate the use of hash tables, for
+// which it performs only two or three such multiplications, and it passes the
+// SMHasher quality test suite.  For more information, see:
+// https://github.com/wangyi-fudan/wyhash
+//
+// This class satisfies the requirements for regular 'bslh' hashing algorithms
+// and seeded 'bslh' hashing algorithms, defined in 'bslh_hash.h' and
+// 'bslh_seededhash.h' respectively.  More information can be found in the
+// package level documentation for 'bslh' (internal users can also find
+// information here {TEAM BDE:USING MODULAR HASHING<GO>})
+//
+///Security
+///--------
+// In this context "security" refers to the ability of the algorithm to produce
+// hashes that are not predictable by an attacker.  There are *no* security
+// guarantees made by 'bslh::WyHashAlgorithm', meaning attackers may be able to
+// engineer keys that will cause a Denial of Service (DoS) attack in hash
+// tables using this algorithm, even if they do not know the seed used to
+// initialize it.  If security is required, an algorithm that documents better
+// secure properties should be used, such as 'bslh::SipHashAlgorithm'.
+//
+///Speed
+///-----
+// This algorithm will compute a hash on the order of O(n) where 'n' is the
+// length of the input data.  Each 48 bytes of input are consumed by three
+// independent multiply-mix operations, and inputs of 16 bytes or less by a
+// total of three such operations.  On platforms providing a 128-bit integer
+// type (e.g., GCC and Clang on 64-bit platforms) each multiply-mix compiles to
+// a single widening multiplication instruction; elsewhere it is emulated
+// using four 32-bit multiplications.  Data supplied to 'operator()' is
+// buffered until it is known whether more data follows, so hashing a sequence
+// of small values (as 'hashAppend' does for the attributes of a type) costs
+// little more than hashing the same bytes in a single call.
+//
+///Hash Distribution
+///-----------------
+// Output hashes will be well distributed and will avalanche, which means
+// changing one bit of the input will change approximately 50% of the output
+// bits.  This will prevent similar values from funneling to the same hash or
+// bucket.
+//
+///Hash Consistency
+///----------------
+// This hash algorithm is endian-independent.  The input is read as a sequence
+// of little-endian words, and the seed is read as a little-endian 64-bit
+// integer, so the hashes produced for a given seed and given sequence of bytes
+// are the same on big-endian and little-endian platforms, and match those of
+// the canonical implementation.  Note that if the "given data" has internal
+// structure, such as being integral or floating-point, its bytes are likely
+// ordered in different ways depending on the platform, and thus will not hash
+// to the same value.
+//
+///Usage
+///-----
+// This section illustrates intended usage of this component.
+//
+///Example: Assigning Short Keys to Shards
+///- - - - - - - - - - - - - - - - - - - -
+// Suppose we maintain a cache of market data that is partitioned into shards,
+// each protected by its own lock, and that each entry is identified by the
+// exchange on which an instrument trades and the instrument's ticker symbol.
+// Both attributes are short, and the shard of an entry is computed every time
+// the entry is accessed, so we want an algorithm that is fast for short keys
+// and distributes similar keys (e.g., "IBM" and "IBN") over different shards.
+//
+// First, we define the key type:
+//..
+//  struct InstrumentKey {
+//      // This 'struct' identifies an instrument by the code of its exchange
+//      // and its ticker symbol.
+//
+//      // DATA
+//      int         d_exchange;  // exchange code
+//      const char *d_symbol;    // ticker symbol (held, not owned)
+//  };
+//..
+// Then, we define a function that computes the shard of a key by passing the
+// attributes of the key that are salient to hashing to the algorithm.  We
+// pass the length of the symbol as well as its characters, so that keys
+// differing only in where the symbol ends are hashed differently.  The
+// algorithm is seeded so that the assignments of keys to the shards of
+// different caches are independent:
+//..
+//  size_t shardOf(const InstrumentKey&  key,
+//                 size_t                numShards,
+//                 const char           *seed)
+//      // Return the index, in the range '[0 .. numShards)', of the shard
+//      // containing the entry having the specified 'key' in a cache seeded
+//      // with the 'bslh::WyHashAlgorithm::k_SEED_LENGTH' bytes at the
+//      // specified 'seed'.  The behavior is undefined unless '0 < numShards'.
+//  {
+//      const size_t length = strlen(key.d_symbol);
+//
+//      bslh::WyHashAlgorithm hash(seed);
+//
+//      hash(&key.d_exchange, sizeof key.d_exchange);
+//      hash(key.d_symbol,    length);
+//      hash(&length,         sizeof length);
+//
+//      return static_cast<size_t>(hash.computeHash() % numShards);
+//  }
+//..
+// Now, we assign a number of keys to shards:
+//..
+//  const char seed[bslh::WyHashAlgorithm::k_SEED_LENGTH] = {
+//                               '\x5a', '\x17', '\x00', '\xc3',
+//                               '\x9e', '\x42', '\x6b', '\x81' };
+//
+//  const InstrumentKey keys[] = { {  1, "IBM"   },
+//                                 {  1, "IBN"   },
+//                                 {  2, "IBM"   },
+//                                 {  1, "MSFT"  },
+//                                 {  7, "VOD"   },
+//                                 {  7, "VODL"  } };
+//  const size_t numKeys = sizeof keys / sizeof *keys;
+//
+//  size_t shards[numKeys];
+//  for (size_t i = 0; i < numKeys; ++i) {
+//      shards[i] = shardOf(keys[i], 64, seed);
+//      assert(shards[i] < 64);
+//  }
+//..
+// Finally, we verify that equal keys are always assigned to the same shard,
+// and that, for this seed, the similar keys above are assigned to different
+// shards:
+//..
+//  for (size_t i = 0; i < numKeys; ++i) {
+//      char symbol[8];
+//      strcpy(symbol, keys[i].d_symbol);
+//
+//      const InstrumentKey copy = { keys[i].d_exchange, symbol };
+//
+//      assert(shards[i] == shardOf(copy, 64, seed));
+//  }
+//  assert(shards[0] != shards[1]);
+//  assert(shards[0] != shards[2]);
+//  assert(shards[4] != shards[5]);
+//..
+
+#include <bslscm_version.h>
+
+#include <bslmf_isbitwisemoveable.h>
+
+#include <bsls_assert.h>
+#include <bsls_byteorder.h>
+#include <bsls_platform.h>
+#include <bsls_types.h>
+
+#include <stddef.h>  // for 'size_t'
+#include <string.h>  // for 'memcpy'
+
+#if defined(__SIZEOF_INT128__)
+#define BSLH_WYHASHALGORITHM_HAS_INT128 1
+    // The platform provides a 128-bit unsigned integer type, which is used to
+    // compute the full product of two 64-bit integers.
+#endif
+
+namespace BloombergLP {
+
+namespace bslh {
+
+                          // ===========================
+                          // class bslh::WyHashAlgorithm
+                          // ===========================
+
+class WyHashAlgorithm {
+    // This class wraps an implementation of the "wyhash" hash algorithm in an
+    // interface that is usable in the modular hashing system in 'bslh'.  The
+    // data passed to the function call operator is processed in blocks of 48
+    // bytes as soon as it is known that at least one more byte follows each
+    // block (the final, possibly complete, block being processed by
+    // 'computeHash'), so that the resulting hash is identical to that produced
+    // by the canonical, one-shot, implementation of the algorithm.
+
+  private:
+    // PRIVATE TYPES
+    typedef bsls::Types::Uint64 Uint64;
+        // Typedef for a 64-bit integer type used in the hashing algorithm.
+
+    enum {
+        k_BLOCK_SIZE = 48,  // number of bytes consumed by one block round
+
+        k_TAIL_SIZE  = 16   // number of bytes preceding the unprocessed data
+                            // that may be read when finalizing the hash
+    };
+
+    // CLASS DATA
+    static const Uint64 k_SECRET0 = 0xa0761d6478bd642fULL;
+    static const Uint64 k_SECRET1 = 0xe7037ed1a0b428dbULL;
+    static const Uint64 k_SECRET2 = 0x8ebc6af09c88c6e3ULL;
+    static const Uint64 k_SECRET3 = 0x589965cc75374cc3ULL;
+        // Default secret parameters of the algorithm.
+
+    // DATA
+    Uint64 d_seed;
+    Uint64 d_see1;
+    Uint64 d_see2;
+        // Stores the intermediate state of the algorithm (one 64-bit value
+        // for each of the three lanes of a block round).
+
+    Uint64 d_totalLength;
+        // The total length of all data that has been passed into the
+        // algorithm.
+
+    size_t d_bufferLength;
+        // The length of the unprocessed data currently stored in the buffer,
+        // following the first 'k_TAIL_SIZE' bytes of the buffer.
+
+    union {
+        Uint64        d_alignment;
+            // Provides alignment
+
+        unsigned char d_buffer[k_TAIL_SIZE + k_BLOCK_SIZE];
+            // Stores the last 'k_TAIL_SIZE' bytes of the last processed block
+            // (if any), followed by the unprocessed data.
+    };
+
+    // NOT IMPLEMENTED
+    WyHashAlgorithm(const WyHashAlgorithm& original); // = delete;
+        // Do not allow copy construction.
+
+    WyHashAlgorithm& operator=(const WyHashAlgorithm& rhs); // = delete;
+        // Do not allow assignment.
+
+    // PRIVATE CLASS METHODS
+    static Uint64 load32(const unsigned char *data);
+        // Return the value of the little-endian 32-bit unsigned integer at the
+        // specified 'data'.
+
+    static Uint64 load64(const unsigned char *data);
+        // Return the value of the little-endian 64-bit unsigned integer at the
+        // specified 'data'.
+
+    static Uint64 mix(Uint64 lhs, Uint64 rhs);
+        // Return the exclusive-or of the low and high 64-bit halves of the
+        // 128-bit product of the specified 'lhs' and 'rhs'.
+
+    static void multiply(Uint64 *lhs, Uint64 *rhs);
+        // Load, into the specified 'lhs' and 'rhs', respectively the low and
+        // the high 64-bit halves of the 128-bit product of their values.
+
+    // PRIVATE MANIPULATORS
+    void initialize(Uint64 seed);
+        // Set the state of this object to that of an algorithm seeded with
+        // the specified 'seed' and to which no data has been passed.
+
+    void processBlock(const unsigned char *block);
+        // Incorporate the 'k_BLOCK_SIZE' bytes at the specified 'block' into
+        // the internal state of the algorithm.
+
+    void update(const unsigned char *data, size_t numBytes);
+        // Incorporate the specified 'data', of the specified 'numBytes', into
+        // the internal state of the algorithm, processing all the complete
+        // blocks of the unprocessed data that are followed by at least one
+        // byte.  The behavior is undefined unless the length of the
+        // unprocessed data after incorporating 'data' exceeds 'k_BLOCK_SIZE'.
+
+  public:
+    // TYPES
+    typedef bsls::Types::Uint64 result_type;
+        // Typedef indicating the value type returned by this algorithm.
+
+    // CONSTANTS
+    enum { k_SEED_LENGTH = 8 }; // Seed length in bytes.
+
+    // CREATORS
+    WyHashAlgorithm();
+        // Create a 'bslh::WyHashAlgorithm' using a default initial seed (of
+        // 0).
+
+    explicit WyHashAlgorithm(const char *seed);
+        // Create a 'bslh::WyHashAlgorithm', seeded with a 64-bit
+        // ('k_SEED_LENGTH' bytes) seed pointed to by the specified 'seed',
+        // interpreted as a little-endian integer.  Each bit of the supplied
+        // seed will contribute to the final hash produced by 'computeHash()'.
+        // The behaviour is undefined unless 'seed' points to at least 8 bytes
+        // of initialized memory.
+
+    //! ~WyHashAlgorithm() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    void operator()(const void *data, size_t numBytes);
+        // Incorporate the specified 'data', of at least the specified
+        // 'numBytes', into the internal state of the hashing algorithm.  Every
+        // bit of data incorporated into the internal state of the algorithm
+        // will contribute to the final hash produced by 'computeHash()'.  The
+        // same hash value will be produced regardless of whether a sequence of
+        // bytes is passed in all at once or through multiple calls to this
+        // member function.  Input where 'numBytes' is 0 will have no effect on
+        // the internal state of the algorithm.  The behaviour is undefined
+        // unless 'data' points to a valid memory location with at least
+        // 'numBytes' bytes of initialized memory or 'numBytes' is zero.
+
+    result_type computeHash();
+        // Return the finalized version of the hash that has been accumulated.
+        // Note that a value will be returned, even if data has not been passed
+        // into 'operator()'.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+// PRIVATE CLASS METHODS
+inline
+WyHashAlgorithm::Uint64 WyHashAlgorithm::load32(const unsigned char *data)
+{
+    unsigned int value;
+    memcpy(&value, data, sizeof value);
+    return BSLS_BYTEORDER_LE_U32_TO_HOST(value);
+}
+
+inline
+WyHashAlgorithm::Uint64 WyHashAlgorithm::load64(const unsigned char *data)
+{
+    Uint64 value;
+    memcpy(&value, data, sizeof value);
+    return BSLS_BYTEORDER_LE_U64_TO_HOST(value);
+}
+
+inline
+WyHashAlgorithm::Uint64 WyHashAlgorithm::mix(Uint64 lhs, Uint64 rhs)
+{
+    multiply(&lhs, &rhs);
+    return lhs ^ rhs;
+}
+
+inline
+void WyHashAlgorithm::multiply(Uint64 *lhs, Uint64 *rhs)
+{
+#if defined(BSLH_WYHASHALGORITHM_HAS_INT128)
+    const unsigned __int128 product =
+                           static_cast<unsigned __int128>(*lhs) * *rhs;
+
+    *lhs = static_cast<Uint64>(product);
+    *rhs = static_cast<Uint64>(product >> 64);
+#else
+    const Uint64 lhsHi = *lhs >> 32;
+    const Uint64 lhsLo = *lhs & 0xffffffffULL;
+    const Uint64 rhsHi = *rhs >> 32;
+    const Uint64 rhsLo = *rhs & 0xffffffffULL;
+
+    const Uint64 hh = lhsHi * rhsHi;
+    const Uint64 hl = lhsHi * rhsLo;
+    const Uint64 lh = lhsLo * rhsHi;
+    const Uint64 ll = lhsLo * rhsLo;
+
+    const Uint64 lo    = ll + (hl << 32);
+    const Uint64 carry = lo < ll;
+    const Uint64 low   = lo + (lh << 32);
+
+    *lhs = low;
+    *rhs = hh + (hl >> 32) + (lh >> 32) + carry + (low < lo);
+#endif
+}
+
+// PRIVATE MANIPULATORS
+inline
+void WyHashAlgorithm::initialize(Uint64 seed)
+{
+    d_seed         = seed ^ mix(seed ^ k_SECRET0, k_SECRET1);
+    d_see1         = d_seed;
+    d_see2         = d_seed;
+    d_totalLength  = 0;
+    d_bufferLength = 0;
+}
+
+// CREATORS
+inline
+WyHashAlgorithm::WyHashAlgorithm()
+{
+    initialize(0);
+}
+
+inline
+WyHashAlgorithm::WyHashAlgorithm(const char *seed)
+{
+    BSLS_ASSERT(seed);
+
+    initialize(load64(reinterpret_cast<const unsigned char *>(seed)));
+}
+
+// MANIPULATORS
+inline
+void WyHashAlgorithm::operator()(const void *data, size_t numBytes)
+{
+    BSLS_ASSERT(0 != data || 0 == numBytes);
+
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+
+    d_totalLength += numBytes;
+
+    if (d_bufferLength + numBytes <= k_BLOCK_SIZE) {
+        if (numBytes) {
+            memcpy(d_buffer + k_TAIL_SIZE + d_bufferLength, bytes, numBytes);
+            d_bufferLength += numBytes;
+        }
+        return;                                                       // RETURN
+    }
+
+    update(bytes, numBytes);
+}
+
+inline
+WyHashAlgorithm::result_type WyHashAlgorithm::computeHash()
+{
+    const unsigned char *data = d_buffer + k_TAIL_SIZE;
+    Uint64               seed = d_seed;
+    Uint64               a;
+    Uint64               b;
+
+    if (d_totalLength <= 16) {
+        const size_t length = d_bufferLength;
+
+        if (length >= 4) {
+            const size_t offset = (length >> 3) << 2;
+
+            a = (load32(data) << 32) | load32(data + offset);
+            b = (load32(data + length - 4) << 32)
+              |  load32(data + length - 4 - offset);
+        }
+        else if (length > 0) {
+            a = static_cast<Uint64>(data[0]) << 16
+              | static_cast<Uint64>(data[length >> 1]) << 8
+              | data[length - 1];
+            b = 0;
+        }
+        else {
+            a = 0;
+            b = 0;
+        }
+    }
+    else {
+        size_t length = d_bufferLength;
+
+        if (d_totalLength > k_BLOCK_SIZE) {
+            seed ^= d_see1 ^ d_see2;
+        }
+        while (length > 16) {
+            seed = mix(load64(data) ^ k_SECRET1, load64(data + 8) ^ seed);
+            data   += 16;
+            length -= 16;
+        }
+
+        // Note that the last 16 bytes of input may begin before 'data', in
+        // the retained tail of the last processed block.
+
+        a = load64(data + length - 16);
+        b = load64(data + length - 8);
+    }
+
+    a ^= k_SECRET1;
+    b ^= seed;
+    multiply(&a, &b);
+
+    return mix(a ^ k_SECRET0 ^ d_totalLength, b ^ k_SECRET1);
+}
+
+}  // close package namespace
+
+// ============================================================================
+//                                TYPE TRAITS
+// ============================================================================
+
+namespace bslmf {
+template <>
+struct IsBitwiseMoveable<bslh::WyHashAlgorithm>
+    : bsl::true_type {};
+}  // close namespace bslmf
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1320 @@
+// bslh_wyhashalgorithm.t.cpp                                         -*-C++-*-
+#include <bslh_wyhashalgorithm.h>
+
+#include <bslh_siphashalgorithm.h>     // for testing only
+#include <bslh_spookyhashalgorithm.h>  // for testing only
+
+#include <bslmf_isbitwisemoveable.h>
+#include <bslmf_issame.h>
+
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_bsltestutil.h>
+#include <bsls_stopwatch.h>            // for testing only
+#include <bsls_types.h>
+
+#include <algorithm>                   // for testing only
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace BloombergLP;
+using namespace bslh;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a 'bslh' hashing algorithm.  The basic test plan
+// is to compare the output of the function call operator with the expected
+// output of the canonical implementation of the algorithm, both as published
+// test vectors and as computed by a one-shot reference implementation included
+// in this test driver.  The component will also be tested for conformance to
+// the requirements on 'bslh' hashing algorithms, outlined in the 'bslh'
+// package level documentation, and the quality of the hashes it produces will
+// be checked by a subset of the SMHasher tests.
+//-----------------------------------------------------------------------------
+// TYPEDEF
+// [ 4] typedef bsls::Types::Uint64 result_type;
+//
+// CONSTANTS
+// [ 5] enum { k_SEED_LENGTH = 8 };
+//
+// CREATORS
+// [ 2] WyHashAlgorithm();
+// [ 2] explicit WyHashAlgorithm(const char *seed);
+// [ 2] ~WyHashAlgorithm();
+//
+// MANIPULATORS
+// [ 3] void operator()(void const* key, size_t len);
+// [ 3] result_type computeHash();
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] Trait IsBitwiseMoveable
+// [ 7] HASH QUALITY
+// [ 8] USAGE EXAMPLE
+// [-1] PERFORMANCE COMPARISON WITH OTHER ALGORITHMS
+//-----------------------------------------------------------------------------
+
+// ============================================================================
+//                     STANDARD BSL ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", line, message);
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BSL TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P            BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_           BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+//=============================================================================
+//                   GLOBAL TYPEDEFS AND DATA FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef WyHashAlgorithm     Obj;
+typedef bsls::Types::Uint64 Uint64;
+
+const char genericSeed[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+//=============================================================================
+//                       REFERENCE IMPLEMENTATION
+//-----------------------------------------------------------------------------
+
+namespace {
+namespace u {
+
+void referenceMultiply(Uint64 *lhs, Uint64 *rhs)
+    // Load, into the specified 'lhs' and 'rhs', respectively the low and the
+    // high 64-bit halves of the 128-bit product of their values, computed
+    // one bit at a time.
+{
+    Uint64 lo = 0;
+    Uint64 hi = 0;
+
+    for (int i = 63; i >= 0; --i) {
+        hi = hi << 1 | lo >> 63;
+        lo = lo << 1;
+        if (*rhs >> i & 1) {
+            const Uint64 sum = lo + *lhs;
+
+            hi += sum < lo;
+            lo  = sum;
+        }
+    }
+    *lhs = lo;
+    *rhs = hi;
+}
+
+Uint64 referenceMix(Uint64 lhs, Uint64 rhs)
+    // Return the exclusive-or of the two halves of the product of the
+    // specified 'lhs' and 'rhs'.
+{
+    referenceMultiply(&lhs, &rhs);
+    return lhs ^ rhs;
+}
+
+Uint64 referenceRead(const unsigned char *data, int numBytes)
+    // Return the value of the little-endian integer of the specified
+    // 'numBytes' at the specified 'data'.
+{
+    Uint64 result = 0;
+    for (int i = numBytes - 1; i >= 0; --i) {
+        result = result << 8 | data[i];
+    }
+    return result;
+}
+
+Uint64 referenceWyHash(const void *key, size_t length, Uint64 seed)
+    // Return the hash of the specified 'key' of the specified 'length'
+    // computed, using the specified 'seed', in one shot by a transcription of
+    // the canonical wyhash (final version 4) implementation.
+{
+    static const Uint64 secret[4] = { 0xa0761d6478bd642fULL,
+                                      0xe7037ed1a0b428dbULL,
+                                      0x8ebc6af09c88c6e3ULL,
+                                      0x589965cc75374cc3ULL };
+
+    const unsigned char *p = static_cast<const unsigned char *>(key);
+
+    seed ^= referenceMix(seed ^ secret[0], secret[1]);
+
+    Uint64 a;
+    Uint64 b;
+
+    if (length <= 16) {
+        if (length >= 4) {
+            const size_t offset = (length >> 3) << 2;
+
+            a = referenceRead(p, 4) << 32 | referenceRead(p + offset, 4);
+            b = referenceRead(p + length - 4, 4) << 32
+              | referenceRead(p + length - 4 - offset, 4);
+        }
+        else if (length > 0) {
+            a = static_cast<Uint64>(p[0]) << 16
+              | static_cast<Uint64>(p[length >> 1]) << 8
+              | p[length - 1];
+            b = 0;
+        }
+        else {
+            a = b = 0;
+        }
+    }
+    else {
+        size_t i = length;
+        if (i > 48) {
+            Uint64 see1 = seed;
+            Uint64 see2 = seed;
+            do {
+                seed = referenceMix(referenceRead(p,      8) ^ secret[1],
+                                    referenceRead(p +  8, 8) ^ seed);
+                see1 = referenceMix(referenceRead(p + 16, 8) ^ secret[2],
+                                    referenceRead(p + 24, 8) ^ see1);
+                see2 = referenceMix(referenceRead(p + 32, 8) ^ secret[3],
+                                    referenceRead(p + 40, 8) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = referenceMix(referenceRead(p,     8) ^ secret[1],
+                                referenceRead(p + 8, 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = referenceRead(p + i - 16, 8);
+        b = referenceRead(p + i - 8,  8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    referenceMultiply(&a, &b);
+
+    return referenceMix(a ^ secret[0] ^ length, b ^ secret[1]);
+}
+
+void seedFromInteger(char *seed, Uint64 value)
+    // Load, into the 'Obj::k_SEED_LENGTH' bytes at the specified 'seed', the
+    // little-endian representation of the specified 'value'.
+{
+    for (int i = 0; i < Obj::k_SEED_LENGTH; ++i) {
+        seed[i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+class Random {
+    // This class provides a deterministic generator of pseudo-random 64-bit
+    // values (a "xorshift64*" generator).
+
+    // DATA
+    Uint64 d_state;
+
+  public:
+    // CREATORS
+    explicit Random(Uint64 seed)
+        // Create a generator seeded with the specified non-zero 'seed'.
+    : d_state(seed)
+    {
+    }
+
+    // MANIPULATORS
+    Uint64 operator()()
+        // Return the next pseudo-random value.
+    {
+        d_state ^= d_state >> 12;
+        d_state ^= d_state << 25;
+        d_state ^= d_state >> 27;
+        return d_state * 0x2545f4914f6cdd1dULL;
+    }
+
+    void fill(unsigned char *buffer, size_t numBytes)
+        // Load pseudo-random values into the specified 'numBytes' of the
+        // specified 'buffer'.
+    {
+        for (size_t i = 0; i < numBytes; ++i) {
+            buffer[i] = static_cast<unsigned char>((*this)() >> 56);
+        }
+    }
+};
+
+template <class ALGORITHM>
+Uint64 hashBytes(const void *data, size_t numBytes)
+    // Return the hash of the specified 'data' of the specified 'numBytes'
+    // computed by a default constructed object of the (template parameter)
+    // 'ALGORITHM' type.
+{
+    ALGORITHM hash;
+    hash(data, numBytes);
+    return hash.computeHash();
+}
+
+template <>
+Uint64 hashBytes<SipHashAlgorithm>(const void *data, size_t numBytes)
+    // Return the hash of the specified 'data' of the specified 'numBytes'
+    // computed by a 'SipHashAlgorithm' object using a fixed seed.
+{
+    static const char seed[SipHashAlgorithm::k_SEED_LENGTH] = { 0 };
+
+    SipHashAlgorithm hash(seed);
+    hash(data, numBytes);
+    return hash.computeHash();
+}
+
+Uint64 hashKey(const unsigned char *key, size_t length)
+    // Return the hash of the specified 'key' of the specified 'length' using
+    // a default constructed 'Obj'.
+{
+    return hashBytes<Obj>(key, length);
+}
+
+size_t countDuplicates(Uint64 *values, size_t numValues, Uint64 mask)
+    // Return the number of elements of the specified 'values' array of the
+    // specified 'numValues' whose bits selected by the specified 'mask' are
+    // equal to those of a preceding element, after sorting the selected bits
+    // of the elements in place.
+{
+    for (size_t i = 0; i < numValues; ++i) {
+        values[i] &= mask;
+    }
+    std::sort(values, values + numValues);
+
+    size_t result = 0;
+    for (size_t i = 1; i < numValues; ++i) {
+        result += values[i] == values[i - 1];
+    }
+    return result;
+}
+
+template <class ALGORITHM>
+void benchmark(const char *name, size_t numBytes, int numIterations)
+    // Print the average time taken by the (template parameter) 'ALGORITHM' to
+    // hash a key of the specified 'numBytes', measured over the specified
+    // 'numIterations', preceded by the specified 'name'.
+{
+    unsigned char key[1024];
+    Random(numBytes + 1).fill(key, sizeof key);
+
+    Uint64          sink = 0;
+    bsls::Stopwatch timer;
+    timer.start();
+    for (int i = 0; i < numIterations; ++i) {
+        key[0] = static_cast<unsigned char>(i);
+        sink  ^= hashBytes<ALGORITHM>(key, numBytes);
+    }
+    timer.stop();
+
+    printf("%-8s %5u bytes: %8.2f ns/hash (%llx)\n",
+           name,
+           static_cast<unsigned>(numBytes),
+           timer.elapsedTime() * 1e9 / numIterations,
+           static_cast<unsigned long long>(sink & 0xf));
+}
+
+}  // close namespace u
+}  // close unnamed namespace
+
+//=============================================================================
+//                             USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+///Usage
+///-----
+// This section illustrates intended usage of this component.
+//
+///Example: Assigning Short Keys to Shards
+///- - - - - - - - - - - - - - - - - - - -
+// Suppose we maintain a cache of market data that is partitioned into shards,
+// each protected by its own lock, and that each entry is identified by the
+// exchange on which an instrument trades and the instrument's ticker symbol.
+// Both attributes are short, and the shard of an entry is computed every time
+// the entry is accessed, so we want an algorithm that is fast for short keys
+// and distributes similar keys (e.g., "IBM" and "IBN") over different shards.
+//
+// First, we define the key type:
+//..
+    struct InstrumentKey {
+        // This 'struct' identifies an instrument by the code of its exchange
+        // and its ticker symbol.
+
+        // DATA
+        int         d_exchange;  // exchange code
+        const char *d_symbol;    // ticker symbol (held, not owned)
+    };
+//..
+// Then, we define a function that computes the shard of a key by passing the
+// attributes of the key that are salient to hashing to the algorithm.  We
+// pass the length of the symbol as well as its characters, so that keys
+// differing only in where the symbol ends are hashed differently.  The
+// algorithm is seeded so that the assignments of keys to the shards of
+// different caches are independent:
+//..
+    size_t shardOf(const InstrumentKey&  key,
+                   size_t                numShards,
+                   const char           *seed)
+        // Return the index, in the range '[0 .. numShards)', of the shard
+        // containing the entry having the specified 'key' in a cache seeded
+        // with the 'bslh::WyHashAlgorithm::k_SEED_LENGTH' bytes at the
+        // specified 'seed'.  The behavior is undefined unless '0 < numShards'.
+    {
+        const size_t length = strlen(key.d_symbol);
+
+        bslh::WyHashAlgorithm hash(seed);
+
+        hash(&key.d_exchange, sizeof key.d_exchange);
+        hash(key.d_symbol,    length);
+        hash(&length,         sizeof length);
+
+        return static_cast<size_t>(hash.computeHash() % numShards);
+    }
+//..
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+    bool veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVeryVerbose;      // suppress warning
+    (void)veryVeryVeryVerbose;  // suppress warning
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   The hashing algorithm can be used to compute the hash of the
+        //   attributes of a type that are salient to hashing.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("USAGE EXAMPLE\n"
+                            "=============\n");
+// Now, we assign a number of keys to shards:
+//..
+        const char seed[bslh::WyHashAlgorithm::k_SEED_LENGTH] = {
+                                     '\x5a', '\x17', '\x00', '\xc3',
+                                     '\x9e', '\x42', '\x6b', '\x81' };
+
+        const InstrumentKey keys[] = { {  1, "IBM"   },
+                                       {  1, "IBN"   },
+                                       {  2, "IBM"   },
+                                       {  1, "MSFT"  },
+                                       {  7, "VOD"   },
+                                       {  7, "VODL"  } };
+        const size_t numKeys = sizeof keys / sizeof *keys;
+
+        size_t shards[numKeys];
+        for (size_t i = 0; i < numKeys; ++i) {
+            shards[i] = shardOf(keys[i], 64, seed);
+            ASSERT(shards[i] < 64);
+        }
+//..
+// Finally, we verify that equal keys are always assigned to the same shard,
+// and that, for this seed, the similar keys above are assigned to different
+// shards:
+//..
+        for (size_t i = 0; i < numKeys; ++i) {
+            char symbol[8];
+            strcpy(symbol, keys[i].d_symbol);
+
+            const InstrumentKey copy = { keys[i].d_exchange, symbol };
+
+            ASSERT(shards[i] == shardOf(copy, 64, seed));
+        }
+        ASSERT(shards[0] != shards[1]);
+        ASSERT(shards[0] != shards[2]);
+        ASSERT(shards[4] != shards[5]);
+//..
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // HASH QUALITY
+        //   The hashes produced by the algorithm should be suitable for use in
+        //   hash tables, as verified by a subset of the tests of the SMHasher
+        //   suite, scaled down to run quickly.
+        //
+        // Concerns:
+        //: 1 Flipping any bit of the input flips each bit of the hash with a
+        //:   probability close to 50% (avalanche), for short and long keys.
+        //:
+        //: 2 Flipping any bit of the seed flips each bit of the hash with a
+        //:   probability close to 50%.
+        //:
+        //: 3 Keys having very few bits set (SMHasher "Sparse") do not
+        //:   collide, neither on the full 64-bit hash nor, beyond the number
+        //:   of collisions expected of a random function, on its low or high
+        //:   32 bits.
+        //:
+        //: 4 Sequences of zero bytes of different lengths have different
+        //:   hashes.
+        //:
+        //: 5 The hashes of consecutive integers are uniformly distributed over
+        //:   the buckets selected by both their low and their high bits.
+        //
+        // Plan:
+        //: 1 For keys of various lengths, and for a number of random keys of
+        //:   each length, flip each bit of the key and accumulate, for each
+        //:   pair of input and output bits, the number of times the output
+        //:   bit changed.  Verify that the largest deviation of the resulting
+        //:   frequencies from 50% is within the expected statistical bounds.
+        //:   (C-1)
+        //:
+        //: 2 Repeat P-1, flipping the bits of the seed instead.  (C-2)
+        //:
+        //: 3 Hash every 32-byte key with at most 3 bits set and every 8-byte
+        //:   key with at most 4 bits set, and count the duplicate hashes and
+        //:   the duplicate low and high halves of hashes.  (C-3)
+        //:
+        //: 4 Hash the sequences of zero bytes of lengths 0 to 512 and verify
+        //:   that all hashes are different.  (C-4)
+        //:
+        //: 5 Hash the integers from 0 to 2^20 and verify that the largest
+        //:   bucket, among 2^12 buckets selected by the low or high bits of
+        //:   the hash, is within the expected statistical bounds.  (C-5)
+        //
+        // Testing:
+        //   HASH QUALITY
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nHASH QUALITY"
+                            "\n============\n");
+
+        if (verbose) printf("Testing avalanche of the key bits.\n");
+        {
+            // Note that keys of a single byte are omitted, as there are too
+            // few of them for the samples to be independent.
+
+            const size_t LENGTHS[] = { 2, 3, 4, 8, 12, 16, 17, 32, 48, 49,
+                                       64, 100 };
+            const int    NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+            const int    NUM_KEYS    = 4000;
+
+            // With 4000 samples per pair of bits, the standard deviation of
+            // the frequency of a change is about 0.8%, and the largest
+            // deviation over the (at most) 51200 pairs of bits is expected to
+            // be about 3.5%.
+
+            const double MAX_BIAS = 0.05;
+
+            u::Random       random(1);
+            static unsigned counts[100 * 8][64];
+
+            for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+                const size_t LENGTH = LENGTHS[ti];
+
+                memset(counts, 0, sizeof counts);
+
+                unsigned char key[100];
+                for (int k = 0; k < NUM_KEYS; ++k) {
+                    random.fill(key, LENGTH);
+
+                    const Uint64 HASH = u::hashKey(key, LENGTH);
+                    for (size_t bit = 0; bit < LENGTH * 8; ++bit) {
+                        key[bit / 8] ^= static_cast<unsigned char>(
+                                                               1 << bit % 8);
+                        Uint64 diff = HASH ^ u::hashKey(key, LENGTH);
+                        key[bit / 8] ^= static_cast<unsigned char>(
+                                                               1 << bit % 8);
+
+                        for (int out = 0; diff; ++out, diff >>= 1) {
+                            counts[bit][out] += diff & 1;
+                        }
+                    }
+                }
+
+                double worst = 0;
+                for (size_t bit = 0; bit < LENGTH * 8; ++bit) {
+                    for (int out = 0; out < 64; ++out) {
+                        double bias = counts[bit][out] * 1.0 / NUM_KEYS - 0.5;
+                        if (bias < 0) {
+                            bias = -bias;
+                        }
+                        worst = std::max(worst, bias);
+                    }
+                }
+                if (veryVerbose) {
+                    P_(LENGTH) P(worst)
+                }
+                ASSERTV(LENGTH, worst, worst < MAX_BIAS);
+            }
+        }
+
+        if (verbose) printf("Testing avalanche of the seed bits.\n");
+        {
+            const size_t LENGTHS[]   = { 0, 4, 16, 64 };
+            const int    NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+            const int    NUM_KEYS    = 4000;
+            const double MAX_BIAS    = 0.05;
+
+            u::Random random(2);
+
+            for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+                const size_t LENGTH = LENGTHS[ti];
+
+                unsigned counts[64][64] = { { 0 } };
+
+                unsigned char key[64];
+                for (int k = 0; k < NUM_KEYS; ++k) {
+                    random.fill(key, LENGTH);
+                    const Uint64 SEED = random();
+
+                    char seed[Obj::k_SEED_LENGTH];
+                    u::seedFromInteger(seed, SEED);
+
+                    Obj hash(seed);
+                    hash(key, LENGTH);
+                    const Uint64 HASH = hash.computeHash();
+
+                    for (int bit = 0; bit < 64; ++bit) {
+                        u::seedFromInteger(seed, SEED ^ 1ULL << bit);
+
+                        Obj flipped(seed);
+                        flipped(key, LENGTH);
+
+                        Uint64 diff = HASH ^ flipped.computeHash();
+                        for (int out = 0; diff; ++out, diff >>= 1) {
+                            counts[bit][out] += diff & 1;
+                        }
+                    }
+                }
+
+                double worst = 0;
+                for (int bit = 0; bit < 64; ++bit) {
+                    for (int out = 0; out < 64; ++out) {
+                        double bias = counts[bit][out] * 1.0 / NUM_KEYS - 0.5;
+                        if (bias < 0) {
+                            bias = -bias;
+                        }
+                        worst = std::max(worst, bias);
+                    }
+                }
+                if (veryVerbose) {
+                    P_(LENGTH) P(worst)
+                }
+                ASSERTV(LENGTH, worst, worst < MAX_BIAS);
+            }
+        }
+
+        if (verbose) printf("Testing collisions of sparse keys.\n");
+        {
+            static const struct {
+                int d_line;
+                int d_length;   // length of the keys, in bytes
+                int d_maxBits;  // maximum number of bits set in a key
+            } DATA[] = {
+                //LINE  LENGTH  MAX BITS
+                //----  ------  --------
+                { L_,       32,        3 },
+                { L_,        8,        4 },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int LINE     = DATA[ti].d_line;
+                const int LENGTH   = DATA[ti].d_length;
+                const int MAX_BITS = DATA[ti].d_maxBits;
+                const int NUM_BITS = LENGTH * 8;
+
+                // Count the keys having at most 'MAX_BITS' bits set.
+
+                size_t numKeys = 0;
+                {
+                    size_t combinations = 1;
+                    for (int k = 0; k <= MAX_BITS; ++k) {
+                        numKeys      += combinations;
+                        combinations  = combinations * (NUM_BITS - k)
+                                                                     / (k + 1);
+                    }
+                }
+
+                Uint64 *hashes = new Uint64[numKeys];
+                Uint64 *copy   = new Uint64[numKeys];
+                size_t  count  = 0;
+
+                unsigned char key[32] = { 0 };
+                hashes[count++] = u::hashKey(key, LENGTH);
+
+                int bits[4];
+                for (int numSet = 1; numSet <= MAX_BITS; ++numSet) {
+                    // Enumerate the combinations of 'numSet' bit positions in
+                    // lexicographic order.
+
+                    for (int k = 0; k < numSet; ++k) {
+                        bits[k] = k;
+                    }
+                    while (true) {
+                        for (int k = 0; k < numSet; ++k) {
+                            key[bits[k] / 8] ^= static_cast<unsigned char>(
+                                                           1 << bits[k] % 8);
+                        }
+                        hashes[count++] = u::hashKey(key, LENGTH);
+                        for (int k = 0; k < numSet; ++k) {
+                            key[bits[k] / 8] ^= static_cast<unsigned char>(
+                                                           1 << bits[k] % 8);
+                        }
+
+                        int k = numSet - 1;
+                        while (k >= 0 && bits[k] == NUM_BITS - numSet + k) {
+                            --k;
+                        }
+                        if (k < 0) {
+                            break;
+                        }
+                        ++bits[k];
+                        for (int j = k + 1; j < numSet; ++j) {
+                            bits[j] = bits[j - 1] + 1;
+                        }
+                    }
+                }
+                ASSERTV(LINE, count, numKeys, count == numKeys);
+
+                // The expected number of collisions of 'n' random 32-bit
+                // values is about 'n * n / 2^33'.
+
+                const double EXPECTED = static_cast<double>(numKeys)
+                                      * static_cast<double>(numKeys)
+                                      / 8589934592.0;
+                const double LIMIT    = 2 * EXPECTED + 10;
+
+                std::copy(hashes, hashes + numKeys, copy);
+                const size_t FULL = u::countDuplicates(copy,
+                                                       numKeys,
+                                                       ~0ULL);
+
+                std::copy(hashes, hashes + numKeys, copy);
+                const size_t LOW  = u::countDuplicates(copy,
+                                                       numKeys,
+                                                       0xffffffffULL);
+
+                for (size_t i = 0; i < numKeys; ++i) {
+                    copy[i] = hashes[i] >> 32;
+                }
+                const size_t HIGH = u::countDuplicates(copy,
+                                                       numKeys,
+                                                       0xffffffffULL);
+
+                if (veryVerbose) {
+                    P_(LINE) P_(numKeys) P_(EXPECTED) P_(FULL) P_(LOW) P(HIGH)
+                }
+                ASSERTV(LINE, FULL, 0 == FULL);
+                ASSERTV(LINE, LOW,  EXPECTED, LOW  < LIMIT);
+                ASSERTV(LINE, HIGH, EXPECTED, HIGH < LIMIT);
+
+                delete [] copy;
+                delete [] hashes;
+            }
+        }
+
+        if (verbose) printf("Testing zero-filled keys of different lengths."
+                            "\n");
+        {
+            enum { k_MAX_LENGTH = 512 };
+
+            static unsigned char zeros[k_MAX_LENGTH];
+            Uint64               hashes[k_MAX_LENGTH + 1];
+
+            for (int length = 0; length <= k_MAX_LENGTH; ++length) {
+                hashes[length] = u::hashKey(zeros, length);
+            }
+            ASSERT(0 == u::countDuplicates(hashes,
+                                           k_MAX_LENGTH + 1,
+                                           ~0ULL));
+        }
+
+        if (verbose) printf("Testing distribution of consecutive integers.\n");
+        {
+            enum {
+                k_NUM_VALUES  = 1 << 20,
+                k_NUM_BUCKETS = 1 << 12
+            };
+
+            // With 256 values per bucket on average (a standard deviation of
+            // 16), the largest of the 4096 buckets is expected to hold about
+            // 256 + 4 * 16 values; we allow a margin of 6 standard deviations.
+
+            const unsigned LIMIT = 256 + 6 * 16;
+
+            static unsigned low[k_NUM_BUCKETS];
+            static unsigned high[k_NUM_BUCKETS];
+
+            for (unsigned i = 0; i < k_NUM_VALUES; ++i) {
+                const Uint64 HASH = u::hashKey(
+                                   reinterpret_cast<const unsigned char *>(&i),
+                                   sizeof i);
+
+                ++low[HASH & (k_NUM_BUCKETS - 1)];
+                ++high[HASH >> (64 - 12)];
+            }
+
+            const unsigned LOW  = *std::max_element(low,
+                                                    low + k_NUM_BUCKETS);
+            const unsigned HIGH = *std::max_element(high,
+                                                    high + k_NUM_BUCKETS);
+            if (veryVerbose) {
+                P_(LOW) P(HIGH)
+            }
+            ASSERTV(LOW,  LOW  < LIMIT);
+            ASSERTV(HIGH, HIGH < LIMIT);
+        }
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // TESTING BDE TYPE TRAITS
+        //   The class is bitwise movable and should have a trait that
+        //   indicates that.
+        //
+        // Concerns:
+        //: 1 The class is marked as 'IsBitwiseMoveable'.
+        //
+        // Plan:
+        //: 1 ASSERT the presence of the trait using the
+        //:   'bslmf::IsBitwiseMoveable' metafunction. (C-1)
+        //
+        // Testing:
+        //   Trait IsBitwiseMoveable
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING BDE TYPE TRAITS"
+                            "\n=======================\n");
+
+        if (verbose) printf("ASSERT the presence of the trait using the"
+                            " 'bslmf::IsBitwiseMoveable' metafunction."
+                            " (C-1)\n");
+        {
+            ASSERT(bslmf::IsBitwiseMoveable<WyHashAlgorithm>::value);
+        }
+
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING 'k_SEED_LENGTH'
+        //   The class is a seeded algorithm and should expose a
+        //   'k_SEED_LENGTH' enum.
+        //
+        // Concerns:
+        //: 1 'k_SEED_LENGTH' is publicly accessible.
+        //:
+        //: 2 'k_SEED_LENGTH' is set to 8.
+        //
+        // Plan:
+        //: 1 Access 'k_SEED_LENGTH' and ASSERT it is equal to the expected
+        //:   value. (C-1,2)
+        //
+        // Testing:
+        //   enum { k_SEED_LENGTH = 8 };
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING 'k_SEED_LENGTH'"
+                            "\n=======================\n");
+
+        if (verbose) printf("Access 'k_SEED_LENGTH' and ASSERT it is equal to"
+                            " the expected value. (C-1,2)\n");
+        {
+            ASSERT(8 == WyHashAlgorithm::k_SEED_LENGTH);
+        }
+
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING 'result_type' TYPEDEF
+        //   Verify that the class offers the result_type typedef that needs to
+        //   be exposed by all 'bslh' hashing algorithms
+        //
+        // Concerns:
+        //: 1 The typedef 'result_type' is publicly accessible and an alias for
+        //:   'bsls::Types::Uint64'.
+        //:
+        //: 2 'computeHash()' returns 'result_type'
+        //
+        // Plan:
+        //: 1 ASSERT the typedef is accessible and is the correct type using
+        //:   'bslmf::IsSame'. (C-1)
+        //:
+        //: 2 Declare the expected signature of 'computeHash()' and then assign
+        //:   to it.  If it compiles, the test passes. (C-2)
+        //
+        // Testing:
+        //   typedef bsls::Types::Uint64 result_type;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING 'result_type' TYPEDEF"
+                            "\n=============================\n");
+
+        if (verbose) printf("ASSERT the typedef is accessible and is the"
+                            " correct type using 'bslmf::IsSame'. (C-1)\n");
+        {
+            ASSERT((bslmf::IsSame<bsls::Types::Uint64,
+                                        WyHashAlgorithm::result_type>::VALUE));
+        }
+
+        if (verbose) printf("Declare the expected signature of 'computeHash()'"
+                            " and then assign to it.  If it compiles, the test"
+                            " passes. (C-2)\n");
+        {
+            Obj::result_type (Obj::*expectedSignature) ();
+
+            (void)(expectedSignature = &Obj::computeHash);
+        }
+
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'operator()' AND 'computeHash()'
+        //   Verify the class provides an overload for the function call
+        //   operator that can be called with some bytes and a length.  Verify
+        //   that calling 'operator()' will permute the algorithm's internal
+        //   state as specified by wyhash.  Verify that 'computeHash()' returns
+        //   the final value by wyhash specifications.
+        //
+        // Concerns:
+        //: 1 The function call operator is callable.
+        //:
+        //: 2 'computeHash()' returns the values of the published test vectors
+        //:   of the canonical implementation of wyhash.
+        //:
+        //: 3 'computeHash()' returns the value computed by a one-shot
+        //:   implementation of the canonical algorithm, for every length of
+        //:   input, in particular around the boundaries between the short
+        //:   input, 16-byte round, and 48-byte round code paths.
+        //:
+        //: 4 Given the same bytes, the function call operator will permute the
+        //:   internal state of the algorithm in the same way, regardless of
+        //:   whether the bytes are passed in all at once or in pieces, of any
+        //:   sizes.
+        //:
+        //: 5 Byte sequences passed in to 'operator()' with a length of 0 will
+        //:   not contribute to the final hash.
+        //:
+        //: 6 'operator()' does a BSLS_ASSERT for null pointers and non-zero
+        //:   length, and not for null pointers and zero length.
+        //
+        // Plan:
+        //: 1 Hash the messages of the published test vectors with the
+        //:   corresponding seeds, and verify the results.  (C-1,2)
+        //:
+        //: 2 For each length from 0 to 300 bytes, hash a pseudo-random
+        //:   message all at once and compare the result with that of the
+        //:   reference implementation in this test driver.  (C-3)
+        //:
+        //: 3 Hash the same messages one byte at a time, and in pieces of
+        //:   pseudo-random sizes interleaved with pieces of length 0, and
+        //:   verify that the results are the same as in P-2.  (C-4,5)
+        //:
+        //: 4 Call 'operator()' with a null pointer. (C-6)
+        //
+        // Testing:
+        //   void operator()(void const* key, size_t len);
+        //   result_type computeHash();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING 'operator()' AND 'computeHash()'"
+                            "\n========================================\n");
+
+        if (verbose) printf("Hash the messages of the published test vectors"
+                            " with the corresponding seeds. (C-1,2)\n");
+        {
+            static const struct {
+                int                  d_line;
+                const char          *d_message;
+                Uint64               d_seed;
+                Uint64               d_expectedHash;
+            } DATA[] = {
+                // LINE MESSAGE / SEED / HASH
+                { L_, "",
+                  0, 0x0409638ee2bde459ULL },
+                { L_, "a",
+                  1, 0xa8412d091b5fe0a9ULL },
+                { L_, "abc",
+                  2, 0x32dd92e4b2915153ULL },
+                { L_, "message digest",
+                  3, 0x8619124089a3a16bULL },
+                { L_, "abcdefghijklmnopqrstuvwxyz",
+                  4, 0x7a43afb61d7f5f40ULL },
+                { L_, "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+                      "0123456789",
+                  5, 0xff42329b90e50d58ULL },
+                { L_, "1234567890123456789012345678901234567890"
+                      "1234567890123456789012345678901234567890",
+                  6, 0xc39cab13b115aad3ULL },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int     LINE    = DATA[ti].d_line;
+                const char   *MESSAGE = DATA[ti].d_message;
+                const Uint64  EXP     = DATA[ti].d_expectedHash;
+
+                char seed[Obj::k_SEED_LENGTH];
+                u::seedFromInteger(seed, DATA[ti].d_seed);
+
+                Obj mX(seed);
+                mX(MESSAGE, strlen(MESSAGE));
+                const Uint64 hash = mX.computeHash();
+
+                if (veryVerbose) {
+                    P_(LINE) P_(MESSAGE) P(hash)
+                }
+                ASSERTV(LINE, hash, EXP, EXP == hash);
+                ASSERTV(LINE, EXP == u::referenceWyHash(MESSAGE,
+                                                        strlen(MESSAGE),
+                                                        DATA[ti].d_seed));
+            }
+
+            Obj mX;
+            ASSERT(0x0409638ee2bde459ULL == mX.computeHash());
+        }
+
+        enum { k_MAX_LENGTH = 300 };
+
+        unsigned char message[k_MAX_LENGTH];
+        u::Random(12345).fill(message, k_MAX_LENGTH);
+
+        const Uint64 SEED = 0x0123456789abcdefULL;
+        char         seed[Obj::k_SEED_LENGTH];
+        u::seedFromInteger(seed, SEED);
+
+        if (verbose) printf("Compare with the reference implementation for"
+                            " each length of input. (C-3)\n");
+        {
+            for (int length = 0; length <= k_MAX_LENGTH; ++length) {
+                Obj mX(seed);
+                mX(message, length);
+
+                const Uint64 EXP = u::referenceWyHash(message, length, SEED);
+                ASSERTV(length, EXP == mX.computeHash());
+            }
+        }
+
+        if (verbose) printf("Hash the messages in pieces. (C-4,5)\n");
+        {
+            u::Random random(99);
+
+            for (int length = 0; length <= k_MAX_LENGTH; ++length) {
+                const Uint64 EXP = u::referenceWyHash(message, length, SEED);
+
+                Obj byByte(seed);
+                for (int i = 0; i < length; ++i) {
+                    byByte(message + i, 1);
+                }
+                ASSERTV(length, EXP == byByte.computeHash());
+
+                for (int trial = 0; trial < 20; ++trial) {
+                    Obj pieces(seed);
+
+                    int offset = 0;
+                    while (offset < length) {
+                        const int remaining = length - offset;
+                        const int maxPiece  = trial % 2 ? 8 : 120;
+                        int       piece     = static_cast<int>(
+                                                 random() % (maxPiece + 1));
+                        if (piece > remaining) {
+                            piece = remaining;
+                        }
+                        pieces(message + offset, piece);
+                        pieces(message, 0);
+                        offset += piece;
+                    }
+                    ASSERTV(length, trial, EXP == pieces.computeHash());
+                }
+            }
+        }
+
+        if (verbose) printf("Call 'operator()' with null pointers. (C-6)\n");
+        {
+            const char data[5] = {'a', 'b', 'c', 'd', 'e'};
+
+            bsls::AssertTestHandlerGuard guard;
+
+            ASSERT_FAIL(Obj(genericSeed).operator()(   0, 5));
+            ASSERT_PASS(Obj(genericSeed).operator()(   0, 0));
+            ASSERT_PASS(Obj(genericSeed).operator()(data, 5));
+        }
+
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING CREATORS
+        //   Ensure that the implicitly declared and defined destructor and the
+        //   explicitly defined constructors are publicly callable.
+        //
+        // Concerns:
+        //: 1 Objects can be created using the default constructor, which uses
+        //:   a seed of 0.
+        //:
+        //: 2 Objects can be created using the parameterized constructor, which
+        //:   reads the seed as a little-endian integer.
+        //:
+        //: 3 Objects can be destroyed.
+        //:
+        //: 4 The parameterized constructor does a BSLS_ASSERT for null
+        //:   pointers.
+        //
+        // Plan:
+        //: 1 Create objects using the default constructor and using a seed of
+        //:   all-zero bytes, and verify that they produce the same hash for
+        //:   the same input.  (C-1,3)
+        //:
+        //: 2 Create objects using seeds differing in a single byte, and verify
+        //:   that they produce the hashes of the reference implementation
+        //:   for the corresponding integer seeds.  (C-2,3)
+        //:
+        //: 3 Call the parameterized constructor with a null pointer. (C-4)
+        //
+        // Testing:
+        //   WyHashAlgorithm();
+        //   explicit WyHashAlgorithm(const char *seed);
+        //   ~WyHashAlgorithm();
+        // --------------------------------------------------------------------
+
+        if (verbose)
+            printf("\nTESTING CREATORS"
+                   "\n================\n");
+
+        const char *MESSAGE = "The quick brown fox jumps over the lazy dog";
+
+        if (verbose) printf("Create objects using the default constructor."
+                            " (C-1,3)\n");
+        {
+            Obj alg1;
+            Obj alg2(genericSeed);
+
+            alg1(MESSAGE, strlen(MESSAGE));
+            alg2(MESSAGE, strlen(MESSAGE));
+
+            ASSERT(alg1.computeHash() == alg2.computeHash());
+        }
+
+        if (verbose) printf("Create objects using seeds differing in a single"
+                            " byte. (C-2,3)\n");
+        {
+            for (int i = 0; i < Obj::k_SEED_LENGTH; ++i) {
+                char seed[Obj::k_SEED_LENGTH] = { 0 };
+                seed[i] = '\x5a';
+
+                Obj mX(seed);
+                mX(MESSAGE, strlen(MESSAGE));
+
+                const Uint64 EXP = u::referenceWyHash(MESSAGE,
+                                                      strlen(MESSAGE),
+                                                      0x5aULL << (8 * i));
+                ASSERTV(i, EXP == mX.computeHash());
+            }
+        }
+
+        if (verbose) printf("Call the parameterized constructor with a null"
+                            " pointer. (C-4)\n");
+        {
+            bsls::AssertTestHandlerGuard guard;
+
+            ASSERT_FAIL(Obj dummy(0));
+            ASSERT_PASS(Obj dummy(genericSeed));
+        }
+
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an instance of 'bslh::WyHashAlgorithm'. (C-1)
+        //:
+        //: 2 Verify different hashes are produced for different c-strings.
+        //:   (C-1)
+        //:
+        //: 3 Verify the same hashes are produced for the same c-strings. (C-1)
+        //:
+        //: 4 Verify different hashes are produced for different 'int's. (C-1)
+        //:
+        //: 5 Verify the same hashes are produced for the same 'int's. (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        if (verbose) printf("Instantiate 'bslh::WyHashAlgorithm'\n");
+        {
+            WyHashAlgorithm hashAlg;
+        }
+
+        if (verbose) printf("Verify different hashes are produced for"
+                            " different c-strings.\n");
+        {
+            WyHashAlgorithm hashAlg1;
+            WyHashAlgorithm hashAlg2;
+            const char * str1 = "Hello World";
+            const char * str2 = "Goodbye World";
+            hashAlg1(str1, strlen(str1));
+            hashAlg2(str2, strlen(str2));
+            ASSERT(hashAlg1.computeHash() != hashAlg2.computeHash());
+        }
+
+        if (verbose) printf("Verify the same hashes are produced for the same"
+                            " c-strings.\n");
+        {
+            WyHashAlgorithm hashAlg1;
+            WyHashAlgorithm hashAlg2;
+            const char * str1 = "Hello World";
+            const char * str2 = "Hello World";
+            hashAlg1(str1, strlen(str1));
+            hashAlg2(str2, strlen(str2));
+            ASSERT(hashAlg1.computeHash() == hashAlg2.computeHash());
+        }
+
+        if (verbose) printf("Verify different hashes are produced for"
+                            " different ints.\n");
+        {
+            WyHashAlgorithm hashAlg1;
+            WyHashAlgorithm hashAlg2;
+            int int1 = 123456;
+            int int2 = 654321;
+            hashAlg1(&int1, sizeof(int));
+            hashAlg2(&int2, sizeof(int));
+            ASSERT(hashAlg1.computeHash() != hashAlg2.computeHash());
+        }
+
+        if (verbose) printf("Verify the same hashes are produced for the same"
+                            " ints.\n");
+        {
+            WyHashAlgorithm hashAlg1;
+            WyHashAlgorithm hashAlg2;
+            int int1 = 123456;
+            int int2 = 123456;
+            hashAlg1(&int1, sizeof(int));
+            hashAlg2(&int2, sizeof(int));
+            ASSERT(hashAlg1.computeHash() == hashAlg2.computeHash());
+        }
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE COMPARISON WITH OTHER ALGORITHMS
+        //   Measure the time taken to hash keys of various lengths using this
+        //   algorithm, 'SpookyHashAlgorithm' (the algorithm underlying
+        //   'DefaultHashAlgorithm'), and 'SipHashAlgorithm'.
+        //
+        // Concerns:
+        //: 1 The algorithm is faster than the other algorithms for short keys.
+        //
+        // Plan:
+        //: 1 For keys of 4 to 1024 bytes, hash a key (whose first byte is
+        //:   changed on each iteration) a number of times, optionally
+        //:   specified by the second argument, with each algorithm, and print
+        //:   the average time taken per hash.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE COMPARISON WITH OTHER ALGORITHMS
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nPERFORMANCE COMPARISON WITH OTHER ALGORITHMS"
+                            "\n============================================"
+                            "\n");
+
+        const int NUM_ITERATIONS = argc > 2 ? atoi(argv[2]) : 10000000;
+
+        const size_t LENGTHS[] = { 4, 8, 16, 24, 32, 64, 256, 1024 };
+        const int    NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+
+        for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+            const size_t LENGTH = LENGTHS[ti];
+            const int    NUM    = std::max(1,
+                                               static_cast<int>(
+                                      NUM_ITERATIONS * 8 / (LENGTH + 8)));
+
+            u::benchmark<WyHashAlgorithm>(    "wyhash", LENGTH, NUM);
+            u::benchmark<SpookyHashAlgorithm>("spooky", LENGTH, NUM);
+            u::benchmark<SipHashAlgorithm>(   "siphash", LENGTH, NUM);
+        }
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
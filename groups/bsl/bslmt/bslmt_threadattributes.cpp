@@ -32,6 +32,8 @@ bslmt::ThreadAttributes::ThreadAttributes()
 , d_schedulingPriority(e_UNSET_PRIORITY)
 , d_stackSize(e_UNSET_STACK_SIZE)
 , d_threadName(static_cast<bslma::Allocator *>(0))
+, d_cpuAffinity(static_cast<bslma::Allocator *>(0))
+, d_numaNode(e_UNSET_NUMA_NODE)
 {
 }
 
@@ -43,6 +45,8 @@ bslmt::ThreadAttributes::ThreadAttributes(bslma::Allocator *basicAllocator)
 , d_schedulingPriority(e_UNSET_PRIORITY)
 , d_stackSize(e_UNSET_STACK_SIZE)
 , d_threadName(basicAllocator)
+, d_cpuAffinity(basicAllocator)
+, d_numaNode(e_UNSET_NUMA_NODE)
 {
 }
 
@@ -57,6 +61,8 @@ bslmt::ThreadAttributes::ThreadAttributes(
 , d_schedulingPriority(original.d_schedulingPriority)
 , d_stackSize(original.d_stackSize)
 , d_threadName(original.d_threadName, basicAllocator)
+, d_cpuAffinity(original.d_cpuAffinity, basicAllocator)
+, d_numaNode(original.d_numaNode)
 {
 }
 
@@ -71,6 +77,8 @@ bslmt::ThreadAttributes& bslmt::ThreadAttributes::operator=(
     d_schedulingPriority  = rhs.d_schedulingPriority;
     d_stackSize           = rhs.d_stackSize;
     d_threadName          = rhs.d_threadName;
+    d_cpuAffinity         = rhs.d_cpuAffinity;
+    d_numaNode            = rhs.d_numaNode;
 
     return *this;
 }
@@ -85,7 +93,9 @@ bool bslmt::operator==(const ThreadAttributes& lhs,
            lhs.schedulingPolicy()   == rhs.schedulingPolicy()   &&
            lhs.schedulingPriority() == rhs.schedulingPriority() &&
            lhs.stackSize()          == rhs.stackSize()          &&
-           lhs.threadName()         == rhs.threadName();
+           lhs.threadName()         == rhs.threadName()         &&
+           lhs.cpuAffinity()        == rhs.cpuAffinity()        &&
+           lhs.numaNode()           == rhs.numaNode();
 }
 
 bool bslmt::operator!=(const ThreadAttributes& lhs,
@@ -97,7 +107,9 @@ bool bslmt::operator!=(const ThreadAttributes& lhs,
            lhs.schedulingPolicy()   != rhs.schedulingPolicy()   ||
            lhs.schedulingPriority() != rhs.schedulingPriority() ||
            lhs.stackSize()          != rhs.stackSize()          ||
-           lhs.threadName()         != rhs.threadName();
+           lhs.threadName()         != rhs.threadName()         ||
+           lhs.cpuAffinity()        != rhs.cpuAffinity()        ||
+           lhs.numaNode()           != rhs.numaNode();
 }
 
 }  // close enterprise namespace
@@ -36,11 +36,15 @@ BSLS_IDENT("$Id: $")
 //  schedulingPolicy    enum SchedulingPolicy  e_SCHED_DEFAULT
 //  schedulingPriority  int                    e_UNSET_PRIORITY
 //  threadName          bsl::string            ""
+//  cpuAffinity         bsl::vector<int>       empty
+//  numaNode            int                    e_UNSET_NUMA_NODE
 //
 //  Name          Constraint
 //  ---------     ---------------------------------------------------
 //  stackSize     'e_UNSET_STACK_SIZE == stackSize || 0 <= stackSize'
 //  guardSize     'e_UNSET_GUARD_SIZE == guardSize || 0 <= guardSize'
+//  cpuAffinity   '0 <= cpu' for each 'cpu' of 'cpuAffinity'
+//  numaNode      'e_UNSET_NUMA_NODE == numaNode || 0 <= numaNode'
 //..
 //
 ///'detachedState' Attribute
@@ -130,6 +134,32 @@ BSLS_IDENT("$Id: $")
 // thread names, and there is a maximum thread name length of 15 on both of
 // those platforms.
 //
+///'cpuAffinity' Attribute
+///- - - - - - - - - - - -
+// The 'cpuAffinity' attribute indicates the set of CPUs, identified by their
+// zero-based indices (as reported, e.g., by 'sched_getcpu' on Linux), on which
+// the thread may run.  If 'cpuAffinity' is empty (the default), the thread may
+// run on any CPU allowed for the process.  Restricting (or "pinning") a thread
+// to a few CPUs keeps its caches warm, and, on systems having several NUMA
+// nodes, keeps the memory it allocates (which, by default, is placed on the
+// node of the CPU that first touches it) local to the CPUs that access it.
+// Thread creation fails if none of the specified CPUs is available to the
+// process.
+//
+///'numaNode' Attribute
+/// - - - - - - - - - -
+// The 'numaNode' attribute indicates the NUMA node (i.e., the group of CPUs
+// sharing a memory controller, typically a socket) on whose CPUs the thread
+// may run.  If 'numaNode' is 'e_UNSET_NUMA_NODE' (the default), the thread is
+// not bound to a node.  If both 'numaNode' and 'cpuAffinity' are set, the
+// thread may run only on the CPUs of 'cpuAffinity' that belong to
+// 'numaNode'.  Thread creation fails if 'numaNode' is not a node of the
+// system.  See 'bslmt_threadutil' for functions describing the NUMA nodes of
+// the system.
+//
+// At this time, only Linux supports the 'cpuAffinity' and 'numaNode'
+// attributes; they are ignored on other platforms.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -269,7 +299,9 @@ BSLS_IDENT("$Id: $")
 #include <bsls_assert.h>
 
 #include <bsl_c_limits.h>
+#include <bsl_cstddef.h>
 #include <bsl_string.h>
+#include <bsl_vector.h>
 
 namespace BloombergLP {
 namespace bslmt {
@@ -331,14 +363,16 @@ class ThreadAttributes {
 
     enum {
         // The following constants indicate that the 'stackSize', 'guardSize',
-        // and 'schedulingPriority' attributes, respectively, are unspecified
-        // and the thread creation routine is use platform-specific defaults.
-        // These attributes are initialized to these values when a thread
-        // attributes object is default constructed.
+        // 'schedulingPriority', and 'numaNode' attributes, respectively, are
+        // unspecified and the thread creation routine is use
+        // platform-specific defaults.  These attributes are initialized to
+        // these values when a thread attributes object is default
+        // constructed.
 
         e_UNSET_STACK_SIZE = -1,
         e_UNSET_GUARD_SIZE = -1,
         e_UNSET_PRIORITY   = INT_MIN,
+        e_UNSET_NUMA_NODE  = -1,
 
         e_SCHED_MIN        = e_SCHED_OTHER,
         e_SCHED_MAX        = e_SCHED_DEFAULT
@@ -374,6 +408,12 @@ class ThreadAttributes {
 
     bsl::string      d_threadName;          // name of the thread
 
+    bsl::vector<int> d_cpuAffinity;         // CPUs on which the thread may
+                                            // run (any CPU if empty)
+
+    int              d_numaNode;            // NUMA node on whose CPUs the
+                                            // thread may run
+
   public:
     // TRAITS
     BSLMF_NESTED_TRAIT_DECLARATION(ThreadAttributes,
@@ -391,6 +431,8 @@ class ThreadAttributes {
         //: o 'schedulingPriority() == e_UNSET_PRIORITY'
         //: o 'stackSize()          == e_UNSET_STACK_SIZE'
         //: o 'threadName()         == ""'
+        //: o 'cpuAffinity()        == bsl::vector<int>()'
+        //: o 'numaNode()           == e_UNSET_NUMA_NODE'
         // Optionally specify a 'basicAllocator' used to supply memory.  If
         // 'basicAllocator' is 0, the currently installed default allocator is
         // used.
@@ -408,6 +450,14 @@ class ThreadAttributes {
         // return a reference providing modifiable access to this object.
 
     // MANIPULATORS
+    void setCpuAffinity(const bsl::vector<int>& value);
+        // Set the 'cpuAffinity' attribute of this object to the specified
+        // 'value', the indices of the CPUs on which a thread may run.  An
+        // empty 'value' (the default) indicates that a thread may run on any
+        // CPU.  The behavior is undefined unless each element of 'value' is
+        // non-negative.  See {'cpuAffinity' Attribute} for information about
+        // support for this attribute.
+
     void setDetachedState(DetachedState value);
         // Set the 'detachedState' attribute of this object to the specified
         // 'value'.  A value of 'e_CREATE_JOINABLE' (the default) indicates
@@ -434,6 +484,14 @@ class ThreadAttributes {
         // and ignore the respective values in this object.  See
         // 'bslmt_threadutil' for information about support for this attribute.
 
+    void setNumaNode(int value);
+        // Set the 'numaNode' attribute of this object to the specified
+        // 'value', the index of the NUMA node on whose CPUs a thread may run.
+        // 'e_UNSET_NUMA_NODE == value' (the default) indicates that a thread
+        // is not bound to a NUMA node.  The behavior is undefined unless
+        // 'e_UNSET_NUMA_NODE == value' or '0 <= value'.  See {'numaNode'
+        // Attribute} for information about support for this attribute.
+
     void setSchedulingPolicy(SchedulingPolicy value);
         // Set the value of the 'schedulingPolicy' attribute of this object to
         // the specified 'value'.  This attribute is ignored unless
@@ -462,6 +520,12 @@ class ThreadAttributes {
         // 'value'.
 
     // ACCESSORS
+    const bsl::vector<int>& cpuAffinity() const;
+        // Return a reference providing non-modifiable access to the
+        // 'cpuAffinity' attribute of this object, the indices of the CPUs on
+        // which a thread may run, or an empty vector if a thread may run on
+        // any CPU.
+
     DetachedState detachedState() const;
         // Return the value of the 'detachedState' attribute of this object.  A
         // value of 'e_CREATE_JOINABLE' indicates that a thread must be joined
@@ -487,6 +551,11 @@ class ThreadAttributes {
         // respective values in this object.  See 'bslmt_threadutil' for
         // information about support for this attribute.
 
+    int numaNode() const;
+        // Return the value of the 'numaNode' attribute of this object, the
+        // index of the NUMA node on whose CPUs a thread may run, or
+        // 'e_UNSET_NUMA_NODE' if a thread is not bound to a NUMA node.
+
     SchedulingPolicy schedulingPolicy() const;
         // Return the value of the 'schedulingPolicy' attribute of this object.
         // This attribute is ignored unless 'inheritSchedule' is 'false'.  See
@@ -523,14 +592,16 @@ bool operator==(const ThreadAttributes& lhs, const ThreadAttributes& rhs);
     // value, and 'false' otherwise.  Two 'ThreadAttributes' objects have the
     // same value if the corresponding values of their 'detachedState',
     // 'guardSize', 'inheritSchedule', 'schedulingPolicy',
-    // 'schedulingPriority', and 'stackSize' attributes are the same.
+    // 'schedulingPriority', 'stackSize', 'threadName', 'cpuAffinity', and
+    // 'numaNode' attributes are the same.
 
 bool operator!=(const ThreadAttributes& lhs, const ThreadAttributes& rhs);
     // Return 'true' if the specified 'lhs' and 'rhs' objects do not have the
     // same value, and 'false' otherwise.  Two 'baltzo::LocalTimeDescriptor'
     // objects do not have the same value if the corresponding values of their
     // 'detachedState', 'guardSize', 'inheritSchedule', 'schedulingPolicy',
-    // 'schedulingPriority', and 'stackSize' attributes are not the same.
+    // 'schedulingPriority', 'stackSize', 'threadName', 'cpuAffinity', and
+    // 'numaNode' attributes are not the same.
 
 }  // close package namespace
 
@@ -543,6 +614,18 @@ bool operator!=(const ThreadAttributes& lhs, const ThreadAttributes& rhs);
                           // ----------------------
 
 // MANIPULATORS
+inline
+void bslmt::ThreadAttributes::setCpuAffinity(const bsl::vector<int>& value)
+{
+#ifdef BSLS_ASSERT_SAFE_IS_ACTIVE
+    for (bsl::size_t i = 0; i < value.size(); ++i) {
+        BSLS_ASSERT_SAFE(0 <= value[i]);
+    }
+#endif
+
+    d_cpuAffinity = value;
+}
+
 inline
 void bslmt::ThreadAttributes::setDetachedState(
                                          ThreadAttributes::DetachedState value)
@@ -569,6 +652,16 @@ void bslmt::ThreadAttributes::setInheritSchedule(bool value)
     d_inheritScheduleFlag = value;
 }
 
+inline
+void bslmt::ThreadAttributes::setNumaNode(int value)
+{
+    BSLMF_ASSERT(-1 == e_UNSET_NUMA_NODE);
+
+    BSLS_ASSERT_SAFE(-1 <= value);
+
+    d_numaNode = value;
+}
+
 inline
 void bslmt::ThreadAttributes::setSchedulingPolicy(
                                       ThreadAttributes::SchedulingPolicy value)
@@ -602,6 +695,12 @@ void bslmt::ThreadAttributes::setThreadName(const bslstl::StringRef& value)
 }
 
 // ACCESSORS
+inline
+const bsl::vector<int>& bslmt::ThreadAttributes::cpuAffinity() const
+{
+    return d_cpuAffinity;
+}
+
 inline
 bslmt::ThreadAttributes::DetachedState
 bslmt::ThreadAttributes::detachedState() const
@@ -621,6 +720,12 @@ bool bslmt::ThreadAttributes::inheritSchedule() const
     return d_inheritScheduleFlag;
 }
 
+inline
+int bslmt::ThreadAttributes::numaNode() const
+{
+    return d_numaNode;
+}
+
 inline
 bslmt::ThreadAttributes::SchedulingPolicy
 bslmt::ThreadAttributes::schedulingPolicy() const
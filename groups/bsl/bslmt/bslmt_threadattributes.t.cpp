@@ -19,11 +19,13 @@
 
 #include <bslmf_assert.h>
 
+#include <bsls_asserttest.h>
 #include <bsls_types.h>
 
 #include <bsl_cstdlib.h>
 #include <bsl_ios.h>
 #include <bsl_iostream.h>
+#include <bsl_vector.h>
 
 #ifdef BSLMT_PLATFORM_POSIX_THREADS
 #include <pthread.h>
@@ -76,6 +78,13 @@ void aSsErT(bool condition, const char *message, int line)
 #define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
 #define L_           BSLIM_TESTUTIL_L_  // current Line number
 
+// ============================================================================
+//                     NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+
 // ============================================================================
 //                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
 // ----------------------------------------------------------------------------
@@ -318,9 +327,10 @@ int main(int argc, char *argv[])
         // ------------------------------------------------------------------
         // Testing Primary Manipulators / Accessors
         //
-        // For each of the 6 attributes of Attribute, set the attribute on a
+        // For each of the attributes of Attribute, set the attribute on a
         // newly constructed object, copy the object, and use the accessor for
-        // that attribute to verify the value.
+        // that attribute to verify the value.  The 'numaNode' and
+        // 'cpuAffinity' attributes are derived from the index of the row.
         // ------------------------------------------------------------------
 
         if (verbose) {
@@ -368,9 +378,18 @@ int main(int argc, char *argv[])
 
         size_t numParams = sizeof(PARAM) / sizeof(Parameters);
         for (unsigned i = 0; i < numParams; ++i) {
-            const Int64 numTaPreAlloc = ta.numAllocations();
             const Int64 numDaPreAlloc = da.numAllocations();
 
+            const int NUMA_NODE = static_cast<int>(i % 3) - 1;
+
+            bsl::vector<int> cpus(&ta);
+            for (unsigned j = 0; j < i % 4; ++j) {
+                cpus.push_back(static_cast<int>(j * 2));
+            }
+            const bsl::vector<int>& CPUS = cpus;
+
+            const Int64 numTaPreAlloc = ta.numAllocations();
+
             Obj mX(&ta);    const Obj& X = mX;
             mX.setDetachedState(PARAM[i].d_detachedState);
             mX.setSchedulingPolicy(PARAM[i].d_schedulingPolicy);
@@ -379,9 +398,12 @@ int main(int argc, char *argv[])
             mX.setStackSize(PARAM[i].d_stackSize);
             mX.setGuardSize(PARAM[i].d_guardSize);
             mX.setThreadName(PARAM[i].d_threadName);
+            mX.setNumaNode(NUMA_NODE);
+            mX.setCpuAffinity(CPUS);
 
             ASSERT(da.numAllocations() == numDaPreAlloc);
-            ASSERTV(X.threadName(), (X.threadName().length() > 15) ==
+            ASSERTV(X.threadName(), (X.threadName().length() > 15 ||
+                                     !CPUS.empty()) ==
                                         (ta.numAllocations() > numTaPreAlloc));
 
             Obj mY(&ta);
@@ -464,6 +486,45 @@ int main(int argc, char *argv[])
                         PARAM[i].d_threadName == Y.threadName());
             LOOP_ASSERT(PARAM[i].d_line,
                         PARAM[i].d_threadName == Z.threadName());
+            LOOP_ASSERT(PARAM[i].d_line, NUMA_NODE == X.numaNode());
+            LOOP_ASSERT(PARAM[i].d_line, NUMA_NODE == Y.numaNode());
+            LOOP_ASSERT(PARAM[i].d_line, NUMA_NODE == Z.numaNode());
+            LOOP_ASSERT(PARAM[i].d_line, CPUS == X.cpuAffinity());
+            LOOP_ASSERT(PARAM[i].d_line, CPUS == Y.cpuAffinity());
+            LOOP_ASSERT(PARAM[i].d_line, CPUS == Z.cpuAffinity());
+
+            // Each of the new attributes participates in equality.
+
+            Obj mW(X, &ta);    const Obj& W = mW;
+            mW.setNumaNode(NUMA_NODE + 1);
+            LOOP_ASSERT(PARAM[i].d_line, W != X);
+            LOOP_ASSERT(PARAM[i].d_line, !(W == X));
+            mW.setNumaNode(NUMA_NODE);
+            LOOP_ASSERT(PARAM[i].d_line, W == X);
+
+            bsl::vector<int> otherCpus(CPUS, &ta);
+            otherCpus.push_back(1);
+            mW.setCpuAffinity(otherCpus);
+            LOOP_ASSERT(PARAM[i].d_line, W != X);
+            LOOP_ASSERT(PARAM[i].d_line, !(W == X));
+            mW.setCpuAffinity(CPUS);
+            LOOP_ASSERT(PARAM[i].d_line, W == X);
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            Obj mX(&ta);
+
+            ASSERT_SAFE_PASS(mX.setNumaNode(Obj::e_UNSET_NUMA_NODE));
+            ASSERT_SAFE_PASS(mX.setNumaNode(0));
+            ASSERT_SAFE_FAIL(mX.setNumaNode(-2));
+
+            bsl::vector<int> cpus(1, 0, &ta);
+            ASSERT_SAFE_PASS(mX.setCpuAffinity(cpus));
+            cpus.push_back(-1);
+            ASSERT_SAFE_FAIL(mX.setCpuAffinity(cpus));
         }
       } break;
       case 1: {
@@ -494,6 +555,8 @@ int main(int argc, char *argv[])
         ASSERT(X.inheritSchedule());
         ASSERT(0 != X.stackSize());
         ASSERT("" == X.threadName());
+        ASSERT(X.cpuAffinity().empty());
+        ASSERT(Obj::e_UNSET_NUMA_NODE == X.numaNode());
       } break;
       case -1: {
         // --------------------------------------------------------------------
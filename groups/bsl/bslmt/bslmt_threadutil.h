@@ -291,6 +291,7 @@ BSLS_IDENT("$Id: $")
 #include <bsls_types.h>
 
 #include <bsl_string.h>
+#include <bsl_vector.h>
 
 namespace BloombergLP {
 
@@ -715,6 +716,23 @@ struct ThreadUtil {
     static unsigned int hardwareConcurrency();
         // Return a *hint* at the number of concurrent threads supported by
         // this platform on success, and 0 otherwise.
+
+    static int numNumaNodes();
+        // Return the number of NUMA nodes (i.e., groups of CPUs sharing a
+        // memory controller) of this platform, which is 1 if the platform
+        // does not report its NUMA topology.  Note that the nodes are
+        // identified by the indices in the range '[0 .. numNumaNodes())', and
+        // that a thread can be bound to a node using the 'numaNode' attribute
+        // of 'bslmt::ThreadAttributes'.
+
+    static int numaNodeCpus(bsl::vector<int> *result, int numaNode);
+        // Load into the specified 'result' the indices, in increasing order,
+        // of the CPUs belonging to the specified 'numaNode'.  Return 0 on
+        // success, and a non-zero value (with no effect on 'result') if
+        // 'numaNode' is not a NUMA node of this platform.  The behavior is
+        // undefined unless '0 <= numaNode'.  Note that on a platform that
+        // does not report its NUMA topology, node 0 comprises all the CPUs
+        // reported by 'hardwareConcurrency'.
 };
 
 }  // close package namespace
@@ -1023,6 +1041,21 @@ unsigned int bslmt::ThreadUtil::hardwareConcurrency()
     return Imp::hardwareConcurrency();
 }
 
+inline
+int bslmt::ThreadUtil::numNumaNodes()
+{
+    return Imp::numNumaNodes();
+}
+
+inline
+int bslmt::ThreadUtil::numaNodeCpus(bsl::vector<int> *result, int numaNode)
+{
+    BSLS_ASSERT_SAFE(result);
+    BSLS_ASSERT_SAFE(0 <= numaNode);
+
+    return Imp::numaNodeCpus(result, numaNode);
+}
+
 }  // close enterprise namespace
 
 #endif
@@ -37,6 +37,7 @@
 #include <bsl_iostream.h>
 #include <bsl_map.h>
 #include <bsl_set.h>
+#include <bsl_vector.h>
 
 #include <errno.h>
 
@@ -128,6 +129,8 @@ bool isPost_5_10;    // On Solaris, is OS post-Solaris 5.0
 #define ASSERT_PASS(expr)      BSLS_ASSERTTEST_ASSERT_PASS(expr)
 #define ASSERT_FAIL_RAW(expr)  BSLS_ASSERTTEST_ASSERT_FAIL_RAW(expr)
 #define ASSERT_PASS_RAW(expr)  BSLS_ASSERTTEST_ASSERT_PASS_RAW(expr)
+#define ASSERT_SAFE_FAIL(expr) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(expr)
+#define ASSERT_SAFE_PASS(expr) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(expr)
 
 #if !defined(BSLS_PLATFORM_OS_CYGWIN)
     const int MIN_GUARD_SIZE = 0;
@@ -1326,6 +1329,47 @@ extern "C" void *secondClearanceTest(void *vStackSize)
     return 0;
 }
 
+// ----------------------------------------------------------------------------
+//                                TEST CASE 18
+// ----------------------------------------------------------------------------
+
+struct PlacementInfo {
+    // This 'struct' holds the placement of a thread, as observed by the
+    // thread itself.
+
+    int d_numAllowedCpus;  // number of CPUs on which the thread may run
+    int d_firstAllowedCpu; // lowest CPU on which the thread may run
+    int d_currentCpu;      // CPU running the thread
+};
+
+extern "C" void *recordPlacement(void *arg)
+    // Load the placement of the calling thread into the 'PlacementInfo'
+    // addressed by the specified 'arg'.  Return 0.
+{
+    PlacementInfo *info = static_cast<PlacementInfo *>(arg);
+
+    info->d_numAllowedCpus  = -1;
+    info->d_firstAllowedCpu = -1;
+    info->d_currentCpu      = -1;
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (0 == pthread_getaffinity_np(pthread_self(), sizeof cpuSet, &cpuSet)) {
+        info->d_numAllowedCpus = CPU_COUNT(&cpuSet);
+        for (int i = 0; i < CPU_SETSIZE; ++i) {
+            if (CPU_ISSET(i, &cpuSet)) {
+                info->d_firstAllowedCpu = i;
+                break;
+            }
+        }
+    }
+    info->d_currentCpu = sched_getcpu();
+#endif
+
+    return 0;
+}
+
 // ============================================================================
 //                               MAIN PROGRAM
 // ----------------------------------------------------------------------------
@@ -1357,6 +1401,177 @@ int main(int argc, char *argv[])
 #endif
 
     switch (test) { case 0:  // Zero is always the leading case.
+      case 18: {
+        // --------------------------------------------------------------------
+        // TESTING NUMA TOPOLOGY AND CPU AFFINITY
+        //
+        // Concerns:
+        //: 1 'numNumaNodes' returns a positive value.
+        //:
+        //: 2 'numaNodeCpus' loads the CPUs of each node in increasing order,
+        //:   every node has valid CPU indices, and node 0 has at least one
+        //:   CPU.
+        //:
+        //: 3 'numaNodeCpus' fails, without modifying 'result', for a node
+        //:   that does not exist.
+        //:
+        //: 4 On Linux, a thread created with a 'cpuAffinity' attribute runs
+        //:   only on the specified CPUs, and a thread created with a
+        //:   'numaNode' attribute runs only on the CPUs of that node.
+        //:
+        //: 5 On Linux, thread creation fails if 'numaNode' does not exist, or
+        //:   if no CPU of 'cpuAffinity' belongs to 'numaNode'.
+        //:
+        //: 6 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Call 'numNumaNodes' and verify the result.  (C-1)
+        //:
+        //: 2 For each node, call 'numaNodeCpus' and verify the result.  (C-2)
+        //:
+        //: 3 Call 'numaNodeCpus' for the node 'numNumaNodes()' and verify
+        //:   that it fails and does not modify the result.  (C-3)
+        //:
+        //: 4 Create threads pinned to the first CPU of node 0, and bound to
+        //:   node 0, and have each thread report the CPUs on which it may run
+        //:   and is running.  (C-4)
+        //:
+        //: 5 Attempt to create threads with invalid 'numaNode' and
+        //:   'cpuAffinity' attributes, and verify that creation fails.  (C-5)
+        //:
+        //: 6 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-6)
+        //
+        // Testing:
+        //   int numNumaNodes();
+        //   int numaNodeCpus(bsl::vector<int> *result, int numaNode);
+        //   CONCERN: 'cpuAffinity' and 'numaNode' attributes are honored
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "TESTING NUMA TOPOLOGY AND CPU AFFINITY\n"
+                             "======================================\n";
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        const int NUM_NODES = Obj::numNumaNodes();
+        if (veryVerbose) { P(NUM_NODES); }
+
+        ASSERTV(NUM_NODES, 1 <= NUM_NODES);
+
+        bsl::vector<int> node0Cpus(&ta);
+        for (int node = 0; node < NUM_NODES; ++node) {
+            bsl::vector<int> cpus(&ta);
+            int rc = Obj::numaNodeCpus(&cpus, node);
+
+            ASSERTV(node, 0 == rc);
+            for (bsl::size_t i = 0; i < cpus.size(); ++i) {
+                ASSERTV(node, i, cpus[i], 0 <= cpus[i]);
+                ASSERTV(node, i, cpus[i], 0 == i || cpus[i - 1] < cpus[i]);
+            }
+            if (veryVerbose) { P_(node); P(cpus.size()); }
+
+            if (0 == node) {
+                ASSERT(!cpus.empty());
+                node0Cpus = cpus;
+            }
+        }
+
+        {
+            bsl::vector<int> cpus(1, 42, &ta);
+            ASSERT(0 != Obj::numaNodeCpus(&cpus, NUM_NODES));
+            ASSERT(1 == cpus.size() && 42 == cpus[0]);
+        }
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+        if (verbose) cout << "\tPinning threads.\n";
+
+        const int FIRST_CPU = node0Cpus.empty() ? 0 : node0Cpus.front();
+        {
+            Attr attr(&ta);
+            attr.setCpuAffinity(bsl::vector<int>(1, FIRST_CPU, &ta));
+
+            PlacementInfo info;
+            Obj::Handle   handle;
+            ASSERT(0 == Obj::create(&handle, attr, &recordPlacement, &info));
+            ASSERT(0 == Obj::join(handle));
+
+            ASSERTV(info.d_numAllowedCpus,  1 == info.d_numAllowedCpus);
+            ASSERTV(info.d_firstAllowedCpu,
+                    FIRST_CPU == info.d_firstAllowedCpu);
+            ASSERTV(info.d_currentCpu, FIRST_CPU == info.d_currentCpu);
+        }
+        {
+            Attr attr(&ta);
+            attr.setNumaNode(0);
+
+            PlacementInfo info;
+            Obj::Handle   handle;
+            ASSERT(0 == Obj::create(&handle, attr, &recordPlacement, &info));
+            ASSERT(0 == Obj::join(handle));
+
+            ASSERTV(info.d_numAllowedCpus,
+                    1 <= info.d_numAllowedCpus &&
+                    static_cast<int>(node0Cpus.size()) >=
+                                                       info.d_numAllowedCpus);
+            ASSERTV(info.d_currentCpu,
+                    bsl::binary_search(node0Cpus.begin(),
+                                       node0Cpus.end(),
+                                       info.d_currentCpu));
+        }
+        {
+            Attr attr(&ta);
+            attr.setNumaNode(0);
+            attr.setCpuAffinity(bsl::vector<int>(1, FIRST_CPU, &ta));
+
+            PlacementInfo info;
+            Obj::Handle   handle;
+            ASSERT(0 == Obj::create(&handle, attr, &recordPlacement, &info));
+            ASSERT(0 == Obj::join(handle));
+
+            ASSERTV(info.d_numAllowedCpus,  1 == info.d_numAllowedCpus);
+            ASSERTV(info.d_currentCpu, FIRST_CPU == info.d_currentCpu);
+        }
+
+        if (verbose) cout << "\tInvalid placements.\n";
+        {
+            PlacementInfo info;
+            Obj::Handle   handle;
+
+            Attr attr(&ta);
+            attr.setNumaNode(NUM_NODES);
+            ASSERT(0 != Obj::create(&handle, attr, &recordPlacement, &info));
+
+            Attr attr2(&ta);
+            attr2.setCpuAffinity(bsl::vector<int>(1, CPU_SETSIZE, &ta));
+            ASSERT(0 != Obj::create(&handle, attr2, &recordPlacement, &info));
+
+            if (1 < NUM_NODES) {
+                bsl::vector<int> node1Cpus(&ta);
+                ASSERT(0 == Obj::numaNodeCpus(&node1Cpus, 1));
+
+                Attr attr3(&ta);
+                attr3.setNumaNode(0);
+                attr3.setCpuAffinity(node1Cpus);
+                ASSERT(node1Cpus.empty() ||
+                       0 != Obj::create(&handle,
+                                        attr3,
+                                        &recordPlacement,
+                                        &info));
+            }
+        }
+#endif
+
+        if (verbose) cout << "\tNegative Testing.\n";
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            bsl::vector<int> cpus(&ta);
+            ASSERT_SAFE_PASS(Obj::numaNodeCpus(&cpus, 0));
+            ASSERT_SAFE_FAIL(Obj::numaNodeCpus(0, 0));
+            ASSERT_SAFE_FAIL(Obj::numaNodeCpus(&cpus, -1));
+
+        }
+      } break;
       case 17: {
         // --------------------------------------------------------------------
         // TESTING 'hardwareConcurrency'
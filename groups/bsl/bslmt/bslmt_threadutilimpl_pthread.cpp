@@ -31,6 +31,7 @@ BSLS_IDENT_RCSID(bslmt_threadutilimpl_pthread_cpp,"$Id$ $CSID$")
 #include <bsl_cstring.h>
 #include <bsl_ctime.h>
 #include <bsl_c_limits.h>
+#include <bsl_cstdio.h>    // 'sprintf'
 
 #include <pthread.h>
 #include <unistd.h>        // sysconf, geteuid
@@ -45,6 +46,8 @@ BSLS_IDENT_RCSID(bslmt_threadutilimpl_pthread_cpp,"$Id$ $CSID$")
 # include <sys/utsname.h>
 #elif defined(BSLS_PLATFORM_OS_LINUX)
 # include <sys/prctl.h>
+# include <fcntl.h>        // open
+# include <sched.h>        // 'cpu_set_t'
 #elif defined(BSLS_PLATFORM_OS_HPUX)
 # include <sys/mpctl.h>
 #endif
@@ -100,6 +103,203 @@ int localPthreadsPolicy(int policy)
     BSLS_ASSERT_OPT(0);
 }
 
+enum {
+    k_CPU_LIST_BUF_SIZE = 4096  // size of a buffer holding the list of CPUs
+                                // of a NUMA node, or the list of nodes
+};
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+static const char k_NODES_ONLINE_PATH[] = "/sys/devices/system/node/online";
+
+static
+int readSysFile(char *buffer, int size, const char *path)
+    // Load into the specified 'buffer' having the specified 'size' the
+    // null-terminated contents of the file at the specified 'path',
+    // truncated to 'size - 1' characters.  Return 0 on success, and a
+    // non-zero value if the file cannot be read or is empty.
+{
+    int fd = open(path, O_RDONLY);
+    if (0 > fd) {
+        return -1;                                                    // RETURN
+    }
+
+    ssize_t length = read(fd, buffer, size - 1);
+    close(fd);
+    if (0 >= length) {
+        return -1;                                                    // RETURN
+    }
+
+    buffer[length] = '\0';
+    return 0;
+}
+#endif
+
+static
+int parseCpuList(const char  *list,
+                 int        (*visitor)(void *, int),
+                 void        *context)
+    // Invoke the specified 'visitor' with the specified 'context' and each
+    // index in the specified 'list' having the Linux "cpulist" format (i.e.,
+    // comma-separated indices and inclusive ranges of indices, for example
+    // "0-3,8,10-11").  Return 0 on success, and a non-zero value if 'list' is
+    // malformed or 'visitor' returns a non-zero value, in which case the
+    // remaining indices are not visited.  Note that an empty (or blank)
+    // 'list' is well-formed.
+{
+    const char *p = list;
+    while (true) {
+        while (' ' == *p || '\n' == *p) {
+            ++p;
+        }
+        if ('\0' == *p) {
+            return 0;                                                 // RETURN
+        }
+
+        int first = 0;
+        if ('0' > *p || '9' < *p) {
+            return -1;                                                // RETURN
+        }
+        while ('0' <= *p && '9' >= *p && first < INT_MAX / 10) {
+            first = first * 10 + (*p++ - '0');
+        }
+
+        int last = first;
+        if ('-' == *p) {
+            ++p;
+            last = 0;
+            if ('0' > *p || '9' < *p) {
+                return -1;                                            // RETURN
+            }
+            while ('0' <= *p && '9' >= *p && last < INT_MAX / 10) {
+                last = last * 10 + (*p++ - '0');
+            }
+        }
+
+        if (last < first || ('0' <= *p && '9' >= *p)) {
+            return -1;                                                // RETURN
+        }
+
+        for (int index = first; index <= last; ++index) {
+            if (0 != visitor(context, index)) {
+                return -1;                                            // RETURN
+            }
+        }
+
+        if (',' == *p) {
+            ++p;
+        }
+    }
+}
+
+static
+int appendToVector(void *vector, int index)
+    // Append the specified 'index' to the 'bsl::vector<int>' addressed by the
+    // specified 'vector'.  Return 0.
+{
+    static_cast<bsl::vector<int> *>(vector)->push_back(index);
+    return 0;
+}
+
+static
+int loadNumaNodeCpuList(char *buffer, int numaNode)
+    // Load into the specified 'buffer', having a size of
+    // 'k_CPU_LIST_BUF_SIZE', the list of the CPUs of the specified
+    // 'numaNode' in the Linux "cpulist" format.  Return 0 on success, and a
+    // non-zero value if 'numaNode' is not a NUMA node of this platform.  If
+    // the platform does not report its NUMA topology, node 0 comprises all
+    // the CPUs reported by 'hardwareConcurrency'.
+{
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    char path[64];
+    bsl::sprintf(path, "/sys/devices/system/node/node%d/cpulist", numaNode);
+    if (0 == readSysFile(buffer, k_CPU_LIST_BUF_SIZE, path)) {
+        return 0;                                                     // RETURN
+    }
+    if (0 == readSysFile(buffer, k_CPU_LIST_BUF_SIZE, k_NODES_ONLINE_PATH)) {
+        // The NUMA topology is reported, and has no such node.
+
+        return -1;                                                    // RETURN
+    }
+#endif
+
+    if (0 != numaNode) {
+        return -1;                                                    // RETURN
+    }
+
+    unsigned int numCpus = bslmt::ThreadUtilImpl<bslmt::Platform::PosixThreads>
+                                                       ::hardwareConcurrency();
+    bsl::sprintf(buffer, "0-%u", 0 == numCpus ? 0 : numCpus - 1);
+    return 0;
+}
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+static
+int updateMaximum(void *maximum, int index)
+    // Assign the specified 'index' to the 'int' addressed by the specified
+    // 'maximum' if 'index' is greater.  Return 0.
+{
+    int *max = static_cast<int *>(maximum);
+    if (*max < index) {
+        *max = index;
+    }
+    return 0;
+}
+
+static
+int addToCpuSet(void *cpuSet, int index)
+    // Add the specified 'index' to the 'cpu_set_t' addressed by the specified
+    // 'cpuSet'.  Return 0 on success, and a non-zero value if 'index' is not
+    // representable in a 'cpu_set_t'.
+{
+    if (CPU_SETSIZE <= index) {
+        return -1;                                                    // RETURN
+    }
+    CPU_SET(index, static_cast<cpu_set_t *>(cpuSet));
+    return 0;
+}
+
+static
+int loadCpuSet(cpu_set_t *result, const bslmt::ThreadAttributes& attributes)
+    // Load into the specified 'result' the set of CPUs on which a thread
+    // created with the specified 'attributes' may run, i.e., the CPUs of the
+    // 'cpuAffinity' attribute of 'attributes' that belong to its 'numaNode'
+    // attribute, if either is set.  Return 0 on success, and a non-zero value
+    // if 'numaNode' is not a NUMA node of this platform or the resulting set
+    // is empty.  The behavior is undefined unless 'cpuAffinity' is not empty
+    // or 'numaNode' is set.
+{
+    CPU_ZERO(result);
+
+    const bsl::vector<int>& cpus = attributes.cpuAffinity();
+    for (bsl::size_t i = 0; i < cpus.size(); ++i) {
+        if (0 != addToCpuSet(result, cpus[i])) {
+            return -1;                                                // RETURN
+        }
+    }
+
+    const int numaNode = attributes.numaNode();
+    if (bslmt::ThreadAttributes::e_UNSET_NUMA_NODE != numaNode) {
+        char      buffer[k_CPU_LIST_BUF_SIZE];
+        cpu_set_t nodeCpuSet;
+
+        CPU_ZERO(&nodeCpuSet);
+        if (0 != loadNumaNodeCpuList(buffer, numaNode)
+         || 0 != parseCpuList(buffer, &addToCpuSet, &nodeCpuSet)) {
+            return -1;                                                // RETURN
+        }
+
+        if (cpus.empty()) {
+            *result = nodeCpuSet;
+        }
+        else {
+            CPU_AND(result, result, &nodeCpuSet);
+        }
+    }
+
+    return 0 == CPU_COUNT(result) ? -1 : 0;
+}
+#endif
+
 static int initPthreadAttribute(pthread_attr_t                 *destination,
                                 const bslmt::ThreadAttributes&  src)
     // Initialize the specified pthreads attribute type 'destination',
@@ -193,6 +393,20 @@ static int initPthreadAttribute(pthread_attr_t                 *destination,
         rc |= pthread_attr_setstacksize(destination, stackSize);
     }
 
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    if (Attr::e_UNSET_NUMA_NODE != src.numaNode()
+     || !src.cpuAffinity().empty()) {
+        // Note that memory is not explicitly bound to 'numaNode' (e.g., using
+        // 'mbind'): Linux allocates the pages first touched by a thread on
+        // the node of the CPU running it, so that pinning the thread suffices
+        // to keep the memory it allocates local.
+
+        cpu_set_t cpuSet;
+        rc |= u::loadCpuSet(&cpuSet, src);
+        rc |= pthread_attr_setaffinity_np(destination, sizeof cpuSet, &cpuSet);
+    }
+#endif
+
     return rc;
 }
 
@@ -643,6 +857,44 @@ bslmt::ThreadUtilImpl<bslmt::Platform::PosixThreads>::hardwareConcurrency()
     return 0 > result ? 0 : static_cast<unsigned int>(result);
 }
 
+int bslmt::ThreadUtilImpl<bslmt::Platform::PosixThreads>::numNumaNodes()
+{
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    char buffer[u::k_CPU_LIST_BUF_SIZE];
+    int  maxNode = -1;
+    if (0 == u::readSysFile(buffer,
+                            u::k_CPU_LIST_BUF_SIZE,
+                            u::k_NODES_ONLINE_PATH)
+     && 0 == u::parseCpuList(buffer, &u::updateMaximum, &maxNode)
+     && 0 <= maxNode) {
+        return maxNode + 1;                                           // RETURN
+    }
+#endif
+
+    return 1;
+}
+
+int bslmt::ThreadUtilImpl<bslmt::Platform::PosixThreads>::numaNodeCpus(
+                                                    bsl::vector<int> *result,
+                                                    int               numaNode)
+{
+    BSLS_ASSERT(result);
+    BSLS_ASSERT(0 <= numaNode);
+
+    char buffer[u::k_CPU_LIST_BUF_SIZE];
+    if (0 != u::loadNumaNodeCpuList(buffer, numaNode)) {
+        return -1;                                                    // RETURN
+    }
+
+    bsl::vector<int> cpus(result->get_allocator());
+    if (0 != u::parseCpuList(buffer, &u::appendToVector, &cpus)) {
+        return -1;                                                    // RETURN
+    }
+
+    result->swap(cpus);
+    return 0;
+}
+
 }  // close enterprise namespace
 
 #endif
@@ -64,6 +64,7 @@ BSLS_IDENT("$Id: $")
 #include <bsls_types.h>
 
 #include <bsl_string.h>
+#include <bsl_vector.h>
 
 #include <pthread.h>
 
@@ -347,6 +348,17 @@ struct ThreadUtilImpl<Platform::PosixThreads> {
     static unsigned int hardwareConcurrency();
         // Return the number of concurrent threads supported by the
         // implementation on success, and 0 otherwise.
+
+    static int numNumaNodes();
+        // Return the number of NUMA nodes of this platform, which is 1 if the
+        // platform does not report its NUMA topology.
+
+    static int numaNodeCpus(bsl::vector<int> *result, int numaNode);
+        // Load into the specified 'result' the indices, in increasing order,
+        // of the CPUs belonging to the specified 'numaNode'.  Return 0 on
+        // success, and a non-zero value (with no effect on 'result') if
+        // 'numaNode' is not a NUMA node of this platform.  The behavior is
+        // undefined unless '0 <= numaNode'.
 };
 
 }  // close package namespace
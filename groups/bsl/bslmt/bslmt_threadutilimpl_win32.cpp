@@ -793,6 +793,31 @@ bslmt::ThreadUtilImpl<bslmt::Platform::Win32Threads>::hardwareConcurrency()
     return sysinfo.dwNumberOfProcessors;
 }
 
+int bslmt::ThreadUtilImpl<bslmt::Platform::Win32Threads>::numNumaNodes()
+{
+    return 1;
+}
+
+int bslmt::ThreadUtilImpl<bslmt::Platform::Win32Threads>::numaNodeCpus(
+                                                    bsl::vector<int> *result,
+                                                    int               numaNode)
+{
+    BSLS_ASSERT(result);
+    BSLS_ASSERT(0 <= numaNode);
+
+    if (0 != numaNode) {
+        return -1;                                                    // RETURN
+    }
+
+    unsigned int numCpus = hardwareConcurrency();
+
+    result->clear();
+    for (unsigned int i = 0; i < (0 == numCpus ? 1 : numCpus); ++i) {
+        result->push_back(static_cast<int>(i));
+    }
+    return 0;
+}
+
 }  // close enterprise namespace
 
 #endif  // BSLMT_PLATFORM_WIN32_THREADS
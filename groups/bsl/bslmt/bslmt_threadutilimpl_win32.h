@@ -65,6 +65,7 @@ BSLS_IDENT("$Id: $")
 #include <bsls_types.h>
 
 #include <bsl_string.h>
+#include <bsl_vector.h>
 
 typedef unsigned long DWORD;
 typedef int BOOL;
@@ -351,6 +352,17 @@ struct ThreadUtilImpl<Platform::Win32Threads> {
     static unsigned int hardwareConcurrency();
         // Return the number of concurrent threads supported by the
         // implementation on success, and 0 otherwise.
+
+    static int numNumaNodes();
+        // Return the number of NUMA nodes of this platform, which is 1 if the
+        // platform does not report its NUMA topology.
+
+    static int numaNodeCpus(bsl::vector<int> *result, int numaNode);
+        // Load into the specified 'result' the indices, in increasing order,
+        // of the CPUs belonging to the specified 'numaNode'.  Return 0 on
+        // success, and a non-zero value (with no effect on 'result') if
+        // 'numaNode' is not a NUMA node of this platform.  The behavior is
+        // undefined unless '0 <= numaNode'.
 };
 
 // FREE OPERATORS
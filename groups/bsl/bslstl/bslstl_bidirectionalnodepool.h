@@ -238,6 +238,16 @@ class BidirectionalNodePool {
         // Alias for the 'size_type' of the allocator defined by 'SimplePool'.
 
   public:
+    // CLASS METHODS
+    static void deleteDetachedNode(bslalg::BidirectionalLink *linkNode,
+                                   const AllocatorType&       allocator);
+        // Destroy the 'VALUE' attribute of the specified 'linkNode' and return
+        // the memory footprint of 'linkNode' directly to the specified
+        // 'allocator'.  The behavior is undefined unless 'linkNode' was
+        // obtained from 'moveIntoDetachedNode' on a pool whose allocator
+        // compares equal to 'allocator'.  Note that the pool that created
+        // 'linkNode' need not exist any longer.
+
     // CREATORS
     explicit BidirectionalNodePool(const ALLOCATOR& allocator);
         // Create a 'BidirectionalNodePool' object that will use the specified
@@ -454,6 +464,18 @@ class BidirectionalNodePool {
         // be uninitialized.  Also note that the 'value' attribute of
         // 'original' is left in a valid but unspecified state.
 
+    bslalg::BidirectionalLink *moveIntoDetachedNode(
+                                          bslalg::BidirectionalLink *original);
+        // Allocate a node of the type 'BidirectionalNode<VALUE>' individually
+        // from the allocator of this pool, rather than from its free list, and
+        // move-construct an object of the (template parameter) type 'VALUE'
+        // with the (explicitly moved) value indicated by the 'value' attribute
+        // of the specified 'original' link.  Return the address of the node,
+        // which must be destroyed with 'deleteDetachedNode', and may outlive
+        // this pool.  Note that the 'next' and 'prev' attributes of the
+        // returned node will be uninitialized.  Also note that the 'value'
+        // attribute of 'original' is left in a valid but unspecified state.
+
     void release();
         // Relinquish all memory currently allocated with the memory pool
         // maintained by this object.
@@ -515,6 +537,21 @@ struct IsBitwiseMoveable<bslstl::BidirectionalNodePool<VALUE, ALLOCATOR> >
 
 namespace bslstl {
 
+// CLASS METHODS
+template <class VALUE, class ALLOCATOR>
+void BidirectionalNodePool<VALUE, ALLOCATOR>::deleteDetachedNode(
+                                  bslalg::BidirectionalLink *linkNode,
+                                  const AllocatorType&       allocator)
+{
+    BSLS_ASSERT(linkNode);
+
+    bslalg::BidirectionalNode<VALUE> *node =
+                     static_cast<bslalg::BidirectionalNode<VALUE> *>(linkNode);
+    AllocatorType alloc(allocator);
+    AllocatorTraits::destroy(alloc, bsls::Util::addressOf(node->value()));
+    Pool::deallocateDetachedBlock(allocator, node);
+}
+
 // CREATORS
 template <class VALUE, class ALLOCATOR>
 inline
@@ -935,6 +972,23 @@ BidirectionalNodePool<VALUE, ALLOCATOR>::moveIntoNewNode(
         static_cast<bslalg::BidirectionalNode<VALUE> *>(original)->value()));
 }
 
+template <class VALUE, class ALLOCATOR>
+bslalg::BidirectionalLink *
+BidirectionalNodePool<VALUE, ALLOCATOR>::moveIntoDetachedNode(
+                                           bslalg::BidirectionalLink *original)
+{
+    bslalg::BidirectionalNode<VALUE> *node = d_pool.allocateDetachedBlock();
+    typename Pool::DetachedBlockProctor proctor(node, allocator());
+
+    AllocatorTraits::construct(
+        allocator(),
+        bsls::Util::addressOf(node->value()),
+        MoveUtil::move(
+          static_cast<bslalg::BidirectionalNode<VALUE> *>(original)->value()));
+    proctor.release();
+    return node;
+}
+
 template <class VALUE, class ALLOCATOR>
 void BidirectionalNodePool<VALUE, ALLOCATOR>::deleteNode(
                                            bslalg::BidirectionalLink *linkNode)
@@ -75,6 +75,9 @@ using namespace bslstl;
 //: o No memory is ever allocated from the global allocator.
 //: o Precondition violations are detected in appropriate build modes.
 //-----------------------------------------------------------------------------
+// CLASS METHODS
+// [17] static void deleteDetachedNode(BidirectionalLink *, const Alloc&);
+//
 // CREATORS
 // [ 2] explicit BidirectionalNodePool(const ALLOCATOR& allocator);
 //*[13] BidirectionalNodePool(bslmf::MovableRef<BidirectionalNodePool> orig);
@@ -89,6 +92,7 @@ using namespace bslstl;
 // [ 9] bslalg::BidirectionalLink *cloneNode(const BidirectionalLink&);
 //*[15] template <class... Args> Link *emplaceNode(Args&&... arguments);
 //*[14] bslalg::BidirectionalLink *moveNode(BidirectionalLink *);
+// [17] bslalg::BidirectionalLink *moveIntoDetachedNode(BidirectionalLink *);
 // [ 5] void deleteNode(bslalg::BidirectionalLink *node);
 // [  ] void release();
 // [ 6] void reserveNodes(std::size_t numNodes);
@@ -103,6 +107,7 @@ using namespace bslstl;
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [16] USAGE EXAMPLE
+// [17] DETACHED NODES
 // [ *] CONCERN: No memory is ever allocated from the global allocator.
 //-----------------------------------------------------------------------------
 
@@ -490,6 +495,9 @@ class TestDriver {
 
   public:
     // TEST CASES
+    static void testCase17();
+        // Test detached nodes.
+
     static void testCase11();
         // Test type traits.
 
@@ -574,6 +582,83 @@ void TestDriver<VALUE>::createFreeBlocks(Obj   *result,
     }
 }
 
+template<class VALUE>
+void TestDriver<VALUE>::testCase17()
+{
+    // ------------------------------------------------------------------------
+    // DETACHED NODES
+    //
+    // Concerns:
+    //: 1 'moveIntoDetachedNode' creates a node holding the value of the
+    //:   original node, allocated individually from the allocator of the pool
+    //:   rather than from the free list.
+    //:
+    //: 2 A detached node remains valid after the pool that created it is
+    //:   destroyed, and 'deleteDetachedNode' destroys its value and returns
+    //:   its memory to the allocator.
+    //:
+    //: 3 No memory is allocated from the default allocator.
+    //
+    // Plan:
+    //: 1 Create a pooled node, move its value into a detached node, and
+    //:   verify the value of the detached node and the blocks allocated from
+    //:   the object allocator.  (C-1)
+    //:
+    //: 2 Destroy the pool, verify the value of the detached node, then delete
+    //:   it and verify that no memory remains in use.  (C-2..3)
+    //
+    // Testing:
+    //   bslalg::BidirectionalLink *moveIntoDetachedNode(BidirectionalLink *);
+    //   static void deleteDetachedNode(BidirectionalLink *, const Alloc&);
+    // ------------------------------------------------------------------------
+
+    if (verbose) printf("\nDETACHED NODES"
+                        "\n==============\n");
+
+    typedef bsltf::TemplateTestFacility TstFacility;
+
+    const int TYPE_ALLOC = bslma::UsesBslmaAllocator<VALUE>::value;
+
+    bslma::TestAllocator da("default", veryVeryVeryVerbose);
+    bslma::TestAllocator oa("object",  veryVeryVeryVerbose);
+
+    bslma::DefaultAllocatorGuard dag(&da);
+
+    ValueNode *detached;
+    {
+        Obj mX(&oa);
+
+        Link *pooled = mX.emplaceIntoNewNode(7);
+
+        bslma::TestAllocatorMonitor oam(&oa);
+
+        detached = static_cast<ValueNode *>(mX.moveIntoDetachedNode(pooled));
+        ASSERT(detached);
+        ASSERT(pooled != detached);
+        ASSERT(7 == TstFacility::getIdentifier(detached->value()));
+        ASSERTV(oam.numBlocksInUseChange(),
+                1 + TYPE_ALLOC == oam.numBlocksInUseChange());
+
+        mX.deleteNode(pooled);
+
+        // The freed pooled node is reused without any allocation.
+
+        oam.reset();
+        Link *reused = mX.emplaceIntoNewNode(8);
+        ASSERT(pooled == reused);
+        ASSERTV(oam.numBlocksInUseChange(),
+                TYPE_ALLOC == oam.numBlocksInUseChange());
+
+        mX.deleteNode(reused);
+    }
+    ASSERTV(oa.numBlocksInUse(), 1 + TYPE_ALLOC == oa.numBlocksInUse());
+    ASSERT(7 == TstFacility::getIdentifier(detached->value()));
+
+    Obj::deleteDetachedNode(detached, typename Obj::AllocatorType(&oa));
+    ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+    ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+}
+
 template<class VALUE>
 void TestDriver<VALUE>::testCase11()
 {
@@ -2058,6 +2143,12 @@ int main(int argc, char *argv[])
     bslma::TestAllocatorMonitor gam(&ga);
 
     switch (test) { case 0:
+      case 17: {
+        // --------------------------------------------------------------------
+        // DETACHED NODES
+        // --------------------------------------------------------------------
+        TestDriver<bsltf::AllocTestType>::testCase17();
+      } break;
       case 16: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
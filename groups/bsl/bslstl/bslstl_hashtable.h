@@ -1897,6 +1897,15 @@ class HashTable {
     HashTable_ImplParameters<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>
                                                                 ImplParameters;
 
+  public:
+    // TYPES
+    typedef typename ImplParameters::NodeFactory                NodeFactory;
+        // This 'typedef' is an alias for the type of the factory used by this
+        // hash-table to create and destroy nodes.
+
+  private:
+    // PRIVATE TYPES
+
     typedef bslmf::MovableRefUtil                               MoveUtil;
         // This typedef is a convenient alias for the utility associated with
         // movable references.
@@ -2802,6 +2811,13 @@ class HashTable {
         // allocated in order to preserve the bucket allocation strategy of the
         // hash table (but never fewer).
 
+    NodeFactory& nodeFactory();
+        // Return a reference providing modifiable access to the factory used
+        // by this hash-table to create and destroy nodes.  Note that this
+        // method is intended for the implementation of node handles by the
+        // containers of this library, and that the factory of a hash-table is
+        // exchanged by 'swap'.
+
     bslalg::BidirectionalLink *remove(bslalg::BidirectionalLink *node);
         // Remove the specified 'node' from this hash-table, and return the
         // address of the node immediately after 'node' in this hash-table
@@ -2896,6 +2912,20 @@ class HashTable {
         // first such element (from the contiguous sequence of elements having
         // the same key).
 
+    template <class LOOKUP_KEY>
+    bslalg::BidirectionalLink *find(const LOOKUP_KEY& key) const;
+        // Return the address of a link whose key has the same value as the
+        // specified 'key' (according to this hash-table's 'comparator'), and a
+        // null pointer value if no such link exists.  If this hash-table
+        // contains more than one element having the supplied 'key', return the
+        // first such element (from the contiguous sequence of elements having
+        // the same key).  The behavior is undefined unless this hash-table's
+        // 'hasher' and 'comparator' can be invoked with an object of the
+        // (template parameter) type 'LOOKUP_KEY', and the hasher returns the
+        // same hash code for 'key' as it does for the keys of this hash-table
+        // that compare equal to 'key'.  Note that this overload allows
+        // heterogeneous lookup without creating an object of 'KeyType'.
+
     bslalg::BidirectionalLink *findEndOfRange(
                                        bslalg::BidirectionalLink *first) const;
         // Return the address of the first node after any nodes holding a value
@@ -2920,6 +2950,21 @@ class HashTable {
         // the element following the range).  Also note that this hash-table
         // ensures all elements having the same key form a contiguous sequence.
 
+    template <class LOOKUP_KEY>
+    void findRange(bslalg::BidirectionalLink **first,
+                   bslalg::BidirectionalLink **last,
+                   const LOOKUP_KEY&           key) const;
+        // Load into the specified 'first' and 'last' pointers the respective
+        // addresses of the first and last link (in the list of elements owned
+        // by this hash table) where the contained elements have a key that
+        // compares equal to the specified 'key' using the 'comparator' of this
+        // hash-table, and null pointers values if there are no elements
+        // matching 'key'.  The behavior is undefined unless this hash-table's
+        // 'hasher' and 'comparator' can be invoked with an object of the
+        // (template parameter) type 'LOOKUP_KEY', and the hasher returns the
+        // same hash code for 'key' as it does for the keys of this hash-table
+        // that compare equal to 'key'.
+
     bool hasSameValue(const HashTable& other) const;
         // Return 'true' if the specified 'other' has the same value as this
         // object, and 'false' otherwise.  Two 'HashTable' objects have the
@@ -6803,6 +6848,14 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::rehashForNumBuckets(
     }
 }
 
+template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
+inline
+typename HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::NodeFactory&
+HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::nodeFactory()
+{
+    return d_parameters.nodeFactory();
+}
+
 template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
 bslalg::BidirectionalLink *
 HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::remove(
@@ -6989,6 +7042,34 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::find(
                                              d_parameters.hashCodeForKey(key));
 }
 
+template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
+template <class LOOKUP_KEY>
+bslalg::BidirectionalLink *
+HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::find(
+                                                   const LOOKUP_KEY& key) const
+{
+    typedef bslalg::HashTableImpUtil ImpUtil;
+
+    // 'ImpUtil::find' accepts only a 'KeyType', so we search the bucket
+    // directly rather than creating a temporary key.
+
+    const bslalg::HashTableBucket *bucket = d_anchor.bucketArrayAddress()
+                                          + ImpUtil::computeBucketIndex(
+                                              d_parameters.hashCodeForKey(key),
+                                              d_anchor.bucketArraySize());
+
+    for (bslalg::BidirectionalLink *cursor     = bucket->first(),
+                                   * const end = bucket->end();
+                             end != cursor; cursor = cursor->nextLink()) {
+        if (d_parameters.comparator()(
+                                    key,
+                                    ImpUtil::extractKey<KEY_CONFIG>(cursor))) {
+            return cursor;                                            // RETURN
+        }
+    }
+    return 0;
+}
+
 template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
 bslalg::BidirectionalLink *
 HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::findEndOfRange(
@@ -7032,6 +7113,24 @@ HashTable< KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::findRange(
            : 0;
 }
 
+template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
+template <class LOOKUP_KEY>
+inline
+void
+HashTable< KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::findRange(
+                                         bslalg::BidirectionalLink **first,
+                                         bslalg::BidirectionalLink **last,
+                                         const LOOKUP_KEY&           key) const
+{
+    BSLS_ASSERT_SAFE(first);
+    BSLS_ASSERT_SAFE(last);
+
+    *first = this->find(key);
+    *last  = *first
+           ? this->findEndOfRange(*first)
+           : 0;
+}
+
 template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
 bool
 HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::hasSameValue(
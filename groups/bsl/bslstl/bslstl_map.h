@@ -143,6 +143,33 @@ BSLS_IDENT("$Id: $")
 // (template parameter) type 'KEY' and 'VALUE', if respectively, the types
 // define the 'bslma::UsesBslmaAllocator' trait.
 //
+///Node Handles
+///------------
+// On platforms supporting rvalue references, an element can be removed from a
+// map, without being destroyed, by the 'extract' method, which returns a
+// *node* *handle* (of type 'map::node_type') owning the node holding the
+// element.  The key and the mapped value of the element can be modified
+// through the node handle, and the node handle can be inserted back into a map
+// by the 'insert' methods taking a 'node_type' argument.
+//
+// Each map obtains its nodes from a pool that it owns, and that releases its
+// memory only when the map is destroyed.  So that a node handle may outlive
+// the map from which it was extracted (or survive that map being swapped or
+// moved from), 'extract' moves the element into a node allocated individually
+// from the allocator of the map, and returns the original node to the pool
+// (see 'bslstl_nodehandle' for details).  Inserting a node handle into a map
+// (and transferring elements by 'merge') moves the element into a node
+// supplied by the pool of the destination map.  Since the pools recycle
+// released nodes, re-keying an element by extracting it and inserting it back
+// allocates a single node, and no memory is allocated for the elements
+// themselves if the allocators of the maps compare equal.
+//
+// The 'try_emplace' and 'insert_or_assign' methods insert an element having a
+// given key if no element having an equivalent key exists, and otherwise,
+// respectively, leave the existing element (and their arguments) unchanged or
+// assign to its mapped value.  Neither method creates a temporary
+// 'value_type' object.
+//
 ///Operations
 ///----------
 // This section describes the run-time complexity of operations on instances
@@ -164,6 +191,7 @@ BSLS_IDENT("$Id: $")
 //  'vt'            - object of type 'value_type'
 //  'rvt'           - modifiable rvalue of type 'value_type'
 //  'p1', 'p2'      - two 'const_iterator's belonging to 'a'
+//  'nh'            - modifiable rvalue of type 'map<K, V>::node_type'
 //  distance(i1,i2) - number of elements in the range '[i1 .. i2)'
 //
 //  +----------------------------------------------------+--------------------+
@@ -223,14 +251,17 @@ BSLS_IDENT("$Id: $")
 //  +----------------------------------------------------+--------------------+
 //  | a.insert(vt)                                       | O[log(n)]          |
 //  | a.insert(rvt)                                      |                    |
+//  | a.insert(nh)                                       |                    |
 //  | a.emplace(Args&&...)                               |                    |
+//  | a.try_emplace(k, Args&&...)                        |                    |
+//  | a.insert_or_assign(k, v)                           |                    |
 //  +----------------------------------------------------+--------------------+
 //  | a.insert(p1, vt)                                   | amortized constant |
 //  | a.insert(p1, rvt)                                  | if the value is    |
-//  | a.emplace(p1, Args&&...)                           | inserted right     |
-//  |                                                    | before p1,         |
-//  |                                                    | O[log(n)]          |
-//  |                                                    | otherwise          |
+//  | a.insert(p1, nh)                                   | inserted right     |
+//  | a.emplace(p1, Args&&...)                           | before p1,         |
+//  | a.try_emplace(p1, k, Args&&...)                    | O[log(n)]          |
+//  | a.insert_or_assign(p1, k, v)                       | otherwise          |
 //  +----------------------------------------------------+--------------------+
 //  | a.insert(i1, i2)                                   | O[log(N) *         |
 //  |                                                    |   distance(i1,i2)] |
@@ -249,6 +280,12 @@ BSLS_IDENT("$Id: $")
 //  | a.erase(p1, p2)                                    | O[log(n) +         |
 //  |                                                    | distance(p1, p2)]  |
 //  +----------------------------------------------------+--------------------+
+//  | a.extract(p1)                                      | amortized constant |
+//  +----------------------------------------------------+--------------------+
+//  | a.extract(k)                                       | O[log(n)]          |
+//  +----------------------------------------------------+--------------------+
+//  | a.merge(b)                                         | O[m * log(n + m)]  |
+//  +----------------------------------------------------+--------------------+
 //  | a.clear()                                          | O[n]               |
 //  +----------------------------------------------------+--------------------+
 //  | a.key_comp()                                       | O[1]               |
@@ -472,6 +509,7 @@ BSL_OVERRIDES_STD mode"
 #include <bslstl_iterator.h>
 #include <bslstl_iteratorutil.h>
 #include <bslstl_mapcomparator.h>
+#include <bslstl_nodehandle.h>
 #include <bslstl_pair.h>
 #include <bslstl_stdexceptutil.h>
 #include <bslstl_treeiterator.h>
@@ -499,6 +537,7 @@ BSL_OVERRIDES_STD mode"
 #include <bsls_assert.h>
 #include <bsls_compilerfeatures.h>
 #include <bsls_keyword.h>
+#include <bsls_libraryfeatures.h>
 #include <bsls_nativestd.h>
 #include <bsls_objectbuffer.h>
 #include <bsls_performancehint.h>
@@ -506,6 +545,10 @@ BSL_OVERRIDES_STD mode"
 
 #include <functional>
 
+#if defined(BSLS_LIBRARYFEATURES_HAS_CPP11_PAIR_PIECEWISE_CONSTRUCTOR)
+#include <tuple>  // 'std::forward_as_tuple'
+#endif
+
 #if defined(BSLS_COMPILERFEATURES_SUPPORT_GENERALIZED_INITIALIZERS)
 # include <initializer_list>
 #endif
@@ -635,6 +678,16 @@ class map {
     typedef bsl::reverse_iterator<iterator>            reverse_iterator;
     typedef bsl::reverse_iterator<const_iterator>      const_reverse_iterator;
 
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+    typedef BloombergLP::bslstl::MapNodeHandle<KEY,
+                                               VALUE,
+                                               Node,
+                                               NodeFactory,
+                                               ALLOCATOR>  node_type;
+    typedef BloombergLP::bslstl::NodeHandleInsertResult<iterator, node_type>
+                                                       insert_return_type;
+#endif
+
     class value_compare {
         // This nested class defines a mechanism for comparing two objects of
         // 'value_type' by adapting an object of (template parameter) type
@@ -730,6 +783,15 @@ class map {
         // behavior is undefined unless this object was created with the same
         // allocator as 'other'.
 
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+    BloombergLP::bslalg::RbTreeNode *takeNode(node_type *node);
+        // Return the address of a node, supplied by the node factory of this
+        // map, into which the element owned by the specified 'node' handle is
+        // moved, and leave 'node' empty, deallocating the node it owned.  If
+        // an exception is thrown, 'node' is unchanged.  The behavior is
+        // undefined if 'node' is empty.
+#endif
+
     // PRIVATE ACCESSORS
     const NodeFactory& nodeFactory() const;
         // Return a reference providing non-modifiable access to the node
@@ -1144,6 +1206,80 @@ class map {
         // 'VALUE'}).
 #endif
 
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+    insert_return_type insert(BloombergLP::bslmf::MovableRef<node_type> node);
+        // Insert into this map the element owned by the specified 'node'
+        // handle if 'node' is not empty and a key equivalent to that of the
+        // element does not already exist in this map.  Return an object whose
+        // 'position' member refers to the inserted element, or to the element
+        // whose key is equivalent to that of the element owned by 'node', or
+        // is 'end()' if 'node' is empty; whose 'inserted' member is 'true' if
+        // the element was inserted, and 'false' otherwise; and whose 'node'
+        // member owns the element if it was not inserted, and is empty
+        // otherwise.  The element is moved into a node supplied by this map,
+        // and the node owned by 'node' is deallocated (see {Node Handles}).
+        // 'node' is left empty unless the returned 'node' member is not
+        // empty.
+
+    iterator insert(const_iterator                            hint,
+                    BloombergLP::bslmf::MovableRef<node_type> node);
+        // Insert into this map the element owned by the specified 'node'
+        // handle (in amortized constant time if the specified 'hint' is a
+        // valid immediate successor to the key of that element) if 'node' is
+        // not empty and a key equivalent to that of the element does not
+        // already exist in this map.  Return an iterator referring to the
+        // inserted element, or to the element whose key is equivalent to that
+        // of the element owned by 'node', or 'end()' if 'node' is empty.
+        // 'node' is left empty if the element is inserted, and is unchanged
+        // otherwise.  Memory is allocated only as described by the 'insert'
+        // method (above) taking only a 'node' handle.  The behavior is
+        // undefined unless 'hint' is an iterator in the range
+        // '[begin() .. end()]' (both endpoints included).
+#endif
+
+    template <class MAPPED>
+    pair<iterator, bool> insert_or_assign(
+                                const key_type&                         key,
+                                BSLS_COMPILERFEATURES_FORWARD_REF(MAPPED) obj);
+    template <class MAPPED>
+    pair<iterator, bool> insert_or_assign(
+                            BloombergLP::bslmf::MovableRef<key_type>     key,
+                            BSLS_COMPILERFEATURES_FORWARD_REF(MAPPED)    obj);
+        // If a key equivalent to the specified 'key' already exists in this
+        // map, assign the specified 'obj' (forwarded) to the mapped value of
+        // the element having that key; otherwise, insert into this map a
+        // newly-created 'value_type' object constructed from 'key' (copied or
+        // moved) and 'obj' (forwarded).  Return a pair whose 'first' member
+        // is an iterator referring to the (possibly newly inserted) element
+        // whose key is equivalent to 'key', and whose 'second' member is
+        // 'true' if a new element was inserted, and 'false' if the mapped
+        // value of an existing element was assigned.  This method requires
+        // that the (template parameter) type 'VALUE' be assignable from, and
+        // 'emplace-constructible' together with 'KEY' from, 'obj'.
+
+    template <class MAPPED>
+    iterator insert_or_assign(
+                            const_iterator                             hint,
+                            const key_type&                            key,
+                            BSLS_COMPILERFEATURES_FORWARD_REF(MAPPED)  obj);
+    template <class MAPPED>
+    iterator insert_or_assign(
+                            const_iterator                             hint,
+                            BloombergLP::bslmf::MovableRef<key_type>   key,
+                            BSLS_COMPILERFEATURES_FORWARD_REF(MAPPED)  obj);
+        // If a key equivalent to the specified 'key' already exists in this
+        // map, assign the specified 'obj' (forwarded) to the mapped value of
+        // the element having that key; otherwise, insert into this map (in
+        // amortized constant time if the specified 'hint' is a valid
+        // immediate successor to 'key') a newly-created 'value_type' object
+        // constructed from 'key' (copied or moved) and 'obj' (forwarded).
+        // Return an iterator referring to the (possibly newly inserted)
+        // element whose key is equivalent to 'key'.  This method requires
+        // that the (template parameter) type 'VALUE' be assignable from, and
+        // 'emplace-constructible' together with 'KEY' from, 'obj'.  The
+        // behavior is undefined unless 'hint' is an iterator in the range
+        // '[begin() .. end()]' (both endpoints included).
+
 #if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES
 
     template <class... Args>
@@ -1470,6 +1606,52 @@ class map {
 // }}} END GENERATED CODE
 #endif
 
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES                            \
+ && defined(BSLS_LIBRARYFEATURES_HAS_CPP11_PAIR_PIECEWISE_CONSTRUCTOR)        \
+ && defined(BSLS_LIBRARYFEATURES_HAS_CPP14_INTEGER_SEQUENCE)
+    template <class... Args>
+    pair<iterator, bool> try_emplace(const key_type& key, Args&&... args);
+    template <class... Args>
+    pair<iterator, bool> try_emplace(
+                                BloombergLP::bslmf::MovableRef<key_type> key,
+                                Args&&...                                args);
+        // If a key equivalent to the specified 'key' does not already exist
+        // in this map, insert into this map a newly-created 'value_type'
+        // object whose key is constructed from 'key' (copied or moved) and
+        // whose mapped value is constructed by forwarding the specified
+        // (variable number of) 'args' to the corresponding constructor of
+        // 'VALUE'; otherwise, this method has no effect, and, unlike
+        // 'emplace', neither 'key' nor 'args' are moved from and no
+        // temporary 'value_type' object is created.  Return a pair whose
+        // 'first' member is an iterator referring to the (possibly newly
+        // inserted) element whose key is equivalent to 'key', and whose
+        // 'second' member is 'true' if a new element was inserted, and
+        // 'false' otherwise.  This method requires that the (template
+        // parameter) type 'VALUE' be 'emplace-constructible' from 'args'.
+
+    template <class... Args>
+    iterator try_emplace(const_iterator  hint,
+                         const key_type& key,
+                         Args&&...       args);
+    template <class... Args>
+    iterator try_emplace(const_iterator                           hint,
+                         BloombergLP::bslmf::MovableRef<key_type> key,
+                         Args&&...                                args);
+        // If a key equivalent to the specified 'key' does not already exist
+        // in this map, insert into this map (in amortized constant time if
+        // the specified 'hint' is a valid immediate successor to 'key') a
+        // newly-created 'value_type' object whose key is constructed from
+        // 'key' (copied or moved) and whose mapped value is constructed by
+        // forwarding the specified (variable number of) 'args' to the
+        // corresponding constructor of 'VALUE'; otherwise, this method has no
+        // effect, and neither 'key' nor 'args' are moved from.  Return an
+        // iterator referring to the (possibly newly inserted) element whose
+        // key is equivalent to 'key'.  This method requires that the
+        // (template parameter) type 'VALUE' be 'emplace-constructible' from
+        // 'args'.  The behavior is undefined unless 'hint' is an iterator in
+        // the range '[begin() .. end()]' (both endpoints included).
+#endif
+
     iterator erase(const_iterator position);
     iterator erase(iterator position);
         // Remove from this map the 'value_type' object at the specified
@@ -1499,6 +1681,25 @@ class map {
         // 'end' iterator, and the 'first' position is at or before the 'last'
         // position in the ordered sequence provided by this container.
 
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+    node_type extract(const_iterator position);
+        // Remove from this map the element at the specified 'position', and
+        // return a node handle owning that element.  The element is moved
+        // into a single node allocated from the allocator of this map, and
+        // the node that held it is returned to the pool of this map (see
+        // {Node Handles}); iterators, pointers, and references to the removed
+        // element are invalidated.  If an exception is thrown, this map is
+        // unchanged.  The behavior is undefined unless 'position' refers to
+        // an element in this map.
+
+    node_type extract(const key_type& key);
+        // Remove from this map the element whose key is equivalent to the
+        // specified 'key', if such an element exists, and return a node
+        // handle owning that element; otherwise, return an empty node handle.
+        // Memory is allocated only as described by the 'extract' method
+        // (above) taking an iterator.
+#endif
+
     void swap(map& other) BSLS_KEYWORD_NOEXCEPT_SPECIFICATION(false);
         // Exchange the value and comparator of this object with the value and
         // comparator of the specified 'other' object.  Additionally, if
@@ -1511,6 +1712,23 @@ class map {
         // either this object was created with the same allocator as 'other' or
         // 'propagate_on_container_swap' is 'true'.
 
+    template <class COMPARATOR2>
+    void merge(map<KEY, VALUE, COMPARATOR2, ALLOCATOR>& source);
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+    template <class COMPARATOR2>
+    void merge(map<KEY, VALUE, COMPARATOR2, ALLOCATOR>&& source);
+#endif
+        // Move into this map each element of the specified 'source' map whose
+        // key is not equivalent to the key of an element of this map, and
+        // remove that element from 'source'.  The elements of 'source' whose
+        // keys are equivalent to those of elements of this map are left in
+        // 'source'.  Each element is moved into a node supplied by this map,
+        // and its original node is returned to 'source' (see {Node Handles}).
+        // If an exception is thrown, the elements already transferred remain
+        // in this map, and the element being transferred (if any) remains in
+        // 'source', in a valid but unspecified state.  This method has no
+        // effect if 'source' is this map.
+
     void clear() BSLS_KEYWORD_NOEXCEPT;
         // Remove all entries from this map.  Note that the map is empty after
         // this call, but allocated memory may be retained for future use.
@@ -1833,6 +2051,29 @@ class map {
         return count;
     }
 
+    bool contains(const key_type& key) const
+        // Return 'true' if this map contains a 'value_type' object whose key
+        // is equivalent to the specified 'key', and 'false' otherwise.
+        //
+        // Note: implemented inline due to Sun CC compilation error.
+    {
+        return find(key) != end();
+    }
+
+    template <class LOOKUP_KEY>
+    typename bsl::enable_if<
+        BloombergLP::bslmf::IsTransparentPredicate<COMPARATOR,
+                                                   LOOKUP_KEY>::value,
+        bool>::type
+    contains(const LOOKUP_KEY& key) const
+        // Return 'true' if this map contains a 'value_type' object whose key
+        // is equivalent to the specified 'key', and 'false' otherwise.
+        //
+        // Note: implemented inline due to Sun CC compilation error.
+    {
+        return find(key) != end();
+    }
+
     const_iterator lower_bound(const key_type& key) const
         // Return an iterator providing non-modifiable access to the first
         // (i.e., ordered least) 'value_type' object in this map whose key is
@@ -2209,6 +2450,22 @@ void map<KEY, VALUE, COMPARATOR, ALLOCATOR>::quickSwapRetainAllocators(
     }
 }
 
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
+inline
+BloombergLP::bslalg::RbTreeNode *
+map<KEY, VALUE, COMPARATOR, ALLOCATOR>::takeNode(node_type *node)
+{
+    BSLS_ASSERT_SAFE(node);
+    BSLS_ASSERT_SAFE(!node->empty());
+
+    BloombergLP::bslalg::RbTreeNode *result =
+                                  nodeFactory().moveIntoNewNode(node->node());
+    *node = node_type();
+    return result;
+}
+#endif
+
 // PRIVATE ACCESSORS
 template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
 inline
@@ -2755,6 +3012,229 @@ void map<KEY, VALUE, COMPARATOR, ALLOCATOR>::insert(
 }
 #endif
 
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
+inline
+typename map<KEY, VALUE, COMPARATOR, ALLOCATOR>::insert_return_type
+map<KEY, VALUE, COMPARATOR, ALLOCATOR>::insert(
+                               BloombergLP::bslmf::MovableRef<node_type> node)
+{
+    node_type& lvalue = node;
+
+    if (lvalue.empty()) {
+        insert_return_type result = { end(), false, node_type() };
+        return result;                                                // RETURN
+    }
+
+    int comparisonResult;
+    BloombergLP::bslalg::RbTreeNode *insertLocation =
+        BloombergLP::bslalg::RbTreeUtil::findUniqueInsertLocation(
+                                                            &comparisonResult,
+                                                            &d_tree,
+                                                            this->comparator(),
+                                                            lvalue.key());
+    if (!comparisonResult) {
+        insert_return_type result = { iterator(insertLocation),
+                                      false,
+                                      MoveUtil::move(lvalue) };
+        return result;                                                // RETURN
+    }
+
+    BloombergLP::bslalg::RbTreeNode *newNode = takeNode(&lvalue);
+    BloombergLP::bslalg::RbTreeUtil::insertAt(&d_tree,
+                                              insertLocation,
+                                              comparisonResult < 0,
+                                              newNode);
+    insert_return_type result = { iterator(newNode), true, node_type() };
+    return result;
+}
+
+template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
+inline
+typename map<KEY, VALUE, COMPARATOR, ALLOCATOR>::iterator
+map<KEY, VALUE, COMPARATOR, ALLOCATOR>::insert(
+                               const_iterator                            hint,
+                               BloombergLP::bslmf::MovableRef<node_type> node)
+{
+    node_type& lvalue = node;
+
+    if (lvalue.empty()) {
+        return end();                                                 // RETURN
+    }
+
+    BloombergLP::bslalg::RbTreeNode *hintNode =
+                    const_cast<BloombergLP::bslalg::RbTreeNode *>(hint.node());
+    int comparisonResult;
+    BloombergLP::bslalg::RbTreeNode *insertLocation =
+        BloombergLP::bslalg::RbTreeUtil::findUniqueInsertLocation(
+                                                            &comparisonResult,
+                                                            &d_tree,
+                                                            this->comparator(),
+                                                            lvalue.key(),
+                                                            hintNode);
+    if (!comparisonResult) {
+        return iterator(insertLocation);                              // RETURN
+    }
+
+    BloombergLP::bslalg::RbTreeNode *newNode = takeNode(&lvalue);
+    BloombergLP::bslalg::RbTreeUtil::insertAt(&d_tree,
+                                              insertLocation,
+                                              comparisonResult < 0,
+                                              newNode);
+    return iterator(newNode);
+}
+#endif
+
+template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
+template <class MAPPED>
+inline
+pair<typename map<KEY, VALUE, COMPARATOR, ALLOCATOR>::iterator, bool>
+map<KEY, VALUE, COMPARATOR, ALLOCATOR>::insert_or_assign(
+                                const key_type&                           key,
+                                BSLS_COMPILERFEATURES_FORWARD_REF(MAPPED) obj)
+{
+    int comparisonResult;
+    BloombergLP::bslalg::RbTreeNode *insertLocation =
+        BloombergLP::bslalg::RbTreeUtil::findUniqueInsertLocation(
+                                                            &comparisonResult,
+                                                            &d_tree,
+                                                            this->comparator(),
+                                                            key);
+    if (!comparisonResult) {
+        toNode(insertLocation)->value().second =
+                                   BSLS_COMPILERFEATURES_FORWARD(MAPPED, obj);
+        return pair<iterator, bool>(iterator(insertLocation), false); // RETURN
+    }
+
+    BloombergLP::bslalg::RbTreeNode *node = nodeFactory().emplaceIntoNewNode(
+                                   key,
+                                   BSLS_COMPILERFEATURES_FORWARD(MAPPED, obj));
+    BloombergLP::bslalg::RbTreeUtil::insertAt(&d_tree,
+                                              insertLocation,
+                                              comparisonResult < 0,
+                                              node);
+    return pair<iterator, bool>(iterator(node), true);
+}
+
+template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
+template <class MAPPED>
+inline
+pair<typename map<KEY, VALUE, COMPARATOR, ALLOCATOR>::iterator, bool>
+map<KEY, VALUE, COMPARATOR, ALLOCATOR>::insert_or_assign(
+                               BloombergLP::bslmf::MovableRef<key_type>  key,
+                               BSLS_COMPILERFEATURES_FORWARD_REF(MAPPED) obj)
+{
+    key_type& lvalue = key;
+
+    int comparisonResult;
+    BloombergLP::bslalg::RbTreeNode *insertLocation =
+        BloombergLP::bslalg::RbTreeUtil::findUniqueInsertLocation(
+                                                            &comparisonResult,
+                                                            &d_tree,
+                                                            this->comparator(),
+                                                            lvalue);
+    if (!comparisonResult) {
+        toNode(insertLocation)->value().second =
+                                   BSLS_COMPILERFEATURES_FORWARD(MAPPED, obj);
+        return pair<iterator, bool>(iterator(insertLocation), false); // RETURN
+    }
+
+    // See 'operator[]' for the reason 'lvalue' is not moved in C++03.
+
+#if defined(BSLMF_MOVABLEREF_USES_RVALUE_REFERENCES)
+    BloombergLP::bslalg::RbTreeNode *node = nodeFactory().emplaceIntoNewNode(
+                                   MoveUtil::move(lvalue),
+                                   BSLS_COMPILERFEATURES_FORWARD(MAPPED, obj));
+#else
+    BloombergLP::bslalg::RbTreeNode *node = nodeFactory().emplaceIntoNewNode(
+                                   lvalue,
+                                   BSLS_COMPILERFEATURES_FORWARD(MAPPED, obj));
+#endif
+    BloombergLP::bslalg::RbTreeUtil::insertAt(&d_tree,
+                                              insertLocation,
+                                              comparisonResult < 0,
+                                              node);
+    return pair<iterator, bool>(iterator(node), true);
+}
+
+template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
+template <class MAPPED>
+inline
+typename map<KEY, VALUE, COMPARATOR, ALLOCATOR>::iterator
+map<KEY, VALUE, COMPARATOR, ALLOCATOR>::insert_or_assign(
+                                const_iterator                            hint,
+                                const key_type&                           key,
+                                BSLS_COMPILERFEATURES_FORWARD_REF(MAPPED) obj)
+{
+    BloombergLP::bslalg::RbTreeNode *hintNode =
+                    const_cast<BloombergLP::bslalg::RbTreeNode *>(hint.node());
+    int comparisonResult;
+    BloombergLP::bslalg::RbTreeNode *insertLocation =
+        BloombergLP::bslalg::RbTreeUtil::findUniqueInsertLocation(
+                                                            &comparisonResult,
+                                                            &d_tree,
+                                                            this->comparator(),
+                                                            key,
+                                                            hintNode);
+    if (!comparisonResult) {
+        toNode(insertLocation)->value().second =
+                                   BSLS_COMPILERFEATURES_FORWARD(MAPPED, obj);
+        return iterator(insertLocation);                              // RETURN
+    }
+
+    BloombergLP::bslalg::RbTreeNode *node = nodeFactory().emplaceIntoNewNode(
+                                   key,
+                                   BSLS_COMPILERFEATURES_FORWARD(MAPPED, obj));
+    BloombergLP::bslalg::RbTreeUtil::insertAt(&d_tree,
+                                              insertLocation,
+                                              comparisonResult < 0,
+                                              node);
+    return iterator(node);
+}
+
+template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
+template <class MAPPED>
+inline
+typename map<KEY, VALUE, COMPARATOR, ALLOCATOR>::iterator
+map<KEY, VALUE, COMPARATOR, ALLOCATOR>::insert_or_assign(
+                               const_iterator                            hint,
+                               BloombergLP::bslmf::MovableRef<key_type>  key,
+                               BSLS_COMPILERFEATURES_FORWARD_REF(MAPPED) obj)
+{
+    key_type& lvalue = key;
+
+    BloombergLP::bslalg::RbTreeNode *hintNode =
+                    const_cast<BloombergLP::bslalg::RbTreeNode *>(hint.node());
+    int comparisonResult;
+    BloombergLP::bslalg::RbTreeNode *insertLocation =
+        BloombergLP::bslalg::RbTreeUtil::findUniqueInsertLocation(
+                                                            &comparisonResult,
+                                                            &d_tree,
+                                                            this->comparator(),
+                                                            lvalue,
+                                                            hintNode);
+    if (!comparisonResult) {
+        toNode(insertLocation)->value().second =
+                                   BSLS_COMPILERFEATURES_FORWARD(MAPPED, obj);
+        return iterator(insertLocation);                              // RETURN
+    }
+
+#if defined(BSLMF_MOVABLEREF_USES_RVALUE_REFERENCES)
+    BloombergLP::bslalg::RbTreeNode *node = nodeFactory().emplaceIntoNewNode(
+                                   MoveUtil::move(lvalue),
+                                   BSLS_COMPILERFEATURES_FORWARD(MAPPED, obj));
+#else
+    BloombergLP::bslalg::RbTreeNode *node = nodeFactory().emplaceIntoNewNode(
+                                   lvalue,
+                                   BSLS_COMPILERFEATURES_FORWARD(MAPPED, obj));
+#endif
+    BloombergLP::bslalg::RbTreeUtil::insertAt(&d_tree,
+                                              insertLocation,
+                                              comparisonResult < 0,
+                                              node);
+    return iterator(node);
+}
+
 #if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES
 
 template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
@@ -3803,6 +4283,146 @@ map<KEY, VALUE, COMPARATOR, ALLOCATOR>::emplace_hint(const_iterator hint,
 // }}} END GENERATED CODE
 #endif
 
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES                            \
+ && defined(BSLS_LIBRARYFEATURES_HAS_CPP11_PAIR_PIECEWISE_CONSTRUCTOR)        \
+ && defined(BSLS_LIBRARYFEATURES_HAS_CPP14_INTEGER_SEQUENCE)
+template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
+template <class... Args>
+inline
+pair<typename map<KEY, VALUE, COMPARATOR, ALLOCATOR>::iterator, bool>
+map<KEY, VALUE, COMPARATOR, ALLOCATOR>::try_emplace(const key_type& key,
+                                                    Args&&...       args)
+{
+    int comparisonResult;
+    BloombergLP::bslalg::RbTreeNode *insertLocation =
+        BloombergLP::bslalg::RbTreeUtil::findUniqueInsertLocation(
+                                                            &comparisonResult,
+                                                            &d_tree,
+                                                            this->comparator(),
+                                                            key);
+    if (!comparisonResult) {
+        return pair<iterator, bool>(iterator(insertLocation), false); // RETURN
+    }
+
+    BloombergLP::bslalg::RbTreeNode *node = nodeFactory().emplaceIntoNewNode(
+                           native_std::piecewise_construct,
+                           native_std::forward_as_tuple(key),
+                           native_std::forward_as_tuple(
+                                BSLS_COMPILERFEATURES_FORWARD(Args, args)...));
+    BloombergLP::bslalg::RbTreeUtil::insertAt(&d_tree,
+                                              insertLocation,
+                                              comparisonResult < 0,
+                                              node);
+    return pair<iterator, bool>(iterator(node), true);
+}
+
+template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
+template <class... Args>
+inline
+pair<typename map<KEY, VALUE, COMPARATOR, ALLOCATOR>::iterator, bool>
+map<KEY, VALUE, COMPARATOR, ALLOCATOR>::try_emplace(
+                                 BloombergLP::bslmf::MovableRef<key_type> key,
+                                 Args&&...                                args)
+{
+    key_type& lvalue = key;
+
+    int comparisonResult;
+    BloombergLP::bslalg::RbTreeNode *insertLocation =
+        BloombergLP::bslalg::RbTreeUtil::findUniqueInsertLocation(
+                                                            &comparisonResult,
+                                                            &d_tree,
+                                                            this->comparator(),
+                                                            lvalue);
+    if (!comparisonResult) {
+        return pair<iterator, bool>(iterator(insertLocation), false); // RETURN
+    }
+
+    BloombergLP::bslalg::RbTreeNode *node = nodeFactory().emplaceIntoNewNode(
+                           native_std::piecewise_construct,
+                           native_std::forward_as_tuple(
+                                                      MoveUtil::move(lvalue)),
+                           native_std::forward_as_tuple(
+                                BSLS_COMPILERFEATURES_FORWARD(Args, args)...));
+    BloombergLP::bslalg::RbTreeUtil::insertAt(&d_tree,
+                                              insertLocation,
+                                              comparisonResult < 0,
+                                              node);
+    return pair<iterator, bool>(iterator(node), true);
+}
+
+template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
+template <class... Args>
+inline
+typename map<KEY, VALUE, COMPARATOR, ALLOCATOR>::iterator
+map<KEY, VALUE, COMPARATOR, ALLOCATOR>::try_emplace(const_iterator  hint,
+                                                    const key_type& key,
+                                                    Args&&...       args)
+{
+    BloombergLP::bslalg::RbTreeNode *hintNode =
+                    const_cast<BloombergLP::bslalg::RbTreeNode *>(hint.node());
+    int comparisonResult;
+    BloombergLP::bslalg::RbTreeNode *insertLocation =
+        BloombergLP::bslalg::RbTreeUtil::findUniqueInsertLocation(
+                                                            &comparisonResult,
+                                                            &d_tree,
+                                                            this->comparator(),
+                                                            key,
+                                                            hintNode);
+    if (!comparisonResult) {
+        return iterator(insertLocation);                              // RETURN
+    }
+
+    BloombergLP::bslalg::RbTreeNode *node = nodeFactory().emplaceIntoNewNode(
+                           native_std::piecewise_construct,
+                           native_std::forward_as_tuple(key),
+                           native_std::forward_as_tuple(
+                                BSLS_COMPILERFEATURES_FORWARD(Args, args)...));
+    BloombergLP::bslalg::RbTreeUtil::insertAt(&d_tree,
+                                              insertLocation,
+                                              comparisonResult < 0,
+                                              node);
+    return iterator(node);
+}
+
+template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
+template <class... Args>
+inline
+typename map<KEY, VALUE, COMPARATOR, ALLOCATOR>::iterator
+map<KEY, VALUE, COMPARATOR, ALLOCATOR>::try_emplace(
+                                 const_iterator                           hint,
+                                 BloombergLP::bslmf::MovableRef<key_type> key,
+                                 Args&&...                                args)
+{
+    key_type& lvalue = key;
+
+    BloombergLP::bslalg::RbTreeNode *hintNode =
+                    const_cast<BloombergLP::bslalg::RbTreeNode *>(hint.node());
+    int comparisonResult;
+    BloombergLP::bslalg::RbTreeNode *insertLocation =
+        BloombergLP::bslalg::RbTreeUtil::findUniqueInsertLocation(
+                                                            &comparisonResult,
+                                                            &d_tree,
+                                                            this->comparator(),
+                                                            lvalue,
+                                                            hintNode);
+    if (!comparisonResult) {
+        return iterator(insertLocation);                              // RETURN
+    }
+
+    BloombergLP::bslalg::RbTreeNode *node = nodeFactory().emplaceIntoNewNode(
+                           native_std::piecewise_construct,
+                           native_std::forward_as_tuple(
+                                                      MoveUtil::move(lvalue)),
+                           native_std::forward_as_tuple(
+                                BSLS_COMPILERFEATURES_FORWARD(Args, args)...));
+    BloombergLP::bslalg::RbTreeUtil::insertAt(&d_tree,
+                                              insertLocation,
+                                              comparisonResult < 0,
+                                              node);
+    return iterator(node);
+}
+#endif
+
 template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
 inline
 typename map<KEY, VALUE, COMPARATOR, ALLOCATOR>::iterator
@@ -3852,6 +4472,40 @@ map<KEY, VALUE, COMPARATOR, ALLOCATOR>::erase(const_iterator first,
     return iterator(last.node());
 }
 
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
+inline
+typename map<KEY, VALUE, COMPARATOR, ALLOCATOR>::node_type
+map<KEY, VALUE, COMPARATOR, ALLOCATOR>::extract(const_iterator position)
+{
+    BSLS_ASSERT_SAFE(position != end());
+
+    BloombergLP::bslalg::RbTreeNode *node =
+                const_cast<BloombergLP::bslalg::RbTreeNode *>(position.node());
+
+    // The element is moved into a node that does not belong to the pool of
+    // this map, so that the node handle may outlive this map.
+
+    BloombergLP::bslalg::RbTreeNode *detachedNode =
+                                     nodeFactory().moveIntoDetachedNode(node);
+    BloombergLP::bslalg::RbTreeUtil::remove(&d_tree, node);
+    nodeFactory().deleteNode(node);
+    return node_type(toNode(detachedNode), get_allocator());
+}
+
+template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
+inline
+typename map<KEY, VALUE, COMPARATOR, ALLOCATOR>::node_type
+map<KEY, VALUE, COMPARATOR, ALLOCATOR>::extract(const key_type& key)
+{
+    const_iterator it = find(key);
+    if (it == end()) {
+        return node_type();                                           // RETURN
+    }
+    return extract(it);
+}
+#endif
+
 template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
 inline
 void map<KEY, VALUE, COMPARATOR, ALLOCATOR>::swap(map& other)
@@ -3885,6 +4539,53 @@ void map<KEY, VALUE, COMPARATOR, ALLOCATOR>::swap(map& other)
     }
 }
 
+template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
+template <class COMPARATOR2>
+inline
+void map<KEY, VALUE, COMPARATOR, ALLOCATOR>::merge(
+                            map<KEY, VALUE, COMPARATOR2, ALLOCATOR>& source)
+{
+    typedef typename map<KEY, VALUE, COMPARATOR2, ALLOCATOR>::iterator
+                                                                SourceIterator;
+
+    if (static_cast<void *>(&source) == static_cast<void *>(this)) {
+        return;                                                       // RETURN
+    }
+
+    for (SourceIterator it = source.begin(); it != source.end(); ) {
+        int comparisonResult;
+        BloombergLP::bslalg::RbTreeNode *insertLocation =
+            BloombergLP::bslalg::RbTreeUtil::findUniqueInsertLocation(
+                                                            &comparisonResult,
+                                                            &d_tree,
+                                                            this->comparator(),
+                                                            it->first);
+        if (!comparisonResult) {
+            ++it;
+            continue;
+        }
+
+        BloombergLP::bslalg::RbTreeNode *node = nodeFactory().moveIntoNewNode(
+                    const_cast<BloombergLP::bslalg::RbTreeNode *>(it.node()));
+        BloombergLP::bslalg::RbTreeUtil::insertAt(&d_tree,
+                                                  insertLocation,
+                                                  comparisonResult < 0,
+                                                  node);
+        it = source.erase(it);
+    }
+}
+
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
+template <class COMPARATOR2>
+inline
+void map<KEY, VALUE, COMPARATOR, ALLOCATOR>::merge(
+                           map<KEY, VALUE, COMPARATOR2, ALLOCATOR>&& source)
+{
+    merge(source);
+}
+#endif
+
 template <class KEY, class VALUE, class COMPARATOR, class ALLOCATOR>
 inline
 void map<KEY, VALUE, COMPARATOR, ALLOCATOR>::clear() BSLS_KEYWORD_NOEXCEPT
@@ -196,6 +196,21 @@
 // [31] iterator emplace(Args&&... args);
 // [32] iterator emplace_hint(const_iterator position, Args&&... args);
 //
+// [41] node_type extract(const_iterator position);
+// [41] node_type extract(const key_type& key);
+// [41] insert_return_type insert(node_type&& node);
+// [41] iterator insert(const_iterator hint, node_type&& node);
+// [41] void merge(map<KEY, VALUE, C2, ALLOCATOR>& source);
+// [41] void merge(map<KEY, VALUE, C2, ALLOCATOR>&& source);
+// [41] pair<iterator, bool> insert_or_assign(const key_type&, M&&);
+// [41] pair<iterator, bool> insert_or_assign(key_type&&, M&&);
+// [41] iterator insert_or_assign(const_iterator, const key_type&, M&&);
+// [41] iterator insert_or_assign(const_iterator, key_type&&, M&&);
+// [41] pair<iterator, bool> try_emplace(const key_type&, Args&&...);
+// [41] pair<iterator, bool> try_emplace(key_type&&, Args&&...);
+// [41] iterator try_emplace(const_iterator, const key_type&, Args&&...);
+// [41] iterator try_emplace(const_iterator, key_type&&, Args&&...);
+//
 // [18] iterator erase(const_iterator position);
 // [18] iterator erase(iterator position);
 // [18] size_type erase(const key_type& key);
@@ -231,7 +246,7 @@
 //
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [40] USAGE EXAMPLE
+// [42] USAGE EXAMPLE
 //
 // TEST APPARATUS
 // [ 3] int ggg(map *object, const char *spec, bool verbose = true);
@@ -248,6 +263,7 @@
 // [38] CONCERN: 'erase' overload is deduced correctly.
 // [39] CONCERN: 'find'        properly handles transparent comparators.
 // [39] CONCERN: 'count'       properly handles transparent comparators.
+// [39] CONCERN: 'contains'    properly handles transparent comparators.
 // [39] CONCERN: 'lower_bound' properly handles transparent comparators.
 // [39] CONCERN: 'upper_bound' properly handles transparent comparators.
 // [39] CONCERN: 'equal_range' properly handles transparent comparators.
@@ -4762,7 +4778,7 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:
-      case 40: {
+      case 42: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -4808,6 +4824,8 @@ int main(int argc, char *argv[])
             ASSERT(0 <  objectAllocator.numBytesInUse());
         }
       } break;
+      case 41: // falls through
+      case 40: // falls through
       case 39: // falls through
       case 38: // falls through
       case 37: // falls through
@@ -196,6 +196,21 @@
 // [31] iterator emplace(Args&&... args);
 // [32] iterator emplace_hint(const_iterator position, Args&&... args);
 //
+// [41] node_type extract(const_iterator position);
+// [41] node_type extract(const key_type& key);
+// [41] insert_return_type insert(node_type&& node);
+// [41] iterator insert(const_iterator hint, node_type&& node);
+// [41] void merge(map<KEY, VALUE, C2, ALLOCATOR>& source);
+// [41] void merge(map<KEY, VALUE, C2, ALLOCATOR>&& source);
+// [41] pair<iterator, bool> insert_or_assign(const key_type&, M&&);
+// [41] pair<iterator, bool> insert_or_assign(key_type&&, M&&);
+// [41] iterator insert_or_assign(const_iterator, const key_type&, M&&);
+// [41] iterator insert_or_assign(const_iterator, key_type&&, M&&);
+// [41] pair<iterator, bool> try_emplace(const key_type&, Args&&...);
+// [41] pair<iterator, bool> try_emplace(key_type&&, Args&&...);
+// [41] iterator try_emplace(const_iterator, const key_type&, Args&&...);
+// [41] iterator try_emplace(const_iterator, key_type&&, Args&&...);
+//
 // [18] iterator erase(const_iterator position);
 // [18] iterator erase(iterator position);
 // [18] size_type erase(const key_type& key);
@@ -231,7 +246,7 @@
 //
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [40] USAGE EXAMPLE
+// [42] USAGE EXAMPLE
 //
 // TEST APPARATUS
 // [ 3] int ggg(map *object, const char *spec, bool verbose = true);
@@ -248,6 +263,7 @@
 // [38] CONCERN: 'erase' overload is deduced correctly.
 // [39] CONCERN: 'find'        properly handles transparent comparators.
 // [39] CONCERN: 'count'       properly handles transparent comparators.
+// [39] CONCERN: 'contains'    properly handles transparent comparators.
 // [39] CONCERN: 'lower_bound' properly handles transparent comparators.
 // [39] CONCERN: 'upper_bound' properly handles transparent comparators.
 // [39] CONCERN: 'equal_range' properly handles transparent comparators.
@@ -1029,6 +1045,17 @@ void testTransparentComparator(Container& container,
     ASSERT(0                       == NON_EXISTING_C);
     ASSERT(expectedConversionCount == nonExistingKey.conversionCount());
 
+    // Testing 'contains'.
+
+    ASSERT(true == container.contains(existingKey));
+    if (!isTransparent) {
+        ++expectedConversionCount;
+    }
+    ASSERT(expectedConversionCount == existingKey.conversionCount());
+
+    ASSERT(false == container.contains(nonExistingKey));
+    ASSERT(expectedConversionCount == nonExistingKey.conversionCount());
+
     // Testing 'lower_bound'.
 
     const Iterator EXISTING_LB = container.lower_bound(existingKey);
@@ -9454,7 +9481,390 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:
-         case 40: {
+      case 41: {
+        // --------------------------------------------------------------------
+        // TESTING NODE HANDLES, 'try_emplace', AND 'insert_or_assign'
+        //
+        // Concerns:
+        //: 1 'extract' removes the element from the map and returns a node
+        //:   handle owning it, by moving the element into a single node
+        //:   allocated individually, and returns the map's node to its pool;
+        //:   extracting a missing key returns an empty node handle.
+        //:
+        //: 2 Inserting a node handle into the map from which it was extracted
+        //:   moves the element (possibly after re-keying it) into the node
+        //:   previously returned to the pool, without allocating memory, and
+        //:   deallocates the node of the handle.
+        //:
+        //: 3 Inserting a node handle whose key is already present does not
+        //:   modify the map, and returns the node handle to the caller;
+        //:   inserting an empty node handle has no effect.
+        //:
+        //: 4 Inserting a node handle into another map, including a map having
+        //:   a different allocator, moves the element into a node of that
+        //:   map, and deallocates the node of the handle.
+        //:
+        //: 5 'merge' transfers exactly the elements whose keys are missing
+        //:   from the target, including from a map having a different
+        //:   comparator or allocator, and merging a map into itself has no
+        //:   effect.
+        //:
+        //: 6 'insert_or_assign' inserts a missing key, and otherwise assigns
+        //:   to the mapped value of the existing element.
+        //:
+        //: 7 'try_emplace' inserts a missing key, and otherwise neither
+        //:   modifies the map nor moves from its arguments.
+        //:
+        //: 8 No memory is allocated from the default allocator, and no memory
+        //:   is leaked.
+        //:
+        //: 9 A node handle remains usable, and can be inserted into another
+        //:   map or destroyed, after the map from which it was extracted has
+        //:   been destroyed, moved from, or swapped.
+        //
+        // Plan:
+        //: 1 Using a map from 'int' to a 'bsl::string' too long for the short
+        //:   string optimization, exercise each function and verify the
+        //:   contents of the maps, the address of the elements and of their
+        //:   string buffers, and the allocations made by the object
+        //:   allocator.  (C-1..8)
+        //:
+        //: 2 Extract node handles from maps that are then destroyed, moved
+        //:   from, or swapped, and verify that the node handles can be used,
+        //:   inserted into another map, and destroyed.  (C-9)
+        //
+        // Testing:
+        //   node_type extract(const_iterator position);
+        //   node_type extract(const key_type& key);
+        //   insert_return_type insert(node_type&& node);
+        //   iterator insert(const_iterator hint, node_type&& node);
+        //   void merge(map<KEY, VALUE, C2, ALLOCATOR>& source);
+        //   void merge(map<KEY, VALUE, C2, ALLOCATOR>&& source);
+        //   pair<iterator, bool> insert_or_assign(const key_type&, M&&);
+        //   pair<iterator, bool> insert_or_assign(key_type&&, M&&);
+        //   iterator insert_or_assign(const_iterator, const key_type&, M&&);
+        //   iterator insert_or_assign(const_iterator, key_type&&, M&&);
+        //   pair<iterator, bool> try_emplace(const key_type&, Args&&...);
+        //   pair<iterator, bool> try_emplace(key_type&&, Args&&...);
+        //   iterator try_emplace(const_iterator, const key_type&, Args&&...);
+        //   iterator try_emplace(const_iterator, key_type&&, Args&&...);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf(
+               "\nTESTING NODE HANDLES, 'try_emplace', AND 'insert_or_assign'"
+               "\n==========================================================="
+               "\n");
+
+        typedef bslmf::MovableRefUtil                             MoveUtil;
+        typedef bsl::map<int, bsl::string>                        Obj;
+        typedef bsl::map<int, bsl::string, std::greater<int> >    ReverseObj;
+
+        const char LONG_A[] = "a string that is too long to be short: A";
+        const char LONG_B[] = "a string that is too long to be short: B";
+        const char LONG_C[] = "a string that is too long to be short: C";
+
+        bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+        bslma::TestAllocator         oa("object",  veryVeryVeryVerbose);
+        bslma::TestAllocator         za("other",   veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        if (verbose) printf("\tTesting 'insert_or_assign'.\n");
+        {
+            Obj mX(&oa);  const Obj& X = mX;
+
+            const bsl::string A(LONG_A, &oa);
+            const bsl::string B(LONG_B, &oa);
+
+            bsl::pair<Obj::iterator, bool> result = mX.insert_or_assign(1, A);
+            ASSERT(result.second);
+            ASSERT(1 == result.first->first);
+            ASSERT(A == result.first->second);
+
+            result = mX.insert_or_assign(1, B);
+            ASSERT(!result.second);
+            ASSERT(B == result.first->second);
+            ASSERT(1 == X.size());
+
+            int key = 2;
+            result = mX.insert_or_assign(
+                                      MoveUtil::move(key), A);
+            ASSERT(result.second);
+            ASSERT(A == X.find(2)->second);
+
+            Obj::iterator it = mX.insert_or_assign(X.end(), 3, B);
+            ASSERT(3 == it->first);
+            ASSERT(B == it->second);
+
+            it = mX.insert_or_assign(X.begin(), 3, A);
+            ASSERT(3 == it->first);
+            ASSERT(A == it->second);
+
+            key = 4;
+            it = mX.insert_or_assign(X.end(),
+                                     MoveUtil::move(key),
+                                     B);
+            ASSERT(4 == it->first);
+            ASSERT(4 == X.size());
+        }
+
+        if (verbose) printf("\tTesting 'merge'.\n");
+        {
+            Obj        mX(&oa);  const Obj&        X = mX;
+            ReverseObj mY(&oa);  const ReverseObj& Y = mY;
+
+            mX[1] = LONG_A;
+            mX[3] = LONG_A;
+            mY[2] = LONG_B;
+            mY[3] = LONG_B;
+            mY[5] = LONG_B;
+
+            mX.merge(mY);
+            ASSERTV(X.size(), 4 == X.size());
+            ASSERTV(Y.size(), 1 == Y.size());
+            ASSERT(LONG_A == X.find(3)->second);
+            ASSERT(LONG_B == X.find(2)->second);
+            ASSERT(LONG_B == X.find(5)->second);
+            ASSERT(LONG_B == Y.find(3)->second);
+
+            mX.merge(mX);
+            ASSERT(4 == X.size());
+
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+            mY[7] = LONG_C;
+            mX.merge(MoveUtil::move(mY));
+            ASSERT(5 == X.size());
+            ASSERT(1 == Y.size());
+            ASSERT(LONG_C == X.find(7)->second);
+#endif
+
+            // Merging from a map having a different allocator moves the
+            // elements into nodes allocated by the target.
+
+            ReverseObj mZ(&za);  const ReverseObj& Z = mZ;
+
+            mZ[4] = LONG_C;
+            mZ[5] = LONG_C;
+
+            mX.merge(mZ);
+            ASSERTV(X.size(), 6 == X.size());
+            ASSERTV(Z.size(), 1 == Z.size());
+            ASSERT(LONG_C == X.find(4)->second);
+            ASSERT(&oa    == X.find(4)->second.get_allocator().mechanism());
+        }
+        ASSERTV(za.numBlocksInUse(), 0 == za.numBlocksInUse());
+
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+        if (verbose) printf("\tTesting 'extract' and node 'insert'.\n");
+        {
+            Obj mX(&oa);  const Obj& X = mX;
+            Obj mY(&oa);  const Obj& Y = mY;
+
+            mX[1] = LONG_A;
+            mX[2] = LONG_B;
+            mX[3] = LONG_C;
+
+            const Obj::value_type *ELEMENT = &*X.find(1);
+            const char            *BUFFER  = X.find(1)->second.data();
+
+            bsls::Types::Int64 numAllocs   = oa.numAllocations();
+            bsls::Types::Int64 numDeallocs = oa.numDeallocations();
+
+            Obj::node_type nh = mX.extract(X.find(1));
+            ASSERT(!nh.empty());
+            ASSERT(2      == X.size());
+            ASSERT(X.end() == X.find(1));
+            ASSERT(1      == nh.key());
+            ASSERT(LONG_A == nh.mapped());
+            ASSERT(BUFFER == nh.mapped().data());
+            ASSERT(&oa    == nh.get_allocator().mechanism());
+
+            ASSERTV(numAllocs + 1 == oa.numAllocations());
+            ASSERTV(numDeallocs   == oa.numDeallocations());
+
+            Obj::node_type empty = mX.extract(99);
+            ASSERT(empty.empty());
+            ASSERTV(numAllocs + 1 == oa.numAllocations());
+
+            // Re-key the element and insert it back.
+
+            nh.key() = 4;
+            Obj::insert_return_type result =
+                                      mX.insert(MoveUtil::move(nh));
+            ASSERT(result.inserted);
+            ASSERT(result.node.empty());
+            ASSERT(nh.empty());
+            ASSERT(4       == result.position->first);
+            ASSERT(ELEMENT == &*result.position);
+            ASSERT(BUFFER  == result.position->second.data());
+            ASSERT(3       == X.size());
+
+            ASSERTV(numAllocs   + 1 == oa.numAllocations());
+            ASSERTV(numDeallocs + 1 == oa.numDeallocations());
+
+            // Duplicate key: the node handle is returned.
+
+            nh = mX.extract(2);
+            nh.key() = 3;
+            result = mX.insert(MoveUtil::move(nh));
+            ASSERT(!result.inserted);
+            ASSERT(!result.node.empty());
+            ASSERT(3      == result.position->first);
+            ASSERT(LONG_C == result.position->second);
+            ASSERT(LONG_B == result.node.mapped());
+            ASSERT(2      == X.size());
+
+            // Empty node handle.
+
+            result = mX.insert(Obj::node_type());
+            ASSERT(!result.inserted);
+            ASSERT(X.end() == result.position);
+            ASSERT(result.node.empty());
+
+            // Hinted insertion.
+
+            nh = MoveUtil::move(result.node);
+            ASSERT(nh.empty());
+            nh = mX.extract(3);
+            nh.key() = 2;
+            Obj::iterator it = mX.insert(X.begin(),
+                                         MoveUtil::move(nh));
+            ASSERT(nh.empty());
+            ASSERT(2 == it->first);
+            ASSERT(LONG_C == it->second);
+            ASSERT(X.begin() == it);
+
+            it = mX.insert(X.end(), Obj::node_type());
+            ASSERT(X.end() == it);
+
+            // Insertion into another map.
+
+            const Obj::value_type *OTHER = &*X.find(4);
+
+            nh = mX.extract(4);
+            result = mY.insert(MoveUtil::move(nh));
+            ASSERT(result.inserted);
+            ASSERT(nh.empty());
+            ASSERT(1       == X.size());
+            ASSERT(1       == Y.size());
+            ASSERT(4       == result.position->first);
+            ASSERT(LONG_A  == result.position->second);
+            ASSERT(BUFFER  == result.position->second.data());
+            ASSERT(OTHER   != &*result.position);
+
+            // The node returned to 'mX' is reused by its next insertion.
+
+            mX[5] = LONG_B;
+            ASSERT(OTHER == &*X.find(5));
+
+            // Insertion into a map having a different allocator.
+
+            Obj mZ(&za);  const Obj& Z = mZ;
+
+            nh = mY.extract(4);
+            ASSERT(&oa == nh.get_allocator().mechanism());
+
+            result = mZ.insert(MoveUtil::move(nh));
+            ASSERT(result.inserted);
+            ASSERT(nh.empty());
+            ASSERT(0      == Y.size());
+            ASSERT(1      == Z.size());
+            ASSERT(LONG_A == result.position->second);
+            ASSERT(&za    == result.position->second.get_allocator()
+                                                                 .mechanism());
+        }
+        ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+        ASSERTV(za.numBlocksInUse(), 0 == za.numBlocksInUse());
+
+        if (verbose) printf("\tTesting node handles outliving maps.\n");
+        {
+            Obj mX(&oa);  const Obj& X = mX;
+
+            Obj::node_type nh;
+            Obj::node_type nh2;
+            {
+                Obj mY(&oa);
+
+                mY[1] = LONG_A;
+                mY[2] = LONG_B;
+
+                nh  = mY.extract(1);
+                nh2 = mY.extract(2);
+            }
+            ASSERT(1      == nh.key());
+            ASSERT(LONG_A == nh.mapped());
+            ASSERT(&oa    == nh.get_allocator().mechanism());
+
+            const char *BUFFER = nh.mapped().data();
+
+            Obj::insert_return_type result = mX.insert(MoveUtil::move(nh));
+            ASSERT(result.inserted);
+            ASSERT(nh.empty());
+            ASSERT(LONG_A == result.position->second);
+            ASSERT(BUFFER == result.position->second.data());
+            ASSERT(1      == X.size());
+
+            // The map the node was extracted from can also be moved from, or
+            // swapped, while the node handle is alive.
+
+            Obj mW(&oa);
+            mW[3] = LONG_C;
+            nh = mW.extract(3);
+
+            Obj mV(MoveUtil::move(mW));
+            mV.swap(mW);
+            mW[4] = LONG_C;
+            ASSERT(LONG_C == nh.mapped());
+
+            // 'nh2' is destroyed after the map it was extracted from.
+        }
+        ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+#endif
+
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES                            \
+ && defined(BSLS_LIBRARYFEATURES_HAS_CPP11_PAIR_PIECEWISE_CONSTRUCTOR)        \
+ && defined(BSLS_LIBRARYFEATURES_HAS_CPP14_INTEGER_SEQUENCE)
+        if (verbose) printf("\tTesting 'try_emplace'.\n");
+        {
+            Obj mX(&oa);  const Obj& X = mX;
+
+            bsl::pair<Obj::iterator, bool> result =
+                                           mX.try_emplace(1, LONG_A);
+            ASSERT(result.second);
+            ASSERT(LONG_A == result.first->second);
+            ASSERT(&oa    == result.first->second.get_allocator().mechanism());
+
+            bsl::string value(LONG_B, &oa);
+
+            result = mX.try_emplace(1, MoveUtil::move(value));
+            ASSERT(!result.second);
+            ASSERT(LONG_A == result.first->second);
+            ASSERT(LONG_B == value);
+
+            int key = 2;
+            result = mX.try_emplace(MoveUtil::move(key), 3, 'x');
+            ASSERT(result.second);
+            ASSERT("xxx" == result.first->second);
+
+            Obj::iterator it = mX.try_emplace(X.end(), 3);
+            ASSERT(3 == it->first);
+            ASSERT(it->second.empty());
+
+            it = mX.try_emplace(X.begin(), 3, MoveUtil::move(value));
+            ASSERT(3 == it->first);
+            ASSERT(LONG_B == value);
+
+            key = 4;
+            it = mX.try_emplace(X.end(), MoveUtil::move(key), LONG_C);
+            ASSERT(4 == it->first);
+            ASSERT(LONG_C == it->second);
+            ASSERT(4 == X.size());
+        }
+        ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+#endif
+
+        ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+      } break;
+      case 40: {
         // --------------------------------------------------------------------
         // TESTING COMPARATORS WITH MULTI-VALUE EQUAL RANGES
         //   Although in most cases additional operators accepting reference
@@ -9666,6 +10076,7 @@ int main(int argc, char *argv[])
         // Testing:
         //   CONCERN: 'find'        properly handles transparent comparators.
         //   CONCERN: 'count'       properly handles transparent comparators.
+        //   CONCERN: 'contains'    properly handles transparent comparators.
         //   CONCERN: 'lower_bound' properly handles transparent comparators.
         //   CONCERN: 'upper_bound' properly handles transparent comparators.
         //   CONCERN: 'equal_range' properly handles transparent comparators.
@@ -0,0 +1,576 @@
+// bslstl_nodehandle.h                                                -*-C++-*-
+#ifndef INCLUDED_BSLSTL_NODEHANDLE
+#define INCLUDED_BSLSTL_NODEHANDLE
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide node handles for elements extracted from maps.
+//
+//@CLASSES:
+//  bslstl::MapNodeHandle: owner of a node extracted from a map
+//  bslstl::NodeHandleInsertResult: result of inserting a node handle
+//
+//@SEE_ALSO: bslstl_map, bslstl_unorderedmap, bslstl_treenodepool,
+//           bslstl_bidirectionalnodepool
+//
+//@DESCRIPTION: This component provides a move-only class template,
+// 'bslstl::MapNodeHandle', that owns a single node of a node-based map (i.e.,
+// 'bsl::map' or 'bsl::unordered_map') after that node has been removed from
+// the map by 'extract', and a class template,
+// 'bslstl::NodeHandleInsertResult', that describes the outcome of inserting
+// such a node handle back into a map.  These types implement the 'node_type'
+// and 'insert_return_type' of the maps, as specified by the C++17 standard.
+//
+// A 'bslstl::MapNodeHandle' holds the node it owns and a copy of the
+// allocator of the map from which the node was extracted.  When a non-empty
+// node handle is destroyed (or assigned to), the value held by its node is
+// destroyed and the memory of the node is returned to that allocator.  While
+// a node is owned by a node handle, its key may be modified through the 'key'
+// method, and its mapped value through the 'mapped' method, which allows an
+// element to be re-keyed without copying its value.
+//
+///Node Ownership and Node Pools
+///-----------------------------
+// The maps of this library obtain their nodes from a pool owned by each map
+// (see 'bslstl_simplepool'), which carves nodes out of larger chunks of memory
+// that are released only when the pool is destroyed.  A node carved from a
+// chunk therefore cannot outlive its map.  Instead, the node owned by a node
+// handle is a *detached* node, allocated individually from the allocator of
+// the map by the 'moveIntoDetachedNode' method of the node factory of the map,
+// and destroyed by the 'deleteDetachedNode' class method of that factory.  As
+// a consequence:
+//
+//: o A node handle does not depend on the map from which its node was
+//:   extracted, and may outlive that map, or be used after that map has been
+//:   swapped or moved from.
+//:
+//: o Extracting an element moves it into a detached node, and returns the
+//:   original node to the pool of the map.  Inserting a node handle into a map
+//:   moves the element into a node supplied by the pool of that map, and
+//:   returns the detached node to the allocator of the node handle.  Both
+//:   pools recycle released nodes, so only the detached node is allocated by
+//:   a round trip through a node handle.
+//
+// This component is available only on platforms supporting rvalue references.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Re-keying a Node
+///- - - - - - - - - - - - - -
+// Node handles are normally obtained from the 'extract' method of a map, but
+// any detached node created by a compatible node factory can be owned by a
+// node handle.  In this example we use a 'bslstl::TreeNodePool' directly.
+//
+// First, we define the types of the node, the node factory, and the node
+// handle for a map from 'int' to 'int':
+//..
+//  typedef bsl::pair<const int, int>                   Value;
+//  typedef bsl::allocator<Value>                       Allocator;
+//  typedef bslstl::TreeNode<Value>                     Node;
+//  typedef bslstl::TreeNodePool<Value, Allocator>      Factory;
+//  typedef bslstl::MapNodeHandle<int, int, Node, Factory, Allocator>
+//                                                      NodeHandle;
+//..
+// Then, we create a node factory, and a pooled node holding the value
+// '(1, 100)', as a map would.  We move the value into a detached node, as
+// 'extract' does, return the pooled node to the factory, and transfer
+// ownership of the detached node to a node handle:
+//..
+//  bslma::TestAllocator oa;
+//  NodeHandle           handle;
+//  Node                *node;
+//  {
+//      Factory factory(&oa);
+//
+//      bslalg::RbTreeNode *pooled = factory.emplaceIntoNewNode(1, 100);
+//
+//      node = static_cast<Node *>(factory.moveIntoDetachedNode(pooled));
+//      factory.deleteNode(pooled);
+//
+//      NodeHandle temp(node, Allocator(&oa));
+//      handle.swap(temp);
+//
+//      assert(2 == oa.numBlocksInUse());
+//  }
+//  assert(!handle.empty());
+//  assert(  1 == handle.key());
+//  assert(100 == handle.mapped());
+//  assert(&oa == handle.get_allocator().mechanism());
+//..
+// Notice that the node handle remains valid after the factory, and the chunk
+// of memory from which it supplied the pooled node, are destroyed.
+//
+// Next, we change the key of the node in place, without creating a new node:
+//..
+//  handle.key() = 2;
+//  assert(node == handle.node());
+//  assert(2    == node->value().first);
+//..
+// Now, we move the node to a second node handle, leaving the first one empty:
+//..
+//  NodeHandle other(bslmf::MovableRefUtil::move(handle));
+//  assert( handle.empty());
+//  assert(!other.empty());
+//  assert(2 == other.key());
+//..
+// Finally, we observe that destroying the second handle returns the memory of
+// the node to the allocator:
+//..
+//  assert(1 == oa.numBlocksInUse());
+//
+//  other = NodeHandle();
+//  assert(other.empty());
+//  assert(0 == oa.numBlocksInUse());
+//..
+
+// Prevent 'bslstl' headers from being included directly in 'BSL_OVERRIDES_STD'
+// mode.  Doing so is unsupported, and is likely to cause compilation errors.
+#if defined(BSL_OVERRIDES_STD) && !defined(BOS_STDHDRS_PROLOGUE_IN_EFFECT)
+#error "include <bsl_map.h> instead of <bslstl_nodehandle.h> in \
+BSL_OVERRIDES_STD mode"
+#endif
+#include <bslscm_version.h>
+
+#include <bslmf_movableref.h>
+
+#include <bsls_assert.h>
+#include <bsls_compilerfeatures.h>
+#include <bsls_keyword.h>
+#include <bsls_objectbuffer.h>
+
+#include <new>
+
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+
+namespace BloombergLP {
+namespace bslstl {
+
+                            // ===================
+                            // class MapNodeHandle
+                            // ===================
+
+template <class KEY,
+          class VALUE,
+          class NODE,
+          class NODE_FACTORY,
+          class ALLOCATOR>
+class MapNodeHandle {
+    // This move-only class owns a (possibly null) node of the (template
+    // parameter) type 'NODE', holding a 'pair<const KEY, VALUE>', that was
+    // created by the 'moveIntoDetachedNode' method of an object of the
+    // (template parameter) type 'NODE_FACTORY' using an allocator equal to
+    // the one held by this object.  'NODE' must provide a 'value' method
+    // returning a reference to the held pair, and 'NODE_FACTORY' must provide
+    // a static 'deleteDetachedNode' method accepting a 'NODE *' and an
+    // allocator convertible from the (template parameter) type 'ALLOCATOR'.
+
+    // DATA
+    NODE                          *d_node_p;     // owned node, or 0 if this
+                                                 // handle is empty
+
+    bsls::ObjectBuffer<ALLOCATOR>  d_allocator;  // allocator of 'd_node_p',
+                                                 // constructed only if this
+                                                 // handle is not empty
+
+  private:
+    // NOT IMPLEMENTED
+    MapNodeHandle(const MapNodeHandle&);
+    MapNodeHandle& operator=(const MapNodeHandle&);
+
+    // PRIVATE MANIPULATORS
+    void reset() BSLS_KEYWORD_NOEXCEPT;
+        // If this node handle is not empty, destroy the value held by the
+        // owned node, return the node to its allocator, and leave this handle
+        // empty.
+
+    void takeFrom(MapNodeHandle& other) BSLS_KEYWORD_NOEXCEPT;
+        // Take ownership of the node owned by the specified 'other' node
+        // handle (if any) along with its allocator, and leave 'other' empty.
+        // The behavior is undefined unless this node handle is empty.
+
+  public:
+    // TYPES
+    typedef KEY       key_type;
+    typedef VALUE     mapped_type;
+    typedef ALLOCATOR allocator_type;
+
+    // CREATORS
+    MapNodeHandle() BSLS_KEYWORD_NOEXCEPT;
+        // Create an empty node handle.
+
+    MapNodeHandle(NODE *node, const ALLOCATOR& allocator);
+        // Create a node handle that owns the specified 'node', whose memory
+        // was obtained from the specified 'allocator'.  The behavior is
+        // undefined unless 'node' is non-null, was created by the
+        // 'moveIntoDetachedNode' method of a 'NODE_FACTORY' using an allocator
+        // equal to 'allocator', and is not linked into any container.  Note
+        // that this constructor is intended for use by the maps of this
+        // library.
+
+    MapNodeHandle(bslmf::MovableRef<MapNodeHandle> original)
+                                                         BSLS_KEYWORD_NOEXCEPT;
+                                                                    // IMPLICIT
+        // Create a node handle that owns the node owned by the specified
+        // 'original' node handle (if any), and leave 'original' empty.
+
+    ~MapNodeHandle();
+        // If this node handle is not empty, destroy the value held by the
+        // owned node and return the node to its allocator, and destroy this
+        // object.
+
+    // MANIPULATORS
+    MapNodeHandle& operator=(bslmf::MovableRef<MapNodeHandle> rhs)
+                                                         BSLS_KEYWORD_NOEXCEPT;
+        // If this node handle is not empty, destroy the value held by the
+        // owned node and return the node to its allocator; then take
+        // ownership of the node owned by the specified 'rhs' node handle (if
+        // any), along with its allocator, leaving 'rhs' empty.  Return a
+        // reference providing modifiable access to this object.
+
+    key_type& key() const;
+        // Return a reference providing modifiable access to the key of the
+        // value held by the node owned by this node handle.  The behavior is
+        // undefined if this node handle is empty.
+
+    mapped_type& mapped() const;
+        // Return a reference providing modifiable access to the mapped value
+        // of the value held by the node owned by this node handle.  The
+        // behavior is undefined if this node handle is empty.
+
+    NODE *release() BSLS_KEYWORD_NOEXCEPT;
+        // Return the address of the node owned by this node handle (or 0 if
+        // this handle is empty), and leave this handle empty without
+        // destroying the node.  Note that this method is intended for use by
+        // the maps of this library.
+
+    void swap(MapNodeHandle& other) BSLS_KEYWORD_NOEXCEPT;
+        // Exchange the nodes owned by this object and the specified 'other'
+        // object, along with their allocators.
+
+    // ACCESSORS
+    BSLS_KEYWORD_EXPLICIT operator bool() const BSLS_KEYWORD_NOEXCEPT;
+        // Return 'true' if this node handle owns a node, and 'false'
+        // otherwise.
+
+    bool empty() const BSLS_KEYWORD_NOEXCEPT;
+        // Return 'true' if this node handle does not own a node, and 'false'
+        // otherwise.
+
+    allocator_type get_allocator() const;
+        // Return (a copy of) the allocator from which the memory of the node
+        // owned by this node handle was obtained.  The behavior is undefined
+        // if this node handle is empty.
+
+    NODE *node() const BSLS_KEYWORD_NOEXCEPT;
+        // Return the address of the node owned by this node handle, or 0 if
+        // this handle is empty.
+};
+
+// FREE FUNCTIONS
+template <class KEY,
+          class VALUE,
+          class NODE,
+          class NODE_FACTORY,
+          class ALLOCATOR>
+void swap(MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>& a,
+          MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>& b)
+                                                         BSLS_KEYWORD_NOEXCEPT;
+    // Exchange the nodes owned by the specified 'a' and 'b' objects.
+
+                        // ============================
+                        // struct NodeHandleInsertResult
+                        // ============================
+
+template <class ITERATOR, class NODE_HANDLE>
+struct NodeHandleInsertResult {
+    // This 'struct' describes the result of inserting a node handle into a
+    // container having unique keys.  The names of its data members are those
+    // specified by the C++17 standard for 'insert_return_type'.
+
+    // PUBLIC DATA
+    ITERATOR    position;  // inserted element, or the element that prevented
+                           // the insertion, or 'end()' if the inserted node
+                           // handle was empty
+
+    bool        inserted;  // 'true' if the node was inserted, and 'false'
+                           // otherwise
+
+    NODE_HANDLE node;      // the node that was not inserted, or an empty node
+                           // handle if the node was inserted
+};
+
+// ============================================================================
+//                  INLINE AND TEMPLATE FUNCTION DEFINITIONS
+// ============================================================================
+
+                            // -------------------
+                            // class MapNodeHandle
+                            // -------------------
+
+// PRIVATE MANIPULATORS
+template <class KEY,
+          class VALUE,
+          class NODE,
+          class NODE_FACTORY,
+          class ALLOCATOR>
+inline
+void MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>::reset()
+                                                          BSLS_KEYWORD_NOEXCEPT
+{
+    if (d_node_p) {
+        NODE_FACTORY::deleteDetachedNode(d_node_p, d_allocator.object());
+        d_allocator.object().~ALLOCATOR();
+        d_node_p = 0;
+    }
+}
+
+template <class KEY,
+          class VALUE,
+          class NODE,
+          class NODE_FACTORY,
+          class ALLOCATOR>
+inline
+void MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>::takeFrom(
+                                   MapNodeHandle& other) BSLS_KEYWORD_NOEXCEPT
+{
+    BSLS_ASSERT_SAFE(!d_node_p);
+
+    if (other.d_node_p) {
+        ::new (d_allocator.buffer()) ALLOCATOR(other.d_allocator.object());
+        d_node_p = other.d_node_p;
+
+        other.d_allocator.object().~ALLOCATOR();
+        other.d_node_p = 0;
+    }
+}
+
+// CREATORS
+template <class KEY,
+          class VALUE,
+          class NODE,
+          class NODE_FACTORY,
+          class ALLOCATOR>
+inline
+MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>::MapNodeHandle()
+                                                          BSLS_KEYWORD_NOEXCEPT
+: d_node_p(0)
+{
+}
+
+template <class KEY,
+          class VALUE,
+          class NODE,
+          class NODE_FACTORY,
+          class ALLOCATOR>
+inline
+MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>::MapNodeHandle(
+                                                  NODE             *node,
+                                                  const ALLOCATOR&  allocator)
+: d_node_p(node)
+{
+    BSLS_ASSERT_SAFE(node);
+
+    ::new (d_allocator.buffer()) ALLOCATOR(allocator);
+}
+
+template <class KEY,
+          class VALUE,
+          class NODE,
+          class NODE_FACTORY,
+          class ALLOCATOR>
+inline
+MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>::MapNodeHandle(
+            bslmf::MovableRef<MapNodeHandle> original) BSLS_KEYWORD_NOEXCEPT
+: d_node_p(0)
+{
+    MapNodeHandle& lvalue = original;
+
+    takeFrom(lvalue);
+}
+
+template <class KEY,
+          class VALUE,
+          class NODE,
+          class NODE_FACTORY,
+          class ALLOCATOR>
+inline
+MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>::~MapNodeHandle()
+{
+    reset();
+}
+
+// MANIPULATORS
+template <class KEY,
+          class VALUE,
+          class NODE,
+          class NODE_FACTORY,
+          class ALLOCATOR>
+inline
+MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>&
+MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>::operator=(
+                 bslmf::MovableRef<MapNodeHandle> rhs) BSLS_KEYWORD_NOEXCEPT
+{
+    MapNodeHandle& lvalue = rhs;
+
+    if (this != &lvalue) {
+        reset();
+        takeFrom(lvalue);
+    }
+    return *this;
+}
+
+template <class KEY,
+          class VALUE,
+          class NODE,
+          class NODE_FACTORY,
+          class ALLOCATOR>
+inline
+KEY& MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>::key() const
+{
+    BSLS_ASSERT_SAFE(d_node_p);
+
+    // The key is stored as a 'const KEY', but the node is owned exclusively by
+    // this handle, so modifying the key cannot corrupt a container.
+
+    return const_cast<KEY&>(d_node_p->value().first);
+}
+
+template <class KEY,
+          class VALUE,
+          class NODE,
+          class NODE_FACTORY,
+          class ALLOCATOR>
+inline
+VALUE& MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>::mapped() const
+{
+    BSLS_ASSERT_SAFE(d_node_p);
+
+    return d_node_p->value().second;
+}
+
+template <class KEY,
+          class VALUE,
+          class NODE,
+          class NODE_FACTORY,
+          class ALLOCATOR>
+inline
+NODE *MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>::release()
+                                                          BSLS_KEYWORD_NOEXCEPT
+{
+    NODE *result = d_node_p;
+
+    if (d_node_p) {
+        d_allocator.object().~ALLOCATOR();
+        d_node_p = 0;
+    }
+    return result;
+}
+
+template <class KEY,
+          class VALUE,
+          class NODE,
+          class NODE_FACTORY,
+          class ALLOCATOR>
+inline
+void MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>::swap(
+                                   MapNodeHandle& other) BSLS_KEYWORD_NOEXCEPT
+{
+    MapNodeHandle temp;
+
+    temp.takeFrom(*this);
+    takeFrom(other);
+    other.takeFrom(temp);
+}
+
+// ACCESSORS
+template <class KEY,
+          class VALUE,
+          class NODE,
+          class NODE_FACTORY,
+          class ALLOCATOR>
+inline
+MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>::operator bool() const
+                                                          BSLS_KEYWORD_NOEXCEPT
+{
+    return 0 != d_node_p;
+}
+
+template <class KEY,
+          class VALUE,
+          class NODE,
+          class NODE_FACTORY,
+          class ALLOCATOR>
+inline
+bool MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>::empty() const
+                                                          BSLS_KEYWORD_NOEXCEPT
+{
+    return 0 == d_node_p;
+}
+
+template <class KEY,
+          class VALUE,
+          class NODE,
+          class NODE_FACTORY,
+          class ALLOCATOR>
+inline
+ALLOCATOR
+MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>::get_allocator()
+                                                                          const
+{
+    BSLS_ASSERT_SAFE(d_node_p);
+
+    return d_allocator.object();
+}
+
+template <class KEY,
+          class VALUE,
+          class NODE,
+          class NODE_FACTORY,
+          class ALLOCATOR>
+inline
+NODE *MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>::node() const
+                                                          BSLS_KEYWORD_NOEXCEPT
+{
+    return d_node_p;
+}
+
+}  // close package namespace
+
+// FREE FUNCTIONS
+template <class KEY,
+          class VALUE,
+          class NODE,
+          class NODE_FACTORY,
+          class ALLOCATOR>
+inline
+void bslstl::swap(MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>& a,
+                  MapNodeHandle<KEY, VALUE, NODE, NODE_FACTORY, ALLOCATOR>& b)
+                                                          BSLS_KEYWORD_NOEXCEPT
+{
+    a.swap(b);
+}
+
+}  // close enterprise namespace
+
+#endif  // BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,659 @@
+// bslstl_nodehandle.t.cpp                                            -*-C++-*-
+#include <bslstl_nodehandle.h>
+
+#include <bslstl_pair.h>
+#include <bslstl_treenode.h>
+#include <bslstl_treenodepool.h>
+
+#include <bslalg_rbtreenode.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_stdallocator.h>
+#include <bslma_testallocator.h>
+
+#include <bslmf_movableref.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_bsltestutil.h>
+#include <bsls_compilerfeatures.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace BloombergLP;
+
+//=============================================================================
+//                              TEST PLAN
+//-----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test provides a move-only handle owning a node created
+// by a node factory, and a simple aggregate describing the result of inserting
+// such a handle.  We exercise the handle with detached nodes created by a
+// 'bslstl::TreeNodePool', and use a test allocator to verify that nodes are
+// returned to the allocator (and never leaked) by every operation releasing
+// ownership, even after the factory has been destroyed.
+//
+// Note that the component is available only on platforms supporting rvalue
+// references; on other platforms every test case is empty.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] MapNodeHandle();
+// [ 2] MapNodeHandle(NODE *node, const ALLOCATOR& allocator);
+// [ 3] MapNodeHandle(MovableRef<MapNodeHandle> original);
+// [ 2] ~MapNodeHandle();
+//
+// MANIPULATORS
+// [ 3] MapNodeHandle& operator=(MovableRef<MapNodeHandle> rhs);
+// [ 2] key_type& key() const;
+// [ 2] mapped_type& mapped() const;
+// [ 4] NODE *release();
+// [ 4] void swap(MapNodeHandle& other);
+//
+// ACCESSORS
+// [ 2] operator bool() const;
+// [ 2] bool empty() const;
+// [ 2] allocator_type get_allocator() const;
+// [ 2] NODE *node() const;
+//
+// FREE FUNCTIONS
+// [ 4] void swap(MapNodeHandle& a, MapNodeHandle& b);
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] NodeHandleInsertResult
+// [ 6] USAGE EXAMPLE
+// [ 2] CONCERN: All nodes are returned to the allocator.
+// [ 2] CONCERN: A node handle can outlive the factory of its node.
+//=============================================================================
+
+//=============================================================================
+//                  STANDARD BDE ASSERT TEST MACRO
+//-----------------------------------------------------------------------------
+// NOTE: THIS IS A LOW-LEVEL COMPONENT AND MAY NOT USE ANY C++ LIBRARY
+// FUNCTIONS, INCLUDING IOSTREAMS.
+static int testStatus = 0;
+
+namespace {
+
+void aSsErT(bool b, const char *s, int i) {
+    if (b) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", i, s);
+        if (testStatus >= 0 && testStatus <= 100) ++testStatus;
+    }
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+//-----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                       GLOBAL TEST VALUES
+// ----------------------------------------------------------------------------
+
+static bool             verbose;
+static bool         veryVerbose;
+static bool     veryVeryVerbose;
+static bool veryVeryVeryVerbose;
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS AND HELPERS FOR TESTING
+//-----------------------------------------------------------------------------
+
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+
+typedef bsl::pair<const int, int>                      Value;
+typedef bsl::allocator<Value>                          Allocator;
+typedef bslstl::TreeNode<Value>                        Node;
+typedef bslstl::TreeNodePool<Value, Allocator>         Factory;
+typedef bslstl::MapNodeHandle<int, int, Node, Factory, Allocator>
+                                                       Obj;
+typedef bslstl::NodeHandleInsertResult<const Node *, Obj>
+                                                       InsertResult;
+
+static
+Node *makeNode(bslma::Allocator *allocator, int key, int mapped)
+    // Return a new detached node, holding a pair having the specified 'key'
+    // and 'mapped' value, created (as by the 'extract' method of a map) by a
+    // temporary factory using the specified 'allocator'.  Note that the
+    // factory, and the memory from which it supplied its pooled node, are
+    // released before this function returns.
+{
+    Factory factory(allocator);
+
+    bslalg::RbTreeNode *pooled = factory.emplaceIntoNewNode(key, mapped);
+    bslalg::RbTreeNode *node   = factory.moveIntoDetachedNode(pooled);
+    factory.deleteNode(pooled);
+
+    return static_cast<Node *>(node);
+}
+
+#endif  // BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES
+
+//=============================================================================
+//                                 MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int  test = argc > 1 ? atoi(argv[1]) : 0;
+    verbose = argc > 2;
+    veryVerbose = argc > 3;
+    veryVeryVerbose = argc > 4;
+    veryVeryVeryVerbose = argc > 5;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+    bslma::DefaultAllocatorGuard dag(&da);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Re-keying a Node
+///- - - - - - - - - - - - - -
+// Node handles are normally obtained from the 'extract' method of a map, but
+// any detached node created by a compatible node factory can be owned by a
+// node handle.  In this example we use a 'bslstl::TreeNodePool' directly.
+//
+// First, we define the types of the node, the node factory, and the node
+// handle for a map from 'int' to 'int':
+//..
+    typedef bsl::pair<const int, int>                   Value;
+    typedef bsl::allocator<Value>                       Allocator;
+    typedef bslstl::TreeNode<Value>                     Node;
+    typedef bslstl::TreeNodePool<Value, Allocator>      Factory;
+    typedef bslstl::MapNodeHandle<int, int, Node, Factory, Allocator>
+                                                        NodeHandle;
+//..
+// Then, we create a node factory, and a pooled node holding the value
+// '(1, 100)', as a map would.  We move the value into a detached node, as
+// 'extract' does, return the pooled node to the factory, and transfer
+// ownership of the detached node to a node handle:
+//..
+    bslma::TestAllocator oa;
+    NodeHandle           handle;
+    Node                *node;
+    {
+        Factory factory(&oa);
+
+        bslalg::RbTreeNode *pooled = factory.emplaceIntoNewNode(1, 100);
+
+        node = static_cast<Node *>(factory.moveIntoDetachedNode(pooled));
+        factory.deleteNode(pooled);
+
+        NodeHandle temp(node, Allocator(&oa));
+        handle.swap(temp);
+
+        ASSERT(2 == oa.numBlocksInUse());
+    }
+    ASSERT(!handle.empty());
+    ASSERT(  1 == handle.key());
+    ASSERT(100 == handle.mapped());
+    ASSERT(&oa == handle.get_allocator().mechanism());
+//..
+// Notice that the node handle remains valid after the factory, and the chunk
+// of memory from which it supplied the pooled node, are destroyed.
+//
+// Next, we change the key of the node in place, without creating a new node:
+//..
+    handle.key() = 2;
+    ASSERT(node == handle.node());
+    ASSERT(2    == node->value().first);
+//..
+// Now, we move the node to a second node handle, leaving the first one empty:
+//..
+    NodeHandle other(bslmf::MovableRefUtil::move(handle));
+    ASSERT( handle.empty());
+    ASSERT(!other.empty());
+    ASSERT(2 == other.key());
+//..
+// Finally, we observe that destroying the second handle returns the memory of
+// the node to the allocator:
+//..
+    ASSERT(1 == oa.numBlocksInUse());
+
+    other = NodeHandle();
+    ASSERT(other.empty());
+    ASSERT(0 == oa.numBlocksInUse());
+//..
+#endif
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING 'NodeHandleInsertResult'
+        //
+        // Concerns:
+        //: 1 'NodeHandleInsertResult' has public data members named
+        //:   'position', 'inserted', and 'node', having the specified types.
+        //:
+        //: 2 A node handle can be moved into and out of the 'node' member.
+        //
+        // Plan:
+        //: 1 Create an object, set each member, and verify the values of the
+        //:   members.  Move a node handle in and out of the 'node' member, and
+        //:   verify that no node is leaked.  (C-1..2)
+        //
+        // Testing:
+        //   NodeHandleInsertResult
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING 'NodeHandleInsertResult'"
+                            "\n================================\n");
+
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+        {
+            Node *node = makeNode(&oa, 1, 10);
+
+            InsertResult mX = { node, false, Obj(node, Allocator(&oa)) };
+            const InsertResult& X = mX;
+
+            ASSERT(node == X.position);
+            ASSERT(false == X.inserted);
+            ASSERT(node == X.node.node());
+
+            mX.inserted = true;
+            ASSERT(true == X.inserted);
+
+            Obj handle(bslmf::MovableRefUtil::move(mX.node));
+            ASSERT(X.node.empty());
+            ASSERT(node == handle.node());
+        }
+        ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+#endif
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING 'release' AND 'swap'
+        //
+        // Concerns:
+        //: 1 'release' returns the owned node (or 0), leaves the handle empty,
+        //:   and does not destroy the node.
+        //:
+        //: 2 The member and free 'swap' functions exchange the owned nodes
+        //:   and allocators, including when one or both handles are empty.
+        //
+        // Plan:
+        //: 1 Release nodes from empty and non-empty handles, and verify the
+        //:   result and the state of the handle and the test allocator.  (C-1)
+        //:
+        //: 2 Swap each combination of empty and non-empty handles, holding
+        //:   nodes from distinct allocators, using both the member and the
+        //:   free function, and verify the result.  (C-2)
+        //
+        // Testing:
+        //   NODE *release();
+        //   void swap(MapNodeHandle& other);
+        //   void swap(MapNodeHandle& a, MapNodeHandle& b);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING 'release' AND 'swap'"
+                            "\n============================\n");
+
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+        bslma::TestAllocator oa2("object2", veryVeryVeryVerbose);
+        {
+            if (verbose) printf("\tTesting 'release'.\n");
+            {
+                Obj mX;
+                ASSERT(0 == mX.release());
+                ASSERT(mX.empty());
+
+                Node *node = makeNode(&oa, 1, 10);
+                Obj   mY(node, Allocator(&oa));
+                ASSERT(node == mY.release());
+                ASSERT(mY.empty());
+
+                // The node is still alive, and owned by the caller.
+
+                ASSERT(1 == node->value().first);
+                ASSERT(1 == oa.numBlocksInUse());
+                Factory::deleteDetachedNode(node, Allocator(&oa));
+            }
+
+            if (verbose) printf("\tTesting 'swap'.\n");
+
+            for (int i = 0; i < 4; ++i) {
+                const bool FULL_A = i & 1;
+                const bool FULL_B = i & 2;
+
+                if (veryVerbose) { T_ P_(FULL_A) P(FULL_B) }
+
+                Node *nodeA = FULL_A ? makeNode(&oa,  1, 10) : 0;
+                Node *nodeB = FULL_B ? makeNode(&oa2, 2, 20) : 0;
+
+                Obj mA = FULL_A ? Obj(nodeA, Allocator(&oa))  : Obj();
+                Obj mB = FULL_B ? Obj(nodeB, Allocator(&oa2)) : Obj();
+
+                mA.swap(mB);
+                ASSERTV(i, nodeB == mA.node());
+                ASSERTV(i, nodeA == mB.node());
+                ASSERTV(i, !FULL_B || &oa2 == mA.get_allocator().mechanism());
+                ASSERTV(i, !FULL_A || &oa  == mB.get_allocator().mechanism());
+
+                swap(mA, mB);
+                ASSERTV(i, nodeA == mA.node());
+                ASSERTV(i, nodeB == mB.node());
+                ASSERTV(i, !FULL_A || &oa  == mA.get_allocator().mechanism());
+                ASSERTV(i, !FULL_B || &oa2 == mB.get_allocator().mechanism());
+
+                mA.swap(mA);
+                ASSERTV(i, nodeA == mA.node());
+                ASSERTV(i, !FULL_A || &oa  == mA.get_allocator().mechanism());
+            }
+        }
+        ASSERTV(oa.numBlocksInUse(),  0 == oa.numBlocksInUse());
+        ASSERTV(oa2.numBlocksInUse(), 0 == oa2.numBlocksInUse());
+#endif
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING MOVE OPERATIONS
+        //
+        // Concerns:
+        //: 1 The move constructor transfers ownership of the node (if any),
+        //:   along with its allocator, and leaves the source empty.
+        //:
+        //: 2 Move assignment first returns the node owned by the target (if
+        //:   any) to its allocator, then transfers ownership of the source
+        //:   node (if any) along with its allocator, leaving the source empty.
+        //:
+        //: 3 Move assignment returns a reference to the target, and
+        //:   self-assignment leaves the object unchanged.
+        //
+        // Plan:
+        //: 1 Move-construct from empty and non-empty handles, and verify the
+        //:   state of both handles.  (C-1)
+        //:
+        //: 2 Move-assign each combination of empty and non-empty handles,
+        //:   using nodes from factories having distinct allocators, and verify
+        //:   the state of both handles and the number of blocks in use in
+        //:   each allocator.  (C-2..3)
+        //
+        // Testing:
+        //   MapNodeHandle(MovableRef<MapNodeHandle> original);
+        //   MapNodeHandle& operator=(MovableRef<MapNodeHandle> rhs);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING MOVE OPERATIONS"
+                            "\n=======================\n");
+
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+        if (verbose) printf("\tTesting move constructor.\n");
+        {
+            bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+            Obj mX;
+            Obj mY(bslmf::MovableRefUtil::move(mX));
+            ASSERT(mX.empty());
+            ASSERT(mY.empty());
+
+            Node *node = makeNode(&oa, 1, 10);
+            Obj   mZ(node, Allocator(&oa));
+            Obj   mW(bslmf::MovableRefUtil::move(mZ));
+            ASSERT(mZ.empty());
+            ASSERT(node == mW.node());
+            ASSERT(&oa  == mW.get_allocator().mechanism());
+        }
+
+        if (verbose) printf("\tTesting move-assignment operator.\n");
+
+        for (int i = 0; i < 4; ++i) {
+            const bool FULL_LHS = i & 1;
+            const bool FULL_RHS = i & 2;
+
+            if (veryVerbose) { T_ P_(FULL_LHS) P(FULL_RHS) }
+
+            bslma::TestAllocator la("lhs", veryVeryVeryVerbose);
+            bslma::TestAllocator ra("rhs", veryVeryVeryVerbose);
+            {
+                Node *lhsNode = FULL_LHS ? makeNode(&la, 1, 10) : 0;
+                Node *rhsNode = FULL_RHS ? makeNode(&ra, 2, 20) : 0;
+
+                Obj mL = FULL_LHS ? Obj(lhsNode, Allocator(&la)) : Obj();
+                Obj mR = FULL_RHS ? Obj(rhsNode, Allocator(&ra)) : Obj();
+
+                Obj *mR_p = &(mL = bslmf::MovableRefUtil::move(mR));
+                ASSERTV(i, &mL == mR_p);
+                ASSERTV(i, mR.empty());
+                ASSERTV(i, rhsNode == mL.node());
+                ASSERTV(i, !FULL_RHS || &ra == mL.get_allocator().mechanism());
+
+                // The node previously owned by 'mL' has been returned to 'la'.
+
+                ASSERTV(i, la.numBlocksInUse(), 0 == la.numBlocksInUse());
+                ASSERTV(i, ra.numBlocksInUse(),
+                        (FULL_RHS ? 1 : 0) == ra.numBlocksInUse());
+
+                mL = bslmf::MovableRefUtil::move(mL);
+                ASSERTV(i, rhsNode == mL.node());
+            }
+            ASSERTV(i, la.numBlocksInUse(), 0 == la.numBlocksInUse());
+            ASSERTV(i, ra.numBlocksInUse(), 0 == ra.numBlocksInUse());
+        }
+#endif
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING PRIMARY MANIPULATORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 A default-constructed handle is empty, and its 'node' is null.
+        //:
+        //: 2 A handle constructed from a node and an allocator refers to the
+        //:   node, and is not empty.
+        //:
+        //: 3 'key' and 'mapped' provide modifiable access to the key and
+        //:   mapped value held by the node, and modifying them does not
+        //:   allocate memory.
+        //:
+        //: 4 'get_allocator' returns the allocator supplied at construction.
+        //:
+        //: 5 The destructor returns the owned node (if any) to its allocator.
+        //:
+        //: 6 A node handle remains usable, and releases its node, after the
+        //:   factory that created the node has been destroyed.
+        //
+        // Plan:
+        //: 1 Create empty and non-empty handles, verify all accessors, modify
+        //:   the key and the mapped value, and verify that the destruction of
+        //:   the handles releases all memory.  (C-1..5)
+        //:
+        //: 2 Destroy the factory before using and destroying a handle holding
+        //:   one of its nodes, and verify that no memory is leaked.  (C-6)
+        //
+        // Testing:
+        //   MapNodeHandle();
+        //   MapNodeHandle(NODE *node, const ALLOCATOR& allocator);
+        //   ~MapNodeHandle();
+        //   key_type& key() const;
+        //   mapped_type& mapped() const;
+        //   operator bool() const;
+        //   bool empty() const;
+        //   allocator_type get_allocator() const;
+        //   NODE *node() const;
+        //   CONCERN: All nodes are returned to the allocator.
+        //   CONCERN: A node handle can outlive the factory of its node.
+        // --------------------------------------------------------------------
+
+        if (verbose) printf(
+                          "\nTESTING PRIMARY MANIPULATORS AND ACCESSORS"
+                          "\n==========================================\n");
+
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+        {
+            const Obj X;
+            ASSERT( X.empty());
+            ASSERT(!X);
+            ASSERT(0 == X.node());
+
+            Node *node = makeNode(&oa, 1, 10);
+            {
+                const Obj Y(node, Allocator(&oa));
+                ASSERT(!Y.empty());
+                ASSERT( Y);
+                ASSERT(node == Y.node());
+                ASSERT(1    == Y.key());
+                ASSERT(10   == Y.mapped());
+                ASSERT(&oa  == Y.get_allocator().mechanism());
+
+                const bsls::Types::Int64 NUM_ALLOCS = oa.numAllocations();
+
+                Y.key()    = 5;
+                Y.mapped() = 50;
+                ASSERT(5  == node->value().first);
+                ASSERT(50 == node->value().second);
+                ASSERT(NUM_ALLOCS == oa.numAllocations());
+            }
+
+            // The memory of the node has been returned to 'oa'.
+
+            ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+        }
+        ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+
+        if (verbose) printf("\tTesting a handle outliving its factory.\n");
+        {
+            Obj mX;
+            {
+                Factory factory(&oa);
+
+                bslalg::RbTreeNode *pooled = factory.emplaceIntoNewNode(1, 10);
+
+                Obj mY(static_cast<Node *>(
+                                        factory.moveIntoDetachedNode(pooled)),
+                       Allocator(&oa));
+                factory.deleteNode(pooled);
+                mX.swap(mY);
+            }
+            ASSERT(!mX.empty());
+            ASSERT(1   == mX.key());
+            ASSERT(10  == mX.mapped());
+            ASSERT(&oa == mX.get_allocator().mechanism());
+            ASSERTV(oa.numBlocksInUse(), 1 == oa.numBlocksInUse());
+        }
+        ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+#endif
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create, move, and destroy node handles.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+        {
+            Obj mX(makeNode(&oa, 1, 10), Allocator(&oa));
+            ASSERT(!mX.empty());
+
+            Obj mY;
+            ASSERT(mY.empty());
+
+            mY = bslmf::MovableRefUtil::move(mX);
+            ASSERT( mX.empty());
+            ASSERT(!mY.empty());
+            ASSERT(1  == mY.key());
+            ASSERT(10 == mY.mapped());
+        }
+        ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+#endif
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
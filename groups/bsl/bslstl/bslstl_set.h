@@ -1659,6 +1659,29 @@ class set {
         return count;
     }
 
+    bool contains(const key_type& key) const
+        // Return 'true' if this set contains a 'value_type' object equivalent
+        // to the specified 'key', and 'false' otherwise.
+        //
+        // Note: implemented inline due to Sun CC compilation error.
+    {
+        return find(key) != end();
+    }
+
+    template <class LOOKUP_KEY>
+    typename bsl::enable_if<
+        BloombergLP::bslmf::IsTransparentPredicate<COMPARATOR,
+                                                   LOOKUP_KEY>::value,
+        bool>::type
+    contains(const LOOKUP_KEY& key) const
+        // Return 'true' if this set contains a 'value_type' object equivalent
+        // to the specified 'key', and 'false' otherwise.
+        //
+        // Note: implemented inline due to Sun CC compilation error.
+    {
+        return find(key) != end();
+    }
+
     const_iterator lower_bound(const key_type& key) const
         // Return an iterator providing non-modifiable access to the first
         // (i.e., ordered least) 'value_type' object in this set greater-than
@@ -186,6 +186,7 @@
 // [33] CONCERN: Methods qualified 'noexcept' in standard are so implemented.
 // [34] CONCERN: 'find'        properly handles transparent comparators.
 // [34] CONCERN: 'count'       properly handles transparent comparators.
+// [34] CONCERN: 'contains'    properly handles transparent comparators.
 // [34] CONCERN: 'lower_bound' properly handles transparent comparators.
 // [34] CONCERN: 'upper_bound' properly handles transparent comparators.
 // [34] CONCERN: 'equal_range' properly handles transparent comparators.
@@ -188,6 +188,7 @@
 // [33] CONCERN: Methods qualified 'noexcept' in standard are so implemented.
 // [34] CONCERN: 'find'        properly handles transparent comparators.
 // [34] CONCERN: 'count'       properly handles transparent comparators.
+// [34] CONCERN: 'contains'    properly handles transparent comparators.
 // [34] CONCERN: 'lower_bound' properly handles transparent comparators.
 // [34] CONCERN: 'upper_bound' properly handles transparent comparators.
 // [34] CONCERN: 'equal_range' properly handles transparent comparators.
@@ -948,6 +949,17 @@ void testTransparentComparator(Container& container,
     ASSERT(0                       == NON_EXISTING_C);
     ASSERT(expectedConversionCount == nonExistingKey.conversionCount());
 
+    // Testing 'contains'.
+
+    ASSERT(true == container.contains(existingKey));
+    if (!isTransparent) {
+        ++expectedConversionCount;
+    }
+    ASSERT(expectedConversionCount == existingKey.conversionCount());
+
+    ASSERT(false == container.contains(nonExistingKey));
+    ASSERT(expectedConversionCount == nonExistingKey.conversionCount());
+
     // Testing 'lower_bound'.
 
     const Iterator EXISTING_LB = container.lower_bound(existingKey);
@@ -7911,6 +7923,7 @@ int main(int argc, char *argv[])
         // Testing:
         //   CONCERN: 'find'        properly handles transparent comparators
         //   CONCERN: 'count'       properly handles transparent comparators
+        //   CONCERN: 'contains'    properly handles transparent comparators
         //   CONCERN: 'lower_bound' properly handles transparent comparators
         //   CONCERN: 'upper_bound' properly handles transparent comparators
         //   CONCERN: 'equal_range' properly handles transparent comparators
@@ -294,6 +294,38 @@ class SimplePool : public SimplePool_Type<ALLOCATOR>::AllocatorType {
 
     typedef typename AllocatorTraits::size_type size_type;
 
+    class DetachedBlockProctor {
+        // This class implements a proctor that, unless 'release' is called,
+        // returns a block obtained from 'allocateDetachedBlock' to its
+        // allocator on destruction.
+
+        // DATA
+        void                 *d_block_p;    // managed block, or 0
+
+        const AllocatorType&  d_allocator;  // allocator of the block
+
+      private:
+        // NOT IMPLEMENTED
+        DetachedBlockProctor(const DetachedBlockProctor&);
+        DetachedBlockProctor& operator=(const DetachedBlockProctor&);
+
+      public:
+        // CREATORS
+        DetachedBlockProctor(void *block, const AllocatorType& allocator);
+            // Create a proctor managing the specified 'block' that was
+            // obtained from 'allocateDetachedBlock' on a pool using the
+            // specified 'allocator'.
+
+        ~DetachedBlockProctor();
+            // Return the managed block, if any, to the allocator supplied at
+            // construction.
+
+        // MANIPULATORS
+        void release();
+            // Release from management the block currently managed by this
+            // proctor.
+    };
+
   private:
     // DATA
     Chunk *d_chunkList_p;     // linked list of "chunks" of memory
@@ -320,7 +352,22 @@ class SimplePool : public SimplePool_Type<ALLOCATOR>::AllocatorType {
         // strategy, and use the chunk to replenish the free memory list of
         // this pool.
 
+    // PRIVATE CLASS METHODS
+    static size_type numMaxAlignedPerDetachedBlock();
+        // Return the number of 'bsls::AlignmentUtil::MaxAlignedType' objects
+        // needed to hold a single block allocated by 'allocateDetachedBlock'.
+
   public:
+    // CLASS METHODS
+    static void deallocateDetachedBlock(const AllocatorType&  allocator,
+                                        void                 *address);
+        // Return the memory block at the specified 'address' directly to the
+        // specified 'allocator'.  The behavior is undefined unless 'address'
+        // was obtained from 'allocateDetachedBlock' on a pool whose allocator
+        // compares equal to 'allocator', and has not already been
+        // deallocated.  Note that the pool that allocated the block need not
+        // exist any longer.
+
     // CREATORS
     explicit SimplePool(const ALLOCATOR& allocator);
         // Create a memory pool that returns blocks of contiguous memory of the
@@ -359,6 +406,14 @@ class SimplePool : public SimplePool_Type<ALLOCATOR>::AllocatorType {
         // Return the address of a block of memory of at least the size of
         // 'VALUE'.  Note that the memory is *not* initialized.
 
+    VALUE *allocateDetachedBlock();
+        // Return the address of a block of memory of at least the size of
+        // 'VALUE' that is allocated individually from the allocator of this
+        // pool rather than carved from a chunk, so that it remains valid
+        // after this pool is released or destroyed.  The block must be
+        // returned using 'deallocateDetachedBlock', and never to
+        // 'deallocate'.  Note that the memory is *not* initialized.
+
     void deallocate(void *address);
         // Relinquish the memory block at the specified 'address' back to this
         // pool object for reuse.  The behavior is undefined unless 'address'
@@ -407,6 +462,42 @@ class SimplePool : public SimplePool_Type<ALLOCATOR>::AllocatorType {
 //                  TEMPLATE AND INLINE FUNCTION DEFINITIONS
 // ============================================================================
 
+                  // ----------------------------------------
+                  // class SimplePool<>::DetachedBlockProctor
+                  // ----------------------------------------
+
+// CREATORS
+template <class VALUE, class ALLOCATOR>
+inline
+SimplePool<VALUE, ALLOCATOR>::DetachedBlockProctor::DetachedBlockProctor(
+                                              void                 *block,
+                                              const AllocatorType&  allocator)
+: d_block_p(block)
+, d_allocator(allocator)
+{
+}
+
+template <class VALUE, class ALLOCATOR>
+inline
+SimplePool<VALUE, ALLOCATOR>::DetachedBlockProctor::~DetachedBlockProctor()
+{
+    if (d_block_p) {
+        SimplePool::deallocateDetachedBlock(d_allocator, d_block_p);
+    }
+}
+
+// MANIPULATORS
+template <class VALUE, class ALLOCATOR>
+inline
+void SimplePool<VALUE, ALLOCATOR>::DetachedBlockProctor::release()
+{
+    d_block_p = 0;
+}
+
+                       // ----------------
+                       // class SimplePool
+                       // ----------------
+
 // PRIVATE MANIPULATORS
 template <class VALUE, class ALLOCATOR>
 typename SimplePool<VALUE, ALLOCATOR>::Block *
@@ -445,6 +536,33 @@ void SimplePool<VALUE, ALLOCATOR>::replenish()
     }
 }
 
+// PRIVATE CLASS METHODS
+template <class VALUE, class ALLOCATOR>
+inline
+typename SimplePool<VALUE, ALLOCATOR>::size_type
+SimplePool<VALUE, ALLOCATOR>::numMaxAlignedPerDetachedBlock()
+{
+    const size_type maxAlign = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+    return (static_cast<size_type>(sizeof(Block)) + maxAlign - 1) / maxAlign;
+}
+
+// CLASS METHODS
+template <class VALUE, class ALLOCATOR>
+inline
+void SimplePool<VALUE, ALLOCATOR>::deallocateDetachedBlock(
+                                            const AllocatorType&  allocator,
+                                            void                 *address)
+{
+    BSLS_ASSERT_SAFE(address);
+
+    AllocatorType rebound(allocator);
+    AllocatorTraits::deallocate(
+           rebound,
+           reinterpret_cast<bsls::AlignmentUtil::MaxAlignedType *>(address),
+           numMaxAlignedPerDetachedBlock());
+}
+
 // CREATORS
 template <class VALUE, class ALLOCATOR>
 inline
@@ -519,6 +637,15 @@ VALUE *SimplePool<VALUE, ALLOCATOR>::allocate()
     return block;
 }
 
+template <class VALUE, class ALLOCATOR>
+inline
+VALUE *SimplePool<VALUE, ALLOCATOR>::allocateDetachedBlock()
+{
+    return reinterpret_cast<VALUE *>(AllocatorTraits::allocate(
+                                           allocator(),
+                                           numMaxAlignedPerDetachedBlock()));
+}
+
 template <class VALUE, class ALLOCATOR>
 inline
 void SimplePool<VALUE, ALLOCATOR>::deallocate(void *address)
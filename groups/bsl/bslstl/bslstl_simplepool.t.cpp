@@ -46,6 +46,7 @@ using namespace bslstl;
 // [11] SimplePool& operator=(MovableRef<SimplePool> rhs);
 // [ 4] AllocatorType& allocator();
 // [ 2] VALUE *allocate();
+// [14] VALUE *allocateDetachedBlock();
 // [ 5] void deallocate(void *address);
 // [ 6] void reserve(size_type numBlocks);
 // [ 7] void release();
@@ -54,6 +55,9 @@ using namespace bslstl;
 // ACCESSORS
 // [ 4] const AllocatorType& allocator() const;
 // [13] bool hasFreeBlocks() const;
+//
+// CLASS METHODS
+// [14] static void deallocateDetachedBlock(const AllocatorType&, void *);
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [12] USAGE EXAMPLE
@@ -260,6 +264,9 @@ class TestDriver {
 
   public:
     // TEST CASES
+    static void testCase14();
+        // Test detached blocks.
+
     static void testCase13();
         // Test other accessors.
 
@@ -354,6 +361,109 @@ void TestDriver<VALUE>::createFreeBlocks(Obj *result, int numBlocks)
     }
 }
 
+template<class VALUE>
+void TestDriver<VALUE>::testCase14()
+{
+    // ------------------------------------------------------------------------
+    // DETACHED BLOCKS
+    //
+    // Concerns:
+    //: 1 'allocateDetachedBlock' allocates exactly one block from the
+    //:   allocator of the pool, and neither uses nor replenishes the free
+    //:   list.
+    //:
+    //: 2 The returned block is maximally aligned, and every byte of it is
+    //:   usable.
+    //:
+    //: 3 A detached block remains valid after the pool that allocated it is
+    //:   released and destroyed, and 'deallocateDetachedBlock' returns it to
+    //:   the allocator.
+    //:
+    //: 4 'DetachedBlockProctor' returns its block to the allocator unless
+    //:   'release' is called.
+    //
+    // Plan:
+    //: 1 Allocate detached blocks from a pool, verify the allocations made by
+    //:   the test allocator and the state of the free list, write to every
+    //:   byte of each block, and verify its alignment.  (C-1..2)
+    //:
+    //: 2 Destroy the pool, then deallocate the blocks and verify that no
+    //:   memory remains in use.  (C-3)
+    //:
+    //: 3 Create proctors for detached blocks, releasing one of them, and
+    //:   verify the blocks in use after the proctors are destroyed.  (C-4)
+    //
+    // Testing:
+    //   VALUE *allocateDetachedBlock();
+    //   static void deallocateDetachedBlock(const AllocatorType&, void *);
+    // ------------------------------------------------------------------------
+
+    if (verbose) printf("\nDETACHED BLOCKS"
+                        "\n===============\n");
+
+    enum { k_NUM_BLOCKS = 4 };
+
+    bslma::TestAllocator da("default",  veryVeryVeryVerbose);
+    bslma::TestAllocator oa("supplied", veryVeryVeryVerbose);
+
+    bslma::DefaultAllocatorGuard dag(&da);
+
+    const typename Obj::AllocatorType ALLOC(&oa);
+
+    VALUE *blocks[k_NUM_BLOCKS];
+    {
+        Obj mX(&oa);  const Obj& X = mX;
+
+        VALUE *pooled = mX.allocate();
+        ASSERT(1 == oa.numBlocksInUse());
+
+        for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+            bslma::TestAllocatorMonitor oam(&oa);
+
+            blocks[i] = mX.allocateDetachedBlock();
+            ASSERTV(i, blocks[i]);
+            ASSERTV(i, 1 == oam.numBlocksInUseChange());
+            ASSERTV(i, false == X.hasFreeBlocks());
+            ASSERTV(i, 0 == bsls::AlignmentUtil::calculateAlignmentOffset(
+                                    blocks[i],
+                                    bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT));
+
+            memset(static_cast<void *>(blocks[i]), 0xa5, sizeof(VALUE));
+        }
+
+        mX.deallocate(pooled);
+        mX.release();
+        ASSERTV(oa.numBlocksInUse(), k_NUM_BLOCKS == oa.numBlocksInUse());
+    }
+    ASSERTV(oa.numBlocksInUse(), k_NUM_BLOCKS == oa.numBlocksInUse());
+
+    for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+        Obj::deallocateDetachedBlock(ALLOC, blocks[i]);
+    }
+    ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+
+    if (verbose) printf("\tTesting 'DetachedBlockProctor'.\n");
+    {
+        Obj mX(&oa);
+
+        VALUE *kept = mX.allocateDetachedBlock();
+        {
+            typename Obj::DetachedBlockProctor proctor(
+                                                 mX.allocateDetachedBlock(),
+                                                 ALLOC);
+            typename Obj::DetachedBlockProctor releasedProctor(kept, ALLOC);
+            releasedProctor.release();
+
+            ASSERTV(oa.numBlocksInUse(), 2 == oa.numBlocksInUse());
+        }
+        ASSERTV(oa.numBlocksInUse(), 1 == oa.numBlocksInUse());
+
+        Obj::deallocateDetachedBlock(ALLOC, kept);
+    }
+    ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+    ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+}
+
 template<class VALUE>
 void TestDriver<VALUE>::testCase13()
 {
@@ -1605,6 +1715,14 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:
+      case 14: {
+        // --------------------------------------------------------------------
+        // DETACHED BLOCKS
+        // --------------------------------------------------------------------
+
+        RUN_EACH_TYPE(TestDriver, testCase14, TEST_TYPES);
+
+      } break;
       case 13: {
         // --------------------------------------------------------------------
         // OTHER ACCESSORS
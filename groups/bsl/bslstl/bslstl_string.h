@@ -618,6 +618,7 @@ BSL_OVERRIDES_STD mode"
 #include <bslstl_iterator.h>
 #include <bslstl_stdexceptutil.h>
 #include <bslstl_stringrefdata.h>
+#include <bslstl_stringsearchutil.h>
 #include <bslstl_stringview.h>
 
 #include <bslalg_containerbase.h>
@@ -1058,6 +1059,14 @@ class basic_string
 
     typedef BloombergLP::bslalg::ContainerBase<ALLOCATOR>        ContainerBase;
 
+    typedef BloombergLP::bslstl::StringSearchUtil                SearchUtil;
+
+    typedef BloombergLP::bslstl::StringSearchUtil_IsAccelerated<CHAR_TYPE,
+                                                                CHAR_TRAITS>
+                                                           IsSearchAccelerated;
+        // 'IsSearchAccelerated::value' is non-zero if this string can be
+        // searched using the vectorized functions of 'SearchUtil'.
+
     // FRIENDS
     friend string to_string(int);
     friend string to_string(long);
@@ -5419,6 +5428,15 @@ basic_string<CHAR_TYPE,CHAR_TRAITS,ALLOCATOR>::find(
     if (0 == numChars) {
         return position;                                              // RETURN
     }
+    if (IsSearchAccelerated::value) {
+        const char *data   = reinterpret_cast<const char *>(this->dataPtr());
+        const char *result = SearchUtil::find(
+                                     data + position,
+                                     remChars,
+                                     reinterpret_cast<const char *>(substring),
+                                     numChars);
+        return result ? result - data : npos;                         // RETURN
+    }
     const CHAR_TYPE *thisString = this->dataPtr() + position;
     const CHAR_TYPE *nextString;
     for (remChars -= numChars - 1;
@@ -5545,6 +5563,15 @@ basic_string<CHAR_TYPE,CHAR_TRAITS,ALLOCATOR>::find_first_of(
 {
     BSLS_ASSERT_SAFE(characterString || 0 == numChars);
 
+    if (IsSearchAccelerated::value && position < length()) {
+        const char *data   = reinterpret_cast<const char *>(this->dataPtr());
+        const char *result = SearchUtil::findFirstOf(
+                               data + position,
+                               length() - position,
+                               reinterpret_cast<const char *>(characterString),
+                               numChars);
+        return result ? result - data : npos;                         // RETURN
+    }
     if (0 < numChars && position < length()) {
         for (const CHAR_TYPE *current = this->dataPtr() + position;
              current != this->dataPtr() + length();
@@ -5669,6 +5696,15 @@ basic_string<CHAR_TYPE,CHAR_TRAITS,ALLOCATOR>::find_first_not_of(
 {
     BSLS_ASSERT_SAFE(characterString || 0 == numChars);
 
+    if (IsSearchAccelerated::value && position < length()) {
+        const char *data   = reinterpret_cast<const char *>(this->dataPtr());
+        const char *result = SearchUtil::findFirstNotOf(
+                               data + position,
+                               length() - position,
+                               reinterpret_cast<const char *>(characterString),
+                               numChars);
+        return result ? result - data : npos;                         // RETURN
+    }
     if (position < length()) {
         const CHAR_TYPE *last = this->dataPtr() + length();
         for (const CHAR_TYPE *current = this->dataPtr() + position;
@@ -0,0 +1,536 @@
+// bslstl_stringsearchutil.cpp                                        -*-C++-*-
+#include <bslstl_stringsearchutil.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id$ $CSID$")
+
+#include <bsls_assert.h>
+#include <bsls_atomicoperations.h>
+#include <bsls_platform.h>
+
+#include <cstring>
+
+#if defined(BSLS_PLATFORM_CPU_X86_64)                                         \
+ && (defined(BSLS_PLATFORM_CMP_CLANG)                                         \
+  || (defined(BSLS_PLATFORM_CMP_GNU) && BSLS_PLATFORM_CMP_VERSION >= 40900))
+#define BSLSTL_STRINGSEARCHUTIL_X86 1
+    // The vectorized implementations are compiled for the instruction sets
+    // named by the 'target' attributes of their functions, irrespective of
+    // the instruction set selected for the rest of the translation unit, and
+    // are called only if the processor supports these instruction sets.
+
+#include <immintrin.h>
+#endif
+
+namespace BloombergLP {
+
+namespace {
+
+typedef bslstl::StringSearchUtil::size_type size_type;
+
+                             // =================
+                             // class NibbleTable
+                             // =================
+
+class NibbleTable {
+    // This class implements a set of characters as two 16-entry tables
+    // indexed by the low four bits of a character, in which the bit 'i' of
+    // entry 'j' of the first table indicates whether the character having
+    // the value '16 * i + j' belongs to the set, and the bit 'i' of entry 'j'
+    // of the second table whether the character having the value
+    // '16 * (i + 8) + j' belongs to the set.  This representation can be
+    // searched 16 or 32 characters at a time using byte shuffles.
+
+    // DATA
+    unsigned char d_low[16];   // characters '0x00' to '0x7f'
+    unsigned char d_high[16];  // characters '0x80' to '0xff'
+
+  public:
+    // CREATORS
+    NibbleTable(const char *characters, size_type numChars)
+        // Create a table holding the specified 'numChars' 'characters'.
+    {
+        std::memset(d_low,  0, sizeof d_low);
+        std::memset(d_high, 0, sizeof d_high);
+
+        for (size_type i = 0; i < numChars; ++i) {
+            const unsigned char c = static_cast<unsigned char>(characters[i]);
+            if (c < 0x80) {
+                d_low[c & 0x0f]  |= static_cast<unsigned char>(1 << (c >> 4));
+            }
+            else {
+                d_high[c & 0x0f] |= static_cast<unsigned char>(
+                                                         1 << ((c >> 4) - 8));
+            }
+        }
+    }
+
+    // ACCESSORS
+    bool contains(char character) const
+        // Return 'true' if the specified 'character' belongs to this set, and
+        // 'false' otherwise.
+    {
+        const unsigned char c = static_cast<unsigned char>(character);
+        return c < 0x80 ? (d_low[c & 0x0f]  >> (c >> 4)) & 1
+                        : (d_high[c & 0x0f] >> ((c >> 4) - 8)) & 1;
+    }
+
+    const unsigned char *high() const
+        // Return the address of the table of the characters '0x80' to '0xff'.
+    {
+        return d_high;
+    }
+
+    const unsigned char *low() const
+        // Return the address of the table of the characters '0x00' to '0x7f'.
+    {
+        return d_low;
+    }
+};
+
+                        // ========================
+                        // portable implementations
+                        // ========================
+
+const char *findPortable(const char *string,
+                         size_type   length,
+                         const char *substring,
+                         size_type   numChars)
+    // Return the address of the first occurrence, in the specified 'string'
+    // having the specified 'length', of the specified 'substring' having the
+    // specified '2 <= numChars', or 0 if there is no such occurrence.
+{
+    if (numChars > length) {
+        return 0;                                                     // RETURN
+    }
+
+    const char *current = string;
+    size_type   numPositions = length - numChars + 1;
+
+    while (numPositions) {
+        const char *candidate = static_cast<const char *>(
+                              std::memchr(current, *substring, numPositions));
+        if (!candidate) {
+            return 0;                                                 // RETURN
+        }
+        if (0 == std::memcmp(candidate + 1, substring + 1, numChars - 1)) {
+            return candidate;                                         // RETURN
+        }
+        numPositions -= candidate + 1 - current;
+        current       = candidate + 1;
+    }
+    return 0;
+}
+
+const char *findInSetPortable(const char         *string,
+                              size_type           length,
+                              const NibbleTable&  table,
+                              bool                isMember)
+    // Return the address of the first character, in the specified 'string'
+    // having the specified 'length', whose membership in the specified
+    // 'table' is the specified 'isMember', or 0 if there is no such
+    // character.
+{
+    const char *end = string + length;
+    for (; string != end; ++string) {
+        if (table.contains(*string) == isMember) {
+            return string;                                            // RETURN
+        }
+    }
+    return 0;
+}
+
+#ifdef BSLSTL_STRINGSEARCHUTIL_X86
+
+                         // ======================
+                         // SSE4.2 implementations
+                         // ======================
+
+__attribute__((target("sse4.2")))
+inline
+__m128i loadSse42(const void *address)
+    // Return the 16 bytes at the specified 'address', which need not be
+    // aligned.
+{
+    return _mm_loadu_si128(static_cast<const __m128i *>(address));
+}
+
+__attribute__((target("sse4.2")))
+inline
+__m128i matchSse42(__m128i block, __m128i low, __m128i high, __m128i bits)
+    // Return a vector whose bytes are all ones at the positions of the
+    // characters of the specified 'block' belonging to the set represented by
+    // the specified 'low' and 'high' tables, and zero elsewhere, using the
+    // specified 'bits' holding the powers of two '1, 2, ..., 128' twice.
+{
+    const __m128i lowNibbles  = _mm_and_si128(block, _mm_set1_epi8(0x0f));
+    const __m128i highNibbles = _mm_and_si128(_mm_srli_epi16(block, 4),
+                                              _mm_set1_epi8(0x0f));
+
+    // Select the table entry of each character, from the 'high' table if the
+    // most significant bit of the character is set, and then the bit of the
+    // entry corresponding to the high nibble of the character.
+
+    const __m128i rows = _mm_blendv_epi8(_mm_shuffle_epi8(low, lowNibbles),
+                                         _mm_shuffle_epi8(high, lowNibbles),
+                                         block);
+    const __m128i bit  = _mm_shuffle_epi8(bits, highNibbles);
+
+    return _mm_cmpeq_epi8(_mm_and_si128(rows, bit), bit);
+}
+
+__attribute__((target("sse4.2")))
+const char *findSse42(const char *string,
+                      size_type   length,
+                      const char *substring,
+                      size_type   numChars)
+    // Return the address of the first occurrence, in the specified 'string'
+    // having the specified 'length', of the specified 'substring' having the
+    // specified '2 <= numChars', or 0 if there is no such occurrence.
+{
+    if (numChars > length) {
+        return 0;                                                     // RETURN
+    }
+
+    const size_type numPositions = length - numChars + 1;
+    const __m128i   first = _mm_set1_epi8(substring[0]);
+    const __m128i   last  = _mm_set1_epi8(substring[numChars - 1]);
+
+    size_type i = 0;
+    for (; i + 16 <= numPositions; i += 16) {
+        const __m128i firstBlock = loadSse42(string + i);
+        const __m128i lastBlock  = loadSse42(string + i + numChars - 1);
+
+        unsigned mask = _mm_movemask_epi8(
+                            _mm_and_si128(_mm_cmpeq_epi8(first, firstBlock),
+                                          _mm_cmpeq_epi8(last,  lastBlock)));
+        while (mask) {
+            const char *candidate = string + i + __builtin_ctz(mask);
+            if (0 == std::memcmp(candidate + 1,
+                                 substring + 1,
+                                 numChars - 2)) {
+                return candidate;                                     // RETURN
+            }
+            mask &= mask - 1;
+        }
+    }
+    return findPortable(string + i, length - i, substring, numChars);
+}
+
+__attribute__((target("sse4.2")))
+const char *findInSetSse42(const char         *string,
+                           size_type           length,
+                           const NibbleTable&  table,
+                           bool                isMember)
+    // Return the address of the first character, in the specified 'string'
+    // having the specified 'length', whose membership in the specified
+    // 'table' is the specified 'isMember', or 0 if there is no such
+    // character.
+{
+    const __m128i low  = loadSse42(table.low());
+    const __m128i high = loadSse42(table.high());
+    const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128,
+                                       1, 2, 4, 8, 16, 32, 64, -128);
+    const unsigned flip = isMember ? 0 : 0xffff;
+
+    size_type i = 0;
+    for (; i + 16 <= length; i += 16) {
+        const __m128i block = loadSse42(string + i);
+
+        const unsigned mask = flip ^ static_cast<unsigned>(_mm_movemask_epi8(
+                                        matchSse42(block, low, high, bits)));
+        if (mask) {
+            return string + i + __builtin_ctz(mask);                  // RETURN
+        }
+    }
+    return findInSetPortable(string + i, length - i, table, isMember);
+}
+
+                          // ====================
+                          // AVX2 implementations
+                          // ====================
+
+__attribute__((target("avx2")))
+inline
+__m256i loadAvx2(const void *address)
+    // Return the 32 bytes at the specified 'address', which need not be
+    // aligned.
+{
+    return _mm256_loadu_si256(static_cast<const __m256i *>(address));
+}
+
+__attribute__((target("avx2")))
+inline
+__m256i matchAvx2(__m256i block, __m256i low, __m256i high, __m256i bits)
+    // Return a vector whose bytes are all ones at the positions of the
+    // characters of the specified 'block' belonging to the set represented by
+    // the specified 'low' and 'high' tables, and zero elsewhere, using the
+    // specified 'bits' holding the powers of two '1, 2, ..., 128' four times.
+    // The behavior is undefined unless both 128-bit lanes of 'low' and of
+    // 'high' hold the same table.
+{
+    const __m256i lowNibbles  = _mm256_and_si256(block,
+                                                 _mm256_set1_epi8(0x0f));
+    const __m256i highNibbles = _mm256_and_si256(_mm256_srli_epi16(block, 4),
+                                                 _mm256_set1_epi8(0x0f));
+
+    const __m256i rows = _mm256_blendv_epi8(
+                                        _mm256_shuffle_epi8(low,  lowNibbles),
+                                        _mm256_shuffle_epi8(high, lowNibbles),
+                                        block);
+    const __m256i bit  = _mm256_shuffle_epi8(bits, highNibbles);
+
+    return _mm256_cmpeq_epi8(_mm256_and_si256(rows, bit), bit);
+}
+
+__attribute__((target("avx2")))
+const char *findAvx2(const char *string,
+                     size_type   length,
+                     const char *substring,
+                     size_type   numChars)
+    // Return the address of the first occurrence, in the specified 'string'
+    // having the specified 'length', of the specified 'substring' having the
+    // specified '2 <= numChars', or 0 if there is no such occurrence.
+{
+    if (numChars > length) {
+        return 0;                                                     // RETURN
+    }
+
+    const size_type numPositions = length - numChars + 1;
+    const __m256i   first = _mm256_set1_epi8(substring[0]);
+    const __m256i   last  = _mm256_set1_epi8(substring[numChars - 1]);
+
+    size_type i = 0;
+    for (; i + 32 <= numPositions; i += 32) {
+        const __m256i firstBlock = loadAvx2(string + i);
+        const __m256i lastBlock  = loadAvx2(string + i + numChars - 1);
+
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                     _mm256_and_si256(_mm256_cmpeq_epi8(first, firstBlock),
+                                      _mm256_cmpeq_epi8(last,  lastBlock))));
+        while (mask) {
+            const char *candidate = string + i + __builtin_ctz(mask);
+            if (0 == std::memcmp(candidate + 1,
+                                 substring + 1,
+                                 numChars - 2)) {
+                return candidate;                                     // RETURN
+            }
+            mask &= mask - 1;
+        }
+    }
+    return findSse42(string + i, length - i, substring, numChars);
+}
+
+__attribute__((target("avx2")))
+const char *findInSetAvx2(const char         *string,
+                          size_type           length,
+                          const NibbleTable&  table,
+                          bool                isMember)
+    // Return the address of the first character, in the specified 'string'
+    // having the specified 'length', whose membership in the specified
+    // 'table' is the specified 'isMember', or 0 if there is no such
+    // character.
+{
+    const __m256i low  = _mm256_broadcastsi128_si256(loadSse42(table.low()));
+    const __m256i high = _mm256_broadcastsi128_si256(
+                                                    loadSse42(table.high()));
+    const __m256i bits = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128,
+                                          1, 2, 4, 8, 16, 32, 64, -128,
+                                          1, 2, 4, 8, 16, 32, 64, -128,
+                                          1, 2, 4, 8, 16, 32, 64, -128);
+    const unsigned flip = isMember ? 0 : 0xffffffffu;
+
+    size_type i = 0;
+    for (; i + 32 <= length; i += 32) {
+        const __m256i block = loadAvx2(string + i);
+
+        const unsigned mask = flip ^ static_cast<unsigned>(
+                     _mm256_movemask_epi8(matchAvx2(block, low, high, bits)));
+        if (mask) {
+            return string + i + __builtin_ctz(mask);                  // RETURN
+        }
+    }
+    return findInSetSse42(string + i, length - i, table, isMember);
+}
+
+#endif  // BSLSTL_STRINGSEARCHUTIL_X86
+
+                          // ====================
+                          // instruction set data
+                          // ====================
+
+bsls::AtomicOperations::AtomicTypes::Int s_instructionSet = { -1 };
+    // instruction set of the implementations in use, or -1 if not yet
+    // determined
+
+inline
+bslstl::StringSearchUtil::InstructionSet selectedInstructionSet()
+    // Return the instruction set of the implementations in use, determining
+    // it if necessary.
+{
+    const int value = bsls::AtomicOperations::getIntRelaxed(&s_instructionSet);
+    if (value >= 0) {
+        return static_cast<bslstl::StringSearchUtil::InstructionSet>(value);
+                                                                      // RETURN
+    }
+
+    typedef bslstl::StringSearchUtil Util;
+
+    const Util::InstructionSet supported = Util::supportedInstructionSet();
+    bsls::AtomicOperations::setIntRelaxed(&s_instructionSet, supported);
+    return supported;
+}
+
+const char *findInSet(const char         *string,
+                      size_type           length,
+                      const NibbleTable&  table,
+                      bool                isMember)
+    // Return the address of the first character, in the specified 'string'
+    // having the specified 'length', whose membership in the specified
+    // 'table' is the specified 'isMember', or 0 if there is no such
+    // character.
+{
+#ifdef BSLSTL_STRINGSEARCHUTIL_X86
+    switch (selectedInstructionSet()) {
+      case bslstl::StringSearchUtil::e_AVX2: {
+        return findInSetAvx2(string, length, table, isMember);        // RETURN
+      }
+      case bslstl::StringSearchUtil::e_SSE42: {
+        return findInSetSse42(string, length, table, isMember);       // RETURN
+      }
+      default: {
+      } break;
+    }
+#endif
+    return findInSetPortable(string, length, table, isMember);
+}
+
+}  // close unnamed namespace
+
+namespace bslstl {
+
+                           // -----------------------
+                           // struct StringSearchUtil
+                           // -----------------------
+
+// CLASS METHODS
+const char *StringSearchUtil::find(const char *string,
+                                   size_type   length,
+                                   const char *substring,
+                                   size_type   numChars)
+{
+    BSLS_ASSERT_SAFE(string    || 0 == length);
+    BSLS_ASSERT_SAFE(substring || 0 == numChars);
+
+    if (0 == numChars) {
+        return string;                                                // RETURN
+    }
+    if (numChars > length) {
+        return 0;                                                     // RETURN
+    }
+    if (1 == numChars) {
+        return static_cast<const char *>(std::memchr(string,
+                                                     *substring,
+                                                     length));        // RETURN
+    }
+
+#ifdef BSLSTL_STRINGSEARCHUTIL_X86
+    switch (selectedInstructionSet()) {
+      case e_AVX2: {
+        return findAvx2(string, length, substring, numChars);         // RETURN
+      }
+      case e_SSE42: {
+        return findSse42(string, length, substring, numChars);        // RETURN
+      }
+      default: {
+      } break;
+    }
+#endif
+    return findPortable(string, length, substring, numChars);
+}
+
+const char *StringSearchUtil::findFirstNotOf(const char *string,
+                                             size_type   length,
+                                             const char *characters,
+                                             size_type   numChars)
+{
+    BSLS_ASSERT_SAFE(string     || 0 == length);
+    BSLS_ASSERT_SAFE(characters || 0 == numChars);
+
+    if (0 == length) {
+        return 0;                                                     // RETURN
+    }
+    if (0 == numChars) {
+        return string;                                                // RETURN
+    }
+
+    return findInSet(string, length, NibbleTable(characters, numChars), false);
+}
+
+const char *StringSearchUtil::findFirstOf(const char *string,
+                                          size_type   length,
+                                          const char *characters,
+                                          size_type   numChars)
+{
+    BSLS_ASSERT_SAFE(string     || 0 == length);
+    BSLS_ASSERT_SAFE(characters || 0 == numChars);
+
+    if (0 == length || 0 == numChars) {
+        return 0;                                                     // RETURN
+    }
+    if (1 == numChars) {
+        return static_cast<const char *>(std::memchr(string,
+                                                     *characters,
+                                                     length));        // RETURN
+    }
+
+    return findInSet(string, length, NibbleTable(characters, numChars), true);
+}
+
+StringSearchUtil::InstructionSet StringSearchUtil::instructionSet()
+{
+    return selectedInstructionSet();
+}
+
+void StringSearchUtil::setInstructionSet(InstructionSet value)
+{
+    const InstructionSet supported = supportedInstructionSet();
+
+    bsls::AtomicOperations::setIntRelaxed(&s_instructionSet,
+                                          value < supported ? value
+                                                            : supported);
+}
+
+StringSearchUtil::InstructionSet StringSearchUtil::supportedInstructionSet()
+{
+#ifdef BSLSTL_STRINGSEARCHUTIL_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        return e_AVX2;                                                // RETURN
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return e_SSE42;                                               // RETURN
+    }
+#endif
+    return e_PORTABLE;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,253 @@
+// bslstl_stringsearchutil.h                                          -*-C++-*-
+#ifndef INCLUDED_BSLSTL_STRINGSEARCHUTIL
+#define INCLUDED_BSLSTL_STRINGSEARCHUTIL
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide vectorized search primitives for 'char' strings.
+//
+//@CLASSES:
+//  bslstl::StringSearchUtil: namespace for vectorized 'char' string searches
+//  bslstl::StringSearchUtil_IsAccelerated: trait for accelerated strings
+//
+//@SEE_ALSO: bslstl_string, bslstl_boyermoorehorspoolsearcher
+//
+//@DESCRIPTION: This component provides a 'struct',
+// 'bslstl::StringSearchUtil', that serves as a namespace for functions
+// searching ranges of 'char' for a substring ('find'), for the first
+// character belonging to a set of characters ('findFirstOf'), and for the
+// first character not belonging to a set of characters ('findFirstNotOf').
+// These functions implement the 'char' specializations of the corresponding
+// 'bsl::basic_string' methods, and may be used directly to search any
+// contiguous range of characters, such as the one referred to by a
+// 'bslstl::StringRef'.
+//
+///Instruction Sets
+///----------------
+// On x86-64 platforms built with GCC or Clang, each function has three
+// implementations, which are selected at run time, on first use, according to
+// the instruction set supported by the processor:
+//
+//: 'e_AVX2':
+//:   Examines 32 characters per iteration using AVX2 instructions.
+//:
+//: 'e_SSE42':
+//:   Examines 16 characters per iteration using SSE4.2 (and earlier)
+//:   instructions.
+//:
+//: 'e_PORTABLE':
+//:   Examines one character per iteration (after locating candidate
+//:   positions with 'memchr' where applicable), and is the only
+//:   implementation on other platforms.
+//
+// The substring search compares, in each iteration, the first and the last
+// characters of the substring with a block of candidate positions, and fully
+// compares only those positions at which both match.  The character set
+// searches look up every character of a block in a 16-entry table indexed by
+// the low four bits of the character, so that their cost does not depend on
+// the number of characters in the set.  None of the functions allocates
+// memory or builds a table whose size depends on the searched string.
+//
+// The selected instruction set can be obtained with 'instructionSet', and can
+// be restricted with 'setInstructionSet', which is intended for testing and
+// benchmarking.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Tokenizing a Message
+///- - - - - - - - - - - - - - - -
+// Suppose that we are parsing messages consisting of fields separated by any
+// of several delimiters, and that the messages are provided as ranges of
+// characters that are not null-terminated.
+//
+// First, we define a function that counts the fields of a message, skipping
+// leading delimiters and then searching for the end of each field:
+//..
+//  int countFields(const char *message, bsl::size_t length)
+//      // Return the number of fields in the specified 'message' having the
+//      // specified 'length', where fields are separated by one or more of the
+//      // characters ' ', ',', ';', and '|'.
+//  {
+//      static const char  delimiters[]  = " ,;|";
+//      const bsl::size_t  numDelimiters = sizeof delimiters - 1;
+//      const char        *end           = message + length;
+//      int                numFields     = 0;
+//
+//      while (message != end) {
+//          const char *field = bslstl::StringSearchUtil::findFirstNotOf(
+//                                                             message,
+//                                                             end - message,
+//                                                             delimiters,
+//                                                             numDelimiters);
+//          if (!field) {
+//              break;
+//          }
+//          ++numFields;
+//
+//          message = bslstl::StringSearchUtil::findFirstOf(field,
+//                                                          end - field,
+//                                                          delimiters,
+//                                                          numDelimiters);
+//          if (!message) {
+//              break;
+//          }
+//      }
+//      return numFields;
+//  }
+//..
+// Then, we count the fields of a message:
+//..
+//  const char MESSAGE[] = "  ORDER|IBM, 100;  BUY ||| 131.25 ";
+//
+//  assert(5 == countFields(MESSAGE, sizeof MESSAGE - 1));
+//..
+// Finally, we search the message for a substring:
+//..
+//  const char *buy = bslstl::StringSearchUtil::find(MESSAGE,
+//                                                   sizeof MESSAGE - 1,
+//                                                   "BUY",
+//                                                   3);
+//  assert(MESSAGE + 19 == buy);
+//
+//  assert(0 == bslstl::StringSearchUtil::find(MESSAGE,
+//                                             sizeof MESSAGE - 1,
+//                                             "SELL",
+//                                             4));
+//..
+
+// Prevent 'bslstl' headers from being included directly in 'BSL_OVERRIDES_STD'
+// mode.  Doing so is unsupported, and is likely to cause compilation errors.
+#if defined(BSL_OVERRIDES_STD) && !defined(BOS_STDHDRS_PROLOGUE_IN_EFFECT)
+#error "include <bsl_string.h> instead of <bslstl_stringsearchutil.h> in \
+BSL_OVERRIDES_STD mode"
+#endif
+#include <bslscm_version.h>
+
+#include <bsls_nativestd.h>
+
+#include <cstddef>  // for 'native_std::size_t'
+#include <iosfwd>   // for 'native_std::char_traits'
+
+namespace BloombergLP {
+namespace bslstl {
+
+                           // =======================
+                           // struct StringSearchUtil
+                           // =======================
+
+struct StringSearchUtil {
+    // This 'struct' provides a namespace for functions searching ranges of
+    // 'char' using the widest vector instructions supported by the processor.
+
+    // TYPES
+    typedef native_std::size_t size_type;
+
+    enum InstructionSet {
+        // This enumeration defines the implementations of the functions of
+        // this 'struct', in increasing order of vector width.
+
+        e_PORTABLE,  // one character at a time
+        e_SSE42,     // 16 characters at a time
+        e_AVX2       // 32 characters at a time
+    };
+
+    // CLASS METHODS
+    static const char *find(const char *string,
+                            size_type   length,
+                            const char *substring,
+                            size_type   numChars);
+        // Return the address of the first occurrence, in the specified
+        // 'string' having the specified 'length', of the specified 'substring'
+        // having the specified 'numChars', or 0 if 'substring' does not occur
+        // in 'string'.  Return 'string' if '0 == numChars'.  The behavior is
+        // undefined unless 'string' refers to at least 'length' characters
+        // (or '0 == length') and 'substring' refers to at least 'numChars'
+        // characters (or '0 == numChars').
+
+    static const char *findFirstNotOf(const char *string,
+                                      size_type   length,
+                                      const char *characters,
+                                      size_type   numChars);
+        // Return the address of the first character, in the specified
+        // 'string' having the specified 'length', that is not equal to any of
+        // the specified 'numChars' 'characters', or 0 if there is no such
+        // character.  The behavior is undefined unless 'string' refers to at
+        // least 'length' characters (or '0 == length') and 'characters' refers
+        // to at least 'numChars' characters (or '0 == numChars').
+
+    static const char *findFirstOf(const char *string,
+                                   size_type   length,
+                                   const char *characters,
+                                   size_type   numChars);
+        // Return the address of the first character, in the specified
+        // 'string' having the specified 'length', that is equal to one of the
+        // specified 'numChars' 'characters', or 0 if there is no such
+        // character.  The behavior is undefined unless 'string' refers to at
+        // least 'length' characters (or '0 == length') and 'characters' refers
+        // to at least 'numChars' characters (or '0 == numChars').
+
+    static InstructionSet instructionSet();
+        // Return the instruction set of the implementation currently used by
+        // the functions of this 'struct'.  Unless restricted by
+        // 'setInstructionSet', this is the widest instruction set supported
+        // by the processor.
+
+    static void setInstructionSet(InstructionSet value);
+        // Use the implementation of the functions of this 'struct' having the
+        // specified instruction set 'value', or, if 'value' is not supported
+        // by the processor, the implementation having the widest instruction
+        // set that is supported.  Note that this function is intended for
+        // testing and benchmarking, and should not be called while another
+        // thread is using this 'struct'.
+
+    static InstructionSet supportedInstructionSet();
+        // Return the widest instruction set supported by the processor for
+        // which this 'struct' has an implementation.
+};
+
+                   // =====================================
+                   // struct StringSearchUtil_IsAccelerated
+                   // =====================================
+
+template <class CHAR_TYPE, class CHAR_TRAITS>
+struct StringSearchUtil_IsAccelerated {
+    // This component-private 'struct' defines an enumerator, 'value', that is
+    // non-zero if strings having the (template parameter) types 'CHAR_TYPE'
+    // and 'CHAR_TRAITS' can be searched by the functions of
+    // 'StringSearchUtil', and zero otherwise.
+
+    enum { value = 0 };
+};
+
+template <>
+struct StringSearchUtil_IsAccelerated<char, native_std::char_traits<char> > {
+    // This specialization indicates that strings of 'char' compared by the
+    // standard character traits can be searched by the functions of
+    // 'StringSearchUtil'.
+
+    enum { value = 1 };
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
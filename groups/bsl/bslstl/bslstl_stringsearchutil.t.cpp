@@ -0,0 +1,950 @@
+// bslstl_stringsearchutil.t.cpp                                      -*-C++-*-
+#include <bslstl_stringsearchutil.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_bsltestutil.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <cstddef>    // for 'native_std::size_t'
+#include <cstdlib>    // for 'native_std::atoi', 'native_std::rand'
+#include <cstring>    // for 'native_std::memcmp', 'native_std::strlen'
+#include <string>     // for 'native_std::char_traits'
+
+#include <stdio.h>    // for 'printf'
+
+using namespace BloombergLP;
+namespace bsl = native_std;  // for usage example
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                             Overview
+//                             --------
+// The component under test provides three search functions, each having a
+// portable implementation and, on x86-64 platforms, implementations using
+// SSE4.2 and AVX2 instructions.  All implementations supported by the
+// processor running the test are exercised by selecting them in turn with
+// 'setInstructionSet', and their results are compared with those of simple
+// reference implementations defined in this test driver.  The searched
+// strings are allocated with 'new' at their exact length, so that a read
+// beyond their end is detected by memory checkers.  The strings are drawn from
+// small alphabets including characters having the most significant bit set,
+// so that matches, partial matches, and sign-extension errors are frequent.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 3] const char *find(const char *, size_type, const char *, ...);
+// [ 5] const char *findFirstNotOf(const char *, size_type, ...);
+// [ 4] const char *findFirstOf(const char *, size_type, ...);
+// [ 2] InstructionSet instructionSet();
+// [ 2] void setInstructionSet(InstructionSet value);
+// [ 2] InstructionSet supportedInstructionSet();
+//
+// TRAITS
+// [ 6] StringSearchUtil_IsAccelerated<CHAR_TYPE, CHAR_TRAITS>
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 7] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST
+// ----------------------------------------------------------------------------
+
+// ============================================================================
+//                     STANDARD BSL ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", line, message);
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                       STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define Q   BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P   BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_  BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_  BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_  BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+
+// ============================================================================
+//                      GLOBAL TYPEDEFS AND CONSTANTS
+// ----------------------------------------------------------------------------
+
+typedef bslstl::StringSearchUtil Util;
+typedef Util::size_type          size_type;
+
+static const Util::InstructionSet INSTRUCTION_SETS[] = {
+    Util::e_PORTABLE,
+    Util::e_SSE42,
+    Util::e_AVX2
+};
+static const int NUM_INSTRUCTION_SETS = sizeof INSTRUCTION_SETS
+                                      / sizeof *INSTRUCTION_SETS;
+
+static const char *const INSTRUCTION_SET_NAMES[] = {
+    "portable",
+    "SSE4.2",
+    "AVX2"
+};
+
+struct UserTraits : native_std::char_traits<char> {
+    // This 'struct' provides user-defined character traits for 'char', for
+    // which the functions of the component under test must not be used.
+};
+
+// ============================================================================
+//                          HELPER FUNCTIONS
+// ----------------------------------------------------------------------------
+
+static
+const char *findOracle(const char *string,
+                       size_type   length,
+                       const char *substring,
+                       size_type   numChars)
+    // Return the address of the first occurrence, in the specified 'string'
+    // having the specified 'length', of the specified 'substring' having the
+    // specified 'numChars', or 0 if there is no such occurrence, examining
+    // every position of 'string'.
+{
+    if (0 == numChars) {
+        return string;                                                // RETURN
+    }
+    for (size_type i = 0; i + numChars <= length; ++i) {
+        if (0 == native_std::memcmp(string + i, substring, numChars)) {
+            return string + i;                                        // RETURN
+        }
+    }
+    return 0;
+}
+
+static
+const char *findInSetOracle(const char *string,
+                            size_type   length,
+                            const char *characters,
+                            size_type   numChars,
+                            bool        isMember)
+    // Return the address of the first character, in the specified 'string'
+    // having the specified 'length', that is equal to one of the specified
+    // 'numChars' 'characters' if the specified 'isMember' is 'true', and that
+    // is equal to none of them otherwise, or 0 if there is no such character.
+{
+    for (size_type i = 0; i < length; ++i) {
+        bool found = false;
+        for (size_type j = 0; j < numChars; ++j) {
+            found = found || string[i] == characters[j];
+        }
+        if (found == isMember) {
+            return string + i;                                        // RETURN
+        }
+    }
+    return 0;
+}
+
+                              // ================
+                              // class TestString
+                              // ================
+
+class TestString {
+    // This class owns a string allocated at its exact length, so that any
+    // read beyond its end can be detected by memory checkers.
+
+    // DATA
+    char      *d_data_p;  // owned characters, or 0 if empty
+    size_type  d_length;  // number of characters
+
+  private:
+    // NOT IMPLEMENTED
+    TestString(const TestString&);
+    TestString& operator=(const TestString&);
+
+  public:
+    // CREATORS
+    TestString(const char *alphabet, size_type length)
+        // Create a string of the specified 'length' characters drawn at
+        // random from the specified null-terminated 'alphabet'.
+    : d_data_p(length ? new char[length] : 0)
+    , d_length(length)
+    {
+        const size_type alphabetSize = native_std::strlen(alphabet);
+        for (size_type i = 0; i < length; ++i) {
+            d_data_p[i] = alphabet[native_std::rand() % alphabetSize];
+        }
+    }
+
+    ~TestString()
+        // Destroy this object.
+    {
+        delete [] d_data_p;
+    }
+
+    // ACCESSORS
+    const char *data() const
+        // Return the address of the characters of this string.
+    {
+        return d_data_p;
+    }
+
+    size_type length() const
+        // Return the number of characters of this string.
+    {
+        return d_length;
+    }
+};
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Tokenizing a Message
+///- - - - - - - - - - - - - - - -
+// Suppose that we are parsing messages consisting of fields separated by any
+// of several delimiters, and that the messages are provided as ranges of
+// characters that are not null-terminated.
+//
+// First, we define a function that counts the fields of a message, skipping
+// leading delimiters and then searching for the end of each field:
+//..
+    int countFields(const char *message, bsl::size_t length)
+        // Return the number of fields in the specified 'message' having the
+        // specified 'length', where fields are separated by one or more of the
+        // characters ' ', ',', ';', and '|'.
+    {
+        static const char  delimiters[]  = " ,;|";
+        const bsl::size_t  numDelimiters = sizeof delimiters - 1;
+        const char        *end           = message + length;
+        int                numFields     = 0;
+
+        while (message != end) {
+            const char *field = bslstl::StringSearchUtil::findFirstNotOf(
+                                                               message,
+                                                               end - message,
+                                                               delimiters,
+                                                               numDelimiters);
+            if (!field) {
+                break;
+            }
+            ++numFields;
+
+            message = bslstl::StringSearchUtil::findFirstOf(field,
+                                                            end - field,
+                                                            delimiters,
+                                                            numDelimiters);
+            if (!message) {
+                break;
+            }
+        }
+        return numFields;
+    }
+//..
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? native_std::atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+
+    (void) veryVeryVerbose;
+
+    setbuf(stdout, NULL);    // Use unbuffered output
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+// Then, we count the fields of a message:
+//..
+    const char MESSAGE[] = "  ORDER|IBM, 100;  BUY ||| 131.25 ";
+
+    ASSERT(5 == countFields(MESSAGE, sizeof MESSAGE - 1));
+//..
+// Finally, we search the message for a substring:
+//..
+    const char *buy = bslstl::StringSearchUtil::find(MESSAGE,
+                                                     sizeof MESSAGE - 1,
+                                                     "BUY",
+                                                     3);
+    ASSERT(MESSAGE + 19 == buy);
+
+    ASSERT(0 == bslstl::StringSearchUtil::find(MESSAGE,
+                                               sizeof MESSAGE - 1,
+                                               "SELL",
+                                               4));
+//..
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // TRAIT 'StringSearchUtil_IsAccelerated'
+        //
+        // Concerns:
+        //: 1 The trait is non-zero for 'char' strings having the standard
+        //:   character traits, and zero for other character types and
+        //:   character traits.
+        //
+        // Plan:
+        //: 1 Verify the value of the trait for 'char' and 'wchar_t' with the
+        //:   standard character traits, and for 'char' with user-defined
+        //:   character traits.  (C-1)
+        //
+        // Testing:
+        //   StringSearchUtil_IsAccelerated<CHAR_TYPE, CHAR_TRAITS>
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTRAIT 'StringSearchUtil_IsAccelerated'"
+                            "\n======================================\n");
+
+        ASSERT( (bslstl::StringSearchUtil_IsAccelerated<
+                              char,
+                              native_std::char_traits<char> >::value));
+        ASSERT(!(bslstl::StringSearchUtil_IsAccelerated<
+                              wchar_t,
+                              native_std::char_traits<wchar_t> >::value));
+        ASSERT(!(bslstl::StringSearchUtil_IsAccelerated<
+                              char,
+                              UserTraits>::value));
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // 'findFirstNotOf'
+        //
+        // Concerns:
+        //: 1 Each implementation returns the address of the first character
+        //:   of the string that belongs to none of the characters of the set,
+        //:   or 0 if there is none.
+        //:
+        //: 2 The result does not depend on the number of characters of the
+        //:   set, or on their values, including characters having the most
+        //:   significant bit set.
+        //:
+        //: 3 An empty string yields 0, and an empty set yields the first
+        //:   character of a non-empty string.
+        //:
+        //: 4 No character beyond the end of the string is read.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For each supported instruction set, search random strings of
+        //:   lengths 0 to 130, drawn from small alphabets, for random sets of
+        //:   0 to 20 characters drawn from the same alphabets, and compare
+        //:   the results with those of a reference implementation.  Also
+        //:   search strings made of the characters of the set followed by a
+        //:   single other character at each position.  (C-1..4)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for null addresses with non-zero lengths (using the
+        //:   'BSLS_ASSERTTEST_*' macros).  (C-5)
+        //
+        // Testing:
+        //   const char *findFirstNotOf(const char *, size_type, ...);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\n'findFirstNotOf'"
+                            "\n================\n");
+
+        static const char *const ALPHABETS[] = {
+            "ab",
+            " \t,;",
+            "xyz\x80\xff",
+            "\x01\x7f\x80\x81\xfe\xff",
+            "0123456789abcdefghijklmnopqrstuvwxyz"
+        };
+        const int NUM_ALPHABETS = sizeof ALPHABETS / sizeof *ALPHABETS;
+
+        for (int ti = 0; ti < NUM_INSTRUCTION_SETS; ++ti) {
+            Util::setInstructionSet(INSTRUCTION_SETS[ti]);
+            if (Util::instructionSet() != INSTRUCTION_SETS[ti]) {
+                continue;
+            }
+            if (veryVerbose) printf("\t%s\n", INSTRUCTION_SET_NAMES[ti]);
+
+            for (int ai = 0; ai < NUM_ALPHABETS; ++ai) {
+                const char *ALPHABET = ALPHABETS[ai];
+
+                for (size_type length = 0; length <= 130; ++length) {
+                    for (size_type numChars = 0; numChars <= 20; ++numChars) {
+                        const TestString string(ALPHABET, length);
+                        const TestString set(ALPHABET, numChars);
+
+                        const char *EXP = findInSetOracle(string.data(),
+                                                          length,
+                                                          set.data(),
+                                                          numChars,
+                                                          false);
+                        const char *result = Util::findFirstNotOf(
+                                                                string.data(),
+                                                                length,
+                                                                set.data(),
+                                                                numChars);
+                        ASSERTV(ti, ai, length, numChars, EXP == result);
+                    }
+                }
+            }
+
+            static const char SET[] = "\x80 ,;\xff";
+            const size_type   NUM_CHARS = sizeof SET - 1;
+
+            for (size_type length = 1; length <= 100; ++length) {
+                for (size_type pos = 0; pos < length; ++pos) {
+                    char *string = new char[length];
+                    for (size_type i = 0; i < length; ++i) {
+                        string[i] = SET[i % NUM_CHARS];
+                    }
+                    string[pos] = 'x';
+
+                    ASSERTV(ti, length, pos, string + pos ==
+                       Util::findFirstNotOf(string, length, SET, NUM_CHARS));
+
+                    string[pos] = ';';
+                    ASSERTV(ti, length, pos, 0 ==
+                       Util::findFirstNotOf(string, length, SET, NUM_CHARS));
+
+                    delete [] string;
+                }
+            }
+        }
+        Util::setInstructionSet(Util::supportedInstructionSet());
+
+        if (verbose) printf("\nNegative Testing.\n");
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            const char S[] = "abc";
+
+            ASSERT_SAFE_PASS(Util::findFirstNotOf(0, 0, S, 3));
+            ASSERT_SAFE_FAIL(Util::findFirstNotOf(0, 1, S, 3));
+            ASSERT_SAFE_PASS(Util::findFirstNotOf(S, 3, 0, 0));
+            ASSERT_SAFE_FAIL(Util::findFirstNotOf(S, 3, 0, 1));
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // 'findFirstOf'
+        //
+        // Concerns:
+        //: 1 Each implementation returns the address of the first character
+        //:   of the string that is equal to one of the characters of the set,
+        //:   or 0 if there is none.
+        //:
+        //: 2 The result does not depend on the number of characters of the
+        //:   set, or on their values, including characters having the most
+        //:   significant bit set.
+        //:
+        //: 3 An empty string or an empty set yields 0.
+        //:
+        //: 4 No character beyond the end of the string is read.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For each supported instruction set, search random strings of
+        //:   lengths 0 to 130, drawn from a large alphabet, for random sets of
+        //:   0 to 20 characters drawn from a small alphabet, so that matches
+        //:   occur at various positions, and compare the results with those
+        //:   of a reference implementation.  Also search, for each of the 256
+        //:   character values, a string having only that character at each of
+        //:   several positions.  (C-1..4)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for null addresses with non-zero lengths (using the
+        //:   'BSLS_ASSERTTEST_*' macros).  (C-5)
+        //
+        // Testing:
+        //   const char *findFirstOf(const char *, size_type, ...);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\n'findFirstOf'"
+                            "\n=============\n");
+
+        static const struct {
+            const char *d_stringAlphabet;  // characters of searched strings
+            const char *d_setAlphabet;     // characters of sets
+        } DATA[] = {
+            { "abcdefghijklmnopqrstuvwxyz",            "xyz"               },
+            { "abcdefghijklmnopqrstuvwxyz \t,;",       " \t,;|"            },
+            { "abcdefghij\x80\x90\xa0\xf0\xff",        "\x80\xff j"        },
+            { "\x01\x10\x7f\x80\x81\x8f\xf1\xfe\xff",  "\x10\x8f\xfe\x01"  },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_INSTRUCTION_SETS; ++ti) {
+            Util::setInstructionSet(INSTRUCTION_SETS[ti]);
+            if (Util::instructionSet() != INSTRUCTION_SETS[ti]) {
+                continue;
+            }
+            if (veryVerbose) printf("\t%s\n", INSTRUCTION_SET_NAMES[ti]);
+
+            for (int di = 0; di < NUM_DATA; ++di) {
+                for (size_type length = 0; length <= 130; ++length) {
+                    for (size_type numChars = 0; numChars <= 20; ++numChars) {
+                        const TestString string(DATA[di].d_stringAlphabet,
+                                                length);
+                        const TestString set(DATA[di].d_setAlphabet,
+                                             numChars);
+
+                        const char *EXP = findInSetOracle(string.data(),
+                                                          length,
+                                                          set.data(),
+                                                          numChars,
+                                                          true);
+                        const char *result = Util::findFirstOf(string.data(),
+                                                               length,
+                                                               set.data(),
+                                                               numChars);
+                        ASSERTV(ti, di, length, numChars, EXP == result);
+                    }
+                }
+            }
+
+            const size_type LENGTH = 70;
+            char           *string = new char[LENGTH];
+
+            for (int c = 0; c < 256; ++c) {
+                const char CHAR    = static_cast<char>(c);
+                const char OTHER   = static_cast<char>(c + 1);
+                const char SET[]   = { static_cast<char>(c + 7), CHAR };
+
+                for (size_type pos = 0; pos < LENGTH; pos += 3) {
+                    native_std::memset(string, OTHER, LENGTH);
+                    string[pos] = CHAR;
+
+                    ASSERTV(ti, c, pos, string + pos ==
+                                    Util::findFirstOf(string, LENGTH, SET, 2));
+                    ASSERTV(ti, c, pos, string + pos ==
+                                    Util::findFirstOf(string,
+                                                      LENGTH,
+                                                      SET + 1,
+                                                      1));
+                }
+            }
+            delete [] string;
+        }
+        Util::setInstructionSet(Util::supportedInstructionSet());
+
+        if (verbose) printf("\nNegative Testing.\n");
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            const char S[] = "abc";
+
+            ASSERT_SAFE_PASS(Util::findFirstOf(0, 0, S, 3));
+            ASSERT_SAFE_FAIL(Util::findFirstOf(0, 1, S, 3));
+            ASSERT_SAFE_PASS(Util::findFirstOf(S, 3, 0, 0));
+            ASSERT_SAFE_FAIL(Util::findFirstOf(S, 3, 0, 1));
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'find'
+        //
+        // Concerns:
+        //: 1 Each implementation returns the address of the first occurrence
+        //:   of the substring in the string, or 0 if there is none.
+        //:
+        //: 2 An empty substring yields the string, and a substring longer than
+        //:   the string yields 0.
+        //:
+        //: 3 Occurrences overlapping the end of a vector block, partial
+        //:   matches of the first and last characters, and overlapping
+        //:   occurrences are handled correctly.
+        //:
+        //: 4 No character beyond the end of the string is read.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For each supported instruction set, search random strings of
+        //:   lengths 0 to 150, drawn from alphabets of 2 to 4 characters, for
+        //:   random substrings of lengths 0 to 12 drawn from the same
+        //:   alphabets, and for substrings of the strings themselves, and
+        //:   compare the results with those of a reference implementation.
+        //:   (C-1..4)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for null addresses with non-zero lengths (using the
+        //:   'BSLS_ASSERTTEST_*' macros).  (C-5)
+        //
+        // Testing:
+        //   const char *find(const char *, size_type, const char *, ...);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\n'find'"
+                            "\n======\n");
+
+        static const char *const ALPHABETS[] = {
+            "ab",
+            "abc",
+            "a\x80\xff",
+            "\x7f\x80\x81\xff"
+        };
+        const int NUM_ALPHABETS = sizeof ALPHABETS / sizeof *ALPHABETS;
+
+        for (int ti = 0; ti < NUM_INSTRUCTION_SETS; ++ti) {
+            Util::setInstructionSet(INSTRUCTION_SETS[ti]);
+            if (Util::instructionSet() != INSTRUCTION_SETS[ti]) {
+                continue;
+            }
+            if (veryVerbose) printf("\t%s\n", INSTRUCTION_SET_NAMES[ti]);
+
+            for (int ai = 0; ai < NUM_ALPHABETS; ++ai) {
+                const char *ALPHABET = ALPHABETS[ai];
+
+                for (size_type length = 0; length <= 150; ++length) {
+                    const TestString string(ALPHABET, length);
+
+                    for (size_type numChars = 0; numChars <= 12; ++numChars) {
+                        const TestString substring(ALPHABET, numChars);
+
+                        const char *EXP = findOracle(string.data(),
+                                                     length,
+                                                     substring.data(),
+                                                     numChars);
+                        const char *result = Util::find(string.data(),
+                                                        length,
+                                                        substring.data(),
+                                                        numChars);
+                        ASSERTV(ti, ai, length, numChars, EXP == result);
+                    }
+
+                    // Search for the substrings of the string itself.
+
+                    for (size_type pos = 0; pos < length; pos += 7) {
+                        for (size_type numChars = 1;
+                             pos + numChars <= length && numChars <= 40;
+                             numChars += 3) {
+                            const char *EXP = findOracle(string.data(),
+                                                         length,
+                                                         string.data() + pos,
+                                                         numChars);
+                            const char *result = Util::find(
+                                                          string.data(),
+                                                          length,
+                                                          string.data() + pos,
+                                                          numChars);
+                            ASSERTV(ti, ai, length, pos, numChars,
+                                    EXP == result);
+                            ASSERTV(ti, ai, length, pos, numChars,
+                                    result && result <= string.data() + pos);
+                        }
+                    }
+                }
+            }
+        }
+        Util::setInstructionSet(Util::supportedInstructionSet());
+
+        if (verbose) printf("\nNegative Testing.\n");
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            const char S[] = "abc";
+
+            ASSERT_SAFE_PASS(Util::find(0, 0, S, 3));
+            ASSERT_SAFE_FAIL(Util::find(0, 1, S, 3));
+            ASSERT_SAFE_PASS(Util::find(S, 3, 0, 0));
+            ASSERT_SAFE_FAIL(Util::find(S, 3, 0, 1));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // INSTRUCTION SET SELECTION
+        //
+        // Concerns:
+        //: 1 Unless restricted, the selected instruction set is the supported
+        //:   instruction set.
+        //:
+        //: 2 'setInstructionSet' selects the specified instruction set if it
+        //:   is supported, and the supported instruction set otherwise.
+        //:
+        //: 3 The portable implementation is always supported.
+        //
+        // Plan:
+        //: 1 Verify the initially selected instruction set, then select each
+        //:   instruction set in turn and verify the selected instruction set.
+        //:   (C-1..3)
+        //
+        // Testing:
+        //   InstructionSet instructionSet();
+        //   void setInstructionSet(InstructionSet value);
+        //   InstructionSet supportedInstructionSet();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nINSTRUCTION SET SELECTION"
+                            "\n=========================\n");
+
+        const Util::InstructionSet SUPPORTED =
+                                               Util::supportedInstructionSet();
+
+        if (verbose) printf("\tSupported: %s\n",
+                            INSTRUCTION_SET_NAMES[SUPPORTED]);
+
+        ASSERT(SUPPORTED == Util::instructionSet());
+
+        for (int ti = 0; ti < NUM_INSTRUCTION_SETS; ++ti) {
+            const Util::InstructionSet VALUE = INSTRUCTION_SETS[ti];
+            const Util::InstructionSet EXP   = VALUE <= SUPPORTED ? VALUE
+                                                                  : SUPPORTED;
+
+            Util::setInstructionSet(VALUE);
+            ASSERTV(ti, EXP == Util::instructionSet());
+        }
+
+        Util::setInstructionSet(Util::e_PORTABLE);
+        ASSERT(Util::e_PORTABLE == Util::instructionSet());
+
+        Util::setInstructionSet(SUPPORTED);
+        ASSERT(SUPPORTED == Util::instructionSet());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic
+        //   functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Search a few strings using each function.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        const char      S[] = "The quick brown fox jumps over the lazy dog, "
+                              "and then the quick brown fox sleeps.";
+        const size_type N   = sizeof S - 1;
+
+        ASSERT(S + 16 == Util::find(S, N, "fox", 3));
+        ASSERT(S + 31 == Util::find(S, N, "the", 3));
+        ASSERT(0      == Util::find(S, N, "cat", 3));
+        ASSERT(S      == Util::find(S, N, "", 0));
+        ASSERT(S + N - 7 == Util::find(S, N, "sleeps.", 7));
+
+        ASSERT(S + 3  == Util::findFirstOf(S, N, " ,", 2));
+        ASSERT(S + 43 == Util::findFirstOf(S, N, ",.", 2));
+        ASSERT(0      == Util::findFirstOf(S, N, "!?", 2));
+
+        ASSERT(S + 1  == Util::findFirstNotOf(S, N, "T", 1));
+        ASSERT(S + 4  == Util::findFirstNotOf(S, N, "Teh ", 4));
+        ASSERT(0      == Util::findFirstNotOf(S, N, S, N));
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST
+        //
+        // Concerns:
+        //: 1 The vectorized implementations are faster than the portable
+        //:   implementation, and than the generic loops over character traits
+        //:   that they replace, on strings typical of log and message parsing.
+        //
+        // Plan:
+        //: 1 For each supported instruction set, time searches of a 4 KiB
+        //:   message for a substring that does not occur, for the first
+        //:   of several delimiters, and for the first character that is not
+        //:   whitespace, and print the throughput.  Time the same searches
+        //:   using loops over 'char_traits<char>'.  The number of iterations
+        //:   may be specified as the second argument.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE TEST
+        // --------------------------------------------------------------------
+
+        printf("\nPERFORMANCE TEST"
+               "\n================\n");
+
+        const int numIterations = argc > 2 ? native_std::atoi(argv[2]) : 20000;
+
+        enum { k_LENGTH = 4096 };
+
+        // 'message' holds lowercase words separated by spaces, and 'blank'
+        // holds spaces followed by a word and a delimiter, so that each search
+        // examines (almost) the whole string.
+
+        char *message = new char[k_LENGTH];
+        for (int i = 0; i < k_LENGTH; ++i) {
+            message[i] = 0 == i % 7 ? ' ' : static_cast<char>('a' + i % 26);
+        }
+
+        char *blank = new char[k_LENGTH];
+        native_std::memset(blank, ' ', k_LENGTH);
+        blank[k_LENGTH - 2] = 'x';
+        blank[k_LENGTH - 1] = '|';
+
+        static const char SUBSTRING[]  = "needle";
+        static const char DELIMITERS[] = "|;,=\n";
+        static const char WHITESPACE[] = " \t\r\n";
+
+        typedef native_std::char_traits<char> Traits;
+
+        bsls::Stopwatch timer;
+        volatile size_type sink = 0;
+
+        printf("%-12s %12s %12s %12s\n",
+               "", "find", "firstOf", "firstNotOf");
+
+        for (int ti = -1; ti < NUM_INSTRUCTION_SETS; ++ti) {
+            if (0 <= ti) {
+                Util::setInstructionSet(INSTRUCTION_SETS[ti]);
+                if (Util::instructionSet() != INSTRUCTION_SETS[ti]) {
+                    continue;
+                }
+            }
+
+            double seconds[3];
+
+            for (int fi = 0; fi < 3; ++fi) {
+                timer.reset();
+                timer.start();
+                for (int i = 0; i < numIterations; ++i) {
+                    const char *result = 0;
+                    if (0 > ti) {
+
+                        // Generic loops over the character traits, as used
+                        // by 'bsl::basic_string' for other character types.
+
+                        const char *end = (0 == fi ? message : blank)
+                                                                   + k_LENGTH;
+                        for (const char *p = 0 == fi ? message : blank;
+                             p != end && !result;
+                             ++p) {
+                            if (0 == fi) {
+                                if (p + 6 <= end
+                                 && 0 == Traits::compare(p, SUBSTRING, 6)) {
+                                    result = p;
+                                }
+                            }
+                            else if (1 == fi) {
+                                if (Traits::find(DELIMITERS, 5, *p)) {
+                                    result = p;
+                                }
+                            }
+                            else if (!Traits::find(WHITESPACE, 4, *p)) {
+                                result = p;
+                            }
+                        }
+                    }
+                    else if (0 == fi) {
+                        result = Util::find(message, k_LENGTH, SUBSTRING, 6);
+                    }
+                    else if (1 == fi) {
+                        result = Util::findFirstOf(blank,
+                                                   k_LENGTH,
+                                                   DELIMITERS,
+                                                   5);
+                    }
+                    else {
+                        result = Util::findFirstNotOf(blank,
+                                                      k_LENGTH,
+                                                      WHITESPACE,
+                                                      4);
+                    }
+                    sink = sink + (result ? 1 : 0);
+                }
+                timer.stop();
+                seconds[fi] = timer.accumulatedWallTime();
+            }
+
+            const double bytes = static_cast<double>(k_LENGTH)
+                                                              * numIterations;
+            printf("%-12s %9.2f GB/s %7.2f GB/s %7.2f GB/s\n",
+                   0 > ti ? "char_traits" : INSTRUCTION_SET_NAMES[ti],
+                   bytes / seconds[0] / 1e9,
+                   bytes / seconds[1] / 1e9,
+                   bytes / seconds[2] / 1e9);
+        }
+        Util::setInstructionSet(Util::supportedInstructionSet());
+
+        delete [] blank;
+        delete [] message;
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2020 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
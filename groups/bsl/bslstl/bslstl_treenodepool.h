@@ -270,6 +270,16 @@ class TreeNodePool {
         // Alias for the 'size_type' of the allocator defined by 'SimplePool'.
 
   public:
+    // CLASS METHODS
+    static void deleteDetachedNode(bslalg::RbTreeNode   *node,
+                                   const AllocatorType&  allocator);
+        // Destroy the 'VALUE' value of the specified 'node' and return the
+        // memory footprint of 'node' directly to the specified 'allocator'.
+        // The behavior is undefined unless 'node' was obtained from
+        // 'moveIntoDetachedNode' on a node-pool whose allocator compares equal
+        // to 'allocator'.  Note that the node-pool that created 'node' need
+        // not exist any longer.
+
     // CREATORS
     explicit TreeNodePool(const ALLOCATOR& allocator);
         // Create a node-pool that will use the specified 'allocator' to supply
@@ -475,6 +485,19 @@ class TreeNodePool {
         // unless 'original' refers to a 'TreeNode<VALUE>' object holding a
         // valid (initialized) value.
 
+    bslalg::RbTreeNode *moveIntoDetachedNode(bslalg::RbTreeNode *original);
+        // Allocate a node of the type 'TreeNode<VALUE>' individually from the
+        // allocator of this pool, rather than from its free list, and
+        // move-construct an object of the (template parameter) type 'VALUE'
+        // with the (explicitly moved) value indicated by the 'value'
+        // attribute of the specified 'original' node.  Return the address of
+        // the newly allocated node, which must be destroyed with
+        // 'deleteDetachedNode', and may outlive this pool.  The object
+        // referred to by the 'value' attribute of 'original' is left in a
+        // valid but unspecified state.  The behavior is undefined unless
+        // 'original' refers to a 'TreeNode<VALUE>' object holding a valid
+        // (initialized) value.
+
     void reserveNodes(size_type numNodes);
         // Add to this pool sufficient memory to satisfy memory requests for at
         // least the specified 'numNodes'.  The additional memory is added
@@ -518,6 +541,21 @@ class TreeNodePool {
                        // class TreeNodePool
                        // ------------------
 
+// CLASS METHODS
+template <class VALUE, class ALLOCATOR>
+inline
+void TreeNodePool<VALUE, ALLOCATOR>::deleteDetachedNode(
+                                       bslalg::RbTreeNode   *node,
+                                       const AllocatorType&  allocator)
+{
+    BSLS_ASSERT(node);
+
+    TreeNode<VALUE> *treeNode = static_cast<TreeNode<VALUE> *>(node);
+    AllocatorType    alloc(allocator);
+    AllocatorTraits::destroy(alloc, BSLS_UTIL_ADDRESSOF(treeNode->value()));
+    Pool::deallocateDetachedBlock(allocator, treeNode);
+}
+
 // CREATORS
 template <class VALUE, class ALLOCATOR>
 inline
@@ -944,6 +982,23 @@ TreeNodePool<VALUE, ALLOCATOR>::moveIntoNewNode(bslalg::RbTreeNode *original)
             MoveUtil::move(static_cast<TreeNode<VALUE> *>(original)->value()));
 }
 
+template <class VALUE, class ALLOCATOR>
+inline
+bslalg::RbTreeNode *
+TreeNodePool<VALUE, ALLOCATOR>::moveIntoDetachedNode(
+                                                  bslalg::RbTreeNode *original)
+{
+    TreeNode<VALUE> *node = d_pool.allocateDetachedBlock();
+    typename Pool::DetachedBlockProctor proctor(node, allocator());
+
+    AllocatorTraits::construct(
+            allocator(),
+            BSLS_UTIL_ADDRESSOF(node->value()),
+            MoveUtil::move(static_cast<TreeNode<VALUE> *>(original)->value()));
+    proctor.release();
+    return node;
+}
+
 template <class VALUE, class ALLOCATOR>
 inline
 void TreeNodePool<VALUE, ALLOCATOR>::reserveNodes(size_type numNodes)
@@ -59,6 +59,7 @@ using namespace bslstl;
 // [13] template <class P> bslalg::RbTreeNode *emplaceIntoNewNode(P&&);
 // [ 5] void deleteNode(bslalg::RbTreeNode *node);
 // [  ] bslalg::RbTreeNode *moveIntoNewNode(bslalg::RbTreeNode *original);
+// [16] bslalg::RbTreeNode *moveIntoDetachedNode(bslalg::RbTreeNode *original);
 // [ 6] void reserveNodes(size_type numNodes);
 // [ 8] void swap(TreeNodePool& other);
 // [ 8] void swapExchangeAllocators(TreeNodePool& other);
@@ -67,6 +68,9 @@ using namespace bslstl;
 // ACCESSORS
 // [ 4] const AllocatorType& allocator() const;
 // [15] bool hasFreeNodes() const;
+//
+// CLASS METHODS
+// [16] static void deleteDetachedNode(RbTreeNode *, const AllocatorType&);
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [14] USAGE EXAMPLE
@@ -351,6 +355,9 @@ class TestDriver {
 
   public:
     // TEST CASES
+    static void testCase16();
+        // Test detached nodes.
+
     static void testCase15();
         // Test other accessors.
 
@@ -453,6 +460,78 @@ void TestDriver<VALUE>::createFreeBlocks(Obj   *result,
     }
 }
 
+template<class VALUE>
+void TestDriver<VALUE>::testCase16()
+{
+    // ------------------------------------------------------------------------
+    // DETACHED NODES
+    //
+    // Concerns:
+    //: 1 'moveIntoDetachedNode' creates a node holding the value of the
+    //:   original node, allocated individually from the allocator of the pool
+    //:   without using or replenishing the free list.
+    //:
+    //: 2 The value of the detached node uses the allocator of the pool.
+    //:
+    //: 3 A detached node remains valid after the pool that created it is
+    //:   destroyed, and 'deleteDetachedNode' destroys its value and returns
+    //:   its memory to the allocator.
+    //:
+    //: 4 No memory is allocated from the default allocator.
+    //
+    // Plan:
+    //: 1 Create a pooled node, move its value into a detached node, and
+    //:   verify the value of the detached node, the state of the free list,
+    //:   and the blocks allocated from the object allocator.  (C-1..2)
+    //:
+    //: 2 Destroy the pool, verify the value of the detached node, then delete
+    //:   it and verify that no memory remains in use.  (C-3..4)
+    //
+    // Testing:
+    //   bslalg::RbTreeNode *moveIntoDetachedNode(bslalg::RbTreeNode *);
+    //   static void deleteDetachedNode(RbTreeNode *, const AllocatorType&);
+    // ------------------------------------------------------------------------
+
+    if (verbose) printf("\nDETACHED NODES"
+                        "\n==============\n");
+
+    typedef bsltf::TemplateTestFacility TstFacility;
+
+    const int TYPE_ALLOC = bslma::UsesBslmaAllocator<VALUE>::value;
+
+    bslma::TestAllocator da("default", veryVeryVeryVerbose);
+    bslma::TestAllocator oa("object",  veryVeryVeryVerbose);
+
+    bslma::DefaultAllocatorGuard dag(&da);
+
+    ValueNode *detached;
+    {
+        Obj mX(&oa);  const Obj& X = mX;
+
+        RbNode *pooled = mX.emplaceIntoNewNode(7);
+        ASSERT(false == X.hasFreeNodes());
+
+        bslma::TestAllocatorMonitor oam(&oa);
+
+        detached = static_cast<ValueNode *>(mX.moveIntoDetachedNode(pooled));
+        ASSERT(detached);
+        ASSERT(pooled != detached);
+        ASSERT(7 == TstFacility::getIdentifier(detached->value()));
+        ASSERTV(oam.numBlocksInUseChange(),
+                1 + TYPE_ALLOC == oam.numBlocksInUseChange());
+        ASSERT(false == X.hasFreeNodes());
+
+        mX.deleteNode(pooled);
+        ASSERT(true == X.hasFreeNodes());
+    }
+    ASSERTV(oa.numBlocksInUse(), 1 + TYPE_ALLOC == oa.numBlocksInUse());
+    ASSERT(7 == TstFacility::getIdentifier(detached->value()));
+
+    Obj::deleteDetachedNode(detached, typename Obj::AllocatorType(&oa));
+    ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+    ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+}
+
 template<class VALUE>
 void TestDriver<VALUE>::testCase15()
 {
@@ -1819,6 +1898,9 @@ int main(int argc, char *argv[])
     printf("TEST " __FILE__ " CASE %d\n", test);
 
     switch (test) { case 0:
+      case 16: {
+        TestDriver<bsltf::AllocTestType>::testCase16();
+      } break;
       case 15: {
         TestDriver<bsltf::AllocTestType>::testCase15();
       } break;
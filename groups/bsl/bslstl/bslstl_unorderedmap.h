@@ -148,6 +148,38 @@ BSLS_IDENT("$Id: $")
 // for any two objects whose keys compare equivalent by the comparator, shall
 // also produce the same return value from the hasher.
 //
+///Heterogeneous Lookup
+///- - - - - - - - - - -
+// If both 'HASH' and 'EQUAL' are *transparent* (i.e., each declares a nested
+// type named 'is_transparent'), the 'find', 'count', 'equal_range', and
+// 'contains' methods of this unordered map accept a key of any type,
+// 'LOOKUP_KEY', that 'HASH' can hash and 'EQUAL' can compare with 'KEY', and
+// look up that key without converting it to 'KEY'.  For example, the keys of
+// a container of 'bsl::string' can be looked up with a 'bsl::string_view'
+// without allocating memory.  'HASH' must return the same value for a
+// 'LOOKUP_KEY' object as for every equivalent 'KEY' object.
+//
+///Node Handles
+///------------
+// On platforms supporting rvalue references, an element can be removed from
+// an unordered map, without being destroyed, by the 'extract' method, which
+// returns a node handle (of type 'unordered_map::node_type') owning the node
+// holding the element.  The key and the mapped value of the element can be
+// modified through the node handle, and the node handle can be inserted back
+// into an unordered map by the 'insert' methods taking a 'node_type'
+// argument.  Since each unordered map obtains its nodes from a pool that it
+// owns, 'extract' moves the element into a node allocated individually from
+// the allocator of the unordered map, and returns the original node to the
+// pool, so that a node handle may outlive the unordered map from which it was
+// extracted (see 'bslstl_nodehandle').  Inserting a node handle into an
+// unordered map (or transferring elements with 'merge') moves the element
+// into a node from the pool of the destination.
+//
+// The 'try_emplace' and 'insert_or_assign' methods insert an element having a
+// given key if no element having an equivalent key exists, and otherwise,
+// respectively, leave the existing element (and their arguments) unchanged or
+// assign to its mapped value.
+//
 ///Memory Allocation
 ///-----------------
 // The type supplied as the 'ALLOCATOR' template parameter determines how
@@ -199,6 +231,7 @@ BSLS_IDENT("$Id: $")
 //  't&&'               - movable reference to variable 't'
 //  'ai1', 'ai2'        - two iterators belonging to 'a'
 //  'idx'               - bucket index
+//  'nh'                - modifiable rvalue of type 'node_type'
 //  '{*}'               - C++11 std::initializer_list
 //  'distance(i1, i2)'  - number of elements in the range '[i1 .. i2)'
 //  'distance(ai1,ai2)' - number of elements in the range '[ai1 .. ai2)'
@@ -292,6 +325,12 @@ BSLS_IDENT("$Id: $")
 //  | a.insert(vt&&), a.insert(ai1, vt&&)                | Average: O[1]      |
 //  |                                                    | Worst:   O[n]      |
 //  +----------------------------------------------------+--------------------+
+//  | a.insert(nh), a.insert(ai1, nh)                    | Average: O[1]      |
+//  | a.try_emplace(k, Args&&...)                        | Worst:   O[n]      |
+//  | a.try_emplace(ai1, k, Args&&...)                   |                    |
+//  | a.insert_or_assign(k, t&&)                         |                    |
+//  | a.insert_or_assign(ai1, k, t&&)                    |                    |
+//  +----------------------------------------------------+--------------------+
 //  | a.insert(i1, i2)                                   | Average: O[        |
 //  |                                                    |   distance(i1, i2)]|
 //  |                                                    | Worst:   O[n *     |
@@ -314,6 +353,12 @@ BSLS_IDENT("$Id: $")
 //  |                                                    | distance(ai1, ai2)]|
 //  |                                                    | Worst:   O[n]      |
 //  +----------------------------------------------------+--------------------+
+//  | a.extract(ai1), a.extract(k)                       | Average: O[1]      |
+//  |                                                    | Worst:   O[n]      |
+//  +----------------------------------------------------+--------------------+
+//  | a.merge(b)                                         | Average: O[m]      |
+//  |                                                    | Worst:   O[n * m]  |
+//  +----------------------------------------------------+--------------------+
 //  | a.clear()                                          | O[n]               |
 //  +----------------------------------------------------+--------------------+
 //  | a.find(k)                                          | Average: O[1]      |
@@ -325,6 +370,9 @@ BSLS_IDENT("$Id: $")
 //  | a.equal_range(k)                                   | Average: O[1]      |
 //  |                                                    | Worst:   O[n]      |
 //  +----------------------------------------------------+--------------------+
+//  | a.contains(k)                                      | Average: O[1]      |
+//  |                                                    | Worst:   O[n]      |
+//  +----------------------------------------------------+--------------------+
 //  | a.bucket_count()                                   | O[1]               |
 //  +----------------------------------------------------+--------------------+
 //  | a.max_bucket_count()                               | O[1]               |
@@ -947,6 +995,7 @@ BSL_OVERRIDES_STD mode"
 #include <bslstl_hashtablebucketiterator.h>
 #include <bslstl_hashtableiterator.h>
 #include <bslstl_iteratorutil.h>
+#include <bslstl_nodehandle.h>
 #include <bslstl_pair.h>
 #include <bslstl_stdexceptutil.h>
 #include <bslstl_unorderedmapkeyconfiguration.h>
@@ -965,12 +1014,15 @@ BSL_OVERRIDES_STD mode"
 #include <bslmf_enableif.h>
 #include <bslmf_isbitwisemoveable.h>
 #include <bslmf_isconvertible.h>
+#include <bslmf_istransparentpredicate.h>
 #include <bslmf_movableref.h>
 #include <bslmf_nestedtraitdeclaration.h>
 
 #include <bsls_assert.h>
 #include <bsls_compilerfeatures.h>
 #include <bsls_keyword.h>
+#include <bsls_libraryfeatures.h>
+#include <bsls_nativestd.h>
 #include <bsls_objectbuffer.h>
 #include <bsls_performancehint.h>
 
@@ -978,6 +1030,10 @@ BSL_OVERRIDES_STD mode"
 # include <initializer_list>
 #endif
 
+#if defined(BSLS_LIBRARYFEATURES_HAS_CPP11_PAIR_PIECEWISE_CONSTRUCTOR)
+# include <tuple>  // 'std::forward_as_tuple'
+#endif
+
 namespace bsl {
 
                            // ===================
@@ -1076,6 +1132,16 @@ class unordered_map {
     typedef BloombergLP::bslstl::HashTableBucketIterator<
                        const value_type, difference_type> const_local_iterator;
 
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+    typedef BloombergLP::bslstl::MapNodeHandle<KEY,
+                                               VALUE,
+                                               HashTableNode,
+                                               typename HashTable::NodeFactory,
+                                               ALLOCATOR>  node_type;
+    typedef BloombergLP::bslstl::NodeHandleInsertResult<iterator, node_type>
+                                                       insert_return_type;
+#endif
+
   private:
     // DATA
     HashTable d_impl;  // underlying hash table used by this unordered map
@@ -1471,12 +1537,53 @@ class unordered_map {
         // at or before the 'last' position in the iteration sequence provided
         // by this container.
 
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+    node_type extract(const_iterator position);
+        // Remove from this unordered map the element at the specified
+        // 'position', and return a node handle owning that element.  The
+        // element is moved into a single node allocated from the allocator of
+        // this unordered map, and the node that held it is returned to the
+        // pool of this unordered map (see {Node Handles}).  This method
+        // invalidates only iterators, pointers, and references to the removed
+        // element and previously saved values of the 'end()' iterator.  If an
+        // exception is thrown, this unordered map is unchanged.  The behavior
+        // is undefined unless 'position' refers to an element in this
+        // unordered map.
+
+    node_type extract(const key_type& key);
+        // Remove from this unordered map the element whose key is equivalent
+        // to the specified 'key', if such an element exists, and return a node
+        // handle owning that element; otherwise, return an empty node handle.
+        // Memory is allocated only as described by the 'extract' method
+        // (above) taking an iterator.
+#endif
+
     iterator find(const key_type& key);
         // Return an iterator providing modifiable access to the 'value_type'
         // object in this unordered map with a key equivalent to the specified
         // 'key', if such an entry exists, and the past-the-end iterator
         // ('end') otherwise.
 
+    template <class LOOKUP_KEY>
+    typename enable_if<
+        BloombergLP::bslmf::IsTransparentPredicate<HASH, LOOKUP_KEY>::value
+     && BloombergLP::bslmf::IsTransparentPredicate<EQUAL, LOOKUP_KEY>::value,
+        iterator>::type
+    find(const LOOKUP_KEY& key)
+        // Return an iterator providing modifiable access to the 'value_type'
+        // object in this unordered map with a key equivalent to the specified
+        // 'key', if such an entry exists, and the past-the-end iterator
+        // ('end') otherwise.  This overload
+        // participates in overload resolution only if both 'HASH' and 'EQUAL'
+        // are transparent (i.e., declare a nested 'is_transparent' type).  The
+        // behavior is undefined unless 'HASH' returns the same hash code for
+        // 'key' as for any equivalent 'key_type' object.
+        //
+        // Note: implemented inline due to Sun CC compilation error.
+    {
+        return iterator(d_impl.find(key));
+    }
+
     pair<iterator, bool> insert(const value_type& value);
         // Insert the specified 'value' into this unordered map if the key (the
         // 'first' element) of the object referred to by 'value' does not
@@ -1623,6 +1730,77 @@ class unordered_map {
         // 'copy-constructible' (see {Requirements on 'value_type'}).
 #endif
 
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+    insert_return_type insert(BloombergLP::bslmf::MovableRef<node_type> node);
+        // Insert into this unordered map the element owned by the specified
+        // 'node' handle if 'node' is not empty and a key equivalent to that of
+        // the element does not already exist in this unordered map.  Return an
+        // object whose 'position' member refers to the inserted element, or to
+        // the element whose key is equivalent to that of the element owned by
+        // 'node', or is 'end()' if 'node' is empty; whose 'inserted' member is
+        // 'true' if the element was inserted, and 'false' otherwise; and whose
+        // 'node' member owns the element if it was not inserted, and is empty
+        // otherwise.  The element is moved into a node supplied by this
+        // unordered map, and the node owned by 'node' is deallocated (see
+        // {Node Handles}).  'node' is left empty unless the returned 'node'
+        // member is not empty.
+
+    iterator insert(const_iterator                            hint,
+                    BloombergLP::bslmf::MovableRef<node_type> node);
+        // Insert into this unordered map the element owned by the specified
+        // 'node' handle if 'node' is not empty and a key equivalent to that of
+        // the element does not already exist in this unordered map.  Return an
+        // iterator referring to the inserted element, or to the element whose
+        // key is equivalent to that of the element owned by 'node', or 'end()'
+        // if 'node' is empty.  'node' is left empty if the element is
+        // inserted, and is unchanged otherwise.  Memory is allocated only as
+        // described by the 'insert' method (above) taking only a 'node'
+        // handle.  The specified 'hint' is ignored (other than possibly being
+        // used for debugging purposes).
+#endif
+
+    template <class MAPPED>
+    pair<iterator, bool> insert_or_assign(
+                                const key_type&                           key,
+                                BSLS_COMPILERFEATURES_FORWARD_REF(MAPPED) obj);
+    template <class MAPPED>
+    pair<iterator, bool> insert_or_assign(
+                               BloombergLP::bslmf::MovableRef<key_type>  key,
+                               BSLS_COMPILERFEATURES_FORWARD_REF(MAPPED) obj);
+        // If a key equivalent to the specified 'key' already exists in this
+        // unordered map, assign the specified 'obj' (forwarded) to the mapped
+        // value of the element having that key; otherwise, insert into this
+        // unordered map a newly-created 'value_type' object constructed from
+        // 'key' (copied or moved) and 'obj' (forwarded).  Return a pair whose
+        // 'first' member is an iterator referring to the (possibly newly
+        // inserted) element whose key is equivalent to 'key', and whose
+        // 'second' member is 'true' if a new element was inserted, and
+        // 'false' if the mapped value of an existing element was assigned.
+        // This method requires that the (template parameter) type 'VALUE' be
+        // assignable from, and 'emplace-constructible' together with 'KEY'
+        // from, 'obj'.
+
+    template <class MAPPED>
+    iterator insert_or_assign(
+                                const_iterator                            hint,
+                                const key_type&                           key,
+                                BSLS_COMPILERFEATURES_FORWARD_REF(MAPPED) obj);
+    template <class MAPPED>
+    iterator insert_or_assign(
+                               const_iterator                            hint,
+                               BloombergLP::bslmf::MovableRef<key_type>  key,
+                               BSLS_COMPILERFEATURES_FORWARD_REF(MAPPED) obj);
+        // If a key equivalent to the specified 'key' already exists in this
+        // unordered map, assign the specified 'obj' (forwarded) to the mapped
+        // value of the element having that key; otherwise, insert into this
+        // unordered map a newly-created 'value_type' object constructed from
+        // 'key' (copied or moved) and 'obj' (forwarded).  Return an iterator
+        // referring to the (possibly newly inserted) element whose key is
+        // equivalent to 'key'.  The specified 'hint' is ignored (other than
+        // possibly being used for debugging purposes).  This method requires
+        // that the (template parameter) type 'VALUE' be assignable from, and
+        // 'emplace-constructible' together with 'KEY' from, 'obj'.
+
     pair<iterator, iterator> equal_range(const key_type& key);
         // Return a pair of iterators providing modifiable access to the
         // sequence of 'value_type' objects in this unordered map having the
@@ -1633,6 +1811,34 @@ class unordered_map {
         // value, 'end()'.  Note that since an unordered map maintains unique
         // keys, the range will contain at most one element.
 
+    template <class LOOKUP_KEY>
+    typename enable_if<
+        BloombergLP::bslmf::IsTransparentPredicate<HASH, LOOKUP_KEY>::value
+     && BloombergLP::bslmf::IsTransparentPredicate<EQUAL, LOOKUP_KEY>::value,
+        pair<iterator, iterator> >::type
+    equal_range(const LOOKUP_KEY& key)
+        // Return a pair of iterators providing modifiable access to the
+        // sequence of 'value_type' objects in this unordered map having the
+        // specified 'key', where the first iterator is positioned at the start
+        // of the sequence, and the second is positioned one past the end of
+        // the sequence.  If this unordered map contains no 'value_type' object
+        // having 'key', then the two returned iterators will have the same
+        // value, 'end()'.  This overload
+        // participates in overload resolution only if both 'HASH' and 'EQUAL'
+        // are transparent (i.e., declare a nested 'is_transparent' type).  The
+        // behavior is undefined unless 'HASH' returns the same hash code for
+        // 'key' as for any equivalent 'key_type' object.
+        //
+        // Note: implemented inline due to Sun CC compilation error.
+    {
+        typedef bsl::pair<iterator, iterator> ResultType;
+
+        HashTableLink *first = d_impl.find(key);
+        return first
+             ? ResultType(iterator(first), iterator(first->nextLink()))
+             : ResultType(iterator(0),     iterator(0));
+    }
+
     void max_load_factor(float newMaxLoadFactor);
         // Set the maximum load factor of this unordered map to the specified
         // 'newMaxLoadFactor'.  If 'newMaxLoadFactor < loadFactor()', this
@@ -1640,6 +1846,24 @@ class unordered_map {
         // standard); otherwise, it has a constant-time cost.  The behavior is
         // undefined unless '0 < newMaxLoadFactor'.
 
+    template <class HASH2, class EQUAL2>
+    void merge(unordered_map<KEY, VALUE, HASH2, EQUAL2, ALLOCATOR>& source);
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+    template <class HASH2, class EQUAL2>
+    void merge(unordered_map<KEY, VALUE, HASH2, EQUAL2, ALLOCATOR>&& source);
+#endif
+        // Move into this unordered map each element of the specified 'source'
+        // unordered map whose key is not equivalent to the key of an element
+        // of this unordered map, and remove that element from 'source'.  The
+        // elements of 'source' whose keys are equivalent to those of elements
+        // of this unordered map are left in 'source'.  Each element is moved
+        // into a node supplied by this unordered map, and its original node
+        // is returned to 'source' (see {Node Handles}).  If an exception is
+        // thrown, the elements already transferred remain in this unordered
+        // map, and the element being transferred (if any) remains in
+        // 'source'.  This method has no effect if 'source' is this unordered
+        // map.
+
     void rehash(size_type numBuckets);
         // Change the size of the array of buckets maintained by this unordered
         // map to at least the specified 'numBuckets', and redistribute all the
@@ -1672,6 +1896,51 @@ class unordered_map {
         // created with the same allocator as 'other' or the 'ALLOCATOR' type
         // has the 'propagate_on_container_swap' trait.
 
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES                            \
+ && defined(BSLS_LIBRARYFEATURES_HAS_CPP11_PAIR_PIECEWISE_CONSTRUCTOR)        \
+ && defined(BSLS_LIBRARYFEATURES_HAS_CPP14_INTEGER_SEQUENCE)
+    template <class... Args>
+    pair<iterator, bool> try_emplace(const key_type& key, Args&&... args);
+    template <class... Args>
+    pair<iterator, bool> try_emplace(
+                                BloombergLP::bslmf::MovableRef<key_type> key,
+                                Args&&...                                args);
+        // If a key equivalent to the specified 'key' does not already exist
+        // in this unordered map, insert into this unordered map a
+        // newly-created 'value_type' object whose key is constructed from
+        // 'key' (copied or moved) and whose mapped value is constructed by
+        // forwarding the specified (variable number of) 'args' to the
+        // corresponding constructor of 'VALUE'; otherwise, this method has no
+        // effect, and, unlike 'emplace', neither 'key' nor 'args' are moved
+        // from and no temporary 'value_type' object is created.  Return a
+        // pair whose 'first' member is an iterator referring to the (possibly
+        // newly inserted) element whose key is equivalent to 'key', and whose
+        // 'second' member is 'true' if a new element was inserted, and
+        // 'false' otherwise.  This method requires that the (template
+        // parameter) type 'VALUE' be 'emplace-constructible' from 'args'.
+
+    template <class... Args>
+    iterator try_emplace(const_iterator  hint,
+                         const key_type& key,
+                         Args&&...       args);
+    template <class... Args>
+    iterator try_emplace(const_iterator                           hint,
+                         BloombergLP::bslmf::MovableRef<key_type> key,
+                         Args&&...                                args);
+        // If a key equivalent to the specified 'key' does not already exist
+        // in this unordered map, insert into this unordered map a
+        // newly-created 'value_type' object whose key is constructed from
+        // 'key' (copied or moved) and whose mapped value is constructed by
+        // forwarding the specified (variable number of) 'args' to the
+        // corresponding constructor of 'VALUE'; otherwise, this method has no
+        // effect, and neither 'key' nor 'args' are moved from.  Return an
+        // iterator referring to the (possibly newly inserted) element whose
+        // key is equivalent to 'key'.  The specified 'hint' is ignored (other
+        // than possibly being used for debugging purposes).  This method
+        // requires that the (template parameter) type 'VALUE' be
+        // 'emplace-constructible' from 'args'.
+#endif
+
     // ACCESSORS
     typename add_lvalue_reference<const VALUE>::type at(const key_type& key)
                                                                          const;
@@ -1738,6 +2007,46 @@ class unordered_map {
         // unordered map maintains unique keys, the returned value will be
         // either 0 or 1.
 
+    template <class LOOKUP_KEY>
+    typename enable_if<
+        BloombergLP::bslmf::IsTransparentPredicate<HASH, LOOKUP_KEY>::value
+     && BloombergLP::bslmf::IsTransparentPredicate<EQUAL, LOOKUP_KEY>::value,
+        size_type>::type
+    count(const LOOKUP_KEY& key) const
+        // Return the number of 'value_type' objects contained within this
+        // unordered map having the specified 'key'.  This overload
+        // participates in overload resolution only if both 'HASH' and 'EQUAL'
+        // are transparent (i.e., declare a nested 'is_transparent' type).  The
+        // behavior is undefined unless 'HASH' returns the same hash code for
+        // 'key' as for any equivalent 'key_type' object.
+        //
+        // Note: implemented inline due to Sun CC compilation error.
+    {
+        return d_impl.find(key) != 0;
+    }
+
+    bool contains(const key_type& key) const;
+        // Return 'true' if this unordered map contains a 'value_type' object
+        // having the specified 'key', and 'false' otherwise.
+
+    template <class LOOKUP_KEY>
+    typename enable_if<
+        BloombergLP::bslmf::IsTransparentPredicate<HASH, LOOKUP_KEY>::value
+     && BloombergLP::bslmf::IsTransparentPredicate<EQUAL, LOOKUP_KEY>::value,
+        bool>::type
+    contains(const LOOKUP_KEY& key) const
+        // Return 'true' if this unordered map contains a 'value_type' object
+        // having the specified 'key', and 'false' otherwise.  This overload
+        // participates in overload resolution only if both 'HASH' and 'EQUAL'
+        // are transparent (i.e., declare a nested 'is_transparent' type).  The
+        // behavior is undefined unless 'HASH' returns the same hash code for
+        // 'key' as for any equivalent 'key_type' object.
+        //
+        // Note: implemented inline due to Sun CC compilation error.
+    {
+        return d_impl.find(key) != 0;
+    }
+
     bool empty() const BSLS_KEYWORD_NOEXCEPT;
         // Return 'true' if this unordered map contains no elements, and
         // 'false' otherwise.
@@ -1759,6 +2068,55 @@ class unordered_map {
         // the specified 'key', if such an entry exists, and the past-the-end
         // iterator ('end') otherwise.
 
+    template <class LOOKUP_KEY>
+    typename enable_if<
+        BloombergLP::bslmf::IsTransparentPredicate<HASH, LOOKUP_KEY>::value
+     && BloombergLP::bslmf::IsTransparentPredicate<EQUAL, LOOKUP_KEY>::value,
+        pair<const_iterator, const_iterator> >::type
+    equal_range(const LOOKUP_KEY& key) const
+        // Return a pair of iterators providing non-modifiable access to the
+        // sequence of 'value_type' objects in this unordered map having the
+        // specified 'key', where the first iterator is positioned at the start
+        // of the sequence, and the second is positioned one past the end of
+        // the sequence.  If this unordered map contains no 'value_type' object
+        // having 'key', then the two returned iterators will have the same
+        // value, 'end()'.  This overload
+        // participates in overload resolution only if both 'HASH' and 'EQUAL'
+        // are transparent (i.e., declare a nested 'is_transparent' type).  The
+        // behavior is undefined unless 'HASH' returns the same hash code for
+        // 'key' as for any equivalent 'key_type' object.
+        //
+        // Note: implemented inline due to Sun CC compilation error.
+    {
+        typedef bsl::pair<const_iterator, const_iterator> ResultType;
+
+        HashTableLink *first = d_impl.find(key);
+        return first
+             ? ResultType(const_iterator(first),
+                          const_iterator(first->nextLink()))
+             : ResultType(const_iterator(0), const_iterator(0));
+    }
+
+    template <class LOOKUP_KEY>
+    typename enable_if<
+        BloombergLP::bslmf::IsTransparentPredicate<HASH, LOOKUP_KEY>::value
+     && BloombergLP::bslmf::IsTransparentPredicate<EQUAL, LOOKUP_KEY>::value,
+        const_iterator>::type
+    find(const LOOKUP_KEY& key) const
+        // Return an iterator providing non-modifiable access to the
+        // 'value_type' object in this unordered map with a key equivalent to
+        // the specified 'key', if such an entry exists, and the past-the-end
+        // iterator ('end') otherwise.  This overload
+        // participates in overload resolution only if both 'HASH' and 'EQUAL'
+        // are transparent (i.e., declare a nested 'is_transparent' type).  The
+        // behavior is undefined unless 'HASH' returns the same hash code for
+        // 'key' as for any equivalent 'key_type' object.
+        //
+        // Note: implemented inline due to Sun CC compilation error.
+    {
+        return const_iterator(d_impl.find(key));
+    }
+
     allocator_type get_allocator() const BSLS_KEYWORD_NOEXCEPT;
         // Return (a copy of) the allocator used for memory allocation by this
         // unordered map.
@@ -2458,6 +2816,39 @@ unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::erase(const_iterator first,
     return iterator(first.node()); // convert from const_iterator
 }
 
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+inline
+typename unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::node_type
+unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::extract(
+                                                       const_iterator position)
+{
+    BSLS_ASSERT_SAFE(position != this->end());
+
+    // The element is moved into a node that does not belong to the pool of
+    // this unordered map, so that the node handle may outlive it.
+
+    HashTableLink *node         = position.node();
+    HashTableLink *detachedNode =
+                              d_impl.nodeFactory().moveIntoDetachedNode(node);
+    d_impl.remove(node);
+    return node_type(static_cast<HashTableNode *>(detachedNode),
+                     get_allocator());
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+inline
+typename unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::node_type
+unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::extract(const key_type& key)
+{
+    HashTableLink *node = d_impl.find(key);
+    if (!node) {
+        return node_type();                                           // RETURN
+    }
+    return extract(const_iterator(node));
+}
+#endif
+
 template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
 inline
 typename unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::iterator
@@ -2527,6 +2918,152 @@ void unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::insert(
 }
 #endif
 
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+typename unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::insert_return_type
+unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::insert(
+                               BloombergLP::bslmf::MovableRef<node_type> node)
+{
+    node_type& lvalue = node;
+
+    if (lvalue.empty()) {
+        insert_return_type result = { this->end(), false, node_type() };
+        return result;                                                // RETURN
+    }
+
+    // Move the element into a node from our own pool (if the key is
+    // missing), and deallocate the node owned by the handle.
+
+    bool           isInsertedFlag = false;
+    HashTableLink *position = d_impl.insertIfMissing(
+                                     &isInsertedFlag,
+                                     MoveUtil::move(lvalue.node()->value()));
+    if (isInsertedFlag) {
+        lvalue = node_type();
+    }
+
+    if (!isInsertedFlag) {
+        insert_return_type result = { iterator(position),
+                                      false,
+                                      MoveUtil::move(lvalue) };
+        return result;                                                // RETURN
+    }
+
+    insert_return_type result = { iterator(position), true, node_type() };
+    return result;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+inline
+typename unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::iterator
+unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::insert(
+                               const_iterator,
+                               BloombergLP::bslmf::MovableRef<node_type> node)
+{
+    node_type& lvalue = node;
+
+    insert_return_type result = insert(MoveUtil::move(lvalue));
+    if (!result.inserted) {
+        lvalue = MoveUtil::move(result.node);
+    }
+    return result.position;
+}
+#endif
+
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+template <class MAPPED>
+bsl::pair<
+         typename unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::iterator,
+         bool>
+unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::insert_or_assign(
+                                const key_type&                           key,
+                                BSLS_COMPILERFEATURES_FORWARD_REF(MAPPED) obj)
+{
+    typedef bsl::pair<iterator, bool> ResultType;
+
+    HashTableLink *position = d_impl.find(key);
+    if (position) {
+        static_cast<HashTableNode *>(position)->value().second =
+                                   BSLS_COMPILERFEATURES_FORWARD(MAPPED, obj);
+        return ResultType(iterator(position), false);                 // RETURN
+    }
+
+    bool isInsertedFlag = false;
+
+    position = d_impl.emplaceIfMissing(
+                                   &isInsertedFlag,
+                                   key,
+                                   BSLS_COMPILERFEATURES_FORWARD(MAPPED, obj));
+
+    return ResultType(iterator(position), isInsertedFlag);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+template <class MAPPED>
+bsl::pair<
+         typename unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::iterator,
+         bool>
+unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::insert_or_assign(
+                               BloombergLP::bslmf::MovableRef<key_type>  key,
+                               BSLS_COMPILERFEATURES_FORWARD_REF(MAPPED) obj)
+{
+    typedef bsl::pair<iterator, bool> ResultType;
+
+    key_type& lvalue = key;
+
+    HashTableLink *position = d_impl.find(lvalue);
+    if (position) {
+        static_cast<HashTableNode *>(position)->value().second =
+                                   BSLS_COMPILERFEATURES_FORWARD(MAPPED, obj);
+        return ResultType(iterator(position), false);                 // RETURN
+    }
+
+    bool isInsertedFlag = false;
+
+    // See 'bsl::map::operator[]' for the reason 'lvalue' is not moved in
+    // C++03.
+
+#if defined(BSLMF_MOVABLEREF_USES_RVALUE_REFERENCES)
+    position = d_impl.emplaceIfMissing(
+                                   &isInsertedFlag,
+                                   MoveUtil::move(lvalue),
+                                   BSLS_COMPILERFEATURES_FORWARD(MAPPED, obj));
+#else
+    position = d_impl.emplaceIfMissing(
+                                   &isInsertedFlag,
+                                   lvalue,
+                                   BSLS_COMPILERFEATURES_FORWARD(MAPPED, obj));
+#endif
+
+    return ResultType(iterator(position), isInsertedFlag);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+template <class MAPPED>
+inline
+typename unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::iterator
+unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::insert_or_assign(
+                                const_iterator,
+                                const key_type&                           key,
+                                BSLS_COMPILERFEATURES_FORWARD_REF(MAPPED) obj)
+{
+    return insert_or_assign(key,
+                            BSLS_COMPILERFEATURES_FORWARD(MAPPED, obj)).first;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+template <class MAPPED>
+inline
+typename unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::iterator
+unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::insert_or_assign(
+                               const_iterator,
+                               BloombergLP::bslmf::MovableRef<key_type>  key,
+                               BSLS_COMPILERFEATURES_FORWARD_REF(MAPPED) obj)
+{
+    return insert_or_assign(MoveUtil::move(key),
+                            BSLS_COMPILERFEATURES_FORWARD(MAPPED, obj)).first;
+}
+
 template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
 bsl::pair<
          typename unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::iterator,
@@ -2551,6 +3088,43 @@ unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::max_load_factor(
     d_impl.setMaxLoadFactor(newMaxLoadFactor);
 }
 
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+template <class HASH2, class EQUAL2>
+void unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::merge(
+                  unordered_map<KEY, VALUE, HASH2, EQUAL2, ALLOCATOR>& source)
+{
+    typedef typename unordered_map<KEY, VALUE, HASH2, EQUAL2, ALLOCATOR>::
+                                                      iterator SourceIterator;
+
+    if (static_cast<void *>(&source) == static_cast<void *>(this)) {
+        return;                                                       // RETURN
+    }
+
+    for (SourceIterator it = source.begin(); it != source.end(); ) {
+        bool isInsertedFlag = false;
+
+        d_impl.insertIfMissing(&isInsertedFlag, MoveUtil::move(*it));
+
+        if (isInsertedFlag) {
+            it = source.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+template <class HASH2, class EQUAL2>
+inline
+void unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::merge(
+                 unordered_map<KEY, VALUE, HASH2, EQUAL2, ALLOCATOR>&& source)
+{
+    merge(source);
+}
+#endif
+
 template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
 inline
 void
@@ -2578,6 +3152,95 @@ unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::swap(unordered_map& other)
     d_impl.swap(other.d_impl);
 }
 
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES                            \
+ && defined(BSLS_LIBRARYFEATURES_HAS_CPP11_PAIR_PIECEWISE_CONSTRUCTOR)        \
+ && defined(BSLS_LIBRARYFEATURES_HAS_CPP14_INTEGER_SEQUENCE)
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+template <class... Args>
+bsl::pair<
+         typename unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::iterator,
+         bool>
+unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::try_emplace(
+                                                     const key_type& key,
+                                                     Args&&...       args)
+{
+    typedef bsl::pair<iterator, bool> ResultType;
+
+    HashTableLink *position = d_impl.find(key);
+    if (position) {
+        return ResultType(iterator(position), false);                 // RETURN
+    }
+
+    bool isInsertedFlag = false;
+
+    position = d_impl.emplaceIfMissing(
+                           &isInsertedFlag,
+                           native_std::piecewise_construct,
+                           native_std::forward_as_tuple(key),
+                           native_std::forward_as_tuple(
+                                BSLS_COMPILERFEATURES_FORWARD(Args, args)...));
+
+    return ResultType(iterator(position), isInsertedFlag);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+template <class... Args>
+bsl::pair<
+         typename unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::iterator,
+         bool>
+unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::try_emplace(
+                                 BloombergLP::bslmf::MovableRef<key_type> key,
+                                 Args&&...                                args)
+{
+    typedef bsl::pair<iterator, bool> ResultType;
+
+    key_type& lvalue = key;
+
+    HashTableLink *position = d_impl.find(lvalue);
+    if (position) {
+        return ResultType(iterator(position), false);                 // RETURN
+    }
+
+    bool isInsertedFlag = false;
+
+    position = d_impl.emplaceIfMissing(
+                           &isInsertedFlag,
+                           native_std::piecewise_construct,
+                           native_std::forward_as_tuple(
+                                                      MoveUtil::move(lvalue)),
+                           native_std::forward_as_tuple(
+                                BSLS_COMPILERFEATURES_FORWARD(Args, args)...));
+
+    return ResultType(iterator(position), isInsertedFlag);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+template <class... Args>
+inline
+typename unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::iterator
+unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::try_emplace(
+                                                     const_iterator,
+                                                     const key_type& key,
+                                                     Args&&...       args)
+{
+    return try_emplace(key, BSLS_COMPILERFEATURES_FORWARD(Args, args)...)
+                                                                        .first;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+template <class... Args>
+inline
+typename unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::iterator
+unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::try_emplace(
+                                 const_iterator,
+                                 BloombergLP::bslmf::MovableRef<key_type> key,
+                                 Args&&...                                args)
+{
+    return try_emplace(MoveUtil::move(key),
+                       BSLS_COMPILERFEATURES_FORWARD(Args, args)...).first;
+}
+#endif
+
 // ACCESSORS
 template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
 typename add_lvalue_reference<const VALUE>::type
@@ -2722,6 +3385,15 @@ unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::count(
     return d_impl.find(key) != 0;
 }
 
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+inline
+bool
+unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::contains(
+                                                     const key_type& key) const
+{
+    return d_impl.find(key) != 0;
+}
+
 template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
 inline
 bool
@@ -165,6 +165,20 @@ using bsl::pair;
 // [29] iterator insert(CIter, Pair&&);
 // [29] iterator insert(CIter, ALT_PAIR&&);
 // [33] void insert(initializer_list<Pair>);
+// [41] node_type extract(CIter);
+// [41] node_type extract(const KEY&);
+// [41] insert_return_type insert(node_type&&);
+// [41] iterator insert(CIter, node_type&&);
+// [41] void merge(unordered_map<KEY, VALUE, H2, E2, ALLOC>&);
+// [41] void merge(unordered_map<KEY, VALUE, H2, E2, ALLOC>&&);
+// [41] pair<iterator, bool> insert_or_assign(const KEY&, M&&);
+// [41] pair<iterator, bool> insert_or_assign(KEY&&, M&&);
+// [41] iterator insert_or_assign(CIter, const KEY&, M&&);
+// [41] iterator insert_or_assign(CIter, KEY&&, M&&);
+// [41] pair<iterator, bool> try_emplace(const KEY&, Args&&...);
+// [41] pair<iterator, bool> try_emplace(KEY&&, Args&&...);
+// [41] iterator try_emplace(CIter, const KEY&, Args&&...);
+// [41] iterator try_emplace(CIter, KEY&&, Args&&...);
 // [ 8] void swap(Obj&);
 //
 // element access:
@@ -225,7 +239,7 @@ using bsl::pair;
 //
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [40] USAGE EXAMPLE
+// [42] USAGE EXAMPLE
 //
 // TEST APPARATUS: GENERATOR FUNCTIONS
 // [ 3] int  ggg(Obj *, const char *, bool verbose = true);
@@ -241,6 +255,7 @@ using bsl::pair;
 // [36] CONCERN: 'unordered_map' supports incomplete types.
 // [38] CONCERN: 'erase' overload is deduced correctly.
 // [39] CONCERN: Simple test case fails to compile on MSVC.
+// [40] CONCERN: Lookup functions do not convert a transparent key.
 
 // ============================================================================
 //                      STANDARD BDE ASSERT TEST MACROS
@@ -10420,7 +10435,7 @@ int main(int argc, char *argv[])
     ASSERT(0 == bslma::Default::setDefaultAllocator(&defaultAllocator));
 
     switch (test) { case 0:
-      case 40: {
+      case 42: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //
@@ -10440,6 +10455,8 @@ int main(int argc, char *argv[])
                             "\n=============\n");
         usage();
       } break;
+      case 41: // falls through
+      case 40: // falls through
       case 39: // falls through
       case 38: // falls through
       case 37: // falls through
@@ -167,6 +167,20 @@ using bsl::pair;
 // [29] iterator insert(CIter, Pair&&);
 // [29] iterator insert(CIter, ALT_PAIR&&);
 // [33] void insert(initializer_list<Pair>);
+// [41] node_type extract(CIter);
+// [41] node_type extract(const KEY&);
+// [41] insert_return_type insert(node_type&&);
+// [41] iterator insert(CIter, node_type&&);
+// [41] void merge(unordered_map<KEY, VALUE, H2, E2, ALLOC>&);
+// [41] void merge(unordered_map<KEY, VALUE, H2, E2, ALLOC>&&);
+// [41] pair<iterator, bool> insert_or_assign(const KEY&, M&&);
+// [41] pair<iterator, bool> insert_or_assign(KEY&&, M&&);
+// [41] iterator insert_or_assign(CIter, const KEY&, M&&);
+// [41] iterator insert_or_assign(CIter, KEY&&, M&&);
+// [41] pair<iterator, bool> try_emplace(const KEY&, Args&&...);
+// [41] pair<iterator, bool> try_emplace(KEY&&, Args&&...);
+// [41] iterator try_emplace(CIter, const KEY&, Args&&...);
+// [41] iterator try_emplace(CIter, KEY&&, Args&&...);
 // [ 8] void swap(Obj&);
 //
 // element access:
@@ -227,7 +241,7 @@ using bsl::pair;
 //
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [40] USAGE EXAMPLE
+// [42] USAGE EXAMPLE
 //
 // TEST APPARATUS: GENERATOR FUNCTIONS
 // [ 3] int  ggg(Obj *, const char *, bool verbose = true);
@@ -243,6 +257,7 @@ using bsl::pair;
 // [36] CONCERN: 'unordered_map' supports incomplete types.
 // [38] CONCERN: 'erase' overload is deduced correctly.
 // [39] CONCERN: Simple test case fails to compile on MSVC.
+// [40] CONCERN: Lookup functions do not convert a transparent key.
 
 // ============================================================================
 //                      STANDARD BDE ASSERT TEST MACROS
@@ -616,6 +631,187 @@ void testCase39(const bsl::unordered_map<int, int>& m)
     }
 }
 
+                       // =============================
+                       // class TransparentlyComparable
+                       // =============================
+
+class TransparentlyComparable {
+    // This class holds an 'int' value, and counts the number of times it is
+    // converted to 'int', so that a test can verify that heterogeneous lookup
+    // does not create a temporary 'key_type' object.
+
+    // DATA
+    int d_conversionCount;  // number of times 'operator int' has been called
+    int d_value;            // the value
+
+    // NOT IMPLEMENTED
+    TransparentlyComparable(const TransparentlyComparable&);  // = delete
+
+  public:
+    // CREATORS
+    explicit TransparentlyComparable(int value)
+        // Create an object having the specified 'value'.
+    : d_conversionCount(0)
+    , d_value(value)
+    {
+    }
+
+    // MANIPULATORS
+    operator int()
+        // Return the current value of this object.
+    {
+        ++d_conversionCount;
+        return d_value;
+    }
+
+    // ACCESSORS
+    int conversionCount() const
+        // Return the number of times 'operator int' has been called.
+    {
+        return d_conversionCount;
+    }
+
+    int value() const
+        // Return the current value of this object.
+    {
+        return d_value;
+    }
+};
+
+                         // =======================
+                         // struct TransparentHasher
+                         // =======================
+
+struct TransparentHasher {
+    // This class can be used as a hash functor for containers.  It has a
+    // nested type 'is_transparent', so it is classified as transparent by the
+    // 'bslmf::IsTransparentPredicate' metafunction, and returns the same hash
+    // code for an 'int' and a 'TransparentlyComparable' having the same value.
+
+    typedef void is_transparent;
+
+    size_t operator()(int value) const
+        // Return the hash code of the specified 'value'.
+    {
+        return bsl::hash<int>()(value);
+    }
+
+    size_t operator()(const TransparentlyComparable& value) const
+        // Return the hash code of the value of the specified 'value'.
+    {
+        return bsl::hash<int>()(value.value());
+    }
+};
+
+                        // ==========================
+                        // struct TransparentEqualTo
+                        // ==========================
+
+struct TransparentEqualTo {
+    // This class can be used as an equality comparator for containers.  It
+    // has a nested type 'is_transparent', so it is classified as transparent
+    // by the 'bslmf::IsTransparentPredicate' metafunction and can be used for
+    // heterogeneous comparison.
+
+    typedef void is_transparent;
+
+    bool operator()(int lhs, int rhs) const
+        // Return 'true' if the specified 'lhs' is equal to the specified
+        // 'rhs', and 'false' otherwise.
+    {
+        return lhs == rhs;
+    }
+
+    bool operator()(const TransparentlyComparable& lhs, int rhs) const
+        // Return 'true' if the value of the specified 'lhs' is equal to the
+        // specified 'rhs', and 'false' otherwise.
+    {
+        return lhs.value() == rhs;
+    }
+};
+
+template <class CONTAINER>
+void testTransparentLookup(CONTAINER& container,
+                           bool       isTransparent,
+                           int        initKeyValue)
+    // Search for a key equal to the specified 'initKeyValue' in the specified
+    // 'container', and count the number of conversions expected based on the
+    // specified 'isTransparent'.  Note that 'CONTAINER' may resolve to a
+    // 'const'-qualified type, so that both the 'const'-qualified and
+    // non-'const'-qualified overloads are tested.
+{
+    typedef typename CONTAINER::const_iterator Iterator;
+    typedef typename CONTAINER::size_type      Count;
+
+    int expectedConversionCount = 0;
+
+    TransparentlyComparable existingKey(initKeyValue);
+    TransparentlyComparable nonExistingKey(initKeyValue ? -initKeyValue
+                                                        : -100);
+
+    // Testing 'find'.
+
+    const Iterator EXISTING_F = container.find(existingKey);
+    if (!isTransparent) {
+        ++expectedConversionCount;
+    }
+
+    ASSERT(container.end()               != EXISTING_F);
+    ASSERT(existingKey.value()           == EXISTING_F->first);
+    ASSERT(existingKey.conversionCount() == expectedConversionCount);
+
+    const Iterator NON_EXISTING_F = container.find(nonExistingKey);
+    ASSERT(container.end()                  == NON_EXISTING_F);
+    ASSERT(nonExistingKey.conversionCount() == expectedConversionCount);
+
+    // Testing 'count'.
+
+    const Count EXISTING_C = container.count(existingKey);
+    if (!isTransparent) {
+        ++expectedConversionCount;
+    }
+
+    ASSERT(1                       == EXISTING_C);
+    ASSERT(expectedConversionCount == existingKey.conversionCount());
+
+    const Count NON_EXISTING_C = container.count(nonExistingKey);
+    ASSERT(0                       == NON_EXISTING_C);
+    ASSERT(expectedConversionCount == nonExistingKey.conversionCount());
+
+    // Testing 'contains'.
+
+    ASSERT(true == container.contains(existingKey));
+    if (!isTransparent) {
+        ++expectedConversionCount;
+    }
+    ASSERT(expectedConversionCount == existingKey.conversionCount());
+
+    ASSERT(false == container.contains(nonExistingKey));
+    ASSERT(expectedConversionCount == nonExistingKey.conversionCount());
+
+    // Testing 'equal_range'.
+
+    const bsl::pair<Iterator, Iterator> EXISTING_ER =
+                                            container.equal_range(existingKey);
+    if (!isTransparent) {
+        ++expectedConversionCount;
+    }
+
+    Iterator next = EXISTING_F;
+    ++next;
+
+    ASSERT(EXISTING_F              == EXISTING_ER.first);
+    ASSERT(next                    == EXISTING_ER.second);
+    ASSERT(expectedConversionCount == existingKey.conversionCount());
+
+    const bsl::pair<Iterator, Iterator> NON_EXISTING_ER =
+                                         container.equal_range(nonExistingKey);
+
+    ASSERT(container.end()         == NON_EXISTING_ER.first);
+    ASSERT(container.end()         == NON_EXISTING_ER.second);
+    ASSERT(expectedConversionCount == nonExistingKey.conversionCount());
+}
+
                        // =============================
                        // struct EraseAmbiguityTestType
                        // =============================
@@ -8062,6 +8258,453 @@ int main(int argc, char *argv[])
     ASSERT(0 == bslma::Default::setDefaultAllocator(&defaultAllocator));
 
     switch (test) { case 0:
+      case 41: {
+        // --------------------------------------------------------------------
+        // TESTING NODE HANDLES, 'try_emplace', AND 'insert_or_assign'
+        //
+        // Concerns:
+        //: 1 'extract' removes the element from the map and returns a node
+        //:   handle owning it, by moving the element into a single node
+        //:   allocated individually, and returns the map's node to its pool;
+        //:   extracting a missing key returns an empty node handle.
+        //:
+        //: 2 Inserting a node handle into the container from which it was
+        //:   extracted moves the element (possibly after re-keying it) into
+        //:   the node previously returned to the pool, without allocating
+        //:   memory, and deallocates the node of the handle.
+        //:
+        //: 3 Inserting a node handle whose key is already present does not
+        //:   modify the map, and returns the node handle to the caller;
+        //:   inserting an empty node handle has no effect.
+        //:
+        //: 4 Inserting a node handle into another map, including a map having
+        //:   a different allocator, moves the element into a node of that
+        //:   map, and deallocates the node of the handle.
+        //:
+        //: 5 'merge' transfers exactly the elements whose keys are missing
+        //:   from the target, including from a map having a different
+        //:   equality functor or allocator, and merging a map into itself has
+        //:   no effect.
+        //:
+        //: 6 'insert_or_assign' inserts a missing key, and otherwise assigns
+        //:   to the mapped value of the existing element.
+        //:
+        //: 7 'try_emplace' inserts a missing key, and otherwise neither
+        //:   modifies the map nor moves from its arguments.
+        //:
+        //: 8 No memory is allocated from the default allocator, and no memory
+        //:   is leaked.
+        //:
+        //: 9 A node handle remains usable, and can be inserted into another
+        //:   map or destroyed, after the map from which it was extracted has
+        //:   been destroyed, moved from, or swapped.
+        //
+        // Plan:
+        //: 1 Using a map from 'int' to a 'bsl::string' too long for the short
+        //:   string optimization, exercise each function and verify the
+        //:   contents of the maps, the address of the elements and of their
+        //:   string buffers, and the allocations made by the object
+        //:   allocator.  (C-1..8)
+        //:
+        //: 2 Extract node handles from maps that are then destroyed, moved
+        //:   from, or swapped, and verify that the node handles can be used,
+        //:   inserted into another map, and destroyed.  (C-9)
+        //
+        // Testing:
+        //   node_type extract(const_iterator position);
+        //   node_type extract(const key_type& key);
+        //   insert_return_type insert(node_type&& node);
+        //   iterator insert(const_iterator hint, node_type&& node);
+        //   void merge(unordered_map<K, V, H2, E2, A>& source);
+        //   void merge(unordered_map<K, V, H2, E2, A>&& source);
+        //   pair<iterator, bool> insert_or_assign(const key_type&, M&&);
+        //   pair<iterator, bool> insert_or_assign(key_type&&, M&&);
+        //   iterator insert_or_assign(const_iterator, const key_type&, M&&);
+        //   iterator insert_or_assign(const_iterator, key_type&&, M&&);
+        //   pair<iterator, bool> try_emplace(const key_type&, Args&&...);
+        //   pair<iterator, bool> try_emplace(key_type&&, Args&&...);
+        //   iterator try_emplace(const_iterator, const key_type&, Args&&...);
+        //   iterator try_emplace(const_iterator, key_type&&, Args&&...);
+        // --------------------------------------------------------------------
+
+        if (verbose) printf(
+               "\nTESTING NODE HANDLES, 'try_emplace', AND 'insert_or_assign'"
+               "\n==========================================================="
+               "\n");
+
+        typedef bslmf::MovableRefUtil                             MoveUtil;
+        typedef bsl::unordered_map<int, bsl::string>              Obj;
+        typedef bsl::unordered_map<int,
+                                   bsl::string,
+                                   bsl::hash<int>,
+                                   std::equal_to<int> >          OtherObj;
+
+        const char LONG_A[] = "a string that is too long to be short: A";
+        const char LONG_B[] = "a string that is too long to be short: B";
+        const char LONG_C[] = "a string that is too long to be short: C";
+
+        bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+        bslma::TestAllocator         oa("object",  veryVeryVeryVerbose);
+        bslma::TestAllocator         za("other",   veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        if (verbose) printf("\tTesting 'insert_or_assign'.\n");
+        {
+            Obj mX(&oa);  const Obj& X = mX;
+
+            const bsl::string A(LONG_A, &oa);
+            const bsl::string B(LONG_B, &oa);
+
+            bsl::pair<Obj::iterator, bool> result = mX.insert_or_assign(1, A);
+            ASSERT(result.second);
+            ASSERT(1 == result.first->first);
+            ASSERT(A == result.first->second);
+
+            result = mX.insert_or_assign(1, B);
+            ASSERT(!result.second);
+            ASSERT(B == result.first->second);
+            ASSERT(1 == X.size());
+
+            int key = 2;
+            result = mX.insert_or_assign(
+                                      MoveUtil::move(key), A);
+            ASSERT(result.second);
+            ASSERT(A == X.find(2)->second);
+
+            Obj::iterator it = mX.insert_or_assign(X.end(), 3, B);
+            ASSERT(3 == it->first);
+            ASSERT(B == it->second);
+
+            it = mX.insert_or_assign(X.begin(), 3, A);
+            ASSERT(3 == it->first);
+            ASSERT(A == it->second);
+
+            key = 4;
+            it = mX.insert_or_assign(X.end(),
+                                     MoveUtil::move(key),
+                                     B);
+            ASSERT(4 == it->first);
+            ASSERT(4 == X.size());
+        }
+
+        if (verbose) printf("\tTesting 'merge'.\n");
+        {
+            Obj        mX(&oa);  const Obj&        X = mX;
+            OtherObj   mY(&oa);  const OtherObj&   Y = mY;
+
+            mX[1] = LONG_A;
+            mX[3] = LONG_A;
+            mY[2] = LONG_B;
+            mY[3] = LONG_B;
+            mY[5] = LONG_B;
+
+            mX.merge(mY);
+            ASSERTV(X.size(), 4 == X.size());
+            ASSERTV(Y.size(), 1 == Y.size());
+            ASSERT(LONG_A == X.find(3)->second);
+            ASSERT(LONG_B == X.find(2)->second);
+            ASSERT(LONG_B == X.find(5)->second);
+            ASSERT(LONG_B == Y.find(3)->second);
+
+            mX.merge(mX);
+            ASSERT(4 == X.size());
+
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+            mY[7] = LONG_C;
+            mX.merge(MoveUtil::move(mY));
+            ASSERT(5 == X.size());
+            ASSERT(1 == Y.size());
+            ASSERT(LONG_C == X.find(7)->second);
+#endif
+
+            // Merging from a map having a different allocator moves the
+            // elements into nodes allocated by the target.
+
+            OtherObj mZ(&za);  const OtherObj& Z = mZ;
+
+            mZ[3] = LONG_C;
+            mZ[8] = LONG_C;
+
+            mX.merge(mZ);
+            ASSERTV(Z.size(), 1 == Z.size());
+            ASSERT(LONG_C == X.find(8)->second);
+            ASSERT(&oa    == X.find(8)->second.get_allocator().mechanism());
+        }
+        ASSERTV(za.numBlocksInUse(), 0 == za.numBlocksInUse());
+
+#if defined(BSLS_COMPILERFEATURES_SUPPORT_RVALUE_REFERENCES)
+        if (verbose) printf("\tTesting 'extract' and node 'insert'.\n");
+        {
+            Obj mX(&oa);  const Obj& X = mX;
+            Obj mY(&oa);  const Obj& Y = mY;
+
+            mX[1] = LONG_A;
+            mX[2] = LONG_B;
+            mX[3] = LONG_C;
+
+            const Obj::value_type *ELEMENT = &*X.find(1);
+            const char            *BUFFER  = X.find(1)->second.data();
+
+            bsls::Types::Int64 numAllocs   = oa.numAllocations();
+            bsls::Types::Int64 numDeallocs = oa.numDeallocations();
+
+            Obj::node_type nh = mX.extract(X.find(1));
+            ASSERT(!nh.empty());
+            ASSERT(2      == X.size());
+            ASSERT(X.end() == X.find(1));
+            ASSERT(1      == nh.key());
+            ASSERT(LONG_A == nh.mapped());
+            ASSERT(BUFFER == nh.mapped().data());
+            ASSERT(&oa    == nh.get_allocator().mechanism());
+
+            ASSERTV(numAllocs + 1 == oa.numAllocations());
+            ASSERTV(numDeallocs   == oa.numDeallocations());
+
+            Obj::node_type empty = mX.extract(99);
+            ASSERT(empty.empty());
+            ASSERTV(numAllocs + 1 == oa.numAllocations());
+
+            // Re-key the element and insert it back.
+
+            nh.key() = 4;
+            Obj::insert_return_type result =
+                                      mX.insert(MoveUtil::move(nh));
+            ASSERT(result.inserted);
+            ASSERT(result.node.empty());
+            ASSERT(nh.empty());
+            ASSERT(4       == result.position->first);
+            ASSERT(ELEMENT == &*result.position);
+            ASSERT(BUFFER  == result.position->second.data());
+            ASSERT(3       == X.size());
+
+            ASSERTV(numAllocs   + 1 == oa.numAllocations());
+            ASSERTV(numDeallocs + 1 == oa.numDeallocations());
+
+            // Duplicate key: the node handle is returned.
+
+            nh = mX.extract(2);
+            nh.key() = 3;
+            result = mX.insert(MoveUtil::move(nh));
+            ASSERT(!result.inserted);
+            ASSERT(!result.node.empty());
+            ASSERT(3      == result.position->first);
+            ASSERT(LONG_C == result.position->second);
+            ASSERT(LONG_B == result.node.mapped());
+            ASSERT(2      == X.size());
+
+            // Empty node handle.
+
+            result = mX.insert(Obj::node_type());
+            ASSERT(!result.inserted);
+            ASSERT(X.end() == result.position);
+            ASSERT(result.node.empty());
+
+            // Hinted insertion.
+
+            nh = MoveUtil::move(result.node);
+            ASSERT(nh.empty());
+            nh = mX.extract(3);
+            nh.key() = 2;
+            Obj::iterator it = mX.insert(X.begin(),
+                                         MoveUtil::move(nh));
+            ASSERT(nh.empty());
+            ASSERT(2 == it->first);
+            ASSERT(LONG_C == it->second);
+
+            it = mX.insert(X.end(), Obj::node_type());
+            ASSERT(X.end() == it);
+
+            // Insertion into another map.
+
+            const Obj::value_type *OTHER = &*X.find(4);
+
+            nh = mX.extract(4);
+            result = mY.insert(MoveUtil::move(nh));
+            ASSERT(result.inserted);
+            ASSERT(nh.empty());
+            ASSERT(1       == X.size());
+            ASSERT(1       == Y.size());
+            ASSERT(4       == result.position->first);
+            ASSERT(LONG_A  == result.position->second);
+            ASSERT(BUFFER  == result.position->second.data());
+            ASSERT(OTHER   != &*result.position);
+
+            // The node returned to 'mX' is reused by its next insertion.
+
+            mX[5] = LONG_B;
+            ASSERT(OTHER == &*X.find(5));
+
+            // Insertion into a map having a different allocator.
+
+            Obj mZ(&za);  const Obj& Z = mZ;
+
+            nh = mY.extract(4);
+            ASSERT(&oa == nh.get_allocator().mechanism());
+
+            result = mZ.insert(MoveUtil::move(nh));
+            ASSERT(result.inserted);
+            ASSERT(nh.empty());
+            ASSERT(0      == Y.size());
+            ASSERT(1      == Z.size());
+            ASSERT(LONG_A == result.position->second);
+            ASSERT(&za    == result.position->second.get_allocator()
+                                                                 .mechanism());
+        }
+        ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+        ASSERTV(za.numBlocksInUse(), 0 == za.numBlocksInUse());
+
+        if (verbose) printf("\tTesting node handles outliving maps.\n");
+        {
+            Obj mX(&oa);  const Obj& X = mX;
+
+            Obj::node_type nh;
+            Obj::node_type nh2;
+            {
+                Obj mY(&oa);
+
+                mY[1] = LONG_A;
+                mY[2] = LONG_B;
+
+                nh  = mY.extract(1);
+                nh2 = mY.extract(2);
+            }
+            ASSERT(1      == nh.key());
+            ASSERT(LONG_A == nh.mapped());
+            ASSERT(&oa    == nh.get_allocator().mechanism());
+
+            const char *BUFFER = nh.mapped().data();
+
+            Obj::insert_return_type result = mX.insert(MoveUtil::move(nh));
+            ASSERT(result.inserted);
+            ASSERT(nh.empty());
+            ASSERT(LONG_A == result.position->second);
+            ASSERT(BUFFER == result.position->second.data());
+            ASSERT(1      == X.size());
+
+            // The map the node was extracted from can also be moved from, or
+            // swapped, while the node handle is alive.
+
+            Obj mW(&oa);
+            mW[3] = LONG_C;
+            nh = mW.extract(3);
+
+            Obj mV(MoveUtil::move(mW));
+            mV.swap(mW);
+            mW[4] = LONG_C;
+            ASSERT(LONG_C == nh.mapped());
+
+            // 'nh2' is destroyed after the map it was extracted from.
+        }
+        ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+#endif
+
+#if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES                            \
+ && defined(BSLS_LIBRARYFEATURES_HAS_CPP11_PAIR_PIECEWISE_CONSTRUCTOR)        \
+ && defined(BSLS_LIBRARYFEATURES_HAS_CPP14_INTEGER_SEQUENCE)
+        if (verbose) printf("\tTesting 'try_emplace'.\n");
+        {
+            Obj mX(&oa);  const Obj& X = mX;
+
+            bsl::pair<Obj::iterator, bool> result =
+                                           mX.try_emplace(1, LONG_A);
+            ASSERT(result.second);
+            ASSERT(LONG_A == result.first->second);
+            ASSERT(&oa    == result.first->second.get_allocator().mechanism());
+
+            bsl::string value(LONG_B, &oa);
+
+            result = mX.try_emplace(1, MoveUtil::move(value));
+            ASSERT(!result.second);
+            ASSERT(LONG_A == result.first->second);
+            ASSERT(LONG_B == value);
+
+            int key = 2;
+            result = mX.try_emplace(MoveUtil::move(key), 3, 'x');
+            ASSERT(result.second);
+            ASSERT("xxx" == result.first->second);
+
+            Obj::iterator it = mX.try_emplace(X.end(), 3);
+            ASSERT(3 == it->first);
+            ASSERT(it->second.empty());
+
+            it = mX.try_emplace(X.begin(), 3, MoveUtil::move(value));
+            ASSERT(3 == it->first);
+            ASSERT(LONG_B == value);
+
+            key = 4;
+            it = mX.try_emplace(X.end(), MoveUtil::move(key), LONG_C);
+            ASSERT(4 == it->first);
+            ASSERT(LONG_C == it->second);
+            ASSERT(4 == X.size());
+        }
+        ASSERTV(oa.numBlocksInUse(), 0 == oa.numBlocksInUse());
+#endif
+
+        ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+      } break;
+      case 40: {
+        // --------------------------------------------------------------------
+        // TESTING TRANSPARENT LOOKUP
+        //
+        // Concerns:
+        //: 1 'unordered_map' does not have a transparent set of lookup
+        //:   functions unless both the hasher and the equality comparator
+        //:   are transparent.
+        //:
+        //: 2 'unordered_map' has a transparent set of lookup functions if both
+        //:   the hasher and the equality comparator are transparent.
+        //
+        // Plan:
+        //: 1 Construct a non-transparent map and call the lookup functions
+        //:   with a type that is convertible to the 'key_type'.  There should
+        //:   be exactly one conversion per call to a lookup function.  (C-1)
+        //:
+        //: 2 Construct a transparent map and call the lookup functions with
+        //:   a type that is convertible to the 'key_type'.  There should be no
+        //:   conversions.  (C-2)
+        //
+        // Testing:
+        //   CONCERN: Lookup functions do not convert a transparent key.
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\n" "TESTING TRANSPARENT LOOKUP" "\n"
+                                 "==========================" "\n");
+
+        typedef bsl::unordered_map<int, int> NonTransparent;
+        typedef bsl::unordered_map<int,
+                                   int,
+                                   TransparentHasher,
+                                   TransparentEqualTo> Transparent;
+
+        const int DATA[] = { 0, 1, 2, 3, 4 };
+        enum { NUM_DATA = sizeof DATA / sizeof *DATA };
+
+        NonTransparent        mXNT;
+        const NonTransparent& XNT = mXNT;
+
+        for (int i = 0; i < NUM_DATA; ++i) {
+            mXNT.insert(bsl::pair<const int, int>(DATA[i], DATA[i]));
+        }
+
+        Transparent        mXT(mXNT.begin(), mXNT.end());
+        const Transparent& XT = mXT;
+
+        ASSERT(NUM_DATA == XNT.size());
+        ASSERT(NUM_DATA == XT.size() );
+
+        for (int i = 0; i < NUM_DATA; ++i) {
+            const int VALUE = DATA[i];
+            if (veryVerbose) {
+                printf("Testing transparent lookup with a value of %d\n",
+                       VALUE);
+            }
+
+            testTransparentLookup( XNT, false, VALUE);
+            testTransparentLookup(mXNT, false, VALUE);
+            testTransparentLookup( XT,  true,  VALUE);
+            testTransparentLookup(mXT,  true,  VALUE);
+        }
+      } break;
       case 39: {
         // --------------------------------------------------------------------
         // SIMPLE MSVC COMPILATION FAILURE
@@ -133,6 +133,17 @@ BSLS_IDENT("$Id: $")
 // two objects whose keys compare equal by the comparator, shall produce the
 // same value from the hasher.
 //
+///Heterogeneous Lookup
+///- - - - - - - - - - -
+// If both 'HASH' and 'EQUAL' are *transparent* (i.e., each declares a nested
+// type named 'is_transparent'), the 'find', 'count', 'equal_range', and
+// 'contains' methods of this unordered set accept a key of any type,
+// 'LOOKUP_KEY', that 'HASH' can hash and 'EQUAL' can compare with 'KEY', and
+// look up that key without converting it to 'KEY'.  For example, the keys of
+// a container of 'bsl::string' can be looked up with a 'bsl::string_view'
+// without allocating memory.  'HASH' must return the same value for a
+// 'LOOKUP_KEY' object as for every equivalent 'KEY' object.
+//
 ///Memory Allocation
 ///-----------------
 // The type supplied as a set's 'ALLOCATOR' template parameter determines how
@@ -281,6 +292,9 @@ BSLS_IDENT("$Id: $")
 //  |                                                    |         a.count(k)]|
 //  |                                                    | Worst:   O[n]      |
 //  +----------------------------------------------------+--------------------+
+//  | a.contains(k)                                      | Average: O[1]      |
+//  |                                                    | Worst:   O[n]      |
+//  +----------------------------------------------------+--------------------+
 //  | a.bucket_count()                                   | O[1]               |
 //  +----------------------------------------------------+--------------------+
 //  | a.max_bucket_count()                               | O[1]               |
@@ -588,7 +602,9 @@ BSL_OVERRIDES_STD mode"
                                  // not very user friendly
 #include <bslma_usesbslmaallocator.h>
 
+#include <bslmf_enableif.h>
 #include <bslmf_isbitwisemoveable.h>
+#include <bslmf_istransparentpredicate.h>
 #include <bslmf_nestedtraitdeclaration.h>
 
 #include <bsls_assert.h>
@@ -1392,6 +1408,26 @@ class unordered_set {
         // such an entry exists, and the past-the-end ('end') iterator
         // otherwise.
 
+    template <class LOOKUP_KEY>
+    typename enable_if<
+        BloombergLP::bslmf::IsTransparentPredicate<HASH, LOOKUP_KEY>::value
+     && BloombergLP::bslmf::IsTransparentPredicate<EQUAL, LOOKUP_KEY>::value,
+        iterator>::type
+    find(const LOOKUP_KEY& key)
+        // Return an iterator providing modifiable access to the 'value_type'
+        // object in this set that is equivalent to the specified 'key', if
+        // such an entry exists, and the past-the-end ('end') iterator
+        // otherwise.  This overload
+        // participates in overload resolution only if both 'HASH' and 'EQUAL'
+        // are transparent (i.e., declare a nested 'is_transparent' type).  The
+        // behavior is undefined unless 'HASH' returns the same hash code for
+        // 'key' as for any equivalent 'key_type' object.
+        //
+        // Note: implemented inline due to Sun CC compilation error.
+    {
+        return iterator(d_impl.find(key));
+    }
+
     pair<iterator, iterator> equal_range(const key_type& key);
         // Return a pair of iterators providing modifiable access to the
         // sequence of 'value_type' objects in this unordered set that are
@@ -1402,6 +1438,34 @@ class unordered_set {
         // returned iterators will have the same value.  Note that since a set
         // maintains unique keys, the range will contain at most one element.
 
+    template <class LOOKUP_KEY>
+    typename enable_if<
+        BloombergLP::bslmf::IsTransparentPredicate<HASH, LOOKUP_KEY>::value
+     && BloombergLP::bslmf::IsTransparentPredicate<EQUAL, LOOKUP_KEY>::value,
+        pair<iterator, iterator> >::type
+    equal_range(const LOOKUP_KEY& key)
+        // Return a pair of iterators providing modifiable access to the
+        // sequence of 'value_type' objects in this unordered set that are
+        // equivalent to the specified 'key', where the first iterator is
+        // positioned at the start of the sequence, and the second is
+        // positioned one past the end of the sequence.  If this unordered set
+        // contains no 'value_type' objects equivalent to 'key', then the two
+        // returned iterators will have the same value.  This overload
+        // participates in overload resolution only if both 'HASH' and 'EQUAL'
+        // are transparent (i.e., declare a nested 'is_transparent' type).  The
+        // behavior is undefined unless 'HASH' returns the same hash code for
+        // 'key' as for any equivalent 'key_type' object.
+        //
+        // Note: implemented inline due to Sun CC compilation error.
+    {
+        typedef bsl::pair<iterator, iterator> ResultType;
+
+        HashTableLink *first = d_impl.find(key);
+        return first
+             ? ResultType(iterator(first), iterator(first->nextLink()))
+             : ResultType(end(), end());
+    }
+
     void max_load_factor(float newLoadFactor);
         // Set the maximum load factor of this container to the specified
         // 'newLoadFactor'.
@@ -1477,11 +1541,71 @@ class unordered_set {
         // 'key', if such an entry exists, and the past-the-end ('end')
         // iterator otherwise.
 
+    template <class LOOKUP_KEY>
+    typename enable_if<
+        BloombergLP::bslmf::IsTransparentPredicate<HASH, LOOKUP_KEY>::value
+     && BloombergLP::bslmf::IsTransparentPredicate<EQUAL, LOOKUP_KEY>::value,
+        const_iterator>::type
+    find(const LOOKUP_KEY& key) const
+        // Return an iterator providing non-modifiable access to the
+        // 'value_type' object in this set that is equivalent to the specified
+        // 'key', if such an entry exists, and the past-the-end ('end')
+        // iterator otherwise.  This overload
+        // participates in overload resolution only if both 'HASH' and 'EQUAL'
+        // are transparent (i.e., declare a nested 'is_transparent' type).  The
+        // behavior is undefined unless 'HASH' returns the same hash code for
+        // 'key' as for any equivalent 'key_type' object.
+        //
+        // Note: implemented inline due to Sun CC compilation error.
+    {
+        return const_iterator(d_impl.find(key));
+    }
+
     size_type count(const key_type& key) const;
         // Return the number of 'value_type' objects within this set that are
         // equivalent to the specified 'key'.  Note that since an unordered set
         // maintains unique keys, the returned value will be either 0 or 1.
 
+    template <class LOOKUP_KEY>
+    typename enable_if<
+        BloombergLP::bslmf::IsTransparentPredicate<HASH, LOOKUP_KEY>::value
+     && BloombergLP::bslmf::IsTransparentPredicate<EQUAL, LOOKUP_KEY>::value,
+        size_type>::type
+    count(const LOOKUP_KEY& key) const
+        // Return the number of 'value_type' objects within this set that are
+        // equivalent to the specified 'key'.  This overload
+        // participates in overload resolution only if both 'HASH' and 'EQUAL'
+        // are transparent (i.e., declare a nested 'is_transparent' type).  The
+        // behavior is undefined unless 'HASH' returns the same hash code for
+        // 'key' as for any equivalent 'key_type' object.
+        //
+        // Note: implemented inline due to Sun CC compilation error.
+    {
+        return 0 != d_impl.find(key);
+    }
+
+    bool contains(const key_type& key) const;
+        // Return 'true' if this set contains a 'value_type' object equivalent
+        // to the specified 'key', and 'false' otherwise.
+
+    template <class LOOKUP_KEY>
+    typename enable_if<
+        BloombergLP::bslmf::IsTransparentPredicate<HASH, LOOKUP_KEY>::value
+     && BloombergLP::bslmf::IsTransparentPredicate<EQUAL, LOOKUP_KEY>::value,
+        bool>::type
+    contains(const LOOKUP_KEY& key) const
+        // Return 'true' if this set contains a 'value_type' object equivalent
+        // to the specified 'key', and 'false' otherwise.  This overload
+        // participates in overload resolution only if both 'HASH' and 'EQUAL'
+        // are transparent (i.e., declare a nested 'is_transparent' type).  The
+        // behavior is undefined unless 'HASH' returns the same hash code for
+        // 'key' as for any equivalent 'key_type' object.
+        //
+        // Note: implemented inline due to Sun CC compilation error.
+    {
+        return 0 != d_impl.find(key);
+    }
+
     pair<const_iterator, const_iterator> equal_range(
                                                     const key_type& key) const;
         // Return a pair of iterators providing non-modifiable access to the
@@ -1493,6 +1617,35 @@ class unordered_set {
         // have the same value.  Note that since a set maintains unique keys,
         // the range will contain at most one element.
 
+    template <class LOOKUP_KEY>
+    typename enable_if<
+        BloombergLP::bslmf::IsTransparentPredicate<HASH, LOOKUP_KEY>::value
+     && BloombergLP::bslmf::IsTransparentPredicate<EQUAL, LOOKUP_KEY>::value,
+        pair<const_iterator, const_iterator> >::type
+    equal_range(const LOOKUP_KEY& key) const
+        // Return a pair of iterators providing non-modifiable access to the
+        // sequence of 'value_type' objects in this set that are equivalent to
+        // the specified 'key', where the first iterator is positioned at the
+        // start of the sequence and the second iterator is positioned one past
+        // the end of the sequence.  If this set contains no 'value_type'
+        // objects equivalent to 'key', then the two returned iterators will
+        // have the same value.  This overload
+        // participates in overload resolution only if both 'HASH' and 'EQUAL'
+        // are transparent (i.e., declare a nested 'is_transparent' type).  The
+        // behavior is undefined unless 'HASH' returns the same hash code for
+        // 'key' as for any equivalent 'key_type' object.
+        //
+        // Note: implemented inline due to Sun CC compilation error.
+    {
+        typedef bsl::pair<const_iterator, const_iterator> ResultType;
+
+        HashTableLink *first = d_impl.find(key);
+        return first
+             ? ResultType(const_iterator(first),
+                          const_iterator(first->nextLink()))
+             : ResultType(end(), end());
+    }
+
     size_type bucket_count() const BSLS_KEYWORD_NOEXCEPT;
         // Return the number of buckets in the array of buckets maintained by
         // this set.
@@ -2874,6 +3027,14 @@ unordered_set<KEY, HASH, EQUAL, ALLOCATOR>::count(const key_type& key) const
     return 0 != d_impl.find(key);
 }
 
+template <class KEY, class HASH, class EQUAL, class ALLOCATOR>
+inline
+bool
+unordered_set<KEY, HASH, EQUAL, ALLOCATOR>::contains(const key_type& key) const
+{
+    return 0 != d_impl.find(key);
+}
+
 template <class KEY, class HASH, class EQUAL, class ALLOCATOR>
 inline
 bsl::pair<typename unordered_set<KEY, HASH, EQUAL, ALLOCATOR>::const_iterator,
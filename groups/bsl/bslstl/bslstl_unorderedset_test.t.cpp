@@ -204,7 +204,7 @@ using bsls::NameOf;
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [ 2] default construction (only)
-// [34] USAGE EXAMPLE
+// [35] USAGE EXAMPLE
 //
 // TEST APPARATUS: GENERATOR FUNCTIONS
 //*[ 3] int ggg(unordered_set<K,H,E,A> *object, const char *spec, int verbose);
@@ -216,6 +216,7 @@ using bsls::NameOf;
 //*[23] TBD: Not yet working for all types.
 //*[  ] CONCERN: The type provides the full interface defined by the standard.
 // [33] CONCERN: Methods qualifed 'noexcept' in standard are so implemented.
+// [34] CONCERN: Lookup functions do not convert a transparent key.
 
 // ============================================================================
 //                      STANDARD BDE ASSERT TEST MACROS
@@ -823,9 +824,188 @@ void testErase(CONTAINER& mX)
     testEmptyContainer(mX);
 }
 
+                       // =============================
+                       // class TransparentlyComparable
+                       // =============================
 
-//------ Test machinery borrowed from associative container test drivers ------
+class TransparentlyComparable {
+    // This class holds an 'int' value, and counts the number of times it is
+    // converted to 'int', so that a test can verify that heterogeneous lookup
+    // does not create a temporary 'key_type' object.
+
+    // DATA
+    int d_conversionCount;  // number of times 'operator int' has been called
+    int d_value;            // the value
+
+    // NOT IMPLEMENTED
+    TransparentlyComparable(const TransparentlyComparable&);  // = delete
+
+  public:
+    // CREATORS
+    explicit TransparentlyComparable(int value)
+        // Create an object having the specified 'value'.
+    : d_conversionCount(0)
+    , d_value(value)
+    {
+    }
+
+    // MANIPULATORS
+    operator int()
+        // Return the current value of this object.
+    {
+        ++d_conversionCount;
+        return d_value;
+    }
+
+    // ACCESSORS
+    int conversionCount() const
+        // Return the number of times 'operator int' has been called.
+    {
+        return d_conversionCount;
+    }
+
+    int value() const
+        // Return the current value of this object.
+    {
+        return d_value;
+    }
+};
+
+                         // =======================
+                         // struct TransparentHasher
+                         // =======================
+
+struct TransparentHasher {
+    // This class can be used as a hash functor for containers.  It has a
+    // nested type 'is_transparent', so it is classified as transparent by the
+    // 'bslmf::IsTransparentPredicate' metafunction, and returns the same hash
+    // code for an 'int' and a 'TransparentlyComparable' having the same value.
+
+    typedef void is_transparent;
+
+    size_t operator()(int value) const
+        // Return the hash code of the specified 'value'.
+    {
+        return bsl::hash<int>()(value);
+    }
+
+    size_t operator()(const TransparentlyComparable& value) const
+        // Return the hash code of the value of the specified 'value'.
+    {
+        return bsl::hash<int>()(value.value());
+    }
+};
+
+                        // ==========================
+                        // struct TransparentEqualTo
+                        // ==========================
+
+struct TransparentEqualTo {
+    // This class can be used as an equality comparator for containers.  It
+    // has a nested type 'is_transparent', so it is classified as transparent
+    // by the 'bslmf::IsTransparentPredicate' metafunction and can be used for
+    // heterogeneous comparison.
+
+    typedef void is_transparent;
+
+    bool operator()(int lhs, int rhs) const
+        // Return 'true' if the specified 'lhs' is equal to the specified
+        // 'rhs', and 'false' otherwise.
+    {
+        return lhs == rhs;
+    }
+
+    bool operator()(const TransparentlyComparable& lhs, int rhs) const
+        // Return 'true' if the value of the specified 'lhs' is equal to the
+        // specified 'rhs', and 'false' otherwise.
+    {
+        return lhs.value() == rhs;
+    }
+};
+
+template <class CONTAINER>
+void testTransparentLookup(CONTAINER& container,
+                           bool       isTransparent,
+                           int        initKeyValue)
+    // Search for a key equal to the specified 'initKeyValue' in the specified
+    // 'container', and count the number of conversions expected based on the
+    // specified 'isTransparent'.  Note that 'CONTAINER' may resolve to a
+    // 'const'-qualified type, so that both the 'const'-qualified and
+    // non-'const'-qualified overloads are tested.
+{
+    typedef typename CONTAINER::const_iterator Iterator;
+    typedef typename CONTAINER::size_type      Count;
 
+    int expectedConversionCount = 0;
+
+    TransparentlyComparable existingKey(initKeyValue);
+    TransparentlyComparable nonExistingKey(initKeyValue ? -initKeyValue
+                                                        : -100);
+
+    // Testing 'find'.
+
+    const Iterator EXISTING_F = container.find(existingKey);
+    if (!isTransparent) {
+        ++expectedConversionCount;
+    }
+
+    ASSERT(container.end()               != EXISTING_F);
+    ASSERT(existingKey.value()           == *EXISTING_F);
+    ASSERT(existingKey.conversionCount() == expectedConversionCount);
+
+    const Iterator NON_EXISTING_F = container.find(nonExistingKey);
+    ASSERT(container.end()                  == NON_EXISTING_F);
+    ASSERT(nonExistingKey.conversionCount() == expectedConversionCount);
+
+    // Testing 'count'.
+
+    const Count EXISTING_C = container.count(existingKey);
+    if (!isTransparent) {
+        ++expectedConversionCount;
+    }
+
+    ASSERT(1                       == EXISTING_C);
+    ASSERT(expectedConversionCount == existingKey.conversionCount());
+
+    const Count NON_EXISTING_C = container.count(nonExistingKey);
+    ASSERT(0                       == NON_EXISTING_C);
+    ASSERT(expectedConversionCount == nonExistingKey.conversionCount());
+
+    // Testing 'contains'.
+
+    ASSERT(true == container.contains(existingKey));
+    if (!isTransparent) {
+        ++expectedConversionCount;
+    }
+    ASSERT(expectedConversionCount == existingKey.conversionCount());
+
+    ASSERT(false == container.contains(nonExistingKey));
+    ASSERT(expectedConversionCount == nonExistingKey.conversionCount());
+
+    // Testing 'equal_range'.
+
+    const bsl::pair<Iterator, Iterator> EXISTING_ER =
+                                            container.equal_range(existingKey);
+    if (!isTransparent) {
+        ++expectedConversionCount;
+    }
+
+    Iterator next = EXISTING_F;
+    ++next;
+
+    ASSERT(EXISTING_F              == EXISTING_ER.first);
+    ASSERT(next                    == EXISTING_ER.second);
+    ASSERT(expectedConversionCount == existingKey.conversionCount());
+
+    const bsl::pair<Iterator, Iterator> NON_EXISTING_ER =
+                                         container.equal_range(nonExistingKey);
+
+    ASSERT(container.end()         == NON_EXISTING_ER.first);
+    ASSERT(container.end()         == NON_EXISTING_ER.second);
+    ASSERT(expectedConversionCount == nonExistingKey.conversionCount());
+}
+
+//------ Test machinery borrowed from associative container test drivers ------
 namespace bsl {
 
 // set-specific print function.
@@ -7634,6 +7814,68 @@ int main(int argc, char *argv[])
     ASSERT(0 == bslma::Default::setDefaultAllocator(&defaultAllocator));
 
     switch (test) { case 0:
+      case 34: {
+        // --------------------------------------------------------------------
+        // TESTING TRANSPARENT LOOKUP
+        //
+        // Concerns:
+        //: 1 'unordered_set' does not have a transparent set of lookup
+        //:   functions unless both the hasher and the equality comparator
+        //:   are transparent.
+        //:
+        //: 2 'unordered_set' has a transparent set of lookup functions if both
+        //:   the hasher and the equality comparator are transparent.
+        //
+        // Plan:
+        //: 1 Construct a non-transparent set and call the lookup functions
+        //:   with a type that is convertible to the 'key_type'.  There should
+        //:   be exactly one conversion per call to a lookup function.  (C-1)
+        //:
+        //: 2 Construct a transparent set and call the lookup functions with
+        //:   a type that is convertible to the 'key_type'.  There should be no
+        //:   conversions.  (C-2)
+        //
+        // Testing:
+        //   CONCERN: Lookup functions do not convert a transparent key.
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\n" "TESTING TRANSPARENT LOOKUP" "\n"
+                                 "==========================" "\n");
+
+        typedef bsl::unordered_set<int> NonTransparent;
+        typedef bsl::unordered_set<int,
+                                   TransparentHasher,
+                                   TransparentEqualTo> Transparent;
+
+        const int DATA[] = { 0, 1, 2, 3, 4 };
+        enum { NUM_DATA = sizeof DATA / sizeof *DATA };
+
+        NonTransparent        mXNT;
+        const NonTransparent& XNT = mXNT;
+
+        for (int i = 0; i < NUM_DATA; ++i) {
+            mXNT.insert(DATA[i]);
+        }
+
+        Transparent        mXT(mXNT.begin(), mXNT.end());
+        const Transparent& XT = mXT;
+
+        ASSERT(NUM_DATA == XNT.size());
+        ASSERT(NUM_DATA == XT.size() );
+
+        for (int i = 0; i < NUM_DATA; ++i) {
+            const int VALUE = DATA[i];
+            if (veryVerbose) {
+                printf("Testing transparent lookup with a value of %d\n",
+                       VALUE);
+            }
+
+            testTransparentLookup( XNT, false, VALUE);
+            testTransparentLookup(mXNT, false, VALUE);
+            testTransparentLookup( XT,  true,  VALUE);
+            testTransparentLookup(mXT,  true,  VALUE);
+        }
+      } break;
       case 33: {
         // --------------------------------------------------------------------
         // 'noexcept' SPECIFICATION